@@ -40,7 +40,7 @@ function(wrap_python TARGET_NAME PYTHON_MODULE_DIRECTORY)
   # Create a static library version
   add_library(${TARGET_NAME} SHARED ${ARGN})
 
-  target_link_libraries(${TARGET_NAME} ${Boost_PYTHON_LIBRARY} ${PYTHON_LIBRARY} gtsam-shared)
+  target_link_libraries(${TARGET_NAME} ${Boost_PYTHON_LIBRARY} ${PYTHON_LIBRARY} gtsam)
       set_target_properties(${TARGET_NAME} PROPERTIES 
           OUTPUT_NAME         ${TARGET_NAME}
           CLEAN_DIRECT_OUTPUT 1
@@ -64,4 +64,36 @@ function(wrap_python TARGET_NAME PYTHON_MODULE_DIRECTORY)
   get_directory_property(AMCF ADDITIONAL_MAKE_CLEAN_FILES)
   list(APPEND AMCF ${PYTHON_MODULE_DIRECTORY}/${PYLIB_SO_NAME})
   set_directory_properties(PROPERTIES ADDITIONAL_MAKE_CLEAN_FILES "${AMCF}") 
-endfunction(wrap_python)
\ No newline at end of file
+endfunction(wrap_python)
+
+# Generates a Boost.Python module from an interface header, like the MATLAB
+# wrapper in GtsamMatlabWrap.cmake, and builds it with wrap_python.  Matrix
+# and Vector arguments and results are exchanged with NumPy through the buffer
+# protocol, see wrap/python.h.
+# Arguments:
+#  interfaceHeader:          The relative path to the interface definition file, e.g. "../gtsam.h"
+#  PYTHON_MODULE_DIRECTORY:  The directory the module library is copied to
+#  Extra arguments:          Libraries to link the module with
+function(wrap_and_build_python interfaceHeader PYTHON_MODULE_DIRECTORY)
+  get_filename_component(interfaceHeader "${interfaceHeader}" ABSOLUTE)
+  get_filename_component(modulePath "${interfaceHeader}" PATH)
+  get_filename_component(moduleName "${interfaceHeader}" NAME_WE)
+  set(generated_files_path "${PROJECT_BINARY_DIR}/wrap/${moduleName}_python")
+  set(generated_cpp_file "${generated_files_path}/${moduleName}_python.cpp")
+
+  file(MAKE_DIRECTORY "${generated_files_path}")
+  add_custom_command(
+    OUTPUT ${generated_cpp_file}
+    DEPENDS ${interfaceHeader} wrap
+    COMMAND wrap --python ${modulePath} ${moduleName} ${generated_files_path}
+    VERBATIM
+    WORKING_DIRECTORY ${generated_files_path})
+
+  # wrap/python.h is included as <wrap/python.h>
+  include_directories(${PROJECT_SOURCE_DIR})
+  wrap_python(${moduleName}_python ${PYTHON_MODULE_DIRECTORY} ${generated_cpp_file})
+  set_target_properties(${moduleName}_python PROPERTIES OUTPUT_NAME ${moduleName} PREFIX "")
+  if(ARGN)
+    target_link_libraries(${moduleName}_python ${ARGN})
+  endif()
+endfunction(wrap_and_build_python)
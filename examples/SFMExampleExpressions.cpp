@@ -67,12 +67,15 @@ int main(int argc, char* argv[]) {
   // Simulated measurements from each camera pose, adding them to the factor graph
   for (size_t i = 0; i < poses.size(); ++i) {
     Pose3_ x('x', i);
+    // All measurements from this camera need the inverse of its pose, which we make shareable:
+    // when linearizing, it is computed once and reused by all factors of the camera
+    Pose3_ xInverse = inverse(x).shareable();
     SimpleCamera camera(poses[i], K);
     for (size_t j = 0; j < points.size(); ++j) {
       Point2 measurement = camera.project(points[j]);
       // Below an expression for the prediction of the measurement:
       Point3_ p('l', j);
-      Point2_ prediction = uncalibrate(cK, project(transform_to(x, p)));
+      Point2_ prediction = uncalibrate(cK, project(transform_from(xInverse, p)));
       // Again, here we use an ExpressionFactor
       graph.addExpressionFactor(prediction, measurement, measurementNoise);
     }
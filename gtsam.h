@@ -1996,12 +1996,23 @@ virtual class NonlinearOptimizerParams {
   double getAbsoluteErrorTol() const;
   double getErrorTol() const;
   string getVerbosity() const;
+  bool getCacheLinearization() const;
+  int getMaxThreads() const;
+  bool getInexactNewton() const;
+  double getMaxForcingTerm() const;
+  bool getWarmStartIterative() const;
 
   void setMaxIterations(int value);
   void setRelativeErrorTol(double value);
   void setAbsoluteErrorTol(double value);
   void setErrorTol(double value);
   void setVerbosity(string s);
+  void setCacheLinearization(bool value);
+  void setMaxThreads(int value);
+  void setInexactNewton(bool value);
+  void setMaxForcingTerm(double value);
+  void setWarmStartIterative(bool value);
+  void setRelinearizeThreshold(double value);
 
   string getLinearSolverType() const;
   
@@ -2011,6 +2022,8 @@ virtual class NonlinearOptimizerParams {
 
   bool isMultifrontal() const;
   bool isSequential() const;
+  bool isMixedPrecision() const;
+  bool isSchurComplement() const;
   bool isCholmod() const;
   bool isIterative() const;
 };
@@ -2031,11 +2044,13 @@ virtual class LevenbergMarquardtParams : gtsam::NonlinearOptimizerParams {
   double getlambdaInitial() const;
   double getlambdaFactor() const;
   double getlambdaUpperBound() const;
+  size_t getParallelLambdaTrials() const;
   string getVerbosityLM() const;
 
   void setlambdaInitial(double value);
   void setlambdaFactor(double value);
   void setlambdaUpperBound(double value);
+  void setParallelLambdaTrials(size_t value);
   void setVerbosityLM(string s);
 };
 
@@ -2056,6 +2071,7 @@ virtual class NonlinearOptimizer {
   double error() const;
   int iterations() const;
   gtsam::Values values() const;
+  size_t skippedLinearizations() const;
   void iterate() const;
 };
 
@@ -2148,6 +2164,10 @@ class ISAM2Params {
   void setEnableDetailedResults(bool enableDetailedResults);
   bool isEnablePartialRelinearizationCheck() const;
   void setEnablePartialRelinearizationCheck(bool enablePartialRelinearizationCheck);
+  size_t getRelinearizeBudget() const;
+  void setRelinearizeBudget(size_t relinearizeBudget);
+  int getMaxThreads() const;
+  void setMaxThreads(int maxThreads);
 };
 
 class ISAM2Clique {
@@ -2169,6 +2189,7 @@ class ISAM2Result {
   size_t getVariablesRelinearized() const;
   size_t getVariablesReeliminated() const;
   size_t getCliques() const;
+  size_t getRelinearizeQueueDepth() const;
 };
 
 class ISAM2 {
@@ -2211,8 +2232,10 @@ class NonlinearISAM {
   Matrix marginalCovariance(size_t key) const;
   int reorderInterval() const;
   int reorderCounter() const;
+  bool reorderInProgress() const;
   void update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& initialValues);
   void reorder_relinearize();
+  void waitForReorder();
 
   // These might be expensive as instead of a reference the wrapper will make a copy
   gtsam::GaussianISAM bayesTree() const;
@@ -2654,6 +2677,16 @@ namespace utilities {
   Matrix extractPose2(const gtsam::Values& values);
   gtsam::Values allPose3s(gtsam::Values& values);
   Matrix extractPose3(const gtsam::Values& values);
+  void insertPoint2(gtsam::Values& values, Vector J, Matrix points);
+  void insertPoint3(gtsam::Values& values, Vector J, Matrix points);
+  void insertPose2(gtsam::Values& values, Vector J, Matrix poses);
+  void insertPose3(gtsam::Values& values, Vector J, Matrix poses);
+  Matrix extractPoint2(const gtsam::Values& values, Vector J);
+  Matrix extractPoint3(const gtsam::Values& values, Vector J);
+  Matrix extractPose2(const gtsam::Values& values, Vector J);
+  Matrix extractPose3(const gtsam::Values& values, Vector J);
+  void insertBetweenFactorsPose2(gtsam::NonlinearFactorGraph& graph, Vector I, Vector J, Matrix Z, const gtsam::noiseModel::Base* model);
+  void insertBetweenFactorsPose3(gtsam::NonlinearFactorGraph& graph, Vector I, Vector J, Matrix Z, const gtsam::noiseModel::Base* model);
   void perturbPoint2(gtsam::Values& values, double sigma, int seed);
   void perturbPose2 (gtsam::Values& values, double sigmaT, double sigmaR, int seed);
   void perturbPoint3(gtsam::Values& values, double sigma, int seed);
@@ -206,12 +206,27 @@ inline void check_that_malloc_is_allowed()
 {}
 #endif
 
+// GTSAM patch: if EIGEN_ALLOCATION_HOOK names a function, it is called with the size of every
+// heap allocation made through aligned_malloc and conditional_aligned_malloc.  The function is
+// declared here and must be defined by the application, see GTSAM_ENABLE_ALLOCATION_TRACKING.
+#ifdef EIGEN_ALLOCATION_HOOK
+void EIGEN_ALLOCATION_HOOK(std::size_t size);
+inline void call_allocation_hook(std::size_t size)
+{
+  EIGEN_ALLOCATION_HOOK(size);
+}
+#else
+inline void call_allocation_hook(std::size_t)
+{}
+#endif
+
 /** \internal Allocates \a size bytes. The returned pointer is guaranteed to have 16 bytes alignment.
   * On allocation error, the returned pointer is null, and std::bad_alloc is thrown.
   */
 inline void* aligned_malloc(size_t size)
 {
   check_that_malloc_is_allowed();
+  call_allocation_hook(size);
 
   void *result;
   #if !EIGEN_ALIGN
@@ -304,6 +319,7 @@ template<bool Align> inline void* conditional_aligned_malloc(size_t size)
 template<> inline void* conditional_aligned_malloc<false>(size_t size)
 {
   check_that_malloc_is_allowed();
+  call_allocation_hook(size);
 
   void *result = std::malloc(size);
   if(!result && size)
@@ -228,20 +228,17 @@ struct Jet {
 
   // The infinitesimal part.
   //
-  // Note the Eigen::DontAlign bit is needed here because this object
-  // gets allocated on the stack and as part of other arrays and
-  // structs. Forcing the right alignment there is the source of much
-  // pain and suffering. Even if that works, passing Jets around to
-  // functions by value has problems because the C++ ABI does not
-  // guarantee alignment for function arguments.
-  //
-  // Setting the DontAlign bit prevents Eigen from using SSE for the
-  // various operations on Jets. This is a small performance penalty
-  // since the AutoDiff code will still expose much of the code as
-  // statically sized loops to the compiler. But given the subtle
-  // issues that arise due to alignment, especially when dealing with
-  // multiple platforms, it seems to be a trade off worth making.
-  Eigen::Matrix<T, N, 1, Eigen::DontAlign> v;
+  // GTSAM: unlike upstream, the infinitesimal part is not declared with the
+  // Eigen::DontAlign bit, which prevents Eigen from using SIMD for the
+  // arithmetic on Jets.  When N doubles fill whole SIMD packets, v is aligned
+  // and all operations on the derivative lanes are vectorized; otherwise Eigen
+  // does not align it and nothing changes.  Jets are aligned on the stack, as
+  // members and in arrays by the compiler, and on the heap by the operator new
+  // below; they are passed by const reference, as function arguments may not
+  // be aligned on some platforms.  AdaptAutoDiff pads N to whole packets.
+  Eigen::Matrix<T, N, 1> v;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
 
 // Unary +
@@ -622,7 +619,7 @@ template<typename T, int N> inline       Jet<T, N>  ei_atan(const Jet<T, N>& x)
 template<typename T, int N> inline       Jet<T, N>  ei_sinh(const Jet<T, N>& x) { return sinh(x);        }  // NOLINT
 template<typename T, int N> inline       Jet<T, N>  ei_cosh(const Jet<T, N>& x) { return cosh(x);        }  // NOLINT
 template<typename T, int N> inline       Jet<T, N>  ei_tanh(const Jet<T, N>& x) { return tanh(x);        }  // NOLINT
-template<typename T, int N> inline       Jet<T, N>  ei_pow (const Jet<T, N>& x, Jet<T, N> y) { return pow(x, y); }  // NOLINT
+template<typename T, int N> inline       Jet<T, N>  ei_pow (const Jet<T, N>& x, const Jet<T, N>& y) { return pow(x, y); }  // NOLINT
 
 // Note: This has to be in the ceres namespace for argument dependent lookup to
 // function correctly. Otherwise statements like CHECK_LE(x, 2.0) fail with
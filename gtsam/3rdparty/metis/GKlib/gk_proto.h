@@ -260,6 +260,7 @@ GK_MKRANDOM_PROTO(gk_f,   size_t, float)
 GK_MKRANDOM_PROTO(gk_d,   size_t, double)
 GK_MKRANDOM_PROTO(gk_idx, size_t, gk_idx_t)
 GK_MKRANDOM_PROTO(gk_z,   size_t, ssize_t)
+int gk_randlocal(int);
 void gk_randinit(uint64_t);
 uint64_t gk_randint64(void);
 uint32_t gk_randint32(void);
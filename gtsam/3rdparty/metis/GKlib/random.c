@@ -25,9 +25,14 @@ GK_MKRANDOM(gk_z,   size_t, ssize_t)
 
 /*************************************************************************/
 /*! GKlib's built in random number generator for portability across 
-    different architectures */
+    different architectures.
+
+    GTSAM: the generator is always compiled, with its state per thread.
+    Without USE_GKRAND it is only used by threads that called
+    gk_randlocal(1), so that those can run METIS concurrently and still
+    get deterministic results, while all other callers keep using rand()
+    exactly as before. */
 /*************************************************************************/
-#ifdef USE_GKRAND
 /* 
    A C-program for MT19937-64 (2004/9/29 version).
    Coded by Takuji Nishimura and Makoto Matsumoto.
@@ -62,73 +67,86 @@ GK_MKRANDOM(gk_z,   size_t, ssize_t)
 
 
 /* The array for the state vector */
-static uint64_t mt[NN]; 
+static __thread uint64_t mt[NN]; 
 /* mti==NN+1 means mt[NN] is not initialized */
-static int mti=NN+1; 
-#endif /* USE_GKRAND */
+static __thread int mti=NN+1; 
+/* whether this thread uses the generator above instead of rand() */
+#ifdef USE_GKRAND
+static __thread int uselocal=1;
+#else
+static __thread int uselocal=0;
+#endif
+
+/* selects the per-thread generator for the calling thread, returns the
+   previous setting */
+int gk_randlocal(int flag)
+{
+  int old = uselocal;
+  uselocal = flag;
+  return old;
+}
 
 /* initializes mt[NN] with a seed */
 void gk_randinit(uint64_t seed)
 {
-#ifdef USE_GKRAND
-  mt[0] = seed;
-  for (mti=1; mti<NN; mti++) 
-    mt[mti] = (6364136223846793005ULL * (mt[mti-1] ^ (mt[mti-1] >> 62)) + mti);
-#else
-  srand((unsigned int) seed);
-#endif
+  if (uselocal) {
+    mt[0] = seed;
+    for (mti=1; mti<NN; mti++) 
+      mt[mti] = (6364136223846793005ULL * (mt[mti-1] ^ (mt[mti-1] >> 62)) + mti);
+  }
+  else
+    srand((unsigned int) seed);
 }
 
 
 /* generates a random number on [0, 2^64-1]-interval */
 uint64_t gk_randint64(void)
 {
-#ifdef USE_GKRAND
-  int i;
-  unsigned long long x;
-  static uint64_t mag01[2]={0ULL, MATRIX_A};
-
-  if (mti >= NN) { /* generate NN words at one time */
-    /* if init_genrand64() has not been called, */
-    /* a default initial seed is used     */
-    if (mti == NN+1) 
-      gk_randinit(5489ULL); 
-
-    for (i=0; i<NN-MM; i++) {
-      x = (mt[i]&UM)|(mt[i+1]&LM);
-      mt[i] = mt[i+MM] ^ (x>>1) ^ mag01[(int)(x&1ULL)];
-    }
-    for (; i<NN-1; i++) {
-      x = (mt[i]&UM)|(mt[i+1]&LM);
-      mt[i] = mt[i+(MM-NN)] ^ (x>>1) ^ mag01[(int)(x&1ULL)];
+  if (uselocal) {
+    int i;
+    unsigned long long x;
+    static uint64_t mag01[2]={0ULL, MATRIX_A};
+
+    if (mti >= NN) { /* generate NN words at one time */
+      /* if init_genrand64() has not been called, */
+      /* a default initial seed is used     */
+      if (mti == NN+1) 
+        gk_randinit(5489ULL); 
+
+      for (i=0; i<NN-MM; i++) {
+        x = (mt[i]&UM)|(mt[i+1]&LM);
+        mt[i] = mt[i+MM] ^ (x>>1) ^ mag01[(int)(x&1ULL)];
+      }
+      for (; i<NN-1; i++) {
+        x = (mt[i]&UM)|(mt[i+1]&LM);
+        mt[i] = mt[i+(MM-NN)] ^ (x>>1) ^ mag01[(int)(x&1ULL)];
+      }
+      x = (mt[NN-1]&UM)|(mt[0]&LM);
+      mt[NN-1] = mt[MM-1] ^ (x>>1) ^ mag01[(int)(x&1ULL)];
+
+      mti = 0;
     }
-    x = (mt[NN-1]&UM)|(mt[0]&LM);
-    mt[NN-1] = mt[MM-1] ^ (x>>1) ^ mag01[(int)(x&1ULL)];
 
-    mti = 0;
-  }
-
-  x = mt[mti++];
+    x = mt[mti++];
 
-  x ^= (x >> 29) & 0x5555555555555555ULL;
-  x ^= (x << 17) & 0x71D67FFFEDA60000ULL;
-  x ^= (x << 37) & 0xFFF7EEE000000000ULL;
-  x ^= (x >> 43);
+    x ^= (x >> 29) & 0x5555555555555555ULL;
+    x ^= (x << 17) & 0x71D67FFFEDA60000ULL;
+    x ^= (x << 37) & 0xFFF7EEE000000000ULL;
+    x ^= (x >> 43);
 
-  return x & 0x7FFFFFFFFFFFFFFF;
-#else
-  return (uint64_t)(((uint64_t) rand()) << 32 | ((uint64_t) rand()));
-#endif
+    return x & 0x7FFFFFFFFFFFFFFF;
+  }
+  else
+    return (uint64_t)(((uint64_t) rand()) << 32 | ((uint64_t) rand()));
 }
 
 /* generates a random number on [0, 2^32-1]-interval */
 uint32_t gk_randint32(void)
 {
-#ifdef USE_GKRAND
-  return (uint32_t)(gk_randint64() & 0x7FFFFFFF);
-#else
-  return (uint32_t)rand();
-#endif
+  if (uselocal)
+    return (uint32_t)(gk_randint64() & 0x7FFFFFFF);
+  else
+    return (uint32_t)rand();
 }
 
 
@@ -226,6 +226,8 @@ METIS_API(int) METIS_Free(void *ptr);
 
 METIS_API(int) METIS_SetDefaultOptions(idx_t *options);
 
+METIS_API(int) METIS_SetThreadLocalRandom(int enable);
+
 
 /* These functions are used by ParMETIS */
 
@@ -41,3 +41,19 @@ int METIS_SetDefaultOptions(idx_t *options)
 }
 
 
+
+/*************************************************************************/
+/*! GTSAM addition: selects a random number generator with per-thread 
+    state for the METIS calls made by the calling thread, instead of the
+    process-wide rand(). Threads that enable it can call METIS concurrently,
+    and since every call reseeds the generator, their results do not depend
+    on which thread makes the call. 
+
+    \param enable is 1 to use the per-thread generator, 0 for rand().
+    \returns the previous setting.
+*/
+/*************************************************************************/
+int METIS_SetThreadLocalRandom(int enable)
+{
+  return gk_randlocal(enable);
+}
@@ -0,0 +1,164 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BlockMatrixArena.cpp
+ * @brief   Opt-in recycling of the dense storage of block matrices during elimination
+ * @date    Oct 14, 2026
+ */
+
+#include <gtsam/base/BlockMatrixArena.h>
+#include <gtsam/base/SymmetricBlockMatrix.h>
+#include <gtsam/base/VerticalBlockMatrix.h>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+#include <map>
+
+namespace gtsam {
+
+namespace {
+
+// Storage cached by one thread, keyed on the number of matrix entries
+struct ThreadCache {
+  typedef std::multimap<DenseIndex, Matrix> Storage;
+  Storage storage;
+  size_t bytes;
+  size_t generation;
+  ThreadCache() : bytes(0), generation(0) {}
+  void clear(size_t currentGeneration) {
+    storage.clear();
+    bytes = 0;
+    generation = currentGeneration;
+  }
+};
+
+boost::atomic<bool> arenaEnabled(false);
+boost::atomic<size_t> maxCachedBytes(256 * 1024 * 1024);
+boost::atomic<int> openScopes(0);
+boost::atomic<size_t> generation(0); // Incremented each time the outermost Scope closes
+boost::mutex scopeMutex;
+boost::thread_specific_ptr<ThreadCache> threadCache;
+
+// Retrieve the cache of the calling thread, releasing it if it is left over from a previous scope
+ThreadCache& currentCache() {
+  ThreadCache* cache = threadCache.get();
+  if (!cache) {
+    cache = new ThreadCache();
+    cache->generation = generation.load();
+    threadCache.reset(cache);
+  } else if (cache->generation != generation.load()) {
+    cache->clear(generation.load());
+  }
+  return *cache;
+}
+
+}
+
+/* ************************************************************************* */
+BlockMatrixArena::Scope::Scope() : opened_(false) {
+  if (arenaEnabled.load()) {
+    boost::mutex::scoped_lock lock(scopeMutex);
+    ++openScopes;
+    opened_ = true;
+  }
+}
+
+/* ************************************************************************* */
+BlockMatrixArena::Scope::~Scope() {
+  if (opened_) {
+    boost::mutex::scoped_lock lock(scopeMutex);
+    if (--openScopes == 0) {
+      ++generation;
+      if (threadCache.get())
+        threadCache->clear(generation.load());
+    }
+  }
+}
+
+/* ************************************************************************* */
+void BlockMatrixArena::SetEnabled(bool enabled) {
+  arenaEnabled = enabled;
+}
+
+/* ************************************************************************* */
+bool BlockMatrixArena::Enabled() {
+  return arenaEnabled.load();
+}
+
+/* ************************************************************************* */
+void BlockMatrixArena::SetMaxCachedBytes(size_t maxBytes) {
+  maxCachedBytes = maxBytes;
+}
+
+/* ************************************************************************* */
+bool BlockMatrixArena::Active() {
+  return openScopes.load() > 0;
+}
+
+/* ************************************************************************* */
+size_t BlockMatrixArena::CachedBytes() {
+  return threadCache.get() ? currentCache().bytes : 0;
+}
+
+/* ************************************************************************* */
+void BlockMatrixArena::Allocate(Matrix& matrix, DenseIndex rows, DenseIndex cols) {
+  const DenseIndex size = rows * cols;
+  if (Active() && size > 0 && matrix.size() != size) {
+    ThreadCache& cache = currentCache();
+    ThreadCache::Storage::iterator cached = cache.storage.find(size);
+    if (cached != cache.storage.end()) {
+      matrix.swap(cached->second);
+      cache.bytes -= size * sizeof(double);
+      cache.storage.erase(cached);
+    }
+  }
+  // Does not reallocate if the number of entries already matches
+  matrix.resize(rows, cols);
+}
+
+/* ************************************************************************* */
+void BlockMatrixArena::Recycle(Matrix& matrix) {
+  const size_t bytes = matrix.size() * sizeof(double);
+  if (Active() && bytes > 0) {
+    ThreadCache& cache = currentCache();
+    if (cache.bytes + bytes <= maxCachedBytes.load()) {
+      cache.storage.insert(std::make_pair(matrix.size(), Matrix()))->second.swap(matrix);
+      cache.bytes += bytes;
+    }
+  }
+}
+
+/* ************************************************************************* */
+void BlockMatrixArena::Recycle(SymmetricBlockMatrix& matrix) {
+  if (Active()) {
+    Recycle(matrix.matrix_);
+    matrix.matrix_.resize(0, 0);
+    matrix.variableColOffsets_.assign(1, 0);
+    matrix.blockStart_ = 0;
+  }
+}
+
+/* ************************************************************************* */
+void BlockMatrixArena::Recycle(VerticalBlockMatrix& matrix) {
+  if (Active()) {
+    Recycle(matrix.matrix_);
+    matrix.matrix_.resize(0, 0);
+    matrix.variableColOffsets_.assign(1, 0);
+    matrix.rowStart_ = 0;
+    matrix.rowEnd_ = 0;
+    matrix.blockStart_ = 0;
+  }
+}
+
+}
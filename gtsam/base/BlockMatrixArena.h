@@ -0,0 +1,96 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BlockMatrixArena.h
+ * @brief   Opt-in recycling of the dense storage of block matrices during elimination
+ * @date    Oct 14, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+#include <gtsam/dllexport.h>
+#include <cstddef>
+
+namespace gtsam {
+
+  // Forward declarations
+  class SymmetricBlockMatrix;
+  class VerticalBlockMatrix;
+
+  /**
+   * An opt-in, per-thread cache of the dense storage used by SymmetricBlockMatrix and
+   * VerticalBlockMatrix.
+   *
+   * Every frontal elimination step allocates new block matrices for the joint factor and the
+   * conditional, and the remaining factors passed up the tree are freed again as soon as the
+   * parent clique has been eliminated.  While the arena is enabled and a Scope is open, the
+   * storage of block matrices owned by destroyed HessianFactor and JacobianFactor objects is
+   * kept in a cache local to the destroying thread, and is handed out again to new block
+   * matrices with the same number of entries instead of going back to the heap.  All storage
+   * cached by the calling thread is released when the outermost Scope closes, and the caches of
+   * other threads (e.g. TBB workers) are released the next time they touch the arena.
+   *
+   * The arena is disabled by default, use SetEnabled(true) to turn it on.  EliminationTree and
+   * ClusterTree (and thus JunctionTree) elimination open a Scope themselves.
+   *
+   * @addtogroup base */
+  class GTSAM_EXPORT BlockMatrixArena
+  {
+  public:
+    /** While an object of this class is alive and the arena is enabled, block matrix storage is
+     *  recycled through the arena.  Scopes may be nested, the cache is released when the
+     *  outermost Scope is destroyed. */
+    class GTSAM_EXPORT Scope
+    {
+    public:
+      Scope();
+      ~Scope();
+
+    private:
+      bool opened_; ///< Whether this Scope was opened while the arena was enabled
+      Scope(const Scope&);
+      Scope& operator=(const Scope&);
+    };
+
+    /// Enable or disable the arena (default: disabled).  Takes effect for Scopes opened afterwards.
+    static void SetEnabled(bool enabled);
+
+    /// Whether the arena is enabled
+    static bool Enabled();
+
+    /// Set the maximum number of bytes cached per thread (default: 256 MB)
+    static void SetMaxCachedBytes(size_t maxBytes);
+
+    /// Whether storage is currently being recycled, i.e. the arena is enabled and a Scope is open
+    static bool Active();
+
+    /// Number of bytes currently cached by the calling thread
+    static size_t CachedBytes();
+
+    /// Resize \c matrix to \c rows x \c cols, taking the storage from the cache if a matrix with
+    /// the same number of entries has been recycled.  Equivalent to matrix.resize(rows, cols)
+    /// when the arena is not active.
+    static void Allocate(Matrix& matrix, DenseIndex rows, DenseIndex cols);
+
+    /// Move the storage of \c matrix into the cache, leaving \c matrix empty.  Does nothing if the
+    /// arena is not active or the cache is full.
+    static void Recycle(Matrix& matrix);
+
+    /// Move the storage of \c matrix into the cache, leaving an empty SymmetricBlockMatrix.
+    static void Recycle(SymmetricBlockMatrix& matrix);
+
+    /// Move the storage of \c matrix into the cache, leaving an empty VerticalBlockMatrix.
+    static void Recycle(VerticalBlockMatrix& matrix);
+  };
+
+}
@@ -0,0 +1,120 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file DSFConcurrent.cpp
+ * @date Oct 14, 2026
+ * @brief A disjoint set forest that can be merged from several threads at once
+ */
+
+#include <gtsam/base/DSFConcurrent.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+DSFConcurrent::DSFConcurrent(size_t numNodes) :
+    size_(numNodes), parents_(new boost::atomic<size_t>[numNodes]) {
+  for (size_t i = 0; i < numNodes; ++i)
+    parents_[i].store(i, boost::memory_order_relaxed);
+}
+
+/* ************************************************************************* */
+size_t DSFConcurrent::find(size_t key) const {
+  // Path halving: make every other node on the path point to its grandparent.  A failed
+  // compare-and-swap only means another thread shortened the path first.
+  size_t parent = parents_[key].load(boost::memory_order_acquire);
+  while (parent != key) {
+    size_t grandparent = parents_[parent].load(boost::memory_order_acquire);
+    if (grandparent != parent)
+      parents_[key].compare_exchange_weak(parent, grandparent, boost::memory_order_release,
+          boost::memory_order_relaxed);
+    key = grandparent;
+    parent = parents_[key].load(boost::memory_order_acquire);
+  }
+  return key;
+}
+
+/* ************************************************************************* */
+bool DSFConcurrent::merge(size_t i1, size_t i2) {
+  while (true) {
+    size_t root1 = find(i1), root2 = find(i2);
+    if (root1 == root2)
+      return false;
+    // Link the larger root below the smaller one.  This fails if root1 got a parent since we
+    // found it, in which case we look up the roots again.
+    if (root1 < root2)
+      std::swap(root1, root2);
+    size_t expected = root1;
+    if (parents_[root1].compare_exchange_strong(expected, root2, boost::memory_order_acq_rel))
+      return true;
+  }
+}
+
+/* ************************************************************************* */
+#ifdef GTSAM_USE_TBB
+namespace {
+class MergeEdges {
+  DSFConcurrent& dsf_;
+  const DSFConcurrent::Edges& edges_;
+public:
+  MergeEdges(DSFConcurrent& dsf, const DSFConcurrent::Edges& edges) :
+      dsf_(dsf), edges_(edges) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& range) const {
+    for (size_t k = range.begin(); k != range.end(); ++k)
+      dsf_.merge(edges_[k].first, edges_[k].second);
+  }
+};
+}
+#endif
+
+/* ************************************************************************* */
+void DSFConcurrent::merge(const Edges& edges, size_t grainSize) {
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, edges.size(), std::max(grainSize, size_t(1))),
+      MergeEdges(*this, edges));
+#else
+  for (size_t k = 0; k < edges.size(); ++k)
+    merge(edges[k].first, edges[k].second);
+#endif
+}
+
+/* ************************************************************************* */
+vector<size_t> DSFConcurrent::labels() const {
+  vector<size_t> labels(size_);
+  // Roots have smaller indices than their descendants, so labels of parents are known first
+  for (size_t i = 0; i < size_; ++i) {
+    const size_t parent = parents_[i].load(boost::memory_order_acquire);
+    labels[i] = (parent == i) ? i : labels[parent];
+  }
+  return labels;
+}
+
+/* ************************************************************************* */
+map<size_t, vector<size_t> > DSFConcurrent::arrays() const {
+  map<size_t, vector<size_t> > arrays;
+  const vector<size_t> labels = this->labels();
+  for (size_t i = 0; i < size_; ++i)
+    arrays[labels[i]].push_back(i);
+  return arrays;
+}
+
+} // namespace gtsam
@@ -0,0 +1,73 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file DSFConcurrent.h
+ * @date Oct 14, 2026
+ * @brief A disjoint set forest that can be merged from several threads at once
+ */
+
+#pragma once
+
+#include <gtsam/global_includes.h>
+#include <boost/atomic.hpp>
+#include <boost/shared_array.hpp>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * A disjoint set forest on the keys 0...numNodes-1, like DSFBase, in which find and merge can be
+ * called concurrently without locks.  Parent links are atomic and only ever changed with
+ * compare-and-swap: find() shortens paths by path halving, and merge() links the root with the
+ * larger index below the root with the smaller index.  Hence the label of each set is its
+ * smallest key, independent of the order in which merges happen.
+ *
+ * merge(const Edges&) merges a whole list of edges, in parallel when GTSAM is built with TBB,
+ * e.g. to build feature tracks from a large number of matches.
+ * @addtogroup base
+ */
+class GTSAM_EXPORT DSFConcurrent {
+
+public:
+  typedef std::pair<size_t, size_t> Edge; ///< A pair of keys to merge
+  typedef std::vector<Edge> Edges; ///< A list of pairs of keys to merge
+
+private:
+  size_t size_; ///< Number of keys
+  boost::shared_array<boost::atomic<size_t> > parents_; ///< Parent pointers, root iff parent[i]==i
+
+public:
+  /// Constructor, allows for keys 0...numNodes-1
+  explicit DSFConcurrent(size_t numNodes);
+
+  /// Number of keys
+  size_t size() const { return size_; }
+
+  /// Find the label of the set in which {key} lives, the smallest key in the set
+  size_t find(size_t key) const;
+
+  /// Merge two sets, returns false if they were already the same set
+  bool merge(size_t i1, size_t i2);
+
+  /// Merge the sets of all edges, in parallel if GTSAM is built with TBB
+  void merge(const Edges& edges, size_t grainSize = 10000);
+
+  /// Return the label of each key
+  std::vector<size_t> labels() const;
+
+  /// Return all sets, i.e. a partition of all keys
+  std::map<size_t, std::vector<size_t> > arrays() const;
+};
+
+}
@@ -107,6 +107,11 @@ public:
     return (static_cast<const DERIVED*>(this))->localCoordinates(derivedValue2);
   }
 
+  /// Return the memory used by this value, without heap storage of the derived class
+  virtual size_t memoryUsage() const {
+    return sizeof(DERIVED);
+  }
+
   /// Assignment operator
   virtual Value& operator=(const Value& rhs) {
     // Cast the base class Value pointer to a derived class pointer
@@ -18,6 +18,7 @@
 
 #pragma once
 #include <gtsam/config.h>      // Configuration from CMake
+#include <gtsam/dllexport.h>
 
 #if !defined GTSAM_ALLOCATOR_BOOSTPOOL && !defined GTSAM_ALLOCATOR_TBB && !defined GTSAM_ALLOCATOR_STL
 #  ifdef GTSAM_USE_TBB
@@ -53,31 +54,69 @@
 #endif
 //////////////////
 
+#ifdef GTSAM_ENABLE_ALLOCATION_TRACKING
+#  include <cstddef>
+#  include <memory>
+#endif
 
 namespace gtsam
 {
 
   namespace internal
   {
+#ifdef GTSAM_ENABLE_ALLOCATION_TRACKING
+    /// Count an allocation of the given size, see allocation tracking in timing.h
+    GTSAM_EXPORT void recordAllocation(std::size_t bytes);
+
+    /// Allocator adaptor that counts allocations before forwarding them to ALLOCATOR, so that
+    /// pool allocations which never reach operator new are counted too
+    template<typename T, class ALLOCATOR>
+    struct CountingAllocator : public ALLOCATOR
+    {
+      typedef std::allocator_traits<ALLOCATOR> Traits;
+      typedef typename Traits::value_type value_type;
+      typedef typename Traits::pointer pointer;
+      typedef typename Traits::size_type size_type;
+      template<typename U> struct rebind {
+        typedef CountingAllocator<U, typename Traits::template rebind_alloc<U> > other;
+      };
+
+      CountingAllocator() {}
+      CountingAllocator(const ALLOCATOR& allocator) : ALLOCATOR(allocator) {}
+      template<typename U, class OTHER>
+      CountingAllocator(const CountingAllocator<U, OTHER>& other) : ALLOCATOR(other) {}
+
+      pointer allocate(size_type n, const void* = 0) {
+        recordAllocation(n * sizeof(value_type));
+        return Traits::allocate(*this, n);
+      }
+    };
+#endif
+
     /// Default allocator for list, map, and set types
     template<typename T>
     struct FastDefaultAllocator
     {
 #if defined GTSAM_ALLOCATOR_BOOSTPOOL
-      typedef boost::fast_pool_allocator<T> type;
+      typedef boost::fast_pool_allocator<T> base;
       static const bool isBoost = true;
       static const bool isTBB = false;
       static const bool isSTL = false;
 #elif defined GTSAM_ALLOCATOR_TBB
-      typedef tbb::tbb_allocator<T> type;
+      typedef tbb::tbb_allocator<T> base;
       static const bool isBoost = false;
       static const bool isTBB = true;
       static const bool isSTL = false;
 #elif defined GTSAM_ALLOCATOR_STL
-      typedef std::allocator<T> type;
+      typedef std::allocator<T> base;
       static const bool isBoost = false;
       static const bool isTBB = false;
       static const bool isSTL = true;
+#endif
+#if defined GTSAM_ENABLE_ALLOCATION_TRACKING && !defined GTSAM_ALLOCATOR_STL
+      typedef CountingAllocator<T, base> type; // std::allocator is counted in operator new
+#else
+      typedef base type;
 #endif
     };
 
@@ -86,7 +125,11 @@ namespace gtsam
     struct FastDefaultVectorAllocator
     {
 #if defined GTSAM_ALLOCATOR_TBB
+#  ifdef GTSAM_ENABLE_ALLOCATION_TRACKING
+      typedef CountingAllocator<T, tbb::tbb_allocator<T> > type;
+#  else
       typedef tbb::tbb_allocator<T> type;
+#  endif
       static const bool isBoost = false;
       static const bool isTBB = true;
       static const bool isSTL = false;
@@ -0,0 +1,289 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FlatKeyMap.h
+ * @brief   An open-addressing hash map from Key to values, with contiguous storage
+ * @date    Oct 14, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/FastVector.h>
+#include <gtsam/base/types.h>
+#include <gtsam/config.h> // for GTSAM_USE_FLAT_KEYMAP
+
+#include <boost/cstdint.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/utility.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace gtsam {
+
+/**
+ * FlatKeyMap is a map from Key to VALUE with the same interface as FastMap for the operations
+ * used in inference, implemented as an open-addressing hash table (linear probing) over a
+ * contiguous vector of entries.  Lookups touch one or two cache lines instead of chasing the
+ * pointers of a red-black tree, which matters when building and querying maps with many keys
+ * during symbolic elimination.
+ *
+ * Entries are iterated in insertion order, not sorted by key like FastMap.  Call sortByKey()
+ * once the map is built to iterate in key order.  As in std::vector, inserting (and erasing)
+ * invalidates iterators, and erasing moves the last entry into the erased position.
+ * @addtogroup base
+ */
+template<typename VALUE>
+class FlatKeyMap {
+
+public:
+
+  typedef Key key_type;
+  typedef VALUE mapped_type;
+  typedef std::pair<Key, VALUE> value_type;
+
+private:
+
+  typedef FastVector<value_type> Entries;
+
+public:
+
+  typedef typename Entries::iterator iterator;
+  typedef typename Entries::const_iterator const_iterator;
+  typedef typename Entries::size_type size_type;
+
+private:
+
+  Entries entries_; ///< The entries, contiguous and in insertion order
+  FastVector<size_t> table_; ///< 1 + the index in entries_ of the entry in each bucket, 0 if empty
+  size_t shift_; ///< 64 - log2(table_.size())
+
+public:
+
+  /** Default constructor */
+  FlatKeyMap() : shift_(64) {}
+
+  /** Constructor from a range of (Key, VALUE) pairs */
+  template<typename INPUTITERATOR>
+  explicit FlatKeyMap(INPUTITERATOR first, INPUTITERATOR last) : shift_(64) {
+    insert(first, last);
+  }
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+
+  size_type size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+  /** Reserve space for n entries, so that no rehashing takes place until that size */
+  void reserve(size_t n) {
+    entries_.reserve(n);
+    if (2 * n > table_.size())
+      rehash(2 * n);
+  }
+
+  void clear() {
+    entries_.clear();
+    std::fill(table_.begin(), table_.end(), 0);
+  }
+
+  void swap(FlatKeyMap& other) {
+    entries_.swap(other.entries_);
+    table_.swap(other.table_);
+    std::swap(shift_, other.shift_);
+  }
+
+  iterator find(Key key) {
+    const size_t bucket = findBucket(key);
+    return (bucket == npos() || !table_[bucket]) ? end() : entries_.begin() + (table_[bucket] - 1);
+  }
+
+  const_iterator find(Key key) const {
+    const size_t bucket = findBucket(key);
+    return (bucket == npos() || !table_[bucket]) ? end() : entries_.begin() + (table_[bucket] - 1);
+  }
+
+  size_type count(Key key) const { return find(key) == end() ? 0 : 1; }
+
+  /** Handy 'exists' function */
+  bool exists(Key key) const { return find(key) != end(); }
+
+  VALUE& at(Key key) {
+    iterator it = find(key);
+    if (it == end())
+      throw std::out_of_range("FlatKeyMap::at: key not found");
+    return it->second;
+  }
+
+  const VALUE& at(Key key) const {
+    const_iterator it = find(key);
+    if (it == end())
+      throw std::out_of_range("FlatKeyMap::at: key not found");
+    return it->second;
+  }
+
+  VALUE& operator[](Key key) {
+    return insert(value_type(key, VALUE())).first->second;
+  }
+
+  /** Insert an entry if the key is not already present, returns the entry and whether it was
+   *  inserted */
+  std::pair<iterator, bool> insert(const value_type& entry) {
+    // Keep the load factor at most 1/2
+    if (2 * (entries_.size() + 1) > table_.size())
+      rehash(2 * (entries_.size() + 1));
+    const size_t bucket = findBucket(entry.first);
+    if (table_[bucket])
+      return std::make_pair(entries_.begin() + (table_[bucket] - 1), false);
+    entries_.push_back(entry);
+    table_[bucket] = entries_.size();
+    return std::make_pair(entries_.end() - 1, true);
+  }
+
+  template<typename INPUTITERATOR>
+  void insert(INPUTITERATOR first, INPUTITERATOR last) {
+    for (; first != last; ++first)
+      insert(value_type(first->first, first->second));
+  }
+
+  /** Handy 'insert' function for Matlab wrapper */
+  bool insert2(Key key, const VALUE& val) { return insert(value_type(key, val)).second; }
+
+  /** Erase the entry with the given key, returns the number of erased entries */
+  size_type erase(Key key) {
+    const size_t bucket = findBucket(key);
+    if (bucket == npos() || !table_[bucket])
+      return 0;
+    const size_t index = table_[bucket] - 1;
+    removeBucket(bucket);
+    // Move the last entry into the hole
+    if (index != entries_.size() - 1) {
+      table_[findBucket(entries_.back().first)] = index + 1;
+      entries_[index] = entries_.back();
+    }
+    entries_.pop_back();
+    return 1;
+  }
+
+  void erase(iterator it) { erase(it->first); }
+
+  /** Sort the entries by key, e.g. to iterate in the same order as FastMap */
+  void sortByKey() {
+    std::sort(entries_.begin(), entries_.end(), CompareKeys());
+    rehash(table_.size());
+  }
+
+  /** Conversion to a FastMap */
+  operator FastMap<Key, VALUE>() const {
+    return FastMap<Key, VALUE>(begin(), end());
+  }
+
+  /** Equality of the contents, regardless of the order of insertion */
+  bool operator==(const FlatKeyMap& other) const {
+    if (size() != other.size())
+      return false;
+    for (const_iterator it = begin(); it != end(); ++it) {
+      const_iterator match = other.find(it->first);
+      if (match == other.end() || !(match->second == it->second))
+        return false;
+    }
+    return true;
+  }
+
+  bool operator!=(const FlatKeyMap& other) const { return !(*this == other); }
+
+private:
+
+  struct CompareKeys {
+    bool operator()(const value_type& a, const value_type& b) const { return a.first < b.first; }
+  };
+
+  static size_t npos() { return size_t(-1); }
+
+  /** Fibonacci hashing, the high bits of the product are well mixed even for sequential keys */
+  size_t hash(Key key) const {
+    return size_t((boost::uint64_t(key) * 11400714819323198485ull) >> shift_);
+  }
+
+  /** Bucket containing key, or the empty bucket where it would be inserted, npos if no table */
+  size_t findBucket(Key key) const {
+    if (table_.empty())
+      return npos();
+    const size_t mask = table_.size() - 1;
+    size_t bucket = hash(key);
+    while (table_[bucket] && entries_[table_[bucket] - 1].first != key)
+      bucket = (bucket + 1) & mask;
+    return bucket;
+  }
+
+  /** Empty a bucket, shifting back later entries of the probe sequence so lookups still work */
+  void removeBucket(size_t bucket) {
+    const size_t mask = table_.size() - 1;
+    size_t next = (bucket + 1) & mask;
+    while (table_[next]) {
+      const size_t home = hash(entries_[table_[next] - 1].first);
+      // Move the entry in 'next' into the hole unless its home lies cyclically in (bucket, next]
+      if (((next - home) & mask) >= ((next - bucket) & mask)) {
+        table_[bucket] = table_[next];
+        bucket = next;
+      }
+      next = (next + 1) & mask;
+    }
+    table_[bucket] = 0;
+  }
+
+  /** Rebuild the table with at least minBuckets buckets (a power of two, at least 8) */
+  void rehash(size_t minBuckets) {
+    size_t nBuckets = 8;
+    size_t shift = 61;
+    while (nBuckets < minBuckets) {
+      nBuckets *= 2;
+      --shift;
+    }
+    table_.assign(nBuckets, 0);
+    shift_ = shift;
+    for (size_t i = 0; i < entries_.size(); ++i)
+      table_[findBucket(entries_[i].first)] = i + 1;
+  }
+
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template<class ARCHIVE>
+  void save(ARCHIVE & ar, const unsigned int /*version*/) const {
+    ar & BOOST_SERIALIZATION_NVP(entries_);
+  }
+  template<class ARCHIVE>
+  void load(ARCHIVE & ar, const unsigned int /*version*/) {
+    ar & BOOST_SERIALIZATION_NVP(entries_);
+    rehash(2 * entries_.size());
+  }
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
+};
+
+/**
+ * The map from Key to VALUE used in hot inference paths (VariableSlots, Ordering::invert).  This
+ * is a FlatKeyMap if GTSAM is configured with GTSAM_USE_FLAT_KEYMAP, and a FastMap otherwise.
+ */
+template<typename VALUE>
+struct KeyMap {
+#ifdef GTSAM_USE_FLAT_KEYMAP
+  typedef FlatKeyMap<VALUE> type;
+#else
+  typedef FastMap<Key, VALUE> type;
+#endif
+};
+
+}
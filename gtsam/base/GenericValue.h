@@ -20,13 +20,16 @@
 #pragma once
 
 #include <gtsam/base/Manifold.h>
+#include <gtsam/base/MemoryUsage.h>
 #include <gtsam/base/Value.h>
 
 #include <boost/make_shared.hpp>
+#include <boost/mpl/bool.hpp>
 #include <boost/pool/pool_alloc.hpp>
 
 #include <cmath>
 #include <iosfwd>
+#include <vector>
 #include <typeinfo> // operator typeid
 
 namespace gtsam {
@@ -47,11 +50,13 @@ protected:
 
 public:
   // Only needed for serialization.
-  GenericValue(){}
+  GenericValue() :
+      Value(&internal::TypeTag<GenericValue>::id) {
+  }
 
   /// Construct from value
   GenericValue(const T& value) :
-      value_(value) {
+      Value(&internal::TypeTag<GenericValue>::id), value_(value) {
   }
 
   /// Return a constant value
@@ -127,6 +132,17 @@ public:
       return resultAsValue;
     }
 
+    /// Generic Value interface version of retractBatch_, see internal::BatchRetract
+    virtual void retractBatch_(const Value* const* values, const Vector* const* deltas, size_t n,
+        Value** result) const {
+      retractBatch(values, deltas, n, result, boost::mpl::bool_<internal::BatchRetract<T>::value>());
+    }
+
+    /// Generic Value interface version of in-place retract, allocates nothing
+    virtual void retractInPlace_(const Vector& delta) {
+      value_ = traits<T>::Retract(value_, delta);
+    }
+
     /// Generic Value interface version of localCoordinates
     virtual Vector localCoordinates_(const Value& value2) const {
       // Cast the base class Value pointer to a templated generic class pointer
@@ -152,6 +168,11 @@ public:
       return traits<T>::GetDimension(value_);
     }
 
+    /// Return the memory used by this value, including a dynamic-size matrix or vector
+    virtual size_t memoryUsage() const {
+      return sizeof(*this) + heapBytes(value_);
+    }
+
     /// Assignment operator
     virtual Value& operator=(const Value& rhs) {
       // Cast the base class Value pointer to a derived class pointer
@@ -178,6 +199,26 @@ public:
     struct PoolTag {
     };
 
+    /// Retract one value at a time, T has no batch retraction
+    void retractBatch(const Value* const* values, const Vector* const* deltas, size_t n,
+        Value** result, boost::mpl::false_) const {
+      Value::retractBatch_(values, deltas, n, result);
+    }
+
+    /// Retract all values with internal::BatchRetract<T>
+    void retractBatch(const Value* const* values, const Vector* const* deltas, size_t n,
+        Value** result, boost::mpl::true_) const {
+      std::vector<const T*> inputs(n);
+      for (size_t i = 0; i < n; ++i)
+        inputs[i] = &static_cast<const GenericValue&>(*values[i]).value();
+      std::vector<T> retracted(n);
+      internal::BatchRetract<T>::Retract(&inputs[0], deltas, n, &retracted[0]);
+      for (size_t i = 0; i < n; ++i) {
+        void* place = boost::singleton_pool<PoolTag, sizeof(GenericValue)>::malloc();
+        result[i] = new (place) GenericValue(retracted[i]);
+      }
+    }
+
   private:
 
     /** Serialization function */
@@ -202,6 +243,8 @@ struct traits<GenericValue<ValueType> >
 // define Value::cast here since now GenericValue has been declared
 template<typename ValueType>
 const ValueType& Value::cast() const {
+  if (typeTag_ == &internal::TypeTag<GenericValue<ValueType> >::id)
+    return static_cast<const GenericValue<ValueType>&>(*this).value();
   return dynamic_cast<const GenericValue<ValueType>&>(*this).value();
 }
 
@@ -54,6 +54,17 @@ template <typename T> struct traits;
 
 namespace internal {
 
+/**
+ * Retracts many values of type T at once, see Value::retractBatch_.  Types that retract faster
+ * in batches than one traits<T>::Retract call at a time, e.g. Pose3, specialize this with
+ * \c value true and a static function
+ * <tt>Retract(const T* const* values, const Vector* const* deltas, size_t n, T* result)</tt>.
+ */
+template<class T>
+struct BatchRetract {
+  static const bool value = false;
+};
+
 /// Requirements on type to pass it to Manifold template below
 template<class Class>
 struct HasManifoldPrereqs {
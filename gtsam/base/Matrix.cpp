@@ -23,6 +23,11 @@
 #include <Eigen/SVD>
 #include <Eigen/LU>
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
+
 #include <boost/foreach.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/tokenizer.hpp>
@@ -549,8 +554,8 @@ void vector_scale_inplace(const Vector& v, Matrix& A, bool inf_mask) {
         A.row(i) *= vi;
     }
   } else {
-    for (DenseIndex i=0; i<m; ++i)
-      A.row(i) *= v(i);
+    // Scale column by column, which is contiguous in memory, rather than row by row
+    A.array().colwise() *= v.head(m).array();
   }
 }
 
@@ -703,23 +708,75 @@ std::string formatMatrixIndented(const std::string& label, const Matrix& matrix,
 }
 
 /* ************************************************************************* */
-void inplace_QR(Matrix& A){
-  size_t rows = A.rows();
-  size_t cols = A.cols();
-  size_t size = std::min(rows,cols);
+namespace {
+typedef Eigen::internal::plain_diag_type<Matrix>::type HCoeffsType;
+typedef Eigen::internal::plain_row_type<Matrix>::type RowVectorType;
+
+// Blocked Householder QR of a block of rows, leaving R in its upper triangle
+void blockQR(Eigen::Block<Matrix> A) {
+  HCoeffsType hCoeffs(std::min(A.rows(), A.cols()));
+  RowVectorType temp(A.cols());
+  Eigen::internal::householder_qr_inplace_blocked<Eigen::Block<Matrix>, HCoeffsType>::run(
+      A, hCoeffs, 48, temp.data());
+}
+
+// Row tiles of at least this many rows, and at least 4 times the columns, are factored separately
+static const size_t tsqrMinTileRows = 256;
 
-  typedef Eigen::internal::plain_diag_type<Matrix>::type HCoeffsType;
-  typedef Eigen::internal::plain_row_type<Matrix>::type RowVectorType;
-  HCoeffsType hCoeffs(size);
-  RowVectorType temp(cols);
+#ifdef GTSAM_USE_TBB
+class TileQR {
+  Matrix& A_;
+  size_t tileRows_, nTiles_;
+public:
+  TileQR(Matrix& A, size_t tileRows, size_t nTiles) : A_(A), tileRows_(tileRows), nTiles_(nTiles) {}
+  void operator()(const tbb::blocked_range<size_t>& range) const {
+    for (size_t t = range.begin(); t != range.end(); ++t) {
+      const size_t first = t * tileRows_;
+      const size_t last = (t + 1 == nTiles_) ? size_t(A_.rows()) : first + tileRows_;
+      blockQR(A_.middleRows(first, last - first));
+    }
+  }
+};
+#endif
 
-#ifdef GTSAM_USE_SYSTEM_EIGEN
-  // System-Eigen is used, and MKL is off
-  Eigen::internal::householder_qr_inplace_blocked<Matrix, HCoeffsType>::run(A, hCoeffs, 48, temp.data());
+// Tall-skinny QR: the row tiles are factored independently, in parallel with TBB, and their R
+// factors are stacked and factored again.  Only R is needed by elimination, and it is the same as
+// the R of a QR of the whole matrix, up to the signs of its rows.
+void tiledQR(Matrix& A, size_t tileRows) {
+  gttic(tiledQR);
+  const size_t cols = A.cols(), nTiles = A.rows() / tileRows;
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, nTiles), TileQR(A, tileRows, nTiles));
 #else
-  // Patched Eigen is used, and MKL is either on or off
-  Eigen::internal::householder_qr_inplace_blocked<Matrix, HCoeffsType>::run(A, hCoeffs, 48, temp.data());
+  for (size_t t = 0; t < nTiles; ++t) {
+    const size_t first = t * tileRows;
+    const size_t last = (t + 1 == nTiles) ? size_t(A.rows()) : first + tileRows;
+    blockQR(A.middleRows(first, last - first));
+  }
 #endif
+  // Stack the R factors at the top, each one moves up over rows that are no longer needed
+  for (size_t t = 1; t < nTiles; ++t) {
+    Eigen::Block<Matrix> R = A.middleRows(t * tileRows, cols);
+    R.triangularView<Eigen::StrictlyLower>().setZero();
+    A.middleRows(t * cols, cols) = R;
+  }
+  A.topRows(cols).triangularView<Eigen::StrictlyLower>().setZero();
+  blockQR(A.topRows(nTiles * cols));
+}
+}
+
+/* ************************************************************************* */
+void inplace_QR(Matrix& A){
+  size_t rows = A.rows();
+  size_t cols = A.cols();
+
+  // Tall matrices, like stacked Jacobians, are factored by tiles
+  const size_t tileRows = std::max(tsqrMinTileRows, 4 * cols);
+  if (rows >= 2 * tileRows) {
+    tiledQR(A, tileRows);
+  } else {
+    blockQR(A.topRows(rows));
+  }
 
   zeroBelowDiagonal(A);
 }
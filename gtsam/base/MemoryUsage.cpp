@@ -0,0 +1,57 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    MemoryUsage.cpp
+ * @brief   Accounting of the memory used by graphs, values and solvers
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/base/MemoryUsage.h>
+
+#include <boost/foreach.hpp>
+
+#include <iostream>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+MemoryUsage& MemoryUsage::operator+=(const MemoryUsage& other) {
+  BOOST_FOREACH(const Categories::value_type& category, other.categories_)
+    categories_[category.first] += category.second;
+  return *this;
+}
+
+/* ************************************************************************* */
+size_t MemoryUsage::operator[](const string& category) const {
+  Categories::const_iterator it = categories_.find(category);
+  return it == categories_.end() ? 0 : it->second;
+}
+
+/* ************************************************************************* */
+size_t MemoryUsage::total() const {
+  size_t bytes = 0;
+  BOOST_FOREACH(const Categories::value_type& category, categories_)
+    bytes += category.second;
+  return bytes;
+}
+
+/* ************************************************************************* */
+void MemoryUsage::print(const string& s) const {
+  cout << s << "MemoryUsage: " << total() << " bytes\n";
+  BOOST_FOREACH(const Categories::value_type& category, categories_)
+    cout << "  " << category.first << ": " << category.second << " bytes\n";
+  cout.flush();
+}
+
+} // \namespace gtsam
@@ -0,0 +1,99 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    MemoryUsage.h
+ * @brief   Accounting of the memory used by graphs, values and solvers
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/FastVector.h>
+#include <gtsam/base/Matrix.h>
+#include <gtsam/dllexport.h>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace gtsam {
+
+  /**
+   * The memory used by an object, in bytes, broken down into named categories, e.g. "factors"
+   * and "noise models" for a NonlinearFactorGraph.  Objects made of several parts add the
+   * breakdowns of their parts.
+   *
+   * The numbers are estimates meant for budgeting and for spotting growth: they count the
+   * objects themselves, the heap storage of their matrices, vectors and containers (using the
+   * capacity of vectors), and a fixed overhead per node of maps, but not the bookkeeping of the
+   * allocators nor memory held by pools after it was freed.  Shared objects, like noise models,
+   * are counted once per breakdown.
+   *
+   * @addtogroup base */
+  class GTSAM_EXPORT MemoryUsage
+  {
+  public:
+    typedef std::map<std::string, size_t> Categories;
+
+    /// Add \c bytes to \c category
+    void add(const std::string& category, size_t bytes) { categories_[category] += bytes; }
+
+    /// Add all categories of \c other
+    MemoryUsage& operator+=(const MemoryUsage& other);
+
+    /// The bytes of \c category, zero if nothing was added to it
+    size_t operator[](const std::string& category) const;
+
+    /// The bytes of all categories
+    size_t total() const;
+
+    /// All categories with their bytes
+    const Categories& categories() const { return categories_; }
+
+    /// Print the breakdown and the total
+    void print(const std::string& s = "") const;
+
+  private:
+    Categories categories_;
+  };
+
+  /// @name Heap storage of members, for implementing memoryUsage()
+  /// @{
+
+  /// Objects without heap storage
+  template<class T>
+  size_t heapBytes(const T&) { return 0; }
+
+  /// Heap storage of a dynamic-size matrix
+  inline size_t heapBytes(const Matrix& m) { return m.size() * sizeof(double); }
+
+  /// Heap storage of a dynamic-size vector
+  inline size_t heapBytes(const Vector& v) { return v.size() * sizeof(double); }
+
+  /// Heap storage of a vector, including its unused capacity
+  template<class T, class ALLOCATOR>
+  size_t heapBytes(const std::vector<T, ALLOCATOR>& v) { return v.capacity() * sizeof(T); }
+
+  /// Heap storage of a FastVector, including its unused capacity
+  template<class T>
+  size_t heapBytes(const FastVector<T>& v) { return v.capacity() * sizeof(T); }
+
+  /// Storage of the nodes of a map holding \c nrNodes entries of \c entryBytes each, assuming
+  /// the parent, child and color fields of a red-black tree node
+  inline size_t mapNodeBytes(size_t nrNodes, size_t entryBytes) {
+    return nrNodes * (entryBytes + 4 * sizeof(void*));
+  }
+
+  /// @}
+
+} // \namespace gtsam
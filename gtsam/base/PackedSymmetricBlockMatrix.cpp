@@ -0,0 +1,95 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PackedSymmetricBlockMatrix.cpp
+ * @brief   Symmetric block matrix that only stores the blocks of the upper triangle
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/base/PackedSymmetricBlockMatrix.h>
+#include <gtsam/base/SymmetricBlockMatrix.h>
+#include <gtsam/base/VerticalBlockMatrix.h>
+#include <gtsam/base/timing.h>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+PackedSymmetricBlockMatrix::PackedSymmetricBlockMatrix(const SymmetricBlockMatrix& other) {
+  const DenseIndex start = other.offset(0);
+  variableColOffsets_.push_back(0);
+  for (DenseIndex j = 0; j < other.nBlocks(); ++j)
+    variableColOffsets_.push_back(
+        (j + 1 < other.nBlocks() ? other.offset(j + 1) : start + other.cols()) - start);
+  fillPanelOffsets();
+  data_.resize(packedSize());
+
+  // Each panel is the top of a block column of the active view
+  const Matrix& matrix = other.matrix().nestedExpression();
+  for (DenseIndex j = 0; j < nBlocks(); ++j)
+    Eigen::Map<Matrix>(data_.data() + panelOffsets_[j], offset(j + 1), getDim(j)) =
+        matrix.block(start, start + offset(j), offset(j + 1), getDim(j));
+}
+
+/* ************************************************************************* */
+Matrix PackedSymmetricBlockMatrix::selfadjointView() const {
+  Matrix result(rows(), cols());
+  for (DenseIndex j = 0; j < nBlocks(); ++j)
+    result.block(0, offset(j), offset(j + 1), getDim(j)) =
+        Eigen::Map<const Matrix>(data_.data() + panelOffsets_[j], offset(j + 1), getDim(j));
+  result.triangularView<Eigen::StrictlyLower>() = result.transpose();
+  return result;
+}
+
+/* ************************************************************************* */
+SymmetricBlockMatrix PackedSymmetricBlockMatrix::unpack() const {
+  FastVector<DenseIndex> dims(nBlocks());
+  for (DenseIndex j = 0; j < nBlocks(); ++j)
+    dims[j] = getDim(j);
+  SymmetricBlockMatrix result(dims);
+  Matrix& matrix = result.matrix().nestedExpression();
+  for (DenseIndex j = 0; j < nBlocks(); ++j)
+    matrix.block(0, offset(j), offset(j + 1), getDim(j)) =
+        Eigen::Map<const Matrix>(data_.data() + panelOffsets_[j], offset(j + 1), getDim(j));
+  return result;
+}
+
+/* ************************************************************************* */
+void PackedSymmetricBlockMatrix::updateHessian(const FastVector<DenseIndex>& slots,
+    SymmetricBlockMatrix* info) const {
+  gttic(updateHessian_PackedSymmetricBlockMatrix);
+  assert(DenseIndex(slots.size()) == nBlocks());
+  // Apply updates to the upper triangle, transposing the blocks that land below the diagonal
+  Matrix& matrix = info->matrix().nestedExpression();
+  for (DenseIndex j = 0; j < nBlocks(); ++j) {
+    const DenseIndex J = info->offset(slots[j]);
+    for (DenseIndex i = 0; i < j; ++i) {
+      const DenseIndex I = info->offset(slots[i]);
+      if (I < J)
+        matrix.block(I, J, getDim(i), getDim(j)) += (*this)(i, j);
+      else
+        matrix.block(J, I, getDim(j), getDim(i)) += (*this)(i, j).transpose();
+    }
+    Eigen::Block<Matrix> diagonal = matrix.block(J, J, getDim(j), getDim(j));
+    diagonal.triangularView<Eigen::Upper>() = diagonal + (*this)(j, j);
+  }
+}
+
+/* ************************************************************************* */
+VerticalBlockMatrix PackedSymmetricBlockMatrix::choleskyPartial(DenseIndex nFrontals) {
+  SymmetricBlockMatrix dense = unpack();
+  VerticalBlockMatrix Ab = dense.choleskyPartial(nFrontals);
+  *this = PackedSymmetricBlockMatrix(dense);
+  return Ab;
+}
+/* ************************************************************************* */
+
+} //\ namespace gtsam
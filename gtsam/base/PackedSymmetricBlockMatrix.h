@@ -0,0 +1,157 @@
+/* ----------------------------------------------------------------------------
+
+* GTSAM Copyright 2010, Georgia Tech Research Corporation,
+* Atlanta, Georgia 30332-0415
+* All Rights Reserved
+* Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+* See LICENSE for the license information
+
+* -------------------------------------------------------------------------- */
+
+/**
+* @file    PackedSymmetricBlockMatrix.h
+* @brief   Symmetric block matrix that only stores the blocks of the upper triangle
+* @date    Oct 15, 2026
+*/
+#pragma once
+
+#include <gtsam/base/FastVector.h>
+#include <gtsam/base/Matrix.h>
+#include <gtsam/base/types.h>
+#include <gtsam/dllexport.h>
+#include <boost/serialization/nvp.hpp>
+#include <cassert>
+
+namespace boost {
+namespace serialization {
+class access;
+} /* namespace serialization */
+} /* namespace boost */
+
+namespace gtsam {
+
+  // Forward declarations
+  class SymmetricBlockMatrix;
+  class VerticalBlockMatrix;
+
+  /**
+  * A symmetric matrix with the same block structure as SymmetricBlockMatrix, but which only stores
+  * the blocks on and above the diagonal.  For a matrix with many blocks this takes about half the
+  * memory of a SymmetricBlockMatrix, which stores the whole square matrix, so it is meant for
+  * information matrices that are kept around, like cached Hessians, while SymmetricBlockMatrix
+  * remains the working storage of elimination.
+  *
+  * Each column of blocks, i.e. the blocks (0,j) to (j,j), is stored as one column-major panel, so
+  * blocks are accessed as strided Eigen maps, and only for block indices i <= j.  The lower
+  * triangles of the diagonal blocks are stored but not used.
+  *
+  * @addtogroup base */
+  class GTSAM_EXPORT PackedSymmetricBlockMatrix
+  {
+  public:
+    typedef PackedSymmetricBlockMatrix This;
+    typedef Eigen::Map<Matrix, 0, Eigen::OuterStride<> > Block;
+    typedef Eigen::Map<const Matrix, 0, Eigen::OuterStride<> > constBlock;
+
+  protected:
+    Vector data_; ///< The panels of the columns of blocks
+    FastVector<DenseIndex> variableColOffsets_; ///< the starting columns of each block (0-based)
+    FastVector<DenseIndex> panelOffsets_; ///< the position in data_ of the panel of each column of blocks
+
+  public:
+    /// Construct an empty matrix
+    PackedSymmetricBlockMatrix() {
+      variableColOffsets_.push_back(0);
+      panelOffsets_.push_back(0);
+    }
+
+    /// Construct from a container of the sizes of each block, with all entries zero.
+    template<typename CONTAINER>
+    PackedSymmetricBlockMatrix(const CONTAINER& dimensions, bool appendOneDimension = false) {
+      variableColOffsets_.push_back(0);
+      for (typename CONTAINER::const_iterator dim = dimensions.begin(); dim != dimensions.end(); ++dim)
+        variableColOffsets_.push_back(variableColOffsets_.back() + *dim);
+      if (appendOneDimension)
+        variableColOffsets_.push_back(variableColOffsets_.back() + 1);
+      fillPanelOffsets();
+      data_ = Vector::Zero(panelOffsets_.back());
+    }
+
+    /// Pack the active view of a SymmetricBlockMatrix, i.e. its blocks from blockStart() on
+    explicit PackedSymmetricBlockMatrix(const SymmetricBlockMatrix& other);
+
+    /// Row size
+    DenseIndex rows() const { return variableColOffsets_.back(); }
+
+    /// Column size
+    DenseIndex cols() const { return rows(); }
+
+    /// Block count
+    DenseIndex nBlocks() const { return variableColOffsets_.size() - 1; }
+
+    /// Dimension of the block with index \c block
+    DenseIndex getDim(DenseIndex block) const {
+      return variableColOffsets_[block + 1] - variableColOffsets_[block];
+    }
+
+    /// Return the offset in the full matrix of the start of the specified \c block.
+    DenseIndex offset(DenseIndex block) const { return variableColOffsets_[block]; }
+
+    /// Number of stored scalars, compared to rows() * cols() for a SymmetricBlockMatrix
+    DenseIndex packedSize() const { return panelOffsets_.back(); }
+
+    /// The block with vertical block index \c i_block and horizontal block index \c j_block,
+    /// which must be on or above the diagonal.
+    Block operator()(DenseIndex i_block, DenseIndex j_block) {
+      assert(i_block <= j_block);
+      return Block(data_.data() + panelOffsets_[j_block] + offset(i_block), getDim(i_block),
+          getDim(j_block), Eigen::OuterStride<>(offset(j_block + 1)));
+    }
+
+    /// The block with vertical block index \c i_block and horizontal block index \c j_block,
+    /// which must be on or above the diagonal.
+    constBlock operator()(DenseIndex i_block, DenseIndex j_block) const {
+      assert(i_block <= j_block);
+      return constBlock(data_.data() + panelOffsets_[j_block] + offset(i_block), getDim(i_block),
+          getDim(j_block), Eigen::OuterStride<>(offset(j_block + 1)));
+    }
+
+    /// The full symmetric matrix, with both triangles filled in
+    Matrix selfadjointView() const;
+
+    /// Unpack into a SymmetricBlockMatrix with the same blocks
+    SymmetricBlockMatrix unpack() const;
+
+    /// Add this matrix into \c info, as in HessianFactor::updateHessian: block (i,j) is added to
+    /// block (slots[i], slots[j]) of the active view of \c info.  The slots must be distinct.
+    void updateHessian(const FastVector<DenseIndex>& slots, SymmetricBlockMatrix* info) const;
+
+    /// Do partial Cholesky and return the eliminated block matrix, keeping the remaining symmetric
+    /// matrix of the last nBlocks() - nFrontals blocks, like SymmetricBlockMatrix::choleskyPartial.
+    /// The factorization is done in a dense SymmetricBlockMatrix, only the remaining matrix is
+    /// packed again.
+    /// @throw CholeskyFailed if the frontal block is not positive definite
+    VerticalBlockMatrix choleskyPartial(DenseIndex nFrontals);
+
+  protected:
+    void fillPanelOffsets() {
+      panelOffsets_.resize(variableColOffsets_.size());
+      panelOffsets_[0] = 0;
+      for (DenseIndex j = 0; j < nBlocks(); ++j)
+        panelOffsets_[j + 1] = panelOffsets_[j] + offset(j + 1) * getDim(j);
+    }
+
+  private:
+    /** Serialization function */
+    friend class boost::serialization::access;
+    template<class ARCHIVE>
+    void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+      ar & BOOST_SERIALIZATION_NVP(data_);
+      ar & BOOST_SERIALIZATION_NVP(variableColOffsets_);
+      if (ARCHIVE::is_loading::value)
+        fillPanelOffsets();
+    }
+  };
+
+}
@@ -0,0 +1,81 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ScratchBuffer.cpp
+ * @brief   Reusable per-thread scratch memory
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/base/ScratchBuffer.h>
+
+#include <boost/thread/tss.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+
+#include <vector>
+
+namespace gtsam {
+
+namespace {
+
+typedef boost::aligned_storage<ScratchBuffer::Alignment, ScratchBuffer::Alignment>::type Storage;
+
+// Number of Storage units needed for the given number of bytes
+size_t units(size_t bytes) {
+  return (bytes + ScratchBuffer::Alignment - 1) / ScratchBuffer::Alignment;
+}
+
+// The buffer of one thread
+struct ThreadBuffer {
+  std::vector<Storage> storage;
+  bool leased;
+  ThreadBuffer() : leased(false) {}
+};
+
+boost::thread_specific_ptr<ThreadBuffer> threadBuffer;
+
+ThreadBuffer& currentBuffer() {
+  if (!threadBuffer.get())
+    threadBuffer.reset(new ThreadBuffer());
+  return *threadBuffer;
+}
+
+}
+
+/* ************************************************************************* */
+ScratchBuffer::Lease::Lease(size_t bytes) : data_(0), heap_(false) {
+  ThreadBuffer& buffer = currentBuffer();
+  const size_t n = units(bytes) > 0 ? units(bytes) : 1;
+  if (buffer.leased) {
+    data_ = reinterpret_cast<char*>(new Storage[n]);
+    heap_ = true;
+  } else {
+    if (buffer.storage.size() < n)
+      buffer.storage.resize(n);
+    buffer.leased = true;
+    data_ = reinterpret_cast<char*>(&buffer.storage[0]);
+  }
+}
+
+/* ************************************************************************* */
+ScratchBuffer::Lease::~Lease() {
+  if (heap_)
+    delete[] reinterpret_cast<Storage*>(data_);
+  else
+    threadBuffer->leased = false;
+}
+
+/* ************************************************************************* */
+size_t ScratchBuffer::Capacity() {
+  return threadBuffer.get() ? threadBuffer->storage.size() * Alignment : 0;
+}
+
+}
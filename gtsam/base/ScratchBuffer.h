@@ -0,0 +1,61 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ScratchBuffer.h
+ * @brief   Reusable per-thread scratch memory
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/dllexport.h>
+#include <cstddef>
+
+namespace gtsam {
+
+  /**
+   * A per-thread buffer of aligned scratch memory, e.g. for the execution traces of expressions.
+   *
+   * Each thread owns one buffer that only grows, so after the first few calls no memory is
+   * allocated.  The buffer is leased for the lifetime of a Lease object; if it is already leased
+   * by the same thread (a nested lease), the Lease falls back to the heap.
+   *
+   * @addtogroup base */
+  class GTSAM_EXPORT ScratchBuffer
+  {
+  public:
+    /// Alignment of the memory handed out, in bytes
+    static const size_t Alignment = 16;
+
+    /** While a Lease is alive, data() points to at least \c bytes of scratch memory, aligned
+     *  to ScratchBuffer::Alignment, that is not used by anyone else. */
+    class GTSAM_EXPORT Lease
+    {
+    public:
+      explicit Lease(size_t bytes);
+      ~Lease();
+
+      /// The scratch memory
+      char* data() const { return data_; }
+
+    private:
+      char* data_;
+      bool heap_; ///< Whether data_ was allocated on the heap, because the buffer was leased
+      Lease(const Lease&);
+      Lease& operator=(const Lease&);
+    };
+
+    /// Size of the buffer of the calling thread, in bytes
+    static size_t Capacity();
+  };
+
+}
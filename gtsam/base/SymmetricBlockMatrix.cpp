@@ -32,7 +32,7 @@ SymmetricBlockMatrix SymmetricBlockMatrix::LikeActiveViewOf(
   for (size_t i = 0; i < result.variableColOffsets_.size(); ++i)
     result.variableColOffsets_[i] = other.variableColOffsets_[other.blockStart_
         + i] - other.variableColOffsets_[other.blockStart_];
-  result.matrix_.resize(other.cols(), other.cols());
+  BlockMatrixArena::Allocate(result.matrix_, other.cols(), other.cols());
   result.assertInvariants();
   return result;
 }
@@ -45,19 +45,22 @@ SymmetricBlockMatrix SymmetricBlockMatrix::LikeActiveViewOf(
   for (size_t i = 0; i < result.variableColOffsets_.size(); ++i)
     result.variableColOffsets_[i] = other.variableColOffsets_[other.blockStart_
         + i] - other.variableColOffsets_[other.blockStart_];
-  result.matrix_.resize(other.cols(), other.cols());
+  BlockMatrixArena::Allocate(result.matrix_, other.cols(), other.cols());
   result.assertInvariants();
   return result;
 }
 
 /* ************************************************************************* */
 VerticalBlockMatrix SymmetricBlockMatrix::choleskyPartial(
-    DenseIndex nFrontals) {
+    DenseIndex nFrontals, bool singlePrecision) {
   // Do dense elimination
   if (blockStart() != 0)
     throw std::invalid_argument(
         "Can only do Cholesky when the SymmetricBlockMatrix is not a restricted view, i.e. when blockStart == 0.");
-  if (!gtsam::choleskyPartial(matrix_, offset(nFrontals)))
+  const bool ok = singlePrecision ?
+      gtsam::choleskyPartialSinglePrecision(matrix_, offset(nFrontals)) :
+      gtsam::choleskyPartial(matrix_, offset(nFrontals));
+  if (!ok)
     throw CholeskyFailed();
 
   // Split conditional
@@ -17,6 +17,7 @@
 */
 #pragma once
 
+#include <gtsam/base/BlockMatrixArena.h>
 #include <gtsam/base/FastVector.h>
 #include <gtsam/base/Matrix.h>
 #include <gtsam/base/SymmetricBlockMatrixBlockExpr.h>
@@ -77,7 +78,7 @@ namespace gtsam {
       blockStart_(0)
     {
       fillOffsets(dimensions.begin(), dimensions.end(), appendOneDimension);
-      matrix_.resize(variableColOffsets_.back(), variableColOffsets_.back());
+      BlockMatrixArena::Allocate(matrix_, variableColOffsets_.back(), variableColOffsets_.back());
       assertInvariants();
     }
 
@@ -87,7 +88,7 @@ namespace gtsam {
       blockStart_(0)
     {
       fillOffsets(firstBlockDim, lastBlockDim, appendOneDimension);
-      matrix_.resize(variableColOffsets_.back(), variableColOffsets_.back());
+      BlockMatrixArena::Allocate(matrix_, variableColOffsets_.back(), variableColOffsets_.back());
       assertInvariants();
     }
 
@@ -96,7 +97,7 @@ namespace gtsam {
     SymmetricBlockMatrix(const CONTAINER& dimensions, const Matrix& matrix, bool appendOneDimension = false) :
       blockStart_(0)
     {
-      matrix_.resize(matrix.rows(), matrix.cols());
+      BlockMatrixArena::Allocate(matrix_, matrix.rows(), matrix.cols());
       matrix_.triangularView<Eigen::Upper>() = matrix.triangularView<Eigen::Upper>();
       fillOffsets(dimensions.begin(), dimensions.end(), appendOneDimension);
       if(matrix_.rows() != matrix_.cols())
@@ -179,6 +180,12 @@ namespace gtsam {
       return matrix_;
     }
 
+    /** Bytes allocated on the heap for the full matrix and the block offsets */
+    size_t allocatedBytes() const
+    {
+      return matrix_.size() * sizeof(double) + variableColOffsets_.capacity() * sizeof(DenseIndex);
+    }
+
     /// Return the absolute offset in the underlying matrix of the start of the specified \c block.
     DenseIndex offset(DenseIndex block) const
     {
@@ -198,8 +205,10 @@ namespace gtsam {
     DenseIndex blockStart() const { return blockStart_; }
 
     /// Do partial Cholesky in-place and return the eliminated block matrix, leaving the remaining
-    /// symmetric matrix in place.
-    VerticalBlockMatrix choleskyPartial(DenseIndex nFrontals);
+    /// symmetric matrix in place.  If \c singlePrecision is true, the factorization is computed in
+    /// single precision with choleskyPartialSinglePrecision(), and the result is only accurate to
+    /// single precision.
+    VerticalBlockMatrix choleskyPartial(DenseIndex nFrontals, bool singlePrecision = false);
 
   protected:
     void assertInvariants() const
@@ -242,6 +251,7 @@ namespace gtsam {
     }
 
     friend class VerticalBlockMatrix;
+    friend class BlockMatrixArena;
     template<typename SymmetricBlockMatrixType> friend class SymmetricBlockMatrixBlockExpr;
 
   private:
@@ -0,0 +1,82 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file     TaskArena.cpp
+ * @brief    Confines the parallel work of one solver to a limited number of threads
+ * @date     Oct 15, 2026
+ */
+
+#include <gtsam/base/TaskArena.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+// Observers local to an arena, to call the thread entry of the threads joining it
+#define TBB_PREVIEW_LOCAL_OBSERVER 1
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
+#endif
+
+namespace gtsam {
+
+#ifdef GTSAM_USE_TBB
+
+/* ************************************************************************* */
+// Calls the thread entry of each thread joining the arena
+class ThreadEntryObserver : public tbb::task_scheduler_observer {
+  TaskArena::ThreadEntry threadEntry_;
+public:
+  ThreadEntryObserver(tbb::task_arena& arena, const TaskArena::ThreadEntry& threadEntry) :
+    tbb::task_scheduler_observer(arena), threadEntry_(threadEntry) { observe(true); }
+  ~ThreadEntryObserver() { observe(false); }
+  virtual void on_scheduler_entry(bool /*isWorker*/) { threadEntry_(); }
+};
+
+/* ************************************************************************* */
+struct TaskArena::Impl {
+  mutable tbb::task_arena arena;
+  boost::shared_ptr<ThreadEntryObserver> observer;
+  Impl(int maxThreads, const ThreadEntry& threadEntry) : arena(maxThreads) {
+    if(threadEntry)
+      observer.reset(new ThreadEntryObserver(arena, threadEntry));
+  }
+};
+
+#else
+
+struct TaskArena::Impl {};
+
+#endif
+
+/* ************************************************************************* */
+TaskArena::TaskArena(int maxThreads, const ThreadEntry& threadEntry) :
+  maxThreads_(maxThreads > 0 ? maxThreads : 0)
+{
+#ifdef GTSAM_USE_TBB
+  if(maxThreads_ > 0)
+    impl_.reset(new Impl(maxThreads_, threadEntry));
+#else
+  (void)threadEntry;
+#endif
+}
+
+/* ************************************************************************* */
+void TaskArena::execute(const boost::function<void()>& function) const {
+#ifdef GTSAM_USE_TBB
+  if(impl_) {
+    impl_->arena.execute(function);
+    return;
+  }
+#endif
+  function();
+}
+
+}
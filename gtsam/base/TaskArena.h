@@ -0,0 +1,60 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file     TaskArena.h
+ * @brief    Confines the parallel work of one solver to a limited number of threads
+ * @date     Oct 15, 2026
+ * @addtogroup base
+ */
+
+#pragma once
+
+#include <gtsam/dllexport.h>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace gtsam {
+
+/**
+ * An execution context for the parallel work of one solver.  With TBB and a positive maxThreads,
+ * the work done in execute() runs in a tbb::task_arena of its own with at most maxThreads threads,
+ * counting the calling thread, instead of in the global scheduler shared by all solvers of the
+ * process.  Several solvers thus do not oversubscribe the machine, and the latency of each one
+ * does not depend on the others.
+ *
+ * The optional \c threadEntry is called by each thread every time it joins the arena, e.g. to pin
+ * the threads of the arena to the cores of one NUMA node.  It should thus be cheap and idempotent.
+ *
+ * Without TBB, or with maxThreads <= 0, execute() just calls the function.  Copies share the
+ * arena.
+ */
+class GTSAM_EXPORT TaskArena {
+public:
+  typedef boost::function<void()> ThreadEntry;
+
+  /// Create an arena with at most \c maxThreads threads, or none if \c maxThreads <= 0
+  explicit TaskArena(int maxThreads = 0, const ThreadEntry& threadEntry = ThreadEntry());
+
+  /// The maximum number of threads, or 0 if it is not limited
+  int maxThreads() const { return maxThreads_; }
+
+  /// Run \c function in the arena and wait for all its parallel work.  Exceptions are propagated.
+  void execute(const boost::function<void()>& function) const;
+
+private:
+  struct Impl;
+  boost::shared_ptr<Impl> impl_;
+  int maxThreads_;
+};
+
+}
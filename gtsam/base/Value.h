@@ -25,6 +25,16 @@
 
 namespace gtsam {
 
+  namespace internal {
+    /// A unique address for every type T, to tag the dynamic type of a Value without RTTI
+    template<class T>
+    struct TypeTag {
+      static const char id;
+    };
+    template<class T>
+    const char TypeTag<T>::id = 0;
+  }
+
   /**
    * This is the interface class for any value that may be used as a variable
    * assignment in a factor graph, and which you must derive to create new
@@ -104,6 +114,12 @@ namespace gtsam {
      */
     virtual size_t dim() const = 0;
 
+    /** Return the memory used by this value in bytes, including the heap storage of the
+     * dynamic-size matrices and vectors it holds.  The default only knows the size of this
+     * base class.
+     */
+    virtual size_t memoryUsage() const { return sizeof(Value); }
+
     /** Increment the value, by mapping from the vector delta in the tangent
      * space of the current value back to the manifold to produce a new,
      * incremented value.
@@ -112,6 +128,27 @@ namespace gtsam {
      */
     virtual Value* retract_(const Vector& delta) const = 0;
 
+    /** Increment this value in place by the tangent-space vector \c delta.
+     * The default goes through retract_() and assignment; derived classes
+     * should override it to avoid the temporary copy.
+     */
+    virtual void retractInPlace_(const Vector& delta) {
+      Value* retracted = retract_(delta);
+      *this = *retracted;
+      retracted->deallocate_();
+    }
+
+    /** Retract \c n values of the same type as this one, \c values[i] by \c deltas[i], into
+     * new values allocated as by retract_(), stored in \c result[i].  The default retracts them
+     * one at a time.  If this throws, the values already stored in \c result are owned by the
+     * caller.
+     */
+    virtual void retractBatch_(const Value* const* values, const Vector* const* deltas, size_t n,
+        Value** result) const {
+      for (size_t i = 0; i < n; ++i)
+        result[i] = values[i]->retract_(*deltas[i]);
+    }
+
     /** Compute the coordinates in the tangent space of this value that
      * retract() would map to \c value.
      * @param value The value whose coordinates should be determined in the
@@ -130,10 +167,23 @@ namespace gtsam {
     template<typename ValueType>
     const ValueType& cast() const;
 
+    /** Tag of the dynamic type: &internal::TypeTag<GenericValue<T> >::id for a GenericValue<T>,
+     *  null for other values.  Values::at compares it instead of casting with RTTI. */
+    const void* typeTag() const { return typeTag_; }
+
     /** Virutal destructor */
     virtual ~Value() {}
 
+  protected:
+    /** Construct a value without a type tag */
+    Value() : typeTag_(0) {}
+
+    /** Construct a value with the tag of its dynamic type */
+    explicit Value(const void* typeTag) : typeTag_(typeTag) {}
+
   private:
+    const void* typeTag_;
+
     /** Empty serialization function.
      *
      * There are two important things that users need to do to serialize derived objects in Values successfully:
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <gtsam/base/Matrix.h>
+#include <gtsam/base/BlockMatrixArena.h>
 #include <gtsam/base/FastVector.h>
 
 namespace gtsam {
@@ -70,7 +71,7 @@ namespace gtsam {
         variableColOffsets_(dimensions.size() + (appendOneDimension ? 2 : 1)),
         rowStart_(0), rowEnd_(height), blockStart_(0) {
       fillOffsets(dimensions.begin(), dimensions.end(), appendOneDimension);
-      matrix_.resize(height, variableColOffsets_.back());
+      BlockMatrixArena::Allocate(matrix_, height, variableColOffsets_.back());
       assertInvariants();
     }
 
@@ -94,7 +95,7 @@ namespace gtsam {
         variableColOffsets_((lastBlockDim-firstBlockDim) + (appendOneDimension ? 2 : 1)),
         rowStart_(0), rowEnd_(height), blockStart_(0) {
       fillOffsets(firstBlockDim, lastBlockDim, appendOneDimension);
-      matrix_.resize(height, variableColOffsets_.back());
+      BlockMatrixArena::Allocate(matrix_, height, variableColOffsets_.back());
       assertInvariants();
     }
 
@@ -189,6 +190,10 @@ namespace gtsam {
     /** Non-const access to full matrix (*including* any portions excluded by rowStart(), rowEnd(), and firstBlock()) */
     Matrix& matrix() { return matrix_; }
 
+    /** Bytes allocated on the heap for the full matrix and the block offsets */
+    size_t allocatedBytes() const {
+      return matrix_.size() * sizeof(double) + variableColOffsets_.capacity() * sizeof(DenseIndex); }
+
   protected:
     void assertInvariants() const {
       assert(matrix_.cols() == variableColOffsets_.back());
@@ -216,6 +221,7 @@ namespace gtsam {
     }
 
     friend class SymmetricBlockMatrix;
+    friend class BlockMatrixArena;
 
   private:
     /** Serialization function */
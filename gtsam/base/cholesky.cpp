@@ -18,10 +18,20 @@
 
 #include <gtsam/base/debug.h>
 #include <gtsam/base/cholesky.h>
+#include <gtsam/base/cudaCholesky.h>
+#include <gtsam/base/simdKernels.h>
 #include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
 
 #include <boost/format.hpp>
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 using namespace std;
 
@@ -118,21 +128,19 @@ pair<size_t,bool> choleskyCareful(Matrix& ATA, int order) {
 }
 
 /* ************************************************************************* */
-bool choleskyPartial(Matrix& ABC, size_t nFrontal) {
-
-  gttic(choleskyPartial);
-
-  const bool debug = ISDEBUG("choleskyPartial");
-
-  assert(ABC.rows() == ABC.cols());
-  assert(ABC.rows() >= 0 && nFrontal <= size_t(ABC.rows()));
-
+// Factor the frontal block A of ABC into R, and compute S = inv(R') * B, for a
+// run-time number of frontal variables.
+static Eigen::ComputationInfo choleskyFrontal(Matrix& ABC, size_t nFrontal) {
   const size_t n = ABC.rows();
 
-  // Compute Cholesky factorization of A, overwrites A.
   gttic(lld);
   Eigen::ComputationInfo lltResult;
-  if(nFrontal > 0)
+  if(nFrontal > 0 && nFrontal <= simd::MaxBlockSize)
+  {
+    // Small frontal blocks are factored in place by the run-time dispatched kernel
+    lltResult = simd::llt(nFrontal, ABC.data(), ABC.rows()) ? Eigen::Success : Eigen::NumericalIssue;
+  }
+  else if(nFrontal > 0)
   {
     Eigen::LLT<Matrix, Eigen::Upper> llt = ABC.block(0, 0, nFrontal, nFrontal).selfadjointView<Eigen::Upper>().llt();
     ABC.block(0, 0, nFrontal, nFrontal).triangularView<Eigen::Upper>() = llt.matrixU();
@@ -144,27 +152,134 @@ bool choleskyPartial(Matrix& ABC, size_t nFrontal) {
   }
   gttoc(lld);
 
-  if(debug) cout << "R:\n" << Eigen::MatrixXd(ABC.topLeftCorner(nFrontal,nFrontal).triangularView<Eigen::Upper>()) << endl;
-
-  // Compute S = inv(R') * B
   gttic(compute_S);
   if(n - nFrontal > 0) {
     ABC.topLeftCorner(nFrontal,nFrontal).triangularView<Eigen::Upper>().transpose().solveInPlace(
         ABC.topRightCorner(nFrontal, n-nFrontal));
   }
-  if(debug) cout << "S:\n" << ABC.topRightCorner(nFrontal, n-nFrontal) << endl;
   gttoc(compute_S);
 
-  // Compute L = C - S' * S
-  gttic(compute_L);
-  if(debug) cout << "C:\n" << Eigen::MatrixXd(ABC.bottomRightCorner(n-nFrontal,n-nFrontal).selfadjointView<Eigen::Upper>()) << endl;
-  if(n - nFrontal > 0)
-    ABC.bottomRightCorner(n-nFrontal,n-nFrontal).selfadjointView<Eigen::Upper>().rankUpdate(
-        ABC.topRightCorner(nFrontal, n-nFrontal).transpose(), -1.0);
-  if(debug) cout << "L:\n" << Eigen::MatrixXd(ABC.bottomRightCorner(n-nFrontal,n-nFrontal).selfadjointView<Eigen::Upper>()) << endl;
-  gttoc(compute_L);
+  return lltResult;
+}
 
-  // Check last diagonal element - Eigen does not check it
+/* ************************************************************************* */
+// Same as above for N frontal variables known at compile time, such that Eigen
+// unrolls and vectorizes the factorization of the frontal block and the solve
+// for each column of B.
+template<int N>
+static Eigen::ComputationInfo choleskyFrontal(Matrix& ABC) {
+  typedef Eigen::Matrix<double, N, N> MatrixNN;
+  const size_t n = ABC.rows();
+
+  gttic(lld);
+  const Eigen::LLT<MatrixNN, Eigen::Upper> llt(MatrixNN(ABC.template topLeftCorner<N, N>()));
+  const MatrixNN R = llt.matrixU();
+  ABC.template topLeftCorner<N, N>().template triangularView<Eigen::Upper>() = R;
+  gttoc(lld);
+
+  gttic(compute_S);
+  for(size_t j = N; j < n; ++j) {
+    Eigen::Matrix<double, N, 1> column = ABC.col(j).template head<N>();
+    R.template triangularView<Eigen::Upper>().transpose().solveInPlace(column);
+    ABC.col(j).template head<N>() = column;
+  }
+  gttoc(compute_S);
+
+  return llt.info();
+}
+
+/* ************************************************************************* */
+#ifdef GTSAM_USE_TBB
+// Cliques of at least this dimension are factored by the blocked algorithm below, in parallel
+static const size_t parallelCliqueDim = 256;
+// Width of the column blocks of the blocked algorithm
+static const size_t parallelBlockSize = 64;
+
+namespace {
+typedef std::vector<std::pair<size_t, size_t> > ColumnBlocks;
+
+// Solves R_kk' * X = ABC(k, j) for the column blocks j of a range, where R_kk is the factored
+// diagonal block k, which gives the rows of block k of R and S.
+class SolveRowBlock {
+  Matrix& ABC_;
+  const ColumnBlocks& blocks_;
+  size_t k_;
+public:
+  SolveRowBlock(Matrix& ABC, const ColumnBlocks& blocks, size_t k) :
+      ABC_(ABC), blocks_(blocks), k_(k) {}
+  void operator()(const tbb::blocked_range<size_t>& range) const {
+    const size_t r0 = blocks_[k_].first, b = blocks_[k_].second - r0;
+    for (size_t j = range.begin(); j != range.end(); ++j) {
+      const size_t j0 = blocks_[j].first, w = blocks_[j].second - j0;
+      ABC_.block(r0, r0, b, b).triangularView<Eigen::Upper>().transpose().solveInPlace(
+          ABC_.block(r0, j0, b, w));
+    }
+  }
+};
+
+// Subtracts the contribution of the rows of block k from the upper triangle of the column blocks
+// of a range, which are right of block k.  For the frontal columns this is the update of the
+// not yet factored part of A, for the separator columns it is one term of L = C - S' * S.
+class UpdateTrailingBlocks {
+  Matrix& ABC_;
+  const ColumnBlocks& blocks_;
+  size_t k_;
+public:
+  UpdateTrailingBlocks(Matrix& ABC, const ColumnBlocks& blocks, size_t k) :
+      ABC_(ABC), blocks_(blocks), k_(k) {}
+  void operator()(const tbb::blocked_range<size_t>& range) const {
+    const size_t r0 = blocks_[k_].first, b = blocks_[k_].second - r0, top = r0 + b;
+    for (size_t j = range.begin(); j != range.end(); ++j) {
+      const size_t j0 = blocks_[j].first, w = blocks_[j].second - j0;
+      if (j0 > top)
+        ABC_.block(top, j0, j0 - top, w).noalias() -=
+            ABC_.block(r0, top, b, j0 - top).transpose() * ABC_.block(r0, j0, b, w);
+      ABC_.block(j0, j0, w, w).selfadjointView<Eigen::Upper>().rankUpdate(
+          ABC_.block(r0, j0, b, w).transpose(), -1.0);
+    }
+  }
+};
+}
+
+// Right-looking blocked partial Cholesky of a large clique, computing R, S and L in place.  The
+// triangular solves and the updates of every step are independent per column block, and run as
+// TBB tasks.  Inside the parallel elimination of a tree, these tasks are nested in the task of
+// the clique, so they are picked up by the threads that have no subtree left to eliminate, which
+// is mostly the case for the large cliques close to the root.
+static Eigen::ComputationInfo choleskyPartialBlocked(Matrix& ABC, size_t nFrontal) {
+  gttic(choleskyPartialBlocked);
+  const size_t n = ABC.rows();
+
+  // Column blocks, with a block boundary between the frontal and separator columns
+  ColumnBlocks blocks;
+  for (size_t j0 = 0; j0 < nFrontal; j0 += parallelBlockSize)
+    blocks.push_back(make_pair(j0, std::min(j0 + parallelBlockSize, nFrontal)));
+  const size_t nFrontalBlocks = blocks.size();
+  for (size_t j0 = nFrontal; j0 < n; j0 += parallelBlockSize)
+    blocks.push_back(make_pair(j0, std::min(j0 + parallelBlockSize, n)));
+
+  for (size_t k = 0; k < nFrontalBlocks; ++k) {
+    const size_t r0 = blocks[k].first, b = blocks[k].second - r0;
+    Eigen::LLT<Matrix, Eigen::Upper> llt =
+        ABC.block(r0, r0, b, b).selfadjointView<Eigen::Upper>().llt();
+    if (llt.info() != Eigen::Success)
+      return llt.info();
+    ABC.block(r0, r0, b, b).triangularView<Eigen::Upper>() = llt.matrixU();
+    if (k + 1 < blocks.size()) {
+      const tbb::blocked_range<size_t> trailing(k + 1, blocks.size());
+      tbb::parallel_for(trailing, SolveRowBlock(ABC, blocks, k));
+      tbb::parallel_for(trailing, UpdateTrailingBlocks(ABC, blocks, k));
+    }
+  }
+  return Eigen::Success;
+}
+#endif
+
+/* ************************************************************************* */
+// Check the result of factoring the frontal block, including the last diagonal
+// elements, which Eigen does not check
+static bool frontalFactorOk(const Matrix& ABC, size_t nFrontal,
+    Eigen::ComputationInfo lltResult) {
   bool ok;
   if(lltResult == Eigen::Success) {
     if(nFrontal >= 2) {
@@ -186,4 +301,95 @@ bool choleskyPartial(Matrix& ABC, size_t nFrontal) {
   return ok;
 }
 
+/* ************************************************************************* */
+bool choleskyPartial(Matrix& ABC, size_t nFrontal) {
+
+  gttic(choleskyPartial);
+
+  const bool debug = ISDEBUG("choleskyPartial");
+
+  assert(ABC.rows() == ABC.cols());
+  assert(ABC.rows() >= 0 && nFrontal <= size_t(ABC.rows()));
+
+  const size_t n = ABC.rows();
+
+  // Large cliques are factored on the GPU if there is one, see cudaCholesky.h
+  if(n >= cuda::minCliqueDim() && nFrontal > 0) {
+    Eigen::ComputationInfo lltResult;
+    if(cuda::choleskyPartial(ABC, nFrontal, lltResult))
+      return frontalFactorOk(ABC, nFrontal, lltResult);
+  }
+
+#ifdef GTSAM_USE_TBB
+  // Large cliques are factored with parallel block operations, see choleskyPartialBlocked
+  if(n >= parallelCliqueDim && nFrontal > 0)
+    return frontalFactorOk(ABC, nFrontal, choleskyPartialBlocked(ABC, nFrontal));
+#endif
+
+  // Compute Cholesky factorization of A, overwrites A, and S = inv(R') * B.  The frontal block
+  // sizes of common variable types are dispatched to fixed-size, unrolled kernels.
+  Eigen::ComputationInfo lltResult;
+  switch(nFrontal) {
+  case 1: lltResult = choleskyFrontal<1>(ABC); break;
+  case 2: lltResult = choleskyFrontal<2>(ABC); break;
+  case 3: lltResult = choleskyFrontal<3>(ABC); break;
+  case 6: lltResult = choleskyFrontal<6>(ABC); break;
+  case 9: lltResult = choleskyFrontal<9>(ABC); break;
+  case 15: lltResult = choleskyFrontal<15>(ABC); break;
+  default: lltResult = choleskyFrontal(ABC, nFrontal); break;
+  }
+
+  if(debug) cout << "R:\n" << Eigen::MatrixXd(ABC.topLeftCorner(nFrontal,nFrontal).triangularView<Eigen::Upper>()) << endl;
+  if(debug) cout << "S:\n" << ABC.topRightCorner(nFrontal, n-nFrontal) << endl;
+
+  // Compute L = C - S' * S
+  gttic(compute_L);
+  if(debug) cout << "C:\n" << Eigen::MatrixXd(ABC.bottomRightCorner(n-nFrontal,n-nFrontal).selfadjointView<Eigen::Upper>()) << endl;
+  if(n - nFrontal > 0 && n - nFrontal <= simd::MaxBlockSize) {
+    const size_t ld = ABC.rows();
+    simd::gemmTN(n-nFrontal, n-nFrontal, nFrontal, -1.0, &ABC(0, nFrontal), ld,
+        &ABC(0, nFrontal), ld, &ABC(nFrontal, nFrontal), ld, true);
+  } else if(n - nFrontal > 0)
+    ABC.bottomRightCorner(n-nFrontal,n-nFrontal).selfadjointView<Eigen::Upper>().rankUpdate(
+        ABC.topRightCorner(nFrontal, n-nFrontal).transpose(), -1.0);
+  if(debug) cout << "L:\n" << Eigen::MatrixXd(ABC.bottomRightCorner(n-nFrontal,n-nFrontal).selfadjointView<Eigen::Upper>()) << endl;
+  gttoc(compute_L);
+
+  return frontalFactorOk(ABC, nFrontal, lltResult);
+}
+
+/* ************************************************************************* */
+bool choleskyPartialSinglePrecision(Matrix& ABC, size_t nFrontal) {
+
+  gttic(choleskyPartialSinglePrecision);
+
+  assert(ABC.rows() == ABC.cols());
+  assert(ABC.rows() >= 0 && nFrontal <= size_t(ABC.rows()));
+
+  const size_t n = ABC.rows();
+
+  // Round to single precision, only the upper triangle is used below
+  Eigen::MatrixXf ABCf = ABC.cast<float>();
+
+  // Factor A into R and compute S = inv(R') * B
+  Eigen::ComputationInfo lltResult = Eigen::Success;
+  if(nFrontal > 0) {
+    Eigen::LLT<Eigen::MatrixXf, Eigen::Upper> llt =
+        ABCf.topLeftCorner(nFrontal, nFrontal).selfadjointView<Eigen::Upper>().llt();
+    ABCf.topLeftCorner(nFrontal, nFrontal).triangularView<Eigen::Upper>() = llt.matrixU();
+    lltResult = llt.info();
+  }
+
+  // Compute L = C - S' * S
+  if(n - nFrontal > 0) {
+    ABCf.topLeftCorner(nFrontal, nFrontal).triangularView<Eigen::Upper>().transpose().solveInPlace(
+        ABCf.topRightCorner(nFrontal, n-nFrontal));
+    ABCf.bottomRightCorner(n-nFrontal, n-nFrontal).selfadjointView<Eigen::Upper>().rankUpdate(
+        ABCf.topRightCorner(nFrontal, n-nFrontal).transpose(), -1.0f);
+  }
+
+  ABC.triangularView<Eigen::Upper>() = ABCf.cast<double>();
+  return frontalFactorOk(ABC, nFrontal, lltResult);
+}
+
 }
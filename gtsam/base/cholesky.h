@@ -55,10 +55,24 @@ GTSAM_EXPORT std::pair<size_t,bool> choleskyCareful(Matrix& ATA, int order = -1)
  * nFrontal determines the split between A, B, and C, with A being of size
  * nFrontal x nFrontal.
  *
+ * If GTSAM is compiled with TBB, matrices of dimension 256 or more are factored
+ * by a blocked algorithm whose block operations run as TBB tasks, such that the
+ * large cliques near the root of an elimination tree use all threads.  If GTSAM
+ * is compiled with CUDA, cliques of dimension cuda::minCliqueDim() or more are
+ * factored on the GPU, see cudaCholesky.h.
+ *
  * @return \c true if the decomposition is successful, \c false if \c A was
  * not positive-definite.
  */
 GTSAM_EXPORT bool choleskyPartial(Matrix& ABC, size_t nFrontal);
 
+/**
+ * Same as choleskyPartial, but the factorization is computed in single precision, which halves the
+ * memory bandwidth of the dense kernels.  The result is rounded back into \c ABC, so it is only
+ * accurate to single precision, and is meant to be used with iterative refinement in double
+ * precision.
+ */
+GTSAM_EXPORT bool choleskyPartialSinglePrecision(Matrix& ABC, size_t nFrontal);
+
 }
 
@@ -0,0 +1,224 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    cudaCholesky.cpp
+ * @brief   Partial Cholesky factorization of large cliques on the GPU
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/base/cudaCholesky.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_CUDA
+
+#ifdef GTSAM_USE_CUDA
+#  include <cuda_runtime.h>
+#  include <cublas_v2.h>
+#  include <cusolverDn.h>
+#  include <boost/thread/mutex.hpp>
+#  include <vector>
+#endif
+
+#include <boost/atomic.hpp>
+
+namespace gtsam {
+namespace cuda {
+
+static boost::atomic<size_t> minCliqueDim_(1024);
+
+/* ************************************************************************* */
+size_t minCliqueDim() {
+  return minCliqueDim_.load();
+}
+
+/* ************************************************************************* */
+void setMinCliqueDim(size_t dim) {
+  minCliqueDim_.store(dim);
+}
+
+/* ************************************************************************* */
+size_t maxStreams() {
+  return 4;
+}
+
+#ifdef GTSAM_USE_CUDA
+
+namespace {
+
+/* ************************************************************************* */
+// A CUDA stream with its cuSOLVER and cuBLAS handles and device buffers, which grow to the
+// largest clique factored so far
+struct Context {
+  cudaStream_t stream;
+  cusolverDnHandle_t solver;
+  cublasHandle_t blas;
+  double* matrix;
+  size_t matrixCapacity;
+  double* workspace;
+  int workspaceCapacity;
+  int* info;
+  bool ok;
+
+  Context() : stream(0), solver(0), blas(0), matrix(0), matrixCapacity(0), workspace(0),
+      workspaceCapacity(0), info(0) {
+    ok = cudaStreamCreate(&stream) == cudaSuccess
+        && cusolverDnCreate(&solver) == CUSOLVER_STATUS_SUCCESS
+        && cusolverDnSetStream(solver, stream) == CUSOLVER_STATUS_SUCCESS
+        && cublasCreate(&blas) == CUBLAS_STATUS_SUCCESS
+        && cublasSetStream(blas, stream) == CUBLAS_STATUS_SUCCESS
+        && cudaMalloc((void**) &info, sizeof(int)) == cudaSuccess;
+  }
+
+  bool reserve(size_t matrixSize, int workspaceSize) {
+    if (matrixSize > matrixCapacity) {
+      cudaFree(matrix);
+      matrixCapacity = 0;
+      if (cudaMalloc((void**) &matrix, matrixSize * sizeof(double)) != cudaSuccess)
+        return false;
+      matrixCapacity = matrixSize;
+    }
+    if (workspaceSize > workspaceCapacity) {
+      cudaFree(workspace);
+      workspaceCapacity = 0;
+      if (cudaMalloc((void**) &workspace, workspaceSize * sizeof(double)) != cudaSuccess)
+        return false;
+      workspaceCapacity = workspaceSize;
+    }
+    return true;
+  }
+};
+
+/* ************************************************************************* */
+// The contexts, created on demand up to maxStreams().  They are never destroyed, because the CUDA
+// runtime may already be unloaded when static objects are destroyed at exit.
+class ContextPool {
+  boost::mutex mutex_;
+  std::vector<Context*> idle_;
+  size_t created_;
+  bool hasDevice_;
+
+public:
+  ContextPool() : created_(0) {
+    int count = 0;
+    hasDevice_ = cudaGetDeviceCount(&count) == cudaSuccess && count > 0;
+  }
+
+  bool hasDevice() const { return hasDevice_; }
+
+  // An idle context, or null if all streams are busy
+  Context* acquire() {
+    boost::mutex::scoped_lock lock(mutex_);
+    if (!idle_.empty()) {
+      Context* context = idle_.back();
+      idle_.pop_back();
+      return context;
+    }
+    if (created_ == maxStreams())
+      return 0;
+    ++created_;
+    return new Context();
+  }
+
+  void release(Context* context) {
+    boost::mutex::scoped_lock lock(mutex_);
+    idle_.push_back(context);
+  }
+};
+
+ContextPool& pool() {
+  static ContextPool* pool = new ContextPool();
+  return *pool;
+}
+
+// Returns the context to the pool at the end of a scope
+class Borrowed {
+  Context* context_;
+public:
+  Borrowed() : context_(pool().acquire()) {}
+  ~Borrowed() { if (context_) pool().release(context_); }
+  Context* operator->() const { return context_; }
+  operator bool() const { return context_ && context_->ok; }
+};
+
+}
+
+/* ************************************************************************* */
+bool available() {
+  return pool().hasDevice();
+}
+
+/* ************************************************************************* */
+bool choleskyPartial(Matrix& ABC, size_t nFrontal, Eigen::ComputationInfo& lltResult) {
+  if (!available() || nFrontal == 0)
+    return false;
+  Borrowed context;
+  if (!context)
+    return false;
+
+  gttic(cudaCholeskyPartial);
+  const int n = int(ABC.rows()), nF = int(nFrontal), s = n - nF;
+  int workspaceSize = 0;
+  if (cusolverDnDpotrf_bufferSize(context->solver, CUBLAS_FILL_MODE_UPPER, nF, context->matrix,
+      n, &workspaceSize) != CUSOLVER_STATUS_SUCCESS)
+    return false;
+  if (!context->reserve(size_t(n) * size_t(n), workspaceSize))
+    return false;
+
+  // Everything is queued on the stream of the context, and only this thread waits for it
+  double* A = context->matrix;
+  double* B = A + size_t(nF) * size_t(n);
+  double* C = B + nF;
+  const double one = 1.0, minusOne = -1.0;
+  bool ok = cudaMemcpyAsync(A, ABC.data(), size_t(n) * size_t(n) * sizeof(double),
+      cudaMemcpyHostToDevice, context->stream) == cudaSuccess;
+  // R' * R = A
+  ok = ok && cusolverDnDpotrf(context->solver, CUBLAS_FILL_MODE_UPPER, nF, A, n,
+      context->workspace, workspaceSize, context->info) == CUSOLVER_STATUS_SUCCESS;
+  if (ok && s > 0) {
+    // S = inv(R') * B
+    ok = cublasDtrsm(context->blas, CUBLAS_SIDE_LEFT, CUBLAS_FILL_MODE_UPPER, CUBLAS_OP_T,
+        CUBLAS_DIAG_NON_UNIT, nF, s, &one, A, n, B, n) == CUBLAS_STATUS_SUCCESS;
+    // L = C - S' * S, upper triangle only
+    ok = ok && cublasDsyrk(context->blas, CUBLAS_FILL_MODE_UPPER, CUBLAS_OP_T, s, nF, &minusOne,
+        B, n, &one, C, n) == CUBLAS_STATUS_SUCCESS;
+  }
+  int info = 0;
+  ok = ok && cudaMemcpyAsync(&info, context->info, sizeof(int), cudaMemcpyDeviceToHost,
+      context->stream) == cudaSuccess;
+  ok = ok && cudaStreamSynchronize(context->stream) == cudaSuccess;
+  if (!ok)
+    return false;
+
+  // The strictly lower triangle was copied unchanged, so the whole matrix can be copied back
+  if (cudaMemcpyAsync(ABC.data(), A, size_t(n) * size_t(n) * sizeof(double),
+      cudaMemcpyDeviceToHost, context->stream) != cudaSuccess
+      || cudaStreamSynchronize(context->stream) != cudaSuccess)
+    return false;
+  lltResult = info == 0 ? Eigen::Success : Eigen::NumericalIssue;
+  return true;
+}
+
+#else
+
+/* ************************************************************************* */
+bool available() {
+  return false;
+}
+
+/* ************************************************************************* */
+bool choleskyPartial(Matrix&, size_t, Eigen::ComputationInfo&) {
+  return false;
+}
+
+#endif
+
+} // namespace cuda
+} // namespace gtsam
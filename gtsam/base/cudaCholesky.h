@@ -0,0 +1,63 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    cudaCholesky.h
+ * @brief   Partial Cholesky factorization of large cliques on the GPU
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+
+namespace gtsam {
+
+/**
+ * Offload of the dense partial Cholesky factorization of large cliques to a CUDA GPU, with
+ * cuSOLVER potrf for the frontal block, cuBLAS trsm for S and cuBLAS syrk for the update of the
+ * separator block.  choleskyPartial calls it for cliques of dimension minCliqueDim() or more,
+ * which is where most of the flops of SfM and dense mapping problems are, and factors smaller
+ * cliques on the CPU.
+ *
+ * The factorization of a clique blocks only the thread that eliminates it, so during parallel
+ * elimination the other threads keep eliminating sibling subtrees on the CPU while the matrix is
+ * transferred and factored.  Up to maxStreams() cliques are factored concurrently, each on its
+ * own CUDA stream.  When all streams are busy, or the GPU fails, the clique is factored on the CPU.
+ *
+ * This is only active if GTSAM is configured with CUDA (GTSAM_WITH_CUDA) and a device is found at
+ * run time, otherwise available() is false and choleskyPartial() does nothing.
+ *
+ * @addtogroup base
+ */
+namespace cuda {
+
+/// Whether GTSAM was built with CUDA and a CUDA device is available
+GTSAM_EXPORT bool available();
+
+/// Smallest clique dimension factored on the GPU, 1024 by default
+GTSAM_EXPORT size_t minCliqueDim();
+
+/// Change the smallest clique dimension factored on the GPU
+GTSAM_EXPORT void setMinCliqueDim(size_t dim);
+
+/// Largest number of cliques factored on the GPU at the same time
+GTSAM_EXPORT size_t maxStreams();
+
+/**
+ * Same factorization as choleskyPartial, on the GPU.  On success, \c ABC holds R, S and L, and
+ * \c lltResult whether the frontal block was positive definite.
+ * @return \c false, leaving \c ABC unchanged, if the GPU is not available or busy, or failed
+ */
+GTSAM_EXPORT bool choleskyPartial(Matrix& ABC, size_t nFrontal, Eigen::ComputationInfo& lltResult);
+
+} // namespace cuda
+} // namespace gtsam
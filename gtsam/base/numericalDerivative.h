@@ -162,6 +162,51 @@ typename internal::FixedSizeMatrix<Y,X>::type numericalDerivative11(Y (*h)(const
   return numericalDerivative11<Y, X>(boost::bind(h, _1), x, delta);
 }
 
+namespace internal {
+/// numericalDerivativeFixed given the value hx = h(x), which callers often already have
+template<class Y, class X, class FUNCTOR>
+typename FixedSizeMatrix<Y,X>::type numericalDerivativeFixed(const FUNCTOR& h, const X& x,
+    const Y& hx, double delta) {
+  static const int M = traits<Y>::dimension;
+  static const int N = traits<X>::dimension;
+  BOOST_STATIC_ASSERT_MSG(M>0, "Template argument Y must be fixed-size type.");
+  BOOST_STATIC_ASSERT_MSG(N>0, "Template argument X must be fixed-size type.");
+  typedef traits<Y> TraitsY;
+  typedef traits<X> TraitsX;
+
+  // Local coordinates of h at x + delta*e_j in column j, and at x - delta*e_j in column n+j
+  Eigen::Matrix<double, M, 2 * N> dy;
+  typename TraitsX::TangentVector dx;
+  dx.setZero();
+  for (int j = 0; j < N; j++) {
+    dx(j) = delta;
+    dy.col(j) = TraitsY::Local(hx, h(TraitsX::Retract(x, dx)));
+    dx(j) = -delta;
+    dy.col(N + j) = TraitsY::Local(hx, h(TraitsX::Retract(x, dx)));
+    dx(j) = 0;
+  }
+  return (dy.template leftCols<N>() - dy.template rightCols<N>()) * (0.5 / delta);
+}
+}
+
+/**
+ * Fixed-size numerical derivative of a unary function, for use in production code.
+ * Unlike numericalDerivative11, h can be any callable (function pointer, functor or
+ * boost::bind expression) and is called directly instead of through a boost::function.
+ * All 2n perturbed arguments are evaluated into one fixed-size m*2n matrix of local
+ * coordinates, and the central differences are then taken for all columns at once.
+ * @param h unary function yielding a value of fixed dimension m
+ * @param x value of fixed dimension n at which to evaluate h
+ * @param delta increment for numerical derivative
+ * @return m*n Jacobian computed via central differencing
+ */
+template<class Y, class X, class FUNCTOR>
+typename internal::FixedSizeMatrix<Y,X>::type numericalDerivativeFixed(const FUNCTOR& h,
+    const X& x, double delta = 1e-5) {
+  const Y hx = h(x);
+  return internal::numericalDerivativeFixed<Y, X>(h, x, hx, delta);
+}
+
 /**
  * Compute numerical derivative in argument 1 of binary function
  * @param h binary function yielding m-vector
@@ -0,0 +1,352 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    simdKernels.cpp
+ * @brief   Small dense kernels with an implementation per instruction set, selected at run time
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/base/simdKernels.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// The kernels are written once, over a vector type V, and instantiated for every instruction set.
+// With GCC and Clang, V is a vector extension type and the x86 variants are compiled for their
+// instruction set with the target attribute; the bodies are forced inline into those functions
+// so that they are compiled with the same target. Other compilers get a scalar implementation.
+#if defined(__GNUC__) || defined(__clang__)
+#define GTSAM_SIMD_VECTOR_EXTENSIONS
+#define GTSAM_SIMD_INLINE inline __attribute__((always_inline))
+#if defined(__x86_64__) || defined(__i386__)
+#define GTSAM_SIMD_X86
+#endif
+#else
+#define GTSAM_SIMD_INLINE inline
+#endif
+
+// Wide vector types only appear in forced-inline functions, so no ABI is involved
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+namespace gtsam {
+namespace simd {
+
+namespace {
+
+#ifdef GTSAM_SIMD_VECTOR_EXTENSIONS
+typedef double Double2 __attribute__((vector_size(16)));
+typedef double Double4 __attribute__((vector_size(32)));
+typedef double Double8 __attribute__((vector_size(64)));
+#endif
+
+/* ************************************************************************* */
+// Lane-level helpers, for scalars and vector extension types
+template<class V>
+struct Lanes { static const size_t value = sizeof(V) / sizeof(double); };
+
+template<class V>
+GTSAM_SIMD_INLINE V load(const double* p) { V v; std::memcpy(&v, p, sizeof(V)); return v; }
+
+template<class V>
+GTSAM_SIMD_INLINE void store(double* p, const V& v) { std::memcpy(p, &v, sizeof(V)); }
+
+template<class V>
+GTSAM_SIMD_INLINE V broadcast(double a) {
+  V v;
+  for (size_t l = 0; l < Lanes<V>::value; ++l) v[l] = a;
+  return v;
+}
+template<>
+GTSAM_SIMD_INLINE double broadcast<double>(double a) { return a; }
+
+template<class V>
+GTSAM_SIMD_INLINE double sum(const V& v) {
+  double s = 0.0;
+  for (size_t l = 0; l < Lanes<V>::value; ++l) s += v[l];
+  return s;
+}
+template<>
+GTSAM_SIMD_INLINE double sum<double>(const double& v) { return v; }
+
+/* ************************************************************************* */
+// The kernels, see simdKernels.h
+template<class V>
+GTSAM_SIMD_INLINE double dot(size_t n, const double* a, const double* b) {
+  const size_t W = Lanes<V>::value;
+  V acc0 = broadcast<V>(0.0), acc1 = broadcast<V>(0.0);
+  size_t i = 0;
+  for (; i + 2 * W <= n; i += 2 * W) {
+    acc0 += load<V>(a + i) * load<V>(b + i);
+    acc1 += load<V>(a + i + W) * load<V>(b + i + W);
+  }
+  for (; i + W <= n; i += W)
+    acc0 += load<V>(a + i) * load<V>(b + i);
+  double s = sum<V>(acc0 + acc1);
+  for (; i < n; ++i)
+    s += a[i] * b[i];
+  return s;
+}
+
+template<class V>
+GTSAM_SIMD_INLINE void axpy(size_t n, double alpha, const double* x, double* y) {
+  const size_t W = Lanes<V>::value;
+  const V a = broadcast<V>(alpha);
+  size_t i = 0;
+  for (; i + W <= n; i += W)
+    store<V>(y + i, load<V>(y + i) + a * load<V>(x + i));
+  for (; i < n; ++i)
+    y[i] += alpha * x[i];
+}
+
+template<class V>
+GTSAM_SIMD_INLINE void gemmTNBody(size_t m, size_t n, size_t k, double alpha, const double* A,
+    size_t lda, const double* B, size_t ldb, double* C, size_t ldc, bool upper) {
+  for (size_t j = 0; j < n; ++j) {
+    const size_t rows = upper ? std::min(j + 1, m) : m;
+    for (size_t i = 0; i < rows; ++i)
+      C[i + j * ldc] += alpha * dot<V>(k, A + i * lda, B + j * ldb);
+  }
+}
+
+template<class V>
+GTSAM_SIMD_INLINE void gemvBody(size_t m, size_t n, double alpha, const double* A, size_t lda,
+    const double* x, double* y) {
+  for (size_t j = 0; j < n; ++j)
+    axpy<V>(m, alpha * x[j], A + j * lda, y);
+}
+
+template<class V>
+GTSAM_SIMD_INLINE void gemvTBody(size_t m, size_t n, double alpha, const double* A, size_t lda,
+    const double* x, double* y) {
+  for (size_t j = 0; j < n; ++j)
+    y[j] += alpha * dot<V>(m, A + j * lda, x);
+}
+
+template<class V>
+GTSAM_SIMD_INLINE void symvBody(size_t n, double alpha, const double* A, size_t lda,
+    const double* x, double* y) {
+  // Column j of the upper triangle contributes to y(0:j-1), and its transpose to y(j)
+  for (size_t j = 0; j < n; ++j) {
+    axpy<V>(j, alpha * x[j], A + j * lda, y);
+    y[j] += alpha * dot<V>(j + 1, A + j * lda, x);
+  }
+}
+
+template<class V>
+GTSAM_SIMD_INLINE bool lltBody(size_t n, double* A, size_t lda) {
+  // Column by column: R(i,j) = (A(i,j) - R(0:i-1,i)'*R(0:i-1,j)) / R(i,i), where both
+  // column segments are contiguous in memory.
+  for (size_t j = 0; j < n; ++j) {
+    double* Aj = A + j * lda;
+    for (size_t i = 0; i < j; ++i)
+      Aj[i] = (Aj[i] - dot<V>(i, A + i * lda, Aj)) / A[i + i * lda];
+    const double d = Aj[j] - dot<V>(j, Aj, Aj);
+    if (!(d > 0.0))
+      return false;
+    Aj[j] = std::sqrt(d);
+  }
+  return true;
+}
+
+template<class V>
+GTSAM_SIMD_INLINE void transformToBody(size_t n, const double* R, const double* t,
+    const double* p, size_t ldp, double* q, size_t ldq) {
+  const size_t W = Lanes<V>::value;
+  const double* px = p, *py = p + ldp, *pz = p + 2 * ldp;
+  double* qc[3] = { q, q + ldq, q + 2 * ldq };
+  size_t i = 0;
+  for (; i + W <= n; i += W) {
+    const V dx = load<V>(px + i) - broadcast<V>(t[0]);
+    const V dy = load<V>(py + i) - broadcast<V>(t[1]);
+    const V dz = load<V>(pz + i) - broadcast<V>(t[2]);
+    for (size_t c = 0; c < 3; ++c)
+      store<V>(qc[c] + i, dx * broadcast<V>(R[3 * c]) + dy * broadcast<V>(R[3 * c + 1])
+          + dz * broadcast<V>(R[3 * c + 2]));
+  }
+  for (; i < n; ++i) {
+    const double dx = px[i] - t[0], dy = py[i] - t[1], dz = pz[i] - t[2];
+    for (size_t c = 0; c < 3; ++c)
+      qc[c][i] = dx * R[3 * c] + dy * R[3 * c + 1] + dz * R[3 * c + 2];
+  }
+}
+
+/* ************************************************************************* */
+// One table of function pointers per instruction set
+struct Kernels {
+  void (*gemmTN)(size_t, size_t, size_t, double, const double*, size_t, const double*, size_t,
+      double*, size_t, bool);
+  void (*gemv)(size_t, size_t, double, const double*, size_t, const double*, double*);
+  void (*gemvT)(size_t, size_t, double, const double*, size_t, const double*, double*);
+  void (*symv)(size_t, double, const double*, size_t, const double*, double*);
+  bool (*llt)(size_t, double*, size_t);
+  void (*transformTo)(size_t, const double*, const double*, const double*, size_t, double*,
+      size_t);
+};
+
+#define GTSAM_SIMD_DEFINE_KERNELS(NAME, V, TARGET) \
+  TARGET void gemmTN_##NAME(size_t m, size_t n, size_t k, double alpha, const double* A, \
+      size_t lda, const double* B, size_t ldb, double* C, size_t ldc, bool upper) { \
+    gemmTNBody<V>(m, n, k, alpha, A, lda, B, ldb, C, ldc, upper); } \
+  TARGET void gemv_##NAME(size_t m, size_t n, double alpha, const double* A, size_t lda, \
+      const double* x, double* y) { gemvBody<V>(m, n, alpha, A, lda, x, y); } \
+  TARGET void gemvT_##NAME(size_t m, size_t n, double alpha, const double* A, size_t lda, \
+      const double* x, double* y) { gemvTBody<V>(m, n, alpha, A, lda, x, y); } \
+  TARGET void symv_##NAME(size_t n, double alpha, const double* A, size_t lda, \
+      const double* x, double* y) { symvBody<V>(n, alpha, A, lda, x, y); } \
+  TARGET bool llt_##NAME(size_t n, double* A, size_t lda) { return lltBody<V>(n, A, lda); } \
+  TARGET void transformTo_##NAME(size_t n, const double* R, const double* t, const double* p, \
+      size_t ldp, double* q, size_t ldq) { transformToBody<V>(n, R, t, p, ldp, q, ldq); } \
+  const Kernels NAME##Kernels = { &gemmTN_##NAME, &gemv_##NAME, &gemvT_##NAME, &symv_##NAME, \
+      &llt_##NAME, &transformTo_##NAME };
+
+#ifdef GTSAM_SIMD_VECTOR_EXTENSIONS
+GTSAM_SIMD_DEFINE_KERNELS(generic, Double2, )
+#else
+GTSAM_SIMD_DEFINE_KERNELS(generic, double, )
+#endif
+
+#ifdef GTSAM_SIMD_X86
+GTSAM_SIMD_DEFINE_KERNELS(avx2, Double4, __attribute__((target("avx2,fma"))))
+GTSAM_SIMD_DEFINE_KERNELS(avx512, Double8, __attribute__((target("avx512f,fma"))))
+#endif
+
+/* ************************************************************************* */
+bool cpuSupports(Isa isa) {
+  switch (isa) {
+  case GENERIC:
+    return true;
+  case NEON:
+#if defined(__aarch64__) || defined(__ARM_NEON)
+    return true;
+#else
+    return false;
+#endif
+#ifdef GTSAM_SIMD_X86
+  case AVX2:
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  case AVX512:
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("fma");
+#endif
+  default:
+    return false;
+  }
+}
+
+const Kernels& kernelsFor(Isa isa) {
+#ifdef GTSAM_SIMD_X86
+  if (isa == AVX512) return avx512Kernels;
+  if (isa == AVX2) return avx2Kernels;
+#endif
+  (void)isa;
+  return genericKernels;
+}
+
+// The widest supported instruction set, or the one named by GTSAM_SIMD if it is supported
+Isa initialIsa() {
+  const Isa all[] = { AVX512, AVX2, NEON, GENERIC };
+  if (const char* requested = std::getenv("GTSAM_SIMD")) {
+    for (size_t k = 0; k < 4; ++k)
+      if (isaName(all[k]) == std::string(requested) && cpuSupports(all[k]))
+        return all[k];
+  }
+  for (size_t k = 0; k < 4; ++k)
+    if (cpuSupports(all[k]))
+      return all[k];
+  return GENERIC;
+}
+
+struct Dispatch {
+  Isa isa;
+  const Kernels* kernels;
+  Dispatch() : isa(initialIsa()), kernels(&kernelsFor(isa)) {}
+};
+
+Dispatch& dispatch() {
+  static Dispatch instance;
+  return instance;
+}
+
+// Select the kernels when the library is loaded rather than on the first call
+const Dispatch& selectedAtStartup = dispatch();
+
+} // namespace
+
+/* ************************************************************************* */
+const char* isaName(Isa isa) {
+  switch (isa) {
+  case NEON: return "neon";
+  case AVX2: return "avx2";
+  case AVX512: return "avx512";
+  default: return "generic";
+  }
+}
+
+/* ************************************************************************* */
+bool isSupported(Isa isa) {
+  return cpuSupports(isa);
+}
+
+/* ************************************************************************* */
+Isa activeIsa() {
+  return dispatch().isa;
+}
+
+/* ************************************************************************* */
+bool setActiveIsa(Isa isa) {
+  if (!cpuSupports(isa))
+    return false;
+  dispatch().isa = isa;
+  dispatch().kernels = &kernelsFor(isa);
+  return true;
+}
+
+/* ************************************************************************* */
+void gemmTN(size_t m, size_t n, size_t k, double alpha, const double* A, size_t lda,
+    const double* B, size_t ldb, double* C, size_t ldc, bool upper) {
+  dispatch().kernels->gemmTN(m, n, k, alpha, A, lda, B, ldb, C, ldc, upper);
+}
+
+/* ************************************************************************* */
+void gemv(size_t m, size_t n, double alpha, const double* A, size_t lda, const double* x,
+    double* y) {
+  dispatch().kernels->gemv(m, n, alpha, A, lda, x, y);
+}
+
+/* ************************************************************************* */
+void gemvT(size_t m, size_t n, double alpha, const double* A, size_t lda, const double* x,
+    double* y) {
+  dispatch().kernels->gemvT(m, n, alpha, A, lda, x, y);
+}
+
+/* ************************************************************************* */
+void symv(size_t n, double alpha, const double* A, size_t lda, const double* x, double* y) {
+  dispatch().kernels->symv(n, alpha, A, lda, x, y);
+}
+
+/* ************************************************************************* */
+bool llt(size_t n, double* A, size_t lda) {
+  return dispatch().kernels->llt(n, A, lda);
+}
+
+/* ************************************************************************* */
+void transformTo(size_t n, const double* R, const double* t, const double* p, size_t ldp,
+    double* q, size_t ldq) {
+  dispatch().kernels->transformTo(n, R, t, p, ldp, q, ldq);
+}
+
+} // namespace simd
+} // namespace gtsam
@@ -0,0 +1,93 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    simdKernels.h
+ * @brief   Small dense kernels with an implementation per instruction set, selected at run time
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/dllexport.h>
+#include <cstddef>
+
+namespace gtsam {
+
+/**
+ * Hot dense kernels on raw column-major storage, compiled once per instruction set and
+ * dispatched at run time, so that one binary uses AVX2 or AVX-512 where the CPU has them.
+ *
+ * Eigen picks its packet size when GTSAM is compiled, so a build that has to run on older
+ * CPUs never uses the wider registers. These kernels cover the small blocks that dominate
+ * elimination: the frontal Cholesky factorization, the A'*B products of updateHessian and
+ * the Hessian-vector products of multiplyHessianAdd, plus batched point transforms. Matrix
+ * products on blocks larger than MaxBlockSize stay with Eigen, whose blocked products win there.
+ *
+ * The instruction set is chosen when the library is loaded: the widest one the CPU supports,
+ * unless the environment variable GTSAM_SIMD names another one (generic, neon, avx2, avx512).
+ * On AArch64 NEON is part of the base instruction set, so the generic kernels already use it.
+ *
+ * @addtogroup base
+ */
+namespace simd {
+
+/// Instruction sets with a kernel implementation
+enum Isa {
+  GENERIC, ///< Whatever the compiler targets by default
+  NEON,    ///< ARM NEON, the default on AArch64
+  AVX2,    ///< x86 AVX2 with FMA
+  AVX512   ///< x86 AVX-512F
+};
+
+/// Largest block dimension for which callers should prefer these kernels over Eigen
+static const size_t MaxBlockSize = 32;
+
+/// Name of an instruction set, as accepted by GTSAM_SIMD
+GTSAM_EXPORT const char* isaName(Isa isa);
+
+/// Whether this build and the CPU it runs on support the given instruction set
+GTSAM_EXPORT bool isSupported(Isa isa);
+
+/// The instruction set currently used by the kernels
+GTSAM_EXPORT Isa activeIsa();
+
+/// Use the given instruction set from now on, returns false (and changes nothing) if unsupported
+GTSAM_EXPORT bool setActiveIsa(Isa isa);
+
+/// C += alpha * A' * B, with A k*m, B k*n and C m*n. If upper is true, only the upper triangle
+/// of C is updated, which is all that is needed when A == B.
+GTSAM_EXPORT void gemmTN(size_t m, size_t n, size_t k, double alpha, const double* A, size_t lda,
+    const double* B, size_t ldb, double* C, size_t ldc, bool upper = false);
+
+/// y += alpha * A * x, with A m*n
+GTSAM_EXPORT void gemv(size_t m, size_t n, double alpha, const double* A, size_t lda,
+    const double* x, double* y);
+
+/// y += alpha * A' * x, with A m*n
+GTSAM_EXPORT void gemvT(size_t m, size_t n, double alpha, const double* A, size_t lda,
+    const double* x, double* y);
+
+/// y += alpha * A * x for a symmetric n*n matrix A of which only the upper triangle is read
+GTSAM_EXPORT void symv(size_t n, double alpha, const double* A, size_t lda, const double* x,
+    double* y);
+
+/// Cholesky factorization A = R'*R in place, into the upper triangle of the n*n matrix A. The
+/// strictly lower triangle is not touched. Returns false on a non-positive pivot, like Eigen::LLT.
+GTSAM_EXPORT bool llt(size_t n, double* A, size_t lda);
+
+/// q = (p - t)' * R for n points, with the point coordinates p and results q stored as the three
+/// columns of n*3 matrices with leading dimensions ldp and ldq, see Pose3::transform_to
+GTSAM_EXPORT void transformTo(size_t n, const double* R, const double* t, const double* p,
+    size_t ldp, double* q, size_t ldq);
+
+} // namespace simd
+} // namespace gtsam
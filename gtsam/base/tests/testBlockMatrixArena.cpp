@@ -0,0 +1,108 @@
+/* ----------------------------------------------------------------------------
+
+* GTSAM Copyright 2010, Georgia Tech Research Corporation,
+* Atlanta, Georgia 30332-0415
+* All Rights Reserved
+* Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+* See LICENSE for the license information
+
+* -------------------------------------------------------------------------- */
+
+/**
+* @file   testBlockMatrixArena.cpp
+* @brief  Unit tests for BlockMatrixArena
+**/
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam/base/BlockMatrixArena.h>
+#include <gtsam/base/SymmetricBlockMatrix.h>
+#include <gtsam/base/VerticalBlockMatrix.h>
+#include <boost/assign/list_of.hpp>
+
+using namespace std;
+using namespace gtsam;
+using boost::assign::list_of;
+
+/* ************************************************************************* */
+TEST(BlockMatrixArena, Disabled)
+{
+  BlockMatrixArena::SetEnabled(false);
+  BlockMatrixArena::Scope scope;
+  EXPECT(!BlockMatrixArena::Active());
+
+  Matrix m;
+  BlockMatrixArena::Allocate(m, 3, 4);
+  EXPECT_LONGS_EQUAL(12, m.size());
+  BlockMatrixArena::Recycle(m);
+  EXPECT_LONGS_EQUAL(12, m.size());
+  EXPECT_LONGS_EQUAL(0, BlockMatrixArena::CachedBytes());
+}
+
+/* ************************************************************************* */
+TEST(BlockMatrixArena, RecycleMatrix)
+{
+  BlockMatrixArena::SetEnabled(true);
+  {
+    BlockMatrixArena::Scope scope;
+    EXPECT(BlockMatrixArena::Active());
+
+    Matrix m;
+    BlockMatrixArena::Allocate(m, 3, 4);
+    const double* data = m.data();
+    BlockMatrixArena::Recycle(m);
+    EXPECT_LONGS_EQUAL(0, m.size());
+    EXPECT_LONGS_EQUAL(12 * sizeof(double), BlockMatrixArena::CachedBytes());
+
+    // Same number of entries, different shape, reuses the storage
+    Matrix m2;
+    BlockMatrixArena::Allocate(m2, 6, 2);
+    EXPECT_LONGS_EQUAL(6, m2.rows());
+    EXPECT_LONGS_EQUAL(2, m2.cols());
+    EXPECT(data == m2.data());
+    EXPECT_LONGS_EQUAL(0, BlockMatrixArena::CachedBytes());
+
+    BlockMatrixArena::Recycle(m2);
+    {
+      // Nested scopes do not release the cache
+      BlockMatrixArena::Scope nested;
+    }
+    EXPECT_LONGS_EQUAL(12 * sizeof(double), BlockMatrixArena::CachedBytes());
+  }
+  // Closing the outermost scope releases everything
+  EXPECT(!BlockMatrixArena::Active());
+  EXPECT_LONGS_EQUAL(0, BlockMatrixArena::CachedBytes());
+  BlockMatrixArena::SetEnabled(false);
+}
+
+/* ************************************************************************* */
+TEST(BlockMatrixArena, RecycleBlockMatrices)
+{
+  BlockMatrixArena::SetEnabled(true);
+  {
+    BlockMatrixArena::Scope scope;
+
+    SymmetricBlockMatrix symmetric(list_of(3)(2)(1));
+    const double* data = symmetric.matrix().nestedExpression().data();
+    BlockMatrixArena::Recycle(symmetric);
+    EXPECT_LONGS_EQUAL(0, symmetric.rows());
+    EXPECT_LONGS_EQUAL(0, symmetric.nBlocks());
+    EXPECT_LONGS_EQUAL(36 * sizeof(double), BlockMatrixArena::CachedBytes());
+
+    // A 4x9 vertical block matrix has the same number of entries
+    VerticalBlockMatrix vertical(list_of(3)(6), 4);
+    EXPECT(data == vertical.matrix().data());
+    EXPECT_LONGS_EQUAL(0, BlockMatrixArena::CachedBytes());
+
+    BlockMatrixArena::Recycle(vertical);
+    EXPECT_LONGS_EQUAL(0, vertical.rows());
+    EXPECT_LONGS_EQUAL(0, vertical.cols());
+    EXPECT_LONGS_EQUAL(36 * sizeof(double), BlockMatrixArena::CachedBytes());
+  }
+  EXPECT_LONGS_EQUAL(0, BlockMatrixArena::CachedBytes());
+  BlockMatrixArena::SetEnabled(false);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
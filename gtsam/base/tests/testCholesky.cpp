@@ -53,6 +53,77 @@ TEST(cholesky, choleskyPartial) {
   EXPECT(assert_equal(expected, actual, 1e-9));
 }
 
+/* ************************************************************************* */
+TEST(cholesky, choleskyPartialFixedSizes) {
+
+  // Frontal block sizes with fixed-size kernels, and one without
+  const size_t frontalSizes[] = { 1, 2, 3, 6, 9, 15, 7 };
+  for (size_t k = 0; k < sizeof(frontalSizes) / sizeof(size_t); ++k) {
+    const size_t nFrontal = frontalSizes[k], n = nFrontal + 5;
+    Matrix A = Matrix::Random(n + 3, n);
+    const Matrix ABC = A.transpose() * A;
+
+    // Only the upper triangle should be used
+    Matrix RSL = ABC.triangularView<Eigen::Upper>();
+    EXPECT(choleskyPartial(RSL, nFrontal));
+
+    Matrix R1 = RSL.triangularView<Eigen::Upper>();
+    R1 = R1.transpose().eval();
+    Matrix R2 = RSL.triangularView<Eigen::Upper>();
+    R1.block(nFrontal, nFrontal, n - nFrontal, n - nFrontal).setIdentity();
+    R2.block(nFrontal, nFrontal, n - nFrontal, n - nFrontal) =
+        RSL.block(nFrontal, nFrontal, n - nFrontal, n - nFrontal).selfadjointView<Eigen::Upper>();
+    EXPECT(assert_equal(ABC, R1 * R2, 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(cholesky, choleskyPartialLargeCliques) {
+
+  // Cliques large enough for the blocked factorization with TBB, dominated by the frontal block
+  // and by the separator, with sizes that are not multiples of the block size
+  const size_t frontalSizes[] = { 300, 10 }, separatorSizes[] = { 70, 290 };
+  for (size_t k = 0; k < 2; ++k) {
+    const size_t nFrontal = frontalSizes[k], n = nFrontal + separatorSizes[k];
+    Matrix A = Matrix::Random(n + 3, n);
+    const Matrix ABC = A.transpose() * A;
+
+    // Only the upper triangle should be used and written
+    Matrix RSL = ABC.triangularView<Eigen::Upper>();
+    EXPECT(choleskyPartial(RSL, nFrontal));
+    EXPECT(RSL.triangularView<Eigen::StrictlyLower>().toDenseMatrix().isZero());
+
+    Matrix R1 = RSL.triangularView<Eigen::Upper>();
+    R1 = R1.transpose().eval();
+    Matrix R2 = RSL.triangularView<Eigen::Upper>();
+    R1.block(nFrontal, nFrontal, n - nFrontal, n - nFrontal).setIdentity();
+    R2.block(nFrontal, nFrontal, n - nFrontal, n - nFrontal) =
+        RSL.block(nFrontal, nFrontal, n - nFrontal, n - nFrontal).selfadjointView<Eigen::Upper>();
+    EXPECT(assert_equal(ABC, R1 * R2, 1e-6));
+  }
+
+  // Indefinite frontal block
+  Matrix indefinite = -Matrix::Identity(300, 300);
+  EXPECT(!choleskyPartial(indefinite, 200));
+}
+
+/* ************************************************************************* */
+TEST(cholesky, choleskyPartialSinglePrecision) {
+  const size_t nFrontal = 6, n = nFrontal + 5;
+  Matrix A = Matrix::Random(n + 3, n);
+  const Matrix ABC = A.transpose() * A;
+
+  Matrix expected = ABC.triangularView<Eigen::Upper>();
+  EXPECT(choleskyPartial(expected, nFrontal));
+
+  // Same factorization, only accurate to single precision
+  Matrix actual = ABC.triangularView<Eigen::Upper>();
+  EXPECT(choleskyPartialSinglePrecision(actual, nFrontal));
+  Matrix upperExpected = expected.triangularView<Eigen::Upper>(),
+      upperActual = actual.triangularView<Eigen::Upper>();
+  EXPECT(assert_equal(upperExpected, upperActual, 1e-4));
+}
+
 /* ************************************************************************* */
 TEST(cholesky, BadScalingCholesky) {
   Matrix A = (Matrix(2,2) <<
@@ -0,0 +1,73 @@
+/* ----------------------------------------------------------------------------
+
+* GTSAM Copyright 2010, Georgia Tech Research Corporation,
+* Atlanta, Georgia 30332-0415
+* All Rights Reserved
+* Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+* See LICENSE for the license information
+
+* -------------------------------------------------------------------------- */
+
+/**
+* @file   testCudaCholesky.cpp
+* @brief  Unit tests for the GPU partial Cholesky factorization, checked against the CPU when the
+*         machine has a CUDA device
+**/
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam/base/cudaCholesky.h>
+#include <gtsam/base/cholesky.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(cudaCholesky, minCliqueDim)
+{
+  const size_t initial = cuda::minCliqueDim();
+  cuda::setMinCliqueDim(100);
+  EXPECT_LONGS_EQUAL(100, cuda::minCliqueDim());
+  cuda::setMinCliqueDim(initial);
+  EXPECT(cuda::maxStreams() > 0);
+}
+
+/* ************************************************************************* */
+TEST(cudaCholesky, choleskyPartial)
+{
+  const size_t nFrontal = 200, n = 330;
+  Matrix A = Matrix::Random(n + 3, n);
+  const Matrix ABC = A.transpose() * A;
+
+  Matrix actual = ABC;
+  Eigen::ComputationInfo lltResult = Eigen::NumericalIssue;
+  if (!cuda::available()) {
+    // Without a GPU nothing is done
+    EXPECT(!cuda::choleskyPartial(actual, nFrontal, lltResult));
+    EXPECT(assert_equal(ABC, actual));
+    return;
+  }
+
+  EXPECT(cuda::choleskyPartial(actual, nFrontal, lltResult));
+  EXPECT(lltResult == Eigen::Success);
+
+  // Same factorization as on the CPU, with the strictly lower triangle unchanged
+  const size_t initial = cuda::minCliqueDim();
+  cuda::setMinCliqueDim(n + 1);
+  Matrix expected = ABC;
+  EXPECT(choleskyPartial(expected, nFrontal));
+  cuda::setMinCliqueDim(initial);
+  EXPECT(assert_equal(Matrix(expected.triangularView<Eigen::Upper>()),
+      Matrix(actual.triangularView<Eigen::Upper>()), 1e-6));
+  EXPECT(assert_equal(Matrix(ABC.triangularView<Eigen::StrictlyLower>()),
+      Matrix(actual.triangularView<Eigen::StrictlyLower>())));
+
+  // An indefinite frontal block is reported
+  Matrix indefinite = -Matrix::Identity(n, n);
+  EXPECT(cuda::choleskyPartial(indefinite, nFrontal, lltResult));
+  EXPECT(lltResult != Eigen::Success);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -0,0 +1,97 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testDSFConcurrent.cpp
+ * @date Oct 14, 2026
+ * @brief unit tests for DSFConcurrent
+ */
+
+#include <gtsam/base/DSFConcurrent.h>
+#include <gtsam/base/DSFVector.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(DSFConcurrent, merge) {
+  DSFConcurrent dsf(5);
+  EXPECT(dsf.merge(3, 1));
+  EXPECT(dsf.merge(4, 3));
+  EXPECT(!dsf.merge(1, 4));
+  EXPECT_LONGS_EQUAL(1, dsf.find(4));
+  EXPECT_LONGS_EQUAL(0, dsf.find(0));
+  EXPECT_LONGS_EQUAL(2, dsf.find(2));
+
+  map<size_t, vector<size_t> > expected;
+  expected[0].push_back(0);
+  expected[1].push_back(1); expected[1].push_back(3); expected[1].push_back(4);
+  expected[2].push_back(2);
+  EXPECT(expected == dsf.arrays());
+}
+
+/* ************************************************************************* */
+TEST(DSFConcurrent, mergeEdges) {
+  // Random edges, compared with the sequential DSFBase
+  const size_t n = 2000;
+  DSFConcurrent::Edges edges;
+  size_t seed = 12345;
+  for (size_t k = 0; k < 1500; ++k) {
+    seed = seed * 1103515245 + 12345;
+    const size_t i = (seed >> 8) % n;
+    seed = seed * 1103515245 + 12345;
+    edges.push_back(make_pair(i, (seed >> 8) % n));
+  }
+  DSFConcurrent dsf(n);
+  dsf.merge(edges, 100);
+  DSFBase expected(n);
+  for (size_t k = 0; k < edges.size(); ++k)
+    expected.merge(edges[k].first, edges[k].second);
+
+  const vector<size_t> labels = dsf.labels();
+  for (size_t i = 0; i < n; ++i) {
+    EXPECT_LONGS_EQUAL(labels[i], dsf.find(i));
+    EXPECT(labels[i] <= i);
+    for (size_t j = i + 1; j < n; j += 97)
+      EXPECT((labels[i] == labels[j]) == (expected.find(i) == expected.find(j)));
+  }
+}
+
+/* ************************************************************************* */
+namespace {
+  void mergeRange(DSFConcurrent* dsf, size_t first, size_t last) {
+    for (size_t i = first; i + 1 < last; ++i)
+      dsf->merge(i + 1, i);
+  }
+}
+
+TEST(DSFConcurrent, threads) {
+  // Four threads each merge an overlapping stretch of a chain
+  DSFConcurrent dsf(4000);
+  boost::thread_group threads;
+  for (size_t t = 0; t < 4; ++t)
+    threads.create_thread(boost::bind(&mergeRange, &dsf, t * 1000,
+        std::min((t + 1) * 1000 + 1, dsf.size())));
+  threads.join_all();
+  for (size_t i = 0; i < dsf.size(); ++i)
+    EXPECT_LONGS_EQUAL(0, dsf.find(i));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -0,0 +1,100 @@
+/* ----------------------------------------------------------------------------
+
+* GTSAM Copyright 2010, Georgia Tech Research Corporation,
+* Atlanta, Georgia 30332-0415
+* All Rights Reserved
+* Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+* See LICENSE for the license information
+
+* -------------------------------------------------------------------------- */
+
+/**
+* @file   testFlatKeyMap.cpp
+* @brief  Unit tests for FlatKeyMap
+**/
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam/base/FlatKeyMap.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(FlatKeyMap, insertFind)
+{
+  FlatKeyMap<size_t> map;
+  EXPECT(map.empty());
+  EXPECT(map.find(5) == map.end());
+
+  // Insert enough keys to rehash several times
+  for (size_t i = 0; i < 1000; ++i)
+    EXPECT(map.insert(make_pair(Key(1000 - i), i)).second);
+  EXPECT_LONGS_EQUAL(1000, map.size());
+  EXPECT(!map.insert(make_pair(Key(7), size_t(0))).second);
+  EXPECT(!map.insert2(7, 0));
+
+  for (size_t i = 0; i < 1000; ++i) {
+    EXPECT(map.exists(1000 - i));
+    EXPECT_LONGS_EQUAL(i, map.at(1000 - i));
+  }
+  EXPECT(!map.exists(0));
+  EXPECT_LONGS_EQUAL(0, map.count(1001));
+  CHECK_EXCEPTION(map.at(1001), std::out_of_range);
+
+  // Iterates in insertion order
+  EXPECT_LONGS_EQUAL(1000, map.begin()->first);
+
+  map[2000] = 5;
+  EXPECT_LONGS_EQUAL(5, map.at(2000));
+  EXPECT_LONGS_EQUAL(0, map[3000]);
+  EXPECT_LONGS_EQUAL(1002, map.size());
+}
+
+/* ************************************************************************* */
+TEST(FlatKeyMap, erase)
+{
+  FlatKeyMap<int> map;
+  for (int i = 0; i < 100; ++i)
+    map[Key(i) << 32] = i;
+
+  for (int i = 0; i < 100; i += 2)
+    EXPECT_LONGS_EQUAL(1, map.erase(Key(i) << 32));
+  EXPECT_LONGS_EQUAL(0, map.erase(0));
+  EXPECT_LONGS_EQUAL(50, map.size());
+
+  for (int i = 0; i < 100; ++i) {
+    if (i % 2 == 0) {
+      EXPECT(!map.exists(Key(i) << 32));
+    } else {
+      EXPECT_LONGS_EQUAL(i, map.at(Key(i) << 32));
+    }
+  }
+}
+
+/* ************************************************************************* */
+TEST(FlatKeyMap, sortByKeyAndEquals)
+{
+  FlatKeyMap<int> map, other;
+  map[3] = 3; map[1] = 1; map[2] = 2;
+  other[1] = 1; other[2] = 2; other[3] = 3;
+  EXPECT(map == other);
+  other[3] = 4;
+  EXPECT(map != other);
+
+  map.sortByKey();
+  FlatKeyMap<int>::const_iterator it = map.begin();
+  EXPECT_LONGS_EQUAL(1, (it++)->first);
+  EXPECT_LONGS_EQUAL(2, (it++)->first);
+  EXPECT_LONGS_EQUAL(3, (it++)->first);
+  EXPECT(it == map.end());
+  EXPECT_LONGS_EQUAL(2, map.at(2));
+
+  FastMap<Key, int> fastMap = map;
+  EXPECT_LONGS_EQUAL(3, fastMap.size());
+  EXPECT_LONGS_EQUAL(3, fastMap.at(3));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
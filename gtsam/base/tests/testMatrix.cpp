@@ -896,6 +896,20 @@ TEST(Matrix, eigen_QR )
   EXPECT(assert_equal(expected, A, 1e-3));
 }
 
+/* ************************************************************************* */
+TEST(Matrix, inplace_QR_tall )
+{
+  // Tall enough to be factored by row tiles, with a remainder in the last tile
+  const Matrix A = Matrix::Random(1100, 9);
+  Matrix actual = A;
+  inplace_QR(actual);
+
+  // Same R as a QR of the whole matrix, up to the signs of the rows
+  const Matrix R = Eigen::HouseholderQR<Matrix>(A).matrixQR().topRows(9).triangularView<Eigen::Upper>();
+  EXPECT(assert_equal(Matrix(R.cwiseAbs()), Matrix(actual.topRows(9).cwiseAbs()), 1e-9));
+  EXPECT(assert_equal(Matrix::Zero(1091, 9), Matrix(actual.bottomRows(1091))));
+}
+
 /* ************************************************************************* */
 // unit test for qr factorization (and hence householder)
 // This behaves the same as QR in matlab: [Q,R] = qr(A), except for signs
@@ -135,6 +135,38 @@ TEST(testNumericalDerivative, numericalHessian311) {
   EXPECT(assert_equal(expected33, actual33, 1e-5));
 }
 
+/* ************************************************************************* */
+Vector3 h(const Vector2& x) {
+  return Vector3(sin(x(0)) * x(1), cos(x(1)), x(0) * x(0) * x(1));
+}
+
+struct Scaled {
+  double s;
+  Vector3 operator()(const Vector2& x) const {
+    return s * h(x);
+  }
+};
+
+/* ************************************************************************* */
+TEST(testNumericalDerivative, numericalDerivativeFixed) {
+  Vector2 x(0.3, -1.2);
+
+  Matrix32 expected;
+  expected << cos(x(0)) * x(1), sin(x(0)),
+              0, -sin(x(1)),
+              2 * x(0) * x(1), x(0) * x(0);
+
+  // function pointer, without any boost::function
+  Matrix32 actual = numericalDerivativeFixed<Vector3, Vector2>(h, x);
+  EXPECT(assert_equal(expected, actual, 1e-8));
+  EXPECT(assert_equal(numericalDerivative11<Vector3, Vector2>(h, x), actual, 1e-12));
+
+  // functor
+  Scaled scaled = { 2.0 };
+  EXPECT(assert_equal(Matrix(2 * expected),
+      numericalDerivativeFixed<Vector3, Vector2>(scaled, x), 1e-8));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
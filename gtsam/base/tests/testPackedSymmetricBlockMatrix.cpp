@@ -0,0 +1,110 @@
+/* ----------------------------------------------------------------------------
+
+* GTSAM Copyright 2010, Georgia Tech Research Corporation,
+* Atlanta, Georgia 30332-0415
+* All Rights Reserved
+* Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+* See LICENSE for the license information
+
+* -------------------------------------------------------------------------- */
+
+/**
+* @file   testPackedSymmetricBlockMatrix.cpp
+* @brief  Unit tests for PackedSymmetricBlockMatrix class
+**/
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam/base/PackedSymmetricBlockMatrix.h>
+#include <gtsam/base/SymmetricBlockMatrix.h>
+#include <gtsam/base/VerticalBlockMatrix.h>
+#include <boost/assign/list_of.hpp>
+
+using namespace std;
+using namespace gtsam;
+using boost::assign::list_of;
+
+static const Matrix testMatrix = (Matrix(6, 6) <<
+  1, 2, 3, 4, 5, 6,
+  2, 8, 9, 10, 11, 12,
+  3, 9, 15, 16, 17, 18,
+  4, 10, 16, 22, 23, 24,
+  5, 11, 17, 23, 29, 30,
+  6, 12, 18, 24, 30, 36).finished();
+
+/* ************************************************************************* */
+TEST(PackedSymmetricBlockMatrix, Pack)
+{
+  const PackedSymmetricBlockMatrix packed(SymmetricBlockMatrix(list_of(3)(2)(1), testMatrix));
+  EXPECT_LONGS_EQUAL(3, packed.nBlocks());
+  EXPECT_LONGS_EQUAL(6, packed.rows());
+  // 9 + 5*2 + 6*1 instead of 36
+  EXPECT_LONGS_EQUAL(25, packed.packedSize());
+
+  EXPECT(assert_equal(Matrix(testMatrix.block(0, 3, 3, 2)), Matrix(packed(0, 1))));
+  EXPECT(assert_equal(Matrix(testMatrix.block(3, 5, 2, 1)), Matrix(packed(1, 2))));
+  EXPECT(assert_equal(Matrix(testMatrix.block(3, 3, 2, 2).triangularView<Eigen::Upper>()),
+      Matrix(Matrix(packed(1, 1)).triangularView<Eigen::Upper>())));
+  EXPECT(assert_equal(testMatrix, packed.selfadjointView()));
+  EXPECT(assert_equal(testMatrix, Matrix(packed.unpack().full().selfadjointView())));
+
+  // The active view only
+  SymmetricBlockMatrix restricted(list_of(3)(2)(1), testMatrix);
+  restricted.blockStart() = 1;
+  const PackedSymmetricBlockMatrix packedView(restricted);
+  EXPECT_LONGS_EQUAL(2, packedView.nBlocks());
+  EXPECT(assert_equal(Matrix(testMatrix.bottomRightCorner(3, 3)), packedView.selfadjointView()));
+}
+
+/* ************************************************************************* */
+TEST(PackedSymmetricBlockMatrix, WriteBlocks)
+{
+  PackedSymmetricBlockMatrix packed(list_of(3)(2)(1));
+  EXPECT(assert_equal(Matrix::Zero(6, 6), packed.selfadjointView()));
+  packed(0, 2) = Vector3(1, 2, 3);
+  packed(2, 2)(0, 0) = 4;
+  Matrix expected = Matrix::Zero(6, 6);
+  expected.block(0, 5, 3, 1) << 1, 2, 3;
+  expected.block(5, 0, 1, 3) << 1, 2, 3;
+  expected(5, 5) = 4;
+  EXPECT(assert_equal(expected, packed.selfadjointView()));
+}
+
+/* ************************************************************************* */
+TEST(PackedSymmetricBlockMatrix, updateHessian)
+{
+  const PackedSymmetricBlockMatrix packed(SymmetricBlockMatrix(list_of(3)(2)(1), testMatrix));
+
+  // Add into a larger matrix with the first two blocks swapped
+  SymmetricBlockMatrix info(list_of(1)(2)(3)(1));
+  info.full().triangularView().setZero();
+  packed.updateHessian(list_of(2)(1)(3), &info);
+
+  Matrix expected = Matrix::Zero(7, 7);
+  const size_t order[] = { 3, 4, 0, 1, 2, 5 }; // scalar column of the packed matrix
+  for (size_t i = 1; i < 7; ++i)
+    for (size_t j = 1; j < 7; ++j)
+      expected(i, j) = testMatrix(order[i - 1], order[j - 1]);
+  EXPECT(assert_equal(expected, Matrix(info.full().selfadjointView())));
+}
+
+/* ************************************************************************* */
+TEST(PackedSymmetricBlockMatrix, choleskyPartial)
+{
+  Matrix A = Matrix::Random(9, 6);
+  const Matrix ABC = A.transpose() * A;
+
+  SymmetricBlockMatrix dense(list_of(3)(2)(1), ABC);
+  const VerticalBlockMatrix expectedAb = dense.choleskyPartial(1);
+
+  PackedSymmetricBlockMatrix packed(SymmetricBlockMatrix(list_of(3)(2)(1), ABC));
+  const VerticalBlockMatrix actualAb = packed.choleskyPartial(1);
+
+  EXPECT(assert_equal(Matrix(expectedAb.full()), Matrix(actualAb.full()), 1e-9));
+  EXPECT_LONGS_EQUAL(2, packed.nBlocks());
+  EXPECT(assert_equal(Matrix(dense.full().selfadjointView()), packed.selfadjointView(), 1e-9));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -0,0 +1,69 @@
+/* ----------------------------------------------------------------------------
+
+* GTSAM Copyright 2010, Georgia Tech Research Corporation,
+* Atlanta, Georgia 30332-0415
+* All Rights Reserved
+* Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+* See LICENSE for the license information
+
+* -------------------------------------------------------------------------- */
+
+/**
+* @file   testScratchBuffer.cpp
+* @brief  Unit tests for ScratchBuffer
+**/
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam/base/ScratchBuffer.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(ScratchBuffer, Reuse)
+{
+  char* first;
+  {
+    ScratchBuffer::Lease lease(100);
+    first = lease.data();
+    EXPECT_LONGS_EQUAL(0, reinterpret_cast<size_t>(first) % ScratchBuffer::Alignment);
+    EXPECT(ScratchBuffer::Capacity() >= 100);
+  }
+
+  // A smaller lease gets the same memory
+  {
+    ScratchBuffer::Lease lease(50);
+    EXPECT(lease.data() == first);
+  }
+
+  // A larger one grows the buffer
+  {
+    ScratchBuffer::Lease lease(1000);
+    EXPECT(ScratchBuffer::Capacity() >= 1000);
+  }
+  const size_t capacity = ScratchBuffer::Capacity();
+  {
+    ScratchBuffer::Lease lease(1000);
+  }
+  EXPECT_LONGS_EQUAL(capacity, ScratchBuffer::Capacity());
+}
+
+/* ************************************************************************* */
+TEST(ScratchBuffer, Nested)
+{
+  ScratchBuffer::Lease outer(64);
+  outer.data()[0] = 'a';
+  {
+    // The buffer is in use, so a nested lease gets other memory
+    ScratchBuffer::Lease inner(64);
+    EXPECT(inner.data() != outer.data());
+    EXPECT_LONGS_EQUAL(0, reinterpret_cast<size_t>(inner.data()) % ScratchBuffer::Alignment);
+    inner.data()[0] = 'b';
+  }
+  EXPECT(outer.data()[0] == 'a');
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
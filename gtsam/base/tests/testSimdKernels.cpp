@@ -0,0 +1,122 @@
+/* ----------------------------------------------------------------------------
+
+* GTSAM Copyright 2010, Georgia Tech Research Corporation,
+* Atlanta, Georgia 30332-0415
+* All Rights Reserved
+* Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+* See LICENSE for the license information
+
+* -------------------------------------------------------------------------- */
+
+/**
+* @file   testSimdKernels.cpp
+* @brief  Unit tests for the run-time dispatched kernels, checked against Eigen for every
+*         instruction set the machine supports
+**/
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam/base/simdKernels.h>
+#include <gtsam/base/Matrix.h>
+
+using namespace std;
+using namespace gtsam;
+
+static const simd::Isa allIsas[] = { simd::GENERIC, simd::NEON, simd::AVX2, simd::AVX512 };
+
+/* ************************************************************************* */
+TEST(simdKernels, dispatch)
+{
+  const simd::Isa initial = simd::activeIsa();
+  EXPECT(simd::isSupported(initial));
+  EXPECT(simd::isSupported(simd::GENERIC));
+  EXPECT(simd::setActiveIsa(simd::GENERIC));
+  EXPECT(simd::activeIsa() == simd::GENERIC);
+  EXPECT(string("generic") == simd::isaName(simd::GENERIC));
+  EXPECT(simd::setActiveIsa(initial));
+}
+
+/* ************************************************************************* */
+TEST(simdKernels, products)
+{
+  const simd::Isa initial = simd::activeIsa();
+  // Odd sizes exercise the remainder loops, and A and x live in larger matrices
+  const Matrix big = Matrix::Random(23, 13), B = Matrix::Random(23, 7);
+  const Eigen::Block<const Matrix> A = big.block(1, 2, 21, 9);
+  const Vector x = Vector::Random(21), z = Vector::Random(9);
+  Matrix S = Matrix::Random(11, 11);
+  S = S * S.transpose();
+
+  for (size_t k = 0; k < 4; ++k) {
+    if (!simd::setActiveIsa(allIsas[k])) continue;
+
+    Matrix C = Matrix::Zero(9, 7);
+    simd::gemmTN(9, 7, 21, 2.0, A.data(), big.rows(), B.data(), B.rows(), C.data(), C.rows());
+    EXPECT(assert_equal(Matrix(2.0 * A.transpose() * B.topRows(21)), C, 1e-9));
+
+    Matrix U = Matrix::Zero(9, 9);
+    simd::gemmTN(9, 9, 21, -1.0, A.data(), big.rows(), A.data(), big.rows(), U.data(), 9, true);
+    const Matrix expectedU = -A.transpose() * A;
+    EXPECT(assert_equal(Matrix(expectedU.triangularView<Eigen::Upper>()), U, 1e-9));
+
+    Vector y = Vector::Ones(21);
+    simd::gemv(21, 9, 0.5, A.data(), big.rows(), z.data(), y.data());
+    EXPECT(assert_equal(Vector(Vector::Ones(21) + 0.5 * A * z), y, 1e-9));
+
+    Vector w = Vector::Ones(9);
+    simd::gemvT(21, 9, 0.5, A.data(), big.rows(), x.data(), w.data());
+    EXPECT(assert_equal(Vector(Vector::Ones(9) + 0.5 * A.transpose() * x), w, 1e-9));
+
+    Matrix Supper = S.triangularView<Eigen::Upper>();
+    Vector v = Vector::Zero(11);
+    const Vector u = x.head(11);
+    simd::symv(11, 3.0, Supper.data(), 11, u.data(), v.data());
+    EXPECT(assert_equal(Vector(3.0 * S * u), v, 1e-9));
+  }
+  simd::setActiveIsa(initial);
+}
+
+/* ************************************************************************* */
+TEST(simdKernels, llt)
+{
+  const simd::Isa initial = simd::activeIsa();
+  Matrix A = Matrix::Random(13, 13);
+  A = A * A.transpose() + 13 * Matrix::Identity(13, 13);
+  const Matrix expected = Eigen::LLT<Matrix, Eigen::Upper>(A).matrixU();
+
+  for (size_t k = 0; k < 4; ++k) {
+    if (!simd::setActiveIsa(allIsas[k])) continue;
+    Matrix R = A;
+    EXPECT(simd::llt(13, R.data(), 13));
+    EXPECT(assert_equal(expected, Matrix(R.triangularView<Eigen::Upper>()), 1e-9));
+    // The strictly lower triangle is left alone
+    EXPECT(assert_equal(Matrix(A.triangularView<Eigen::StrictlyLower>()),
+        Matrix(R.triangularView<Eigen::StrictlyLower>())));
+
+    Matrix indefinite = -Matrix::Identity(5, 5);
+    EXPECT(!simd::llt(5, indefinite.data(), 5));
+  }
+  simd::setActiveIsa(initial);
+}
+
+/* ************************************************************************* */
+TEST(simdKernels, transformTo)
+{
+  const simd::Isa initial = simd::activeIsa();
+  const Matrix3 R = Matrix3::Random();
+  const Vector3 t(0.5, -1.0, 2.0);
+  const Matrix points = Matrix::Random(19, 3);
+  const Matrix expected = (points.rowwise() - t.transpose()) * R;
+
+  for (size_t k = 0; k < 4; ++k) {
+    if (!simd::setActiveIsa(allIsas[k])) continue;
+    Matrix q(19, 3);
+    simd::transformTo(19, R.data(), t.data(), points.data(), 19, q.data(), 19);
+    EXPECT(assert_equal(expected, q, 1e-12));
+  }
+  simd::setActiveIsa(initial);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
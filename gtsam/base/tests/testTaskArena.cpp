@@ -0,0 +1,58 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   testTaskArena.cpp
+ * @brief  Unit tests for TaskArena
+ **/
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam/base/TaskArena.h>
+#include <gtsam/config.h>
+#include <boost/bind.hpp>
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+
+static void increment(int* counter) { ++ *counter; }
+static void fail() { throw runtime_error("failed in the arena"); }
+
+/* ************************************************************************* */
+TEST(TaskArena, execute)
+{
+  // Without a limit the function runs in the calling context
+  int calls = 0, entries = 0;
+  TaskArena global;
+  EXPECT_LONGS_EQUAL(0, global.maxThreads());
+  global.execute(boost::bind(&increment, &calls));
+  EXPECT_LONGS_EQUAL(1, calls);
+
+  const TaskArena limited(2, boost::bind(&increment, &entries));
+  EXPECT_LONGS_EQUAL(2, limited.maxThreads());
+  limited.execute(boost::bind(&increment, &calls));
+  EXPECT_LONGS_EQUAL(2, calls);
+#ifdef GTSAM_USE_TBB
+  // The calling thread joined the arena
+  EXPECT(entries >= 1);
+#else
+  EXPECT_LONGS_EQUAL(0, entries);
+#endif
+
+  // Copies share the arena, and exceptions are propagated
+  const TaskArena copy = limited;
+  EXPECT_LONGS_EQUAL(2, copy.maxThreads());
+  CHECK_EXCEPTION(copy.execute(&fail), std::runtime_error);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -0,0 +1,176 @@
+/* ----------------------------------------------------------------------------
+
+* GTSAM Copyright 2010, Georgia Tech Research Corporation,
+* Atlanta, Georgia 30332-0415
+* All Rights Reserved
+* Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+* See LICENSE for the license information
+
+* -------------------------------------------------------------------------- */
+
+/**
+* @file   testTiming.cpp
+* @brief  Unit tests for the timing trace recorder
+**/
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/base/FastList.h>
+#include <gtsam/base/Matrix.h>
+
+#include <boost/thread/thread.hpp>
+
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+  void timedOnWorker() {
+    gttic_(worker_section);
+  }
+
+  size_t count(const string& haystack, const string& needle) {
+    size_t n = 0;
+    for (size_t pos = haystack.find(needle); pos != string::npos; pos = haystack.find(needle, pos + 1))
+      ++n;
+    return n;
+  }
+}
+
+/* ************************************************************************* */
+TEST(Timing, traceNested)
+{
+  tictoc_startTrace_();
+  EXPECT(internal::tracing());
+  {
+    gttic_(outer_section);
+    gttic_(inner_section);
+    gttoc_(inner_section);
+  }
+  tictoc_stopTrace_();
+  EXPECT(!internal::tracing());
+  {
+    gttic_(untraced_section);
+  }
+
+  stringstream ss;
+  internal::writeTrace(ss);
+  const string trace = ss.str();
+  EXPECT(trace.find("\"traceEvents\":[") != string::npos);
+  EXPECT_LONGS_EQUAL(2, count(trace, "\"name\":\"outer_section\""));
+  EXPECT_LONGS_EQUAL(2, count(trace, "\"name\":\"inner_section\""));
+  EXPECT_LONGS_EQUAL(0, count(trace, "untraced_section"));
+  EXPECT_LONGS_EQUAL(2, count(trace, "\"ph\":\"B\""));
+  EXPECT_LONGS_EQUAL(2, count(trace, "\"ph\":\"E\""));
+
+  // Events are in order of recording
+  EXPECT(trace.find("\"name\":\"outer_section\",\"ph\":\"B\"") <
+      trace.find("\"name\":\"inner_section\",\"ph\":\"B\""));
+  EXPECT(trace.find("\"name\":\"inner_section\",\"ph\":\"E\"") <
+      trace.find("\"name\":\"outer_section\",\"ph\":\"E\""));
+}
+
+/* ************************************************************************* */
+TEST(Timing, traceThreads)
+{
+  tictoc_startTrace_();
+  {
+    gttic_(main_section);
+    boost::thread worker(timedOnWorker);
+    worker.join();
+  }
+  tictoc_stopTrace_();
+
+  stringstream ss;
+  internal::writeTrace(ss);
+  const string trace = ss.str();
+
+  // Previous trace was cleared, and each thread gets its own named track
+  EXPECT_LONGS_EQUAL(0, count(trace, "outer_section"));
+  EXPECT_LONGS_EQUAL(2, count(trace, "\"name\":\"main_section\""));
+  EXPECT_LONGS_EQUAL(2, count(trace, "\"name\":\"worker_section\""));
+  EXPECT_LONGS_EQUAL(2, count(trace, "\"name\":\"thread_name\""));
+}
+
+/* ************************************************************************* */
+TEST(Timing, allocationCounts)
+{
+  boost::shared_ptr<const internal::TimingOutline> child;
+  {
+    gttic_(allocating_section);
+    {
+      gttic_(allocating_child);
+      Matrix A = Matrix::Zero(10, 10);
+      EXPECT_DOUBLES_EQUAL(0.0, A.sum(), 0.0);
+    }
+    tictoc_getNode(node, allocating_child);
+    child = node;
+    FastList<int> list;
+    list.push_back(1);
+    boost::shared_ptr<int> p(new int(1));
+  }
+  tictoc_getNode(section, allocating_section);
+
+#ifdef GTSAM_ENABLE_ALLOCATION_TRACKING
+  // The matrix is counted in the child, and again in the section with the list and the int
+  EXPECT(child->allocations() >= 1);
+  EXPECT(child->bytesAllocated() >= 100 * sizeof(double));
+  EXPECT(section->allocations() >= child->allocations() + 2);
+  EXPECT(section->bytesAllocated() > child->bytesAllocated());
+  EXPECT(internal::allocationCount().allocations >= section->allocations());
+#else
+  EXPECT_LONGS_EQUAL(0, section->allocations());
+  EXPECT_LONGS_EQUAL(0, child->bytesAllocated());
+  EXPECT_LONGS_EQUAL(0, internal::allocationCount().allocations);
+#endif
+}
+
+/* ************************************************************************* */
+TEST(Timing, perfCounters)
+{
+  EXPECT(!internal::setPerfCounters("no-such-counter"));
+  EXPECT(internal::perfCounterNames().empty());
+  EXPECT(internal::setPerfCounters(""));
+  EXPECT(internal::perfCounterNames().empty());
+
+#ifdef GTSAM_USE_PERF_COUNTERS
+  // perf_event may not be permitted, e.g. in containers, in which case nothing is recorded
+  if (internal::setPerfCounters("instructions,cycles")) {
+    EXPECT_LONGS_EQUAL(2, internal::perfCounterNames().size());
+    {
+      gttic_(counted_section);
+      Matrix A = Matrix::Random(50, 50);
+      EXPECT(A.norm() > 0);
+    }
+    tictoc_getNode(section, counted_section);
+    EXPECT_LONGS_EQUAL(2, section->counters().size());
+    EXPECT(section->counters()[0] > 0);
+    internal::setPerfCounters("");
+  }
+#endif
+}
+
+/* ************************************************************************* */
+TEST(Timing, writeJSON)
+{
+  {
+    gttic_(json_section);
+    gttic_(json_child);
+  }
+  stringstream ss;
+  internal::writeJSON(ss);
+  const string json = ss.str();
+  EXPECT(json.find("{\"label\": \"Total\"") == 0);
+  EXPECT_LONGS_EQUAL(1, count(json, "\"label\": \"json_section\", \"calls\": 1"));
+  EXPECT_LONGS_EQUAL(1, count(json, "\"label\": \"json_child\""));
+  EXPECT(json.find("json_section") < json.find("json_child"));
+  EXPECT_LONGS_EQUAL(count(json, "{"), count(json, "}"));
+  EXPECT_LONGS_EQUAL(count(json, "["), count(json, "]"));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -20,17 +20,39 @@
 #include <gtsam/base/timing.h>
 
 #include <boost/algorithm/string/replace.hpp>
+#include <boost/atomic.hpp>
+#include <boost/chrono/chrono.hpp>
+#include <boost/core/demangle.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/foreach.hpp>
 #include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstdlib>
 #include <cassert>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <new>
 #include <stdexcept>
+#include <typeindex>
 #include <utility>
+#include <vector>
+
+#ifdef GTSAM_USE_PERF_COUNTERS
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
 
 namespace gtsam {
 namespace internal {
@@ -39,6 +61,216 @@ GTSAM_EXPORT boost::shared_ptr<TimingOutline> gTimingRoot(
     new TimingOutline("Total", getTicTocID("Total")));
 GTSAM_EXPORT boost::weak_ptr<TimingOutline> gCurrentTimer(gTimingRoot);
 
+/* ************************************************************************* */
+// Trace recording
+/* ************************************************************************* */
+
+namespace {
+
+// A begin ('B') or end ('E') event, the label is the string literal passed by gttic/gttoc
+struct TraceEvent {
+  const char* label;
+  char phase;
+  boost::int64_t usecs; ///< microseconds since the trace was started
+  TraceEvent(const char* _label, char _phase, boost::int64_t _usecs) :
+      label(_label), phase(_phase), usecs(_usecs) {}
+};
+
+// Events recorded by a single thread, only ever appended to by that thread
+struct TraceBuffer {
+  size_t tid;
+  std::vector<TraceEvent> events;
+  explicit TraceBuffer(size_t _tid) : tid(_tid) {}
+};
+
+boost::atomic<bool> traceEnabled(false);
+boost::posix_time::ptime traceStart;
+const TraceBuffer* traceOwner = 0; // the buffer of the thread that started the trace
+
+// All buffers ever created, kept alive after their thread exits so they can still be written
+boost::mutex traceMutex;
+std::vector<boost::shared_ptr<TraceBuffer> > traceBuffers;
+boost::thread_specific_ptr<boost::shared_ptr<TraceBuffer> > threadTraceBuffer;
+
+TraceBuffer& currentTraceBuffer() {
+  boost::shared_ptr<TraceBuffer>* buffer = threadTraceBuffer.get();
+  if (!buffer) {
+    boost::mutex::scoped_lock lock(traceMutex);
+    buffer = new boost::shared_ptr<TraceBuffer>(
+        boost::make_shared<TraceBuffer>(traceBuffers.size()));
+    traceBuffers.push_back(*buffer);
+    threadTraceBuffer.reset(buffer);
+  }
+  return **buffer;
+}
+
+// Record an event if tracing, returns whether the calling thread should update the outline
+bool recordTraceEvent(const char* label, char phase) {
+  if (!traceEnabled.load(boost::memory_order_acquire))
+    return true;
+  TraceBuffer& buffer = currentTraceBuffer();
+  const boost::posix_time::time_duration elapsed =
+      boost::posix_time::microsec_clock::universal_time() - traceStart;
+  buffer.events.push_back(TraceEvent(label, phase, elapsed.total_microseconds()));
+  return &buffer == traceOwner;
+}
+
+// Totals of counted heap allocations, constant-initialized so that allocations made during
+// static initialization are counted
+boost::atomic<size_t> allocationTotal(0);
+boost::atomic<size_t> bytesTotal(0);
+
+}
+
+/* ************************************************************************* */
+// Allocation counting
+/* ************************************************************************* */
+
+#ifdef GTSAM_ENABLE_ALLOCATION_TRACKING
+/* ************************************************************************* */
+void recordAllocation(size_t bytes) {
+  allocationTotal.fetch_add(1, boost::memory_order_relaxed);
+  bytesTotal.fetch_add(bytes, boost::memory_order_relaxed);
+}
+#endif
+
+/* ************************************************************************* */
+AllocationCount allocationCount() {
+  AllocationCount count;
+  count.allocations = allocationTotal.load(boost::memory_order_relaxed);
+  count.bytes = bytesTotal.load(boost::memory_order_relaxed);
+  return count;
+}
+
+/* ************************************************************************* */
+// Hardware performance counters
+/* ************************************************************************* */
+
+namespace {
+
+std::vector<std::string> perfNames; // counters being recorded
+
+#ifdef GTSAM_USE_PERF_COUNTERS
+const char* defaultPerfCounters = "cycles,instructions,cache-references,cache-misses";
+bool perfConfigured = false; // whether setPerfCounters was called, possibly by configurePerfCounters
+std::vector<size_t> perfScratch; // counter values read at toc
+std::vector<int> perfFds; // one event group, the leader first
+
+// Fill in the perf_event attributes of a named counter, returns false for unknown names
+bool perfEventAttr(const std::string& name, perf_event_attr& attr) {
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  const boost::uint64_t cacheMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8)
+      | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  if (name == "cycles") attr.config = PERF_COUNT_HW_CPU_CYCLES;
+  else if (name == "instructions") attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+  else if (name == "cache-references") attr.config = PERF_COUNT_HW_CACHE_REFERENCES;
+  else if (name == "cache-misses") attr.config = PERF_COUNT_HW_CACHE_MISSES;
+  else if (name == "branches") attr.config = PERF_COUNT_HW_BRANCH_INSTRUCTIONS;
+  else if (name == "branch-misses") attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+  else if (name == "L1-dcache-load-misses") {
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_L1D | cacheMiss;
+  } else if (name == "LLC-load-misses") {
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_LL | cacheMiss;
+  } else if (name.size() > 1 && name[0] == 'r'
+      && name.find_first_not_of("0123456789abcdefABCDEF", 1) == std::string::npos) {
+    attr.type = PERF_TYPE_RAW;
+    attr.config = std::strtoull(name.c_str() + 1, 0, 16);
+  } else
+    return false;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return true;
+}
+
+void closePerfCounters() {
+  BOOST_FOREACH(int fd, perfFds)
+    close(fd);
+  perfFds.clear();
+}
+
+// Read the current counter values, returns false if no counters are recorded
+bool readPerfCounters(std::vector<size_t>& values) {
+  if (perfFds.empty())
+    return false;
+  boost::uint64_t buffer[16];
+  const size_t n = perfFds.size();
+  const ssize_t expected = sizeof(boost::uint64_t) * (n + 1);
+  if (read(perfFds.front(), buffer, sizeof(buffer)) != expected || buffer[0] != n)
+    return false;
+  values.resize(n);
+  for (size_t i = 0; i < n; i++)
+    values[i] = size_t(buffer[i + 1]);
+  return true;
+}
+
+// Choose the counters from GTSAM_PERF_COUNTERS, or the defaults, unless already chosen
+void configurePerfCounters() {
+  if (perfConfigured)
+    return;
+  const char* names = std::getenv("GTSAM_PERF_COUNTERS");
+  if (!setPerfCounters(names ? names : defaultPerfCounters))
+    std::cerr << "gtsam timing:  Could not open hardware counters \""
+        << (names ? names : defaultPerfCounters) << "\", recording none" << std::endl;
+}
+#endif
+
+}
+
+/* ************************************************************************* */
+bool setPerfCounters(const std::string& names) {
+  perfNames.clear();
+  std::vector<std::string> requested;
+  std::string::size_type start = 0;
+  while (start <= names.size()) {
+    std::string::size_type end = names.find(',', start);
+    if (end == std::string::npos)
+      end = names.size();
+    if (end > start)
+      requested.push_back(names.substr(start, end - start));
+    start = end + 1;
+  }
+#ifdef GTSAM_USE_PERF_COUNTERS
+  perfConfigured = true;
+  closePerfCounters();
+  if (requested.empty())
+    return true;
+  if (requested.size() > 15)
+    return false;
+  BOOST_FOREACH(const std::string& name, requested) {
+    perf_event_attr attr;
+    if (!perfEventAttr(name, attr)) {
+      closePerfCounters();
+      return false;
+    }
+    const int leader = perfFds.empty() ? -1 : perfFds.front();
+    attr.disabled = (leader == -1);
+    // Count the calling thread, on any CPU
+    const int fd = int(syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0));
+    if (fd < 0) {
+      closePerfCounters();
+      return false;
+    }
+    perfFds.push_back(fd);
+  }
+  ioctl(perfFds.front(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(perfFds.front(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  perfNames = requested;
+  return true;
+#else
+  return requested.empty();
+#endif
+}
+
+/* ************************************************************************* */
+const std::vector<std::string>& perfCounterNames() {
+  return perfNames;
+}
+
 /* ************************************************************************* */
 // Implementation of TimingOutline
 /* ************************************************************************* */
@@ -56,7 +288,7 @@ void TimingOutline::add(size_t usecs, size_t usecsWall) {
 /* ************************************************************************* */
 TimingOutline::TimingOutline(const std::string& label, size_t id) :
     id_(id), t_(0), tWall_(0), t2_(0.0), tIt_(0), tMax_(0), tMin_(0), n_(0), myOrder_(
-        0), lastChildOrder_(0), label_(label) {
+        0), lastChildOrder_(0), allocations_(0), bytes_(0), label_(label) {
 #ifdef GTSAM_USING_NEW_BOOST_TIMERS
   timer_.stop();
 #endif
@@ -82,7 +314,24 @@ void TimingOutline::print(const std::string& outline) const {
   boost::replace_all(formattedLabel, "_", " ");
   std::cout << outline << "-" << formattedLabel << ": " << self() << " CPU ("
       << n_ << " times, " << wall() << " wall, " << secs() << " children, min: "
-      << min() << " max: " << max() << ")\n";
+      << min() << " max: " << max()
+#ifdef GTSAM_ENABLE_ALLOCATION_TRACKING
+      << ", " << allocations_ << " allocations, " << bytes_ << " bytes"
+#endif
+      ;
+  // Hardware counters, and instructions per cycle if both are recorded
+  const std::vector<std::string>& names = perfCounterNames();
+  if (counters_.size() == names.size()) {
+    double cycles = 0, instructions = 0;
+    for (size_t i = 0; i < names.size(); i++) {
+      std::cout << ", " << names[i] << ": " << counters_[i];
+      if (names[i] == "cycles") cycles = double(counters_[i]);
+      if (names[i] == "instructions") instructions = double(counters_[i]);
+    }
+    if (cycles > 0 && instructions > 0)
+      std::cout << ", IPC: " << instructions / cycles;
+  }
+  std::cout << ")\n";
   // Order children
   typedef FastMap<size_t, boost::shared_ptr<TimingOutline> > ChildOrder;
   ChildOrder childOrder;
@@ -98,6 +347,37 @@ void TimingOutline::print(const std::string& outline) const {
   std::cout.flush();
 }
 
+/* ************************************************************************* */
+void TimingOutline::writeJSON(std::ostream& os, const std::string& indent) const {
+  os << indent << "{\"label\": \"" << label_ << "\", \"calls\": " << n_
+      << ", \"cpu\": " << self() << ", \"wall\": " << wall() << ", \"total\": " << secs()
+      << ", \"min\": " << min() << ", \"max\": " << max()
+      << ", \"allocations\": " << allocations_ << ", \"bytes\": " << bytes_;
+  const std::vector<std::string>& names = perfCounterNames();
+  if (counters_.size() == names.size() && !names.empty()) {
+    os << ", \"counters\": {";
+    for (size_t i = 0; i < names.size(); i++)
+      os << (i ? ", " : "") << "\"" << names[i] << "\": " << counters_[i];
+    os << "}";
+  }
+  // Children in the order they were first timed, as in print
+  typedef FastMap<size_t, boost::shared_ptr<TimingOutline> > ChildOrder;
+  ChildOrder childOrder;
+  BOOST_FOREACH(const ChildMap::value_type& child, children_)
+    childOrder[child.second->myOrder_] = child.second;
+  os << ", \"children\": [";
+  bool first = true;
+  BOOST_FOREACH(const ChildOrder::value_type& order_child, childOrder) {
+    os << (first ? "\n" : ",\n");
+    order_child.second->writeJSON(os, indent + "  ");
+    first = false;
+  }
+  if (!first)
+    os << "\n" << indent;
+  os << "]}";
+}
+
+/* ************************************************************************* */
 void TimingOutline::print2(const std::string& outline,
     const double parentTotal) const {
 
@@ -170,6 +450,16 @@ void TimingOutline::tic() {
 #ifdef GTSAM_USE_TBB
   tbbTimer_ = tbb::tick_count::now();
 #endif
+
+#ifdef GTSAM_ENABLE_ALLOCATION_TRACKING
+  ticCount_ = allocationCount();
+#endif
+
+#ifdef GTSAM_USE_PERF_COUNTERS
+  configurePerfCounters();
+  if (!readPerfCounters(ticCounters_))
+    ticCounters_.clear();
+#endif
 }
 
 /* ************************************************************************* */
@@ -200,6 +490,20 @@ void TimingOutline::toc() {
       (tbb::tick_count::now() - tbbTimer_).seconds() * 1e6);
 #endif
 
+#ifdef GTSAM_ENABLE_ALLOCATION_TRACKING
+  const AllocationCount count = allocationCount();
+  allocations_ += count.allocations - ticCount_.allocations;
+  bytes_ += count.bytes - ticCount_.bytes;
+#endif
+
+#ifdef GTSAM_USE_PERF_COUNTERS
+  if (readPerfCounters(perfScratch) && perfScratch.size() == ticCounters_.size()) {
+    counters_.resize(perfScratch.size(), 0);
+    for (size_t i = 0; i < perfScratch.size(); i++)
+      counters_[i] += perfScratch[i] - ticCounters_[i];
+  }
+#endif
+
   add(cpuTime, wallTime);
 }
 
@@ -236,6 +540,8 @@ size_t getTicTocID(const char *descriptionC) {
 
 /* ************************************************************************* */
 void tic(size_t id, const char *labelC) {
+  if (!recordTraceEvent(labelC, 'B'))
+    return;
   const std::string label(labelC);
   boost::shared_ptr<TimingOutline> node = //
       gCurrentTimer.lock()->child(id, label, gCurrentTimer);
@@ -245,6 +551,8 @@ void tic(size_t id, const char *labelC) {
 
 /* ************************************************************************* */
 void toc(size_t id, const char *label) {
+  if (!recordTraceEvent(label, 'E'))
+    return;
   boost::shared_ptr<TimingOutline> current(gCurrentTimer.lock());
   if (id != current->id_) {
     gTimingRoot->print();
@@ -264,5 +572,273 @@ void toc(size_t id, const char *label) {
   gCurrentTimer = current->parent_;
 }
 
+/* ************************************************************************* */
+void startTrace() {
+  traceEnabled = false;
+  TraceBuffer& owner = currentTraceBuffer();
+  {
+    boost::mutex::scoped_lock lock(traceMutex);
+    BOOST_FOREACH(const boost::shared_ptr<TraceBuffer>& buffer, traceBuffers)
+      buffer->events.clear();
+  }
+  traceOwner = &owner;
+  traceStart = boost::posix_time::microsec_clock::universal_time();
+  traceEnabled = true;
+}
+
+/* ************************************************************************* */
+void stopTrace() {
+  traceEnabled = false;
+}
+
+/* ************************************************************************* */
+bool tracing() {
+  return traceEnabled.load();
+}
+
+/* ************************************************************************* */
+void writeTrace(std::ostream& os) {
+  boost::mutex::scoped_lock lock(traceMutex);
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  BOOST_FOREACH(const boost::shared_ptr<TraceBuffer>& buffer, traceBuffers) {
+    if (buffer->events.empty())
+      continue;
+    os << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":"
+        << buffer->tid << ",\"args\":{\"name\":\"thread " << buffer->tid << "\"}}";
+    first = false;
+    BOOST_FOREACH(const TraceEvent& event, buffer->events) {
+      os << ",\n{\"name\":\"" << event.label << "\",\"ph\":\"" << event.phase
+          << "\",\"ts\":" << event.usecs << ",\"pid\":0,\"tid\":" << buffer->tid << "}";
+    }
+  }
+  os << "\n]}\n";
+  os.flush();
+}
+
+/* ************************************************************************* */
+void writeJSON(std::ostream& os) {
+  gTimingRoot->writeJSON(os);
+  os << "\n";
+  os.flush();
+}
+
+/* ************************************************************************* */
+void writeJSON(const std::string& filename) {
+  std::ofstream os(filename.c_str());
+  if (!os)
+    throw std::runtime_error("gtsam timing:  Could not open JSON file " + filename);
+  writeJSON(os);
+}
+
+/* ************************************************************************* */
+void writeTrace(const std::string& filename) {
+  std::ofstream os(filename.c_str());
+  if (!os)
+    throw std::runtime_error("gtsam timing:  Could not open trace file " + filename);
+  writeTrace(os);
+}
+
+/* ************************************************************************* */
+// Profiling by factor type
+/* ************************************************************************* */
+
+namespace {
+
+// Statistics recorded by a single thread, keyed on the concrete factor type
+typedef std::map<std::type_index, FactorTypeProfile> FactorProfileBuffer;
+
+boost::atomic<bool> factorProfileEnabled(false);
+
+// All buffers ever created, kept alive after their thread exits so they can still be merged
+boost::mutex factorProfileMutex;
+std::vector<boost::shared_ptr<FactorProfileBuffer> > factorProfileBuffers;
+boost::thread_specific_ptr<boost::shared_ptr<FactorProfileBuffer> > threadFactorProfileBuffer;
+
+FactorProfileBuffer& currentFactorProfileBuffer() {
+  boost::shared_ptr<FactorProfileBuffer>* buffer = threadFactorProfileBuffer.get();
+  if (!buffer) {
+    boost::mutex::scoped_lock lock(factorProfileMutex);
+    buffer = new boost::shared_ptr<FactorProfileBuffer>(
+        boost::make_shared<FactorProfileBuffer>());
+    factorProfileBuffers.push_back(*buffer);
+    threadFactorProfileBuffer.reset(buffer);
+  }
+  return **buffer;
+}
+
+boost::int64_t steadyNanoseconds() {
+  return boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+      boost::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool moreExpensive(const FactorTypeProfile& a, const FactorTypeProfile& b) {
+  return a.secs() > b.secs();
+}
+
+}
+
+/* ************************************************************************* */
+void startFactorProfile() {
+  factorProfileEnabled = false;
+  {
+    boost::mutex::scoped_lock lock(factorProfileMutex);
+    BOOST_FOREACH(const boost::shared_ptr<FactorProfileBuffer>& buffer, factorProfileBuffers)
+      buffer->clear();
+  }
+  factorProfileEnabled = true;
+}
+
+/* ************************************************************************* */
+void stopFactorProfile() {
+  factorProfileEnabled = false;
+}
+
+/* ************************************************************************* */
+bool profilingFactors() {
+  return factorProfileEnabled.load(boost::memory_order_relaxed);
+}
+
+/* ************************************************************************* */
+void recordFactorProfile(const std::type_info& type, FactorOperation operation, double secs,
+    size_t linearizedEntries) {
+  FactorTypeProfile& profile = currentFactorProfileBuffer()[std::type_index(type)];
+  if (operation == FACTOR_ERROR) {
+    ++profile.errorCalls;
+    profile.errorSecs += secs;
+  } else {
+    ++profile.linearizeCalls;
+    profile.linearizeSecs += secs;
+    profile.linearizedEntries += linearizedEntries;
+  }
+}
+
+/* ************************************************************************* */
+std::vector<FactorTypeProfile> factorProfile() {
+  FactorProfileBuffer merged;
+  {
+    boost::mutex::scoped_lock lock(factorProfileMutex);
+    BOOST_FOREACH(const boost::shared_ptr<FactorProfileBuffer>& buffer, factorProfileBuffers) {
+      BOOST_FOREACH(const FactorProfileBuffer::value_type& entry, *buffer) {
+        FactorTypeProfile& profile = merged[entry.first];
+        profile.errorCalls += entry.second.errorCalls;
+        profile.errorSecs += entry.second.errorSecs;
+        profile.linearizeCalls += entry.second.linearizeCalls;
+        profile.linearizeSecs += entry.second.linearizeSecs;
+        profile.linearizedEntries += entry.second.linearizedEntries;
+      }
+    }
+  }
+  std::vector<FactorTypeProfile> profiles;
+  profiles.reserve(merged.size());
+  BOOST_FOREACH(FactorProfileBuffer::value_type& entry, merged) {
+    entry.second.type = boost::core::demangle(entry.first.name());
+    profiles.push_back(entry.second);
+  }
+  std::stable_sort(profiles.begin(), profiles.end(), moreExpensive);
+  return profiles;
+}
+
+/* ************************************************************************* */
+void printFactorProfile(std::ostream& os) {
+  const std::vector<FactorTypeProfile> profiles = factorProfile();
+  if (profiles.empty())
+    return;
+  os << "Factor types:\n";
+  BOOST_FOREACH(const FactorTypeProfile& profile, profiles) {
+    os << "-" << profile.type << ": " << profile.secs() << " CPU (error: "
+        << profile.errorCalls << " times, " << profile.errorSecs << ", linearize: "
+        << profile.linearizeCalls << " times, " << profile.linearizeSecs << ", "
+        << profile.linearizedEntries << " entries)\n";
+  }
+  os.flush();
+}
+
+/* ************************************************************************* */
+void printFactorProfile() {
+  printFactorProfile(std::cout);
+}
+
+/* ************************************************************************* */
+FactorProfileScope::FactorProfileScope(const std::type_info& type, FactorOperation operation) :
+    type_(type), operation_(operation), linearizedEntries_(0), start_(steadyNanoseconds()) {
+}
+
+/* ************************************************************************* */
+FactorProfileScope::~FactorProfileScope() {
+  recordFactorProfile(type_, operation_, double(steadyNanoseconds() - start_) * 1e-9,
+      linearizedEntries_);
+}
+
 } // namespace internal
 } // namespace gtsam
+
+#ifdef GTSAM_ENABLE_ALLOCATION_TRACKING
+/* ************************************************************************* */
+// Replacements of the global allocation functions, counting every allocation
+/* ************************************************************************* */
+
+namespace {
+void* countedMalloc(std::size_t size) {
+  gtsam::internal::recordAllocation(size);
+  for (;;) {
+    if (void* p = std::malloc(size ? size : 1))
+      return p;
+    std::new_handler handler = std::get_new_handler();
+    if (!handler)
+      return 0;
+    handler();
+  }
+}
+}
+
+void* operator new(std::size_t size) {
+  if (void* p = countedMalloc(size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) throw() {
+  try {
+    return countedMalloc(size);
+  } catch (...) {
+    return 0;
+  }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& nothrow) throw() {
+  return operator new(size, nothrow);
+}
+
+void operator delete(void* p) throw() {
+  std::free(p);
+}
+
+void operator delete[](void* p) throw() {
+  std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) throw() {
+  std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) throw() {
+  std::free(p);
+}
+
+#ifdef EIGEN_ALLOCATION_HOOK
+/* ************************************************************************* */
+// Called by the bundled Eigen for each of its heap allocations, see Eigen/src/Core/util/Memory.h
+namespace Eigen {
+namespace internal {
+void EIGEN_ALLOCATION_HOOK(std::size_t size) {
+  gtsam::internal::recordAllocation(size);
+}
+}
+}
+#endif
+#endif
@@ -25,8 +25,13 @@
 #include <boost/smart_ptr/weak_ptr.hpp>
 #include <boost/version.hpp>
 
+#include <boost/cstdint.hpp>
+
 #include <cstddef>
+#include <iosfwd>
 #include <string>
+#include <typeinfo>
+#include <vector>
 
 // This file contains the GTSAM timing instrumentation library, a low-overhead method for
 // learning at a medium-fine level how much time various components of an algorithm take
@@ -105,6 +110,54 @@
 //   too scope.  Note that if you use these, it may become difficult to ensure that you
 //   have matching gttic/gttoc statments.  You may want to consider reorganizing your timing
 //   outline to match the scope of your code.
+//
+// - Tracing timelines.  The outline aggregates statistics, but does not show when, and on
+//   which thread, each section ran.  Between tictoc_startTrace_() and tictoc_stopTrace_(),
+//   every gttic/gttoc additionally records a timestamped begin/end event into a buffer local
+//   to the calling thread.  tictoc_writeTrace_("trace.json") writes all recorded events in
+//   the Chrome trace event format, with one track per thread, which can be loaded in
+//   chrome://tracing or Perfetto to inspect e.g. load imbalance across cliques:
+//   void myAlgorithm() {
+//     tictoc_startTrace_();
+//     runParallelAlgorithm();
+//     tictoc_stopTrace_();
+//     tictoc_writeTrace_("trace.json");
+//   }
+//   While a trace is being recorded, only the thread that started the trace updates the
+//   (shared) timing outline, sections timed on other threads are only recorded in the trace.
+//   Write the trace only after all threads have finished timing.
+//
+// - Counting allocations.  If GTSAM is configured with GTSAM_ENABLE_ALLOCATION_TRACKING, every
+//   heap allocation is counted: global operator new is replaced, the Fast* containers count
+//   the allocations of FastDefaultAllocator that bypass operator new (boost pool and TBB), and
+//   the bundled Eigen reports its own allocations through EIGEN_ALLOCATION_HOOK.  Each section
+//   accumulates the allocations and bytes made between its gttic and gttoc, including those of
+//   its children, which tictoc_print_() shows next to the times and TimingOutline::allocations()
+//   and TimingOutline::bytesAllocated() return.  Counts are process-wide, so allocations made by
+//   other threads while a section is open are attributed to it.  Memory is never subtracted
+//   when freed: the counts measure allocation traffic, not memory in use.
+//
+// - Hardware counters.  If GTSAM is configured with GTSAM_WITH_PERF_COUNTERS on Linux, each
+//   section also accumulates hardware performance counters read with perf_event.  They count
+//   only the thread that opened them, which is the one timing the first section.  Counters are
+//   chosen with the GTSAM_PERF_COUNTERS environment variable or internal::setPerfCounters, as
+//   a comma-separated list of cycles, instructions, cache-references, cache-misses, branches,
+//   branch-misses, L1-dcache-load-misses, LLC-load-misses, or raw PMU events written rNNNN in
+//   hex as for `perf stat`, e.g. the FP_ARITH_INST_RETIRED events of the CPU to estimate FLOPs.
+//   By default cycles, instructions, cache-references and cache-misses are recorded.
+//   tictoc_print_() shows the counters, and the instructions per cycle if both are recorded.
+//
+// - JSON export.  tictoc_writeJSON_("timing.json") writes the whole outline, with times,
+//   allocation counts and hardware counters of every section, for processing by scripts.
+//
+// - Profiling by factor type.  Between tictoc_startFactorProfile_() and
+//   tictoc_stopFactorProfile_(), NonlinearFactorGraph::error, linearize and relinearize time
+//   every factor, and accumulate per concrete factor type the number of calls, the time and
+//   the number of entries of the linearized factors, in statistics local to each thread.
+//   tictoc_print_() prints them merged after the outline, one line per type, most expensive
+//   first, and internal::factorProfile() returns them.  Timing every factor costs two clock
+//   reads per call, which is noticeable for cheap factors, so the outline of a profiled run
+//   is slightly inflated.  Read the profile only after all threads have finished.
 
 // Automatically use the new Boost timers if version is recent enough.
 #if BOOST_VERSION >= 104800
@@ -139,6 +192,98 @@ namespace gtsam {
     // Call toc on gCurrentTimer and then set gCurrentTimer to the parent of gCurrentTimer
     GTSAM_EXPORT void toc(size_t id, const char *label);
 
+    // Clear all previously recorded trace events and start recording tic/toc events
+    GTSAM_EXPORT void startTrace();
+
+    // Stop recording tic/toc events
+    GTSAM_EXPORT void stopTrace();
+
+    // Whether tic/toc events are currently being recorded
+    GTSAM_EXPORT bool tracing();
+
+    // Write all recorded trace events to a stream, in the Chrome trace event (JSON) format
+    GTSAM_EXPORT void writeTrace(std::ostream& os);
+
+    // Write all recorded trace events to a file, throws std::runtime_error on failure
+    GTSAM_EXPORT void writeTrace(const std::string& filename);
+
+    // Running totals of counted heap allocations, always zero without allocation tracking
+    struct AllocationCount {
+      size_t allocations;
+      size_t bytes;
+      AllocationCount() : allocations(0), bytes(0) {}
+    };
+
+    // Heap allocations counted since the program started
+    GTSAM_EXPORT AllocationCount allocationCount();
+
+    // Select the hardware counters recorded per section, as a comma-separated list of names
+    // (see above).  Returns false, and records no counters, if perf_event is not available or
+    // a counter cannot be opened.  An empty list disables the counters.
+    GTSAM_EXPORT bool setPerfCounters(const std::string& names);
+
+    // Names of the hardware counters being recorded, empty if none
+    GTSAM_EXPORT const std::vector<std::string>& perfCounterNames();
+
+    // Write the timing outline in JSON format
+    GTSAM_EXPORT void writeJSON(std::ostream& os);
+
+    // Write the timing outline to a JSON file, throws std::runtime_error on failure
+    GTSAM_EXPORT void writeJSON(const std::string& filename);
+
+    // Operations profiled per factor type
+    enum FactorOperation { FACTOR_ERROR, FACTOR_LINEARIZE };
+
+    // Statistics of one concrete factor type, merged over all threads
+    struct FactorTypeProfile {
+      std::string type; ///< demangled name of the concrete factor type
+      size_t errorCalls;
+      double errorSecs;
+      size_t linearizeCalls;
+      double linearizeSecs;
+      size_t linearizedEntries; ///< total matrix entries of the linearized factors
+      FactorTypeProfile() : errorCalls(0), errorSecs(0.0), linearizeCalls(0), linearizeSecs(0.0),
+          linearizedEntries(0) {}
+      double secs() const { return errorSecs + linearizeSecs; } ///< total time, in seconds
+    };
+
+    // Clear the statistics of all threads and start profiling factors
+    GTSAM_EXPORT void startFactorProfile();
+
+    // Stop profiling factors
+    GTSAM_EXPORT void stopFactorProfile();
+
+    // Whether factors are currently being profiled
+    GTSAM_EXPORT bool profilingFactors();
+
+    // Add one call of a factor of concrete type \c type to the statistics of the calling thread
+    GTSAM_EXPORT void recordFactorProfile(const std::type_info& type, FactorOperation operation,
+        double secs, size_t linearizedEntries = 0);
+
+    // The statistics of all threads merged per factor type, most expensive type first
+    GTSAM_EXPORT std::vector<FactorTypeProfile> factorProfile();
+
+    // Print the merged statistics, nothing if no factor was profiled
+    GTSAM_EXPORT void printFactorProfile(std::ostream& os);
+    GTSAM_EXPORT void printFactorProfile();
+
+    /**
+     * Small class that times a factor operation from construction to destruction, and records it
+     * with recordFactorProfile
+     */
+    class GTSAM_EXPORT FactorProfileScope {
+     private:
+      const std::type_info& type_;
+      FactorOperation operation_;
+      size_t linearizedEntries_;
+      boost::int64_t start_; ///< nanoseconds of a steady clock
+
+     public:
+      FactorProfileScope(const std::type_info& type, FactorOperation operation);
+      ~FactorProfileScope();
+      void setLinearizedEntries(size_t entries) { linearizedEntries_ = entries; }
+    };
+
     /**
      * Timing Entry, arranged in a tree
      */
@@ -154,6 +299,11 @@ namespace gtsam {
       size_t n_;
       size_t myOrder_;
       size_t lastChildOrder_;
+      size_t allocations_; ///< heap allocations, including children
+      size_t bytes_; ///< bytes allocated, including children
+      AllocationCount ticCount_; ///< totals at the last tic
+      std::vector<size_t> counters_; ///< hardware counters, see perfCounterNames()
+      std::vector<size_t> ticCounters_; ///< hardware counters at the last tic
       std::string label_;
 
       // Tree structure
@@ -182,8 +332,12 @@ namespace gtsam {
       double min()  const { return double(tMin_)  / 1000000.0;} ///< min time, in seconds
       double max()  const { return double(tMax_)  / 1000000.0;} ///< max time, in seconds
       double mean() const { return self() / double(n_); } ///< mean self time, in seconds
+      size_t allocations() const { return allocations_; } ///< heap allocations, including children
+      size_t bytesAllocated() const { return bytes_; } ///< bytes allocated, including children
+      const std::vector<size_t>& counters() const { return counters_; } ///< hardware counters, including children
       void print(const std::string& outline = "") const;
       void print2(const std::string& outline = "", const double parentTotal = -1.0) const;
+      void writeJSON(std::ostream& os, const std::string& indent = "") const;
       const boost::shared_ptr<TimingOutline>&
         child(size_t child, const std::string& label, const boost::weak_ptr<TimingOutline>& thisPtr);
       void tic();
@@ -249,14 +403,39 @@ namespace gtsam {
 inline void tictoc_finishedIteration_() {
   ::gtsam::internal::gTimingRoot->finishedIteration(); }
 
-// print
+// print, followed by the factor profile if factors were profiled
 inline void tictoc_print_() {
-  ::gtsam::internal::gTimingRoot->print(); }
+  ::gtsam::internal::gTimingRoot->print();
+  ::gtsam::internal::printFactorProfile(); }
 
 // print mean and standard deviation
 inline void tictoc_print2_() {
   ::gtsam::internal::gTimingRoot->print2(); }
 
+// start recording a trace of tic/toc events
+inline void tictoc_startTrace_() {
+  ::gtsam::internal::startTrace(); }
+
+// stop recording the trace
+inline void tictoc_stopTrace_() {
+  ::gtsam::internal::stopTrace(); }
+
+// write the recorded trace in the Chrome trace event format
+inline void tictoc_writeTrace_(const std::string& filename) {
+  ::gtsam::internal::writeTrace(filename); }
+
+// write the timing outline in JSON format
+inline void tictoc_writeJSON_(const std::string& filename) {
+  ::gtsam::internal::writeJSON(filename); }
+
+// start profiling factors by type
+inline void tictoc_startFactorProfile_() {
+  ::gtsam::internal::startFactorProfile(); }
+
+// stop profiling factors by type
+inline void tictoc_stopFactorProfile_() {
+  ::gtsam::internal::stopFactorProfile(); }
+
 // get a node by label and assign it to variable
 #define tictoc_getNode(variable, label) \
   static const size_t label##_id_getnode = ::gtsam::internal::getTicTocID(#label); \
@@ -276,6 +455,12 @@ inline void tictoc_reset_() {
 #define tictoc_finishedIteration tictoc_finishedIteration_
 #define tictoc_print tictoc_print_
 #define tictoc_reset tictoc_reset_
+#define tictoc_startTrace tictoc_startTrace_
+#define tictoc_stopTrace tictoc_stopTrace_
+#define tictoc_writeTrace tictoc_writeTrace_
+#define tictoc_writeJSON tictoc_writeJSON_
+#define tictoc_startFactorProfile tictoc_startFactorProfile_
+#define tictoc_stopFactorProfile tictoc_stopFactorProfile_
 #else
 #define gttic(label) ((void)0)
 #define gttoc(label) ((void)0)
@@ -284,6 +469,12 @@ inline void tictoc_reset_() {
 #define tictoc_finishedIteration() ((void)0)
 #define tictoc_print() ((void)0)
 #define tictoc_reset() ((void)0)
+#define tictoc_startTrace() ((void)0)
+#define tictoc_stopTrace() ((void)0)
+#define tictoc_writeTrace(filename) ((void)0)
+#define tictoc_writeJSON(filename) ((void)0)
+#define tictoc_startFactorProfile() ((void)0)
+#define tictoc_stopFactorProfile() ((void)0)
 #endif
 
 }
@@ -137,6 +137,30 @@ void DepthFirstForest(FOREST& forest, DATA& rootData, VISITOR_PRE& visitorPre) {
   DepthFirstForest(forest, rootData, visitorPre, visitorPost);
 }
 
+#ifdef GTSAM_USE_TBB
+/* ************************************************************************* */
+namespace internal {
+// Pre-order visitor of the cost pass, which needs no data
+struct NoCostData {
+  template<typename NODE>
+  int operator()(const boost::shared_ptr<NODE>&, int) { return 0; }
+};
+
+// Post-order visitor summing the estimated costs of subtrees, children are visited first
+template<typename NODE>
+struct SubtreeCostVisitor {
+  TraversalCosts<NODE>& costs;
+  SubtreeCostVisitor(TraversalCosts<NODE>& costs) : costs(costs) {}
+  void operator()(const boost::shared_ptr<NODE>& node, int) {
+    double cost = node->estimatedCost();
+    BOOST_FOREACH(const boost::shared_ptr<NODE>& child, node->children)
+      cost += costs.cost(child);
+    costs.subtreeCosts[node.get()] = cost;
+  }
+};
+}
+#endif
+
 /** Traverse a forest depth-first with pre-order and post-order visits.
  *  @param forest The forest of trees to traverse.  The method \c forest.roots() should exist
  *         and return a collection of (shared) pointers to \c FOREST::Node.
@@ -150,20 +174,41 @@ void DepthFirstForest(FOREST& forest, DATA& rootData, VISITOR_PRE& visitorPre) {
  *         its children, and will be passed, by reference, the \c DATA object returned by the
  *         call to \c visitorPre (the \c DATA object may be modified by visiting the children).
  *  @param rootData The data to pass by reference to \c visitorPre when it is called on each
- *         root node. */
+ *         root node.
+ *  @param minTaskCost With TBB, the tasks are scheduled from the estimated cost of each subtree,
+ *         the sum of \c node->estimatedCost() over its nodes.  Children are started with the
+ *         most expensive subtree first, so that the critical path starts as early as possible,
+ *         and a subtree is split into tasks for its children only if its cost is over a cutoff:
+ *         the total cost divided among a few tasks per thread, but at least \c minTaskCost, in
+ *         the units of \c estimatedCost(), so that cheap subtrees run in a single task. */
 template<class FOREST, typename DATA, typename VISITOR_PRE,
     typename VISITOR_POST>
 void DepthFirstForestParallel(FOREST& forest, DATA& rootData,
     VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
-    int problemSizeThreshold = 10) {
+    double minTaskCost = 1e5) {
 #ifdef GTSAM_USE_TBB
   // Typedefs
   typedef typename FOREST::Node Node;
   typedef boost::shared_ptr<Node> sharedNode;
 
+  // Estimate the cost of every subtree, and split the total among a few tasks per thread
+  static const int tasksPerThread = 8;
+  internal::TraversalCosts<Node> costs;
+  {
+    int costRootData = 0;
+    internal::NoCostData costVisitorPre;
+    internal::SubtreeCostVisitor<Node> costVisitorPost(costs);
+    DepthFirstForest(forest, costRootData, costVisitorPre, costVisitorPost);
+  }
+  double totalCost = 0.0;
+  BOOST_FOREACH(const sharedNode& root, forest.roots())
+    totalCost += costs.cost(root);
+  costs.taskCutoff = std::max(minTaskCost,
+      totalCost / (tasksPerThread * tbb::task_scheduler_init::default_num_threads()));
+
   tbb::task::spawn_root_and_wait(
       internal::CreateRootTask<Node>(forest.roots(), rootData, visitorPre,
-          visitorPost, problemSizeThreshold));
+          visitorPost, costs));
 #else
   DepthFirstForest(forest, rootData, visitorPre, visitorPost);
 #endif
@@ -17,10 +17,13 @@
 #pragma once
 
 #include <gtsam/global_includes.h>
+#include <gtsam/base/FastVector.h>
 
+#include <algorithm>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/foreach.hpp>
+#include <boost/unordered_map.hpp>
 
 #ifdef GTSAM_USE_TBB
 #  include <tbb/tbb.h>
@@ -36,6 +39,40 @@ namespace gtsam {
 
     namespace internal {
 
+      /* ************************************************************************* */
+      /// Estimated costs of the subtrees of a forest, and the cost above which a subtree gets
+      /// tasks of its own.  Computed before the parallel traversal and read only during it.
+      template<typename NODE>
+      struct TraversalCosts
+      {
+        typedef boost::shared_ptr<NODE> sharedNode;
+
+        boost::unordered_map<const NODE*, double> subtreeCosts;
+        double taskCutoff;
+
+        /// The estimated cost of the subtree rooted at node
+        double cost(const sharedNode& node) const { return subtreeCosts.find(node.get())->second; }
+
+        /// Whether the subtree rooted at node is expensive enough to spawn tasks for its children
+        bool makeNewTasks(const sharedNode& node) const { return cost(node) >= taskCutoff; }
+
+        /// Indices of the nodes, from the most to the least expensive subtree
+        template<typename NODES>
+        FastVector<size_t> heaviestFirst(const NODES& nodes) const
+        {
+          FastVector<std::pair<double, size_t> > order;
+          order.reserve(nodes.size());
+          for (size_t i = 0; i < nodes.size(); ++i)
+            order.push_back(std::make_pair(-cost(nodes[i]), i));
+          std::stable_sort(order.begin(), order.end());
+          FastVector<size_t> indices;
+          indices.reserve(nodes.size());
+          for (size_t i = 0; i < order.size(); ++i)
+            indices.push_back(order[i].second);
+          return indices;
+        }
+      };
+
       /* ************************************************************************* */
       template<typename NODE, typename DATA, typename VISITOR_POST>
       class PostOrderTask : public tbb::task
@@ -66,16 +103,16 @@ namespace gtsam {
         boost::shared_ptr<DATA> myData;
         VISITOR_PRE& visitorPre;
         VISITOR_POST& visitorPost;
-        int problemSizeThreshold;
+        const TraversalCosts<NODE>& costs;
         bool makeNewTasks;
 
         bool isPostOrderPhase;
 
         PreOrderTask(const boost::shared_ptr<NODE>& treeNode, const boost::shared_ptr<DATA>& myData,
-          VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost, int problemSizeThreshold,
+          VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost, const TraversalCosts<NODE>& costs,
           bool makeNewTasks = true) :
           treeNode(treeNode), myData(myData), visitorPre(visitorPre), visitorPost(visitorPost),
-          problemSizeThreshold(problemSizeThreshold), makeNewTasks(makeNewTasks), isPostOrderPhase(false) {}
+          costs(costs), makeNewTasks(makeNewTasks), isPostOrderPhase(false) {}
 
         tbb::task* execute()
         {
@@ -97,22 +134,25 @@ namespace gtsam {
                 //PostOrderTask<NODE, DATA, VISITOR_POST>& postOrderTask =
                 //  *new(allocate_continuation()) PostOrderTask<NODE, DATA, VISITOR_POST>(treeNode, myData, visitorPost);
 
-                bool overThreshold = (treeNode->problemSize() >= problemSizeThreshold);
+                // Run visitorPre on the children in tree order, the order in which the visitors
+                // expect them.  Important:  Run visitorPre before calling allocate_child so that
+                // if visitorPre throws an exception, we will not have allocated an extra child,
+                // this causes a TBB error.
+                FastVector<boost::shared_ptr<DATA> > childData;
+                childData.reserve(treeNode->children.size());
+                BOOST_FOREACH(const boost::shared_ptr<NODE>& child, treeNode->children)
+                  childData.push_back(boost::allocate_shared<DATA>(tbb::scalable_allocator<DATA>(), visitorPre(child, *myData)));
 
+                // Process each child in a subtask, starting with the most expensive subtree,
+                // which is on the critical path, in this thread.  Only children whose subtree
+                // is over the cutoff spawn tasks for their own children.
                 tbb::task* firstChild = 0;
                 tbb::task_list childTasks;
-                BOOST_FOREACH(const boost::shared_ptr<NODE>& child, treeNode->children)
+                BOOST_FOREACH(size_t i, costs.heaviestFirst(treeNode->children))
                 {
-                  // Process child in a subtask.  Important:  Run visitorPre before calling
-                  // allocate_child so that if visitorPre throws an exception, we will not have
-                  // allocated an extra child, this causes a TBB error.
-                  boost::shared_ptr<DATA> childData = boost::allocate_shared<DATA>(tbb::scalable_allocator<DATA>(), visitorPre(child, *myData));
-                  //childTasks.push_back(*new(postOrderTask.allocate_child())
-                  //  PreOrderTask(child, childData, visitorPre, visitorPost,
-                  //  problemSizeThreshold, overThreshold));
                   tbb::task* childTask = new(allocate_child())
-                    PreOrderTask(child, childData, visitorPre, visitorPost,
-                    problemSizeThreshold, overThreshold);
+                    PreOrderTask(treeNode->children[i], childData[i], visitorPre, visitorPost,
+                    costs, costs.makeNewTasks(treeNode->children[i]));
                   if(firstChild)
                     childTasks.push_back(*childTask);
                   else
@@ -163,22 +203,27 @@ namespace gtsam {
         DATA& myData;
         VISITOR_PRE& visitorPre;
         VISITOR_POST& visitorPost;
-        int problemSizeThreshold;
+        const TraversalCosts<NODE>& costs;
         RootTask(const ROOTS& roots, DATA& myData, VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
-          int problemSizeThreshold) :
+          const TraversalCosts<NODE>& costs) :
           roots(roots), myData(myData), visitorPre(visitorPre), visitorPost(visitorPost),
-          problemSizeThreshold(problemSizeThreshold) {}
+          costs(costs) {}
 
         tbb::task* execute()
         {
           typedef PreOrderTask<NODE, DATA, VISITOR_PRE, VISITOR_POST> PreOrderTask;
-          // Create data and tasks for our children
-          tbb::task_list tasks;
+          // Create data for our children in tree order, then their tasks with the most expensive
+          // subtree first
+          FastVector<boost::shared_ptr<DATA> > rootData;
+          rootData.reserve(roots.size());
           BOOST_FOREACH(const boost::shared_ptr<NODE>& root, roots)
+            rootData.push_back(boost::allocate_shared<DATA>(tbb::scalable_allocator<DATA>(), visitorPre(root, myData)));
+          tbb::task_list tasks;
+          BOOST_FOREACH(size_t i, costs.heaviestFirst(roots))
           {
-            boost::shared_ptr<DATA> rootData = boost::allocate_shared<DATA>(tbb::scalable_allocator<DATA>(), visitorPre(root, myData));
             tasks.push_back(*new(allocate_child())
-              PreOrderTask(root, rootData, visitorPre, visitorPost, problemSizeThreshold));
+              PreOrderTask(roots[i], rootData[i], visitorPre, visitorPost, costs,
+              costs.makeNewTasks(roots[i])));
           }
           // Set TBB ref count
           set_ref_count(1 + (int) roots.size());
@@ -191,10 +236,10 @@ namespace gtsam {
 
       template<typename NODE, typename ROOTS, typename DATA, typename VISITOR_PRE, typename VISITOR_POST>
       RootTask<ROOTS, NODE, DATA, VISITOR_PRE, VISITOR_POST>&
-        CreateRootTask(const ROOTS& roots, DATA& rootData, VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost, int problemSizeThreshold)
+        CreateRootTask(const ROOTS& roots, DATA& rootData, VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost, const TraversalCosts<NODE>& costs)
       {
           typedef RootTask<ROOTS, NODE, DATA, VISITOR_PRE, VISITOR_POST> RootTask;
-          return *new(tbb::task::allocate_root()) RootTask(roots, rootData, visitorPre, visitorPost, problemSizeThreshold);
+          return *new(tbb::task::allocate_root()) RootTask(roots, rootData, visitorPre, visitorPost, costs);
         }
 
     }
@@ -140,7 +140,8 @@ namespace gtsam {
 
   /// An object whose scope defines a block where TBB and OpenMP parallelism are mixed.  In such a
   /// block, we use default threads for TBB, and p/2 threads for OpenMP.  If GTSAM is not compiled to
-  /// use both TBB and OpenMP, this has no effect.
+  /// use both TBB and OpenMP, this has no effect.  Large cliques do not need more OpenMP threads,
+  /// choleskyPartial factors them with nested TBB tasks.
   class TbbOpenMPMixedScope
   {
     int previousOpenMPThreads;
@@ -20,6 +20,9 @@
 
 #include <gtsam/discrete/DecisionTree-inl.h>
 
+#include <cmath>
+#include <limits>
+
 namespace gtsam {
 
   /**
@@ -59,6 +62,43 @@ namespace gtsam {
       }
     };
 
+    /**
+     * The same ring on log values, which do not underflow on long chains: multiplication is
+     * addition, addition is log-sum-exp, and maximization is unchanged.
+     */
+    struct LogRing {
+      static inline double zero() {
+        return -std::numeric_limits<double>::infinity();
+      }
+      static inline double one() {
+        return 0.0;
+      }
+      static inline double add(const double& a, const double& b) {
+        if (a == zero()) return b;
+        if (b == zero()) return a;
+        return a > b ? a + std::log1p(std::exp(b - a)) : b + std::log1p(std::exp(a - b));
+      }
+      static inline double max(const double& a, const double& b) {
+        return std::max(a, b);
+      }
+      static inline double mul(const double& a, const double& b) {
+        return a + b;
+      }
+      /// Safe division, log(0)-log(0) is log(0)
+      static inline double div(const double& a, const double& b) {
+        return a == zero() ? a : a - b;
+      }
+      static inline double id(const double& x) {
+        return x;
+      }
+      static inline double log(const double& x) {
+        return std::log(x);
+      }
+      static inline double exp(const double& x) {
+        return std::exp(x);
+      }
+    };
+
     AlgebraicDecisionTree() :
         Super(1.0) {
     }
@@ -102,7 +142,7 @@ namespace gtsam {
     template<typename Iterator>
     AlgebraicDecisionTree(Iterator begin, Iterator end, const L& label) :
         Super(NULL) {
-      this->root_ = compose(begin, end, label);
+      this->root_ = this->compose(begin, end, label);
     }
 
     /** Convert */
@@ -138,6 +178,21 @@ namespace gtsam {
       return this->combine(labelC, &Ring::add);
     }
 
+    /** log of every value, to do arithmetic with LogRing */
+    AlgebraicDecisionTree log() const {
+      return this->apply(&LogRing::log);
+    }
+
+    /** exp of every value, back from LogRing */
+    AlgebraicDecisionTree exp() const {
+      return this->apply(&LogRing::exp);
+    }
+
+    /** sum out variable from log values, with log-sum-exp */
+    AlgebraicDecisionTree logSum(const L& label, size_t cardinality) const {
+      return this->combine(label, cardinality, &LogRing::add);
+    }
+
   };
 // AlgebraicDecisionTree
 
@@ -21,6 +21,7 @@
 
 #include <gtsam/discrete/DecisionTree.h>
 #include <gtsam/base/Testable.h>
+#include <gtsam/base/FastDefaultAllocator.h>
 
 #include <boost/format.hpp>
 #include <boost/optional.hpp>
@@ -29,6 +30,9 @@
 #include <boost/assign/std/vector.hpp>
 using boost::assign::operator+=;
 #include <boost/unordered_set.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/noncopyable.hpp>
 
 #include <list>
@@ -101,32 +105,6 @@ namespace gtsam {
       return constant_;
     }
 
-    /** apply unary operator */
-    NodePtr apply(const Unary& op) const {
-      NodePtr f(new Leaf(op(constant_)));
-      return f;
-    }
-
-    // Apply binary operator "h = f op g" on Leaf node
-    // Note op is not assumed commutative so we need to keep track of order
-    // Simply calls apply on argument to call correct virtual method:
-    // fL.apply_f_op_g(gL) -> gL.apply_g_op_fL(fL) (below)
-    // fL.apply_f_op_g(gC) -> gC.apply_g_op_fL(fL) (Choice)
-    NodePtr apply_f_op_g(const Node& g, const Binary& op) const {
-      return g.apply_g_op_fL(*this, op);
-    }
-
-    // Applying binary operator to two leaves results in a leaf
-    NodePtr apply_g_op_fL(const Leaf& fL, const Binary& op) const {
-      NodePtr h(new Leaf(op(fL.constant_, constant_))); // fL op gL
-      return h;
-    }
-
-    // If second argument is a Choice node, call it's apply with leaf as second
-    NodePtr apply_g_op_fC(const Choice& fC, const Binary& op) const {
-      return fC.apply_fC_op_gL(*this, op); // operand order back to normal
-    }
-
     /** choose a branch, create new memory ! */
     NodePtr choose(const L& label, size_t index) const {
       return NodePtr(new Leaf(constant()));
@@ -184,37 +162,6 @@ namespace gtsam {
       branches_.reserve(count);
     }
 
-    /**
-     * Construct from applying binary op to two Choice nodes
-     */
-    Choice(const Choice& f, const Choice& g, const Binary& op) :
-      allSame_(true) {
-
-      // Choose what to do based on label
-      if (f.label() > g.label()) {
-        // f higher than g
-        label_ = f.label();
-        size_t count = f.nrChoices();
-        branches_.reserve(count);
-        for (size_t i = 0; i < count; i++)
-          push_back(f.branches_[i]->apply_f_op_g(g, op));
-      } else if (g.label() > f.label()) {
-        // f lower than g
-        label_ = g.label();
-        size_t count = g.nrChoices();
-        branches_.reserve(count);
-        for (size_t i = 0; i < count; i++)
-          push_back(g.branches_[i]->apply_g_op_fC(f, op));
-      } else {
-        // f same level as g
-        label_ = f.label();
-        size_t count = f.nrChoices();
-        branches_.reserve(count);
-        for (size_t i = 0; i < count; i++)
-          push_back(f.branches_[i]->apply_f_op_g(*g.branches_[i], op));
-      }
-    }
-
     const L& label() const {
       return label_;
     }
@@ -303,68 +250,131 @@ namespace gtsam {
       return (*child)(x);
     }
 
-    /**
-     * Construct from applying unary op to a Choice node
-     */
-    Choice(const L& label, const Choice& f, const Unary& op) :
-      label_(label), allSame_(true) {
-
-      branches_.reserve(f.branches_.size()); // reserve space
-      BOOST_FOREACH (const NodePtr& branch, f.branches_)
-              push_back(branch->apply(op));
+    /** choose a branch, recursively */
+    NodePtr choose(const L& label, size_t index) const {
+      if (label_ == label)
+        return branches_[index]; // choose branch
+    
+      // second case, not label of interest, just recurse
+      boost::shared_ptr<Choice> r(new Choice(label_, branches_.size()));
+      BOOST_FOREACH(const NodePtr& branch, branches_)
+              r->push_back(branch->choose(label, index));
+      return Unique(r);
     }
 
-    /** apply unary operator */
-    NodePtr apply(const Unary& op) const {
-      boost::shared_ptr<Choice> r(new Choice(label_, *this, op));
-      return Unique(r);
+  }; // Choice
+
+  /*********************************************************************************/
+  // NodeCache
+  /*********************************************************************************/
+  /**
+   * Unique table for the nodes created by one apply or combine, as in BDD packages: equal
+   * leaves, and choices on the same label with the same branches, are created only once, so
+   * the result is a DAG in which equal subtrees are shared.  Because branches are themselves
+   * unique, two choices are equal exactly when their branch pointers are, which makes the
+   * lookup cheap.  The table also memoizes apply on pairs of operand nodes, so a shared
+   * subtree is only visited once per operand.  Nodes are allocated from the pool behind
+   * FastDefaultAllocator.  The cache lives only as long as the operation, so no global state
+   * is shared between threads.
+   */
+  template<typename L, typename Y>
+  class DecisionTree<L, Y>::NodeCache: boost::noncopyable {
+
+    typedef typename internal::FastDefaultAllocator<Leaf>::type LeafAllocator;
+    typedef typename internal::FastDefaultAllocator<Choice>::type ChoiceAllocator;
+
+    /** A choice is identified by its label and the addresses of its (unique) branches */
+    struct ChoiceKey {
+      L label;
+      std::vector<const Node*> branches;
+      bool operator==(const ChoiceKey& other) const {
+        return label == other.label && branches == other.branches;
+      }
+      friend size_t hash_value(const ChoiceKey& key) {
+        size_t seed = boost::hash<L>()(key.label);
+        boost::hash_range(seed, key.branches.begin(), key.branches.end());
+        return seed;
+      }
+    };
+
+    /** Result of apply, holding on to the operands so their addresses are not reused */
+    struct Memo {
+      NodePtr f, g, h;
+    };
+
+    typedef std::pair<const Node*, const Node*> Operands;
+
+    boost::unordered_map<Y, NodePtr> leaves_;
+    boost::unordered_map<ChoiceKey, NodePtr> choices_;
+    boost::unordered_map<Operands, Memo> binary_;
+    boost::unordered_map<const Node*, Memo> unary_;
+
+  public:
+
+    /** The unique leaf with value y */
+    NodePtr leaf(const Y& y) {
+      NodePtr& node = leaves_[y];
+      if (!node)
+        node = boost::allocate_shared<Leaf>(LeafAllocator(), y);
+      return node;
     }
 
-    // Apply binary operator "h = f op g" on Choice node
-    // Note op is not assumed commutative so we need to keep track of order
-    // Simply calls apply on argument to call correct virtual method:
-    // fC.apply_f_op_g(gL) -> gL.apply_g_op_fC(fC) -> (Leaf)
-    // fC.apply_f_op_g(gC) -> gC.apply_g_op_fC(fC) -> (below)
-    NodePtr apply_f_op_g(const Node& g, const Binary& op) const {
-      return g.apply_g_op_fC(*this, op);
+    /** The unique choice on label with the given unique branches, pruned like Choice::Unique */
+    NodePtr choice(const L& label, const std::vector<NodePtr>& branches) {
+      assert(!branches.empty());
+#ifndef DT_NO_PRUNING
+      bool allSame = true;
+      for (size_t i = 1; allSame && i < branches.size(); i++)
+        allSame = branches[i]->sameLeaf(*branches[0]);
+      if (allSame && branches[0]->isLeaf())
+        return branches[0];
+#endif
+      ChoiceKey key;
+      key.label = label;
+      key.branches.reserve(branches.size());
+      BOOST_FOREACH(const NodePtr& branch, branches)
+        key.branches.push_back(branch.get());
+      NodePtr& node = choices_[key];
+      if (!node) {
+        boost::shared_ptr<Choice> c =
+            boost::allocate_shared<Choice>(ChoiceAllocator(), label, branches.size());
+        BOOST_FOREACH(const NodePtr& branch, branches)
+          c->push_back(branch);
+        node = c;
+      }
+      return node;
     }
 
-    // If second argument of binary op is Leaf node, recurse on branches
-    NodePtr apply_g_op_fL(const Leaf& fL, const Binary& op) const {
-      boost::shared_ptr<Choice> h(new Choice(label(), nrChoices()));
-      BOOST_FOREACH(NodePtr branch, branches_)
-              h->push_back(fL.apply_f_op_g(*branch, op));
-      return Unique(h);
+    /** Memoized result of f op g, or null */
+    NodePtr find(const NodePtr& f, const NodePtr& g) const {
+      typename boost::unordered_map<Operands, Memo>::const_iterator it =
+          binary_.find(Operands(f.get(), g.get()));
+      return it == binary_.end() ? NodePtr() : it->second.h;
     }
 
-    // If second argument of binary op is Choice, call constructor
-    NodePtr apply_g_op_fC(const Choice& fC, const Binary& op) const {
-      boost::shared_ptr<Choice> h(new Choice(fC, *this, op));
-      return Unique(h);
+    /** Memoized result of op(f), or null */
+    NodePtr find(const NodePtr& f) const {
+      typename boost::unordered_map<const Node*, Memo>::const_iterator it =
+          unary_.find(f.get());
+      return it == unary_.end() ? NodePtr() : it->second.h;
     }
 
-    // If second argument of binary op is Leaf
-    template<typename OP>
-    NodePtr apply_fC_op_gL(const Leaf& gL, OP op) const {
-      boost::shared_ptr<Choice> h(new Choice(label(), nrChoices()));
-      BOOST_FOREACH(const NodePtr& branch, branches_)
-              h->push_back(branch->apply_f_op_g(gL, op));
-      return Unique(h);
+    /** Remember h = f op g */
+    void memoize(const NodePtr& f, const NodePtr& g, const NodePtr& h) {
+      Memo& memo = binary_[Operands(f.get(), g.get())];
+      memo.f = f;
+      memo.g = g;
+      memo.h = h;
     }
 
-    /** choose a branch, recursively */
-    NodePtr choose(const L& label, size_t index) const {
-      if (label_ == label)
-        return branches_[index]; // choose branch
-    
-      // second case, not label of interest, just recurse
-      boost::shared_ptr<Choice> r(new Choice(label_, branches_.size()));
-      BOOST_FOREACH(const NodePtr& branch, branches_)
-              r->push_back(branch->choose(label, index));
-      return Unique(r);
+    /** Remember h = op(f) */
+    void memoize(const NodePtr& f, const NodePtr& h) {
+      Memo& memo = unary_[f.get()];
+      memo.f = f;
+      memo.h = h;
     }
 
-  }; // Choice
+  }; // NodeCache
 
   /*********************************************************************************/
   // DecisionTree
@@ -623,7 +633,8 @@ namespace gtsam {
 
   template<typename L, typename Y>
   DecisionTree<L, Y> DecisionTree<L, Y>::apply(const Unary& op) const {
-    return DecisionTree(root_->apply(op));
+    NodeCache cache;
+    return DecisionTree(Apply(root_, op, cache));
   }
 
   /*********************************************************************************/
@@ -631,12 +642,87 @@ namespace gtsam {
   DecisionTree<L, Y> DecisionTree<L, Y>::apply(const DecisionTree& g,
       const Binary& op) const {
     // apply the operaton on the root of both diagrams
-    NodePtr h = root_->apply_f_op_g(*g.root_, op);
+    NodeCache cache;
+    NodePtr h = Apply(root_, g.root_, op, cache);
     // create a new class with the resulting root "h"
     DecisionTree result(h);
     return result;
   }
 
+  /*********************************************************************************/
+  template<typename L, typename Y>
+  typename DecisionTree<L, Y>::NodePtr DecisionTree<L, Y>::Apply(const NodePtr& f,
+      const Unary& op, NodeCache& cache) {
+    NodePtr h = cache.find(f);
+    if (h) return h;
+    if (f->isLeaf())
+      h = cache.leaf(op(static_cast<const Leaf&>(*f).constant()));
+    else {
+      const Choice& fC = static_cast<const Choice&>(*f);
+      std::vector<NodePtr> branches;
+      branches.reserve(fC.nrChoices());
+      BOOST_FOREACH(const NodePtr& branch, fC.branches())
+        branches.push_back(Apply(branch, op, cache));
+      h = cache.choice(fC.label(), branches);
+    }
+    cache.memoize(f, h);
+    return h;
+  }
+
+  /*********************************************************************************/
+  // Apply binary operator "h = f op g", recursing on the highest label of f and g.
+  // Note op is not assumed commutative so we need to keep track of order.
+  template<typename L, typename Y>
+  typename DecisionTree<L, Y>::NodePtr DecisionTree<L, Y>::Apply(const NodePtr& f,
+      const NodePtr& g, const Binary& op, NodeCache& cache) {
+    NodePtr h = cache.find(f, g);
+    if (h) return h;
+    const Choice* fC = f->isLeaf() ? 0 : static_cast<const Choice*>(f.get());
+    const Choice* gC = g->isLeaf() ? 0 : static_cast<const Choice*>(g.get());
+    std::vector<NodePtr> branches;
+    if (!fC && !gC) {
+      // Applying binary operator to two leaves results in a leaf
+      h = cache.leaf(op(static_cast<const Leaf&>(*f).constant(),
+          static_cast<const Leaf&>(*g).constant()));
+    } else if (fC && (!gC || fC->label() > gC->label())) {
+      // f higher than g
+      branches.reserve(fC->nrChoices());
+      BOOST_FOREACH(const NodePtr& branch, fC->branches())
+        branches.push_back(Apply(branch, g, op, cache));
+      h = cache.choice(fC->label(), branches);
+    } else if (!fC || gC->label() > fC->label()) {
+      // f lower than g
+      branches.reserve(gC->nrChoices());
+      BOOST_FOREACH(const NodePtr& branch, gC->branches())
+        branches.push_back(Apply(f, branch, op, cache));
+      h = cache.choice(gC->label(), branches);
+    } else {
+      // f same level as g
+      branches.reserve(fC->nrChoices());
+      for (size_t i = 0; i < fC->nrChoices(); i++)
+        branches.push_back(Apply(fC->branches()[i], gC->branches()[i], op, cache));
+      h = cache.choice(fC->label(), branches);
+    }
+    cache.memoize(f, g, h);
+    return h;
+  }
+
+  /*********************************************************************************/
+  template<typename L, typename Y>
+  size_t DecisionTree<L, Y>::NrLeaves(const NodePtr& f) {
+    if (f->isLeaf()) return 1;
+    size_t n = 0;
+    BOOST_FOREACH(const NodePtr& branch, static_cast<const Choice&>(*f).branches())
+      n += NrLeaves(branch);
+    return n;
+  }
+
+  /*********************************************************************************/
+  template<typename L, typename Y>
+  size_t DecisionTree<L, Y>::nrLeaves() const {
+    return NrLeaves(root_);
+  }
+
   /*********************************************************************************/
   // The way this works:
   // We have an ADT, picture it as a tree.
@@ -649,12 +735,14 @@ namespace gtsam {
   template<typename L, typename Y>
   DecisionTree<L, Y> DecisionTree<L, Y>::combine(const L& label,
       size_t cardinality, const Binary& op) const {
-    DecisionTree result = choose(label, 0);
+    // one cache for all the applies, so subtrees shared by the chosen trees are reused
+    NodeCache cache;
+    NodePtr result = choose(label, 0).root_;
     for (size_t index = 1; index < cardinality; index++) {
       DecisionTree chosen = choose(label, index);
-      result = result.apply(chosen, op);
+      result = Apply(result, chosen.root_, op, cache);
     }
-    return result;
+    return DecisionTree(result);
   }
 
   /*********************************************************************************/
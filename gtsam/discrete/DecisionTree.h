@@ -81,10 +81,6 @@ namespace gtsam {
       virtual bool sameLeaf(const Node& q) const = 0;
       virtual bool equals(const Node& other, double tol = 1e-9) const = 0;
       virtual const Y& operator()(const Assignment<L>& x) const = 0;
-      virtual Ptr apply(const Unary& op) const = 0;
-      virtual Ptr apply_f_op_g(const Node&, const Binary&) const = 0;
-      virtual Ptr apply_g_op_fL(const Leaf&, const Binary&) const = 0;
-      virtual Ptr apply_g_op_fC(const Choice&, const Binary&) const = 0;
       virtual Ptr choose(const L& label, size_t index) const = 0;
       virtual bool isLeaf() const = 0;
     };
@@ -100,6 +96,19 @@ namespace gtsam {
 
   protected:
 
+    /** Unique table and apply cache for one operation, see DecisionTree-inl.h */
+    class NodeCache;
+
+    /** Apply unary op to the tree rooted at f, memoized and hash-consed in cache */
+    static NodePtr Apply(const NodePtr& f, const Unary& op, NodeCache& cache);
+
+    /** Apply binary op to the trees rooted at f and g, memoized and hash-consed in cache */
+    static NodePtr Apply(const NodePtr& f, const NodePtr& g, const Binary& op,
+        NodeCache& cache);
+
+    /** Number of leaves below f, see nrLeaves */
+    static size_t NrLeaves(const NodePtr& f);
+
     /** Internal recursive function to create from keys, cardinalities, and Y values */
     template<typename It, typename ValueIt>
     NodePtr create(It begin, It end, ValueIt beginY, ValueIt endY) const;
@@ -182,6 +191,9 @@ namespace gtsam {
       return DecisionTree(newRoot);
     }
 
+    /** number of leaves, counting a leaf once for every path that reaches it */
+    size_t nrLeaves() const;
+
     /** combine subtrees on key with binary operation "op" */
     DecisionTree combine(const L& label, size_t cardinality, const Binary& op) const;
 
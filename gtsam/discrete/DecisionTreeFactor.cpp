@@ -135,5 +135,19 @@ namespace gtsam {
     return boost::make_shared<DecisionTreeFactor>(dkeys, result);
   }
 
+  /* ************************************************************************* */
+  DecisionTreeFactor DecisionTreeFactor::log() const {
+    DecisionTreeFactor result(*this);
+    static_cast<ADT&>(result) = ADT::log();
+    return result;
+  }
+
+  /* ************************************************************************* */
+  DecisionTreeFactor DecisionTreeFactor::exp() const {
+    DecisionTreeFactor result(*this);
+    static_cast<ADT&>(result) = ADT::exp();
+    return result;
+  }
+
 /* ************************************************************************* */
 } // namespace gtsam
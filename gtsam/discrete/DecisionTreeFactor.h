@@ -115,6 +115,38 @@ namespace gtsam {
       return combine(nrFrontals, ADT::Ring::max);
     }
 
+    /// Create new factor by maximizing over all values with the same separator values
+    shared_ptr max(const Ordering& keys) const {
+      return combine(keys, ADT::Ring::max);
+    }
+
+    /// @}
+    /// @name Log Values
+    /// Factors holding log values, see ADT::LogRing, do not underflow on long chains.
+    /// Maximization is the same on log values, use max.
+    /// @{
+
+    /// Factor with the log of every value
+    DecisionTreeFactor log() const;
+
+    /// Factor with the exp of every value, back from log values
+    DecisionTreeFactor exp() const;
+
+    /// Multiply two factors holding log values, i.e., add them
+    DecisionTreeFactor logProduct(const DecisionTreeFactor& f) const {
+      return apply(f, ADT::LogRing::mul);
+    }
+
+    /// Create new factor by summing all log values with the same separator values (log-sum-exp)
+    shared_ptr logSum(size_t nrFrontals) const {
+      return combine(nrFrontals, ADT::LogRing::add);
+    }
+
+    /// Create new factor by summing all log values with the same separator values (log-sum-exp)
+    shared_ptr logSum(const Ordering& keys) const {
+      return combine(keys, ADT::LogRing::add);
+    }
+
     /// @}
     /// @name Advanced Interface
     /// @{
@@ -28,6 +28,7 @@
 #include <boost/random/variate_generator.hpp>
 
 #include <vector>
+#include <limits>
 #include <algorithm>
 #include <stdexcept>
 
@@ -58,6 +59,22 @@ DiscreteConditional::DiscreteConditional(const DecisionTreeFactor& joint,
   }
 }
 
+/* ******************************************************************************** */
+DiscreteConditional::shared_ptr DiscreteConditional::FromLogJoint(
+    const DecisionTreeFactor& logJoint, const DecisionTreeFactor& logMarginal,
+    const boost::optional<Ordering>& orderedKeys) {
+  shared_ptr conditional(new DiscreteConditional());
+  static_cast<DecisionTreeFactor&>(*conditional) =
+      logJoint.apply(logMarginal, ADT::LogRing::div);
+  conditional->nrFrontals_ = logJoint.size() - logMarginal.size();
+  if (orderedKeys) {
+    conditional->keys_.clear();
+    conditional->keys_.insert(conditional->keys_.end(), orderedKeys->begin(),
+        orderedKeys->end());
+  }
+  return conditional;
+}
+
 /* ******************************************************************************** */
 DiscreteConditional::DiscreteConditional(const Signature& signature) :
         BaseFactor(signature.discreteKeysParentsFirst(), signature.cpt()), BaseConditional(
@@ -108,7 +125,7 @@ void DiscreteConditional::solveInPlace(Values& values) const {
 
   // Initialize
   Values mpe;
-  double maxP = 0;
+  double maxP = -numeric_limits<double>::infinity(); // also log values
 
   DiscreteKeys keys;
   BOOST_FOREACH(Key idx, frontals()) {
@@ -152,7 +169,7 @@ size_t DiscreteConditional::solve(const Values& parentsValues) const {
   // TODO, only works for one key now, seems horribly slow this way
   size_t mpe = 0;
   Values frontals;
-  double maxP = 0;
+  double maxP = -numeric_limits<double>::infinity(); // also log values
   assert(nrFrontals() == 1);
   Key j = (firstFrontalKey());
   for (size_t value = 0; value < cardinality(j); value++) {
@@ -62,6 +62,14 @@ public:
   DiscreteConditional(const DecisionTreeFactor& joint,
       const DecisionTreeFactor& marginal, const boost::optional<Ordering>& orderedKeys = boost::none);
 
+  /**
+   * Construct log P(X|Y) = log P(X,Y) - log P(Y) from factors holding log values, see
+   * DecisionTreeFactor::log.  solve and solveInPlace work on the result as usual.
+   */
+  static shared_ptr FromLogJoint(const DecisionTreeFactor& logJoint,
+      const DecisionTreeFactor& logMarginal, const boost::optional<Ordering>& orderedKeys =
+          boost::none);
+
   /**
    * Combine several conditional into a single one.
    * The conditionals must be given in increasing order, meaning that the parents
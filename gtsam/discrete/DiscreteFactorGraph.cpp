@@ -22,8 +22,16 @@
 #include <gtsam/discrete/DiscreteBayesTree.h>
 #include <gtsam/discrete/DiscreteEliminationTree.h>
 #include <gtsam/discrete/DiscreteJunctionTree.h>
+#include <gtsam/discrete/DiscreteTableFactor.h>
 #include <gtsam/inference/FactorGraph-inst.h>
 #include <gtsam/inference/EliminateableFactorGraph-inst.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
+
 #include <boost/make_shared.hpp>
 
 namespace gtsam {
@@ -46,14 +54,6 @@ namespace gtsam {
     return keys;
   }
 
-  /* ************************************************************************* */
-  DecisionTreeFactor DiscreteFactorGraph::product() const {
-    DecisionTreeFactor result;
-    BOOST_FOREACH(const sharedFactor& factor, *this)
-      if (factor) result = (*factor) * result;
-    return result;
-  }
-
   /* ************************************************************************* */
   double DiscreteFactorGraph::operator()(
       const DiscreteFactor::Values &values) const {
@@ -100,15 +100,126 @@ namespace gtsam {
     return BaseEliminateable::eliminateSequential()->optimize();
   }
 
+  /* ************************************************************************* */
+  DiscreteFactor::sharedValues DiscreteFactorGraph::optimizeLog() const
+  {
+    gttic(DiscreteFactorGraph_optimizeLog);
+    DiscreteFactorGraph logFactors;
+    logFactors.reserve(size());
+    BOOST_FOREACH(const sharedFactor& factor, *this)
+      if (factor) logFactors.push_back(
+          boost::make_shared<DecisionTreeFactor>(factor->toDecisionTreeFactor().log()));
+    return logFactors.eliminateSequential(boost::none, EliminateDiscreteLogMax)->optimize();
+  }
+
+#ifdef GTSAM_USE_TBB
+  /* ************************************************************************* */
+  namespace {
+    typedef DecisionTreeFactor::ADT ADT;
+
+    // Products of the factors with key j fixed to each value in a range
+    class RestrictedProducts {
+      const std::vector<DecisionTreeFactor>& factors_;
+      const Key j_;
+      std::vector<ADT>& products_;
+    public:
+      RestrictedProducts(const std::vector<DecisionTreeFactor>& factors, Key j,
+          std::vector<ADT>& products) :
+          factors_(factors), j_(j), products_(products) {
+      }
+      void operator()(const tbb::blocked_range<size_t>& r) const {
+        for (size_t value = r.begin(); value != r.end(); ++value) {
+          ADT product;
+          BOOST_FOREACH(const DecisionTreeFactor& factor, factors_)
+            product = ADT(factor.choose(j_, value)) * product;
+          products_[value] = product;
+        }
+      }
+    };
+  }
+#endif
+
+  /* ************************************************************************* */
+  DecisionTreeFactor DiscreteFactorGraph::product() const {
+#ifdef GTSAM_USE_TBB
+    // The scope of the product, whose highest key is the root of the product tree
+    std::vector<DecisionTreeFactor> trees;
+    std::map<Key, size_t> cs;
+    BOOST_FOREACH(const sharedFactor& factor, *this) {
+      if (!factor) continue;
+      trees.push_back(factor->toDecisionTreeFactor());
+      BOOST_FOREACH(Key j, trees.back().keys())
+        cs[j] = trees.back().cardinality(j);
+    }
+
+    if (!cs.empty() && cs.rbegin()->second > 1) {
+      // Multiply the factors restricted to each value of the root in parallel: these are the
+      // branches of the root of the product, and no node of the product depends on two of them
+      const DiscreteKey root = *cs.rbegin();
+      std::vector<ADT> branches(root.second);
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, root.second),
+          RestrictedProducts(trees, root.first, branches));
+      DiscreteKeys keys;
+      BOOST_FOREACH(const DiscreteKey& key, cs)
+        keys.push_back(key);
+      return DecisionTreeFactor(keys, ADT(branches.begin(), branches.end(), root.first));
+    }
+#endif
+    DecisionTreeFactor result;
+    BOOST_FOREACH(const sharedFactor& factor, *this)
+      if (factor) result = (*factor) * result;
+    return result;
+  }
+
+  /* ************************************************************************* */
+  std::pair<DiscreteConditional::shared_ptr, DecisionTreeFactor::shared_ptr>  //
+  EliminateDiscreteTables(const DiscreteFactorGraph& factors, const Ordering& frontalKeys) {
+
+    // PRODUCT: multiply all factors as tables
+    gttic(product);
+    DiscreteTableFactor product;
+    BOOST_FOREACH(const DiscreteFactor::shared_ptr& factor, factors) {
+      if (!factor) continue;
+      if (const DiscreteTableFactor* table =
+          dynamic_cast<const DiscreteTableFactor*>(factor.get()))
+        product = (*table) * product;
+      else
+        product = DiscreteTableFactor(factor->toDecisionTreeFactor()) * product;
+    }
+    gttoc(product);
+
+    // sum out frontals, this is the factor on the separator
+    gttic(sum);
+    DiscreteTableFactor::shared_ptr sum = product.sum(frontalKeys);
+    gttoc(sum);
+
+    // Ordering keys for the conditional so that frontalKeys are really in front
+    Ordering orderedKeys;
+    orderedKeys.insert(orderedKeys.end(), frontalKeys.begin(), frontalKeys.end());
+    orderedKeys.insert(orderedKeys.end(), sum->keys().begin(), sum->keys().end());
+
+    // convert back to decision trees, to divide product/sum to get conditional
+    gttic(divide);
+    DecisionTreeFactor::shared_ptr separator =
+        boost::make_shared<DecisionTreeFactor>(sum->toDecisionTreeFactor());
+    DiscreteConditional::shared_ptr cond(new DiscreteConditional(
+        product.toDecisionTreeFactor(), *separator, orderedKeys));
+    gttoc(divide);
+
+    return std::make_pair(cond, separator);
+  }
+
   /* ************************************************************************* */
   std::pair<DiscreteConditional::shared_ptr, DecisionTreeFactor::shared_ptr>  //
   EliminateDiscrete(const DiscreteFactorGraph& factors, const Ordering& frontalKeys) {
 
+    // Small dense products are faster with tables
+    if (DiscreteTableFactor::UseTables(factors))
+      return EliminateDiscreteTables(factors, frontalKeys);
+
     // PRODUCT: multiply all factors
     gttic(product);
-    DecisionTreeFactor product;
-    BOOST_FOREACH(const DiscreteFactor::shared_ptr& factor, factors)
-      product = (*factor) * product;
+    DecisionTreeFactor product = factors.product();
     gttoc(product);
 
     // sum out frontals, this is the factor on the separator
@@ -129,6 +240,37 @@ namespace gtsam {
     return std::make_pair(cond, sum);
   }
 
+  /* ************************************************************************* */
+  std::pair<DiscreteConditional::shared_ptr, DecisionTreeFactor::shared_ptr>  //
+  EliminateDiscreteLogMax(const DiscreteFactorGraph& factors, const Ordering& frontalKeys) {
+
+    // PRODUCT: add all log factors
+    gttic(product);
+    typedef DecisionTreeFactor::ADT ADT;
+    DecisionTreeFactor product(DiscreteKeys(), ADT(ADT::Super(ADT::LogRing::one())));
+    BOOST_FOREACH(const DiscreteFactor::shared_ptr& factor, factors)
+      if (factor) product = factor->toDecisionTreeFactor().logProduct(product);
+    gttoc(product);
+
+    // maximize over frontals, this is the factor on the separator
+    gttic(max);
+    DecisionTreeFactor::shared_ptr max = product.max(frontalKeys);
+    gttoc(max);
+
+    // Ordering keys for the conditional so that frontalKeys are really in front
+    Ordering orderedKeys;
+    orderedKeys.insert(orderedKeys.end(), frontalKeys.begin(), frontalKeys.end());
+    orderedKeys.insert(orderedKeys.end(), max->keys().begin(), max->keys().end());
+
+    // subtract to get the conditional
+    gttic(divide);
+    DiscreteConditional::shared_ptr cond =
+        DiscreteConditional::FromLogJoint(product, *max, orderedKeys);
+    gttoc(divide);
+
+    return std::make_pair(cond, max);
+  }
+
 /* ************************************************************************* */
 } // namespace
 
@@ -41,6 +41,17 @@ class DiscreteJunctionTree;
 GTSAM_EXPORT std::pair<boost::shared_ptr<DiscreteConditional>, DecisionTreeFactor::shared_ptr>
 EliminateDiscrete(const DiscreteFactorGraph& factors, const Ordering& keys);
 
+/** Elimination function that multiplies and sums DiscreteTableFactors, used by
+ *  EliminateDiscrete when DiscreteTableFactor::UseTables says that is faster */
+GTSAM_EXPORT std::pair<boost::shared_ptr<DiscreteConditional>, DecisionTreeFactor::shared_ptr>
+EliminateDiscreteTables(const DiscreteFactorGraph& factors, const Ordering& keys);
+
+/** Max-product elimination function for factors holding log values, see DecisionTreeFactor::log:
+ *  adds the factors, maximizes over the keys for the separator, and returns the conditional
+ *  as log values, see DiscreteConditional::FromLogJoint.  Used by optimizeLog. */
+GTSAM_EXPORT std::pair<boost::shared_ptr<DiscreteConditional>, DecisionTreeFactor::shared_ptr>
+EliminateDiscreteLogMax(const DiscreteFactorGraph& factors, const Ordering& keys);
+
 /* ************************************************************************* */
 template<> struct EliminationTraits<DiscreteFactorGraph>
 {
@@ -122,7 +133,9 @@ public:
   /** Return the set of variables involved in the factors (set union) */
   KeySet keys() const;
 
-  /** return product of all factors as a single factor */
+  /** return product of all factors as a single factor.  The product is split across the values
+   *  of its highest key, the root of its decision tree, and with TBB the branches are
+   *  multiplied in parallel. */
   DecisionTreeFactor product() const;
 
   /** Evaluates the factor graph given values, returns the joint probability of the factor graph given specific instantiation of values*/
@@ -138,6 +151,12 @@ public:
    *  to calling graph.eliminateSequential()->optimize(). */
   DiscreteFactor::sharedValues optimize() const;
 
+  /** Find the most probable explanation by max-product elimination on log values, with
+   *  EliminateDiscreteLogMax, which does not underflow on long chains where optimize
+   *  would.  Factors are converted with DecisionTreeFactor::log, and must not have
+   *  negative values. */
+  DiscreteFactor::sharedValues optimizeLog() const;
+
 
 //  /** Permute the variables in the factors */
 //  GTSAM_EXPORT void permuteWithInverse(const Permutation& inversePermutation);
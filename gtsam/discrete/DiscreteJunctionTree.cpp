@@ -28,7 +28,8 @@ namespace gtsam {
 
   /* ************************************************************************* */
   DiscreteJunctionTree::DiscreteJunctionTree(
-    const DiscreteEliminationTree& eliminationTree) :
-  Base(eliminationTree) {}
+    const DiscreteEliminationTree& eliminationTree,
+    const RelaxedAmalgamation& amalgamation) :
+  Base(eliminationTree, amalgamation) {}
 
 }
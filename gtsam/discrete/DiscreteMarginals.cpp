@@ -0,0 +1,87 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file DiscreteMarginals.cpp
+ * @brief Marginals of all variables of a DiscreteBayesTree in one downward pass
+ * @date Oct 15, 2026
+ */
+
+#include <gtsam/discrete/DiscreteMarginals.h>
+#include <gtsam/base/treeTraversal-inst.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/make_shared.hpp>
+#include <algorithm>
+
+namespace gtsam {
+
+namespace {
+
+// Sum a factor over all its keys except the given ones
+DecisionTreeFactor::shared_ptr sumExcept(const DecisionTreeFactor& factor,
+    DiscreteFactor::const_iterator begin, DiscreteFactor::const_iterator end) {
+  Ordering others;
+  BOOST_FOREACH(Key key, factor.keys())
+    if (std::find(begin, end, key) == end)
+      others.push_back(key);
+  return factor.sum(others);
+}
+
+// Pre-order visitor that computes the joint of a clique from the joint of its parent, and the
+// marginals of its frontal variables.  marginals holds an entry for every variable, so that
+// parallel visits only write existing entries.
+struct MarginalVisitor {
+  FastMap<Key, DecisionTreeFactor::shared_ptr>* marginals;
+
+  MarginalVisitor(FastMap<Key, DecisionTreeFactor::shared_ptr>* marginals) :
+    marginals(marginals) {}
+
+  DecisionTreeFactor::shared_ptr operator()(const DiscreteBayesTree::sharedClique& clique,
+      const DecisionTreeFactor::shared_ptr& parentJoint) {
+    const DiscreteConditional& conditional = *clique->conditional();
+
+    // P(F,S) = P(F|S) P(S), with P(S) from the joint of the parent, which contains S
+    DecisionTreeFactor::shared_ptr joint;
+    if (conditional.nrParents() == 0 || !parentJoint)
+      joint = boost::make_shared<DecisionTreeFactor>(conditional);
+    else
+      joint = boost::make_shared<DecisionTreeFactor>(conditional
+          * *sumExcept(*parentJoint, conditional.beginParents(), conditional.endParents()));
+
+    for (DiscreteConditional::const_iterator frontal = conditional.beginFrontals();
+        frontal != conditional.endFrontals(); ++frontal)
+      marginals->find(*frontal)->second = sumExcept(*joint, frontal, frontal + 1);
+    return joint;
+  }
+};
+
+}
+
+/* ************************************************************************* */
+const FastMap<Key, DecisionTreeFactor::shared_ptr>& DiscreteMarginals::marginals() const {
+  if (marginals_.empty() && !bayesTree_->nodes().empty()) {
+    gttic(DiscreteMarginals_marginals);
+    // Insert all keys first, so the parallel traversal only writes existing entries
+    FastMap<Key, DecisionTreeFactor::shared_ptr> marginals;
+    BOOST_FOREACH(const DiscreteBayesTree::Nodes::value_type& node, bayesTree_->nodes())
+      marginals.insert(std::make_pair(node.first, DecisionTreeFactor::shared_ptr()));
+
+    DecisionTreeFactor::shared_ptr rootData;
+    MarginalVisitor visitorPre(&marginals);
+    treeTraversal::no_op visitorPost;
+    treeTraversal::DepthFirstForestParallel(*bayesTree_, rootData, visitorPre, visitorPost);
+    marginals_.swap(marginals);
+  }
+  return marginals_;
+}
+
+} /* namespace gtsam */
@@ -28,12 +28,19 @@ namespace gtsam {
 
   /**
    * A class for computing marginals of variables in a DiscreteFactorGraph
+   *
+   * The marginals of all variables are computed together, on the first query, in one downward
+   * pass over the Bayes tree, and cached: the joint of each clique is its conditional times the
+   * marginal of its separator, summed from the joint of its parent, so every clique is visited
+   * once instead of computing a shortcut for every query.  With TBB, subtrees are processed in
+   * parallel.
    */
-  class DiscreteMarginals {
+  class GTSAM_EXPORT DiscreteMarginals {
 
   protected:
 
     DiscreteBayesTree::shared_ptr bayesTree_;
+    mutable FastMap<Key, DecisionTreeFactor::shared_ptr> marginals_; ///< empty until the first query
 
   public:
 
@@ -44,12 +51,19 @@ namespace gtsam {
     bayesTree_ = graph.eliminateMultifrontal();
   }
 
+  /** Construct a marginals class from the Bayes tree of the joint density, e.g., one already
+   * computed for MPE, without eliminating again.
+   */
+  DiscreteMarginals(const DiscreteBayesTree::shared_ptr& bayesTree) :
+    bayesTree_(bayesTree) {
+  }
+
+  /** The marginals of all variables, computed in one pass over the Bayes tree on the first call */
+  const FastMap<Key, DecisionTreeFactor::shared_ptr>& marginals() const;
+
   /** Compute the marginal of a single variable */
   DiscreteFactor::shared_ptr operator()(Key variable) const {
-    // Compute marginal
-    DiscreteFactor::shared_ptr marginalFactor;
-    marginalFactor = bayesTree_->marginalFactor(variable, &EliminateDiscrete);
-    return marginalFactor;
+    return marginals().at(variable);
   }
 
   /** Compute the marginal of a single variable
@@ -57,16 +71,14 @@ namespace gtsam {
    *   @return Vector of marginal probabilities
    */
   Vector marginalProbabilities(const DiscreteKey& key) const {
-    // Compute marginal
-    DiscreteFactor::shared_ptr marginalFactor;
-    marginalFactor = bayesTree_->marginalFactor(key.first, &EliminateDiscrete);
+    const DecisionTreeFactor& marginalFactor = *marginals().at(key.first);
 
     //Create result
     Vector vResult(key.second);
     for (size_t state = 0; state < key.second ; ++ state) {
       DiscreteFactor::Values values;
       values[key.first] = state;
-      vResult(state) = (*marginalFactor)(values);
+      vResult(state) = marginalFactor(values);
     }
     return vResult;
   }
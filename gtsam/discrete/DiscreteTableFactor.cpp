@@ -0,0 +1,402 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file DiscreteTableFactor.cpp
+ *  @brief A discrete factor stored as a dense table
+ *  @date Oct 15, 2026
+ */
+
+#include <gtsam/discrete/DiscreteTableFactor.h>
+#include <gtsam/discrete/DiscreteFactorGraph.h>
+
+#include <boost/foreach.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+  namespace {
+
+    struct Multiply {
+      double operator()(double a, double b) const { return a * b; }
+    };
+
+    // Same as Potentials::safe_div: zero probability if the product or sum is zero
+    struct SafeDivide {
+      double operator()(double a, double b) const { return (a == 0 || b == 0) ? 0 : (a / b); }
+    };
+
+    struct Add {
+      static double identity() { return 0.0; }
+      double operator()(double a, double b) const { return a + b; }
+    };
+
+    struct Max {
+      static double identity() { return -numeric_limits<double>::infinity(); }
+      double operator()(double a, double b) const { return std::max(a, b); }
+    };
+
+    // Strides of f's keys at the positions of keys, zero where f does not depend on the key
+    vector<size_t> stridesIn(const DiscreteTableFactor& f, const KeyVector& keys,
+        const vector<size_t>& cardinalities) {
+      vector<size_t> strides(keys.size(), 0);
+      size_t stride = 1;
+      for (int i = (int) f.size() - 1; i >= 0; i--) {
+        size_t k = find(keys.begin(), keys.end(), f.keys()[i]) - keys.begin();
+        if (k == keys.size())
+          throw invalid_argument("DiscreteTableFactor: key not in the result");
+        strides[k] = stride;
+        stride *= cardinalities[k];
+      }
+      return strides;
+    }
+
+    // out = a op b over the table with the given cardinalities, where sa and sb are the strides
+    // of a and b per key.  The last key, which varies fastest, is done in an inner loop.
+    template<class OP>
+    void applyTables(const vector<size_t>& cardinalities, size_t size,
+        const vector<size_t>& sa, const double* a, const vector<size_t>& sb, const double* b,
+        double* out, OP op) {
+      const int n = cardinalities.size();
+      if (n == 0) {
+        out[0] = op(a[0], b[0]);
+        return;
+      }
+      const size_t run = cardinalities[n - 1], la = sa[n - 1], lb = sb[n - 1];
+      vector<size_t> index(n, 0);
+      size_t ia = 0, ib = 0;
+      for (double* o = out; o != out + size; o += run) {
+        for (size_t j = 0; j < run; j++)
+          o[j] = op(a[ia + j * la], b[ib + j * lb]);
+        for (int k = n - 2; k >= 0; k--) {
+          ia += sa[k];
+          ib += sb[k];
+          if (++index[k] < cardinalities[k]) break;
+          ia -= cardinalities[k] * sa[k];
+          ib -= cardinalities[k] * sb[k];
+          index[k] = 0;
+        }
+      }
+    }
+  }
+
+  /* ************************************************************************* */
+  DiscreteTableFactor::DiscreteTableFactor() {
+    initialize();
+    table_[0] = 1.0;
+  }
+
+  /* ************************************************************************* */
+  DiscreteTableFactor::DiscreteTableFactor(const DiscreteKeys& keys,
+      const vector<double>& table) :
+      Base(keys.indices()) {
+    BOOST_FOREACH(const DiscreteKey& key, keys)
+      cardinalities_.push_back(key.second);
+    initialize();
+    if (table.size() != table_.size())
+      throw invalid_argument(
+          (boost::format("DiscreteTableFactor: expected %d values, got %d") % table_.size()
+              % table.size()).str());
+    table_ = table;
+  }
+
+  /* ************************************************************************* */
+  namespace {
+    typedef DecisionTreeFactor::ADT ADT;
+
+    // Copy the tree below node into the table, where fixed marks the keys that are set by the
+    // choices above it, and offset is their contribution to the table index
+    void fillTable(const ADT::NodePtr& node, size_t offset, const KeyVector& keys,
+        const vector<size_t>& cardinalities, const vector<size_t>& strides,
+        vector<bool>& fixed, vector<double>& table) {
+      if (!node->isLeaf()) {
+        const ADT::Choice& choice = static_cast<const ADT::Choice&>(*node);
+        size_t k = find(keys.begin(), keys.end(), choice.label()) - keys.begin();
+        fixed[k] = true;
+        for (size_t i = 0; i < choice.nrChoices(); i++)
+          fillTable(choice.branches()[i], offset + i * strides[k], keys, cardinalities,
+              strides, fixed, table);
+        fixed[k] = false;
+        return;
+      }
+
+      // A leaf sets all the values for the keys not fixed by its parents
+      const double value = static_cast<const ADT::Leaf&>(*node).constant();
+      vector<size_t> free;
+      for (size_t k = 0; k < keys.size(); k++)
+        if (!fixed[k]) free.push_back(k);
+      vector<size_t> index(free.size(), 0);
+      while (true) {
+        table[offset] = value;
+        int f = (int) free.size() - 1;
+        for (; f >= 0; f--) {
+          const size_t k = free[f];
+          offset += strides[k];
+          if (++index[f] < cardinalities[k]) break;
+          offset -= cardinalities[k] * strides[k];
+          index[f] = 0;
+        }
+        if (f < 0) break;
+      }
+    }
+  }
+
+  /* ************************************************************************* */
+  DiscreteTableFactor::DiscreteTableFactor(const DecisionTreeFactor& f) :
+      Base(f.keys()) {
+    BOOST_FOREACH(Key j, keys_)
+      cardinalities_.push_back(f.cardinality(j));
+    initialize();
+    vector<bool> fixed(keys_.size(), false);
+    fillTable(f.root_, 0, keys_, cardinalities_, strides_, fixed, table_);
+  }
+
+  /* ************************************************************************* */
+  void DiscreteTableFactor::initialize() {
+    strides_.resize(keys_.size());
+    size_t size = 1;
+    for (int k = (int) keys_.size() - 1; k >= 0; k--) {
+      strides_[k] = size;
+      size *= cardinalities_[k];
+    }
+    table_.resize(size);
+  }
+
+  /* ************************************************************************* */
+  bool DiscreteTableFactor::equals(const DiscreteFactor& other, double tol) const {
+    const DiscreteTableFactor* f = dynamic_cast<const DiscreteTableFactor*>(&other);
+    if (!f || keys_ != f->keys_ || cardinalities_ != f->cardinalities_)
+      return false;
+    for (size_t i = 0; i < table_.size(); i++)
+      if (fabs(table_[i] - f->table_[i]) > tol)
+        return false;
+    return true;
+  }
+
+  /* ************************************************************************* */
+  void DiscreteTableFactor::print(const string& s, const KeyFormatter& formatter) const {
+    cout << s;
+    Base::print("Keys:", formatter);
+    cout << " Table:";
+    BOOST_FOREACH(double value, table_)
+      cout << " " << value;
+    cout << endl;
+  }
+
+  /* ************************************************************************* */
+  double DiscreteTableFactor::operator()(const Values& values) const {
+    size_t index = 0;
+    for (size_t k = 0; k < keys_.size(); k++)
+      index += values.at(keys_[k]) * strides_[k];
+    return table_[index];
+  }
+
+  /* ************************************************************************* */
+  DiscreteTableFactor DiscreteTableFactor::operator*(const DiscreteTableFactor& f) const {
+    // The keys of the product, in order, as in DecisionTreeFactor::apply
+    map<Key, size_t> cs;
+    for (size_t k = 0; k < size(); k++)
+      cs[keys_[k]] = cardinalities_[k];
+    for (size_t k = 0; k < f.size(); k++)
+      cs[f.keys_[k]] = f.cardinalities_[k];
+    DiscreteTableFactor result;
+    result.keys_.clear();
+    BOOST_FOREACH(const DiscreteKey& key, cs) {
+      result.keys_.push_back(key.first);
+      result.cardinalities_.push_back(key.second);
+    }
+    result.initialize();
+
+    applyTables(result.cardinalities_, result.table_.size(),
+        stridesIn(*this, result.keys_, result.cardinalities_), &table_[0],
+        stridesIn(f, result.keys_, result.cardinalities_), &f.table_[0], &result.table_[0],
+        Multiply());
+    return result;
+  }
+
+  /* ************************************************************************* */
+  DiscreteTableFactor DiscreteTableFactor::operator/(const DiscreteTableFactor& f) const {
+    DiscreteTableFactor result(*this);
+    applyTables(cardinalities_, table_.size(), strides_, &table_[0],
+        stridesIn(f, keys_, cardinalities_), &f.table_[0], &result.table_[0], SafeDivide());
+    return result;
+  }
+
+  /* ************************************************************************* */
+  DecisionTreeFactor DiscreteTableFactor::toDecisionTreeFactor() const {
+    typedef DecisionTreeFactor::ADT ADT;
+    const int n = keys_.size();
+    if (n == 0)
+      return DecisionTreeFactor(DiscreteKeys(), ADT(table_[0]));
+
+    // DecisionTree::create is fastest when the labels are given highest to lowest, so
+    // transpose the table to that order
+    vector<pair<Key, size_t> > sorted;
+    for (int k = 0; k < n; k++)
+      sorted.push_back(make_pair(keys_[k], k));
+    sort(sorted.rbegin(), sorted.rend());
+    vector<size_t> order;
+    DiscreteKeys labels;
+    for (int o = 0; o < n; o++) {
+      order.push_back(sorted[o].second);
+      labels.push_back(DiscreteKey(sorted[o].first, cardinalities_[sorted[o].second]));
+    }
+    vector<double> values(table_.size());
+    vector<size_t> index(n, 0);
+    size_t offset = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+      values[i] = table_[offset];
+      for (int o = n - 1; o >= 0; o--) {
+        const size_t k = order[o];
+        offset += strides_[k];
+        if (++index[o] < cardinalities_[k]) break;
+        offset -= cardinalities_[k] * strides_[k];
+        index[o] = 0;
+      }
+    }
+    return DecisionTreeFactor(discreteKeys(), ADT(labels, values));
+  }
+
+  /* ************************************************************************* */
+  template<class KEYS, class OP>
+  DiscreteTableFactor::shared_ptr DiscreteTableFactor::combine(const KEYS& frontals,
+      OP op) const {
+    // The separator keys, and the stride of each of our keys in the result
+    const int n = keys_.size();
+    shared_ptr result = boost::make_shared<DiscreteTableFactor>();
+    result->keys_.clear();
+    vector<size_t> so(n, 0);
+    size_t stride = 1;
+    for (int k = n - 1; k >= 0; k--) {
+      if (std::find(frontals.begin(), frontals.end(), keys_[k]) != frontals.end()) continue;
+      result->keys_.insert(result->keys_.begin(), keys_[k]);
+      result->cardinalities_.insert(result->cardinalities_.begin(), cardinalities_[k]);
+      so[k] = stride;
+      stride *= cardinalities_[k];
+    }
+    if (n - result->size() != frontals.size())
+      throw invalid_argument(
+          (boost::format(
+              "DiscreteTableFactor::combine: invalid frontal keys, nr.frontals=%d, nr.keys=%d")
+              % frontals.size() % n).str());
+    result->initialize();
+    if (n == 0) {
+      result->table_ = table_;
+      return result;
+    }
+
+    // Run over our table, where the last key, which varies fastest, is done in an inner loop
+    std::fill(result->table_.begin(), result->table_.end(), OP::identity());
+    const size_t run = cardinalities_[n - 1], lo = so[n - 1];
+    vector<size_t> index(n, 0);
+    size_t io = 0;
+    for (const double* in = &table_[0]; in != &table_[0] + table_.size(); in += run) {
+      double* out = &result->table_[io];
+      if (lo == 0) {
+        double value = *out;
+        for (size_t j = 0; j < run; j++)
+          value = op(value, in[j]);
+        *out = value;
+      } else {
+        for (size_t j = 0; j < run; j++)
+          out[j * lo] = op(out[j * lo], in[j]);
+      }
+      for (int k = n - 2; k >= 0; k--) {
+        io += so[k];
+        if (++index[k] < cardinalities_[k]) break;
+        io -= cardinalities_[k] * so[k];
+        index[k] = 0;
+      }
+    }
+    return result;
+  }
+
+  /* ************************************************************************* */
+  DiscreteTableFactor::shared_ptr DiscreteTableFactor::sum(size_t nrFrontals) const {
+    if (nrFrontals > size()) throw invalid_argument(
+        (boost::format(
+            "DiscreteTableFactor::sum: invalid number of frontal keys %d, nr.keys=%d")
+            % nrFrontals % size()).str());
+    return combine(KeyVector(keys_.begin(), keys_.begin() + nrFrontals), Add());
+  }
+
+  /* ************************************************************************* */
+  DiscreteTableFactor::shared_ptr DiscreteTableFactor::sum(const Ordering& keys) const {
+    return combine(keys, Add());
+  }
+
+  /* ************************************************************************* */
+  DiscreteTableFactor::shared_ptr DiscreteTableFactor::max(size_t nrFrontals) const {
+    if (nrFrontals > size()) throw invalid_argument(
+        (boost::format(
+            "DiscreteTableFactor::max: invalid number of frontal keys %d, nr.keys=%d")
+            % nrFrontals % size()).str());
+    return combine(KeyVector(keys_.begin(), keys_.begin() + nrFrontals), Max());
+  }
+
+  /* ************************************************************************* */
+  DiscreteTableFactor::shared_ptr DiscreteTableFactor::max(const Ordering& keys) const {
+    return combine(keys, Max());
+  }
+
+  /* ************************************************************************* */
+  DiscreteKeys DiscreteTableFactor::discreteKeys() const {
+    DiscreteKeys result;
+    for (size_t k = 0; k < keys_.size(); k++)
+      result.push_back(DiscreteKey(keys_[k], cardinalities_[k]));
+    return result;
+  }
+
+  /* ************************************************************************* */
+  size_t DiscreteTableFactor::cardinality(Key j) const {
+    const_iterator it = find(j);
+    if (it == end())
+      throw out_of_range("DiscreteTableFactor::cardinality: key not in factor");
+    return cardinalities_[it - begin()];
+  }
+
+  /* ************************************************************************* */
+  bool DiscreteTableFactor::UseTables(const DiscreteFactorGraph& factors) {
+    map<Key, size_t> cs;
+    size_t nrEntries = 0, nrLeaves = 0;
+    BOOST_FOREACH(const DiscreteFactor::shared_ptr& factor, factors) {
+      if (!factor) continue;
+      if (const DecisionTreeFactor* f = dynamic_cast<const DecisionTreeFactor*>(factor.get())) {
+        size_t entries = 1;
+        BOOST_FOREACH(Key j, f->keys())
+          entries *= cs[j] = f->cardinality(j);
+        if (entries > MaxTableSize) return false;
+        nrEntries += entries;
+        nrLeaves += f->nrLeaves();
+      } else if (const DiscreteTableFactor* t =
+          dynamic_cast<const DiscreteTableFactor*>(factor.get())) {
+        for (size_t k = 0; k < t->size(); k++)
+          cs[t->keys_[k]] = t->cardinalities_[k];
+        nrEntries += t->table_.size();
+        nrLeaves += t->table_.size();
+      } else {
+        return false; // e.g. a constraint, which only knows how to multiply trees
+      }
+    }
+    size_t size = 1;
+    BOOST_FOREACH(const DiscreteKey& key, cs)
+      if ((size *= key.second) > MaxTableSize) return false;
+    return 4 * nrLeaves >= nrEntries;
+  }
+
+} // namespace gtsam
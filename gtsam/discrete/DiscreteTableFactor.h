@@ -0,0 +1,151 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file DiscreteTableFactor.h
+ *  @brief A discrete factor stored as a dense table
+ *  @date Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/discrete/DecisionTreeFactor.h>
+#include <gtsam/inference/Ordering.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+namespace gtsam {
+
+  class DiscreteFactorGraph;
+
+  /**
+   * A discrete factor stored as a dense table, in row-major order over its keys (the last key
+   * varies fastest), the same layout as the string and vector constructors of
+   * DecisionTreeFactor.  Products, sums and maxima over variables are plain loops over the
+   * table with precomputed strides, which for small scopes with few repeated values is much
+   * faster than applying the operation to decision trees.  EliminateDiscrete switches to
+   * tables automatically, see UseTables.
+   */
+  class GTSAM_EXPORT DiscreteTableFactor: public DiscreteFactor {
+
+  public:
+
+    // typedefs needed to play nice with gtsam
+    typedef DiscreteTableFactor This;
+    typedef DiscreteFactor Base; ///< Typedef to base class
+    typedef boost::shared_ptr<DiscreteTableFactor> shared_ptr;
+
+    /// Largest product table, in entries, that EliminateDiscrete computes densely
+    static const size_t MaxTableSize = 1 << 16;
+
+  protected:
+
+    std::vector<size_t> cardinalities_; ///< Cardinality of each key, in key order
+    std::vector<size_t> strides_; ///< Distance in the table between consecutive values of a key
+    std::vector<double> table_; ///< Values, row-major over the keys
+
+  public:
+
+    /// @name Standard Constructors
+    /// @{
+
+    /** Default constructor creates the constant 1 */
+    DiscreteTableFactor();
+
+    /** Constructor from keys and a table in row-major order over them */
+    DiscreteTableFactor(const DiscreteKeys& keys, const std::vector<double>& table);
+
+    /** Construct from a DecisionTreeFactor, with the same keys */
+    explicit DiscreteTableFactor(const DecisionTreeFactor& f);
+
+    /// @}
+    /// @name Testable
+    /// @{
+
+    /// equality
+    bool equals(const DiscreteFactor& other, double tol = 1e-9) const;
+
+    // print
+    virtual void print(const std::string& s = "DiscreteTableFactor:\n",
+        const KeyFormatter& formatter = DefaultKeyFormatter) const;
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /// Value is a look up in the table
+    virtual double operator()(const Values& values) const;
+
+    /// Multiply in a DecisionTreeFactor
+    virtual DecisionTreeFactor operator*(const DecisionTreeFactor& f) const {
+      return toDecisionTreeFactor() * f;
+    }
+
+    /// Multiply two tables
+    DiscreteTableFactor operator*(const DiscreteTableFactor& f) const;
+
+    /// Divide by table f (safely), whose keys must be a subset of ours
+    DiscreteTableFactor operator/(const DiscreteTableFactor& f) const;
+
+    /// Convert into a decision tree
+    virtual DecisionTreeFactor toDecisionTreeFactor() const;
+
+    /// Create new factor by summing out the first nrFrontals keys
+    shared_ptr sum(size_t nrFrontals) const;
+
+    /// Create new factor by summing out the given keys
+    shared_ptr sum(const Ordering& keys) const;
+
+    /// Create new factor by maximizing over the first nrFrontals keys
+    shared_ptr max(size_t nrFrontals) const;
+
+    /// Create new factor by maximizing over the given keys
+    shared_ptr max(const Ordering& keys) const;
+
+    /// Keys with their cardinalities
+    DiscreteKeys discreteKeys() const;
+
+    /// Cardinality of key j
+    size_t cardinality(Key j) const;
+
+    /// The values, row-major over the keys
+    const std::vector<double>& table() const { return table_; }
+
+    /// @}
+    /// @name Advanced Interface
+    /// @{
+
+    /**
+     * Whether eliminating the given factors is faster with tables than with decision trees:
+     * true if the product has at most MaxTableSize entries, and the decision trees of the
+     * factors are dense, i.e., have at least a quarter as many leaves as table entries.
+     */
+    static bool UseTables(const DiscreteFactorGraph& factors);
+
+    /// @}
+
+  private:
+
+    /// Compute strides from cardinalities and allocate the table
+    void initialize();
+
+    /// Combine the values that agree on the keys not in frontals with op, see the .cpp
+    template<class KEYS, class OP>
+    shared_ptr combine(const KEYS& frontals, OP op) const;
+  };
+  // DiscreteTableFactor
+
+// traits
+template<> struct traits<DiscreteTableFactor> : public Testable<DiscreteTableFactor> {};
+
+}// namespace gtsam
@@ -177,7 +177,7 @@ TEST(ADT, joint)
   dot(joint, "Asia-ASTLBEX");
   joint = apply(joint, pD, &mul);
   dot(joint, "Asia-ASTLBEXD");
-  EXPECT_LONGS_EQUAL(346, (long)muls);
+  EXPECT_LONGS_EQUAL(308, (long)muls); // shared subtrees are only multiplied once
   printCounts("Asia joint");
 
   ADT pASTL = pA;
@@ -228,7 +228,7 @@ TEST(ADT, inference)
   dot(joint, "Joint-Product-ASTLBEX");
   joint = apply(joint, pD, &mul);
   dot(joint, "Joint-Product-ASTLBEXD");
-  EXPECT_LONGS_EQUAL(370, (long)muls); // different ordering
+  EXPECT_LONGS_EQUAL(308, (long)muls); // different ordering
   printCounts("Asia product");
 
   ADT marginal = joint;
@@ -240,7 +240,7 @@ TEST(ADT, inference)
   dot(marginal, "Joint-Sum-ADBLE");
   marginal = marginal.combine(E, &add_);
   dot(marginal, "Joint-Sum-ADBL");
-  EXPECT_LONGS_EQUAL(161, (long)adds);
+  EXPECT_LONGS_EQUAL(150, (long)adds);
   printCounts("Asia sum");
 }
 
@@ -269,7 +269,7 @@ TEST(ADT, factor_graph)
   fg = apply(fg, pX, &mul);
   fg = apply(fg, pD, &mul);
   dot(fg, "FactorGraph");
-  EXPECT_LONGS_EQUAL(158, (long)muls);
+  EXPECT_LONGS_EQUAL(130, (long)muls);
   printCounts("Asia FG");
 
   fg = fg.combine(X, &add_);
@@ -242,6 +242,39 @@ TEST(DT, Compose)
   DOT(f5);
 }
 
+/* ******************************************************************************** */
+// test that apply shares equal subtrees
+int mod4(const int& x) { return x % 4; }
+
+TEST(DT, hashConsing)
+{
+  // Create labels
+  string A("A"), B("B"), C("C");
+  vector<DT::LabelC> keys;
+  keys += DT::LabelC(A,2), DT::LabelC(B,2), DT::LabelC(C,2);
+  DT f(keys, "0 4 2 6 1 5 3 7");
+
+  // Both branches on C become the same AB tree, which is created only once
+  DT g = f.apply(&mod4);
+  vector<DT::LabelC> ab(keys.begin(), keys.begin() + 2);
+  DT expected(C, DT(ab, "0 2 1 3"), DT(ab, "0 2 1 3"));
+  EXPECT(assert_equal(expected, g, 1e-9));
+  const DT::Choice* root = dynamic_cast<const DT::Choice*>(g.root_.get());
+  CHECK(root);
+  EXPECT(root->branches()[0] == root->branches()[1]);
+
+  // Same for a binary apply, where equal leaves are shared as well
+  DT h = apply(f, DT(C, 4, 0), &Ring::add);
+  DT expected2(C, DT(ab, "4 6 5 7"), DT(ab, "4 6 5 7"));
+  EXPECT(assert_equal(expected2, h, 1e-9));
+  root = dynamic_cast<const DT::Choice*>(h.root_.get());
+  CHECK(root);
+  EXPECT(root->branches()[0] == root->branches()[1]);
+
+  // Summing out C adds the two shared subtrees
+  EXPECT(assert_equal(DT(ab, "8 12 10 14"), h.combine(C, 2, &Ring::add), 1e-9));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
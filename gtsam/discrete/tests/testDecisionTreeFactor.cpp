@@ -98,6 +98,31 @@ TEST( DecisionTreeFactor, sum_max)
 
 }
 
+/* ************************************************************************* */
+TEST( DecisionTreeFactor, logValues)
+{
+  DiscreteKey v0(0,3), v1(1,2);
+  DecisionTreeFactor f1(v0 & v1, "1 2  3 4  5 6");
+  DecisionTreeFactor f2(v1, "0 2");
+
+  // Arithmetic on log values agrees with arithmetic on values
+  DecisionTreeFactor l1 = f1.log(), l2 = f2.log();
+  DiscreteFactor::Values values;
+  values[0] = 2;
+  values[1] = 1;
+  EXPECT_DOUBLES_EQUAL(std::log(6.0), l1(values), 1e-9);
+  EXPECT(assert_equal(f1, l1.exp(), 1e-9));
+  EXPECT(assert_equal(f1 * f2, l1.logProduct(l2).exp(), 1e-9));
+  EXPECT(assert_equal(*f1.sum(1), l1.logSum(1)->exp(), 1e-9));
+  EXPECT(assert_equal(*f1.max(1), l1.max(1)->exp(), 1e-9));
+  EXPECT(assert_equal(*(f1 * f2).sum(1), l1.logProduct(l2).logSum(1)->exp(), 1e-9));
+
+  // Values far below the smallest double
+  DecisionTreeFactor tiny(v1, "-2000 -2001");
+  EXPECT_DOUBLES_EQUAL(-2000 + std::log1p(std::exp(-1.0)), (*tiny.logSum(1))(
+      DiscreteFactor::Values()), 1e-9);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -67,6 +67,28 @@ TEST_UNSAFE( DiscreteFactorGraph, debugScheduler) {
 //  DiscreteBayesNet::shared_ptr bayesNet = solver.eliminate();
 }
 
+/* ************************************************************************* */
+// The product is split on its highest key with TBB, and must not depend on that
+TEST( DiscreteFactorGraph, product) {
+  DiscreteKey A(0,2), B(1,3), C(2,2), D(3,4);
+
+  DiscreteFactorGraph graph;
+  graph.add(A & C, "1 2 3 4");
+  graph.add(B & D, "1 2 3 4 5 6 7 8 9 10 11 12");
+  graph.add(C & D, "1 1 2 2 3 3 4 4");
+  graph.add(A, "5 7");
+
+  DecisionTreeFactor expected;
+  BOOST_FOREACH(const DiscreteFactor::shared_ptr& factor, graph)
+    expected = (*factor) * expected;
+  EXPECT(assert_equal(expected, graph.product()));
+
+  // Values are the products of the factor values
+  DiscreteFactor::Values values;
+  values[0] = 1; values[1] = 2; values[2] = 0; values[3] = 3;
+  EXPECT_DOUBLES_EQUAL(3 * 12 * 2 * 7, graph.product()(values), 1e-9);
+}
+
 /* ************************************************************************* */
 /// Test the () operator of DiscreteFactorGraph
 TEST_UNSAFE( DiscreteFactorGraph, DiscreteFactorGraphEvaluationTest) {
@@ -192,6 +214,31 @@ TEST( DiscreteFactorGraph, testMPE)
   EXPECT(assert_equal(expectedMPE, *actualMPE));
 }
 
+/* ************************************************************************* */
+TEST( DiscreteFactorGraph, optimizeLog)
+{
+  // A chain long enough for the products of its factors to underflow
+  const size_t n = 500;
+  DiscreteFactorGraph graph;
+  DiscreteFactor::Values expected;
+  for (size_t i = 0; i < n; i++) {
+    DiscreteKey x(i, 2);
+    graph.add(x, i % 3 ? ".01 .002" : ".001 .01");
+    if (i > 0) graph.add(DiscreteKey(i - 1, 2), x, ".02 .01 .01 .02");
+    expected[i] = i % 3 ? 0 : 1;
+  }
+  EXPECT(assert_equal(expected, *graph.optimizeLog()));
+
+  // The graph in testMPE
+  DiscreteKey C(0,2), A(1,2), B(2,2);
+  DiscreteFactorGraph small;
+  small.add(C & A, "0.2 0.8 0.3 0.7");
+  small.add(C & B, "0.1 0.9 0.4 0.6");
+  DiscreteFactor::Values expectedMPE;
+  insert(expectedMPE)(0, 0)(1, 1)(2, 1);
+  EXPECT(assert_equal(expectedMPE, *small.optimizeLog()));
+}
+
 /* ************************************************************************* */
 TEST( DiscreteFactorGraph, testMPE_Darwiche09book_p244)
 {
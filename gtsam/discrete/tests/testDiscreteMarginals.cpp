@@ -197,6 +197,42 @@ TEST_UNSAFE( DiscreteMarginals, truss2 ) {
   }
 }
 
+/* ************************************************************************* */
+// All marginals in one pass agree with the marginals from shortcuts
+TEST_UNSAFE( DiscreteMarginals, allMarginals ) {
+
+  const int nrNodes = 12;
+  vector<DiscreteKey> key;
+  for (int i = 0; i < nrNodes; i++)
+    key.push_back(DiscreteKey(i, 2 + i % 3));
+
+  // a loopy graph, so that cliques have more than one frontal and separator variable
+  DiscreteFactorGraph graph;
+  graph.add(key[0], key[0].second == 2 ? "1 3" : "1 2 3");
+  for (int i = 1; i < nrNodes; i++) {
+    vector<double> table;
+    for (size_t k = 0; k < key[i - 1].second * key[i].second; k++)
+      table.push_back(1.0 + (3 * k + i) % 5);
+    graph.add(key[i - 1] & key[i], table);
+    if (i >= 3) {
+      vector<double> loop;
+      for (size_t k = 0; k < key[i - 3].second * key[i].second; k++)
+        loop.push_back(1.0 + (k + 2 * i) % 4);
+      graph.add(key[i - 3] & key[i], loop);
+    }
+  }
+
+  DiscreteBayesTree::shared_ptr bayesTree = graph.eliminateMultifrontal();
+  DiscreteMarginals marginals(bayesTree);
+  EXPECT_LONGS_EQUAL(nrNodes, marginals.marginals().size());
+  for (int i = 0; i < nrNodes; i++) {
+    DecisionTreeFactor expected(*bayesTree->marginalFactor(i, &EliminateDiscrete));
+    DiscreteFactor::shared_ptr actual = marginals(i);
+    EXPECT(assert_equal(expected, *boost::dynamic_pointer_cast<DecisionTreeFactor>(actual), 1e-9));
+    EXPECT_DOUBLES_EQUAL(1.0, marginals.marginalProbabilities(key[i]).sum(), 1e-9);
+  }
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -0,0 +1,142 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/*
+ * testDiscreteTableFactor.cpp
+ *
+ *  @date Oct 15, 2026
+ */
+
+#include <gtsam/discrete/DiscreteTableFactor.h>
+#include <gtsam/discrete/DiscreteFactorGraph.h>
+#include <gtsam/discrete/DiscreteConditional.h>
+#include <gtsam/base/Testable.h>
+#include <CppUnitLite/TestHarness.h>
+#include <boost/assign/std/vector.hpp>
+using namespace boost::assign;
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST( DiscreteTableFactor, constructors)
+{
+  DiscreteKey X(0,2), Y(1,3), Z(2,2);
+
+  vector<double> table;
+  table += 2, 5, 3, 6, 4, 7, 25, 55, 35, 65, 45, 75;
+  DiscreteTableFactor f(X & Y & Z, table);
+  DecisionTreeFactor expected(X & Y & Z, "2 5 3 6 4 7 25 55 35 65 45 75");
+  EXPECT_LONGS_EQUAL(3, f.size());
+
+  DiscreteFactor::Values values;
+  values[0] = 1; // x
+  values[1] = 2; // y
+  values[2] = 1; // z
+  EXPECT_DOUBLES_EQUAL(75, f(values), 1e-9);
+
+  // Conversions both ways
+  EXPECT(assert_equal(expected, f.toDecisionTreeFactor()));
+  EXPECT(assert_equal(f, DiscreteTableFactor(expected)));
+
+  // Also from a pruned tree
+  DecisionTreeFactor pruned(X & Y, "1 1 1 2 2 2");
+  vector<double> prunedTable;
+  prunedTable += 1, 1, 1, 2, 2, 2;
+  EXPECT(assert_equal(DiscreteTableFactor(X & Y, prunedTable), DiscreteTableFactor(pruned)));
+}
+
+/* ************************************************************************* */
+TEST( DiscreteTableFactor, multiplication)
+{
+  DiscreteKey v0(0,2), v1(1,3), v2(2,2);
+
+  DecisionTreeFactor f1(v2 & v0, "1 2 3 4");
+  DecisionTreeFactor f2(v1 & v2, "5 6 7 8 9 10");
+  DiscreteTableFactor actual = DiscreteTableFactor(f1) * DiscreteTableFactor(f2);
+  EXPECT(assert_equal(DiscreteTableFactor(f1 * f2), actual));
+  EXPECT(assert_equal(f1 * f2, actual.toDecisionTreeFactor()));
+
+  // Division by a factor on a subset of the keys
+  DecisionTreeFactor::shared_ptr s = (f1 * f2).sum(1);
+  EXPECT(assert_equal((f1 * f2) / *s,
+      (actual / *DiscreteTableFactor(*s).sum(0)).toDecisionTreeFactor()));
+}
+
+/* ************************************************************************* */
+TEST( DiscreteTableFactor, sum_max)
+{
+  DiscreteKey v0(0,3), v1(1,2), v2(2,2);
+  DecisionTreeFactor f(v0 & v1 & v2, "1 2 3 4 5 6 7 8 9 10 11 12");
+  DiscreteTableFactor t(f);
+
+  EXPECT(assert_equal(*f.sum(1), t.sum(1)->toDecisionTreeFactor()));
+  EXPECT(assert_equal(*f.sum(2), t.sum(2)->toDecisionTreeFactor()));
+  EXPECT(assert_equal(*f.max(1), t.max(1)->toDecisionTreeFactor()));
+
+  // Summing out keys that are not in front, including the fastest varying one
+  Ordering keys;
+  keys += Key(2), Key(0);
+  EXPECT(assert_equal(*f.sum(keys), t.sum(keys)->toDecisionTreeFactor()));
+  Ordering last;
+  last += Key(2);
+  EXPECT(assert_equal(*f.sum(last), t.sum(last)->toDecisionTreeFactor()));
+  EXPECT(assert_equal(*f.combine(last, DecisionTreeFactor::ADT::Ring::max),
+      t.max(last)->toDecisionTreeFactor()));
+}
+
+/* ************************************************************************* */
+TEST( DiscreteTableFactor, eliminate)
+{
+  // An HMM-like chain, as in examples/UGM_chain.cpp
+  DiscreteKey x0(0,3), x1(1,3), x2(2,3);
+  DiscreteFactorGraph graph;
+  graph.add(x0, ".3 .6 .1");
+  graph.add(x0 & x1, ".08 .9 .02   .03 .95 .02   .06 .06 .88");
+  graph.add(x1 & x2, ".08 .9 .02   .03 .95 .02   .06 .06 .88");
+  EXPECT(DiscreteTableFactor::UseTables(graph));
+
+  Ordering frontals;
+  frontals += Key(0);
+  DiscreteFactorGraph eliminated;
+  eliminated.push_back(graph[0]);
+  eliminated.push_back(graph[1]);
+  DecisionTreeFactor product = graph[0]->toDecisionTreeFactor()
+      * graph[1]->toDecisionTreeFactor();
+  DecisionTreeFactor::shared_ptr expectedSum = product.sum(frontals);
+  Ordering orderedKeys;
+  orderedKeys += Key(0), Key(1);
+  DiscreteConditional expectedConditional(product, *expectedSum, orderedKeys);
+
+  pair<DiscreteConditional::shared_ptr, DecisionTreeFactor::shared_ptr> actual =
+      EliminateDiscreteTables(eliminated, frontals);
+  EXPECT(assert_equal(expectedConditional, *actual.first));
+  EXPECT(assert_equal(*expectedSum, *actual.second));
+
+  // The whole chain gives the same solution either way
+  DiscreteFactorGraph tables;
+  for (size_t i = 0; i < graph.size(); i++)
+    tables.push_back(boost::make_shared<DiscreteTableFactor>(graph[i]->toDecisionTreeFactor()));
+  EXPECT(assert_equal(*graph.optimize(), *tables.optimize()));
+
+  // Large scopes stay with decision trees
+  DiscreteKey y0(3,300), y1(4,300);
+  DiscreteFactorGraph large;
+  large.add(y0 & y1, vector<double>(300 * 300, 1.0));
+  EXPECT(!DiscreteTableFactor::UseTables(large));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -93,6 +93,40 @@ Point2 Cal3Bundler::uncalibrate(const Point2& p, //
   return Point2(u0_ + f_ * u, v0_ + f_ * v);
 }
 
+/* ************************************************************************* */
+Matrix Cal3Bundler::uncalibrateBatch(const Matrix& p, Matrix* Dcal, Matrix* Dp) const {
+  // Same as uncalibrate, with each intermediate variable an array over all points
+  typedef Eigen::ArrayXd Array;
+  const DenseIndex n = p.rows();
+  const Array x = p.col(0).array(), y = p.col(1).array();
+  const Array r = x * x + y * y;
+  const Array g = 1. + (k1_ + k2_ * r) * r;
+  const Array u = g * x, v = g * y;
+
+  if (Dcal) {
+    Dcal->resize(2 * n, 3);
+    for (DenseIndex i = 0; i < n; i++) {
+      const double rx = r(i) * x(i), ry = r(i) * y(i);
+      Dcal->block<2, 3>(2 * i, 0) << u(i), f_ * rx, f_ * r(i) * rx, v(i), f_ * ry,
+          f_ * r(i) * ry;
+    }
+  }
+
+  if (Dp) {
+    const Array a = 2. * (k1_ + 2. * k2_ * r);
+    const Array axx = a * x * x, axy = a * x * y, ayy = a * y * y;
+    Dp->resize(2 * n, 2);
+    for (DenseIndex i = 0; i < n; i++)
+      Dp->block<2, 2>(2 * i, 0) << f_ * (g(i) + axx(i)), f_ * axy(i), f_ * axy(i),
+          f_ * (g(i) + ayy(i));
+  }
+
+  Matrix pi(n, 2);
+  pi.col(0) = (u0_ + f_ * u).matrix();
+  pi.col(1) = (v0_ + f_ * v).matrix();
+  return pi;
+}
+
 /* ************************************************************************* */
 Point2 Cal3Bundler::calibrate(const Point2& pi, const double tol) const {
   // Copied from Cal3DS2 :-(
@@ -21,8 +21,42 @@
 #include <gtsam/geometry/Point3.h>
 #include <gtsam/geometry/Cal3DS2_Base.h>
 
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
 namespace gtsam {
 
+/* ************************************************************************* */
+// Undistorted points at the nodes of a regular pixel grid
+struct Cal3DS2_Base::UndistortionGrid {
+  double cellSize;
+  size_t cols, rows; ///< Number of nodes, node (c,r) is at pixel (c*cellSize, r*cellSize)
+  std::vector<double> x, y; ///< Intrinsic coordinates of the nodes, row-major, NaN if unknown
+
+  /// Bilinear interpolation at pixel (u,v), false if outside the grid or next to unknown nodes
+  bool interpolate(double u, double v, Point2& pn) const {
+    const double cu = u / cellSize, cv = v / cellSize;
+    if (!(cu >= 0.0 && cv >= 0.0))
+      return false;
+    const size_t c = static_cast<size_t>(cu), r = static_cast<size_t>(cv);
+    if (c + 1 >= cols || r + 1 >= rows)
+      return false;
+    const double a = cu - c, b = cv - r;
+    const size_t i00 = r * cols + c, i01 = i00 + 1, i10 = i00 + cols, i11 = i10 + 1;
+    const double px = (1 - b) * ((1 - a) * x[i00] + a * x[i01]) + b * ((1 - a) * x[i10] + a * x[i11]);
+    const double py = (1 - b) * ((1 - a) * y[i00] + a * y[i01]) + b * ((1 - a) * y[i10] + a * y[i11]);
+    if (std::isnan(px) || std::isnan(py))
+      return false;
+    pn = Point2(px, py);
+    return true;
+  }
+};
+
 /* ************************************************************************* */
 Cal3DS2_Base::Cal3DS2_Base(const Vector &v):
     fx_(v[0]), fy_(v[1]), s_(v[2]), u0_(v[3]), v0_(v[4]), k1_(v[5]), k2_(v[6]), p1_(v[7]), p2_(v[8]){}
@@ -129,6 +163,49 @@ Point2 Cal3DS2_Base::uncalibrate(const Point2& p,
   return Point2(fx_ * pnx + s_ * pny + u0_, fy_ * pny + v0_);
 }
 
+/* ************************************************************************* */
+Matrix Cal3DS2_Base::uncalibrateBatch(const Matrix& p, Matrix* Dcal, Matrix* Dp) const {
+  // Same as uncalibrate, with each intermediate variable an array over all points
+  typedef Eigen::ArrayXd Array;
+  const DenseIndex n = p.rows();
+  const Array x = p.col(0).array(), y = p.col(1).array();
+  const Array xy = x * y, xx = x * x, yy = y * y;
+  const Array rr = xx + yy;
+  const Array r4 = rr * rr;
+  const Array g = 1. + k1_ * rr + k2_ * r4; // scaling factor
+
+  // tangential component
+  const Array dx = 2. * p1_ * xy + p2_ * (rr + 2. * xx);
+  const Array dy = 2. * p2_ * xy + p1_ * (rr + 2. * yy);
+
+  // Radial and tangential distortion applied
+  const Array pnx = g * x + dx;
+  const Array pny = g * y + dy;
+
+  if (Dcal || Dp) {
+    Matrix2 DK;
+    DK << fx_, s_, 0.0, fy_;
+    if (Dcal)
+      Dcal->resize(2 * n, 9);
+    if (Dp)
+      Dp->resize(2 * n, 2);
+    for (DenseIndex i = 0; i < n; i++) {
+      if (Dcal)
+        Dcal->block<2, 9>(2 * i, 0) = D2dcalibration(x(i), y(i), xx(i), yy(i), xy(i), rr(i),
+            r4(i), pnx(i), pny(i), DK);
+      if (Dp)
+        Dp->block<2, 2>(2 * i, 0) = D2dintrinsic(x(i), y(i), rr(i), g(i), k1_, k2_, p1_, p2_,
+            DK);
+    }
+  }
+
+  // Regular uncalibrate after distortion
+  Matrix pi(n, 2);
+  pi.col(0) = (fx_ * pnx + s_ * pny + u0_).matrix();
+  pi.col(1) = (fy_ * pny + v0_).matrix();
+  return pi;
+}
+
 /* ************************************************************************* */
 Point2 Cal3DS2_Base::calibrate(const Point2& pi, const double tol) const {
   // Use the following fixed point iteration to invert the radial distortion.
@@ -137,8 +214,11 @@ Point2 Cal3DS2_Base::calibrate(const Point2& pi, const double tol) const {
   const Point2 invKPi ((1 / fx_) * (pi.x() - u0_ - (s_ / fy_) * (pi.y() - v0_)),
                        (1 / fy_) * (pi.y() - v0_));
 
-  // initialize by ignoring the distortion at all, might be problematic for pixels around boundary
+  // initialize from the undistortion grid if there is one, otherwise by ignoring the distortion
+  // at all, which might be problematic for pixels around boundary
   Point2 pn = invKPi;
+  if (grid_)
+    grid_->interpolate(pi.x(), pi.y(), pn);
 
   // iterate until the uncalibrate is close to the actual pixel coordinate
   const int maxIterations = 10;
@@ -159,6 +239,83 @@ Point2 Cal3DS2_Base::calibrate(const Point2& pi, const double tol) const {
   return pn;
 }
 
+/* ************************************************************************* */
+Matrix Cal3DS2_Base::calibrateBatch(const Matrix& pi, const double tol) const {
+  // Same fixed point iteration as calibrate, with each variable an array over a block of points,
+  // small enough to stay on the stack.  Points that converged keep their value while the others
+  // iterate.
+  static const int BlockSize = 16;
+  typedef Eigen::Array<double, Eigen::Dynamic, 1, 0, BlockSize, 1> Array;
+  typedef Eigen::Array<bool, Eigen::Dynamic, 1, 0, BlockSize, 1> Mask;
+  const int maxIterations = 10;
+  Matrix pn(pi.rows(), 2);
+  for (DenseIndex first = 0; first < pi.rows(); first += BlockSize) {
+    const DenseIndex n = std::min<DenseIndex>(BlockSize, pi.rows() - first);
+    const Array u = pi.col(0).segment(first, n).array(), v = pi.col(1).segment(first, n).array();
+    const Array invKPix = (1 / fx_) * (u - u0_ - (s_ / fy_) * (v - v0_));
+    const Array invKPiy = (1 / fy_) * (v - v0_);
+
+    Array x = invKPix, y = invKPiy;
+    if (grid_) {
+      for (DenseIndex i = 0; i < n; ++i) {
+        Point2 p;
+        if (grid_->interpolate(u(i), v(i), p)) {
+          x(i) = p.x();
+          y(i) = p.y();
+        }
+      }
+    }
+
+    for (int iteration = 0;; ++iteration) {
+      const Array xy = x * y, xx = x * x, yy = y * y;
+      const Array rr = xx + yy;
+      const Array g = 1 + k1_ * rr + k2_ * rr * rr;
+      const Array dx = 2 * p1_ * xy + p2_ * (rr + 2 * xx);
+      const Array dy = 2 * p2_ * xy + p1_ * (rr + 2 * yy);
+
+      // distance of the uncalibrated points to the given ones
+      const Array pny = g * y + dy;
+      const Array eu = fx_ * (g * x + dx) + s_ * pny + u0_ - u, ev = fy_ * pny + v0_ - v;
+      const Mask converged = eu * eu + ev * ev <= tol * tol;
+      if (converged.all())
+        break;
+      if (iteration == maxIterations - 1)
+        throw std::runtime_error("Cal3DS2::calibrate fails to converge. need a better initialization");
+
+      x = converged.select(x, (invKPix - dx) / g);
+      y = converged.select(y, (invKPiy - dy) / g);
+    }
+
+    pn.col(0).segment(first, n) = x.matrix();
+    pn.col(1).segment(first, n) = y.matrix();
+  }
+  return pn;
+}
+
+/* ************************************************************************* */
+void Cal3DS2_Base::precomputeUndistortion(size_t width, size_t height, double cellSize) {
+  // Compute the nodes without a grid, then share the grid
+  grid_.reset();
+  boost::shared_ptr<UndistortionGrid> grid = boost::make_shared<UndistortionGrid>();
+  grid->cellSize = cellSize;
+  grid->cols = static_cast<size_t>(width / cellSize) + 2;
+  grid->rows = static_cast<size_t>(height / cellSize) + 2;
+  grid->x.resize(grid->cols * grid->rows);
+  grid->y.resize(grid->cols * grid->rows);
+  for (size_t r = 0, i = 0; r < grid->rows; ++r) {
+    for (size_t c = 0; c < grid->cols; ++c, ++i) {
+      try {
+        const Point2 pn = calibrate(Point2(c * cellSize, r * cellSize), 1e-9);
+        grid->x[i] = pn.x();
+        grid->y[i] = pn.y();
+      } catch (const std::runtime_error&) {
+        grid->x[i] = grid->y[i] = std::numeric_limits<double>::quiet_NaN();
+      }
+    }
+  }
+  grid_ = grid;
+}
+
 /* ************************************************************************* */
 Matrix2 Cal3DS2_Base::D2d_intrinsic(const Point2& p) const {
   const double x = p.x(), y = p.y(), xx = x * x, yy = y * y;
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <gtsam/geometry/Point2.h>
+#include <boost/shared_ptr.hpp>
 
 namespace gtsam {
 
@@ -44,6 +45,9 @@ protected:
   double k1_, k2_ ; // radial 2nd-order and 4th-order
   double p1_, p2_ ; // tangential distortion
 
+  struct UndistortionGrid;
+  boost::shared_ptr<const UndistortionGrid> grid_; ///< Optional, see precomputeUndistortion
+
 public:
 
   /// @name Standard Constructors
@@ -125,9 +129,37 @@ public:
        OptionalJacobian<2,9> Dcal = boost::none,
        OptionalJacobian<2,2> Dp = boost::none) const ;
 
+  /**
+   * uncalibrate for many points at once, vectorized across points
+   * @param p n*2 matrix with a point in intrinsic coordinates in each row
+   * @param Dcal optional 2n*9 Jacobian wrpt Cal3DS2 parameters, 2 rows per point
+   * @param Dp optional 2n*2 Jacobian wrpt intrinsic coordinates, 2 rows per point
+   * @return n*2 matrix of points in (distorted) image coordinates
+   */
+  Matrix uncalibrateBatch(const Matrix& p, Matrix* Dcal = 0, Matrix* Dp = 0) const;
+
   /// Convert (distorted) image coordinates uv to intrinsic coordinates xy
   Point2 calibrate(const Point2& p, const double tol=1e-5) const;
 
+  /**
+   * calibrate for many points at once, vectorized across points
+   * @param p n*2 matrix with a point in (distorted) image coordinates in each row
+   * @return n*2 matrix of points in intrinsic coordinates
+   */
+  Matrix calibrateBatch(const Matrix& p, const double tol=1e-5) const;
+
+  /**
+   * Undistort the pixels of a grid covering the image [0,width]*[0,height], with nodes every
+   * cellSize pixels.  Afterwards calibrate starts its fixed-point iteration from a bilinear
+   * interpolation in this grid, which is usually within tolerance after one step, instead of
+   * from the undistorted point.  Pixels outside the image are calibrated as before.
+   * The grid is shared by copies of this calibration, and is neither compared nor serialized.
+   */
+  void precomputeUndistortion(size_t width, size_t height, double cellSize = 8.0);
+
+  /// Whether precomputeUndistortion was called
+  bool hasUndistortionGrid() const { return grid_.get() != 0; }
+
   /// Derivative of uncalibrate wrpt intrinsic coordinates
   Matrix2 D2d_intrinsic(const Point2& p) const ;
 
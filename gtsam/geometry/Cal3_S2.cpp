@@ -82,6 +82,27 @@ Point2 Cal3_S2::uncalibrate(const Point2& p, OptionalJacobian<2, 5> Dcal,
   return Point2(fx_ * x + s_ * y + u0_, fy_ * y + v0_);
 }
 
+/* ************************************************************************* */
+Matrix Cal3_S2::uncalibrateBatch(const Matrix& p, Matrix* Dcal, Matrix* Dp) const {
+  const DenseIndex n = p.rows();
+  Matrix pi(n, 2);
+  pi.col(0) = ((fx_ * p.col(0) + s_ * p.col(1)).array() + u0_).matrix();
+  pi.col(1) = ((fy_ * p.col(1)).array() + v0_).matrix();
+  if (Dcal) {
+    Dcal->resize(2 * n, 5);
+    for (DenseIndex i = 0; i < n; i++) {
+      const double x = p(i, 0), y = p(i, 1);
+      Dcal->block<2, 5>(2 * i, 0) << x, 0.0, y, 1.0, 0.0, 0.0, y, 0.0, 0.0, 1.0;
+    }
+  }
+  if (Dp) {
+    Dp->resize(2 * n, 2);
+    for (DenseIndex i = 0; i < n; i++)
+      Dp->block<2, 2>(2 * i, 0) << fx_, s_, 0.0, fy_;
+  }
+  return pi;
+}
+
 /* ************************************************************************* */
 Point2 Cal3_S2::calibrate(const Point2& p, OptionalJacobian<2,5> Dcal,
                            OptionalJacobian<2,2> Dp) const {
@@ -153,6 +153,15 @@ public:
   Point2 uncalibrate(const Point2& p, OptionalJacobian<2,5> Dcal = boost::none,
       OptionalJacobian<2,2> Dp = boost::none) const;
 
+  /**
+   * uncalibrate for many points at once, vectorized across points
+   * @param p n*2 matrix with a point in intrinsic coordinates in each row
+   * @param Dcal optional 2n*5 Jacobian wrpt Cal3_S2 parameters, 2 rows per point
+   * @param Dp optional 2n*2 Jacobian wrpt intrinsic coordinates, 2 rows per point
+   * @return n*2 matrix of points in image coordinates
+   */
+  Matrix uncalibrateBatch(const Matrix& p, Matrix* Dcal = 0, Matrix* Dp = 0) const;
+
   /**
    * convert image coordinates uv to intrinsic coordinates xy
    * @param p point in image coordinates
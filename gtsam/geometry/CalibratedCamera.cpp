@@ -160,6 +160,37 @@ Point2 PinholeBase::project2(const Unit3& pw, OptionalJacobian<2, 6> Dpose,
     *Dpoint = Dpn_pc * Dpc_point; // 2x2 * 2*2
   return pn;
 }
+/* ************************************************************************* */
+Matrix PinholeBase::project2Batch(const Matrix& points, Matrix* Dpose,
+    Matrix* Dpoint) const {
+  // Transform all points into the camera frame, then divide by depth column-wise
+  const Matrix q = pose().transform_to(points);
+#ifdef GTSAM_THROW_CHEIRALITY_EXCEPTION
+  if ((q.col(2).array() <= 0).any())
+    throw CheiralityException();
+#endif
+  const Eigen::ArrayXd d = q.col(2).array().inverse();
+  Matrix pn(q.rows(), 2);
+  pn.col(0) = (q.col(0).array() * d).matrix();
+  pn.col(1) = (q.col(1).array() * d).matrix();
+
+  if (Dpose || Dpoint) {
+    const Matrix3 Rt = pose().rotation().transpose();
+    if (Dpose)
+      Dpose->resize(2 * q.rows(), 6);
+    if (Dpoint)
+      Dpoint->resize(2 * q.rows(), 3);
+    for (DenseIndex i = 0; i < q.rows(); i++) {
+      const Point2 pni(pn(i, 0), pn(i, 1));
+      if (Dpose)
+        Dpose->block<2, 6>(2 * i, 0) = PinholeBase::Dpose(pni, d(i));
+      if (Dpoint)
+        Dpoint->block<2, 3>(2 * i, 0) = PinholeBase::Dpoint(pni, d(i), Rt);
+    }
+  }
+  return pn;
+}
+
 /* ************************************************************************* */
 Point3 PinholeBase::backproject_from_camera(const Point2& p,
     const double depth) {
@@ -201,6 +201,16 @@ public:
       OptionalJacobian<2, 6> Dpose = boost::none,
       OptionalJacobian<2, 2> Dpoint = boost::none) const;
 
+  /** Project many points into the image, vectorized across points
+   * Throws a CheiralityException if any point is behind the image plane iff
+   * GTSAM_THROW_CHEIRALITY_EXCEPTION
+   * @param points n*3 matrix with a 3D point in world coordinates in each row
+   * @param Dpose optional 2n*6 Jacobian wrpt the pose, 2 rows per point
+   * @param Dpoint optional 2n*3 Jacobian wrpt the points, 2 rows per point
+   * @return n*2 matrix of the intrinsic coordinates of the projected points
+   */
+  Matrix project2Batch(const Matrix& points, Matrix* Dpose = 0, Matrix* Dpoint = 0) const;
+
   /// backproject a 2-dimensional point to a 3-dimensional point at given depth
   static Point3 backproject_from_camera(const Point2& p, const double depth);
 
@@ -147,15 +147,90 @@ public:
   static SymmetricBlockMatrix SchurComplement(const FBlocks& Fs,
       const Matrix& E, const Eigen::Matrix<double, N, N>& P, const Vector& b) {
 
+    // Create a SymmetricBlockMatrix, with one block per camera and one for b
+    std::vector<DenseIndex> dims(Fs.size(), D);
+    SymmetricBlockMatrix augmentedHessian(dims, true);
+    SchurComplement(Fs, E, P, b, augmentedHessian);
+    return augmentedHessian;
+  }
+
+  /**
+   * Do Schur complement, given Jacobian as Fs,E,P, writing the result into the given
+   * SymmetricBlockMatrix, which has one D-dimensional block per camera and a last block for
+   * the information vector.  All of its (upper triangular) blocks are overwritten, so its
+   * storage need not be initialized.
+   * Fixed size version, tracks of 2 to 8 cameras use fully fixed-size blocks
+   */
+  template<int N> // N = 2 or 3
+  static void SchurComplement(const FBlocks& Fs, const Matrix& E,
+      const Eigen::Matrix<double, N, N>& P, const Vector& b,
+      /*output ->*/SymmetricBlockMatrix& augmentedHessian) {
+    switch (Fs.size()) {
+    case 2: SchurComplementFixed<2, N>(Fs, E, P, b, augmentedHessian); break;
+    case 3: SchurComplementFixed<3, N>(Fs, E, P, b, augmentedHessian); break;
+    case 4: SchurComplementFixed<4, N>(Fs, E, P, b, augmentedHessian); break;
+    case 5: SchurComplementFixed<5, N>(Fs, E, P, b, augmentedHessian); break;
+    case 6: SchurComplementFixed<6, N>(Fs, E, P, b, augmentedHessian); break;
+    case 7: SchurComplementFixed<7, N>(Fs, E, P, b, augmentedHessian); break;
+    case 8: SchurComplementFixed<8, N>(Fs, E, P, b, augmentedHessian); break;
+    default: SchurComplementDynamic<N>(Fs, E, P, b, augmentedHessian);
+    }
+  }
+
+  /**
+   * Do Schur complement for a track of exactly M cameras, with E and b mapped to fixed-size
+   * matrices.  Each F_i' * E_i * P is computed once, so an off-diagonal block only costs a
+   * (DxN) * (NxD) product.
+   */
+  template<int M, int N>
+  static void SchurComplementFixed(const FBlocks& Fs, const Matrix& E,
+      const Eigen::Matrix<double, N, N>& P, const Vector& b,
+      /*output ->*/SymmetricBlockMatrix& augmentedHessian) {
+    assert(Fs.size() == M && E.rows() == ZDim * M && E.cols() == N);
+    assert(augmentedHessian.nBlocks() == M + 1);
+    const Eigen::Map<const Eigen::Matrix<double, ZDim * M, N> > Ef(E.data());
+    const Eigen::Map<const Eigen::Matrix<double, ZDim * M, 1> > bf(b.data());
+
+    // E' * b, shared by all cameras
+    const Eigen::Matrix<double, N, 1> Etb = Ef.transpose() * bf;
+
+    // F_i' * E_i and F_i' * E_i * P for all cameras
+    Eigen::Matrix<double, D, N> FtE[M], FtEP[M];
+    for (int i = 0; i < M; i++) {
+      FtE[i] = Fs[i].transpose() * Ef.template block<ZDim, N>(ZDim * i, 0);
+      FtEP[i] = FtE[i] * P;
+    }
+
+    // Write fixed-size blocks straight into the upper triangle of the underlying matrix
+    Matrix& H = augmentedHessian.matrix().nestedExpression();
+    const DenseIndex o = augmentedHessian.offset(0);
+    for (int i = 0; i < M; i++) {
+      const MatrixZD& Fi = Fs[i];
+      // (Dx1) = (DxZDim) * (ZDimx1) - (DxN) * (Nx1)
+      H.template block<D, 1>(o + D * i, o + D * M).noalias() = Fi.transpose()
+          * bf.template segment<ZDim>(ZDim * i) - FtEP[i] * Etb;
+      // (DxD) = (DxZDim) * (ZDimxD) - (DxN) * (NxD)
+      H.template block<D, D>(o + D * i, o + D * i).noalias() = Fi.transpose() * Fi
+          - FtEP[i] * FtE[i].transpose();
+      for (int j = i + 1; j < M; j++)
+        H.template block<D, D>(o + D * i, o + D * j).noalias() = -FtEP[i]
+            * FtE[j].transpose();
+    }
+
+    H(o + D * M, o + D * M) = bf.squaredNorm();
+  }
+
+  /// Do Schur complement for any number of cameras, see SchurComplement
+  template<int N> // N = 2 or 3
+  static void SchurComplementDynamic(const FBlocks& Fs, const Matrix& E,
+      const Eigen::Matrix<double, N, N>& P, const Vector& b,
+      /*output ->*/SymmetricBlockMatrix& augmentedHessian) {
     // a single point is observed in m cameras
     size_t m = Fs.size();
+    assert(augmentedHessian.nBlocks() == (DenseIndex)m + 1);
 
-    // Create a SymmetricBlockMatrix
-    size_t M1 = D * m + 1;
-    std::vector<DenseIndex> dims(m + 1); // this also includes the b term
-    std::fill(dims.begin(), dims.end() - 1, D);
-    dims.back() = 1;
-    SymmetricBlockMatrix augmentedHessian(dims, Matrix::Zero(M1, M1));
+    // E' * b, shared by all cameras
+    const Eigen::Matrix<double, N, 1> Etb = E.transpose() * b;
 
     // Blockwise Schur complement
     for (size_t i = 0; i < m; i++) { // for each camera
@@ -166,7 +241,7 @@ public:
 
       // D = (Dx2) * ZDim
       augmentedHessian(i, m) = Fi.transpose() * b.segment<ZDim>(ZDim * i) // F' * b
-      - Fi.transpose() * (Ei_P * (E.transpose() * b)); // D = (DxZDim) * (ZDimx3) * (N*ZDimm) * (ZDimm x 1)
+      - Fi.transpose() * (Ei_P * Etb); // D = (DxZDim) * (ZDimx3) * (N*ZDimm) * (ZDimm x 1)
 
       // (DxD) = (DxZDim) * ( (ZDimxD) - (ZDimx3) * (3xZDim) * (ZDimxD) )
       augmentedHessian(i, i) = Fi.transpose()
@@ -182,8 +257,7 @@ public:
       }
     } // end of for over cameras
 
-    augmentedHessian(m, m)(0, 0) += b.squaredNorm();
-    return augmentedHessian;
+    augmentedHessian(m, m)(0, 0) = b.squaredNorm();
   }
 
   /// Computes Point Covariance P, with lambda parameter
@@ -191,13 +265,12 @@ public:
   static void ComputePointCovariance(Eigen::Matrix<double, N, N>& P,
       const Matrix& E, double lambda, bool diagonalDamping = false) {
 
-    Matrix EtE = E.transpose() * E;
+    Eigen::Matrix<double, N, N> EtE = E.transpose() * E;
 
     if (diagonalDamping) { // diagonal of the hessian
       EtE.diagonal() += lambda * EtE.diagonal();
     } else {
-      DenseIndex n = E.cols();
-      EtE += lambda * Eigen::MatrixXd::Identity(n, n);
+      EtE += lambda * Eigen::Matrix<double, N, N>::Identity();
     }
 
     P = (EtE).inverse();
@@ -224,17 +297,25 @@ public:
   static SymmetricBlockMatrix SchurComplement(const FBlocks& Fblocks,
       const Matrix& E, const Vector& b, const double lambda = 0.0,
       bool diagonalDamping = false) {
-    SymmetricBlockMatrix augmentedHessian;
+    std::vector<DenseIndex> dims(Fblocks.size(), D);
+    SymmetricBlockMatrix augmentedHessian(dims, true);
+    SchurComplement(Fblocks, E, b, augmentedHessian, lambda, diagonalDamping);
+    return augmentedHessian;
+  }
+
+  /// Do Schur complement, given Jacobian as Fs,E,b, writing into augmentedHessian, dynamic version
+  static void SchurComplement(const FBlocks& Fblocks, const Matrix& E,
+      const Vector& b, /*output ->*/SymmetricBlockMatrix& augmentedHessian,
+      const double lambda = 0.0, bool diagonalDamping = false) {
     if (E.cols() == 2) {
       Matrix2 P;
       ComputePointCovariance(P, E, lambda, diagonalDamping);
-      augmentedHessian = SchurComplement(Fblocks, E, P, b);
+      SchurComplement(Fblocks, E, P, b, augmentedHessian);
     } else {
       Matrix3 P;
       ComputePointCovariance(P, E, lambda, diagonalDamping);
-      augmentedHessian = SchurComplement(Fblocks, E, P, b);
+      SchurComplement(Fblocks, E, P, b, augmentedHessian);
     }
-    return augmentedHessian;
   }
 
   /**
@@ -269,7 +350,7 @@ public:
     for (size_t i = 0; i < m; i++) { // for each camera in the current factor
 
       const MatrixZD& Fi = Fs[i];
-      const Eigen::Matrix<double, 2, N> Ei_P = E.template block<ZDim, N>(
+      const Eigen::Matrix<double, ZDim, N> Ei_P = E.template block<ZDim, N>(
           ZDim * i, 0) * P;
 
       // D = (DxZDim) * (ZDim)
@@ -6,12 +6,59 @@
  */
 
 #include <gtsam/geometry/EssentialMatrix.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 #include <iostream>
+#include <stdexcept>
 
 using namespace std;
 
 namespace gtsam {
 
+namespace {
+
+// Check the sizes of batched correspondences
+void checkCorrespondences(const Matrix& vA, const Matrix& vB) {
+  if (vA.rows() != 3 || vB.rows() != 3 || vA.cols() != vB.cols())
+    throw invalid_argument(
+        "EssentialMatrix: correspondences must be two 3*N matrices");
+}
+
+// Squared Sampson distances of correspondences [first, last)
+void sampsonRange(const Matrix3& E, const Matrix& vA, const Matrix& vB,
+    double* errors, size_t first, size_t last) {
+  const size_t n = last - first;
+  const Eigen::Matrix3Xd Ev = E * vB.middleCols(first, n);
+  const Eigen::Matrix3Xd Etu = E.transpose() * vA.middleCols(first, n);
+  const Eigen::ArrayXd numerator =
+      (vA.middleCols(first, n).array() * Ev.array()).colwise().sum().transpose();
+  const Eigen::ArrayXd denominator = (Ev.topRows<2>().array().square().colwise().sum()
+      + Etu.topRows<2>().array().square().colwise().sum()).transpose();
+  Eigen::Map<Eigen::ArrayXd>(errors + first, n) = numerator.square() / denominator;
+}
+
+#ifdef GTSAM_USE_TBB
+class SampsonErrors {
+  const Matrix3& E_;
+  const Matrix& vA_;
+  const Matrix& vB_;
+  double* errors_;
+public:
+  SampsonErrors(const Matrix3& E, const Matrix& vA, const Matrix& vB, double* errors) :
+      E_(E), vA_(vA), vB_(vB), errors_(errors) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& range) const {
+    sampsonRange(E_, vA_, vB_, errors_, range.begin(), range.end());
+  }
+};
+#endif
+
+}
+
 /* ************************************************************************* */
 EssentialMatrix EssentialMatrix::FromPose3(const Pose3& aPb,
     OptionalJacobian<5, 6> H) {
@@ -102,6 +149,46 @@ double EssentialMatrix::error(const Vector3& vA, const Vector3& vB, //
   return dot(vA, E_ * vB);
 }
 
+/* ************************************************************************* */
+Vector EssentialMatrix::errorBatch(const Matrix& vA, const Matrix& vB) const {
+  checkCorrespondences(vA, vB);
+  return (vA.array() * (E_ * vB).array()).colwise().sum().transpose();
+}
+
+/* ************************************************************************* */
+Vector EssentialMatrix::sampsonErrorBatch(const Matrix& vA, const Matrix& vB) const {
+  checkCorrespondences(vA, vB);
+  Vector errors(vA.cols());
+  sampsonRange(E_, vA, vB, errors.data(), 0, vA.cols());
+  return errors;
+}
+
+/* ************************************************************************* */
+size_t EssentialMatrix::countInliers(const Matrix& vA, const Matrix& vB,
+    double threshold, vector<bool>* inliers) const {
+  checkCorrespondences(vA, vB);
+  const size_t n = vA.cols();
+  Vector errors(n);
+#ifdef GTSAM_USE_TBB
+  // Blocks large enough to amortize the scheduling and keep the kernel vectorized
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n, 512),
+      SampsonErrors(E_, vA, vB, errors.data()));
+#else
+  sampsonRange(E_, vA, vB, errors.data(), 0, n);
+#endif
+  if (inliers)
+    inliers->resize(n);
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const bool inlier = errors(i) < threshold;
+    if (inliers)
+      (*inliers)[i] = inlier;
+    if (inlier)
+      ++count;
+  }
+  return count;
+}
+
 /* ************************************************************************* */
 ostream& operator <<(ostream& os, const EssentialMatrix& E) {
   Rot3 R = E.rotation();
@@ -12,6 +12,7 @@
 #include <gtsam/geometry/Point2.h>
 #include <gtsam/base/Manifold.h>
 #include <iosfwd>
+#include <vector>
 
 namespace gtsam {
 
@@ -158,6 +159,34 @@ public:
   double error(const Vector3& vA, const Vector3& vB, //
       OptionalJacobian<1,5> H = boost::none) const;
 
+  /**
+   * Algebraic epipolar errors vA_i' * E * vB_i of many correspondences at once
+   * @param vA 3*N matrix of homogeneous coordinates in image a
+   * @param vB 3*N matrix of homogeneous coordinates in image b
+   * @return N-vector of errors, the same as error(vA.col(i), vB.col(i))
+   */
+  Vector errorBatch(const Matrix& vA, const Matrix& vB) const;
+
+  /**
+   * Squared Sampson distances of many correspondences at once, the first-order
+   * approximation of the squared geometric (reprojection) error:
+   * (vA' E vB)^2 / ((E vB)_1^2 + (E vB)_2^2 + (E' vA)_1^2 + (E' vA)_2^2)
+   * @param vA 3*N matrix of homogeneous coordinates in image a
+   * @param vB 3*N matrix of homogeneous coordinates in image b
+   */
+  Vector sampsonErrorBatch(const Matrix& vA, const Matrix& vB) const;
+
+  /**
+   * Score a hypothesis, e.g. in RANSAC: count the correspondences with a squared
+   * Sampson distance below threshold.  Uses TBB, if available, for large N.
+   * @param vA 3*N matrix of homogeneous coordinates in image a
+   * @param vB 3*N matrix of homogeneous coordinates in image b
+   * @param threshold on the squared Sampson distance
+   * @param inliers optional output, true for the inlying correspondences
+   */
+  size_t countInliers(const Matrix& vA, const Matrix& vB, double threshold,
+      std::vector<bool>* inliers = 0) const;
+
   /// @}
 
   /// @name Streaming operators
@@ -136,8 +136,8 @@ public:
     return Vector4(unit_vec[0], unit_vec[1], unit_vec[2], d_);
   }
 
-  /// Return the normal
-  inline Unit3 normal() const {
+  /// Return the normal, by reference so that its cached basis is reused
+  inline const Unit3& normal() const {
     return n_;
   }
 
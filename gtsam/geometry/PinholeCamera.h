@@ -228,6 +228,24 @@ public:
     return _project2(pw, Dcamera, Dpoint);
   }
 
+  /** project2 for many points at once, vectorized across points.
+   *  Needs a calibration with uncalibrateBatch, e.g., Cal3_S2, Cal3DS2 or Cal3Bundler.
+   *  @param points n*3 matrix with a point in world coordinates in each row
+   *  @param Dcamera optional 2n*dimension Jacobian w.r.t. the camera, i.e., the stacked F blocks
+   *  @param Dpoint optional 2n*3 Jacobian w.r.t. the points, i.e., the stacked E blocks
+   *  @return n*2 matrix of image points
+   */
+  Matrix project2Batch(const Matrix& points, Matrix* Dcamera = 0, Matrix* Dpoint = 0) const {
+    Matrix Dpose, Dcal;
+    const Matrix pi = Base::projectBatch(points, Dcamera ? &Dpose : 0, Dpoint,
+        Dcamera ? &Dcal : 0);
+    if (Dcamera) {
+      Dcamera->resize(Dpose.rows(), dimension);
+      *Dcamera << Dpose, Dcal;
+    }
+    return pi;
+  }
+
   /**
    * Calculate range to a landmark
    * @param point 3D location of landmark
@@ -144,6 +144,37 @@ public:
     return _project(pw, Dpose, Dpoint, Dcal);
   }
 
+  /** Project many 3D points from world coordinates into the image, vectorized across points.
+   *  Needs a calibration with uncalibrateBatch.
+   *  @param points n*3 matrix with a point in world coordinates in each row
+   *  @param Dpose optional 2n*6 Jacobian w.r.t. pose3, 2 rows per point
+   *  @param Dpoint optional 2n*3 Jacobian w.r.t. the points, 2 rows per point
+   *  @param Dcal optional 2n*DimK Jacobian w.r.t. calibration, 2 rows per point
+   *  @return n*2 matrix of image points
+   */
+  Matrix projectBatch(const Matrix& points, Matrix* Dpose = 0, Matrix* Dpoint = 0,
+      Matrix* Dcal = 0) const {
+
+    // project to normalized coordinates
+    const Matrix pn = PinholeBase::project2Batch(points, Dpose, Dpoint);
+
+    // uncalibrate to pixel coordinates
+    Matrix Dpi_pn;
+    const Matrix pi = calibration().uncalibrateBatch(pn, Dcal,
+        Dpose || Dpoint ? &Dpi_pn : 0);
+
+    // If needed, apply chain rule, one point at a time
+    for (DenseIndex i = 0; i < pn.rows(); i++) {
+      const Matrix2 Dpi_pn_i = Dpi_pn.block<2, 2>(2 * i, 0);
+      if (Dpose)
+        Dpose->block<2, 6>(2 * i, 0) = Dpi_pn_i * Dpose->block<2, 6>(2 * i, 0);
+      if (Dpoint)
+        Dpoint->block<2, 3>(2 * i, 0) = Dpi_pn_i * Dpoint->block<2, 3>(2 * i, 0);
+    }
+
+    return pi;
+  }
+
   /// backproject a 2-dimensional point to a 3-dimensional point at given depth
   Point3 backproject(const Point2& p, double depth) const {
     const Point2 pn = calibration().calibrate(p);
@@ -349,6 +380,15 @@ public:
     return Base::project(pw, Dpose, Dpoint);
   }
 
+  /** project2 for many points at once, vectorized across points, see projectBatch
+   *  @param points n*3 matrix with a point in world coordinates in each row
+   *  @param Dpose optional 2n*6 Jacobian w.r.t. the camera, i.e., the stacked F blocks
+   *  @param Dpoint optional 2n*3 Jacobian w.r.t. the points, i.e., the stacked E blocks
+   */
+  Matrix project2Batch(const Matrix& points, Matrix* Dpose = 0, Matrix* Dpoint = 0) const {
+    return Base::projectBatch(points, Dpose, Dpoint);
+  }
+
   /// @}
   /// @name Manifold
   /// @{
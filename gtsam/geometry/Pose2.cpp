@@ -24,6 +24,7 @@
 #include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <stdexcept>
 
 using namespace std;
 
@@ -262,6 +263,39 @@ double Pose2::range(const Point2& point,
   return r;
 }
 
+/* ************************************************************************* */
+Vector Pose2::rangeBatch(const Matrix& points, Matrix* Dpose, Matrix* Dpoint) const {
+  if (points.cols() != 2)
+    throw std::invalid_argument("Pose2::rangeBatch: points must be an n*2 matrix");
+  const DenseIndex n = points.rows();
+  Matrix d = points;
+  d.rowwise() -= t_.vector().transpose();
+  const Vector r = d.rowwise().norm();
+  if (Dpose || Dpoint) {
+    // The range is invariant to the rotation, the other derivatives are unit vectors (p - t)/r
+    d.array().colwise() /= r.array();
+    if (Dpose) {
+      Dpose->resize(n, 3);
+      Dpose->col(0) = -r_.c() * d.col(0) - r_.s() * d.col(1);
+      Dpose->col(1) = r_.s() * d.col(0) - r_.c() * d.col(1);
+      Dpose->col(2).setZero();
+    }
+    if (Dpoint)
+      *Dpoint = d;
+    // Coincident points get the Jacobians of range
+    for (DenseIndex i = 0; i < n; ++i) {
+      if (r(i) > 1e-10)
+        continue;
+      Matrix13 H1;
+      Matrix12 H2;
+      range(Point2(points(i, 0), points(i, 1)), H1, H2);
+      if (Dpose) Dpose->row(i) = H1;
+      if (Dpoint) Dpoint->row(i) = H2;
+    }
+  }
+  return r;
+}
+
 /* ************************************************************************* */
 double Pose2::range(const Pose2& pose,
     OptionalJacobian<1,3> Hpose,
@@ -238,6 +238,12 @@ public:
       OptionalJacobian<1, 3> H1=boost::none,
       OptionalJacobian<1, 2> H2=boost::none) const;
 
+  /**
+   * Ranges to the rows of the n*2 matrix points, vectorized across the points, with the
+   * optional n*3 Jacobian wrpt this pose and n*2 Jacobian wrpt the points, one row per point
+   */
+  Vector rangeBatch(const Matrix& points, Matrix* Dpose = 0, Matrix* Dpoint = 0) const;
+
   /**
    * Calculate range to another pose
    * @param point 2D location of other pose
@@ -18,6 +18,7 @@
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/geometry/concepts.h>
 #include <gtsam/base/concepts.h>
+#include <gtsam/base/simdKernels.h>
 
 #include <boost/foreach.hpp>
 #include <iostream>
@@ -183,6 +184,20 @@ Vector6 Pose3::ChartAtOrigin::Local(const Pose3& T, ChartJacobian H) {
 #endif
 }
 
+/* ************************************************************************* */
+vector<Pose3> Pose3::ChartAtOrigin::RetractBatch(const Matrix& xi) {
+#ifdef GTSAM_POSE3_EXPMAP
+  return ExpmapBatch(xi);
+#else
+  const vector<Rot3> R = Rot3::ChartAtOrigin::RetractBatch(xi.leftCols<3>());
+  vector<Pose3> result;
+  result.reserve(R.size());
+  for (size_t i = 0; i < R.size(); ++i)
+    result.push_back(Pose3(R[i], Point3(xi(i, 3), xi(i, 4), xi(i, 5))));
+  return result;
+#endif
+}
+
 /* ************************************************************************* */
 /**
  * Compute the 3x3 bottom-left block Q of the SE3 Expmap derivative matrix
@@ -291,6 +306,79 @@ Point3 Pose3::transform_from(const Point3& p, OptionalJacobian<3,6> Dpose,
   return Point3(R * p.vector()) + t_;
 }
 
+/* ************************************************************************* */
+vector<Pose3> Pose3::ExpmapBatch(const Matrix& xi, Matrix* H) {
+  const size_t n = xi.rows();
+  if (H) {
+    H->resize(6 * n, 6);
+    for (size_t i = 0; i < n; ++i)
+      H->block<6, 6>(6 * i, 0) = ExpmapDerivative(xi.row(i).transpose());
+  }
+
+  // t = v + B w x v + C w x (w x v), with B = (1-cos(t))/t^2 and C = (t-sin(t))/t^3, computed
+  // for all poses at once, with a Taylor expansion for small angles
+  typedef Eigen::ArrayXd Array;
+  const vector<Rot3> R = Rot3::ExpmapBatch(xi.leftCols<3>());
+  const Array wx = xi.col(0).array(), wy = xi.col(1).array(), wz = xi.col(2).array();
+  const Array vx = xi.col(3).array(), vy = xi.col(4).array(), vz = xi.col(5).array();
+  const Array theta2 = wx * wx + wy * wy + wz * wz;
+  const Eigen::Array<bool, Eigen::Dynamic, 1> small = theta2 < 1e-6;
+  const Array safe2 = small.select(Array::Ones(n), theta2), theta = safe2.sqrt();
+  const Array B = small.select(0.5 - theta2 / 24.0, (1.0 - theta.cos()) / safe2);
+  const Array C = small.select(1.0 / 6.0 - theta2 / 120.0, (theta - theta.sin()) / (safe2 * theta));
+  const Array cx = wy * vz - wz * vy, cy = wz * vx - wx * vz, cz = wx * vy - wy * vx;
+  const Array tx = vx + B * cx + C * (wy * cz - wz * cy);
+  const Array ty = vy + B * cy + C * (wz * cx - wx * cz);
+  const Array tz = vz + B * cz + C * (wx * cy - wy * cx);
+
+  vector<Pose3> result;
+  result.reserve(n);
+  for (size_t i = 0; i < n; ++i)
+    result.push_back(Pose3(R[i], Point3(tx(i), ty(i), tz(i))));
+  return result;
+}
+
+/* ************************************************************************* */
+Matrix Pose3::LogmapBatch(const vector<Pose3>& poses, Matrix* H) {
+  // The branches of Logmap depend on each pose, so it is done one pose at a time
+  Matrix xi(poses.size(), 6);
+  if (H)
+    H->resize(6 * poses.size(), 6);
+  for (size_t i = 0; i < poses.size(); ++i) {
+    xi.row(i) = Logmap(poses[i]).transpose();
+    if (H)
+      H->block<6, 6>(6 * i, 0) = LogmapDerivative(poses[i]);
+  }
+  return xi;
+}
+
+/* ************************************************************************* */
+void Pose3::RetractBatch(const Pose3* const* poses, const Matrix& xi, Pose3* result) {
+  const vector<Pose3> local = ChartAtOrigin::RetractBatch(xi);
+  for (size_t i = 0; i < local.size(); ++i)
+    result[i] = poses[i]->compose(local[i]);
+}
+
+/* ************************************************************************* */
+Matrix Pose3::transform_to(const Matrix& points, Matrix* Dpose) const {
+  // q' = (p - t)' R for every row p' of points, vectorized across the points
+  if (points.cols() != 3)
+    throw std::invalid_argument("Pose3::transform_to: points must be an n*3 matrix");
+  const Matrix3 R = R_.matrix();
+  const Vector3 t = t_.vector();
+  Matrix q(points.rows(), 3);
+  simd::transformTo(points.rows(), R.data(), t.data(), points.data(), points.rows(), q.data(),
+      q.rows());
+  if (Dpose) {
+    Dpose->setZero(3 * q.rows(), 6);
+    for (DenseIndex i = 0; i < q.rows(); ++i) {
+      Dpose->block<3, 3>(3 * i, 0) = skewSymmetric(q(i, 0), q(i, 1), q(i, 2));
+      Dpose->block<3, 3>(3 * i, 3) = -I_3x3;
+    }
+  }
+  return q;
+}
+
 /* ************************************************************************* */
 Point3 Pose3::transform_to(const Point3& p, OptionalJacobian<3,6> Dpose,
     OptionalJacobian<3,3> Dpoint) const {
@@ -328,6 +416,38 @@ double Pose3::range(const Point3& point, OptionalJacobian<1, 6> H1,
   }
 }
 
+/* ************************************************************************* */
+Vector Pose3::rangeBatch(const Matrix& points, Matrix* Dpose, Matrix* Dpoint) const {
+  if (points.cols() != 3)
+    throw std::invalid_argument("Pose3::rangeBatch: points must be an n*3 matrix");
+  const DenseIndex n = points.rows();
+  Matrix d = points;
+  d.rowwise() -= t_.vector().transpose();
+  const Vector r = d.rowwise().norm();
+  if (Dpose || Dpoint) {
+    // The range is invariant to the rotation, the other derivatives are unit vectors (p - t)/r
+    d.array().colwise() /= r.array();
+    if (Dpose) {
+      Dpose->resize(n, 6);
+      Dpose->leftCols<3>().setZero();
+      Dpose->rightCols<3>().noalias() = -d * R_.matrix();
+    }
+    if (Dpoint)
+      *Dpoint = d;
+    // Coincident points get the Jacobians of range
+    for (DenseIndex i = 0; i < n; ++i) {
+      if (r(i) > 1e-10)
+        continue;
+      Matrix16 H1;
+      Matrix13 H2;
+      range(Point3(points.row(i).transpose()), H1, H2);
+      if (Dpose) Dpose->row(i) = H1;
+      if (Dpoint) Dpoint->row(i) = H2;
+    }
+  }
+  return r;
+}
+
 /* ************************************************************************* */
 double Pose3::range(const Pose3& pose, OptionalJacobian<1, 6> H1,
                     OptionalJacobian<1, 6> H2) const {
@@ -169,6 +169,9 @@ public:
   struct ChartAtOrigin {
     static Pose3 Retract(const Vector6& v, ChartJacobian H = boost::none);
     static Vector6 Local(const Pose3& r, ChartJacobian H = boost::none);
+
+    /// Retract the rows of the n*6 matrix xi, see ExpmapBatch
+    static std::vector<Pose3> RetractBatch(const Matrix& xi);
   };
 
   using LieGroup<Pose3, 6>::inverse; // version with derivative
@@ -185,6 +188,28 @@ public:
     return (Matrix(4, 4) << 0., -wz, wy, vx, wz, 0., -wx, vy, -wy, wx, 0., vz, 0., 0., 0., 0.).finished();
   }
 
+  /// @}
+  /// @name Batch operations
+  /// Tangent vectors and points are the rows of an n*6 or n*3 matrix, so each coordinate of
+  /// all n elements is contiguous and the arithmetic is vectorized across elements.  Jacobians
+  /// are stacked, one block of rows per element.
+  /// @{
+
+  /// Expmap of each row of xi, with the optional 6n*6 Jacobian
+  static std::vector<Pose3> ExpmapBatch(const Matrix& xi, Matrix* H = 0);
+
+  /// Logmap of each pose, as the rows of an n*6 matrix, with the optional 6n*6 Jacobian
+  static Matrix LogmapBatch(const std::vector<Pose3>& poses, Matrix* H = 0);
+
+  /// Retract poses[i] by the i-th row of the n*6 matrix xi into result[i]
+  static void RetractBatch(const Pose3* const* poses, const Matrix& xi, Pose3* result);
+
+  /**
+   * Transform the rows of the n*3 matrix points from world to pose coordinates, with the
+   * optional 3n*6 Jacobian wrpt this pose.  The Jacobian wrpt every point is R'.
+   */
+  Matrix transform_to(const Matrix& points, Matrix* Dpose = 0) const;
+
   /// @}
   /// @name Group Action on Point3
   /// @{
@@ -255,6 +280,12 @@ public:
   double range(const Point3& point, OptionalJacobian<1, 6> H1 = boost::none,
       OptionalJacobian<1, 3> H2 = boost::none) const;
 
+  /**
+   * Ranges to the rows of the n*3 matrix points, vectorized across the points, with the
+   * optional n*6 Jacobian wrpt this pose and n*3 Jacobian wrpt the points, one row per point
+   */
+  Vector rangeBatch(const Matrix& points, Matrix* Dpose = 0, Matrix* Dpoint = 0) const;
+
   /**
    * Calculate range to another pose
    * @param pose Other SO(3) pose
@@ -335,6 +366,21 @@ typedef std::vector<Pose3> Pose3Vector;
 template <>
 struct traits<Pose3> : public internal::LieGroup<Pose3> {};
 
+namespace internal {
+/// Values retracts runs of Pose3 with Pose3::RetractBatch
+template<>
+struct BatchRetract<Pose3> {
+  static const bool value = true;
+  static void Retract(const Pose3* const* values, const Vector* const* deltas, size_t n,
+      Pose3* result) {
+    Matrix xi(n, 6);
+    for (size_t i = 0; i < n; ++i)
+      xi.row(i) = deltas[i]->transpose();
+    Pose3::RetractBatch(values, xi, result);
+  }
+};
+}
+
 template <>
 struct traits<const Pose3> : public internal::LieGroup<Pose3> {};
 
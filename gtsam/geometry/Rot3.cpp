@@ -77,20 +77,6 @@ Unit3 Rot3::operator*(const Unit3& p) const {
   return rotate(p);
 }
 
-/* ************************************************************************* */
-// see doc/math.lyx, SO(3) section
-Point3 Rot3::unrotate(const Point3& p, OptionalJacobian<3,3> H1,
-    OptionalJacobian<3,3> H2) const {
-  const Matrix3& Rt = transpose();
-  Point3 q(Rt * p.vector()); // q = Rt*p
-  const double wx = q.x(), wy = q.y(), wz = q.z();
-  if (H1)
-    *H1 << 0.0, -wz, +wy, +wz, 0.0, -wx, -wy, +wx, 0.0;
-  if (H2)
-    *H2 = Rt;
-  return q;
-}
-
 /* ************************************************************************* */
 Point3 Rot3::column(int index) const{
   if(index == 3)
@@ -178,6 +164,81 @@ Rot3 Rot3::slerp(double t, const Rot3& other) const {
   return compose(Expmap(t * omega));
 }
 
+/* ************************************************************************* */
+vector<Rot3> Rot3::ExpmapBatch(const Matrix& omega, Matrix* H) {
+  const size_t n = omega.rows();
+  if (H) {
+    H->resize(3 * n, 3);
+    for (size_t i = 0; i < n; ++i)
+      H->block<3, 3>(3 * i, 0) = ExpmapDerivative(omega.row(i).transpose());
+  }
+
+  // Rodrigues' formula R = I + A W + B W^2 with A = sin(t)/t and B = (1-cos(t))/t^2, computed
+  // for all rotations at once, with a Taylor expansion for small angles
+  typedef Eigen::ArrayXd Array;
+  const Array wx = omega.col(0).array(), wy = omega.col(1).array(), wz = omega.col(2).array();
+  const Array xx = wx * wx, yy = wy * wy, zz = wz * wz;
+  const Array theta2 = xx + yy + zz;
+  const Eigen::Array<bool, Eigen::Dynamic, 1> small = theta2 < 1e-6;
+  const Array safe2 = small.select(Array::Ones(n), theta2), theta = safe2.sqrt();
+  const Array A = small.select(1.0 - theta2 / 6.0, theta.sin() / theta);
+  const Array B = small.select(0.5 - theta2 / 24.0, (1.0 - theta.cos()) / safe2);
+  const Array Axyz[3] = { A * wx, A * wy, A * wz };
+  const Array Bxy = B * wx * wy, Bxz = B * wx * wz, Byz = B * wy * wz;
+  const Array d0 = 1.0 - B * (yy + zz), d1 = 1.0 - B * (xx + zz), d2 = 1.0 - B * (xx + yy);
+
+  vector<Rot3> result;
+  result.reserve(n);
+  for (size_t i = 0; i < n; ++i)
+    result.push_back(Rot3(d0(i), Bxy(i) - Axyz[2](i), Bxz(i) + Axyz[1](i),
+                          Bxy(i) + Axyz[2](i), d1(i), Byz(i) - Axyz[0](i),
+                          Bxz(i) - Axyz[1](i), Byz(i) + Axyz[0](i), d2(i)));
+  return result;
+}
+
+/* ************************************************************************* */
+Matrix Rot3::LogmapBatch(const vector<Rot3>& R, Matrix* H) {
+  // The branches of Logmap depend on each rotation, so it is done one rotation at a time
+  Matrix omega(R.size(), 3);
+  if (H)
+    H->resize(3 * R.size(), 3);
+  for (size_t i = 0; i < R.size(); ++i) {
+    const Vector3 w = Logmap(R[i]);
+    omega.row(i) = w.transpose();
+    if (H)
+      H->block<3, 3>(3 * i, 0) = LogmapDerivative(w);
+  }
+  return omega;
+}
+
+/* ************************************************************************* */
+vector<Rot3> Rot3::ChartAtOrigin::RetractBatch(const Matrix& omega) {
+  static const CoordinatesMode mode = ROT3_DEFAULT_COORDINATES_MODE;
+  if (mode == Rot3::EXPMAP) return ExpmapBatch(omega);
+#ifndef GTSAM_USE_QUATERNIONS
+  if (mode != Rot3::CAYLEY) throw std::runtime_error("Rot3::RetractBatch: unknown mode");
+
+  // Closed form of the Cayley map, see CayleyChart::Retract
+  typedef Eigen::ArrayXd Array;
+  const size_t n = omega.rows();
+  const Array x = omega.col(0).array(), y = omega.col(1).array(), z = omega.col(2).array();
+  const Array x2 = x * x, y2 = y * y, z2 = z * z;
+  const Array xy = x * y, xz = x * z, yz = y * z;
+  const Array f = 1.0 / (4.0 + x2 + y2 + z2), _2f = 2.0 * f;
+  vector<Rot3> result;
+  result.reserve(n);
+  for (size_t i = 0; i < n; ++i)
+    result.push_back(Rot3((4 + x2(i) - y2(i) - z2(i)) * f(i), (xy(i) - 2 * z(i)) * _2f(i),
+        (xz(i) + 2 * y(i)) * _2f(i), (xy(i) + 2 * z(i)) * _2f(i),
+        (4 - x2(i) + y2(i) - z2(i)) * f(i), (yz(i) - 2 * x(i)) * _2f(i),
+        (xz(i) - 2 * y(i)) * _2f(i), (yz(i) + 2 * x(i)) * _2f(i),
+        (4 - x2(i) - y2(i) + z2(i)) * f(i)));
+  return result;
+#else
+  throw std::runtime_error("Rot3::RetractBatch: unknown mode");
+#endif
+}
+
 /* ************************************************************************* */
 
 } // namespace gtsam
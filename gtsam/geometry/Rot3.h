@@ -28,6 +28,8 @@
 #include <gtsam/base/concepts.h>
 #include <gtsam/config.h> // Get GTSAM_USE_QUATERNIONS macro
 
+#include <vector>
+
 // You can override the default coordinate mode using this flag
 #ifndef ROT3_DEFAULT_COORDINATES_MODE
   #ifdef GTSAM_USE_QUATERNIONS
@@ -247,9 +249,13 @@ namespace gtsam {
     /// Syntatic sugar for composing two rotations
     Rot3 operator*(const Rot3& R2) const;
 
-    /// inverse of a rotation, TODO should be different for M/Q
+    /// inverse of a rotation
     Rot3 inverse() const {
+#ifdef GTSAM_USE_QUATERNIONS
+      return Rot3(quaternion_.conjugate());
+#else
       return Rot3(Matrix3(transpose()));
+#endif
     }
 
     /**
@@ -338,10 +344,26 @@ namespace gtsam {
     struct ChartAtOrigin {
       static Rot3 Retract(const Vector3& v, ChartJacobian H = boost::none);
       static Vector3 Local(const Rot3& r, ChartJacobian H = boost::none);
+
+      /// Retract the rows of the n*3 matrix omega, see ExpmapBatch
+      static std::vector<Rot3> RetractBatch(const Matrix& omega);
     };
 
     using LieGroup<Rot3, 3>::inverse; // version with derivative
 
+    /// @}
+    /// @name Batch operations
+    /// Tangent vectors are the rows of an n*3 matrix, so each coordinate of all n rotations is
+    /// contiguous and the arithmetic is vectorized across rotations.  Jacobians are stacked
+    /// into a 3n*3 matrix.
+    /// @{
+
+    /// Expmap of each row of omega
+    static std::vector<Rot3> ExpmapBatch(const Matrix& omega, Matrix* H = 0);
+
+    /// Logmap of each rotation, as the rows of an n*3 matrix
+    static Matrix LogmapBatch(const std::vector<Rot3>& R, Matrix* H = 0);
+
     /// @}
     /// @name Group Action on Point3
     /// @{
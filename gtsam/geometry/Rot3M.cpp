@@ -124,6 +124,20 @@ Point3 Rot3::rotate(const Point3& p,
   return Point3(rot_ * p.vector());
 }
 
+/* ************************************************************************* */
+// see doc/math.lyx, SO(3) section
+Point3 Rot3::unrotate(const Point3& p, OptionalJacobian<3,3> H1,
+    OptionalJacobian<3,3> H2) const {
+  const Matrix3& Rt = transpose();
+  Point3 q(Rt * p.vector()); // q = Rt*p
+  const double wx = q.x(), wy = q.y(), wz = q.z();
+  if (H1)
+    *H1 << 0.0, -wz, +wy, +wz, 0.0, -wx, -wy, +wx, 0.0;
+  if (H2)
+    *H2 = Rt;
+  return q;
+}
+
 /* ************************************************************************* */
 // Log map at identity - return the canonical coordinates of this rotation
 Vector3 Rot3::Logmap(const Rot3& R, OptionalJacobian<3,3> H) {
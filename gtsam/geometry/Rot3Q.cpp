@@ -91,11 +91,26 @@ namespace gtsam {
   /* ************************************************************************* */
   Point3 Rot3::rotate(const Point3& p,
         OptionalJacobian<3,3> H1,  OptionalJacobian<3,3> H2) const {
-    Matrix R = matrix();
-    if (H1) *H1 = R * skewSymmetric(-p.x(), -p.y(), -p.z());
-    if (H2) *H2 = R;
-    Eigen::Vector3d r = R * p.vector();
-    return Point3(r.x(), r.y(), r.z());
+    // The rotation matrix is only needed for the derivatives
+    if (H1 || H2) {
+      const Matrix3 R = matrix();
+      if (H1) *H1 = R * skewSymmetric(-p.x(), -p.y(), -p.z());
+      if (H2) *H2 = R;
+    }
+    return Point3(quaternion_ * p.vector());
+  }
+
+  /* ************************************************************************* */
+  // see doc/math.lyx, SO(3) section
+  Point3 Rot3::unrotate(const Point3& p,
+        OptionalJacobian<3,3> H1,  OptionalJacobian<3,3> H2) const {
+    const Point3 q(quaternion_.conjugate() * p.vector()); // q = Rt*p
+    const double wx = q.x(), wy = q.y(), wz = q.z();
+    if (H1)
+      *H1 << 0.0, -wz, +wy, +wz, 0.0, -wx, -wy, +wx, 0.0;
+    if (H2)
+      *H2 = transpose();
+    return q;
   }
 
   /* ************************************************************************* */
@@ -134,6 +134,47 @@ public:
   StereoPoint2 project2(const Point3& point, OptionalJacobian<3, 6> H1 =
       boost::none, OptionalJacobian<3, 3> H2 = boost::none) const;
 
+  /** Project 3D point with the given left camera pose and calibration, with optional
+   * derivatives, without constructing a StereoCamera.  Inline fixed-size version of project2.
+   * @param H1 derivative with respect to pose
+   * @param H2 derivative with respect to point
+   */
+  static StereoPoint2 Project(const Pose3& leftCamPose, const Cal3_S2Stereo& K,
+      const Point3& point, OptionalJacobian<3, 6> H1 = boost::none,
+      OptionalJacobian<3, 3> H2 = boost::none) {
+
+    // transform to the camera frame
+    const Matrix3 R = leftCamPose.rotation().matrix();
+    const Vector3 q = R.transpose() * (point.vector() - leftCamPose.translation().vector());
+
+    if (q.z() <= 0) throw StereoCheiralityException();
+
+    // calculate scaled but not translated image coordinates
+    const double fx = K.fx(), fy = K.fy(), b = K.baseline();
+    const double d = 1.0 / q.z();
+    const double x = q.x(), y = q.y();
+    const double dfx = d*fx, dfy = d*fy;
+    const double uL = dfx*x;
+    const double uR = dfx*(x - b);
+    const double v  = dfy*y;
+
+    // optimized version of the derivatives, see StereoCamera.nb
+    if (H1) {
+      const double v1 = v/fy, v2 = fx*v1, dx=d*x;
+      *H1  << uL*v1, -fx-dx*uL,     v2, -dfx,  0.0, d*uL,
+              uR*v1, -fx-dx*uR,     v2, -dfx,  0.0, d*uR,
+              fy + v*v1,    -dx*v , -x*dfy,  0.0, -dfy, d*v;
+    }
+    if (H2) {
+      *H2  << d*(fx*R(0, 0) - R(0, 2)*uL), d*(fx*R(1, 0) - R(1, 2)*uL), d*(fx*R(2, 0) - R(2, 2)*uL),
+              d*(fx*R(0, 0) - R(0, 2)*uR), d*(fx*R(1, 0) - R(1, 2)*uR), d*(fx*R(2, 0) - R(2, 2)*uR),
+              d*(fy*R(0, 1) - R(0, 2)*v ), d*(fy*R(1, 1) - R(1, 2)*v ), d*(fy*R(2, 1) - R(2, 2)*v );
+    }
+
+    // finally translate
+    return StereoPoint2(K.px() + uL, K.px() + uR, K.py() + v);
+  }
+
   /// back-project a measurement
   Point3 backproject(const StereoPoint2& z) const;
 
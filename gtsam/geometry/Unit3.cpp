@@ -65,23 +65,31 @@ Unit3 Unit3::Random(boost::mt19937 & rng) {
 }
 
 /* ************************************************************************* */
-const Matrix32& Unit3::basis(OptionalJacobian<6, 2> H) const {
-#ifdef GTSAM_USE_TBB
-  // NOTE(hayk): At some point it seemed like this reproducably resulted in deadlock. However, I
-  // can't see the reason why and I can no longer reproduce it. It may have been a red herring, or
-  // there is still a latent bug to watch out for.
-  tbb::mutex::scoped_lock lock(B_mutex_);
-#endif
-
-  // Return cached basis if available and the Jacobian isn't needed.
-  if (B_ && !H) {
-    return *B_;
+template<class MATRIX>
+void Unit3::Publish(boost::atomic<int>& state, MATRIX& cache, const MATRIX& value) {
+  // Threads racing to fill the cache computed the same value, so only the first one copies it
+  int expected = EMPTY;
+  if (state.compare_exchange_strong(expected, WRITING, boost::memory_order_acquire)) {
+    cache = value;
+    state.store(CACHED, boost::memory_order_release);
+  } else {
+    while (state.load(boost::memory_order_acquire) != CACHED) {
+    }
   }
+}
 
-  // Return cached basis and derivatives if available.
-  if (B_ && H && H_B_) {
-    *H = *H_B_;
-    return *B_;
+/* ************************************************************************* */
+const Matrix32& Unit3::basis(OptionalJacobian<6, 2> H) const {
+  // Return cached basis if available and the Jacobian isn't needed.
+  if (B_state_.load(boost::memory_order_acquire) == CACHED) {
+    if (!H)
+      return B_;
+
+    // Return cached basis and derivatives if available.
+    if (H_B_state_.load(boost::memory_order_acquire) == CACHED) {
+      *H = H_B_;
+      return B_;
+    }
   }
 
   // Get the unit vector and derivative wrt this.
@@ -116,22 +124,24 @@ const Matrix32& Unit3::basis(OptionalJacobian<6, 2> H) const {
   Point3 b2 = n.cross(b1, H ? &H_b2_n : 0, H ? &H_b2_b1 : 0);
 
   // Create the basis by stacking b1 and b2.
-  B_.reset(Matrix32());
-  (*B_) << b1.x(), b2.x(), b1.y(), b2.y(), b1.z(), b2.z();
+  Matrix32 B;
+  B << b1.x(), b2.x(), b1.y(), b2.y(), b1.z(), b2.z();
+  Publish(B_state_, B_, B);
 
   if (H) {
     // Chain rule tomfoolery to compute the derivative.
-    const Matrix32& H_n_p = *B_;
+    const Matrix32& H_n_p = B;
     Matrix32 H_b1_p = H_b1_B1 * H_B1_n * H_n_p;
     Matrix32 H_b2_p = H_b2_n * H_n_p + H_b2_b1 * H_b1_p;
 
     // Cache the derivative and fill the result.
-    H_B_.reset(Matrix62());
-    (*H_B_) << H_b1_p, H_b2_p;
-    *H = *H_B_;
+    Matrix62 H_B;
+    H_B << H_b1_p, H_b2_p;
+    Publish(H_B_state_, H_B_, H_B);
+    *H = H_B;
   }
 
-  return *B_;
+  return B_;
 }
 
 /* ************************************************************************* */
@@ -26,16 +26,13 @@
 #include <gtsam/base/Matrix.h>
 #include <gtsam/dllexport.h>
 
+#include <boost/atomic.hpp>
 #include <boost/optional.hpp>
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/serialization/nvp.hpp>
 
 #include <string>
 
-#ifdef GTSAM_USE_TBB
-#include <tbb/mutex.h>
-#endif
-
 namespace gtsam {
 
 /// Represents a 3D point on a unit sphere.
@@ -43,13 +40,20 @@ class GTSAM_EXPORT Unit3 {
 
 private:
 
+  /// States of a lazily computed cache, see basis()
+  enum CacheState {
+    EMPTY, WRITING, CACHED
+  };
+
   Vector3 p_; ///< The location of the point on the unit sphere
-  mutable boost::optional<Matrix32> B_; ///< Cached basis
-  mutable boost::optional<Matrix62> H_B_; ///< Cached basis derivative
+  mutable Matrix32 B_; ///< Cached basis, valid once B_state_ is CACHED
+  mutable Matrix62 H_B_; ///< Cached basis derivative, valid once H_B_state_ is CACHED
+  mutable boost::atomic<int> B_state_; ///< CacheState of B_
+  mutable boost::atomic<int> H_B_state_; ///< CacheState of H_B_
 
-#ifdef GTSAM_USE_TBB
-  mutable tbb::mutex B_mutex_; ///< Mutex to protect the cached basis.
-#endif
+  /// Store value in cache, unless another thread is already doing so
+  template<class MATRIX>
+  static void Publish(boost::atomic<int>& state, MATRIX& cache, const MATRIX& value);
 
 public:
 
@@ -62,39 +66,42 @@ public:
 
   /// Default constructor
   Unit3() :
-      p_(1.0, 0.0, 0.0) {
+      p_(1.0, 0.0, 0.0), B_state_(EMPTY), H_B_state_(EMPTY) {
   }
 
   /// Construct from point
   explicit Unit3(const Point3& p) :
-      p_(p.vector().normalized()) {
+      p_(p.vector().normalized()), B_state_(EMPTY), H_B_state_(EMPTY) {
   }
 
   /// Construct from a vector3
   explicit Unit3(const Vector3& p) :
-      p_(p.normalized()) {
+      p_(p.normalized()), B_state_(EMPTY), H_B_state_(EMPTY) {
   }
 
   /// Construct from x,y,z
   Unit3(double x, double y, double z) :
-      p_(x, y, z) {
+      p_(x, y, z), B_state_(EMPTY), H_B_state_(EMPTY) {
     p_.normalize();
   }
 
   /// Construct from 2D point in plane at focal length f
   /// Unit3(p,1) can be viewed as normalized homogeneous coordinates of 2D point
-  explicit Unit3(const Point2& p, double f = 1.0) : p_(p.x(), p.y(), f) {
+  explicit Unit3(const Point2& p, double f = 1.0) :
+      p_(p.x(), p.y(), f), B_state_(EMPTY), H_B_state_(EMPTY) {
     p_.normalize();
   }
 
-  /// Copy constructor
-  Unit3(const Unit3& u) {
-    p_ = u.p_;
+  /// Copy constructor, the cached basis is not copied
+  Unit3(const Unit3& u) :
+      p_(u.p_), B_state_(EMPTY), H_B_state_(EMPTY) {
   }
 
-  /// Copy assignment
+  /// Copy assignment, clears the cached basis
   Unit3& operator=(const Unit3 & u) {
     p_ = u.p_;
+    B_state_.store(EMPTY);
+    H_B_state_.store(EMPTY);
     return *this;
   }
 
@@ -129,6 +136,11 @@ public:
    * It is a 3*2 matrix [b1 b2] composed of two orthogonal directions
    * tangent to the sphere at the current direction.
    * Provides derivatives of the basis with the two basis vectors stacked up as a 6x1.
+   *
+   * Both are computed on the first call that needs them and cached without a lock: the first
+   * thread to finish publishes its result with an atomic flag, and once published a call is a
+   * single atomic load.  Concurrent first calls compute the same values and do not block each
+   * other, except for the few nanoseconds in which the result is copied into the cache.
    */
   const Matrix32& basis(OptionalJacobian<6, 2> H = boost::none) const;
 
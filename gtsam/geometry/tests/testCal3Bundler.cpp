@@ -76,6 +76,23 @@ TEST( Cal3Bundler, Duncalibrate)
   CHECK(assert_equal(Dcombined,K.D2d_intrinsic_calibration(p),1e-7));
 }
 
+/* ************************************************************************* */
+TEST( Cal3Bundler, uncalibrateBatch)
+{
+  Matrix points(3, 2);
+  points << 2.0, 3.0, -0.5, 0.25, 0.0, 0.0;
+  Matrix Dcal, Dp;
+  Matrix actual = K.uncalibrateBatch(points, &Dcal, &Dp);
+  for (size_t i = 0; i < 3; i++) {
+    Matrix23 expectedDcal;
+    Matrix2 expectedDp;
+    Point2 expected = K.uncalibrate(Point2(points(i, 0), points(i, 1)), expectedDcal, expectedDp);
+    CHECK(assert_equal(expected.vector(), Vector(actual.row(i).transpose()), 1e-9));
+    CHECK(assert_equal(Matrix(expectedDcal), Matrix(Dcal.block<2, 3>(2 * i, 0)), 1e-9));
+    CHECK(assert_equal(Matrix(expectedDp), Matrix(Dp.block<2, 2>(2 * i, 0)), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 TEST( Cal3Bundler, assert_equal)
 {
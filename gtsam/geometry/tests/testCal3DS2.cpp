@@ -51,6 +51,36 @@ TEST( Cal3DS2, calibrate )
   CHECK( pn.equals(pn_hat, 1e-5));
 }
 
+/* ************************************************************************* */
+TEST( Cal3DS2, calibrateBatch )
+{
+  // A calibration with visible distortion, and pixels inside and outside a 640*480 image
+  Cal3DS2 K2(500, 520, 0.1, 320, 240, -0.1, 0.02, 1e-3, -2e-3);
+  Matrix pi(5, 2);
+  pi << 320.0, 240.0, 10.0, 20.0, 633.3, 471.7, 101.5, 402.25, -15.0, 250.0;
+
+  Matrix actual = K2.calibrateBatch(pi);
+  for (size_t i = 0; i < 5; i++)
+    CHECK(assert_equal(K2.calibrate(Point2(pi(i, 0), pi(i, 1))).vector(),
+        Vector(actual.row(i).transpose()), 1e-6));
+
+  // With an undistortion grid the points are the same up to the tolerance, in copies as well
+  Cal3DS2 K3 = K2;
+  K3.precomputeUndistortion(640, 480);
+  CHECK(!K2.hasUndistortionGrid());
+  const Cal3DS2 K4 = K3;
+  CHECK(K4.hasUndistortionGrid());
+  Matrix withGrid = K4.calibrateBatch(pi);
+  for (size_t i = 0; i < 5; i++) {
+    const Point2 pn = K4.calibrate(Point2(pi(i, 0), pi(i, 1)));
+    CHECK(assert_equal(Point2(pi(i, 0), pi(i, 1)), K2.uncalibrate(pn), 1e-5));
+    CHECK(assert_equal(pn.vector(), Vector(withGrid.row(i).transpose()), 1e-6));
+  }
+
+  // Calibrations obtained by retract do not keep the grid
+  CHECK(!K4.retract(Vector9::Zero()).hasUndistortionGrid());
+}
+
 Point2 uncalibrate_(const Cal3DS2& k, const Point2& pt) { return k.uncalibrate(pt); }
 
 /* ************************************************************************* */
@@ -74,6 +104,23 @@ TEST( Cal3DS2, Duncalibrate2)
   CHECK(assert_equal(numerical,separate,1e-5));
 }
 
+/* ************************************************************************* */
+TEST( Cal3DS2, uncalibrateBatch)
+{
+  Matrix points(3, 2);
+  points << 2.0, 3.0, -0.5, 0.25, 0.0, 0.0;
+  Matrix Dcal, Dp;
+  Matrix actual = K.uncalibrateBatch(points, &Dcal, &Dp);
+  for (size_t i = 0; i < 3; i++) {
+    Matrix29 expectedDcal;
+    Matrix2 expectedDp;
+    Point2 expected = K.uncalibrate(Point2(points(i, 0), points(i, 1)), expectedDcal, expectedDp);
+    CHECK(assert_equal(expected.vector(), Vector(actual.row(i).transpose()), 1e-9));
+    CHECK(assert_equal(Matrix(expectedDcal), Matrix(Dcal.block<2, 9>(2 * i, 0)), 1e-9));
+    CHECK(assert_equal(Matrix(expectedDp), Matrix(Dp.block<2, 2>(2 * i, 0)), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 TEST( Cal3DS2, assert_equal)
 {
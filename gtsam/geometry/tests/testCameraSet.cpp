@@ -92,6 +92,13 @@ TEST(CameraSet, Pinhole) {
   SymmetricBlockMatrix actualReduced = Set::SchurComplement(Fs, E, P, b);
   EXPECT(assert_equal(schur, actualReduced.matrix()));
 
+  // Check Schur complement in place, which overwrites whatever was in the storage
+  std::vector<DenseIndex> dims(2, 9);
+  SymmetricBlockMatrix inPlace(dims, true);
+  inPlace.full().triangularView().setConstant(7.0);
+  Set::SchurComplement(Fs, E, P, b, inPlace);
+  EXPECT(assert_equal(schur, inPlace.matrix()));
+
   // Check Schur complement update, same order, should just double
   FastVector<Key> allKeys, keys;
   allKeys.push_back(1);
@@ -132,6 +139,36 @@ TEST(CameraSet, Pinhole) {
   EXPECT(assert_equal(actualE, E));
 }
 
+/* ************************************************************************* */
+// The fixed-size kernels for short tracks and the dynamic one for long tracks
+TEST(CameraSet, SchurComplementTrackLengths) {
+  typedef PinholeCamera<Cal3Bundler> Camera;
+  typedef CameraSet<Camera> Set;
+  for (size_t m = 2; m <= 9; m++) {
+    Set::FBlocks Fs(m);
+    Matrix E(2 * m, 3), F = Matrix::Zero(2 * m, 9 * m);
+    for (size_t i = 0; i < m; i++) {
+      for (int r = 0; r < 2; r++) {
+        for (int c = 0; c < 9; c++)
+          Fs[i](r, c) = sin(double(1 + i + 3 * r + 7 * c));
+        for (int c = 0; c < 3; c++)
+          E(2 * i + r, c) = cos(double((2 * i + r + 1) * (c + 1)));
+      }
+      F.block<2, 9>(2 * i, 9 * i) = Fs[i];
+    }
+    Vector b(2 * m);
+    for (size_t k = 0; k < 2 * m; k++)
+      b(k) = 0.1 * double(k) - 0.3;
+    const Matrix3 P = (E.transpose() * E).inverse();
+
+    const Matrix Ft = F.transpose(), Et = E.transpose();
+    const Vector v = Ft * (b - E * P * Et * b);
+    Matrix expected(9 * m + 1, 9 * m + 1);
+    expected << Ft * F - Ft * E * P * Et * F, v, v.transpose(), b.squaredNorm();
+    EXPECT(assert_equal(expected, Set::SchurComplement(Fs, E, P, b).matrix(), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 #include <gtsam/geometry/StereoCamera.h>
 TEST(CameraSet, Stereo) {
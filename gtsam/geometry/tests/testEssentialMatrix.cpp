@@ -220,6 +220,44 @@ TEST (EssentialMatrix, epipoles) {
   EXPECT(assert_equal(e2, E.epipole_b()));
 }
 
+//*************************************************************************
+TEST (EssentialMatrix, batch) {
+  EssentialMatrix E(Rot3::ypr(0.1, -0.2, 0.3), Unit3(0.4, 0.5, 0.6));
+
+  // Correspondences of points in front of both cameras, with some noise on vA
+  const Pose3 aPb(E.rotation(), E.direction().point3());
+  const size_t n = 1000;
+  Matrix vA(3, n), vB(3, n);
+  for (size_t i = 0; i < n; i++) {
+    const Point3 pA(sin(0.1 * i), cos(0.3 * i), 4.0 + sin(0.7 * i));
+    const Point3 pB = aPb.transform_to(pA);
+    vA.col(i) << pA.x() / pA.z(), pA.y() / pA.z(), 1.0;
+    vB.col(i) << pB.x() / pB.z(), pB.y() / pB.z(), 1.0;
+    if (i % 4 == 0)
+      vA(0, i) += 0.01 * (1.0 + i % 3);
+  }
+
+  // Algebraic errors agree with error
+  const Vector errors = E.errorBatch(vA, vB);
+  const Vector sampson = E.sampsonErrorBatch(vA, vB);
+  EXPECT_LONGS_EQUAL(n, errors.size());
+  for (size_t i = 0; i < n; i++) {
+    const Vector3 a = vA.col(i), b = vB.col(i);
+    EXPECT_DOUBLES_EQUAL(E.error(a, b), errors(i), 1e-12);
+    const Vector3 Eb = E.matrix() * b, Eta = E.matrix().transpose() * a;
+    const double expected = E.error(a, b) * E.error(a, b)
+        / (Eb.head<2>().squaredNorm() + Eta.head<2>().squaredNorm());
+    EXPECT_DOUBLES_EQUAL(expected, sampson(i), 1e-12);
+  }
+
+  // Only the perturbed correspondences are outliers
+  vector<bool> inliers;
+  EXPECT_LONGS_EQUAL(3 * n / 4, E.countInliers(vA, vB, 1e-8, &inliers));
+  EXPECT(!inliers[0] && inliers[1] && inliers[2] && inliers[3] && !inliers[4]);
+
+  CHECK_EXCEPTION(E.errorBatch(vA, vB.leftCols(3)), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -18,6 +18,7 @@
 #include <gtsam/geometry/PinholeCamera.h>
 #include <gtsam/geometry/Cal3_S2.h>
 #include <gtsam/geometry/Cal3Bundler.h>
+#include <gtsam/geometry/Cal3DS2.h>
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/base/Testable.h>
 #include <gtsam/base/numericalDerivative.h>
@@ -113,6 +114,37 @@ TEST( PinholeCamera, project)
   EXPECT(assert_equal( camera.project(point4), Point2( 100,  100) ));
 }
 
+/* ************************************************************************* */
+// Compare project2Batch with project2 of each point
+template<class CAMERA>
+bool checkProject2Batch(const CAMERA& camera, const Matrix& points) {
+  Matrix Dcamera, Dpoint;
+  const Matrix actual = camera.project2Batch(points, &Dcamera, &Dpoint);
+  bool ok = true;
+  for (DenseIndex i = 0; i < points.rows(); i++) {
+    Eigen::Matrix<double, 2, CAMERA::dimension> expectedDcamera;
+    Matrix23 expectedDpoint;
+    const Point2 expected = camera.project2(Point3(points.row(i).transpose()),
+        expectedDcamera, expectedDpoint);
+    ok = assert_equal(expected.vector(), Vector(actual.row(i).transpose()), 1e-9) && ok;
+    ok = assert_equal(Matrix(expectedDcamera), Matrix(Dcamera.middleRows(2 * i, 2)), 1e-9) && ok;
+    ok = assert_equal(Matrix(expectedDpoint), Matrix(Dpoint.middleRows(2 * i, 2)), 1e-9) && ok;
+  }
+  return ok;
+}
+
+TEST( PinholeCamera, project2Batch)
+{
+  Matrix points(4, 3);
+  points << point1.vector().transpose(), point2.vector().transpose(),
+      point3.vector().transpose(), Vector3(0.3, -0.2, 5.0).transpose();
+  EXPECT(checkProject2Batch(camera, points));
+  EXPECT(checkProject2Batch(PinholeCamera<Cal3DS2>(pose,
+      Cal3DS2(500, 100, 0.1, 320, 240, 1e-3, 2e-3, 3e-3, 4e-3)), points));
+  EXPECT(checkProject2Batch(PinholeCamera<Cal3Bundler>(pose,
+      Cal3Bundler(500, 1e-3, 1e-3, 1000, 2000)), points));
+}
+
 /* ************************************************************************* */
 TEST( PinholeCamera, backproject)
 {
@@ -99,6 +99,25 @@ TEST( PinholePose, project)
   EXPECT(assert_equal( camera.project2(point4), Point2( 100,  100) ));
 }
 
+/* ************************************************************************* */
+TEST( PinholePose, project2Batch)
+{
+  Matrix points(4, 3);
+  points << point1.vector().transpose(), point2.vector().transpose(),
+      point3.vector().transpose(), point4.vector().transpose();
+  Matrix Dpose, Dpoint;
+  const Matrix actual = camera.project2Batch(points, &Dpose, &Dpoint);
+  for (size_t i = 0; i < 4; i++) {
+    Matrix26 expectedDpose;
+    Matrix23 expectedDpoint;
+    const Point2 expected = camera.project2(Point3(points.row(i).transpose()),
+        expectedDpose, expectedDpoint);
+    EXPECT(assert_equal(expected.vector(), Vector(actual.row(i).transpose()), 1e-9));
+    EXPECT(assert_equal(Matrix(expectedDpose), Matrix(Dpose.block<2, 6>(2 * i, 0)), 1e-9));
+    EXPECT(assert_equal(Matrix(expectedDpoint), Matrix(Dpoint.block<2, 3>(2 * i, 0)), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 TEST( PinholePose, backproject)
 {
@@ -647,6 +647,23 @@ TEST( Pose2, range )
   EXPECT(assert_equal(expectedH2,actualH2));
 }
 
+/* ************************************************************************* */
+TEST( Pose2, rangeBatch )
+{
+  Matrix points(3, 2);
+  points << 1.0, 2.0, -0.5, 4.0, 0.0, 0.0;
+  Matrix Dpose, Dpoint;
+  const Vector ranges = x3.rangeBatch(points, &Dpose, &Dpoint);
+  EXPECT_LONGS_EQUAL(3, ranges.size());
+  for (size_t i = 0; i < 3; ++i) {
+    const Point2 point(points(i, 0), points(i, 1));
+    Matrix expectedH1, expectedH2;
+    EXPECT_DOUBLES_EQUAL(x3.range(point, expectedH1, expectedH2), ranges(i), 1e-9);
+    EXPECT(assert_equal(expectedH1, Matrix(Dpose.row(i)), 1e-9));
+    EXPECT(assert_equal(expectedH2, Matrix(Dpoint.row(i)), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 namespace {
   double range_pose_proxy(const Pose2& pose, const Pose2& point) {
@@ -598,6 +598,23 @@ TEST( Pose3, range )
   EXPECT(assert_equal(expectedH2,actualH2));
 }
 
+/* ************************************************************************* */
+TEST( Pose3, rangeBatch )
+{
+  Matrix points(3, 3);
+  points << 1.0, 2.0, 3.0, -0.5, 0.3, 4.0, 0.0, 0.0, 0.0;
+  Matrix Dpose, Dpoint;
+  const Vector ranges = x3.rangeBatch(points, &Dpose, &Dpoint);
+  EXPECT_LONGS_EQUAL(3, ranges.size());
+  for (size_t i = 0; i < 3; ++i) {
+    const Point3 point(points.row(i).transpose());
+    Matrix expectedH1, expectedH2;
+    EXPECT_DOUBLES_EQUAL(x3.range(point, expectedH1, expectedH2), ranges(i), 1e-9);
+    EXPECT(assert_equal(expectedH1, Matrix(Dpose.row(i)), 1e-9));
+    EXPECT(assert_equal(expectedH2, Matrix(Dpoint.row(i)), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 double range_pose_proxy(const Pose3& pose, const Pose3& point) {
   return pose.range(point);
@@ -808,6 +825,47 @@ TEST(Pose3 , ChartDerivatives) {
   }
 }
 
+/* ************************************************************************* */
+TEST(Pose3, Batch) {
+  // Includes a tangent vector small enough for the Taylor expansions
+  Matrix xi(3, 6);
+  xi << 0.1, -0.2, 0.3, 1.0, 2.0, 3.0,
+        1e-5, 2e-5, -1e-5, 0.5, -0.5, 0.2,
+        -1.2, 0.4, 0.9, -2.0, 0.1, 0.7;
+
+  Matrix H;
+  const vector<Pose3> poses = Pose3::ExpmapBatch(xi, &H);
+  EXPECT_LONGS_EQUAL(3, poses.size());
+  Matrix HLog;
+  const Matrix logs = Pose3::LogmapBatch(poses, &HLog);
+  for (size_t i = 0; i < 3; ++i) {
+    const Vector6 v = xi.row(i).transpose();
+    EXPECT(assert_equal(Pose3::Expmap(v), poses[i], 1e-9));
+    EXPECT(assert_equal(Pose3::ExpmapDerivative(v), Matrix(H.block<6, 6>(6 * i, 0)), 1e-9));
+    EXPECT(assert_equal(v, Vector(logs.row(i).transpose()), 1e-9));
+    EXPECT(assert_equal(Pose3::LogmapDerivative(poses[i]), Matrix(HLog.block<6, 6>(6 * i, 0)), 1e-9));
+  }
+
+  // Retract matches the chart at the origin
+  const Pose3* inputs[] = { &T, &T2, &T3 };
+  Pose3 retracted[3];
+  Pose3::RetractBatch(inputs, xi, retracted);
+  for (size_t i = 0; i < 3; ++i)
+    EXPECT(assert_equal(inputs[i]->retract(xi.row(i).transpose()), retracted[i], 1e-9));
+
+  // transform_to of many points
+  Matrix points(2, 3);
+  points << 1.0, 2.0, 3.0, -0.5, 0.3, 4.0;
+  Matrix Dpose;
+  const Matrix q = T.transform_to(points, &Dpose);
+  for (size_t i = 0; i < 2; ++i) {
+    Matrix36 expectedH;
+    const Point3 expected = T.transform_to(Point3(points.row(i).transpose()), expectedH);
+    EXPECT(assert_equal(expected.vector(), Vector(q.row(i).transpose()), 1e-9));
+    EXPECT(assert_equal(Matrix(expectedH), Matrix(Dpose.block<3, 6>(3 * i, 0)), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
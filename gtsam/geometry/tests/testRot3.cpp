@@ -695,6 +695,27 @@ TEST(Rot3 , ChartDerivatives) {
   }
 }
 
+/* ************************************************************************* */
+TEST(Rot3, Batch) {
+  // Includes a tangent vector small enough for the Taylor expansions
+  Matrix omega(3, 3);
+  omega << 0.1, -0.2, 0.3, 1e-5, 2e-5, -1e-5, -1.2, 0.4, 0.9;
+
+  Matrix H;
+  const vector<Rot3> R = Rot3::ExpmapBatch(omega, &H);
+  const vector<Rot3> retracted = Rot3::ChartAtOrigin::RetractBatch(omega);
+  Matrix HLog;
+  const Matrix logs = Rot3::LogmapBatch(R, &HLog);
+  for (size_t i = 0; i < 3; ++i) {
+    const Vector3 v = omega.row(i).transpose();
+    EXPECT(assert_equal(Rot3::Expmap(v), R[i], 1e-9));
+    EXPECT(assert_equal(Rot3::ExpmapDerivative(v), Matrix(H.block<3, 3>(3 * i, 0)), 1e-9));
+    EXPECT(assert_equal(Rot3::ChartAtOrigin::Retract(v), retracted[i], 1e-9));
+    EXPECT(assert_equal(v, Vector(logs.row(i).transpose()), 1e-9));
+    EXPECT(assert_equal(Rot3::LogmapDerivative(v), Matrix(HLog.block<3, 3>(3 * i, 0)), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -279,6 +279,43 @@ TEST( triangulation, onePose) {
       TriangulationUnderconstrainedException);
 }
 
+//******************************************************************************
+TEST( triangulation, tracks) {
+  // Three cameras, and landmarks seen with noise by two or three of them
+  typedef PinholeCamera<Cal3_S2> Camera;
+  vector<Camera> cameras;
+  cameras += camera1, camera2, Camera(pose1 * Pose3(Rot3::ypr(0.1, 0.2, 0.1), Point3(0, -1, 0)),
+      *sharedCal);
+
+  vector<Point3> landmarks;
+  landmarks += landmark, Point3(6, -0.5, 0.8), Point3(4, 1.0, 1.5);
+  vector<vector<TrackMeasurement> > tracks(landmarks.size() + 1);
+  for (size_t j = 0; j < landmarks.size(); j++)
+    for (size_t i = j % 2; i < cameras.size(); i++)
+      tracks[j] += make_pair(i, cameras[i].project(landmarks[j]) + Point2(0.5 * i, -0.3 * j));
+
+  // The last track has a single measurement
+  tracks.back() += make_pair(0, z1);
+
+  TriangulationParameters params(1e-9, true);
+  vector<TriangulationResult> results = triangulateTracks(cameras, tracks, params);
+  LONGS_EQUAL(4, results.size());
+  for (size_t j = 0; j < landmarks.size(); j++) {
+    vector<Camera> trackCameras;
+    vector<Point2> measured;
+    for (size_t k = 0; k < tracks[j].size(); k++) {
+      trackCameras += cameras[tracks[j][k].first];
+      measured += tracks[j][k].second;
+    }
+
+    // Gauss-Newton converges to the same point as the factor graph
+    CHECK(results[j]);
+    EXPECT(assert_equal(*triangulateSafe(trackCameras, measured, params), *results[j], 1e-5));
+    EXPECT(assert_equal(landmarks[j], *results[j], 1e-2));
+  }
+  EXPECT(results.back().degenerate());
+}
+
 //******************************************************************************
 TEST( triangulation, StereotriangulateNonlinear ) {
 
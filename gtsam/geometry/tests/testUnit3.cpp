@@ -35,6 +35,7 @@
 #include <boost/bind.hpp>
 #include <boost/foreach.hpp>
 #include <boost/random.hpp>
+#include <boost/thread/thread.hpp>
 #include <boost/assign/std/vector.hpp>
 #include <cmath>
 
@@ -344,6 +345,40 @@ TEST(Unit3, basis_derivatives) {
   }
 }
 
+//*******************************************************************************
+// Compute the basis and its derivative of every direction
+void ComputeBases(const vector<Unit3>* directions, vector<Matrix62>* H) {
+  for (size_t i = 0; i < directions->size(); i++)
+    (*directions)[i].basis((*H)[i]);
+}
+
+/// Fill the basis caches from several threads at once, and clear them on assignment
+TEST(Unit3, basis_threads) {
+  boost::mt19937 rng(42);
+  vector<Unit3> directions;
+  for (int i = 0; i < 1000; i++)
+    directions.push_back(Unit3::Random(rng));
+
+  vector<vector<Matrix62> > H(4, vector<Matrix62>(directions.size()));
+  boost::thread_group threads;
+  for (size_t t = 0; t < H.size(); t++)
+    threads.create_thread(boost::bind(&ComputeBases, &directions, &H[t]));
+  threads.join_all();
+
+  for (size_t i = 0; i < directions.size(); i++) {
+    const Unit3 fresh(directions[i].point3());
+    Matrix62 expectedH;
+    EXPECT(assert_equal(Matrix(fresh.basis(expectedH)), Matrix(directions[i].basis()), 1e-9));
+    for (size_t t = 0; t < H.size(); t++)
+      EXPECT(assert_equal(expectedH, H[t][i], 1e-9));
+  }
+
+  Unit3 p = directions[0];
+  p.basis();
+  p = directions[1];
+  EXPECT(assert_equal(Matrix(directions[1].basis()), Matrix(p.basis()), 1e-9));
+}
+
 //*******************************************************************************
 TEST(Unit3, retract) {
   {
@@ -23,6 +23,14 @@
 #include <gtsam/slam/PriorFactor.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/inference/Symbol.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <limits>
+#include <utility>
 
 namespace gtsam {
 
@@ -192,6 +200,58 @@ Point3 triangulateNonlinear(
   (cameras, measurements, initialEstimate);
 }
 
+/**
+ * Given an initial estimate, refine a point using measurements in several monocular cameras,
+ * with Gauss-Newton on the 3*3 normal equations of the reprojection errors.  This minimizes
+ * the same error as triangulateNonlinear, without building a factor graph.
+ * Stops when the step is smaller than tol, or when a step increases the error, in which case
+ * the point before that step is returned.
+ * @param cameras pinhole cameras
+ * @param measurements 2D measurements
+ * @param initialEstimate
+ * @param maxIterations maximum number of Gauss-Newton steps
+ * @param tol threshold on the norm of the step
+ * @return refined Point3
+ */
+template<class CAMERA>
+Point3 triangulateGaussNewton(const std::vector<CAMERA>& cameras,
+    const std::vector<Point2>& measurements, const Point3& initialEstimate,
+    size_t maxIterations = 10, double tol = 1e-9) {
+
+  Point3 point = initialEstimate, previous = initialEstimate;
+  double previousError = std::numeric_limits<double>::infinity();
+  for (size_t iteration = 0; iteration < maxIterations; iteration++) {
+
+    // Accumulate the normal equations of all reprojection errors
+    Matrix3 H = Matrix3::Zero();
+    Vector3 g = Vector3::Zero();
+    double error = 0.0;
+    for (size_t i = 0; i < cameras.size(); i++) {
+      Matrix23 Dpoint;
+      const Vector2 e = (cameras[i].project2(point, boost::none, Dpoint)
+          - measurements[i]).vector();
+      H.noalias() += Dpoint.transpose() * Dpoint;
+      g.noalias() += Dpoint.transpose() * e;
+      error += e.squaredNorm();
+    }
+
+    // Undo the last step if it made things worse
+    if (error > previousError)
+      return previous;
+    previous = point;
+    previousError = error;
+
+    const Eigen::LDLT<Matrix3> ldlt(H);
+    if (ldlt.info() != Eigen::Success)
+      break;
+    const Vector3 delta = -ldlt.solve(g);
+    point = point + delta;
+    if (delta.norm() < tol)
+      break;
+  }
+  return point;
+}
+
 /**
  * Create a 3*4 camera projection matrix from calibration and pose.
  * Functor for partial application on calibration
@@ -403,6 +463,45 @@ public:
   }
 };
 
+namespace internal {
+/// Check landmark distance and re-projection errors of a triangulated point, see triangulateSafe
+template<class CAMERA>
+TriangulationResult checkTriangulation(const std::vector<CAMERA>& cameras,
+    const std::vector<Point2>& measured, const Point3& point,
+    const TriangulationParameters& params) {
+  size_t i = 0;
+  double totalReprojError = 0.0;
+  BOOST_FOREACH(const CAMERA& camera, cameras) {
+    const Pose3& pose = camera.pose();
+    if (params.landmarkDistanceThreshold > 0
+        && pose.translation().distance(point)
+            > params.landmarkDistanceThreshold)
+      return TriangulationResult::Degenerate();
+#ifdef GTSAM_THROW_CHEIRALITY_EXCEPTION
+    // verify that the triangulated point lies in front of all cameras
+    // Only needed if this was not yet handled by exception
+    const Point3& p_local = pose.transform_to(point);
+    if (p_local.z() <= 0)
+      return TriangulationResult::BehindCamera();
+#endif
+    // Check reprojection error
+    if (params.dynamicOutlierRejectionThreshold > 0) {
+      const Point2& zi = measured.at(i);
+      Point2 reprojectionError(camera.project(point) - zi);
+      totalReprojError += reprojectionError.vector().norm();
+    }
+    i += 1;
+  }
+  // Flag as degenerate if average reprojection error is too large
+  if (params.dynamicOutlierRejectionThreshold > 0
+      && totalReprojError / cameras.size() > params.dynamicOutlierRejectionThreshold)
+    return TriangulationResult::Degenerate();
+
+  // all good!
+  return TriangulationResult(point);
+}
+}
+
 /// triangulateSafe: extensive checking of the outcome
 template<class CAMERA>
 TriangulationResult triangulateSafe(const std::vector<CAMERA>& cameras,
@@ -421,36 +520,7 @@ TriangulationResult triangulateSafe(const std::vector<CAMERA>& cameras,
           params.rankTolerance, params.enableEPI);
 
       // Check landmark distance and re-projection errors to avoid outliers
-      size_t i = 0;
-      double totalReprojError = 0.0;
-      BOOST_FOREACH(const CAMERA& camera, cameras) {
-        const Pose3& pose = camera.pose();
-        if (params.landmarkDistanceThreshold > 0
-            && pose.translation().distance(point)
-                > params.landmarkDistanceThreshold)
-          return TriangulationResult::Degenerate();
-#ifdef GTSAM_THROW_CHEIRALITY_EXCEPTION
-        // verify that the triangulated point lies in front of all cameras
-        // Only needed if this was not yet handled by exception
-        const Point3& p_local = pose.transform_to(point);
-        if (p_local.z() <= 0)
-          return TriangulationResult::BehindCamera();
-#endif
-        // Check reprojection error
-        if (params.dynamicOutlierRejectionThreshold > 0) {
-          const Point2& zi = measured.at(i);
-          Point2 reprojectionError(camera.project(point) - zi);
-          totalReprojError += reprojectionError.vector().norm();
-        }
-        i += 1;
-      }
-      // Flag as degenerate if average reprojection error is too large
-      if (params.dynamicOutlierRejectionThreshold > 0
-          && totalReprojError / m > params.dynamicOutlierRejectionThreshold)
-        return TriangulationResult::Degenerate();
-
-      // all good!
-      return TriangulationResult(point);
+      return internal::checkTriangulation(cameras, measured, point, params);
     } catch (TriangulationUnderconstrainedException&) {
       // This exception is thrown if
       // 1) There is a single pose for triangulation - this should not happen because we checked the number of poses before
@@ -462,5 +532,104 @@ TriangulationResult triangulateSafe(const std::vector<CAMERA>& cameras,
     }
 }
 
+/// A measurement of a track: the index of the camera and the 2D measurement, as in SfM_Track
+typedef std::pair<size_t, Point2> TrackMeasurement;
+
+namespace internal {
+/// Triangulate tracks [first, last), see triangulateTracks
+template<class CAMERA>
+void triangulateTrackRange(const std::vector<CAMERA>& cameras,
+    const std::vector<Matrix34>& projection_matrices,
+    const std::vector<std::vector<TrackMeasurement> >& tracks,
+    const TriangulationParameters& params, std::vector<TriangulationResult>& results,
+    size_t first, size_t last) {
+  std::vector<CAMERA> trackCameras;
+  std::vector<Matrix34> trackProjections;
+  std::vector<Point2> measured;
+  for (size_t j = first; j < last; j++) {
+    trackCameras.clear();
+    trackProjections.clear();
+    measured.clear();
+    BOOST_FOREACH(const TrackMeasurement& measurement, tracks[j]) {
+      trackCameras.push_back(cameras.at(measurement.first));
+      trackProjections.push_back(projection_matrices[measurement.first]);
+      measured.push_back(measurement.second);
+    }
+    if (measured.size() < 2) {
+      results[j] = TriangulationResult::Degenerate();
+      continue;
+    }
+    try {
+      Point3 point = triangulateDLT(trackProjections, measured, params.rankTolerance);
+      if (params.enableEPI)
+        point = triangulateGaussNewton(trackCameras, measured, point);
+      results[j] = checkTriangulation(trackCameras, measured, point, params);
+    } catch (TriangulationUnderconstrainedException&) {
+      results[j] = TriangulationResult::Degenerate();
+    } catch (CheiralityException&) {
+      results[j] = TriangulationResult::BehindCamera();
+    }
+  }
+}
+
+#ifdef GTSAM_USE_TBB
+template<class CAMERA>
+class TriangulateTracks {
+  const std::vector<CAMERA>& cameras_;
+  const std::vector<Matrix34>& projection_matrices_;
+  const std::vector<std::vector<TrackMeasurement> >& tracks_;
+  const TriangulationParameters& params_;
+  std::vector<TriangulationResult>& results_;
+public:
+  TriangulateTracks(const std::vector<CAMERA>& cameras,
+      const std::vector<Matrix34>& projection_matrices,
+      const std::vector<std::vector<TrackMeasurement> >& tracks,
+      const TriangulationParameters& params, std::vector<TriangulationResult>& results) :
+      cameras_(cameras), projection_matrices_(projection_matrices), tracks_(tracks),
+      params_(params), results_(results) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    triangulateTrackRange(cameras_, projection_matrices_, tracks_, params_, results_,
+        blocked_range.begin(), blocked_range.end());
+  }
+};
+#endif
+}
+
+/**
+ * Triangulate many tracks at once, in parallel when GTSAM is built with TBB.  Each track is
+ * handled as by triangulateSafe, except that the projection matrices are computed once per
+ * camera, and that if params.enableEPI the DLT result is refined with triangulateGaussNewton
+ * instead of with a factor graph.
+ * @param cameras all monocular pinhole cameras
+ * @param tracks the measurements of each landmark, with indices into cameras, e.g. the
+ *        measurements of SfM_Tracks
+ * @param params checks on the outcome, as in triangulateSafe
+ * @return one TriangulationResult per track
+ */
+template<class CAMERA>
+std::vector<TriangulationResult> triangulateTracks(const std::vector<CAMERA>& cameras,
+    const std::vector<std::vector<TrackMeasurement> >& tracks,
+    const TriangulationParameters& params = TriangulationParameters()) {
+
+  // construct projection matrices from poses & calibration, once for all tracks
+  std::vector<Matrix34> projection_matrices;
+  projection_matrices.reserve(cameras.size());
+  BOOST_FOREACH(const CAMERA& camera, cameras)
+    projection_matrices.push_back(
+        CameraProjectionMatrix<typename CAMERA::CalibrationType>(camera.calibration())(
+            camera.pose()));
+
+  std::vector<TriangulationResult> results(tracks.size(), TriangulationResult::Degenerate());
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, tracks.size()),
+      internal::TriangulateTracks<CAMERA>(cameras, projection_matrices, tracks, params, results));
+#else
+  internal::triangulateTrackRange(cameras, projection_matrices, tracks, params, results, 0,
+      tracks.size());
+#endif
+  return results;
+}
+
 } // \namespace gtsam
 
@@ -165,7 +165,8 @@ namespace gtsam {
      *  solution may be directly obtained by calling .solve() on the returned object.
      *  Alternatively, it may be directly used as its factor base class.  For example, for Gaussian
      *  systems, this returns a GaussianConditional, which inherits from JacobianFactor and
-     *  GaussianFactor. */
+     *  GaussianFactor.  Marginals may be computed from several threads at once, as long as the
+     *  tree is not modified meanwhile: they share the cached separator marginals. */
     sharedConditional marginalFactor(Key j, const Eliminate& function = EliminationTraitsType::DefaultEliminate) const;
 
     /**
@@ -17,8 +17,10 @@
 #pragma once
 
 #include <gtsam/inference/BayesTreeCliqueBase.h>
+#include <gtsam/inference/eliminationCost.h>
 #include <gtsam/base/timing.h>
 #include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
 
 namespace gtsam {
 
@@ -88,11 +90,27 @@ namespace gtsam {
     return size;
   }
 
+  /* ************************************************************************* */
+  template<class DERIVED, class FACTORGRAPH>
+  double BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::estimatedCost() const {
+    if (!conditional_)
+      return 0.0;
+    double frontalDim = 0.0, separatorDim = 0.0;
+    for (typename ConditionalType::const_iterator key = conditional_->begin();
+        key != conditional_->end(); ++key) {
+      if (key < conditional_->endFrontals())
+        frontalDim += double(scalarDimension(*conditional_, key));
+      else
+        separatorDim += double(scalarDimension(*conditional_, key));
+    }
+    return eliminationFlops(frontalDim, separatorDim);
+  }
+
   /* ************************************************************************* */
   template<class DERIVED, class FACTORGRAPH>
   size_t BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::numCachedSeparatorMarginals() const
   {
-    if (!cachedSeparatorMarginal_)
+    if (!boost::atomic_load(&cachedSeparatorMarginal_))
       return 0;
 
     size_t subtree_count = 1;
@@ -146,16 +164,17 @@ namespace gtsam {
     BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::separatorMarginal(Eliminate function) const
   {
     gttic(BayesTreeCliqueBase_separatorMarginal);
-    // Check if the Separator marginal was already calculated
-    if (!cachedSeparatorMarginal_)
+    // Check if the Separator marginal was already calculated.  Threads that miss the cache at the
+    // same time compute the same marginal, and the last one to finish publishes its copy.
+    boost::shared_ptr<const FactorGraphType> cached = boost::atomic_load(&cachedSeparatorMarginal_);
+    if (!cached)
     {
       gttic(BayesTreeCliqueBase_separatorMarginal_cachemiss);
       // If this is the root, there is no separator
       if (parent_.expired() /*(if we're the root)*/)
       {
         // we are root, return empty
-        FactorGraphType empty;
-        cachedSeparatorMarginal_ = empty;
+        cached = boost::make_shared<const FactorGraphType>();
       }
       else
       {
@@ -172,12 +191,14 @@ namespace gtsam {
 
         // The variables we want to keepSet are exactly the ones in S
         FastVector<Key> indicesS(this->conditional()->beginParents(), this->conditional()->endParents());
-        cachedSeparatorMarginal_ = *p_Cp.marginalMultifrontalBayesNet(Ordering(indicesS), boost::none, function);
+        cached = boost::make_shared<const FactorGraphType>(
+          *p_Cp.marginalMultifrontalBayesNet(Ordering(indicesS), boost::none, function));
       }
+      boost::atomic_store(&cachedSeparatorMarginal_, cached);
     }
 
     // return the shortcut P(S||B)
-    return *cachedSeparatorMarginal_; // return the cached version
+    return *cached; // return the cached version
   }
 
   /* ************************************************************************* */
@@ -203,13 +224,13 @@ namespace gtsam {
     // When a shortcut is requested, all of the shortcuts between it and the
     // root are also generated. So, if this clique's cached shortcut is set,
     // recursively call over all child cliques. Otherwise, it is unnecessary.
-    if (cachedSeparatorMarginal_) {
+    if (boost::atomic_load(&cachedSeparatorMarginal_)) {
       BOOST_FOREACH(derived_ptr& child, children) {
         child->deleteCachedShortcuts();
       }
 
       //Delete CachedShortcut for this clique
-      cachedSeparatorMarginal_ = boost::none;
+      deleteCachedShortcutsNonRecursive();
     }
 
   }
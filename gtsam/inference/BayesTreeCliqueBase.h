@@ -18,6 +18,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
 #include <gtsam/base/types.h>
 #include <gtsam/base/FastVector.h>
 
@@ -37,6 +38,10 @@ namespace gtsam {
    * the derived type.  This is possible because all cliques in a BayesTree are the same type - if
    * they were not then we'd need a virtual class.
    *
+   * Queries such as separatorMarginal(), marginal2() and shortcut() may be run concurrently on a
+   * tree that is not being modified.  The separator marginals are computed once and published
+   * atomically, so concurrent queries share them without locking.
+   *
    * @tparam DERIVED The derived clique type.
    * @tparam CONDITIONAL The conditional type.
    * \nosubgrouping */
@@ -73,8 +78,9 @@ namespace gtsam {
 
     /// @}
 
-    /// This stores the Cached separator margnal P(S)
-    mutable boost::optional<FactorGraphType> cachedSeparatorMarginal_;
+    /// This stores the Cached separator margnal P(S).  It is never modified once created, and is
+    /// only read and replaced with boost::atomic_load and boost::atomic_store.
+    mutable boost::shared_ptr<const FactorGraphType> cachedSeparatorMarginal_;
 
   public:
     sharedConditional conditional_;
@@ -118,6 +124,10 @@ namespace gtsam {
     /** Problem size (used for parallel traversal) */
     int problemSize() const { return problemSize_; }
 
+    /** Estimated flop count of the dense operations on this clique, from the dimensions of its
+     *  frontal and separator variables (used to schedule parallel traversal) */
+    double estimatedCost() const;
+
     /// @}
     /// @name Advanced Interface
     /// @{
@@ -137,8 +147,13 @@ namespace gtsam {
      */
     void deleteCachedShortcuts();
 
-    const boost::optional<FactorGraphType>& cachedSeparatorMarginal() const {
-      return cachedSeparatorMarginal_; }
+    /** The cached separator marginal P(S), if it was computed */
+    boost::optional<FactorGraphType> cachedSeparatorMarginal() const {
+      boost::shared_ptr<const FactorGraphType> cached = boost::atomic_load(&cachedSeparatorMarginal_);
+      if (cached)
+        return *cached;
+      return boost::none;
+    }
 
     friend class BayesTree<DerivedType>;
 
@@ -153,7 +168,8 @@ namespace gtsam {
     FastVector<Key> shortcut_indices(const derived_ptr& B, const FactorGraphType& p_Cp_B) const;
 
     /** Non-recursive delete cached shortcuts and marginals - internal only. */
-    void deleteCachedShortcutsNonRecursive() { cachedSeparatorMarginal_ = boost::none; }
+    void deleteCachedShortcutsNonRecursive() {
+      boost::atomic_store(&cachedSeparatorMarginal_, boost::shared_ptr<const FactorGraphType>()); }
 
   private:
 
@@ -10,14 +10,58 @@
 #include <gtsam/inference/ClusterTree.h>
 #include <gtsam/inference/BayesTree.h>
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/eliminationCost.h>
+#include <gtsam/base/BlockMatrixArena.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/base/treeTraversal-inst.h>
 
+#include <boost/atomic.hpp>
 #include <boost/foreach.hpp>
 #include <boost/bind.hpp>
 
 namespace gtsam {
 
+namespace internal {
+/* ************************************************************************* */
+// Running estimate of the memory of the intermediate factors of an elimination, and its peak.
+// Updated concurrently by the post-order visitors when eliminating in parallel.
+struct EliminationMemory {
+  boost::atomic<size_t> current;
+  boost::atomic<size_t> peak;
+
+  EliminationMemory() : current(0), peak(0) {}
+
+  void add(size_t bytes) {
+    const size_t now = current.fetch_add(bytes) + bytes;
+    size_t previous = peak.load();
+    while (now > previous && !peak.compare_exchange_weak(previous, now)) {}
+  }
+
+  void remove(size_t bytes) { current.fetch_sub(bytes); }
+};
+
+// Estimated dense storage of a factor, see denseFactorBytes
+template<class FACTOR>
+size_t factorDenseBytes(const FACTOR& factor) {
+  size_t dim = 0;
+  for (typename FACTOR::const_iterator key = factor.begin(); key != factor.end(); ++key)
+    dim += scalarDimension(factor, key);
+  return denseFactorBytes(dim);
+}
+
+// Collect the scalar dimension of the variables of some factors
+template<class FACTOR>
+void collectDims(const FastVector<boost::shared_ptr<FACTOR> >& factors,
+    FastMap<Key, size_t>& dims) {
+  BOOST_FOREACH(const boost::shared_ptr<FACTOR>& factor, factors) {
+    if (!factor)
+      continue;
+    for (typename FACTOR::const_iterator key = factor->begin(); key != factor->end(); ++key)
+      dims.insert(std::make_pair(*key, scalarDimension(*factor, key)));
+  }
+}
+}
+
 /* ************************************************************************* */
 // Elimination traversal data - stores a pointer to the parent data and collects
 // the factors resulting from elimination of the children.  Also sets up BayesTree
@@ -66,25 +110,46 @@ struct EliminationData {
   class EliminationPostOrderVisitor {
     const typename CLUSTERTREE::Eliminate& eliminationFunction_;
     typename CLUSTERTREE::BayesTreeType::Nodes& nodesIndex_;
+    internal::EliminationMemory* memory_; // Null if the memory is not reported
 
   public:
     // Construct functor
     EliminationPostOrderVisitor(
         const typename CLUSTERTREE::Eliminate& eliminationFunction,
-        typename CLUSTERTREE::BayesTreeType::Nodes& nodesIndex) :
-        eliminationFunction_(eliminationFunction), nodesIndex_(nodesIndex) {
+        typename CLUSTERTREE::BayesTreeType::Nodes& nodesIndex,
+        internal::EliminationMemory* memory = 0) :
+        eliminationFunction_(eliminationFunction), nodesIndex_(nodesIndex), memory_(memory) {
     }
 
     // Function that does the HEAVY lifting
     void operator()(const typename CLUSTERTREE::sharedNode& node,
         EliminationData& myData) {
       assert(node);
+      gttic(Cluster_eliminate);
 
-      // Gather factors
+      // Gather factors.  The gathered graph takes over the remaining factors of the children, so
+      // that they are freed as soon as this clique is eliminated.
       FactorGraphType gatheredFactors;
       gatheredFactors.reserve(node->factors.size() + node->children.size());
       gatheredFactors += node->factors;
       gatheredFactors += myData.childFactors;
+      size_t childBytes = 0, jointBytes = 0;
+      if (memory_) {
+        typedef FastMap<Key, size_t> Dims;
+        Dims dims;
+        internal::collectDims(node->factors, dims);
+        internal::collectDims(myData.childFactors, dims);
+        size_t dim = 0;
+        BOOST_FOREACH(const Dims::value_type& keyDim, dims)
+          dim += keyDim.second;
+        jointBytes = denseFactorBytes(dim);
+        BOOST_FOREACH(const sharedFactor& factor, myData.childFactors) {
+          if (factor)
+            childBytes += internal::factorDenseBytes(*factor);
+        }
+        memory_->add(jointBytes);
+      }
+      FastVector<sharedFactor>().swap(myData.childFactors);
 
       // Check for Bayes tree orphan subtrees, and add them to our children
       BOOST_FOREACH(const sharedFactor& f, node->factors) {
@@ -101,6 +166,14 @@ struct EliminationData {
           eliminationFunction_(gatheredFactors, node->orderedFrontalKeys);
       // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
+      // Release the gathered factors before the result is stored
+      gatheredFactors.resize(0);
+      if (memory_) {
+        memory_->remove(childBytes + jointBytes);
+        if (!eliminationResult.second->empty())
+          memory_->add(internal::factorDenseBytes(*eliminationResult.second));
+      }
+
       // Store conditional in BayesTree clique, and in the case of ISAM2Clique also store the remaining factor
       myData.bayesTreeNode->setEliminationResult(eliminationResult);
 
@@ -118,6 +191,79 @@ struct EliminationData {
   };
 };
 
+/* ************************************************************************* */
+// Cost estimate traversal data - collects the separators of the children, and the memory of
+// their remaining factors.
+template<class CLUSTERTREE>
+struct CostEstimateData {
+  CostEstimateData* const parentData;
+  KeySet childSeparators;
+  size_t childBytes;
+
+  CostEstimateData(CostEstimateData* _parentData) : parentData(_parentData), childBytes(0) {}
+
+  static CostEstimateData PreOrderVisitor(const typename CLUSTERTREE::sharedNode&,
+      CostEstimateData& parentData) {
+    return CostEstimateData(&parentData);
+  }
+
+  // Post-order visitor - computes the separator and dimensions of the clique as it would be
+  // eliminated, and accumulates its cost and the memory of a serial elimination.
+  class PostOrderVisitor {
+    EliminationCostEstimate& estimate_;
+    FastMap<Key, size_t>& dims_; // Dimension of the variables seen so far
+    size_t& pendingBytes_; // Remaining factors waiting for their parent
+
+  public:
+    PostOrderVisitor(EliminationCostEstimate& estimate, FastMap<Key, size_t>& dims,
+        size_t& pendingBytes) :
+        estimate_(estimate), dims_(dims), pendingBytes_(pendingBytes) {
+    }
+
+    void operator()(const typename CLUSTERTREE::sharedNode& node, CostEstimateData& myData) {
+      typedef typename CLUSTERTREE::sharedFactor sharedFactor;
+      typedef typename CLUSTERTREE::FactorType FactorType;
+      KeySet separator;
+      separator.swap(myData.childSeparators);
+      BOOST_FOREACH(const sharedFactor& factor, node->factors) {
+        if (!factor)
+          continue;
+        for (typename FactorType::const_iterator key = factor->begin(); key != factor->end(); ++key) {
+          dims_.insert(std::make_pair(*key, scalarDimension(*factor, key)));
+          separator.insert(*key);
+        }
+      }
+      // Frontal variables only in the separators of the children are known from there, and
+      // variables in no factor at all count as scalars
+      size_t frontalDim = 0, separatorDim = 0;
+      BOOST_FOREACH(Key key, node->orderedFrontalKeys) {
+        FastMap<Key, size_t>::const_iterator dim = dims_.find(key);
+        frontalDim += dim == dims_.end() ? 1 : dim->second;
+        separator.erase(key);
+      }
+      BOOST_FOREACH(Key key, separator)
+        separatorDim += dims_.at(key);
+
+      estimate_.flops += eliminationFlops(double(frontalDim), double(separatorDim));
+      estimate_.rNonzeros += frontalDim * (frontalDim + 1) / 2 + frontalDim * separatorDim;
+      estimate_.largestClique = std::max(estimate_.largestClique, frontalDim + separatorDim);
+      ++estimate_.nrCliques;
+      estimate_.bayesTreeBytes += frontalDim * (frontalDim + separatorDim + 1) * sizeof(double);
+      estimate_.peakBytes = std::max(estimate_.peakBytes, estimate_.bayesTreeBytes + pendingBytes_
+          + denseFactorBytes(frontalDim + separatorDim));
+
+      // The remaining factors of the children are replaced by the one of this clique
+      pendingBytes_ -= myData.childBytes;
+      if (!separator.empty()) {
+        const size_t bytes = denseFactorBytes(separatorDim);
+        pendingBytes_ += bytes;
+        myData.parentData->childBytes += bytes;
+        myData.parentData->childSeparators.insert(separator.begin(), separator.end());
+      }
+    }
+  };
+};
+
 /* ************************************************************************* */
 template<class BAYESTREE, class GRAPH>
 void ClusterTree<BAYESTREE, GRAPH>::Cluster::print(const std::string& s,
@@ -126,6 +272,34 @@ void ClusterTree<BAYESTREE, GRAPH>::Cluster::print(const std::string& s,
   PrintKeyVector(orderedFrontalKeys);
 }
 
+/* ************************************************************************* */
+template<class BAYESTREE, class GRAPH>
+double ClusterTree<BAYESTREE, GRAPH>::Cluster::estimatedCost() const {
+  // Scalar dimension of every variable of the cluster, variables only in the children's
+  // separators are unknown here
+  typedef FastMap<Key, size_t> Dims;
+  Dims dims;
+  BOOST_FOREACH(const sharedFactor& factor, factors) {
+    if (!factor)
+      continue;
+    for (typename FactorType::const_iterator key = factor->begin(); key != factor->end(); ++key)
+      dims.insert(std::make_pair(*key, scalarDimension(*factor, key)));
+  }
+  double frontalDim = 0.0, separatorDim = 0.0;
+  BOOST_FOREACH(Key key, orderedFrontalKeys) {
+    typename Dims::iterator dim = dims.find(key);
+    if (dim == dims.end()) {
+      frontalDim += 1.0;
+    } else {
+      frontalDim += double(dim->second);
+      dims.erase(dim);
+    }
+  }
+  BOOST_FOREACH(const typename Dims::value_type& dim, dims)
+    separatorDim += double(dim.second);
+  return eliminationFlops(frontalDim, separatorDim);
+}
+
 /* ************************************************************************* */
 template<class BAYESTREE, class GRAPH>
 void ClusterTree<BAYESTREE, GRAPH>::Cluster::mergeChildren(
@@ -201,22 +375,29 @@ ClusterTree<BAYESTREE, GRAPH>& ClusterTree<BAYESTREE, GRAPH>::operator=(
 /* ************************************************************************* */
 template<class BAYESTREE, class GRAPH>
 std::pair<boost::shared_ptr<BAYESTREE>, boost::shared_ptr<GRAPH> > ClusterTree<
-    BAYESTREE, GRAPH>::eliminate(const Eliminate& function) const {
+    BAYESTREE, GRAPH>::eliminate(const Eliminate& function, size_t* peakBytes) const {
   gttic(ClusterTree_eliminate);
+  // Recycle the storage of intermediate dense factors, if enabled
+  BlockMatrixArena::Scope arenaScope;
+
   // Do elimination (depth-first traversal).  The rootsContainer stores a 'dummy' BayesTree node
   // that contains all of the roots as its children.  rootsContainer also stores the remaining
   // uneliminated factors passed up from the roots.
   boost::shared_ptr<BayesTreeType> result = boost::make_shared<BayesTreeType>();
   typedef EliminationData<This> Data;
   Data rootsContainer(0, roots_.size());
+  internal::EliminationMemory memory;
   typename Data::EliminationPostOrderVisitor visitorPost(function,
-      result->nodes_);
+      result->nodes_, peakBytes ? &memory : 0);
   {
     TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
     treeTraversal::DepthFirstForestParallel(*this, rootsContainer,
-        Data::EliminationPreOrderVisitor, visitorPost, 10);
+        Data::EliminationPreOrderVisitor, visitorPost);
   }
 
+  if (peakBytes)
+    *peakBytes = memory.peak;
+
   // Create BayesTree from roots stored in the dummy BayesTree node.
   result->roots_.insert(result->roots_.end(),
       rootsContainer.bayesTreeNode->children.begin(),
@@ -236,4 +417,18 @@ std::pair<boost::shared_ptr<BAYESTREE>, boost::shared_ptr<GRAPH> > ClusterTree<
   return std::make_pair(result, remaining);
 }
 
+/* ************************************************************************* */
+template<class BAYESTREE, class GRAPH>
+EliminationCostEstimate ClusterTree<BAYESTREE, GRAPH>::estimateCost() const {
+  gttic(ClusterTree_estimateCost);
+  EliminationCostEstimate estimate;
+  FastMap<Key, size_t> dims;
+  size_t pendingBytes = 0;
+  typedef CostEstimateData<This> Data;
+  Data rootsContainer(0);
+  typename Data::PostOrderVisitor visitorPost(estimate, dims, pendingBytes);
+  treeTraversal::DepthFirstForest(*this, rootsContainer, Data::PreOrderVisitor, visitorPost);
+  return estimate;
+}
+
 }
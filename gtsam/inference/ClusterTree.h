@@ -12,6 +12,7 @@
 #include <gtsam/base/Testable.h>
 #include <gtsam/base/FastVector.h>
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/eliminationCost.h>
 
 namespace gtsam {
 
@@ -55,6 +56,11 @@ public:
       return problemSize_;
     }
 
+    /** Estimated flop count of eliminating this cluster, which schedules parallel elimination.
+     *  The separator is estimated from the keys of the factors in the cluster, so separator
+     *  variables only introduced by the children are not counted. */
+    double estimatedCost() const;
+
     /// print this node
     void print(const std::string& s = "", const KeyFormatter& keyFormatter =
         DefaultKeyFormatter) const;
@@ -98,10 +104,18 @@ public:
   /** Eliminate the factors to a Bayes tree and remaining factor graph
    * @param function The function to use to eliminate, see the namespace functions
    * in GaussianFactorGraph.h
+   * @param peakBytes If not null, set to the estimated peak memory of the intermediate factors:
+   * the remaining factors passed up the tree that wait for their parent clique, plus the joint
+   * factor of the clique being eliminated, each counted as dense, see denseFactorBytes.  The
+   * remaining factors of the children of a clique are released as soon as it is eliminated.
    * @return The Bayes tree and factor graph resulting from elimination
    */
   std::pair<boost::shared_ptr<BayesTreeType>, boost::shared_ptr<FactorGraphType> >
-  eliminate(const Eliminate& function) const;
+  eliminate(const Eliminate& function, size_t* peakBytes = 0) const;
+
+  /** Predict the cost of eliminate() from the structure of the tree only, without numeric work.
+   *  The memory is that of a serial elimination with dense factors. */
+  EliminationCostEstimate estimateCost() const;
 
   /// @}
 
@@ -56,6 +56,10 @@ namespace gtsam {
       // block.
       if (orderingType == Ordering::METIS)
         return eliminateSequential(Ordering::Metis(asDerived()), function, variableIndex, orderingType);
+      else if (orderingType == Ordering::NESTED_DISSECTION)
+        return eliminateSequential(Ordering::NestedDissection(asDerived()), function, variableIndex, orderingType);
+      else if (orderingType == Ordering::AMD)
+        return eliminateSequential(Ordering::Amd(*variableIndex), function, variableIndex, orderingType);
       else
         return eliminateSequential(Ordering::Colamd(*variableIndex), function, variableIndex, orderingType);
     }
@@ -70,9 +74,9 @@ namespace gtsam {
   {
     if(ordering && variableIndex) {
       gttic(eliminateMultifrontal);
-      // Do elimination with given ordering
-      EliminationTreeType etree(asDerived(), *variableIndex, *ordering);
-      JunctionTreeType junctionTree(etree);
+      // Do elimination with given ordering.  The elimination tree is a temporary, so that it is
+      // freed before the elimination starts.
+      JunctionTreeType junctionTree((EliminationTreeType(asDerived(), *variableIndex, *ordering)));
       boost::shared_ptr<BayesTreeType> bayesTree;
       boost::shared_ptr<FactorGraphType> factorGraph;
       boost::tie(bayesTree,factorGraph) = junctionTree.eliminate(function);
@@ -94,11 +98,38 @@ namespace gtsam {
       // block.
 	    if (orderingType == Ordering::METIS)
 		    return eliminateMultifrontal(Ordering::Metis(asDerived()), function, variableIndex, orderingType);
+	    else if (orderingType == Ordering::NESTED_DISSECTION)
+		    return eliminateMultifrontal(Ordering::NestedDissection(asDerived()), function, variableIndex, orderingType);
+	    else if (orderingType == Ordering::AMD)
+		    return eliminateMultifrontal(Ordering::Amd(*variableIndex), function, variableIndex, orderingType);
 	    else
 		    return eliminateMultifrontal(Ordering::Colamd(*variableIndex), function, variableIndex, orderingType);
     }
   }
 
+  /* ************************************************************************* */
+  template<class FACTORGRAPH>
+  EliminationCostEstimate EliminateableFactorGraph<FACTORGRAPH>::estimateEliminationCost(
+    const Ordering& ordering, OptionalVariableIndex variableIndex) const
+  {
+    if(variableIndex) {
+      gttic(estimateEliminationCost);
+      JunctionTreeType junctionTree((EliminationTreeType(asDerived(), *variableIndex, ordering)));
+      return junctionTree.estimateCost();
+    } else {
+      // If no variable index is provided, compute one and call this function again
+      return estimateEliminationCost(ordering, VariableIndex(asDerived()));
+    }
+  }
+
+  /* ************************************************************************* */
+  template<class FACTORGRAPH>
+  EliminationCostEstimate EliminateableFactorGraph<FACTORGRAPH>::estimateEliminationCost(
+    Ordering::OrderingType orderingType) const
+  {
+    return estimateEliminationCost(Ordering::Create(orderingType, asDerived()));
+  }
+
   /* ************************************************************************* */
   template<class FACTORGRAPH>
   std::pair<boost::shared_ptr<typename EliminateableFactorGraph<FACTORGRAPH>::BayesNetType>, boost::shared_ptr<FACTORGRAPH> >
@@ -144,9 +175,8 @@ namespace gtsam {
   {
     if(variableIndex) {
       gttic(eliminatePartialMultifrontal);
-      // Do elimination
-      EliminationTreeType etree(asDerived(), *variableIndex, ordering);
-      JunctionTreeType junctionTree(etree);
+      // Do elimination, freeing the temporary elimination tree before
+      JunctionTreeType junctionTree((EliminationTreeType(asDerived(), *variableIndex, ordering)));
       return junctionTree.eliminate(function);
     } else {
       // If no variable index is provided, compute one and call this function again
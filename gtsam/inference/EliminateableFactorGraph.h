@@ -25,6 +25,7 @@
 
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/VariableIndex.h>
+#include <gtsam/inference/eliminationCost.h>
 
 namespace gtsam {
 
@@ -154,6 +155,19 @@ namespace gtsam {
 	    OptionalVariableIndex variableIndex = boost::none,
 	    OptionalOrderingType orderingType = boost::none) const;
 
+    /** Predict the cost of eliminateMultifrontal() in the given \c ordering before doing it: the
+     *  flops, the entries of R, the largest clique and the peak memory, computed from the
+     *  structure of the junction tree only.  Comparing the estimates of several orderings helps
+     *  to choose one, or to prefer an iterative solver when even the best ordering costs too
+     *  much.  See EliminationCostEstimate. */
+    EliminationCostEstimate estimateEliminationCost(
+      const Ordering& ordering, OptionalVariableIndex variableIndex = boost::none) const;
+
+    /** Predict the cost of eliminateMultifrontal() in an ordering of the given type, see
+     *  estimateEliminationCost(const Ordering&, OptionalVariableIndex) */
+    EliminationCostEstimate estimateEliminationCost(
+      Ordering::OrderingType orderingType = Ordering::COLAMD) const;
+
     /** Do sequential elimination of some variables, in \c ordering provided, to produce a Bayes net
      *  and a remaining factor graph.  This computes the factorization \f$ p(X) = p(A|B) p(B) \f$,
      *  where \f$ A = \f$ \c variables, \f$ X \f$ is all the variables in the factor graph, and \f$
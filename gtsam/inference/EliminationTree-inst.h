@@ -22,6 +22,7 @@
 #include <boost/bind.hpp>
 #include <stack>
 
+#include <gtsam/base/BlockMatrixArena.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/base/treeTraversal-inst.h>
 #include <gtsam/inference/EliminationTree.h>
@@ -89,9 +90,12 @@ namespace gtsam {
 
     static const size_t none = std::numeric_limits<size_t>::max();
 
-    // Allocate result parent vector and vector of last factor columns
+    // Allocate result parent vector and vector of last factor columns.  The ancestors are
+    // shortcuts towards the roots, compressed as we go (Liu's algorithm), so finding the root
+    // of a subtree does not walk the whole path up the tree every time.
     FastVector<sharedNode> nodes(n);
     FastVector<size_t> parents(n, none);
+    FastVector<size_t> ancestors(n, none);
     FastVector<size_t> prevCol(m, none);
     FastVector<bool> factorUsed(m, false);
 
@@ -112,20 +116,20 @@ namespace gtsam {
           // variable in this factor a child of the current node.  This means that the variables
           // eliminated earlier in the factor depend on the later variables in the factor.  If we
           // haven't yet hit a variable in this factor, we add the factor to the current node.
-          // TODO: Store root shortcuts instead of parents.
           if (prevCol[i] != none) {
-            size_t k = prevCol[i];
-            // Find root r of the current tree that contains k. Use raw pointers in computing the
-            // parents to avoid changing the reference counts while traversing up the tree.
-            size_t r = k;
-            while (parents[r] != none)
-              r = parents[r];
-            // If the root of the subtree involving this node is actually the current node,
-            // TODO: what does this mean?  forest?
-            if (r != j) {
-              // Now that we found the root, hook up parent and child pointers in the nodes.
-              parents[r] = j;
-              node->children.push_back(nodes[r]);
+            // Walk from k = prevCol[i] to the root r of the current tree that contains it,
+            // pointing every ancestor on the way at the current node.  If the walk reaches the
+            // current node, the subtree is already our child.  Otherwise hook up the root.
+            size_t r = prevCol[i];
+            while (r != none && r != j) {
+              const size_t next = ancestors[r];
+              ancestors[r] = j;
+              if (next == none) {
+                parents[r] = j;
+                node->children.push_back(nodes[r]);
+                node->subtreeSize += nodes[r]->subtreeSize;
+              }
+              r = next;
             }
           } else {
             // Add the factor to the current node since we are at the first variable in this factor.
@@ -190,6 +194,9 @@ namespace gtsam {
     EliminationTree<BAYESNET,GRAPH>::eliminate(Eliminate function) const
   {
     gttic(EliminationTree_eliminate);
+    // Recycle the storage of intermediate dense factors, if enabled
+    BlockMatrixArena::Scope arenaScope;
+
     // Allocate result
     boost::shared_ptr<BayesNetType> result = boost::make_shared<BayesNetType>();
 
@@ -70,6 +70,16 @@ namespace gtsam {
       Key key; ///< key associated with root
       Factors factors; ///< factors associated with root
       Children children; ///< sub-trees
+      size_t subtreeSize; ///< number of nodes in this subtree, including this one
+
+      Node() : key(0), subtreeSize(1) {}
+
+      /// The subtree size
+      int problemSize() const { return int(subtreeSize); }
+
+      /// The cost of symbolically eliminating this node, in factors, which schedules parallel
+      /// traversals
+      double estimatedCost() const { return double(factors.size() + children.size()); }
 
       sharedFactor eliminate(const boost::shared_ptr<BayesNetType>& output,
         const Eliminate& function, const FastVector<sharedFactor>& childrenFactors) const;
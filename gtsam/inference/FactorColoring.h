@@ -0,0 +1,106 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FactorColoring.h
+ * @brief   Partition of the factors of a graph into colors of factors sharing no variable
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/inference/Key.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/FastVector.h>
+
+#include <boost/foreach.hpp>
+
+namespace gtsam {
+
+  /**
+   * A coloring of the factors of a factor graph, in which no two factors of the same color
+   * involve the same variable.  Operations that scatter-add the contribution of every factor into
+   * its variables, like GaussianFactorGraph::multiplyHessianAdd, can then process the graph color
+   * by color, and the factors within a color in parallel, without locks or atomics.
+   *
+   * The coloring is computed greedily in the order of the factors, giving each factor the first
+   * color not used by a factor it shares a variable with, so a variable involved in k factors
+   * forces at least k colors.  It only depends on the structure of the graph: compute it once and
+   * keep it as long as the factors keep their keys and indices.  Null factors get no color.
+   * \nosubgrouping
+   */
+  class FactorColoring {
+  public:
+
+    typedef FastVector<size_t> Factors; ///< Indices of the factors of one color
+
+    /// @name Standard Constructors
+    /// @{
+
+    /** Create an empty coloring */
+    FactorColoring() : nrFactors_(0) {}
+
+    /** Color the factors of a graph */
+    template<class FG>
+    explicit FactorColoring(const FG& graph);
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /** The number of colors */
+    size_t nrColors() const { return colors_.size(); }
+
+    /** The indices of the factors of color \c c, in increasing order */
+    const Factors& color(size_t c) const { return colors_[c]; }
+
+    /** The number of factors colored, i.e., the non-null factors of the graph */
+    size_t nrFactors() const { return nrFactors_; }
+
+    /// @}
+
+  private:
+    FastVector<Factors> colors_;
+    size_t nrFactors_;
+  };
+
+  /* ************************************************************************* */
+  template<class FG>
+  FactorColoring::FactorColoring(const FG& graph) : nrFactors_(0) {
+    FastMap<Key, Factors> keyColors; // Colors of the factors on each variable so far
+    FastVector<bool> forbidden; // Colors of the factors sharing a variable with this one
+    for (size_t i = 0; i < graph.size(); ++i) {
+      if (!graph[i])
+        continue;
+      const FastVector<Key>& keys = graph[i]->keys();
+      BOOST_FOREACH(Key key, keys) {
+        BOOST_FOREACH(size_t c, keyColors[key])
+          forbidden[c] = true;
+      }
+      size_t color = 0;
+      while (color < colors_.size() && forbidden[color])
+        ++color;
+      if (color == colors_.size()) {
+        colors_.push_back(Factors());
+        forbidden.push_back(false);
+      }
+      colors_[color].push_back(i);
+      BOOST_FOREACH(Key key, keys) {
+        Factors& used = keyColors[key];
+        BOOST_FOREACH(size_t c, used)
+          forbidden[c] = false;
+        used.push_back(color);
+      }
+      ++nrFactors_;
+    }
+  }
+
+} // \namespace gtsam
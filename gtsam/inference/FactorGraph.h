@@ -312,6 +312,9 @@ namespace gtsam {
      */
     void resize(size_t size) { factors_.resize(size); }
 
+    /** Release the capacity beyond the current number of factors */
+    void shrink_to_fit() { FastVector<sharedFactor>(factors_).swap(factors_); }
+
     /** delete factor without re-arranging indexes by inserting a NULL pointer */
     void remove(size_t i) { factors_[i].reset();}
 
@@ -33,7 +33,11 @@ struct ConstructorTraversalData {
   typedef typename JunctionTree<BAYESTREE, GRAPH>::sharedNode sharedNode;
 
   ConstructorTraversalData* const parentData;
+  const RelaxedAmalgamation& amalgamation;
   sharedNode myJTNode;
+  size_t myIndex; ///< index of myJTNode among the children of the parent's node
+  // Symbolic elimination results of the children, in the order of myJTNode->children.  Each
+  // child writes its own slot, so that siblings can be visited in parallel.
   FastVector<SymbolicConditional::shared_ptr> childSymbolicConditionals;
   FastVector<SymbolicFactor::shared_ptr> childSymbolicFactors;
 
@@ -41,8 +45,9 @@ struct ConstructorTraversalData {
   class SymbolicFactors: public FactorGraph<Factor> {
   };
 
-  ConstructorTraversalData(ConstructorTraversalData* _parentData) :
-      parentData(_parentData) {
+  ConstructorTraversalData(ConstructorTraversalData* _parentData,
+      const RelaxedAmalgamation& _amalgamation) :
+      parentData(_parentData), amalgamation(_amalgamation), myIndex(0) {
   }
 
   // Pre-order visitor function
@@ -51,10 +56,16 @@ struct ConstructorTraversalData {
       ConstructorTraversalData& parentData) {
     // On the pre-order pass, before children have been visited, we just set up
     // a traversal data structure with its own JT node, and create a child
-    // pointer in its parent.
-    ConstructorTraversalData myData = ConstructorTraversalData(&parentData);
+    // pointer in its parent.  The parallel traversal visits all children of a
+    // node here before descending into any of them, so the parent's vectors
+    // are not resized while a sibling writes its results.
+    ConstructorTraversalData myData = ConstructorTraversalData(&parentData,
+        parentData.amalgamation);
     myData.myJTNode = boost::make_shared<Node>(node->key, node->factors);
+    myData.myIndex = parentData.myJTNode->children.size();
     parentData.myJTNode->children.push_back(myData.myJTNode);
+    parentData.childSymbolicConditionals.resize(myData.myIndex + 1);
+    parentData.childSymbolicFactors.resize(myData.myIndex + 1);
     return myData;
   }
 
@@ -88,8 +99,8 @@ struct ConstructorTraversalData {
         symbolicFactors, keyAsOrdering);
 
     // Store symbolic elimination results in the parent
-    myData.parentData->childSymbolicConditionals.push_back(myConditional);
-    myData.parentData->childSymbolicFactors.push_back(mySeparatorFactor);
+    myData.parentData->childSymbolicConditionals[myData.myIndex] = myConditional;
+    myData.parentData->childSymbolicFactors[myData.myIndex] = mySeparatorFactor;
 
     sharedNode node = myData.myJTNode;
     const FastVector<SymbolicConditional::shared_ptr>& childConditionals =
@@ -97,7 +108,10 @@ struct ConstructorTraversalData {
     node->problemSize_ = (int) (myConditional->size() * symbolicFactors.size());
 
     // Merge our children if they are in our clique - if our conditional has
-    // exactly one fewer parent than our child's conditional.
+    // exactly one fewer parent than our child's conditional.  With relaxed
+    // amalgamation, also merge children whose merging introduces little fill,
+    // or that are smaller than the minimum supernode size.
+    const RelaxedAmalgamation& amalgamation = myData.amalgamation;
     const size_t myNrParents = myConditional->nrParents();
     const size_t nrChildren = node->children.size();
     assert(childConditionals.size() == nrChildren);
@@ -107,7 +121,19 @@ struct ConstructorTraversalData {
     size_t myNrFrontals = 1, i = 0;
     BOOST_FOREACH(const sharedNode& child, node->children) {
       // Check if we should merge the i^th child
-      if (myNrParents + myNrFrontals == childConditionals[i]->nrParents()) {
+      const size_t myCliqueSize = myNrParents + myNrFrontals;
+      const size_t childNrParents = childConditionals[i]->nrParents();
+      bool mergeChild = (myCliqueSize == childNrParents);
+      if (!mergeChild) {
+        // The child's rows in the merged clique have zeros in the columns of
+        // our clique that are not in the child's separator.
+        const size_t childNrFrontals = child->orderedFrontalKeys.size();
+        const double fill = double(myCliqueSize - childNrParents)
+            / double(childNrFrontals + myCliqueSize);
+        mergeChild = (fill <= amalgamation.fillTolerance)
+            || (childNrFrontals < amalgamation.minSupernodeSize);
+      }
+      if (mergeChild) {
         // Increment number of frontal variables
         myNrFrontals += child->orderedFrontalKeys.size();
         merge[i] = true;
@@ -124,25 +150,29 @@ struct ConstructorTraversalData {
 template<class BAYESTREE, class GRAPH>
 template<class ETREE_BAYESNET, class ETREE_GRAPH>
 JunctionTree<BAYESTREE, GRAPH>::JunctionTree(
-    const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree) {
+    const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree,
+    const RelaxedAmalgamation& amalgamation) {
   gttic(JunctionTree_FromEliminationTree);
   // Here we rely on the BayesNet having been produced by this elimination tree,
   // such that the conditionals are arranged in DFS post-order.  We traverse the
   // elimination tree, and inspect the symbolic conditional corresponding to
   // each node.  The elimination tree node is added to the same clique with its
   // parent if it has exactly one more Bayes net conditional parent than
-  // does its elimination tree parent.
+  // does its elimination tree parent, or if relaxed amalgamation allows it.
 
   // Traverse the elimination tree, doing symbolic elimination and merging nodes
-  // as we go.  Gather the created junction tree roots in a dummy Node.
+  // as we go.  Gather the created junction tree roots in a dummy Node.  With
+  // TBB, subtrees with at least parallelSubtreeCost factors to eliminate
+  // symbolically are converted in parallel.
   typedef typename EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>::Node ETreeNode;
   typedef ConstructorTraversalData<BAYESTREE, GRAPH, ETreeNode> Data;
-  Data rootData(0);
+  static const double parallelSubtreeCost = 2000.0;
+  Data rootData(0, amalgamation);
   rootData.myJTNode = boost::make_shared<typename Base::Node>(); // Make a dummy node to gather
                                                                  // the junction tree roots
-  treeTraversal::DepthFirstForest(eliminationTree, rootData,
+  treeTraversal::DepthFirstForestParallel(eliminationTree, rootData,
       Data::ConstructorTraversalVisitorPre,
-      Data::ConstructorTraversalVisitorPostAlg2);
+      Data::ConstructorTraversalVisitorPostAlg2, parallelSubtreeCost);
 
   // Assign roots from the dummy node
   typedef typename JunctionTree<BAYESTREE, GRAPH>::Node Node;
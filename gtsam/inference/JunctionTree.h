@@ -27,6 +27,28 @@ namespace gtsam {
   // Forward declarations
   template<class BAYESNET, class GRAPH> class EliminationTree;
 
+  /**
+   * Parameters for relaxed supernode amalgamation when building a JunctionTree.  By default a
+   * clique is merged into its parent only when this introduces no fill, i.e. when its separator
+   * is exactly the parent clique.  Relaxing this merges chains of small cliques, for example in
+   * pose graphs with long odometry chains, into larger dense cliques.  The explicit zeros
+   * this introduces are factored along with the rest of the clique, which trades a few extra
+   * flops for fewer, larger dense eliminations with less per-clique overhead.
+   */
+  struct RelaxedAmalgamation {
+    /** Merge a child clique into its parent if at most this fraction of the entries in the child's
+     *  rows of the merged clique are zero fill */
+    double fillTolerance;
+
+    /** Merge a child clique with fewer frontal variables than this into its parent, regardless of
+     *  fill */
+    size_t minSupernodeSize;
+
+    /** Constructor, the defaults merge exactly as without relaxation */
+    RelaxedAmalgamation(double _fillTolerance = 0.0, size_t _minSupernodeSize = 1) :
+      fillTolerance(_fillTolerance), minSupernodeSize(_minSupernodeSize) {}
+  };
+
   /**
    * A JunctionTree is a ClusterTree, i.e., a set of variable clusters with factors, arranged
    * in a tree, with the additional property that it represents the clique tree associated
@@ -66,9 +88,11 @@ namespace gtsam {
     template<class ETREE>
       static This FromEliminationTree(const ETREE& eliminationTree) { return This(eliminationTree); }
       
-    /** Build the junction tree from an elimination tree. */
+    /** Build the junction tree from an elimination tree, merging cliques as specified by
+     *  \c amalgamation. */
     template<class ETREE_BAYESNET, class ETREE_GRAPH>
-    JunctionTree(const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree);
+    JunctionTree(const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree,
+        const RelaxedAmalgamation& amalgamation = RelaxedAmalgamation());
 
     /// @}
 
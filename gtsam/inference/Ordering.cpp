@@ -20,23 +20,62 @@
 #include <limits>
 
 #include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/task_group.h>
+#undef max // TBB seems to include windows.h and we don't want these macros
+#undef min
+#undef ERROR
+#endif
 
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/3rdparty/CCOLAMD/Include/ccolamd.h>
 #include <gtsam/3rdparty/metis/include/metis.h>
 
+#include <Eigen/SparseCore>
+#include <Eigen/OrderingMethods>
+
 using namespace std;
 
 namespace gtsam {
 
 /* ************************************************************************* */
-FastMap<Key, size_t> Ordering::invert() const {
-  FastMap<Key, size_t> inverted;
+Ordering::InvertedMap Ordering::invert() const {
+  InvertedMap inverted;
+#ifdef GTSAM_USE_FLAT_KEYMAP
+  inverted.reserve(this->size());
+#endif
   for (size_t pos = 0; pos < this->size(); ++pos)
     inverted.insert(make_pair((*this)[pos], pos));
+#ifdef GTSAM_USE_FLAT_KEYMAP
+  inverted.sortByKey(); // Iterate in key order, as with FastMap
+#endif
   return inverted;
 }
 
+/* ************************************************************************* */
+namespace {
+
+// Keys of a VariableIndex in iteration order, which is sorted by key, so that the column of a
+// key can be found by binary search instead of building a map for every call
+vector<Key> sortedKeys(const VariableIndex& variableIndex) {
+  vector<Key> keys;
+  keys.reserve(variableIndex.size());
+  BOOST_FOREACH(const VariableIndex::value_type& key_factors, variableIndex)
+    keys.push_back(key_factors.first);
+  return keys;
+}
+
+size_t columnOf(const vector<Key>& keys, Key key) {
+  vector<Key>::const_iterator it = lower_bound(keys.begin(), keys.end(), key);
+  if (it == keys.end() || *it != key)
+    throw out_of_range("Ordering: constrained key is not in the VariableIndex");
+  return it - keys.begin();
+}
+
+}
+
 /* ************************************************************************* */
 Ordering Ordering::Colamd(const VariableIndex& variableIndex) {
   // Call constrained version with all groups set to zero
@@ -58,20 +97,20 @@ Ordering Ordering::ColamdConstrained(const VariableIndex& variableIndex,
   vector<int> A = vector<int>(Alen); /* colamd arg 4: row indices of A, of size Alen */
   vector<int> p = vector<int>(nVars + 1); /* colamd arg 5: column pointers of A, of size n_col+1 */
 
-  // Fill in input data for COLAMD
+  // Fill in input data for COLAMD.  The factor lists of the VariableIndex are the columns, so
+  // each one is copied in bulk (taking the entries by reference, not by value).  They are usually
+  // sorted, but not always, e.g. after factors are added to reused slots or loaded back from
+  // disk by ISAM2, which CCOLAMD accepts as a jumbled matrix.
+  // CCOLAMD uses A as workspace and destroys it, so this one copy cannot be avoided.
   p[0] = 0;
   int count = 0;
   vector<Key> keys(nVars); // Array to store the keys in the order we add them so we can retrieve them in permuted order
   size_t index = 0;
-  BOOST_FOREACH(const VariableIndex::value_type key_factors, variableIndex) {
+  BOOST_FOREACH(const VariableIndex::value_type& key_factors, variableIndex) {
     // Arrange factor indices into COLAMD format
     const VariableIndex::Factors& column = key_factors.second;
-    size_t lastFactorId = numeric_limits<size_t>::max();
-    BOOST_FOREACH(size_t factorIndex, column) {
-      if (lastFactorId != numeric_limits<size_t>::max())
-        assert(factorIndex > lastFactorId);
-      A[count++] = (int) factorIndex; // copy sparse column
-    }
+    std::copy(column.begin(), column.end(), A.begin() + count); // copy sparse column
+    count += (int) column.size();
     p[index + 1] = count; // column j (base 1) goes from A[j-1] to A[j]-1
     // Store key in array and increment index
     keys[index] = key_factors.first;
@@ -122,17 +161,14 @@ Ordering Ordering::ColamdConstrainedLast(const VariableIndex& variableIndex,
   size_t n = variableIndex.size();
   std::vector<int> cmember(n, 0);
 
-  // Build a mapping to look up sorted Key indices by Key
-  FastMap<Key, size_t> keyIndices;
-  size_t j = 0;
-  BOOST_FOREACH(const VariableIndex::value_type key_factors, variableIndex)
-    keyIndices.insert(keyIndices.end(), make_pair(key_factors.first, j++));
+  // Sorted keys, to look up the column of each constrained key
+  const vector<Key> keys = sortedKeys(variableIndex);
 
   // If at least some variables are not constrained to be last, constrain the
   // ones that should be constrained.
   int group = (constrainLast.size() != n ? 1 : 0);
   BOOST_FOREACH(Key key, constrainLast) {
-    cmember[keyIndices.at(key)] = group;
+    cmember[columnOf(keys, key)] = group;
     if (forceOrder)
       ++group;
   }
@@ -149,17 +185,14 @@ Ordering Ordering::ColamdConstrainedFirst(const VariableIndex& variableIndex,
   size_t n = variableIndex.size();
   std::vector<int> cmember(n, none);
 
-  // Build a mapping to look up sorted Key indices by Key
-  FastMap<Key, size_t> keyIndices;
-  size_t j = 0;
-  BOOST_FOREACH(const VariableIndex::value_type key_factors, variableIndex)
-    keyIndices.insert(keyIndices.end(), make_pair(key_factors.first, j++));
+  // Sorted keys, to look up the column of each constrained key
+  const vector<Key> keys = sortedKeys(variableIndex);
 
   // If at least some variables are not constrained to be last, constrain the
   // ones that should be constrained.
   int group = 0;
   BOOST_FOREACH(Key key, constrainFirst) {
-    cmember[keyIndices.at(key)] = group;
+    cmember[columnOf(keys, key)] = group;
     if (forceOrder)
       ++group;
   }
@@ -180,24 +213,71 @@ Ordering Ordering::ColamdConstrained(const VariableIndex& variableIndex,
   size_t n = variableIndex.size();
   std::vector<int> cmember(n, 0);
 
-  // Build a mapping to look up sorted Key indices by Key
-  FastMap<Key, size_t> keyIndices;
-  size_t j = 0;
-  BOOST_FOREACH(const VariableIndex::value_type key_factors, variableIndex)
-    keyIndices.insert(keyIndices.end(), make_pair(key_factors.first, j++));
+  // Sorted keys, to look up the column of each constrained key
+  const vector<Key> keys = sortedKeys(variableIndex);
 
   // Assign groups
   typedef FastMap<Key, int>::value_type key_group;
   BOOST_FOREACH(const key_group& p, groups) {
     // FIXME: check that no groups are skipped
-    cmember[keyIndices.at(p.first)] = p.second;
+    cmember[columnOf(keys, p.first)] = p.second;
   }
 
   return Ordering::ColamdConstrained(variableIndex, cmember);
 }
 
 /* ************************************************************************* */
-Ordering Ordering::Metis(const MetisIndex& met) {
+Ordering Ordering::Amd(const VariableIndex& variableIndex) {
+  gttic(Ordering_AMD);
+
+  gttic(Prepare);
+  const int nFactors = (int) variableIndex.nFactors(), nVars = (int) variableIndex.size();
+  // Factor-variable incidence matrix in compressed column format, as for COLAMD
+  vector<int> rows, columns(nVars + 1);
+  rows.reserve(variableIndex.nEntries());
+  vector<Key> keys(nVars);
+  size_t index = 0;
+  BOOST_FOREACH(const VariableIndex::value_type& key_factors, variableIndex) {
+    const VariableIndex::Factors& column = key_factors.second;
+    rows.insert(rows.end(), column.begin(), column.end());
+    columns[index + 1] = (int) rows.size();
+    keys[index++] = key_factors.first;
+  }
+  const vector<double> ones(rows.size(), 1.0);
+  Eigen::MappedSparseMatrix<double, Eigen::ColMajor, int> incidence(nFactors, nVars,
+      (int) rows.size(), &columns[0], rows.empty() ? 0 : &rows[0],
+      const_cast<double*>(ones.empty() ? 0 : &ones[0]));
+
+  // Variables are adjacent when they share a factor, which is the pattern of A'*A
+  const Eigen::SparseMatrix<double, Eigen::ColMajor, int> adjacency =
+      incidence.transpose() * incidence;
+  gttoc(Prepare);
+
+  Ordering result;
+  if (nVars == 0)
+    return result;
+
+  gttic(amd);
+  Eigen::AMDOrdering<int>::PermutationType permutation;
+  Eigen::AMDOrdering<int>()(adjacency, permutation);
+  gttoc(amd);
+
+  // The permutation lists the original column of each variable in elimination order
+  result.resize(nVars);
+  for (int j = 0; j < nVars; ++j)
+    result[j] = keys[permutation.indices()[j]];
+  return result;
+}
+
+/* ************************************************************************* */
+Ordering Ordering::Metis(const MetisIndex& met, size_t parallelThreshold) {
+#ifdef GTSAM_USE_TBB
+  // On large graphs a single METIS_NodeND call can take longer than the factorization itself, so
+  // dissect the top levels in parallel and leave about 64 leaves of the tree to METIS_NodeND
+  if ((size_t) met.nValues() > parallelThreshold)
+    return NestedDissection(met, std::max<size_t>(100, met.nValues() / 64));
+#endif
+
   gttic(Ordering_METIS);
 
   vector<idx_t> xadj = met.xadj();
@@ -229,6 +309,141 @@ Ordering Ordering::Metis(const MetisIndex& met) {
   return result;
 }
 
+/* ************************************************************************* */
+namespace {
+
+// By default METIS draws its random numbers from the process-wide rand() state (it reseeds on
+// every call), so concurrent calls would race and make the resulting orderings non-deterministic.
+// While one of these is in scope, the METIS calls of the current thread use a generator with
+// per-thread state instead.  The previous setting is restored, as TBB threads are shared.
+class ThreadLocalMetisRandom {
+  int previous_;
+public:
+  ThreadLocalMetisRandom() : previous_(METIS_SetThreadLocalRandom(1)) {}
+  ~ThreadLocalMetisRandom() { METIS_SetThreadLocalRandom(previous_); }
+};
+
+// Subgraph in METIS CSR format, with the index in the full graph of each vertex
+struct DissectionGraph {
+  vector<idx_t> xadj, adj, vertices;
+};
+
+void nestedDissection(const DissectionGraph& graph, idx_t* perm, size_t minSubgraphSize);
+
+// Task ordering one half of a bisected graph
+class NestedDissectionTask {
+  boost::shared_ptr<DissectionGraph> graph_;
+  idx_t* perm_;
+  size_t minSubgraphSize_;
+public:
+  NestedDissectionTask(const boost::shared_ptr<DissectionGraph>& graph, idx_t* perm,
+      size_t minSubgraphSize) :
+      graph_(graph), perm_(perm), minSubgraphSize_(minSubgraphSize) {
+  }
+  void operator()() const {
+    nestedDissection(*graph_, perm_, minSubgraphSize_);
+  }
+};
+
+// Order 'graph' into perm[0 .. graph.vertices.size()), as indices into the full graph
+void nestedDissection(const DissectionGraph& graph, idx_t* perm, size_t minSubgraphSize) {
+  idx_t n = graph.vertices.size();
+  if (n == 0)
+    return;
+  if (graph.adj.empty()) {
+    copy(graph.vertices.begin(), graph.vertices.end(), perm);
+    return;
+  }
+
+  ThreadLocalMetisRandom metisRandom;
+
+  // Bisect with a vertex separator, part[i] is 0 or 1 for the two halves and 2 for the separator
+  vector<idx_t> part(n, 0);
+  size_t partSize[3] = { 0, 0, 0 };
+  if ((size_t) n > minSubgraphSize) {
+    idx_t options[METIS_NOPTIONS];
+    METIS_SetDefaultOptions(options);
+    idx_t sepSize;
+    int outputError = METIS_ComputeVertexSeparator(&n, const_cast<idx_t*>(&graph.xadj[0]),
+        const_cast<idx_t*>(&graph.adj[0]), NULL, options, &sepSize, &part[0]);
+    if (outputError == METIS_OK)
+      for (idx_t i = 0; i < n; ++i)
+        ++partSize[part[i]];
+  }
+
+  if (partSize[0] == 0 || partSize[1] == 0) {
+    // Small (or inseparable) subgraph, let METIS order it in one go
+    vector<idx_t> localPerm(n), localIperm(n);
+    int outputError = METIS_NodeND(&n, const_cast<idx_t*>(&graph.xadj[0]),
+        const_cast<idx_t*>(&graph.adj[0]), NULL, NULL, &localPerm[0], &localIperm[0]);
+    if (outputError != METIS_OK)
+      throw std::runtime_error("Ordering::NestedDissection: METIS_NodeND failed");
+    for (idx_t i = 0; i < n; ++i)
+      perm[i] = graph.vertices[localPerm[i]];
+    return;
+  }
+
+  // Build the two halves, the separator is ordered last
+  boost::shared_ptr<DissectionGraph> halves[2] = { boost::make_shared<DissectionGraph>(),
+      boost::make_shared<DissectionGraph>() };
+  vector<idx_t> localIndex(n);
+  size_t nextIndex[3] = { 0, 0, 0 };
+  for (idx_t i = 0; i < n; ++i) {
+    localIndex[i] = nextIndex[part[i]]++;
+    if (part[i] == 2)
+      perm[partSize[0] + partSize[1] + localIndex[i]] = graph.vertices[i];
+    else
+      halves[part[i]]->vertices.push_back(graph.vertices[i]);
+  }
+  for (size_t h = 0; h < 2; ++h) {
+    halves[h]->xadj.reserve(partSize[h] + 1);
+    halves[h]->xadj.push_back(0);
+  }
+  for (idx_t i = 0; i < n; ++i) {
+    if (part[i] == 2)
+      continue;
+    DissectionGraph& half = *halves[part[i]];
+    for (idx_t k = graph.xadj[i]; k < graph.xadj[i + 1]; ++k)
+      if (part[graph.adj[k]] == part[i])
+        half.adj.push_back(localIndex[graph.adj[k]]);
+    half.xadj.push_back(half.adj.size());
+  }
+
+#ifdef GTSAM_USE_TBB
+  tbb::task_group tasks;
+  tasks.run(NestedDissectionTask(halves[0], perm, minSubgraphSize));
+  nestedDissection(*halves[1], perm + partSize[0], minSubgraphSize);
+  tasks.wait();
+#else
+  nestedDissection(*halves[0], perm, minSubgraphSize);
+  nestedDissection(*halves[1], perm + partSize[0], minSubgraphSize);
+#endif
+}
+
+}
+
+/* ************************************************************************* */
+Ordering Ordering::NestedDissection(const MetisIndex& met, size_t minSubgraphSize) {
+  gttic(Ordering_NestedDissection);
+
+  DissectionGraph graph;
+  graph.xadj = met.xadj();
+  graph.adj = met.adj();
+  graph.vertices.resize(met.nValues());
+  for (size_t j = 0; j < graph.vertices.size(); ++j)
+    graph.vertices[j] = j;
+
+  vector<idx_t> perm(graph.vertices.size());
+  if (!perm.empty())
+    nestedDissection(graph, &perm[0], minSubgraphSize);
+
+  Ordering result;
+  result.resize(perm.size());
+  for (size_t j = 0; j < perm.size(); ++j)
+    result[j] = met.intToKey(perm[j]);
+  return result;
+}
+
 /* ************************************************************************* */
 void Ordering::print(const std::string& str,
     const KeyFormatter& keyFormatter) const {
@@ -23,6 +23,7 @@
 #include <gtsam/inference/MetisIndex.h>
 #include <gtsam/inference/FactorGraph.h>
 #include <gtsam/base/FastSet.h>
+#include <gtsam/base/FlatKeyMap.h>
 
 #include <boost/assign/list_inserter.hpp>
 #include <algorithm>
@@ -38,7 +39,7 @@ public:
 
   /// Type of ordering to use
   enum OrderingType {
-    COLAMD, METIS, NATURAL, CUSTOM
+    COLAMD, METIS, NATURAL, CUSTOM, NESTED_DISSECTION, AMD
   };
 
   typedef Ordering This; ///< Typedef to this class
@@ -69,8 +70,11 @@ public:
         boost::assign_detail::call_push_back<This>(*this))(key);
   }
 
+  /// Map from key to order position returned by invert(), a FastMap unless GTSAM_USE_FLAT_KEYMAP
+  typedef KeyMap<size_t>::type InvertedMap;
+
   /// Invert (not reverse) the ordering - returns a map from key to order position
-  FastMap<Key, size_t> invert() const;
+  InvertedMap invert() const;
 
   /// @name Fill-reducing Orderings @{
 
@@ -85,6 +89,20 @@ public:
   /// Compute a fill-reducing ordering using COLAMD from a VariableIndex.
   static GTSAM_EXPORT Ordering Colamd(const VariableIndex& variableIndex);
 
+  /// Compute a fill-reducing ordering using approximate minimum degree (AMD) from a factor
+  /// graph.  This internally builds a VariableIndex so if you already have a VariableIndex, it
+  /// is faster to use Amd(const VariableIndex&).
+  template<class FACTOR>
+  static Ordering Amd(const FactorGraph<FACTOR>& graph) {
+    return Amd(VariableIndex(graph));
+  }
+
+  /// Compute a fill-reducing ordering using AMD (Eigen's implementation) on the variable
+  /// adjacency graph of a VariableIndex.  Unlike COLAMD, which orders the columns of the
+  /// factor-variable incidence matrix, AMD works on the symmetric variable graph, which is
+  /// smaller for graphs of binary factors such as pose graphs.  Constraints are not supported.
+  static GTSAM_EXPORT Ordering Amd(const VariableIndex& variableIndex);
+
   /// Compute a fill-reducing ordering using constrained COLAMD from a factor graph (see details
   /// for note on performance).  This internally builds a VariableIndex so if you already have a
   /// VariableIndex, it is faster to use COLAMD(const VariableIndex&).  This function constrains
@@ -175,12 +193,31 @@ public:
   static GTSAM_EXPORT void CSRFormat(std::vector<int>& xadj,
       std::vector<int>& adj, const FactorGraph<FACTOR>& graph);
 
-  /// Compute an ordering determined by METIS from a VariableIndex
-  static GTSAM_EXPORT Ordering Metis(const MetisIndex& met);
+  /// Compute an ordering determined by METIS from a VariableIndex.  With TBB, graphs with more
+  /// than \c parallelThreshold variables are ordered by the parallel NestedDissection() instead
+  /// of a single serial METIS_NodeND call, with leaves large enough for METIS to order them well.
+  static GTSAM_EXPORT Ordering Metis(const MetisIndex& met,
+      size_t parallelThreshold = 100000);
+
+  template<class FACTOR>
+  static Ordering Metis(const FactorGraph<FACTOR>& graph,
+      size_t parallelThreshold = 100000) {
+    return Metis(MetisIndex(graph), parallelThreshold);
+  }
+
+  /// Compute a nested dissection ordering by recursively bisecting the graph with METIS vertex
+  /// separators, ordering each separator after the two halves it separates.  Unlike Metis(), the
+  /// recursion is explicit, so that the halves become independent, balanced subtrees of the
+  /// elimination tree.  With TBB, the two halves are ordered in parallel, and the METIS calls
+  /// themselves run concurrently.  Subgraphs with at most \c minSubgraphSize variables are
+  /// ordered directly by METIS.
+  static GTSAM_EXPORT Ordering NestedDissection(const MetisIndex& met,
+      size_t minSubgraphSize = 100);
 
   template<class FACTOR>
-  static Ordering Metis(const FactorGraph<FACTOR>& graph) {
-    return Metis(MetisIndex(graph));
+  static Ordering NestedDissection(const FactorGraph<FACTOR>& graph,
+      size_t minSubgraphSize = 100) {
+    return NestedDissection(MetisIndex(graph), minSubgraphSize);
   }
 
   /// @}
@@ -198,6 +235,10 @@ public:
       return Metis(graph);
     case NATURAL:
       return Natural(graph);
+    case NESTED_DISSECTION:
+      return NestedDissection(graph);
+    case AMD:
+      return Amd(graph);
     case CUSTOM:
       throw std::runtime_error(
           "Ordering::Create error: called with CUSTOM ordering type.");
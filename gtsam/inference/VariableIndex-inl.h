@@ -60,6 +60,12 @@ void VariableIndex::remove(ITERATOR firstFactor, ITERATOR lastFactor,
   // indices need to remain consistent.  Removing factors from a factor graph
   // does not shift the indices of other factors.  Also, we keep nFactors_
   // one greater than the highest-numbered factor referenced in a VariableIndex.
+
+  // Collect the factor indices to remove for each involved variable, so that the
+  // factor list of each variable is compacted in a single pass, instead of
+  // searching and erasing once per removed factor.
+  typedef FastMap<Key, Factors> RemovedMap;
+  RemovedMap removedFromVariable;
   ITERATOR factorIndex = firstFactor;
   size_t i = 0;
   for (; factorIndex != lastFactor; ++factorIndex, ++i) {
@@ -67,18 +73,23 @@ void VariableIndex::remove(ITERATOR firstFactor, ITERATOR lastFactor,
       throw std::invalid_argument(
           "Internal error, requested inconsistent number of factor indices and factors in VariableIndex::remove");
     if (factors[i]) {
-      BOOST_FOREACH(Key j, *factors[i]) {
-        Factors& factorEntries = internalAt(j);
-        Factors::iterator entry = std::find(factorEntries.begin(),
-            factorEntries.end(), *factorIndex);
-        if (entry == factorEntries.end())
-          throw std::invalid_argument(
-              "Internal error, indices and factors passed into VariableIndex::remove are not consistent with the existing variable index");
-        factorEntries.erase(entry);
-        --nEntries_;
-      }
+      BOOST_FOREACH(Key j, *factors[i])
+        removedFromVariable[j].push_back(*factorIndex);
     }
   }
+
+  BOOST_FOREACH(RemovedMap::value_type& key_removed, removedFromVariable) {
+    Factors& removed = key_removed.second;
+    std::sort(removed.begin(), removed.end());
+    Factors& factorEntries = internalAt(key_removed.first);
+    const Factors::iterator newEnd = std::remove_if(factorEntries.begin(),
+        factorEntries.end(), IsRemoved(removed));
+    if (size_t(factorEntries.end() - newEnd) != removed.size())
+      throw std::invalid_argument(
+          "Internal error, indices and factors passed into VariableIndex::remove are not consistent with the existing variable index");
+    factorEntries.erase(newEnd, factorEntries.end());
+    nEntries_ -= removed.size();
+  }
 }
 
 /* ************************************************************************* */
@@ -18,6 +18,7 @@
 #include <iostream>
 
 #include <gtsam/inference/VariableIndex.h>
+#include <gtsam/base/MemoryUsage.h>
 
 namespace gtsam {
 
@@ -29,6 +30,26 @@ bool VariableIndex::equals(const VariableIndex& other, double tol) const {
     && this->index_ == other.index_;
 }
 
+/* ************************************************************************* */
+size_t VariableIndex::memoryUsage() const {
+  size_t bytes = sizeof(VariableIndex) + mapNodeBytes(index_.size(), sizeof(KeyMap::value_type));
+  BOOST_FOREACH(const KeyMap::value_type& key_factors, index_)
+    bytes += heapBytes(key_factors.second);
+  return bytes;
+}
+
+/* ************************************************************************* */
+void VariableIndex::renumberFactors(const FastVector<size_t>& newIndices, size_t nFactors) {
+  BOOST_FOREACH(KeyMap::value_type& key_factors, index_) {
+    Factors factors;
+    factors.reserve(key_factors.second.size());
+    BOOST_FOREACH(const size_t factor, key_factors.second)
+      factors.push_back(newIndices[factor]);
+    key_factors.second.swap(factors);
+  }
+  nFactors_ = nFactors;
+}
+
 /* ************************************************************************* */
 void VariableIndex::print(const string& str, const KeyFormatter& keyFormatter) const {
   cout << str;
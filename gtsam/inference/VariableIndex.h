@@ -25,6 +25,7 @@
 #include <boost/optional/optional.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 
@@ -89,6 +90,9 @@ public:
   /** The number of nonzero blocks, i.e. the number of variable-factor entries */
   size_t nEntries() const { return nEntries_; }
 
+  /** Return the memory used by the index in bytes, see MemoryUsage */
+  size_t memoryUsage() const;
+
   /** Access a list of factors by variable */
   const Factors& operator[](Key variable) const {
     KeyMap::const_iterator item = index_.find(variable);
@@ -144,6 +148,14 @@ public:
   template<typename ITERATOR>
   void removeUnusedVariables(ITERATOR firstKey, ITERATOR lastKey);
 
+  /**
+   * Renumber the factors after the factor graph was compacted, e.g. by ISAM2::compactFactors,
+   * releasing the capacity left in the factor lists by removed factors.
+   * @param newIndices The new index of every factor index in the variable index
+   * @param nFactors The number of factors in the compacted factor graph
+   */
+  void renumberFactors(const FastVector<size_t>& newIndices, size_t nFactors);
+
   /** Iterator to the first variable entry */
   const_iterator begin() const { return index_.begin(); }
 
@@ -160,6 +172,15 @@ protected:
   Factor_const_iterator factorsBegin(Key variable) const { return internalAt(variable).begin(); }
   Factor_const_iterator factorsEnd(Key variable) const { return internalAt(variable).end(); }
 
+  /// Predicate for whether a factor index is in a sorted list of removed factor indices
+  struct IsRemoved {
+    const Factors& removed;
+    IsRemoved(const Factors& _removed) : removed(_removed) {}
+    bool operator()(size_t factorIndex) const {
+      return std::binary_search(removed.begin(), removed.end(), factorIndex);
+    }
+  };
+
   /// Internal version of 'at' that asserts existence
   const Factors& internalAt(Key variable) const {
     const KeyMap::const_iterator item = index_.find(variable);
@@ -19,7 +19,7 @@
 #pragma once
 
 #include <gtsam/global_includes.h>
-#include <gtsam/base/FastMap.h>
+#include <gtsam/base/FlatKeyMap.h>
 #include <gtsam/base/FastVector.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/base/Testable.h>
@@ -38,7 +38,8 @@ namespace gtsam {
 *   interleaved.
 *  
 *   VariableSlots describes the 2D block structure of the combined factor.  It
-*   is a map<Key, vector<size_t> >.  The Key is the real
+*   is a map<Key, vector<size_t> > (a FlatKeyMap if GTSAM_USE_FLAT_KEYMAP is
+*   defined, iterated in key order in either case).  The Key is the real
 *   variable index of the combined factor slot.  The vector<size_t> tells, for
 *   each row-block (factor), which column-block (variable slot) from the
 *   component factor appears in this block of the combined factor.
@@ -50,11 +51,11 @@ namespace gtsam {
 *  
 *   \nosubgrouping */
 
-class VariableSlots : public FastMap<Key, FastVector<size_t> > {
+class VariableSlots : public KeyMap<FastVector<size_t> >::type {
 
 public:
 
-  typedef FastMap<Key, FastVector<size_t> > Base;
+  typedef KeyMap<FastVector<size_t> >::type Base;
   GTSAM_EXPORT static const size_t Empty;
 
   /// @name Standard Constructors
@@ -119,6 +120,9 @@ VariableSlots::VariableSlots(const FG& factorGraph)
     }
     ++ jointFactorPos;
   }
+#ifdef GTSAM_USE_FLAT_KEYMAP
+  this->sortByKey();
+#endif
 }
 
 }
@@ -0,0 +1,80 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    eliminationCost.h
+ * @brief   Cost estimates of eliminating cliques, used to schedule parallel tree traversals and
+ *          to report the memory of elimination
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace gtsam {
+
+namespace internal {
+  // Factors with a getDim method (Gaussian factors) report the dimension of their variables
+  template<class FACTOR>
+  auto scalarDimension(const FACTOR& factor, typename FACTOR::const_iterator key, int)
+      -> decltype(size_t(factor.getDim(key))) {
+    return size_t(factor.getDim(key));
+  }
+
+  // Variables of other factors (symbolic, discrete) count as scalars
+  template<class FACTOR>
+  size_t scalarDimension(const FACTOR&, typename FACTOR::const_iterator, long) {
+    return 1;
+  }
+}
+
+/** Scalar dimension of the variable \c key of \c factor, or 1 for factors whose variables have
+ *  no dimension, like symbolic factors */
+template<class FACTOR>
+size_t scalarDimension(const FACTOR& factor, typename FACTOR::const_iterator key) {
+  return internal::scalarDimension(factor, key, 0);
+}
+
+/** Estimated flop count of the dense partial factorization of a clique with \c frontalDim frontal
+ *  and \c separatorDim separator scalar dimensions: the Cholesky factorization of the frontal
+ *  block, the triangular solve for the off-diagonal block and the Schur complement update. */
+inline double eliminationFlops(double frontalDim, double separatorDim) {
+  return frontalDim * frontalDim * frontalDim / 3.0 + frontalDim * frontalDim * separatorDim
+      + frontalDim * separatorDim * separatorDim;
+}
+
+/** Estimated bytes of the dense storage of a factor on variables of total scalar dimension
+ *  \c dim: the augmented square matrix of a HessianFactor, which also bounds the augmented matrix
+ *  of a JacobianFactor after QR.  Used to estimate the memory of intermediate factors. */
+inline size_t denseFactorBytes(size_t dim) {
+  return (dim + 1) * (dim + 1) * sizeof(double);
+}
+
+/**
+ * Predicted cost of a multifrontal elimination, computed from the structure of the junction tree
+ * before any numeric work, see EliminateableFactorGraph::estimateEliminationCost.  Dimensions
+ * are scalar dimensions, see scalarDimension, and the memory is estimated for dense factors.
+ */
+struct EliminationCostEstimate {
+  double flops; ///< Flops of the dense partial factorizations of all cliques, see eliminationFlops
+  size_t rNonzeros; ///< Entries of R: the triangular frontal and the separator blocks of all cliques
+  size_t largestClique; ///< Largest dimension of a clique, frontal plus separator
+  size_t nrCliques; ///< Number of cliques
+  size_t bayesTreeBytes; ///< Storage of the conditionals [R S d] of the Bayes tree
+  size_t peakBytes; ///< Peak memory of a serial elimination: the Bayes tree so far, the remaining
+                    ///< factors waiting for their parent and the joint factor being eliminated
+
+  EliminationCostEstimate() : flops(0.0), rNonzeros(0), largestClique(0), nrCliques(0),
+      bayesTreeBytes(0), peakBytes(0) {}
+};
+
+}
@@ -0,0 +1,78 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testFactorColoring.cpp
+ * @brief   Unit tests for the coloring of factors sharing no variable
+ * @date    Oct 15, 2026
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam/inference/FactorColoring.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+
+#include <boost/assign/list_of.hpp>
+
+using namespace gtsam;
+using namespace std;
+using boost::assign::list_of;
+
+/* ************************************************************************* */
+TEST(FactorColoring, chain) {
+  SymbolicFactorGraph fg;
+  fg.push_factor(0);
+  fg.push_factor(0, 1);
+  fg.push_factor(1, 2);
+  fg.push_back(SymbolicFactor::shared_ptr());
+  fg.push_factor(2, 3);
+  fg.push_factor(5, 9);
+
+  FactorColoring actual(fg);
+  LONGS_EQUAL(5, actual.nrFactors());
+  LONGS_EQUAL(2, actual.nrColors());
+  const FactorColoring::Factors expected0 = list_of(0)(2)(5), expected1 = list_of(1)(4);
+  EXPECT(expected0 == actual.color(0));
+  EXPECT(expected1 == actual.color(1));
+}
+
+/* ************************************************************************* */
+TEST(FactorColoring, disjoint) {
+  // A grid of variables with factors on neighbors, plus a variable shared by many factors
+  SymbolicFactorGraph fg;
+  const Key hub = 1000;
+  for (Key i = 0; i < 10; ++i)
+    for (Key j = 0; j < 10; ++j) {
+      if (j + 1 < 10) fg.push_factor(10 * i + j, 10 * i + j + 1);
+      if (i + 1 < 10) fg.push_factor(10 * i + j, 10 * (i + 1) + j);
+      if (j == 0) fg.push_factor(10 * i, hub);
+    }
+  FactorColoring coloring(fg);
+  LONGS_EQUAL(fg.size(), coloring.nrFactors());
+  EXPECT(coloring.nrColors() >= 10);
+
+  // Every factor has exactly one color, and the factors of a color share no variable
+  vector<size_t> nrColors(fg.size(), 0);
+  for (size_t c = 0; c < coloring.nrColors(); ++c) {
+    KeySet keys;
+    BOOST_FOREACH(size_t i, coloring.color(c)) {
+      ++nrColors[i];
+      BOOST_FOREACH(Key key, fg[i]->keys())
+        EXPECT(keys.insert(key).second);
+    }
+  }
+  BOOST_FOREACH(size_t n, nrColors)
+    EXPECT_LONGS_EQUAL(1, n);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
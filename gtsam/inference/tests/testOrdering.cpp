@@ -17,6 +17,7 @@
 
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/symbolic/SymbolicBayesTree.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/MetisIndex.h>
 #include <gtsam/base/TestableAssertions.h>
@@ -262,6 +263,98 @@ TEST(Ordering, MetisLoop) {
 #endif
 }
 
+/* ************************************************************************* */
+TEST(Ordering, NestedDissection) {
+
+  // create a 20x20 grid
+  SymbolicFactorGraph sfg;
+  const size_t side = 20;
+  for (size_t i = 0; i < side; ++i) {
+    for (size_t j = 0; j < side; ++j) {
+      if (i + 1 < side) sfg.push_factor(i * side + j, (i + 1) * side + j);
+      if (j + 1 < side) sfg.push_factor(i * side + j, i * side + j + 1);
+    }
+  }
+
+  Ordering actual = Ordering::NestedDissection(sfg, 50);
+
+  // Every variable appears exactly once
+  EXPECT_LONGS_EQUAL(side * side, actual.size());
+  KeySet keys(actual.begin(), actual.end());
+  EXPECT_LONGS_EQUAL(side * side, keys.size());
+
+  // Deterministic, and reachable through Create
+  EXPECT(assert_equal(actual, Ordering::NestedDissection(sfg, 50)));
+  EXPECT_LONGS_EQUAL(side * side, Ordering::Create(Ordering::NESTED_DISSECTION, sfg).size());
+
+  // The top-level separator splits the grid, so the elimination tree has at least two subtrees
+  // below the root clique
+  SymbolicBayesTree::shared_ptr bayesTree = sfg.eliminateMultifrontal(actual);
+  EXPECT_LONGS_EQUAL(1, bayesTree->roots().size());
+  EXPECT(bayesTree->roots().front()->children.size() >= 2);
+}
+
+/* ************************************************************************* */
+TEST(Ordering, MetisParallelThreshold) {
+
+  // create a 20x20 grid
+  SymbolicFactorGraph sfg;
+  const size_t side = 20;
+  for (size_t i = 0; i < side; ++i) {
+    for (size_t j = 0; j < side; ++j) {
+      if (i + 1 < side) sfg.push_factor(i * side + j, (i + 1) * side + j);
+      if (j + 1 < side) sfg.push_factor(i * side + j, i * side + j + 1);
+    }
+  }
+
+  // Above the threshold METIS is run in parallel (with TBB), which is deterministic as well
+  Ordering actual = Ordering::Metis(sfg, 100);
+  EXPECT_LONGS_EQUAL(side * side, KeySet(actual.begin(), actual.end()).size());
+  EXPECT(assert_equal(actual, Ordering::Metis(sfg, 100)));
+#ifdef GTSAM_USE_TBB
+  EXPECT(assert_equal(Ordering::NestedDissection(sfg, 100), actual));
+#else
+  EXPECT(assert_equal(Ordering::Metis(sfg), actual));
+#endif
+
+  // The serial METIS ordering is not affected by ordering in parallel before
+  Ordering serial = Ordering::Metis(sfg);
+  Ordering::NestedDissection(sfg, 50);
+  EXPECT(assert_equal(serial, Ordering::Metis(sfg)));
+}
+
+/* ************************************************************************* */
+TEST(Ordering, Amd) {
+
+  // Star: the center is adjacent to every other variable, so it is eliminated last
+  SymbolicFactorGraph star;
+  for (size_t j = 1; j <= 6; ++j)
+    star.push_factor(0, j);
+  Ordering actual = Ordering::Amd(star);
+  EXPECT_LONGS_EQUAL(7, actual.size());
+  EXPECT_LONGS_EQUAL(7, KeySet(actual.begin(), actual.end()).size());
+  EXPECT_LONGS_EQUAL(0, actual.back());
+
+  // On a chain, AMD eliminates from the ends and so causes no fill-in: every conditional has
+  // at most one parent
+  SymbolicFactorGraph chain = example::symbolicChain();
+  actual = Ordering::Create(Ordering::AMD, chain);
+  EXPECT_LONGS_EQUAL(6, actual.size());
+  SymbolicBayesNet::shared_ptr bayesNet = chain.eliminateSequential(actual);
+  BOOST_FOREACH(const SymbolicConditional::shared_ptr& conditional, *bayesNet)
+    EXPECT(conditional->nrParents() <= 1);
+
+  // Same result through the elimination functions
+  EXPECT(assert_equal(*bayesNet,
+      *chain.eliminateSequential(boost::none, EliminateSymbolic, boost::none, Ordering::AMD)));
+
+  // Single variable and empty graphs
+  SymbolicFactorGraph single;
+  single.push_factor(3);
+  EXPECT(assert_equal(Ordering(list_of(3)), Ordering::Amd(single)));
+  EXPECT_LONGS_EQUAL(0, Ordering::Amd(SymbolicFactorGraph()).size());
+}
+
 /* ************************************************************************* */
 TEST(Ordering, Create) {
 
@@ -21,21 +21,23 @@
 #pragma once
 
 #include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/VectorValues.h>
 #include <gtsam/base/SymmetricBlockMatrix.h>
 #include <gtsam/base/timing.h>
 
 namespace gtsam {
 
 /**
- * A binary JacobianFactor specialization that uses fixed matrix math for speed
+ * A binary JacobianFactor specialization that uses fixed matrix math for speed.
+ * The number of rows M may be Eigen::Dynamic, as the fixed-size products only
+ * depend on the variable dimensions N1 and N2.
  */
 template<int M, int N1, int N2>
 struct BinaryJacobianFactor: JacobianFactor {
 
-  /// Constructor
-  BinaryJacobianFactor(Key key1, const Eigen::Matrix<double, M, N1>& A1,
-      Key key2, const Eigen::Matrix<double, M, N2>& A2,
-      const Eigen::Matrix<double, M, 1>& b, //
+  /// Constructor, the matrices should be M*N1 and M*N2, and b should have M rows
+  BinaryJacobianFactor(Key key1, const Matrix& A1, Key key2, const Matrix& A2,
+      const Vector& b, //
       const SharedDiagonal& model = SharedDiagonal()) :
       JacobianFactor(key1, A1, key2, A2, b, model) {
   }
@@ -59,7 +61,7 @@ struct BinaryJacobianFactor: JacobianFactor {
             "BinaryJacobianFactor::updateHessian: cannot update information with "
                 "constrained noise model");
       BinaryJacobianFactor whitenedFactor(key1(), model->Whiten(getA(begin())),
-          key2(), model->Whiten(getA(end())), model->whiten(getb()));
+          key2(), model->Whiten(getA(begin() + 1)), model->whiten(getb()));
       whitenedFactor.updateHessian(infoKeys, info);
     } else {
       // First build an array of slots
@@ -67,10 +69,9 @@ struct BinaryJacobianFactor: JacobianFactor {
       DenseIndex slot2 = Slot(infoKeys, key2());
       DenseIndex slotB = info->nBlocks() - 1;
 
-      const Matrix& Ab = Ab_.matrix();
-      Eigen::Block<const Matrix, M, N1> A1(Ab, 0, 0);
-      Eigen::Block<const Matrix, M, N2> A2(Ab, 0, N1);
-      Eigen::Block<const Matrix, M, 1> b(Ab, 0, N1 + N2);
+      const Block1 A1 = this->A1();
+      const Block2 A2 = this->A2();
+      const BlockB b = this->b();
 
       // We perform I += A'*A to the upper triangle
       (*info)(slot1, slot1).selfadjointView().rankUpdate(A1.transpose());
@@ -81,6 +82,58 @@ struct BinaryJacobianFactor: JacobianFactor {
       (*info)(slotB, slotB)(0, 0) += b.transpose() * b;
     }
   }
+
+  /// x += alpha * A'*e, with fixed-size products unless there is a noise model
+  void transposeMultiplyAdd(double alpha, const Vector& e, VectorValues& x) const {
+    if (model_) {
+      JacobianFactor::transposeMultiplyAdd(alpha, e, x);
+      return;
+    }
+    const Eigen::Matrix<double, N1, 1> x1 = alpha * (A1().transpose() * e);
+    const Eigen::Matrix<double, N2, 1> x2 = alpha * (A2().transpose() * e);
+    AddTo(x, key1(), x1);
+    AddTo(x, key2(), x2);
+  }
+
+  /// y += alpha * A'*A*x, with fixed-size products unless there is a noise model
+  void multiplyHessianAdd(double alpha, const VectorValues& x, VectorValues& y) const {
+    if (model_) {
+      JacobianFactor::multiplyHessianAdd(alpha, x, y);
+      return;
+    }
+    const Block1 A1 = this->A1();
+    const Block2 A2 = this->A2();
+    const Eigen::Matrix<double, M, 1> Ax = A1 * x.at(key1()) + A2 * x.at(key2());
+    const Eigen::Matrix<double, N1, 1> y1 = alpha * (A1.transpose() * Ax);
+    const Eigen::Matrix<double, N2, 1> y2 = alpha * (A2.transpose() * Ax);
+    AddTo(y, key1(), y1);
+    AddTo(y, key2(), y2);
+  }
+
+private:
+
+  typedef Eigen::Block<const Matrix, M, N1> Block1;
+  typedef Eigen::Block<const Matrix, M, N2> Block2;
+  typedef Eigen::Block<const Matrix, M, 1> BlockB;
+
+  // Fixed-size views of the augmented matrix [A1 A2 b]
+  Block1 A1() const {
+    return Block1(Ab_.matrix(), 0, 0, rows(), Ab_(0).cols());
+  }
+  Block2 A2() const {
+    return Block2(Ab_.matrix(), 0, Ab_.offset(1), rows(), Ab_(1).cols());
+  }
+  BlockB b() const {
+    return BlockB(Ab_.matrix(), 0, Ab_.offset(2), rows(), 1);
+  }
+
+  // Add v to x[j], inserting it if it does not exist yet
+  template<int N>
+  static void AddTo(VectorValues& x, Key j, const Eigen::Matrix<double, N, 1>& v) {
+    std::pair<VectorValues::iterator, bool> xj = x.tryInsert(j, v);
+    if (!xj.second)
+      xj.first->second += v;
+  }
 };
 
 template<int M, int N1, int N2>
@@ -33,7 +33,9 @@ void ConjugateGradientParameters::print(ostream &os) const {
         << "maxIter:       " << maxIterations_ << endl
         << "resetIter:     " << reset_ << endl
         << "eps_rel:       " << epsilon_rel_ << endl
-        << "eps_abs:       " << epsilon_abs_ << endl;
+        << "eps_abs:       " << epsilon_abs_ << endl
+        << "blasKernel:    " << blasTranslator(blas_kernel_) << endl
+        << "variant:       " << variantTranslator(cg_variant_) << endl;
 }
 
 /*****************************************************************************/
@@ -41,6 +43,7 @@ std::string ConjugateGradientParameters::blasTranslator(const BLASKernel value)
   std::string s;
   switch (value) {
   case ConjugateGradientParameters::GTSAM:      s = "GTSAM" ;      break;
+  case ConjugateGradientParameters::BSR:        s = "BSR" ;        break;
   default:                                      s = "UNDEFINED" ;  break;
   }
   return s;
@@ -51,11 +54,35 @@ ConjugateGradientParameters::BLASKernel ConjugateGradientParameters::blasTransla
     const std::string &src) {
   std::string s = src;  boost::algorithm::to_upper(s);
   if (s == "GTSAM")  return ConjugateGradientParameters::GTSAM;
+  if (s == "BSR")    return ConjugateGradientParameters::BSR;
 
   /* default is SBM */
   return ConjugateGradientParameters::GTSAM;
 }
 
+/*****************************************************************************/
+std::string ConjugateGradientParameters::variantTranslator(const CGVariant value) {
+  std::string s;
+  switch (value) {
+  case ConjugateGradientParameters::STANDARD:   s = "STANDARD" ;   break;
+  case ConjugateGradientParameters::PIPELINED:  s = "PIPELINED" ;  break;
+  case ConjugateGradientParameters::BLOCK:      s = "BLOCK" ;      break;
+  default:                                      s = "UNDEFINED" ;  break;
+  }
+  return s;
+}
+
+/*****************************************************************************/
+ConjugateGradientParameters::CGVariant ConjugateGradientParameters::variantTranslator(
+    const std::string &src) {
+  std::string s = src;  boost::algorithm::to_upper(s);
+  if (s == "PIPELINED")  return ConjugateGradientParameters::PIPELINED;
+  if (s == "BLOCK")      return ConjugateGradientParameters::BLOCK;
+
+  /* default is STANDARD */
+  return ConjugateGradientParameters::STANDARD;
+}
+
 /*****************************************************************************/
 
 }
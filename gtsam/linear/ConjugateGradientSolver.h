@@ -20,6 +20,8 @@
 #pragma once
 
 #include <gtsam/linear/IterativeSolver.h>
+#include <gtsam/base/Matrix.h>
+#include <Eigen/QR>
 
 namespace gtsam {
 
@@ -41,20 +43,30 @@ public:
   /* Matrix Operation Kernel */
   enum BLASKernel {
     GTSAM = 0,        ///< Jacobian Factor Graph of GTSAM
+    BSR = 1,          ///< Hessian assembled once into block sparse row storage, see BlockSparseHessian
   } blas_kernel_ ;
 
+  /* Conjugate Gradient Variant */
+  enum CGVariant {
+    STANDARD = 0,     ///< Textbook PCG, with two dependent reductions per iteration
+    PIPELINED = 1,    ///< Ghysels-Vanroose pipelined PCG, see pipelinedConjugateGradient
+    BLOCK = 2,        ///< Block PCG over all right-hand sides at once, see PCGSolver::solve
+  } cg_variant_ ;
+
   ConjugateGradientParameters()
     : minIterations_(1), maxIterations_(500), reset_(501), epsilon_rel_(1e-3),
-      epsilon_abs_(1e-3), blas_kernel_(GTSAM) {}
+      epsilon_abs_(1e-3), blas_kernel_(GTSAM), cg_variant_(STANDARD) {}
 
   ConjugateGradientParameters(size_t minIterations, size_t maxIterations, size_t reset,
-    double epsilon_rel, double epsilon_abs, BLASKernel blas)
+    double epsilon_rel, double epsilon_abs, BLASKernel blas, CGVariant variant = STANDARD)
     : minIterations_(minIterations), maxIterations_(maxIterations), reset_(reset),
-      epsilon_rel_(epsilon_rel), epsilon_abs_(epsilon_abs), blas_kernel_(blas) {}
+      epsilon_rel_(epsilon_rel), epsilon_abs_(epsilon_abs), blas_kernel_(blas),
+      cg_variant_(variant) {}
 
   ConjugateGradientParameters(const ConjugateGradientParameters &p)
     : Base(p), minIterations_(p.minIterations_), maxIterations_(p.maxIterations_), reset_(p.reset_),
-               epsilon_rel_(p.epsilon_rel_), epsilon_abs_(p.epsilon_abs_), blas_kernel_(GTSAM) {}
+               epsilon_rel_(p.epsilon_rel_), epsilon_abs_(p.epsilon_abs_), blas_kernel_(p.blas_kernel_),
+               cg_variant_(p.cg_variant_) {}
 
   /* general interface */
   inline size_t minIterations() const { return minIterations_; }
@@ -63,6 +75,7 @@ public:
   inline double epsilon() const { return epsilon_rel_; }
   inline double epsilon_rel() const { return epsilon_rel_; }
   inline double epsilon_abs() const { return epsilon_abs_; }
+  inline CGVariant variant() const { return cg_variant_; }
 
   inline size_t getMinIterations() const { return minIterations_; }
   inline size_t getMaxIterations() const { return maxIterations_; }
@@ -77,6 +90,7 @@ public:
   inline void setEpsilon(double value) { epsilon_rel_ = value; }
   inline void setEpsilon_rel(double value) { epsilon_rel_ = value; }
   inline void setEpsilon_abs(double value) { epsilon_abs_ = value; }
+  inline void setVariant(CGVariant value) { cg_variant_ = value; }
 
 
   void print() const { Base::print(); }
@@ -84,13 +98,16 @@ public:
 
   static std::string blasTranslator(const BLASKernel k) ;
   static BLASKernel blasTranslator(const std::string &s) ;
+  static std::string variantTranslator(const CGVariant v) ;
+  static CGVariant variantTranslator(const std::string &s) ;
 };
 
 /*
  * A template for the linear preconditioned conjugate gradient method.
  * System class should support residual(v, g), multiply(v,Av), scal(alpha,v), dot(v,v), axpy(alpha,x,y)
- * leftPrecondition(v, L^{-1}v, rightPrecondition(v, L^{-T}v) where preconditioner M = L*L^T
- * Note that the residual is in the preconditioned domain. Refer to Section 9.2 of Saad's book.
+ * and precondition(v, M^{-1}v). The preconditioner M does not need to be given in split form
+ * M = L*L^T, and gamma = r'*M^{-1}*r is the squared norm of the residual in the preconditioned
+ * domain. Refer to Section 9.2 of Saad's book.
  *
  ** REFERENCES:
  * [1] Y. Saad, "Preconditioned Iterations," in Iterative Methods for Sparse Linear Systems,
@@ -100,14 +117,14 @@ template<class S, class V>
 V preconditionedConjugateGradient(const S &system, const V &initial,
     const ConjugateGradientParameters &parameters) {
 
-  V estimate, residual, direction, q1, q2;
-  estimate = residual = direction = q1 = q2 = initial;
+  V estimate, residual, direction, z, q;
+  estimate = residual = direction = z = q = initial;
 
-  system.residual(estimate, q1);                /* q1 = b-Ax */
-  system.leftPrecondition(q1, residual);        /* r = L^{-1} (b-Ax) */
-  system.rightPrecondition(residual, direction);/* p = L^{-T} r */
+  system.residual(estimate, residual);          /* r = b-Ax */
+  system.precondition(residual, z);             /* z = M^{-1} r */
+  direction = z;                                /* p = z */
 
-  double currentGamma = system.dot(residual, residual), prevGamma, alpha, beta;
+  double currentGamma = system.dot(residual, z), prevGamma, alpha, beta;
 
   const size_t iMaxIterations = parameters.maxIterations(),
                iMinIterations = parameters.minIterations(),
@@ -126,22 +143,21 @@ V preconditionedConjugateGradient(const S &system, const V &initial,
   for ( k = 1 ; k <= iMaxIterations && (currentGamma > threshold || k <= iMinIterations) ; k++ ) {
 
     if ( k % iReset == 0 ) {
-      system.residual(estimate, q1);                      /* q1 = b-Ax */
-      system.leftPrecondition(q1, residual);              /* r = L^{-1} (b-Ax) */
-      system.rightPrecondition(residual, direction);      /* p = L^{-T} r */
-      currentGamma = system.dot(residual, residual);
+      system.residual(estimate, residual);                /* r = b-Ax */
+      system.precondition(residual, z);                   /* z = M^{-1} r */
+      direction = z;                                      /* p = z */
+      currentGamma = system.dot(residual, z);
     }
-    system.multiply(direction, q1);                       /* q1 = A p */
-    alpha = currentGamma / system.dot(direction, q1);     /* alpha = gamma / (p' A p) */
+    system.multiply(direction, q);                        /* q = A p */
+    alpha = currentGamma / system.dot(direction, q);      /* alpha = gamma / (p' A p) */
     system.axpy(alpha, direction, estimate);              /* estimate += alpha * p */
-    system.leftPrecondition(q1, q2);                      /* q2 = L^{-1} * q1 */
-    system.axpy(-alpha, q2, residual);                    /* r -= alpha * q2 */
+    system.axpy(-alpha, q, residual);                     /* r -= alpha * q */
+    system.precondition(residual, z);                     /* z = M^{-1} r */
     prevGamma = currentGamma;
-    currentGamma = system.dot(residual, residual);        /* gamma = |r|^2 */
+    currentGamma = system.dot(residual, z);               /* gamma = r' z */
     beta = currentGamma / prevGamma;
-    system.rightPrecondition(residual, q1);               /* q1 = L^{-T} r */
     system.scal(beta, direction);
-    system.axpy(1.0, q1, direction);                      /* p = q1 + beta * p */
+    system.axpy(1.0, z, direction);                       /* p = z + beta * p */
 
     if (parameters.verbosity() >= ConjugateGradientParameters::ERROR )
        std::cout << "[PCG] k = " << k
@@ -160,5 +176,185 @@ V preconditionedConjugateGradient(const S &system, const V &initial,
   return estimate;
 }
 
+/*
+ * Pipelined version of preconditionedConjugateGradient, with the same system interface and
+ * stopping criterion. The recurrences are rearranged so that the two dot products of an
+ * iteration are computed together, and do not depend on the preconditioner solve and product
+ * with A that follow them, so a parallel system can overlap that reduction with the next
+ * product instead of synchronizing twice per iteration. This costs three extra vectors and
+ * axpy's, and the recurrences lose accuracy faster than in standard PCG, so the residual is
+ * recomputed from the estimate every reset() iterations.
+ *
+ ** REFERENCES:
+ * [1] P. Ghysels and W. Vanroose, "Hiding global synchronization latency in the preconditioned
+ * Conjugate Gradient algorithm," Parallel Computing, vol. 40, no. 7, pp. 224-238, 2014, Alg. 3.
+ */
+template<class S, class V>
+V pipelinedConjugateGradient(const S &system, const V &initial,
+    const ConjugateGradientParameters &parameters) {
+
+  V estimate, residual, u, w, m, n, direction, s, q, z;
+  estimate = residual = u = w = m = n = initial;
+
+  system.residual(estimate, residual);          /* r = b-Ax */
+  system.precondition(residual, u);             /* u = M^{-1} r */
+  system.multiply(u, w);                        /* w = A u */
+  direction = s = q = z = initial;
+  system.scal(0.0, direction);
+  system.scal(0.0, s);
+  system.scal(0.0, q);
+  system.scal(0.0, z);
+
+  double currentGamma = system.dot(residual, u), delta = system.dot(w, u),
+      prevGamma = currentGamma, alpha = 1.0, beta;
+
+  const size_t iMaxIterations = parameters.maxIterations(),
+               iMinIterations = parameters.minIterations(),
+               iReset = parameters.reset() ;
+  const double threshold = std::max(parameters.epsilon_abs(),
+                                    parameters.epsilon() * parameters.epsilon() * currentGamma);
+
+  if (parameters.verbosity() >= ConjugateGradientParameters::COMPLEXITY )
+    std::cout << "[PPCG] epsilon = " << parameters.epsilon()
+             << ", max = " << parameters.maxIterations()
+             << ", reset = " << parameters.reset()
+             << ", ||r0||^2 = " << currentGamma
+             << ", threshold = " << threshold << std::endl;
+
+  size_t k;
+  bool restart = true;
+  for ( k = 1 ; k <= iMaxIterations && (currentGamma > threshold || k <= iMinIterations) ; k++ ) {
+
+    if ( k % iReset == 0 ) {
+      system.residual(estimate, residual);                /* r = b-Ax */
+      system.precondition(residual, u);                   /* u = M^{-1} r */
+      system.multiply(u, w);                              /* w = A u */
+      currentGamma = system.dot(residual, u);
+      delta = system.dot(w, u);
+      restart = true;
+    }
+    system.precondition(w, m);                            /* m = M^{-1} w */
+    system.multiply(m, n);                                /* n = A m */
+
+    if (restart) {
+      beta = 0.0;
+      alpha = currentGamma / delta;
+      restart = false;
+    } else {
+      beta = currentGamma / prevGamma;
+      alpha = currentGamma / (delta - beta * currentGamma / alpha);
+    }
+
+    system.scal(beta, z);
+    system.axpy(1.0, n, z);                               /* z = n + beta * z */
+    system.scal(beta, q);
+    system.axpy(1.0, m, q);                               /* q = m + beta * q */
+    system.scal(beta, s);
+    system.axpy(1.0, w, s);                               /* s = w + beta * s */
+    system.scal(beta, direction);
+    system.axpy(1.0, u, direction);                       /* p = u + beta * p */
+    system.axpy(alpha, direction, estimate);              /* estimate += alpha * p */
+    system.axpy(-alpha, s, residual);                     /* r -= alpha * s */
+    system.axpy(-alpha, q, u);                            /* u -= alpha * q */
+    system.axpy(-alpha, z, w);                            /* w -= alpha * z */
+
+    // The only reduction of the iteration, whose result is not needed before the next
+    // preconditioner solve and product are done
+    prevGamma = currentGamma;
+    currentGamma = system.dot(residual, u);               /* gamma = r' u */
+    delta = system.dot(w, u);                             /* delta = w' u */
+
+    if (parameters.verbosity() >= ConjugateGradientParameters::ERROR )
+       std::cout << "[PPCG] k = " << k
+                 << ", alpha = " << alpha
+                 << ", beta = " << beta
+                 << ", ||r||^2 = " << currentGamma
+                 << std::endl;
+  }
+  if (parameters.verbosity() >= ConjugateGradientParameters::COMPLEXITY )
+     std::cout << "[PPCG] iterations = " << k
+               << ", ||r||^2 = " << currentGamma
+               << std::endl;
+
+  return estimate;
+}
+
+/*
+ * Block preconditioned conjugate gradient for several right-hand sides, the columns of B, that
+ * share the same system.  All columns are updated together from a search space spanned by the
+ * directions of every column, so each iteration is one product of A with a block of vectors,
+ * and the number of iterations is usually smaller than for the slowest column alone.  This is
+ * worthwhile when A is applied matrix-free, e.g. when probing columns of a covariance.
+ * System class should support multiply(P, AP) and precondition(R, M^{-1}R) on matrices.
+ * Iterations stop when the squared preconditioned residual of every column is below the
+ * threshold of preconditionedConjugateGradient.
+ *
+ ** REFERENCES:
+ * [1] D. P. O'Leary, "The block conjugate gradient algorithm and related methods," Linear
+ * Algebra and its Applications, vol. 29, pp. 293-322, 1980.
+ */
+template<class S>
+Matrix preconditionedBlockConjugateGradient(const S &system, const Matrix &B,
+    const Matrix &initial, const ConjugateGradientParameters &parameters) {
+
+  Matrix estimate = initial, residual(B.rows(), B.cols()), z(B.rows(), B.cols()),
+      q(B.rows(), B.cols());
+
+  system.multiply(estimate, q);
+  residual = B - q;                                       /* R = B-AX */
+  system.precondition(residual, z);                       /* Z = M^{-1} R */
+  Matrix direction = z;                                   /* P = Z */
+  Matrix currentGamma = z.transpose() * residual, prevGamma;
+
+  const size_t iMaxIterations = parameters.maxIterations(),
+               iMinIterations = parameters.minIterations();
+  const Vector threshold = (parameters.epsilon() * parameters.epsilon()
+      * currentGamma.diagonal()).cwiseMax(parameters.epsilon_abs());
+
+  if (parameters.verbosity() >= ConjugateGradientParameters::COMPLEXITY )
+    std::cout << "[BPCG] epsilon = " << parameters.epsilon()
+             << ", max = " << parameters.maxIterations()
+             << ", columns = " << B.cols() << std::endl;
+
+  size_t k;
+  for ( k = 1 ; k <= iMaxIterations && ((currentGamma.diagonal() - threshold).maxCoeff() > 0
+      || k <= iMinIterations) ; k++ ) {
+
+    system.multiply(direction, q);                        /* Q = A P */
+    // The search directions become dependent as columns converge, so solve with pivoting
+    const Matrix alpha = (direction.transpose() * q).colPivHouseholderQr().solve(currentGamma);
+    estimate.noalias() += direction * alpha;              /* X += P alpha */
+    residual.noalias() -= q * alpha;                      /* R -= Q alpha */
+    system.precondition(residual, z);                     /* Z = M^{-1} R */
+    prevGamma = currentGamma;
+    currentGamma = z.transpose() * residual;              /* Gamma = Z' R */
+    const Matrix beta = prevGamma.colPivHouseholderQr().solve(currentGamma);
+    direction = z + direction * beta;                     /* P = Z + P beta */
+
+    if (parameters.verbosity() >= ConjugateGradientParameters::ERROR )
+       std::cout << "[BPCG] k = " << k
+                 << ", max ||r||^2 = " << currentGamma.diagonal().maxCoeff()
+                 << std::endl;
+  }
+  if (parameters.verbosity() >= ConjugateGradientParameters::COMPLEXITY )
+     std::cout << "[BPCG] iterations = " << k
+               << ", max ||r||^2 = " << currentGamma.diagonal().maxCoeff()
+               << std::endl;
+
+  return estimate;
+}
+
+/*
+ * Run the conjugate gradient variant selected in the parameters on a single right-hand side.
+ * Block PCG with one right-hand side is standard PCG.
+ */
+template<class S, class V>
+V conjugateGradient(const S &system, const V &initial,
+    const ConjugateGradientParameters &parameters) {
+  if (parameters.variant() == ConjugateGradientParameters::PIPELINED)
+    return pipelinedConjugateGradient(system, initial, parameters);
+  return preconditionedConjugateGradient(system, initial, parameters);
+}
+
 
 }
@@ -0,0 +1,160 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DenseVectorValues.cpp
+ * @brief   VectorValues stored in one contiguous vector
+ * @date    Oct 14, 2026
+ */
+
+#include <gtsam/linear/DenseVectorValues.h>
+
+#include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  DenseVectorValues::DenseVectorValues() : layout_(boost::make_shared<Layout>()) {
+  }
+
+  /* ************************************************************************* */
+  DenseVectorValues::DenseVectorValues(const VectorValues& values) {
+    boost::shared_ptr<Layout> layout = boost::make_shared<Layout>();
+    DenseIndex offset = 0;
+    BOOST_FOREACH(const VectorValues::value_type& key_value, values) {
+      layout->insert(make_pair(key_value.first, Slot(offset, key_value.second.size())));
+      offset += key_value.second.size();
+    }
+    values_.resize(offset);
+    BOOST_FOREACH(const VectorValues::value_type& key_value, values) {
+      const Slot& s = layout->at(key_value.first);
+      values_.segment(s.offset, s.dim) = key_value.second;
+    }
+    layout_ = layout;
+  }
+
+  /* ************************************************************************* */
+  DenseVectorValues::DenseVectorValues(const VectorValues& values, const Ordering& ordering) {
+    if (ordering.size() != values.size())
+      throw invalid_argument(
+          "DenseVectorValues: the ordering does not contain the same keys as the VectorValues");
+    boost::shared_ptr<Layout> layout = boost::make_shared<Layout>();
+    DenseIndex offset = 0;
+    BOOST_FOREACH(Key key, ordering) {
+      VectorValues::const_iterator item = values.find(key);
+      if (item == values.end() || !layout->insert(make_pair(key,
+          Slot(offset, item->second.size()))).second)
+        throw invalid_argument(
+            "DenseVectorValues: the ordering does not contain the same keys as the VectorValues");
+      offset += item->second.size();
+    }
+    values_.resize(offset);
+    BOOST_FOREACH(const Layout::value_type& key_slot, *layout)
+      values_.segment(key_slot.second.offset, key_slot.second.dim) = values.at(key_slot.first);
+    layout_ = layout;
+  }
+
+  /* ************************************************************************* */
+  DenseVectorValues DenseVectorValues::Zero(const DenseVectorValues& other) {
+    return DenseVectorValues(other.layout_, Vector::Zero(other.values_.size()));
+  }
+
+  /* ************************************************************************* */
+  const DenseVectorValues::Slot& DenseVectorValues::slot(Key j) const {
+    Layout::const_iterator item = layout_->find(j);
+    if (item == layout_->end())
+      throw std::out_of_range(
+          "Requested variable '" + DefaultKeyFormatter(j) + "' is not in this DenseVectorValues.");
+    return item->second;
+  }
+
+  /* ************************************************************************* */
+  VectorValues DenseVectorValues::vectorValues() const {
+    VectorValues result;
+    BOOST_FOREACH(const Layout::value_type& key_slot, *layout_)
+      result.insert(key_slot.first, values_.segment(key_slot.second.offset, key_slot.second.dim));
+    return result;
+  }
+
+  /* ************************************************************************* */
+  void DenseVectorValues::print(const string& str, const KeyFormatter& formatter) const {
+    cout << str << ": " << size() << " elements\n";
+    BOOST_FOREACH(const Layout::value_type& key_slot, *layout_)
+      cout << "  " << formatter(key_slot.first) << ": "
+          << values_.segment(key_slot.second.offset, key_slot.second.dim).transpose() << "\n";
+    cout.flush();
+  }
+
+  /* ************************************************************************* */
+  bool DenseVectorValues::equals(const DenseVectorValues& x, double tol) const {
+    // Compare variable by variable, so that the layouts may differ in the order of the keys
+    if (size() != x.size())
+      return false;
+    BOOST_FOREACH(const Layout::value_type& key_slot, *layout_) {
+      if (!x.exists(key_slot.first))
+        return false;
+      const ConstSubVector other = x.at(key_slot.first);
+      if (other.size() != key_slot.second.dim || !equal_with_abs_tol(Vector(other),
+          Vector(values_.segment(key_slot.second.offset, key_slot.second.dim)), tol))
+        return false;
+    }
+    return true;
+  }
+
+  /* ************************************************************************* */
+  double DenseVectorValues::dot(const DenseVectorValues& v) const {
+    assert_throw(hasSameLayout(v),
+        invalid_argument("DenseVectorValues::dot called with a different layout"));
+    return values_.dot(v.values_);
+  }
+
+  /* ************************************************************************* */
+  DenseVectorValues DenseVectorValues::operator+(const DenseVectorValues& c) const {
+    assert_throw(hasSameLayout(c),
+        invalid_argument("DenseVectorValues::operator+ called with a different layout"));
+    return DenseVectorValues(layout_, values_ + c.values_);
+  }
+
+  /* ************************************************************************* */
+  DenseVectorValues& DenseVectorValues::operator+=(const DenseVectorValues& c) {
+    assert_throw(hasSameLayout(c),
+        invalid_argument("DenseVectorValues::operator+= called with a different layout"));
+    values_ += c.values_;
+    return *this;
+  }
+
+  /* ************************************************************************* */
+  DenseVectorValues DenseVectorValues::operator-(const DenseVectorValues& c) const {
+    assert_throw(hasSameLayout(c),
+        invalid_argument("DenseVectorValues::operator- called with a different layout"));
+    return DenseVectorValues(layout_, values_ - c.values_);
+  }
+
+  /* ************************************************************************* */
+  DenseVectorValues& DenseVectorValues::axpy(double alpha, const DenseVectorValues& x) {
+    assert_throw(hasSameLayout(x),
+        invalid_argument("DenseVectorValues::axpy called with a different layout"));
+    values_ += alpha * x.values_;
+    return *this;
+  }
+
+  /* ************************************************************************* */
+  DenseVectorValues DenseVectorValues::scale(double a) const {
+    return DenseVectorValues(layout_, a * values_);
+  }
+
+} // \namespace gtsam
@@ -0,0 +1,195 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DenseVectorValues.h
+ * @brief   VectorValues stored in one contiguous vector
+ * @date    Oct 14, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/Vector.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace gtsam {
+
+  /**
+   * A collection of vector-valued variables, like VectorValues, stored in a single contiguous
+   * Vector together with a table of the offset and dimension of each key.  The table is shared by
+   * all copies and by vectors created with Zero(), so that the linear algebra operations (dot,
+   * axpy, add, scale) between vectors with the same layout run as single operations on the
+   * underlying Vector, without map lookups or per-variable allocations.  This is the layout to
+   * use for the vectors in iterative solvers.
+   * \nosubgrouping
+   */
+  class GTSAM_EXPORT DenseVectorValues {
+  public:
+
+    /// Position of one variable in the contiguous vector
+    struct Slot {
+      DenseIndex offset; ///< Start of the variable in the contiguous vector
+      DenseIndex dim; ///< Dimension of the variable
+      Slot(DenseIndex _offset = 0, DenseIndex _dim = 0) : offset(_offset), dim(_dim) {}
+      bool operator==(const Slot& other) const {
+        return offset == other.offset && dim == other.dim;
+      }
+    };
+
+    typedef FastMap<Key, Slot> Layout; ///< Offset and dimension of each key
+
+  protected:
+    boost::shared_ptr<const Layout> layout_; ///< Layout, shared between vectors
+    Vector values_; ///< Contiguous storage of all variables
+
+  public:
+
+    /// @name Standard Constructors
+    /// @{
+
+    /** Default constructor creates an empty DenseVectorValues. */
+    DenseVectorValues();
+
+    /** Copy the values of a VectorValues, laid out in increasing key order. */
+    explicit DenseVectorValues(const VectorValues& values);
+
+    /** Copy the values of a VectorValues, laid out in the given ordering, which should contain all
+     *  the keys of \c values and only those.  Throws std::invalid_argument otherwise. */
+    DenseVectorValues(const VectorValues& values, const Ordering& ordering);
+
+    /** Create a DenseVectorValues with the same layout as \c other, but filled with zeros. */
+    static DenseVectorValues Zero(const DenseVectorValues& other);
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /** Number of variables stored. */
+    size_t size() const { return layout_->size(); }
+
+    /** Total dimension of all variables. */
+    size_t dim() const { return values_.size(); }
+
+    /** Return the dimension of variable \c j. */
+    size_t dim(Key j) const { return slot(j).dim; }
+
+    /** Check whether a variable with key \c j exists. */
+    bool exists(Key j) const { return layout_->find(j) != layout_->end(); }
+
+    /** Read/write access to the variable with key \c j, throws std::out_of_range if \c j does not
+     *  exist. */
+    SubVector at(Key j) {
+      const Slot& s = slot(j);
+      return values_.segment(s.offset, s.dim);
+    }
+
+    /** Access the variable with key \c j (const version), throws std::out_of_range if \c j does
+     *  not exist. */
+    ConstSubVector at(Key j) const {
+      const Slot& s = slot(j);
+      return values_.segment(s.offset, s.dim);
+    }
+
+    /** Access the variable with key \c j, identical to at(Key). */
+    SubVector operator[](Key j) { return at(j); }
+
+    /** Access the variable with key \c j (const version), identical to at(Key). */
+    ConstSubVector operator[](Key j) const { return at(j); }
+
+    /** The offset and dimension of each key. */
+    const Layout& layout() const { return *layout_; }
+
+    /** The contiguous vector holding all variables. */
+    const Vector& vector() const { return values_; }
+
+    /** The contiguous vector holding all variables (non-const version), which should not be
+     *  resized. */
+    Vector& vector() { return values_; }
+
+    /** Copy the values into a VectorValues. */
+    VectorValues vectorValues() const;
+
+    /** Set all values to zero. */
+    void setZero() { values_.setZero(); }
+
+    /** print required by Testable for unit testing */
+    void print(const std::string& str = "DenseVectorValues: ",
+        const KeyFormatter& formatter = DefaultKeyFormatter) const;
+
+    /** equals required by Testable for unit testing */
+    bool equals(const DenseVectorValues& x, double tol = 1e-9) const;
+
+    /** Check if this DenseVectorValues has the same layout (keys, offsets and dimensions) as
+     *  another, which is required by the linear algebra operations below. */
+    bool hasSameLayout(const DenseVectorValues& other) const {
+      return layout_ == other.layout_ || *layout_ == *other.layout_;
+    }
+
+    /// @}
+    /// @name Linear algebra operations
+    /// @{
+
+    /** Dot product with another DenseVectorValues with the same layout (checked when NDEBUG is
+     *  not defined). */
+    double dot(const DenseVectorValues& v) const;
+
+    /** Vector L2 norm */
+    double norm() const { return values_.norm(); }
+
+    /** Squared vector L2 norm */
+    double squaredNorm() const { return values_.squaredNorm(); }
+
+    /** Element-wise addition.  Both must have the same layout (checked when NDEBUG is not
+     *  defined). */
+    DenseVectorValues operator+(const DenseVectorValues& c) const;
+
+    /** Element-wise addition in-place.  Both must have the same layout (checked when NDEBUG is
+     *  not defined). */
+    DenseVectorValues& operator+=(const DenseVectorValues& c);
+
+    /** Element-wise subtraction.  Both must have the same layout (checked when NDEBUG is not
+     *  defined). */
+    DenseVectorValues operator-(const DenseVectorValues& c) const;
+
+    /** this += alpha * x.  Both must have the same layout (checked when NDEBUG is not defined). */
+    DenseVectorValues& axpy(double alpha, const DenseVectorValues& x);
+
+    /** Element-wise scaling by a constant. */
+    DenseVectorValues scale(double a) const;
+
+    /** Element-wise scaling by a constant in-place. */
+    DenseVectorValues& operator*=(double alpha) {
+      values_ *= alpha;
+      return *this;
+    }
+
+    /// @}
+
+  private:
+    // Create with a given layout and values
+    DenseVectorValues(const boost::shared_ptr<const Layout>& layout, const Vector& values) :
+        layout_(layout), values_(values) {
+    }
+
+    // Slot of key j, or throw std::out_of_range
+    const Slot& slot(Key j) const;
+  };
+
+  /// traits
+  template<>
+  struct traits<DenseVectorValues> : public Testable<DenseVectorValues> {
+  };
+
+} // \namespace gtsam
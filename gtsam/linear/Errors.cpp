@@ -123,6 +123,58 @@ void print(const Errors& a, const string& s) {
   a.print(s);
 }
 
+/* ************************************************************************* */
+ErrorVector::ErrorVector(const Errors& errors) {
+  offsets_.reserve(errors.size() + 1);
+  offsets_.push_back(0);
+  BOOST_FOREACH(const Vector& e, errors)
+    offsets_.push_back(offsets_.back() + e.size());
+  vector_.resize(dim());
+  work_.resize(dim());
+  size_t i = 0;
+  BOOST_FOREACH(const Vector& e, errors)
+    (*this)[i++] = e;
+}
+
+/* ************************************************************************* */
+Errors ErrorVector::errors() const {
+  Errors result;
+  for (size_t i = 0; i < size(); ++i)
+    result.push_back((*this)[i]);
+  return result;
+}
+
+/* ************************************************************************* */
+void ErrorVector::print(const std::string& s) const {
+  errors().print(s);
+}
+
+/* ************************************************************************* */
+bool ErrorVector::equals(const ErrorVector& expected, double tol) const {
+  return offsets_ == expected.offsets_
+      && equal_with_abs_tol(vector_, expected.vector_, tol);
+}
+
+/* ************************************************************************* */
+double dot(const ErrorVector& a, const ErrorVector& b) {
+#ifndef NDEBUG
+  if (a.dim() != b.dim())
+    throw(std::invalid_argument("ErrorVector::dot: incompatible sizes"));
+#endif
+  return a.vector().dot(b.vector());
+}
+
+/* ************************************************************************* */
+template<>
+void axpy<ErrorVector,ErrorVector>(double alpha, const ErrorVector& x, ErrorVector& y) {
+  y.vector() += alpha * x.vector();
+}
+
+/* ************************************************************************* */
+void print(const ErrorVector& a, const string& s) {
+  a.print(s);
+}
+
 /* ************************************************************************* */
 
 } // gtsam
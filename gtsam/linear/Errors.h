@@ -20,6 +20,7 @@
 #pragma once
 
 #include <gtsam/base/FastList.h>
+#include <gtsam/base/FastVector.h>
 #include <gtsam/base/Vector.h>
 #include <gtsam/base/Testable.h>
 
@@ -76,4 +77,77 @@ namespace gtsam {
   struct traits<Errors> : public Testable<Errors> {
   };
 
+  /**
+   * The same errors as Errors, one vector per factor, but stored contiguously in a single vector,
+   * with the errors of factor i at offset(i).  Conjugate gradient on a GaussianFactorGraph uses
+   * it, since dot and axpy are then single vectorized operations on the whole vector, and
+   * GaussianFactorGraph::multiplyInPlace and transposeMultiplyAdd work on it without allocating.
+   */
+  class GTSAM_EXPORT ErrorVector {
+    Vector vector_;
+    FastVector<size_t> offsets_; ///< start of the errors of each factor, and the total dimension
+    mutable Vector work_; ///< scratch space of the same dimension, see work()
+
+  public:
+
+    /** empty, without factors */
+    ErrorVector() : offsets_(1, 0) {}
+
+    /** copy the vectors of \c errors, not explicit so that the result of
+     *  GaussianFactorGraph::operator* can be assigned */
+    ErrorVector(const Errors& errors);
+
+    /** number of factors */
+    size_t size() const { return offsets_.size() - 1; }
+
+    /** total dimension */
+    size_t dim() const { return offsets_.back(); }
+
+    /** start of the errors of factor \c i in vector() */
+    size_t offset(size_t i) const { return offsets_[i]; }
+
+    /** the errors of factor \c i */
+    Eigen::VectorBlock<Vector> operator[](size_t i) {
+      return vector_.segment(offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+
+    /** the errors of factor \c i */
+    Eigen::VectorBlock<const Vector> operator[](size_t i) const {
+      return vector_.segment(offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+
+    /** all errors */
+    Vector& vector() { return vector_; }
+
+    /** all errors */
+    const Vector& vector() const { return vector_; }
+
+    /** scratch space of dimension dim(), for whitening the errors in transposeMultiplyAdd */
+    double* work() const { return work_.data(); }
+
+    /** split into one vector per factor */
+    Errors errors() const;
+
+    /** print */
+    void print(const std::string& s = "ErrorVector") const;
+
+    /** equals, for unit testing */
+    bool equals(const ErrorVector& expected, double tol=1e-9) const;
+  };
+
+  /** dot product */
+  GTSAM_EXPORT double dot(const ErrorVector& a, const ErrorVector& b);
+
+  /** BLAS level 1 style y += alpha * x */
+  template <>
+  GTSAM_EXPORT void axpy<ErrorVector,ErrorVector>(double alpha, const ErrorVector& x, ErrorVector& y);
+
+  /** print with optional string */
+  GTSAM_EXPORT void print(const ErrorVector& a, const std::string& s = "ErrorVector");
+
+  /// traits
+  template<>
+  struct traits<ErrorVector> : public Testable<ErrorVector> {
+  };
+
 } //\ namespace gtsam
@@ -0,0 +1,270 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file FixedKalmanFilter.h
+ * @brief Linear Kalman filter with a fixed-size state, updated in place without heap allocation
+ * @date Oct 14, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/KalmanFilter.h>
+
+#include <Eigen/Householder>
+
+#include <boost/make_shared.hpp>
+#include <boost/static_assert.hpp>
+
+#include <stdexcept>
+
+namespace gtsam {
+
+/**
+ * Fixed-dimension version of KalmanFilter, for running many small filters.
+ *
+ * Like KalmanFilter, it is a square-root information filter, and the density is
+ * \f$ |R x - d|^2 \f$ with upper-triangular R.  Instead of building and eliminating a
+ * GaussianFactorGraph at every step, predict() and update() stack the current [R d] and the new
+ * whitened factor in a fixed-size matrix on the stack and re-triangularize it in place with
+ * Householder reflections, so that no step allocates on the heap.  The dimensions of the
+ * control and measurement inputs are template parameters of the individual methods.
+ *
+ * The state converts to and from KalmanFilter::State (a GaussianDensity) with ToDensity() and
+ * FromDensity(), so this filter can be mixed with KalmanFilter and the rest of GTSAM.  Only
+ * QR factorization is provided.
+ */
+template<int N>
+class FixedKalmanFilter {
+
+public:
+
+  typedef Eigen::Matrix<double, N, N> MatrixN;
+  typedef Eigen::Matrix<double, N, 1> VectorN;
+
+  /**
+   * The filter state: the square-root information matrix R and vector d of the density
+   * \f$ |R x_k - d|^2 \f$ at step k.
+   */
+  struct State {
+    Key k; ///< step index, starts at 0 and is incremented at each predict
+    MatrixN R; ///< upper-triangular square-root information matrix
+    VectorN d; ///< square-root information vector
+
+    /// Mean \f$ \mu = R^{-1} d \f$
+    VectorN mean() const {
+      return R.template triangularView<Eigen::Upper>().solve(d);
+    }
+
+    /// Information matrix \f$ \Lambda = R^T R \f$
+    MatrixN information() const {
+      return R.transpose() * R;
+    }
+
+    /// Covariance matrix \f$ \Sigma = (R^T R)^{-1} \f$
+    MatrixN covariance() const {
+      MatrixN Rinv = MatrixN::Identity();
+      R.template triangularView<Eigen::Upper>().solveInPlace(Rinv);
+      return Rinv * Rinv.transpose();
+    }
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+private:
+
+  // Triangularize the first nrColumns columns of Ab in place with Householder reflections.  Only
+  // the upper-triangular part of the result is meaningful.
+  template<int ROWS, int COLS>
+  static void triangularize(Eigen::Matrix<double, ROWS, COLS>& Ab, int nrColumns) {
+    Eigen::Matrix<double, 1, COLS> workspace;
+    for (int j = 0; j < nrColumns; ++j) {
+      double tau, beta;
+      Ab.col(j).tail(ROWS - j).makeHouseholderInPlace(tau, beta);
+      Ab.bottomRightCorner(ROWS - j, COLS - j - 1).applyHouseholderOnTheLeft(
+          Ab.col(j).tail(ROWS - j - 1), tau, workspace.data());
+      Ab(j, j) = beta;
+    }
+  }
+
+  // Whiten the rows of a new factor with diagonal standard deviations
+  template<int M, class BLOCK>
+  static void whitenDiagonal(const Eigen::Matrix<double, M, 1>& sigmas, BLOCK rows) {
+    rows.array().colwise() /= sigmas.array();
+  }
+
+  // Whiten the rows of a new factor with covariance Q = L*L', by solving with L
+  template<int M, class BLOCK>
+  static void whitenFull(const Eigen::Matrix<double, M, M>& Q, BLOCK rows) {
+    Eigen::LLT<Eigen::Matrix<double, M, M> > llt(Q);
+    if (llt.info() != Eigen::Success)
+      throw std::invalid_argument("FixedKalmanFilter: covariance is not positive definite");
+    llt.matrixL().solveInPlace(rows);
+  }
+
+  // Fuse p with the whitened motion factor |A0*x_k + A1*x_{k+1} - b|^2, stored in the bottom M
+  // rows of Ab, and keep the marginal on x_{k+1}
+  template<int M>
+  static void fuseMotion(State& p, Eigen::Matrix<double, N + M, 2 * N + 1>& Ab) {
+    BOOST_STATIC_ASSERT(M >= N);
+    Ab.template topLeftCorner<N, N>() = p.R.template triangularView<Eigen::Upper>();
+    Ab.template block<N, N>(0, N).setZero();
+    Ab.template block<N, 1>(0, 2 * N) = p.d;
+    triangularize(Ab, 2 * N);
+    p.R = Ab.template block<N, N>(N, N).template triangularView<Eigen::Upper>();
+    p.d = Ab.template block<N, 1>(N, 2 * N);
+    ++p.k;
+  }
+
+  // Fuse p with the whitened measurement factor |H*x_k - z|^2, stored in the bottom M rows of Ab
+  template<int M>
+  static void fuseMeasurement(State& p, Eigen::Matrix<double, N + M, N + 1>& Ab) {
+    Ab.template topLeftCorner<N, N>() = p.R.template triangularView<Eigen::Upper>();
+    Ab.template block<N, 1>(0, N) = p.d;
+    triangularize(Ab, N);
+    p.R = Ab.template topLeftCorner<N, N>().template triangularView<Eigen::Upper>();
+    p.d = Ab.template block<N, 1>(0, N);
+  }
+
+public:
+
+  /**
+   * Create initial state, i.e., prior density at time k=0
+   * In Kalman Filter notation, these are x_{0|0} and P_{0|0}
+   * @param x0 estimate at time 0
+   * @param sigmas standard deviations at time 0
+   */
+  State init(const VectorN& x0, const VectorN& sigmas) const {
+    State p;
+    p.k = 0;
+    p.R = sigmas.cwiseInverse().asDiagonal();
+    p.d = x0.cwiseQuotient(sigmas);
+    return p;
+  }
+
+  /// version of init with a full covariance matrix
+  State init(const VectorN& x0, const MatrixN& P0) const {
+    // R'*R = inv(P0)
+    Eigen::LLT<MatrixN> llt(P0.inverse());
+    if (llt.info() != Eigen::Success)
+      throw std::invalid_argument("FixedKalmanFilter: covariance is not positive definite");
+    State p;
+    p.k = 0;
+    p.R = llt.matrixU();
+    p.d = p.R * x0;
+    return p;
+  }
+
+  /** Return step index k, starts at 0, incremented at each predict. */
+  static Key step(const State& p) {
+    return p.k;
+  }
+
+  /**
+   * Predict the state P(x_{t+1}|Z^t) in place
+   *   In Kalman Filter notation, this is x_{t+1|t} and P_{t+1|t}
+   * Details and parameters:
+   *   In a linear Kalman Filter, the motion model is f(x_{t}) = F*x_{t} + B*u_{t} + w
+   *   where F is the state transition model/matrix, B is the control input model,
+   *   and w is zero-mean, Gaussian white noise with standard deviations sigmasQ.
+   */
+  template<int C>
+  void predict(State& p, const MatrixN& F, const Eigen::Matrix<double, N, C>& B,
+      const Eigen::Matrix<double, C, 1>& u, const VectorN& sigmasQ) const {
+    Eigen::Matrix<double, 2 * N, 2 * N + 1> Ab;
+    Ab.template block<N, N>(N, 0) = -F;
+    Ab.template block<N, N>(N, N).setIdentity();
+    Ab.template block<N, 1>(N, 2 * N) = B * u;
+    whitenDiagonal(sigmasQ, Ab.template bottomRows<N>());
+    fuseMotion<N>(p, Ab);
+  }
+
+  /// Version of predict with full covariance Q
+  template<int C>
+  void predictQ(State& p, const MatrixN& F, const Eigen::Matrix<double, N, C>& B,
+      const Eigen::Matrix<double, C, 1>& u, const MatrixN& Q) const {
+    Eigen::Matrix<double, 2 * N, 2 * N + 1> Ab;
+    Ab.template block<N, N>(N, 0) = -F;
+    Ab.template block<N, N>(N, N).setIdentity();
+    Ab.template block<N, 1>(N, 2 * N) = B * u;
+    whitenFull(Q, Ab.template bottomRows<N>());
+    fuseMotion<N>(p, Ab);
+  }
+
+  /**
+   * Predict the state P(x_{t+1}|Z^t) in place
+   *   This version of predict takes the motion model |A0*x_{t} + A1*x_{t+1} - b|^2,
+   *   with diagonal standard deviations sigmas and at least N rows.
+   */
+  template<int M>
+  void predict2(State& p, const Eigen::Matrix<double, M, N>& A0,
+      const Eigen::Matrix<double, M, N>& A1, const Eigen::Matrix<double, M, 1>& b,
+      const Eigen::Matrix<double, M, 1>& sigmas) const {
+    Eigen::Matrix<double, N + M, 2 * N + 1> Ab;
+    Ab.template block<M, N>(N, 0) = A0;
+    Ab.template block<M, N>(N, N) = A1;
+    Ab.template block<M, 1>(N, 2 * N) = b;
+    whitenDiagonal(sigmas, Ab.template bottomRows<M>());
+    fuseMotion<M>(p, Ab);
+  }
+
+  /**
+   * Update the state in place with a measurement
+   * For the Kalman Filter, the measurement function, h(x_{t}) = z_{t}
+   * will be of the form h(x_{t}) = H*x_{t} + v
+   * where H is the observation model/matrix, and v is zero-mean,
+   * Gaussian white noise with standard deviations sigmas.
+   */
+  template<int M>
+  void update(State& p, const Eigen::Matrix<double, M, N>& H,
+      const Eigen::Matrix<double, M, 1>& z, const Eigen::Matrix<double, M, 1>& sigmas) const {
+    Eigen::Matrix<double, N + M, N + 1> Ab;
+    Ab.template block<M, N>(N, 0) = H;
+    Ab.template block<M, 1>(N, N) = z;
+    whitenDiagonal(sigmas, Ab.template bottomRows<M>());
+    fuseMeasurement<M>(p, Ab);
+  }
+
+  /// Version of update with full measurement covariance Q
+  template<int M>
+  void updateQ(State& p, const Eigen::Matrix<double, M, N>& H,
+      const Eigen::Matrix<double, M, 1>& z, const Eigen::Matrix<double, M, M>& Q) const {
+    Eigen::Matrix<double, N + M, N + 1> Ab;
+    Ab.template block<M, N>(N, 0) = H;
+    Ab.template block<M, 1>(N, N) = z;
+    whitenFull(Q, Ab.template bottomRows<M>());
+    fuseMeasurement<M>(p, Ab);
+  }
+
+  /// Convert a state to a KalmanFilter::State, i.e., a GaussianDensity on key k
+  static KalmanFilter::State ToDensity(const State& p) {
+    return boost::make_shared<GaussianDensity>(p.k, Vector(p.d), Matrix(p.R));
+  }
+
+  /// Convert a KalmanFilter::State of dimension N to a state
+  static State FromDensity(const KalmanFilter::State& density) {
+    if (density->rows() != N || density->getDim(density->begin()) != N)
+      throw std::invalid_argument("FixedKalmanFilter::FromDensity: density has wrong dimension");
+    State p;
+    p.k = density->firstFrontalKey();
+    p.R = density->get_R();
+    p.d = density->get_d();
+    if (density->get_model()) {
+      // Absorb the noise model, so that the density is |R*x - d|^2
+      const VectorN invsigmas = density->get_model()->invsigmas();
+      p.R = invsigmas.asDiagonal() * p.R;
+      p.d = p.d.cwiseProduct(invsigmas);
+    }
+    return p;
+  }
+};
+
+} // \namespace gtsam
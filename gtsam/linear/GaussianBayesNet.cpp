@@ -111,6 +111,38 @@ namespace gtsam {
     return gy;
   }
 
+  /* ************************************************************************* */
+  DenseVectorValues::Layout GaussianBayesNet::denseLayout() const
+  {
+    DenseVectorValues::Layout layout;
+    DenseIndex offset = 0;
+    BOOST_FOREACH(const sharedConditional& cg, *this) {
+      for (GaussianConditional::const_iterator frontal = cg->beginFrontals();
+        frontal != cg->endFrontals(); ++frontal)
+      {
+        layout.insert(make_pair(*frontal, DenseVectorValues::Slot(offset, cg->getDim(frontal))));
+        offset += cg->getDim(frontal);
+      }
+    }
+    return layout;
+  }
+
+  /* ************************************************************************* */
+  void GaussianBayesNet::backSubstituteInPlace(
+    const DenseVectorValues::Layout& layout, Matrix& X) const
+  {
+    BOOST_REVERSE_FOREACH(const sharedConditional& cg, *this)
+      cg->solveOtherRHSInPlace(layout, X);
+  }
+
+  /* ************************************************************************* */
+  void GaussianBayesNet::backSubstituteTransposeInPlace(
+    const DenseVectorValues::Layout& layout, Matrix& X) const
+  {
+    BOOST_FOREACH(const sharedConditional& cg, *this)
+      cg->solveTransposeInPlace(layout, X);
+  }
+
   ///* ************************************************************************* */
   //VectorValues GaussianBayesNet::optimizeGradientSearch() const
   //{
@@ -160,6 +160,28 @@ namespace gtsam {
      */
     VectorValues backSubstituteTranspose(const VectorValues& gx) const;
 
+    /**
+     * Layout of the rows of the batched right-hand sides used by backSubstituteInPlace and
+     * backSubstituteTransposeInPlace, with the frontal variables of each conditional stored
+     * contiguously, in elimination order.
+     */
+    DenseVectorValues::Layout denseLayout() const;
+
+    /**
+     * Batched version of backSubstitute for many right-hand sides at once: each column of \c X is
+     * a right-hand side, with its rows laid out by \c layout (usually denseLayout()), and is
+     * overwritten by the corresponding solution.  Each conditional solves all columns with a single
+     * triangular solve with its stored R, which is much faster than calling backSubstitute per
+     * column when computing several samples or marginal covariance columns.
+     */
+    void backSubstituteInPlace(const DenseVectorValues::Layout& layout, Matrix& X) const;
+
+    /**
+     * Batched version of backSubstituteTranspose for many right-hand sides at once, with \c X laid
+     * out as in backSubstituteInPlace.
+     */
+    void backSubstituteTransposeInPlace(const DenseVectorValues::Layout& layout, Matrix& X) const;
+
     /// @}
 
   private:
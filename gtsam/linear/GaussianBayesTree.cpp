@@ -25,6 +25,10 @@
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/VectorValues.h>
 
+#include <boost/foreach.hpp>
+
+#include <vector>
+
 namespace gtsam {
 
   // Instantiate base class
@@ -101,6 +105,31 @@ namespace gtsam {
     return marginalFactor(key)->information().inverse();
   }
 
+  /* ************************************************************************* */
+  GaussianBayesNet GaussianBayesTree::toBayesNet() const
+  {
+    // Collect the cliques in pre-order, and reverse it so that children come before parents
+    std::vector<sharedClique> cliques, stack(this->roots_.begin(), this->roots_.end());
+    while (!stack.empty()) {
+      const sharedClique clique = stack.back();
+      stack.pop_back();
+      cliques.push_back(clique);
+      stack.insert(stack.end(), clique->children.begin(), clique->children.end());
+    }
+
+    GaussianBayesNet result;
+    result.reserve(cliques.size());
+    BOOST_REVERSE_FOREACH(const sharedClique& clique, cliques)
+      result.push_back(clique->conditional());
+    return result;
+  }
+
+  /* ************************************************************************* */
+  MemoryUsage GaussianBayesTree::memoryUsage() const
+  {
+    return internal::linearAlgorithms::bayesTreeMemoryUsage(*this);
+  }
+
 
 } // \namespace gtsam
 
@@ -126,6 +126,17 @@ namespace gtsam {
     /** Return the marginal on the requested variable as a covariance matrix.  See also
     *   marginalFactor(). */
     Matrix marginalCovariance(Key key) const;
+
+    /** Collect the clique conditionals into a GaussianBayesNet, ordered so that the conditional of
+     *  each clique comes before those of its ancestors.  The conditionals are shared, not copied,
+     *  and the Bayes net represents the same density, so it can be used to back-substitute with
+     *  GaussianBayesNet::backSubstitute() and GaussianBayesNet::backSubstituteTranspose(). */
+    GaussianBayesNet toBayesNet() const;
+
+    /** Return the memory used by the Bayes tree, broken down into "conditionals", the R, S and d
+     *  matrices of the cliques, "cliques", and "nodes", the map from keys to cliques.  See
+     *  MemoryUsage. */
+    MemoryUsage memoryUsage() const;
   };
 
   /// traits
@@ -197,6 +197,115 @@ namespace gtsam {
     }
   }
 
+  /* ************************************************************************* */
+  namespace {
+    // If the frontal variables are stored contiguously and in order in the rows of a batched
+    // right-hand side, return the first row, otherwise return -1
+    DenseIndex contiguousFrontalRow(const GaussianConditional& conditional,
+      const DenseVectorValues::Layout& layout)
+    {
+      const DenseIndex start = layout.at(conditional.firstFrontalKey()).offset;
+      DenseIndex row = start;
+      for (GaussianConditional::const_iterator frontal = conditional.beginFrontals();
+        frontal != conditional.endFrontals(); ++frontal)
+      {
+        const DenseVectorValues::Slot& slot = layout.at(*frontal);
+        if (slot.offset != row)
+          return -1;
+        row += slot.dim;
+      }
+      return start;
+    }
+
+    // Copy the frontal rows out of, or back into, a batched right-hand side
+    void gatherFrontalRows(const GaussianConditional& conditional,
+      const DenseVectorValues::Layout& layout, const Matrix& X, Matrix& F)
+    {
+      DenseIndex row = 0;
+      for (GaussianConditional::const_iterator frontal = conditional.beginFrontals();
+        frontal != conditional.endFrontals(); ++frontal)
+      {
+        const DenseVectorValues::Slot& slot = layout.at(*frontal);
+        F.middleRows(row, slot.dim) = X.middleRows(slot.offset, slot.dim);
+        row += slot.dim;
+      }
+    }
+
+    void scatterFrontalRows(const GaussianConditional& conditional,
+      const DenseVectorValues::Layout& layout, const Matrix& F, Matrix& X)
+    {
+      DenseIndex row = 0;
+      for (GaussianConditional::const_iterator frontal = conditional.beginFrontals();
+        frontal != conditional.endFrontals(); ++frontal)
+      {
+        const DenseVectorValues::Slot& slot = layout.at(*frontal);
+        X.middleRows(slot.offset, slot.dim) = F.middleRows(row, slot.dim);
+        row += slot.dim;
+      }
+    }
+
+    // Solve with R in place and scale the rows by the sigmas
+    template<class BLOCK>
+    void solveFrontalRows(const GaussianConditional& conditional, BLOCK F)
+    {
+      conditional.get_R().triangularView<Eigen::Upper>().solveInPlace(F);
+      if (conditional.get_model())
+        F = conditional.get_model()->sigmas().asDiagonal() * F;
+    }
+  }
+
+  /* ************************************************************************* */
+  void GaussianConditional::solveOtherRHSInPlace(
+    const DenseVectorValues::Layout& layout, Matrix& X) const
+  {
+    const DenseIndex frontalDim = get_R().rows();
+    const DenseIndex start = contiguousFrontalRow(*this, layout);
+    Matrix F;
+    if (start < 0) {
+      F.resize(frontalDim, X.cols());
+      gatherFrontalRows(*this, layout, X, F);
+    }
+
+    // Subtract the parents, using the frontal rows of X directly when they are contiguous
+    for (const_iterator parent = beginParents(); parent != endParents(); ++parent) {
+      const DenseVectorValues::Slot& slot = layout.at(*parent);
+      if (start < 0)
+        F.noalias() -= getA(parent) * X.middleRows(slot.offset, slot.dim);
+      else
+        X.middleRows(start, frontalDim).noalias() -= getA(parent) * X.middleRows(slot.offset, slot.dim);
+    }
+
+    if (start < 0) {
+      solveFrontalRows(*this, F.middleRows(0, frontalDim));
+      scatterFrontalRows(*this, layout, F, X);
+    } else {
+      solveFrontalRows(*this, X.middleRows(start, frontalDim));
+    }
+  }
+
+  /* ************************************************************************* */
+  void GaussianConditional::solveTransposeInPlace(
+    const DenseVectorValues::Layout& layout, Matrix& X) const
+  {
+    const DenseIndex frontalDim = get_R().rows();
+    Matrix F(frontalDim, X.cols());
+    gatherFrontalRows(*this, layout, X, F);
+    get_R().transpose().triangularView<Eigen::Lower>().solveInPlace(F);
+
+    // Check for indeterminant solution
+    if (F.hasNaN()) throw IndeterminantLinearSystemException(this->keys().front());
+
+    for (const_iterator parent = beginParents(); parent != endParents(); ++parent) {
+      const DenseVectorValues::Slot& slot = layout.at(*parent);
+      X.middleRows(slot.offset, slot.dim).noalias() -= getA(parent).transpose() * F;
+    }
+
+    // Scale by sigmas
+    if (model_)
+      F = model_->sigmas().asDiagonal() * F;
+    scatterFrontalRows(*this, layout, F, X);
+  }
+
   /* ************************************************************************* */
   void GaussianConditional::scaleFrontalsBySigma(VectorValues& gy) const
   {
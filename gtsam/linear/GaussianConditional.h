@@ -25,6 +25,7 @@
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/inference/Conditional.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/linear/DenseVectorValues.h>
 
 namespace gtsam {
 
@@ -125,6 +126,23 @@ namespace gtsam {
     /** Performs transpose backsubstition in place on values */
     void solveTransposeInPlace(VectorValues& gy) const;
 
+    /**
+     * Batched version of solveOtherRHS for many right-hand sides at once.  Row block
+     * <tt>layout.at(j)</tt> of \c X holds variable \c j, and each column of \c X is a separate
+     * right-hand side.  On input the frontal rows hold the right-hand sides and the parent rows
+     * hold the already solved parents; on output the frontal rows hold the solutions.  The
+     * triangular solve with the stored R runs once for all columns (a BLAS-3 TRSM) rather than once
+     * per column.
+     */
+    void solveOtherRHSInPlace(const DenseVectorValues::Layout& layout, Matrix& X) const;
+
+    /**
+     * Batched version of solveTransposeInPlace(VectorValues&) for many right-hand sides at once,
+     * with \c X laid out as in solveOtherRHSInPlace.  Throws IndeterminantLinearSystemException if
+     * the solution contains NaNs.
+     */
+    void solveTransposeInPlace(const DenseVectorValues::Layout& layout, Matrix& X) const;
+
     /** Scale the values in \c gy according to the sigmas for the frontal variables in this
      *  conditional. */
     void scaleFrontalsBySigma(VectorValues& gy) const;
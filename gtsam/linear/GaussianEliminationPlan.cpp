@@ -0,0 +1,263 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    GaussianEliminationPlan.cpp
+ * @brief   Symbolic analysis of a Gaussian factor graph, reusable for repeated numeric solves
+ * @date    Oct 14, 2026
+ */
+
+#include <gtsam/linear/GaussianEliminationPlan.h>
+#include <gtsam/linear/GaussianEliminationTree.h>
+#include <gtsam/linear/GaussianJunctionTree.h>
+#include <gtsam/linear/GaussianConditional.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/inference/ClusterTree-inst.h>
+#include <gtsam/inference/VariableIndex.h>
+#include <gtsam/inference/inferenceExceptions.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+typedef ClusterTree<GaussianBayesTree, GaussianFactorGraph> GaussianClusterTree;
+
+/* ************************************************************************* */
+// A cluster tree built from a plan, pointing to the factors of a new graph
+class PlannedClusterTree : public GaussianClusterTree {
+public:
+  PlannedClusterTree(const FastVector<GaussianEliminationPlan::sharedNode>& planRoots,
+      const FastVector<size_t>& remainingFactors, const GaussianFactorGraph& graph) {
+    // Copy the tree iteratively, since chains of cliques can be very deep
+    typedef pair<GaussianEliminationPlan::sharedNode, sharedNode> Pair;
+    FastVector<Pair> stack;
+    roots_.reserve(planRoots.size());
+    BOOST_FOREACH(const GaussianEliminationPlan::sharedNode& planRoot, planRoots) {
+      roots_.push_back(boost::make_shared<Cluster>());
+      stack.push_back(Pair(planRoot, roots_.back()));
+    }
+    while (!stack.empty()) {
+      const Pair current = stack.back();
+      stack.pop_back();
+      const GaussianEliminationPlan::Node& planNode = *current.first;
+      Cluster& cluster = *current.second;
+      cluster.orderedFrontalKeys = planNode.orderedFrontalKeys;
+      cluster.problemSize_ = planNode.problemSize;
+      cluster.factors.reserve(planNode.factors.size());
+      BOOST_FOREACH(size_t i, planNode.factors)
+        cluster.factors.push_back(graph[i]);
+      cluster.children.reserve(planNode.children.size());
+      BOOST_FOREACH(const GaussianEliminationPlan::sharedNode& planChild, planNode.children) {
+        cluster.children.push_back(boost::make_shared<Cluster>());
+        stack.push_back(Pair(planChild, cluster.children.back()));
+      }
+    }
+    remainingFactors_.reserve(remainingFactors.size());
+    BOOST_FOREACH(size_t i, remainingFactors)
+      remainingFactors_.push_back(graph[i]);
+  }
+};
+
+/* ************************************************************************* */
+// Dense elimination function using the Scatter stored for each clique, keyed on its first
+// frontal key, instead of recomputing it from the gathered factors.
+class EliminateWithScatter {
+  const FastMap<Key, const Scatter*>& scatters_;
+public:
+  EliminateWithScatter(const FastMap<Key, const Scatter*>& scatters) :
+      scatters_(scatters) {
+  }
+
+  pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<GaussianFactor> > operator()(
+      const GaussianFactorGraph& factors, const Ordering& keys) const {
+    // Cholesky cannot handle constrained noise models, see EliminatePreferCholesky
+    if (hasConstraints(factors))
+      return EliminateQR(factors, keys);
+    HessianFactor::shared_ptr jointFactor = boost::make_shared<HessianFactor>(factors,
+        *scatters_.at(keys.front()));
+    GaussianConditional::shared_ptr conditional = jointFactor->eliminateCholesky(keys);
+    return make_pair(conditional, jointFactor);
+  }
+};
+
+}
+
+/* ************************************************************************* */
+GaussianEliminationPlan::GaussianEliminationPlan(const GaussianFactorGraph& graph,
+    const Ordering& ordering, const RelaxedAmalgamation& amalgamation) :
+    ordering_(ordering), nrCliques_(0) {
+  analyze(graph, amalgamation);
+}
+
+/* ************************************************************************* */
+GaussianEliminationPlan::GaussianEliminationPlan(const GaussianFactorGraph& graph,
+    Ordering::OrderingType orderingType, const RelaxedAmalgamation& amalgamation) :
+    ordering_(Ordering::Create(orderingType, graph)), nrCliques_(0) {
+  analyze(graph, amalgamation);
+}
+
+/* ************************************************************************* */
+void GaussianEliminationPlan::analyze(const GaussianFactorGraph& graph,
+    const RelaxedAmalgamation& amalgamation) {
+  gttic(GaussianEliminationPlan_analyze);
+
+  // Record the structure of the graph
+  factorKeys_.resize(graph.size());
+  hasFactor_.resize(graph.size());
+  FastMap<const GaussianFactor*, FastVector<size_t> > factorIndices;
+  for (size_t i = 0; i < graph.size(); ++i) {
+    hasFactor_[i] = bool(graph[i]);
+    if (!graph[i])
+      continue;
+    factorKeys_[i].assign(graph[i]->begin(), graph[i]->end());
+    for (GaussianFactor::const_iterator key = graph[i]->begin(); key != graph[i]->end(); ++key)
+      dims_[*key] = graph[i]->getDim(key);
+    factorIndices[graph[i].get()].push_back(i);
+  }
+
+  // Build the junction tree as in EliminateableFactorGraph::eliminateMultifrontal
+  const VariableIndex variableIndex(graph);
+  const GaussianEliminationTree etree(graph, variableIndex, ordering_);
+  const GaussianJunctionTree junctionTree(etree, amalgamation);
+
+  // Replace factor pointers by indices.  The same factor may be in the graph more than once, in
+  // which case its occurrences are assigned its indices in reverse order.
+  typedef GaussianJunctionTree::sharedNode sharedCluster;
+  FastVector<sharedNode> preOrder;
+  FastVector<size_t> parents;
+  FastVector<pair<sharedCluster, size_t> > stack;
+  BOOST_FOREACH(const sharedCluster& root, junctionTree.roots())
+    stack.push_back(make_pair(root, size_t(-1)));
+  while (!stack.empty()) {
+    const pair<sharedCluster, size_t> current = stack.back();
+    stack.pop_back();
+    const GaussianJunctionTree::Node& cluster = *current.first;
+    sharedNode node = boost::make_shared<Node>();
+    node->orderedFrontalKeys = cluster.orderedFrontalKeys;
+    node->problemSize = cluster.problemSize();
+    node->factors.reserve(cluster.factors.size());
+    BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, cluster.factors) {
+      FastVector<size_t>& indices = factorIndices.at(factor.get());
+      node->factors.push_back(indices.back());
+      indices.pop_back();
+    }
+    if (current.second == size_t(-1))
+      roots_.push_back(node);
+    else
+      preOrder[current.second]->children.push_back(node);
+    // Push children in reverse, so that they are visited and added to node in order
+    for (size_t c = cluster.children.size(); c-- > 0;)
+      stack.push_back(make_pair(cluster.children[c], preOrder.size()));
+    preOrder.push_back(node);
+    parents.push_back(current.second);
+  }
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, junctionTree.remainingFactors()) {
+    FastVector<size_t>& indices = factorIndices.at(factor.get());
+    remainingFactors_.push_back(indices.back());
+    indices.pop_back();
+  }
+  nrCliques_ = preOrder.size();
+
+  // Compute the separator of each clique, children before parents, and from it the Scatter of
+  // the joint factor formed when eliminating the clique.
+  FastVector<KeySet> separators(preOrder.size());
+  for (size_t k = preOrder.size(); k-- > 0;) {
+    Node& node = *preOrder[k];
+    KeySet& separator = separators[k];
+    BOOST_FOREACH(size_t i, node.factors)
+      separator.insert(factorKeys_[i].begin(), factorKeys_[i].end());
+    BOOST_FOREACH(Key key, node.orderedFrontalKeys)
+      separator.erase(key);
+
+    node.scatter.reserve(node.orderedFrontalKeys.size() + separator.size());
+    BOOST_FOREACH(Key key, node.orderedFrontalKeys)
+      node.scatter.add(key, dims_.at(key));
+    BOOST_FOREACH(Key key, separator)
+      node.scatter.add(key, dims_.at(key));
+    scatters_[node.orderedFrontalKeys.front()] = &node.scatter;
+
+    // The part of the separator not eliminated in the parent is passed up to it
+    if (parents[k] != size_t(-1))
+      separators[parents[k]].insert(separator.begin(), separator.end());
+  }
+}
+
+/* ************************************************************************* */
+bool GaussianEliminationPlan::compatible(const GaussianFactorGraph& graph) const {
+  if (graph.size() != factorKeys_.size())
+    return false;
+  for (size_t i = 0; i < graph.size(); ++i) {
+    if (bool(graph[i]) != hasFactor_[i])
+      return false;
+    if (!graph[i])
+      continue;
+    const GaussianFactor& factor = *graph[i];
+    if (factor.size() != factorKeys_[i].size()
+        || !std::equal(factor.begin(), factor.end(), factorKeys_[i].begin()))
+      return false;
+    for (GaussianFactor::const_iterator key = factor.begin(); key != factor.end(); ++key)
+      if (factor.getDim(key) != dims_.at(*key))
+        return false;
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<GaussianBayesTree> GaussianEliminationPlan::eliminate(
+    const GaussianFactorGraph& graph, const Eliminate& function, bool useScatters) const {
+  gttic(GaussianEliminationPlan_eliminate);
+  if (!compatible(graph))
+    throw std::invalid_argument(
+        "GaussianEliminationPlan: the factor graph does not have the structure the plan was "
+        "created for");
+
+  const PlannedClusterTree clusterTree(roots_, remainingFactors_, graph);
+  boost::shared_ptr<GaussianBayesTree> bayesTree;
+  boost::shared_ptr<GaussianFactorGraph> factorGraph;
+  if (useScatters)
+    boost::tie(bayesTree, factorGraph) = clusterTree.eliminate(EliminateWithScatter(scatters_));
+  else
+    boost::tie(bayesTree, factorGraph) = clusterTree.eliminate(function);
+  // If any factors are remaining, the ordering was incomplete
+  if (!factorGraph->empty())
+    throw InconsistentEliminationRequested();
+  return bayesTree;
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<GaussianBayesTree> GaussianEliminationPlan::eliminateMultifrontal(
+    const GaussianFactorGraph& graph) const {
+  return eliminate(graph, Eliminate(), true);
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<GaussianBayesTree> GaussianEliminationPlan::eliminateMultifrontal(
+    const GaussianFactorGraph& graph, const Eliminate& function) const {
+  return eliminate(graph, function, false);
+}
+
+/* ************************************************************************* */
+VectorValues GaussianEliminationPlan::optimize(const GaussianFactorGraph& graph) const {
+  gttic(GaussianEliminationPlan_optimize);
+  return eliminateMultifrontal(graph)->optimize();
+}
+
+}
@@ -0,0 +1,133 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    GaussianEliminationPlan.h
+ * @brief   Symbolic analysis of a Gaussian factor graph, reusable for repeated numeric solves
+ * @date    Oct 14, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/linear/Scatter.h>
+#include <gtsam/inference/JunctionTree.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/FastVector.h>
+
+namespace gtsam {
+
+/**
+ * A GaussianEliminationPlan stores the result of the symbolic phase of multifrontal
+ * elimination of a GaussianFactorGraph: the elimination ordering, the junction tree structure,
+ * and for each clique the Scatter (slot layout) of the joint factor that is eliminated there.
+ *
+ * This is the analyze/factorize split of sparse direct solvers like CHOLMOD: when the same
+ * graph structure is solved many times with different numerical values, e.g. re-solving with
+ * new measurements, the plan is created once and eliminateMultifrontal() then only does the
+ * numeric work.  The graphs passed in must have the same structure as the one the plan was
+ * created from: the same number of factors, and each factor on the same keys with the same
+ * dimensions.  Null factors must stay null.
+ *
+ * \addtogroup Multifrontal
+ * \nosubgrouping
+ */
+class GTSAM_EXPORT GaussianEliminationPlan {
+public:
+
+  typedef GaussianFactorGraph::Eliminate Eliminate; ///< Typedef for an eliminate subroutine
+
+  /** One clique of the plan, with factors stored as indices into the factor graph */
+  struct Node {
+    Ordering orderedFrontalKeys; ///< Frontal keys, in elimination order
+    FastVector<size_t> factors; ///< Indices of the factors associated with this clique
+    FastVector<boost::shared_ptr<Node> > children; ///< Sub-trees
+    Scatter scatter; ///< Slots of the joint factor: frontal keys followed by sorted separator
+    int problemSize; ///< Problem size, as in the junction tree
+  };
+
+  typedef boost::shared_ptr<Node> sharedNode;
+
+  /// @name Standard Constructors
+  /// @{
+
+  /** Analyze the structure of \c graph, eliminating in the given ordering, and merging cliques
+   *  as specified by \c amalgamation */
+  GaussianEliminationPlan(const GaussianFactorGraph& graph, const Ordering& ordering,
+      const RelaxedAmalgamation& amalgamation = RelaxedAmalgamation());
+
+  /** Analyze the structure of \c graph, computing an ordering of the given type, and merging
+   *  cliques as specified by \c amalgamation */
+  explicit GaussianEliminationPlan(const GaussianFactorGraph& graph,
+      Ordering::OrderingType orderingType = Ordering::COLAMD,
+      const RelaxedAmalgamation& amalgamation = RelaxedAmalgamation());
+
+  /// @}
+
+  /// @name Standard Interface
+  /// @{
+
+  /** The elimination ordering */
+  const Ordering& ordering() const { return ordering_; }
+
+  /** The roots of the planned clique tree */
+  const FastVector<sharedNode>& roots() const { return roots_; }
+
+  /** Number of cliques in the plan */
+  size_t nrCliques() const { return nrCliques_; }
+
+  /** Check whether \c graph has the structure this plan was created for */
+  bool compatible(const GaussianFactorGraph& graph) const;
+
+  /**
+   * Eliminate \c graph, which must have the structure of the analyzed graph, into a Bayes tree.
+   * This uses the stored slot layouts with Cholesky elimination, falling back on QR in cliques
+   * with constrained noise models, as EliminatePreferCholesky does.
+   * @throw std::invalid_argument if the structure of \c graph does not match the plan
+   */
+  boost::shared_ptr<GaussianBayesTree> eliminateMultifrontal(const GaussianFactorGraph& graph) const;
+
+  /**
+   * Eliminate \c graph with a custom dense elimination function, reusing only the ordering and
+   * clique structure of the plan.
+   * @throw std::invalid_argument if the structure of \c graph does not match the plan
+   */
+  boost::shared_ptr<GaussianBayesTree> eliminateMultifrontal(const GaussianFactorGraph& graph,
+      const Eliminate& function) const;
+
+  /** Eliminate \c graph and solve for the optimal solution by back-substitution */
+  VectorValues optimize(const GaussianFactorGraph& graph) const;
+
+  /// @}
+
+private:
+
+  Ordering ordering_;
+  FastVector<sharedNode> roots_;
+  FastVector<size_t> remainingFactors_; ///< Factors not involving any eliminated variable
+  size_t nrCliques_;
+
+  FastVector<FastVector<Key> > factorKeys_; ///< Keys of each factor, empty for null factors
+  FastVector<bool> hasFactor_; ///< Whether each factor is not null
+  FastMap<Key, size_t> dims_; ///< Dimension of each variable
+  FastMap<Key, const Scatter*> scatters_; ///< Scatter of each clique, by first frontal key
+
+  /** Do the symbolic analysis */
+  void analyze(const GaussianFactorGraph& graph, const RelaxedAmalgamation& amalgamation);
+
+  /** Eliminate, using the stored Scatters with Cholesky if useScatters is true */
+  boost::shared_ptr<GaussianBayesTree> eliminate(const GaussianFactorGraph& graph,
+      const Eliminate& function, bool useScatters) const;
+};
+
+}
@@ -22,6 +22,7 @@
 
 #include <gtsam/inference/Factor.h>
 #include <gtsam/base/Matrix.h>
+#include <gtsam/base/MemoryUsage.h>
 #include <gtsam/base/Testable.h>
 
 namespace gtsam {
@@ -114,6 +115,10 @@ namespace gtsam {
     /** Test whether the factor is empty */
     virtual bool empty() const = 0;
 
+    /** Return the memory used by this factor in bytes, the default counts this base class and
+     *  the keys */
+    virtual size_t memoryUsage() const { return sizeof(GaussianFactor) + heapBytes(keys()); }
+
     /**
      * Construct the corresponding anti-factor to negate information
      * stored stored in this factor.
@@ -26,9 +26,21 @@
 #include <gtsam/linear/HessianFactor.h>
 #include <gtsam/inference/FactorGraph-inst.h>
 #include <gtsam/inference/EliminateableFactorGraph-inst.h>
+#include <gtsam/inference/FactorColoring.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/base/cholesky.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#  include <tbb/parallel_reduce.h>
+#endif
+
+#include <algorithm>
+#include <limits>
 
 using namespace std;
 using namespace gtsam;
@@ -54,10 +66,21 @@ namespace gtsam {
     return keys;
   }
 
+  /* ************************************************************************* */
+  size_t GaussianFactorGraph::memoryUsage() const {
+    size_t bytes = sizeof(GaussianFactorGraph) + heapBytes(factors_);
+    BOOST_FOREACH(const sharedFactor& factor, *this) {
+      if (factor)
+        bytes += factor->memoryUsage();
+    }
+    return bytes;
+  }
+
   /* ************************************************************************* */
   std::map<Key, size_t> GaussianFactorGraph::getKeyDimMap() const {
     map<Key, size_t> spec;
     BOOST_FOREACH ( const GaussianFactor::shared_ptr &gf, *this ) {
+      if ( !gf ) continue;
       for ( GaussianFactor::const_iterator it = gf->begin() ; it != gf->end() ; it++ ) {
         map<Key,size_t>::iterator it2 = spec.find(*it);
         if ( it2 == spec.end() ) {
@@ -208,6 +231,268 @@ namespace gtsam {
     return IJS;
   }
 
+  /* ************************************************************************* */
+  namespace {
+    // JacobianFactor versions of the non-null factors of a graph, and their layout in the
+    // sparse Jacobian, shared by the sparse exports below
+    struct SparseJacobianLayout {
+      vector<JacobianFactor::shared_ptr> factors; // JacobianFactor of each non-null factor
+      vector<size_t> rowOffsets; // first row of each factor, followed by the number of rows
+      vector<size_t> widths; // number of columns of each factor
+      FastMap<Key, size_t> columns; // block column of each variable
+      vector<size_t> colOffsets; // first column of each block column, followed by the number of columns
+
+      SparseJacobianLayout(const GaussianFactorGraph& graph,
+          boost::optional<const Ordering&> optionalOrdering) {
+        // Columns in the ordering, or in key order
+        typedef map<Key, size_t> Dims;
+        const Dims dims = graph.getKeyDimMap();
+        vector<Key> keys;
+        if (optionalOrdering) {
+          BOOST_FOREACH(Key key, *optionalOrdering)
+            if (dims.find(key) != dims.end())
+              keys.push_back(key);
+          if (keys.size() != dims.size())
+            throw invalid_argument(
+                "GaussianFactorGraph sparse Jacobian: the ordering does not contain all variables of the graph");
+        } else {
+          BOOST_FOREACH(const Dims::value_type& key_dim, dims)
+            keys.push_back(key_dim.first);
+        }
+        colOffsets.push_back(0);
+        BOOST_FOREACH(Key key, keys) {
+          columns.insert(make_pair(key, colOffsets.size() - 1));
+          colOffsets.push_back(colOffsets.back() + dims.at(key));
+        }
+
+        // Rows of each factor, converting HessianFactors
+        rowOffsets.push_back(0);
+        BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, graph) {
+          if (!factor)
+            continue;
+          JacobianFactor::shared_ptr jacobian = boost::dynamic_pointer_cast<JacobianFactor>(factor);
+          if (!jacobian) {
+            HessianFactor::shared_ptr hessian = boost::dynamic_pointer_cast<HessianFactor>(factor);
+            if (!hessian)
+              throw invalid_argument(
+                  "GaussianFactorGraph contains a factor that is neither a JacobianFactor nor a HessianFactor.");
+            jacobian = boost::make_shared<JacobianFactor>(*hessian);
+          }
+          factors.push_back(jacobian);
+          rowOffsets.push_back(rowOffsets.back() + jacobian->rows());
+          size_t width = 0;
+          for (JacobianFactor::const_iterator key = jacobian->begin(); key != jacobian->end(); ++key)
+            width += jacobian->getDim(key);
+          widths.push_back(width);
+        }
+      }
+
+      size_t rows() const { return rowOffsets.back(); }
+      size_t cols() const { return colOffsets.back(); }
+
+      // Positions of the keys of factor f, sorted by block column
+      vector<pair<size_t, size_t> > sortedKeys(size_t f) const {
+        vector<pair<size_t, size_t> > result;
+        const JacobianFactor& factor = *factors[f];
+        for (size_t k = 0; k < factor.size(); ++k)
+          result.push_back(make_pair(columns.at(factor.keys()[k]), k));
+        sort(result.begin(), result.end());
+        return result;
+      }
+    };
+
+    // The whitened version of a factor, which is the factor itself if it has no noise model
+    const JacobianFactor& whitenedFactor(const JacobianFactor& factor, JacobianFactor& storage) {
+      if (!factor.get_model())
+        return factor;
+      storage = factor.whiten();
+      return storage;
+    }
+
+    // Fill the rows of factor f of a CSR matrix
+    struct FillCSR {
+      const SparseJacobianLayout& layout_;
+      const vector<size_t>& nnzOffsets_;
+      GaussianFactorGraph::SparseMatrixCSR::Index *outer_, *inner_;
+      double *values_, *b_;
+      void operator()(size_t f) const {
+        JacobianFactor storage;
+        const JacobianFactor& factor = whitenedFactor(*layout_.factors[f], storage);
+        const vector<pair<size_t, size_t> > keys = layout_.sortedKeys(f);
+        const size_t rows = factor.rows(), first = layout_.rowOffsets[f];
+        for (size_t i = 0; i < rows; ++i) {
+          size_t k = nnzOffsets_[f] + i * layout_.widths[f];
+          outer_[first + i] = k;
+          for (size_t j = 0; j < keys.size(); ++j) {
+            JacobianFactor::constABlock A = factor.getA(factor.begin() + keys[j].second);
+            const size_t column = layout_.colOffsets[keys[j].first];
+            for (DenseIndex jj = 0; jj < A.cols(); ++jj, ++k) {
+              inner_[k] = column + jj;
+              values_[k] = A(i, jj);
+            }
+          }
+        }
+        Eigen::Map<Vector>(b_ + first, rows) = factor.getb();
+      }
+    };
+
+    // Fill the entries of factor f in the columns of a CSC matrix
+    struct FillCSC {
+      const SparseJacobianLayout& layout_;
+      const vector<size_t>& blockNnzStarts_; // first entry of each block column
+      const vector<size_t>& blockNnz_; // number of entries in each column of each block column
+      const vector<size_t>& keyStarts_; // first key of each factor in positions_
+      const vector<size_t>& positions_; // position of each factor/key pair within its columns
+      GaussianFactorGraph::SparseMatrixCSC::Index *inner_;
+      double *values_, *b_;
+      void operator()(size_t f) const {
+        JacobianFactor storage;
+        const JacobianFactor& factor = whitenedFactor(*layout_.factors[f], storage);
+        const size_t rows = factor.rows(), first = layout_.rowOffsets[f];
+        for (size_t k = 0; k < factor.size(); ++k) {
+          JacobianFactor::constABlock A = factor.getA(factor.begin() + k);
+          const size_t c = layout_.columns.at(factor.keys()[k]);
+          for (DenseIndex jj = 0; jj < A.cols(); ++jj) {
+            const size_t start = blockNnzStarts_[c] + jj * blockNnz_[c] + positions_[keyStarts_[f] + k];
+            for (size_t i = 0; i < rows; ++i) {
+              inner_[start + i] = first + i;
+              values_[start + i] = A(i, jj);
+            }
+          }
+        }
+        Eigen::Map<Vector>(b_ + first, rows) = factor.getb();
+      }
+    };
+
+    // Fill the blocks of factor f of a BlockSparseJacobian
+    struct FillBlocks {
+      const SparseJacobianLayout& layout_;
+      const vector<size_t>& valueOffsets_; // first value of each factor
+      BlockSparseJacobian& result_;
+      void operator()(size_t f) const {
+        JacobianFactor storage;
+        const JacobianFactor& factor = whitenedFactor(*layout_.factors[f], storage);
+        const vector<pair<size_t, size_t> > keys = layout_.sortedKeys(f);
+        size_t start = valueOffsets_[f];
+        for (size_t j = 0; j < keys.size(); ++j) {
+          JacobianFactor::constABlock A = factor.getA(factor.begin() + keys[j].second);
+          const size_t k = result_.rowStarts[f] + j;
+          result_.blockColumns[k] = keys[j].first;
+          result_.valueStarts[k] = start;
+          Eigen::Map<Matrix>(result_.values.data() + start, A.rows(), A.cols()) = A;
+          start += A.size();
+        }
+        result_.b.segment(layout_.rowOffsets[f], factor.rows()) = factor.getb();
+      }
+    };
+
+#ifdef GTSAM_USE_TBB
+    template<class FILL>
+    class FillFactors {
+      const FILL& fill_;
+    public:
+      FillFactors(const FILL& fill) : fill_(fill) {}
+      void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+        for (size_t f = blocked_range.begin(); f != blocked_range.end(); ++f)
+          fill_(f);
+      }
+    };
+#endif
+
+    // Call fill for every factor, in parallel when TBB is enabled, as factors write disjoint entries
+    template<class FILL>
+    void fillFactors(size_t nrFactors, const FILL& fill) {
+#ifdef GTSAM_USE_TBB
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, nrFactors, 16), FillFactors<FILL>(fill));
+#else
+      for (size_t f = 0; f < nrFactors; ++f)
+        fill(f);
+#endif
+    }
+  }
+
+  /* ************************************************************************* */
+  pair<GaussianFactorGraph::SparseMatrixCSR, Vector> GaussianFactorGraph::sparseJacobianCSR(
+      boost::optional<const Ordering&> optionalOrdering) const {
+    gttic(GaussianFactorGraph_sparseJacobianCSR);
+    const SparseJacobianLayout layout(*this, optionalOrdering);
+    vector<size_t> nnzOffsets(layout.factors.size() + 1, 0);
+    for (size_t f = 0; f < layout.factors.size(); ++f)
+      nnzOffsets[f + 1] = nnzOffsets[f] + layout.factors[f]->rows() * layout.widths[f];
+
+    pair<SparseMatrixCSR, Vector> result;
+    SparseMatrixCSR& A = result.first;
+    A.resize(layout.rows(), layout.cols());
+    A.resizeNonZeros(nnzOffsets.back());
+    A.outerIndexPtr()[layout.rows()] = nnzOffsets.back();
+    result.second.resize(layout.rows());
+    const FillCSR fill = { layout, nnzOffsets, A.outerIndexPtr(), A.innerIndexPtr(),
+        A.valuePtr(), result.second.data() };
+    fillFactors(layout.factors.size(), fill);
+    return result;
+  }
+
+  /* ************************************************************************* */
+  pair<GaussianFactorGraph::SparseMatrixCSC, Vector> GaussianFactorGraph::sparseJacobianCSC(
+      boost::optional<const Ordering&> optionalOrdering) const {
+    gttic(GaussianFactorGraph_sparseJacobianCSC);
+    const SparseJacobianLayout layout(*this, optionalOrdering);
+
+    // Factors are stacked in each column in their order in the graph
+    const size_t nrBlocks = layout.colOffsets.size() - 1;
+    vector<size_t> blockNnz(nrBlocks, 0), keyStarts, positions;
+    for (size_t f = 0; f < layout.factors.size(); ++f) {
+      const JacobianFactor& factor = *layout.factors[f];
+      keyStarts.push_back(positions.size());
+      BOOST_FOREACH(Key key, factor.keys()) {
+        size_t& nnz = blockNnz[layout.columns.at(key)];
+        positions.push_back(nnz);
+        nnz += factor.rows();
+      }
+    }
+    vector<size_t> blockNnzStarts(nrBlocks + 1, 0);
+    for (size_t c = 0; c < nrBlocks; ++c)
+      blockNnzStarts[c + 1] = blockNnzStarts[c]
+          + blockNnz[c] * (layout.colOffsets[c + 1] - layout.colOffsets[c]);
+
+    pair<SparseMatrixCSC, Vector> result;
+    SparseMatrixCSC& A = result.first;
+    A.resize(layout.rows(), layout.cols());
+    A.resizeNonZeros(blockNnzStarts.back());
+    for (size_t c = 0; c < nrBlocks; ++c)
+      for (size_t j = layout.colOffsets[c]; j < layout.colOffsets[c + 1]; ++j)
+        A.outerIndexPtr()[j] = blockNnzStarts[c] + (j - layout.colOffsets[c]) * blockNnz[c];
+    A.outerIndexPtr()[layout.cols()] = blockNnzStarts.back();
+    result.second.resize(layout.rows());
+    const FillCSC fill = { layout, blockNnzStarts, blockNnz, keyStarts, positions,
+        A.innerIndexPtr(), A.valuePtr(), result.second.data() };
+    fillFactors(layout.factors.size(), fill);
+    return result;
+  }
+
+  /* ************************************************************************* */
+  BlockSparseJacobian GaussianFactorGraph::blockSparseJacobian(
+      boost::optional<const Ordering&> optionalOrdering) const {
+    gttic(GaussianFactorGraph_blockSparseJacobian);
+    const SparseJacobianLayout layout(*this, optionalOrdering);
+    BlockSparseJacobian result;
+    result.rowOffsets = layout.rowOffsets;
+    result.colOffsets = layout.colOffsets;
+    vector<size_t> valueOffsets(1, 0);
+    result.rowStarts.push_back(0);
+    for (size_t f = 0; f < layout.factors.size(); ++f) {
+      result.rowStarts.push_back(result.rowStarts.back() + layout.factors[f]->size());
+      valueOffsets.push_back(valueOffsets.back() + layout.factors[f]->rows() * layout.widths[f]);
+    }
+    result.blockColumns.resize(result.rowStarts.back());
+    result.valueStarts.resize(result.rowStarts.back());
+    result.values.resize(valueOffsets.back());
+    result.b.resize(layout.rows());
+    const FillBlocks fill = { layout, valueOffsets, result };
+    fillFactors(layout.factors.size(), fill);
+    return result;
+  }
+
   /* ************************************************************************* */
   Matrix GaussianFactorGraph::augmentedJacobian(
       boost::optional<const Ordering&> optionalOrdering) const {
@@ -245,34 +530,87 @@ namespace gtsam {
   }
 
   /* ************************************************************************* */
-  VectorValues GaussianFactorGraph::hessianDiagonal() const {
-    VectorValues d;
-    BOOST_FOREACH(const sharedFactor& factor, *this) {
-      if(factor){
-        VectorValues di = factor->hessianDiagonal();
-        d.addInPlace_(di);
+  namespace {
+#ifdef GTSAM_USE_TBB
+    // Accumulates a range of factors into a private result, joined at the end
+    template<class ACCUMULATE>
+    class AccumulateFactors {
+      const GaussianFactorGraph& graph_;
+      const ACCUMULATE& accumulate_;
+    public:
+      typename ACCUMULATE::Result result;
+      AccumulateFactors(const GaussianFactorGraph& graph, const ACCUMULATE& accumulate) :
+          graph_(graph), accumulate_(accumulate) {}
+      AccumulateFactors(AccumulateFactors& other, tbb::split) :
+          graph_(other.graph_), accumulate_(other.accumulate_) {}
+      void operator()(const tbb::blocked_range<size_t>& blocked_range) {
+        for (size_t i = blocked_range.begin(); i != blocked_range.end(); ++i)
+          if (graph_[i])
+            accumulate_(graph_[i], result);
       }
+      void join(const AccumulateFactors& other) {
+        ACCUMULATE::Join(other.result, result);
+      }
+    };
+#endif
+
+    // Sum a per-factor result over the non-null factors, in parallel when TBB is enabled
+    template<class ACCUMULATE>
+    typename ACCUMULATE::Result accumulateFactors(const GaussianFactorGraph& graph,
+        const ACCUMULATE& accumulate) {
+#ifdef GTSAM_USE_TBB
+      // Factors share variables, so each thread accumulates into its own result
+      AccumulateFactors<ACCUMULATE> body(graph, accumulate);
+      tbb::parallel_reduce(tbb::blocked_range<size_t>(0, graph.size(), 64), body);
+      return body.result;
+#else
+      typename ACCUMULATE::Result result;
+      BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, graph)
+        if (factor)
+          accumulate(factor, result);
+      return result;
+#endif
     }
-    return d;
+
+    // Base of the accumulators that add up VectorValues
+    struct AccumulateVectorValues {
+      typedef VectorValues Result;
+      static void Join(const VectorValues& other, VectorValues& result) {
+        result.addInPlace_(other);
+      }
+    };
+
+    struct AccumulateHessianDiagonal : AccumulateVectorValues {
+      void operator()(const GaussianFactor::shared_ptr& factor, VectorValues& d) const {
+        d.addInPlace_(factor->hessianDiagonal());
+      }
+    };
+
+    struct AccumulateHessianBlockDiagonal {
+      typedef map<Key, Matrix> Result;
+      static void Join(const map<Key, Matrix>& other, map<Key, Matrix>& blocks) {
+        for (map<Key, Matrix>::const_iterator it = other.begin(); it != other.end(); ++it) {
+          pair<map<Key, Matrix>::iterator, bool> block = blocks.insert(*it);
+          if (!block.second)
+            block.first->second += it->second;
+        }
+      }
+      void operator()(const GaussianFactor::shared_ptr& factor, map<Key, Matrix>& blocks) const {
+        Join(factor->hessianBlockDiagonal(), blocks);
+      }
+    };
+  }
+
+  /* ************************************************************************* */
+  VectorValues GaussianFactorGraph::hessianDiagonal() const {
+    gttic(GaussianFactorGraph_hessianDiagonal);
+    return accumulateFactors(*this, AccumulateHessianDiagonal());
   }
 
   /* ************************************************************************* */
   map<Key,Matrix> GaussianFactorGraph::hessianBlockDiagonal() const {
-    map<Key,Matrix> blocks;
-    BOOST_FOREACH(const sharedFactor& factor, *this) {
-      if (!factor) continue;
-      map<Key,Matrix> BD = factor->hessianBlockDiagonal();
-      map<Key,Matrix>::const_iterator it = BD.begin();
-      for(;it!=BD.end();it++) {
-        Key j = it->first; // variable key for this block
-        const Matrix& Bj = it->second;
-        if (blocks.count(j))
-          blocks[j] += Bj;
-        else
-          blocks.insert(make_pair(j,Bj));
-      }
-    }
-    return blocks;
+    gttic(GaussianFactorGraph_hessianBlockDiagonal);
+    return accumulateFactors(*this, AccumulateHessianBlockDiagonal());
   }
 
   /* ************************************************************************* */
@@ -282,6 +620,33 @@ namespace gtsam {
     return BaseEliminateable::eliminateMultifrontal(ordering, function)->optimize();
   }
 
+  /* ************************************************************************* */
+  VectorValues GaussianFactorGraph::optimizeMixedPrecision(OptionalOrdering ordering,
+      size_t refinementSteps) const
+  {
+    gttic(GaussianFactorGraph_optimizeMixedPrecision);
+
+    // Factor in single precision and solve
+    const GaussianBayesNet bayesNet = BaseEliminateable::eliminateMultifrontal(ordering,
+        EliminateCholeskySinglePrecision)->toBayesNet();
+    VectorValues x = bayesNet.optimize();
+
+    // Refine in double precision, with the residual r = A'b - A'A x of the normal equations
+    const VectorValues Atb = gradientAtZero().scale(-1.0);
+    double previousResidual = std::numeric_limits<double>::infinity();
+    for (size_t step = 0; step < refinementSteps; ++step) {
+      VectorValues AtAx = VectorValues::Zero(x);
+      multiplyHessianAdd(1.0, x, AtAx);
+      const VectorValues r = Atb - AtAx;
+      const double residual = r.norm();
+      if (residual == 0.0 || residual >= previousResidual)
+        break;
+      previousResidual = residual;
+      x += bayesNet.backSubstitute(bayesNet.backSubstituteTranspose(r));
+    }
+    return x;
+  }
+
   /* ************************************************************************* */
   namespace {
     JacobianFactor::shared_ptr convertToJacobianFactorPtr(const GaussianFactor::shared_ptr &gf) {
@@ -293,28 +658,38 @@ namespace gtsam {
     }
   }
 
+  /* ************************************************************************* */
+  namespace {
+    struct AccumulateGradient : AccumulateVectorValues {
+      const VectorValues& x0;
+      AccumulateGradient(const VectorValues& _x0) : x0(_x0) {}
+      void operator()(const GaussianFactor::shared_ptr& factor, VectorValues& g) const {
+        JacobianFactor::shared_ptr Ai = convertToJacobianFactorPtr(factor);
+        Vector e = Ai->error_vector(x0);
+        Ai->transposeMultiplyAdd(1.0, e, g);
+      }
+    };
+
+    struct AccumulateGradientAtZero : AccumulateVectorValues {
+      void operator()(const GaussianFactor::shared_ptr& factor, VectorValues& g) const {
+        g.addInPlace_(factor->gradientAtZero());
+      }
+    };
+  }
+
   /* ************************************************************************* */
   VectorValues GaussianFactorGraph::gradient(const VectorValues& x0) const
   {
+    gttic(GaussianFactorGraph_gradient);
     VectorValues g = VectorValues::Zero(x0);
-    BOOST_FOREACH(const sharedFactor& Ai_G, *this) {
-      JacobianFactor::shared_ptr Ai = convertToJacobianFactorPtr(Ai_G);
-      Vector e = Ai->error_vector(x0);
-      Ai->transposeMultiplyAdd(1.0, e, g);
-    }
+    g.addInPlace_(accumulateFactors(*this, AccumulateGradient(x0)));
     return g;
   }
 
   /* ************************************************************************* */
   VectorValues GaussianFactorGraph::gradientAtZero() const {
-    // Zero-out the gradient
-    VectorValues g;
-    BOOST_FOREACH(const sharedFactor& factor, *this) {
-      if (!factor) continue;
-      VectorValues gi = factor->gradientAtZero();
-      g.addInPlace_(gi);
-    }
-    return g;
+    gttic(GaussianFactorGraph_gradientAtZero);
+    return accumulateFactors(*this, AccumulateGradientAtZero());
   }
 
   /* ************************************************************************* */
@@ -356,11 +731,44 @@ namespace gtsam {
     return e;
   }
 
+  /* ************************************************************************* */
+  namespace {
+#ifdef GTSAM_USE_TBB
+    // Accumulates the products of a range of factors into a private y, joined at the end
+    class MultiplyHessianAdd {
+      const GaussianFactorGraph& graph_;
+      const double alpha_;
+      const VectorValues& x_;
+    public:
+      VectorValues y;
+      MultiplyHessianAdd(const GaussianFactorGraph& graph, double alpha, const VectorValues& x) :
+          graph_(graph), alpha_(alpha), x_(x) {}
+      MultiplyHessianAdd(MultiplyHessianAdd& other, tbb::split) :
+          graph_(other.graph_), alpha_(other.alpha_), x_(other.x_) {}
+      void operator()(const tbb::blocked_range<size_t>& blocked_range) {
+        for (size_t i = blocked_range.begin(); i != blocked_range.end(); ++i)
+          if (graph_[i])
+            graph_[i]->multiplyHessianAdd(alpha_, x_, y);
+      }
+      void join(const MultiplyHessianAdd& other) {
+        y.addInPlace_(other.y);
+      }
+    };
+#endif
+  }
+
   /* ************************************************************************* */
   void GaussianFactorGraph::multiplyHessianAdd(double alpha,
       const VectorValues& x, VectorValues& y) const {
+#ifdef GTSAM_USE_TBB
+    // Factors share variables, so each thread accumulates into its own y
+    MultiplyHessianAdd body(*this, alpha, x);
+    tbb::parallel_reduce(tbb::blocked_range<size_t>(0, size(), 64), body);
+    y.addInPlace_(body.y);
+#else
     BOOST_FOREACH(const GaussianFactor::shared_ptr& f, *this)
      f->multiplyHessianAdd(alpha, x, y);
+#endif
   }
 
   /* ************************************************************************* */
@@ -378,6 +786,17 @@ namespace gtsam {
     }
   }
 
+  /* ************************************************************************* */
+  void GaussianFactorGraph::multiplyInPlace(const VectorValues& x, ErrorVector& e) const {
+    assert(e.size() == size());
+    double* ei = e.vector().data();
+    BOOST_FOREACH(const GaussianFactor::shared_ptr& Ai_G, *this) {
+      JacobianFactor::shared_ptr Ai = convertToJacobianFactorPtr(Ai_G);
+      Ai->multiplyInPlace(x, ei);
+      ei += Ai->rows();
+    }
+  }
+
   /* ************************************************************************* */
   bool hasConstraints(const GaussianFactorGraph& factors) {
     typedef JacobianFactor J;
@@ -402,6 +821,127 @@ namespace gtsam {
     }
   }
 
+  /* ************************************************************************* */
+  void GaussianFactorGraph::transposeMultiplyAdd(double alpha, const ErrorVector& e,
+                                                 VectorValues& x) const {
+    assert(e.size() == size());
+    for (size_t i = 0; i < size(); ++i) {
+      JacobianFactor::shared_ptr Ai = convertToJacobianFactorPtr(at(i));
+      Ai->transposeMultiplyAdd(alpha, e.vector().data() + e.offset(i), x, e.work() + e.offset(i));
+    }
+  }
+
+  /* ************************************************************************* */
+  namespace {
+#ifdef GTSAM_USE_TBB
+    // Applies an operation to a range of the factors of one color
+    template<class OPERATION>
+    class ColorRange {
+      const FactorColoring::Factors& factors_;
+      const OPERATION& operation_;
+    public:
+      ColorRange(const FactorColoring::Factors& factors, const OPERATION& operation) :
+          factors_(factors), operation_(operation) {}
+      void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+        for (size_t k = blocked_range.begin(); k != blocked_range.end(); ++k)
+          operation_(factors_[k]);
+      }
+    };
+#endif
+
+    // Apply an operation to every colored factor, color by color.  Factors of one color share
+    // no variable, so with TBB they run in parallel while updating the variables they touch.
+    template<class OPERATION>
+    void forEachColor(const FactorColoring& coloring, const OPERATION& operation) {
+      for (size_t c = 0; c < coloring.nrColors(); ++c) {
+#ifdef GTSAM_USE_TBB
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, coloring.color(c).size(), 16),
+            ColorRange<OPERATION>(coloring.color(c), operation));
+#else
+        BOOST_FOREACH(size_t i, coloring.color(c))
+          operation(i);
+#endif
+      }
+    }
+
+    // Check that y has all variables, as inserting into it from several threads is not safe
+    void checkAllVariables(const GaussianFactorGraph& graph, const VectorValues& y) {
+#ifndef NDEBUG
+      BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, graph)
+        if (factor)
+          BOOST_FOREACH(Key key, factor->keys())
+            assert(y.exists(key));
+#endif
+    }
+
+    struct MultiplyHessianAddFactor {
+      const GaussianFactorGraph& graph;
+      const double alpha;
+      const VectorValues& x;
+      VectorValues& y;
+      MultiplyHessianAddFactor(const GaussianFactorGraph& _graph, double _alpha,
+          const VectorValues& _x, VectorValues& _y) :
+          graph(_graph), alpha(_alpha), x(_x), y(_y) {}
+      void operator()(size_t i) const {
+        graph[i]->multiplyHessianAdd(alpha, x, y);
+      }
+    };
+
+    struct TransposeMultiplyAddFactor {
+      const GaussianFactorGraph& graph;
+      const double alpha;
+      const FastVector<const Vector*>& e;
+      VectorValues& x;
+      TransposeMultiplyAddFactor(const GaussianFactorGraph& _graph, double _alpha,
+          const FastVector<const Vector*>& _e, VectorValues& _x) :
+          graph(_graph), alpha(_alpha), e(_e), x(_x) {}
+      void operator()(size_t i) const {
+        convertToJacobianFactorPtr(graph[i])->transposeMultiplyAdd(alpha, *e[i], x);
+      }
+    };
+
+    struct TransposeMultiplyAddFactorContiguous {
+      const GaussianFactorGraph& graph;
+      const double alpha;
+      const ErrorVector& e;
+      VectorValues& x;
+      TransposeMultiplyAddFactorContiguous(const GaussianFactorGraph& _graph, double _alpha,
+          const ErrorVector& _e, VectorValues& _x) :
+          graph(_graph), alpha(_alpha), e(_e), x(_x) {}
+      void operator()(size_t i) const {
+        convertToJacobianFactorPtr(graph[i])->transposeMultiplyAdd(alpha,
+            e.vector().data() + e.offset(i), x, e.work() + e.offset(i));
+      }
+    };
+  }
+
+  /* ************************************************************************* */
+  void GaussianFactorGraph::multiplyHessianAdd(double alpha, const VectorValues& x,
+      VectorValues& y, const FactorColoring& coloring) const {
+    checkAllVariables(*this, y);
+    forEachColor(coloring, MultiplyHessianAddFactor(*this, alpha, x, y));
+  }
+
+  /* ************************************************************************* */
+  void GaussianFactorGraph::transposeMultiplyAdd(double alpha, const Errors& e,
+      VectorValues& x, const FactorColoring& coloring) const {
+    checkAllVariables(*this, x);
+    // Errors is a list, so index it first
+    FastVector<const Vector*> errors;
+    errors.reserve(size());
+    BOOST_FOREACH(const Vector& ei, e)
+      errors.push_back(&ei);
+    forEachColor(coloring, TransposeMultiplyAddFactor(*this, alpha, errors, x));
+  }
+
+  /* ************************************************************************* */
+  void GaussianFactorGraph::transposeMultiplyAdd(double alpha, const ErrorVector& e,
+      VectorValues& x, const FactorColoring& coloring) const {
+    assert(e.size() == size());
+    checkAllVariables(*this, x);
+    forEachColor(coloring, TransposeMultiplyAddFactorContiguous(*this, alpha, e, x));
+  }
+
   ///* ************************************************************************* */
   //void residual(const GaussianFactorGraph& fg, const VectorValues &x, VectorValues &r) {
   //  Key i = 0 ;
@@ -27,6 +27,7 @@
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/HessianFactor.h>
 #include <gtsam/linear/Errors.h> // Included here instead of fw-declared so we can use Errors::iterator
+#include <Eigen/SparseCore>
 
 namespace gtsam {
 
@@ -38,6 +39,7 @@ namespace gtsam {
   class GaussianEliminationTree;
   class GaussianBayesTree;
   class GaussianJunctionTree;
+  class FactorColoring;
 
   /* ************************************************************************* */
   template<> struct EliminationTraits<GaussianFactorGraph>
@@ -55,6 +57,31 @@ namespace gtsam {
         return EliminatePreferCholesky(factors, keys); }
   };
 
+  /* ************************************************************************* */
+  /**
+   * The whitened Jacobian of a GaussianFactorGraph in block compressed sparse row form, with one
+   * block row per factor and one block column per variable, see
+   * GaussianFactorGraph::blockSparseJacobian.  Block k, in block row r, is the column-major
+   * (rowOffsets[r+1]-rowOffsets[r]) x (colOffsets[c+1]-colOffsets[c]) matrix starting at
+   * values[valueStarts[k]], where c = blockColumns[k].
+   */
+  struct GTSAM_EXPORT BlockSparseJacobian {
+    std::vector<size_t> rowOffsets;   ///< First row of each block row, followed by the number of rows
+    std::vector<size_t> colOffsets;   ///< First column of each block column, followed by the number of columns
+    std::vector<size_t> rowStarts;    ///< First block of each block row, followed by the number of blocks
+    std::vector<size_t> blockColumns; ///< Block column of each block, increasing within a block row
+    std::vector<size_t> valueStarts;  ///< Start of each block in values
+    Vector values;                    ///< Entries of all blocks
+    Vector b;                         ///< Whitened right-hand side
+
+    /// Block k, which is in block row r
+    Eigen::Map<const Matrix> block(size_t r, size_t k) const {
+      return Eigen::Map<const Matrix>(values.data() + valueStarts[k],
+          rowOffsets[r + 1] - rowOffsets[r],
+          colOffsets[blockColumns[k] + 1] - colOffsets[blockColumns[k]]);
+    }
+  };
+
   /* ************************************************************************* */
   /**
    * A Linear Factor Graph is a factor graph where all factors are Gaussian, i.e.
@@ -72,6 +99,8 @@ namespace gtsam {
     typedef FactorGraph<GaussianFactor> Base; ///< Typedef to base factor graph type
     typedef EliminateableFactorGraph<This> BaseEliminateable; ///< Typedef to base elimination class
     typedef boost::shared_ptr<This> shared_ptr; ///< shared_ptr to this class
+    typedef Eigen::SparseMatrix<double, Eigen::ColMajor> SparseMatrixCSC; ///< Compressed sparse column matrix
+    typedef Eigen::SparseMatrix<double, Eigen::RowMajor> SparseMatrixCSR; ///< Compressed sparse row matrix
 
     /** Default constructor */
     GaussianFactorGraph() {}
@@ -143,6 +172,9 @@ namespace gtsam {
 
     std::vector<size_t> getkeydim() const;
 
+    /** Return the memory used by the graph and its factors in bytes, see MemoryUsage */
+    size_t memoryUsage() const;
+
     /** unnormalized error */
     double error(const VectorValues& x) const {
       double total_error = 0.;
@@ -196,6 +228,24 @@ namespace gtsam {
      */
     Matrix sparseJacobian_() const;
 
+    /**
+     * Return the whitened Jacobian \f$ A \f$ in compressed sparse row form and the right-hand
+     * side \f$ b \f$, with columns in the order of \c ordering, or in key order by default.  The
+     * factor blocks are written directly into the sparse storage, in parallel over factors when
+     * TBB is enabled, and all their entries are stored, including zeros.  HessianFactors are
+     * converted to JacobianFactors first.
+     */
+    std::pair<SparseMatrixCSR, Vector> sparseJacobianCSR(
+        boost::optional<const Ordering&> optionalOrdering = boost::none) const;
+
+    /** Compressed sparse column version of sparseJacobianCSR, also written directly. */
+    std::pair<SparseMatrixCSC, Vector> sparseJacobianCSC(
+        boost::optional<const Ordering&> optionalOrdering = boost::none) const;
+
+    /** Block version of sparseJacobianCSR, with one dense block per factor and variable. */
+    BlockSparseJacobian blockSparseJacobian(
+        boost::optional<const Ordering&> optionalOrdering = boost::none) const;
+
     /**
      * Return a dense \f$ [ \;A\;b\; ] \in \mathbb{R}^{m \times n+1} \f$
      * Jacobian matrix, augmented with b with the noise models baked
@@ -235,7 +285,9 @@ namespace gtsam {
      */
     std::pair<Matrix,Vector> hessian(boost::optional<const Ordering&> optionalOrdering = boost::none) const;
 
-    /** Return only the diagonal of the Hessian A'*A, as a VectorValues */
+    /** Return only the diagonal of the Hessian A'*A, as a VectorValues.  When TBB is enabled,
+     *  ranges of factors are summed in parallel into private results that are then added up,
+     *  and the same holds for hessianBlockDiagonal(), gradient() and gradientAtZero(). */
     virtual VectorValues hessianDiagonal() const;
 
     /** Return the block diagonal of the Hessian for this factor */
@@ -248,6 +300,17 @@ namespace gtsam {
     VectorValues optimize(OptionalOrdering ordering = boost::none,
       const Eliminate& function = EliminationTraitsType::DefaultEliminate) const;
 
+    /** Solve the factor graph with mixed-precision iterative refinement.  The cliques are factored
+     *  by multifrontal elimination with EliminateCholeskySinglePrecision, so that the dense
+     *  factorizations run in single precision, and the solution of the Bayes tree is refined by up
+     *  to \c refinementSteps steps of
+     *  \f$ x \leftarrow x + (R^T R)^{-1} (A^T b - A^T A x) \f$, where the residual is computed in
+     *  double precision with multiplyHessianAdd().  Refinement stops early when the residual no
+     *  longer decreases.  As with EliminateCholesky, the graph may not contain constrained noise
+     *  models. */
+    VectorValues optimizeMixedPrecision(OptionalOrdering ordering = boost::none,
+      size_t refinementSteps = 3) const;
+
     /**
      * Compute the gradient of the energy function,
      * \f$ \nabla_{x=x_0} \left\Vert \Sigma^{-1} A x - b \right\Vert^2 \f$,
@@ -316,6 +379,31 @@ namespace gtsam {
     /** In-place version e <- A*x that takes an iterator. */
     void multiplyInPlace(const VectorValues& x, const Errors::iterator& e) const;
 
+    /** In-place version e <- A*x into contiguous errors, which must have the structure of A*x */
+    void multiplyInPlace(const VectorValues& x, ErrorVector& e) const;
+
+    /** x += alpha*A'*e for contiguous errors */
+    void transposeMultiplyAdd(double alpha, const ErrorVector& e, VectorValues& x) const;
+
+    /**
+     * y += alpha*A'A*x, processing the factors color by color, see FactorColoring.  The factors
+     * of one color update disjoint variables of y, in parallel when TBB is enabled, without locks.
+     * To this end y must already contain every variable of the graph, e.g. be a
+     * VectorValues::Zero(x).  The result does not depend on the number of threads.
+     */
+    void multiplyHessianAdd(double alpha, const VectorValues& x, VectorValues& y,
+        const FactorColoring& coloring) const;
+
+    /** x += alpha*A'*e color by color, see multiplyHessianAdd with a coloring.  x must already
+     *  contain every variable of the graph. */
+    void transposeMultiplyAdd(double alpha, const Errors& e, VectorValues& x,
+        const FactorColoring& coloring) const;
+
+    /** x += alpha*A'*e for contiguous errors, color by color, see multiplyHessianAdd with a
+     *  coloring.  x must already contain every variable of the graph. */
+    void transposeMultiplyAdd(double alpha, const ErrorVector& e, VectorValues& x,
+        const FactorColoring& coloring) const;
+
     /// @}
 
   private:
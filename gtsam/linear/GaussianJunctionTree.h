@@ -16,6 +16,8 @@
  * @author Richard Roberts
  */
 
+#pragma once
+
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/inference/JunctionTree.h>
@@ -58,9 +60,12 @@ namespace gtsam {
     * @param structure The set of factors involving each variable.  If this is not
     * precomputed, you can call the Create(const FactorGraph<DERIVEDFACTOR>&)
     * named constructor instead.
+    * @param amalgamation Parameters for merging cliques, the default merges only when there is
+    * no fill
     * @return The elimination tree
     */
-    GaussianJunctionTree(const GaussianEliminationTree& eliminationTree);
+    GaussianJunctionTree(const GaussianEliminationTree& eliminationTree,
+      const RelaxedAmalgamation& amalgamation = RelaxedAmalgamation());
   };
 
 }
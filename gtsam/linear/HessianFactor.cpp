@@ -22,12 +22,20 @@
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/linearExceptions.h>
+#include <gtsam/inference/eliminationCost.h>
 #include <gtsam/base/cholesky.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/FastMap.h>
 #include <gtsam/base/Matrix.h>
+#include <gtsam/base/simdKernels.h>
 #include <gtsam/base/ThreadsafeException.h>
 #include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
 
 #include <boost/foreach.hpp>
 #include <boost/format.hpp>
@@ -224,6 +232,45 @@ HessianFactor::HessianFactor(const GaussianFactor& gf) :
   }
 }
 
+/* ************************************************************************* */
+namespace {
+// Minimum number of factors per task when merging factors in parallel
+const size_t kMergeGrainSize = 64;
+// Maximum number of partial information matrices when merging factors in parallel
+const size_t kMergeMaxChunks = 16;
+
+// Add the information of the factors [first, last) of a graph to info
+void _updateHessianOfChunk(const GaussianFactorGraph& factors, size_t first,
+    size_t last, const FastVector<Key>& keys, SymmetricBlockMatrix* info) {
+  for (size_t i = first; i < last; ++i)
+    if (factors[i])
+      factors[i]->updateHessian(keys, info);
+}
+
+#ifdef GTSAM_USE_TBB
+class _UpdateHessianOfChunks {
+  const GaussianFactorGraph& factors_;
+  const FastVector<Key>& keys_;
+  size_t grainSize_;
+  const std::vector<SymmetricBlockMatrix*>& partials_;
+public:
+  _UpdateHessianOfChunks(const GaussianFactorGraph& factors,
+      const FastVector<Key>& keys, size_t grainSize,
+      const std::vector<SymmetricBlockMatrix*>& partials) :
+      factors_(factors), keys_(keys), grainSize_(grainSize), partials_(partials) {
+  }
+  // Operator that accumulates each chunk of a given range into its own partial
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    for (size_t k = blocked_range.begin(); k != blocked_range.end(); ++k) {
+      const size_t first = k * grainSize_;
+      _updateHessianOfChunk(factors_, first,
+          std::min(first + grainSize_, factors_.size()), keys_, partials_[k]);
+    }
+  }
+};
+#endif
+}
+
 /* ************************************************************************* */
 HessianFactor::HessianFactor(const GaussianFactorGraph& factors,
     boost::optional<const Scatter&> scatter) {
@@ -253,9 +300,38 @@ HessianFactor::HessianFactor(const GaussianFactorGraph& factors,
 
   // Form A' * A
   gttic(update);
-  BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, factors)
-    if (factor)
-      factor->updateHessian(keys_, &info_);
+#ifdef GTSAM_USE_TBB
+  if (factors.size() >= 2 * kMergeGrainSize) {
+    // Split the factors in chunks, accumulate each chunk into its own partial information
+    // matrix in parallel, the first one being info_ itself
+    const size_t grainSize = std::max(kMergeGrainSize,
+        (factors.size() + kMergeMaxChunks - 1) / kMergeMaxChunks);
+    const size_t nrChunks = (factors.size() + grainSize - 1) / grainSize;
+    std::vector<SymmetricBlockMatrix> storage(nrChunks - 1,
+        SymmetricBlockMatrix::LikeActiveViewOf(info_));
+    std::vector<SymmetricBlockMatrix*> partials(1, &info_);
+    BOOST_FOREACH(SymmetricBlockMatrix& partial, storage) {
+      partial.full().triangularView().setZero();
+      partials.push_back(&partial);
+    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, nrChunks, 1),
+        _UpdateHessianOfChunks(factors, keys_, grainSize, partials));
+
+    // Combine the partials with a fixed pairwise reduction tree, so that the
+    // result does not depend on how the chunks were scheduled
+    for (size_t n = nrChunks; n > 1; n = (n + 1) / 2) {
+      for (size_t k = 0; k < n / 2; ++k) {
+        partials[2 * k]->full() += partials[2 * k + 1]->full();
+        partials[k] = partials[2 * k];
+      }
+      if (n % 2 == 1)
+        partials[n / 2] = partials[n - 1];
+    }
+    gttoc(update);
+    return;
+  }
+#endif
+  _updateHessianOfChunk(factors, 0, factors.size(), keys_, &info_);
   gttoc(update);
 }
 
@@ -381,18 +457,24 @@ void HessianFactor::multiplyHessianAdd(double alpha, const VectorValues& x,
 
   // Accessing the VectorValues one by one is expensive
   // So we will loop over columns to access x only once per column
-  // And fill the above temporary y values, to be added into yvalues after
+  // And fill the above temporary y values, to be added into yvalues after.
+  // The blocks are multiplied by the run-time dispatched kernels, on the upper triangle.
+  const Matrix& infoMatrix = info_.matrix().nestedExpression();
+  const size_t ld = infoMatrix.rows();
   for (DenseIndex j = 0; j < (DenseIndex) size(); ++j) {
     // xj is the input vector
-    Vector xj = x.at(keys_[j]);
+    const Vector& xj = x.at(keys_[j]);
+    const DenseIndex oj = info_.offset(j);
     DenseIndex i = 0;
     for (; i < j; ++i)
-      y[i] += info_(i, j).knownOffDiagonal() * xj;
+      simd::gemv(y[i].size(), xj.size(), 1.0, &infoMatrix(info_.offset(i), oj), ld,
+          xj.data(), y[i].data());
     // blocks on the diagonal are only half
-    y[i] += info_(j, j).selfadjointView() * xj;
+    simd::symv(xj.size(), 1.0, &infoMatrix(oj, oj), ld, xj.data(), y[i].data());
     // for below diagonal, we take transpose block from upper triangular part
     for (i = j + 1; i < (DenseIndex) size(); ++i)
-      y[i] += info_(i, j).knownOffDiagonal() * xj;
+      simd::gemvT(xj.size(), y[i].size(), 1.0, &infoMatrix(oj, info_.offset(i)), ld,
+          xj.data(), y[i].data());
   }
 
   // copy to yvalues
@@ -447,11 +529,31 @@ Vector HessianFactor::gradient(Key key, const VectorValues& x) const {
 }
 
 /* ************************************************************************* */
-std::pair<boost::shared_ptr<GaussianConditional>,
-    boost::shared_ptr<HessianFactor> > EliminateCholesky(
-    const GaussianFactorGraph& factors, const Ordering& keys) {
-  gttic(EliminateCholesky);
+GaussianConditional::shared_ptr HessianFactor::eliminateCholesky(const Ordering& keys,
+    bool singlePrecision) {
+  gttic(HessianFactor_eliminateCholesky);
+
+  GaussianConditional::shared_ptr conditional;
+  try {
+    size_t numberOfKeysToEliminate = keys.size();
+    VerticalBlockMatrix Ab = info_.choleskyPartial(numberOfKeysToEliminate,
+        singlePrecision);
+    conditional = boost::make_shared<GaussianConditional>(keys_,
+        numberOfKeysToEliminate, Ab);
+    // Erase the eliminated keys in this factor
+    keys_.erase(begin(), begin() + numberOfKeysToEliminate);
+  } catch (const CholeskyFailed& e) {
+    throw IndeterminantLinearSystemException(keys.front());
+  }
+  return conditional;
+}
 
+/* ************************************************************************* */
+namespace {
+// Build the joint factor and eliminate it, in single or double precision
+std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
+eliminateJointCholesky(const GaussianFactorGraph& factors, const Ordering& keys,
+    bool singlePrecision) {
   // Build joint factor
   HessianFactor::shared_ptr jointFactor;
   try {
@@ -464,23 +566,76 @@ std::pair<boost::shared_ptr<GaussianConditional>,
   }
 
   // Do dense elimination
-  GaussianConditional::shared_ptr conditional;
-  try {
-    size_t numberOfKeysToEliminate = keys.size();
-    VerticalBlockMatrix Ab = jointFactor->info_.choleskyPartial(
-        numberOfKeysToEliminate);
-    conditional = boost::make_shared<GaussianConditional>(jointFactor->keys(),
-        numberOfKeysToEliminate, Ab);
-    // Erase the eliminated keys in the remaining factor
-    jointFactor->keys_.erase(jointFactor->begin(),
-        jointFactor->begin() + numberOfKeysToEliminate);
-  } catch (const CholeskyFailed& e) {
-    throw IndeterminantLinearSystemException(keys.front());
-  }
+  GaussianConditional::shared_ptr conditional = jointFactor->eliminateCholesky(keys,
+      singlePrecision);
 
   // Return result
   return make_pair(conditional, jointFactor);
 }
+}
+
+/* ************************************************************************* */
+std::pair<boost::shared_ptr<GaussianConditional>,
+    boost::shared_ptr<HessianFactor> > EliminateCholesky(
+    const GaussianFactorGraph& factors, const Ordering& keys) {
+  gttic(EliminateCholesky);
+  return eliminateJointCholesky(factors, keys, false);
+}
+
+/* ************************************************************************* */
+std::pair<boost::shared_ptr<GaussianConditional>,
+    boost::shared_ptr<HessianFactor> > EliminateCholeskySinglePrecision(
+    const GaussianFactorGraph& factors, const Ordering& keys) {
+  gttic(EliminateCholeskySinglePrecision);
+  return eliminateJointCholesky(factors, keys, true);
+}
+
+/* ************************************************************************* */
+namespace {
+// Cliques with a smaller estimated Cholesky cost are always eliminated with Cholesky, the flop
+// counts below do not account for the overheads that dominate small cliques
+static const double minCostModelFlops = 1e6;
+
+// Whether QR on the stacked Jacobians is estimated to be cheaper than forming the Hessian and
+// eliminating it with Cholesky.  Only cliques of JacobianFactors are considered, since QR would
+// first have to factor any HessianFactor back into a JacobianFactor.
+bool qrIsCheaper(const GaussianFactorGraph& factors, const Ordering& keys) {
+  FastMap<Key, size_t> dims;
+  double rows = 0.0, formHessianFlops = 0.0;
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, factors) {
+    if (!factor)
+      continue;
+    const JacobianFactor* jacobian = dynamic_cast<const JacobianFactor*>(factor.get());
+    if (!jacobian)
+      return false;
+    const double m = double(jacobian->rows()), n = double(jacobian->cols());
+    rows += m;
+    formHessianFlops += m * n * n;
+    for (GaussianFactor::const_iterator key = factor->begin(); key != factor->end(); ++key)
+      dims[*key] = factor->getDim(key);
+  }
+  size_t frontalDim = 0, totalDim = 0;
+  BOOST_FOREACH(Key key, keys) {
+    FastMap<Key, size_t>::const_iterator dim = dims.find(key);
+    if (dim != dims.end())
+      frontalDim += dim->second;
+  }
+  typedef FastMap<Key, size_t>::value_type KeyDim;
+  BOOST_FOREACH(const KeyDim& keyDim, dims)
+    totalDim += keyDim.second;
+
+  // The right-hand side is one more column of the separator
+  const double f = double(frontalDim), n = double(totalDim + 1);
+  const double choleskyFlops = formHessianFlops + eliminationFlops(f, n - f);
+  // Fewer rows than frontal dimensions cannot be eliminated, Cholesky reports that
+  if (choleskyFlops < minCostModelFlops || rows < f)
+    return false;
+  // Householder QR of the stacked rows x n matrix
+  const double qrFlops = rows >= n ?
+      2.0 * n * n * (rows - n / 3.0) : 2.0 * rows * rows * (n - rows / 3.0);
+  return qrFlops < choleskyFlops;
+}
+}
 
 /* ************************************************************************* */
 std::pair<boost::shared_ptr<GaussianConditional>,
@@ -491,8 +646,11 @@ std::pair<boost::shared_ptr<GaussianConditional>,
   // If any JacobianFactors have constrained noise models, we have to convert
   // all factors to JacobianFactors.  Otherwise, we can convert all factors
   // to HessianFactors.  This is because QR can handle constrained noise
-  // models but Cholesky cannot.
-  if (hasConstraints(factors))
+  // models but Cholesky cannot.  Without constraints, QR is still used for
+  // the large cliques where the cost model estimates it to be cheaper, like
+  // wide cliques with few stacked rows.  The choice shows in the timing
+  // output as an EliminateQR or EliminateCholesky scope.
+  if (hasConstraints(factors) || qrIsCheaper(factors, keys))
     return EliminateQR(factors, keys);
   else
     return EliminateCholesky(factors, keys);
@@ -41,6 +41,9 @@ namespace gtsam {
   GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
     EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys);
 
+  GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
+    EliminateCholeskySinglePrecision(const GaussianFactorGraph& factors, const Ordering& keys);
+
   /**
    * @brief A Gaussian factor using the canonical parameters (information form)
    *
@@ -184,8 +187,8 @@ namespace gtsam {
     explicit HessianFactor(const GaussianFactorGraph& factors,
       boost::optional<const Scatter&> scatter = boost::none);
 
-    /** Destructor */
-    virtual ~HessianFactor() {}
+    /** Destructor, hands the storage to the BlockMatrixArena when it is active */
+    virtual ~HessianFactor() { BlockMatrixArena::Recycle(info_); }
 
     /** Clone this HessianFactor */
     virtual GaussianFactor::shared_ptr clone() const {
@@ -221,6 +224,11 @@ namespace gtsam {
     /** Check if the factor is empty.  TODO: How should this be defined? */
     virtual bool empty() const { return size() == 0 /*|| rows() == 0*/; }
 
+    /** Return the memory used by this factor in bytes, including the information matrix */
+    virtual size_t memoryUsage() const {
+      return sizeof(*this) + heapBytes(keys()) + info_.allocatedBytes();
+    }
+
     /** Return a view of the block at (j1,j2) of the <em>upper-triangular part</em> of the
      * information matrix \f$ H \f$, no data is copied.  See HessianFactor class documentation
      * above to explain that only the upper-triangular part of the information matrix is stored
@@ -339,6 +347,10 @@ namespace gtsam {
     /** Return the full augmented Hessian matrix of this factor as a SymmetricBlockMatrix object. */
     const SymmetricBlockMatrix& matrixObject() const { return info_; }
 
+    /** Return the full augmented Hessian matrix of this factor as a SymmetricBlockMatrix object,
+     *  e.g. to fill it in place.  The block structure must not be changed. */
+    SymmetricBlockMatrix& matrixObject() { return info_; }
+
     /** Update an information matrix by adding the information corresponding to this factor
      * (used internally during elimination).
      * @param scatter A mapping from variable index to slot index in this HessianFactor
@@ -361,6 +373,18 @@ namespace gtsam {
      */
     Vector gradient(Key key, const VectorValues& x) const;
 
+    /**
+     *  In-place elimination that returns a conditional on the (ordered) keys specified, and
+     *  leaves this factor to be on the remaining keys (separator) only.  The eliminated keys must
+     *  be the first keys of this factor, in elimination order, as when it is constructed from a
+     *  Scatter with an ordering.
+     *  @param keys The variables to eliminate and their elimination ordering
+     *  @param singlePrecision Factor in single precision, see choleskyPartialSinglePrecision()
+     *  @return The conditional on the eliminated keys
+     */
+    boost::shared_ptr<GaussianConditional> eliminateCholesky(const Ordering& keys,
+        bool singlePrecision = false);
+
     /**
     *   Densely partially eliminate with Cholesky factorization.  JacobianFactors are
     *   left-multiplied with their transpose to form the Hessian using the conversion constructor
@@ -380,13 +404,27 @@ namespace gtsam {
     friend GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
       EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys);
 
+    /**
+    *   Same as EliminateCholesky, but the dense partial Cholesky factorization of the joint factor
+    *   is computed in single precision.  The conditional and remaining factor are still stored in
+    *   double precision, but are only accurate to single precision.  This is meant for the
+    *   mixed-precision solver GaussianFactorGraph::optimizeMixedPrecision, which recovers the
+    *   double precision solution by iterative refinement.
+    *
+    *   \addtogroup LinearSolving */
+    friend GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
+      EliminateCholeskySinglePrecision(const GaussianFactorGraph& factors, const Ordering& keys);
+
     /**
     *   Densely partially eliminate with Cholesky factorization.  JacobianFactors are
     *   left-multiplied with their transpose to form the Hessian using the conversion constructor
     *   HessianFactor(const JacobianFactor&).
     *   
     *   This function will fall back on QR factorization for any cliques containing JacobianFactor's
-    *   with constrained noise models.
+    *   with constrained noise models.  It also uses QR for large cliques of JacobianFactors for
+    *   which a flop count model, based on the number of stacked rows and the frontal and
+    *   separator dimensions, estimates QR to be cheaper than forming the Hessian, e.g. when there
+    *   are far fewer rows than columns.
     *   
     *   Variables are eliminated in the order specified in \c keys.
     *   
@@ -398,6 +436,14 @@ namespace gtsam {
     friend GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<GaussianFactor> >
       EliminatePreferCholesky(const GaussianFactorGraph& factors, const Ordering& keys);
 
+  protected:
+
+    /** Construct with the given keys and block dimensions, leaving the augmented information
+     *  matrix uninitialized, for derived classes that fill it in place */
+    template<typename KEYS, typename DIMS>
+    HessianFactor(const KEYS& keys, const DIMS& dims, bool appendOneDimension) :
+        GaussianFactor(keys), info_(dims, appendOneDimension) {}
+
   private:
 
     /** Serialization function */
@@ -30,6 +30,8 @@
 #include <gtsam/base/Matrix.h>
 #include <gtsam/base/FastMap.h>
 #include <gtsam/base/cholesky.h>
+#include <gtsam/base/simdKernels.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
 
 #include <boost/assign/list_of.hpp>
 #include <boost/foreach.hpp>
@@ -52,6 +54,11 @@
 #include <sstream>
 #include <stdexcept>
 
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 using namespace boost::assign;
 
@@ -215,6 +222,50 @@ FastVector<JacobianFactor::shared_ptr> _convertOrCastToJacobians(
   }
   return jacobians;
 }
+
+/* ************************************************************************* */
+// Copies the rows of a range of source factors into the combined factor.  Each source factor has
+// a precomputed destination: its first row, and the combined slot of each of its variables, so
+// that the factors can be copied independently of each other.
+struct CopyFactorRows {
+  const FastVector<JacobianFactor::shared_ptr>& factors_;
+  const FastVector<DenseIndex>& firstRow_; // first combined row of each factor, and m at the end
+  const FastVector<size_t>& firstSlot_; // start of each factor in combinedSlot_
+  const FastVector<size_t>& combinedSlot_; // combined slot of each variable of each factor
+  JacobianFactor& combined_;
+  Vector* sigmas_;
+
+  CopyFactorRows(const FastVector<JacobianFactor::shared_ptr>& factors,
+      const FastVector<DenseIndex>& firstRow, const FastVector<size_t>& firstSlot,
+      const FastVector<size_t>& combinedSlot, JacobianFactor& combined, Vector* sigmas) :
+      factors_(factors), firstRow_(firstRow), firstSlot_(firstSlot), combinedSlot_(
+          combinedSlot), combined_(combined), sigmas_(sigmas) {
+  }
+
+  void operator()(size_t begin, size_t end) const {
+    for (size_t factorI = begin; factorI < end; ++factorI) {
+      const JacobianFactor& source = *factors_[factorI];
+      const DenseIndex row = firstRow_[factorI];
+      const DenseIndex rows = firstRow_[factorI + 1] - row;
+      if (rows == 0)
+        continue;
+      // Zero the variables not in the source factor, then copy its blocks
+      combined_.getA().middleRows(row, rows).setZero();
+      for (size_t sourceSlot = 0; sourceSlot < source.size(); ++sourceSlot)
+        combined_.getA(combined_.begin() + combinedSlot_[firstSlot_[factorI] + sourceSlot])
+            .middleRows(row, rows) = source.getA(source.begin() + sourceSlot);
+      combined_.getb().segment(row, rows) = source.getb();
+      if (sigmas_ && source.get_model())
+        sigmas_->segment(row, rows) = source.get_model()->sigmas();
+    }
+  }
+
+#ifdef GTSAM_USE_TBB
+  void operator()(const tbb::blocked_range<size_t>& range) const {
+    (*this)(range.begin(), range.end());
+  }
+#endif
+};
 }
 
 /* ************************************************************************* */
@@ -245,10 +296,10 @@ JacobianFactor::JacobianFactor(const GaussianFactorGraph& graph,
     FastList<VariableSlots::const_iterator> unorderedSlots;
     size_t nOrderingSlotsUsed = 0;
     orderedSlots.resize(ordering->size());
-    FastMap<Key, size_t> inverseOrdering = ordering->invert();
+    Ordering::InvertedMap inverseOrdering = ordering->invert();
     for (VariableSlots::const_iterator item = variableSlots->begin();
         item != variableSlots->end(); ++item) {
-      FastMap<Key, size_t>::const_iterator orderingPosition =
+      Ordering::InvertedMap::const_iterator orderingPosition =
           inverseOrdering.find(item->first);
       if (orderingPosition == inverseOrdering.end()) {
         unorderedSlots.push_back(item);
@@ -289,56 +340,47 @@ JacobianFactor::JacobianFactor(const GaussianFactorGraph& graph,
       Base::keys_.begin());
   gttoc(allocate);
 
-  // Loop over slots in combined factor and copy blocks from source factors
-  gttic(copy_blocks);
-  size_t combinedSlot = 0;
-  BOOST_FOREACH(VariableSlots::const_iterator varslot, orderedSlots) {
-    JacobianFactor::ABlock destSlot(this->getA(this->begin() + combinedSlot));
-    // Loop over source jacobians
-    DenseIndex nextRow = 0;
-    for (size_t factorI = 0; factorI < jacobians.size(); ++factorI) {
-      // Slot in source factor
-      const size_t sourceSlot = varslot->second[factorI];
-      const DenseIndex sourceRows = jacobians[factorI]->rows();
-      if (sourceRows > 0) {
-        JacobianFactor::ABlock::RowsBlockXpr destBlock(
-            destSlot.middleRows(nextRow, sourceRows));
-        // Copy if exists in source factor, otherwise set zero
-        if (sourceSlot != VariableSlots::Empty)
-          destBlock = jacobians[factorI]->getA(
-              jacobians[factorI]->begin() + sourceSlot);
-        else
-          destBlock.setZero();
-        nextRow += sourceRows;
-      }
-    }
-    ++combinedSlot;
-  }
-  gttoc(copy_blocks);
-
-  // Copy the RHS vectors and sigmas
-  gttic(copy_vectors);
+  // Compute the destination of every source factor: its first row in the combined factor, and
+  // the combined slot of each of its variables
+  gttic(destinations);
+  FastVector<DenseIndex> firstRow(jacobians.size() + 1);
+  FastVector<size_t> firstSlot(jacobians.size() + 1);
+  firstRow[0] = 0;
+  firstSlot[0] = 0;
+  bool anyModel = false;
   bool anyConstrained = false;
-  boost::optional<Vector> sigmas;
-  // Loop over source jacobians
-  DenseIndex nextRow = 0;
   for (size_t factorI = 0; factorI < jacobians.size(); ++factorI) {
-    const DenseIndex sourceRows = jacobians[factorI]->rows();
-    if (sourceRows > 0) {
-      this->getb().segment(nextRow, sourceRows) = jacobians[factorI]->getb();
-      if (jacobians[factorI]->get_model()) {
-        // If the factor has a noise model and we haven't yet allocated sigmas, allocate it.
-        if (!sigmas)
-          sigmas = Vector::Constant(m, 1.0);
-        sigmas->segment(nextRow, sourceRows) =
-            jacobians[factorI]->get_model()->sigmas();
-        if (jacobians[factorI]->isConstrained())
-          anyConstrained = true;
-      }
-      nextRow += sourceRows;
+    const JacobianFactor& source = *jacobians[factorI];
+    firstRow[factorI + 1] = firstRow[factorI] + source.rows();
+    firstSlot[factorI + 1] = firstSlot[factorI] + source.size();
+    if (source.rows() > 0 && source.get_model()) {
+      anyModel = true;
+      if (source.isConstrained())
+        anyConstrained = true;
     }
   }
-  gttoc(copy_vectors);
+  FastVector<size_t> combinedSlot(firstSlot.back());
+  for (size_t slot = 0; slot < orderedSlots.size(); ++slot) {
+    const FastVector<size_t>& sourceSlots = orderedSlots[slot]->second;
+    for (size_t factorI = 0; factorI < jacobians.size(); ++factorI)
+      if (sourceSlots[factorI] != VariableSlots::Empty)
+        combinedSlot[firstSlot[factorI] + sourceSlots[factorI]] = slot;
+  }
+  gttoc(destinations);
+
+  // Copy the blocks, RHS vectors and sigmas of the source factors, in parallel when possible
+  gttic(copy_blocks);
+  boost::optional<Vector> sigmas;
+  if (anyModel)
+    sigmas = Vector::Constant(m, 1.0);
+  CopyFactorRows copyRows(jacobians, firstRow, firstSlot, combinedSlot, *this,
+      sigmas ? &*sigmas : 0);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, jacobians.size(), 64), copyRows);
+#else
+  copyRows(0, jacobians.size());
+#endif
+  gttoc(copy_blocks);
 
   if (sigmas)
     this->setModel(anyConstrained, *sigmas);
@@ -523,19 +565,40 @@ void JacobianFactor::updateHessian(const FastVector<Key>& infoKeys,
     // Ab_ is the augmented Jacobian matrix A, and we perform I += A'*A below
     DenseIndex n = Ab_.nBlocks() - 1, N = info->nBlocks() - 1;
 
+    // Blocks of common variable sizes are multiplied by the run-time dispatched kernels,
+    // directly on the upper triangle of the information matrix
+    Matrix& infoMatrix = info->matrix().nestedExpression();
+    const size_t ld = infoMatrix.rows(), k = Ab_.rows();
+
     // Apply updates to the upper triangle
     // Loop over blocks of A, including RHS with j==n
     vector<DenseIndex> slots(n+1);
     for (DenseIndex j = 0; j <= n; ++j) {
       const DenseIndex J = (j == n) ? N : Slot(infoKeys, keys_[j]);
       slots[j] = J;
+      const constABlock Aj = Ab_(j);
+      const bool smallJ = size_t(Aj.cols()) <= simd::MaxBlockSize;
       // Fill off-diagonal blocks with Ai'*Aj
       for (DenseIndex i = 0; i < j; ++i) {
         const DenseIndex I = slots[i];  // because i<j, slots[i] is valid.
-        (*info)(I, J).knownOffDiagonal() += Ab_(i).transpose() * Ab_(j);
+        const constABlock Ai = Ab_(i);
+        if (smallJ && size_t(Ai.cols()) <= simd::MaxBlockSize) {
+          if (I < J)
+            simd::gemmTN(Ai.cols(), Aj.cols(), k, 1.0, Ai.data(), Ai.outerStride(), Aj.data(),
+                Aj.outerStride(), &infoMatrix(info->offset(I), info->offset(J)), ld);
+          else
+            simd::gemmTN(Aj.cols(), Ai.cols(), k, 1.0, Aj.data(), Aj.outerStride(), Ai.data(),
+                Ai.outerStride(), &infoMatrix(info->offset(J), info->offset(I)), ld);
+        } else {
+          (*info)(I, J).knownOffDiagonal() += Ai.transpose() * Aj;
+        }
       }
       // Fill diagonal block with Aj'*Aj
-      (*info)(J, J).selfadjointView().rankUpdate(Ab_(j).transpose());
+      if (smallJ)
+        simd::gemmTN(Aj.cols(), Aj.cols(), k, 1.0, Aj.data(), Aj.outerStride(), Aj.data(),
+            Aj.outerStride(), &infoMatrix(info->offset(J), info->offset(J)), ld, true);
+      else
+        (*info)(J, J).selfadjointView().rankUpdate(Aj.transpose());
     }
   }
 }
@@ -569,6 +632,38 @@ void JacobianFactor::transposeMultiplyAdd(double alpha, const Vector& e,
   }
 }
 
+/* ************************************************************************* */
+void JacobianFactor::multiplyInPlace(const VectorValues& x, double* e) const {
+  Eigen::Map<Vector> Ax(e, Ab_.rows());
+  Ax.setZero();
+  for (size_t pos = 0; pos < size(); ++pos)
+    Ax.noalias() += Ab_(pos) * x[keys_[pos]];
+  // Diagonal noise models whiten in place, constrained ones leave their hard constraints alone
+  if (model_ && !model_->isConstrained())
+    Ax.array() *= model_->invsigmas().array();
+  else if (model_)
+    Ax = model_->whiten(Vector(Ax));
+}
+
+/* ************************************************************************* */
+void JacobianFactor::transposeMultiplyAdd(double alpha, const double* e,
+    VectorValues& x, double* work) const {
+  Eigen::Map<const Vector> ei(e, Ab_.rows());
+  Eigen::Map<Vector> E(work, Ab_.rows());
+  if (model_ && !model_->isConstrained())
+    E = alpha * ei.cwiseProduct(model_->invsigmas());
+  else if (model_)
+    E = alpha * model_->whiten(Vector(ei));
+  else
+    E = alpha * ei;
+  for (size_t pos = 0; pos < size(); ++pos) {
+    pair<VectorValues::iterator, bool> xi = x.tryInsert(keys_[pos], Vector());
+    if (xi.second)
+      xi.first->second = Vector::Zero(getDim(begin() + pos));
+    xi.first->second.noalias() += Ab_(pos).transpose() * E;
+  }
+}
+
 /* ************************************************************************* */
 void JacobianFactor::multiplyHessianAdd(double alpha, const VectorValues& x,
     VectorValues& y) const {
@@ -151,8 +151,8 @@ namespace gtsam {
       boost::optional<const Ordering&> ordering = boost::none,
       boost::optional<const VariableSlots&> variableSlots = boost::none);
 
-    /** Virtual destructor */
-    virtual ~JacobianFactor() {}
+    /** Virtual destructor, hands the storage to the BlockMatrixArena when it is active */
+    virtual ~JacobianFactor() { BlockMatrixArena::Recycle(Ab_); }
 
     /** Clone this JacobianFactor */
     virtual GaussianFactor::shared_ptr clone() const {
@@ -229,6 +229,12 @@ namespace gtsam {
     /** Check if the factor is empty.  TODO: How should this be defined? */
     virtual bool empty() const { return size() == 0 /*|| rows() == 0*/; }
 
+    /** Return the memory used by this factor in bytes, including the matrix and noise model */
+    virtual size_t memoryUsage() const {
+      return sizeof(*this) + heapBytes(keys()) + Ab_.allocatedBytes()
+          + (model_ ? model_->memoryUsage() : 0);
+    }
+
     /** is noise model constrained ? */
     bool isConstrained() const {
       return model_ && model_->isConstrained();
@@ -285,7 +291,14 @@ namespace gtsam {
 
     /** x += A'*e.  If x is initially missing any values, they are created and assumed to start as
      *  zero vectors. */
-    void transposeMultiplyAdd(double alpha, const Vector& e, VectorValues& x) const;
+    virtual void transposeMultiplyAdd(double alpha, const Vector& e, VectorValues& x) const;
+
+    /** Raw memory access version of operator*, writes the rows() entries of A*x to e */
+    void multiplyInPlace(const VectorValues& x, double* e) const;
+
+    /** Raw memory access version of transposeMultiplyAdd, x += alpha*A'*e for the rows() entries
+     *  of e.  The rows() entries of work are used as scratch space. */
+    void transposeMultiplyAdd(double alpha, const double* e, VectorValues& x, double* work) const;
 
     /** y += alpha * A'*A*x */
     void multiplyHessianAdd(double alpha, const VectorValues& x, VectorValues& y) const;
@@ -346,8 +359,6 @@ namespace gtsam {
     /// Internal function to fill blocks and set dimensions
     template<typename TERMS>
     void fillTerms(const TERMS& terms, const Vector& b, const SharedDiagonal& noiseModel);
-    
-  private:
 
     /** Unsafe Constructor that creates an uninitialized Jacobian of right size
      *  @param keys in some order
@@ -361,8 +372,12 @@ namespace gtsam {
         Base(keys), Ab_(dims.begin(), dims.end(), m, true), model_(model) {
     }
 
+  private:
+
     // be very selective on who can access these private methods:
     template<typename T> friend class ExpressionFactor;
+    friend class ImuFactor;
+    friend class CombinedImuFactor;
 
     /** Serialization function */
     friend class boost::serialization::access;
@@ -17,6 +17,7 @@
  */
 
 #include <gtsam/linear/NoiseModel.h>
+#include <gtsam/base/MemoryUsage.h>
 #include <gtsam/base/timing.h>
 
 #include <boost/foreach.hpp>
@@ -130,6 +131,11 @@ void Gaussian::print(const string& name) const {
   gtsam::print(thisR(), name + "Gaussian");
 }
 
+/* ************************************************************************* */
+size_t Gaussian::memoryUsage() const {
+  return sizeof(Gaussian) + (sqrt_information_ ? heapBytes(*sqrt_information_) : 0);
+}
+
 /* ************************************************************************* */
 bool Gaussian::equals(const Base& expected, double tol) const {
   const Gaussian* p = dynamic_cast<const Gaussian*> (&expected);
@@ -278,6 +284,11 @@ void Diagonal::print(const string& name) const {
   gtsam::print(sigmas_, name + "diagonal sigmas");
 }
 
+/* ************************************************************************* */
+size_t Diagonal::memoryUsage() const {
+  return sizeof(Diagonal) + heapBytes(sigmas_) + heapBytes(invsigmas_) + heapBytes(precisions_);
+}
+
 /* ************************************************************************* */
 Vector Diagonal::whiten(const Vector& v) const {
   return v.cwiseProduct(invsigmas_);
@@ -303,6 +314,30 @@ void Diagonal::WhitenInPlace(Eigen::Block<Matrix> H) const {
   H = invsigmas().asDiagonal() * H;
 }
 
+/* ************************************************************************* */
+void Diagonal::WhitenSystem(vector<Matrix>& A, Vector& b) const {
+  BOOST_FOREACH(Matrix& Aj, A) { Aj.array().colwise() *= invsigmas_.array(); }
+  b.array() *= invsigmas_.array();
+}
+
+void Diagonal::WhitenSystem(Matrix& A, Vector& b) const {
+  A.array().colwise() *= invsigmas_.array();
+  b.array() *= invsigmas_.array();
+}
+
+void Diagonal::WhitenSystem(Matrix& A1, Matrix& A2, Vector& b) const {
+  A1.array().colwise() *= invsigmas_.array();
+  A2.array().colwise() *= invsigmas_.array();
+  b.array() *= invsigmas_.array();
+}
+
+void Diagonal::WhitenSystem(Matrix& A1, Matrix& A2, Matrix& A3, Vector& b) const {
+  A1.array().colwise() *= invsigmas_.array();
+  A2.array().colwise() *= invsigmas_.array();
+  A3.array().colwise() *= invsigmas_.array();
+  b.array() *= invsigmas_.array();
+}
+
 /* ************************************************************************* */
 // Constrained
 /* ************************************************************************* */
@@ -349,6 +384,12 @@ void Constrained::print(const std::string& name) const {
   gtsam::print(mu_, name + "constrained mu");
 }
 
+/* ************************************************************************* */
+size_t Constrained::memoryUsage() const {
+  return sizeof(Constrained) + heapBytes(sigmas_) + heapBytes(invsigmas_)
+      + heapBytes(precisions_) + heapBytes(mu_);
+}
+
 /* ************************************************************************* */
 Vector Constrained::whiten(const Vector& v) const {
   // If sigmas[i] is not 0 then divide v[i] by sigmas[i], as usually done in
@@ -398,6 +439,24 @@ void Constrained::WhitenInPlace(Eigen::Block<Matrix> H) const {
       H.row(i) *= invsigmas_(i);
 }
 
+/* ************************************************************************* */
+// The fast Diagonal versions do not know about constrained rows
+void Constrained::WhitenSystem(vector<Matrix>& A, Vector& b) const {
+  Gaussian::WhitenSystem(A, b);
+}
+
+void Constrained::WhitenSystem(Matrix& A, Vector& b) const {
+  Gaussian::WhitenSystem(A, b);
+}
+
+void Constrained::WhitenSystem(Matrix& A1, Matrix& A2, Vector& b) const {
+  Gaussian::WhitenSystem(A1, A2, b);
+}
+
+void Constrained::WhitenSystem(Matrix& A1, Matrix& A2, Matrix& A3, Vector& b) const {
+  Gaussian::WhitenSystem(A1, A2, A3, b);
+}
+
 /* ************************************************************************* */
 Constrained::shared_ptr Constrained::unit() const {
   Vector sigmas = ones(dim());
@@ -510,6 +569,11 @@ void Isotropic::print(const string& name) const {
   cout << boost::format("isotropic dim=%1% sigma=%2%") % dim() % sigma_ << endl;
 }
 
+/* ************************************************************************* */
+size_t Isotropic::memoryUsage() const {
+  return sizeof(Isotropic) + heapBytes(sigmas_) + heapBytes(invsigmas_) + heapBytes(precisions_);
+}
+
 /* ************************************************************************* */
 double Isotropic::Mahalanobis(const Vector& v) const {
   return v.dot(v) * invsigma_ * invsigma_;
@@ -545,6 +609,30 @@ void Isotropic::WhitenInPlace(Eigen::Block<Matrix> H) const {
   H *= invsigma_;
 }
 
+/* ************************************************************************* */
+void Isotropic::WhitenSystem(vector<Matrix>& A, Vector& b) const {
+  BOOST_FOREACH(Matrix& Aj, A) { Aj *= invsigma_; }
+  b *= invsigma_;
+}
+
+void Isotropic::WhitenSystem(Matrix& A, Vector& b) const {
+  A *= invsigma_;
+  b *= invsigma_;
+}
+
+void Isotropic::WhitenSystem(Matrix& A1, Matrix& A2, Vector& b) const {
+  A1 *= invsigma_;
+  A2 *= invsigma_;
+  b *= invsigma_;
+}
+
+void Isotropic::WhitenSystem(Matrix& A1, Matrix& A2, Matrix& A3, Vector& b) const {
+  A1 *= invsigma_;
+  A2 *= invsigma_;
+  A3 *= invsigma_;
+  b *= invsigma_;
+}
+
 /* ************************************************************************* */
 // Unit
 /* ************************************************************************* */
@@ -560,11 +648,11 @@ namespace mEstimator {
 
 /** produce a weight vector according to an error vector and the implemented
  * robust function */
-Vector Base::weight(const Vector &error) const {
-  const size_t n = error.rows();
+Vector Base::weights(const Vector& distances) const {
+  const size_t n = distances.rows();
   Vector w(n);
   for ( size_t i = 0 ; i < n ; ++i )
-    w(i) = weight(error(i));
+    w(i) = weight(distances(i));
   return w;
 }
 
@@ -671,6 +759,9 @@ Fair::Fair(double c, const ReweightScheme reweight)
 double Fair::weight(double error) const
 { return 1.0 / (1.0 + fabs(error)/c_); }
 
+Vector Fair::weights(const Vector& distances) const
+{ return (1.0 + distances.array().abs() / c_).inverse(); }
+
 void Fair::print(const std::string &s="") const
 { cout << s << "fair (" << c_ << ")" << endl; }
 
@@ -699,6 +790,11 @@ double Huber::weight(double error) const {
   return (fabs(error) > k_) ? k_ / fabs(error) : 1.0;
 }
 
+Vector Huber::weights(const Vector& distances) const {
+  const Eigen::ArrayXd absError = distances.array().abs();
+  return (absError > k_).select(k_ / absError, 1.0);
+}
+
 void Huber::print(const std::string &s="") const {
   cout << s << "huber (" << k_ << ")" << endl;
 }
@@ -729,6 +825,10 @@ double Cauchy::weight(double error) const {
   return k_*k_ / (k_*k_ + error*error);
 }
 
+Vector Cauchy::weights(const Vector& distances) const {
+  return k_*k_ / (k_*k_ + distances.array().square());
+}
+
 void Cauchy::print(const std::string &s="") const {
   cout << s << "cauchy (" << k_ << ")" << endl;
 }
@@ -759,6 +859,11 @@ double Tukey::weight(double error) const {
   return 0.0;
 }
 
+Vector Tukey::weights(const Vector& distances) const {
+  const Eigen::ArrayXd xc2 = (distances.array() / c_).square();
+  return (distances.array().abs() <= c_).select((1.0 - xc2).square(), 0.0);
+}
+
 void Tukey::print(const std::string &s="") const {
   std::cout << s << ": Tukey (" << c_ << ")" << std::endl;
 }
@@ -785,6 +890,10 @@ double Welsh::weight(double error) const {
   return std::exp(-xc2);
 }
 
+Vector Welsh::weights(const Vector& distances) const {
+  return (-(distances.array() / c_).square()).exp();
+}
+
 void Welsh::print(const std::string &s="") const {
   std::cout << s << ": Welsh (" << c_ << ")" << std::endl;
 }
@@ -813,6 +922,11 @@ double GemanMcClure::weight(double error) const {
   return c4/(c2error*c2error);
 }
 
+Vector GemanMcClure::weights(const Vector& distances) const {
+  const double c2 = c_*c_;
+  return (c2*c2) / (c2 + distances.array().square()).square();
+}
+
 void GemanMcClure::print(const std::string &s="") const {
   std::cout << s << ": Geman-McClure (" << c_ << ")" << std::endl;
 }
@@ -845,6 +959,11 @@ double DCS::weight(double error) const {
   return 1.0;
 }
 
+Vector DCS::weights(const Vector& distances) const {
+  const Eigen::ArrayXd e2 = distances.array().square();
+  return (e2 > c_).select((2.0*c_ / (c_ + e2)).square(), 1.0);
+}
+
 void DCS::print(const std::string &s="") const {
   std::cout << s << ": DCS (" << c_ << ")" << std::endl;
 }
@@ -870,6 +989,10 @@ void Robust::print(const std::string& name) const {
   noise_->print(name);
 }
 
+size_t Robust::memoryUsage() const {
+  return sizeof(Robust) + noise_->memoryUsage();
+}
+
 bool Robust::equals(const Base& expected, double tol) const {
   const Robust* p = dynamic_cast<const Robust*> (&expected);
   if (p == NULL) return false;
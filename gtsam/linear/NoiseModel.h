@@ -74,6 +74,9 @@ namespace gtsam {
 
       virtual void print(const std::string& name = "") const = 0;
 
+      /// Memory used by this noise model in bytes, including its matrices and vectors
+      virtual size_t memoryUsage() const { return sizeof(Base); }
+
       virtual bool equals(const Base& expected, double tol=1e-9) const = 0;
 
       /// Calculate standard deviations
@@ -191,6 +194,7 @@ namespace gtsam {
       static shared_ptr Covariance(const Matrix& covariance, bool smart = true);
 
       virtual void print(const std::string& name) const;
+      virtual size_t memoryUsage() const;
       virtual bool equals(const Base& expected, double tol=1e-9) const;
       virtual Vector sigmas() const;
       virtual Vector whiten(const Vector& v) const;
@@ -311,6 +315,7 @@ namespace gtsam {
       }
 
       virtual void print(const std::string& name) const;
+      virtual size_t memoryUsage() const;
       virtual Vector sigmas() const { return sigmas_; }
       virtual Vector whiten(const Vector& v) const;
       virtual Vector unwhiten(const Vector& v) const;
@@ -318,6 +323,15 @@ namespace gtsam {
       virtual void WhitenInPlace(Matrix& H) const;
       virtual void WhitenInPlace(Eigen::Block<Matrix> H) const;
 
+      /**
+       * Whiten a system in one call, scaling each block with invsigmas without the virtual
+       * WhitenInPlace call per block of Gaussian::WhitenSystem
+       */
+      virtual void WhitenSystem(std::vector<Matrix>& A, Vector& b) const;
+      virtual void WhitenSystem(Matrix& A, Vector& b) const;
+      virtual void WhitenSystem(Matrix& A1, Matrix& A2, Vector& b) const;
+      virtual void WhitenSystem(Matrix& A1, Matrix& A2, Matrix& A3, Vector& b) const;
+
       /**
        * Return standard deviations (sqrt of diagonal)
        */
@@ -470,6 +484,7 @@ namespace gtsam {
       }
 
       virtual void print(const std::string& name) const;
+      virtual size_t memoryUsage() const;
 
       /// Calculates error vector with weights applied
       virtual Vector whiten(const Vector& v) const;
@@ -480,6 +495,12 @@ namespace gtsam {
       virtual void WhitenInPlace(Matrix& H) const;
       virtual void WhitenInPlace(Eigen::Block<Matrix> H) const;
 
+      /// Whiten a system block by block, with the partial whitening above
+      virtual void WhitenSystem(std::vector<Matrix>& A, Vector& b) const;
+      virtual void WhitenSystem(Matrix& A, Vector& b) const;
+      virtual void WhitenSystem(Matrix& A1, Matrix& A2, Vector& b) const;
+      virtual void WhitenSystem(Matrix& A1, Matrix& A2, Matrix& A3, Vector& b) const;
+
       /**
        * Apply QR factorization to the system [A b], taking into account constraints
        */
@@ -546,6 +567,7 @@ namespace gtsam {
       }
 
       virtual void print(const std::string& name) const;
+      virtual size_t memoryUsage() const;
       virtual double Mahalanobis(const Vector& v) const;
       virtual Vector whiten(const Vector& v) const;
       virtual Vector unwhiten(const Vector& v) const;
@@ -554,6 +576,12 @@ namespace gtsam {
       virtual void whitenInPlace(Vector& v) const;
       virtual void WhitenInPlace(Eigen::Block<Matrix> H) const;
 
+      /// Whiten a system in one call, scaling all blocks by 1/sigma
+      virtual void WhitenSystem(std::vector<Matrix>& A, Vector& b) const;
+      virtual void WhitenSystem(Matrix& A, Vector& b) const;
+      virtual void WhitenSystem(Matrix& A1, Matrix& A2, Vector& b) const;
+      virtual void WhitenSystem(Matrix& A1, Matrix& A2, Matrix& A3, Vector& b) const;
+
       /**
        * Return standard deviation
        */
@@ -608,6 +636,11 @@ namespace gtsam {
       virtual void unwhitenInPlace(Vector& /*v*/) const {}
       virtual void whitenInPlace(Eigen::Block<Vector>& /*v*/) const {}
       virtual void unwhitenInPlace(Eigen::Block<Vector>& /*v*/) const {}
+      virtual void WhitenSystem(std::vector<Matrix>& /*A*/, Vector& /*b*/) const {}
+      virtual void WhitenSystem(Matrix& /*A*/, Vector& /*b*/) const {}
+      virtual void WhitenSystem(Matrix& /*A1*/, Matrix& /*A2*/, Vector& /*b*/) const {}
+      virtual void WhitenSystem(Matrix& /*A1*/, Matrix& /*A2*/, Matrix& /*A3*/,
+          Vector& /*b*/) const {}
 
     private:
       /** Serialization function */
@@ -648,9 +681,15 @@ namespace gtsam {
           return std::sqrt(weight(error));
         }
 
+        /**
+         * Weights of a whole vector of distances at once.  The default calls weight(double) for
+         * each entry, the estimators below override it with a single array expression.
+         */
+        virtual Vector weights(const Vector& distances) const;
+
         /** produce a weight vector according to an error vector and the implemented
         * robust function */
-        Vector weight(const Vector &error) const;
+        Vector weight(const Vector &error) const { return weights(error); }
 
         /** square root version of the weight function */
         Vector sqrtWeight(const Vector &error) const {
@@ -681,6 +720,9 @@ namespace gtsam {
         Null(const ReweightScheme reweight = Block) : Base(reweight) {}
         virtual ~Null() {}
         virtual double weight(double /*error*/) const { return 1.0; }
+        virtual Vector weights(const Vector& distances) const {
+          return Vector::Ones(distances.size());
+        }
         virtual void print(const std::string &s) const;
         virtual bool equals(const Base& /*expected*/, double /*tol*/) const { return true; }
         static shared_ptr Create() ;
@@ -702,6 +744,7 @@ namespace gtsam {
         Fair(double c = 1.3998, const ReweightScheme reweight = Block);
         virtual ~Fair() {}
         virtual double weight(double error) const;
+        virtual Vector weights(const Vector& distances) const;
         virtual void print(const std::string &s) const;
         virtual bool equals(const Base& expected, double tol=1e-8) const;
         static shared_ptr Create(double c, const ReweightScheme reweight = Block) ;
@@ -727,6 +770,7 @@ namespace gtsam {
         virtual ~Huber() {}
         Huber(double k = 1.345, const ReweightScheme reweight = Block);
         virtual double weight(double error) const;
+        virtual Vector weights(const Vector& distances) const;
         virtual void print(const std::string &s) const;
         virtual bool equals(const Base& expected, double tol=1e-8) const;
         static shared_ptr Create(double k, const ReweightScheme reweight = Block) ;
@@ -756,6 +800,7 @@ namespace gtsam {
         virtual ~Cauchy() {}
         Cauchy(double k = 0.1, const ReweightScheme reweight = Block);
         virtual double weight(double error) const;
+        virtual Vector weights(const Vector& distances) const;
         virtual void print(const std::string &s) const;
         virtual bool equals(const Base& expected, double tol=1e-8) const;
         static shared_ptr Create(double k, const ReweightScheme reweight = Block) ;
@@ -781,6 +826,7 @@ namespace gtsam {
         Tukey(double c = 4.6851, const ReweightScheme reweight = Block);
         virtual ~Tukey() {}
         virtual double weight(double error) const;
+        virtual Vector weights(const Vector& distances) const;
         virtual void print(const std::string &s) const;
         virtual bool equals(const Base& expected, double tol=1e-8) const;
         static shared_ptr Create(double k, const ReweightScheme reweight = Block) ;
@@ -806,6 +852,7 @@ namespace gtsam {
         Welsh(double c = 2.9846, const ReweightScheme reweight = Block);
         virtual ~Welsh() {}
         virtual double weight(double error) const;
+        virtual Vector weights(const Vector& distances) const;
         virtual void print(const std::string &s) const;
         virtual bool equals(const Base& expected, double tol=1e-8) const;
         static shared_ptr Create(double k, const ReweightScheme reweight = Block) ;
@@ -836,6 +883,7 @@ namespace gtsam {
         GemanMcClure(double c = 1.0, const ReweightScheme reweight = Block);
         virtual ~GemanMcClure() {}
         virtual double weight(double error) const;
+        virtual Vector weights(const Vector& distances) const;
         virtual void print(const std::string &s) const;
         virtual bool equals(const Base& expected, double tol=1e-8) const;
         static shared_ptr Create(double k, const ReweightScheme reweight = Block) ;
@@ -865,6 +913,7 @@ namespace gtsam {
         DCS(double c = 1.0, const ReweightScheme reweight = Block);
         virtual ~DCS() {}
         virtual double weight(double error) const;
+        virtual Vector weights(const Vector& distances) const;
         virtual void print(const std::string &s) const;
         virtual bool equals(const Base& expected, double tol=1e-8) const;
         static shared_ptr Create(double k, const ReweightScheme reweight = Block) ;
@@ -909,6 +958,7 @@ namespace gtsam {
       virtual ~Robust() {}
 
       virtual void print(const std::string& name) const;
+      virtual size_t memoryUsage() const;
       virtual bool equals(const Base& expected, double tol=1e-9) const;
 
       /// Return the contained robust error function
@@ -0,0 +1,247 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    OutOfCoreBayesTree.cpp
+ * @brief   Multifrontal elimination streaming the cliques of the Bayes tree to a file
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/linear/OutOfCoreBayesTree.h>
+#include <gtsam/linear/GaussianEliminationTree.h>
+#include <gtsam/linear/GaussianJunctionTree.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/inference/inferenceExceptions.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/base/treeTraversal-inst.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/foreach.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/make_shared.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+// The file starts with this tag, followed by the cliques.  Every clique is a header of 64-bit
+// integers: number of keys, number of frontals, rows, and whether sigmas follow, then the keys and
+// their dimensions, then the augmented matrix [R S d] in column-major order and the sigmas.  All
+// fields are 8 bytes, so the doubles are aligned in a memory map.
+const char kTag[8] = { 'G', 'T', 'S', 'A', 'M', 'O', 'O', 'C' };
+const size_t kHeaderFields = 4;
+
+// A read-only memory map of a whole file
+struct MappedFile {
+  boost::interprocess::file_mapping mapping;
+  boost::interprocess::mapped_region region;
+  MappedFile(const string& filename) :
+      mapping(filename.c_str(), boost::interprocess::read_only),
+      region(mapping, boost::interprocess::read_only) {
+  }
+  const char* begin() const {
+    return static_cast<const char*>(region.get_address());
+  }
+  size_t size() const {
+    return region.get_size();
+  }
+};
+
+/* ************************************************************************* */
+// Number of bytes of the clique starting at data
+size_t cliqueBytes(const char* data) {
+  const boost::uint64_t* header = reinterpret_cast<const boost::uint64_t*>(data);
+  const size_t nrKeys = header[0], rows = header[2];
+  const boost::uint64_t* dims = header + kHeaderFields + nrKeys;
+  size_t cols = 1;
+  for (size_t k = 0; k < nrKeys; ++k)
+    cols += dims[k];
+  return sizeof(boost::uint64_t) * (kHeaderFields + 2 * nrKeys)
+      + sizeof(double) * rows * (cols + (header[3] ? 1 : 0));
+}
+
+/* ************************************************************************* */
+// Write a conditional as a clique, and return its number of bytes
+size_t writeClique(ostream& stream, const GaussianConditional& conditional) {
+  const Matrix Ab = conditional.augmentedJacobianUnweighted();
+  const SharedDiagonal& model = conditional.get_model();
+  FastVector<boost::uint64_t> header;
+  header.reserve(kHeaderFields + 2 * conditional.size());
+  header.push_back(conditional.size());
+  header.push_back(conditional.nrFrontals());
+  header.push_back(Ab.rows());
+  header.push_back(model ? 1 : 0);
+  header.insert(header.end(), conditional.begin(), conditional.end());
+  for (GaussianConditional::const_iterator key = conditional.begin(); key != conditional.end(); ++key)
+    header.push_back(conditional.getDim(key));
+  stream.write(reinterpret_cast<const char*>(&header[0]), sizeof(boost::uint64_t) * header.size());
+  stream.write(reinterpret_cast<const char*>(Ab.data()), sizeof(double) * Ab.size());
+  if (model) {
+    const Vector sigmas = model->sigmas();
+    stream.write(reinterpret_cast<const char*>(sigmas.data()), sizeof(double) * sigmas.size());
+  }
+  return sizeof(boost::uint64_t) * header.size()
+      + sizeof(double) * (Ab.size() + (model ? Ab.rows() : 0));
+}
+
+/* ************************************************************************* */
+// Read the conditional of the clique starting at data
+GaussianConditional::shared_ptr readClique(const char* data) {
+  const boost::uint64_t* header = reinterpret_cast<const boost::uint64_t*>(data);
+  const size_t nrKeys = header[0], nrFrontals = header[1], rows = header[2];
+  const boost::uint64_t* keys = header + kHeaderFields;
+  const boost::uint64_t* dims = keys + nrKeys;
+  VerticalBlockMatrix Ab(dims, dims + nrKeys, rows, true);
+  const double* matrix = reinterpret_cast<const double*>(dims + nrKeys);
+  Ab.matrix() = Eigen::Map<const Matrix>(matrix, rows, Ab.cols());
+  SharedDiagonal model;
+  if (header[3])
+    model = noiseModel::Diagonal::Sigmas(
+        Eigen::Map<const Vector>(matrix + rows * Ab.cols(), rows));
+  return boost::make_shared<GaussianConditional>(
+      FastVector<Key>(keys, keys + nrKeys), nrFrontals, Ab, model);
+}
+
+/* ************************************************************************* */
+// Traversal data of the streaming elimination: the remaining factors of the children
+struct StreamingData {
+  StreamingData* const parentData;
+  size_t myIndexInParent;
+  FastVector<GaussianFactor::shared_ptr> childFactors;
+
+  StreamingData(StreamingData* _parentData) : parentData(_parentData), myIndexInParent(0) {
+    if (parentData) {
+      myIndexInParent = parentData->childFactors.size();
+      parentData->childFactors.push_back(GaussianFactor::shared_ptr());
+    }
+  }
+
+  static StreamingData PreOrderVisitor(const GaussianJunctionTree::sharedNode&,
+      StreamingData& parentData) {
+    return StreamingData(&parentData);
+  }
+};
+
+/* ************************************************************************* */
+// Eliminate a cluster, write its conditional to the file and pass the remaining factor up
+class StreamingPostOrderVisitor {
+  const OutOfCoreBayesTree::Eliminate& function_;
+  ostream& stream_;
+  FastVector<size_t>& offsets_;
+  size_t& position_;
+
+public:
+  StreamingPostOrderVisitor(const OutOfCoreBayesTree::Eliminate& function, ostream& stream,
+      FastVector<size_t>& offsets, size_t& position) :
+      function_(function), stream_(stream), offsets_(offsets), position_(position) {
+  }
+
+  void operator()(const GaussianJunctionTree::sharedNode& node, StreamingData& myData) {
+    GaussianFactorGraph gatheredFactors;
+    gatheredFactors.reserve(node->factors.size() + myData.childFactors.size());
+    gatheredFactors += node->factors;
+    gatheredFactors += myData.childFactors;
+    FastVector<GaussianFactor::shared_ptr>().swap(myData.childFactors);
+
+    const pair<GaussianConditional::shared_ptr, GaussianFactor::shared_ptr> eliminationResult =
+        function_(gatheredFactors, node->orderedFrontalKeys);
+    gatheredFactors.resize(0);
+
+    offsets_.push_back(position_);
+    position_ += writeClique(stream_, *eliminationResult.first);
+    if (!stream_)
+      throw runtime_error("OutOfCoreBayesTree: could not write a clique");
+
+    if (!eliminationResult.second->empty())
+      myData.parentData->childFactors[myData.myIndexInParent] = eliminationResult.second;
+  }
+};
+
+}
+
+/* ************************************************************************* */
+OutOfCoreBayesTree::OutOfCoreBayesTree(const GaussianFactorGraph& graph,
+    const Ordering& ordering, const string& filename, const Eliminate& function) :
+    filename_(filename), fileBytes_(0) {
+  gttic(OutOfCoreBayesTree_eliminate);
+  const GaussianJunctionTree junctionTree((GaussianEliminationTree(graph, ordering)));
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, junctionTree.remainingFactors()) {
+    if (factor && !factor->empty())
+      throw InconsistentEliminationRequested();
+  }
+
+  ofstream stream(filename.c_str(), ios::binary | ios::trunc);
+  if (!stream)
+    throw runtime_error("OutOfCoreBayesTree: could not write " + filename);
+  stream.write(kTag, sizeof(kTag));
+  fileBytes_ = sizeof(kTag);
+
+  // The traversal is serial, so that the cliques are written in post-order
+  StreamingData rootData(0);
+  StreamingPostOrderVisitor visitorPost(function, stream, offsets_, fileBytes_);
+  treeTraversal::DepthFirstForest(junctionTree, rootData, StreamingData::PreOrderVisitor,
+      visitorPost);
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, rootData.childFactors) {
+    if (factor)
+      throw InconsistentEliminationRequested();
+  }
+
+  stream.close();
+  if (!stream)
+    throw runtime_error("OutOfCoreBayesTree: could not write " + filename);
+}
+
+/* ************************************************************************* */
+OutOfCoreBayesTree::OutOfCoreBayesTree(const string& filename) :
+    filename_(filename), fileBytes_(0) {
+  const MappedFile file(filename);
+  if (file.size() < sizeof(kTag) || memcmp(file.begin(), kTag, sizeof(kTag)) != 0)
+    throw runtime_error("OutOfCoreBayesTree: " + filename + " is not a clique file");
+  size_t position = sizeof(kTag);
+  while (position < file.size()) {
+    if (file.size() - position < sizeof(boost::uint64_t) * kHeaderFields)
+      throw runtime_error("OutOfCoreBayesTree: " + filename + " is truncated");
+    offsets_.push_back(position);
+    position += cliqueBytes(file.begin() + position);
+  }
+  if (position != file.size())
+    throw runtime_error("OutOfCoreBayesTree: " + filename + " is truncated");
+  fileBytes_ = position;
+}
+
+/* ************************************************************************* */
+GaussianConditional::shared_ptr OutOfCoreBayesTree::conditional(size_t i) const {
+  const MappedFile file(filename_);
+  return readClique(file.begin() + offsets_.at(i));
+}
+
+/* ************************************************************************* */
+VectorValues OutOfCoreBayesTree::optimize() const {
+  gttic(OutOfCoreBayesTree_optimize);
+  VectorValues solution;
+  if (offsets_.empty())
+    return solution;
+  const MappedFile file(filename_);
+  for (size_t i = offsets_.size(); i-- > 0;) {
+    const GaussianConditional::shared_ptr conditional = readClique(file.begin() + offsets_[i]);
+    solution.insert(conditional->solve(solution));
+  }
+  return solution;
+}
+
+}
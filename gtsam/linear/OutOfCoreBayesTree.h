@@ -0,0 +1,99 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    OutOfCoreBayesTree.h
+ * @brief   Multifrontal elimination streaming the cliques of the Bayes tree to a file
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/GaussianConditional.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/base/FastVector.h>
+
+#include <string>
+
+namespace gtsam {
+
+/**
+ * A Gaussian Bayes tree kept on disk, for problems whose Bayes tree does not fit in memory.
+ *
+ * Multifrontal elimination visits the cliques in post-order, and a clique is not needed anymore
+ * once its conditional is computed, so the constructor writes the conditional of every clique to
+ * a file as soon as it is eliminated.  Only the active front is kept in memory: the remaining
+ * factors passed up from the cliques on the current path of the traversal to their parents.
+ * Back-substitution in optimize() then streams the cliques from a memory map of the file in
+ * reverse post-order, which solves every clique after its parent, holding only the solution.
+ *
+ * The file uses the native byte order and is not removed by this class, it can be opened again
+ * with the constructor taking only a file name.
+ *
+ * \addtogroup Multifrontal
+ * \nosubgrouping
+ */
+class GTSAM_EXPORT OutOfCoreBayesTree {
+public:
+
+  typedef GaussianFactorGraph::Eliminate Eliminate; ///< Typedef for an eliminate subroutine
+
+  /// @name Standard Constructors
+  /// @{
+
+  /**
+   * Eliminate \c graph in the given ordering, writing the cliques to \c filename, which is
+   * overwritten.  The ordering must contain all variables of the graph.
+   * @throw std::runtime_error if the file cannot be written
+   * @throw InconsistentEliminationRequested if the ordering is incomplete
+   */
+  OutOfCoreBayesTree(const GaussianFactorGraph& graph, const Ordering& ordering,
+      const std::string& filename,
+      const Eliminate& function = EliminationTraits<GaussianFactorGraph>::DefaultEliminate);
+
+  /**
+   * Open the cliques written to \c filename by a previous elimination
+   * @throw std::runtime_error if the file cannot be read or is not a clique file
+   */
+  explicit OutOfCoreBayesTree(const std::string& filename);
+
+  /// @}
+
+  /// @name Standard Interface
+  /// @{
+
+  /** The file holding the cliques */
+  const std::string& filename() const { return filename_; }
+
+  /** Number of cliques */
+  size_t nrCliques() const { return offsets_.size(); }
+
+  /** Size of the file in bytes */
+  size_t fileBytes() const { return fileBytes_; }
+
+  /** Read the conditional of clique \c i, in post-order, i.e. children before their parent */
+  GaussianConditional::shared_ptr conditional(size_t i) const;
+
+  /** Solve for the optimal solution by back-substitution, reading the cliques from the file */
+  VectorValues optimize() const;
+
+  /// @}
+
+private:
+
+  std::string filename_;
+  FastVector<size_t> offsets_; ///< Position of each clique in the file, in post-order
+  size_t fileBytes_;
+};
+
+}
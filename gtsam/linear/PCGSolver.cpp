@@ -21,11 +21,20 @@
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/timing.h>
 
 #include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/algorithm/string.hpp>
 
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <stdexcept>
 
@@ -54,19 +63,305 @@ VectorValues PCGSolver::optimize(const GaussianFactorGraph &gfg,
   preconditioner_->build(gfg, keyInfo, lambda);
 
   /* apply pcg */
-  GaussianFactorGraphSystem system(gfg, *preconditioner_, keyInfo, lambda);
+  GaussianFactorGraphSystem system(gfg, *preconditioner_, keyInfo, lambda,
+      parameters_.blas_kernel_);
   Vector x0 = initial.vector(keyInfo.ordering());
-  const Vector sol = preconditionedConjugateGradient(system, x0, parameters_);
+  const Vector sol = conjugateGradient(system, x0, parameters_);
 
   return buildVectorValues(sol, keyInfo);
 }
 
+/*****************************************************************************/
+VectorValues PCGSolver::optimizeWarmStarted(const GaussianFactorGraph &gfg,
+    const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda,
+    const VectorValues &initial) {
+  preconditioner_->build(gfg, keyInfo, lambda);
+  GaussianFactorGraphSystem system(gfg, *preconditioner_, keyInfo, lambda,
+      parameters_.blas_kernel_);
+
+  /* squared norms of the preconditioned residuals at zero and at the warm start */
+  Vector x0 = initial.vector(keyInfo.ordering());
+  Vector r(x0.size()), z(x0.size());
+  system.getb(r);
+  system.precondition(r, z);
+  const double gammaZero = r.dot(z);
+  system.residual(x0, r);
+  system.precondition(r, z);
+  const double gammaInitial = r.dot(z);
+
+  /* scale the relative tolerance, so that pcg stops at the same residual as from zero */
+  PCGSolverParameters parameters = parameters_;
+  if (gammaInitial == 0.0)
+    return initial;
+  if (gammaInitial >= gammaZero)
+    x0.setZero();
+  else
+    parameters.setEpsilon_rel(parameters_.epsilon_rel() * std::sqrt(gammaZero / gammaInitial));
+
+  const Vector sol = conjugateGradient(system, x0, parameters);
+  return buildVectorValues(sol, keyInfo);
+}
+
+/*****************************************************************************/
+Matrix PCGSolver::solve(const GaussianFactorGraph &gfg, const KeyInfo &keyInfo,
+    const std::map<Key, Vector> &lambda, const Matrix &B) {
+  gttic(PCGSolver_solve);
+  preconditioner_->build(gfg, keyInfo, lambda);
+  GaussianFactorGraphSystem system(gfg, *preconditioner_, keyInfo, lambda,
+      parameters_.blas_kernel_);
+
+  const Matrix X0 = Matrix::Zero(B.rows(), B.cols());
+  if (parameters_.variant() == ConjugateGradientParameters::BLOCK)
+    return preconditionedBlockConjugateGradient(system, B, X0, parameters_);
+
+  Matrix X(B.rows(), B.cols());
+  for (DenseIndex j = 0; j < B.cols(); ++j)
+    X.col(j) = preconditionedBlockConjugateGradient(system, Matrix(B.col(j)),
+        Matrix(X0.col(j)), parameters_);
+  return X;
+}
+
+/*****************************************************************************/
+namespace {
+
+// Factors whose information matrices are computed at once, before being summed into blocks
+const size_t kFactorsPerBatch = 4096;
+
+// Information matrices of factors [begin, end) into informations[k - offset]
+void computeInformation(const GaussianFactorGraph &gfg, size_t begin, size_t end,
+    size_t offset, vector<Matrix> &informations) {
+  for (size_t k = begin; k < end; ++k)
+    if (gfg[k])
+      informations[k - offset] = gfg[k]->information();
+}
+
+#ifdef GTSAM_USE_TBB
+class ComputeInformation {
+  const GaussianFactorGraph &gfg_;
+  const size_t offset_;
+  vector<Matrix> &informations_;
+public:
+  ComputeInformation(const GaussianFactorGraph &gfg, size_t offset,
+      vector<Matrix> &informations) :
+      gfg_(gfg), offset_(offset), informations_(informations) {
+  }
+  void operator()(const tbb::blocked_range<size_t> &r) const {
+    computeInformation(gfg_, r.begin(), r.end(), offset_, informations_);
+  }
+};
+#endif
+
+}
+
+/*****************************************************************************/
+BlockSparseHessian::BlockSparseHessian(const GaussianFactorGraph &gfg,
+    const KeyInfo &keyInfo) :
+    dims_(keyInfo.size()), offsets_(keyInfo.size()), blockDim_(0) {
+  gttic(BlockSparseHessian_assemble);
+  BOOST_FOREACH(const KeyInfo::value_type &item, keyInfo) {
+    dims_[item.second.index()] = item.second.dim();
+    offsets_[item.second.index()] = item.second.colstart();
+  }
+  if (!dims_.empty() && size_t(count(dims_.begin(), dims_.end(), dims_[0])) == dims_.size())
+    blockDim_ = dims_[0];
+
+  // Sum the information of all factors into blocks, sorted by column within each block row.
+  // The information matrices of a batch of factors are computed in parallel, and then summed
+  // in the order of the factors.
+  typedef FastMap<size_t, Matrix> BlockRow;
+  vector<BlockRow> rows(dims_.size());
+  vector<Matrix> informations(min(gfg.size(), kFactorsPerBatch));
+  for (size_t batch = 0; batch < gfg.size(); batch += kFactorsPerBatch) {
+    const size_t batchEnd = min(gfg.size(), batch + kFactorsPerBatch);
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(batch, batchEnd, 64),
+        ComputeInformation(gfg, batch, informations));
+#else
+    computeInformation(gfg, batch, batchEnd, batch, informations);
+#endif
+    for (size_t k = batch; k < batchEnd; ++k) {
+      const GaussianFactor::shared_ptr &factor = gfg[k];
+      if (!factor)
+        continue;
+      const Matrix &information = informations[k - batch];
+      vector<size_t> indices, starts;
+      size_t start = 0;
+      for (GaussianFactor::const_iterator key = factor->begin(); key != factor->end(); ++key) {
+        indices.push_back(keyInfo.at(*key).index());
+        starts.push_back(start);
+        start += factor->getDim(key);
+      }
+      for (size_t i = 0; i < indices.size(); ++i) {
+        for (size_t j = 0; j < indices.size(); ++j) {
+          const size_t ri = indices[i], cj = indices[j];
+          const Matrix block = information.block(starts[i], starts[j], dims_[ri], dims_[cj]);
+          pair<BlockRow::iterator, bool> entry = rows[ri].insert(make_pair(cj, block));
+          if (!entry.second)
+            entry.first->second += block;
+        }
+      }
+    }
+  }
+
+  // Copy the blocks into contiguous storage
+  size_t nrBlocks = 0, nrValues = 0;
+  for (size_t r = 0; r < rows.size(); ++r) {
+    nrBlocks += rows[r].size();
+    BOOST_FOREACH(const BlockRow::value_type &block, rows[r])
+      nrValues += block.second.size();
+  }
+  rowStarts_.reserve(rows.size() + 1);
+  blockColumns_.reserve(nrBlocks);
+  blockStarts_.reserve(nrBlocks);
+  values_.resize(nrValues);
+  size_t valueStart = 0;
+  for (size_t r = 0; r < rows.size(); ++r) {
+    rowStarts_.push_back(blockColumns_.size());
+    BOOST_FOREACH(const BlockRow::value_type &block, rows[r]) {
+      blockColumns_.push_back(block.first);
+      blockStarts_.push_back(valueStart);
+      values_.segment(valueStart, block.second.size()) =
+          Eigen::Map<const Vector>(block.second.data(), block.second.size());
+      valueStart += block.second.size();
+    }
+  }
+  rowStarts_.push_back(blockColumns_.size());
+}
+
+/*****************************************************************************/
+template<int D>
+void BlockSparseHessian::multiplyRowsFixed(size_t begin, size_t end,
+    const Vector &x, Vector &y) const {
+  typedef Eigen::Matrix<double, D, D> Block;
+  typedef Eigen::Matrix<double, D, 1> Segment;
+  for (size_t r = begin; r < end; ++r) {
+    Segment yr = Segment::Zero();
+    for (size_t b = rowStarts_[r]; b < rowStarts_[r + 1]; ++b)
+      yr.noalias() += Eigen::Map<const Block>(values_.data() + blockStarts_[b])
+          * x.segment<D>(offsets_[blockColumns_[b]]);
+    y.segment<D>(offsets_[r]) = yr;
+  }
+}
+
+/*****************************************************************************/
+namespace {
+// yr += A * x for a block whose column dimension is fixed at compile time
+template<int R, int C>
+inline void addBlockFixed(const double *A, const double *x,
+    Eigen::Matrix<double, R, 1> &yr) {
+  yr.noalias() += Eigen::Map<const Eigen::Matrix<double, R, C> >(A)
+      * Eigen::Map<const Eigen::Matrix<double, C, 1> >(x);
+}
+}
+
+/*****************************************************************************/
+template<int R>
+void BlockSparseHessian::multiplyRowFixed(size_t r, const Vector &x,
+    Vector &y) const {
+  // The row dimension is fixed, and each block dispatches on its column dimension
+  typedef Eigen::Matrix<double, R, 1> Segment;
+  Segment yr = Segment::Zero();
+  for (size_t b = rowStarts_[r]; b < rowStarts_[r + 1]; ++b) {
+    const size_t c = blockColumns_[b];
+    const double *A = values_.data() + blockStarts_[b], *xc = x.data() + offsets_[c];
+    switch (dims_[c]) {
+    case 1: addBlockFixed<R, 1>(A, xc, yr); break;
+    case 2: addBlockFixed<R, 2>(A, xc, yr); break;
+    case 3: addBlockFixed<R, 3>(A, xc, yr); break;
+    case 6: addBlockFixed<R, 6>(A, xc, yr); break;
+    case 9: addBlockFixed<R, 9>(A, xc, yr); break;
+    default:
+      yr.noalias() += Eigen::Map<const Eigen::Matrix<double, R, Eigen::Dynamic> >(A, R,
+          dims_[c]) * x.segment(offsets_[c], dims_[c]);
+    }
+  }
+  y.segment<R>(offsets_[r]) = yr;
+}
+
+/*****************************************************************************/
+void BlockSparseHessian::multiplyRows(size_t begin, size_t end, const Vector &x,
+    Vector &y) const {
+  switch (blockDim_) {
+  case 3:
+    multiplyRowsFixed<3>(begin, end, x, y);
+    return;
+  case 6:
+    multiplyRowsFixed<6>(begin, end, x, y);
+    return;
+  case 9:
+    multiplyRowsFixed<9>(begin, end, x, y);
+    return;
+  }
+  // Mixed dimensions: blocks of the common variable dimensions use fixed-size kernels
+  for (size_t r = begin; r < end; ++r) {
+    switch (dims_[r]) {
+    case 1: multiplyRowFixed<1>(r, x, y); continue;
+    case 2: multiplyRowFixed<2>(r, x, y); continue;
+    case 3: multiplyRowFixed<3>(r, x, y); continue;
+    case 6: multiplyRowFixed<6>(r, x, y); continue;
+    case 9: multiplyRowFixed<9>(r, x, y); continue;
+    }
+    SubVector yr = y.segment(offsets_[r], dims_[r]);
+    yr.setZero();
+    for (size_t b = rowStarts_[r]; b < rowStarts_[r + 1]; ++b) {
+      const size_t c = blockColumns_[b];
+      yr.noalias() += Eigen::Map<const Matrix>(values_.data() + blockStarts_[b], dims_[r],
+          dims_[c]) * x.segment(offsets_[c], dims_[c]);
+    }
+  }
+}
+
+/*****************************************************************************/
+#ifdef GTSAM_USE_TBB
+struct BlockSparseHessian::MultiplyRows {
+  const BlockSparseHessian &hessian_;
+  const Vector &x_;
+  Vector &y_;
+  MultiplyRows(const BlockSparseHessian &hessian, const Vector &x, Vector &y) :
+      hessian_(hessian), x_(x), y_(y) {
+  }
+  void operator()(const tbb::blocked_range<size_t> &rows) const {
+    hessian_.multiplyRows(rows.begin(), rows.end(), x_, y_);
+  }
+};
+#endif
+
+/*****************************************************************************/
+void BlockSparseHessian::multiply(const Vector &x, Vector &y) const {
+  // Block rows are written independently, so they can be computed in parallel
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, dims_.size(), 64),
+      MultiplyRows(*this, x, y));
+#else
+  multiplyRows(0, dims_.size(), x, y);
+#endif
+}
+
+/*****************************************************************************/
+Matrix BlockSparseHessian::matrix() const {
+  const size_t n = offsets_.empty() ? 0 : offsets_.back() + dims_.back();
+  Matrix result = Matrix::Zero(n, n);
+  for (size_t r = 0; r < dims_.size(); ++r) {
+    for (size_t b = rowStarts_[r]; b < rowStarts_[r + 1]; ++b) {
+      const size_t c = blockColumns_[b];
+      result.block(offsets_[r], offsets_[c], dims_[r], dims_[c]) = Eigen::Map<const Matrix>(
+          values_.data() + blockStarts_[b], dims_[r], dims_[c]);
+    }
+  }
+  return result;
+}
+
 /*****************************************************************************/
 GaussianFactorGraphSystem::GaussianFactorGraphSystem(
     const GaussianFactorGraph &gfg, const Preconditioner &preconditioner,
-    const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda) :
+    const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda,
+    ConjugateGradientParameters::BLASKernel kernel) :
     gfg_(gfg), preconditioner_(preconditioner), keyInfo_(keyInfo), lambda_(
         lambda) {
+  if (kernel == ConjugateGradientParameters::BSR)
+    hessian_ = boost::make_shared<BlockSparseHessian>(gfg, keyInfo);
+  else
+    coloring_ = FactorColoring(gfg);
 }
 
 /*****************************************************************************/
@@ -86,19 +381,34 @@ void GaussianFactorGraphSystem::residual(const Vector &x, Vector &r) const {
 void GaussianFactorGraphSystem::multiply(const Vector &x, Vector& AtAx) const {
   /* implement A^T*(A*x), assume x and AtAx are pre-allocated */
 
+  if (hessian_) {
+    hessian_->multiply(x, AtAx);
+    return;
+  }
+
   // Build a VectorValues for Vector x
   VectorValues vvX = buildVectorValues(x, keyInfo_);
 
-  // VectorValues form of A'Ax for multiplyHessianAdd
-  VectorValues vvAtAx;
+  // VectorValues form of A'Ax for multiplyHessianAdd, with all variables for the coloring
+  VectorValues vvAtAx = VectorValues::Zero(vvX);
 
   // vvAtAx += 1.0 * A'Ax for each factor
-  gfg_.multiplyHessianAdd(1.0, vvX, vvAtAx);
+  gfg_.multiplyHessianAdd(1.0, vvX, vvAtAx, coloring_);
 
   // Make the result as Vector form
   AtAx = vvAtAx.vector(keyInfo_.ordering());
 }
 
+/*****************************************************************************/
+void GaussianFactorGraphSystem::multiply(const Matrix &X, Matrix& AtAX) const {
+  Vector x, y = Vector::Zero(X.rows());
+  for (DenseIndex j = 0; j < X.cols(); ++j) {
+    x = X.col(j);
+    multiply(x, y);
+    AtAX.col(j) = y;
+  }
+}
+
 /*****************************************************************************/
 void GaussianFactorGraphSystem::getb(Vector &b) const {
   /* compute rhs, assume b pre-allocated */
@@ -126,6 +436,25 @@ void GaussianFactorGraphSystem::rightPrecondition(const Vector &x,
   preconditioner_.transposeSolve(x, y);
 }
 
+/**********************************************************************************/
+void GaussianFactorGraphSystem::precondition(const Vector &x,
+    Vector &y) const {
+  // For a preconditioner M = L*L^T
+  // Calculate y = M^{-1} x = L^{-T} L^{-1} x
+  preconditioner_.fullSolve(x, y);
+}
+
+/**********************************************************************************/
+void GaussianFactorGraphSystem::precondition(const Matrix &X,
+    Matrix &Y) const {
+  Vector x, y = Vector::Zero(X.rows());
+  for (DenseIndex j = 0; j < X.cols(); ++j) {
+    x = X.col(j);
+    preconditioner_.fullSolve(x, y);
+    Y.col(j) = y;
+  }
+}
+
 /**********************************************************************************/
 VectorValues buildVectorValues(const Vector &v, const Ordering &ordering,
     const map<Key, size_t> & dimensions) {
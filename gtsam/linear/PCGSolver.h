@@ -20,7 +20,10 @@
 #pragma once
 
 #include <gtsam/linear/ConjugateGradientSolver.h>
+#include <gtsam/inference/FactorColoring.h>
+#include <gtsam/base/Matrix.h>
 #include <string>
+#include <vector>
 
 namespace gtsam {
 
@@ -76,6 +79,105 @@ public:
       const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda,
       const VectorValues &initial);
 
+  /**
+   * Like optimize, starting from \c initial, e.g. the solution of a similar system, but with the
+   * tolerance epsilon_rel() relative to the residual at zero instead of the residual at \c initial,
+   * so that a good warm start saves iterations instead of asking for a more accurate solution.
+   * A warm start that is worse than zero is not used.
+   */
+  VectorValues optimizeWarmStarted(const GaussianFactorGraph &gfg,
+      const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda,
+      const VectorValues &initial);
+
+  /**
+   * Solve the normal equations of gfg for several right-hand sides at once, instead of for the
+   * right-hand side of the graph: the columns of B and of the result are in the order of keyInfo.
+   * With the BLOCK variant all columns are solved together by block PCG, otherwise each column is
+   * solved separately by standard PCG.
+   */
+  Matrix solve(const GaussianFactorGraph &gfg, const KeyInfo &keyInfo,
+      const std::map<Key, Vector> &lambda, const Matrix &B);
+
+};
+
+/**
+ * The Hessian A'*A of a Gaussian factor graph, assembled once into block compressed sparse row
+ * (BSR) storage with one block row and column per variable, in the order of a KeyInfo.  The
+ * product with a vector is then a sweep over contiguous blocks, parallel over block rows when TBB
+ * is enabled.  When all variables have dimension 3, 6 or 9 a single fixed-size kernel is used.
+ * With mixed dimensions, e.g. poses, points and biases, each block of dimensions in {1, 2, 3, 6,
+ * 9} still uses the fixed-size kernel for its row and column dimensions.
+ */
+class GTSAM_EXPORT BlockSparseHessian {
+public:
+
+  /// Assemble the Hessian of the factors in gfg, for the variables in keyInfo
+  BlockSparseHessian(const GaussianFactorGraph &gfg, const KeyInfo &keyInfo);
+
+  /// y = A'*A*x, assumes y is pre-allocated
+  void multiply(const Vector &x, Vector &y) const;
+
+  /// Number of non-zero blocks, counting both triangles
+  size_t nrBlocks() const {
+    return blockColumns_.size();
+  }
+
+  /// The common dimension of all variables, or 0 if they differ
+  size_t blockDim() const {
+    return blockDim_;
+  }
+
+  /// Number of block rows, one per variable
+  size_t nrBlockRows() const {
+    return dims_.size();
+  }
+
+  /// Dimension of each block row/column
+  const std::vector<size_t>& dims() const {
+    return dims_;
+  }
+
+  /// Scalar offset of each block row/column
+  const std::vector<size_t>& offsets() const {
+    return offsets_;
+  }
+
+  /// First block of each block row, followed by the number of blocks
+  const std::vector<size_t>& rowStarts() const {
+    return rowStarts_;
+  }
+
+  /// Block column of each block, increasing within each block row
+  const std::vector<size_t>& blockColumns() const {
+    return blockColumns_;
+  }
+
+  /// Block b, which is in block row r
+  Eigen::Map<const Matrix> block(size_t r, size_t b) const {
+    return Eigen::Map<const Matrix>(values_.data() + blockStarts_[b], dims_[r],
+        dims_[blockColumns_[b]]);
+  }
+
+  /// The Hessian as a dense matrix, for testing
+  Matrix matrix() const;
+
+private:
+
+  std::vector<size_t> dims_; ///< dimension of each block row/column
+  std::vector<size_t> offsets_; ///< scalar offset of each block row/column
+  std::vector<size_t> rowStarts_; ///< first block of each block row, and the number of blocks
+  std::vector<size_t> blockColumns_; ///< block column of each block
+  std::vector<size_t> blockStarts_; ///< start of each column-major block in values_
+  Vector values_; ///< block entries
+  size_t blockDim_;
+
+  void multiplyRows(size_t begin, size_t end, const Vector &x, Vector &y) const;
+  template<int D>
+  void multiplyRowsFixed(size_t begin, size_t end, const Vector &x, Vector &y) const;
+  template<int R>
+  void multiplyRowFixed(size_t r, const Vector &x, Vector &y) const;
+
+  struct MultiplyRows;
 };
 
 /**
@@ -84,18 +186,29 @@ public:
 class GTSAM_EXPORT GaussianFactorGraphSystem {
 public:
 
+  /**
+   * Create the system for a graph.  With the BSR kernel, the Hessian is assembled into a
+   * BlockSparseHessian here, and used in multiply instead of the factors.  Otherwise the
+   * factors are colored here, so that multiply can process them in parallel.
+   */
   GaussianFactorGraphSystem(const GaussianFactorGraph &gfg,
       const Preconditioner &preconditioner, const KeyInfo &info,
-      const std::map<Key, Vector> &lambda);
+      const std::map<Key, Vector> &lambda,
+      ConjugateGradientParameters::BLASKernel kernel = ConjugateGradientParameters::GTSAM);
 
   const GaussianFactorGraph &gfg_;
   const Preconditioner &preconditioner_;
   const KeyInfo &keyInfo_;
   const std::map<Key, Vector> &lambda_;
+  boost::shared_ptr<BlockSparseHessian> hessian_; ///< Assembled Hessian, if the BSR kernel is used
+  FactorColoring coloring_; ///< Coloring of the factors, for multiply without the BSR kernel
 
   void residual(const Vector &x, Vector &r) const;
   void multiply(const Vector &x, Vector& y) const;
+  void multiply(const Matrix &X, Matrix& Y) const;  ///< column by column, for block PCG
   void leftPrecondition(const Vector &x, Vector &y) const;
+  void precondition(const Vector &x, Vector &y) const;
+  void precondition(const Matrix &X, Matrix &Y) const;  ///< column by column, for block PCG
   void rightPrecondition(const Vector &x, Vector &y) const;
   inline void scal(const double alpha, Vector &x) const {
     x *= alpha;
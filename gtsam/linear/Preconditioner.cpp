@@ -12,10 +12,22 @@
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/SubgraphPreconditioner.h>
 #include <gtsam/linear/NoiseModel.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+#include <boost/foreach.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/map.hpp>
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <stdexcept>
 #include <vector>
 
 using namespace std;
@@ -74,6 +86,13 @@ std::string PreconditionerParameters::verbosityTranslator(PreconditionerParamete
   else return "UNKNOWN";
 }
 
+/***************************************************************************************/
+void Preconditioner::fullSolve(const Vector& y, Vector &x) const {
+  Vector z(y.size());
+  solve(y, z);
+  transposeSolve(z, x);
+}
+
 /***************************************************************************************/
 BlockJacobiPreconditioner::BlockJacobiPreconditioner()
   : Base(), buffer_(0), bufferSize_(0), nnz_(0) {}
@@ -82,71 +101,114 @@ BlockJacobiPreconditioner::BlockJacobiPreconditioner()
 BlockJacobiPreconditioner::~BlockJacobiPreconditioner() { clean(); }
 
 /***************************************************************************************/
-void BlockJacobiPreconditioner::solve(const Vector& y, Vector &x) const {
+namespace {
+
+/* Factorize a block diagonal D = L*L' into dst, column-major, with a fixed-size Cholesky
+ * for dimension D, or a dynamic one if D is Eigen::Dynamic */
+template<int D>
+void choleskyBlock(const Matrix& block, double* dst) {
+  typedef Eigen::Matrix<double, D, D> MatrixD;
+  const DenseIndex d = block.rows();
+  Eigen::Map<MatrixD>(dst, d, d) = Eigen::LLT<MatrixD>(block).matrixL();
+}
 
-  const size_t n = dims_.size();
-  double *ptr = buffer_, *dst = x.data();
+/* Solve L*x = b, or L'*x = b, in place for a factorized block of dimension d */
+template<int D>
+void solveBlock(DenseIndex d, const double* L, double* x, bool transpose) {
+  const Eigen::Map<const Eigen::Matrix<double, D, D> > R(L, d, d);
+  Eigen::Map<Eigen::Matrix<double, D, 1> > b(x, d);
+  if (transpose)
+    R.transpose().template triangularView<Eigen::Upper>().solveInPlace(b);
+  else
+    R.template triangularView<Eigen::Lower>().solveInPlace(b);
+}
 
-  std::copy(y.data(), y.data() + y.rows(), x.data());
+/* Dispatch on the common dimensions of poses, camera and IMU states to fixed-size code */
+void choleskyBlock(const Matrix& block, double* dst) {
+  switch (block.rows()) {
+  case 3: choleskyBlock<3>(block, dst); break;
+  case 6: choleskyBlock<6>(block, dst); break;
+  case 9: choleskyBlock<9>(block, dst); break;
+  case 15: choleskyBlock<15>(block, dst); break;
+  default: choleskyBlock<Eigen::Dynamic>(block, dst);
+  }
+}
 
-  for ( size_t i = 0 ; i < n ; ++i ) {
-    const size_t d = dims_[i];
-    const size_t sz = d*d;
+void solveBlock(size_t d, const double* L, double* x, bool transpose) {
+  switch (d) {
+  case 3: solveBlock<3>(d, L, x, transpose); break;
+  case 6: solveBlock<6>(d, L, x, transpose); break;
+  case 9: solveBlock<9>(d, L, x, transpose); break;
+  case 15: solveBlock<15>(d, L, x, transpose); break;
+  default: solveBlock<Eigen::Dynamic>(d, L, x, transpose);
+  }
+}
 
-    const Eigen::Map<const Eigen::MatrixXd> R(ptr, d, d);
-    Eigen::Map<Eigen::VectorXd> b(dst, d, 1);
-    R.triangularView<Eigen::Lower>().solveInPlace(b);
+/* Solve all blocks of the block diagonal in place */
+void solveBlocks(const std::vector<size_t>& dims, const double* buffer, double* x,
+    bool transpose) {
+  for (size_t i = 0; i < dims.size(); ++i) {
+    const size_t d = dims[i];
+    solveBlock(d, buffer, x, transpose);
+    buffer += d * d;
+    x += d;
+  }
+}
 
-    dst += d;
-    ptr += sz;
+#ifdef GTSAM_USE_TBB
+class _FactorizeBlocks {
+  const std::vector<const Matrix*>& blocks_;
+  const std::vector<size_t>& offsets_;
+  double* buffer_;
+public:
+  _FactorizeBlocks(const std::vector<const Matrix*>& blocks,
+      const std::vector<size_t>& offsets, double* buffer) :
+      blocks_(blocks), offsets_(offsets), buffer_(buffer) {
   }
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    for (size_t i = blocked_range.begin(); i != blocked_range.end(); ++i)
+      choleskyBlock(*blocks_[i], buffer_ + offsets_[i]);
+  }
+};
+#endif
+
 }
 
 /***************************************************************************************/
-void BlockJacobiPreconditioner::transposeSolve(const Vector& y, Vector& x) const {
-  const size_t n = dims_.size();
-  double *ptr = buffer_, *dst = x.data();
-
+void BlockJacobiPreconditioner::solve(const Vector& y, Vector &x) const {
   std::copy(y.data(), y.data() + y.rows(), x.data());
+  solveBlocks(dims_, buffer_, x.data(), false);
+}
 
-  for ( size_t i = 0 ; i < n ; ++i ) {
-    const size_t d = dims_[i];
-    const size_t sz = d*d;
-
-    const Eigen::Map<const Eigen::MatrixXd> R(ptr, d, d);
-    Eigen::Map<Eigen::VectorXd> b(dst, d, 1);
-    R.transpose().triangularView<Eigen::Upper>().solveInPlace(b);
-
-    dst += d;
-    ptr += sz;
-  }
+/***************************************************************************************/
+void BlockJacobiPreconditioner::transposeSolve(const Vector& y, Vector& x) const {
+  std::copy(y.data(), y.data() + y.rows(), x.data());
+  solveBlocks(dims_, buffer_, x.data(), true);
 }
 
 /***************************************************************************************/
 void BlockJacobiPreconditioner::build(
   const GaussianFactorGraph &gfg, const KeyInfo &keyInfo, const std::map<Key,Vector> &lambda)
 {
+  gttic(BlockJacobiPreconditioner_build);
   // n is the number of keys
   const size_t n = keyInfo.size();
   // dims_ is a vector that contains the dimension of keys
   dims_ = keyInfo.colSpec();
 
-  /* prepare the buffer of block diagonals */
-  std::vector<Matrix> blocks; blocks.reserve(n);
-
-  /* allocate memory for the factorization of block diagonals */
+  /* offsets of the factorizations of block diagonals in the buffer */
+  std::vector<size_t> offsets(n);
   size_t nnz = 0;
   for ( size_t i = 0 ; i < n ; ++i ) {
-    const size_t dim = dims_[i];
-    // blocks.push_back(Matrix::Zero(dim, dim));
-    // nnz += (((dim)*(dim+1)) >> 1); // d*(d+1) / 2  ;
-    nnz += dim*dim;
+    offsets[i] = nnz;
+    nnz += dims_[i]*dims_[i];
   }
 
   /* getting the block diagonals over the factors */
-  std::map<Key, Matrix> hessianMap =gfg.hessianBlockDiagonal();
-  BOOST_FOREACH ( const Matrix hessian, hessianMap | boost::adaptors::map_values)
-    blocks.push_back(hessian);
+  const std::map<Key, Matrix> hessianMap = gfg.hessianBlockDiagonal();
+  std::vector<const Matrix*> blocks; blocks.reserve(n);
+  BOOST_FOREACH ( const Matrix& hessian, hessianMap | boost::adaptors::map_values)
+    blocks.push_back(&hessian);
 
   /* if necessary, allocating the memory for cacheing the factorization results */
   if ( nnz > bufferSize_ ) {
@@ -156,20 +218,14 @@ void BlockJacobiPreconditioner::build(
   }
   nnz_ = nnz;
 
-  /* factorizing the blocks respectively */
-  double *ptr = buffer_;
-  for ( size_t i = 0 ; i < n ; ++i ) {
-    /* use eigen to decompose Di */
-    /* It is same as L = chol(M,'lower') in MATLAB where M is full preconditioner */
-    const Matrix L = blocks[i].llt().matrixL();
-
-    /* store the data in the buffer */
-    size_t sz = dims_[i]*dims_[i] ;
-    std::copy(L.data(), L.data() + sz, ptr);
-
-    /* advance the pointer */
-    ptr += sz;
-  }
+  /* factorizing the blocks, independently of each other, into the buffer */
+  /* It is same as L = chol(M,'lower') in MATLAB where M is full preconditioner */
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n, 64), _FactorizeBlocks(blocks, offsets, buffer_));
+#else
+  for ( size_t i = 0 ; i < n ; ++i )
+    choleskyBlock(*blocks[i], buffer_ + offsets[i]);
+#endif
 }
 
 /*****************************************************************************/
@@ -182,6 +238,313 @@ void BlockJacobiPreconditioner::clean() {
   }
 }
 
+/***************************************************************************************/
+void BlockIncompleteCholeskyPreconditionerParameters::print(ostream &os) const {
+  Base::print(os);
+  os << "fill:          " << fill_ << endl;
+}
+
+/***************************************************************************************/
+BlockIncompleteCholeskyPreconditioner::BlockIncompleteCholeskyPreconditioner(
+    const BlockIncompleteCholeskyPreconditionerParameters &p)
+  : Base(), parameters_(p) {}
+
+/***************************************************************************************/
+void BlockIncompleteCholeskyPreconditioner::solve(const Vector& y, Vector &x) const {
+  /* forward substitution, block row by block row */
+  x = y;
+  for ( size_t i = 0 ; i < dims_.size() ; ++i ) {
+    SubVector xi = x.segment(offsets_[i], dims_[i]);
+    for ( size_t b = rowStarts_[i] ; b < rowStarts_[i+1] ; ++b ) {
+      const size_t j = columns_[b];
+      xi -= blocks_[b] * x.segment(offsets_[j], dims_[j]);
+    }
+    diagonal_[i].triangularView<Eigen::Lower>().solveInPlace(xi);
+  }
+}
+
+/***************************************************************************************/
+void BlockIncompleteCholeskyPreconditioner::transposeSolve(const Vector& y, Vector& x) const {
+  /* backward substitution with the transposed blocks, in reverse order */
+  x = y;
+  for ( size_t i = dims_.size() ; i-- > 0 ; ) {
+    SubVector xi = x.segment(offsets_[i], dims_[i]);
+    diagonal_[i].transpose().triangularView<Eigen::Upper>().solveInPlace(xi);
+    for ( size_t b = rowStarts_[i] ; b < rowStarts_[i+1] ; ++b ) {
+      const size_t j = columns_[b];
+      x.segment(offsets_[j], dims_[j]) -= blocks_[b].transpose() * xi;
+    }
+  }
+}
+
+/***************************************************************************************/
+void BlockIncompleteCholeskyPreconditioner::build(
+  const GaussianFactorGraph &gfg, const KeyInfo &keyInfo, const std::map<Key,Vector> &lambda)
+{
+  const BlockSparseHessian hessian(gfg, keyInfo);
+  const size_t n = hessian.nrBlockRows();
+  dims_ = hessian.dims();
+  offsets_ = hessian.offsets();
+  diagonal_.assign(n, Matrix());
+  rowStarts_.clear(); rowStarts_.reserve(n+1);
+  columns_.clear();
+  blocks_.clear();
+
+  /* the blocks of L in each block column, with their block row and level of fill */
+  vector<vector<size_t> > columnBlocks(n);
+  vector<size_t> blockRows, blockLevels;
+
+  /* L is computed one block row at a time: L_ij = (A_ij - sum_{k<j} L_ik L_jk^T) L_jj^{-T} */
+  for ( size_t i = 0 ; i < n ; ++i ) {
+
+    /* symbolic phase: the level of fill of every block left of the diagonal */
+    const vector<size_t> &rowStarts = hessian.rowStarts(), &blockColumns = hessian.blockColumns();
+    typedef std::map<size_t, size_t> Levels;
+    Levels levels;
+    for ( size_t b = rowStarts[i] ; b < rowStarts[i+1] && blockColumns[b] < i ; ++b )
+      levels[blockColumns[b]] = 0;
+    for ( Levels::iterator entry = levels.begin() ; entry != levels.end() ; ++entry ) {
+      if ( entry->second > parameters_.fill_ ) continue;
+      BOOST_FOREACH ( size_t b, columnBlocks[entry->first] ) {
+        const size_t level = entry->second + blockLevels[b] + 1;
+        pair<Levels::iterator, bool> fill = levels.insert(make_pair(blockRows[b], level));
+        if ( !fill.second ) fill.first->second = std::min(fill.first->second, level);
+      }
+    }
+
+    /* numeric phase, restricted to the blocks up to the level of fill */
+    typedef std::map<size_t, Matrix> Row;
+    Row row;
+    BOOST_FOREACH ( const Levels::value_type &entry, levels )
+      if ( entry.second <= parameters_.fill_ )
+        row.insert(make_pair(entry.first, Matrix::Zero(dims_[i], dims_[entry.first])));
+    Matrix original;
+    for ( size_t b = rowStarts[i] ; b < rowStarts[i+1] ; ++b ) {
+      if ( blockColumns[b] < i ) row[blockColumns[b]] = hessian.block(i, b);
+      else if ( blockColumns[b] == i ) original = hessian.block(i, b);
+    }
+    Matrix diagonal = original;
+
+    rowStarts_.push_back(columns_.size());
+    BOOST_FOREACH ( const Row::value_type &entry, row ) {
+      const size_t j = entry.first;
+      const Matrix Lij = diagonal_[j].triangularView<Eigen::Lower>().solve(
+          entry.second.transpose()).transpose();
+      BOOST_FOREACH ( size_t b, columnBlocks[j] ) {
+        Row::iterator target = row.find(blockRows[b]);
+        if ( target != row.end() ) target->second.noalias() -= Lij * blocks_[b].transpose();
+      }
+      diagonal.noalias() -= Lij * Lij.transpose();
+      columnBlocks[j].push_back(blocks_.size());
+      blockRows.push_back(i);
+      blockLevels.push_back(levels[j]);
+      columns_.push_back(j);
+      blocks_.push_back(Lij);
+    }
+
+    /* fall back to the original diagonal block if the updated one is not positive definite */
+    Eigen::LLT<Matrix> llt(diagonal);
+    if ( llt.info() != Eigen::Success ) {
+      llt.compute(original);
+      if ( llt.info() != Eigen::Success )
+        throw runtime_error("BlockIncompleteCholeskyPreconditioner: the Hessian is not positive definite");
+    }
+    diagonal_[i] = llt.matrixL();
+  }
+  rowStarts_.push_back(columns_.size());
+}
+
+/***************************************************************************************/
+void AlgebraicMultigridPreconditionerParameters::print(ostream &os) const {
+  Base::print(os);
+  os << "maxLevels:     " << maxLevels_ << endl
+     << "coarsestDim:   " << coarsestDim_ << endl
+     << "sweeps:        " << sweeps_ << endl
+     << "threshold:     " << strengthThreshold_ << endl;
+}
+
+/***************************************************************************************/
+AlgebraicMultigridPreconditioner::AlgebraicMultigridPreconditioner(
+    const AlgebraicMultigridPreconditionerParameters &p)
+  : Base(), parameters_(p) {}
+
+/***************************************************************************************/
+void AlgebraicMultigridPreconditioner::solve(const Vector& y, Vector &x) const {
+  throw logic_error("AlgebraicMultigridPreconditioner::solve: not available in split form, use fullSolve");
+}
+
+/***************************************************************************************/
+void AlgebraicMultigridPreconditioner::transposeSolve(const Vector& y, Vector& x) const {
+  throw logic_error("AlgebraicMultigridPreconditioner::transposeSolve: not available in split form, use fullSolve");
+}
+
+/***************************************************************************************/
+void AlgebraicMultigridPreconditioner::fullSolve(const Vector& y, Vector &x) const {
+  vcycle(0, y, x);
+}
+
+/***************************************************************************************/
+/* one Gauss-Seidel sweep on a symmetric matrix, whose columns are also its rows */
+static void gaussSeidel(const AlgebraicMultigridPreconditioner::Sparse &A,
+    const Vector &invDiagonal, const Vector &b, Vector &x, bool forward) {
+  const DenseIndex n = A.cols();
+  for ( DenseIndex k = 0 ; k < n ; ++k ) {
+    const DenseIndex i = forward ? k : n - 1 - k;
+    double r = b(i);
+    for ( AlgebraicMultigridPreconditioner::Sparse::InnerIterator it(A, i) ; it ; ++it )
+      r -= it.value() * x(it.row());
+    x(i) += invDiagonal(i) * r;
+  }
+}
+
+/***************************************************************************************/
+void AlgebraicMultigridPreconditioner::vcycle(size_t level, const Vector& b, Vector& x) const {
+  if ( level + 1 == A_.size() ) {
+    x = coarsest_.solve(b);
+    return;
+  }
+
+  /* forward sweeps before and backward sweeps after the coarse correction keep M symmetric */
+  const Sparse &A = A_[level], &P = P_[level];
+  x = Vector::Zero(b.size());
+  for ( size_t s = 0 ; s < parameters_.sweeps_ ; ++s )
+    gaussSeidel(A, invDiagonal_[level], b, x, true);
+  const Vector r = b - A * x;
+  Vector xc;
+  vcycle(level + 1, P.transpose() * r, xc);
+  x += P * xc;
+  for ( size_t s = 0 ; s < parameters_.sweeps_ ; ++s )
+    gaussSeidel(A, invDiagonal_[level], b, x, false);
+}
+
+/***************************************************************************************/
+void AlgebraicMultigridPreconditioner::build(
+  const GaussianFactorGraph &gfg, const KeyInfo &keyInfo, const std::map<Key,Vector> &lambda)
+{
+  A_.clear(); P_.clear(); invDiagonal_.clear();
+
+  /* the finest level is the Hessian, with one node per variable */
+  const BlockSparseHessian hessian(gfg, keyInfo);
+  vector<Eigen::Triplet<double> > triplets;
+  for ( size_t r = 0 ; r < hessian.nrBlockRows() ; ++r ) {
+    for ( size_t b = hessian.rowStarts()[r] ; b < hessian.rowStarts()[r+1] ; ++b ) {
+      const Eigen::Map<const Matrix> block = hessian.block(r, b);
+      const size_t rowStart = hessian.offsets()[r],
+                   colStart = hessian.offsets()[hessian.blockColumns()[b]];
+      for ( DenseIndex j = 0 ; j < block.cols() ; ++j )
+        for ( DenseIndex i = 0 ; i < block.rows() ; ++i )
+          if ( block(i, j) != 0.0 ) triplets.push_back(Eigen::Triplet<double>(rowStart + i, colStart + j, block(i, j)));
+    }
+  }
+  const size_t n = keyInfo.numCols();
+  Sparse A(n, n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  vector<size_t> dims = hessian.dims();
+
+  const size_t none = numeric_limits<size_t>::max();
+  const double threshold = parameters_.strengthThreshold_ * parameters_.strengthThreshold_;
+  while ( true ) {
+    const Vector invDiagonal = A.diagonal().cwiseInverse();
+    A_.push_back(A);
+    invDiagonal_.push_back(invDiagonal);
+    const size_t nrNodes = dims.size();
+    if ( A_.size() >= parameters_.maxLevels_ || size_t(A.rows()) <= parameters_.coarsestDim_ )
+      break;
+
+    /* the node of each unknown, and the squared norm of each block between nodes */
+    vector<size_t> nodeOf;
+    nodeOf.reserve(A.rows());
+    for ( size_t i = 0 ; i < nrNodes ; ++i ) nodeOf.insert(nodeOf.end(), dims[i], i);
+    typedef FastMap<size_t, double> Norms;
+    vector<Norms> norms(nrNodes);
+    for ( DenseIndex k = 0 ; k < A.outerSize() ; ++k )
+      for ( Sparse::InnerIterator it(A, k) ; it ; ++it )
+        norms[nodeOf[it.row()]][nodeOf[it.col()]] += it.value() * it.value();
+
+    /* nodes i and j are strongly connected if |A_ij|^2 > threshold^2 |A_ii| |A_jj| */
+    vector<double> diagonalNorms(nrNodes);
+    for ( size_t i = 0 ; i < nrNodes ; ++i ) diagonalNorms[i] = norms[i][i];
+    vector<vector<size_t> > strong(nrNodes);
+    for ( size_t i = 0 ; i < nrNodes ; ++i ) {
+      BOOST_FOREACH ( const Norms::value_type &entry, norms[i] ) {
+        const size_t j = entry.first;
+        if ( j != i && entry.second > threshold * std::sqrt(diagonalNorms[i] * diagonalNorms[j]) )
+          strong[i].push_back(j);
+      }
+    }
+
+    /* aggregation: nodes whose strong neighbors are all free start an aggregate with them, the
+     * remaining nodes join a neighboring aggregate, or else start a new one */
+    vector<size_t> aggregate(nrNodes, none);
+    size_t nrAggregates = 0;
+    for ( size_t i = 0 ; i < nrNodes ; ++i ) {
+      bool free = aggregate[i] == none;
+      BOOST_FOREACH ( size_t j, strong[i] ) free = free && aggregate[j] == none;
+      if ( !free ) continue;
+      aggregate[i] = nrAggregates;
+      BOOST_FOREACH ( size_t j, strong[i] ) aggregate[j] = nrAggregates;
+      ++nrAggregates;
+    }
+    const vector<size_t> initial = aggregate;
+    for ( size_t i = 0 ; i < nrNodes ; ++i ) {
+      if ( aggregate[i] != none ) continue;
+      BOOST_FOREACH ( size_t j, strong[i] ) {
+        if ( initial[j] != none ) { aggregate[i] = initial[j]; break; }
+      }
+    }
+    for ( size_t i = 0 ; i < nrNodes ; ++i ) {
+      if ( aggregate[i] != none ) continue;
+      aggregate[i] = nrAggregates;
+      BOOST_FOREACH ( size_t j, strong[i] ) if ( aggregate[j] == none ) aggregate[j] = nrAggregates;
+      ++nrAggregates;
+    }
+    if ( nrAggregates == nrNodes ) break; /* no strong connections left to coarsen */
+
+    /* tentative prolongation: every dimension of a node maps to the same dimension of its aggregate */
+    vector<size_t> coarseDims(nrAggregates, 0), coarseOffsets(nrAggregates, 0);
+    for ( size_t i = 0 ; i < nrNodes ; ++i )
+      coarseDims[aggregate[i]] = std::max(coarseDims[aggregate[i]], dims[i]);
+    for ( size_t a = 1 ; a < nrAggregates ; ++a )
+      coarseOffsets[a] = coarseOffsets[a-1] + coarseDims[a-1];
+    const size_t nc = coarseOffsets.back() + coarseDims.back();
+    triplets.clear();
+    for ( DenseIndex k = 0, i = 0 ; i < DenseIndex(nrNodes) ; ++i )
+      for ( size_t c = 0 ; c < dims[i] ; ++c, ++k )
+        triplets.push_back(Eigen::Triplet<double>(k, coarseOffsets[aggregate[i]] + c, 1.0));
+    Sparse T(A.rows(), nc);
+    T.setFromTriplets(triplets.begin(), triplets.end());
+
+    /* smoothed prolongation P = (I - omega D^{-1} A) T, with omega = 4/3 / rho(D^{-1} A), where
+     * the spectral radius is bounded by the largest row sum of |D^{-1} A| */
+    double rho = 0.0;
+    for ( DenseIndex k = 0 ; k < A.outerSize() ; ++k ) {
+      double sum = 0.0;
+      for ( Sparse::InnerIterator it(A, k) ; it ; ++it ) sum += std::abs(it.value());
+      rho = std::max(rho, sum * std::abs(invDiagonal(k)));
+    }
+    Sparse AT = A * T;
+    for ( DenseIndex k = 0 ; k < AT.outerSize() ; ++k )
+      for ( Sparse::InnerIterator it(AT, k) ; it ; ++it )
+        it.valueRef() *= (4.0 / 3.0) / rho * invDiagonal(it.row());
+    const Sparse P = T - AT;
+
+    /* Galerkin coarse operator */
+    const Sparse Pt = P.transpose();
+    const Sparse AP = A * P;
+    A = Pt * AP;
+    P_.push_back(P);
+    dims = coarseDims;
+  }
+
+  coarsest_.compute(A_.back().toDense());
+
+  if ( parameters_.verbosity() >= PreconditionerParameters::COMPLEXITY ) {
+    cout << "AlgebraicMultigridPreconditioner: levels =";
+    BOOST_FOREACH ( const Sparse &level, A_ ) cout << " " << level.rows();
+    cout << endl;
+  }
+}
+
 /***************************************************************************************/
 boost::shared_ptr<Preconditioner> createPreconditioner(const boost::shared_ptr<PreconditionerParameters> parameters) {
 
@@ -191,6 +554,12 @@ boost::shared_ptr<Preconditioner> createPreconditioner(const boost::shared_ptr<P
   else if ( BlockJacobiPreconditionerParameters::shared_ptr blockJacobi = boost::dynamic_pointer_cast<BlockJacobiPreconditionerParameters>(parameters) ) {
     return boost::make_shared<BlockJacobiPreconditioner>();
   }
+  else if ( BlockIncompleteCholeskyPreconditionerParameters::shared_ptr incompleteCholesky = boost::dynamic_pointer_cast<BlockIncompleteCholeskyPreconditionerParameters>(parameters) ) {
+    return boost::make_shared<BlockIncompleteCholeskyPreconditioner>(*incompleteCholesky);
+  }
+  else if ( AlgebraicMultigridPreconditionerParameters::shared_ptr multigrid = boost::dynamic_pointer_cast<AlgebraicMultigridPreconditionerParameters>(parameters) ) {
+    return boost::make_shared<AlgebraicMultigridPreconditioner>(*multigrid);
+  }
   else if ( SubgraphPreconditionerParameters::shared_ptr subgraph = boost::dynamic_pointer_cast<SubgraphPreconditionerParameters>(parameters) ) {
     return boost::make_shared<SubgraphPreconditioner>(*subgraph);
   }
@@ -8,11 +8,14 @@
 
 #pragma once
 
+#include <gtsam/base/Matrix.h>
 #include <gtsam/base/Vector.h>
+#include <Eigen/SparseCore>
 #include <boost/shared_ptr.hpp>
 #include <iosfwd>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace gtsam {
 
@@ -80,8 +83,9 @@ public:
   virtual void transposeSolve(const Vector& y, Vector& x) const = 0;
 //  virtual void transposeSolve(const VectorValues& y, VectorValues &x) const = 0;
 
-//  /* implement x = L^{-1} L^{-T} y */
-//  virtual void fullSolve(const Vector& y, Vector &x) const = 0;
+  /* implement x = L^{-T} L^{-1} y = M^{-1} y, which is all that preconditioners that are not
+   * given in split form, like multigrid, need to provide */
+  virtual void fullSolve(const Vector& y, Vector &x) const;
 //  virtual void fullSolve(const VectorValues& y, VectorValues &x) const = 0;
 
   /* build/factorize the preconditioner */
@@ -118,7 +122,7 @@ public:
   virtual void transposeSolve(const Vector& y, Vector& x) const { x = y; }
 //  virtual void transposeSolve(const VectorValues& y, VectorValues& x) const { x = y; }
 
-//  virtual void fullSolve(const Vector& y, Vector &x) const { x = y; }
+  virtual void fullSolve(const Vector& y, Vector &x) const { x = y; }
 //  virtual void fullSolve(const VectorValues& y, VectorValues& x) const { x = y; }
 
   virtual void build(
@@ -163,6 +167,111 @@ protected:
   size_t nnz_;
 };
 
+/*******************************************************************************************/
+/* parameters for the block incomplete Cholesky preconditioner, fill_ is the level of fill:
+ * 0 keeps the sparsity pattern of the Hessian (IC0), k also keeps the fill-in blocks that are
+ * created through at most k eliminated variables */
+struct GTSAM_EXPORT BlockIncompleteCholeskyPreconditionerParameters : public PreconditionerParameters {
+  typedef PreconditionerParameters Base;
+  typedef boost::shared_ptr<BlockIncompleteCholeskyPreconditionerParameters> shared_ptr;
+  size_t fill_;
+  BlockIncompleteCholeskyPreconditionerParameters(size_t fill = 0) : Base(), fill_(fill) {}
+  virtual ~BlockIncompleteCholeskyPreconditionerParameters() {}
+  virtual void print(std::ostream &os) const ;
+};
+
+/*******************************************************************************************/
+/* Block incomplete Cholesky factorization L*L^T of the Hessian, with one block per variable in
+ * the order of the KeyInfo, and the level of fill of the parameters. If a diagonal block becomes
+ * indefinite during the factorization, it is replaced by the factor of the original Hessian block */
+class GTSAM_EXPORT BlockIncompleteCholeskyPreconditioner : public Preconditioner {
+public:
+  typedef Preconditioner Base;
+  BlockIncompleteCholeskyPreconditioner(
+      const BlockIncompleteCholeskyPreconditionerParameters &p = BlockIncompleteCholeskyPreconditionerParameters());
+  virtual ~BlockIncompleteCholeskyPreconditioner() {}
+
+  /* Computation Interfaces for raw vector */
+  virtual void solve(const Vector& y, Vector &x) const;
+  virtual void transposeSolve(const Vector& y, Vector& x) const ;
+
+  virtual void build(
+    const GaussianFactorGraph &gfg,
+    const KeyInfo &info,
+    const std::map<Key,Vector> &lambda
+    ) ;
+
+  /* the number of off-diagonal blocks in L */
+  size_t nrOffDiagonalBlocks() const { return columns_.size(); }
+
+protected:
+
+  BlockIncompleteCholeskyPreconditionerParameters parameters_;
+  std::vector<size_t> dims_, offsets_;  /* dimension and offset of each block row */
+  std::vector<Matrix> diagonal_;        /* lower triangular diagonal blocks of L */
+  std::vector<size_t> rowStarts_;       /* first off-diagonal block of each block row */
+  std::vector<size_t> columns_;         /* block column of each off-diagonal block */
+  std::vector<Matrix> blocks_;          /* off-diagonal blocks of L */
+};
+
+/*******************************************************************************************/
+/* parameters for the algebraic multigrid preconditioner */
+struct GTSAM_EXPORT AlgebraicMultigridPreconditionerParameters : public PreconditionerParameters {
+  typedef PreconditionerParameters Base;
+  typedef boost::shared_ptr<AlgebraicMultigridPreconditionerParameters> shared_ptr;
+  size_t maxLevels_;          /* maximum number of levels, including the finest */
+  size_t coarsestDim_;        /* stop coarsening when a level has at most this many unknowns */
+  size_t sweeps_;             /* number of Gauss-Seidel sweeps before and after coarse correction */
+  double strengthThreshold_;  /* relative size of the blocks that count as strong connections */
+  AlgebraicMultigridPreconditionerParameters() : Base(),
+      maxLevels_(10), coarsestDim_(200), sweeps_(1), strengthThreshold_(0.08) {}
+  virtual ~AlgebraicMultigridPreconditionerParameters() {}
+  virtual void print(std::ostream &os) const ;
+};
+
+/*******************************************************************************************/
+/* Smoothed aggregation algebraic multigrid. Variables are aggregated with their strongly
+ * connected neighbors, every dimension of an aggregate is a coarse unknown, and the prolongation
+ * is smoothed with one damped Jacobi step. The preconditioner applies one symmetric V-cycle, with
+ * forward Gauss-Seidel before and backward Gauss-Seidel after each coarse correction and a dense
+ * factorization on the coarsest level. It is not available in split form, so only fullSolve is
+ * implemented, and solve and transposeSolve throw std::logic_error */
+class GTSAM_EXPORT AlgebraicMultigridPreconditioner : public Preconditioner {
+public:
+  typedef Preconditioner Base;
+  typedef Eigen::SparseMatrix<double> Sparse;
+  AlgebraicMultigridPreconditioner(
+      const AlgebraicMultigridPreconditionerParameters &p = AlgebraicMultigridPreconditionerParameters());
+  virtual ~AlgebraicMultigridPreconditioner() {}
+
+  /* Computation Interfaces for raw vector */
+  virtual void solve(const Vector& y, Vector &x) const;
+  virtual void transposeSolve(const Vector& y, Vector& x) const ;
+  virtual void fullSolve(const Vector& y, Vector &x) const;
+
+  virtual void build(
+    const GaussianFactorGraph &gfg,
+    const KeyInfo &info,
+    const std::map<Key,Vector> &lambda
+    ) ;
+
+  /* the number of levels, including the finest and the coarsest */
+  size_t nrLevels() const { return A_.size(); }
+
+  /* the number of unknowns on a level */
+  size_t dim(size_t level) const { return A_.at(level).rows(); }
+
+protected:
+
+  void vcycle(size_t level, const Vector& b, Vector& x) const;
+
+  AlgebraicMultigridPreconditionerParameters parameters_;
+  std::vector<Sparse> A_;           /* system matrix on each level */
+  std::vector<Sparse> P_;           /* prolongation from level l+1 to level l */
+  std::vector<Vector> invDiagonal_; /* inverse diagonal of A_ for Gauss-Seidel */
+  Eigen::LDLT<Matrix> coarsest_;    /* factorization of the coarsest level */
+};
+
 /*********************************************************************************************/
 /* factory method to create preconditioners */
 boost::shared_ptr<Preconditioner> createPreconditioner(const boost::shared_ptr<PreconditionerParameters> parameters);
@@ -83,8 +83,25 @@ public:
     checkInvariants();
   }
 
+  /**
+   * Create a factor on the given keys with uninitialized storage for the augmented
+   * information matrix, to be filled in place through matrixObject(), e.g. by
+   * CameraSet::SchurComplement.  This avoids copying a separately built matrix.
+   */
+  template<typename KEYS>
+  static boost::shared_ptr<RegularHessianFactor> Uninitialized(const KEYS& keys) {
+    return boost::shared_ptr<RegularHessianFactor>(new RegularHessianFactor(keys,
+        std::vector<DenseIndex>(keys.size(), D), true));
+  }
+
 private:
 
+  /// Construct with uninitialized storage, see Uninitialized
+  template<typename KEYS, typename DIMS>
+  RegularHessianFactor(const KEYS& keys, const DIMS& dims, bool appendOneDimension) :
+      HessianFactor(keys, dims, appendOneDimension) {
+  }
+
   /// Check invariants after construction
   void checkInvariants() {
     if (info_.cols() != 1 + (info_.nBlocks()-1) * (DenseIndex)D)
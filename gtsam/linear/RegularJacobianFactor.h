@@ -184,6 +184,15 @@ public:
     return model_ ? model_->whiten(Ax) : Ax;
   }
 
+protected:
+
+  /// Unsafe constructor of an uninitialized factor with m rows, to be filled by derived classes
+  template<typename KEYS>
+  RegularJacobianFactor(const KEYS& keys, DenseIndex m,
+      const SharedDiagonal& model) :
+      JacobianFactor(keys, std::vector<size_t>(keys.size(), D), m, model) {
+  }
+
 };
 // end class RegularJacobianFactor
 
@@ -15,8 +15,106 @@
  */
 
 #include <gtsam/linear/Sampler.h>
+#include <gtsam/linear/GaussianBayesNet.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#include <boost/cstdint.hpp>
+#include <boost/foreach.hpp>
+#include <stdexcept>
+#include <cmath>
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 namespace gtsam {
 
+namespace {
+
+/* ************************************************************************* */
+// SplitMix64 finalizer, used as a counter-based generator: its output only depends on its input
+inline boost::uint64_t mix64(boost::uint64_t z) {
+  z += 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+/* ************************************************************************* */
+// Uniform double in (0,1) from draw counter of a stream
+inline double uniform(boost::uint64_t stream, boost::uint64_t counter) {
+  return ((mix64(stream ^ mix64(counter)) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+/* ************************************************************************* */
+// Standard normal samples with Box-Muller, from the stream of sample `column` of a batch
+void standardNormals(boost::uint64_t key, boost::uint64_t column, Eigen::Block<Matrix, Eigen::Dynamic, 1, true> z) {
+  const boost::uint64_t stream = mix64(key + mix64(column));
+  const DenseIndex d = z.size();
+  for (DenseIndex i = 0; i < d; i += 2) {
+    const double r = std::sqrt(-2.0 * std::log(uniform(stream, i)));
+    const double theta = 2.0 * M_PI * uniform(stream, i + 1);
+    z(i) = r * std::cos(theta);
+    if (i + 1 < d)
+      z(i + 1) = r * std::sin(theta);
+  }
+}
+
+/* ************************************************************************* */
+// Columns [begin, end) of a batch of samples of a diagonal distribution
+struct SampleDiagonal {
+  const Vector& sigmas_;
+  boost::uint64_t key_;
+  Matrix& samples_;
+  SampleDiagonal(const Vector& sigmas, boost::uint64_t key, Matrix& samples) :
+      sigmas_(sigmas), key_(key), samples_(samples) {}
+  void operator()(size_t begin, size_t end) const {
+    for (size_t j = begin; j < end; ++j) {
+      standardNormals(key_, j, samples_.col(j));
+      samples_.col(j).array() *= sigmas_.array();
+    }
+  }
+#ifdef GTSAM_USE_TBB
+  void operator()(const tbb::blocked_range<size_t>& range) const {
+    (*this)(range.begin(), range.end());
+  }
+#endif
+};
+
+/* ************************************************************************* */
+// Columns [begin, end) of a batch of samples of a Bayes net, solved with one multi-RHS
+// back-substitution into a block of their own
+struct SampleBayesNet {
+  const GaussianBayesNet& bayesNet_;
+  const DenseVectorValues::Layout& layout_;
+  const Vector& d_;
+  boost::uint64_t key_;
+  Matrix& samples_;
+  SampleBayesNet(const GaussianBayesNet& bayesNet, const DenseVectorValues::Layout& layout,
+      const Vector& d, boost::uint64_t key, Matrix& samples) :
+      bayesNet_(bayesNet), layout_(layout), d_(d), key_(key), samples_(samples) {}
+  void operator()(size_t begin, size_t end) const {
+    Matrix X(d_.size(), end - begin);
+    for (size_t j = begin; j < end; ++j) {
+      standardNormals(key_, j, X.col(j - begin));
+      X.col(j - begin) += d_;
+    }
+    bayesNet_.backSubstituteInPlace(layout_, X);
+    samples_.middleCols(begin, end - begin) = X;
+  }
+#ifdef GTSAM_USE_TBB
+  void operator()(const tbb::blocked_range<size_t>& range) const {
+    (*this)(range.begin(), range.end());
+  }
+#endif
+};
+
+// Number of samples solved together in one back-substitution
+const size_t kBlockSize = 256;
+
+}
+
 /* ************************************************************************* */
 Sampler::Sampler(const noiseModel::Diagonal::shared_ptr& model, int32_t seed)
   : model_(model), generator_(static_cast<unsigned>(seed))
@@ -68,6 +166,56 @@ Vector Sampler::sampleNewModel(const noiseModel::Diagonal::shared_ptr& model) {
   const Vector& sigmas = model->sigmas();
   return sampleDiagonal(sigmas);
 }
+
+/* ************************************************************************* */
+Matrix Sampler::sample(size_t n) {
+  assert(model_.get());
+  const Vector& sigmas = model_->sigmas();
+  Matrix samples(sigmas.size(), n);
+  SampleDiagonal body(sigmas, generator_(), samples);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n, kBlockSize), body);
+#else
+  body(0, n);
+#endif
+  return samples;
+}
+
+/* ************************************************************************* */
+Matrix Sampler::sample(const GaussianBayesNet& bayesNet, size_t n) {
+  const DenseVectorValues::Layout layout = bayesNet.denseLayout();
+
+  // Gather the right-hand sides d of all conditionals, the sample mean before back-substitution
+  DenseIndex dim = 0;
+  BOOST_FOREACH(const GaussianConditional::shared_ptr& cg, bayesNet)
+    dim += cg->get_R().rows();
+  Vector d(dim);
+  BOOST_FOREACH(const GaussianConditional::shared_ptr& cg, bayesNet) {
+    const SharedDiagonal& model = cg->get_model();
+    if (model && !(model->sigmas().array() == 1.0).all())
+      throw std::invalid_argument(
+          "Sampler::sample: only Bayes nets with unit noise models can be sampled");
+    DenseIndex position = 0;
+    for (GaussianConditional::const_iterator frontal = cg->beginFrontals();
+        frontal != cg->endFrontals(); ++frontal) {
+      const DenseIndex frontalDim = cg->getDim(frontal);
+      d.segment(layout.at(*frontal).offset, frontalDim) = cg->get_d().segment(position,
+          frontalDim);
+      position += frontalDim;
+    }
+  }
+
+  Matrix samples(dim, n);
+  SampleBayesNet body(bayesNet, layout, d, generator_(), samples);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n, kBlockSize), body);
+#else
+  for (size_t begin = 0; begin < n; begin += kBlockSize)
+    body(begin, std::min(n, begin + kBlockSize));
+#endif
+  return samples;
+}
+
 /* ************************************************************************* */
 
 } // \namespace gtsam
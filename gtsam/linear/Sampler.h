@@ -24,6 +24,9 @@
 
 namespace gtsam {
 
+// Forward declarations
+class GaussianBayesNet;
+
 /**
  * Sampling structure that keeps internal random number generators for
  * diagonal distributions specified by NoiseModel
@@ -83,6 +86,23 @@ public:
    */
   Vector sampleNewModel(const noiseModel::Diagonal::shared_ptr& model);
 
+  /**
+   * Draw n samples from the distribution at once, one in each column of the result.
+   * Each sample is generated from its own counter-based random stream, so the columns are
+   * computed in parallel when TBB is enabled, and the result does not depend on the number of
+   * threads.  Advances the underlying generator once per call.
+   */
+  Matrix sample(size_t n);
+
+  /**
+   * Draw n samples from the Gaussian density of a Bayes net, one in each column of the result,
+   * with the rows laid out as in bayesNet.denseLayout().  The noise of all samples is generated
+   * in parallel as in sample(size_t), and the Bayes net is solved for blocks of samples at once
+   * with the multi-RHS GaussianBayesNet::backSubstituteInPlace.  The conditionals need unit (or
+   * no) noise models, as produced by elimination, otherwise std::invalid_argument is thrown.
+   */
+  Matrix sample(const GaussianBayesNet& bayesNet, size_t n);
+
 protected:
 
   /** given sigmas for a diagonal model, returns a sample */
@@ -75,6 +75,11 @@ Scatter::Scatter(const GaussianFactorGraph& gfg,
   erase(std::remove_if(begin(), end(), SlotEntry::Zero), end());
 }
 
+/* ************************************************************************* */
+void Scatter::add(Key key, size_t dim) {
+  push_back(SlotEntry(key, dim));
+}
+
 /* ************************************************************************* */
 FastVector<SlotEntry>::iterator Scatter::find(Key key) {
   iterator it = begin();
@@ -50,10 +50,16 @@ struct GTSAM_EXPORT SlotEntry {
  */
 class Scatter : public FastVector<SlotEntry> {
  public:
+  /// Default Constructor
+  Scatter() {}
+
   /// Constructor
   Scatter(const GaussianFactorGraph& gfg,
           boost::optional<const Ordering&> ordering = boost::none);
 
+  /// Add a key/dim pair
+  void add(Key key, size_t dim);
+
  private:
 
   /// Find the SlotEntry with the right key (linear time worst case)
@@ -0,0 +1,226 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SchurComplementSolver.cpp
+ * @brief   Direct solver that first eliminates independent variables, e.g. bundle adjustment landmarks
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/linear/SchurComplementSolver.h>
+#include <gtsam/linear/GaussianConditional.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <boost/foreach.hpp>
+
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+// Eliminate variables [first, last), each from its own factors
+void _eliminateRange(const vector<Key>& keys, const vector<GaussianFactorGraph>& factors,
+    const GaussianFactorGraph::Eliminate& function,
+    vector<GaussianConditional::shared_ptr>& conditionals,
+    vector<GaussianFactor::shared_ptr>& schurFactors, size_t first, size_t last) {
+  for (size_t i = first; i < last; ++i) {
+    if (factors[i].empty())
+      continue;
+    Ordering frontal;
+    frontal.push_back(keys[i]);
+    GaussianFactorGraph::EliminationResult result = function(factors[i], frontal);
+    conditionals[i] = result.first;
+    schurFactors[i] = result.second;
+  }
+}
+
+// Back-substitute variables [first, last) given the reduced solution
+void _backSubstituteRange(const vector<GaussianConditional::shared_ptr>& conditionals,
+    const VectorValues& reducedSolution, vector<VectorValues>& solutions, size_t first,
+    size_t last) {
+  for (size_t i = first; i < last; ++i) {
+    if (conditionals[i])
+      solutions[i] = conditionals[i]->solve(reducedSolution);
+  }
+}
+
+#ifdef GTSAM_USE_TBB
+class _EliminateIndependent {
+  const vector<Key>& keys_;
+  const vector<GaussianFactorGraph>& factors_;
+  const GaussianFactorGraph::Eliminate& function_;
+  vector<GaussianConditional::shared_ptr>& conditionals_;
+  vector<GaussianFactor::shared_ptr>& schurFactors_;
+public:
+  _EliminateIndependent(const vector<Key>& keys, const vector<GaussianFactorGraph>& factors,
+      const GaussianFactorGraph::Eliminate& function,
+      vector<GaussianConditional::shared_ptr>& conditionals,
+      vector<GaussianFactor::shared_ptr>& schurFactors) :
+      keys_(keys), factors_(factors), function_(function), conditionals_(conditionals),
+      schurFactors_(schurFactors) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    _eliminateRange(keys_, factors_, function_, conditionals_, schurFactors_,
+        blocked_range.begin(), blocked_range.end());
+  }
+};
+
+class _BackSubstituteIndependent {
+  const vector<GaussianConditional::shared_ptr>& conditionals_;
+  const VectorValues& reducedSolution_;
+  vector<VectorValues>& solutions_;
+public:
+  _BackSubstituteIndependent(const vector<GaussianConditional::shared_ptr>& conditionals,
+      const VectorValues& reducedSolution, vector<VectorValues>& solutions) :
+      conditionals_(conditionals), reducedSolution_(reducedSolution), solutions_(solutions) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    _backSubstituteRange(conditionals_, reducedSolution_, solutions_, blocked_range.begin(),
+        blocked_range.end());
+  }
+};
+#endif
+
+}
+
+/* ************************************************************************* */
+SchurComplementSolver::SchurComplementSolver(const KeySet& eliminatedKeys,
+    const Ordering& reducedOrdering) :
+    eliminatedKeys_(eliminatedKeys), reducedOrdering_(reducedOrdering) {
+}
+
+/* ************************************************************************* */
+VectorValues SchurComplementSolver::optimize(const GaussianFactorGraph& graph,
+    const Eliminate& function) const {
+  gttic(SchurComplementSolver_optimize);
+
+  // Give each factor to the eliminated variable it involves, if any
+  const vector<Key> keys(eliminatedKeys_.begin(), eliminatedKeys_.end());
+  FastMap<Key, size_t> slots;
+  for (size_t i = 0; i < keys.size(); ++i)
+    slots.insert(make_pair(keys[i], i));
+  vector<GaussianFactorGraph> factors(keys.size());
+  GaussianFactorGraph reduced;
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, graph) {
+    if (!factor)
+      continue;
+    size_t owner = keys.size();
+    BOOST_FOREACH(Key key, *factor) {
+      FastMap<Key, size_t>::const_iterator slot = slots.find(key);
+      if (slot == slots.end())
+        continue;
+      if (owner != keys.size() && owner != slot->second)
+        throw std::invalid_argument(
+            "SchurComplementSolver: two eliminated variables share a factor");
+      owner = slot->second;
+    }
+    if (owner == keys.size())
+      reduced.push_back(factor);
+    else
+      factors[owner].push_back(factor);
+  }
+
+  // Eliminate the independent variables, each from its own factors
+  gttic(eliminate_independent);
+  vector<GaussianConditional::shared_ptr> conditionals(keys.size());
+  vector<GaussianFactor::shared_ptr> schurFactors(keys.size());
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, keys.size()),
+      _EliminateIndependent(keys, factors, function, conditionals, schurFactors));
+#else
+  _eliminateRange(keys, factors, function, conditionals, schurFactors, 0, keys.size());
+#endif
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& schurFactor, schurFactors) {
+    if (schurFactor && !schurFactor->empty())
+      reduced.push_back(schurFactor);
+  }
+  gttoc(eliminate_independent);
+
+  // Solve the reduced system
+  gttic(solve_reduced);
+  VectorValues solution;
+  if (!reduced.empty()) {
+    if (reducedOrdering_.empty()) {
+      solution = reduced.optimize(Ordering::Colamd(reduced), function);
+    } else {
+      // Keep only the variables that are still in the reduced system
+      const KeySet reducedKeys = reduced.keys();
+      Ordering ordering;
+      BOOST_FOREACH(Key key, reducedOrdering_) {
+        if (reducedKeys.exists(key))
+          ordering.push_back(key);
+      }
+      if (ordering.size() != reducedKeys.size())
+        throw std::invalid_argument(
+            "SchurComplementSolver: the reduced ordering does not contain all remaining variables");
+      solution = reduced.optimize(ordering, function);
+    }
+  }
+  gttoc(solve_reduced);
+
+  // Back-substitute for the independent variables
+  gttic(back_substitute);
+  vector<VectorValues> solutions(keys.size());
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, keys.size()),
+      _BackSubstituteIndependent(conditionals, solution, solutions));
+#else
+  _backSubstituteRange(conditionals, solution, solutions, 0, keys.size());
+#endif
+  BOOST_FOREACH(const VectorValues& independent, solutions)
+    solution.insert(independent);
+  gttoc(back_substitute);
+
+  return solution;
+}
+
+/* ************************************************************************* */
+KeySet SchurComplementSolver::DetectEliminatedKeys(const GaussianFactorGraph& graph) {
+  // Collect the variables of each Symbol character, and the characters that occur twice in a
+  // factor, whose variables are not independent
+  map<unsigned char, KeySet> keysOfType;
+  set<unsigned char> dependent;
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, graph) {
+    if (!factor)
+      continue;
+    set<unsigned char> typesInFactor;
+    BOOST_FOREACH(Key key, *factor) {
+      const unsigned char chr = Symbol(key).chr();
+      keysOfType[chr].insert(key);
+      if (!typesInFactor.insert(chr).second)
+        dependent.insert(chr);
+    }
+  }
+
+  // The largest independent type
+  KeySet best;
+  typedef pair<const unsigned char, KeySet> TypeKeys;
+  BOOST_FOREACH(const TypeKeys& type_keys, keysOfType) {
+    if (!dependent.count(type_keys.first) && type_keys.second.size() > best.size())
+      best = type_keys.second;
+  }
+  return best;
+}
+
+}
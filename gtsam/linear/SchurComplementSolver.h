@@ -0,0 +1,85 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SchurComplementSolver.h
+ * @brief   Direct solver that first eliminates independent variables, e.g. bundle adjustment landmarks
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/Key.h>
+
+namespace gtsam {
+
+/**
+ * A SchurComplementSolver solves a linear least-squares problem whose variables split into a
+ * large set of mutually independent variables, no two of which appear in the same factor, and
+ * the rest.  In bundle adjustment these are the landmarks and the cameras.
+ *
+ * Each independent variable is eliminated from its own factors alone, so this is done in
+ * parallel (with TBB), producing a conditional on the cameras it is seen from and a Schur
+ * complement factor on those cameras.  The reduced camera system is then solved by multifrontal
+ * elimination, and the independent variables are recovered by back-substitution, again in
+ * parallel.  This is the equivalent of the SPARSE_SCHUR solver of Ceres.
+ *
+ * To use it in nonlinear optimization, set NonlinearOptimizerParams::linearSolverType to
+ * SCHUR_COMPLEMENT, and optionally NonlinearOptimizerParams::schurKeys.
+ *
+ * \nosubgrouping
+ */
+class GTSAM_EXPORT SchurComplementSolver {
+public:
+
+  typedef GaussianFactorGraph::Eliminate Eliminate; ///< Typedef for an eliminate subroutine
+
+  /// @name Standard Constructors
+  /// @{
+
+  /** Eliminate \c eliminatedKeys first, then solve the reduced system in \c reducedOrdering,
+   *  which may be empty to compute a COLAMD ordering of the reduced system */
+  SchurComplementSolver(const KeySet& eliminatedKeys, const Ordering& reducedOrdering = Ordering());
+
+  /// @}
+
+  /// @name Standard Interface
+  /// @{
+
+  /** The variables eliminated first */
+  const KeySet& eliminatedKeys() const { return eliminatedKeys_; }
+
+  /**
+   * Solve \c graph, using \c function for all dense eliminations.
+   * @throw std::invalid_argument if two eliminated variables share a factor
+   */
+  VectorValues optimize(const GaussianFactorGraph& graph,
+      const Eliminate& function = EliminatePreferCholesky) const;
+
+  /**
+   * Detect the variables to eliminate from the key types: of the Symbol characters whose
+   * variables never share a factor, the one with the most variables.  Returns an empty set if
+   * there is no such character.
+   */
+  static KeySet DetectEliminatedKeys(const GaussianFactorGraph& graph);
+
+  /// @}
+
+private:
+
+  KeySet eliminatedKeys_;
+  Ordering reducedOrdering_;
+};
+
+}
@@ -0,0 +1,248 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SparseCholeskySolver.cpp
+ * @brief   Direct solver factoring the scalar sparse Hessian, with CHOLMOD when available
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/linear/SparseCholeskySolver.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/linearExceptions.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/config.h>
+
+#include <Eigen/SparseCore>
+#ifdef GTSAM_USE_CHOLMOD
+#include <Eigen/CholmodSupport>
+#else
+#include <Eigen/SparseCholesky>
+#endif
+
+#include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace gtsam {
+
+typedef Eigen::SparseMatrix<double, Eigen::ColMajor, int> SparseMatrix;
+
+/* ************************************************************************* */
+#ifdef GTSAM_USE_CHOLMOD
+
+// CHOLMOD's supernodal Cholesky, told to keep our ordering instead of computing its own
+struct SparseCholeskySolver::Factorization :
+    public Eigen::CholmodSupernodalLLT<SparseMatrix, Eigen::Upper> {
+  SparseMatrix hessian;
+  Factorization() {
+    cholmod().nmethods = 1;
+    cholmod().method[0].ordering = CHOLMOD_NATURAL;
+    cholmod().postorder = 0;
+  }
+  /// The column where the factorization failed
+  size_t failedColumn() const { return m_cholmodFactor->minor; }
+};
+
+bool SparseCholeskySolver::UsesCholmod() { return true; }
+
+#else
+
+// Eigen's simplicial LDL', in our ordering.  Only exact zeros on the diagonal of D make Eigen
+// report failure, so failedColumn() also checks for negative pivots.  Eigen stops at the first
+// zero pivot, after storing it in D.
+struct SparseCholeskySolver::Factorization :
+    public Eigen::SimplicialLDLT<SparseMatrix, Eigen::Upper, Eigen::NaturalOrdering<int> > {
+  SparseMatrix hessian;
+  /// The column where the factorization failed, or the number of columns if it succeeded
+  size_t failedColumn() const {
+    const Eigen::VectorXd d = vectorD();
+    for (size_t j = 0; j < size_t(d.size()); ++j)
+      if (!(d[j] > 0.0))
+        return j;
+    return d.size();
+  }
+};
+
+bool SparseCholeskySolver::UsesCholmod() { return false; }
+
+#endif
+
+/* ************************************************************************* */
+namespace {
+
+// Scalar columns of the rows (and columns) of a factor's information matrix
+vector<int> scalarColumns(const GaussianFactor& factor, const FastMap<Key, size_t>& offsets) {
+  vector<int> columns;
+  for (GaussianFactor::const_iterator key = factor.begin(); key != factor.end(); ++key) {
+    const size_t offset = offsets.at(*key), dim = factor.getDim(key);
+    for (size_t i = 0; i < dim; ++i)
+      columns.push_back(int(offset + i));
+  }
+  return columns;
+}
+
+}
+
+/* ************************************************************************* */
+SparseCholeskySolver::SparseCholeskySolver(const GaussianFactorGraph& graph,
+    const Ordering& ordering) :
+    ordering_(ordering), factorization_(boost::make_shared<Factorization>()) {
+  gttic(SparseCholeskySolver_analyze);
+
+  // Structure of the graph, to check compatibility later
+  factorKeys_.resize(graph.size());
+  hasFactor_.resize(graph.size());
+  for (size_t i = 0; i < graph.size(); ++i) {
+    hasFactor_[i] = bool(graph[i]);
+    if (!graph[i])
+      continue;
+    const GaussianFactor& factor = *graph[i];
+    factorKeys_[i].assign(factor.begin(), factor.end());
+    for (GaussianFactor::const_iterator key = factor.begin(); key != factor.end(); ++key)
+      dims_[*key] = factor.getDim(key);
+  }
+
+  // Scalar columns, in elimination order
+  size_t n = 0;
+  BOOST_FOREACH(Key key, ordering_) {
+    FastMap<Key, size_t>::const_iterator dim = dims_.find(key);
+    if (dim == dims_.end())
+      throw std::invalid_argument(
+          "SparseCholeskySolver: the ordering contains a variable that is not in the graph");
+    offsets_[key] = n;
+    n += dim->second;
+  }
+  if (offsets_.size() != dims_.size())
+    throw std::invalid_argument(
+        "SparseCholeskySolver: the ordering does not contain every variable of the graph");
+
+  // Pattern of the upper triangle, then the value index of every upper triangular entry of every
+  // factor, in the order optimize() visits them
+  vector<Eigen::Triplet<double, int> > triplets;
+  FastVector<vector<int> > columns(graph.size());
+  for (size_t i = 0; i < graph.size(); ++i) {
+    if (!graph[i])
+      continue;
+    columns[i] = scalarColumns(*graph[i], offsets_);
+    BOOST_FOREACH(int q, columns[i])
+      BOOST_FOREACH(int p, columns[i])
+        if (p <= q)
+          triplets.push_back(Eigen::Triplet<double, int>(p, q, 0.0));
+  }
+  SparseMatrix& hessian = factorization_->hessian;
+  hessian.resize(int(n), int(n));
+  hessian.setFromTriplets(triplets.begin(), triplets.end());
+  hessian.makeCompressed();
+
+  slots_.resize(graph.size());
+  for (size_t i = 0; i < graph.size(); ++i) {
+    slots_[i].reserve(columns[i].size() * (columns[i].size() + 1) / 2);
+    BOOST_FOREACH(int q, columns[i]) {
+      const int* begin = hessian.innerIndexPtr() + hessian.outerIndexPtr()[q];
+      const int* end = hessian.innerIndexPtr() + hessian.outerIndexPtr()[q + 1];
+      BOOST_FOREACH(int p, columns[i])
+        if (p <= q)
+          slots_[i].push_back(int(std::lower_bound(begin, end, p) - hessian.innerIndexPtr()));
+    }
+  }
+
+  gttic(symbolic_factorization);
+  factorization_->analyzePattern(hessian);
+  gttoc(symbolic_factorization);
+}
+
+/* ************************************************************************* */
+bool SparseCholeskySolver::compatible(const GaussianFactorGraph& graph) const {
+  if (graph.size() != factorKeys_.size())
+    return false;
+  for (size_t i = 0; i < graph.size(); ++i) {
+    if (bool(graph[i]) != hasFactor_[i])
+      return false;
+    if (!graph[i])
+      continue;
+    const GaussianFactor& factor = *graph[i];
+    if (factor.size() != factorKeys_[i].size()
+        || !std::equal(factor.begin(), factor.end(), factorKeys_[i].begin()))
+      return false;
+    for (GaussianFactor::const_iterator key = factor.begin(); key != factor.end(); ++key)
+      if (factor.getDim(key) != dims_.at(*key))
+        return false;
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+VectorValues SparseCholeskySolver::optimize(const GaussianFactorGraph& graph) {
+  gttic(SparseCholeskySolver_optimize);
+  if (!compatible(graph))
+    throw std::invalid_argument(
+        "SparseCholeskySolver: the factor graph does not have the structure the solver was "
+        "created for");
+
+  // Assemble the upper triangle of the Hessian and the gradient term A'*b
+  gttic(assemble);
+  SparseMatrix& hessian = factorization_->hessian;
+  double* values = hessian.valuePtr();
+  std::fill(values, values + hessian.nonZeros(), 0.0);
+  Vector rhs = Vector::Zero(hessian.cols());
+  for (size_t i = 0; i < graph.size(); ++i) {
+    if (!graph[i])
+      continue;
+    const GaussianFactor& factor = *graph[i];
+    const JacobianFactor* jacobian = dynamic_cast<const JacobianFactor*>(&factor);
+    if (jacobian && jacobian->isConstrained())
+      throw std::invalid_argument(
+          "SparseCholeskySolver: constrained noise models are not supported");
+    const Matrix info = factor.augmentedInformation();
+    const vector<int> columns = scalarColumns(factor, offsets_);
+    const size_t d = columns.size();
+    if (d == 0)
+      continue;
+    const int* slot = &slots_[i][0];
+    for (size_t q = 0; q < d; ++q) {
+      for (size_t p = 0; p < d; ++p)
+        if (columns[p] <= columns[q])
+          values[*slot++] += info(p, q);
+      rhs[columns[q]] += info(q, d);
+    }
+  }
+  gttoc(assemble);
+
+  gttic(numeric_factorization);
+  factorization_->factorize(hessian);
+  gttoc(numeric_factorization);
+  const size_t failed = factorization_->failedColumn();
+  if (factorization_->info() != Eigen::Success || failed < size_t(hessian.cols())) {
+    // Report the variable whose column failed
+    Key key = ordering_.front();
+    BOOST_FOREACH(Key j, ordering_)
+      if (offsets_.at(j) <= failed)
+        key = j;
+    throw IndeterminantLinearSystemException(key);
+  }
+
+  gttic(solve);
+  const Vector x = factorization_->solve(rhs);
+  gttoc(solve);
+
+  VectorValues result;
+  BOOST_FOREACH(Key key, ordering_)
+    result.insert(key, x.segment(offsets_.at(key), dims_.at(key)));
+  return result;
+}
+
+}
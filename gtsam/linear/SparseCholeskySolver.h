@@ -0,0 +1,96 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SparseCholeskySolver.h
+ * @brief   Direct solver factoring the scalar sparse Hessian, with CHOLMOD when available
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/FastVector.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace gtsam {
+
+/**
+ * A SparseCholeskySolver assembles the Hessian of a GaussianFactorGraph into one scalar sparse
+ * matrix, with its columns in the given elimination ordering, and solves the normal equations
+ * with a sparse Cholesky factorization.  Unlike multifrontal elimination, no Bayes tree is built,
+ * so this is only a solver: use it when all that is needed is the solution.
+ *
+ * If GTSAM is configured with CHOLMOD (GTSAM_WITH_CHOLMOD), the factorization is CHOLMOD's
+ * supernodal Cholesky, whose dense kernels run in the (possibly multithreaded) BLAS.  Otherwise
+ * it is Eigen's simplicial LDL', which is correct but not faster than multifrontal elimination.
+ *
+ * As for GaussianEliminationPlan, the symbolic analysis is done once in the constructor, and
+ * optimize() only does the numeric work, so that the solver can be reused while the graph keeps
+ * its structure: the same number of factors, and each factor on the same keys with the same
+ * dimensions.  Constrained noise models are not supported.
+ *
+ * To use it in nonlinear optimization, set NonlinearOptimizerParams::linearSolverType to CHOLMOD.
+ *
+ * \nosubgrouping
+ */
+class GTSAM_EXPORT SparseCholeskySolver {
+public:
+
+  /// @name Standard Constructors
+  /// @{
+
+  /** Analyze the structure of \c graph, eliminating in the given ordering, which must contain
+   *  every variable of \c graph */
+  SparseCholeskySolver(const GaussianFactorGraph& graph, const Ordering& ordering);
+
+  /// @}
+
+  /// @name Standard Interface
+  /// @{
+
+  /** The elimination ordering */
+  const Ordering& ordering() const { return ordering_; }
+
+  /** Check whether \c graph has the structure the solver was created for */
+  bool compatible(const GaussianFactorGraph& graph) const;
+
+  /**
+   * Assemble and factor the Hessian of \c graph, and solve for the optimal solution.
+   * @throw std::invalid_argument if the structure of \c graph does not match, or a factor has
+   *        a constrained noise model
+   * @throw IndeterminantLinearSystemException if the Hessian is not positive definite
+   */
+  VectorValues optimize(const GaussianFactorGraph& graph);
+
+  /** Whether the factorization is done by CHOLMOD's supernodal Cholesky */
+  static bool UsesCholmod();
+
+  /// @}
+
+private:
+
+  struct Factorization; ///< The sparse matrix and its factorization, hides the backend
+
+  Ordering ordering_;
+  FastVector<FastVector<Key> > factorKeys_; ///< Keys of each factor, empty for null factors
+  FastVector<bool> hasFactor_; ///< Whether each factor is not null
+  FastMap<Key, size_t> dims_; ///< Dimension of each variable
+  FastMap<Key, size_t> offsets_; ///< First scalar column of each variable
+  FastVector<FastVector<int> > slots_; ///< Value index in the sparse matrix of each Hessian entry of each factor
+  boost::shared_ptr<Factorization> factorization_;
+};
+
+}
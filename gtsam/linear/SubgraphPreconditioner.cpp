@@ -22,11 +22,18 @@
 #include <gtsam/linear/GaussianEliminationTree.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/VariableIndex.h>
+#include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/base/DSFVector.h>
 #include <gtsam/base/FastMap.h>
 #include <gtsam/base/FastVector.h>
 #include <gtsam/base/types.h>
 #include <gtsam/base/Vector.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
 
 #include <boost/algorithm/string.hpp>
 #include <boost/archive/text_iarchive.hpp>
@@ -42,6 +49,7 @@
 #include <iomanip>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <list>
 #include <map>
 #include <numeric> // accumulate
@@ -212,6 +220,7 @@ SubgraphBuilderParameters::Skeleton SubgraphBuilderParameters::skeletonTranslato
   if (s == "NATURALCHAIN")    return NATURALCHAIN;
   else if (s == "BFS")        return BFS;
   else if (s == "KRUSKAL")    return KRUSKAL;
+  else if (s == "BORUVKA")    return BORUVKA;
   throw invalid_argument("SubgraphBuilderParameters::skeletonTranslator undefined string " + s);
   return KRUSKAL;
 }
@@ -221,6 +230,7 @@ std::string SubgraphBuilderParameters::skeletonTranslator(Skeleton w) {
   if ( w == NATURALCHAIN )return "NATURALCHAIN";
   else if ( w == BFS )    return "BFS";
   else if ( w == KRUSKAL )return "KRUSKAL";
+  else if ( w == BORUVKA )return "BORUVKA";
   else                    return "UNKNOWN";
 }
 
@@ -275,6 +285,9 @@ std::vector<size_t> SubgraphBuilder::buildTree(const GaussianFactorGraph &gfg, c
   case SubgraphBuilderParameters::KRUSKAL:
     return kruskal(gfg, ordering, w);
     break;
+  case SubgraphBuilderParameters::BORUVKA:
+    return boruvkaSpanningForest(gfg, w);
+    break;
   default:
     cerr << "SubgraphBuilder::buildTree undefined skeleton type" << endl;
     break;
@@ -465,7 +478,7 @@ SubgraphPreconditioner::SubgraphPreconditioner(const SubgraphPreconditionerParam
 SubgraphPreconditioner::SubgraphPreconditioner(const sharedFG& Ab2,
     const sharedBayesNet& Rc1, const sharedValues& xbar, const SubgraphPreconditionerParameters &p) :
         Ab2_(convertToJacobianFactors(*Ab2)), Rc1_(Rc1), xbar_(xbar),
-        b2bar_(new Errors(-Ab2_->gaussianErrors(*xbar))), parameters_(p) {
+        b2bar_(new Errors(-Ab2_->gaussianErrors(*xbar))), coloring2_(*Ab2_), parameters_(p) {
 }
 
 /* ************************************************************************* */
@@ -488,7 +501,7 @@ VectorValues SubgraphPreconditioner::gradient(const VectorValues& y) const {
   VectorValues x = Rc1()->backSubstitute(y); /* inv(R1)*y */
   Errors e = (*Ab2()*x - *b2bar());               /* (A2*inv(R1)*y-b2bar) */
   VectorValues v = VectorValues::Zero(x);
-  Ab2()->transposeMultiplyAdd(1.0, e, v);           /* A2'*(A2*inv(R1)*y-b2bar) */
+  Ab2()->transposeMultiplyAdd(1.0, e, v, coloring2_); /* A2'*(A2*inv(R1)*y-b2bar) */
   return y + Rc1()->backSubstituteTranspose(v);
 }
 
@@ -553,7 +566,7 @@ void SubgraphPreconditioner::transposeMultiplyAdd2 (double alpha,
   while (it != end) e2.push_back(*(it++));
 
   VectorValues x = VectorValues::Zero(y); // x = 0
-  Ab2_->transposeMultiplyAdd(1.0,e2,x);   // x += A2'*e2
+  Ab2_->transposeMultiplyAdd(1.0,e2,x,coloring2_); // x += A2'*e2
   axpy(alpha, Rc1_->backSubstituteTranspose(x), y); // y += alpha*inv(R1')*x
 }
 
@@ -623,7 +636,7 @@ void SubgraphPreconditioner::build(const GaussianFactorGraph &gfg, const KeyInfo
   GaussianFactorGraph::shared_ptr gfg_subgraph = buildFactorSubgraph(gfg, *subgraph, true);
 
   /* factorize and cache BayesNet */
-  Rc1_ = gfg_subgraph->eliminateSequential();
+  Rc1_ = eliminateFactorSubgraph(*gfg_subgraph);
 }
 
 /*****************************************************************************/
@@ -663,6 +676,163 @@ void setSubvector(const Vector &src, const KeyInfo &keyInfo, const FastVector<Ke
   }
 }
 
+/*****************************************************************************/
+namespace {
+  const size_t kNoEdge = std::numeric_limits<size_t>::max();
+
+  // Dense vertex indices of the two keys of each binary factor, or kNoEdge for other factors
+  class FindEndpoints {
+    const GaussianFactorGraph &gfg_;
+    const FastMap<Key, size_t> &index_;
+    vector<pair<size_t, size_t> > &endpoints_;
+  public:
+    FindEndpoints(const GaussianFactorGraph &gfg, const FastMap<Key, size_t> &index,
+        vector<pair<size_t, size_t> > &endpoints) :
+        gfg_(gfg), index_(index), endpoints_(endpoints) {}
+    void operator()(size_t f) const {
+      const GaussianFactor::shared_ptr &gf = gfg_[f];
+      if (gf && gf->size() == 2)
+        endpoints_[f] = make_pair(index_.find(gf->keys()[0])->second,
+            index_.find(gf->keys()[1])->second);
+      else
+        endpoints_[f] = make_pair(kNoEdge, kNoEdge);
+    }
+  };
+
+  // For each vertex, the heaviest incident edge that leaves the component of the vertex
+  class FindHeaviestEdges {
+    const vector<size_t> &starts_, &incidence_;
+    const vector<pair<size_t, size_t> > &endpoints_;
+    const vector<double> &weights_;
+    const vector<size_t> &component_;
+    vector<size_t> &heaviest_;
+  public:
+    FindHeaviestEdges(const vector<size_t> &starts, const vector<size_t> &incidence,
+        const vector<pair<size_t, size_t> > &endpoints, const vector<double> &weights,
+        const vector<size_t> &component, vector<size_t> &heaviest) :
+        starts_(starts), incidence_(incidence), endpoints_(endpoints), weights_(weights),
+        component_(component), heaviest_(heaviest) {}
+
+    // Strict total order on the edges, with ties broken by the lower index
+    bool heavier(size_t e1, size_t e2) const {
+      return e2 == kNoEdge || weights_[e1] > weights_[e2]
+          || (weights_[e1] == weights_[e2] && e1 < e2);
+    }
+
+    void operator()(size_t v) const {
+      size_t best = kNoEdge;
+      for (size_t i = starts_[v]; i < starts_[v + 1]; ++i) {
+        const size_t e = incidence_[i];
+        const size_t u = endpoints_[e].first == v ? endpoints_[e].second : endpoints_[e].first;
+        if (component_[u] != component_[v] && heavier(e, best))
+          best = e;
+      }
+      heaviest_[v] = best;
+    }
+  };
+
+#ifdef GTSAM_USE_TBB
+  template<class BODY>
+  class ForEachIndex {
+    const BODY &body_;
+  public:
+    ForEachIndex(const BODY &body) : body_(body) {}
+    void operator()(const tbb::blocked_range<size_t> &blocked_range) const {
+      for (size_t i = blocked_range.begin(); i != blocked_range.end(); ++i)
+        body_(i);
+    }
+  };
+#endif
+
+  template<class BODY>
+  void forEachIndex(size_t n, const BODY &body) {
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n, 256), ForEachIndex<BODY>(body));
+#else
+    for (size_t i = 0; i < n; ++i)
+      body(i);
+#endif
+  }
+}
+
+/*****************************************************************************/
+std::vector<size_t> boruvkaSpanningForest(const GaussianFactorGraph &gfg,
+    const std::vector<double> &weights) {
+
+  const FastMap<Key, size_t> index = Ordering::Natural(gfg).invert();
+  const size_t n = index.size(), m = gfg.size();
+
+  /* endpoints of the edges, and the incident edges of each vertex in compressed form */
+  vector<pair<size_t, size_t> > endpoints(m);
+  forEachIndex(m, FindEndpoints(gfg, index, endpoints));
+  vector<size_t> starts(n + 1, 0);
+  for (size_t e = 0; e < m; ++e) {
+    if (endpoints[e].first == kNoEdge) continue;
+    ++starts[endpoints[e].first + 1];
+    ++starts[endpoints[e].second + 1];
+  }
+  std::partial_sum(starts.begin(), starts.end(), starts.begin());
+  vector<size_t> incidence(starts[n]), next(starts.begin(), starts.end() - 1);
+  for (size_t e = 0; e < m; ++e) {
+    if (endpoints[e].first == kNoEdge) continue;
+    incidence[next[endpoints[e].first]++] = e;
+    incidence[next[endpoints[e].second]++] = e;
+  }
+
+  /* Boruvka rounds */
+  DSFBase D(n);
+  vector<size_t> component(n), heaviest(n), componentHeaviest(n, kNoEdge);
+  for (size_t v = 0; v < n; ++v)
+    component[v] = v;
+  vector<bool> inForest(m, false);
+  const FindHeaviestEdges findHeaviest(starts, incidence, endpoints, weights, component,
+      heaviest);
+  while (true) {
+    forEachIndex(n, findHeaviest);
+
+    /* heaviest edge leaving each component */
+    for (size_t v = 0; v < n; ++v) {
+      const size_t e = heaviest[v], c = component[v];
+      if (e != kNoEdge && findHeaviest.heavier(e, componentHeaviest[c]))
+        componentHeaviest[c] = e;
+    }
+
+    /* merge the components along these edges, each edge may be chosen by both its components */
+    size_t added = 0;
+    for (size_t c = 0; c < n; ++c) {
+      const size_t e = componentHeaviest[c];
+      if (e == kNoEdge) continue;
+      componentHeaviest[c] = kNoEdge;
+      const size_t u_root = D.find(endpoints[e].first), v_root = D.find(endpoints[e].second);
+      if (u_root != v_root) {
+        D.merge(u_root, v_root);
+        inForest[e] = true;
+        ++added;
+      }
+    }
+    if (added == 0) break;
+
+    for (size_t v = 0; v < n; ++v)
+      component[v] = D.find(v);
+  }
+
+  vector<size_t> result;
+  for (size_t e = 0; e < m; ++e)
+    if (inForest[e]) result.push_back(e);
+  return result;
+}
+
+/*****************************************************************************/
+GaussianBayesNet::shared_ptr eliminateFactorSubgraph(const GaussianFactorGraph &subgraph,
+    boost::optional<const Ordering&> ordering, const GaussianFactorGraph::Eliminate &function) {
+
+  /* multifrontal elimination eliminates independent subtrees in parallel */
+  const GaussianBayesTree::shared_ptr bayesTree = subgraph.eliminateMultifrontal(ordering, function);
+
+  /* flatten the tree so that children come before parents */
+  return boost::make_shared<GaussianBayesNet>(bayesTree->toBayesNet());
+}
+
 /*****************************************************************************/
 boost::shared_ptr<GaussianFactorGraph>
 buildFactorSubgraph(const GaussianFactorGraph &gfg, const Subgraph &subgraph, const bool clone) {
@@ -23,6 +23,7 @@
 #include <gtsam/linear/IterativeSolver.h>
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/FactorColoring.h>
 #include <gtsam/base/FastMap.h>
 #include <gtsam/base/FastVector.h>
 #include <gtsam/base/types.h>
@@ -118,6 +119,7 @@ namespace gtsam {
       NATURALCHAIN = 0,  /* natural ordering of the graph */
       BFS,      /* breadth-first search tree */
       KRUSKAL,  /* maximum weighted spanning tree */
+      BORUVKA,  /* maximum weighted spanning tree, with the edge search of each round in parallel */
     } skeleton_ ;
 
     enum SkeletonWeight {   /* how to weigh the graph edges */
@@ -208,6 +210,7 @@ namespace gtsam {
     sharedBayesNet Rc1_;
     sharedValues xbar_;  ///< A1 \ b1
     sharedErrors b2bar_; ///< A2*xbar - b2
+    FactorColoring coloring2_; ///< Coloring of the factors of Ab2, for the products with A2'
 
     KeyInfo keyInfo_;
     SubgraphPreconditionerParameters parameters_;
@@ -309,6 +312,26 @@ namespace gtsam {
   buildFactorSubgraph(const GaussianFactorGraph &gfg, const Subgraph &subgraph, const bool clone);
 
 
+  /**
+   * Maximum weight spanning forest of the binary factors in gfg, where ties between equal weights
+   * are broken in favor of the lower factor index, so that equal weights give the same forest as
+   * adding the factors greedily in order.  Computed with Boruvka rounds: in each round every
+   * vertex finds its heaviest edge leaving its component (in parallel when TBB is enabled) and the
+   * components are merged with a DSF.  Returns the sorted indices of the forest factors.
+   */
+  std::vector<size_t> boruvkaSpanningForest(const GaussianFactorGraph &gfg,
+      const std::vector<double> &weights);
+
+  /**
+   * Eliminate a factor subgraph into a Bayes net, eliminating independent subtrees of the
+   * elimination tree in parallel when TBB is enabled.  The conditionals of the resulting Bayes
+   * net may have several frontal variables.
+   */
+  boost::shared_ptr<GaussianBayesNet> eliminateFactorSubgraph(const GaussianFactorGraph &subgraph,
+      boost::optional<const Ordering&> ordering = boost::none,
+      const GaussianFactorGraph::Eliminate &function =
+          EliminationTraits<GaussianFactorGraph>::DefaultEliminate);
+
   /* sort the container and return permutation index with default comparator */
    template <typename Container>
    std::vector<size_t> sort_idx(const Container &src)
@@ -22,24 +22,43 @@
 #include <gtsam/linear/iterative-inl.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/SubgraphPreconditioner.h>
-#include <gtsam/base/DSFVector.h>
+#include <gtsam/base/timing.h>
 
 using namespace std;
 
 namespace gtsam {
 
+namespace {
+  // Elapsed wall-clock time since construction, as in LevenbergMarquardtOptimizer
+  class SetupTimer {
+#ifdef GTSAM_USING_NEW_BOOST_TIMERS
+    boost::timer::cpu_timer timer_;
+  public:
+    double elapsed() const { return 1e-9 * timer_.elapsed().wall; }
+#else
+    boost::timer timer_;
+  public:
+    double elapsed() const { return timer_.elapsed(); }
+#endif
+  };
+}
+
 /**************************************************************************************************/
 SubgraphSolver::SubgraphSolver(const GaussianFactorGraph &gfg,
     const Parameters &parameters, const Ordering& ordering) :
     parameters_(parameters), ordering_(ordering) {
+  SetupTimer timer;
   initialize(gfg);
+  setupTime_ = timer.elapsed();
 }
 
 /**************************************************************************************************/
 SubgraphSolver::SubgraphSolver(const GaussianFactorGraph::shared_ptr &jfg,
     const Parameters &parameters, const Ordering& ordering) :
     parameters_(parameters), ordering_(ordering) {
+  SetupTimer timer;
   initialize(*jfg);
+  setupTime_ = timer.elapsed();
 }
 
 /**************************************************************************************************/
@@ -47,10 +66,11 @@ SubgraphSolver::SubgraphSolver(const GaussianFactorGraph &Ab1,
     const GaussianFactorGraph &Ab2, const Parameters &parameters,
     const Ordering& ordering) :
     parameters_(parameters), ordering_(ordering) {
-
-  GaussianBayesNet::shared_ptr Rc1 = Ab1.eliminateSequential(ordering_,
+  SetupTimer timer;
+  GaussianBayesNet::shared_ptr Rc1 = eliminateFactorSubgraph(Ab1, ordering_,
       EliminateQR);
   initialize(Rc1, boost::make_shared<GaussianFactorGraph>(Ab2));
+  setupTime_ = timer.elapsed();
 }
 
 /**************************************************************************************************/
@@ -58,10 +78,11 @@ SubgraphSolver::SubgraphSolver(const GaussianFactorGraph::shared_ptr &Ab1,
     const GaussianFactorGraph::shared_ptr &Ab2, const Parameters &parameters,
     const Ordering& ordering) :
     parameters_(parameters), ordering_(ordering) {
-
-  GaussianBayesNet::shared_ptr Rc1 = Ab1->eliminateSequential(ordering_,
+  SetupTimer timer;
+  GaussianBayesNet::shared_ptr Rc1 = eliminateFactorSubgraph(*Ab1, ordering_,
       EliminateQR);
   initialize(Rc1, Ab2);
+  setupTime_ = timer.elapsed();
 }
 
 /**************************************************************************************************/
@@ -69,7 +90,9 @@ SubgraphSolver::SubgraphSolver(const GaussianBayesNet::shared_ptr &Rc1,
     const GaussianFactorGraph &Ab2, const Parameters &parameters,
     const Ordering& ordering) :
     parameters_(parameters), ordering_(ordering) {
+  SetupTimer timer;
   initialize(Rc1, boost::make_shared<GaussianFactorGraph>(Ab2));
+  setupTime_ = timer.elapsed();
 }
 
 /**************************************************************************************************/
@@ -77,7 +100,9 @@ SubgraphSolver::SubgraphSolver(const GaussianBayesNet::shared_ptr &Rc1,
     const GaussianFactorGraph::shared_ptr &Ab2, const Parameters &parameters,
     const Ordering& ordering) :
     parameters_(parameters), ordering_(ordering) {
+  SetupTimer timer;
   initialize(Rc1, Ab2);
+  setupTime_ = timer.elapsed();
 }
 
 /**************************************************************************************************/
@@ -104,7 +129,7 @@ void SubgraphSolver::initialize(const GaussianFactorGraph &jfg) {
     cout << "Split A into (A1) " << Ab1->size() << " and (A2) " << Ab2->size()
         << " factors" << endl;
 
-  GaussianBayesNet::shared_ptr Rc1 = Ab1->eliminateSequential(ordering_,
+  GaussianBayesNet::shared_ptr Rc1 = eliminateFactorSubgraph(*Ab1, ordering_,
       EliminateQR);
   VectorValues::shared_ptr xbar = boost::make_shared<VectorValues>(
       Rc1->optimize());
@@ -123,39 +148,28 @@ void SubgraphSolver::initialize(const GaussianBayesNet::shared_ptr &Rc1,
 boost::tuple<GaussianFactorGraph::shared_ptr, GaussianFactorGraph::shared_ptr> //
 SubgraphSolver::splitGraph(const GaussianFactorGraph &jfg) {
 
-  const VariableIndex index(jfg);
-  const size_t n = index.size();
-  DSFVector D(n);
-
-  GaussianFactorGraph::shared_ptr At(new GaussianFactorGraph());
-  GaussianFactorGraph::shared_ptr Ac(new GaussianFactorGraph());
-
-  size_t t = 0;
   BOOST_FOREACH ( const GaussianFactor::shared_ptr &gf, jfg ) {
-
     if (gf->keys().size() > 2) {
       throw runtime_error(
           "SubgraphSolver::splitGraph the graph is not simple, sanity check failed ");
     }
+  }
 
-    bool augment = false;
-
-    /* check whether this factor should be augmented to the "tree" graph */
-    if (gf->keys().size() == 1)
-      augment = true;
-    else {
-      const Key u = gf->keys()[0], v = gf->keys()[1], u_root = D.findSet(u),
-          v_root = D.findSet(v);
-      if (u_root != v_root) {
-        t++;
-        augment = true;
-        D.makeUnionInPlace(u_root, v_root);
-      }
-    }
-    if (augment)
-      At->push_back(gf);
+  /* With equal weights, the spanning forest is the one obtained by adding the binary factors
+   * greedily in order whenever they connect two components */
+  const vector<size_t> forest = boruvkaSpanningForest(jfg, vector<double>(jfg.size(), 1.0));
+  vector<bool> inTree(jfg.size(), false);
+  BOOST_FOREACH ( const size_t f, forest )
+    inTree[f] = true;
+
+  GaussianFactorGraph::shared_ptr At(new GaussianFactorGraph());
+  GaussianFactorGraph::shared_ptr Ac(new GaussianFactorGraph());
+  for (size_t f = 0; f < jfg.size(); ++f) {
+    /* unary factors are always added to the "tree" graph */
+    if (jfg[f]->keys().size() == 1 || inTree[f])
+      At->push_back(jfg[f]);
     else
-      Ac->push_back(gf);
+      Ac->push_back(jfg[f]);
   }
 
   return boost::tie(At, Ac);
@@ -72,6 +72,7 @@ protected:
   Parameters parameters_;
   Ordering ordering_;
   boost::shared_ptr<SubgraphPreconditioner> pc_; ///< preconditioner object
+  double setupTime_; ///< time spent building the preconditioner, in seconds
 
 public:
 
@@ -109,6 +110,14 @@ public:
   virtual ~SubgraphSolver() {
   }
 
+  /**
+   * Time spent in the constructor building the preconditioner, in seconds: splitting the graph
+   * (when only A is given), eliminating the subgraph and computing xbar and b2bar.
+   */
+  double setupTime() const {
+    return setupTime_;
+  }
+
   /// Optimize from zero
   VectorValues optimize();
 
@@ -0,0 +1,123 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file UnaryJacobianFactor.h
+ *
+ * @brief A unary JacobianFactor specialization that uses fixed matrix math for speed
+ *
+ * @date Oct 14, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/SymmetricBlockMatrix.h>
+#include <gtsam/base/timing.h>
+
+namespace gtsam {
+
+/**
+ * A unary JacobianFactor specialization that uses fixed matrix math for speed.
+ * The number of rows M may be Eigen::Dynamic, as the fixed-size products only
+ * depend on the variable dimension N.
+ */
+template<int M, int N>
+struct UnaryJacobianFactor: JacobianFactor {
+
+  /// Constructor, A should be M*N, and b should have M rows
+  UnaryJacobianFactor(Key key, const Matrix& A, const Vector& b,
+      const SharedDiagonal& model = SharedDiagonal()) :
+      JacobianFactor(key, A, b, model) {
+  }
+
+  inline Key key() const {
+    return keys_[0];
+  }
+
+  // Fixed-size matrix update
+  void updateHessian(const FastVector<Key>& infoKeys,
+      SymmetricBlockMatrix* info) const {
+    gttic(updateHessian_UnaryJacobianFactor);
+    // Whiten the factor if it has a noise model
+    const SharedDiagonal& model = get_model();
+    if (model && !model->isUnit()) {
+      if (model->isConstrained())
+        throw std::invalid_argument(
+            "UnaryJacobianFactor::updateHessian: cannot update information with "
+                "constrained noise model");
+      UnaryJacobianFactor whitenedFactor(key(), model->Whiten(getA(begin())),
+          model->whiten(getb()));
+      whitenedFactor.updateHessian(infoKeys, info);
+    } else {
+      DenseIndex slot = Slot(infoKeys, key());
+      DenseIndex slotB = info->nBlocks() - 1;
+
+      const BlockA A = this->A();
+      const BlockB b = this->b();
+
+      // We perform I += A'*A to the upper triangle
+      (*info)(slot, slot).selfadjointView().rankUpdate(A.transpose());
+      (*info)(slot, slotB).knownOffDiagonal() += A.transpose() * b;
+      (*info)(slotB, slotB)(0, 0) += b.transpose() * b;
+    }
+  }
+
+  /// x += alpha * A'*e, with fixed-size products unless there is a noise model
+  void transposeMultiplyAdd(double alpha, const Vector& e, VectorValues& x) const {
+    if (model_) {
+      JacobianFactor::transposeMultiplyAdd(alpha, e, x);
+      return;
+    }
+    const Eigen::Matrix<double, N, 1> v = alpha * (A().transpose() * e);
+    AddTo(x, v);
+  }
+
+  /// y += alpha * A'*A*x, with fixed-size products unless there is a noise model
+  void multiplyHessianAdd(double alpha, const VectorValues& x, VectorValues& y) const {
+    if (model_) {
+      JacobianFactor::multiplyHessianAdd(alpha, x, y);
+      return;
+    }
+    const BlockA A = this->A();
+    const Eigen::Matrix<double, M, 1> Ax = A * x.at(key());
+    const Eigen::Matrix<double, N, 1> v = alpha * (A.transpose() * Ax);
+    AddTo(y, v);
+  }
+
+private:
+
+  typedef Eigen::Block<const Matrix, M, N> BlockA;
+  typedef Eigen::Block<const Matrix, M, 1> BlockB;
+
+  // Fixed-size views of the augmented matrix [A b]
+  BlockA A() const {
+    return BlockA(Ab_.matrix(), 0, 0, rows(), Ab_(0).cols());
+  }
+  BlockB b() const {
+    return BlockB(Ab_.matrix(), 0, Ab_.offset(1), rows(), 1);
+  }
+
+  // Add v to x[key()], inserting it if it does not exist yet
+  void AddTo(VectorValues& x, const Eigen::Matrix<double, N, 1>& v) const {
+    std::pair<VectorValues::iterator, bool> xj = x.tryInsert(key(), v);
+    if (!xj.second)
+      xj.first->second += v;
+  }
+};
+
+template<int M, int N>
+struct traits<UnaryJacobianFactor<M, N> > : Testable<
+    UnaryJacobianFactor<M, N> > {
+};
+
+} //namespace gtsam
@@ -17,6 +17,7 @@
  */
 
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/MemoryUsage.h>
 
 #include <boost/foreach.hpp>
 #include <boost/bind.hpp>
@@ -112,6 +113,14 @@ namespace gtsam {
       v.setZero();
   }
 
+  /* ************************************************************************* */
+  size_t VectorValues::memoryUsage() const {
+    size_t bytes = sizeof(VectorValues) + mapNodeBytes(size(), sizeof(value_type));
+    BOOST_FOREACH(const Vector& v, values_ | map_values)
+      bytes += heapBytes(v);
+    return bytes;
+  }
+
   /* ************************************************************************* */
   void VectorValues::print(const string& str, const KeyFormatter& formatter) const {
     cout << str << ": " << size() << " elements\n";
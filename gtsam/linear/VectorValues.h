@@ -140,6 +140,9 @@ namespace gtsam {
     /** Return the dimension of variable \c j. */
     size_t dim(Key j) const { return at(j).rows(); }
 
+    /** Return the memory used by the vectors and the map holding them, in bytes, see MemoryUsage */
+    size_t memoryUsage() const;
+
     /** Check whether a variable with key \c j exists. */
     bool exists(Key j) const { return find(j) != end(); }
 
@@ -21,8 +21,15 @@
 #include <gtsam/base/Matrix.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/IterativeSolver.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/timing.h>
 
+#include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 
 using namespace std;
 
@@ -35,6 +42,150 @@ namespace gtsam {
     gtsam::print(b_, "b");
   }
 
+  /* ************************************************************************* */
+  namespace {
+    // Whiten the rows of one factor as JacobianFactor::multiplyInPlace does
+    void whitenInPlace(const SharedDiagonal& model, Eigen::VectorBlock<Vector> e) {
+      if (model && !model->isConstrained())
+        e.array() *= model->invsigmas().array();
+      else if (model)
+        e = model->whiten(Vector(e));
+    }
+  }
+
+  /* ************************************************************************* */
+  DenseIndexedSystem::DenseIndexedSystem(const GaussianFactorGraph& fg) : maxRows_(0) {
+    gttic(DenseIndexedSystem);
+
+    // Number the keys in the order they first appear, the only key lookups of the solve
+    FastMap<Key, size_t> indices;
+    FastVector<DenseIndex> dims;
+    FastVector<size_t> blockIndices;
+    rowOffsets_.push_back(0);
+    firstBlock_.push_back(0);
+    BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, fg) {
+      if (!factor)
+        continue;
+      JacobianFactor::shared_ptr jacobian = boost::dynamic_pointer_cast<JacobianFactor>(factor);
+      if (!jacobian)
+        // Convert any non-Jacobian factors to Jacobians (e.g. Hessian -> Jacobian with Cholesky)
+        jacobian = boost::make_shared<JacobianFactor>(*factor);
+      factors_.push_back(jacobian);
+      rowOffsets_.push_back(rowOffsets_.back() + jacobian->rows());
+      maxRows_ = std::max(maxRows_, DenseIndex(jacobian->rows()));
+      for (JacobianFactor::const_iterator key = jacobian->begin(); key != jacobian->end(); ++key) {
+        std::pair<FastMap<Key, size_t>::iterator, bool> it =
+            indices.insert(std::make_pair(*key, keys_.size()));
+        if (it.second) {
+          keys_.push_back(*key);
+          dims.push_back(jacobian->getDim(key));
+        }
+        blockIndices.push_back(it.first->second);
+      }
+      firstBlock_.push_back(blockIndices.size());
+    }
+
+    offsets_.resize(keys_.size() + 1);
+    offsets_[0] = 0;
+    for (size_t i = 0; i < keys_.size(); ++i)
+      offsets_[i + 1] = offsets_[i] + dims[i];
+    columns_.resize(blockIndices.size());
+    for (size_t k = 0; k < blockIndices.size(); ++k)
+      columns_[k] = offsets_[blockIndices[k]];
+
+    b_.resize(rows());
+    for (size_t f = 0; f < factors_.size(); ++f)
+      b_.segment(rowOffsets_[f], factors_[f]->rows()) = factors_[f]->getb();
+  }
+
+  /* ************************************************************************* */
+  Vector DenseIndexedSystem::vector(const VectorValues& x) const {
+    Vector v(cols());
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      const Vector& xi = x.at(keys_[i]);
+      if (xi.size() != offsets_[i + 1] - offsets_[i])
+        throw std::invalid_argument(
+            "DenseIndexedSystem::vector: a variable has another dimension than in the graph");
+      v.segment(offsets_[i], xi.size()) = xi;
+    }
+    return v;
+  }
+
+  /* ************************************************************************* */
+  VectorValues DenseIndexedSystem::vectorValues(const Vector& v) const {
+    VectorValues result;
+    for (size_t i = 0; i < keys_.size(); ++i)
+      result.insert(keys_[i], v.segment(offsets_[i], offsets_[i + 1] - offsets_[i]));
+    return result;
+  }
+
+  /* ************************************************************************* */
+  void DenseIndexedSystem::print(const string& s) const {
+    cout << s << ": " << factors_.size() << " factors, " << keys_.size() << " variables, "
+        << rows() << "x" << cols() << endl;
+  }
+
+  /* ************************************************************************* */
+  void DenseIndexedSystem::multiply(const Vector& x, bool subtractb, Vector& e) const {
+    e.resize(rows());
+    for (size_t f = 0; f < factors_.size(); ++f) {
+      const JacobianFactor& factor = *factors_[f];
+      Eigen::VectorBlock<Vector> ef = e.segment(rowOffsets_[f], factor.rows());
+      if (subtractb)
+        ef = -b_.segment(rowOffsets_[f], factor.rows());
+      else
+        ef.setZero();
+      JacobianFactor::const_iterator key = factor.begin();
+      for (size_t k = firstBlock_[f]; k < firstBlock_[f + 1]; ++k, ++key) {
+        const JacobianFactor::constABlock A = factor.getA(key);
+        ef.noalias() += A * x.segment(columns_[k], A.cols());
+      }
+      whitenInPlace(factor.get_model(), ef);
+    }
+  }
+
+  /* ************************************************************************* */
+  Vector DenseIndexedSystem::operator^(const Vector& e) const {
+    Vector x = Vector::Zero(cols());
+    transposeMultiplyAdd(1.0, e, x);
+    return x;
+  }
+
+  /* ************************************************************************* */
+  Vector DenseIndexedSystem::gradient(const Vector& x) const {
+    Vector e;
+    multiply(x, true, e);
+    return (*this) ^ e;
+  }
+
+  /* ************************************************************************* */
+  Vector DenseIndexedSystem::operator*(const Vector& x) const {
+    Vector e;
+    multiply(x, false, e);
+    return e;
+  }
+
+  /* ************************************************************************* */
+  void DenseIndexedSystem::multiplyInPlace(const Vector& x, Vector& e) const {
+    multiply(x, false, e);
+  }
+
+  /* ************************************************************************* */
+  void DenseIndexedSystem::transposeMultiplyAdd(double alpha, const Vector& e, Vector& x) const {
+    Vector work(maxRows_);
+    for (size_t f = 0; f < factors_.size(); ++f) {
+      const JacobianFactor& factor = *factors_[f];
+      Eigen::VectorBlock<Vector> E = work.head(factor.rows());
+      E = alpha * e.segment(rowOffsets_[f], factor.rows());
+      whitenInPlace(factor.get_model(), E);
+      JacobianFactor::const_iterator key = factor.begin();
+      for (size_t k = firstBlock_[f]; k < firstBlock_[f + 1]; ++k, ++key) {
+        const JacobianFactor::constABlock A = factor.getA(key);
+        x.segment(columns_[k], A.cols()).noalias() += A.transpose() * E;
+      }
+    }
+  }
+
   /* ************************************************************************* */
 
   Vector steepestDescent(const System& Ab, const Vector& x,
@@ -60,17 +211,40 @@ namespace gtsam {
     return conjugateGradients<System, Vector, Vector>(Ab, x, parameters);
   }
 
+  /* ************************************************************************* */
+  Vector steepestDescent(const DenseIndexedSystem& Ab, const Vector& x,
+      const ConjugateGradientParameters & parameters) {
+    return conjugateGradients<DenseIndexedSystem, Vector, Vector>(Ab, x, parameters, true);
+  }
+
+  Vector conjugateGradientDescent(const DenseIndexedSystem& Ab, const Vector& x,
+      const ConjugateGradientParameters & parameters) {
+    return conjugateGradients<DenseIndexedSystem, Vector, Vector>(Ab, x, parameters);
+  }
+
+  /* ************************************************************************* */
+  namespace {
+    // Solve on dense indices, and map the solution back to the keys of x
+    VectorValues conjugateGradientsDense(const GaussianFactorGraph& fg, const VectorValues& x,
+        const ConjugateGradientParameters & parameters, bool steepest) {
+      const DenseIndexedSystem Ab(fg);
+      const Vector solution = conjugateGradients<DenseIndexedSystem, Vector, Vector>(
+          Ab, Ab.vector(x), parameters, steepest);
+      VectorValues result = x; // variables not in the graph are unchanged
+      result.update(Ab.vectorValues(solution));
+      return result;
+    }
+  }
+
   /* ************************************************************************* */
   VectorValues steepestDescent(const GaussianFactorGraph& fg,
       const VectorValues& x, const ConjugateGradientParameters & parameters) {
-    return conjugateGradients<GaussianFactorGraph, VectorValues, Errors>(
-        fg, x, parameters, true);
+    return conjugateGradientsDense(fg, x, parameters, true);
   }
 
   VectorValues conjugateGradientDescent(const GaussianFactorGraph& fg,
       const VectorValues& x, const ConjugateGradientParameters & parameters) {
-    return conjugateGradients<GaussianFactorGraph, VectorValues, Errors>(
-        fg, x, parameters);
+    return conjugateGradientsDense(fg, x, parameters, false);
   }
 
 /* ************************************************************************* */
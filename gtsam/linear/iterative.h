@@ -21,9 +21,14 @@
 #include <gtsam/base/Matrix.h>
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/ConjugateGradientSolver.h>
+#include <gtsam/base/FastVector.h>
+
+#include <boost/shared_ptr.hpp>
 
 namespace gtsam {
 
+  class JacobianFactor;
+
   /**
    * Method of conjugate gradients (CG) template
    * "System" class S needs gradient(S,v), e=S*v, v=S^e
@@ -90,6 +95,69 @@ namespace gtsam {
     }
   };
 
+  /**
+   * The system |Ax-b|^2 of a GaussianFactorGraph, with its keys remapped to dense indices.
+   * The keys are numbered 0..n-1 once, in the order they first appear in the graph, and the
+   * offset of each block of each factor in the stacked vector of all variables is recorded, so
+   * that the products with A and A' needed by conjugate gradients run on plain Vectors instead
+   * of looking up every key in a VectorValues.  The factors are whitened like those of the
+   * GaussianFactorGraph, and non-Jacobian factors are converted to JacobianFactors.  Use
+   * vector() and vectorValues() to map solutions to and from the stacked vector.
+   */
+  class GTSAM_EXPORT DenseIndexedSystem {
+
+  private:
+    FastVector<boost::shared_ptr<const JacobianFactor> > factors_; ///< Non-null factors
+    FastVector<DenseIndex> rowOffsets_; ///< First row of each factor, and the total
+    FastVector<size_t> firstBlock_; ///< First entry of each factor in columns_, and the total
+    FastVector<DenseIndex> columns_; ///< Column offset of each block of each factor
+    FastVector<Key> keys_; ///< Key of each dense index
+    FastVector<DenseIndex> offsets_; ///< Offset of each dense index, and the total dimension
+    Vector b_; ///< Stacked right-hand side, not whitened
+    DenseIndex maxRows_; ///< Most rows of a factor
+
+    /** e = A*x, or e = A*x - b if subtractb, whitened */
+    void multiply(const Vector& x, bool subtractb, Vector& e) const;
+
+  public:
+
+    /** Remap the keys of a graph, and record the layout of its factors */
+    explicit DenseIndexedSystem(const GaussianFactorGraph& fg);
+
+    /** Number of rows of A */
+    DenseIndex rows() const { return rowOffsets_.back(); }
+
+    /** Number of columns of A, the total dimension of the variables */
+    DenseIndex cols() const { return offsets_.back(); }
+
+    /** The key of each dense index */
+    const FastVector<Key>& keys() const { return keys_; }
+
+    /** Stack the variables of \c x in dense order, throws if \c x lacks a key of the graph */
+    Vector vector(const VectorValues& x) const;
+
+    /** Map a stacked vector back to a VectorValues */
+    VectorValues vectorValues(const Vector& v) const;
+
+    /** Apply operator A'*e */
+    Vector operator^(const Vector& e) const;
+
+    /** Print with optional string */
+    void print(const std::string& s = "DenseIndexedSystem") const;
+
+    /** gradient of objective function 0.5*|Ax-b|^2 at x = A'*(Ax-b) */
+    Vector gradient(const Vector& x) const;
+
+    /** Apply operator A */
+    Vector operator*(const Vector& x) const;
+
+    /** Apply operator A in place */
+    void multiplyInPlace(const Vector& x, Vector& e) const;
+
+    /** x += alpha* A'*e */
+    void transposeMultiplyAdd(double alpha, const Vector& e, Vector& x) const;
+  };
+
   /**
    * Method of steepest gradients, System version
    */
@@ -127,7 +195,24 @@ namespace gtsam {
       const ConjugateGradientParameters & parameters);
 
   /**
-   * Method of steepest gradients, Gaussian Factor Graph version
+   * Method of steepest gradients, DenseIndexedSystem version
+   */
+  GTSAM_EXPORT Vector steepestDescent(
+      const DenseIndexedSystem& Ab,
+      const Vector& x,
+      const ConjugateGradientParameters & parameters);
+
+  /**
+   * Method of conjugate gradients (CG), DenseIndexedSystem version
+   */
+  GTSAM_EXPORT Vector conjugateGradientDescent(
+      const DenseIndexedSystem& Ab,
+      const Vector& x,
+      const ConjugateGradientParameters & parameters);
+
+  /**
+   * Method of steepest gradients, Gaussian Factor Graph version.  Remaps the keys of the graph
+   * to a DenseIndexedSystem once, and maps the solution back to \c x.
    */
   GTSAM_EXPORT VectorValues steepestDescent(
       const GaussianFactorGraph& fg,
@@ -135,7 +220,8 @@ namespace gtsam {
       const ConjugateGradientParameters & parameters);
 
   /**
-   * Method of conjugate gradients (CG), Gaussian Factor Graph version
+   * Method of conjugate gradients (CG), Gaussian Factor Graph version.  Remaps the keys of the
+   * graph to a DenseIndexedSystem once, and maps the solution back to \c x.
    */
   GTSAM_EXPORT VectorValues conjugateGradientDescent(
       const GaussianFactorGraph& fg,
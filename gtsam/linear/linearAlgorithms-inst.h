@@ -17,10 +17,20 @@
 
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/GaussianConditional.h>
+#include <gtsam/inference/BayesTree.h>
+#include <gtsam/base/MemoryUsage.h>
 #include <gtsam/base/treeTraversal-inst.h>
 
 #include <boost/optional.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/task_group.h>
+#  undef max // TBB seems to include windows.h and we don't want these macros
+#  undef min
+#  undef ERROR
+#endif
 
 namespace gtsam
 {
@@ -123,21 +133,106 @@ namespace gtsam
       //  myData.parentData->results.insert(myData.results);
       //}
 
+#ifdef GTSAM_USE_TBB
+      /* ************************************************************************* */
+      /** Task that back-substitutes a clique once its parent's solution is available, and then
+      *  hands each child clique to a new task.  Children whose subtree problem size is below the
+      *  threshold are solved inline, together with their whole subtree, to avoid the overhead of
+      *  spawning tasks for small cliques.  With TBB, VectorValues is backed by a concurrent map, so
+      *  the tasks can insert their solutions into the collected result concurrently. */
+      template<class CLIQUE>
+      class OptimizeCliqueTask
+      {
+        const boost::shared_ptr<CLIQUE>& clique_;
+        boost::shared_ptr<OptimizeData> parentData_; // Kept alive until the children have read it
+        OptimizeClique<CLIQUE>& solver_;
+        tbb::task_group& tasks_;
+        int problemSizeThreshold_;
+
+      public:
+        OptimizeCliqueTask(const boost::shared_ptr<CLIQUE>& clique,
+          const boost::shared_ptr<OptimizeData>& parentData, OptimizeClique<CLIQUE>& solver,
+          tbb::task_group& tasks, int problemSizeThreshold) :
+          clique_(clique), parentData_(parentData), solver_(solver), tasks_(tasks),
+          problemSizeThreshold_(problemSizeThreshold) {}
+
+        void operator()() const
+        {
+          boost::shared_ptr<OptimizeData> myData =
+            boost::make_shared<OptimizeData>(solver_(clique_, *parentData_));
+          BOOST_FOREACH(const boost::shared_ptr<CLIQUE>& child, clique_->children) {
+            if(child->problemSize() >= problemSizeThreshold_)
+              tasks_.run(OptimizeCliqueTask(child, myData, solver_, tasks_, problemSizeThreshold_));
+            else
+              solveRecursively(child, *myData);
+          }
+        }
+
+      private:
+        void solveRecursively(const boost::shared_ptr<CLIQUE>& clique, OptimizeData& parentData) const
+        {
+          OptimizeData myData = solver_(clique, parentData);
+          BOOST_FOREACH(const boost::shared_ptr<CLIQUE>& child, clique->children)
+            solveRecursively(child, myData);
+        }
+      };
+#endif
+
       /* ************************************************************************* */
       template<class BAYESTREE>
-      VectorValues optimizeBayesTree(const BAYESTREE& bayesTree)
+      VectorValues optimizeBayesTree(const BAYESTREE& bayesTree, int problemSizeThreshold = 10)
       {
         gttic(linear_optimizeBayesTree);
         //internal::OptimizeData rootData; // Will hold final solution
         //treeTraversal::DepthFirstForest(*this, rootData, internal::OptimizePreVisitor, internal::OptimizePostVisitor);
         //return rootData.results;
+        typedef typename BAYESTREE::Clique Clique;
+        OptimizeClique<Clique> preVisitor;
+#ifdef GTSAM_USE_TBB
+        // Solving a clique only requires the solution of its parent, so each child clique is
+        // handed to a new task as soon as its parent has been solved.
+        boost::shared_ptr<OptimizeData> rootData = boost::make_shared<OptimizeData>();
+        TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+        tbb::task_group tasks;
+        BOOST_FOREACH(const boost::shared_ptr<Clique>& root, bayesTree.roots())
+          tasks.run(OptimizeCliqueTask<Clique>(root, rootData, preVisitor, tasks, problemSizeThreshold));
+        tasks.wait();
+#else
         OptimizeData rootData;
-        OptimizeClique<typename BAYESTREE::Clique> preVisitor;
         treeTraversal::no_op postVisitor;
-        TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
-        treeTraversal::DepthFirstForestParallel(bayesTree, rootData, preVisitor, postVisitor);
+        treeTraversal::DepthFirstForest(bayesTree, rootData, preVisitor, postVisitor);
+#endif
         return preVisitor.collectedResult;
       }
+
+      /* ************************************************************************* */
+      // Memory used by a Gaussian Bayes tree, broken down into the "conditionals" of the cliques
+      // (their R, S and d matrices), the "cliques" themselves, and the "nodes" of the tree, i.e.
+      // the map from keys to cliques and the roots
+      template<class BAYESTREE>
+      MemoryUsage bayesTreeMemoryUsage(const BAYESTREE& bayesTree)
+      {
+        typedef typename BAYESTREE::Clique Clique;
+        typedef typename BAYESTREE::Nodes Nodes;
+        MemoryUsage usage;
+        usage.add("conditionals", 0);
+        usage.add("cliques", 0);
+        usage.add("nodes", sizeof(BayesTree<Clique>) + heapBytes(bayesTree.roots())
+            + mapNodeBytes(bayesTree.nodes().size(), sizeof(typename Nodes::value_type)));
+        FastVector<const Clique*> stack;
+        BOOST_FOREACH(const boost::shared_ptr<Clique>& root, bayesTree.roots())
+          stack.push_back(root.get());
+        while (!stack.empty()) {
+          const Clique* clique = stack.back();
+          stack.pop_back();
+          if (clique->conditional())
+            usage.add("conditionals", clique->conditional()->memoryUsage());
+          usage.add("cliques", sizeof(Clique) + heapBytes(clique->children));
+          BOOST_FOREACH(const boost::shared_ptr<Clique>& child, clique->children)
+            stack.push_back(child.get());
+        }
+        return usage;
+      }
     }
   }
 }
@@ -0,0 +1,95 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testDenseVectorValues.cpp
+ * @brief   Unit tests for DenseVectorValues
+ * @date    Oct 14, 2026
+ */
+
+#include <gtsam/linear/DenseVectorValues.h>
+#include <gtsam/base/Testable.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+  VectorValues createValues() {
+    VectorValues values;
+    values.insert(5, Vector3(1, 2, 3));
+    values.insert(0, Vector2(4, 5));
+    values.insert(2, (Vector(1) << 6).finished());
+    return values;
+  }
+}
+
+/* ************************************************************************* */
+TEST(DenseVectorValues, construction)
+{
+  const VectorValues values = createValues();
+  const DenseVectorValues actual(values);
+  LONGS_EQUAL(3, actual.size());
+  LONGS_EQUAL(6, actual.dim());
+  LONGS_EQUAL(3, actual.dim(5));
+  EXPECT(actual.exists(2));
+  EXPECT(!actual.exists(1));
+
+  // Laid out in increasing key order
+  EXPECT(assert_equal((Vector(6) << 4, 5, 6, 1, 2, 3).finished(), actual.vector()));
+  EXPECT(assert_equal(Vector(Vector3(1, 2, 3)), Vector(actual.at(5))));
+  EXPECT(assert_equal(values, actual.vectorValues()));
+  CHECK_EXCEPTION(actual.at(1), std::out_of_range);
+
+  // Laid out in a given ordering
+  Ordering ordering;
+  ordering += 5, 2, 0;
+  const DenseVectorValues ordered(values, ordering);
+  EXPECT(assert_equal((Vector(6) << 1, 2, 3, 6, 4, 5).finished(), ordered.vector()));
+  EXPECT(assert_equal(actual, ordered));
+  EXPECT(!actual.hasSameLayout(ordered));
+
+  Ordering incomplete;
+  incomplete += 5, 2;
+  CHECK_EXCEPTION(DenseVectorValues(values, incomplete), std::invalid_argument);
+  incomplete += 1;
+  CHECK_EXCEPTION(DenseVectorValues(values, incomplete), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(DenseVectorValues, linearAlgebra)
+{
+  const VectorValues values = createValues();
+  const DenseVectorValues x(values);
+  DenseVectorValues y = DenseVectorValues::Zero(x);
+  EXPECT(x.hasSameLayout(y));
+  EXPECT(assert_equal(Vector(Vector::Zero(6)), y.vector()));
+
+  y.at(0) << 1, 1;
+  y.at(5) << 2, 2, 2;
+  DOUBLES_EQUAL(values.dot(y.vectorValues()), x.dot(y), 1e-9);
+  DOUBLES_EQUAL(values.norm(), x.norm(), 1e-9);
+  EXPECT(assert_equal(values + y.vectorValues(), (x + y).vectorValues()));
+  EXPECT(assert_equal(values - y.vectorValues(), (x - y).vectorValues()));
+  EXPECT(assert_equal(2.0 * values, x.scale(2.0).vectorValues()));
+
+  DenseVectorValues z = x;
+  z.axpy(-0.5, y);
+  EXPECT(assert_equal(values - 0.5 * y.vectorValues(), z.vectorValues()));
+  z += y;
+  z *= 2.0;
+  EXPECT(assert_equal(2.0 * (values + 0.5 * y.vectorValues()), z.vectorValues()));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -38,6 +38,25 @@ TEST( Errors, arithmetic )
   CHECK(assert_equal(expected,e));
 }
 
+/* ************************************************************************* */
+TEST( ErrorVector, arithmetic )
+{
+  Errors errors;
+  errors += Vector2(1.0,2.0), Vector3(3.0,4.0,5.0);
+  ErrorVector e(errors);
+  LONGS_EQUAL(2, e.size());
+  LONGS_EQUAL(5, e.dim());
+  LONGS_EQUAL(2, e.offset(1));
+  EXPECT(assert_equal(Vector3(3.0,4.0,5.0), Vector(e[1])));
+  DOUBLES_EQUAL(1+4+9+16+25,dot(e,e),1e-9);
+
+  axpy(2.0,e,e);
+  Errors expected;
+  expected += Vector2(3.0,6.0), Vector3(9.0,12.0,15.0);
+  CHECK(assert_equal(expected,e.errors()));
+  CHECK(assert_equal(ErrorVector(expected),e));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
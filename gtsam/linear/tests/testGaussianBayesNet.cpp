@@ -125,6 +125,56 @@ TEST( GaussianBayesNet, backSubstituteTranspose )
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST( GaussianBayesNet, backSubstituteInPlace )
+{
+  // Two frontal variables in the first conditional, and a diagonal noise model
+  GaussianBayesNet gbn;
+  gbn += GaussianConditional(list_of<pair<Key, Matrix> >
+    (0, (Matrix(3, 2) << 2.0, 1.0,  0.0, 4.0,  0.0, 0.0).finished())
+    (1, (Matrix(3, 1) << 3.0,  1.0,  5.0).finished())
+    (2, (Matrix(3, 2) << 1.0, 2.0,  3.0, 1.0,  2.0, 2.0).finished()),
+    2, Vector3(1.0, 2.0, 3.0), noiseModel::Diagonal::Sigmas(Vector3(0.5, 1.0, 2.0)));
+  gbn += GaussianConditional(2, Vector2(4.0, 5.0),
+    (Matrix(2, 2) << 3.0, 1.0, 0.0, 2.0).finished(), noiseModel::Isotropic::Sigma(2, 0.25));
+
+  Matrix gx = (Matrix(5, 3) <<
+    1.0, 0.0, -1.0,
+    2.0, 1.0,  0.5,
+    3.0, 0.0,  2.0,
+    4.0, 0.0,  1.0,
+    5.0, 1.0, -3.0).finished();
+
+  // The default layout and one where the frontals of the first conditional are not in order
+  DenseVectorValues::Layout swapped;
+  swapped.insert(make_pair(1, DenseVectorValues::Slot(0, 1)));
+  swapped.insert(make_pair(0, DenseVectorValues::Slot(1, 2)));
+  swapped.insert(make_pair(2, DenseVectorValues::Slot(3, 2)));
+  const std::vector<DenseVectorValues::Layout> layouts = list_of(gbn.denseLayout())(swapped);
+  EXPECT(DenseVectorValues::Slot(3, 2) == gbn.denseLayout().at(2));
+
+  BOOST_FOREACH(const DenseVectorValues::Layout& layout, layouts) {
+    Matrix actual = gx, actualTranspose = gx;
+    gbn.backSubstituteInPlace(layout, actual);
+    gbn.backSubstituteTransposeInPlace(layout, actualTranspose);
+
+    // Compare with solving column by column
+    for (DenseIndex j = 0; j < gx.cols(); ++j) {
+      VectorValues column;
+      BOOST_FOREACH(const DenseVectorValues::Layout::value_type& key_slot, layout)
+        column.insert(key_slot.first, gx.col(j).segment(key_slot.second.offset, key_slot.second.dim));
+      const VectorValues expected = gbn.backSubstitute(column);
+      const VectorValues expectedTranspose = gbn.backSubstituteTranspose(column);
+      BOOST_FOREACH(const DenseVectorValues::Layout::value_type& key_slot, layout) {
+        EXPECT(assert_equal(expected.at(key_slot.first),
+          Vector(actual.col(j).segment(key_slot.second.offset, key_slot.second.dim))));
+        EXPECT(assert_equal(expectedTranspose.at(key_slot.first),
+          Vector(actualTranspose.col(j).segment(key_slot.second.offset, key_slot.second.dim))));
+      }
+    }
+  }
+}
+
 /* ************************************************************************* */
 // Tests computing Determinant
 TEST( GaussianBayesNet, DeterminantTest )
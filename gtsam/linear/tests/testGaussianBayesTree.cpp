@@ -30,6 +30,9 @@ using namespace boost::assign;
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/linear/GaussianConditional.h>
 
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
 using namespace std;
 using namespace gtsam;
 
@@ -297,6 +300,71 @@ TEST(GaussianBayesTree, ComputeSteepestDescentPointBT) {
   EXPECT(newError < origError);
 }
 
+/* ************************************************************************* */
+namespace {
+void ComputeMarginals(const GaussianBayesTree* bt, size_t n, vector<GaussianConditional::shared_ptr>* marginals) {
+  for (size_t j = 0; j < n; ++j)
+    (*marginals)[j] = bt->marginalFactor(j);
+}
+}
+
+/// Compute marginals from several threads at once, sharing the separator marginal caches
+TEST(GaussianBayesTree, marginalFactor_threads) {
+  // A 10x10 grid of scalar variables, with a prior on the first one
+  const size_t side = 10, n = side * side;
+  const SharedDiagonal unit = noiseModel::Unit::Create(1);
+  const Matrix I = Matrix::Identity(1, 1);
+  GaussianFactorGraph grid;
+  grid += JacobianFactor(0, I, (Vector(1) << 1.0).finished(), unit);
+  for (size_t i = 0; i < side; ++i) {
+    for (size_t j = 0; j < side; ++j) {
+      const Key key = i * side + j;
+      if (j + 1 < side)
+        grid += JacobianFactor(key, -I, key + 1, I, (Vector(1) << 0.1 * key).finished(), unit);
+      if (i + 1 < side)
+        grid += JacobianFactor(key, -I, key + side, 2 * I, (Vector(1) << -0.2).finished(), unit);
+    }
+  }
+  GaussianBayesTree bt = *grid.eliminateMultifrontal(Ordering::Colamd(grid));
+
+  vector<GaussianConditional::shared_ptr> expected(n);
+  ComputeMarginals(&bt, n, &expected);
+  const size_t cached = bt.numCachedSeparatorMarginals();
+  EXPECT(cached > 0);
+
+  bt.deleteCachedShortcuts();
+  LONGS_EQUAL(0, (long)bt.numCachedSeparatorMarginals());
+  vector<vector<GaussianConditional::shared_ptr> > actual(4,
+      vector<GaussianConditional::shared_ptr>(n));
+  boost::thread_group threads;
+  for (size_t t = 0; t < actual.size(); ++t)
+    threads.create_thread(boost::bind(&ComputeMarginals, &bt, n, &actual[t]));
+  threads.join_all();
+
+  LONGS_EQUAL((long)cached, (long)bt.numCachedSeparatorMarginals());
+  for (size_t t = 0; t < actual.size(); ++t)
+    for (size_t j = 0; j < n; ++j)
+      EXPECT(assert_equal(*expected[j], *actual[t][j], 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(GaussianBayesTree, memoryUsage) {
+  GaussianBayesTree bt = *chain.eliminateMultifrontal(chainOrdering);
+  const MemoryUsage usage = bt.memoryUsage();
+
+  // The conditionals of the cliques, with their augmented matrices [R S d]
+  size_t conditionals = 0;
+  BOOST_FOREACH(const GaussianBayesNet::sharedConditional& conditional, bt.toBayesNet()) {
+    conditionals += conditional->memoryUsage();
+    EXPECT(conditional->memoryUsage() > sizeof(double) * conditional->rows() * conditional->cols());
+  }
+  EXPECT_LONGS_EQUAL((long)conditionals, (long)usage["conditionals"]);
+  EXPECT_LONGS_EQUAL((long)bt.size() * sizeof(GaussianBayesTreeClique) + sizeof(GaussianBayesTreeClique::shared_ptr),
+      (long)usage["cliques"]);
+  EXPECT(usage["nodes"] > 0);
+  EXPECT_LONGS_EQUAL((long)(usage["conditionals"] + usage["cliques"] + usage["nodes"]),
+      (long)usage.total());
+}
 
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
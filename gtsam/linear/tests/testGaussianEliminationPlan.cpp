@@ -0,0 +1,120 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testGaussianEliminationPlan.cpp
+ * @brief   Unit tests for GaussianEliminationPlan
+ * @date    Oct 14, 2026
+ */
+
+#include <gtsam/linear/GaussianEliminationPlan.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/linear/VectorValues.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+  // A small grid of 2D variables with relative measurements, anchored at key 0
+  GaussianFactorGraph createGrid(size_t n, double offset) {
+    const SharedDiagonal model = noiseModel::Isotropic::Sigma(2, 0.5);
+    const Matrix I = Matrix::Identity(2, 2);
+    GaussianFactorGraph graph;
+    graph += JacobianFactor(0, I, Vector2(offset, 0.0), model);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        const Key key = i * n + j;
+        if (j + 1 < n)
+          graph += JacobianFactor(key, -I, key + 1, I, Vector2(1.0 + offset * j, 0.0), model);
+        if (i + 1 < n)
+          graph += JacobianFactor(key, -I, key + n, I, Vector2(0.0, 1.0 - offset * i), model);
+      }
+    }
+    return graph;
+  }
+}
+
+/* ************************************************************************* */
+TEST(GaussianEliminationPlan, reuse)
+{
+  const GaussianFactorGraph graph = createGrid(5, 0.0);
+  const GaussianEliminationPlan plan(graph);
+  EXPECT(plan.compatible(graph));
+  EXPECT(assert_equal(Ordering::Colamd(graph), plan.ordering()));
+  EXPECT(plan.nrCliques() > 1);
+
+  // Same Bayes tree as regular multifrontal elimination
+  const GaussianBayesTree expected = *graph.eliminateMultifrontal(plan.ordering());
+  EXPECT(assert_equal(expected, *plan.eliminateMultifrontal(graph)));
+
+  // Re-solve with new numerical values, with stored slots and with a custom elimination function
+  const GaussianFactorGraph other = createGrid(5, 0.3);
+  EXPECT(plan.compatible(other));
+  const VectorValues expectedSolution = other.optimize(plan.ordering());
+  EXPECT(assert_equal(expectedSolution, plan.optimize(other), 1e-9));
+  EXPECT(assert_equal(expectedSolution,
+      plan.eliminateMultifrontal(other, EliminateQR)->optimize(), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(GaussianEliminationPlan, customOrdering)
+{
+  const GaussianFactorGraph graph = createGrid(4, 0.1);
+  const Ordering ordering = Ordering::Natural(graph);
+  const GaussianEliminationPlan plan(graph, ordering);
+  EXPECT(assert_equal(ordering, plan.ordering()));
+  EXPECT(assert_equal(*graph.eliminateMultifrontal(ordering), *plan.eliminateMultifrontal(graph)));
+}
+
+/* ************************************************************************* */
+TEST(GaussianEliminationPlan, relaxedAmalgamation)
+{
+  const GaussianFactorGraph graph = createGrid(5, 0.2);
+  const GaussianEliminationPlan exact(graph);
+  const GaussianEliminationPlan relaxed(graph, Ordering::COLAMD, RelaxedAmalgamation(0.5, 4));
+  EXPECT(relaxed.nrCliques() < exact.nrCliques());
+  EXPECT(assert_equal(exact.optimize(graph), relaxed.optimize(graph), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(GaussianEliminationPlan, incompatible)
+{
+  const GaussianFactorGraph graph = createGrid(3, 0.0);
+  const GaussianEliminationPlan plan(graph);
+
+  // Different number of factors
+  GaussianFactorGraph bigger = graph;
+  bigger += JacobianFactor(1, Matrix::Identity(2, 2), Vector2(0.0, 0.0),
+      noiseModel::Unit::Create(2));
+  EXPECT(!plan.compatible(bigger));
+  CHECK_EXCEPTION(plan.eliminateMultifrontal(bigger), std::invalid_argument);
+
+  // Same number of factors on different keys
+  GaussianFactorGraph rewired = graph;
+  rewired.replace(1, boost::make_shared<JacobianFactor>(0, Matrix::Identity(2, 2), 4,
+      Matrix::Identity(2, 2), Vector2(0.0, 0.0), noiseModel::Unit::Create(2)));
+  EXPECT(!plan.compatible(rewired));
+
+  // Different dimensions
+  GaussianFactorGraph resized = graph;
+  resized.replace(0, boost::make_shared<JacobianFactor>(0, Matrix::Identity(3, 3), Vector3(0.0,
+      0.0, 0.0), noiseModel::Unit::Create(3)));
+  EXPECT(!plan.compatible(resized));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -21,9 +21,12 @@
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/GaussianConditional.h>
 #include <gtsam/linear/GaussianBayesNet.h>
+#include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/inference/VariableSlots.h>
 #include <gtsam/inference/VariableIndex.h>
+#include <gtsam/inference/FactorColoring.h>
 #include <gtsam/base/debug.h>
+#include <gtsam/base/BlockMatrixArena.h>
 #include <gtsam/base/VerticalBlockMatrix.h>
 
 #include <boost/assign/list_of.hpp>
@@ -105,6 +108,64 @@ TEST(GaussianFactorGraph, sparseJacobian) {
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, sparseJacobianCSR) {
+  // Mixed dimensions, a noise model, a HessianFactor, and keys out of key order in a factor
+  GaussianFactorGraph gfg;
+  SharedDiagonal model = noiseModel::Diagonal::Sigmas(Vector2(0.5, 2.0));
+  gfg.add(0, (Matrix(2, 3) << 1., 2., 3., 5., 6., 7.).finished(), Vector2(4., 8.), model);
+  gfg.add(5, (Matrix(2, 2) << 11., 12., 14., 15.).finished(), 0,
+      (Matrix(2, 3) << 9., 10., 0., 0., 0., 1.).finished(), Vector2(13., 16.), model);
+  gfg += HessianFactor(JacobianFactor(3, (Matrix(1, 1) << 2.).finished(), 5,
+      (Matrix(1, 2) << 1., 3.).finished(), (Vector(1) << 1.).finished()));
+
+  Ordering ordering;
+  ordering.push_back(5);
+  ordering.push_back(0);
+  ordering.push_back(3);
+  for (size_t pass = 0; pass < 2; ++pass) {
+    // Key order first, then the given ordering
+    boost::optional<const Ordering&> optionalOrdering;
+    if (pass == 1)
+      optionalOrdering = ordering;
+    const pair<Matrix, Vector> expected = gfg.jacobian(optionalOrdering);
+
+    const pair<GaussianFactorGraph::SparseMatrixCSR, Vector> csr = gfg.sparseJacobianCSR(optionalOrdering);
+    EXPECT(assert_equal(expected.first, Matrix(csr.first.toDense())));
+    EXPECT(assert_equal(expected.second, csr.second));
+
+    const pair<GaussianFactorGraph::SparseMatrixCSC, Vector> csc = gfg.sparseJacobianCSC(optionalOrdering);
+    EXPECT(assert_equal(expected.first, Matrix(csc.first.toDense())));
+    EXPECT(assert_equal(expected.second, csc.second));
+    EXPECT(csc.first.isCompressed());
+    LONGS_EQUAL(csr.first.nonZeros(), csc.first.nonZeros());
+
+    const BlockSparseJacobian blocks = gfg.blockSparseJacobian(optionalOrdering);
+    LONGS_EQUAL(4, blocks.rowOffsets.size());
+    LONGS_EQUAL(5, blocks.rowStarts.back());
+    Matrix actual = Matrix::Zero(blocks.rowOffsets.back(), blocks.colOffsets.back());
+    for (size_t r = 0; r + 1 < blocks.rowStarts.size(); ++r)
+      for (size_t k = blocks.rowStarts[r]; k < blocks.rowStarts[r + 1]; ++k) {
+        const Eigen::Map<const Matrix> block = blocks.block(r, k);
+        actual.block(blocks.rowOffsets[r], blocks.colOffsets[blocks.blockColumns[k]],
+            block.rows(), block.cols()) = block;
+      }
+    EXPECT(assert_equal(expected.first, actual));
+    EXPECT(assert_equal(expected.second, blocks.b));
+  }
+
+  // Null factors are skipped
+  GaussianFactorGraph withNull = gfg;
+  withNull.push_back(GaussianFactor::shared_ptr());
+  EXPECT(assert_equal(Matrix(gfg.sparseJacobianCSR().first.toDense()),
+      Matrix(withNull.sparseJacobianCSR().first.toDense())));
+
+  // The ordering has to contain all variables
+  Ordering incomplete;
+  incomplete.push_back(0);
+  CHECK_EXCEPTION(gfg.sparseJacobianCSR(incomplete), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 TEST(GaussianFactorGraph, matrices) {
   // Create factor graph:
@@ -221,6 +282,29 @@ TEST( GaussianFactorGraph, transposeMultiplication )
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST( GaussianFactorGraph, contiguousErrors )
+{
+  GaussianFactorGraph A = createSimpleGaussianFactorGraph();
+  VectorValues x;
+  x.insert(0, Vector2(1.0, 2.0));
+  x.insert(1, Vector2(-1.0, 0.5));
+  x.insert(2, Vector2(3.0, -2.0));
+
+  // A*x into a preallocated contiguous buffer
+  const Errors expected = A * x;
+  ErrorVector actual(expected);
+  actual.vector().setZero();
+  A.multiplyInPlace(x, actual);
+  EXPECT(assert_equal(ErrorVector(expected), actual));
+
+  // x += alpha*A'*e
+  VectorValues expectedX = x, actualX = x;
+  A.transposeMultiplyAdd(0.5, expected, expectedX);
+  A.transposeMultiplyAdd(0.5, actual, actualX);
+  EXPECT(assert_equal(expectedX, actualX));
+}
+
 /* ************************************************************************* */
 TEST(GaussianFactorGraph, eliminate_empty )
 {
@@ -242,6 +326,51 @@ TEST(GaussianFactorGraph, eliminate_empty )
   EXPECT(assert_equal(*remainingGFG, expectedLF));
 }
 
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, eliminateWithBlockMatrixArena)
+{
+  GaussianFactorGraph gfg = createSimpleGaussianFactorGraph();
+  VectorValues expected = gfg.optimize();
+
+  // Recycling dense storage must not change the solution
+  BlockMatrixArena::SetEnabled(true);
+  VectorValues actual = gfg.eliminateMultifrontal()->optimize();
+  VectorValues actualSequential = gfg.eliminateSequential()->optimize();
+  VectorValues actualQR = gfg.eliminateMultifrontal(boost::none, EliminateQR)->optimize();
+  BlockMatrixArena::SetEnabled(false);
+
+  EXPECT(assert_equal(expected, actual));
+  EXPECT(assert_equal(expected, actualSequential));
+  EXPECT(assert_equal(expected, actualQR));
+  EXPECT_LONGS_EQUAL(0, BlockMatrixArena::CachedBytes());
+}
+
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, optimizeMixedPrecision)
+{
+  // A chain of 3-dimensional variables with random measurements
+  GaussianFactorGraph gfg;
+  const SharedDiagonal model = noiseModel::Isotropic::Sigma(3, 0.1);
+  gfg += JacobianFactor(0, Matrix::Identity(3, 3), Vector::Random(3), model);
+  for (Key j = 1; j < 20; ++j)
+    gfg += JacobianFactor(j - 1, Matrix::Random(3, 3) - 3.0 * Matrix::Identity(3, 3),
+        j, Matrix::Random(3, 3) + 3.0 * Matrix::Identity(3, 3), Vector::Random(3), model);
+  const VectorValues expected = gfg.optimize();
+
+  // Without refinement the solution is only accurate to single precision
+  const VectorValues unrefined = gfg.optimizeMixedPrecision(boost::none, 0);
+  EXPECT(assert_equal(expected, unrefined, 1e-3));
+
+  // Refinement recovers the double precision solution
+  EXPECT(assert_equal(expected, gfg.optimizeMixedPrecision(), 1e-9));
+
+  Ordering ordering = Ordering::Colamd(VariableIndex(gfg));
+  EXPECT(assert_equal(expected, gfg.optimizeMixedPrecision(ordering), 1e-9));
+
+  // Flattening the Bayes tree gives a Bayes net with the same solution
+  EXPECT(assert_equal(expected, gfg.eliminateMultifrontal()->toBayesNet().optimize(), 1e-9));
+}
+
 /* ************************************************************************* */
 TEST( GaussianFactorGraph, matrices2 )
 {
@@ -399,6 +528,90 @@ TEST( GaussianFactorGraph, hessianDiagonal )
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST( GaussianFactorGraph, accumulateLargeGraph )
+{
+  // A chain long enough to be split into several ranges when TBB is enabled
+  GaussianFactorGraph gfg;
+  const size_t n = 300;
+  gfg += JacobianFactor(0, 2 * eye(2), Vector2(1.0, -1.0));
+  for (size_t j = 1; j < n; ++j) {
+    const Matrix2 A = (Matrix2() << 1.0 + 0.01 * j, 0.1, 0.0, 1.0).finished();
+    if (j % 7 == 0)
+      gfg += HessianFactor(JacobianFactor(j - 1, -eye(2), j, A, Vector2(0.1 * j, 0.5)));
+    else
+      gfg += JacobianFactor(j - 1, -eye(2), j, A, Vector2(0.1 * j, 0.5),
+          noiseModel::Isotropic::Sigma(2, 0.5));
+  }
+  GaussianFactorGraph withNull = gfg;
+  withNull.push_back(GaussianFactor::shared_ptr());
+
+  Ordering ordering;
+  VectorValues::Dims dims;
+  VectorValues x0;
+  for (size_t j = 0; j < n; ++j) {
+    ordering.push_back(j);
+    dims[j] = 2;
+    x0.insert(j, Vector2(0.01 * j, -0.02 * j));
+  }
+  Matrix A;
+  Vector b;
+  boost::tie(A, b) = gfg.jacobian(ordering);
+  const Matrix information = A.transpose() * A;
+
+  const VectorValues diagonal = withNull.hessianDiagonal();
+  const map<Key, Matrix> blocks = withNull.hessianBlockDiagonal();
+  LONGS_EQUAL(n, diagonal.size());
+  LONGS_EQUAL(n, blocks.size());
+  for (size_t j = 0; j < n; ++j) {
+    EXPECT(assert_equal(Vector(information.diagonal().segment<2>(2 * j)), diagonal.at(j), 1e-9));
+    EXPECT(assert_equal(Matrix(information.block<2, 2>(2 * j, 2 * j)), blocks.at(j), 1e-9));
+  }
+
+  const Vector x = x0.vector(dims);
+  EXPECT(assert_equal(VectorValues(-A.transpose() * b, dims), withNull.gradientAtZero(), 1e-9));
+
+  // The gradient has the variables of x0 that are not in the graph, as zeros
+  x0.insert(n, Vector2(1.0, 1.0));
+  VectorValues expected(A.transpose() * (A * x - b), dims);
+  expected.insert(n, Vector2::Zero());
+  EXPECT(assert_equal(expected, withNull.gradient(x0), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST( GaussianFactorGraph, multiplyHessianAddColored )
+{
+  GaussianFactorGraph gfg = createGaussianFactorGraphWithHessianFactor();
+  gfg += JacobianFactor(1, 3 * eye(2), 2, eye(2), Vector2(1.0, 0.0),
+      noiseModel::Isotropic::Sigma(2, 0.5));
+  const FactorColoring coloring(gfg);
+  EXPECT(coloring.nrColors() > 1);
+
+  VectorValues x = map_list_of<Key, Vector>
+      (0, Vector2(1,2))
+      (1, Vector2(3,4))
+      (2, Vector2(5,6));
+
+  // y += A'A*x, also into a y that is not zero
+  VectorValues expected = x, actual = x;
+  gfg.multiplyHessianAdd(2.0, x, expected);
+  gfg.multiplyHessianAdd(2.0, x, actual, coloring);
+  EXPECT(assert_equal(expected, actual, 1e-9));
+
+  // x += A'*e, with the errors as a list and contiguous
+  const Errors e = gfg * x;
+  expected = VectorValues::Zero(x);
+  gfg.transposeMultiplyAdd(0.5, e, expected);
+  actual = VectorValues::Zero(x);
+  gfg.transposeMultiplyAdd(0.5, e, actual, coloring);
+  EXPECT(assert_equal(expected, actual, 1e-9));
+
+  const ErrorVector contiguous(e);
+  actual = VectorValues::Zero(x);
+  gfg.transposeMultiplyAdd(0.5, contiguous, actual, coloring);
+  EXPECT(assert_equal(expected, actual, 1e-9));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -462,6 +462,31 @@ TEST(HessianFactor, eliminate2 )
   EXPECT(assert_equal(HessianFactor(expectedLF), *actual_Chol.second, 1.5e-3));
 }
 
+/* ************************************************************************* */
+TEST(HessianFactor, EliminatePreferCholeskyCostModel) {
+  // A wide clique, 40 rows on 300 columns, is cheaper to eliminate with QR
+  vector<pair<Key, Matrix> > terms;
+  for (Key j = 0; j < 10; ++j)
+    terms.push_back(make_pair(j, Matrix(Matrix::Random(40, 30))));
+  GaussianFactorGraph wide;
+  wide += JacobianFactor(terms, Vector(Vector::Random(40)));
+  const Ordering frontal = list_of(0);
+
+  GaussianFactorGraph::EliminationResult actual = EliminatePreferCholesky(wide, frontal);
+  GaussianFactorGraph::EliminationResult expected = EliminateQR(wide, frontal);
+  EXPECT(boost::dynamic_pointer_cast<JacobianFactor>(actual.second));
+  EXPECT(assert_equal(*expected.first, *actual.first, 1e-9));
+
+  // A tall clique, 2000 rows on 100 columns, is cheaper with Cholesky
+  terms.clear();
+  for (Key j = 0; j < 5; ++j)
+    terms.push_back(make_pair(j, Matrix(Matrix::Random(2000, 20))));
+  GaussianFactorGraph tall;
+  tall += JacobianFactor(terms, Vector(Vector::Random(2000)));
+  actual = EliminatePreferCholesky(tall, frontal);
+  EXPECT(boost::dynamic_pointer_cast<HessianFactor>(actual.second));
+}
+
 /* ************************************************************************* */
 TEST(HessianFactor, combine) {
 
@@ -495,6 +520,31 @@ TEST(HessianFactor, combine) {
 
 }
 
+/* ************************************************************************* */
+// Many factors, which are merged in parallel chunks when TBB is enabled
+TEST(HessianFactor, combineMany) {
+  GaussianFactorGraph factors;
+  SharedDiagonal model = noiseModel::Diagonal::Sigmas(Vector2(0.5, 2.0));
+  for (size_t i = 0; i < 1000; ++i) {
+    const double s = 1.0 + 0.001 * i;
+    Matrix A = (Matrix(2, 2) << s, 0.5, -0.25, 2 * s).finished();
+    if (i % 3 == 0)
+      factors += JacobianFactor(i % 4, A, Vector2(s, -s), model);
+    else
+      factors += JacobianFactor(i % 4, A, (i + 1) % 4, -A.transpose(), Vector2(1, s), model);
+  }
+
+  HessianFactor actual(factors);
+  FastVector<Key> keys;
+  for (Key j = 0; j < 4; ++j)
+    keys.push_back(j);
+  EXPECT(assert_container_equality(keys, actual.keys()));
+  const Ordering ordering(keys);
+  const Matrix Ab = factors.augmentedJacobian(ordering);
+  const Matrix expected = Ab.transpose() * Ab;
+  EXPECT(assert_equal(expected, Matrix(actual.matrixObject().full()), 1e-6));
+}
+
 /* ************************************************************************* */
 TEST(HessianFactor, gradientAtZero)
 {
@@ -18,6 +18,7 @@
  */
 
 #include <gtsam/linear/KalmanFilter.h>
+#include <gtsam/linear/FixedKalmanFilter.h>
 #include <gtsam/linear/NoiseModel.h>
 #include <gtsam/base/Testable.h>
 #include <CppUnitLite/TestHarness.h>
@@ -163,6 +164,75 @@ TEST( KalmanFilter, predict ) {
   EXPECT(assert_equal(pa->covariance(), pb->covariance()));
 }
 
+/* ************************************************************************* */
+TEST( KalmanFilter, fixedSize ) {
+
+  // Same dynamics model as above, and a scalar and a 2D measurement
+  Matrix2 F = (Matrix2() << 1.0, 0.1, 0.2, 1.1).finished();
+  Eigen::Matrix<double, 2, 3> B;
+  B << 1.0, 0.1, 0.2, 1.1, 1.2, 0.8;
+  Vector3 u(1.0, 0.0, 2.0);
+  Vector2 sigmasQ(0.1, 0.2);
+  Matrix2 Q = (Matrix2() << 0.02, 0.005, 0.005, 0.03).finished();
+  Eigen::Matrix<double, 1, 2> H1(1.0, 2.0);
+  Vector1 z1, sigmas1;
+  z1 << 2.5;
+  sigmas1 << 0.5;
+  Matrix2 H2 = (Matrix2() << 1.0, 0.0, 0.5, 1.0).finished();
+  Vector2 z2(1.0, 3.0), sigmas2(0.3, 0.4);
+
+  // Run both filters side by side
+  KalmanFilter kf(2);
+  FixedKalmanFilter<2> fkf;
+  KalmanFilter::State p = kf.init(Vector2(1.0, -1.0), noiseModel::Diagonal::Sigmas(sigmasQ));
+  FixedKalmanFilter<2>::State q = fkf.init(Vector2(1.0, -1.0), sigmasQ);
+  EXPECT(assert_equal(p->mean(), Vector(q.mean())));
+  EXPECT(assert_equal(p->information(), Matrix(q.information())));
+
+  p = kf.predict(p, F, B, u, noiseModel::Diagonal::Sigmas(sigmasQ));
+  fkf.predict(q, F, B, u, sigmasQ);
+  EXPECT(assert_equal(p->mean(), Vector(q.mean())));
+  EXPECT(assert_equal(p->covariance(), Matrix(q.covariance())));
+
+  p = kf.update(p, H1, z1, noiseModel::Diagonal::Sigmas(sigmas1));
+  fkf.update(q, H1, z1, sigmas1);
+  EXPECT(assert_equal(p->mean(), Vector(q.mean())));
+  EXPECT(assert_equal(p->covariance(), Matrix(q.covariance())));
+
+  p = kf.predictQ(p, F, B, u, Q);
+  fkf.predictQ(q, F, B, u, Q);
+  EXPECT(assert_equal(p->mean(), Vector(q.mean())));
+  EXPECT(assert_equal(p->covariance(), Matrix(q.covariance())));
+
+  p = kf.updateQ(p, H2, z2, Q);
+  fkf.updateQ(q, H2, z2, Q);
+  EXPECT(assert_equal(p->mean(), Vector(q.mean())));
+  EXPECT(assert_equal(p->covariance(), Matrix(q.covariance())));
+
+  const Matrix2 A0 = -H2 * F, A1 = H2;
+  const Vector2 b = H2 * B * u;
+  p = kf.predict2(p, A0, A1, b, noiseModel::Diagonal::Sigmas(sigmas2));
+  fkf.predict2(q, A0, A1, b, sigmas2);
+  EXPECT(assert_equal(p->mean(), Vector(q.mean())));
+  EXPECT(assert_equal(p->covariance(), Matrix(q.covariance())));
+  LONGS_EQUAL(3, (long)FixedKalmanFilter<2>::step(q));
+  LONGS_EQUAL((long)KalmanFilter::step(p), (long)FixedKalmanFilter<2>::step(q));
+
+  // Full covariance initialization
+  FixedKalmanFilter<2>::State q0 = fkf.init(Vector2(1.0, 2.0), Q);
+  EXPECT(assert_equal(Matrix(Q), Matrix(q0.covariance())));
+  EXPECT(assert_equal(Vector(Vector2(1.0, 2.0)), Vector(q0.mean())));
+
+  // Conversion to and from GaussianDensity
+  KalmanFilter::State density = FixedKalmanFilter<2>::ToDensity(q);
+  LONGS_EQUAL(3, (long)KalmanFilter::step(density));
+  EXPECT(assert_equal(p->mean(), density->mean()));
+  FixedKalmanFilter<2>::State q2 = FixedKalmanFilter<2>::FromDensity(p);
+  EXPECT(assert_equal(Vector(q.mean()), Vector(q2.mean())));
+  EXPECT(assert_equal(Matrix(q.information()), Matrix(q2.information())));
+  CHECK_EXCEPTION(FixedKalmanFilter<3>::FromDensity(p), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 // Test both QR and Cholesky versions in case of a realistic (AHRS) dynamics update
 TEST( KalmanFilter, QRvsCholesky ) {
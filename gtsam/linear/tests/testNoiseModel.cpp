@@ -321,6 +321,52 @@ TEST(NoiseModel, WhitenInPlace)
   EXPECT(assert_equal(expected, A));
 }
 
+/* ************************************************************************* */
+TEST(NoiseModel, WhitenSystem)
+{
+  Matrix A1 = (Matrix(3, 2) << 1, 2, 3, 4, 5, 6).finished();
+  Matrix A2 = (Matrix(3, 1) << 7, 8, 9).finished();
+  Vector b = Vector3(1, 2, 3);
+
+  SharedDiagonal models[] = { Diagonal::Sigmas(Vector3(0.1, 0.2, 0.5)),
+      Isotropic::Sigma(3, 0.5), Unit::Create(3),
+      Constrained::MixedSigmas(Vector3(0.1, 0.0, 0.5)) };
+  BOOST_FOREACH(const SharedDiagonal& model, models) {
+    Matrix actual1 = A1, actual2 = A2;
+    Vector actualb = b;
+    model->WhitenSystem(actual1, actual2, actualb);
+    EXPECT(assert_equal(model->Whiten(A1), actual1));
+    EXPECT(assert_equal(model->Whiten(A2), actual2));
+    EXPECT(assert_equal(model->whiten(b), actualb));
+
+    vector<Matrix> A;
+    A.push_back(A1);
+    A.push_back(A2);
+    actualb = b;
+    model->WhitenSystem(A, actualb);
+    EXPECT(assert_equal(model->Whiten(A1), A[0]));
+    EXPECT(assert_equal(model->Whiten(A2), A[1]));
+    EXPECT(assert_equal(model->whiten(b), actualb));
+  }
+}
+
+/* ************************************************************************* */
+TEST(NoiseModel, robustWeights)
+{
+  const Vector distances = (Vector(7) << 0.0, 0.1, -0.5, 1.0, -2.0, 5.0, 20.0).finished();
+  mEstimator::Base::shared_ptr estimators[] = { mEstimator::Null::Create(),
+      mEstimator::Fair::Create(1.5), mEstimator::Huber::Create(1.5),
+      mEstimator::Cauchy::Create(1.5), mEstimator::Tukey::Create(4.0),
+      mEstimator::Welsh::Create(1.5), mEstimator::GemanMcClure::Create(1.5),
+      mEstimator::DCS::Create(1.5) };
+  BOOST_FOREACH(const mEstimator::Base::shared_ptr& estimator, estimators) {
+    const Vector actual = estimator->weights(distances);
+    LONGS_EQUAL(distances.size(), actual.size());
+    for (DenseIndex i = 0; i < distances.size(); ++i)
+      DOUBLES_EQUAL(estimator->weight(distances(i)), actual(i), 1e-12);
+  }
+}
+
 /* ************************************************************************* */
 TEST(NoiseModel, robustFunctionHuber)
 {
@@ -0,0 +1,110 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testOutOfCoreBayesTree.cpp
+ * @brief   Unit tests for OutOfCoreBayesTree
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/linear/OutOfCoreBayesTree.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/inferenceExceptions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/assign/std/vector.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <cstdio>
+
+using namespace std;
+using namespace gtsam;
+using namespace boost::assign;
+
+namespace {
+  // A small grid of 2D variables with relative measurements, anchored at key 0
+  GaussianFactorGraph createGrid(size_t n) {
+    const SharedDiagonal model = noiseModel::Isotropic::Sigma(2, 0.5);
+    const Matrix I = Matrix::Identity(2, 2);
+    GaussianFactorGraph graph;
+    graph += JacobianFactor(0, I, Vector2(0.5, 0.0), model);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        const Key key = i * n + j;
+        if (j + 1 < n)
+          graph += JacobianFactor(key, -I, key + 1, I, Vector2(1.0 + 0.1 * j, 0.0), model);
+        if (i + 1 < n)
+          graph += JacobianFactor(key, -I, key + n, I, Vector2(0.0, 1.0 - 0.1 * i), model);
+      }
+    }
+    return graph;
+  }
+
+  const string filename = (boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path("testOutOfCoreBayesTree-%%%%-%%%%.bin")).string();
+}
+
+/* ************************************************************************* */
+TEST(OutOfCoreBayesTree, optimize)
+{
+  const GaussianFactorGraph graph = createGrid(5);
+  const Ordering ordering = Ordering::Colamd(graph);
+  const GaussianBayesTree expected = *graph.eliminateMultifrontal(ordering);
+
+  const OutOfCoreBayesTree actual(graph, ordering, filename);
+  EXPECT_LONGS_EQUAL(expected.size(), actual.nrCliques());
+  EXPECT_LONGS_EQUAL(boost::filesystem::file_size(filename), actual.fileBytes());
+
+  // The cliques are stored in post-order, so the last one is the root clique
+  const GaussianConditional::shared_ptr root = actual.conditional(actual.nrCliques() - 1);
+  EXPECT(assert_equal(*expected.roots().front()->conditional(), *root, 1e-9));
+  EXPECT(assert_equal(expected.optimize(), actual.optimize(), 1e-9));
+
+  // Open the file again
+  const OutOfCoreBayesTree reopened(filename);
+  EXPECT_LONGS_EQUAL(actual.nrCliques(), reopened.nrCliques());
+  EXPECT(assert_equal(expected.optimize(), reopened.optimize(), 1e-9));
+  remove(filename.c_str());
+}
+
+/* ************************************************************************* */
+TEST(OutOfCoreBayesTree, constrained)
+{
+  // QR keeps the constrained noise model in the conditionals, which is stored with the cliques
+  GaussianFactorGraph graph = createGrid(3);
+  graph += JacobianFactor(8, Matrix::Identity(2, 2), Vector2(2.0, 2.0),
+      noiseModel::Constrained::All(2));
+  const Ordering ordering = Ordering::Colamd(graph);
+  const OutOfCoreBayesTree actual(graph, ordering, filename, EliminateQR);
+  EXPECT(assert_equal(graph.eliminateMultifrontal(ordering, EliminateQR)->optimize(),
+      actual.optimize(), 1e-9));
+  remove(filename.c_str());
+}
+
+/* ************************************************************************* */
+TEST(OutOfCoreBayesTree, incompleteOrdering)
+{
+  const GaussianFactorGraph graph = createGrid(2);
+  Ordering ordering;
+  ordering += Key(0), Key(1);
+  CHECK_EXCEPTION(OutOfCoreBayesTree(graph, ordering, filename), InconsistentEliminationRequested);
+  remove(filename.c_str());
+  CHECK_EXCEPTION(OutOfCoreBayesTree("/nonexistent/directory/cliques.bin"), std::exception);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -134,6 +134,32 @@ TEST(RegularHessianFactor, Constructors)
   }
 }
 
+/* ************************************************************************* */
+TEST(RegularHessianFactor, Uninitialized)
+{
+  FastVector<Key> keys;
+  keys += 0, 1, 3;
+  boost::shared_ptr<RegularHessianFactor<2> > factor =
+      RegularHessianFactor<2>::Uninitialized(keys);
+  EXPECT(keys == factor->keys());
+  EXPECT_LONGS_EQUAL(4, factor->matrixObject().nBlocks());
+  EXPECT_LONGS_EQUAL(7, factor->matrixObject().rows());
+
+  // Fill the storage in place, here with the information of [I I I] * x = [1;2]
+  SymmetricBlockMatrix& info = factor->matrixObject();
+  const Vector2 b(1, 2);
+  for (DenseIndex i = 0; i < 3; ++i) {
+    for (DenseIndex j = i; j < 3; ++j)
+      info(i, j) = I_2x2;
+    info(i, 3) = b;
+  }
+  info(3, 3)(0, 0) = b.squaredNorm();
+
+  vector<pair<Key, Matrix> > terms;
+  terms += make_pair(0, I_2x2), make_pair(1, I_2x2), make_pair(3, I_2x2);
+  EXPECT(assert_equal(RegularHessianFactor<2>(RegularJacobianFactor<2>(terms, b)), *factor));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
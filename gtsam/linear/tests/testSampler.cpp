@@ -17,6 +17,9 @@
 #include <CppUnitLite/TestHarness.h>
 
 #include <gtsam/linear/Sampler.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/GaussianBayesNet.h>
+#include <gtsam/inference/Ordering.h>
 
 using namespace gtsam;
 
@@ -37,6 +40,75 @@ TEST(testSampler, basic) {
   EXPECT(assert_equal(sampler2.sample(), sampler3.sample(), tol));
 }
 
+/* ************************************************************************* */
+TEST(testSampler, batch) {
+  Vector sigmas = Vector3(1.0, 0.1, 0.0);
+  Sampler sampler1(sigmas, 7), sampler2(sigmas, 7);
+
+  const size_t n = 20000;
+  Matrix samples = sampler1.sample(n);
+  LONGS_EQUAL(3, samples.rows());
+  LONGS_EQUAL(n, samples.cols());
+  EXPECT(assert_equal(samples, sampler2.sample(n)));
+  EXPECT(samples.row(2).isZero());
+
+  // the next batch is different
+  EXPECT(!sampler1.sample(n).isApprox(samples));
+
+  // sample statistics
+  Vector mean = samples.rowwise().mean();
+  Matrix centered = samples.colwise() - mean;
+  Matrix covariance = centered * centered.transpose() / (n - 1);
+  EXPECT(assert_equal(Vector3(0.0, 0.0, 0.0), mean, 0.03));
+  EXPECT(assert_equal(Matrix(Vector3(1.0, 0.01, 0.0).asDiagonal()), covariance, 0.05));
+  EXPECT_DOUBLES_EQUAL(0.01, covariance(1, 1), 5e-4);
+}
+
+/* ************************************************************************* */
+TEST(testSampler, bayesNet) {
+  // prior on x0 and a relative measurement between x0 and x1
+  GaussianFactorGraph graph;
+  graph += JacobianFactor(0, 2.0 * Matrix::Identity(2, 2), Vector2(1.0, -2.0),
+      noiseModel::Unit::Create(2));
+  graph += JacobianFactor(0, -Matrix::Identity(2, 2), 1, (Matrix(2, 2) << 1.0, 0.5, 0.0, 1.0).finished(),
+      Vector2(0.5, 0.5), noiseModel::Unit::Create(2));
+  Ordering ordering;
+  ordering += 0, 1;
+  GaussianBayesNet::shared_ptr bayesNet = graph.eliminateSequential(ordering);
+
+  // the rows are laid out as in the dense layout
+  DenseVectorValues::Layout layout = bayesNet->denseLayout();
+  VectorValues solution = bayesNet->optimize();
+  Vector expectedMean(4);
+  expectedMean.segment(layout.at(0).offset, 2) = solution.at(0);
+  expectedMean.segment(layout.at(1).offset, 2) = solution.at(1);
+  Matrix information = graph.hessian(ordering).first;
+  Matrix expectedCovariance = information.inverse();
+  if (layout.at(0).offset != 0) {
+    Eigen::PermutationMatrix<4> swap;
+    swap.indices() << 2, 3, 0, 1;
+    expectedCovariance = swap * expectedCovariance * swap.transpose();
+  }
+
+  const size_t n = 50000;
+  Sampler sampler(11);
+  Matrix samples = sampler.sample(*bayesNet, n);
+  LONGS_EQUAL(4, samples.rows());
+  LONGS_EQUAL(n, samples.cols());
+
+  Vector mean = samples.rowwise().mean();
+  Matrix centered = samples.colwise() - mean;
+  Matrix covariance = centered * centered.transpose() / (n - 1);
+  EXPECT(assert_equal(expectedMean, mean, 0.02));
+  EXPECT(assert_equal(expectedCovariance, covariance, 0.03));
+
+  // conditionals with non-unit noise models are rejected
+  GaussianBayesNet scaled;
+  scaled += GaussianConditional(0, Vector2(1.0, 2.0), Matrix::Identity(2, 2),
+      noiseModel::Isotropic::Sigma(2, 2.0));
+  CHECK_EXCEPTION(sampler.sample(scaled, 10), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
@@ -0,0 +1,102 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testSchurComplementSolver.cpp
+ * @brief   Unit tests for SchurComplementSolver
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/linear/SchurComplementSolver.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+using symbol_shorthand::C;
+using symbol_shorthand::L;
+
+namespace {
+  // A linearized bundle adjustment problem: 6-dimensional cameras, each seeing several
+  // 3-dimensional landmarks, with 2-dimensional measurements and a prior on every camera
+  GaussianFactorGraph createBundleAdjustment(size_t nrCameras, size_t nrLandmarks) {
+    const SharedDiagonal pixel = noiseModel::Isotropic::Sigma(2, 1.0);
+    const SharedDiagonal prior = noiseModel::Isotropic::Sigma(6, 10.0);
+    GaussianFactorGraph graph;
+    for (size_t c = 0; c < nrCameras; ++c)
+      graph += JacobianFactor(C(c), Matrix::Identity(6, 6), Vector::Constant(6, 0.1 * c), prior);
+    for (size_t l = 0; l < nrLandmarks; ++l) {
+      for (size_t c = 0; c < nrCameras; ++c) {
+        if ((l + c) % 3 == 0)
+          continue; // Not every camera sees every landmark
+        Matrix Ac = Matrix::Zero(2, 6), Al = Matrix::Zero(2, 3);
+        for (int i = 0; i < 2; ++i) {
+          for (int j = 0; j < 6; ++j)
+            Ac(i, j) = sin(1.0 + i + 2.0 * j + 3.0 * c + 5.0 * l);
+          for (int j = 0; j < 3; ++j)
+            Al(i, j) = cos(2.0 + 1.3 * (i + 1) * (j + 1) + 7.0 * c + 11.0 * l);
+        }
+        graph += JacobianFactor(C(c), Ac, L(l), Al, Vector2(0.1 * l, -0.2 * c), pixel);
+      }
+    }
+    return graph;
+  }
+}
+
+/* ************************************************************************* */
+TEST(SchurComplementSolver, optimize) {
+  const GaussianFactorGraph graph = createBundleAdjustment(4, 10);
+  const VectorValues expected = graph.optimize();
+
+  // Detected from the key types
+  const KeySet landmarks = SchurComplementSolver::DetectEliminatedKeys(graph);
+  EXPECT_LONGS_EQUAL(10, landmarks.size());
+  EXPECT(landmarks.exists(L(0)));
+  EXPECT(!landmarks.exists(C(0)));
+
+  // With a COLAMD ordering of the reduced system
+  EXPECT(assert_equal(expected, SchurComplementSolver(landmarks).optimize(graph), 1e-8));
+
+  // With a given ordering of the cameras, and with QR
+  Ordering cameras;
+  for (size_t c = 0; c < 4; ++c)
+    cameras.push_back(C(c));
+  EXPECT(assert_equal(expected, SchurComplementSolver(landmarks, cameras).optimize(graph), 1e-8));
+  EXPECT(assert_equal(expected,
+      SchurComplementSolver(landmarks, cameras).optimize(graph, EliminateQR), 1e-8));
+}
+
+/* ************************************************************************* */
+TEST(SchurComplementSolver, dependentKeys) {
+  GaussianFactorGraph graph = createBundleAdjustment(2, 3);
+  graph += JacobianFactor(L(0), Matrix::Identity(3, 3), L(1), -Matrix::Identity(3, 3),
+      Vector3::Zero(), noiseModel::Unit::Create(3));
+
+  // The landmarks are no longer independent, so only the cameras could be eliminated first
+  const KeySet detected = SchurComplementSolver::DetectEliminatedKeys(graph);
+  EXPECT(!detected.exists(L(0)));
+
+  KeySet landmarks;
+  landmarks.insert(L(0));
+  landmarks.insert(L(1));
+  CHECK_EXCEPTION(SchurComplementSolver(landmarks).optimize(graph), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
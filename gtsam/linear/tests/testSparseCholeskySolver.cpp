@@ -0,0 +1,107 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testSparseCholeskySolver.cpp
+ * @brief   Unit tests for SparseCholeskySolver
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/linear/SparseCholeskySolver.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/linear/linearExceptions.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+  // A chain of 3-dimensional variables with loop closures, a 2-dimensional variable hanging
+  // off the chain, and a Hessian factor on two of the variables.  The right-hand sides are
+  // scaled by \c scale.
+  GaussianFactorGraph createGraph(double scale = 1.0) {
+    const SharedDiagonal model = noiseModel::Isotropic::Sigma(3, 0.5);
+    GaussianFactorGraph graph;
+    graph += JacobianFactor(0, Matrix::Identity(3, 3), Vector3(0.1, 0.2, 0.3) * scale, model);
+    for (Key j = 0; j + 1 < 8; ++j) {
+      Matrix A1(3, 3), A2(3, 3);
+      for (int r = 0; r < 3; ++r)
+        for (int c = 0; c < 3; ++c) {
+          A1(r, c) = sin(1.0 + r + 2.0 * c + 3.0 * j);
+          A2(r, c) = (r == c ? 2.0 : 0.0) + 0.1 * cos(r + c + j);
+        }
+      graph += JacobianFactor(j, A1, j + 1, A2, Vector3(1.0, -0.5, 0.25 * j) * scale, model);
+    }
+    graph += JacobianFactor(1, Matrix::Identity(3, 3), 6, -Matrix::Identity(3, 3),
+        Vector3::Zero(), model);
+    Matrix B = Matrix::Zero(2, 3);
+    B(0, 0) = 1.0;
+    B(1, 2) = 1.0;
+    graph += JacobianFactor(4, B, 10, Matrix::Identity(2, 2), Vector2(0.3, -0.3) * scale,
+        noiseModel::Unit::Create(2));
+    graph += HessianFactor(JacobianFactor(3, 2.0 * Matrix::Identity(3, 3), 5,
+        Matrix::Identity(3, 3), Vector3(0.5, 0.5, 0.5) * scale, noiseModel::Unit::Create(3)));
+    return graph;
+  }
+}
+
+/* ************************************************************************* */
+TEST(SparseCholeskySolver, optimize) {
+  const GaussianFactorGraph graph = createGraph();
+  const Ordering ordering = Ordering::Colamd(graph);
+  SparseCholeskySolver solver(graph, ordering);
+  EXPECT(assert_equal(ordering, solver.ordering()));
+  EXPECT(assert_equal(graph.optimize(), solver.optimize(graph), 1e-9));
+
+  // Reused with new numbers, and in a different ordering
+  const GaussianFactorGraph scaled = createGraph(-2.0);
+  EXPECT(solver.compatible(scaled));
+  EXPECT(assert_equal(scaled.optimize(), solver.optimize(scaled), 1e-9));
+  EXPECT(assert_equal(scaled.optimize(),
+      SparseCholeskySolver(scaled, Ordering::Natural(scaled)).optimize(scaled), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(SparseCholeskySolver, errors) {
+  GaussianFactorGraph graph = createGraph();
+  SparseCholeskySolver solver(graph, Ordering::Colamd(graph));
+
+  // A different structure
+  GaussianFactorGraph extended = graph;
+  extended += JacobianFactor(0, Matrix::Identity(3, 3), 7, Matrix::Identity(3, 3),
+      Vector3::Zero(), noiseModel::Unit::Create(3));
+  EXPECT(!solver.compatible(extended));
+  CHECK_EXCEPTION(solver.optimize(extended), std::invalid_argument);
+
+  // An ordering that misses a variable
+  Ordering partial = Ordering::Colamd(graph);
+  partial.pop_back();
+  CHECK_EXCEPTION(SparseCholeskySolver(graph, partial), std::invalid_argument);
+
+  // A variable that is not determined
+  GaussianFactorGraph underdetermined;
+  underdetermined += JacobianFactor(0, Matrix::Identity(2, 2), Vector2(1.0, 2.0),
+      noiseModel::Unit::Create(2));
+  underdetermined += JacobianFactor(0, Matrix::Zero(2, 2), 1, Matrix::Zero(2, 2),
+      Vector2::Zero(), noiseModel::Unit::Create(2));
+  SparseCholeskySolver singular(underdetermined, Ordering::Natural(underdetermined));
+  CHECK_EXCEPTION(singular.optimize(underdetermined), IndeterminantLinearSystemException);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
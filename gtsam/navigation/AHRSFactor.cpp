@@ -59,6 +59,19 @@ void PreintegratedAhrsMeasurements::integrateMeasurement(
   preintMeasCov_ = Fr * preintMeasCov_ * Fr.transpose() + p().gyroscopeCovariance * deltaT;
 }
 
+//------------------------------------------------------------------------------
+void PreintegratedAhrsMeasurements::integrateMeasurements(
+    const Matrix& measuredOmegas, const Vector& dts) {
+  PreintegratedRotation::integrateMeasurements(measuredOmegas, biasHat_, dts,
+      &preintMeasCov_);
+}
+
+//------------------------------------------------------------------------------
+void PreintegratedAhrsMeasurements::integrateMeasurements(
+    const Matrix& measuredOmegas, double dt) {
+  integrateMeasurements(measuredOmegas, Vector::Constant(measuredOmegas.rows(), dt));
+}
+
 //------------------------------------------------------------------------------
 Vector3 PreintegratedAhrsMeasurements::predict(const Vector3& bias,
     OptionalJacobian<3,3> H) const {
@@ -75,6 +75,16 @@ class GTSAM_EXPORT PreintegratedAhrsMeasurements : public PreintegratedRotation
    */
   void integrateMeasurement(const Vector3& measuredOmega, double deltaT);
 
+  /**
+   * Add a window of gyroscope measurements, the same as integrateMeasurement on each in turn.
+   * @param measuredOmegas n*3 matrix with a measured angular velocity in each row
+   * @param dts Time interval between each measurement and the previous one
+   */
+  void integrateMeasurements(const Matrix& measuredOmegas, const Vector& dts);
+
+  /// integrateMeasurements at a constant rate
+  void integrateMeasurements(const Matrix& measuredOmegas, double dt);
+
   /// Predict bias-corrected incremental rotation
   /// TODO: The matrix Hbias is the derivative of predict? Unit-test?
   Vector3 predict(const Vector3& bias, OptionalJacobian<3,3> H = boost::none) const;
@@ -20,8 +20,14 @@
  **/
 
 #include <gtsam/navigation/CombinedImuFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
 
 /* External or standard includes */
+#include <boost/array.hpp>
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 #include <ostream>
 
 namespace gtsam {
@@ -48,6 +54,37 @@ bool PreintegratedCombinedMeasurements::equals(
 void PreintegratedCombinedMeasurements::resetIntegration() {
   PreintegrationBase::resetIntegration();
   preintMeasCov_.setZero();
+  measurements_.clear();
+}
+
+//------------------------------------------------------------------------------
+void PreintegratedCombinedMeasurements::keepMeasurements(double biasThreshold) {
+  if (biasThreshold <= 0)
+    throw std::invalid_argument(
+        "PreintegratedCombinedMeasurements::keepMeasurements: threshold must be positive");
+  if (deltaTij_ != 0)
+    throw std::logic_error(
+        "PreintegratedCombinedMeasurements::keepMeasurements: measurements were already integrated");
+  biasThreshold_ = biasThreshold;
+}
+
+//------------------------------------------------------------------------------
+bool PreintegratedCombinedMeasurements::needsRepreintegration(
+    const imuBias::ConstantBias& bias) const {
+  return keepsMeasurements()
+      && (bias.vector() - biasHat_.vector()).norm() > biasThreshold_;
+}
+
+//------------------------------------------------------------------------------
+void PreintegratedCombinedMeasurements::repreintegrate(
+    const imuBias::ConstantBias& biasHat) {
+  std::vector<Vector7> measurements;
+  measurements.swap(measurements_);
+  biasHat_ = biasHat;
+  resetIntegration();
+  measurements_.reserve(measurements.size());
+  BOOST_FOREACH(const Vector7& m, measurements)
+    integrateMeasurement(m.head<3>(), m.segment<3>(3), m(6));
 }
 
 //------------------------------------------------------------------------------
@@ -68,6 +105,12 @@ void PreintegratedCombinedMeasurements::resetIntegration() {
 void PreintegratedCombinedMeasurements::integrateMeasurement(
     const Vector3& measuredAcc, const Vector3& measuredOmega, double deltaT) {
 
+  if (keepsMeasurements()) {
+    Vector7 m;
+    m << measuredAcc, measuredOmega, deltaT;
+    measurements_.push_back(m);
+  }
+
   const Matrix3 dRij = deltaXij_.R(); // expensive when quaternion
 
   // Update preintegrated measurements.
@@ -124,7 +167,7 @@ PreintegratedCombinedMeasurements::PreintegratedCombinedMeasurements(
     const Matrix3& measuredOmegaCovariance,
     const Matrix3& integrationErrorCovariance, const Matrix3& biasAccCovariance,
     const Matrix3& biasOmegaCovariance, const Matrix6& biasAccOmegaInit,
-    const bool use2ndOrderIntegration) {
+    const bool use2ndOrderIntegration) : biasThreshold_(0) {
   if (!use2ndOrderIntegration)
     throw("PreintegratedImuMeasurements no longer supports first-order integration: it incorrectly compensated for gravity");
   biasHat_ = biasHat;
@@ -141,13 +184,97 @@ PreintegratedCombinedMeasurements::PreintegratedCombinedMeasurements(
 }
 //------------------------------------------------------------------------------
 // CombinedImuFactor methods
+//------------------------------------------------------------------------------
+struct CombinedImuFactor::Repreintegration {
+  boost::mutex mutex;
+  boost::shared_ptr<const PreintegratedCombinedMeasurements> latest; ///< null until one finished
+  boost::thread worker;
+  bool running;
+
+  Repreintegration() : running(false) {}
+
+  ~Repreintegration() {
+    // The worker itself releases the last reference if the factor went away meanwhile
+    if (worker.joinable()) {
+      if (worker.get_id() == boost::this_thread::get_id())
+        worker.detach();
+      else
+        worker.join();
+    }
+  }
+
+  /// Re-integrate a copy of pim at bias, and publish it if the factor still exists
+  static void Run(const boost::weak_ptr<Repreintegration>& weak,
+      PreintegratedCombinedMeasurements pim, const imuBias::ConstantBias& bias) {
+    pim.repreintegrate(bias);
+    boost::shared_ptr<Repreintegration> state = weak.lock();
+    if (!state)
+      return;
+    boost::mutex::scoped_lock lock(state->mutex);
+    state->latest = boost::make_shared<const PreintegratedCombinedMeasurements>(pim);
+    state->running = false;
+  }
+};
+
 //------------------------------------------------------------------------------
 CombinedImuFactor::CombinedImuFactor(
     Key pose_i, Key vel_i, Key pose_j, Key vel_j, Key bias_i, Key bias_j,
     const PreintegratedCombinedMeasurements& pim)
     : Base(noiseModel::Gaussian::Covariance(pim.preintMeasCov_), pose_i, vel_i,
            pose_j, vel_j, bias_i, bias_j),
-      _PIM_(pim) {}
+      _PIM_(pim) {
+  initRepreintegration();
+}
+
+//------------------------------------------------------------------------------
+void CombinedImuFactor::initRepreintegration() {
+  if (_PIM_.keepsMeasurements())
+    repreintegration_ = boost::make_shared<Repreintegration>();
+  else
+    repreintegration_.reset();
+}
+
+//------------------------------------------------------------------------------
+boost::shared_ptr<const PreintegratedCombinedMeasurements> CombinedImuFactor::repreintegrated(
+    const imuBias::ConstantBias& bias_i) const {
+  if (!repreintegration_)
+    return boost::shared_ptr<const PreintegratedCombinedMeasurements>();
+  Repreintegration& state = *repreintegration_;
+  boost::mutex::scoped_lock lock(state.mutex);
+  const PreintegratedCombinedMeasurements& latest = state.latest ? *state.latest : _PIM_;
+  if (!state.running && latest.needsRepreintegration(bias_i)) {
+    // The previous worker, if any, has published its result and is done with the mutex
+    if (state.worker.joinable())
+      state.worker.join();
+    state.running = true;
+    state.worker = boost::thread(boost::bind(&Repreintegration::Run,
+        boost::weak_ptr<Repreintegration>(repreintegration_), latest, bias_i));
+  }
+  return state.latest;
+}
+
+//------------------------------------------------------------------------------
+PreintegratedCombinedMeasurements CombinedImuFactor::latestPreintegratedMeasurements() const {
+  if (repreintegration_) {
+    boost::mutex::scoped_lock lock(repreintegration_->mutex);
+    if (repreintegration_->latest)
+      return *repreintegration_->latest;
+  }
+  return _PIM_;
+}
+
+//------------------------------------------------------------------------------
+void CombinedImuFactor::waitForRepreintegration() const {
+  if (!repreintegration_)
+    return;
+  boost::thread worker;
+  {
+    boost::mutex::scoped_lock lock(repreintegration_->mutex);
+    worker.swap(repreintegration_->worker);
+  }
+  if (worker.joinable())
+    worker.join();
+}
 
 //------------------------------------------------------------------------------
 gtsam::NonlinearFactor::shared_ptr CombinedImuFactor::clone() const {
@@ -188,8 +315,13 @@ Vector CombinedImuFactor::evaluateError(const Pose3& pose_i,
   Matrix96 D_r_pose_i, D_r_pose_j, D_r_bias_i;
   Matrix93 D_r_vel_i, D_r_vel_j;
 
+  // use the latest re-integration, if any, and start a new one if bias_i moved too far
+  const boost::shared_ptr<const PreintegratedCombinedMeasurements> latest =
+      repreintegrated(bias_i);
+  const PreintegratedCombinedMeasurements& pim = latest ? *latest : _PIM_;
+
   // error wrt preintegrated measurements
-  Vector9 r_Rpv = _PIM_.computeErrorAndJacobians(pose_i, vel_i, pose_j, vel_j, bias_i,
+  Vector9 r_Rpv = pim.computeErrorAndJacobians(pose_i, vel_i, pose_j, vel_j, bias_i,
       H1 ? &D_r_pose_i : 0, H2 ? &D_r_vel_i : 0, H3 ? &D_r_pose_j : 0,
       H4 ? &D_r_vel_j : 0, H5 ? &D_r_bias_i : 0);
 
@@ -237,6 +369,61 @@ Vector CombinedImuFactor::evaluateError(const Pose3& pose_i,
   return r;
 }
 
+//------------------------------------------------------------------------------
+boost::shared_ptr<GaussianFactor> CombinedImuFactor::linearize(const Values& x) const {
+  // Only Gaussian noise models are whitened here, constrained and robust ones are not
+  const noiseModel::Gaussian* gaussian =
+      dynamic_cast<const noiseModel::Gaussian*>(noiseModel_.get());
+  if (!gaussian || gaussian->isConstrained())
+    return Base::linearize(x);
+
+  // Only linearize if the factor is active
+  if (!active(x))
+    return boost::shared_ptr<JacobianFactor>();
+
+  const imuBias::ConstantBias& bias_i = x.at<imuBias::ConstantBias>(key5());
+  const imuBias::ConstantBias& bias_j = x.at<imuBias::ConstantBias>(key6());
+
+  // Same as evaluateError, but with the Jacobians on the stack
+  Matrix96 D_r_pose_i, D_r_pose_j, D_r_bias_i;
+  Matrix93 D_r_vel_i, D_r_vel_j;
+  const boost::shared_ptr<const PreintegratedCombinedMeasurements> latest =
+      repreintegrated(bias_i);
+  const PreintegratedCombinedMeasurements& pim = latest ? *latest : _PIM_;
+  const Vector9 r_Rpv = pim.computeErrorAndJacobians(x.at<Pose3>(key1()),
+      x.at<Vector3>(key2()), x.at<Pose3>(key3()), x.at<Vector3>(key4()), bias_i,
+      D_r_pose_i, D_r_vel_i, D_r_pose_j, D_r_vel_j, D_r_bias_i);
+  Matrix6 Hbias_i, Hbias_j;
+  const Vector6 fbias = traits<imuBias::ConstantBias>::Between(bias_j, bias_i,
+      Hbias_j, Hbias_i).vector();
+
+  // Fill the blocks of [A b], the bias random walk only depends on the biases
+  static const boost::array<DenseIndex, 6> dims = {{ 6, 3, 6, 3, 6, 6 }};
+  JacobianFactor* factor = new JacobianFactor(keys(), dims, 15);
+  boost::shared_ptr<GaussianFactor> result(factor);
+  VerticalBlockMatrix& Ab = factor->Ab_;
+  Ab.matrix().bottomLeftCorner<6, 18>().setZero();
+  Ab(0).topRows<9>() = D_r_pose_i;
+  Ab(1).topRows<9>() = D_r_vel_i;
+  Ab(2).topRows<9>() = D_r_pose_j;
+  Ab(3).topRows<9>() = D_r_vel_j;
+  Ab(4).topRows<9>() = D_r_bias_i;
+  Ab(4).bottomRows<6>() = Hbias_i;
+  Ab(5).topRows<9>().setZero();
+  Ab(5).bottomRows<6>() = Hbias_j;
+  Ab(6).topRows<9>() = -r_Rpv;
+  Ab(6).bottomRows<6>() = -fbias;
+
+  // Whiten [A b] with the square root information, as one fixed-size product
+  if (!gaussian->isUnit()) {
+    typedef Eigen::Matrix<double, 15, 15> Matrix15;
+    const Matrix15 R = gaussian->R();
+    Eigen::Map<Eigen::Matrix<double, 15, 31> > system(Ab.matrix().data());
+    system = R * system;
+  }
+  return result;
+}
+
 //------------------------------------------------------------------------------
 CombinedImuFactor::CombinedImuFactor(
     Key pose_i, Key vel_i, Key pose_j, Key vel_j, Key bias_i, Key bias_j,
@@ -253,6 +440,7 @@ CombinedImuFactor::CombinedImuFactor(
   p->body_P_sensor = body_P_sensor;
   p->use2ndOrderCoriolis = use2ndOrderCoriolis;
   _PIM_.p_ = p;
+  initRepreintegration();
 }
 //------------------------------------------------------------------------------
 void CombinedImuFactor::Predict(const Pose3& pose_i, const Vector3& vel_i,
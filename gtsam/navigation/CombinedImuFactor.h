@@ -26,6 +26,9 @@
 #include <gtsam/navigation/PreintegrationBase.h>
 #include <gtsam/base/Matrix.h>
 
+#include <boost/serialization/vector.hpp>
+#include <vector>
+
 namespace gtsam {
 
 /*
@@ -108,7 +111,13 @@ public:
    */
   Eigen::Matrix<double, 15, 15> preintMeasCov_;
 
-  PreintegratedCombinedMeasurements() {}
+  /// Raw measurements [acc; omega; deltaT], only kept if biasThreshold_ > 0
+  std::vector<Vector7> measurements_;
+
+  /// Bias change beyond which to re-integrate the raw measurements, 0 if they are not kept
+  double biasThreshold_;
+
+  PreintegratedCombinedMeasurements() : biasThreshold_(0) {}
 
   friend class CombinedImuFactor;
 
@@ -119,7 +128,7 @@ public:
    */
   PreintegratedCombinedMeasurements(const boost::shared_ptr<Params>& p,
                                     const imuBias::ConstantBias& biasHat)
-      : PreintegrationBase(p, biasHat) {
+      : PreintegrationBase(p, biasHat), biasThreshold_(0) {
     preintMeasCov_.setZero();
   }
 
@@ -147,6 +156,26 @@ public:
   void integrateMeasurement(const Vector3& measuredAcc,
       const Vector3& measuredOmega, double deltaT);
 
+  /**
+   * Keep the raw measurements integrated from now on, so that they can be re-integrated when the
+   * bias estimate moves too far from biasHat for the first-order bias correction to hold.
+   * Must be called before the first measurement is integrated.
+   * @param biasThreshold norm of the bias change beyond which to re-integrate
+   */
+  void keepMeasurements(double biasThreshold);
+
+  /// Whether the raw measurements are kept for re-integration
+  bool keepsMeasurements() const { return biasThreshold_ > 0; }
+
+  /// The raw measurements kept, one [acc; omega; deltaT] per measurement
+  const std::vector<Vector7>& measurements() const { return measurements_; }
+
+  /// Whether the given bias is too far from biasHat for the first-order bias correction
+  bool needsRepreintegration(const imuBias::ConstantBias& bias) const;
+
+  /// Integrate the kept raw measurements again, from scratch, with the given bias estimate
+  void repreintegrate(const imuBias::ConstantBias& biasHat);
+
   /// methods to access class variables
   Matrix preintMeasCov() const { return preintMeasCov_; }
 
@@ -166,6 +195,8 @@ public:
   void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
     ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(PreintegrationBase);
     ar& BOOST_SERIALIZATION_NVP(preintMeasCov_);
+    ar& BOOST_SERIALIZATION_NVP(measurements_);
+    ar& BOOST_SERIALIZATION_NVP(biasThreshold_);
   }
 };
 
@@ -200,9 +231,20 @@ private:
 
   PreintegratedCombinedMeasurements _PIM_;
 
+  /// Background re-integration, shared with copies of this factor
+  struct Repreintegration;
+  boost::shared_ptr<Repreintegration> repreintegration_;
+
   /** Default constructor - only use for serialization */
   CombinedImuFactor() {}
 
+  /// Create the background re-integration state if _PIM_ keeps its measurements
+  void initRepreintegration();
+
+  /// The latest re-integrated measurements, if any, starting a re-integration at bias_i if needed
+  boost::shared_ptr<const PreintegratedCombinedMeasurements> repreintegrated(
+      const imuBias::ConstantBias& bias_i) const;
+
 public:
 
   /** Shorthand for a smart pointer to a factor */
@@ -246,6 +288,12 @@ public:
     return _PIM_;
   }
 
+  /// The measurements used for evaluation: the latest re-integration, or the original ones
+  PreintegratedCombinedMeasurements latestPreintegratedMeasurements() const;
+
+  /// Block until a running background re-integration, if any, is finished
+  void waitForRepreintegration() const;
+
   /** implement functions needed to derive from Factor */
 
   /// vector of errors
@@ -257,6 +305,13 @@ public:
       boost::optional<Matrix&> H4 = boost::none, boost::optional<Matrix&> H5 =
           boost::none, boost::optional<Matrix&> H6 = boost::none) const;
 
+  /**
+   * Linearize with fixed-size Jacobians, written into the blocks of the resulting
+   * JacobianFactor and whitened there. Robust and constrained noise models fall back to
+   * NoiseModelFactor::linearize.
+   */
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const;
+
   /// @deprecated typename
   typedef gtsam::PreintegratedCombinedMeasurements CombinedPreintegratedMeasurements;
 
@@ -283,6 +338,8 @@ private:
     ar & boost::serialization::make_nvp("NoiseModelFactor6",
          boost::serialization::base_object<Base>(*this));
     ar & BOOST_SERIALIZATION_NVP(_PIM_);
+    if (ARCHIVE::is_loading::value)
+      initRepreintegration();
   }
 };
 // class CombinedImuFactor
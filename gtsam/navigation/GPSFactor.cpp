@@ -18,10 +18,27 @@
 
 #include "GPSFactor.h"
 
+#include <boost/make_shared.hpp>
+#include <stdexcept>
+
 using namespace std;
 
 namespace gtsam {
 
+//***************************************************************************
+vector<GPSFactor::shared_ptr> GPSFactor::CreateBatch(const vector<Key>& keys,
+    const Matrix& fixes, const GeodeticFrame& frame, const SharedNoiseModel& model) {
+  if (keys.size() != size_t(fixes.rows()))
+    throw invalid_argument("GPSFactor::CreateBatch: one key per fix expected");
+  const Matrix local = frame.forward(fixes);
+  vector<shared_ptr> factors;
+  factors.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i)
+    factors.push_back(boost::make_shared<GPSFactor>(keys[i],
+        Point3(local(i, 0), local(i, 1), local(i, 2)), model));
+  return factors;
+}
+
 //***************************************************************************
 void GPSFactor::print(const string& s, const KeyFormatter& keyFormatter) const {
   cout << s << "GPSFactor on " << keyFormatter(key()) << "\n";
@@ -17,6 +17,7 @@
  **/
 #pragma once
 
+#include <gtsam/navigation/GeodeticFrame.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/geometry/Pose3.h>
 
@@ -65,6 +66,16 @@ public:
       Base(model, key), nT_(gpsIn) {
   }
 
+  /**
+   * @brief Create the factors of many geodetic fixes at once, see GeodeticFrame::forward
+   * @param keys of the Pose3 variables, one per fix
+   * @param fixes n*3 matrix with one (latitude, longitude, height) per row
+   * @param frame the local frame of the measurements
+   * @param model Gaussian noise model, shared by all factors
+   */
+  static std::vector<shared_ptr> CreateBatch(const std::vector<Key>& keys,
+      const Matrix& fixes, const GeodeticFrame& frame, const SharedNoiseModel& model);
+
   /// @return a deep copy of this factor
   virtual gtsam::NonlinearFactor::shared_ptr clone() const {
     return boost::static_pointer_cast<gtsam::NonlinearFactor>(
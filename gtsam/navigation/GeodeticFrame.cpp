@@ -0,0 +1,73 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   GeodeticFrame.cpp
+ * @brief  Conversion of geodetic GPS fixes into a local Cartesian frame, in batch
+ * @date   Oct 15, 2026
+ */
+
+#include <gtsam/navigation/GeodeticFrame.h>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace gtsam {
+
+const double GeodeticFrame::a = 6378137.0;
+const double GeodeticFrame::f = 1.0 / 298.257223563;
+
+//------------------------------------------------------------------------------
+GeodeticFrame::GeodeticFrame(double lat0, double lon0, double h0) :
+    lat0_(lat0), lon0_(lon0), h0_(h0) {
+  const Matrix ecef = Geocentric((Matrix(1, 3) << lat0, lon0, h0).finished());
+  origin_ = ecef.row(0).transpose();
+  const double phi = lat0 * M_PI / 180.0, lam = lon0 * M_PI / 180.0;
+  const double sphi = sin(phi), cphi = cos(phi), slam = sin(lam), clam = cos(lam);
+  R_ << -slam, clam, 0.0,
+        -clam * sphi, -slam * sphi, cphi,
+        clam * cphi, slam * cphi, sphi;
+}
+
+//------------------------------------------------------------------------------
+Matrix GeodeticFrame::Geocentric(const Matrix& fixes) {
+  if (fixes.cols() != 3)
+    throw std::invalid_argument("GeodeticFrame::Geocentric: fixes must be a n*3 matrix");
+
+  // Columns are contiguous, so that every step is one vectorized array expression
+  const double e2 = f * (2.0 - f);
+  const Eigen::ArrayXd phi = fixes.col(0).array() * (M_PI / 180.0);
+  const Eigen::ArrayXd lam = fixes.col(1).array() * (M_PI / 180.0);
+  const Eigen::ArrayXd sphi = phi.sin(), cphi = phi.cos();
+  const Eigen::ArrayXd n = a * (1.0 - e2 * sphi.square()).sqrt().inverse();
+  const Eigen::ArrayXd r = (n + fixes.col(2).array()) * cphi;
+
+  Matrix ecef(fixes.rows(), 3);
+  ecef.col(0) = (r * lam.cos()).matrix();
+  ecef.col(1) = (r * lam.sin()).matrix();
+  ecef.col(2) = (((1.0 - e2) * n + fixes.col(2).array()) * sphi).matrix();
+  return ecef;
+}
+
+//------------------------------------------------------------------------------
+Matrix GeodeticFrame::forward(const Matrix& fixes) const {
+  Matrix ecef = Geocentric(fixes);
+  ecef.rowwise() -= origin_.transpose();
+  return ecef * R_.transpose();
+}
+
+//------------------------------------------------------------------------------
+Point3 GeodeticFrame::forward(double lat, double lon, double h) const {
+  const Matrix local = forward((Matrix(1, 3) << lat, lon, h).finished());
+  return Point3(local(0, 0), local(0, 1), local(0, 2));
+}
+
+} // namespace gtsam
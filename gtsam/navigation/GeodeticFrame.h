@@ -0,0 +1,67 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   GeodeticFrame.h
+ * @brief  Conversion of geodetic GPS fixes into a local Cartesian frame, in batch
+ * @date   Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Point3.h>
+#include <gtsam/base/Matrix.h>
+
+namespace gtsam {
+
+/**
+ * East-North-Up frame tangent to the WGS84 ellipsoid at an origin, as GeographicLib's
+ * LocalCartesian with Geocentric::WGS84, for measurements of GPSFactor. The conversion is
+ * closed-form, geodetic to geocentric to local, so that many fixes are converted at once with
+ * Eigen array expressions instead of one GeographicLib call per fix.
+ *
+ * Latitudes and longitudes are in degrees, heights in meters above the ellipsoid. The NED
+ * frame of a fix is (N, E, -U).
+ * @addtogroup Navigation
+ */
+class GTSAM_EXPORT GeodeticFrame {
+public:
+
+  static const double a; ///< WGS84 equatorial radius, in meters
+  static const double f; ///< WGS84 flattening
+
+  /// Construct the frame at the given origin
+  GeodeticFrame(double lat0, double lon0, double h0 = 0.0);
+
+  /// Geocentric (ECEF) coordinates of the n*3 matrix of fixes, one (lat, lon, h) per row
+  static Matrix Geocentric(const Matrix& fixes);
+
+  /// Local coordinates of the n*3 matrix of fixes, one (east, north, up) per row
+  Matrix forward(const Matrix& fixes) const;
+
+  /// Local coordinates of a single fix
+  Point3 forward(double lat, double lon, double h) const;
+
+  /// @name Access
+  /// @{
+  double latitude() const { return lat0_; }
+  double longitude() const { return lon0_; }
+  double height() const { return h0_; }
+  /// @}
+
+private:
+
+  double lat0_, lon0_, h0_;
+  Vector3 origin_; ///< geocentric coordinates of the origin
+  Matrix3 R_;      ///< rows are the east, north and up axes in geocentric coordinates
+};
+
+} // namespace gtsam
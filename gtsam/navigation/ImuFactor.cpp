@@ -20,14 +20,32 @@
  **/
 
 #include <gtsam/navigation/ImuFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
 
 /* External or standard includes */
+#include <boost/array.hpp>
+#include <algorithm>
 #include <ostream>
+#include <stdexcept>
 
 namespace gtsam {
 
 using namespace std;
 
+namespace {
+
+// First order covariance propagation over an interval dt, see integrateMeasurement
+void propagateCovariance(const PreintegrationBase::Params& p, const Matrix9& F,
+    const Matrix93& G1, const Matrix93& G2, double dt, Matrix9& cov) {
+  static const Matrix93 Gi = (Matrix93() << Z_3x3, I_3x3, Z_3x3).finished();
+  cov = F * cov * F.transpose()
+      + Gi * (p.integrationCovariance * dt) * Gi.transpose() // NOTE(frank): (Gi*dt)*(C/dt)*(Gi'*dt)
+      + G1 * (p.accelerometerCovariance / dt) * G1.transpose()
+      + G2 * (p.gyroscopeCovariance / dt) * G2.transpose();
+}
+
+}
+
 //------------------------------------------------------------------------------
 // Inner class PreintegratedMeasurements
 //------------------------------------------------------------------------------
@@ -53,8 +71,6 @@ void PreintegratedImuMeasurements::resetIntegration() {
 void PreintegratedImuMeasurements::integrateMeasurement(
     const Vector3& measuredAcc, const Vector3& measuredOmega, double dt) {
 
-  static const Matrix93 Gi = (Matrix93() << Z_3x3, I_3x3, Z_3x3).finished();
-
   // Update preintegrated measurements (also get Jacobian)
   Matrix9 F; // overall Jacobian wrt preintegrated measurements (df/dx)
   Matrix93 G1, G2;
@@ -69,6 +85,7 @@ void PreintegratedImuMeasurements::integrateMeasurement(
   // NOTE 1: (1/deltaT) allows to pass from continuous time noise to discrete time noise
   // measurementCovariance_discrete = measurementCovariance_contTime * (1/deltaT)
 #ifdef OLD_JACOBIAN_CALCULATION
+  static const Matrix93 Gi = (Matrix93() << Z_3x3, I_3x3, Z_3x3).finished();
   Matrix9 G;
   G << G1, Gi, G2;
   Matrix9 Cov;
@@ -77,13 +94,66 @@ void PreintegratedImuMeasurements::integrateMeasurement(
       Z_3x3, Z_3x3, p().gyroscopeCovariance / dt;
   preintMeasCov_ = F * preintMeasCov_ * F.transpose() + G * Cov * G.transpose();
 #else
-  preintMeasCov_ = F * preintMeasCov_ * F.transpose()
-      + Gi * (p().integrationCovariance * dt) * Gi.transpose() // NOTE(frank): (Gi*dt)*(C/dt)*(Gi'*dt)
-      + G1 * (p().accelerometerCovariance / dt) * G1.transpose()
-      + G2 * (p().gyroscopeCovariance / dt) * G2.transpose();
+  propagateCovariance(p(), F, G1, G2, dt, preintMeasCov_);
 #endif
 }
 
+//------------------------------------------------------------------------------
+void PreintegratedImuMeasurements::integrateMeasurements(
+    const Matrix& measuredAccs, const Matrix& measuredOmegas, const Vector& dts,
+    size_t covarianceStride) {
+  const size_t n = dts.size();
+  if (size_t(measuredAccs.rows()) != n || measuredAccs.cols() != 3
+      || size_t(measuredOmegas.rows()) != n || measuredOmegas.cols() != 3)
+    throw invalid_argument(
+        "integrateMeasurements: need n*3 measurements and n time intervals");
+  if (covarianceStride == 0)
+    throw invalid_argument("integrateMeasurements: covarianceStride must be positive");
+
+  const Params& params = p();
+  Matrix3 D_incrR_integratedOmega;
+  Matrix9 F;
+  Matrix93 G1, G2;
+
+  if (covarianceStride == 1) {
+    for (size_t k = 0; k < n; ++k) {
+      update(measuredAccs.row(k).transpose(), measuredOmegas.row(k).transpose(), dts(k),
+          &D_incrR_integratedOmega, &F, &G1, &G2);
+      propagateCovariance(params, F, G1, G2, dts(k), preintMeasCov_);
+    }
+    return;
+  }
+
+  // Integrate the measurements without their Jacobians, and propagate the covariance once per
+  // stride, as if its measurements were a single one: their mean over their combined interval
+  for (size_t start = 0; start < n; start += covarianceStride) {
+    const size_t end = min(n, start + covarianceStride);
+    const NavState blockStart = deltaXij_;
+    Vector3 accSum = Vector3::Zero(), omegaSum = Vector3::Zero();
+    double blockDt = 0.0;
+    for (size_t k = start; k < end; ++k) {
+      const Vector3 measuredAcc = measuredAccs.row(k).transpose();
+      const Vector3 measuredOmega = measuredOmegas.row(k).transpose();
+      update(measuredAcc, measuredOmega, dts(k), &D_incrR_integratedOmega, 0, 0, 0);
+      accSum += dts(k) * measuredAcc;
+      omegaSum += dts(k) * measuredOmega;
+      blockDt += dts(k);
+    }
+    if (blockDt <= 0.0)
+      continue;
+    updatedFrom(blockStart, accSum / blockDt, omegaSum / blockDt, blockDt, F, G1, G2);
+    propagateCovariance(params, F, G1, G2, blockDt, preintMeasCov_);
+  }
+}
+
+//------------------------------------------------------------------------------
+void PreintegratedImuMeasurements::integrateMeasurements(
+    const Matrix& measuredAccs, const Matrix& measuredOmegas, double dt,
+    size_t covarianceStride) {
+  integrateMeasurements(measuredAccs, measuredOmegas,
+      Vector::Constant(measuredAccs.rows(), dt), covarianceStride);
+}
+
 //------------------------------------------------------------------------------
 PreintegratedImuMeasurements::PreintegratedImuMeasurements(
     const imuBias::ConstantBias& biasHat, const Matrix3& measuredAccCovariance,
@@ -154,6 +224,44 @@ Vector ImuFactor::evaluateError(const Pose3& pose_i, const Vector3& vel_i,
       H1, H2, H3, H4, H5);
 }
 
+//------------------------------------------------------------------------------
+boost::shared_ptr<GaussianFactor> ImuFactor::linearize(const Values& x) const {
+  // Only Gaussian noise models are whitened here, constrained and robust ones are not
+  const noiseModel::Gaussian* gaussian =
+      dynamic_cast<const noiseModel::Gaussian*>(noiseModel_.get());
+  if (!gaussian || gaussian->isConstrained())
+    return Base::linearize(x);
+
+  // Only linearize if the factor is active
+  if (!active(x))
+    return boost::shared_ptr<JacobianFactor>();
+
+  // Jacobians on the stack, copied into the blocks of [A b]
+  Matrix96 H1, H3, H5;
+  Matrix93 H2, H4;
+  const Vector9 error = _PIM_.computeErrorAndJacobians(x.at<Pose3>(key1()),
+      x.at<Vector3>(key2()), x.at<Pose3>(key3()), x.at<Vector3>(key4()),
+      x.at<imuBias::ConstantBias>(key5()), H1, H2, H3, H4, H5);
+  static const boost::array<DenseIndex, 5> dims = {{ 6, 3, 6, 3, 6 }};
+  JacobianFactor* factor = new JacobianFactor(keys(), dims, 9);
+  boost::shared_ptr<GaussianFactor> result(factor);
+  VerticalBlockMatrix& Ab = factor->Ab_;
+  Ab(0) = H1;
+  Ab(1) = H2;
+  Ab(2) = H3;
+  Ab(3) = H4;
+  Ab(4) = H5;
+  Ab(5) = -error;
+
+  // Whiten [A b] with the square root information, as one fixed-size product
+  if (!gaussian->isUnit()) {
+    const Matrix9 R = gaussian->R();
+    Eigen::Map<Eigen::Matrix<double, 9, 25> > system(Ab.matrix().data());
+    system = R * system;
+  }
+  return result;
+}
+
 //------------------------------------------------------------------------------
 ImuFactor::ImuFactor(Key pose_i, Key vel_i, Key pose_j, Key vel_j, Key bias,
     const PreintegratedMeasurements& pim, const Vector3& n_gravity,
@@ -105,6 +105,21 @@ public:
   void integrateMeasurement(const Vector3& measuredAcc,
       const Vector3& measuredOmega, double dt);
 
+  /**
+   * Add a window of IMU measurements, the same as integrateMeasurement on each in turn.
+   * @param measuredAccs n*3 matrix with a measured acceleration in each row
+   * @param measuredOmegas n*3 matrix with a measured angular velocity in each row
+   * @param dts Time interval between each measurement and the previous one
+   * @param covarianceStride Propagate the covariance once for this many measurements, over
+   *   their combined interval with their mean (1: once per measurement, as integrateMeasurement)
+   */
+  void integrateMeasurements(const Matrix& measuredAccs, const Matrix& measuredOmegas,
+      const Vector& dts, size_t covarianceStride = 1);
+
+  /// integrateMeasurements at a constant rate
+  void integrateMeasurements(const Matrix& measuredAccs, const Matrix& measuredOmegas,
+      double dt, size_t covarianceStride = 1);
+
   /// Return pre-integrated measurement covariance
   Matrix preintMeasCov() const { return preintMeasCov_; }
 
@@ -211,6 +226,13 @@ public:
       boost::optional<Matrix&> H3 = boost::none, boost::optional<Matrix&> H4 =
           boost::none, boost::optional<Matrix&> H5 = boost::none) const;
 
+  /**
+   * Linearize with the Jacobians written straight into the fixed-size blocks of the
+   * resulting JacobianFactor, and whitened there. Robust and constrained noise models
+   * fall back to NoiseModelFactor::linearize.
+   */
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const;
+
   /// @deprecated typename
   typedef PreintegratedImuMeasurements PreintegratedMeasurements;
 
@@ -0,0 +1,84 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   NavStatePropagator.cpp
+ * @brief  Propagate a navigation state estimate with IMU measurements, e.g. in a control loop
+ * @date   Oct 15, 2026
+ */
+
+#include <gtsam/navigation/NavStatePropagator.h>
+
+namespace gtsam {
+
+//------------------------------------------------------------------------------
+NavStatePropagator::NavStatePropagator(const Params& p, const NavState& state_i,
+    const imuBias::ConstantBias& bias_i) :
+    n_gravity_(p.n_gravity), omegaCoriolis_(Vector3::Zero()),
+    useCoriolis_(p.omegaCoriolis.is_initialized()), use2ndOrderCoriolis_(p.use2ndOrderCoriolis),
+    bRs_(I_3x3), b_arm_(Vector3::Zero()), rotated_(false), displaced_(false) {
+  if (p.omegaCoriolis)
+    omegaCoriolis_ = *p.omegaCoriolis;
+  if (p.body_P_sensor) {
+    bRs_ = p.body_P_sensor->rotation().matrix();
+    b_arm_ = p.body_P_sensor->translation().vector();
+    rotated_ = true;
+    displaced_ = !b_arm_.isZero();
+  }
+  reset(state_i, bias_i);
+}
+
+//------------------------------------------------------------------------------
+void NavStatePropagator::reset(const NavState& state_i,
+    const imuBias::ConstantBias& bias_i) {
+  state_i_ = state_i;
+  bias_i_ = bias_i;
+  deltaXij_ = NavState();
+  deltaTij_ = 0;
+}
+
+//------------------------------------------------------------------------------
+void NavStatePropagator::reset(const Values& estimate, Key poseKey, Key velKey,
+    Key biasKey) {
+  reset(NavState(estimate.at<Pose3>(poseKey), estimate.at<Vector3>(velKey)),
+      estimate.at<imuBias::ConstantBias>(biasKey));
+}
+
+//------------------------------------------------------------------------------
+void NavStatePropagator::integrateMeasurement(const Vector3& measuredAcc,
+    const Vector3& measuredOmega, double dt) {
+  // Same correction as PreintegrationBase::correctMeasurementsByBiasAndSensorPose
+  Vector3 correctedAcc = bias_i_.correctAccelerometer(measuredAcc);
+  Vector3 correctedOmega = bias_i_.correctGyroscope(measuredOmega);
+  if (rotated_) {
+    correctedOmega = bRs_ * correctedOmega;
+    correctedAcc = bRs_ * correctedAcc;
+    if (displaced_)
+      correctedAcc -= correctedOmega.cross(correctedOmega.cross(b_arm_));
+  }
+  deltaXij_ = deltaXij_.update(correctedAcc, correctedOmega, dt, boost::none,
+      boost::none, boost::none);
+  deltaTij_ += dt;
+}
+
+//------------------------------------------------------------------------------
+NavState NavStatePropagator::predict() const {
+  Vector9 delta;
+  NavState::dR(delta) = Rot3::Logmap(deltaXij_.attitude());
+  NavState::dP(delta) = deltaXij_.position().vector();
+  NavState::dV(delta) = deltaXij_.velocity();
+  const Vector9 xi = state_i_.correctPIM(delta, deltaTij_, n_gravity_,
+      useCoriolis_ ? boost::optional<Vector3>(omegaCoriolis_) : boost::none,
+      use2ndOrderCoriolis_);
+  return state_i_.retract(xi);
+}
+
+} // namespace gtsam
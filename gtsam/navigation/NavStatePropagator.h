@@ -0,0 +1,88 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   NavStatePropagator.h
+ * @brief  Propagate a navigation state estimate with IMU measurements, e.g. in a control loop
+ * @date   Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/navigation/PreintegrationBase.h>
+#include <gtsam/nonlinear/Values.h>
+
+namespace gtsam {
+
+/**
+ * Propagates a snapshot of the navigation state and bias estimated by an optimizer with the
+ * IMU measurements received since, e.g. to feed a high-rate controller between optimizer
+ * outputs. Only the preintegrated mean is kept, without covariance or bias Jacobians, and the
+ * parameters are copied at construction, so that integrating a measurement and predicting the
+ * current state are fixed-size computations without heap allocation. The prediction is the
+ * same as PreintegrationBase::predict with biasHat equal to the snapshot bias.
+ *
+ * A propagator is a small value type without any locking: keep one per agent, owned by the
+ * thread that runs the control loop, and hand it new snapshots with reset.
+ */
+class GTSAM_EXPORT NavStatePropagator {
+public:
+
+  typedef PreintegrationBase::Params Params;
+
+  /**
+   * Constructor
+   * @param p preintegration parameters, of which gravity, Coriolis and body_P_sensor are used
+   * @param state_i state snapshot at the time of the first measurement
+   * @param bias_i bias snapshot, used to correct all measurements
+   */
+  NavStatePropagator(const Params& p, const NavState& state_i = NavState(),
+      const imuBias::ConstantBias& bias_i = imuBias::ConstantBias());
+
+  /// Start over from a new snapshot, dropping the measurements integrated so far
+  void reset(const NavState& state_i, const imuBias::ConstantBias& bias_i);
+
+  /// Start over from a snapshot of an optimizer estimate, the only Values lookups made
+  void reset(const Values& estimate, Key poseKey, Key velKey, Key biasKey);
+
+  /// Add a single IMU measurement, as given by the sensor
+  void integrateMeasurement(const Vector3& measuredAcc, const Vector3& measuredOmega,
+      double dt);
+
+  /// Predicted state after the measurements integrated since the snapshot
+  NavState predict() const;
+
+  /// @name Access
+  /// @{
+  const NavState& state_i() const { return state_i_; }
+  const imuBias::ConstantBias& bias_i() const { return bias_i_; }
+  const NavState& deltaXij() const { return deltaXij_; }
+  double deltaTij() const { return deltaTij_; }
+  /// @}
+
+private:
+
+  // Parameters, copied
+  Vector3 n_gravity_;
+  Vector3 omegaCoriolis_;
+  bool useCoriolis_, use2ndOrderCoriolis_;
+  Matrix3 bRs_;   ///< rotation of the sensor in the body frame
+  Vector3 b_arm_; ///< position of the sensor in the body frame
+  bool rotated_, displaced_;
+
+  // Snapshot and preintegrated mean since
+  NavState state_i_;
+  imuBias::ConstantBias bias_i_;
+  NavState deltaXij_;
+  double deltaTij_;
+};
+
+} // namespace gtsam
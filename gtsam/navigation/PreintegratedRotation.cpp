@@ -21,6 +21,9 @@
 
 #include "PreintegratedRotation.h"
 
+#include <limits>
+#include <stdexcept>
+
 using namespace std;
 
 namespace gtsam {
@@ -92,6 +95,61 @@ void PreintegratedRotation::integrateMeasurement(const Vector3& measuredOmega,
       - *D_incrR_integratedOmega * deltaT;
 }
 
+void PreintegratedRotation::integrateMeasurements(const Matrix& measuredOmegas,
+    const Vector3& biasHat, const Vector& dts, Matrix3* covariance) {
+  const size_t n = dts.size();
+  if (size_t(measuredOmegas.rows()) != n || measuredOmegas.cols() != 3)
+    throw std::invalid_argument(
+        "integrateMeasurements: need n*3 measurements and n time intervals");
+
+  const bool rotated = p_->body_P_sensor.is_initialized();
+  const Matrix3 body_R_sensor =
+      rotated ? p_->body_P_sensor->rotation().matrix() : Matrix3(I_3x3);
+  const Matrix3& gyroscopeCovariance = p_->gyroscopeCovariance;
+
+  Quaternion q = Quaternion::Identity();
+  Matrix3 incrR, D_incrR_integratedOmega;
+  for (size_t k = 0; k < n; ++k) {
+    const double dt = dts(k);
+    Vector3 correctedOmega = measuredOmegas.row(k).transpose() - biasHat;
+    if (rotated)
+      correctedOmega = body_R_sensor * correctedOmega;
+    const Vector3 omega = correctedOmega * dt;
+
+    // Rot3::Expmap and SO3::ExpmapDerivative, from one sine and cosine of the half angle
+    const Matrix3 W = skewSymmetric(omega);
+    const double theta2 = omega.dot(omega);
+    Quaternion incrQ;
+    if (theta2 > std::numeric_limits<double>::epsilon()) {
+      const double theta = std::sqrt(theta2), sh = std::sin(0.5 * theta),
+          ch = std::cos(0.5 * theta);
+      const double sinTheta = 2.0 * sh * ch, oneMinusCos = 2.0 * sh * sh;
+      const Matrix3 W2 = W * W;
+      incrR = I_3x3 + (sinTheta / theta) * W + (oneMinusCos / theta2) * W2;
+      D_incrR_integratedOmega = I_3x3 - (oneMinusCos / theta2) * W
+          + ((theta - sinTheta) / (theta2 * theta)) * W2;
+      incrQ.w() = ch;
+      incrQ.vec() = (sh / theta) * omega;
+    } else {
+      incrR = I_3x3 + W;
+      D_incrR_integratedOmega = I_3x3;
+      incrQ.w() = 1.0;
+      incrQ.vec() = 0.5 * omega;
+      incrQ.normalize();
+    }
+    q = q * incrQ;
+
+    // Fused update of the bias derivative and, if asked for, the covariance
+    const Matrix3 incrRt = incrR.transpose();
+    delRdelBiasOmega_ = incrRt * delRdelBiasOmega_ - D_incrR_integratedOmega * dt;
+    if (covariance)
+      *covariance = incrRt * (*covariance) * incrR + gyroscopeCovariance * dt;
+    deltaTij_ += dt;
+  }
+  q.normalize();
+  deltaRij_ = deltaRij_.compose(Rot3(q));
+}
+
 Rot3 PreintegratedRotation::biascorrectedDeltaRij(const Vector3& biasOmegaIncr,
     OptionalJacobian<3, 3> H) const {
   const Vector3 biasInducedOmega = delRdelBiasOmega_ * biasOmegaIncr;
@@ -113,6 +113,19 @@ public:
       const Vector3& biasHat, double deltaT, Matrix3* D_incrR_integratedOmega,
       Matrix3* F);
 
+  /**
+   * Integrate a window of gyro measurements, the same as integrateMeasurement on each in turn,
+   * but with the sensor rotation hoisted out of the loop, the exponential map and its
+   * derivative computed from the same half-angle sine and cosine, and the increments
+   * composed as quaternions.
+   * @param measuredOmegas n*3 matrix with a measured angular velocity in each row
+   * @param biasHat gyroscope bias to correct the measurements with
+   * @param dts Time interval between each measurement and the previous one
+   * @param covariance If given, propagated with the gyroscope covariance as in AHRSFactor
+   */
+  void integrateMeasurements(const Matrix& measuredOmegas, const Vector3& biasHat,
+      const Vector& dts, Matrix3* covariance = 0);
+
   /// Return a bias corrected version of the integrated rotation, with optional Jacobian
   Rot3 biascorrectedDeltaRij(const Vector3& biasOmegaIncr,
       OptionalJacobian<3, 3> H = boost::none) const;
@@ -129,20 +129,33 @@ NavState PreintegrationBase::updatedDeltaXij(const Vector3& j_measuredAcc,
     OptionalJacobian<9, 9> D_updated_current,
     OptionalJacobian<9, 3> D_updated_measuredAcc,
     OptionalJacobian<9, 3> D_updated_measuredOmega) const {
+  return updatedFrom(deltaXij_, j_measuredAcc, j_measuredOmega, dt,
+      D_updated_current, D_updated_measuredAcc, D_updated_measuredOmega);
+}
 
-  Vector3 j_correctedAcc, j_correctedOmega;
+//------------------------------------------------------------------------------
+NavState PreintegrationBase::updatedFrom(const NavState& current,
+    const Vector3& j_measuredAcc, const Vector3& j_measuredOmega, const double dt,
+    OptionalJacobian<9, 9> D_updated_current,
+    OptionalJacobian<9, 3> D_updated_measuredAcc,
+    OptionalJacobian<9, 3> D_updated_measuredOmega,
+    Vector3* j_correctedAcc, Vector3* j_correctedOmega) const {
+
+  Vector3 correctedAcc, correctedOmega;
   Matrix3 D_correctedAcc_measuredAcc, //
       D_correctedAcc_measuredOmega, //
       D_correctedOmega_measuredOmega;
   bool needDerivs = D_updated_measuredAcc && D_updated_measuredOmega && p().body_P_sensor;
-  boost::tie(j_correctedAcc, j_correctedOmega) =
+  boost::tie(correctedAcc, correctedOmega) =
       correctMeasurementsByBiasAndSensorPose(j_measuredAcc, j_measuredOmega,
           (needDerivs ? &D_correctedAcc_measuredAcc : 0),
           (needDerivs ? &D_correctedAcc_measuredOmega : 0),
           (needDerivs ? &D_correctedOmega_measuredOmega : 0));
+  if (j_correctedAcc) *j_correctedAcc = correctedAcc;
+  if (j_correctedOmega) *j_correctedOmega = correctedOmega;
   // Do update in one fell swoop
   Matrix93 D_updated_correctedAcc, D_updated_correctedOmega;
-  NavState updated = deltaXij_.update(j_correctedAcc, j_correctedOmega, dt, D_updated_current,
+  NavState updated = current.update(correctedAcc, correctedOmega, dt, D_updated_current,
               (needDerivs ? D_updated_correctedAcc : D_updated_measuredAcc),
               (needDerivs ? D_updated_correctedOmega : D_updated_measuredOmega));
   if (needDerivs) {
@@ -164,17 +177,14 @@ void PreintegrationBase::update(const Vector3& j_measuredAcc,
   // Save current rotation for updating Jacobians
   const Rot3 oldRij = deltaXij_.attitude();
 
-  // Do update
+  // Do update, which also corrects the measurements for the Jacobians below
+  Vector3 j_correctedAcc, j_correctedOmega;
   deltaTij_ += dt;
-  deltaXij_ = updatedDeltaXij(j_measuredAcc, j_measuredOmega, dt,
-      D_updated_current, D_updated_measuredAcc, D_updated_measuredOmega); // functional
+  deltaXij_ = updatedFrom(deltaXij_, j_measuredAcc, j_measuredOmega, dt,
+      D_updated_current, D_updated_measuredAcc, D_updated_measuredOmega,
+      &j_correctedAcc, &j_correctedOmega); // functional
 
   // Update Jacobians
-  // TODO(frank): we are repeating some computation here: accessible in F ?
-  Vector3 j_correctedAcc, j_correctedOmega;
-  boost::tie(j_correctedAcc, j_correctedOmega) =
-      correctMeasurementsByBiasAndSensorPose(j_measuredAcc, j_measuredOmega);
-
   Matrix3 D_acc_R;
   oldRij.rotate(j_correctedAcc, D_acc_R);
   const Matrix3 D_acc_biasOmega = D_acc_R * delRdelBiasOmega_;
@@ -212,6 +212,15 @@ public:
       OptionalJacobian<9, 3> D_updated_measuredAcc = boost::none,
       OptionalJacobian<9, 3> D_updated_measuredOmega = boost::none) const;
 
+  /// Same as updatedDeltaXij, but starting from the given preintegrated state, and optionally
+  /// returning the measurements corrected for bias and sensor pose
+  NavState updatedFrom(const NavState& current, const Vector3& j_measuredAcc,
+      const Vector3& j_measuredOmega, const double dt,
+      OptionalJacobian<9, 9> D_updated_current = boost::none,
+      OptionalJacobian<9, 3> D_updated_measuredAcc = boost::none,
+      OptionalJacobian<9, 3> D_updated_measuredOmega = boost::none,
+      Vector3* j_correctedAcc = 0, Vector3* j_correctedOmega = 0) const;
+
   /// Update preintegrated measurements and get derivatives
   /// It takes measured quantities in the j frame
   void update(const Vector3& j_measuredAcc, const Vector3& j_measuredOmega,
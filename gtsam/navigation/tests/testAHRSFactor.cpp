@@ -476,6 +476,34 @@ TEST (AHRSFactor, graphTest) {
   EXPECT(assert_equal(expectedRot, result.at<Rot3>(X(2))));
 }
 
+//******************************************************************************
+TEST (AHRSFactor, integrateMeasurements) {
+  boost::shared_ptr<PreintegratedAhrsMeasurements::Params> p =
+      boost::make_shared<PreintegratedAhrsMeasurements::Params>();
+  p->gyroscopeCovariance = 0.01 * I_3x3;
+  p->body_P_sensor = Pose3(Rot3::ypr(0.2, -0.1, 0.3), Point3(0.1, 0.0, 0.0));
+  const Vector3 biasHat(0.01, -0.02, 0.005);
+
+  // Fast rotations, and samples without rotation to exercise the first order path
+  const size_t n = 1000;
+  const double dt = 0.001;
+  Matrix omegas(n, 3);
+  for (size_t k = 0; k < n; ++k)
+    omegas.row(k) << 2.0 * sin(0.01 * k), 1.0, -3.0 * cos(0.02 * k);
+  omegas.row(10) = biasHat.transpose();
+
+  PreintegratedAhrsMeasurements expected(p, biasHat), actual(p, biasHat);
+  for (size_t k = 0; k < n; ++k)
+    expected.integrateMeasurement(omegas.row(k).transpose(), dt);
+  actual.integrateMeasurements(omegas.topRows(400), dt);
+  actual.integrateMeasurements(omegas.bottomRows(n - 400), Vector::Constant(n - 400, dt));
+  EXPECT(actual.equals(expected, 1e-9));
+  EXPECT(assert_equal(expected.preintMeasCov(), actual.preintMeasCov(), 1e-9));
+
+  CHECK_EXCEPTION(actual.integrateMeasurements(omegas, Vector::Constant(10, dt)),
+      std::invalid_argument);
+}
+
 //******************************************************************************
 int main() {
   TestResult tr;
@@ -300,6 +300,77 @@ TEST(CombinedImuFactor, PredictRotation) {
   EXPECT(assert_equal(expectedPose, x2, tol));
 }
 
+/* ************************************************************************* */
+TEST(CombinedImuFactor, Linearize) {
+  typedef PreintegratedCombinedMeasurements PIM;
+  boost::shared_ptr<PIM::Params> p = PIM::Params::MakeSharedU();
+  p->accelerometerCovariance = 0.01 * I_3x3;
+  p->gyroscopeCovariance = 0.02 * I_3x3;
+  p->biasAccOmegaInit = 1e-3 * I_6x6;
+  PIM pim(p, imuBias::ConstantBias());
+  for (int i = 0; i < 10; ++i)
+    pim.integrateMeasurement(Vector3(0.1 * i, 0.2, 9.81), Vector3(0.3, 0.0, 0.1 * i), 0.1);
+  CombinedImuFactor factor(X(1), V(1), X(2), V(2), B(1), B(2), pim);
+
+  Values values;
+  values.insert(X(1), Pose3(Rot3::ypr(0.1, 0.2, 0.0), Point3(1.0, 0.0, 0.0)));
+  values.insert(V(1), Vector3(0.5, 0.0, 0.0));
+  values.insert(X(2), Pose3(Rot3::ypr(0.2, 0.2, 0.1), Point3(1.5, 0.2, 0.1)));
+  values.insert(V(2), Vector3(0.6, 0.1, 0.0));
+  values.insert(B(1), imuBias::ConstantBias(Vector3(0.1, 0, 0), Vector3(0, 0.02, 0)));
+  values.insert(B(2), imuBias::ConstantBias(Vector3(0.2, 0, 0), Vector3(0, 0.01, 0)));
+
+  // Fixed-size linearization is the same as the generic one
+  GaussianFactor::shared_ptr expected = factor.NoiseModelFactor::linearize(values);
+  GaussianFactor::shared_ptr actual = factor.linearize(values);
+  EXPECT(assert_equal(*expected, *actual, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(CombinedImuFactor, Repreintegration) {
+  typedef PreintegratedCombinedMeasurements PIM;
+  boost::shared_ptr<PIM::Params> p = PIM::Params::MakeSharedU();
+  const imuBias::ConstantBias biasHat, bias(Vector3(0.2, -0.1, 0.3), Vector3(0.05, 0.02, -0.04));
+
+  // Integrate with biasHat while keeping the raw measurements, and directly with bias
+  PIM pim(p, biasHat), expected(p, bias);
+  pim.keepMeasurements(0.01);
+  CHECK_EXCEPTION(pim.keepMeasurements(0), std::invalid_argument);
+  for (int i = 0; i < 200; ++i) {
+    const Vector3 measuredAcc(0.5 * sin(0.01 * i), 0.2, 9.81 + 0.1 * cos(0.02 * i));
+    const Vector3 measuredOmega(0.1, 0.3 * cos(0.01 * i), -0.2);
+    pim.integrateMeasurement(measuredAcc, measuredOmega, 0.005);
+    expected.integrateMeasurement(measuredAcc, measuredOmega, 0.005);
+  }
+  EXPECT_LONGS_EQUAL(200, pim.measurements().size());
+  CHECK_EXCEPTION(pim.keepMeasurements(0.01), std::logic_error);
+  EXPECT(!pim.needsRepreintegration(biasHat));
+  EXPECT(pim.needsRepreintegration(bias));
+
+  // Re-integration at bias gives the same as integrating with bias in the first place
+  PIM repreintegrated = pim;
+  repreintegrated.repreintegrate(bias);
+  EXPECT(assert_equal(expected.deltaXij(), repreintegrated.deltaXij(), 1e-9));
+  EXPECT(assert_equal(expected.preintMeasCov(), repreintegrated.preintMeasCov(), 1e-9));
+  EXPECT_LONGS_EQUAL(200, repreintegrated.measurements().size());
+
+  // The factor uses the first-order correction until a background re-integration is done
+  CombinedImuFactor factor(X(1), V(1), X(2), V(2), B(1), B(2), pim);
+  Values values;
+  values.insert(X(1), Pose3());
+  values.insert(V(1), Vector3(1.0, 0.0, 0.0));
+  values.insert(X(2), Pose3(Rot3::ypr(0.1, 0.0, 0.0), Point3(1.0, 0.1, 0.0)));
+  values.insert(V(2), Vector3(1.0, 0.1, 0.0));
+  values.insert(B(1), bias);
+  values.insert(B(2), bias);
+  factor.unwhitenedError(values);
+  factor.waitForRepreintegration();
+  EXPECT(assert_equal(bias, factor.latestPreintegratedMeasurements().biasHat()));
+
+  CombinedImuFactor direct(X(1), V(1), X(2), V(2), B(1), B(2), expected);
+  EXPECT(assert_equal(direct.unwhitenedError(values), factor.unwhitenedError(values), 1e-9));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -94,6 +94,36 @@ TEST(GPSData, init) {
   EXPECT(assert_equal(expectedT, T.translation(), 1e-5));
 }
 
+//***************************************************************************
+TEST(GPSFactor, CreateBatch) {
+  const double lat0 = 33.86998, lon0 = -84.30626, h0 = 274;
+  LocalCartesian enu(lat0, lon0, h0, Geocentric::WGS84);
+  GeodeticFrame frame(lat0, lon0, h0);
+
+  // Nearby fixes, and fixes far away, across the date line and near a pole
+  Matrix fixes(6, 3);
+  fixes << 33.87071, -84.30482, 274,
+           33.86998, -84.30626, 274,
+           35.43946, -119.06314, 276.52,
+           -33.86, 151.21, 58,
+           12.5, 179.99, -20,
+           89.99, 10.0, 1000;
+  const Matrix local = frame.forward(fixes);
+  vector<Key> keys;
+  for (size_t i = 0; i < 6; ++i)
+    keys.push_back(Key(i));
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(3, 0.25);
+  const vector<GPSFactor::shared_ptr> factors = GPSFactor::CreateBatch(keys, fixes, frame, model);
+  EXPECT_LONGS_EQUAL(6, factors.size());
+  for (size_t i = 0; i < 6; ++i) {
+    double E, N, U;
+    enu.Forward(fixes(i, 0), fixes(i, 1), fixes(i, 2), E, N, U);
+    EXPECT(assert_equal(Vector3(E, N, U), Vector(local.row(i).transpose()), 1e-6));
+    EXPECT(assert_equal(Point3(E, N, U), frame.forward(fixes(i, 0), fixes(i, 1), fixes(i, 2)), 1e-6));
+    EXPECT(factors[i]->equals(GPSFactor(keys[i], Point3(E, N, U), model), 1e-6));
+  }
+}
+
 // *************************************************************************
 int main() {
   TestResult tr;
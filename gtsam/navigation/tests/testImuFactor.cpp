@@ -438,6 +438,33 @@ TEST(ImuFactor, ErrorAndJacobianWithBiases) {
   EXPECT_CORRECT_FACTOR_JACOBIANS(factor, values, diffDelta, 1e-3);
 }
 
+/* ************************************************************************* */
+TEST(ImuFactor, Linearize) {
+  using common::x1;
+  using common::v1;
+  using common::v2;
+  imuBias::ConstantBias bias(Vector3(0.2, 0, 0), Vector3(0.1, 0, 0.3));
+  Pose3 x2(Rot3::Expmap(Vector3(0, 0.1, M_PI / 5.0)), Point3(5.5, 1.0, -50.0));
+
+  PreintegratedImuMeasurements pim(kZeroBiasHat, kMeasuredAccCovariance,
+      kMeasuredOmegaCovariance, kIntegrationErrorCovariance);
+  for (int i = 0; i < 10; ++i)
+    pim.integrateMeasurement(Vector3(0.1 * i, 0.2, -9.81), Vector3(0.3, 0.0, 0.1 * i), 0.1);
+  ImuFactor factor(X(1), V(1), X(2), V(2), B(1), pim);
+
+  Values values;
+  values.insert(X(1), x1);
+  values.insert(V(1), v1);
+  values.insert(X(2), x2);
+  values.insert(V(2), v2);
+  values.insert(B(1), bias);
+
+  // Fixed-size linearization is the same as the generic one
+  GaussianFactor::shared_ptr expected = factor.NoiseModelFactor::linearize(values);
+  GaussianFactor::shared_ptr actual = factor.linearize(values);
+  EXPECT(assert_equal(*expected, *actual, 1e-9));
+}
+
 /* ************************************************************************* */
 TEST(ImuFactor, ErrorAndJacobianWith2ndOrderCoriolis) {
   using common::x1;
@@ -1010,6 +1037,48 @@ TEST(ImuFactor, bodyPSensorWithBias) {
   EXPECT(assert_equal(biasExpected, biasActual, 1e-3));
 }
 
+/* ************************************************************************* */
+TEST(ImuFactor, integrateMeasurements) {
+  boost::shared_ptr<PreintegratedImuMeasurements::Params> p =
+      PreintegratedImuMeasurements::Params::MakeSharedD();
+  p->accelerometerCovariance = kMeasuredAccCovariance;
+  p->gyroscopeCovariance = kMeasuredOmegaCovariance;
+  p->integrationCovariance = kIntegrationErrorCovariance;
+  p->body_P_sensor = Pose3(Rot3::ypr(0.1, 0.2, -0.3), Point3(0.1, -0.05, 0.2));
+  imuBias::ConstantBias biasHat(Vector3(0.1, -0.1, 0.05), Vector3(0.01, 0.0, -0.02));
+
+  // A second of varying measurements at 1 kHz
+  const size_t n = 1000;
+  const double dt = 0.001;
+  Matrix accs(n, 3), omegas(n, 3);
+  for (size_t k = 0; k < n; ++k) {
+    accs.row(k) << 0.5 * sin(0.01 * k), 0.2 * cos(0.02 * k), -9.81 + 0.1 * sin(0.005 * k);
+    omegas.row(k) << 0.3 * cos(0.01 * k), -0.2, 0.1 * sin(0.03 * k);
+  }
+
+  PreintegratedImuMeasurements expected(p, biasHat);
+  for (size_t k = 0; k < n; ++k)
+    expected.integrateMeasurement(accs.row(k).transpose(), omegas.row(k).transpose(), dt);
+
+  // Same result when propagating the covariance with every measurement
+  PreintegratedImuMeasurements actual(p, biasHat);
+  actual.integrateMeasurements(accs.topRows(400), omegas.topRows(400), dt);
+  actual.integrateMeasurements(accs.bottomRows(n - 400), omegas.bottomRows(n - 400),
+      Vector::Constant(n - 400, dt));
+  EXPECT(expected.equals(actual, 1e-9));
+
+  // At a coarser rate only the covariance changes, and little
+  PreintegratedImuMeasurements coarse(p, biasHat);
+  coarse.integrateMeasurements(accs, omegas, dt, 10);
+  EXPECT(assert_equal(expected.deltaXij(), coarse.deltaXij(), 1e-9));
+  EXPECT(assert_equal(expected.delPdelBiasOmega(), coarse.delPdelBiasOmega(), 1e-9));
+  const Matrix9 difference = coarse.preintMeasCov() - expected.preintMeasCov();
+  EXPECT(difference.norm() < 5e-2 * expected.preintMeasCov().norm());
+
+  CHECK_EXCEPTION(coarse.integrateMeasurements(accs, omegas.topRows(10), dt),
+      std::invalid_argument);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -0,0 +1,68 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testNavStatePropagator.cpp
+ * @brief   Unit tests for NavStatePropagator
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/navigation/NavStatePropagator.h>
+#include <gtsam/navigation/ImuFactor.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+using symbol_shorthand::X;
+using symbol_shorthand::V;
+using symbol_shorthand::B;
+
+/* ************************************************************************* */
+TEST(NavStatePropagator, predict) {
+  boost::shared_ptr<PreintegrationBase::Params> p = PreintegrationBase::Params::MakeSharedU();
+  p->body_P_sensor = Pose3(Rot3::ypr(0.1, -0.2, 0.05), Point3(0.1, 0.05, -0.2));
+  p->omegaCoriolis = Vector3(0.0, 1e-4, 7e-5);
+  p->use2ndOrderCoriolis = true;
+  const NavState state_i(Pose3(Rot3::ypr(0.3, 0.1, -0.1), Point3(1.0, 2.0, 3.0)),
+      Vector3(0.5, -0.2, 0.1));
+  const imuBias::ConstantBias bias_i(Vector3(0.1, -0.05, 0.02), Vector3(0.01, 0.02, -0.01));
+
+  // Same prediction as the preintegrated measurements at the same bias
+  NavStatePropagator propagator(*p, state_i, bias_i);
+  PreintegratedImuMeasurements pim(p, bias_i);
+  for (int i = 0; i < 500; ++i) {
+    const Vector3 measuredAcc(0.3 * sin(0.02 * i), 0.1, 9.7 + 0.2 * cos(0.01 * i));
+    const Vector3 measuredOmega(0.2 * cos(0.01 * i), -0.1, 0.3);
+    propagator.integrateMeasurement(measuredAcc, measuredOmega, 0.002);
+    pim.integrateMeasurement(measuredAcc, measuredOmega, 0.002);
+  }
+  DOUBLES_EQUAL(pim.deltaTij(), propagator.deltaTij(), 1e-12);
+  EXPECT(assert_equal(pim.deltaXij(), propagator.deltaXij(), 1e-9));
+  EXPECT(assert_equal(pim.predict(state_i, bias_i), propagator.predict(), 1e-9));
+
+  // A new snapshot drops the measurements
+  Values estimate;
+  estimate.insert(X(2), Pose3(Rot3::ypr(0.2, 0.0, 0.0), Point3(4.0, 5.0, 6.0)));
+  estimate.insert(V(2), Vector3(1.0, 0.0, 0.0));
+  estimate.insert(B(2), bias_i);
+  propagator.reset(estimate, X(2), V(2), B(2));
+  EXPECT_DOUBLES_EQUAL(0.0, propagator.deltaTij(), 0.0);
+  EXPECT(assert_equal(NavState(estimate.at<Pose3>(X(2)), Vector3(1.0, 0.0, 0.0)),
+      propagator.predict()));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -33,40 +33,49 @@ namespace gtsam {
  *   template<typename T> bool operator()(const T* const, const T* const, T*
  * predicted) const;
  * For now only binary operators are supported.
+ *
+ * The derivatives with respect to both arguments are propagated in the lanes
+ * of a single Jet, padded to whole SIMD packets so that Eigen vectorizes the
+ * Jet arithmetic, and are written straight into the Jacobians asked for, e.g.
+ * the Jacobian blocks of an expression, without intermediate buffers.
  */
 template <typename FUNCTOR, int M, int N1, int N2>
 class AdaptAutoDiff {
-  typedef Eigen::Matrix<double, M, N1, Eigen::RowMajor> RowMajor1;
-  typedef Eigen::Matrix<double, M, N2, Eigen::RowMajor> RowMajor2;
-
   typedef Eigen::Matrix<double, M, 1> VectorT;
   typedef Eigen::Matrix<double, N1, 1> Vector1;
   typedef Eigen::Matrix<double, N2, 1> Vector2;
 
+  // Number of derivative lanes, rounded up to whole SIMD packets
+  enum {
+    PacketSize = Eigen::internal::packet_traits<double>::size,
+    N = (N1 + N2 + PacketSize - 1) / PacketSize * PacketSize
+  };
+  typedef ceres::Jet<double, N> JetT;
+
   FUNCTOR f;
 
  public:
   VectorT operator()(const Vector1& v1, const Vector2& v2,
                      OptionalJacobian<M, N1> H1 = boost::none,
                      OptionalJacobian<M, N2> H2 = boost::none) {
-    using ceres::internal::AutoDiff;
-
     bool success;
     VectorT result;
 
     if (H1 || H2) {
-      // Get derivatives with AutoDiff
-      const double* parameters[] = {v1.data(), v2.data()};
-      double rowMajor1[M * N1], rowMajor2[M * N2];  // on the stack
-      double* jacobians[] = {rowMajor1, rowMajor2};
-      success = AutoDiff<FUNCTOR, double, N1, N2>::Differentiate(
-          f, parameters, M, result.data(), jacobians);
-
-      // Convert from row-major to columnn-major
-      // TODO: if this is a bottleneck (probably not!) fix Autodiff to be
-      // Column-Major
-      if (H1) *H1 = Eigen::Map<RowMajor1>(rowMajor1);
-      if (H2) *H2 = Eigen::Map<RowMajor2>(rowMajor2);
+      // Seed the lanes: the first N1 for v1, the next N2 for v2, on the stack
+      JetT x1[N1], x2[N2], y[M];
+      for (int j = 0; j < N1; ++j)
+        x1[j] = JetT(v1[j], j);
+      for (int j = 0; j < N2; ++j)
+        x2[j] = JetT(v2[j], N1 + j);
+      success = f(x1, x2, y);
+
+      // Copy the lanes of every output into a row of the Jacobians
+      for (int i = 0; i < M; ++i) {
+        result[i] = y[i].a;
+        if (H1) H1->row(i) = y[i].v.template segment<N1>(0).transpose();
+        if (H2) H2->row(i) = y[i].v.template segment<N2>(N1).transpose();
+      }
 
     } else {
       // Apply the mapping, to get result
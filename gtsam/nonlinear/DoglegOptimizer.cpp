@@ -54,7 +54,7 @@ std::string DoglegParams::verbosityDLTranslator(VerbosityDL verbosityDL) const {
 void DoglegOptimizer::iterate(void) {
 
   // Linearize graph
-  GaussianFactorGraph::shared_ptr linear = graph_.linearize(state_.values);
+  GaussianFactorGraph::shared_ptr linear = linearizeWithCache(state_.values);
 
   // Pull out parameters we'll use
   const bool dlVerbose = (params_.verbosityDL > DoglegParams::SILENT);
@@ -63,18 +63,20 @@ void DoglegOptimizer::iterate(void) {
   DoglegOptimizerImpl::IterationResult result;
 
   if ( params_.isMultifrontal() ) {
-    GaussianBayesTree bt = *linear->eliminateMultifrontal(*params_.ordering, params_.getEliminationFunction());
-    VectorValues dx_u = bt.optimizeGradientSearch();
-    VectorValues dx_n = bt.optimize();
+    // The symbolic elimination is reused between iterations, and changes of the trust region
+    // radius in Iterate only blend dx_u and dx_n again
+    GaussianBayesTree::shared_ptr bt = eliminateMultifrontal(*linear, params_);
+    VectorValues dx_u = bt->optimizeGradientSearch();
+    VectorValues dx_n = bt->optimize();
     result = DoglegOptimizerImpl::Iterate(state_.Delta, DoglegOptimizerImpl::ONE_STEP_PER_ITERATION,
-      dx_u, dx_n, bt, graph_, state_.values, state_.error, dlVerbose);
+      dx_u, dx_n, *bt, graph_, state_.values, state_.error, dlVerbose, params_.errorGrainSize);
   }
   else if ( params_.isSequential() ) {
     GaussianBayesNet bn = *linear->eliminateSequential(*params_.ordering, params_.getEliminationFunction());
     VectorValues dx_u = bn.optimizeGradientSearch();
     VectorValues dx_n = bn.optimize();
     result = DoglegOptimizerImpl::Iterate(state_.Delta, DoglegOptimizerImpl::ONE_STEP_PER_ITERATION,
-      dx_u, dx_n, bn, graph_, state_.values, state_.error, dlVerbose);
+      dx_u, dx_n, bn, graph_, state_.values, state_.error, dlVerbose, params_.errorGrainSize);
   }
   else if ( params_.isIterative() ) {
     throw runtime_error("Dogleg is not currently compatible with the linear conjugate gradient solver");
@@ -87,7 +89,7 @@ void DoglegOptimizer::iterate(void) {
   if(params_.verbosity >= NonlinearOptimizerParams::DELTA) result.dx_d.print("delta");
 
   // Create new state with new values and new error
-  state_.values = state_.values.retract(result.dx_d);
+  state_.values.retractInPlace(result.dx_d);
   state_.error = result.f_error;
   state_.Delta = result.Delta;
   ++state_.iterations;
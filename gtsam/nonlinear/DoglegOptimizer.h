@@ -75,7 +75,7 @@ public:
 
 protected:
   DoglegState(const NonlinearFactorGraph& graph, const Values& values, const DoglegParams& params, unsigned int iterations = 0) :
-    NonlinearOptimizerState(graph, values, iterations), Delta(params.deltaInitial) {}
+    NonlinearOptimizerState(graph, values, iterations, params.errorGrainSize), Delta(params.deltaInitial) {}
 
   friend class DoglegOptimizer;
 };
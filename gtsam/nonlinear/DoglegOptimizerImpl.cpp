@@ -24,23 +24,34 @@ namespace gtsam {
 /* ************************************************************************* */
 VectorValues DoglegOptimizerImpl::ComputeDoglegPoint(
     double Delta, const VectorValues& dx_u, const VectorValues& dx_n, const bool verbose) {
+  return DoglegPath(dx_u, dx_n).point(Delta, verbose);
+}
+
+/* ************************************************************************* */
+DoglegOptimizerImpl::DoglegPath::DoglegPath(const VectorValues& dx_u, const VectorValues& dx_n) :
+    dx_u(dx_u), dx_n(dx_n), uu(dx_u.squaredNorm()), nn(dx_n.squaredNorm()), un(dot(dx_u, dx_n)) {
+}
+
+/* ************************************************************************* */
+VectorValues DoglegOptimizerImpl::DoglegPath::point(double Delta, const bool verbose) const {
 
   // Get magnitude of each update and find out which segment Delta falls in
   assert(Delta >= 0.0);
   double DeltaSq = Delta*Delta;
-  double x_u_norm_sq = dx_u.squaredNorm();
-  double x_n_norm_sq = dx_n.squaredNorm();
-  if(verbose) cout << "Steepest descent magnitude " << std::sqrt(x_u_norm_sq) << ", Newton's method magnitude " << std::sqrt(x_n_norm_sq) << endl;
-  if(DeltaSq < x_u_norm_sq) {
+  if(verbose) cout << "Steepest descent magnitude " << std::sqrt(uu) << ", Newton's method magnitude " << std::sqrt(nn) << endl;
+  if(DeltaSq < uu) {
     // Trust region is smaller than steepest descent update
-    VectorValues x_d = std::sqrt(DeltaSq / x_u_norm_sq) * dx_u;
-    if(verbose) cout << "In steepest descent region with fraction " << std::sqrt(DeltaSq / x_u_norm_sq) << " of steepest descent magnitude" << endl;
+    VectorValues x_d = std::sqrt(DeltaSq / uu) * dx_u;
+    if(verbose) cout << "In steepest descent region with fraction " << std::sqrt(DeltaSq / uu) << " of steepest descent magnitude" << endl;
     return x_d;
-  } else if(DeltaSq < x_n_norm_sq) {
+  } else if(DeltaSq < nn) {
     // Trust region boundary is between steepest descent point and Newton's method point
-    return ComputeBlend(Delta, dx_u, dx_n, verbose);
+    const double tau = BlendFraction(Delta, uu, nn, un);
+    if(verbose) cout << "In blend region with fraction " << tau << " of Newton's method point" << endl;
+    VectorValues blend = (1. - tau) * dx_u;  axpy(tau, dx_n, blend);
+    return blend;
   } else {
-    assert(DeltaSq >= x_n_norm_sq);
+    assert(DeltaSq >= nn);
     if(verbose) cout << "In pure Newton's method region" << endl;
     // Trust region is larger than Newton's method point
     return dx_n;
@@ -50,12 +61,19 @@ VectorValues DoglegOptimizerImpl::ComputeDoglegPoint(
 /* ************************************************************************* */
 VectorValues DoglegOptimizerImpl::ComputeBlend(double Delta, const VectorValues& x_u, const VectorValues& x_n, const bool verbose) {
 
-  // See doc/trustregion.lyx or doc/trustregion.pdf
-
   // Compute inner products
-  const double un = dot(x_u, x_n);
-  const double uu = dot(x_u, x_u);
-  const double nn = dot(x_n, x_n);
+  const double tau = BlendFraction(Delta, dot(x_u, x_u), dot(x_n, x_n), dot(x_u, x_n));
+
+  // Compute blended point
+  if(verbose) cout << "In blend region with fraction " << tau << " of Newton's method point" << endl;
+  VectorValues blend = (1. - tau) * x_u;  axpy(tau, x_n, blend);
+  return blend;
+}
+
+/* ************************************************************************* */
+double DoglegOptimizerImpl::BlendFraction(double Delta, double uu, double nn, double un) {
+
+  // See doc/trustregion.lyx or doc/trustregion.pdf
 
   // Compute quadratic formula terms
   const double a = uu - 2.*un + nn;
@@ -75,11 +93,7 @@ VectorValues DoglegOptimizerImpl::ComputeBlend(double Delta, const VectorValues&
     assert(0.0 <= tau2 && tau2 <= 1.0);
     tau = tau2;
   }
-
-  // Compute blended point
-  if(verbose) cout << "In blend region with fraction " << tau << " of Newton's method point" << endl;
-  VectorValues blend = (1. - tau) * x_u;  axpy(tau, x_n, blend);
-  return blend;
+  return tau;
 }
 
 }
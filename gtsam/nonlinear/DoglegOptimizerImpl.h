@@ -20,6 +20,11 @@
 
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/task_group.h>
+#endif
 
 namespace gtsam {
 
@@ -94,7 +99,24 @@ struct GTSAM_EXPORT DoglegOptimizerImpl {
   template<class M, class F, class VALUES>
   static IterationResult Iterate(
       double Delta, TrustRegionAdaptationMode mode, const VectorValues& dx_u, const VectorValues& dx_n,
-      const M& Rd, const F& f, const VALUES& x0, const double f_error, const bool verbose=false);
+      const M& Rd, const F& f, const VALUES& x0, const double f_error, const bool verbose=false,
+      size_t errorGrainSize = 0);
+
+  /** The dogleg path from zero through the steepest descent point \c dx_u to the Gauss-Newton
+   * point \c dx_n.  The squared norms and the inner product of the two points are computed once,
+   * so that the dogleg point for another trust region radius, as Iterate tries when the radius
+   * changes, only costs a scaled sum of the two points and never a new elimination.
+   */
+  struct GTSAM_EXPORT DoglegPath {
+    const VectorValues& dx_u; ///< The steepest descent point
+    const VectorValues& dx_n; ///< The Gauss-Newton point
+    double uu, nn, un; ///< dx_u'dx_u, dx_n'dx_n and dx_u'dx_n
+
+    DoglegPath(const VectorValues& dx_u, const VectorValues& dx_n);
+
+    /// The dogleg point for the trust region radius \c Delta, see ComputeDoglegPoint
+    VectorValues point(double Delta, const bool verbose=false) const;
+  };
 
   /**
    * Compute the dogleg point given a trust region radius \f$ \Delta \f$.  The
@@ -130,19 +152,72 @@ struct GTSAM_EXPORT DoglegOptimizerImpl {
    * @param x_n Newton's method minimizer
    */
   static VectorValues ComputeBlend(double Delta, const VectorValues& x_u, const VectorValues& x_n, const bool verbose=false);
+
+private:
+  /// The fraction \f$ \tau \f$ of ComputeBlend, from the inner products of x_u and x_n
+  static double BlendFraction(double Delta, double uu, double nn, double un);
 };
 
+namespace internal {
+/// The errors of the nonlinear function and of its linear model at a dogleg step, which
+/// DoglegOptimizerImpl::Iterate evaluates concurrently with TBB
+template<class M, class F, class VALUES>
+struct DoglegStepErrors {
+  const M& Rd;
+  const F& f;
+  const VALUES& x0;
+  const VectorValues& dx;
+  size_t grainSize;
+  double f_error, M_error;
+
+  DoglegStepErrors(const M& Rd, const F& f, const VALUES& x0, const VectorValues& dx,
+      size_t grainSize) :
+      Rd(Rd), f(f), x0(x0), dx(dx), grainSize(grainSize), f_error(0.0), M_error(0.0) {
+  }
+
+  /// Error of the nonlinear function at the retracted step
+  void nonlinear() {
+    const VALUES x_d(x0.retract(dx));
+    f_error = f.error(x_d, grainSize);
+  }
+
+  /// Task computing the nonlinear error while the calling thread computes the linear one
+  struct NonlinearTask {
+    DoglegStepErrors* errors;
+    explicit NonlinearTask(DoglegStepErrors* errors) : errors(errors) {}
+    void operator()() const { errors->nonlinear(); }
+  };
+
+  /// Evaluate both errors
+  void evaluate() {
+#ifdef GTSAM_USE_TBB
+    tbb::task_group tasks;
+    tasks.run(NonlinearTask(this));
+    M_error = Rd.error(dx);
+    tasks.wait();
+#else
+    nonlinear();
+    M_error = Rd.error(dx);
+#endif
+  }
+};
+}
+
 
 /* ************************************************************************* */
 template<class M, class F, class VALUES>
 typename DoglegOptimizerImpl::IterationResult DoglegOptimizerImpl::Iterate(
     double Delta, TrustRegionAdaptationMode mode, const VectorValues& dx_u, const VectorValues& dx_n,
-    const M& Rd, const F& f, const VALUES& x0, const double f_error, const bool verbose)
+    const M& Rd, const F& f, const VALUES& x0, const double f_error, const bool verbose,
+    size_t errorGrainSize)
 {
   gttic(M_error);
   const double M_error = Rd.error(VectorValues::Zero(dx_u));
   gttoc(M_error);
 
+  // The points of the dogleg path stay the same when Delta changes, only the blend changes
+  const DoglegPath path(dx_u, dx_n);
+
   // Result to return
   IterationResult result;
 
@@ -151,25 +226,18 @@ typename DoglegOptimizerImpl::IterationResult DoglegOptimizerImpl::Iterate(
   while(stay) {
     gttic(Dog_leg_point);
     // Compute dog leg point
-    result.dx_d = ComputeDoglegPoint(Delta, dx_u, dx_n, verbose);
+    result.dx_d = path.point(Delta, verbose);
     gttoc(Dog_leg_point);
 
     if(verbose) std::cout << "Delta = " << Delta << ", dx_d_norm = " << result.dx_d.norm() << std::endl;
 
-    gttic(retract);
-    // Compute expmapped solution
-    const VALUES x_d(x0.retract(result.dx_d));
-    gttoc(retract);
-
-    gttic(decrease_in_f);
-    // Compute decrease in f
-    result.f_error = f.error(x_d);
-    gttoc(decrease_in_f);
-
-    gttic(new_M_error);
-    // Compute decrease in M
-    const double new_M_error = Rd.error(result.dx_d);
-    gttoc(new_M_error);
+    gttic(step_errors);
+    // Compute decrease in f at the expmapped solution, and decrease in M, concurrently
+    internal::DoglegStepErrors<M, F, VALUES> errors(Rd, f, x0, result.dx_d, errorGrainSize);
+    errors.evaluate();
+    result.f_error = errors.f_error;
+    const double new_M_error = errors.M_error;
+    gttoc(step_errors);
 
     if(verbose) std::cout << std::setprecision(15) << "f error: " << f_error << " -> " << result.f_error << std::endl;
     if(verbose) std::cout << std::setprecision(15) << "M error: " << M_error << " -> " << new_M_error << std::endl;
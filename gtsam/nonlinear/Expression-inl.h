@@ -20,6 +20,7 @@
 #pragma once
 
 #include <gtsam/nonlinear/internal/ExpressionNode.h>
+#include <gtsam/base/ScratchBuffer.h>
 
 #include <boost/tuple/tuple.hpp>
 #include <boost/range/adaptor/map.hpp>
@@ -141,6 +142,13 @@ T Expression<T>::value(const Values& values,
     return root_->value(values);
 }
 
+template<typename T>
+Expression<T> Expression<T>::shareable() const {
+  Expression<T> result;
+  result.root_.reset(new internal::SharedExpression<T>(root_));
+  return result;
+}
+
 template<typename T>
 const boost::shared_ptr<internal::ExpressionNode<T> >& Expression<T>::root() const {
   return root_;
@@ -188,29 +196,19 @@ template<typename T>
 T Expression<T>::valueAndJacobianMap(const Values& values,
     internal::JacobianMap& jacobians) const {
   // The following piece of code is absolutely crucial for performance.
-  // We allocate a block of memory on the stack, which can be done at runtime
-  // with modern C++ compilers. The traceExecution then fills this memory
-  // with an execution trace, made up entirely of "Record" structs, see
-  // the FunctionalNode class in expression-inl.h
-  size_t size = traceSize();
-
-  // Windows does not support variable length arrays, so memory must be dynamically
-  // allocated on Visual Studio. For more information see the issue below
-  // https://bitbucket.org/gtborg/gtsam/issue/178/vlas-unsupported-in-visual-studio
-#ifdef _MSC_VER
-  internal::ExecutionTraceStorage* traceStorage = new internal::ExecutionTraceStorage[size];
-#else
-  internal::ExecutionTraceStorage traceStorage[size];
-#endif
+  // The traceExecution fills a block of memory with an execution trace, made
+  // up entirely of "Record" structs, see the FunctionalNode class in
+  // expression-inl.h. The memory is a per-thread scratch buffer that is
+  // reused across calls, so no memory is allocated once it has grown.
+  ScratchBuffer::Lease scratch(
+      traceSize() * sizeof(internal::ExecutionTraceStorage));
+  internal::ExecutionTraceStorage* traceStorage =
+      reinterpret_cast<internal::ExecutionTraceStorage*>(scratch.data());
 
   internal::ExecutionTrace<T> trace;
   T value(this->traceExecution(values, trace, traceStorage));
   trace.startReverseAD1(jacobians);
 
-#ifdef _MSC_VER
-  delete[] traceStorage;
-#endif
-
   return value;
 }
 
@@ -164,6 +164,14 @@ public:
     return boost::make_shared<Expression>(*this);
   }
 
+  /**
+   * Return an expression with the same value that is evaluated only once per LinearizationPass:
+   * the first factor needing it computes its value and Jacobians, and all other factors
+   * referencing the returned expression reuse them.  Use it for costly sub-expressions common to
+   * many factors, e.g. the inverse of a camera pose observing many landmarks.
+   */
+  Expression<T> shareable() const;
+
   /// Return root
   const boost::shared_ptr<internal::ExpressionNode<T> >& root() const;
 
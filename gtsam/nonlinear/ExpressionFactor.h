@@ -26,12 +26,34 @@
 
 namespace gtsam {
 
+namespace internal {
+
+/**
+ * Access to the compiled expression of an ExpressionFactor that does not depend on its type,
+ * through which ExpressionFactorGraph linearizes structurally identical factors in batches.
+ */
+class BatchLinearizable {
+public:
+  virtual ~BatchLinearizable() {}
+
+  /// The compiled expression, or null if the expression could not be compiled
+  virtual const ExpressionTape* tape() const = 0;
+
+  /// Shape factor and zero its Jacobian, see linearizeInto.  Returns false if not active.
+  virtual bool prepareLinearization(const Values& x, JacobianFactor& factor) const = 0;
+
+  /// Set the right-hand side of factor, and whiten it, once the tape was evaluated in buffer
+  virtual void finishLinearization(const char* buffer, JacobianFactor& factor) const = 0;
+};
+
+}
+
 /**
 
  * Factor that supports arbitrary expressions via AD
  */
 template<typename T>
-class ExpressionFactor: public NoiseModelFactor {
+class ExpressionFactor: public NoiseModelFactor, public internal::BatchLinearizable {
   BOOST_CONCEPT_ASSERT((IsTestable<T>));
 
 protected:
@@ -42,6 +64,7 @@ protected:
   T measured_;  ///< the measurement to be compared with the expression
   Expression<T> expression_;  ///< the expression that is AD enabled
   FastVector<int> dims_;      ///< dimensions of the Jacobian matrices
+  boost::shared_ptr<const internal::ExpressionTape> tape_;  ///< compiled expression, if possible
 
 public:
 
@@ -81,13 +104,22 @@ public:
    */
   virtual Vector unwhitenedError(const Values& x,
       boost::optional<std::vector<Matrix>&> H = boost::none) const {
-    if (H) {
+    if (H && tape_) {
+      // Evaluate the tape into a zeroed VerticalBlockMatrix, as valueAndDerivatives does
+      assert(H->size() == keys_.size());
+      VerticalBlockMatrix Ab(dims_, Dim);
+      Ab.matrix().setZero();
+      const T value = tape_->evaluate<T>(x, &Ab);
+      for (DenseIndex i = 0; i < static_cast<DenseIndex>(keys_.size()); i++)
+        (*H)[i] = Ab(i);
+      return -traits<T>::Local(value, measured_);
+    } else if (H) {
       const T value = expression_.valueAndDerivatives(x, keys_, dims_, *H);
       // NOTE(hayk): Doing the reverse, AKA Local(measured_, value) is not correct here
       // because it would use the tangent space of the measurement instead of the value.
       return -traits<T>::Local(value, measured_);
     } else {
-      const T value = expression_.value(x);
+      const T value = tape_ ? tape_->evaluate<T>(x) : expression_.value(x);
       return -traits<T>::Local(value, measured_);
     }
   }
@@ -97,39 +129,85 @@ public:
     if (!active(x))
       return boost::shared_ptr<JacobianFactor>();
 
-    // In case noise model is constrained, we need to provide a noise model
-    SharedDiagonal noiseModel;
-    if (noiseModel_ && noiseModel_->isConstrained()) {
-      noiseModel = boost::static_pointer_cast<noiseModel::Constrained>(
-          noiseModel_)->unit();
-    }
-
     // Create a writeable JacobianFactor in advance
     boost::shared_ptr<JacobianFactor> factor(
-        new JacobianFactor(keys_, dims_, Dim, noiseModel));
+        new JacobianFactor(keys_, dims_, Dim, SharedDiagonal()));
+    linearizeInto(x, *factor);
+    return factor;
+  }
+
+  /**
+   * Linearize into an existing JacobianFactor, e.g. the result of a previous linearization.
+   * If it already has the keys and block dimensions of this factor, the whitened Jacobian and
+   * right-hand side are written straight into its storage, so nothing is allocated; otherwise
+   * it is reshaped first.  Returns false, and leaves \c factor unchanged, if this factor is not
+   * active.
+   */
+  bool linearizeInto(const Values& x, JacobianFactor& factor) const {
+    if (!prepareLinearization(x, factor))
+      return false;
 
     // Wrap keys and VerticalBlockMatrix into structure passed to expression_
-    VerticalBlockMatrix& Ab = factor->matrixObject();
+    VerticalBlockMatrix& Ab = factor.Ab_;
     internal::JacobianMap jacobianMap(keys_, Ab);
 
-    // Zero out Jacobian so we can simply add to it
-    Ab.matrix().setZero();
-
     // Get value and Jacobians, writing directly into JacobianFactor
-    T value = expression_.valueAndJacobianMap(x, jacobianMap); // <<< Reverse AD happens here !
+    T value = tape_ ? tape_->evaluate<T>(x, &Ab) : // <<< Reverse AD happens here !
+        expression_.valueAndJacobianMap(x, jacobianMap);
+
+    finishLinearization(value, factor);
+    return true;
+  }
+
+  /// Linearize into factor if it is a JacobianFactor, see linearizeInto above
+  virtual bool linearizeInto(const Values& x, GaussianFactor& factor) const {
+    JacobianFactor* jacobian = dynamic_cast<JacobianFactor*>(&factor);
+    return jacobian && linearizeInto(x, *jacobian);
+  }
+
+  /// @name BatchLinearizable
+  /// @{
 
-    // Evaluate error and set RHS vector b
-    Ab(size()).col(0) = traits<T>::Local(value, measured_);
+  virtual const internal::ExpressionTape* tape() const {
+    return tape_.get();
+  }
+
+  virtual bool prepareLinearization(const Values& x, JacobianFactor& factor) const {
+    // Only linearize if the factor is active
+    if (!active(x))
+      return false;
 
-    // Whiten the corresponding system, Ab already contains RHS
-    if (noiseModel_) {
-      Vector b = Ab(size()).col(0);  // need b to be valid for Robust noise models
-      noiseModel_->WhitenSystem(Ab.matrix(), b);
+    // In case noise model is constrained, we need to provide a noise model
+    SharedDiagonal noiseModel;
+    if (noiseModel_ && noiseModel_->isConstrained()) {
+      noiseModel = boost::static_pointer_cast<noiseModel::Constrained>(
+          noiseModel_)->unit();
     }
 
-    return factor;
+    // Reuse the storage of the factor if it has the right shape
+    VerticalBlockMatrix& Ab = factor.Ab_;
+    bool sameShape = factor.keys() == keys_ && Ab.rowStart() == 0 && Ab.firstBlock() == 0
+        && Ab.rows() == Dim && Ab.matrix().rows() == Dim
+        && Ab.nBlocks() == static_cast<DenseIndex>(dims_.size()) + 1;
+    for (size_t i = 0; sameShape && i < dims_.size(); i++)
+      sameShape = Ab(i).cols() == dims_[i];
+    if (!sameShape) {
+      factor.keys() = keys_;
+      Ab = VerticalBlockMatrix(dims_, Dim, true);
+    }
+    factor.model_ = noiseModel;
+
+    // Zero out Jacobian so we can simply add to it
+    Ab.matrix().setZero();
+    return true;
   }
 
+  virtual void finishLinearization(const char* buffer, JacobianFactor& factor) const {
+    finishLinearization(internal::TapeValue<T>(buffer, tape_->rootValue()), factor);
+  }
+
+  /// @}
+
   /// @return a deep copy of this factor
   virtual gtsam::NonlinearFactor::shared_ptr clone() const {
     return boost::static_pointer_cast<gtsam::NonlinearFactor>(
@@ -138,6 +216,21 @@ public:
 
 protected:
  ExpressionFactor() {}
+
+ /// Set the right-hand side from the value of the expression, and whiten the system
+ void finishLinearization(const T& value, JacobianFactor& factor) const {
+   VerticalBlockMatrix& Ab = factor.Ab_;
+
+   // Evaluate error and set RHS vector b
+   Ab(size()).col(0) = traits<T>::Local(value, measured_);
+
+   // Whiten the corresponding system, Ab already contains RHS
+   if (noiseModel_) {
+     Vector b = Ab(size()).col(0);  // need b to be valid for Robust noise models
+     noiseModel_->WhitenSystem(Ab.matrix(), b);
+   }
+ }
+
  /// Default constructor, for serialization
 
  /// Constructor for serializable derived classes
@@ -158,6 +251,11 @@ protected:
    // Get keys and dimensions for Jacobian matrices
    // An Expression is assumed unmutable, so we do this now
    boost::tie(keys_, dims_) = expression_.keysAndDims();
+
+   // Flatten the expression into a tape, so evaluation and reverse AD need no virtual calls
+   tape_ = boost::make_shared<internal::ExpressionTape>(*expression_.root());
+   if (!tape_->valid())
+     tape_.reset();
  }
 
  /// Recreate expression from keys_ and measured_, used in load below.
@@ -0,0 +1,161 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  ExpressionFactorGraph.cpp
+ *  @brief Factor graph that supports adding ExpressionFactors directly
+ *  @date Oct 15, 2026
+ */
+
+#include <gtsam/nonlinear/ExpressionFactorGraph.h>
+#include <gtsam/nonlinear/LinearizationPass.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/base/ScratchBuffer.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <boost/foreach.hpp>
+
+#include <vector>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+// Factors whose compiled expressions have the same structure
+struct Batchable {
+  const internal::ExpressionTape* shape;
+  vector<size_t> factors;
+  explicit Batchable(const internal::ExpressionTape* s) : shape(s) {}
+};
+
+// A range of the factors of a Batchable group
+struct Batch {
+  const Batchable* group;
+  size_t begin, end;
+  Batch(const Batchable* g, size_t b, size_t e) : group(g), begin(b), end(e) {}
+};
+
+// Linearize the factors of one batch together
+void _linearizeBatch(const vector<const internal::BatchLinearizable*>& batchable,
+    const Values& x,
+    const Batch& batch, GaussianFactorGraph& result) {
+  vector<const internal::ExpressionTape*> tapes;
+  vector<VerticalBlockMatrix*> Abs;
+  vector<size_t> active;
+  tapes.reserve(batch.end - batch.begin);
+  Abs.reserve(batch.end - batch.begin);
+  active.reserve(batch.end - batch.begin);
+  for (size_t j = batch.begin; j < batch.end; ++j) {
+    const size_t i = batch.group->factors[j];
+    JacobianFactor::shared_ptr factor = boost::make_shared<JacobianFactor>();
+    if (!batchable[i]->prepareLinearization(x, *factor)) {
+      result[i] = GaussianFactor::shared_ptr();
+      continue;
+    }
+    result[i] = factor;
+    tapes.push_back(batchable[i]->tape());
+    Abs.push_back(&factor->matrixObject());
+    active.push_back(i);
+  }
+  if (tapes.empty())
+    return;
+
+  ScratchBuffer::Lease scratch(tapes.size() * batch.group->shape->batchBufferSize());
+  internal::ExpressionTape::EvaluateBatch(tapes, x, scratch.data(), Abs);
+  const size_t stride = batch.group->shape->batchBufferSize();
+  try {
+    for (size_t k = 0; k < active.size(); ++k)
+      batchable[active[k]]->finishLinearization(scratch.data() + k * stride,
+          static_cast<JacobianFactor&>(*result[active[k]]));
+  } catch (...) {
+    internal::ExpressionTape::DestroyBatch(tapes, scratch.data());
+    throw;
+  }
+  internal::ExpressionTape::DestroyBatch(tapes, scratch.data());
+}
+
+#ifdef GTSAM_USE_TBB
+class _LinearizeBatches {
+  const vector<const internal::BatchLinearizable*>& batchable_;
+  const Values& x_;
+  const vector<Batch>& batches_;
+  GaussianFactorGraph& result_;
+public:
+  _LinearizeBatches(const vector<const internal::BatchLinearizable*>& batchable,
+      const Values& x, const vector<Batch>& batches, GaussianFactorGraph& result) :
+      batchable_(batchable), x_(x), batches_(batches), result_(result) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    for (size_t b = blocked_range.begin(); b != blocked_range.end(); ++b)
+      _linearizeBatch(batchable_, x_, batches_[b], result_);
+  }
+};
+#endif
+
+}
+
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr ExpressionFactorGraph::linearizeBatched(const Values& x,
+    size_t batchSize) const {
+  gttic(ExpressionFactorGraph_linearizeBatched);
+  const LinearizationPass pass(x);
+  GaussianFactorGraph::shared_ptr linearFG = boost::make_shared<GaussianFactorGraph>();
+  linearFG->resize(size());
+  if (batchSize == 0)
+    batchSize = 1;
+
+  // Group the compiled ExpressionFactors by structure, there are usually only a few structures
+  vector<const internal::BatchLinearizable*> batchable(size(), 0);
+  vector<Batchable> groups;
+  for (size_t i = 0; i < size(); ++i) {
+    if (!at(i))
+      continue;
+    const internal::BatchLinearizable* factor =
+        dynamic_cast<const internal::BatchLinearizable*>(at(i).get());
+    if (!factor || !factor->tape()) {
+      (*linearFG)[i] = at(i)->linearize(x);
+      continue;
+    }
+    batchable[i] = factor;
+    size_t g = 0;
+    while (g < groups.size() && !groups[g].shape->sameStructure(*factor->tape()))
+      ++g;
+    if (g == groups.size())
+      groups.push_back(Batchable(factor->tape()));
+    groups[g].factors.push_back(i);
+  }
+
+  // Split the groups into batches and linearize those
+  vector<Batch> batches;
+  BOOST_FOREACH(const Batchable& group, groups) {
+    for (size_t begin = 0; begin < group.factors.size(); begin += batchSize)
+      batches.push_back(Batch(&group, begin, min(begin + batchSize, group.factors.size())));
+  }
+#ifdef GTSAM_USE_TBB
+  TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, batches.size()),
+      _LinearizeBatches(batchable, x, batches, *linearFG));
+#else
+  BOOST_FOREACH(const Batch& batch, batches)
+    _linearizeBatch(batchable, x, batch, *linearFG);
+#endif
+
+  return linearFG;
+}
+
+}
@@ -26,7 +26,7 @@ namespace gtsam {
 /**
  * Factor graph that supports adding ExpressionFactors directly
  */
-class ExpressionFactorGraph: public NonlinearFactorGraph {
+class GTSAM_EXPORT ExpressionFactorGraph: public NonlinearFactorGraph {
 
 public:
 
@@ -46,6 +46,22 @@ public:
   }
 
   /// @}
+
+  /// @name Linearization
+  /// @{
+
+  /**
+   * Linearize like NonlinearFactorGraph::linearize, but evaluate ExpressionFactors whose
+   * compiled expressions have the same structure, e.g. the projection factors of a structure
+   * from motion problem, together in batches of at most \c batchSize factors.  Within a batch
+   * each step of the expression is done for all factors before the next one, with the values
+   * and Jacobians of the whole batch side by side in one scratch buffer.  Other factors are
+   * linearized one by one.
+   */
+  boost::shared_ptr<GaussianFactorGraph> linearizeBatched(const Values& x,
+      size_t batchSize = 64) const;
+
+  /// @}
 };
 
 }
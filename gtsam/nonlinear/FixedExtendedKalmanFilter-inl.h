@@ -0,0 +1,112 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FixedExtendedKalmanFilter-inl.h
+ * @brief   Extended Kalman Filter for a state with a compile-time dimension, without factor graphs
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/FixedExtendedKalmanFilter.h>
+#include <gtsam/linear/linearExceptions.h>
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  template<class VALUE>
+  void FixedExtendedKalmanFilter<VALUE>::solve_(const MatrixD& information, const VectorD& eta) {
+    const Eigen::LLT<MatrixD> llt(information);
+    if (llt.info() != Eigen::Success)
+      throw IndeterminantLinearSystemException(0);
+
+    // Move the linearization point to the mean, where the density has a zero right-hand side
+    const VectorD delta = llt.solve(eta);
+    x_ = traits<T>::Retract(x_, delta);
+    R_ = llt.matrixU();
+  }
+
+  /* ************************************************************************* */
+  template<class VALUE>
+  FixedExtendedKalmanFilter<VALUE>::FixedExtendedKalmanFilter(const T& x_initial,
+      const noiseModel::Gaussian::shared_ptr& P_initial) :
+      x_(x_initial), R_(P_initial->R()) {
+  }
+
+  /* ************************************************************************* */
+  template<class VALUE>
+  typename FixedExtendedKalmanFilter<VALUE>::MatrixD
+  FixedExtendedKalmanFilter<VALUE>::covariance() const {
+    const MatrixD Rinv = R_.template triangularView<Eigen::Upper>().solve(MatrixD::Identity());
+    return Rinv * Rinv.transpose();
+  }
+
+  /* ************************************************************************* */
+  template<class VALUE>
+  typename FixedExtendedKalmanFilter<VALUE>::T FixedExtendedKalmanFilter<VALUE>::predict(
+      const MotionFactor& motionFactor) {
+
+    // Whitened linearization H1*d0 + H2*d1 = b of the motion factor, where both states are
+    // linearized at the current estimate, as in ExtendedKalmanFilter
+    b_ = motionFactor.evaluateError(x_, x_, H1_, H2_);
+    const SharedNoiseModel model = motionFactor.get_noiseModel();
+    if (model)
+      model->WhitenSystem(H1_, H2_, b_);
+    b_ = -b_;
+
+    // Information form of the joint density of the current and the next state
+    MatrixD information00, information01, information11;
+    information00.noalias() = R_.transpose() * R_;
+    information00.noalias() += H1_.transpose() * H1_;
+    information01.noalias() = H1_.transpose() * H2_;
+    information11.noalias() = H2_.transpose() * H2_;
+    VectorD eta0, eta1;
+    eta0.noalias() = H1_.transpose() * b_;
+    eta1.noalias() = H2_.transpose() * b_;
+
+    // Marginalize out the current state with the Schur complement
+    const Eigen::LLT<MatrixD> llt00(information00);
+    if (llt00.info() != Eigen::Success)
+      throw IndeterminantLinearSystemException(motionFactor.key1());
+    const MatrixD Y = llt00.solve(information01);
+    const VectorD y = llt00.solve(eta0);
+    information11.noalias() -= information01.transpose() * Y;
+    eta1.noalias() -= information01.transpose() * y;
+
+    solve_(information11, eta1);
+    return x_;
+  }
+
+  /* ************************************************************************* */
+  template<class VALUE>
+  typename FixedExtendedKalmanFilter<VALUE>::T FixedExtendedKalmanFilter<VALUE>::update(
+      const MeasurementFactor& measurementFactor) {
+
+    // Whitened linearization H1*d = b of the measurement factor at the current estimate
+    b_ = measurementFactor.evaluateError(x_, H1_);
+    const SharedNoiseModel model = measurementFactor.get_noiseModel();
+    if (model)
+      model->WhitenSystem(H1_, b_);
+    b_ = -b_;
+
+    // Add the measurement to the information form of the density
+    MatrixD information;
+    information.noalias() = R_.transpose() * R_;
+    information.noalias() += H1_.transpose() * H1_;
+    VectorD eta;
+    eta.noalias() = H1_.transpose() * b_;
+
+    solve_(information, eta);
+    return x_;
+  }
+
+} // namespace gtsam
@@ -0,0 +1,121 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FixedExtendedKalmanFilter.h
+ * @brief   Extended Kalman Filter for a state with a compile-time dimension, without factor graphs
+ * @date    Oct 15, 2026
+ */
+
+// \callgraph
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/linear/NoiseModel.h>
+
+#include <Eigen/Cholesky>
+
+namespace gtsam {
+
+  /**
+   * An Extended Kalman Filter with the same predict and update steps as ExtendedKalmanFilter, for
+   * a VALUE type with a fixed dimension.  Instead of building, linearizing and eliminating a
+   * factor graph at every step, the motion and measurement factors are linearized directly by
+   * their evaluateError() and whitened by their noise model, and the D x D square root
+   * information matrix of the density is updated in place, in fixed-size matrices.  Once the
+   * Jacobian workspaces have been sized by the first predict and update, the only allocation
+   * of a step is the error vector returned by evaluateError(), which makes the filter suitable
+   * for high-rate embedded estimators.
+   *
+   * As ExtendedKalmanFilter, this filter ignores the keys of the factors.  Factors that override
+   * linearize() with a custom whitening are linearized as evaluateError() and their noise model
+   * define them, not by their linearize().
+   * \nosubgrouping
+   */
+  template<class VALUE>
+  class FixedExtendedKalmanFilter {
+
+    // Check that VALUE type is a testable Manifold
+    BOOST_CONCEPT_ASSERT((IsTestable<VALUE>));
+    BOOST_CONCEPT_ASSERT((IsManifold<VALUE>));
+
+  public:
+
+    typedef VALUE T;
+    enum { D = traits<VALUE>::dimension };
+    BOOST_STATIC_ASSERT_MSG(D != Eigen::Dynamic,
+        "FixedExtendedKalmanFilter needs a VALUE with a fixed dimension, use ExtendedKalmanFilter");
+
+    typedef Eigen::Matrix<double, D, D> MatrixD;
+    typedef Eigen::Matrix<double, D, 1> VectorD;
+    typedef NoiseModelFactor2<VALUE, VALUE> MotionFactor;
+    typedef NoiseModelFactor1<VALUE> MeasurementFactor;
+
+  protected:
+    T x_; // linearization point, at which the density has zero mean
+    MatrixD R_; // upper triangular square root information matrix of the density
+
+    // Workspaces for the whitened Jacobians and error of the factors, sized by the first steps
+    Matrix H1_, H2_;
+    Vector b_;
+
+    // Move the linearization point by the mean of the information form (information, eta), and
+    // keep the Cholesky factor of information as the new density
+    void solve_(const MatrixD& information, const VectorD& eta);
+
+  public:
+
+    /// @name Standard Constructors
+    /// @{
+
+    /// Start at x_initial with the covariance of the Gaussian noise model P_initial
+    FixedExtendedKalmanFilter(const T& x_initial, const noiseModel::Gaussian::shared_ptr& P_initial);
+
+    /// @}
+    /// @name Testable
+    /// @{
+
+    /// print
+    void print(const std::string& s="") const {
+      std::cout << s << "\n";
+      x_.print(s+"x");
+      std::cout << s << "R:\n" << R_ << std::endl;
+    }
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /// The current estimate
+    const T& estimate() const { return x_; }
+
+    /// The upper triangular square root information matrix of the current estimate
+    const MatrixD& R() const { return R_; }
+
+    /// The covariance of the current estimate
+    MatrixD covariance() const;
+
+    /// @}
+    /// @name Advanced Interface
+    /// @{
+
+    /// Predict the next state with a motion factor between the current and the next state
+    T predict(const MotionFactor& motionFactor);
+
+    /// Update the current state with a measurement factor
+    T update(const MeasurementFactor& measurementFactor);
+
+    /// @}
+  };
+
+} // namespace
+
+#include <gtsam/nonlinear/FixedExtendedKalmanFilter-inl.h>
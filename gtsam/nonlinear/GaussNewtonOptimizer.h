@@ -32,8 +32,9 @@ class GTSAM_EXPORT GaussNewtonParams : public NonlinearOptimizerParams {
 
 class GTSAM_EXPORT GaussNewtonState : public NonlinearOptimizerState {
 protected:
-  GaussNewtonState(const NonlinearFactorGraph& graph, const Values& values, unsigned int iterations = 0) :
-    NonlinearOptimizerState(graph, values, iterations) {}
+  GaussNewtonState(const NonlinearFactorGraph& graph, const Values& values, unsigned int iterations = 0,
+      size_t errorGrainSize = 0) :
+    NonlinearOptimizerState(graph, values, iterations, errorGrainSize) {}
 
   friend class GaussNewtonOptimizer;
 };
@@ -61,7 +62,8 @@ public:
    */
   GaussNewtonOptimizer(const NonlinearFactorGraph& graph, const Values& initialValues,
       const GaussNewtonParams& params = GaussNewtonParams()) :
-        NonlinearOptimizer(graph), params_(ensureHasOrdering(params, graph)), state_(graph, initialValues) {}
+        NonlinearOptimizer(graph), params_(ensureHasOrdering(params, graph)),
+        state_(graph, initialValues, 0, params_.errorGrainSize) {}
 
   /** Standard constructor, requires a nonlinear factor graph, initial
    * variable assignments, and optimization parameters.  For convenience this
@@ -71,7 +73,7 @@ public:
    * @param initialValues The initial variable assignments
    */
   GaussNewtonOptimizer(const NonlinearFactorGraph& graph, const Values& initialValues, const Ordering& ordering) :
-        NonlinearOptimizer(graph), state_(graph, initialValues) {
+        NonlinearOptimizer(graph), state_(graph, initialValues, 0, params_.errorGrainSize) {
     params_.ordering = ordering; }
 
   /// @}
@@ -21,6 +21,12 @@
 #include <gtsam/base/debug.h>
 #include <gtsam/config.h> // for GTSAM_USE_TBB
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_reduce.h>
+#endif
+
+#include <algorithm>
 #include <functional>
 #include <boost/range/adaptors.hpp>
 
@@ -46,7 +52,8 @@ void ISAM2::Impl::AddVariables(
 
 /* ************************************************************************* */
 void ISAM2::Impl::AddFactorsStep1(const NonlinearFactorGraph& newFactors, bool useUnusedSlots,
-  NonlinearFactorGraph& nonlinearFactors, FastVector<size_t>& newFactorIndices)
+  NonlinearFactorGraph& nonlinearFactors, FastVector<size_t>& newFactorIndices,
+  const FastMap<size_t, size_t>& evictedFactors)
 {
   newFactorIndices.resize(newFactors.size());
 
@@ -65,7 +72,7 @@ void ISAM2::Impl::AddFactorsStep1(const NonlinearFactorGraph& newFactors, bool u
         // out of the loop and use the current slot.
         if(globalFactorIndex >= nonlinearFactors.size())
           nonlinearFactors.resize(nonlinearFactors.size() + newFactors.size() - newFactorIndex);
-        else if(nonlinearFactors[globalFactorIndex])
+        else if(nonlinearFactors[globalFactorIndex] || evictedFactors.exists(globalFactorIndex))
           ++ globalFactorIndex;
         else
           break;
@@ -105,31 +112,104 @@ void ISAM2::Impl::RemoveVariables(const KeySet& unusedKeys, const FastVector<ISA
 }
 
 /* ************************************************************************* */
-KeySet ISAM2::Impl::CheckRelinearizationFull(const VectorValues& delta,
-    const ISAM2Params::RelinearizationThreshold& relinearizeThreshold)
-{
-  KeySet relinKeys;
+namespace {
+// The relinearization thresholds resolved once per check: a uniform threshold, or a table of
+// per-variable threshold vectors indexed by the symbol character of the key, so a variable is
+// checked without a map lookup.
+class RelinearizationThresholds {
+  const double* uniform_;
+  const Vector* byChr_[256];
+public:
+  explicit RelinearizationThresholds(const ISAM2Params::RelinearizationThreshold& relinearizeThreshold) :
+      uniform_(boost::get<double>(&relinearizeThreshold)) {
+    std::fill(byChr_, byChr_ + 256, static_cast<const Vector*>(0));
+    if(const FastMap<char,Vector>* thresholds = boost::get<FastMap<char,Vector> >(&relinearizeThreshold)) {
+      for(FastMap<char,Vector>::const_iterator it = thresholds->begin(); it != thresholds->end(); ++it)
+        byChr_[static_cast<unsigned char>(it->first)] = &it->second;
+    }
+  }
 
-  if(const double* threshold = boost::get<double>(&relinearizeThreshold))
-  {
-    BOOST_FOREACH(const VectorValues::KeyValuePair& key_delta, delta) {
-      double maxDelta = key_delta.second.lpNorm<Eigen::Infinity>();
-      if(maxDelta >= *threshold)
-        relinKeys.insert(key_delta.first);
+  // Whether a variable is above the threshold, false (with valid false) if its threshold vector
+  // is missing or of the wrong dimension
+  bool exceeds(Key key, const Vector& delta, bool& valid) const {
+    if(uniform_)
+      return delta.lpNorm<Eigen::Infinity>() >= *uniform_;
+    const Vector* threshold = byChr_[Symbol(key).chr()];
+    valid = threshold && threshold->rows() == delta.rows();
+    return valid && (delta.array().abs() > threshold->array()).any();
+  }
+
+  void throwInvalid(Key key) const {
+    throw std::invalid_argument("Relinearization threshold vector dimensionality for '" + std::string(1, Symbol(key).chr()) + "' passed into iSAM2 parameters does not match actual variable dimensionality.");
+  }
+};
+
+// Checks a range of delta entries against the thresholds, collecting the keys above them.  An
+// invalid threshold is recorded instead of thrown, so it can be reported outside of TBB.
+class CheckRelinearizationRange {
+  const vector<const VectorValues::KeyValuePair*>& entries_;
+  const RelinearizationThresholds& thresholds_;
+public:
+  FastVector<Key> keys;
+  bool invalid;
+  Key invalidKey;
+  CheckRelinearizationRange(const vector<const VectorValues::KeyValuePair*>& entries,
+      const RelinearizationThresholds& thresholds) :
+      entries_(entries), thresholds_(thresholds), invalid(false), invalidKey(0) {}
+#ifdef GTSAM_USE_TBB
+  CheckRelinearizationRange(CheckRelinearizationRange& other, tbb::split) :
+      entries_(other.entries_), thresholds_(other.thresholds_), invalid(false), invalidKey(0) {}
+#endif
+  void operator()(size_t begin, size_t end) {
+    for(size_t i = begin; i != end; ++i) {
+      bool valid = true;
+      if(thresholds_.exceeds(entries_[i]->first, entries_[i]->second, valid))
+        keys.push_back(entries_[i]->first);
+      else if(!valid && !invalid) {
+        invalid = true;
+        invalidKey = entries_[i]->first;
+      }
     }
   }
-  else if(const FastMap<char,Vector>* thresholds = boost::get<FastMap<char,Vector> >(&relinearizeThreshold))
-  {
-    BOOST_FOREACH(const VectorValues::KeyValuePair& key_delta, delta) {
-      const Vector& threshold = thresholds->find(Symbol(key_delta.first).chr())->second;
-      if(threshold.rows() != key_delta.second.rows())
-        throw std::invalid_argument("Relinearization threshold vector dimensionality for '" + std::string(1, Symbol(key_delta.first).chr()) + "' passed into iSAM2 parameters does not match actual variable dimensionality.");
-      if((key_delta.second.array().abs() > threshold.array()).any())
-        relinKeys.insert(key_delta.first);
+#ifdef GTSAM_USE_TBB
+  void operator()(const tbb::blocked_range<size_t>& r) {
+    (*this)(r.begin(), r.end());
+  }
+  void join(const CheckRelinearizationRange& other) {
+    keys.insert(keys.end(), other.keys.begin(), other.keys.end());
+    if(other.invalid && !invalid) {
+      invalid = true;
+      invalidKey = other.invalidKey;
     }
   }
+#endif
+};
+}
 
-  return relinKeys;
+/* ************************************************************************* */
+KeySet ISAM2::Impl::CheckRelinearizationFull(const VectorValues& delta,
+    const ISAM2Params::RelinearizationThreshold& relinearizeThreshold)
+{
+  const RelinearizationThresholds thresholds(relinearizeThreshold);
+
+  // Lay the entries out contiguously so the check can be split into ranges
+  vector<const VectorValues::KeyValuePair*> entries;
+  entries.reserve(delta.size());
+  BOOST_FOREACH(const VectorValues::KeyValuePair& key_delta, delta)
+    entries.push_back(&key_delta);
+
+  CheckRelinearizationRange check(entries, thresholds);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_reduce(tbb::blocked_range<size_t>(0, entries.size(), 1024), check);
+#else
+  check(0, entries.size());
+#endif
+  if(check.invalid)
+    thresholds.throwInvalid(check.invalidKey);
+
+  // Sorted keys are inserted in linear time
+  std::sort(check.keys.begin(), check.keys.end());
+  return KeySet(check.keys.begin(), check.keys.end());
 }
 
 /* ************************************************************************* */
@@ -155,27 +235,20 @@ void CheckRelinearizationRecursiveDouble(KeySet& relinKeys, double threshold,
 }
 
 /* ************************************************************************* */
-void CheckRelinearizationRecursiveMap(KeySet& relinKeys, const FastMap<char,Vector>& thresholds,
+void CheckRelinearizationRecursiveMap(KeySet& relinKeys, const RelinearizationThresholds& thresholds,
                                       const VectorValues& delta,
                                       const ISAM2Clique::shared_ptr& clique)
 {
   // Check the current clique for relinearization
   bool relinearize = false;
   BOOST_FOREACH(Key var, *clique->conditional()) {
-    // Find the threshold for this variable type
-    const Vector& threshold = thresholds.find(Symbol(var).chr())->second;
-
-    const Vector& deltaVar = delta[var];
-
-    // Verify the threshold vector matches the actual variable size
-    if(threshold.rows() != deltaVar.rows())
-      throw std::invalid_argument("Relinearization threshold vector dimensionality for '" + std::string(1, Symbol(var).chr()) + "' passed into iSAM2 parameters does not match actual variable dimensionality.");
-
-    // Check for relinearization
-    if((deltaVar.array().abs() > threshold.array()).any()) {
+    bool valid = true;
+    if(thresholds.exceeds(var, delta[var], valid)) {
       relinKeys.insert(var);
       relinearize = true;
     }
+    else if(!valid)
+      thresholds.throwInvalid(var);
   }
 
   // If this node was relinearized, also check its children
@@ -192,23 +265,62 @@ KeySet ISAM2::Impl::CheckRelinearizationPartial(const FastVector<ISAM2::sharedCl
                                                         const ISAM2Params::RelinearizationThreshold& relinearizeThreshold)
 {
   KeySet relinKeys;
+  const RelinearizationThresholds thresholds(relinearizeThreshold);
   BOOST_FOREACH(const ISAM2::sharedClique& root, roots) {
     if(relinearizeThreshold.type() == typeid(double))
       CheckRelinearizationRecursiveDouble(relinKeys, boost::get<double>(relinearizeThreshold), delta, root);
     else if(relinearizeThreshold.type() == typeid(FastMap<char,Vector>))
-      CheckRelinearizationRecursiveMap(relinKeys, boost::get<FastMap<char,Vector> >(relinearizeThreshold), delta, root);
+      CheckRelinearizationRecursiveMap(relinKeys, thresholds, delta, root);
   }
   return relinKeys;
 }
 
 /* ************************************************************************* */
-void ISAM2::Impl::FindAll(ISAM2Clique::shared_ptr clique, KeySet& keys, const KeySet& markedMask)
+double ISAM2::Impl::RelinearizationPriority(Key key, const Vector& delta,
+    const ISAM2Params::RelinearizationThreshold& relinearizeThreshold)
+{
+  if(const double* threshold = boost::get<double>(&relinearizeThreshold))
+    return delta.lpNorm<Eigen::Infinity>() / *threshold;
+  const FastMap<char,Vector>& thresholds = boost::get<FastMap<char,Vector> >(relinearizeThreshold);
+  const Vector& threshold = thresholds.find(Symbol(key).chr())->second;
+  if(threshold.rows() != delta.rows())
+    throw std::invalid_argument("Relinearization threshold vector dimensionality for '" + std::string(1, Symbol(key).chr()) + "' passed into iSAM2 parameters does not match actual variable dimensionality.");
+  return (delta.array().abs() / threshold.array()).maxCoeff();
+}
+
+/* ************************************************************************* */
+KeySet ISAM2::Impl::LimitRelinearization(KeySet& relinKeys, const VectorValues& delta,
+    const ISAM2Params::RelinearizationThreshold& relinearizeThreshold, size_t budget)
+{
+  KeySet deferred;
+  if(budget == 0 || relinKeys.size() <= budget)
+    return deferred;
+
+  // Sort by decreasing priority, the key breaks ties to keep the selection deterministic
+  vector<pair<double, Key> > queue;
+  queue.reserve(relinKeys.size());
+  BOOST_FOREACH(Key key, relinKeys)
+    queue.push_back(make_pair(RelinearizationPriority(key, delta[key], relinearizeThreshold), key));
+  std::sort(queue.begin(), queue.end(), std::greater<pair<double, Key> >());
+
+  relinKeys.clear();
+  for(size_t i = 0; i < queue.size(); ++i) {
+    if(i < budget)
+      relinKeys.insert(queue[i].second);
+    else
+      deferred.insert(queue[i].second);
+  }
+  return deferred;
+}
+
+/* ************************************************************************* */
+void ISAM2::Impl::FindAll(ISAM2Clique::shared_ptr clique, KeySet& keys, const KeyVector& markedMask)
 {
   static const bool debug = false;
   // does the separator contain any of the variables?
   bool found = false;
   BOOST_FOREACH(Key key, clique->conditional()->parents()) {
-    if (markedMask.exists(key)) {
+    if (std::binary_search(markedMask.begin(), markedMask.end(), key)) {
       found = true;
       break;
     }
@@ -226,7 +338,7 @@ void ISAM2::Impl::FindAll(ISAM2Clique::shared_ptr clique, KeySet& keys, const Ke
 
 /* ************************************************************************* */
 void ISAM2::Impl::ExpmapMasked(Values& values, const VectorValues& delta,
-    const KeySet& mask, boost::optional<VectorValues&> invalidateIfDebug, const KeyFormatter& keyFormatter)
+    const KeyVector& mask, boost::optional<VectorValues&> invalidateIfDebug, const KeyFormatter& keyFormatter)
 {
   // If debugging, invalidate if requested, otherwise do not invalidate.
   // Invalidating means setting expmapped entries to Inf, to trigger assertions
@@ -236,27 +348,18 @@ void ISAM2::Impl::ExpmapMasked(Values& values, const VectorValues& delta,
 #endif
 
   assert(values.size() == delta.size());
-  Values::iterator key_value;
-  VectorValues::const_iterator key_delta;
-#ifdef GTSAM_USE_TBB
-  for(key_value = values.begin(); key_value != values.end(); ++key_value)
-  {
-    key_delta = delta.find(key_value->key);
-#else
-  for(key_value = values.begin(), key_delta = delta.begin(); key_value != values.end(); ++key_value, ++key_delta)
-  {
-    assert(key_value->key == key_delta->first);
-#endif
-    Key var = key_value->key;
-    assert(delta[var].size() == (int)key_value->value.dim());
-    assert(delta[var].allFinite());
-    if(mask.exists(var)) {
-      Value* retracted = key_value->value.retract_(delta[var]);
-      key_value->value = *retracted;
-      retracted->deallocate_();
-      if(invalidateIfDebug)
-        (*invalidateIfDebug)[var].operator=(Vector::Constant(delta[var].rows(), numeric_limits<double>::infinity())); // Strange syntax to work with clang++ (bug in clang?)
-    }
+  // Only the masked variables are visited, which are usually few compared to all variables
+  BOOST_FOREACH(Key var, mask) {
+    Values::iterator key_value = values.find(var);
+    assert(key_value != values.end());
+    const Vector& varDelta = delta[var];
+    assert(varDelta.size() == (int)key_value->value.dim());
+    assert(varDelta.allFinite());
+    Value* retracted = key_value->value.retract_(varDelta);
+    key_value->value = *retracted;
+    retracted->deallocate_();
+    if(invalidateIfDebug)
+      (*invalidateIfDebug)[var].operator=(Vector::Constant(varDelta.rows(), numeric_limits<double>::infinity())); // Strange syntax to work with clang++ (bug in clang?)
   }
 }
 
@@ -285,11 +388,9 @@ size_t ISAM2::Impl::UpdateGaussNewtonDelta(const FastVector<ISAM2::sharedClique>
     lastBacksubVariableCount = delta.size();
 
   } else {
-    // Optimize with wildfire
-    lastBacksubVariableCount = 0;
-    BOOST_FOREACH(const ISAM2::sharedClique& root, roots)
-      lastBacksubVariableCount += optimizeWildfireNonRecursive(
-      root, wildfireThreshold, replacedKeys, delta); // modifies delta
+    // Optimize with wildfire, in parallel if TBB is enabled
+    lastBacksubVariableCount = optimizeWildfireParallel(
+      roots, wildfireThreshold, replacedKeys, delta); // modifies delta
 
 #ifdef GTSAM_EXTRA_CONSISTENCY_CHECKS
     for(size_t j=0; j<delta.size(); ++j)
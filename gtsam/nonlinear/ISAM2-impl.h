@@ -50,9 +50,11 @@ struct GTSAM_EXPORT ISAM2::Impl {
 
   /// Perform the first part of the bookkeeping updates for adding new factors.  Adds them to the
   /// complete list of nonlinear factors, and populates the list of new factor indices, both
-  /// optionally finding and reusing empty factor slots.
+  /// optionally finding and reusing empty factor slots.  The slots in \c evictedFactors hold
+  /// factors that were evicted to disk, and are never reused.
   static void AddFactorsStep1(const NonlinearFactorGraph& newFactors, bool useUnusedSlots,
-    NonlinearFactorGraph& nonlinearFactors, FastVector<size_t>& newFactorIndices);
+    NonlinearFactorGraph& nonlinearFactors, FastVector<size_t>& newFactorIndices,
+    const FastMap<size_t, size_t>& evictedFactors = FastMap<size_t, size_t>());
     
   /**
    * Remove variables from the ISAM2 system.
@@ -88,10 +90,30 @@ struct GTSAM_EXPORT ISAM2::Impl {
   static KeySet CheckRelinearizationPartial(const FastVector<ISAM2::sharedClique>& roots,
     const VectorValues& delta, const ISAM2Params::RelinearizationThreshold& relinearizeThreshold);
 
+  /**
+   * How far the delta of a variable is above relinearizeThreshold, as the largest ratio of the
+   * magnitude of a delta component to its threshold.  Variables with a priority of at least 1 are
+   * above the threshold.
+   */
+  static double RelinearizationPriority(Key key, const Vector& delta,
+      const ISAM2Params::RelinearizationThreshold& relinearizeThreshold);
+
+  /**
+   * Limit the variables to relinearize to a budget, keeping those with the highest
+   * RelinearizationPriority.
+   * @param relinKeys The candidate variables, on return the at most \c budget selected ones
+   * @param delta The linear delta, used to prioritize the candidates
+   * @param budget The maximum number of variables to select, 0 for no limit
+   * @return The candidates that were not selected
+   */
+  static KeySet LimitRelinearization(KeySet& relinKeys, const VectorValues& delta,
+      const ISAM2Params::RelinearizationThreshold& relinearizeThreshold, size_t budget);
+
   /**
    * Recursively search this clique and its children for marked keys appearing
    * in the separator, and add the *frontal* keys of any cliques whose
-   * separator contains any marked keys to the set \c keys.  The purpose of
+   * separator contains any marked keys to the set \c keys.  The marked keys
+   * \c markedMask must be sorted, they are looked up by binary search.  The purpose of
    * this is to discover the cliques that need to be redone due to information
    * propagating to them from cliques that directly contain factors being
    * relinearized.
@@ -103,7 +125,7 @@ struct GTSAM_EXPORT ISAM2::Impl {
    *
    * Alternatively could we trace up towards the root for each variable here?
    */
-  static void FindAll(ISAM2Clique::shared_ptr clique, KeySet& keys, const KeySet& markedMask);
+  static void FindAll(ISAM2Clique::shared_ptr clique, KeySet& keys, const KeyVector& markedMask);
 
   /**
    * Apply expmap to the given values, but only for indices appearing in
@@ -111,7 +133,7 @@ struct GTSAM_EXPORT ISAM2::Impl {
    * \param [in, out] values The value to expmap in-place
    * \param delta The linear delta with which to expmap
    * \param ordering The ordering
-   * \param mask Mask on linear indices, only \c true entries are expmapped
+   * \param mask The sorted keys to expmap
    * \param invalidateIfDebug If this is true, *and* NDEBUG is not defined,
    * expmapped deltas will be set to an invalid value (infinity) to catch bugs
    * where we might expmap something twice, or expmap it but then not
@@ -119,7 +141,7 @@ struct GTSAM_EXPORT ISAM2::Impl {
    * @param keyFormatter Formatter for printing nonlinear keys during debugging
    */
   static void ExpmapMasked(Values& values, const VectorValues& delta,
-      const KeySet& mask,
+      const KeyVector& mask,
       boost::optional<VectorValues&> invalidateIfDebug = boost::none,
       const KeyFormatter& keyFormatter = DefaultKeyFormatter);
 
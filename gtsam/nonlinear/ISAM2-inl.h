@@ -22,6 +22,13 @@
 #include <stack>
 #include <gtsam/inference/FactorGraph.h>
 #include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/combinable.h>
+#  include <tbb/concurrent_unordered_set.h>
+#  include <tbb/task_group.h>
+#endif
 
 namespace gtsam {
 
@@ -111,9 +118,9 @@ void optimizeWildfire(const boost::shared_ptr<CLIQUE>& clique, double threshold,
   }
 }
 
-template<class CLIQUE>
+template<class CLIQUE, class KEYSET>
 bool optimizeWildfireNode(const boost::shared_ptr<CLIQUE>& clique, double threshold,
-    KeySet& changed, const KeySet& replaced, VectorValues& delta, size_t& count)
+    KEYSET& changed, const KeySet& replaced, VectorValues& delta, size_t& count)
 {
   // if none of the variables in this clique (frontal and separator!) changed
   // significantly, then by the running intersection property, none of the
@@ -131,7 +138,7 @@ bool optimizeWildfireNode(const boost::shared_ptr<CLIQUE>& clique, double thresh
   bool recalculate = cliqueReplaced;
   if(!recalculate) {
     BOOST_FOREACH(Key parent, clique->conditional()->parents()) {
-      if(changed.exists(parent)) {
+      if(changed.count(parent) > 0) {
         recalculate = true;
         break;
       }
@@ -241,6 +248,50 @@ bool optimizeWildfireNode(const boost::shared_ptr<CLIQUE>& clique, double thresh
   return recalculate;
 }
 
+#ifdef GTSAM_USE_TBB
+/* ************************************************************************* */
+// Initial value of the per-thread counts of solved variables
+inline size_t zeroCount() { return 0; }
+
+/* ************************************************************************* */
+// Wildfire back-substitution of a subtree as a TBB task.  After solving a clique, its children
+// that need to be recalculated are spawned as new tasks, except for one that this task continues
+// with, so that deep trees are traversed without recursion.
+template<class CLIQUE>
+class OptimizeWildfireTask {
+  boost::shared_ptr<CLIQUE> clique_;
+  double threshold_;
+  tbb::concurrent_unordered_set<Key>& changed_;
+  const KeySet& replaced_;
+  VectorValues& delta_;
+  tbb::combinable<size_t>& count_;
+  tbb::task_group& tasks_;
+public:
+  OptimizeWildfireTask(const boost::shared_ptr<CLIQUE>& clique, double threshold,
+      tbb::concurrent_unordered_set<Key>& changed, const KeySet& replaced, VectorValues& delta,
+      tbb::combinable<size_t>& count, tbb::task_group& tasks) :
+      clique_(clique), threshold_(threshold), changed_(changed), replaced_(replaced),
+      delta_(delta), count_(count), tasks_(tasks) {}
+
+  void operator()() const {
+    size_t& count = count_.local();
+    boost::shared_ptr<CLIQUE> clique = clique_;
+    while(clique) {
+      boost::shared_ptr<CLIQUE> next;
+      if(optimizeWildfireNode(clique, threshold_, changed_, replaced_, delta_, count)) {
+        BOOST_FOREACH(const typename CLIQUE::shared_ptr& child, clique->children) {
+          if(next)
+            tasks_.run(OptimizeWildfireTask(next, threshold_, changed_, replaced_, delta_,
+                count_, tasks_));
+          next = child;
+        }
+      }
+      clique = next;
+    }
+  }
+};
+#endif
+
 } // namespace internal
 
 /* ************************************************************************* */
@@ -280,6 +331,29 @@ size_t optimizeWildfireNonRecursive(const boost::shared_ptr<CLIQUE>& root, doubl
   return count;
 }
 
+/* ************************************************************************* */
+template<class CLIQUE>
+size_t optimizeWildfireParallel(const FastVector<boost::shared_ptr<CLIQUE> >& roots,
+    double threshold, const KeySet& keys, VectorValues& delta)
+{
+#ifdef GTSAM_USE_TBB
+  tbb::concurrent_unordered_set<Key> changed;
+  tbb::combinable<size_t> count(internal::zeroCount);
+  tbb::task_group tasks;
+  BOOST_FOREACH(const boost::shared_ptr<CLIQUE>& root, roots)
+    if(root)
+      tasks.run(internal::OptimizeWildfireTask<CLIQUE>(root, threshold, changed, keys, delta,
+          count, tasks));
+  tasks.wait();
+  return count.combine(std::plus<size_t>());
+#else
+  size_t count = 0;
+  BOOST_FOREACH(const boost::shared_ptr<CLIQUE>& root, roots)
+    count += optimizeWildfireNonRecursive(root, threshold, keys, delta);
+  return count;
+#endif
+}
+
 /* ************************************************************************* */
 template<class CLIQUE>
 void nnz_internal(const boost::shared_ptr<CLIQUE>& clique, int& result) {
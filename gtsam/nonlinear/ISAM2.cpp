@@ -16,20 +16,34 @@
  */
 
 #include <boost/foreach.hpp>
+#include <boost/bind.hpp>
 #include <boost/assign/std/list.hpp> // for operator +=
 using namespace boost::assign;
 #include <boost/range/adaptors.hpp>
 #include <boost/range/algorithm/copy.hpp>
 #include <boost/algorithm/string.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <typeinfo>
+
 namespace br { using namespace boost::range; using namespace boost::adaptors; }
 
 #include <gtsam/base/timing.h>
 #include <gtsam/base/debug.h>
+#include <gtsam/base/DSFVector.h>
+#include <gtsam/base/serialization.h>
 #include <gtsam/inference/BayesTree-inst.h>
 #include <gtsam/inference/BayesTreeCliqueBase-inst.h>
 #include <gtsam/inference/JunctionTree-inst.h> // We need the inst file because we'll make a special JT templated on ISAM2
 #include <gtsam/linear/linearAlgorithms-inst.h>
 #include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/GaussianEliminationTree.h>
 
@@ -37,6 +51,12 @@ namespace br { using namespace boost::range; using namespace boost::adaptors; }
 #include <gtsam/nonlinear/DoglegOptimizerImpl.h>
 #include <gtsam/nonlinear/nonlinearExceptions.h>
 #include <gtsam/nonlinear/LinearContainerFactor.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
 
 using namespace std;
 
@@ -76,6 +96,164 @@ public:
     Base(eliminationTree) {}
 };
 
+/* ************************************************************************* */
+namespace {
+// Wall time in seconds since start, for ISAM2Result::Metrics
+double secondsSince(const boost::posix_time::ptime& start) {
+  return 1e-6 * (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds();
+}
+
+// Bytes of the matrix storage of a linear factor, for ISAM2Result::Metrics
+size_t matrixBytes(const GaussianFactor::shared_ptr& factor) {
+  if(const JacobianFactor* jacobian = dynamic_cast<const JacobianFactor*>(factor.get()))
+    return sizeof(double) * jacobian->matrixObject().matrix().size();
+  if(const HessianFactor* hessian = dynamic_cast<const HessianFactor*>(factor.get()))
+    return sizeof(double) * hessian->info().size();
+  return 0;
+}
+
+// Add the storage and dimensions of newly eliminated cliques to the metrics
+void addCliqueMetrics(const ISAM2::Nodes& nodes, ISAM2Result::Metrics& metrics) {
+  BOOST_FOREACH(const ISAM2::Nodes::value_type& key_clique, nodes) {
+    const ISAM2::sharedClique& clique = key_clique.second;
+    if(clique->conditional()->front() != key_clique.first)
+      continue; // Count each clique once, at its first frontal variable
+    ++ metrics.newCliques;
+    metrics.bytesAllocated += matrixBytes(clique->conditional()) + matrixBytes(clique->cachedFactor_);
+    metrics.maxCliqueDimension = std::max(metrics.maxCliqueDimension,
+        size_t(clique->conditional()->cols() - 1));
+  }
+}
+
+// Whether a variable is constrained to be eliminated after group 0, see Ordering::ColamdConstrained
+bool isConstrained(const FastMap<Key,int>& constraintGroups, Key key) {
+  FastMap<Key,int>::const_iterator group = constraintGroups.find(key);
+  return group != constraintGroups.end() && group->second != 0;
+}
+
+// One independent sub-problem of the re-eliminated top of the tree: the factors on a connected
+// set of variables that are not constrained to be eliminated last.  It is partially eliminated
+// on its own, and leaves a factor on the constrained variables it involves.
+struct AffectedComponent {
+  GaussianFactorGraph factors;
+  ISAM2BayesTree::shared_ptr bayesTree;
+  GaussianFactorGraph::shared_ptr remaining;
+
+  void eliminate(const FastMap<Key,int>& constraintGroups,
+      const GaussianFactorGraph::Eliminate& function) {
+    // Eliminate the unconstrained variables only, ordered as if the constrained were last
+    const VariableIndex index(factors);
+    vector<Key> constrained;
+    BOOST_FOREACH(const VariableIndex::value_type& key_factors, index)
+      if(isConstrained(constraintGroups, key_factors.first))
+        constrained.push_back(key_factors.first);
+    Ordering ordering = Ordering::ColamdConstrainedLast(index, constrained);
+    ordering.resize(ordering.size() - constrained.size());
+    boost::tie(bayesTree, remaining) = ISAM2JunctionTree(GaussianEliminationTree(
+        factors, index, ordering)).eliminate(function);
+  }
+};
+
+#ifdef GTSAM_USE_TBB
+// Eliminate a range of components, the body of tbb::parallel_for
+class EliminateComponents {
+  vector<AffectedComponent>& components_;
+  const FastMap<Key,int>& constraintGroups_;
+  const GaussianFactorGraph::Eliminate& function_;
+public:
+  EliminateComponents(vector<AffectedComponent>& components,
+      const FastMap<Key,int>& constraintGroups, const GaussianFactorGraph::Eliminate& function) :
+      components_(components), constraintGroups_(constraintGroups), function_(function) {}
+  void operator()(const tbb::blocked_range<size_t>& r) const {
+    for(size_t i = r.begin(); i != r.end(); ++i)
+      components_[i].eliminate(constraintGroups_, function_);
+  }
+};
+#endif
+
+// Eliminate the affected factors as independent sub-problems, one per connected component of the
+// variables that are not constrained in constraintGroups (the constrained ones are eliminated
+// last anyway, so they separate the components), in parallel when TBB is enabled.  The constrained variables
+// are then eliminated with the factors the components leave on them, and the component subtrees
+// are attached below them like orphans.  The components are found from the variable index of
+// the factors, which is also used to order them when there is a single component.  Returns
+// false, without eliminating, when there are fewer than two components.
+bool eliminateComponents(const GaussianFactorGraph& factors, const VariableIndex& index,
+    const FastMap<Key,int>& constraintGroups, const GaussianFactorGraph::Eliminate& function,
+    FastVector<ISAM2::sharedClique>& roots, ISAM2::Nodes& nodes) {
+  gttic(eliminateComponents);
+
+  // Find the connected components of the unconstrained variables, joining each one with the
+  // first unconstrained variable of every factor it appears in
+  static const size_t none = std::numeric_limits<size_t>::max();
+  FastVector<size_t> firstOf(factors.size(), none);
+  DSFBase dsf(index.size());
+  size_t nrUnconstrained = 0;
+  BOOST_FOREACH(const VariableIndex::value_type& key_factors, index) {
+    if(isConstrained(constraintGroups, key_factors.first))
+      continue;
+    const size_t j = nrUnconstrained++;
+    BOOST_FOREACH(size_t i, key_factors.second) {
+      if(firstOf[i] == none)
+        firstOf[i] = j;
+      else
+        dsf.merge(firstOf[i], j);
+    }
+  }
+  FastMap<size_t, size_t> componentOf;
+  for(size_t j = 0; j < nrUnconstrained; ++j)
+    componentOf.insert(make_pair(dsf.find(j), componentOf.size()));
+  if(componentOf.size() < 2)
+    return false;
+
+  // Distribute the factors, those only on constrained variables are eliminated at the end
+  vector<AffectedComponent> components(componentOf.size());
+  GaussianFactorGraph constrainedFactors;
+  for(size_t i = 0; i < factors.size(); ++i) {
+    if(!factors[i])
+      continue;
+    if(firstOf[i] == none)
+      constrainedFactors.push_back(factors[i]);
+    else
+      components[componentOf.at(dsf.find(firstOf[i]))].factors.push_back(factors[i]);
+  }
+
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, components.size(), 1),
+      EliminateComponents(components, constraintGroups, function));
+#else
+  BOOST_FOREACH(AffectedComponent& component, components)
+    component.eliminate(constraintGroups, function);
+#endif
+
+  // Attach the component subtrees below the constrained variables, or as roots when they do
+  // not involve any
+  BOOST_FOREACH(const AffectedComponent& component, components) {
+    nodes.insert(component.bayesTree->nodes().begin(), component.bayesTree->nodes().end());
+    constrainedFactors.push_back(*component.remaining);
+    BOOST_FOREACH(const ISAM2::sharedClique& root, component.bayesTree->roots()) {
+      if(root->conditional()->nrParents() == 0)
+        roots.push_back(root);
+      else
+        constrainedFactors += boost::make_shared<BayesTreeOrphanWrapper<ISAM2Clique> >(root);
+    }
+  }
+
+  if(!constrainedFactors.empty()) {
+    const VariableIndex index(constrainedFactors);
+    FastMap<Key,int> groups;
+    BOOST_FOREACH(const VariableIndex::value_type& key_factors, index)
+      groups.insert(make_pair(key_factors.first, constraintGroups.at(key_factors.first)));
+    const Ordering ordering = Ordering::ColamdConstrained(index, groups);
+    const ISAM2BayesTree::shared_ptr bayesTree = ISAM2JunctionTree(GaussianEliminationTree(
+        constrainedFactors, index, ordering)).eliminate(function).first;
+    roots.insert(roots.end(), bayesTree->roots().begin(), bayesTree->roots().end());
+    nodes.insert(bayesTree->nodes().begin(), bayesTree->nodes().end());
+  }
+  return true;
+}
+}
+
 /* ************************************************************************* */
 std::string ISAM2DoglegParams::adaptationModeTranslator(const DoglegOptimizerImpl::TrustRegionAdaptationMode& adaptationMode) const {
   std::string s;
@@ -151,13 +329,14 @@ void ISAM2Clique::print(const std::string& s, const KeyFormatter& formatter) con
 }
 
 /* ************************************************************************* */
-ISAM2::ISAM2(const ISAM2Params& params): params_(params), update_count_(0) {
+ISAM2::ISAM2(const ISAM2Params& params): params_(params), update_count_(0), evictionCount_(0),
+    arena_(params.maxThreads, params.threadEntry) {
   if(params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ = boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
 }
 
 /* ************************************************************************* */
-ISAM2::ISAM2() : update_count_(0) {
+ISAM2::ISAM2() : update_count_(0), evictionCount_(0) {
   if(params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ = boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
 }
@@ -171,18 +350,26 @@ bool ISAM2::equals(const ISAM2& other, double tol) const {
 }
 
 /* ************************************************************************* */
-FastSet<size_t> ISAM2::getAffectedFactors(const FastList<Key>& keys) const {
+// Sort and remove duplicates, for lookups with std::binary_search
+template<class VECTOR>
+static void sortUnique(VECTOR& values) {
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+/* ************************************************************************* */
+FastVector<size_t> ISAM2::getAffectedFactors(const KeyVector& keys) const {
   static const bool debug = false;
   if(debug) cout << "Getting affected factors for ";
   if(debug) { BOOST_FOREACH(const Key key, keys) { cout << key << " "; } }
   if(debug) cout << endl;
 
-  NonlinearFactorGraph allAffected;
-  FastSet<size_t> indices;
+  FastVector<size_t> indices;
   BOOST_FOREACH(const Key key, keys) {
     const VariableIndex::Factors& factors(variableIndex_[key]);
-    indices.insert(factors.begin(), factors.end());
+    indices.insert(indices.end(), factors.begin(), factors.end());
   }
+  sortUnique(indices);
   if(debug) cout << "Affected factors are: ";
   if(debug) { BOOST_FOREACH(const size_t index, indices) { cout << index << " "; } }
   if(debug) cout << endl;
@@ -194,31 +381,24 @@ FastSet<size_t> ISAM2::getAffectedFactors(const FastList<Key>& keys) const {
 // (note that the remaining stuff is summarized in the cached factors)
 
 GaussianFactorGraph::shared_ptr
-ISAM2::relinearizeAffectedFactors(const FastList<Key>& affectedKeys, const KeySet& relinKeys) const
+ISAM2::relinearizeAffectedFactors(const KeyVector& affectedKeys, const KeyVector& relinKeys,
+    boost::optional<size_t&> linearizedBytes) const
 {
   gttic(getAffectedFactors);
-  FastSet<size_t> candidates = getAffectedFactors(affectedKeys);
+  const FastVector<size_t> candidates = getAffectedFactors(affectedKeys);
   gttoc(getAffectedFactors);
 
-  NonlinearFactorGraph nonlinearAffectedFactors;
-
-  gttic(affectedKeysSet);
-  // for fast lookup below
-  KeySet affectedKeysSet;
-  affectedKeysSet.insert(affectedKeys.begin(), affectedKeys.end());
-  gttoc(affectedKeysSet);
-
   gttic(check_candidates_and_linearize);
   GaussianFactorGraph::shared_ptr linearized = boost::make_shared<GaussianFactorGraph>();
   BOOST_FOREACH(size_t idx, candidates) {
     bool inside = true;
     bool useCachedLinear = params_.cacheLinearizedFactors;
     BOOST_FOREACH(Key key, nonlinearFactors_[idx]->keys()) {
-      if(affectedKeysSet.find(key) == affectedKeysSet.end()) {
+      if(!std::binary_search(affectedKeys.begin(), affectedKeys.end(), key)) {
         inside = false;
         break;
       }
-      if(useCachedLinear && relinKeys.find(key) != relinKeys.end())
+      if(useCachedLinear && std::binary_search(relinKeys.begin(), relinKeys.end(), key))
         useCachedLinear = false;
     }
     if(inside) {
@@ -231,6 +411,8 @@ ISAM2::relinearizeAffectedFactors(const FastList<Key>& affectedKeys, const KeySe
       } else {
         GaussianFactor::shared_ptr linearFactor = nonlinearFactors_[idx]->linearize(theta_);
         linearized->push_back(linearFactor);
+        if(linearizedBytes)
+          *linearizedBytes += matrixBytes(linearFactor);
         if(params_.cacheLinearizedFactors) {
 #ifdef GTSAM_EXTRA_CONSISTENCY_CHECKS
           assert(linearFactors_[idx]->keys() == linearFactor->keys());
@@ -303,9 +485,13 @@ boost::shared_ptr<KeySet > ISAM2::recalculate(const KeySet& markedKeys, const Ke
   // (a) For each affected variable, remove the corresponding clique and all parents up to the root.
   // (b) Store orphaned sub-trees \BayesTree_{O} of removed cliques.
   gttic(removetop);
+  boost::posix_time::ptime phaseStart = boost::posix_time::microsec_clock::universal_time();
   Cliques orphans;
   GaussianBayesNet affectedBayesNet;
   this->removeTop(FastVector<Key>(markedKeys.begin(), markedKeys.end()), affectedBayesNet, orphans);
+  result.metrics.affectedCliques = affectedBayesNet.size();
+  result.metrics.orphans = orphans.size();
+  result.metrics.symbolicTime += secondsSince(phaseStart);
   gttoc(removetop);
 
   //    FactorGraph<GaussianFactor> factors(affectedBayesNet);
@@ -321,14 +507,15 @@ boost::shared_ptr<KeySet > ISAM2::recalculate(const KeySet& markedKeys, const Ke
 
   // ordering provides all keys in conditionals, there cannot be others because path to root included
   gttic(affectedKeys);
-  FastList<Key> affectedKeys;
+  KeyVector affectedKeys;
   BOOST_FOREACH(const ConditionalType::shared_ptr& conditional, affectedBayesNet)
     affectedKeys.insert(affectedKeys.end(), conditional->beginFrontals(), conditional->endFrontals());
   gttoc(affectedKeys);
 
   boost::shared_ptr<KeySet > affectedKeysSet(new KeySet()); // Will return this result
 
-  if(affectedKeys.size() >= theta_.size() * batchThreshold)
+  // A batch step would lose the evicted subtrees, which are only summarized in their parents
+  if(affectedKeys.size() >= theta_.size() * batchThreshold && evictedSubtrees_.empty())
   {
     // Do a batch step - reorder and relinearize all variables
     gttic(batch);
@@ -338,6 +525,7 @@ boost::shared_ptr<KeySet > ISAM2::recalculate(const KeySet& markedKeys, const Ke
     gttoc(add_keys);
 
     gttic(ordering);
+    phaseStart = boost::posix_time::microsec_clock::universal_time();
     Ordering order;
     if(constrainKeys)
     {
@@ -358,17 +546,27 @@ boost::shared_ptr<KeySet > ISAM2::recalculate(const KeySet& markedKeys, const Ke
         order = Ordering::Colamd(variableIndex_);
       }
     }
+    result.metrics.symbolicTime += secondsSince(phaseStart);
     gttoc(ordering);
 
     gttic(linearize);
+    phaseStart = boost::posix_time::microsec_clock::universal_time();
     GaussianFactorGraph linearized = *nonlinearFactors_.linearize(theta_);
     if(params_.cacheLinearizedFactors)
       linearFactors_ = linearized;
+    BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, linearized)
+      result.metrics.bytesAllocated += matrixBytes(factor);
+    result.metrics.linearizeTime += secondsSince(phaseStart);
     gttoc(linearize);
 
     gttic(eliminate);
-    ISAM2BayesTree::shared_ptr bayesTree = ISAM2JunctionTree(GaussianEliminationTree(linearized, variableIndex_, order))
-      .eliminate(params_.getEliminationFunction()).first;
+    phaseStart = boost::posix_time::microsec_clock::universal_time();
+    const ISAM2JunctionTree junctionTree(GaussianEliminationTree(linearized, variableIndex_, order));
+    result.metrics.symbolicTime += secondsSince(phaseStart);
+    phaseStart = boost::posix_time::microsec_clock::universal_time();
+    ISAM2BayesTree::shared_ptr bayesTree = junctionTree.eliminate(params_.getEliminationFunction()).first;
+    result.metrics.eliminationTime += secondsSince(phaseStart);
+    addCliqueMetrics(bayesTree->nodes(), result.metrics);
     gttoc(eliminate);
 
     gttic(insert);
@@ -398,11 +596,19 @@ boost::shared_ptr<KeySet > ISAM2::recalculate(const KeySet& markedKeys, const Ke
     gttic(incremental);
 
     // 2. Add the new factors \Factors' into the resulting factor graph
-    FastList<Key> affectedAndNewKeys;
+    KeyVector affectedAndNewKeys;
+    affectedAndNewKeys.reserve(affectedKeys.size() + observedKeys.size());
     affectedAndNewKeys.insert(affectedAndNewKeys.end(), affectedKeys.begin(), affectedKeys.end());
     affectedAndNewKeys.insert(affectedAndNewKeys.end(), observedKeys.begin(), observedKeys.end());
     gttic(relinearizeAffected);
-    GaussianFactorGraph factors(*relinearizeAffectedFactors(affectedAndNewKeys, relinKeys));
+    phaseStart = boost::posix_time::microsec_clock::universal_time();
+    // Sorted vectors for the lookups of the keys of each affected factor
+    KeyVector sortedAffectedAndNewKeys(affectedAndNewKeys);
+    sortUnique(sortedAffectedAndNewKeys);
+    const KeyVector sortedRelinKeys(relinKeys.begin(), relinKeys.end());
+    GaussianFactorGraph factors(*relinearizeAffectedFactors(sortedAffectedAndNewKeys, sortedRelinKeys,
+        result.metrics.bytesAllocated));
+    result.metrics.linearizeTime += secondsSince(phaseStart);
     if(debug) factors.print("Relinearized factors: ");
     gttoc(relinearizeAffected);
 
@@ -451,11 +657,19 @@ boost::shared_ptr<KeySet > ISAM2::recalculate(const KeySet& markedKeys, const Ke
     gttic(list_to_set);
     // create a partial reordering for the new and contaminated factors
     // markedKeys are passed in: those variables will be forced to the end in the ordering
-    affectedKeysSet->insert(markedKeys.begin(), markedKeys.end());
-    affectedKeysSet->insert(affectedKeys.begin(), affectedKeys.end());
+    KeyVector reeliminatedKeys;
+    reeliminatedKeys.reserve(markedKeys.size() + affectedKeys.size());
+    std::sort(affectedKeys.begin(), affectedKeys.end());
+    std::set_union(markedKeys.begin(), markedKeys.end(), affectedKeys.begin(), affectedKeys.end(),
+        std::back_inserter(reeliminatedKeys));
+    affectedKeysSet->insert(reeliminatedKeys.begin(), reeliminatedKeys.end());
     gttoc(list_to_set);
 
-    VariableIndex affectedFactorsVarIndex(factors);
+    // The variable index of the affected factors is the only symbolic structure built for them,
+    // it is used to find the independent components and to order the elimination
+    gttic(variable_index);
+    const VariableIndex affectedFactorsVarIndex(factors);
+    gttoc(variable_index);
 
     gttic(ordering_constraints);
     // Create ordering constraints
@@ -472,26 +686,44 @@ boost::shared_ptr<KeySet > ISAM2::recalculate(const KeySet& markedKeys, const Ke
 
     // Remove unaffected keys from the constraints
     for(FastMap<Key,int>::iterator iter = constraintGroups.begin(); iter != constraintGroups.end(); /*Incremented in loop ++iter*/) {
-      if(unusedIndices.exists(iter->first) || !affectedKeysSet->exists(iter->first))
+      if(unusedIndices.exists(iter->first)
+          || !std::binary_search(reeliminatedKeys.begin(), reeliminatedKeys.end(), iter->first))
         constraintGroups.erase(iter ++);
       else
         ++ iter;
     }
     gttoc(ordering_constraints);
 
-    // Generate ordering
-    gttic(Ordering);
-    Ordering ordering = Ordering::ColamdConstrained(affectedFactorsVarIndex, constraintGroups);
-    gttoc(Ordering);
-
-    ISAM2BayesTree::shared_ptr bayesTree = ISAM2JunctionTree(GaussianEliminationTree(
-      factors, affectedFactorsVarIndex, ordering)).eliminate(params_.getEliminationFunction()).first;
+    // Eliminate independent sub-problems separately, or else all factors at once
+    FastVector<sharedClique> newRoots;
+    Nodes newNodes;
+    phaseStart = boost::posix_time::microsec_clock::universal_time();
+    if(eliminateComponents(factors, affectedFactorsVarIndex, constraintGroups,
+        params_.getEliminationFunction(), newRoots, newNodes)) {
+      result.metrics.eliminationTime += secondsSince(phaseStart);
+    } else {
+      // Generate ordering
+      gttic(Ordering);
+      phaseStart = boost::posix_time::microsec_clock::universal_time();
+      Ordering ordering = Ordering::ColamdConstrained(affectedFactorsVarIndex, constraintGroups);
+      gttoc(Ordering);
+
+      const ISAM2JunctionTree junctionTree(GaussianEliminationTree(
+        factors, affectedFactorsVarIndex, ordering));
+      result.metrics.symbolicTime += secondsSince(phaseStart);
+      phaseStart = boost::posix_time::microsec_clock::universal_time();
+      ISAM2BayesTree::shared_ptr bayesTree = junctionTree.eliminate(params_.getEliminationFunction()).first;
+      result.metrics.eliminationTime += secondsSince(phaseStart);
+      newRoots.assign(bayesTree->roots().begin(), bayesTree->roots().end());
+      newNodes = bayesTree->nodes();
+    }
+    addCliqueMetrics(newNodes, result.metrics);
 
     gttoc(reorder_and_eliminate);
 
     gttic(reassemble);
-    this->roots_.insert(this->roots_.end(), bayesTree->roots().begin(), bayesTree->roots().end());
-    this->nodes_.insert(bayesTree->nodes().begin(), bayesTree->nodes().end());
+    this->roots_.insert(this->roots_.end(), newRoots.begin(), newRoots.end());
+    this->nodes_.insert(newNodes.begin(), newNodes.end());
     gttoc(reassemble);
 
     // 4. The orphans have already been inserted during elimination
@@ -509,17 +741,104 @@ boost::shared_ptr<KeySet > ISAM2::recalculate(const KeySet& markedKeys, const Ke
   return affectedKeysSet;
 }
 
+/* ************************************************************************* */
+struct ISAM2::UpdateTask {
+  ISAM2& isam;
+  const NonlinearFactorGraph& newFactors;
+  const Values& newTheta;
+  const vector<size_t>& removeFactorIndices;
+  // Copied, as updateLinearized() passes temporaries
+  const boost::optional<FastMap<Key,int> > constrainedKeys;
+  const boost::optional<FastList<Key> > noRelinKeys;
+  const boost::optional<FastList<Key> > extraReelimKeys;
+  bool force_relinearize;
+  const GaussianFactorGraph* linearizedNewFactors;
+  const Values* linearizationPoint;
+  ISAM2Result result;
+
+  UpdateTask(ISAM2& isam, const NonlinearFactorGraph& newFactors, const Values& newTheta,
+      const vector<size_t>& removeFactorIndices,
+      const boost::optional<FastMap<Key,int> >& constrainedKeys,
+      const boost::optional<FastList<Key> >& noRelinKeys,
+      const boost::optional<FastList<Key> >& extraReelimKeys, bool force_relinearize,
+      const GaussianFactorGraph* linearizedNewFactors, const Values* linearizationPoint) :
+    isam(isam), newFactors(newFactors), newTheta(newTheta),
+    removeFactorIndices(removeFactorIndices), constrainedKeys(constrainedKeys),
+    noRelinKeys(noRelinKeys), extraReelimKeys(extraReelimKeys),
+    force_relinearize(force_relinearize), linearizedNewFactors(linearizedNewFactors),
+    linearizationPoint(linearizationPoint) {}
+
+  void operator()() {
+    result = isam.updateImpl(newFactors, newTheta, removeFactorIndices, constrainedKeys,
+        noRelinKeys, extraReelimKeys, force_relinearize, linearizedNewFactors, linearizationPoint);
+  }
+};
+
 /* ************************************************************************* */
 ISAM2Result ISAM2::update(
     const NonlinearFactorGraph& newFactors, const Values& newTheta, const vector<size_t>& removeFactorIndices,
     const boost::optional<FastMap<Key,int> >& constrainedKeys, const boost::optional<FastList<Key> >& noRelinKeys,
     const boost::optional<FastList<Key> >& extraReelimKeys, bool force_relinearize)
 {
+  UpdateTask task(*this, newFactors, newTheta, removeFactorIndices, constrainedKeys, noRelinKeys,
+      extraReelimKeys, force_relinearize, 0, 0);
+  arena_.execute(boost::ref(task));
+  return task.result;
+}
+
+/* ************************************************************************* */
+ISAM2Result ISAM2::updateLinearized(const NonlinearFactorGraph& newFactors,
+    const Values& newTheta, const vector<size_t>& removeFactorIndices,
+    const GaussianFactorGraph& linearizedNewFactors, const Values& linearizationPoint)
+{
+  if(linearizedNewFactors.size() != newFactors.size())
+    throw invalid_argument(
+        "ISAM2::updateLinearized: linearizedNewFactors must have one entry per new factor");
+  UpdateTask task(*this, newFactors, newTheta, removeFactorIndices, boost::none, boost::none,
+      boost::none, false, &linearizedNewFactors, &linearizationPoint);
+  arena_.execute(boost::ref(task));
+  return task.result;
+}
+
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr ISAM2::linearizeNewFactors(
+    const NonlinearFactorGraph& newFactors, const GaussianFactorGraph& linearized,
+    const Values& linearizationPoint) const
+{
+  GaussianFactorGraph::shared_ptr result = boost::make_shared<GaussianFactorGraph>();
+  result->reserve(newFactors.size());
+  for(size_t i = 0; i < newFactors.size(); ++i) {
+    const NonlinearFactor::shared_ptr& factor = newFactors[i];
+    if(!factor) {
+      result->push_back(GaussianFactor::shared_ptr());
+      continue;
+    }
+    // Reuse the linearized factor only if all its variables are still at the same point.  Some
+    // values compare with a strict inequality, so the smallest positive tolerance is used.
+    bool current = linearized[i].get() != 0;
+    BOOST_FOREACH(Key key, factor->keys()) {
+      if(!current) break;
+      current = linearizationPoint.exists(key) && theta_.at(key).equals_(
+          linearizationPoint.at(key), std::numeric_limits<double>::denorm_min());
+    }
+    result->push_back(current ? linearized[i] : factor->linearize(theta_));
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+ISAM2Result ISAM2::updateImpl(
+    const NonlinearFactorGraph& newFactors, const Values& newTheta, const vector<size_t>& removeFactorIndices,
+    const boost::optional<FastMap<Key,int> >& constrainedKeys, const boost::optional<FastList<Key> >& noRelinKeys,
+    const boost::optional<FastList<Key> >& extraReelimKeys, bool force_relinearize,
+    const GaussianFactorGraph* linearizedNewFactors, const Values* linearizationPoint)
+{
 
   const bool debug = ISDEBUG("ISAM2 update");
   const bool verbose = ISDEBUG("ISAM2 update verbose");
 
   gttic(ISAM2_update);
+  const boost::posix_time::ptime updateStart = boost::posix_time::microsec_clock::universal_time();
 
   this->update_count_++;
 
@@ -534,6 +853,9 @@ ISAM2Result ISAM2::update(
     result.detail = ISAM2Result::DetailedResults();
   const bool relinearizeThisStep = force_relinearize
       || (params_.enableRelinearization && update_count_ % params_.relinearizeSkip == 0);
+  // Variables deferred by the relinearization budget are relinearized in the next updates
+  const bool relinearizeDeferred = !relinearizeThisStep && params_.enableRelinearization
+      && !deferredRelinKeys_.empty();
 
   if(verbose) {
     cout << "ISAM2::update\n";
@@ -541,17 +863,35 @@ ISAM2Result ISAM2::update(
   }
 
   // Update delta if we need it to check relinearization later
-  if(relinearizeThisStep) {
+  if(relinearizeThisStep || relinearizeDeferred) {
     gttic(updateDelta);
+    const boost::posix_time::ptime wildfireStart = boost::posix_time::microsec_clock::universal_time();
     updateDelta(disableReordering);
+    result.metrics.wildfireTime = secondsSince(wildfireStart);
     gttoc(updateDelta);
   }
 
+  // Load the evicted factors to remove, and the subtrees whose factors involve their variables
+  if(!evictedSubtrees_.empty()) {
+    gttic(page_in_removed);
+    KeySet removedKeys;
+    BOOST_FOREACH(size_t index, removeFactorIndices) {
+      FastMap<size_t, size_t>::const_iterator evicted = evictedFactors_.find(index);
+      if(evicted != evictedFactors_.end())
+        loadEvictedSubtree(evicted->second);
+      if(nonlinearFactors_[index])
+        removedKeys.insert(nonlinearFactors_[index]->begin(), nonlinearFactors_[index]->end());
+    }
+    pageInTouched(KeySet(), removedKeys);
+    gttoc(page_in_removed);
+  }
+
   gttic(push_back_factors);
   // 1. Add any new factors \Factors:=\Factors\cup\Factors'.
   // Add the new factor indices to the result struct
   if(debug || verbose) newFactors.print("The new factors are: ");
-  Impl::AddFactorsStep1(newFactors, params_.findUnusedFactorSlots, nonlinearFactors_, result.newFactorsIndices);
+  Impl::AddFactorsStep1(newFactors, params_.findUnusedFactorSlots, nonlinearFactors_,
+      result.newFactorsIndices, evictedFactors_);
 
   // Remove the removed factors
   NonlinearFactorGraph removeFactors; removeFactors.reserve(removeFactorIndices.size());
@@ -633,14 +973,22 @@ ISAM2Result ISAM2::update(
 
   // Check relinearization if we're at the nth step, or we are using a looser loop relin threshold
   KeySet relinKeys;
-  if (relinearizeThisStep) {
+  if (relinearizeThisStep || relinearizeDeferred) {
     gttic(gather_relinearize_keys);
     // 4. Mark keys in \Delta above threshold \beta: J=\{\Delta_{j}\in\Delta|\Delta_{j}\geq\beta\}.
-    if(params_.enablePartialRelinearizationCheck)
-      relinKeys = Impl::CheckRelinearizationPartial(roots_, delta_, params_.relinearizeThreshold);
-    else
-      relinKeys = Impl::CheckRelinearizationFull(delta_, params_.relinearizeThreshold);
-    if(disableReordering) relinKeys = Impl::CheckRelinearizationFull(delta_, 0.0); // This is used for debugging
+    if(relinearizeThisStep) {
+      if(params_.enablePartialRelinearizationCheck)
+        relinKeys = Impl::CheckRelinearizationPartial(roots_, delta_, params_.relinearizeThreshold);
+      else
+        relinKeys = Impl::CheckRelinearizationFull(delta_, params_.relinearizeThreshold);
+      if(disableReordering) relinKeys = Impl::CheckRelinearizationFull(delta_, 0.0); // This is used for debugging
+    }
+
+    // Add the deferred keys that are still above the threshold
+    BOOST_FOREACH(Key key, deferredRelinKeys_) {
+      if(Impl::RelinearizationPriority(key, delta_[key], params_.relinearizeThreshold) >= 1.0)
+        relinKeys.insert(key);
+    }
 
     // Remove from relinKeys any keys whose linearization points are fixed
     BOOST_FOREACH(Key key, fixedVariables_) {
@@ -652,22 +1000,28 @@ ISAM2Result ISAM2::update(
       }
     }
 
+    // Relinearize at most relinearizeBudget keys, deferring those closest to the threshold
+    deferredRelinKeys_ = Impl::LimitRelinearization(relinKeys, delta_,
+        params_.relinearizeThreshold, params_.relinearizeBudget);
+
     // Above relin threshold keys for detailed results
     if(params_.enableDetailedResults) {
       BOOST_FOREACH(Key key, relinKeys) {
         result.detail->variableStatus[key].isAboveRelinThreshold = true;
         result.detail->variableStatus[key].isRelinearized = true; } }
 
-    // Add the variables being relinearized to the marked keys
-    KeySet markedRelinMask;
-    BOOST_FOREACH(const Key key, relinKeys)
-      markedRelinMask.insert(key);
+    // Add the variables being relinearized to the marked keys, and keep them in a sorted vector
+    // for the lookups in the cliques below
+    const KeyVector markedRelinMask(relinKeys.begin(), relinKeys.end());
     markedKeys.insert(relinKeys.begin(), relinKeys.end());
     gttoc(gather_relinearize_keys);
 
     gttic(fluid_find_all);
     // 5. Mark all cliques that involve marked variables \Theta_{J} and all their ancestors.
     if (!relinKeys.empty()) {
+      // Load the evicted subtrees with relinearized variables in their separator
+      pageInTouched(KeySet(), relinKeys);
+
       BOOST_FOREACH(const sharedClique& root, roots_)
         // add other cliques that have the marked ones in the separator
         Impl::FindAll(root, markedKeys, markedRelinMask);
@@ -696,11 +1050,21 @@ ISAM2Result ISAM2::update(
     result.variablesRelinearized = 0;
   }
 
+  // Load the evicted subtrees with marked variables, or that hang below the top of the tree that
+  // will be re-eliminated
+  pageInTouched(markedKeys, KeySet());
+
   gttic(linearize_new);
   // 7. Linearize new factors
   if(params_.cacheLinearizedFactors) {
     gttic(linearize);
-    GaussianFactorGraph::shared_ptr linearFactors = newFactors.linearize(theta_);
+    const boost::posix_time::ptime linearizeStart = boost::posix_time::microsec_clock::universal_time();
+    GaussianFactorGraph::shared_ptr linearFactors = linearizedNewFactors ?
+        linearizeNewFactors(newFactors, *linearizedNewFactors, *linearizationPoint) :
+        newFactors.linearize(theta_);
+    BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, *linearFactors)
+      result.metrics.bytesAllocated += matrixBytes(factor);
+    result.metrics.linearizeTime += secondsSince(linearizeStart);
     if(params_.findUnusedFactorSlots)
     {
       linearFactors_.resize(nonlinearFactors_.size());
@@ -735,20 +1099,36 @@ ISAM2Result ISAM2::update(
     deltaReplacedMask_.insert(replacedKeys->begin(), replacedKeys->end());
   gttoc(recalculate);
 
+  // Discard the cached marginal covariances of the trees whose top was re-eliminated
+  if(replacedKeys)
+    removeStaleMarginalCovariances();
+
   // Update data structures to remove unused keys
   if(!unusedKeys.empty()) {
     gttic(remove_variables);
     Impl::RemoveVariables(unusedKeys, roots_, theta_, variableIndex_, delta_, deltaNewton_, RgProd_,
         deltaReplacedMask_, Base::nodes_, fixedVariables_);
+    BOOST_FOREACH(Key key, unusedKeys) {
+      deferredRelinKeys_.erase(key);
+      marginalCovariances_.erase(key);
+    }
     gttoc(remove_variables);
   }
-  result.cliques = this->nodes().size();
-
   gttic(evaluate_error_after);
   if(params_.evaluateNonlinearError)
     result.errorAfter.reset(nonlinearFactors_.error(calculateEstimate()));
   gttoc(evaluate_error_after);
 
+  // Bound the memory by moving cold subtrees to disk
+  if(params_.maxResidentVariables > 0 && theta_.size() > params_.maxResidentVariables)
+    evictColdSubtrees();
+
+  publishSnapshot();
+
+  result.cliques = this->nodes().size();
+  result.relinearizeQueueDepth = deferredRelinKeys_.size();
+  result.metrics.totalTime = secondsSince(updateStart);
+
   return result;
 }
 
@@ -757,9 +1137,22 @@ void ISAM2::marginalizeLeaves(const FastList<Key>& leafKeysList,
                               boost::optional<std::vector<size_t>&> marginalFactorsIndices,
                               boost::optional<std::vector<size_t>&> deletedFactorsIndices)
 {
+  arena_.execute(boost::bind(&ISAM2::marginalizeLeavesImpl, this, boost::cref(leafKeysList),
+      marginalFactorsIndices, deletedFactorsIndices));
+}
+
+/* ************************************************************************* */
+void ISAM2::marginalizeLeavesImpl(const FastList<Key>& leafKeysList,
+                              boost::optional<std::vector<size_t>&> marginalFactorsIndices,
+                              boost::optional<std::vector<size_t>&> deletedFactorsIndices)
+{
+  gttic(marginalizeLeaves);
   // Convert to ordered set
   KeySet leafKeys(leafKeysList.begin(), leafKeysList.end());
 
+  // Load the evicted subtrees below or involving the leaves
+  pageInTouched(leafKeys, leafKeys);
+
   // Keep track of marginal factors - map from clique to the marginal factors
   // that should be incorporated into it, passed up from it's children.
 //  multimap<sharedClique, GaussianFactor::shared_ptr> marginalFactors;
@@ -866,7 +1259,6 @@ void ISAM2::marginalizeLeaves(const FastList<Key>& leafKeysList,
         // Add the factors that are pulled into the current clique by the marginalized variables.
         // These are the factors that involve *marginalized* frontal variables in this clique
         // but do not involve frontal variables of any of its children.
-        // TODO: reuse cached linear factors
         FastSet<size_t> factorsFromMarginalizedInClique_step1;
         BOOST_FOREACH(Key frontal, clique->conditional()->frontals()) {
           if(leafKeys.exists(frontal))
@@ -876,9 +1268,14 @@ void ISAM2::marginalizeLeaves(const FastList<Key>& leafKeysList,
           BOOST_FOREACH(Key indexInClique, removedChild->conditional()->frontals()) {
             BOOST_FOREACH(size_t factorInvolving, variableIndex_[indexInClique]) {
               factorsFromMarginalizedInClique_step1.erase(factorInvolving); } } }
-        // Create factor graph from factor indices
+        // Create factor graph from factor indices, reusing the cached linear factors, which are
+        // linearized at theta_
         BOOST_FOREACH(size_t i, factorsFromMarginalizedInClique_step1) {
-          graph.push_back(nonlinearFactors_[i]->linearize(theta_)); }
+          if(params_.cacheLinearizedFactors && linearFactors_[i])
+            graph.push_back(linearFactors_[i]);
+          else
+            graph.push_back(nonlinearFactors_[i]->linearize(theta_));
+        }
 
         // Reeliminate the linear graph to get the marginal and discard the conditional
         const KeySet cliqueFrontals(clique->conditional()->beginFrontals(), clique->conditional()->endFrontals());
@@ -898,6 +1295,9 @@ void ISAM2::marginalizeLeaves(const FastList<Key>& leafKeysList,
         while(leafKeys.exists(clique->conditional()->keys()[nToRemove]))
           ++ nToRemove;
 
+        // Copies of this ISAM2 share the conditional, so split a private copy of it
+        clique->conditional_ = boost::make_shared<GaussianConditional>(*clique->conditional());
+
         // Make the clique's matrix appear as a subset
         const DenseIndex dimToRemove = clique->conditional()->matrixObject().offset(nToRemove);
         clique->conditional()->matrixObject().firstBlock() = nToRemove;
@@ -959,10 +1359,618 @@ void ISAM2::marginalizeLeaves(const FastList<Key>& leafKeysList,
   // Remove the marginalized variables
   Impl::RemoveVariables(KeySet(leafKeys.begin(), leafKeys.end()), roots_, theta_, variableIndex_, delta_, deltaNewton_, RgProd_,
     deltaReplacedMask_, nodes_, fixedVariables_);
+  BOOST_FOREACH(Key key, leafKeys) {
+    deferredRelinKeys_.erase(key);
+    marginalCovariances_.erase(key);
+  }
+  removeStaleMarginalCovariances();
+  publishSnapshot();
+}
+
+/* ************************************************************************* */
+void ISAM2::publishSnapshot() {
+  if(!params_.publishSnapshots)
+    return;
+  gttic(publishSnapshot);
+  const ISAM2Snapshot::shared_ptr previous = boost::atomic_load(&snapshot_);
+  const ISAM2Snapshot::shared_ptr snapshot = boost::make_shared<const ISAM2Snapshot>(
+      previous ? previous->epoch() + 1 : 0, theta_, getDelta(), *this,
+      params_.getEliminationFunction());
+  boost::atomic_store(&snapshot_, snapshot);
+}
+
+/* ************************************************************************* */
+void ISAM2::removeStaleMarginalCovariances() const {
+  FastVector<Key> stale;
+  typedef FastMap<Key, std::pair<Matrix, sharedClique> >::value_type CachedCovariance;
+  BOOST_FOREACH(const CachedCovariance& cached, marginalCovariances_) {
+    if(std::find(roots_.begin(), roots_.end(), cached.second.second) == roots_.end())
+      stale.push_back(cached.first);
+  }
+  BOOST_FOREACH(Key key, stale)
+    marginalCovariances_.erase(key);
+}
+
+/* ************************************************************************* */
+namespace {
+// Deleter of the shared file name of an evicted subtree, which removes the file
+struct RemoveEvictedFile {
+  void operator()(const std::string* file) const {
+    std::remove(file->c_str());
+    delete file;
+  }
+};
+
+// A clique of the tree with its parent, depth and number of variables in its subtree, used to
+// choose the subtrees to evict
+struct CliqueExtent {
+  ISAM2::sharedClique clique;
+  size_t parent;
+  size_t depth;
+  size_t variables;
+  CliqueExtent(const ISAM2::sharedClique& _clique, size_t _parent, size_t _depth) :
+      clique(_clique), parent(_parent), depth(_depth), variables(_clique->conditional()->nrFrontals()) {}
+};
+
+bool isDeeper(const CliqueExtent& first, const CliqueExtent& second) {
+  return first.depth > second.depth;
+}
+}
+
+/* ************************************************************************* */
+FastVector<size_t> ISAM2::compactFactors() {
+  gttic(compactFactors);
+  assert(!params_.cacheLinearizedFactors || linearFactors_.size() == nonlinearFactors_.size());
+
+  // Number the factors that are kept, including the evicted ones
+  const size_t n = nonlinearFactors_.size();
+  FastVector<size_t> newIndices(n, n);
+  size_t nrKept = 0;
+  for(size_t i = 0; i < n; ++i)
+    if(nonlinearFactors_[i] || evictedFactors_.exists(i))
+      newIndices[i] = nrKept++;
+
+  // Move them down in place, the new index of a factor is never larger than its old one
+  for(size_t i = 0; i < n; ++i) {
+    if(newIndices[i] == n) {
+      newIndices[i] = nrKept;
+    } else if(newIndices[i] != i) {
+      nonlinearFactors_[newIndices[i]] = nonlinearFactors_[i];
+      if(params_.cacheLinearizedFactors)
+        linearFactors_[newIndices[i]] = linearFactors_[i];
+    }
+  }
+  nonlinearFactors_.resize(nrKept);
+  nonlinearFactors_.shrink_to_fit();
+  if(params_.cacheLinearizedFactors) {
+    linearFactors_.resize(nrKept);
+    linearFactors_.shrink_to_fit();
+  }
+  variableIndex_.renumberFactors(newIndices, nrKept);
+
+  // Renumber the evicted factors
+  FastMap<size_t, size_t> evictedFactors;
+  typedef FastMap<size_t, size_t>::value_type IndexEviction;
+  BOOST_FOREACH(const IndexEviction& index_eviction, evictedFactors_)
+    evictedFactors.insert(make_pair(newIndices[index_eviction.first], index_eviction.second));
+  evictedFactors_.swap(evictedFactors);
+  typedef FastMap<size_t, EvictedSubtree>::value_type Evicted;
+  BOOST_FOREACH(Evicted& evicted, evictedSubtrees_)
+    BOOST_FOREACH(size_t& index, evicted.second.factors)
+      index = newIndices[index];
+
+  return newIndices;
+}
+
+/* ************************************************************************* */
+void ISAM2::pageIn(const KeySet& keys) {
+  pageInTouched(keys, KeySet());
+}
+
+/* ************************************************************************* */
+KeySet ISAM2::getEvictedKeys() const {
+  KeySet keys;
+  br::copy(evictedKeys_ | br::map_keys, std::inserter(keys, keys.end()));
+  return keys;
+}
+
+/* ************************************************************************* */
+void ISAM2::pageInTouched(const KeySet& keys, const KeySet& separatorKeys) {
+  if(evictedSubtrees_.empty())
+    return;
+  gttic(pageIn);
+
+  // Loading a subtree may put more cliques on the paths from the keys to the roots
+  bool loaded = true;
+  while(loaded) {
+    loaded = false;
+    FastSet<size_t> toLoad;
+
+    // The cliques of the resident keys and their ancestors, whose children become orphans
+    KeySet onPath;
+    BOOST_FOREACH(Key key, keys) {
+      FastMap<Key, size_t>::const_iterator evicted = evictedKeys_.find(key);
+      if(evicted != evictedKeys_.end())
+        toLoad.insert(evicted->second);
+      else if(nodes_.exists(key))
+        for(sharedClique clique = nodes_.at(key); clique; clique = clique->parent())
+          if(!onPath.insert(clique->conditional()->front()).second)
+            break; // The ancestors are already on the path
+    }
+
+    typedef FastMap<size_t, EvictedSubtree>::value_type Evicted;
+    BOOST_FOREACH(const Evicted& evicted, evictedSubtrees_) {
+      if(onPath.exists(evicted.second.parent)) {
+        toLoad.insert(evicted.first);
+      } else {
+        BOOST_FOREACH(Key key, evicted.second.separator) {
+          if(separatorKeys.exists(key)) {
+            toLoad.insert(evicted.first);
+            break;
+          }
+        }
+      }
+    }
+
+    BOOST_FOREACH(size_t eviction, toLoad) {
+      if(evictedSubtrees_.exists(eviction)) { // Not loaded already as the parent of another
+        loadEvictedSubtree(eviction);
+        loaded = true;
+      }
+    }
+  }
+}
+
+/* ************************************************************************* */
+void ISAM2::evictColdSubtrees() {
+  if(params_.optimizationParams.type() != typeid(ISAM2GaussNewtonParams))
+    return;
+  gttic(evictColdSubtrees);
+
+  // The evicted deltas are kept as they are until the subtrees are loaded again
+  getDelta();
+
+  // Find the number of variables in each subtree, from the leaves up
+  FastVector<CliqueExtent> cliques;
+  BOOST_FOREACH(const sharedClique& root, roots_)
+    cliques.push_back(CliqueExtent(root, cliques.size(), 0));
+  for(size_t i = 0; i < cliques.size(); ++i) {
+    const size_t depth = cliques[i].depth + 1;
+    BOOST_FOREACH(const sharedClique& child, cliques[i].clique->children)
+      cliques.push_back(CliqueExtent(child, i, depth));
+  }
+  for(size_t i = cliques.size(); i-- > roots_.size(); )
+    cliques[cliques[i].parent].variables += cliques[i].variables;
+
+  // Evict the largest subtrees that fit in the excess, which are disjoint, furthest from the
+  // roots first.  Keeping only half of the maximum makes the evictions rare and large.
+  size_t excess = theta_.size() - params_.maxResidentVariables / 2;
+  FastVector<CliqueExtent> candidates;
+  for(size_t i = roots_.size(); i < cliques.size(); ++i)
+    if(cliques[i].variables <= excess && cliques[cliques[i].parent].variables > excess)
+      candidates.push_back(cliques[i]);
+  std::stable_sort(candidates.begin(), candidates.end(), isDeeper);
+  BOOST_FOREACH(const CliqueExtent& candidate, candidates) {
+    if(candidate.variables > excess)
+      continue;
+    evictSubtree(candidate.clique);
+    excess -= candidate.variables;
+    if(excess == 0)
+      break;
+  }
+}
+
+/* ************************************************************************* */
+void ISAM2::evictSubtree(const sharedClique& subtree) {
+  const sharedClique parent = subtree->parent();
+  EvictedSubtree evicted;
+  evicted.parent = parent->conditional()->front();
+  evicted.separator.insert(subtree->conditional()->beginParents(), subtree->conditional()->endParents());
+
+  // Gather the variables of the subtree and the factors involving any of them
+  FastVector<sharedClique> stack(1, subtree);
+  while(!stack.empty()) {
+    const sharedClique clique = stack.back();
+    stack.pop_back();
+    evicted.keys.insert(clique->conditional()->beginFrontals(), clique->conditional()->endFrontals());
+    stack.insert(stack.end(), clique->children.begin(), clique->children.end());
+  }
+  FastSet<size_t> factorIndices;
+  Values values;
+  VectorValues delta;
+  BOOST_FOREACH(Key key, evicted.keys) {
+    factorIndices.insert(variableIndex_[key].begin(), variableIndex_[key].end());
+    values.insert(key, theta_.at(key));
+    delta.insert(key, delta_.at(key));
+  }
+  NonlinearFactorGraph factors;
+  GaussianFactorGraph linearFactors;
+  BOOST_FOREACH(size_t index, factorIndices) {
+    evicted.factors.push_back(index);
+    factors.push_back(nonlinearFactors_[index]);
+    if(params_.cacheLinearizedFactors) {
+      // Fixed-size Jacobian factors, e.g. from NoiseModelFactor1, are not serializable, so they
+      // are saved as plain JacobianFactors
+      const GaussianFactor::shared_ptr& linearFactor = linearFactors_[index];
+      const JacobianFactor* jacobian = dynamic_cast<const JacobianFactor*>(linearFactor.get());
+      if(jacobian && typeid(*jacobian) != typeid(JacobianFactor))
+        linearFactors.push_back(boost::make_shared<JacobianFactor>(*jacobian));
+      else
+        linearFactors.push_back(linearFactor);
+    }
+  }
+
+  // Detach the subtree and write it to disk
+  const boost::filesystem::path directory = params_.evictionDirectory.empty() ?
+      boost::filesystem::temp_directory_path() : boost::filesystem::path(params_.evictionDirectory);
+  const std::string file = (directory /
+      boost::filesystem::unique_path("isam2-subtree-%%%%-%%%%-%%%%-%%%%.bin")).string();
+  {
+    std::ofstream stream(file.c_str(), std::ios::binary);
+    if(!stream)
+      throw runtime_error("ISAM2: could not write an evicted subtree to " + file);
+    parent->children.erase(std::find(parent->children.begin(), parent->children.end(), subtree));
+    subtree->parent_.reset();
+    boost::archive::binary_oarchive archive(stream);
+    archive << subtree << values << delta << factors << linearFactors;
+  }
+  evicted.file.reset(new std::string(file), RemoveEvictedFile());
+
+  // Remove the subtree, variables and factors from memory
+  variableIndex_.remove(evicted.factors.begin(), evicted.factors.end(), factors);
+  variableIndex_.removeUnusedVariables(evicted.keys.begin(), evicted.keys.end());
+  BOOST_FOREACH(size_t index, evicted.factors) {
+    nonlinearFactors_.remove(index);
+    if(params_.cacheLinearizedFactors)
+      linearFactors_.remove(index);
+    evictedFactors_[index] = evictionCount_;
+  }
+  BOOST_FOREACH(Key key, evicted.keys) {
+    theta_.erase(key);
+    delta_.erase(key);
+    deltaNewton_.erase(key);
+    RgProd_.erase(key);
+    nodes_.unsafe_erase(key);
+    deferredRelinKeys_.erase(key);
+    marginalCovariances_.erase(key);
+    evictedKeys_[key] = evictionCount_;
+  }
+  evictedSubtrees_.insert(make_pair(evictionCount_, evicted));
+  ++ evictionCount_;
+}
+
+/* ************************************************************************* */
+void ISAM2::loadEvictedSubtree(size_t eviction) {
+  const EvictedSubtree evicted = evictedSubtrees_.at(eviction);
+
+  // The parent may have been evicted with a larger subtree later
+  if(!nodes_.exists(evicted.parent))
+    loadEvictedSubtree(evictedKeys_.at(evicted.parent));
+  gttic(loadEvictedSubtree);
+
+  sharedClique subtree;
+  Values values;
+  VectorValues delta;
+  NonlinearFactorGraph factors;
+  GaussianFactorGraph linearFactors;
+  {
+    std::ifstream stream(evicted.file->c_str(), std::ios::binary);
+    if(!stream)
+      throw runtime_error("ISAM2: could not read the evicted subtree in " + *evicted.file);
+    boost::archive::binary_iarchive archive(stream);
+    archive >> subtree >> values >> delta >> factors >> linearFactors;
+  }
+
+  // Reattach the subtree
+  const sharedClique parent = nodes_.at(evicted.parent);
+  subtree->parent_ = parent;
+  parent->children.push_back(subtree);
+  FastVector<sharedClique> stack(1, subtree);
+  while(!stack.empty()) {
+    const sharedClique clique = stack.back();
+    stack.pop_back();
+    BOOST_FOREACH(Key key, clique->conditional()->frontals())
+      nodes_.insert(make_pair(key, clique));
+    stack.insert(stack.end(), clique->children.begin(), clique->children.end());
+  }
+
+  // Restore the variables and factors.  The deltas are solved again by the next back-substitution.
+  theta_.insert(values);
+  delta_.insert(delta);
+  deltaNewton_.insert(values.zeroVectors());
+  RgProd_.insert(values.zeroVectors());
+  deltaReplacedMask_.insert(evicted.keys.begin(), evicted.keys.end());
+  for(size_t i = 0; i < evicted.factors.size(); ++i) {
+    nonlinearFactors_[evicted.factors[i]] = factors[i];
+    if(params_.cacheLinearizedFactors)
+      linearFactors_[evicted.factors[i]] = linearFactors[i];
+    evictedFactors_.erase(evicted.factors[i]);
+  }
+  variableIndex_.augment(factors, evicted.factors);
+  BOOST_FOREACH(Key key, evicted.keys)
+    evictedKeys_.erase(key);
+  evictedSubtrees_.erase(eviction);
+}
+
+/* ************************************************************************* */
+// The checkpoint format: a header, the factors and linearization point in a boost binary archive,
+// then the raw buffers of the remaining state and of the cliques, in the native byte order
+static const char checkpointMagic[8] = { 'I', 'S', 'A', 'M', '2', 'C', 'K', 'P' };
+static const boost::uint32_t checkpointVersion = 1;
+
+template<typename T>
+static void writeRaw(std::ostream& stream, const T& value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static T readRaw(std::istream& stream) {
+  T value;
+  if(!stream.read(reinterpret_cast<char*>(&value), sizeof(T)))
+    throw runtime_error("ISAM2: the checkpoint is truncated");
+  return value;
+}
+
+template<class MATRIX>
+static void writeMatrix(std::ostream& stream, const MATRIX& matrix) {
+  writeRaw(stream, boost::uint64_t(matrix.rows()));
+  writeRaw(stream, boost::uint64_t(matrix.cols()));
+  stream.write(reinterpret_cast<const char*>(matrix.data()), matrix.size() * sizeof(double));
+}
+
+template<class MATRIX>
+static MATRIX readMatrix(std::istream& stream) {
+  const DenseIndex rows = DenseIndex(readRaw<boost::uint64_t>(stream));
+  const DenseIndex cols = DenseIndex(readRaw<boost::uint64_t>(stream));
+  MATRIX matrix(rows, cols);
+  if(!stream.read(reinterpret_cast<char*>(matrix.data()), matrix.size() * sizeof(double)))
+    throw runtime_error("ISAM2: the checkpoint is truncated");
+  return matrix;
+}
+
+template<class KEYS>
+static void writeKeys(std::ostream& stream, const KEYS& keys) {
+  writeRaw(stream, boost::uint64_t(keys.size()));
+  BOOST_FOREACH(Key key, keys)
+    writeRaw(stream, key);
+}
+
+static KeyVector readKeys(std::istream& stream) {
+  KeyVector keys(readRaw<boost::uint64_t>(stream));
+  BOOST_FOREACH(Key& key, keys)
+    key = readRaw<Key>(stream);
+  return keys;
+}
+
+// The keys and block dimensions of a factor
+template<class FACTOR>
+static void writeBlockStructure(std::ostream& stream, const FACTOR& factor) {
+  writeKeys(stream, factor.keys());
+  for(typename FACTOR::const_iterator key = factor.begin(); key != factor.end(); ++key)
+    writeRaw(stream, boost::uint64_t(factor.getDim(key)));
+}
+
+static FastVector<DenseIndex> readDims(std::istream& stream, size_t nrKeys) {
+  FastVector<DenseIndex> dims(nrKeys);
+  BOOST_FOREACH(DenseIndex& dim, dims)
+    dim = DenseIndex(readRaw<boost::uint64_t>(stream));
+  return dims;
+}
+
+// A diagonal noise model, tagged 0 if there is none, 1 if Diagonal and 2 if Constrained
+static void writeModel(std::ostream& stream, const SharedDiagonal& model) {
+  const noiseModel::Constrained* constrained = dynamic_cast<const noiseModel::Constrained*>(model.get());
+  writeRaw(stream, boost::uint8_t(!model ? 0 : constrained ? 2 : 1));
+  if(constrained)
+    writeMatrix(stream, constrained->mu());
+  if(model)
+    writeMatrix(stream, model->sigmas());
+}
+
+static SharedDiagonal readModel(std::istream& stream) {
+  switch(readRaw<boost::uint8_t>(stream)) {
+  case 0:
+    return SharedDiagonal();
+  case 1:
+    return noiseModel::Diagonal::Sigmas(readMatrix<Vector>(stream));
+  case 2: {
+    const Vector mu = readMatrix<Vector>(stream);
+    return noiseModel::Constrained::MixedSigmas(mu, readMatrix<Vector>(stream)); }
+  default:
+    throw runtime_error("ISAM2: unknown noise model in the checkpoint");
+  }
+}
+
+static void writeConditional(std::ostream& stream, const GaussianConditional& conditional) {
+  writeRaw(stream, boost::uint64_t(conditional.nrFrontals()));
+  writeBlockStructure(stream, conditional);
+  writeMatrix(stream, Matrix(conditional.matrixObject().full()));
+  writeModel(stream, conditional.get_model());
+}
+
+static GaussianConditional::shared_ptr readConditional(std::istream& stream) {
+  const size_t nrFrontals = size_t(readRaw<boost::uint64_t>(stream));
+  const KeyVector keys = readKeys(stream);
+  const FastVector<DenseIndex> dims = readDims(stream, keys.size());
+  const VerticalBlockMatrix Ab(dims, readMatrix<Matrix>(stream), true);
+  return boost::make_shared<GaussianConditional>(keys, nrFrontals, Ab, readModel(stream));
+}
+
+// The cached factor of a clique, tagged 0 if there is none, 1 if Jacobian and 2 if Hessian
+static void writeCachedFactor(std::ostream& stream, const GaussianFactor::shared_ptr& factor) {
+  if(!factor) {
+    writeRaw(stream, boost::uint8_t(0));
+  } else if(const HessianFactor* hessian = dynamic_cast<const HessianFactor*>(factor.get())) {
+    writeRaw(stream, boost::uint8_t(2));
+    writeBlockStructure(stream, *hessian);
+    writeMatrix(stream, Matrix(hessian->info().selfadjointView()));
+  } else if(const JacobianFactor* jacobian = dynamic_cast<const JacobianFactor*>(factor.get())) {
+    writeRaw(stream, boost::uint8_t(1));
+    writeBlockStructure(stream, *jacobian);
+    writeMatrix(stream, Matrix(jacobian->matrixObject().full()));
+    writeModel(stream, jacobian->get_model());
+  } else {
+    throw runtime_error("ISAM2: cannot checkpoint a cached factor of type "
+        + string(typeid(*factor).name()));
+  }
+}
+
+static GaussianFactor::shared_ptr readCachedFactor(std::istream& stream) {
+  const boost::uint8_t type = readRaw<boost::uint8_t>(stream);
+  if(type == 0)
+    return GaussianFactor::shared_ptr();
+  const KeyVector keys = readKeys(stream);
+  const FastVector<DenseIndex> dims = readDims(stream, keys.size());
+  if(type == 2)
+    return boost::make_shared<HessianFactor>(keys,
+        SymmetricBlockMatrix(dims, readMatrix<Matrix>(stream), true));
+  const VerticalBlockMatrix Ab(dims, readMatrix<Matrix>(stream), true);
+  return boost::make_shared<JacobianFactor>(keys, Ab, readModel(stream));
+}
+
+/* ************************************************************************* */
+void ISAM2::saveCheckpoint(std::ostream& stream) const {
+  gttic(saveCheckpoint);
+  if(!evictedSubtrees_.empty())
+    throw runtime_error("ISAM2: page in the evicted subtrees before saving a checkpoint");
+  updateDelta();
+
+  stream.write(checkpointMagic, sizeof(checkpointMagic));
+  writeRaw(stream, checkpointVersion);
+  {
+    boost::archive::binary_oarchive archive(stream, boost::archive::no_header);
+    archive << nonlinearFactors_ << theta_;
+  }
+  writeRaw(stream, boost::int64_t(update_count_));
+  writeKeys(stream, fixedVariables_);
+  writeKeys(stream, deferredRelinKeys_);
+  writeRaw(stream, boost::uint8_t(doglegDelta_ ? 1 : 0));
+  writeRaw(stream, doglegDelta_ ? *doglegDelta_ : 0.0);
+  writeRaw(stream, boost::uint64_t(delta_.size()));
+  BOOST_FOREACH(const VectorValues::KeyValuePair& value, delta_) {
+    writeRaw(stream, value.first);
+    writeMatrix(stream, value.second);
+  }
+
+  // The cliques in breadth-first order, each with the index of its parent, which comes first
+  FastVector<std::pair<sharedClique, boost::int64_t> > cliques;
+  BOOST_FOREACH(const sharedClique& root, roots_)
+    cliques.push_back(make_pair(root, boost::int64_t(-1)));
+  for(size_t i = 0; i < cliques.size(); ++i) {
+    const sharedClique clique = cliques[i].first;
+    BOOST_FOREACH(const sharedClique& child, clique->children)
+      cliques.push_back(make_pair(child, boost::int64_t(i)));
+  }
+  writeRaw(stream, boost::uint64_t(cliques.size()));
+  typedef std::pair<sharedClique, boost::int64_t> CliqueParent;
+  BOOST_FOREACH(const CliqueParent& clique, cliques) {
+    writeRaw(stream, clique.second);
+    writeRaw(stream, boost::int32_t(clique.first->problemSize_));
+    writeConditional(stream, *clique.first->conditional());
+    writeCachedFactor(stream, clique.first->cachedFactor_);
+  }
+  if(!stream)
+    throw runtime_error("ISAM2: could not write the checkpoint");
+}
+
+/* ************************************************************************* */
+void ISAM2::loadCheckpoint(std::istream& stream) {
+  gttic(loadCheckpoint);
+  char magic[sizeof(checkpointMagic)];
+  if(!stream.read(magic, sizeof(magic))
+      || !std::equal(magic, magic + sizeof(magic), checkpointMagic)
+      || readRaw<boost::uint32_t>(stream) != checkpointVersion)
+    throw runtime_error("ISAM2: the stream does not hold a checkpoint of this version");
+  const ISAM2Params params = params_;
+  *this = ISAM2(params);
+
+  {
+    boost::archive::binary_iarchive archive(stream, boost::archive::no_header);
+    archive >> nonlinearFactors_ >> theta_;
+  }
+  update_count_ = int(readRaw<boost::int64_t>(stream));
+  const KeyVector fixedVariables = readKeys(stream);
+  fixedVariables_.insert(fixedVariables.begin(), fixedVariables.end());
+  const KeyVector deferredRelinKeys = readKeys(stream);
+  deferredRelinKeys_.insert(deferredRelinKeys.begin(), deferredRelinKeys.end());
+  const bool hasDoglegDelta = readRaw<boost::uint8_t>(stream) != 0;
+  const double doglegDelta = readRaw<double>(stream);
+  if(hasDoglegDelta)
+    doglegDelta_ = doglegDelta;
+  const size_t nrValues = size_t(readRaw<boost::uint64_t>(stream));
+  for(size_t i = 0; i < nrValues; ++i) {
+    const Key key = readRaw<Key>(stream);
+    delta_.insert(key, readMatrix<Vector>(stream));
+  }
+
+  // Rebuild the tree from the stored conditionals and cached factors, without eliminating
+  const size_t nrCliques = size_t(readRaw<boost::uint64_t>(stream));
+  FastVector<sharedClique> cliques;
+  cliques.reserve(nrCliques);
+  FastVector<sharedClique> roots;
+  for(size_t i = 0; i < nrCliques; ++i) {
+    const boost::int64_t parent = readRaw<boost::int64_t>(stream);
+    const sharedClique clique = boost::make_shared<Clique>();
+    clique->problemSize_ = int(readRaw<boost::int32_t>(stream));
+    const GaussianConditional::shared_ptr conditional = readConditional(stream);
+    clique->setEliminationResult(make_pair(conditional, readCachedFactor(stream)));
+    if(parent < 0) {
+      roots.push_back(clique);
+    } else if(parent < boost::int64_t(i)) {
+      clique->parent_ = cliques[parent];
+      cliques[parent]->children.push_back(clique);
+    } else {
+      throw runtime_error("ISAM2: a clique of the checkpoint comes before its parent");
+    }
+    cliques.push_back(clique);
+  }
+  BOOST_FOREACH(const sharedClique& root, roots)
+    insertRoot(root);
+
+  // The remaining state is derived from the factors and delta
+  variableIndex_ = VariableIndex(nonlinearFactors_);
+  if(params_.cacheLinearizedFactors)
+    linearFactors_ = *nonlinearFactors_.linearize(theta_);
+  deltaNewton_ = delta_;
+  RgProd_ = VectorValues::Zero(delta_);
+  if(params_.optimizationParams.type() == typeid(ISAM2DoglegParams)) {
+    // Dogleg solves deltaNewton_ and RgProd_ again
+    BOOST_FOREACH(const VectorValues::KeyValuePair& value, delta_)
+      deltaReplacedMask_.insert(value.first);
+  }
+  publishSnapshot();
+}
+
+/* ************************************************************************* */
+void ISAM2::saveUpdate(std::ostream& stream, const NonlinearFactorGraph& newFactors,
+    const Values& newTheta, const std::vector<size_t>& removeFactorIndices) {
+  boost::archive::binary_oarchive archive(stream, boost::archive::no_header);
+  archive << newFactors << newTheta << removeFactorIndices;
+}
+
+/* ************************************************************************* */
+bool ISAM2::replayUpdate(std::istream& stream) {
+  if(stream.peek() == std::istream::traits_type::eof())
+    return false;
+  NonlinearFactorGraph newFactors;
+  Values newTheta;
+  std::vector<size_t> removeFactorIndices;
+  {
+    boost::archive::binary_iarchive archive(stream, boost::archive::no_header);
+    archive >> newFactors >> newTheta >> removeFactorIndices;
+  }
+  update(newFactors, newTheta, removeFactorIndices);
+  return true;
 }
 
 /* ************************************************************************* */
 void ISAM2::updateDelta(bool forceFullSolve) const
+{
+  arena_.execute(boost::bind(&ISAM2::updateDeltaImpl, this, forceFullSolve));
+}
+
+/* ************************************************************************* */
+void ISAM2::updateDeltaImpl(bool forceFullSolve) const
 {
   gttic(updateDelta);
   if(params_.optimizationParams.type() == typeid(ISAM2GaussNewtonParams)) {
@@ -1035,7 +2043,82 @@ Values ISAM2::calculateBestEstimate() const {
 
 /* ************************************************************************* */
 Matrix ISAM2::marginalCovariance(Key key) const {
-  return marginalFactor(key, params_.getEliminationFunction())->information().inverse();
+  return marginalCovariances(FastVector<Key>(1, key)).front();
+}
+
+/* ************************************************************************* */
+namespace {
+// Joint covariance of variables of the same clique, in the order of ordering, from the clique
+// marginal
+Matrix cliqueCovariance(const ISAM2Clique& clique, const Ordering& ordering,
+    const GaussianFactorGraph::Eliminate& function) {
+  const GaussianFactorGraph cliqueMarginal = clique.marginal2(function);
+  const GaussianFactorGraph joint(
+      *cliqueMarginal.marginalMultifrontalBayesNet(ordering, boost::none, function));
+  const Matrix augmentedInfo = joint.augmentedHessian(ordering);
+  return augmentedInfo.topLeftCorner(augmentedInfo.rows() - 1, augmentedInfo.cols() - 1).inverse();
+}
+}
+
+/* ************************************************************************* */
+FastVector<Matrix> ISAM2::marginalCovariances(const FastVector<Key>& keys) const {
+  gttic(marginalCovariances);
+
+  // Group the keys that are not cached by clique
+  typedef FastMap<sharedClique, FastVector<Key> > CliqueKeys;
+  CliqueKeys cliqueKeys;
+  BOOST_FOREACH(Key key, keys) {
+    if(!marginalCovariances_.exists(key))
+      cliqueKeys[clique(key)].push_back(key);
+  }
+
+  // Compute the joint marginal of the requested keys of each clique, from the clique marginal
+  const GaussianFactorGraph::Eliminate function = params_.getEliminationFunction();
+  BOOST_FOREACH(const CliqueKeys::value_type& clique_keys, cliqueKeys) {
+    sharedClique root = clique_keys.first;
+    while(!root->isRoot())
+      root = root->parent();
+
+    KeySet unique(clique_keys.second.begin(), clique_keys.second.end());
+    const Ordering ordering(unique.begin(), unique.end());
+    const Matrix covariance = cliqueCovariance(*clique_keys.first, ordering, function);
+
+    DenseIndex position = 0;
+    BOOST_FOREACH(Key key, ordering) {
+      const DenseIndex dim = delta_.at(key).size();
+      marginalCovariances_.insert(make_pair(key,
+          make_pair(Matrix(covariance.block(position, position, dim, dim)), root)));
+      position += dim;
+    }
+  }
+
+  FastVector<Matrix> covariances;
+  covariances.reserve(keys.size());
+  BOOST_FOREACH(Key key, keys)
+    covariances.push_back(marginalCovariances_.at(key).first);
+  return covariances;
+}
+
+/* ************************************************************************* */
+ISAM2Snapshot::ISAM2Snapshot(size_t epoch, const Values& theta, const VectorValues& delta,
+    const BayesTree<ISAM2Clique>& bayesTree, const GaussianFactorGraph::Eliminate& function) :
+    epoch_(epoch), theta_(theta), delta_(delta), bayesTree_(bayesTree), function_(function) {
+}
+
+/* ************************************************************************* */
+Values ISAM2Snapshot::calculateEstimate() const {
+  gttic(ISAM2Snapshot_calculateEstimate);
+  return theta_.retract(delta_);
+}
+
+/* ************************************************************************* */
+Values ISAM2Snapshot::calculateBestEstimate() const {
+  return theta_.retract(internal::linearAlgorithms::optimizeBayesTree(bayesTree_));
+}
+
+/* ************************************************************************* */
+Matrix ISAM2Snapshot::marginalCovariance(Key key) const {
+  return cliqueCovariance(*bayesTree_[key], Ordering(FastVector<Key>(1, key)), function_);
 }
 
 /* ************************************************************************* */
@@ -1071,6 +2154,47 @@ static void gradientAtZeroTreeAdder(const boost::shared_ptr<ISAM2Clique>& root,
   }
 }
 
+/* ************************************************************************* */
+MemoryUsage ISAM2::memoryUsage() const
+{
+  MemoryUsage usage = internal::linearAlgorithms::bayesTreeMemoryUsage(*this);
+  usage.add("cached linear factors", linearFactors_.memoryUsage());
+  FastVector<const ISAM2Clique*> stack;
+  BOOST_FOREACH(const sharedClique& root, roots_)
+    stack.push_back(root.get());
+  while (!stack.empty()) {
+    const ISAM2Clique* clique = stack.back();
+    stack.pop_back();
+    if (clique->cachedFactor_)
+      usage.add("cached linear factors", clique->cachedFactor_->memoryUsage());
+    usage.add("cliques", heapBytes(clique->gradientContribution_) + mapNodeBytes(
+        clique->solnPointers_.size(), sizeof(FastMap<Key, VectorValues::iterator>::value_type)));
+    BOOST_FOREACH(const sharedClique& child, clique->children)
+      stack.push_back(child.get());
+  }
+
+  usage += nonlinearFactors_.memoryUsage();
+  usage.add("variable index", variableIndex_.memoryUsage());
+  usage.add("values", theta_.memoryUsage());
+  usage.add("deltas", delta_.memoryUsage() + deltaNewton_.memoryUsage() + RgProd_.memoryUsage());
+
+  typedef FastMap<Key, std::pair<Matrix, sharedClique> > MarginalCovariances;
+  usage.add("marginal covariances", mapNodeBytes(marginalCovariances_.size(),
+      sizeof(MarginalCovariances::value_type)));
+  BOOST_FOREACH(const MarginalCovariances::value_type& covariance, marginalCovariances_)
+    usage.add("marginal covariances", heapBytes(covariance.second.first));
+
+  typedef FastMap<size_t, EvictedSubtree> EvictedSubtrees;
+  usage.add("evictions", mapNodeBytes(evictedSubtrees_.size(), sizeof(EvictedSubtrees::value_type))
+      + mapNodeBytes(evictedKeys_.size(), sizeof(FastMap<Key, size_t>::value_type))
+      + mapNodeBytes(evictedFactors_.size(), sizeof(FastMap<size_t, size_t>::value_type)));
+  BOOST_FOREACH(const EvictedSubtrees::value_type& subtree, evictedSubtrees_) {
+    usage.add("evictions", mapNodeBytes(subtree.second.separator.size() + subtree.second.keys.size(),
+        sizeof(Key)) + heapBytes(subtree.second.factors));
+  }
+  return usage;
+}
+
 /* ************************************************************************* */
 VectorValues ISAM2::gradientAtZero() const
 {
@@ -22,8 +22,10 @@
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/DoglegOptimizerImpl.h>
 #include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/base/TaskArena.h>
 
 #include <boost/variant.hpp>
+#include <iosfwd>
 
 namespace gtsam {
 
@@ -169,6 +171,51 @@ struct GTSAM_EXPORT ISAM2Params {
   /// having to search for slots every time a factor is added.
   bool findUnusedFactorSlots;
 
+  /** Maximum number of variables above the relinearization threshold that are relinearized in a
+   * single call to ISAM2::update, or 0 for no limit (default: 0).  When more variables are above
+   * the threshold, those furthest above it (relative to the threshold) are relinearized first, and
+   * the others are deferred to a queue that is processed in the following updates, regardless of
+   * relinearizeSkip.  This bounds the relinearization and re-elimination cost of each update, for
+   * real-time applications that need a predictable latency more than an immediately optimal
+   * linearization point.  The queue depth is returned in ISAM2Result::relinearizeQueueDepth.
+   */
+  size_t relinearizeBudget;
+
+  /** Maximum number of variables kept in memory, or 0 to keep all of them (default: 0).  When an
+   * update leaves more variables in memory, the subtrees of the Bayes tree furthest from the roots
+   * are evicted to disk, with their variables and the factors on them, until at most half of this
+   * number remain.  An evicted subtree is loaded again when an update touches it, e.g. with a loop
+   * closure, see ISAM2::pageIn().  All factor and value types must be registered for
+   * serialization with BOOST_CLASS_EXPORT and GTSAM_VALUE_EXPORT.  Eviction is only done with
+   * ISAM2GaussNewtonParams.
+   */
+  size_t maxResidentVariables;
+
+  /** Directory in which evicted subtrees are stored, see maxResidentVariables (default: empty,
+   * meaning the temporary directory of the system).  The files are removed when they are loaded
+   * again or when the ISAM2 object is destroyed.
+   */
+  std::string evictionDirectory;
+
+  /** Whether each update publishes an ISAM2Snapshot, see ISAM2::snapshot() (default: false).
+   * Publishing completes the back-substitution of the delta, like calculateEstimate(), and
+   * copies the linearization point, the delta and the Bayes tree skeleton, which is linear in the
+   * number of variables.
+   */
+  bool publishSnapshots;
+
+  /** The maximum number of threads doing the parallel work of this ISAM2 with TBB, counting the
+   * calling thread, or 0 to use the global TBB scheduler (default: 0).  With a positive number,
+   * updates, marginalization and back-substitution run in a tbb::task_arena of their own, so that
+   * several ISAM2 instances in one process do not oversubscribe the machine, see TaskArena.
+   */
+  int maxThreads;
+
+  /** Called by each thread every time it joins the task arena of maxThreads, e.g. to pin the
+   * threads of this ISAM2 to the cores of a NUMA node (default: none).
+   */
+  TaskArena::ThreadEntry threadEntry;
+
   /** Specify parameters as constructor arguments */
   ISAM2Params(
       OptimizationParams _optimizationParams = ISAM2GaussNewtonParams(), ///< see ISAM2Params::optimizationParams
@@ -184,7 +231,8 @@ struct GTSAM_EXPORT ISAM2Params {
       evaluateNonlinearError(_evaluateNonlinearError), factorization(_factorization),
       cacheLinearizedFactors(_cacheLinearizedFactors), keyFormatter(_keyFormatter),
       enableDetailedResults(false), enablePartialRelinearizationCheck(false),
-      findUnusedFactorSlots(false) {}
+      findUnusedFactorSlots(false), relinearizeBudget(0), maxResidentVariables(0),
+      publishSnapshots(false), maxThreads(0) {}
 
   /// print iSAM2 parameters
   void print(const std::string& str = "") const {
@@ -212,6 +260,11 @@ struct GTSAM_EXPORT ISAM2Params {
     std::cout << "enableDetailedResults:             " << enableDetailedResults << "\n";
     std::cout << "enablePartialRelinearizationCheck: " << enablePartialRelinearizationCheck << "\n";
     std::cout << "findUnusedFactorSlots:             " << findUnusedFactorSlots << "\n";
+    std::cout << "relinearizeBudget:                 " << relinearizeBudget << "\n";
+    std::cout << "maxResidentVariables:              " << maxResidentVariables << "\n";
+    std::cout << "evictionDirectory:                 " << evictionDirectory << "\n";
+    std::cout << "publishSnapshots:                  " << publishSnapshots << "\n";
+    std::cout << "maxThreads:                        " << maxThreads << "\n";
     std::cout.flush();
   }
 
@@ -228,6 +281,11 @@ struct GTSAM_EXPORT ISAM2Params {
   KeyFormatter getKeyFormatter() const { return keyFormatter; }
   bool isEnableDetailedResults() const { return enableDetailedResults; }
   bool isEnablePartialRelinearizationCheck() const { return enablePartialRelinearizationCheck; }
+  size_t getRelinearizeBudget() const { return relinearizeBudget; }
+  size_t getMaxResidentVariables() const { return maxResidentVariables; }
+  std::string getEvictionDirectory() const { return evictionDirectory; }
+  bool isPublishSnapshots() const { return publishSnapshots; }
+  int getMaxThreads() const { return maxThreads; }
 
   void setOptimizationParams(OptimizationParams optimizationParams) { this->optimizationParams = optimizationParams; }
   void setRelinearizeThreshold(RelinearizationThreshold relinearizeThreshold) { this->relinearizeThreshold = relinearizeThreshold; }
@@ -239,6 +297,12 @@ struct GTSAM_EXPORT ISAM2Params {
   void setKeyFormatter(KeyFormatter keyFormatter) { this->keyFormatter = keyFormatter; }
   void setEnableDetailedResults(bool enableDetailedResults) { this->enableDetailedResults = enableDetailedResults; }
   void setEnablePartialRelinearizationCheck(bool enablePartialRelinearizationCheck) { this->enablePartialRelinearizationCheck = enablePartialRelinearizationCheck; }
+  void setRelinearizeBudget(size_t relinearizeBudget) { this->relinearizeBudget = relinearizeBudget; }
+  void setMaxResidentVariables(size_t maxResidentVariables) { this->maxResidentVariables = maxResidentVariables; }
+  void setEvictionDirectory(const std::string& evictionDirectory) { this->evictionDirectory = evictionDirectory; }
+  void setPublishSnapshots(bool publishSnapshots) { this->publishSnapshots = publishSnapshots; }
+  void setMaxThreads(int maxThreads) { this->maxThreads = maxThreads; }
+  void setThreadEntry(const TaskArena::ThreadEntry& threadEntry) { this->threadEntry = threadEntry; }
 
   GaussianFactorGraph::Eliminate getEliminationFunction() const {
     return factorization == CHOLESKY
@@ -314,6 +378,12 @@ struct GTSAM_EXPORT ISAM2Result {
   /** The number of cliques in the Bayes' Tree */
   size_t cliques;
 
+  /** The number of variables above the relinearization threshold that are deferred to later
+   * updates after this update, because of ISAM2Params::relinearizeBudget.  This is always zero
+   * without a budget.
+   */
+  size_t relinearizeQueueDepth;
+
   /** The indices of the newly-added factors, in 1-to-1 correspondence with the
    * factors passed as \c newFactors to ISAM2::update().  These indices may be
    * used later to refer to the factors in order to remove them.
@@ -350,6 +420,27 @@ struct GTSAM_EXPORT ISAM2Result {
    * Detail for information about the results data stored here. */
   boost::optional<DetailedResults> detail;
 
+  /** Cheap measurements of the work done by an update, always filled in without the global
+   * gttic/gttoc timing tree.  The times are wall times in seconds. */
+  struct Metrics {
+    double linearizeTime; ///< Linearizing the new factors and relinearizing the affected ones
+    double symbolicTime; ///< Removing the top of the tree, ordering, and building the elimination and junction trees
+    double eliminationTime; ///< Numerical elimination of the top of the tree, including the ordering of independent parts eliminated in parallel
+    double wildfireTime; ///< Back-substitution at the start of the update, needed to check relinearization
+    double totalTime; ///< The whole update
+    size_t bytesAllocated; ///< Matrix storage of the factors linearized, and of the conditionals and cached factors eliminated
+    size_t affectedCliques; ///< Cliques removed from the top of the tree to be re-eliminated
+    size_t orphans; ///< Subtrees below the removed cliques that were reattached unchanged
+    size_t newCliques; ///< Cliques created by the re-elimination
+    size_t maxCliqueDimension; ///< Largest dimension, frontal plus separator, of a re-eliminated clique
+    Metrics() : linearizeTime(0.0), symbolicTime(0.0), eliminationTime(0.0), wildfireTime(0.0),
+        totalTime(0.0), bytesAllocated(0), affectedCliques(0), orphans(0), newCliques(0),
+        maxCliqueDimension(0) {}
+  };
+
+  /** Measurements of this update, see Metrics */
+  Metrics metrics;
+
 
   void print(const std::string str = "") const {
     std::cout << str << "  Reelimintated: " << variablesReeliminated << "  Relinearized: " << variablesRelinearized << "  Cliques: " << cliques << std::endl;
@@ -359,6 +450,7 @@ struct GTSAM_EXPORT ISAM2Result {
   size_t getVariablesRelinearized() const { return variablesRelinearized; };
   size_t getVariablesReeliminated() const { return variablesReeliminated; };
   size_t getCliques() const { return cliques; };
+  size_t getRelinearizeQueueDepth() const { return relinearizeQueueDepth; };
 };
 
 /**
@@ -421,6 +513,65 @@ private:
   }
 }; // \struct ISAM2Clique
 
+/**
+ * @addtogroup ISAM2
+ * An immutable view of an ISAM2 after a completed update, published when
+ * ISAM2Params::publishSnapshots is set, see ISAM2::snapshot().  It holds the linearization point,
+ * the delta and a copy of the Bayes tree sharing the conditionals of the ISAM2, so other threads
+ * can compute estimates and marginal covariances from it while the next update runs, without
+ * locking.  All methods are const and may be called concurrently.  A snapshot is freed when the
+ * last reader releases it.
+ */
+class GTSAM_EXPORT ISAM2Snapshot {
+public:
+  typedef boost::shared_ptr<const ISAM2Snapshot> shared_ptr;
+
+  /** Copy the state of an ISAM2, called by ISAM2 when publishing */
+  ISAM2Snapshot(size_t epoch, const Values& theta, const VectorValues& delta,
+      const BayesTree<ISAM2Clique>& bayesTree, const GaussianFactorGraph::Eliminate& function);
+
+  /** The number of snapshots published before this one by the same ISAM2 */
+  size_t epoch() const { return epoch_; }
+
+  /** The linearization point */
+  const Values& getLinearizationPoint() const { return theta_; }
+
+  /** The delta, as returned by ISAM2::getDelta() */
+  const VectorValues& getDelta() const { return delta_; }
+
+  /** The Bayes tree */
+  const BayesTree<ISAM2Clique>& bayesTree() const { return bayesTree_; }
+
+  /** The estimate, as computed by ISAM2::calculateEstimate() */
+  Values calculateEstimate() const;
+
+  /** The estimate of a single variable, as computed by ISAM2::calculateEstimate(Key) */
+  template<class VALUE>
+  VALUE calculateEstimate(Key key) const {
+    return traits<VALUE>::Retract(theta_.at<VALUE>(key), delta_.at(key));
+  }
+
+  /** The estimate from a full Gauss-Newton back-substitution of the Bayes tree */
+  Values calculateBestEstimate() const;
+
+  /** The marginal covariance of a variable, as computed by ISAM2::marginalCovariance() but not
+   *  cached */
+  Matrix marginalCovariance(Key key) const;
+
+private:
+  /// A copy of the Bayes tree of an ISAM2, whose copy constructor is only accessible to subclasses
+  class Tree : public BayesTree<ISAM2Clique> {
+  public:
+    explicit Tree(const BayesTree<ISAM2Clique>& other) : BayesTree<ISAM2Clique>(other) {}
+  };
+
+  size_t epoch_;
+  Values theta_;
+  VectorValues delta_;
+  Tree bayesTree_;
+  GaussianFactorGraph::Eliminate function_;
+};
+
 /**
  * @addtogroup ISAM2
  * Implementation of the full ISAM2 algorithm for incremental nonlinear optimization.
@@ -430,6 +581,12 @@ private:
  * method.  At any time, calculateEstimate() may be called to obtain the current
  * estimate of all variables.
  *
+ * Copying an ISAM2 is a cheap fork, e.g. to evaluate several hypotheses by updating each copy.
+ * The copy gets its own Bayes tree cliques, linearization point, delta and variable index, but
+ * shares the conditionals, cached factors and the linear and nonlinear factors, which are never
+ * modified in place: update() replaces the conditionals of the affected cliques, and
+ * marginalizeLeaves() copies a conditional before splitting it.  Only the affected part is thus
+ * copied, and the original and its copies may be updated concurrently.
  */
 class GTSAM_EXPORT ISAM2: public BayesTree<ISAM2Clique> {
 
@@ -480,6 +637,38 @@ protected:
 
   int update_count_; ///< Counter incremented every update(), used to determine periodic relinearization
 
+  /** Variables above the relinearization threshold whose relinearization was deferred because of
+   * ISAM2Params::relinearizeBudget.  They are prioritized again by their current delta in the
+   * next update. */
+  KeySet deferredRelinKeys_;
+
+  /** The marginal covariances computed by marginalCovariances(), with the root of the tree they
+   * were computed in.  The entries of a tree are discarded when its root is replaced. */
+  mutable FastMap<Key, std::pair<Matrix, boost::shared_ptr<ISAM2Clique> > > marginalCovariances_;
+
+  /** A subtree of the Bayes tree evicted to disk because of ISAM2Params::maxResidentVariables.
+   * The file holds the subtree, the linearization point and delta of its variables, and the
+   * factors involving any of them, which are removed from memory. */
+  struct EvictedSubtree {
+    boost::shared_ptr<const std::string> file; ///< The file, removed with the last copy of this pointer
+    Key parent; ///< The first frontal variable of the clique the subtree was a child of
+    KeySet separator; ///< The separator of the root of the subtree
+    KeySet keys; ///< The variables of the subtree
+    FastVector<size_t> factors; ///< The indices of the evicted factors
+  };
+
+  FastMap<size_t, EvictedSubtree> evictedSubtrees_; ///< The evicted subtrees, by eviction number
+  FastMap<Key, size_t> evictedKeys_; ///< The evicted subtree of each evicted variable
+  FastMap<size_t, size_t> evictedFactors_; ///< The evicted subtree of each evicted factor index
+  size_t evictionCount_; ///< The number of subtrees evicted so far
+
+  /** The last published snapshot, only accessed with boost::atomic_load and boost::atomic_store,
+   * see ISAM2Params::publishSnapshots */
+  boost::shared_ptr<const ISAM2Snapshot> snapshot_;
+
+  /** The task arena of ISAM2Params::maxThreads, shared by copies */
+  TaskArena arena_;
+
 public:
 
   typedef ISAM2 This; ///< This class
@@ -536,6 +725,18 @@ public:
       const boost::optional<FastList<Key> >& extraReelimKeys = boost::none,
       bool force_relinearize = false);
 
+  /**
+   * Same as update(), but with the new factors already linearized, for example on another thread
+   * while a previous update was running (see ISAM2Pipeline).  \c linearizedNewFactors[i] must be
+   * the linearization of \c newFactors[i] at \c linearizationPoint, or null.  Factors that are
+   * null, or that involve a variable whose linearization point in this ISAM2 differs from
+   * \c linearizationPoint when they are added, are linearized again.  The linearized factors are
+   * only used when ISAM2Params::cacheLinearizedFactors is enabled.
+   */
+  ISAM2Result updateLinearized(const NonlinearFactorGraph& newFactors, const Values& newTheta,
+      const std::vector<size_t>& removeFactorIndices,
+      const GaussianFactorGraph& linearizedNewFactors, const Values& linearizationPoint);
+
   /** Marginalize out variables listed in leafKeys.  These keys must be leaves
    * in the BayesTree.  Throws MarginalizeNonleafException if non-leaves are
    * requested to be marginalized.  Marginalization leaves a linear
@@ -559,11 +760,53 @@ public:
     return theta_;
   }
 
-  /// Check whether variable with given key exists in linearization point
+  /// Check whether variable with given key exists in linearization point, or was evicted to disk
   bool valueExists(Key key) const {
-    return theta_.exists(key);
+    return theta_.exists(key) || evictedKeys_.exists(key);
   }
 
+  /** Load the evicted subtrees containing any of \c keys back into memory (see
+   * ISAM2Params::maxResidentVariables).  update() does this for the variables it touches, but the
+   * estimate and marginals of a variable that is evicted are only available after loading it. */
+  void pageIn(const KeySet& keys);
+
+  /// Check whether a variable is evicted to disk, see ISAM2Params::maxResidentVariables
+  bool isEvicted(Key key) const { return evictedKeys_.exists(key); }
+
+  /// The variables evicted to disk, see ISAM2Params::maxResidentVariables
+  KeySet getEvictedKeys() const;
+
+  /** Write a checkpoint of the whole state to \c stream, from which loadCheckpoint() restores an
+   * identical ISAM2 without re-eliminating, e.g. on a standby process for failover.  The factors
+   * and linearization point are written with boost serialization, so their types need to be
+   * exported as for eviction, while the Bayes tree and delta are written as raw buffers in the
+   * native byte order.  The evicted subtrees need to be loaded with pageIn() first. */
+  void saveCheckpoint(std::ostream& stream) const;
+
+  /** Replace the whole state with a checkpoint written by saveCheckpoint(), keeping the
+   * parameters of this ISAM2.  Only the variable index and, if
+   * ISAM2Params::cacheLinearizedFactors is set, the linearized factors are recomputed. */
+  void loadCheckpoint(std::istream& stream);
+
+  /** Append the arguments of an update() to \c stream, so that an ISAM2 restored from a
+   * checkpoint can follow the updates after it with replayUpdate() */
+  static void saveUpdate(std::ostream& stream, const NonlinearFactorGraph& newFactors,
+      const Values& newTheta = Values(),
+      const std::vector<size_t>& removeFactorIndices = std::vector<size_t>());
+
+  /** Apply the next update written by saveUpdate() to \c stream, or return false if the stream
+   * has no more updates */
+  bool replayUpdate(std::istream& stream);
+
+  /** Remove the null slots that removed and marginalized factors leave in the factor graph,
+   * renumbering the remaining factors in their order.  The variable index, the cached linear
+   * factors and the factors evicted to disk, which keep their slots, are renumbered in place, and
+   * the capacity of the removed factors is released.  Factor indices held by the caller, e.g.
+   * for removeFactorIndices, need to be renumbered with the returned remapping.
+   * @return The new index of every previous factor index, or the new number of factors for the
+   * null slots */
+  FastVector<size_t> compactFactors();
+
   /** Compute an estimate from the incomplete linear delta computed during the last update.
    * This delta is incomplete because it was not updated below wildfire_threshold.  If only
    * a single variable is needed, it is faster to call calculateEstimate(const KEY&).
@@ -588,9 +831,23 @@ public:
    */
   const Value& calculateEstimate(Key key) const;
 
-  /** Return marginal on any variable as a covariance matrix */
+  /** Return marginal on any variable as a covariance matrix.  The result is cached, see
+   *  marginalCovariances(). */
   Matrix marginalCovariance(Key key) const;
 
+  /** Return the marginal covariances of several variables, in the order of \c keys.  The
+   *  variables in the same clique share the elimination of the clique marginal, and all
+   *  variables share the separator marginals cached in the cliques on the way to the root.
+   *  The covariances are cached until the top of their tree is re-eliminated, which changes the
+   *  marginals of all variables in that tree, so repeated queries between updates and queries in
+   *  trees untouched by the last update are answered from the cache. */
+  FastVector<Matrix> marginalCovariances(const FastVector<Key>& keys) const;
+
+  /** The snapshot published after the last update() or marginalizeLeaves(), or null if
+   *  ISAM2Params::publishSnapshots is not set.  Unlike the other methods, this may be called from
+   *  any thread while an update is running, and the snapshot stays valid while it is held. */
+  ISAM2Snapshot::shared_ptr snapshot() const { return boost::atomic_load(&snapshot_); }
+
   /// @name Public members for non-typical usage
   /// @{
 
@@ -616,6 +873,9 @@ public:
   /** Access the nonlinear variable index */
   const KeySet& getFixedVariables() const { return fixedVariables_; }
 
+  /** Variables whose relinearization is deferred to later updates, see ISAM2Params::relinearizeBudget */
+  const KeySet& getDeferredRelinKeys() const { return deferredRelinKeys_; }
+
   size_t lastAffectedVariableCount;
   size_t lastAffectedFactorCount;
   size_t lastAffectedCliqueCount;
@@ -627,6 +887,20 @@ public:
 
   /** prints out clique statistics */
   void printStats() const { getCliqueData().getStats().print(); }
+
+  /**
+   * Return the memory used by this ISAM2, broken down into:
+   *  - "conditionals", "cliques" and "nodes" of the Bayes tree, see GaussianBayesTree::memoryUsage,
+   *    where "cliques" includes the gradient contributions of the cliques
+   *  - "factors" and "noise models" of the nonlinear factors, see NonlinearFactorGraph::memoryUsage
+   *  - "cached linear factors", the linearized factors and the factors cached in the cliques
+   *  - "variable index"
+   *  - "values", the linearization point, and "deltas", the delta and the Dogleg vectors
+   *  - "marginal covariances" cached by marginalCovariances() and "evictions", the bookkeeping of
+   *    the subtrees evicted to disk
+   * See MemoryUsage.
+   */
+  MemoryUsage memoryUsage() const;
   
   /** Compute the gradient of the energy function, \f$ \nabla_{x=0} \left\Vert \Sigma^{-1} R x - d
    * \right\Vert^2 \f$, centered around zero. The gradient about zero is \f$ -R^T d \f$.  See also
@@ -640,14 +914,65 @@ public:
 
 protected:
 
-  FastSet<size_t> getAffectedFactors(const FastList<Key>& keys) const;
-  GaussianFactorGraph::shared_ptr relinearizeAffectedFactors(const FastList<Key>& affectedKeys, const KeySet& relinKeys) const;
+  /** The sorted indices of the factors involving any of \c keys */
+  FastVector<size_t> getAffectedFactors(const KeyVector& keys) const;
+
+  /** Linearize the factors that only involve \c affectedKeys, reusing the cached linear factors
+   * that involve none of \c relinKeys.  Both key vectors must be sorted. */
+  GaussianFactorGraph::shared_ptr relinearizeAffectedFactors(const KeyVector& affectedKeys, const KeyVector& relinKeys,
+      boost::optional<size_t&> linearizedBytes = boost::none) const;
   GaussianFactorGraph getCachedBoundaryFactors(Cliques& orphans);
 
+  /// Implementation of update() and updateLinearized()
+  ISAM2Result updateImpl(const NonlinearFactorGraph& newFactors, const Values& newTheta,
+      const std::vector<size_t>& removeFactorIndices,
+      const boost::optional<FastMap<Key,int> >& constrainedKeys,
+      const boost::optional<FastList<Key> >& noRelinKeys,
+      const boost::optional<FastList<Key> >& extraReelimKeys, bool force_relinearize,
+      const GaussianFactorGraph* linearizedNewFactors, const Values* linearizationPoint);
+
+  /// Linearize the new factors at theta_, reusing those of \c linearized that were linearized at
+  /// the current linearization point of all their variables
+  GaussianFactorGraph::shared_ptr linearizeNewFactors(const NonlinearFactorGraph& newFactors,
+      const GaussianFactorGraph& linearized, const Values& linearizationPoint) const;
+
   virtual boost::shared_ptr<KeySet > recalculate(const KeySet& markedKeys, const KeySet& relinKeys,
       const std::vector<Key>& observedKeys, const KeySet& unusedIndices, const boost::optional<FastMap<Key,int> >& constrainKeys, ISAM2Result& result);
+  /** Update the delta in the task arena, see updateDeltaImpl() */
   void updateDelta(bool forceFullSolve = false) const;
 
+  /** Back-substitute the delta of the replaced variables, or do a Dogleg step */
+  void updateDeltaImpl(bool forceFullSolve) const;
+
+  /** Implementation of marginalizeLeaves(), run in the task arena */
+  void marginalizeLeavesImpl(const FastList<Key>& leafKeys,
+    boost::optional<std::vector<size_t>&> marginalFactorsIndices,
+    boost::optional<std::vector<size_t>&> deletedFactorsIndices);
+
+  /** The arguments of updateImpl(), to call it in the task arena */
+  struct UpdateTask;
+
+  /** Publish a snapshot of the current state, if ISAM2Params::publishSnapshots is set */
+  void publishSnapshot();
+
+  /** Discard the cached marginal covariances of the trees whose root was replaced */
+  void removeStaleMarginalCovariances() const;
+
+  /** Load the evicted subtrees that contain any of \c keys, or that hang below the cliques of
+   * the others or their ancestors, which will be re-eliminated.  Also load those whose separator
+   * involves any of \c separatorKeys, whose factors or cliques depend on these variables. */
+  void pageInTouched(const KeySet& keys, const KeySet& separatorKeys);
+
+  /** Evict the subtrees furthest from the roots until at most half of
+   * ISAM2Params::maxResidentVariables variables remain in memory */
+  void evictColdSubtrees();
+
+  /** Move a subtree and its variables and factors to disk */
+  void evictSubtree(const sharedClique& subtree);
+
+  /** Load an evicted subtree back into memory, with the subtree it hangs below if needed */
+  void loadEvictedSubtree(size_t eviction);
+
 }; // ISAM2
 
 /// traits
@@ -672,6 +997,15 @@ template<class CLIQUE>
 size_t optimizeWildfireNonRecursive(const boost::shared_ptr<CLIQUE>& root,
     double threshold, const KeySet& replaced, VectorValues& delta);
 
+/// Version of optimizeWildfireNonRecursive() for a forest, in which the cliques are solved by
+/// parallel tasks when TBB is enabled: once a clique is solved, its children that need to be
+/// recalculated, because they were replaced or their separator changed above the threshold, are
+/// spawned as new tasks.  Without TBB, the trees are solved one after the other.
+/// @return The number of variables that were solved for
+template<class CLIQUE>
+size_t optimizeWildfireParallel(const FastVector<boost::shared_ptr<CLIQUE> >& roots,
+    double threshold, const KeySet& replaced, VectorValues& delta);
+
 /// calculate the number of non-zero entries for the tree starting at clique (use root for complete matrix)
 template<class CLIQUE>
 int calculate_nnz(const boost::shared_ptr<CLIQUE>& clique);
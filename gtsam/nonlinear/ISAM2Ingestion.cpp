@@ -0,0 +1,205 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Ingestion.cpp
+ * @brief   Multi-producer ingestion of measurements into ISAM2, coalescing pending updates
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2Ingestion.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+struct ISAM2Ingestion::Measurement {
+  NonlinearFactorGraph newFactors;
+  Values newTheta;
+  boost::posix_time::ptime pushed;
+  Measurement* next;
+
+  Measurement(const NonlinearFactorGraph& _newFactors, const Values& _newTheta) :
+      newFactors(_newFactors), newTheta(_newTheta),
+      pushed(boost::posix_time::microsec_clock::universal_time()), next(0) {
+  }
+};
+
+/* ************************************************************************* */
+ISAM2Ingestion::ISAM2Ingestion(const ISAM2Params& isamParams, const Params& params) :
+    params_(params), isam_(isamParams), head_(0), pendingFactors_(0), pushed_(0), rejected_(0),
+    maxPendingFactors_(0), nrApplied_(0), nrUpdates_(0), maxBatch_(0), totalLatency_(0.0),
+    maxLatency_(0.0), stopping_(false) {
+  worker_ = boost::thread(&ISAM2Ingestion::run, this);
+}
+
+/* ************************************************************************* */
+ISAM2Ingestion::~ISAM2Ingestion() {
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  worker_.join();
+}
+
+/* ************************************************************************* */
+bool ISAM2Ingestion::push(const NonlinearFactorGraph& newFactors, const Values& newTheta) {
+  // Reserve room for the factors first, so that concurrent pushes cannot exceed the limit
+  const size_t nrFactors = newFactors.size();
+  const size_t pending = pendingFactors_.fetch_add(nrFactors) + nrFactors;
+  if (params_.maxPendingFactors > 0 && pending > params_.maxPendingFactors && pending > nrFactors) {
+    pendingFactors_.fetch_sub(nrFactors);
+    ++rejected_;
+    return false;
+  }
+  size_t maxPending = maxPendingFactors_.load(boost::memory_order_relaxed);
+  while (pending > maxPending
+      && !maxPendingFactors_.compare_exchange_weak(maxPending, pending, boost::memory_order_relaxed))
+    ;
+  ++pushed_;
+
+  Measurement* measurement = new Measurement(newFactors, newTheta);
+  Measurement* head = head_.load(boost::memory_order_relaxed);
+  do {
+    measurement->next = head;
+  } while (!head_.compare_exchange_weak(head, measurement, boost::memory_order_release,
+      boost::memory_order_relaxed));
+
+  // Only wake the worker if it may be waiting: for any measurement, or for a larger batch
+  const bool reachedBatch = pending >= params_.minBatchFactors
+      && pending - nrFactors < params_.minBatchFactors;
+  if (!head || reachedBatch) {
+    boost::mutex::scoped_lock lock(mutex_);
+    wake_.notify_one();
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+void ISAM2Ingestion::flush() {
+  const size_t pushed = pushed_.load();
+  boost::mutex::scoped_lock lock(mutex_);
+  while (nrApplied_ < pushed)
+    applied_.wait(lock);
+  if (error_) {
+    boost::exception_ptr error = error_;
+    error_ = boost::exception_ptr();
+    boost::rethrow_exception(error);
+  }
+}
+
+/* ************************************************************************* */
+ISAM2Result ISAM2Ingestion::lastResult() const {
+  boost::mutex::scoped_lock lock(mutex_);
+  return lastResult_;
+}
+
+/* ************************************************************************* */
+ISAM2Ingestion::Statistics ISAM2Ingestion::statistics() const {
+  Statistics statistics;
+  statistics.pushed = pushed_.load();
+  statistics.rejected = rejected_.load();
+  statistics.pendingFactors = pendingFactors_.load();
+  statistics.maxPendingFactors = maxPendingFactors_.load();
+  boost::mutex::scoped_lock lock(mutex_);
+  statistics.applied = nrApplied_;
+  statistics.updates = nrUpdates_;
+  statistics.maxBatch = maxBatch_;
+  statistics.meanLatency = nrApplied_ > 0 ? totalLatency_ / nrApplied_ : 0.0;
+  statistics.maxLatency = maxLatency_;
+  return statistics;
+}
+
+/* ************************************************************************* */
+void ISAM2Ingestion::run() {
+  while (true) {
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      while (!head_.load(boost::memory_order_acquire) && !stopping_)
+        wake_.wait(lock);
+      if (!head_.load(boost::memory_order_acquire))
+        break;
+
+      // Give the producers a bounded time to fill a larger batch
+      if (params_.maxWait > 0.0 && !stopping_) {
+        const boost::system_time deadline = boost::get_system_time()
+            + boost::posix_time::microseconds(boost::int64_t(params_.maxWait * 1e6));
+        while (pendingFactors_.load() < params_.minBatchFactors && !stopping_)
+          if (!wake_.timed_wait(lock, deadline))
+            break;
+      }
+    }
+
+    // Take all pending measurements, and restore the order in which they were pushed
+    Measurement* measurement = head_.exchange(0, boost::memory_order_acquire);
+    Measurement* oldest = 0;
+    size_t batch = 0, nrFactors = 0;
+    while (measurement) {
+      Measurement* next = measurement->next;
+      measurement->next = oldest;
+      oldest = measurement;
+      measurement = next;
+      ++batch;
+      nrFactors += oldest->newFactors.size();
+    }
+    pendingFactors_.fetch_sub(nrFactors);
+
+    gttic(ISAM2Ingestion_update);
+    ISAM2Result result;
+    boost::exception_ptr error;
+    try {
+      NonlinearFactorGraph newFactors;
+      Values newTheta;
+      newFactors.reserve(nrFactors);
+      for (measurement = oldest; measurement; measurement = measurement->next) {
+        newFactors.push_back(measurement->newFactors);
+        newTheta.insert(measurement->newTheta);
+      }
+      result = isam_.update(newFactors, newTheta);
+    } catch (...) {
+      error = boost::current_exception();
+    }
+    gttoc(ISAM2Ingestion_update);
+
+    const boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+    double totalLatency = 0.0, maxLatency = 0.0;
+    while (oldest) {
+      const double latency = 1e-6 * (now - oldest->pushed).total_microseconds();
+      totalLatency += latency;
+      maxLatency = std::max(maxLatency, latency);
+      Measurement* next = oldest->next;
+      delete oldest;
+      oldest = next;
+    }
+
+    boost::mutex::scoped_lock lock(mutex_);
+    if (error)
+      error_ = error;
+    else
+      lastResult_ = result;
+    nrApplied_ += batch;
+    ++nrUpdates_;
+    maxBatch_ = std::max(maxBatch_, batch);
+    totalLatency_ += totalLatency;
+    maxLatency_ = std::max(maxLatency_, maxLatency);
+    applied_.notify_all();
+  }
+}
+
+/* ************************************************************************* */
+} /// namespace gtsam
@@ -0,0 +1,139 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Ingestion.h
+ * @brief   Multi-producer ingestion of measurements into ISAM2, coalescing pending updates
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/ISAM2.h>
+
+#include <boost/atomic.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace gtsam {
+
+/**
+ * @addtogroup ISAM2
+ * Lets several sensor threads feed new factors and values to one ISAM2.
+ *
+ * push() can be called from any number of threads.  It never takes a lock in the common case:
+ * the measurement is linked into a lock-free stack, and only the push that finds the stack empty
+ * locks a mutex to wake the worker thread.  The worker takes all pending measurements at once,
+ * in the order they were pushed, and applies them with a single ISAM2::update(), so that while
+ * an update is running all measurements that arrive in the meantime are coalesced into the next
+ * one and its fixed overhead is paid once per batch instead of once per measurement.
+ *
+ * Two parameters trade latency for throughput: the worker waits at most \c maxWait seconds for
+ * \c minBatchFactors factors to accumulate before an update, and push() rejects measurements
+ * once \c maxPendingFactors factors are waiting, which is the backpressure a producer sees.  The
+ * statistics() report the queue depth, batch sizes and latencies to tune them.
+ *
+ * Values pushed by different producers must have distinct keys, as for ISAM2::update().
+ */
+class GTSAM_EXPORT ISAM2Ingestion : boost::noncopyable {
+
+public:
+
+  /** Parameters of the coalescing and of the backpressure */
+  struct Params {
+    size_t minBatchFactors; ///< Factors to wait for before an update, within maxWait (default: 1)
+    double maxWait; ///< Seconds an update may be delayed to reach minBatchFactors (default: 0)
+    size_t maxPendingFactors; ///< Pending factors beyond which push() rejects, 0 for no limit (default: 0)
+
+    Params() : minBatchFactors(1), maxWait(0.0), maxPendingFactors(0) {}
+  };
+
+  /** Counters of the measurements and updates so far */
+  struct Statistics {
+    size_t pushed; ///< Measurements accepted by push()
+    size_t rejected; ///< Measurements rejected by push() because of maxPendingFactors
+    size_t applied; ///< Measurements taken by an update
+    size_t updates; ///< ISAM2 updates done, including those that threw an exception
+    size_t maxBatch; ///< Most measurements coalesced into one update
+    size_t pendingFactors; ///< Factors pushed but not taken by an update yet
+    size_t maxPendingFactors; ///< Most factors pending at once
+    double meanLatency; ///< Mean seconds from push() to the end of the update applying it
+    double maxLatency; ///< Most seconds from push() to the end of the update applying it
+
+    Statistics() : pushed(0), rejected(0), applied(0), updates(0), maxBatch(0),
+        pendingFactors(0), maxPendingFactors(0), meanLatency(0.0), maxLatency(0.0) {}
+
+    /** Mean number of measurements coalesced into one update */
+    double meanBatch() const { return updates > 0 ? double(applied) / updates : 0.0; }
+  };
+
+  /** Create an empty ISAM2 and start the worker thread */
+  explicit ISAM2Ingestion(const ISAM2Params& isamParams = ISAM2Params(),
+      const Params& params = Params());
+
+  /** Apply the pending measurements, then stop the worker thread */
+  ~ISAM2Ingestion();
+
+  /**
+   * Queue new factors and the initial values of their new variables, from any thread.
+   * @return false, without queueing, if more than maxPendingFactors factors would be pending,
+   *   unless none are pending yet
+   */
+  bool push(const NonlinearFactorGraph& newFactors, const Values& newTheta = Values());
+
+  /** Wait until everything pushed before this call was applied, and rethrow an exception thrown
+   *  by an update since the last call */
+  void flush();
+
+  /** The result of the last update */
+  ISAM2Result lastResult() const;
+
+  /** The counters so far */
+  Statistics statistics() const;
+
+  /** Access the underlying ISAM2.  This is only safe while no measurements are pending, e.g.
+   *  after flush() and until the next call to push(). */
+  const ISAM2& isam() const { return isam_; }
+
+private:
+
+  struct Measurement;
+
+  const Params params_;
+  ISAM2 isam_; ///< Only accessed by the worker thread while measurements are pending
+
+  boost::atomic<Measurement*> head_; ///< Lock-free stack of pending measurements, newest first
+  boost::atomic<size_t> pendingFactors_;
+  boost::atomic<size_t> pushed_;
+  boost::atomic<size_t> rejected_;
+  boost::atomic<size_t> maxPendingFactors_;
+
+  mutable boost::mutex mutex_; ///< Protects all members below, and the waits on head_
+  boost::condition_variable wake_; ///< Notified when measurements are pending, or to stop
+  mutable boost::condition_variable applied_; ///< Notified after each update
+  size_t nrApplied_;
+  size_t nrUpdates_;
+  size_t maxBatch_;
+  double totalLatency_;
+  double maxLatency_;
+  ISAM2Result lastResult_;
+  boost::exception_ptr error_; ///< Exception thrown by an update since the last flush()
+  bool stopping_; ///< Set by the destructor
+  boost::thread worker_;
+
+  /** Worker thread: take the pending measurements and apply them with one update */
+  void run();
+};
+
+} /// namespace gtsam
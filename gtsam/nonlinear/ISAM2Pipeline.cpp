@@ -0,0 +1,218 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Pipeline.cpp
+ * @brief   Asynchronous ISAM2 updates, overlapping linearization with elimination
+ * @date    Oct 14, 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2Pipeline.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+struct ISAM2Pipeline::Job {
+  NonlinearFactorGraph newFactors;
+  Values newTheta;
+  vector<size_t> removeFactorIndices;
+  GaussianFactorGraph linearized; ///< One entry per new factor, null if not linearized
+  Values linearizationPoint; ///< Values of the variables of the new factors
+  boost::promise<ISAM2Result> result;
+
+  Job(const NonlinearFactorGraph& _newFactors, const Values& _newTheta,
+      const vector<size_t>& _removeFactorIndices) :
+      newFactors(_newFactors), newTheta(_newTheta), removeFactorIndices(_removeFactorIndices) {
+  }
+};
+
+/* ************************************************************************* */
+ISAM2Pipeline::ISAM2Pipeline(const ISAM2Params& params) :
+    isam_(params), theta_(boost::make_shared<Values>()), estimate_(boost::make_shared<Values>()),
+    completed_(0), stopping_(false) {
+  linearizer_ = boost::thread(&ISAM2Pipeline::linearizeLoop, this);
+  eliminator_ = boost::thread(&ISAM2Pipeline::eliminateLoop, this);
+}
+
+/* ************************************************************************* */
+ISAM2Pipeline::~ISAM2Pipeline() {
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  changed_.notify_all();
+  linearizer_.join();
+  eliminator_.join();
+}
+
+/* ************************************************************************* */
+boost::shared_future<ISAM2Result> ISAM2Pipeline::updateAsync(
+    const NonlinearFactorGraph& newFactors, const Values& newTheta,
+    const vector<size_t>& removeFactorIndices) {
+  const sharedJob job = boost::make_shared<Job>(newFactors, newTheta, removeFactorIndices);
+  boost::shared_future<ISAM2Result> result(job->result.get_future());
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    unfinished_.push_back(job);
+    toLinearize_.push_back(job);
+  }
+  changed_.notify_all();
+  return result;
+}
+
+/* ************************************************************************* */
+void ISAM2Pipeline::wait() const {
+  boost::mutex::scoped_lock lock(mutex_);
+  while (!unfinished_.empty())
+    changed_.wait(lock);
+}
+
+/* ************************************************************************* */
+size_t ISAM2Pipeline::pendingUpdates() const {
+  boost::mutex::scoped_lock lock(mutex_);
+  return unfinished_.size();
+}
+
+/* ************************************************************************* */
+size_t ISAM2Pipeline::completedUpdates() const {
+  boost::mutex::scoped_lock lock(mutex_);
+  return completed_;
+}
+
+/* ************************************************************************* */
+Values ISAM2Pipeline::calculateEstimate() const {
+  boost::shared_ptr<const Values> estimate;
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    estimate = estimate_;
+  }
+  return *estimate;
+}
+
+/* ************************************************************************* */
+void ISAM2Pipeline::linearizeLoop() {
+  for (;;) {
+    sharedJob job;
+    boost::shared_ptr<const Values> theta;
+    vector<sharedJob> earlier;
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      while (toLinearize_.empty() && !stopping_)
+        changed_.wait(lock);
+      if (toLinearize_.empty())
+        return;
+      job = toLinearize_.front();
+      toLinearize_.pop_front();
+      // The variables of this update are at the linearization point of the last completed
+      // update, or at the initial values of a pending update that adds them
+      theta = theta_;
+      BOOST_FOREACH(const sharedJob& pending, unfinished_) {
+        if (pending == job) break;
+        earlier.push_back(pending);
+      }
+    }
+
+    gttic(ISAM2Pipeline_linearize);
+    BOOST_FOREACH(Key key, job->newFactors.keys()) {
+      if (job->newTheta.exists(key)) {
+        job->linearizationPoint.insert(key, job->newTheta.at(key));
+        continue;
+      }
+      bool found = false;
+      BOOST_REVERSE_FOREACH(const sharedJob& pending, earlier) {
+        if (pending->newTheta.exists(key)) {
+          job->linearizationPoint.insert(key, pending->newTheta.at(key));
+          found = true;
+          break;
+        }
+      }
+      if (!found && theta->exists(key))
+        job->linearizationPoint.insert(key, theta->at(key));
+    }
+
+    // Factors with missing variables or failing linearizations are left to ISAM2, which
+    // linearizes them again and reports the error when the update is applied
+    job->linearized.reserve(job->newFactors.size());
+    BOOST_FOREACH(const NonlinearFactor::shared_ptr& factor, job->newFactors) {
+      GaussianFactor::shared_ptr linearized;
+      if (factor) {
+        bool complete = true;
+        BOOST_FOREACH(Key key, factor->keys())
+          complete = complete && job->linearizationPoint.exists(key);
+        if (complete) {
+          try {
+            linearized = factor->linearize(job->linearizationPoint);
+          } catch (const std::exception&) {
+          }
+        }
+      }
+      job->linearized.push_back(linearized);
+    }
+    gttoc(ISAM2Pipeline_linearize);
+
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      toEliminate_.push_back(job);
+    }
+    changed_.notify_all();
+  }
+}
+
+/* ************************************************************************* */
+void ISAM2Pipeline::eliminateLoop() {
+  for (;;) {
+    sharedJob job;
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      while (toEliminate_.empty() && !(stopping_ && unfinished_.empty()))
+        changed_.wait(lock);
+      if (toEliminate_.empty())
+        return;
+      job = toEliminate_.front();
+      toEliminate_.pop_front();
+    }
+
+    gttic(ISAM2Pipeline_update);
+    try {
+      const ISAM2Result result = isam_.updateLinearized(job->newFactors, job->newTheta,
+          job->removeFactorIndices, job->linearized, job->linearizationPoint);
+      const boost::shared_ptr<const Values> theta =
+          boost::make_shared<Values>(isam_.getLinearizationPoint());
+      const boost::shared_ptr<const Values> estimate =
+          boost::make_shared<Values>(isam_.calculateEstimate());
+      {
+        boost::mutex::scoped_lock lock(mutex_);
+        theta_ = theta;
+        estimate_ = estimate;
+        unfinished_.pop_front();
+        ++completed_;
+      }
+      job->result.set_value(result);
+    } catch (...) {
+      {
+        boost::mutex::scoped_lock lock(mutex_);
+        unfinished_.pop_front();
+        ++completed_;
+      }
+      job->result.set_exception(boost::current_exception());
+    }
+    gttoc(ISAM2Pipeline_update);
+    changed_.notify_all();
+  }
+}
+
+} /// namespace gtsam
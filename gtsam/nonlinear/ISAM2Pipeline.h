@@ -0,0 +1,123 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Pipeline.h
+ * @brief   Asynchronous ISAM2 updates, overlapping linearization with elimination
+ * @date    Oct 14, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/ISAM2.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/future.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <deque>
+
+namespace gtsam {
+
+/**
+ * @addtogroup ISAM2
+ * Runs ISAM2 updates asynchronously, so that the caller does not block while the Bayes tree is
+ * updated.
+ *
+ * updateAsync() queues an update and returns immediately with a future of its ISAM2Result.
+ * Updates are applied in the order they were queued, by two background threads forming a
+ * pipeline: one thread linearizes the new factors of update k+1 while the other runs update k,
+ * i.e., the relinearization, re-elimination of the top of the Bayes tree and back-substitution.
+ * The new factors are linearized at the linearization point of the last completed update and are
+ * handed to ISAM2::updateLinearized(), which linearizes again the few factors whose variables
+ * were relinearized in the meantime.  The results are therefore the same as calling
+ * ISAM2::update() with the same arguments in sequence.  The overlap requires
+ * ISAM2Params::cacheLinearizedFactors, which is the default.
+ *
+ * After each update, the pipeline publishes a copy of the estimate and of the linearization
+ * point, so calculateEstimate() always returns the consistent estimate of a completed update,
+ * without waiting for the update in progress.  Copying them is linear in the number of
+ * variables, like ISAM2::calculateEstimate().
+ */
+class GTSAM_EXPORT ISAM2Pipeline : boost::noncopyable {
+
+public:
+
+  /** Create an empty pipeline, sharing the parameters of ISAM2 */
+  explicit ISAM2Pipeline(const ISAM2Params& params = ISAM2Params());
+
+  /** Complete the queued updates, then stop the background threads */
+  ~ISAM2Pipeline();
+
+  /**
+   * Queue an update with the same arguments as ISAM2::update(), and return immediately.  Factor
+   * indices in \c removeFactorIndices refer to the factors after all previously queued updates.
+   * @return A future of the ISAM2Result of this update, which rethrows any exception thrown by
+   * the update when accessed
+   */
+  boost::shared_future<ISAM2Result> updateAsync(
+      const NonlinearFactorGraph& newFactors = NonlinearFactorGraph(),
+      const Values& newTheta = Values(),
+      const std::vector<size_t>& removeFactorIndices = std::vector<size_t>());
+
+  /** Queue an update and wait for its result, see updateAsync() */
+  ISAM2Result update(const NonlinearFactorGraph& newFactors = NonlinearFactorGraph(),
+      const Values& newTheta = Values(),
+      const std::vector<size_t>& removeFactorIndices = std::vector<size_t>()) {
+    return updateAsync(newFactors, newTheta, removeFactorIndices).get();
+  }
+
+  /** Wait for all queued updates to complete */
+  void wait() const;
+
+  /** Number of queued updates that have not completed yet */
+  size_t pendingUpdates() const;
+
+  /** Number of updates completed so far, including those that threw an exception */
+  size_t completedUpdates() const;
+
+  /** The estimate after the last completed update, as computed by ISAM2::calculateEstimate().
+   *  This does not wait for pending updates. */
+  Values calculateEstimate() const;
+
+  /** Access the underlying ISAM2.  This is only safe when no updates are pending, e.g. after
+   *  wait(), and until the next call to updateAsync(). */
+  const ISAM2& isam() const { return isam_; }
+
+private:
+
+  struct Job;
+  typedef boost::shared_ptr<Job> sharedJob;
+
+  // Work loops of the two background threads
+  void linearizeLoop();
+  void eliminateLoop();
+
+  ISAM2 isam_; ///< Only accessed by the elimination thread, while updates are pending
+
+  mutable boost::mutex mutex_; ///< Protects all members below
+  mutable boost::condition_variable changed_; ///< Notified when a job moves through the pipeline
+  std::deque<sharedJob> unfinished_; ///< All queued updates that have not completed, in order
+  std::deque<sharedJob> toLinearize_; ///< Updates waiting for linearization
+  std::deque<sharedJob> toEliminate_; ///< Linearized updates waiting to be applied
+  boost::shared_ptr<const Values> theta_; ///< Linearization point after the last completed update
+  boost::shared_ptr<const Values> estimate_; ///< Estimate after the last completed update
+  size_t completed_; ///< Number of completed updates
+  bool stopping_; ///< Set by the destructor
+
+  boost::thread linearizer_;
+  boost::thread eliminator_;
+};
+
+} /// namespace gtsam
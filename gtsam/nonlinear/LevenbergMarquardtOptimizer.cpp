@@ -23,6 +23,11 @@
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/Errors.h>
 #include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#endif
 
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/map.hpp>
@@ -31,6 +36,7 @@
 #include <fstream>
 #include <limits>
 #include <string>
+#include <vector>
 #include <cmath>
 
 using namespace std;
@@ -110,6 +116,7 @@ void LevenbergMarquardtParams::print(const std::string& str) const {
   std::cout << "            diagonalDamping: " << diagonalDamping << "\n";
   std::cout << "                minDiagonal: " << minDiagonal << "\n";
   std::cout << "                maxDiagonal: " << maxDiagonal << "\n";
+  std::cout << "       parallelLambdaTrials: " << parallelLambdaTrials << "\n";
   std::cout << "                verbosityLM: "
       << verbosityLMTranslator(verbosityLM) << "\n";
   std::cout.flush();
@@ -117,7 +124,7 @@ void LevenbergMarquardtParams::print(const std::string& str) const {
 
 /* ************************************************************************* */
 GaussianFactorGraph::shared_ptr LevenbergMarquardtOptimizer::linearize() const {
-  return graph_.linearize(state_.values);
+  return linearizeWithCache(state_.values);
 }
 
 /* ************************************************************************* */
@@ -168,7 +175,9 @@ GaussianFactorGraph::shared_ptr LevenbergMarquardtOptimizer::buildDampedSystem(
 
   // for each of the variables, add a prior
   double sigma = 1.0 / std::sqrt(state_.lambda);
-  GaussianFactorGraph::shared_ptr dampedPtr = linear.cloneToPtr();
+  // Elimination never modifies its input factors, so the damped system can share
+  // the factors of the undamped one, and only the damping priors are new
+  GaussianFactorGraph::shared_ptr dampedPtr = boost::make_shared<GaussianFactorGraph>(linear);
   GaussianFactorGraph &damped = (*dampedPtr);
   damped.reserve(damped.size() + state_.values.size());
   if (params_.diagonalDamping) {
@@ -250,8 +259,16 @@ void LevenbergMarquardtOptimizer::iterate() {
   }
 
   // Keep increasing lambda until we make make progress
+  bool stepRejected = false;
   while (true) {
 
+    // After a rejected step, the next lambdas can be tried concurrently
+    if (stepRejected && params_.parallelLambdaTrials > 1) {
+      if (tryLambdasInParallel(*linear))
+        break;
+      continue;
+    }
+
 #ifdef GTSAM_USING_NEW_BOOST_TIMERS
     boost::timer::cpu_timer lamda_iteration_timer;
     lamda_iteration_timer.start();
@@ -312,7 +329,7 @@ void LevenbergMarquardtOptimizer::iterate() {
         gttic(compute_error);
         if (lmVerbosity >= LevenbergMarquardtParams::TRYLAMBDA)
           cout << "calculating error:" << endl;
-        newError = graph_.error(newValues);
+        newError = graph_.error(newValues, params_.errorGrainSize);
         gttoc(compute_error);
 
         if (lmVerbosity >= LevenbergMarquardtParams::TRYLAMBDA)
@@ -379,6 +396,7 @@ void LevenbergMarquardtOptimizer::iterate() {
               "cannot decrease error with maximum lambda" << endl;
         break;
       }
+      stepRejected = true;
     } else { // the change in the cost is very small and it is not worth trying bigger lambdas
       writeLogFile(state_.error);
       if (lmVerbosity >= LevenbergMarquardtParams::TRYLAMBDA)
@@ -391,6 +409,164 @@ void LevenbergMarquardtOptimizer::iterate() {
   ++state_.iterations;
 }
 
+/* ************************************************************************* */
+struct LevenbergMarquardtOptimizer::LambdaTrial {
+  double lambda; ///< The damping of this trial
+  double lambdaFactor; ///< The lambda factor of the parameters when lambda is tried
+  GaussianFactorGraph::shared_ptr damped; ///< The damped system for lambda
+  bool solved; ///< Whether the damped system could be solved
+  bool successful; ///< Whether the step decreases the error with enough model fidelity
+  bool stopSearching; ///< Whether the cost change is too small to try larger lambdas
+  double newError, costChange, modelFidelity;
+  Values newValues;
+
+  LambdaTrial() :
+      lambda(0.0), lambdaFactor(0.0), solved(false), successful(false), stopSearching(false),
+      newError(numeric_limits<double>::infinity()), costChange(0.0), modelFidelity(0.0) {
+  }
+};
+
+#ifdef GTSAM_USE_TBB
+/* ************************************************************************* */
+struct LevenbergMarquardtOptimizer::SolveTrials {
+  const LevenbergMarquardtOptimizer& optimizer_;
+  const GaussianFactorGraph& linear_;
+  std::vector<LambdaTrial>& trials_;
+
+  SolveTrials(const LevenbergMarquardtOptimizer& optimizer, const GaussianFactorGraph& linear,
+      std::vector<LambdaTrial>& trials) :
+      optimizer_(optimizer), linear_(linear), trials_(trials) {
+  }
+
+  void operator()(const tbb::blocked_range<size_t>& range) const {
+    for (size_t k = range.begin(); k != range.end(); ++k)
+      optimizer_.tryLambda(linear_, trials_[k]);
+  }
+};
+#endif
+
+/* ************************************************************************* */
+void LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
+    LambdaTrial& trial) const {
+  VectorValues delta;
+  try {
+    delta = solve(*trial.damped, state_.values, params_);
+  } catch (const IndeterminantLinearSystemException& e) {
+    return;
+  }
+  trial.solved = true;
+
+  // Same acceptance test as the sequential search in iterate()
+  const double linearizedCostChange = state_.error - linear.error(delta);
+  if (linearizedCostChange < 0)
+    return;
+  trial.newValues = state_.values.retract(delta);
+  trial.newError = graph_.error(trial.newValues, params_.errorGrainSize);
+  trial.costChange = state_.error - trial.newError;
+  if (linearizedCostChange > 1e-20) {
+    trial.modelFidelity = trial.costChange / linearizedCostChange;
+    trial.successful = trial.modelFidelity > params_.minModelFidelity;
+  }
+  trial.stopSearching = fabs(trial.costChange) < params_.relativeErrorTol * state_.error;
+}
+
+/* ************************************************************************* */
+bool LevenbergMarquardtOptimizer::tryLambdasInParallel(const GaussianFactorGraph& linear) {
+
+  gttic(parallel_lambda_trials);
+  const LevenbergMarquardtParams::VerbosityLM lmVerbosity = params_.verbosityLM;
+
+#ifdef GTSAM_USING_NEW_BOOST_TIMERS
+  boost::timer::cpu_timer lamda_iteration_timer;
+  lamda_iteration_timer.start();
+#else
+  boost::timer lamda_iteration_timer;
+  lamda_iteration_timer.restart();
+#endif
+
+  // Build the damped systems for the lambdas the sequential search would try next, which leaves
+  // the state as if all of them failed
+  std::vector<LambdaTrial> trials;
+  trials.reserve(params_.parallelLambdaTrials);
+  while (trials.size() < params_.parallelLambdaTrials) {
+    if (lmVerbosity >= LevenbergMarquardtParams::TRYLAMBDA)
+      cout << "trying lambda = " << state_.lambda << endl;
+    trials.push_back(LambdaTrial());
+    trials.back().lambda = state_.lambda;
+    trials.back().lambdaFactor = params_.lambdaFactor;
+    trials.back().damped = buildDampedSystem(linear);
+    increaseLambda();
+    if (state_.lambda >= params_.lambdaUpperBound)
+      break;
+  }
+
+  // The damped systems only differ in their priors, so they share the linearization and one
+  // symbolic elimination, and are solved concurrently
+  bool solvedConcurrently = false;
+#ifdef GTSAM_USE_TBB
+  if (prepareSolve(*trials.front().damped, params_)) {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, trials.size(), 1),
+        SolveTrials(*this, linear, trials));
+    solvedConcurrently = true;
+  }
+#endif
+  if (!solvedConcurrently) {
+    for (size_t k = 0; k < trials.size(); ++k)
+      tryLambda(linear, trials[k]);
+  }
+
+#ifdef GTSAM_USING_NEW_BOOST_TIMERS
+  const double iterationTime = 1e-9 * lamda_iteration_timer.elapsed().wall;
+#else
+  const double iterationTime = lamda_iteration_timer.elapsed();
+#endif
+
+  // Pick the successful step with the lowest error
+  size_t best = trials.size();
+  bool stopSearchingLambda = false;
+  for (size_t k = 0; k < trials.size(); ++k) {
+    const LambdaTrial& trial = trials[k];
+    if (lmVerbosity >= LevenbergMarquardtParams::TRYLAMBDA)
+      cout << "lambda = " << trial.lambda << ": new (tentative) error (" << trial.newError
+          << ") modelFidelity: " << trial.modelFidelity << endl;
+    if (lmVerbosity == LevenbergMarquardtParams::SUMMARY)
+      cout << boost::format("% 4d % 8e   % 3.2e   % 3.2e  % 4d   % 3.2e") %
+                  state_.iterations % trial.newError % trial.costChange % trial.lambda %
+                  trial.solved % iterationTime << endl;
+    if (trial.successful && (best == trials.size() || trial.newError < trials[best].newError))
+      best = k;
+    stopSearchingLambda = stopSearchingLambda || trial.stopSearching;
+  }
+  state_.totalNumberInnerIterations += trials.size();
+
+  if (best < trials.size()) {
+    // Continue from the accepted lambda, as if the search had stopped there
+    LambdaTrial& trial = trials[best];
+    state_.values.swap(trial.newValues);
+    state_.error = trial.newError;
+    state_.lambda = trial.lambda;
+    params_.lambdaFactor = trial.lambdaFactor;
+    decreaseLambda(trial.modelFidelity);
+    writeLogFile(state_.error);
+    return true;
+  }
+
+  writeLogFile(state_.error);
+  if (stopSearchingLambda) {
+    if (lmVerbosity >= LevenbergMarquardtParams::TRYLAMBDA)
+      cout << "Levenberg-Marquardt: stopping as relative cost reduction is small" << endl;
+    return true;
+  }
+  if (state_.lambda >= params_.lambdaUpperBound) {
+    if (params_.verbosity >= NonlinearOptimizerParams::TERMINATION ||
+        lmVerbosity == LevenbergMarquardtParams::SUMMARY)
+      cout << "Warning:  Levenberg-Marquardt giving up because "
+          "cannot decrease error with maximum lambda" << endl;
+    return true;
+  }
+  return false;
+}
+
 /* ************************************************************************* */
 LevenbergMarquardtParams LevenbergMarquardtOptimizer::ensureHasOrdering(
     LevenbergMarquardtParams params, const NonlinearFactorGraph& graph) const {
@@ -57,12 +57,14 @@ public:
   bool useFixedLambdaFactor; ///< if true applies constant increase (or decrease) to lambda according to lambdaFactor
   double minDiagonal; ///< when using diagonal damping saturates the minimum diagonal entries (default: 1e-6)
   double maxDiagonal; ///< when using diagonal damping saturates the maximum diagonal entries (default: 1e32)
+  size_t parallelLambdaTrials; ///< after a rejected step, the number of increasing lambdas solved concurrently, sharing the linearization (default: 1, one at a time)
 
   LevenbergMarquardtParams()
       : verbosityLM(SILENT),
         diagonalDamping(false),
         minDiagonal(1e-6),
-        maxDiagonal(1e32) {
+        maxDiagonal(1e32),
+        parallelLambdaTrials(1) {
     SetLegacyDefaults(this);
   }
 
@@ -120,6 +122,7 @@ public:
   double getlambdaLowerBound() const { return lambdaLowerBound; }
   double getlambdaUpperBound() const { return lambdaUpperBound; }
   std::string getLogFile() const { return logFile; }
+  size_t getParallelLambdaTrials() const { return parallelLambdaTrials; }
   std::string getVerbosityLM() const { return verbosityLMTranslator(verbosityLM);}
   void setDiagonalDamping(bool flag) { diagonalDamping = flag; }
   void setlambdaFactor(double value) { lambdaFactor = value; }
@@ -127,6 +130,7 @@ public:
   void setlambdaLowerBound(double value) { lambdaLowerBound = value; }
   void setlambdaUpperBound(double value) { lambdaUpperBound = value; }
   void setLogFile(const std::string& s) { logFile = s; }
+  void setParallelLambdaTrials(size_t value) { parallelLambdaTrials = value; }
   void setUseFixedLambdaFactor(bool flag) { useFixedLambdaFactor = flag;}
   void setVerbosityLM(const std::string& s) { verbosityLM = verbosityLMTranslator(s);}
   // @}
@@ -157,7 +161,8 @@ protected:
   LevenbergMarquardtState(const NonlinearFactorGraph& graph,
       const Values& initialValues, const LevenbergMarquardtParams& params,
       unsigned int iterations = 0) :
-      NonlinearOptimizerState(graph, initialValues, iterations), lambda(
+      NonlinearOptimizerState(graph, initialValues, iterations,
+          params.errorGrainSize), lambda(
           params.lambdaInitial), totalNumberInnerIterations(0),reuseDiagonal(false) {
     initTime();
   }
@@ -305,6 +310,18 @@ protected:
 
   /** linearize, can  be overwritten */
   virtual GaussianFactorGraph::shared_ptr linearize() const;
+
+private:
+  struct LambdaTrial; ///< The damped system for one lambda and the step it gives
+  struct SolveTrials; ///< Functor solving a range of trials, for tbb::parallel_for
+
+  /** Solve the damped system of \c trial and evaluate the step, without changing the state */
+  void tryLambda(const GaussianFactorGraph& linear, LambdaTrial& trial) const;
+
+  /** After a rejected step, try the next LevenbergMarquardtParams::parallelLambdaTrials lambdas
+   * concurrently and accept the successful step with the lowest error.  Returns whether the
+   * search for lambda is over, like the sequential search in iterate(). */
+  bool tryLambdasInParallel(const GaussianFactorGraph& linear);
 };
 
 }
@@ -33,6 +33,15 @@ LinearContainerFactor::LinearContainerFactor(const GaussianFactor::shared_ptr& f
 : NonlinearFactor(factor->keys()), factor_(factor), linearizationPoint_(linearizationPoint) {
 }
 
+/* ************************************************************************* */
+boost::shared_ptr<LinearContainerFactor> LinearContainerFactor::Share(
+    const GaussianFactor::shared_ptr& factor, const Values& linearizationPoint) {
+  boost::shared_ptr<LinearContainerFactor> result(
+      new LinearContainerFactor(factor, boost::optional<Values>()));
+  result->initializeLinearizationPoint(linearizationPoint);
+  return result;
+}
+
 /* ************************************************************************* */
 LinearContainerFactor::LinearContainerFactor(
     const JacobianFactor& factor, const Values& linearizationPoint)
@@ -103,34 +112,71 @@ size_t LinearContainerFactor::dim() const {
 }
 
 /* ************************************************************************* */
-GaussianFactor::shared_ptr LinearContainerFactor::linearize(const Values& c) const {
-  // Clone factor and update as necessary
-  GaussianFactor::shared_ptr linFactor = factor_->clone();
-  if (!hasLinearizationPoint())
-    return linFactor;
-
-  // Extract subset of values
-  Values subsetC;
-  BOOST_FOREACH(const gtsam::Key& key, this->keys())
-    subsetC.insert(key, c.at(key));
+boost::shared_ptr<const LinearContainerFactor::Relinearization> LinearContainerFactor::relinearize(
+    const Values& c) const {
+  // Reuse the last relinearization if the values of the keys are the same
+  boost::shared_ptr<const Relinearization> cached = boost::atomic_load(&relinearization_);
+  if (cached) {
+    bool same = true;
+    BOOST_FOREACH(const gtsam::Key& key, this->keys()) {
+      if (!cached->point.at(key).equals_(c.at(key), 0.0)) {
+        same = false;
+        break;
+      }
+    }
+    if (same)
+      return cached;
+  }
 
-  // Determine delta between linearization points using new ordering
-  VectorValues delta = linearizationPoint_->localCoordinates(subsetC);
+  // Determine delta between linearization points, and extract subset of values
+  boost::shared_ptr<Relinearization> result = boost::make_shared<Relinearization>();
+  VectorValues delta;
+  BOOST_FOREACH(const gtsam::Key& key, this->keys()) {
+    const Value& value = c.at(key);
+    result->point.insert(key, value);
+    delta.insert(key, linearizationPoint_->at(key).localCoordinates_(value));
+  }
 
   // Apply changes due to relinearization
+  result->factor = factor_->clone();
   if (isJacobian()) {
-    JacobianFactor::shared_ptr jacFactor = boost::dynamic_pointer_cast<JacobianFactor>(linFactor);
+    JacobianFactor::shared_ptr jacFactor = boost::dynamic_pointer_cast<JacobianFactor>(result->factor);
     jacFactor->getb() = -jacFactor->unweighted_error(delta);
   } else {
-    HessianFactor::shared_ptr hesFactor = boost::dynamic_pointer_cast<HessianFactor>(linFactor);
-    SymmetricBlockMatrix::constBlock Gview = hesFactor->matrixObject().range(0, hesFactor->size(), 0, hesFactor->size());
+    HessianFactor::shared_ptr hesFactor = boost::dynamic_pointer_cast<HessianFactor>(result->factor);
+    SymmetricBlockMatrix::Block Gview = hesFactor->matrixObject().range(0, hesFactor->size(), 0, hesFactor->size());
     Vector deltaVector = delta.vector(keys());
     Vector G_delta = Gview.selfadjointView() * deltaVector;
     hesFactor->constantTerm() += deltaVector.dot(G_delta) - 2.0 * deltaVector.dot(hesFactor->linearTerm());
     hesFactor->linearTerm() -= G_delta;
   }
 
-  return linFactor;
+  boost::shared_ptr<const Relinearization> relinearization = result;
+  boost::atomic_store(&relinearization_, relinearization);
+  return relinearization;
+}
+
+/* ************************************************************************* */
+GaussianFactor::shared_ptr LinearContainerFactor::linearize(const Values& c) const {
+  if (!hasLinearizationPoint())
+    return factor_->clone();
+  return relinearize(c)->factor->clone();
+}
+
+/* ************************************************************************* */
+bool LinearContainerFactor::linearizeInto(const Values& c, GaussianFactor& factor) const {
+  JacobianFactor* jacobian = dynamic_cast<JacobianFactor*>(&factor);
+  HessianFactor* hessian = dynamic_cast<HessianFactor*>(&factor);
+  if (isJacobian() ? !jacobian : !hessian)
+    return false;
+
+  // Assignment reuses the storage of factor if the shapes agree
+  const GaussianFactor& source = hasLinearizationPoint() ? *relinearize(c)->factor : *factor_;
+  if (jacobian)
+    *jacobian = static_cast<const JacobianFactor&>(source);
+  else
+    *hessian = static_cast<const HessianFactor&>(source);
+  return true;
 }
 
 /* ************************************************************************* */
@@ -30,6 +30,16 @@ protected:
   GaussianFactor::shared_ptr factor_;
   boost::optional<Values> linearizationPoint_;
 
+  /// The stored factor shifted to the values of its keys in point
+  struct Relinearization {
+    Values point;
+    GaussianFactor::shared_ptr factor;
+  };
+
+  /// The last relinearization, reused while the values of the keys do not change.  It is never
+  /// modified once created, and is replaced atomically, so concurrent linearizations are safe.
+  mutable boost::shared_ptr<const Relinearization> relinearization_;
+
   /** Default constructor - necessary for serialization */
   LinearContainerFactor() {}
 
@@ -47,6 +57,14 @@ public:
   /** Constructor from shared_ptr */
   LinearContainerFactor(const GaussianFactor::shared_ptr& factor, const Values& linearizationPoint = Values());
 
+  /**
+   * Wraps a linear factor without cloning it, for factors that are never modified afterwards,
+   * such as the cached factors of a Bayes tree or freshly eliminated marginals.  The factor is
+   * then shared between the owner and this container.
+   */
+  static boost::shared_ptr<LinearContainerFactor> Share(const GaussianFactor::shared_ptr& factor,
+      const Values& linearizationPoint = Values());
+
   // Access
 
   const GaussianFactor::shared_ptr& factor() const { return factor_; }
@@ -95,6 +113,15 @@ public:
    */
   GaussianFactor::shared_ptr linearize(const Values& c) const;
 
+  /**
+   * Linearize like linearize, but into an existing factor, e.g. the result of a previous
+   * linearization.  The relinearized factor is cached until the values of the keys change, and
+   * is copied into \c factor, which allocates nothing if \c factor already has the same shape.
+   * Returns false, and leaves \c factor unchanged, if \c factor is not of the same type
+   * (JacobianFactor or HessianFactor) as the stored factor.
+   */
+  virtual bool linearizeInto(const Values& c, GaussianFactor& factor) const;
+
   /**
    * Creates an anti-factor directly
    */
@@ -141,6 +168,9 @@ public:
 protected:
   void initializeLinearizationPoint(const Values& linearizationPoint);
 
+  /// The stored factor relinearized at c, computed only when the values of the keys changed
+  boost::shared_ptr<const Relinearization> relinearize(const Values& c) const;
+
 private:
 
   /** Serialization function */
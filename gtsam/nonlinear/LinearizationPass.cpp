@@ -0,0 +1,83 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    LinearizationPass.cpp
+ * @brief   Scope in which shareable expressions are evaluated only once
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/nonlinear/LinearizationPass.h>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+#include <map>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+// The outermost pass, read without locking when expressions are evaluated
+boost::mutex passMutex;
+size_t passDepth = 0; // guarded by passMutex
+boost::atomic<const Values*> passValues(0);
+boost::atomic<size_t> passNumber(0);
+
+// The entries computed by one thread, belonging to the pass with the given number
+struct ThreadCache {
+  size_t pass;
+  map<const void*, boost::shared_ptr<internal::SharedExpressionEntry> > entries;
+  ThreadCache() : pass(0) {}
+};
+
+boost::thread_specific_ptr<ThreadCache> threadCache;
+
+}
+
+/* ************************************************************************* */
+LinearizationPass::LinearizationPass(const Values& values) {
+  boost::mutex::scoped_lock lock(passMutex);
+  if (passDepth++ == 0) {
+    ++passNumber;
+    passValues = &values;
+  }
+}
+
+/* ************************************************************************* */
+LinearizationPass::~LinearizationPass() {
+  boost::mutex::scoped_lock lock(passMutex);
+  if (--passDepth == 0)
+    passValues = 0;
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<internal::SharedExpressionEntry>* internal::sharedExpressionEntry(
+    const void* node, const Values& values) {
+  if (passValues.load() != &values)
+    return 0;
+  ThreadCache* cache = threadCache.get();
+  if (!cache) {
+    cache = new ThreadCache;
+    threadCache.reset(cache);
+  }
+  const size_t pass = passNumber.load();
+  if (cache->pass != pass) {
+    cache->entries.clear();
+    cache->pass = pass;
+  }
+  return &cache->entries[node];
+}
+
+}
@@ -0,0 +1,64 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    LinearizationPass.h
+ * @brief   Scope in which shareable expressions are evaluated only once
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/dllexport.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace gtsam {
+
+  class Values;
+
+  /**
+   * While a LinearizationPass over \c values is alive, the value and Jacobians of every shareable
+   * sub-expression (see Expression::shareable) evaluated at \c values are computed once per thread
+   * and reused by all factors referencing it.  NonlinearFactorGraph::linearize and relinearize,
+   * and ExpressionFactorGraph::linearizeBatched, each run in a LinearizationPass.
+   *
+   * Passes nest, and only the outermost one is effective: expressions evaluated at other Values
+   * while it is alive, e.g. by a nested pass from another thread, are not shared.  The cached
+   * entries are dropped by the next pass, so \c values must not change while the pass is alive.
+   *
+   * @addtogroup nonlinear */
+  class GTSAM_EXPORT LinearizationPass : boost::noncopyable
+  {
+  public:
+    explicit LinearizationPass(const Values& values);
+    ~LinearizationPass();
+  };
+
+  namespace internal {
+
+    /// Base class of the entries of the shareable expression cache
+    struct GTSAM_EXPORT SharedExpressionEntry {
+      virtual ~SharedExpressionEntry() {}
+    };
+
+    /**
+     * The entry of \c node in the cache of the calling thread, empty if it was not computed yet,
+     * or null if no LinearizationPass over \c values is alive.  The entry lives until the next
+     * pass starts.
+     */
+    GTSAM_EXPORT boost::shared_ptr<SharedExpressionEntry>* sharedExpressionEntry(
+        const void* node, const Values& values);
+
+  }
+
+}
@@ -17,6 +17,7 @@
  */
 
 #include <gtsam/base/timing.h>
+#include <gtsam/base/treeTraversal-inst.h>
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/HessianFactor.h>
 #include <gtsam/nonlinear/Marginals.h>
@@ -73,6 +74,137 @@ Matrix Marginals::marginalInformation(Key variable) const {
   return marginalFactor->information();
 }
 
+/* ************************************************************************* */
+namespace {
+
+// Joint covariance of the frontal and separator variables of a clique
+struct CliqueCovariance {
+  FastMap<Key, std::pair<DenseIndex, DenseIndex> > blocks; // Offset and dimension of each key
+  Matrix covariance;
+};
+
+// Recover the joint covariance of a clique from that of its parent.  With the whitened
+// conditional R x_F + S x_S = d, x_F = R^-1 (d - S x_S), so with X = R^-1 S,
+// Cov(F,S) = -X Cov(S,S) and Cov(F,F) = R^-1 R^-T + X Cov(S,S) X'.
+// Either the marginals of the frontal variables or the blocks between each frontal variable and
+// the later variables of its clique are stored, into entries that already exist.
+struct CovarianceVisitor {
+  FastMap<Key, Matrix>* marginals;
+  FastMap<std::pair<Key, Key>, Matrix>* blocks;
+  CovarianceVisitor(FastMap<Key, Matrix>* _marginals,
+      FastMap<std::pair<Key, Key>, Matrix>* _blocks) :
+      marginals(_marginals), blocks(_blocks) {
+  }
+
+  CliqueCovariance operator()(const GaussianBayesTree::sharedClique& clique,
+      const CliqueCovariance& parent) {
+    const GaussianConditional& conditional = *clique->conditional();
+    Matrix R = conditional.get_R(), S = conditional.get_S();
+    if (conditional.get_model()) {
+      R = conditional.get_model()->Whiten(R);
+      S = conditional.get_model()->Whiten(S);
+    }
+    const DenseIndex nF = R.cols(), nS = S.cols();
+
+    // Gather the covariance of the separator from the parent
+    CliqueCovariance result;
+    DenseIndex offset = 0;
+    for (GaussianConditional::const_iterator key = conditional.begin(); key != conditional.end();
+        ++key) {
+      const DenseIndex dim = conditional.getDim(key);
+      result.blocks.insert(std::make_pair(*key, std::make_pair(offset, dim)));
+      offset += dim;
+    }
+    Matrix separator(nS, nS);
+    for (GaussianConditional::const_iterator i = conditional.beginParents();
+        i != conditional.endParents(); ++i) {
+      const std::pair<DenseIndex, DenseIndex>& to_i = result.blocks.at(*i);
+      const std::pair<DenseIndex, DenseIndex>& from_i = parent.blocks.at(*i);
+      for (GaussianConditional::const_iterator j = conditional.beginParents();
+          j != conditional.endParents(); ++j) {
+        const std::pair<DenseIndex, DenseIndex>& to_j = result.blocks.at(*j);
+        const std::pair<DenseIndex, DenseIndex>& from_j = parent.blocks.at(*j);
+        separator.block(to_i.first - nF, to_j.first - nF, to_i.second, to_j.second) =
+            parent.covariance.block(from_i.first, from_j.first, from_i.second, from_j.second);
+      }
+    }
+
+    // Joint covariance of the frontal and separator variables
+    const Matrix Rinv = R.triangularView<Eigen::Upper>().solve(Matrix::Identity(nF, nF));
+    const Matrix X = Rinv * S;
+    result.covariance.resize(nF + nS, nF + nS);
+    result.covariance.bottomRightCorner(nS, nS) = separator;
+    result.covariance.topRightCorner(nF, nS) = -X * separator;
+    result.covariance.bottomLeftCorner(nS, nF) = result.covariance.topRightCorner(nF, nS).transpose();
+    result.covariance.topLeftCorner(nF, nF) = Rinv * Rinv.transpose()
+        - result.covariance.topRightCorner(nF, nS) * X.transpose();
+
+    for (GaussianConditional::const_iterator i = conditional.beginFrontals();
+        i != conditional.endFrontals(); ++i) {
+      const std::pair<DenseIndex, DenseIndex>& block_i = result.blocks.at(*i);
+      if (marginals)
+        marginals->find(*i)->second = result.covariance.block(block_i.first, block_i.first,
+            block_i.second, block_i.second);
+      if (blocks) {
+        for (GaussianConditional::const_iterator j = i; j != conditional.end(); ++j) {
+          const std::pair<DenseIndex, DenseIndex>& block_j = result.blocks.at(*j);
+          if (*i <= *j)
+            blocks->find(std::make_pair(*i, *j))->second = result.covariance.block(
+                block_i.first, block_j.first, block_i.second, block_j.second);
+          else
+            blocks->find(std::make_pair(*j, *i))->second = result.covariance.block(
+                block_j.first, block_i.first, block_j.second, block_i.second);
+        }
+      }
+    }
+    return result;
+  }
+};
+
+}
+
+/* ************************************************************************* */
+FastMap<Key, Matrix> Marginals::marginalCovariances() const {
+  gttic(marginalCovariances);
+
+  // Insert all keys first, so the parallel traversal only writes existing entries
+  FastMap<Key, Matrix> marginals;
+  BOOST_FOREACH(const GaussianBayesTree::Nodes::value_type& node, bayesTree_.nodes())
+    marginals.insert(std::make_pair(node.first, Matrix()));
+
+  CliqueCovariance rootData;
+  CovarianceVisitor visitorPre(&marginals, 0);
+  treeTraversal::no_op visitorPost;
+  treeTraversal::DepthFirstForestParallel(bayesTree_, rootData, visitorPre, visitorPost);
+  return marginals;
+}
+
+/* ************************************************************************* */
+FastMap<std::pair<Key, Key>, Matrix> Marginals::sparseInverse() const {
+  gttic(sparseInverse);
+
+  // Insert the blocks of every clique first, so the parallel traversal only writes existing
+  // entries.  Each clique is reached through its first frontal variable.
+  FastMap<std::pair<Key, Key>, Matrix> blocks;
+  BOOST_FOREACH(const GaussianBayesTree::Nodes::value_type& node, bayesTree_.nodes()) {
+    const GaussianConditional& conditional = *node.second->conditional();
+    if (conditional.front() != node.first)
+      continue;
+    for (GaussianConditional::const_iterator i = conditional.beginFrontals();
+        i != conditional.endFrontals(); ++i) {
+      for (GaussianConditional::const_iterator j = i; j != conditional.end(); ++j)
+        blocks.insert(std::make_pair(std::make_pair(std::min(*i, *j), std::max(*i, *j)),
+            Matrix()));
+    }
+  }
+
+  CliqueCovariance rootData;
+  CovarianceVisitor visitorPre(0, &blocks);
+  treeTraversal::no_op visitorPost;
+  treeTraversal::DepthFirstForestParallel(bayesTree_, rootData, visitorPre, visitorPost);
+  return blocks;
+}
+
 /* ************************************************************************* */
 JointMarginal Marginals::jointMarginalCovariance(const std::vector<Key>& variables) const {
   JointMarginal info = jointMarginalInformation(variables);
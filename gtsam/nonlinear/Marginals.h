@@ -66,6 +66,19 @@ public:
    * matrix. */
   Matrix marginalInformation(Key variable) const;
 
+  /** Compute the marginal covariances of all variables at once.  Instead of computing a
+   * shortcut for each variable, as marginalCovariance does, this recovers the joint covariance
+   * of every clique from that of its parent, in one top-down pass over the Bayes tree that runs
+   * in parallel over subtrees when TBB is enabled. */
+  FastMap<Key, Matrix> marginalCovariances() const;
+
+  /** Compute the blocks of the covariance matrix on the sparsity pattern of the Bayes tree,
+   * which includes the non-zeros of the information matrix: the block Cov(x_i, x_j) is
+   * returned, under the key pair (i, j) with i <= j, for every pair of variables that appear
+   * together in a clique.  This is the Takahashi recursion, run in the same top-down pass as
+   * marginalCovariances, and costs about as much as the factorization. */
+  FastMap<std::pair<Key, Key>, Matrix> sparseInverse() const;
+
   /** Compute the joint marginal covariance of several variables */
   JointMarginal jointMarginalCovariance(const std::vector<Key>& variables) const;
 
@@ -81,7 +94,7 @@ class GTSAM_EXPORT JointMarginal {
 protected:
   SymmetricBlockMatrix blockMatrix_;
   std::vector<size_t> keys_;
-  FastMap<Key, size_t> indices_;
+  Ordering::InvertedMap indices_;
 
 public:
   /** A block view of the joint marginal - this stores a reference to the
@@ -18,7 +18,6 @@
 
 #include <gtsam/nonlinear/NonlinearConjugateGradientOptimizer.h>
 #include <gtsam/nonlinear/Values.h>
-#include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/VectorValues.h>
 
 #include <cmath>
@@ -27,27 +26,14 @@ using namespace std;
 
 namespace gtsam {
 
-/**
- * @brief Return the gradient vector of a nonlinear factor graph
- * @param nfg the graph
- * @param values a linearization point
- * Can be moved to NonlinearFactorGraph.h if desired
- */
-static VectorValues gradientInPlace(const NonlinearFactorGraph &nfg,
-    const Values &values) {
-  // Linearize graph
-  GaussianFactorGraph::shared_ptr linear = nfg.linearize(values);
-  return linear->gradientAtZero();
-}
-
 double NonlinearConjugateGradientOptimizer::System::error(
     const State &state) const {
-  return graph_.error(state);
+  return graph_.error(state, grainSize_);
 }
 
 NonlinearConjugateGradientOptimizer::System::Gradient NonlinearConjugateGradientOptimizer::System::gradient(
     const State &state) const {
-  return gradientInPlace(graph_, state);
+  return graph_.gradient(state, grainSize_);
 }
 
 NonlinearConjugateGradientOptimizer::System::State NonlinearConjugateGradientOptimizer::System::advance(
@@ -60,17 +46,17 @@ NonlinearConjugateGradientOptimizer::System::State NonlinearConjugateGradientOpt
 void NonlinearConjugateGradientOptimizer::iterate() {
   int dummy;
   boost::tie(state_.values, dummy) = nonlinearConjugateGradient<System, Values>(
-      System(graph_), state_.values, params_, true /* single iterations */);
+      System(graph_, params_.errorGrainSize), state_.values, params_, true /* single iterations */);
   ++state_.iterations;
-  state_.error = graph_.error(state_.values);
+  state_.error = graph_.error(state_.values, params_.errorGrainSize);
 }
 
 const Values& NonlinearConjugateGradientOptimizer::optimize() {
   // Optimize until convergence
-  System system(graph_);
+  System system(graph_, params_.errorGrainSize);
   boost::tie(state_.values, state_.iterations) = //
       nonlinearConjugateGradient(system, state_.values, params_, false);
-  state_.error = graph_.error(state_.values);
+  state_.error = graph_.error(state_.values, params_.errorGrainSize);
   return state_.values;
 }
 
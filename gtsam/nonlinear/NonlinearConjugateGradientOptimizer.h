@@ -45,10 +45,11 @@ class GTSAM_EXPORT NonlinearConjugateGradientOptimizer: public NonlinearOptimize
 
   protected:
     const NonlinearFactorGraph &graph_;
+    size_t grainSize_; ///< Factors per chunk when evaluating the error and gradient in parallel
 
   public:
-    System(const NonlinearFactorGraph &graph) :
-        graph_(graph) {
+    System(const NonlinearFactorGraph &graph, size_t grainSize = 0) :
+        graph_(graph), grainSize_(grainSize) {
     }
     double error(const State &state) const;
     Gradient gradient(const State &state) const;
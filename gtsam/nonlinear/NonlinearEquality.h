@@ -167,6 +167,11 @@ public:
         new JacobianFactor(this->key(), A, b, model));
   }
 
+  /// Not supported, as linearize is over-written
+  virtual bool linearizeInto(const Values& /*x*/, GaussianFactor& /*factor*/) const {
+    return false;
+  }
+
   /// @return a deep copy of this factor
   virtual gtsam::NonlinearFactor::shared_ptr clone() const {
     return boost::static_pointer_cast<gtsam::NonlinearFactor>(
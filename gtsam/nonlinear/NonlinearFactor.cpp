@@ -37,6 +37,13 @@ bool NonlinearFactor::equals(const NonlinearFactor& f, double tol) const {
   return Base::equals(f);
 }
 
+/* ************************************************************************* */
+void NonlinearFactor::addGradient(const Values& c, VectorValues& g) const {
+  boost::shared_ptr<GaussianFactor> linear = linearize(c);
+  if (linear)
+    g.addInPlace_(linear->gradientAtZero());
+}
+
 /* ************************************************************************* */
 NonlinearFactor::shared_ptr NonlinearFactor::rekey(
     const std::map<Key, Key>& rekey_mapping) const {
@@ -115,14 +122,9 @@ boost::shared_ptr<GaussianFactor> NoiseModelFactor::linearize(
   if (!active(x))
     return boost::shared_ptr<JacobianFactor>();
 
-  // Call evaluate error to get Jacobians and RHS vector b
   std::vector<Matrix> A(size());
-  Vector b = -unwhitenedError(x, A);
-  check(noiseModel_, b.size());
-
-  // Whiten the corresponding system now
-  if (noiseModel_)
-    noiseModel_->WhitenSystem(A, b);
+  Vector b;
+  const SharedDiagonal model = whitenedSystem(x, A, b);
 
   // Fill in terms, needed to create JacobianFactor below
   std::vector<std::pair<Key, Matrix> > terms(size());
@@ -131,14 +133,79 @@ boost::shared_ptr<GaussianFactor> NoiseModelFactor::linearize(
     terms[j].second.swap(A[j]);
   }
 
+  return GaussianFactor::shared_ptr(new JacobianFactor(terms, b, model));
+}
+
+/* ************************************************************************* */
+bool NoiseModelFactor::linearizeInto(const Values& x, GaussianFactor& factor) const {
+
+  JacobianFactor* jacobian = dynamic_cast<JacobianFactor*>(&factor);
+  if (!jacobian || jacobian->keys() != keys() || !active(x))
+    return false;
+
+  std::vector<Matrix> A(size());
+  Vector b;
+  const SharedDiagonal model = whitenedSystem(x, A, b);
+
+  // Only overwrite a factor of the same shape, so that its storage is reused as is
+  VerticalBlockMatrix& Ab = jacobian->matrixObject();
+  if (Ab.rowStart() != 0 || Ab.firstBlock() != 0 || Ab.rows() != b.size()
+      || Ab.matrix().rows() != b.size()
+      || Ab.nBlocks() != static_cast<DenseIndex>(size()) + 1)
+    return false;
+  for (size_t j = 0; j < size(); ++j)
+    if (Ab(j).cols() != A[j].cols())
+      return false;
+
+  for (size_t j = 0; j < size(); ++j)
+    Ab(j) = A[j];
+  Ab(size()).col(0) = b;
+  jacobian->get_model() = model;
+  return true;
+}
+
+/* ************************************************************************* */
+void NoiseModelFactor::addGradient(const Values& x, VectorValues& g) const {
+
+  // Only contribute if the factor is active
+  if (!active(x))
+    return;
+
+  // A constrained noise model stays in the linear factor, which has to apply it
+  if (noiseModel_ && noiseModel_->isConstrained()) {
+    Base::addGradient(x, g);
+    return;
+  }
+
+  std::vector<Matrix> A(size());
+  Vector b;
+  whitenedSystem(x, A, b);
+  for (size_t j = 0; j < size(); ++j) {
+    const Vector gj = -A[j].transpose() * b;
+    std::pair<VectorValues::iterator, bool> it = g.tryInsert(keys()[j], gj);
+    if (!it.second)
+      it.first->second += gj;
+  }
+}
+
+/* ************************************************************************* */
+SharedDiagonal NoiseModelFactor::whitenedSystem(const Values& x,
+    std::vector<Matrix>& A, Vector& b) const {
+
+  // Call evaluate error to get Jacobians and RHS vector b
+  b = -unwhitenedError(x, A);
+  check(noiseModel_, b.size());
+
+  // Whiten the corresponding system now
+  if (noiseModel_)
+    noiseModel_->WhitenSystem(A, b);
+
   // TODO pass unwhitened + noise model to Gaussian factor
   using noiseModel::Constrained;
   if (noiseModel_ && noiseModel_->isConstrained())
-    return GaussianFactor::shared_ptr(
-        new JacobianFactor(terms, b,
-            boost::static_pointer_cast<Constrained>(noiseModel_)->unit()));
+    return boost::static_pointer_cast<Constrained>(noiseModel_)->unit();
   else
-    return GaussianFactor::shared_ptr(new JacobianFactor(terms, b));
+    return SharedDiagonal();
 }
 
 /* ************************************************************************* */
@@ -23,7 +23,10 @@
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/linear/NoiseModel.h>
 #include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/UnaryJacobianFactor.h>
+#include <gtsam/linear/BinaryJacobianFactor.h>
 #include <gtsam/inference/Factor.h>
+#include <gtsam/base/MemoryUsage.h>
 #include <gtsam/base/OptionalJacobian.h>
 
 #include <boost/serialization/base_object.hpp>
@@ -102,6 +105,15 @@ public:
   /** get the dimension of the factor (number of rows on linearization) */
   virtual size_t dim() const = 0;
 
+  /**
+   * Return the memory used by this factor in bytes, without its noise model, which may be
+   * shared with other factors.  The default counts this base class and the keys, derived
+   * classes holding large data should override it.
+   */
+  virtual size_t memoryUsage() const {
+    return sizeof(NonlinearFactor) + heapBytes(keys());
+  }
+
   /**
    * Checks whether a factor should be used based on a set of values.
    * This is primarily used to implment inequality constraints that
@@ -118,6 +130,24 @@ public:
   virtual boost::shared_ptr<GaussianFactor>
   linearize(const Values& c) const = 0;
 
+  /**
+   * Linearize into an existing GaussianFactor, e.g. the result of a previous linearization,
+   * overwriting it in place so that no new factor is allocated.  Returns false, and leaves
+   * \c factor unchanged, if this is not possible, e.g. because \c factor does not have the
+   * type or shape of the linearization or because this factor is not active; call linearize()
+   * then.  By default this always returns false.
+   */
+  virtual bool linearizeInto(const Values& /*c*/, GaussianFactor& /*factor*/) const {
+    return false;
+  }
+
+  /**
+   * Add the gradient of the error at \c c, i.e. the gradient at zero of the linearized
+   * factor, to \c g.  By default this linearizes the factor, so override it where the
+   * gradient can be computed without building a GaussianFactor.
+   */
+  virtual void addGradient(const Values& c, VectorValues& g) const;
+
   /**
    * Creates a shared_ptr clone of the factor - needs to be specialized to allow
    * for subclasses
@@ -242,6 +272,29 @@ public:
    */
   boost::shared_ptr<GaussianFactor> linearize(const Values& x) const;
 
+  /**
+   * Linearize into a JacobianFactor with the keys, rows and block dimensions of the
+   * linearization at x, writing the whitened Jacobians and right-hand side into its storage.
+   * Subclasses that override linearize() so that it returns another factor also have to
+   * override this method.
+   */
+  virtual bool linearizeInto(const Values& x, GaussianFactor& factor) const;
+
+  /**
+   * Add the gradient \f$ -A^T b \f$ of the whitened linearization at x to \c g, without
+   * building a JacobianFactor
+   */
+  virtual void addGradient(const Values& x, VectorValues& g) const;
+
+protected:
+
+  /**
+   * Evaluate the whitened Jacobians A and right-hand side b of the linearization at x, as used
+   * by linearize.  Returns the noise model of the linear factor, which is only non-null for
+   * constrained noise models.
+   */
+  SharedDiagonal whitenedSystem(const Values& x, std::vector<Matrix>& A, Vector& b) const;
+
 private:
 
   /** Serialization function */
@@ -320,6 +373,20 @@ public:
   virtual Vector evaluateError(const X& x, boost::optional<Matrix&> H =
       boost::none) const = 0;
 
+  /**
+   * Linearize to a UnaryJacobianFactor with fixed-size math when X has a fixed dimension,
+   * and to a JacobianFactor otherwise.
+   */
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+    if (traits<X>::dimension == Eigen::Dynamic || !this->active(x))
+      return Base::linearize(x);
+    std::vector<Matrix> A(1);
+    Vector b;
+    const SharedDiagonal model = this->whitenedSystem(x, A, b);
+    return boost::make_shared<UnaryJacobianFactor<Eigen::Dynamic, traits<X>::dimension> >(
+        keys_[0], A[0], b, model);
+  }
+
 private:
 
   /** Serialization function */
@@ -375,8 +442,10 @@ public:
    * so must be implemented in the derived class. */
   virtual Vector unwhitenedError(const Values& x, boost::optional<std::vector<Matrix>&> H = boost::none) const {
     if(this->active(x)) {
-      const X1& x1 = x.at<X1>(keys_[0]);
-      const X2& x2 = x.at<X2>(keys_[1]);
+      const Value* values[2];
+      x.at(keys_, values);
+      const X1& x1 = Values::Cast<X1>(keys_[0], *values[0]);
+      const X2& x2 = Values::Cast<X2>(keys_[1], *values[1]);
       if(H) {
         return evaluateError(x1, x2, (*H)[0], (*H)[1]);
       } else {
@@ -396,6 +465,21 @@ public:
   evaluateError(const X1&, const X2&, boost::optional<Matrix&> H1 =
       boost::none, boost::optional<Matrix&> H2 = boost::none) const = 0;
 
+  /**
+   * Linearize to a BinaryJacobianFactor with fixed-size math when X1 and X2 have a fixed
+   * dimension, and to a JacobianFactor otherwise.
+   */
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+    if (traits<X1>::dimension == Eigen::Dynamic || traits<X2>::dimension == Eigen::Dynamic
+        || !this->active(x))
+      return Base::linearize(x);
+    std::vector<Matrix> A(2);
+    Vector b;
+    const SharedDiagonal model = this->whitenedSystem(x, A, b);
+    return boost::make_shared<BinaryJacobianFactor<Eigen::Dynamic, traits<X1>::dimension,
+        traits<X2>::dimension> >(keys_[0], A[0], keys_[1], A[1], b, model);
+  }
+
 private:
 
   /** Serialization function */
@@ -453,10 +537,15 @@ public:
    * so must be implemented in the derived class. */
   virtual Vector unwhitenedError(const Values& x, boost::optional<std::vector<Matrix>&> H = boost::none) const {
     if(this->active(x)) {
+      const Value* values[3];
+      x.at(keys_, values);
+      const X1& x1 = Values::Cast<X1>(keys_[0], *values[0]);
+      const X2& x2 = Values::Cast<X2>(keys_[1], *values[1]);
+      const X3& x3 = Values::Cast<X3>(keys_[2], *values[2]);
       if(H)
-        return evaluateError(x.at<X1>(keys_[0]), x.at<X2>(keys_[1]), x.at<X3>(keys_[2]), (*H)[0], (*H)[1], (*H)[2]);
+        return evaluateError(x1, x2, x3, (*H)[0], (*H)[1], (*H)[2]);
       else
-        return evaluateError(x.at<X1>(keys_[0]), x.at<X2>(keys_[1]), x.at<X3>(keys_[2]));
+        return evaluateError(x1, x2, x3);
     } else {
       return zero(this->dim());
     }
@@ -533,10 +622,16 @@ public:
    * so must be implemented in the derived class. */
   virtual Vector unwhitenedError(const Values& x, boost::optional<std::vector<Matrix>&> H = boost::none) const {
     if(this->active(x)) {
+      const Value* values[4];
+      x.at(keys_, values);
+      const X1& x1 = Values::Cast<X1>(keys_[0], *values[0]);
+      const X2& x2 = Values::Cast<X2>(keys_[1], *values[1]);
+      const X3& x3 = Values::Cast<X3>(keys_[2], *values[2]);
+      const X4& x4 = Values::Cast<X4>(keys_[3], *values[3]);
       if(H)
-        return evaluateError(x.at<X1>(keys_[0]), x.at<X2>(keys_[1]), x.at<X3>(keys_[2]), x.at<X4>(keys_[3]), (*H)[0], (*H)[1], (*H)[2], (*H)[3]);
+        return evaluateError(x1, x2, x3, x4, (*H)[0], (*H)[1], (*H)[2], (*H)[3]);
       else
-        return evaluateError(x.at<X1>(keys_[0]), x.at<X2>(keys_[1]), x.at<X3>(keys_[2]), x.at<X4>(keys_[3]));
+        return evaluateError(x1, x2, x3, x4);
     } else {
       return zero(this->dim());
     }
@@ -617,10 +712,17 @@ public:
    * so must be implemented in the derived class. */
   virtual Vector unwhitenedError(const Values& x, boost::optional<std::vector<Matrix>&> H = boost::none) const {
     if(this->active(x)) {
+      const Value* values[5];
+      x.at(keys_, values);
+      const X1& x1 = Values::Cast<X1>(keys_[0], *values[0]);
+      const X2& x2 = Values::Cast<X2>(keys_[1], *values[1]);
+      const X3& x3 = Values::Cast<X3>(keys_[2], *values[2]);
+      const X4& x4 = Values::Cast<X4>(keys_[3], *values[3]);
+      const X5& x5 = Values::Cast<X5>(keys_[4], *values[4]);
       if(H)
-        return evaluateError(x.at<X1>(keys_[0]), x.at<X2>(keys_[1]), x.at<X3>(keys_[2]), x.at<X4>(keys_[3]), x.at<X5>(keys_[4]), (*H)[0], (*H)[1], (*H)[2], (*H)[3], (*H)[4]);
+        return evaluateError(x1, x2, x3, x4, x5, (*H)[0], (*H)[1], (*H)[2], (*H)[3], (*H)[4]);
       else
-        return evaluateError(x.at<X1>(keys_[0]), x.at<X2>(keys_[1]), x.at<X3>(keys_[2]), x.at<X4>(keys_[3]), x.at<X5>(keys_[4]));
+        return evaluateError(x1, x2, x3, x4, x5);
     } else {
       return zero(this->dim());
     }
@@ -705,10 +807,18 @@ public:
    * so must be implemented in the derived class. */
   virtual Vector unwhitenedError(const Values& x, boost::optional<std::vector<Matrix>&> H = boost::none) const {
     if(this->active(x)) {
+      const Value* values[6];
+      x.at(keys_, values);
+      const X1& x1 = Values::Cast<X1>(keys_[0], *values[0]);
+      const X2& x2 = Values::Cast<X2>(keys_[1], *values[1]);
+      const X3& x3 = Values::Cast<X3>(keys_[2], *values[2]);
+      const X4& x4 = Values::Cast<X4>(keys_[3], *values[3]);
+      const X5& x5 = Values::Cast<X5>(keys_[4], *values[4]);
+      const X6& x6 = Values::Cast<X6>(keys_[5], *values[5]);
       if(H)
-        return evaluateError(x.at<X1>(keys_[0]), x.at<X2>(keys_[1]), x.at<X3>(keys_[2]), x.at<X4>(keys_[3]), x.at<X5>(keys_[4]), x.at<X6>(keys_[5]), (*H)[0], (*H)[1], (*H)[2], (*H)[3], (*H)[4], (*H)[5]);
+        return evaluateError(x1, x2, x3, x4, x5, x6, (*H)[0], (*H)[1], (*H)[2], (*H)[3], (*H)[4], (*H)[5]);
       else
-        return evaluateError(x.at<X1>(keys_[0]), x.at<X2>(keys_[1]), x.at<X3>(keys_[2]), x.at<X4>(keys_[3]), x.at<X5>(keys_[4]), x.at<X6>(keys_[5]));
+        return evaluateError(x1, x2, x3, x4, x5, x6);
     } else {
       return zero(this->dim());
     }
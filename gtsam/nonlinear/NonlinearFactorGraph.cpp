@@ -22,7 +22,10 @@
 #include <gtsam/symbolic/SymbolicFactorGraph.h>
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/LinearizationPass.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/FactorGraph-inst.h>
 #include <gtsam/config.h> // for GTSAM_USE_TBB
@@ -32,8 +35,13 @@
 #endif
 
 #include <boost/foreach.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <set>
+#include <typeinfo>
+#include <vector>
 
 using namespace std;
 
@@ -47,6 +55,26 @@ double NonlinearFactorGraph::probPrime(const Values& c) const {
   return exp(-0.5 * error(c));
 }
 
+/* ************************************************************************* */
+MemoryUsage NonlinearFactorGraph::memoryUsage() const {
+  MemoryUsage usage;
+  usage.add("factors", sizeof(NonlinearFactorGraph) + heapBytes(factors_));
+  usage.add("noise models", 0);
+  std::set<const noiseModel::Base*> models;
+  BOOST_FOREACH(const sharedFactor& factor, factors_) {
+    if (!factor)
+      continue;
+    usage.add("factors", factor->memoryUsage());
+    if (const NoiseModelFactor* noiseModelFactor =
+        dynamic_cast<const NoiseModelFactor*>(factor.get())) {
+      const SharedNoiseModel model = noiseModelFactor->get_noiseModel();
+      if (model && models.insert(model.get()).second)
+        usage.add("noise models", model->memoryUsage());
+    }
+  }
+  return usage;
+}
+
 /* ************************************************************************* */
 void NonlinearFactorGraph::print(const std::string& str, const KeyFormatter& keyFormatter) const {
   cout << str << "size: " << size() << endl << endl;
@@ -224,15 +252,148 @@ void NonlinearFactorGraph::saveGraph(std::ostream &stm, const Values& values,
 }
 
 /* ************************************************************************* */
-double NonlinearFactorGraph::error(const Values& c) const {
+namespace {
+
+// Sum of the errors of the factors in [first, last)
+double _chunkError(const NonlinearFactorGraph& graph, const Values& c,
+    size_t first, size_t last) {
+  double chunk_error = 0.;
+  if (internal::profilingFactors()) {
+    for (size_t i = first; i < last; ++i) {
+      if (graph[i]) {
+        internal::FactorProfileScope scope(typeid(*graph[i]), internal::FACTOR_ERROR);
+        chunk_error += graph[i]->error(c);
+      }
+    }
+  } else {
+    for (size_t i = first; i < last; ++i) {
+      if (graph[i])
+        chunk_error += graph[i]->error(c);
+    }
+  }
+  return chunk_error;
+}
+
+#ifdef GTSAM_USE_TBB
+class _ErrorOfChunks {
+  const NonlinearFactorGraph& graph_;
+  const Values& c_;
+  size_t grainSize_;
+  std::vector<double>& partials_;
+public:
+  _ErrorOfChunks(const NonlinearFactorGraph& graph, const Values& c,
+      size_t grainSize, std::vector<double>& partials) :
+      graph_(graph), c_(c), grainSize_(grainSize), partials_(partials) {
+  }
+  // Operator that computes the partial sums of a given range of chunks
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    for (size_t k = blocked_range.begin(); k != blocked_range.end(); ++k) {
+      const size_t first = k * grainSize_;
+      partials_[k] = _chunkError(graph_, c_, first,
+          std::min(first + grainSize_, graph_.size()));
+    }
+  }
+};
+#endif
+
+}
+
+/* ************************************************************************* */
+double NonlinearFactorGraph::error(const Values& c, size_t grainSize) const {
   gttic(NonlinearFactorGraph_error);
-  double total_error = 0.;
-  // iterate over all the factors_ to accumulate the log probabilities
-  BOOST_FOREACH(const sharedFactor& factor, this->factors_) {
-    if(factor)
-      total_error += factor->error(c);
+  if (grainSize == 0 || grainSize >= this->size())
+    return _chunkError(*this, c, 0, this->size());
+
+  // Compute one partial sum per chunk of grainSize factors
+  const size_t nrChunks = (this->size() + grainSize - 1) / grainSize;
+  std::vector<double> partials(nrChunks);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, nrChunks, 1),
+      _ErrorOfChunks(*this, c, grainSize, partials));
+#else
+  for (size_t k = 0; k < nrChunks; ++k)
+    partials[k] = _chunkError(*this, c, k * grainSize,
+        std::min((k + 1) * grainSize, this->size()));
+#endif
+
+  // Combine the partial sums with a fixed pairwise reduction tree, so that the
+  // result does not depend on how the chunks were scheduled
+  for (size_t n = nrChunks; n > 1; n = (n + 1) / 2) {
+    for (size_t k = 0; k < n / 2; ++k)
+      partials[k] = partials[2 * k] + partials[2 * k + 1];
+    if (n % 2 == 1)
+      partials[n / 2] = partials[n - 1];
+  }
+  return partials[0];
+}
+
+/* ************************************************************************* */
+namespace {
+
+// Sum of the gradients of the factors in [first, last)
+void _chunkGradient(const NonlinearFactorGraph& graph, const Values& c,
+    size_t first, size_t last, VectorValues& chunk_gradient) {
+  for (size_t i = first; i < last; ++i) {
+    if (graph[i])
+      graph[i]->addGradient(c, chunk_gradient);
+  }
+}
+
+#ifdef GTSAM_USE_TBB
+class _GradientOfChunks {
+  const NonlinearFactorGraph& graph_;
+  const Values& c_;
+  size_t grainSize_;
+  std::vector<VectorValues>& partials_;
+public:
+  _GradientOfChunks(const NonlinearFactorGraph& graph, const Values& c,
+      size_t grainSize, std::vector<VectorValues>& partials) :
+      graph_(graph), c_(c), grainSize_(grainSize), partials_(partials) {
+  }
+  // Operator that computes the partial gradients of a given range of chunks
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    for (size_t k = blocked_range.begin(); k != blocked_range.end(); ++k) {
+      const size_t first = k * grainSize_;
+      _chunkGradient(graph_, c_, first,
+          std::min(first + grainSize_, graph_.size()), partials_[k]);
+    }
+  }
+};
+#endif
+
+}
+
+/* ************************************************************************* */
+VectorValues NonlinearFactorGraph::gradient(const Values& c, size_t grainSize) const {
+  gttic(NonlinearFactorGraph_gradient);
+  if (grainSize == 0 || grainSize >= this->size()) {
+    VectorValues g;
+    _chunkGradient(*this, c, 0, this->size(), g);
+    return g;
   }
-  return total_error;
+
+  // Compute one partial gradient per chunk of grainSize factors
+  const size_t nrChunks = (this->size() + grainSize - 1) / grainSize;
+  std::vector<VectorValues> partials(nrChunks);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, nrChunks, 1),
+      _GradientOfChunks(*this, c, grainSize, partials));
+#else
+  for (size_t k = 0; k < nrChunks; ++k)
+    _chunkGradient(*this, c, k * grainSize,
+        std::min((k + 1) * grainSize, this->size()), partials[k]);
+#endif
+
+  // Combine the partial gradients in the same fixed pairwise order as error()
+  for (size_t n = nrChunks; n > 1; n = (n + 1) / 2) {
+    for (size_t k = 0; k < n / 2; ++k) {
+      partials[k].swap(partials[2 * k]);
+      partials[k].addInPlace_(partials[2 * k + 1]);
+    }
+    if (n % 2 == 1)
+      partials[n / 2].swap(partials[n - 1]);
+  }
+  return partials[0];
 }
 
 /* ************************************************************************* */
@@ -277,6 +438,26 @@ SymbolicFactorGraph::shared_ptr NonlinearFactorGraph::symbolic() const
 /* ************************************************************************* */
 namespace {
 
+// Number of matrix entries of a linearized factor, reported when profiling by factor type
+size_t linearizedEntries(const GaussianFactor::shared_ptr& linear) {
+  if (const JacobianFactor* jacobian = dynamic_cast<const JacobianFactor*>(linear.get()))
+    return jacobian->rows() * jacobian->cols();
+  if (const HessianFactor* hessian = dynamic_cast<const HessianFactor*>(linear.get()))
+    return hessian->rows() * hessian->rows();
+  return 0;
+}
+
+// Linearize a factor, timing it if profiling by factor type
+GaussianFactor::shared_ptr linearizeFactor(const NonlinearFactor& factor,
+    const Values& linearizationPoint, bool profile) {
+  if (!profile)
+    return factor.linearize(linearizationPoint);
+  internal::FactorProfileScope scope(typeid(factor), internal::FACTOR_LINEARIZE);
+  GaussianFactor::shared_ptr linear = factor.linearize(linearizationPoint);
+  scope.setLinearizedEntries(linearizedEntries(linear));
+  return linear;
+}
+
 #ifdef GTSAM_USE_TBB
 class _LinearizeOneFactor {
   const NonlinearFactorGraph& nonlinearGraph_;
@@ -290,9 +471,11 @@ public:
   }
   // Operator that linearizes a given range of the factors
   void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    gttic(NonlinearFactorGraph_linearizeRange);
+    const bool profile = internal::profilingFactors();
     for (size_t i = blocked_range.begin(); i != blocked_range.end(); ++i) {
       if (nonlinearGraph_[i])
-        result_[i] = nonlinearGraph_[i]->linearize(linearizationPoint_);
+        result_[i] = linearizeFactor(*nonlinearGraph_[i], linearizationPoint_, profile);
       else
         result_[i] = GaussianFactor::shared_ptr();
     }
@@ -306,6 +489,7 @@ public:
 GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(const Values& linearizationPoint) const
 {
   gttic(NonlinearFactorGraph_linearize);
+  const LinearizationPass pass(linearizationPoint);
 
   // create an empty linear FG
   GaussianFactorGraph::shared_ptr linearFG = boost::make_shared<GaussianFactorGraph>();
@@ -322,9 +506,10 @@ GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(const Values& li
   linearFG->reserve(this->size());
 
   // linearize all factors
+  const bool profile = internal::profilingFactors();
   BOOST_FOREACH(const sharedFactor& factor, this->factors_) {
     if(factor) {
-      (*linearFG) += factor->linearize(linearizationPoint);
+      (*linearFG) += linearizeFactor(*factor, linearizationPoint, profile);
     } else
     (*linearFG) += GaussianFactor::shared_ptr();
   }
@@ -334,6 +519,70 @@ GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(const Values& li
   return linearFG;
 }
 
+/* ************************************************************************* */
+namespace {
+
+// Linearize a factor into the linear factor in place if possible, otherwise replace it
+void relinearizeFactor(const NonlinearFactor::shared_ptr& factor,
+    const Values& linearizationPoint, GaussianFactor::shared_ptr& linear) {
+  if (!factor) {
+    linear.reset();
+    return;
+  }
+  boost::scoped_ptr<internal::FactorProfileScope> scope;
+  if (internal::profilingFactors())
+    scope.reset(new internal::FactorProfileScope(typeid(*factor), internal::FACTOR_LINEARIZE));
+  if (!linear || !linear.unique() || !factor->linearizeInto(linearizationPoint, *linear))
+    linear = factor->linearize(linearizationPoint);
+  if (scope)
+    scope->setLinearizedEntries(linearizedEntries(linear));
+}
+
+#ifdef GTSAM_USE_TBB
+class _RelinearizeOneFactor {
+  const NonlinearFactorGraph& nonlinearGraph_;
+  const Values& linearizationPoint_;
+  GaussianFactorGraph& result_;
+public:
+  // Create functor with constant parameters
+  _RelinearizeOneFactor(const NonlinearFactorGraph& graph,
+      const Values& linearizationPoint, GaussianFactorGraph& result) :
+      nonlinearGraph_(graph), linearizationPoint_(linearizationPoint), result_(result) {
+  }
+  // Operator that relinearizes a given range of the factors
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    gttic(NonlinearFactorGraph_relinearizeRange);
+    for (size_t i = blocked_range.begin(); i != blocked_range.end(); ++i)
+      relinearizeFactor(nonlinearGraph_[i], linearizationPoint_, result_[i]);
+  }
+};
+#endif
+
+}
+
+/* ************************************************************************* */
+void NonlinearFactorGraph::relinearize(const Values& linearizationPoint,
+    GaussianFactorGraph& linearFG) const
+{
+  gttic(NonlinearFactorGraph_relinearize);
+  const LinearizationPass pass(linearizationPoint);
+
+  linearFG.resize(this->size());
+
+#ifdef GTSAM_USE_TBB
+
+  TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, this->size()),
+    _RelinearizeOneFactor(*this, linearizationPoint, linearFG));
+
+#else
+
+  for (size_t i = 0; i < this->size(); ++i)
+    relinearizeFactor(this->factors_[i], linearizationPoint, linearFG[i]);
+
+#endif
+}
+
 /* ************************************************************************* */
 NonlinearFactorGraph NonlinearFactorGraph::clone() const {
   NonlinearFactorGraph result;
@@ -108,12 +108,33 @@ namespace gtsam {
     /** return keys as an ordered set - ordering is by key value */
     KeySet keys() const;
 
-    /** unnormalized error, \f$ 0.5 \sum_i (h_i(X_i)-z)^2/\sigma^2 \f$ in the most common case */
-    double error(const Values& c) const;
+    /**
+     * unnormalized error, \f$ 0.5 \sum_i (h_i(X_i)-z)^2/\sigma^2 \f$ in the most common case
+     * @param grainSize If zero (default), factor errors are accumulated serially.  Otherwise the
+     * factors are split into chunks of \c grainSize factors whose partial sums are computed in
+     * parallel (when TBB is available) and combined in a fixed pairwise order, so the result only
+     * depends on \c grainSize and not on the number of threads.
+     */
+    double error(const Values& c, size_t grainSize = 0) const;
+
+    /**
+     * Gradient of the error at \c c, the same as linearize(c)->gradientAtZero() but assembled
+     * directly from the factors (see NonlinearFactor::addGradient).
+     * @param grainSize As for error(): chunks of \c grainSize factors are processed in parallel
+     * and their partial gradients combined in a fixed pairwise order.
+     */
+    VectorValues gradient(const Values& c, size_t grainSize = 0) const;
 
     /** Unnormalized probability. O(n) */
     double probPrime(const Values& c) const;
 
+    /**
+     * Return the memory used by the graph, broken down into "factors", the graph and its
+     * factors, and "noise models", the noise models of the NoiseModelFactors, each counted once
+     * even if shared by several factors.  See MemoryUsage.
+     */
+    MemoryUsage memoryUsage() const;
+
     /**
      * Create a symbolic factor graph
      */
@@ -139,6 +160,15 @@ namespace gtsam {
      */
     boost::shared_ptr<GaussianFactorGraph> linearize(const Values& linearizationPoint) const;
 
+    /**
+     * Linearize into an existing linear graph, e.g. the result of linearize() at other values,
+     * which is resized to the size of this graph.  Each linear factor that is not shared with
+     * another owner is overwritten in place by NonlinearFactor::linearizeInto, so that in an
+     * iterative optimizer the linear factors are only allocated in the first iteration; the
+     * others are replaced by the result of NonlinearFactor::linearize.
+     */
+    void relinearize(const Values& linearizationPoint, GaussianFactorGraph& linearFG) const;
+
     /**
      * Clone() performs a deep-copy of the graph, including all of the factors
      */
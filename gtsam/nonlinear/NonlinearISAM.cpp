@@ -20,7 +20,12 @@
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/inference/Ordering.h>
 
+#include <boost/bind.hpp>
 #include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 
 #include <iostream>
 
@@ -28,6 +33,40 @@ using namespace std;
 
 namespace gtsam {
 
+/* ************************************************************************* */
+struct NonlinearISAM::BackgroundReorder {
+  boost::mutex mutex;
+  boost::condition_variable finished;
+  boost::thread worker;
+  size_t nrFactors;    ///< number of factors_ that are relinearized
+  Values linPoint;     ///< the new linearization point of those factors
+  boost::shared_ptr<const GaussianISAM> result; ///< null until the worker finished
+
+  ~BackgroundReorder() {
+    // The worker itself releases the last reference if the NonlinearISAM went away meanwhile
+    if (worker.joinable()) {
+      if (worker.get_id() == boost::this_thread::get_id())
+        worker.detach();
+      else
+        worker.join();
+    }
+  }
+
+  /// Relinearize and eliminate the factors in batch, and publish them if the job still exists
+  static void Run(const boost::weak_ptr<BackgroundReorder>& weak,
+      const NonlinearFactorGraph& factors, const Values& linPoint,
+      const GaussianFactorGraph::Eliminate& eliminationFunction) {
+    boost::shared_ptr<GaussianISAM> isam = boost::make_shared<GaussianISAM>();
+    isam->update(*factors.linearize(linPoint), eliminationFunction);
+    boost::shared_ptr<BackgroundReorder> job = weak.lock();
+    if (!job)
+      return;
+    boost::mutex::scoped_lock lock(job->mutex);
+    job->result = isam;
+    job->finished.notify_all();
+  }
+};
+
 
 /* ************************************************************************* */
 void NonlinearISAM::saveGraph(const string& s, const KeyFormatter& keyFormatter) const {
@@ -39,10 +78,20 @@ void NonlinearISAM::update(const NonlinearFactorGraph& newFactors, const Values&
 
   if(newFactors.size() > 0) {
 
+    // Swap in a finished background reordering before adding to it
+    if(reorderJob_)
+      finishReorder(false);
+
     // Reorder and relinearize every reorderInterval updates
     if(reorderInterval_ > 0 && ++reorderCounter_ >= reorderInterval_) {
-      reorder_relinearize();
-      reorderCounter_ = 0;
+      if(!backgroundReorder_) {
+        reorder_relinearize();
+        reorderCounter_ = 0;
+      } else if(!reorderJob_) {
+        // Otherwise the previous one is still running, and this one starts when it finished
+        startReorder();
+        reorderCounter_ = 0;
+      }
     }
 
     factors_.push_back(newFactors);
@@ -63,6 +112,9 @@ void NonlinearISAM::reorder_relinearize() {
 
 //  cout << "Reordering, relinearizing..." << endl;
 
+  // A batch reordering supersedes the one in the background
+  reorderJob_.reset();
+
   if(factors_.size() > 0) {
     // Obtain the new linearization point
     const Values newLinPoint = estimate();
@@ -79,6 +131,60 @@ void NonlinearISAM::reorder_relinearize() {
   }
 }
 
+/* ************************************************************************* */
+void NonlinearISAM::startReorder() {
+  if(factors_.size() > 0) {
+    reorderJob_ = boost::make_shared<BackgroundReorder>();
+    reorderJob_->nrFactors = factors_.size();
+    reorderJob_->linPoint = estimate();
+
+    // The worker only reads its own copies of the factors and the linearization point
+    reorderJob_->worker = boost::thread(boost::bind(&BackgroundReorder::Run,
+        boost::weak_ptr<BackgroundReorder>(reorderJob_), factors_, reorderJob_->linPoint,
+        eliminationFunction_));
+  }
+}
+
+/* ************************************************************************* */
+bool NonlinearISAM::finishReorder(bool wait) {
+  BackgroundReorder& job = *reorderJob_;
+  {
+    boost::mutex::scoped_lock lock(job.mutex);
+    if(!job.result) {
+      if(!wait)
+        return false;
+      while(!job.result)
+        job.finished.wait(lock);
+    }
+    // The worker has published its result and is done with the mutex
+    if(job.worker.joinable())
+      job.worker.join();
+  }
+
+  // The variables added since the reordering started keep their initial linearization point
+  Values newLinPoint = job.linPoint;
+  BOOST_FOREACH(const Values::ConstKeyValuePair& key_value, linPoint_) {
+    if(!newLinPoint.exists(key_value.key))
+      newLinPoint.insert(key_value.key, key_value.value);
+  }
+
+  // Swap in the reordered tree, and add the factors added since incrementally
+  isam_ = *job.result;
+  const NonlinearFactorGraph newerFactors(factors_.begin() + job.nrFactors, factors_.end());
+  if(newerFactors.size() > 0)
+    isam_.update(*newerFactors.linearize(newLinPoint), eliminationFunction_);
+  linPoint_ = newLinPoint;
+
+  reorderJob_.reset();
+  return true;
+}
+
+/* ************************************************************************* */
+void NonlinearISAM::waitForReorder() {
+  if(reorderJob_)
+    finishReorder(true);
+}
+
 /* ************************************************************************* */
 Values NonlinearISAM::estimate() const {
   if(isam_.size() > 0)
@@ -43,6 +43,19 @@ protected:
   /** The elimination function */
   GaussianFactorGraph::Eliminate eliminationFunction_;
 
+  /** Whether reorderings are computed on a background copy, see the constructor */
+  bool backgroundReorder_;
+
+  /** The reordering running in the background, if any */
+  struct BackgroundReorder;
+  boost::shared_ptr<BackgroundReorder> reorderJob_;
+
+  /** Start relinearizing and reordering a copy of the factors in the background */
+  void startReorder();
+
+  /** Swap in the background reordering if it finished, or after waiting for it if wait is true */
+  bool finishReorder(bool wait);
+
 public:
 
   /// @name Standard Constructors
@@ -54,10 +67,15 @@ public:
    *   0 never reorders (and is dangerous for memory consumption)
    *  1 (default) reorders every time, in worse case is batch every update
    *  typical values are 50 or 100
+   * @param backgroundReorder if true, the periodic reordering relinearizes and eliminates a
+   *   copy of the factors in a background thread while updates continue incrementally, and
+   *   is swapped in by the first update after it finished, so no update stalls on a batch
    */
   NonlinearISAM(int reorderInterval = 1,
-    const GaussianFactorGraph::Eliminate& eliminationFunction = GaussianFactorGraph::EliminationTraitsType::DefaultEliminate) :
-  reorderInterval_(reorderInterval), reorderCounter_(0), eliminationFunction_(eliminationFunction) {}
+    const GaussianFactorGraph::Eliminate& eliminationFunction = GaussianFactorGraph::EliminationTraitsType::DefaultEliminate,
+    bool backgroundReorder = false) :
+  reorderInterval_(reorderInterval), reorderCounter_(0), eliminationFunction_(eliminationFunction),
+  backgroundReorder_(backgroundReorder) {}
 
   /// @}
   /// @name Standard Interface
@@ -84,6 +102,9 @@ public:
   int reorderInterval() const { return reorderInterval_; }  ///<TODO: comment
   int reorderCounter() const { return reorderCounter_; }    ///<TODO: comment
 
+  /** whether a reordering is running in the background */
+  bool reorderInProgress() const { return reorderJob_.get() != 0; }
+
   /** prints out all contents of the system */
   void print(const std::string& s="", const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
 
@@ -100,9 +121,12 @@ public:
   /** Add new factors along with their initial linearization points */
   void update(const NonlinearFactorGraph& newFactors, const Values& initialValues);
 
-  /** Relinearization and reordering of variables */
+  /** Relinearization and reordering of variables, in batch */
   void reorder_relinearize();
 
+  /** Wait for a background reordering, if any, and swap it in */
+  void waitForReorder();
+
   /// @}
 
 };
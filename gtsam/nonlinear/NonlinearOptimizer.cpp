@@ -19,17 +19,26 @@
 #include <gtsam/nonlinear/NonlinearOptimizer.h>
 
 #include <gtsam/linear/GaussianEliminationTree.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/linear/GaussianEliminationPlan.h>
+#include <gtsam/linear/SchurComplementSolver.h>
+#include <gtsam/linear/SparseCholeskySolver.h>
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/SubgraphSolver.h>
 #include <gtsam/linear/PCGSolver.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/VectorValues.h>
 
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/Symbol.h>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
 #include <iomanip>
@@ -38,8 +47,139 @@ using namespace std;
 
 namespace gtsam {
 
+/* ************************************************************************* */
+namespace {
+
+// Variables whose change since their last linearization exceeds the threshold
+KeySet staleVariables(const VectorValues& offsets,
+    const NonlinearOptimizerParams::RelinearizationThreshold& relinearizeThreshold) {
+  KeySet stale;
+  if(const double* threshold = boost::get<double>(&relinearizeThreshold)) {
+    BOOST_FOREACH(const VectorValues::KeyValuePair& key_offset, offsets) {
+      if(key_offset.second.lpNorm<Eigen::Infinity>() >= *threshold)
+        stale.insert(key_offset.first);
+    }
+  } else if(const FastMap<char,Vector>* thresholds = boost::get<FastMap<char,Vector> >(&relinearizeThreshold)) {
+    BOOST_FOREACH(const VectorValues::KeyValuePair& key_offset, offsets) {
+      const char chr = Symbol(key_offset.first).chr();
+      FastMap<char,Vector>::const_iterator threshold = thresholds->find(chr);
+      if(threshold == thresholds->end() || threshold->second.rows() != key_offset.second.rows())
+        throw std::invalid_argument("Relinearization threshold vector for '" + std::string(1, chr) +
+            "' passed into the optimizer parameters is missing or does not match the variable dimensionality.");
+      if((key_offset.second.array().abs() > threshold->second.array()).any())
+        stale.insert(key_offset.first);
+    }
+  }
+  return stale;
+}
+
+}
+
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr NonlinearOptimizer::linearizeWithCache(const Values& values) const {
+  const NonlinearOptimizerParams& params = this->_params();
+  if(!params.cacheLinearization)
+    return graph_.linearize(values);
+
+  // Linearize everything the first time
+  if(linearFactors_.size() != graph_.size() || linearizationPoint_.size() != values.size()) {
+    linearizationPoint_ = Values();
+    linearFactors_ = GaussianFactorGraph();
+  }
+  return gtsam::linearizeWithCache(graph_, values, params.relinearizeThreshold,
+      linearizationPoint_, linearFactors_, skippedLinearizations_);
+}
+
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr linearizeWithCache(const NonlinearFactorGraph& graph,
+    const Values& values, const NonlinearOptimizerParams::RelinearizationThreshold& relinearizeThreshold,
+    Values& linearizationPoint, GaussianFactorGraph& linearFactors, size_t& skippedLinearizations) {
+
+  gttic(NonlinearOptimizer_linearizeWithCache);
+
+  // Variables seen for the first time are linearized at values, and so are the
+  // factors in new slots
+  linearFactors.resize(graph.size());
+  VectorValues offsets;
+  BOOST_FOREACH(const Values::ConstKeyValuePair& key_value, values) {
+    std::pair<Values::iterator, bool> inserted =
+        linearizationPoint.tryInsert(key_value.key, key_value.value);
+    if(inserted.second)
+      offsets.insert(key_value.key, Vector::Zero(key_value.value.dim()));
+    else
+      offsets.insert(key_value.key, inserted.first->value.localCoordinates_(key_value.value));
+  }
+
+  // Move the linearization point of the variables that moved too far
+  const KeySet stale = staleVariables(offsets, relinearizeThreshold);
+  BOOST_FOREACH(Key key, stale) {
+    linearizationPoint.update(key, values.at(key));
+    offsets.at(key).setZero();
+  }
+
+  // Collect the factors involving a stale variable, and those without a cached
+  // linear factor.  Factors that did not linearize to a JacobianFactor cannot be
+  // shifted, so they are always linearized again, directly at values.
+  NonlinearFactorGraph relinearized, unshiftable;
+  vector<size_t> relinearizedSlots, unshiftableSlots;
+  for(size_t i = 0; i < graph.size(); ++i) {
+    const NonlinearFactor::shared_ptr& factor = graph[i];
+    if(!factor) {
+      linearFactors[i].reset();
+      continue;
+    }
+    bool involvesStale = !linearFactors[i];
+    BOOST_FOREACH(Key key, *factor)
+      involvesStale = involvesStale || stale.exists(key);
+    if(linearFactors[i] && !boost::dynamic_pointer_cast<JacobianFactor>(linearFactors[i])) {
+      unshiftable.push_back(factor);
+      unshiftableSlots.push_back(i);
+    } else if(involvesStale) {
+      relinearized.push_back(factor);
+      relinearizedSlots.push_back(i);
+    } else {
+      ++skippedLinearizations;
+    }
+  }
+  GaussianFactorGraph::shared_ptr linear = relinearized.linearize(linearizationPoint);
+  for(size_t k = 0; k < relinearizedSlots.size(); ++k)
+    linearFactors[relinearizedSlots[k]] = (*linear)[k];
+  linear = unshiftable.linearize(values);
+  for(size_t k = 0; k < unshiftableSlots.size(); ++k)
+    linearFactors[unshiftableSlots[k]] = (*linear)[k];
+
+  // The cached factors are functions of the step from linearizationPoint, so
+  // shift them to be functions of the step from values: A (offset + dx) - b
+  GaussianFactorGraph::shared_ptr result = boost::make_shared<GaussianFactorGraph>();
+  result->reserve(linearFactors.size());
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, linearFactors) {
+    JacobianFactor::shared_ptr jacobian = boost::dynamic_pointer_cast<JacobianFactor>(factor);
+    bool moved = false;
+    if(jacobian) {
+      BOOST_FOREACH(Key key, *jacobian)
+        moved = moved || !offsets.at(key).isZero(0.0);
+    }
+    if(moved) {
+      JacobianFactor::shared_ptr shifted = boost::make_shared<JacobianFactor>(*jacobian);
+      for(JacobianFactor::const_iterator key = jacobian->begin(); key != jacobian->end(); ++key)
+        shifted->getb() -= jacobian->getA(key) * offsets.at(*key);
+      result->push_back(shifted);
+    } else {
+      result->push_back(factor);
+    }
+  }
+  return result;
+}
+
 /* ************************************************************************* */
 void NonlinearOptimizer::defaultOptimize() {
+  const NonlinearOptimizerParams& params = this->_params();
+  TaskArena(params.maxThreads, params.threadEntry).execute(
+      boost::bind(&NonlinearOptimizer::defaultOptimizeLoop, this));
+}
+
+/* ************************************************************************* */
+void NonlinearOptimizer::defaultOptimizeLoop() {
 
   const NonlinearOptimizerParams& params = this->_params();
   double currentError = this->error();
@@ -97,17 +237,95 @@ const Values& NonlinearOptimizer::optimizeSafely() {
   }
 }
 
+/* ************************************************************************* */
+bool NonlinearOptimizer::prepareSolve(const GaussianFactorGraph& gfg,
+    const NonlinearOptimizerParams& params) const {
+  if (params.isMultifrontal() && !params.isMixedPrecision()) {
+    if (!eliminationPlan_ || eliminationPlan_->ordering() != *params.ordering
+        || !eliminationPlan_->compatible(gfg))
+      eliminationPlan_ = boost::make_shared<GaussianEliminationPlan>(gfg, *params.ordering);
+  } else if (params.isCholmod()) {
+    if (!sparseCholeskySolver_ || sparseCholeskySolver_->ordering() != *params.ordering
+        || !sparseCholeskySolver_->compatible(gfg))
+      sparseCholeskySolver_ = boost::make_shared<SparseCholeskySolver>(gfg, *params.ordering);
+    // The solver keeps its numeric factorization between calls
+    return false;
+  } else if (params.isIterative()) {
+    // The inexact Newton steps depend on the previous solve
+    return !params.inexactNewton && !params.warmStartIterative;
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<GaussianBayesTree> NonlinearOptimizer::eliminateMultifrontal(
+    const GaussianFactorGraph& gfg, const NonlinearOptimizerParams& params) const {
+  if (params.isMixedPrecision() || !params.isMultifrontal())
+    return gfg.eliminateMultifrontal(*params.ordering, params.getEliminationFunction());
+  prepareSolve(gfg, params);
+  return eliminationPlan_->eliminateMultifrontal(gfg, params.getEliminationFunction());
+}
+
+/* ************************************************************************* */
+double NonlinearOptimizer::forcingTerm(const GaussianFactorGraph& gfg,
+    const NonlinearOptimizerParams& params, double minimum) const {
+  // The damping of LM does not change the gradient, so all lambdas tried at one linearization
+  // get the same tolerance
+  const double gradientNorm = gfg.gradientAtZero().norm();
+  if (gradientNorm == gradientNorm_)
+    return forcingTerm_;
+
+  // Eisenstat-Walker choice 2: eta = gamma * (|g_k| / |g_k-1|)^alpha with gamma = 0.9 and
+  // alpha = 2, safeguarded against dropping faster than the previous eta
+  double eta = params.maxForcingTerm;
+  if (gradientNorm_ > 0.0) {
+    const double ratio = gradientNorm / gradientNorm_;
+    eta = 0.9 * ratio * ratio;
+    const double safeguard = 0.9 * forcingTerm_ * forcingTerm_;
+    if (safeguard > 0.1)
+      eta = std::max(eta, safeguard);
+  }
+  gradientNorm_ = gradientNorm;
+  forcingTerm_ = std::max(minimum, std::min(params.maxForcingTerm, eta));
+  return forcingTerm_;
+}
+
 /* ************************************************************************* */
 VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph &gfg,
     const Values& initial, const NonlinearOptimizerParams& params) const {
 
   // solution of linear solver is an update to the linearization point
   VectorValues delta;
+  prepareSolve(gfg, params);
 
   // Check which solver we are using
-  if (params.isMultifrontal()) {
-    // Multifrontal QR or Cholesky (decided by params.getEliminationFunction())
-    delta = gfg.optimize(*params.ordering, params.getEliminationFunction());
+  if (params.isMixedPrecision()) {
+    // Multifrontal Cholesky in single precision, with iterative refinement in double precision
+    delta = gfg.optimizeMixedPrecision(*params.ordering);
+  } else if (params.isMultifrontal()) {
+    // Multifrontal QR or Cholesky (decided by params.getEliminationFunction()). The junction
+    // tree is only rebuilt when the ordering or the structure of the linear system changes,
+    // so repeated solves, e.g. for each lambda in LM, only do the numeric work.
+    if (params.linearSolverType == NonlinearOptimizerParams::MULTIFRONTAL_CHOLESKY)
+      delta = eliminationPlan_->optimize(gfg);
+    else
+      delta = eliminationPlan_->eliminateMultifrontal(gfg, params.getEliminationFunction())->optimize();
+  } else if (params.isSchurComplement()) {
+    // Eliminate the landmarks in parallel, then solve the reduced camera system in the
+    // restriction of the ordering to the cameras
+    const KeySet landmarks = params.schurKeys.empty() ?
+        SchurComplementSolver::DetectEliminatedKeys(gfg) : params.schurKeys;
+    Ordering reducedOrdering;
+    BOOST_FOREACH(Key key, *params.ordering) {
+      if (!landmarks.exists(key))
+        reducedOrdering.push_back(key);
+    }
+    delta = SchurComplementSolver(landmarks, reducedOrdering).optimize(gfg,
+        params.getEliminationFunction());
+  } else if (params.isCholmod()) {
+    // Sparse Cholesky of the assembled Hessian, keeping the symbolic analysis while the ordering
+    // and the structure of the linear system stay the same
+    delta = sparseCholeskySolver_->optimize(gfg);
   } else if (params.isSequential()) {
     // Sequential QR or Cholesky (decided by params.getEliminationFunction())
     delta = gfg.eliminateSequential(*params.ordering, params.getEliminationFunction(), 
@@ -119,7 +337,25 @@ VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph &gfg,
       throw std::runtime_error("NonlinearOptimizer::solve: cg parameter has to be assigned ...");
 
     if (boost::shared_ptr<PCGSolverParameters> pcg = boost::dynamic_pointer_cast<PCGSolverParameters>(params.iterativeParams) ) {
-      delta = PCGSolver(*pcg).optimize(gfg);
+      if (params.inexactNewton || params.warmStartIterative) {
+        PCGSolverParameters pcgParams = *pcg;
+        if (params.inexactNewton)
+          pcgParams.setEpsilon_rel(forcingTerm(gfg, params, pcg->epsilon_rel()));
+        const KeyInfo keyInfo(gfg);
+        VectorValues initial = keyInfo.x0();
+        if (params.warmStartIterative) {
+          BOOST_FOREACH(VectorValues::KeyValuePair& key_value, initial) {
+            VectorValues::const_iterator previous = iterativeDelta_.find(key_value.first);
+            if (previous != iterativeDelta_.end() && previous->second.size() == key_value.second.size())
+              key_value.second = previous->second;
+          }
+        }
+        delta = PCGSolver(pcgParams).optimizeWarmStarted(gfg, keyInfo, std::map<Key, Vector>(),
+            initial);
+        iterativeDelta_ = delta;
+      } else {
+        delta = PCGSolver(*pcg).optimize(gfg);
+      }
     }
     else if (boost::shared_ptr<SubgraphSolverParameters> spcg = boost::dynamic_pointer_cast<SubgraphSolverParameters>(params.iterativeParams) ) {
       delta = SubgraphSolver(gfg, *spcg, *params.ordering).optimize();
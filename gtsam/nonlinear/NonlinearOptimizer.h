@@ -20,10 +20,14 @@
 
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/NonlinearOptimizerParams.h>
+#include <gtsam/linear/VectorValues.h>
 
 namespace gtsam {
 
 class NonlinearOptimizer;
+class GaussianBayesTree;
+class GaussianEliminationPlan;
+class SparseCholeskySolver;
 
 /**
  * Base class for a nonlinear optimization state, including the current estimate
@@ -50,8 +54,9 @@ public:
   virtual ~NonlinearOptimizerState() {}
 
 protected:
-  NonlinearOptimizerState(const NonlinearFactorGraph& graph, const Values& values, unsigned int iterations = 0) :
-    values(values), error(graph.error(values)), iterations(iterations) {}
+  NonlinearOptimizerState(const NonlinearFactorGraph& graph, const Values& values, unsigned int iterations = 0,
+      size_t errorGrainSize = 0) :
+    values(values), error(graph.error(values, errorGrainSize)), iterations(iterations) {}
 
   NonlinearOptimizerState(const Values& values, double error, unsigned int iterations) :
     values(values), error(error), iterations(iterations) {}
@@ -171,6 +176,10 @@ public:
   /// return values
   const Values& values() const { return _state().values; }
 
+  /// return the number of factor linearizations skipped so far by the
+  /// linearization cache, see NonlinearOptimizerParams::cacheLinearization
+  size_t skippedLinearizations() const { return skippedLinearizations_; }
+
   /// @}
 
   /// @name Advanced interface
@@ -197,12 +206,54 @@ protected:
    */
   void defaultOptimize();
 
+  /** The loop of defaultOptimize(), run in the task arena of NonlinearOptimizerParams::maxThreads */
+  void defaultOptimizeLoop();
+
   virtual const NonlinearOptimizerState& _state() const = 0;
 
   virtual const NonlinearOptimizerParams& _params() const = 0;
 
+  /** Linearize graph_ at \c values.  When NonlinearOptimizerParams::cacheLinearization
+   * is set, only factors involving a variable that moved more than the
+   * relinearization threshold are linearized again; the others reuse their
+   * previous linear factor, shifted to be a function of the step from \c values.
+   */
+  GaussianFactorGraph::shared_ptr linearizeWithCache(const Values& values) const;
+
+  /** Create the symbolic structures solve() reuses for linear systems with the structure of
+   * \c gfg, if they do not exist yet.  Returns whether solve() may then be called concurrently
+   * for several such systems, which is not the case for the sparse Cholesky solver.
+   */
+  bool prepareSolve(const GaussianFactorGraph& gfg, const NonlinearOptimizerParams& params) const;
+
+  /** Eliminate \c gfg into a Bayes tree with the ordering and elimination function of \c params,
+   * reusing the symbolic elimination of solve() while the linear system keeps its structure.
+   */
+  boost::shared_ptr<GaussianBayesTree> eliminateMultifrontal(const GaussianFactorGraph& gfg,
+      const NonlinearOptimizerParams& params) const;
+
   /** Constructor for initial construction of base classes. */
-  NonlinearOptimizer(const NonlinearFactorGraph& graph) : graph_(graph) {}
+  NonlinearOptimizer(const NonlinearFactorGraph& graph) :
+      graph_(graph), skippedLinearizations_(0), gradientNorm_(0.0), forcingTerm_(0.0) {}
+
+private:
+  // Linearization cache, mutable because linearization is a const operation
+  mutable Values linearizationPoint_; ///< The point at which each variable was last linearized
+  mutable GaussianFactorGraph linearFactors_; ///< The factors of graph_ linearized at linearizationPoint_
+  mutable size_t skippedLinearizations_; ///< Number of factor linearizations reused from the cache
+
+  // Symbolic elimination reused by solve() while the linear system keeps its structure
+  mutable boost::shared_ptr<GaussianEliminationPlan> eliminationPlan_;
+  mutable boost::shared_ptr<SparseCholeskySolver> sparseCholeskySolver_;
+
+  // Inexact Newton state of the Iterative solver, see NonlinearOptimizerParams::inexactNewton
+  mutable double gradientNorm_; ///< Gradient norm of the last linear system, 0 before the first
+  mutable double forcingTerm_; ///< Relative PCG tolerance used for the last linear system
+  mutable VectorValues iterativeDelta_; ///< The last PCG solution, to warm start the next
+
+  /** The relative PCG tolerance for \c gfg, at least \c minimum */
+  double forcingTerm(const GaussianFactorGraph& gfg, const NonlinearOptimizerParams& params,
+      double minimum) const;
 
 };
 
@@ -214,4 +265,17 @@ GTSAM_EXPORT bool checkConvergence(double relativeErrorTreshold,
     double absoluteErrorTreshold, double errorThreshold,
     double currentError, double newError, NonlinearOptimizerParams::Verbosity verbosity = NonlinearOptimizerParams::SILENT);
 
+/**
+ * Linearize \c graph at \c values, reusing \c linearFactors, the factors of \c graph linearized
+ * at \c linearizationPoint, as NonlinearOptimizer::linearizeWithCache does.  Only factors that
+ * involve a variable that moved more than \c relinearizeThreshold, and factors whose entry in
+ * \c linearFactors is null, e.g. because their slot was reused, are linearized again; the others
+ * are shifted to be functions of the step from \c values.  Variables missing from
+ * \c linearizationPoint are added.  \c linearizationPoint and \c linearFactors are updated, and
+ * \c skippedLinearizations is incremented by the number of factor linearizations reused.
+ */
+GTSAM_EXPORT GaussianFactorGraph::shared_ptr linearizeWithCache(const NonlinearFactorGraph& graph,
+    const Values& values, const NonlinearOptimizerParams::RelinearizationThreshold& relinearizeThreshold,
+    Values& linearizationPoint, GaussianFactorGraph& linearFactors, size_t& skippedLinearizations);
+
 } // gtsam
@@ -80,6 +80,18 @@ void NonlinearOptimizerParams::print(const std::string& str) const {
   std::cout << "absolute decrease threshold: " << absoluteErrorTol << "\n";
   std::cout << "      total error threshold: " << errorTol << "\n";
   std::cout << "         maximum iterations: " << maxIterations << "\n";
+  std::cout << "           error grain size: " << errorGrainSize << "\n";
+  std::cout << "        cache linearization: " << cacheLinearization << "\n";
+  if(cacheLinearization) {
+    if(const double* threshold = boost::get<double>(&relinearizeThreshold))
+      std::cout << "      relinearize threshold: " << *threshold << "\n";
+    else
+      std::cout << "      relinearize threshold: {mapped}\n";
+  }
+  std::cout << "            maximum threads: " << maxThreads << "\n";
+  std::cout << "             inexact Newton: " << inexactNewton << "\n";
+  std::cout << "           max forcing term: " << maxForcingTerm << "\n";
+  std::cout << "       warm start iterative: " << warmStartIterative << "\n";
   std::cout << "                  verbosity: " << verbosityTranslator(verbosity)
       << "\n";
   std::cout.flush();
@@ -100,6 +112,12 @@ void NonlinearOptimizerParams::print(const std::string& str) const {
   case CHOLMOD:
     std::cout << "         linear solver type: CHOLMOD\n";
     break;
+  case MULTIFRONTAL_CHOLESKY_MIXED:
+    std::cout << "         linear solver type: MULTIFRONTAL CHOLESKY MIXED\n";
+    break;
+  case SCHUR_COMPLEMENT:
+    std::cout << "         linear solver type: SCHUR COMPLEMENT\n";
+    break;
   case Iterative:
     std::cout << "         linear solver type: ITERATIVE\n";
     break;
@@ -115,6 +133,12 @@ void NonlinearOptimizerParams::print(const std::string& str) const {
   case Ordering::METIS:
 	  std::cout << "                   ordering: METIS\n";
 	  break;
+  case Ordering::NESTED_DISSECTION:
+	  std::cout << "                   ordering: NESTED_DISSECTION\n";
+	  break;
+  case Ordering::AMD:
+	  std::cout << "                   ordering: AMD\n";
+	  break;
   default:
 	  std::cout << "                   ordering: custom\n";
 	  break;
@@ -139,6 +163,10 @@ std::string NonlinearOptimizerParams::linearSolverTranslator(
     return "ITERATIVE";
   case CHOLMOD:
     return "CHOLMOD";
+  case MULTIFRONTAL_CHOLESKY_MIXED:
+    return "MULTIFRONTAL_CHOLESKY_MIXED";
+  case SCHUR_COMPLEMENT:
+    return "SCHUR_COMPLEMENT";
   default:
     throw std::invalid_argument(
         "Unknown linear solver type in SuccessiveLinearizationOptimizer");
@@ -160,6 +188,10 @@ NonlinearOptimizerParams::LinearSolverType NonlinearOptimizerParams::linearSolve
     return Iterative;
   if (linearSolverType == "CHOLMOD")
     return CHOLMOD;
+  if (linearSolverType == "MULTIFRONTAL_CHOLESKY_MIXED")
+    return MULTIFRONTAL_CHOLESKY_MIXED;
+  if (linearSolverType == "SCHUR_COMPLEMENT")
+    return SCHUR_COMPLEMENT;
   throw std::invalid_argument(
       "Unknown linear solver type in SuccessiveLinearizationOptimizer");
 }
@@ -171,6 +203,10 @@ std::string NonlinearOptimizerParams::orderingTypeTranslator(Ordering::OrderingT
 		return "METIS";
 	case Ordering::COLAMD:
 		return "COLAMD";
+	case Ordering::NESTED_DISSECTION:
+		return "NESTED_DISSECTION";
+	case Ordering::AMD:
+		return "AMD";
 	default:
 		if (ordering)
 			return "CUSTOM";
@@ -186,6 +222,10 @@ Ordering::OrderingType NonlinearOptimizerParams::orderingTypeTranslator(const st
 		return Ordering::METIS;
 	if (type == "COLAMD")
 		return Ordering::COLAMD;
+	if (type == "NESTED_DISSECTION")
+		return Ordering::NESTED_DISSECTION;
+	if (type == "AMD")
+		return Ordering::AMD;
 	throw std::invalid_argument(
 		"Invalid ordering type: You must provide an ordering for a custom ordering type. See setOrdering");
 }
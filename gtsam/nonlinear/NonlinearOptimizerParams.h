@@ -23,7 +23,10 @@
 
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/SubgraphSolver.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/TaskArena.h>
 #include <boost/optional.hpp>
+#include <boost/variant.hpp>
 #include <string>
 
 namespace gtsam {
@@ -44,10 +47,59 @@ public:
   double errorTol; ///< The maximum total error to stop iterating (default 0.0)
   Verbosity verbosity; ///< The printing verbosity during optimization (default SILENT)
   Ordering::OrderingType orderingType; ///< The method of ordering use during variable elimination (default COLAMD)
+  size_t errorGrainSize; ///< The number of factors per chunk when evaluating the graph error in parallel, 0 for serial (default 1000)
+
+  typedef boost::variant<double, FastMap<char,Vector> > RelinearizationThreshold; ///< Either a constant relinearization threshold or a per-variable-type set of thresholds
+
+  /** Whether to keep the linear factors between iterations and only relinearize
+   * factors involving a variable that moved more than relinearizeThreshold since
+   * it was last linearized (default false).  Reused factors are shifted to the
+   * current estimate to first order, so the converged solution is only exact up
+   * to the threshold, as in ISAM2.
+   */
+  bool cacheLinearization;
+
+  /** Only relevant when cacheLinearization is true.  A variable is relinearized
+   * when any component of its tangent-space change since its last linearization
+   * exceeds the threshold.  As in ISAM2Params, this is either a single double or
+   * a FastMap<char,Vector> of per-dimension thresholds keyed by Symbol character
+   * (default 0.1).
+   */
+  RelinearizationThreshold relinearizeThreshold;
+
+  /** The maximum number of threads doing the parallel work of the optimization loop with TBB,
+   * counting the calling thread, or 0 to use the global TBB scheduler (default 0).  With a
+   * positive number the loop runs in a tbb::task_arena of its own, see TaskArena.
+   */
+  int maxThreads;
+
+  /** Called by each thread every time it joins the task arena of maxThreads, e.g. to pin the
+   * threads to the cores of a NUMA node (default none).
+   */
+  TaskArena::ThreadEntry threadEntry;
+
+  /** Only relevant for the Iterative solver with PCGSolverParameters.  Whether to solve each
+   * linear system only as accurately as the current gradient norm warrants: the relative PCG
+   * tolerance follows the Eisenstat-Walker forcing sequence (choice 2), between the tolerance of
+   * the PCG parameters and maxForcingTerm, so early iterations take cheap inexact steps
+   * (default false).
+   */
+  bool inexactNewton;
+
+  /// The largest relative PCG tolerance of the inexact Newton steps (default 0.9)
+  double maxForcingTerm;
+
+  /** Only relevant for the Iterative solver with PCGSolverParameters.  Whether to start PCG from
+   * the previous linear solution instead of zero, see PCGSolver::optimizeWarmStarted
+   * (default false).
+   */
+  bool warmStartIterative;
 
   NonlinearOptimizerParams() :
       maxIterations(100), relativeErrorTol(1e-5), absoluteErrorTol(1e-5), errorTol(
           0.0), verbosity(SILENT), orderingType(Ordering::COLAMD),
+          errorGrainSize(1000), cacheLinearization(false), relinearizeThreshold(0.1),
+          maxThreads(0), inexactNewton(false), maxForcingTerm(0.9), warmStartIterative(false),
           linearSolverType(MULTIFRONTAL_CHOLESKY) {}
 
   virtual ~NonlinearOptimizerParams() {
@@ -69,6 +121,24 @@ public:
   std::string getVerbosity() const {
     return verbosityTranslator(verbosity);
   }
+  size_t getErrorGrainSize() const {
+    return errorGrainSize;
+  }
+  bool getCacheLinearization() const {
+    return cacheLinearization;
+  }
+  int getMaxThreads() const {
+    return maxThreads;
+  }
+  bool getInexactNewton() const {
+    return inexactNewton;
+  }
+  double getMaxForcingTerm() const {
+    return maxForcingTerm;
+  }
+  bool getWarmStartIterative() const {
+    return warmStartIterative;
+  }
 
   void setMaxIterations(int value) {
     maxIterations = value;
@@ -85,6 +155,30 @@ public:
   void setVerbosity(const std::string &src) {
     verbosity = verbosityTranslator(src);
   }
+  void setErrorGrainSize(size_t value) {
+    errorGrainSize = value;
+  }
+  void setCacheLinearization(bool value) {
+    cacheLinearization = value;
+  }
+  void setRelinearizeThreshold(double value) {
+    relinearizeThreshold = value;
+  }
+  void setMaxThreads(int value) {
+    maxThreads = value;
+  }
+  void setThreadEntry(const TaskArena::ThreadEntry& value) {
+    threadEntry = value;
+  }
+  void setInexactNewton(bool value) {
+    inexactNewton = value;
+  }
+  void setMaxForcingTerm(double value) {
+    maxForcingTerm = value;
+  }
+  void setWarmStartIterative(bool value) {
+    warmStartIterative = value;
+  }
 
   static Verbosity verbosityTranslator(const std::string &s) ;
   static std::string verbosityTranslator(Verbosity value) ;
@@ -101,16 +195,26 @@ public:
     SEQUENTIAL_CHOLESKY,
     SEQUENTIAL_QR,
     Iterative, /* Experimental Flag */
-    CHOLMOD, /* Experimental Flag */
+    CHOLMOD, /* Sparse Cholesky of the assembled Hessian, supernodal with CHOLMOD if available, see SparseCholeskySolver */
+    MULTIFRONTAL_CHOLESKY_MIXED, /* Single precision factorization with iterative refinement */
+    SCHUR_COMPLEMENT, /* Eliminate independent variables (landmarks) first, see SchurComplementSolver */
   };
 
   LinearSolverType linearSolverType; ///< The type of linear solver to use in the nonlinear optimizer
   boost::optional<Ordering> ordering; ///< The variable elimination ordering, or empty to use COLAMD (default: empty)
   IterativeOptimizationParameters::shared_ptr iterativeParams; ///< The container for iterativeOptimization parameters. used in CG Solvers.
+  KeySet schurKeys; ///< The variables, e.g. landmarks, the SCHUR_COMPLEMENT solver eliminates first, or empty to detect them from the key types (default: empty)
 
   inline bool isMultifrontal() const {
     return (linearSolverType == MULTIFRONTAL_CHOLESKY)
-        || (linearSolverType == MULTIFRONTAL_QR);
+        || (linearSolverType == MULTIFRONTAL_QR)
+        || (linearSolverType == MULTIFRONTAL_CHOLESKY_MIXED);
+  }
+
+  /// Multifrontal Cholesky in single precision, refined to double precision by
+  /// GaussianFactorGraph::optimizeMixedPrecision
+  inline bool isMixedPrecision() const {
+    return (linearSolverType == MULTIFRONTAL_CHOLESKY_MIXED);
   }
 
   inline bool isSequential() const {
@@ -118,6 +222,10 @@ public:
         || (linearSolverType == SEQUENTIAL_QR);
   }
 
+  inline bool isSchurComplement() const {
+    return (linearSolverType == SCHUR_COMPLEMENT);
+  }
+
   inline bool isCholmod() const {
     return (linearSolverType == CHOLMOD);
   }
@@ -130,6 +238,11 @@ public:
     switch (linearSolverType) {
     case MULTIFRONTAL_CHOLESKY:
     case SEQUENTIAL_CHOLESKY:
+    // Only the linear solve of NonlinearOptimizer is refined, so other eliminations (marginals,
+    // Dogleg, ...) stay in double precision
+    case MULTIFRONTAL_CHOLESKY_MIXED:
+    case SCHUR_COMPLEMENT:
+    case CHOLMOD:
       return EliminatePreferCholesky;
 
     case MULTIFRONTAL_QR:
@@ -0,0 +1,195 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    NumericalDerivativeFactor.h
+ * @brief   Base classes for factors whose Jacobians are computed numerically
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/base/numericalDerivative.h>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+
+/**
+ * A NoiseModelFactor1 for which only the error has to be implemented, in
+ * evaluateErrorOnly(). The Jacobian is computed with numericalDerivativeFixed,
+ * so X and the error (of dimension ZDim) must have a fixed size, and the
+ * factor linearizes to a fixed-size UnaryJacobianFactor.
+ */
+template<class VALUE, int ZDim>
+class NumericalDerivativeFactor1: public NoiseModelFactor1<VALUE> {
+
+public:
+
+  typedef VALUE X;
+  typedef Eigen::Matrix<double, ZDim, 1> ErrorVector;
+
+protected:
+
+  typedef NoiseModelFactor1<VALUE> Base;
+  typedef NumericalDerivativeFactor1<VALUE, ZDim> This;
+
+  double delta_; ///< increment for the central differences
+
+  /// Calls evaluateErrorOnly, without the indirection of a boost::function
+  struct Error {
+    const This& factor_;
+    Error(const This& factor) : factor_(factor) {}
+    ErrorVector operator()(const X& x) const {
+      return factor_.evaluateErrorOnly(x);
+    }
+  };
+
+public:
+
+  /** Default constructor for I/O only */
+  NumericalDerivativeFactor1() : delta_(1e-5) {}
+
+  virtual ~NumericalDerivativeFactor1() {}
+
+  /**
+   *  Constructor
+   *  @param noiseModel shared pointer to noise model
+   *  @param key1 by which to look up X value in Values
+   *  @param delta increment for the numerical derivative
+   */
+  NumericalDerivativeFactor1(const SharedNoiseModel& noiseModel, Key key1,
+      double delta = 1e-5) :
+      Base(noiseModel, key1), delta_(delta) {}
+
+  /// increment for the numerical derivative
+  double delta() const { return delta_; }
+
+  /** Override this method to finish implementing a unary factor */
+  virtual ErrorVector evaluateErrorOnly(const X& x) const = 0;
+
+  /** Evaluates the error, and its Jacobian numerically if requested */
+  virtual Vector evaluateError(const X& x, boost::optional<Matrix&> H =
+      boost::none) const {
+    const ErrorVector error = evaluateErrorOnly(x);
+    if (H)
+      *H = internal::numericalDerivativeFixed<ErrorVector, X>(Error(*this), x, error, delta_);
+    return error;
+  }
+
+private:
+
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template<class ARCHIVE>
+  void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+    ar & boost::serialization::make_nvp("NoiseModelFactor1",
+        boost::serialization::base_object<Base>(*this));
+    ar & BOOST_SERIALIZATION_NVP(delta_);
+  }
+}; // \class NumericalDerivativeFactor1
+
+/* ************************************************************************* */
+
+/**
+ * A NoiseModelFactor2 for which only the error has to be implemented, in
+ * evaluateErrorOnly(). The Jacobians are computed with numericalDerivativeFixed,
+ * so X1, X2 and the error (of dimension ZDim) must have a fixed size, and the
+ * factor linearizes to a fixed-size BinaryJacobianFactor.
+ */
+template<class VALUE1, class VALUE2, int ZDim>
+class NumericalDerivativeFactor2: public NoiseModelFactor2<VALUE1, VALUE2> {
+
+public:
+
+  typedef VALUE1 X1;
+  typedef VALUE2 X2;
+  typedef Eigen::Matrix<double, ZDim, 1> ErrorVector;
+
+protected:
+
+  typedef NoiseModelFactor2<VALUE1, VALUE2> Base;
+  typedef NumericalDerivativeFactor2<VALUE1, VALUE2, ZDim> This;
+
+  double delta_; ///< increment for the central differences
+
+  /// Calls evaluateErrorOnly as a function of X1, with X2 fixed
+  struct Error1 {
+    const This& factor_;
+    const X2& x2_;
+    Error1(const This& factor, const X2& x2) : factor_(factor), x2_(x2) {}
+    ErrorVector operator()(const X1& x1) const {
+      return factor_.evaluateErrorOnly(x1, x2_);
+    }
+  };
+
+  /// Calls evaluateErrorOnly as a function of X2, with X1 fixed
+  struct Error2 {
+    const This& factor_;
+    const X1& x1_;
+    Error2(const This& factor, const X1& x1) : factor_(factor), x1_(x1) {}
+    ErrorVector operator()(const X2& x2) const {
+      return factor_.evaluateErrorOnly(x1_, x2);
+    }
+  };
+
+public:
+
+  /** Default constructor for I/O only */
+  NumericalDerivativeFactor2() : delta_(1e-5) {}
+
+  virtual ~NumericalDerivativeFactor2() {}
+
+  /**
+   * Constructor
+   * @param noiseModel shared pointer to noise model
+   * @param j1 key of the first variable
+   * @param j2 key of the second variable
+   * @param delta increment for the numerical derivatives
+   */
+  NumericalDerivativeFactor2(const SharedNoiseModel& noiseModel, Key j1, Key j2,
+      double delta = 1e-5) :
+      Base(noiseModel, j1, j2), delta_(delta) {}
+
+  /// increment for the numerical derivatives
+  double delta() const { return delta_; }
+
+  /** Override this method to finish implementing a binary factor */
+  virtual ErrorVector evaluateErrorOnly(const X1& x1, const X2& x2) const = 0;
+
+  /** Evaluates the error, and its Jacobians numerically if requested */
+  virtual Vector evaluateError(const X1& x1, const X2& x2,
+      boost::optional<Matrix&> H1 = boost::none,
+      boost::optional<Matrix&> H2 = boost::none) const {
+    const ErrorVector error = evaluateErrorOnly(x1, x2);
+    if (H1)
+      *H1 = internal::numericalDerivativeFixed<ErrorVector, X1>(Error1(*this, x2), x1, error,
+          delta_);
+    if (H2)
+      *H2 = internal::numericalDerivativeFixed<ErrorVector, X2>(Error2(*this, x1), x2, error,
+          delta_);
+    return error;
+  }
+
+private:
+
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template<class ARCHIVE>
+  void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+    ar & boost::serialization::make_nvp("NoiseModelFactor2",
+        boost::serialization::base_object<Base>(*this));
+    ar & BOOST_SERIALIZATION_NVP(delta_);
+  }
+}; // \class NumericalDerivativeFactor2
+
+} // \namespace gtsam
@@ -0,0 +1,80 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PooledFactorGraph.cpp
+ * @brief   Nonlinear factor graph storing its factors by value, in one pool per concrete type
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/nonlinear/PooledFactorGraph.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/foreach.hpp>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+void PooledFactorGraph::remove(size_t index) {
+  if (!exists(index))
+    throw std::out_of_range("PooledFactorGraph::remove: no factor with this index");
+  Slot& slot = slots_[index];
+  pools_[slot.pool]->remove(slot.position);
+  slot.live = false;
+  --nrFactors_;
+}
+
+/* ************************************************************************* */
+const NonlinearFactor& PooledFactorGraph::at(size_t index) const {
+  if (!exists(index))
+    throw std::out_of_range("PooledFactorGraph::at: no factor with this index");
+  return pools_[slots_[index].pool]->at(slots_[index].position);
+}
+
+/* ************************************************************************* */
+double PooledFactorGraph::error(const Values& c) const {
+  gttic(PooledFactorGraph_error);
+  double total = 0.0;
+  BOOST_FOREACH(const boost::shared_ptr<internal::FactorPoolBase>& pool, pools_)
+    total += pool->error(c);
+  return total;
+}
+
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr PooledFactorGraph::linearize(
+    const Values& linearizationPoint) const {
+  gttic(PooledFactorGraph_linearize);
+  GaussianFactorGraph::shared_ptr linearFG = boost::make_shared<GaussianFactorGraph>();
+  linearFG->resize(slots_.size());
+  BOOST_FOREACH(const boost::shared_ptr<internal::FactorPoolBase>& pool, pools_)
+    pool->linearize(linearizationPoint, *linearFG);
+  return linearFG;
+}
+
+/* ************************************************************************* */
+NonlinearFactorGraph PooledFactorGraph::asNonlinearFactorGraph() const {
+  NonlinearFactorGraph graph;
+  graph.reserve(slots_.size());
+  BOOST_FOREACH(const Slot& slot, slots_) {
+    if (slot.live) {
+      // Aliasing constructor: the factor lives in the pool, which stays alive with it
+      const boost::shared_ptr<internal::FactorPoolBase>& pool = pools_[slot.pool];
+      graph.push_back(NonlinearFactor::shared_ptr(pool,
+          const_cast<NonlinearFactor*>(&pool->at(slot.position))));
+    } else {
+      graph.push_back(NonlinearFactor::shared_ptr());
+    }
+  }
+  return graph;
+}
+
+/* ************************************************************************* */
+} // namespace gtsam
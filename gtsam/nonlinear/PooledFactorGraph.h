@@ -0,0 +1,186 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PooledFactorGraph.h
+ * @brief   Nonlinear factor graph storing its factors by value, in one pool per concrete type
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <deque>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+
+namespace gtsam {
+
+namespace internal {
+
+/// A pool of the factors of one concrete type, type-erased so that a graph can hold several
+class GTSAM_EXPORT FactorPoolBase {
+public:
+  virtual ~FactorPoolBase() {}
+
+  /// The factor at a position in the pool
+  virtual const NonlinearFactor& at(size_t position) const = 0;
+
+  /// Mark the factor at a position as removed
+  virtual void remove(size_t position) = 0;
+
+  /// Sum of the errors of the factors in the pool that were not removed
+  virtual double error(const Values& c) const = 0;
+
+  /// Linearize the factors in the pool, into the slots of result given by their graph indices
+  virtual void linearize(const Values& c, GaussianFactorGraph& result) const = 0;
+};
+
+/// The factors of concrete type FACTOR, stored by value.  A deque keeps them in large
+/// contiguous blocks, and keeps their addresses stable when the pool grows.
+template<class FACTOR>
+class FactorPool : public FactorPoolBase {
+  std::deque<FACTOR> factors_;
+  std::vector<size_t> indices_; ///< Index in the graph of each factor
+  std::vector<bool> live_; ///< False for removed factors
+
+public:
+
+  /// Add a factor with its index in the graph, and return its position in the pool
+  size_t add(const FACTOR& factor, size_t index) {
+    factors_.push_back(factor);
+    indices_.push_back(index);
+    live_.push_back(true);
+    return factors_.size() - 1;
+  }
+
+  virtual const NonlinearFactor& at(size_t position) const {
+    return factors_[position];
+  }
+
+  virtual void remove(size_t position) {
+    live_[position] = false;
+  }
+
+  // The qualified calls below are resolved at compile time, without a virtual dispatch
+  virtual double error(const Values& c) const {
+    double total = 0.0;
+    for (size_t k = 0; k < factors_.size(); ++k) {
+      if (live_[k])
+        total += factors_[k].FACTOR::error(c);
+    }
+    return total;
+  }
+
+  virtual void linearize(const Values& c, GaussianFactorGraph& result) const {
+    for (size_t k = 0; k < factors_.size(); ++k) {
+      if (live_[k])
+        result[indices_[k]] = factors_[k].FACTOR::linearize(c);
+    }
+  }
+};
+
+} // namespace internal
+
+/**
+ * A nonlinear factor graph that groups its factors by concrete type.  NonlinearFactorGraph
+ * stores a shared pointer per factor, so each factor is a separate allocation and each
+ * evaluation is a virtual call, and linearizing a large graph is bound by cache misses.
+ * PooledFactorGraph stores the factors by value, in one pool per concrete type, so factors of
+ * the same type are contiguous in memory, and error() and linearize() iterate over each pool
+ * with calls resolved at compile time.  Note that the nonlinear factors of GTSAM still evaluate
+ * their error through virtual functions internally; it is the per-factor dispatch and the
+ * pointer chasing that are avoided.
+ *
+ * Every factor gets a stable index in the order it was added, which is its slot in the result
+ * of linearize() and in asNonlinearFactorGraph(), also after other factors were removed.  A
+ * factor is added with its static type, which must be its concrete type: adding a factor
+ * through a reference to one of its base classes throws std::invalid_argument.
+ */
+class GTSAM_EXPORT PooledFactorGraph {
+
+public:
+
+  /** Create an empty graph */
+  PooledFactorGraph() : nrFactors_(0) {}
+
+  /**
+   * Add a copy of a factor to the pool of its type, creating the pool if needed.
+   * @return the index of the factor in the graph
+   */
+  template<class FACTOR>
+  size_t add(const FACTOR& factor) {
+    if (typeid(factor) != typeid(FACTOR))
+      throw std::invalid_argument(
+          "PooledFactorGraph::add: the static type of the factor is not its concrete type");
+    size_t p = 0;
+    while (p < pools_.size() && !dynamic_cast<internal::FactorPool<FACTOR>*>(pools_[p].get()))
+      ++p;
+    if (p == pools_.size())
+      pools_.push_back(boost::make_shared<internal::FactorPool<FACTOR> >());
+    internal::FactorPool<FACTOR>& pool = static_cast<internal::FactorPool<FACTOR>&>(*pools_[p]);
+    const size_t index = slots_.size();
+    const Slot slot = { p, pool.add(factor, index), true };
+    slots_.push_back(slot);
+    ++nrFactors_;
+    return index;
+  }
+
+  /** Remove the factor with the given index; the indices of the other factors do not change */
+  void remove(size_t index);
+
+  /** The number of indices given out, including those of removed factors */
+  size_t size() const { return slots_.size(); }
+
+  /** The number of factors that were not removed */
+  size_t nrFactors() const { return nrFactors_; }
+
+  /** The number of pools, i.e., of distinct factor types */
+  size_t nrPools() const { return pools_.size(); }
+
+  /** Whether the factor with the given index exists and was not removed */
+  bool exists(size_t index) const { return index < slots_.size() && slots_[index].live; }
+
+  /** The factor with the given index, throws std::out_of_range if it was removed */
+  const NonlinearFactor& at(size_t index) const;
+
+  /** The total error at \c c, as NonlinearFactorGraph::error */
+  double error(const Values& c) const;
+
+  /** Linearize all factors, with the factor of index i in slot i and null slots for removed
+   *  factors, as NonlinearFactorGraph::linearize */
+  boost::shared_ptr<GaussianFactorGraph> linearize(const Values& linearizationPoint) const;
+
+  /** A NonlinearFactorGraph with the same factors at the same indices.  The factors are not
+   *  copied: they share ownership of the pools with this graph. */
+  NonlinearFactorGraph asNonlinearFactorGraph() const;
+
+private:
+
+  /// Where a factor is stored
+  struct Slot {
+    size_t pool;
+    size_t position;
+    bool live;
+  };
+
+  std::vector<boost::shared_ptr<internal::FactorPoolBase> > pools_;
+  std::vector<Slot> slots_; ///< Indexed by the index of the factor in the graph
+  size_t nrFactors_;
+};
+
+} // namespace gtsam
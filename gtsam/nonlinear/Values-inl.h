@@ -280,7 +280,16 @@ namespace gtsam {
       throw ValuesKeyDoesNotExist("retrieve", j);
 
     // Check the type and throw exception if incorrect
-    const Value& value = *item->second;
+    return Cast<ValueType>(j, *item->second);
+  }
+
+  /* ************************************************************************* */
+  template<typename ValueType>
+  const ValueType& Values::Cast(Key j, const Value& value) {
+    // An exact type match, the common case, only needs a comparison of the type tags instead
+    // of a dynamic_cast
+    if (value.typeTag() == &internal::TypeTag<GenericValue<ValueType> >::id)
+      return static_cast<const GenericValue<ValueType>&>(value).value();
     try {
       return dynamic_cast<const GenericValue<ValueType>&>(value).value();
     } catch (std::bad_cast &) {
@@ -295,13 +304,8 @@ namespace gtsam {
     KeyValueMap::const_iterator item = values_.find(j);
 
     if(item != values_.end()) {
-      // dynamic cast the type and throw exception if incorrect
-      const Value& value = *item->second;
-      try {
-        return dynamic_cast<const GenericValue<ValueType>&>(value).value();
-      } catch (std::bad_cast &) {
-        throw ValuesIncorrectType(j, typeid(value), typeid(ValueType));
-      }
+      // Check the type and throw exception if incorrect
+      return Cast<ValueType>(j, *item->second);
      } else {
       return boost::none;
     }
@@ -24,8 +24,15 @@
 
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <typeinfo>
 #include <list>
+#include <vector>
 
 #include <boost/foreach.hpp>
 #ifdef __GNUC__
@@ -77,38 +84,152 @@ namespace gtsam {
     return values_.find(j) != values_.end();
   }
 
+  /* ************************************************************************* */
+  namespace {
+
+  // Retract values [first, last), or clone them when delta has no entry.  Runs of values of the
+  // same type are retracted together, so types with a batch retraction can vectorize it.
+  void _retractRange(const vector<Key>& keys, const vector<const Value*>& values,
+      const VectorValues& delta, vector<Value*>& result, size_t first, size_t last) {
+    vector<const Vector*> deltas;
+    size_t i = first;
+    while(i < last) {
+      VectorValues::const_iterator vector_item = delta.find(keys[i]);
+      if(vector_item == delta.end()) {
+        result[i] = values[i]->clone_();
+        ++i;
+        continue;
+      }
+      deltas.assign(1, &vector_item->second);
+      size_t end = i + 1;
+      for(; end < last && typeid(*values[end]) == typeid(*values[i]); ++end) {
+        VectorValues::const_iterator next = delta.find(keys[end]);
+        if(next == delta.end())
+          break;
+        deltas.push_back(&next->second);
+      }
+      values[i]->retractBatch_(&values[i], &deltas[0], end - i, &result[i]);
+      i = end;
+    }
+  }
+
+  // Local coordinates of values2 [first, last) around values1
+  void _localCoordinatesRange(const vector<const Value*>& values1,
+      const vector<const Value*>& values2, vector<Vector>& result, size_t first, size_t last) {
+    for(size_t i = first; i < last; ++i)
+      result[i] = values1[i]->localCoordinates_(*values2[i]);
+  }
+
+#ifdef GTSAM_USE_TBB
+  class _RetractValues {
+    const vector<Key>& keys_;
+    const vector<const Value*>& values_;
+    const VectorValues& delta_;
+    vector<Value*>& result_;
+  public:
+    _RetractValues(const vector<Key>& keys, const vector<const Value*>& values,
+        const VectorValues& delta, vector<Value*>& result) :
+        keys_(keys), values_(values), delta_(delta), result_(result) {
+    }
+    void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+      _retractRange(keys_, values_, delta_, result_, blocked_range.begin(), blocked_range.end());
+    }
+  };
+
+  class _LocalCoordinatesOfValues {
+    const vector<const Value*>& values1_;
+    const vector<const Value*>& values2_;
+    vector<Vector>& result_;
+  public:
+    _LocalCoordinatesOfValues(const vector<const Value*>& values1,
+        const vector<const Value*>& values2, vector<Vector>& result) :
+        values1_(values1), values2_(values2), result_(result) {
+    }
+    void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+      _localCoordinatesRange(values1_, values2_, result_, blocked_range.begin(), blocked_range.end());
+    }
+  };
+#endif
+
+  }
+
   /* ************************************************************************* */
   Values Values::retract(const VectorValues& delta) const
   {
-    Values result;
-
+    // Flatten the map so that the retractions can be split into index ranges
+    vector<Key> keys;
+    vector<const Value*> values;
+    keys.reserve(size());
+    values.reserve(size());
     for(const_iterator key_value = begin(); key_value != end(); ++key_value) {
-      VectorValues::const_iterator vector_item = delta.find(key_value->key);
-      Key key = key_value->key;  // Non-const duplicate to deal with non-const insert argument
-      if(vector_item != delta.end()) {
-        const Vector& singleDelta = vector_item->second;
-        Value* retractedValue(key_value->value.retract_(singleDelta)); // Retract
-        result.values_.insert(key, retractedValue); // Add retracted result directly to result values
-      } else {
-        result.values_.insert(key, key_value->value.clone_()); // Add original version to result values
-      }
+      keys.push_back(key_value->key);
+      values.push_back(&key_value->value);
+    }
+
+    // Compute all retracted values into a pre-sized buffer, one slot per key
+    vector<Value*> retracted(size(), NULL);
+    try {
+#ifdef GTSAM_USE_TBB
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, size()),
+          _RetractValues(keys, values, delta, retracted));
+#else
+      _retractRange(keys, values, delta, retracted, 0, size());
+#endif
+    } catch(...) {
+      BOOST_FOREACH(Value* value, retracted)
+        if(value)
+          value->deallocate_();
+      throw;
     }
 
+    // Add the retracted results directly to the result values, in key order
+    Values result;
+    for(size_t i = 0; i < keys.size(); ++i)
+      result.values_.insert(keys[i], retracted[i]);
+
     return result;
   }
 
+  /* ************************************************************************* */
+  void Values::retractInPlace(const VectorValues& delta)
+  {
+    for(VectorValues::const_iterator vector_item = delta.begin(); vector_item != delta.end(); ++vector_item) {
+      KeyValueMap::iterator key_value = values_.find(vector_item->first);
+      if(key_value != values_.end())
+        key_value->second->retractInPlace_(vector_item->second); // Overwrite in place, no allocation
+    }
+  }
+
   /* ************************************************************************* */
   VectorValues Values::localCoordinates(const Values& cp) const {
     if(this->size() != cp.size())
       throw DynamicValuesMismatched();
-    VectorValues result;
+    vector<Key> keys;
+    vector<const Value*> values1, values2;
+    keys.reserve(size());
+    values1.reserve(size());
+    values2.reserve(size());
     for(const_iterator it1=this->begin(), it2=cp.begin(); it1!=this->end(); ++it1, ++it2) {
       if(it1->key != it2->key)
         throw DynamicValuesMismatched(); // If keys do not match
-      // Will throw a dynamic_cast exception if types do not match
-      // NOTE: this is separate from localCoordinates(cp, ordering, result) due to at() vs. insert
-      result.insert(it1->key, it1->value.localCoordinates_(it2->value));
+      keys.push_back(it1->key);
+      values1.push_back(&it1->value);
+      values2.push_back(&it2->value);
     }
+
+    // Will throw a dynamic_cast exception if types do not match
+    vector<Vector> deltas(size());
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, size()),
+        _LocalCoordinatesOfValues(values1, values2, deltas));
+#else
+    _localCoordinatesRange(values1, values2, deltas, 0, size());
+#endif
+
+    // NOTE: this is separate from localCoordinates(cp, ordering, result) due to at() vs. insert
+    VectorValues result;
+    for(size_t i = 0; i < keys.size(); ++i)
+      result.insert(keys[i], deltas[i]);
     return result;
   }
 
@@ -141,6 +262,31 @@ namespace gtsam {
     return *item->second;
   }
 
+  /* ************************************************************************* */
+  void Values::at(const KeyVector& keys, const Value** values) const {
+    // Keys of a factor are often adjacent in the map, e.g. successive poses, so try a few
+    // steps from the previous key before searching the map
+    static const size_t kMaxSteps = 2;
+    KeyValueMap::const_iterator item = values_.end();
+    for (size_t i = 0; i < keys.size(); ++i) {
+      const Key j = keys[i];
+      size_t steps = 0;
+      while (steps < kMaxSteps && item != values_.end() && item->first < j) {
+        ++item;
+        ++steps;
+      }
+      if (steps == 0 || item == values_.end() || item->first != j)
+        item = values_.find(j);
+      if (item == values_.end())
+        throw ValuesKeyDoesNotExist("retrieve", j);
+      values[i] = item->second;
+#ifdef __GNUC__
+      // Start loading the value while the next key is looked up
+      __builtin_prefetch(item->second);
+#endif
+    }
+  }
+
   /* ************************************************************************* */
   void Values::insert(Key j, const Value& val) {
     std::pair<iterator,bool> insertResult = tryInsert(j, val);
@@ -235,6 +381,15 @@ namespace gtsam {
     return result;
   }
 
+  /* ************************************************************************* */
+  size_t Values::memoryUsage() const {
+    size_t result = sizeof(Values) + mapNodeBytes(size(), sizeof(std::pair<const Key, void*>));
+    BOOST_FOREACH(const ConstKeyValuePair& key_value, *this) {
+      result += key_value.value.memoryUsage();
+    }
+    return result;
+  }
+
   /* ************************************************************************* */
   VectorValues Values::zeroVectors() const {
     VectorValues result;
@@ -189,6 +189,20 @@ namespace gtsam {
      */
     const Value& at(Key j) const;
 
+    /** Retrieve the variables of several keys at once, e.g. of all keys of a factor, writing a
+     * pointer to the value of \c keys[i] to \c values[i].  Keys following their predecessor in
+     * \c keys are reached by stepping through the map instead of searching it, and the values
+     * are prefetched, so resolving all keys first and casting them with Cast() afterwards is
+     * cheaper than calling at() for each key.
+     * @throw ValuesKeyDoesNotExist if a key does not exist
+     */
+    void at(const KeyVector& keys, const Value** values) const;
+
+    /** Cast a value retrieved for key \c j to its type, the check done by at<ValueType>(j).
+     * Throws ValuesIncorrectType if the type of the value is not \c ValueType. */
+    template<typename ValueType>
+    static const ValueType& Cast(Key j, const Value& value);
+
     /** Check if a value exists with key \c j.  See exists<>(Key j)
      * and exists(const TypedKey& j) for versions that return the value if it
      * exists. */
@@ -242,6 +256,10 @@ namespace gtsam {
     /** Add a delta config to current config and returns a new config */
     Values retract(const VectorValues& delta) const;
 
+    /** Add a delta config to the current config in place, without copying or
+     * allocating any values.  Keys missing from \c delta are left unchanged. */
+    void retractInPlace(const VectorValues& delta);
+
     /** Get a delta config about a linearization point c0 (*this) */
     VectorValues localCoordinates(const Values& cp) const;
 
@@ -306,6 +324,10 @@ namespace gtsam {
     /** Compute the total dimensionality of all values (\f$ O(n) \f$) */
     size_t dim() const;
 
+    /** Return the memory used by the values and the map holding them, in bytes, see MemoryUsage
+     * (\f$ O(n) \f$) */
+    size_t memoryUsage() const;
+
     /** Return a VectorValues of zero vectors for each variable in this Values */
     VectorValues zeroVectors() const;
 
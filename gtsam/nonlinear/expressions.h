@@ -24,6 +24,12 @@ Expression<T> compose(const Expression<T>& t1, const Expression<T>& t2) {
   return Expression<T>(traits<T>::Compose, t1, t2);
 }
 
+// Generics
+template<typename T>
+Expression<T> inverse(const Expression<T>& t) {
+  return Expression<T>(traits<T>::Inverse, t);
+}
+
 typedef Expression<double> double_;
 typedef Expression<Vector3> Vector3_;
 
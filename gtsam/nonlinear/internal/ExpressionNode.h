@@ -21,7 +21,12 @@
 
 #include <gtsam/nonlinear/internal/ExecutionTrace.h>
 #include <gtsam/nonlinear/internal/CallRecord.h>
+#include <gtsam/nonlinear/internal/ExpressionTape.h>
+#include <gtsam/nonlinear/LinearizationPass.h>
 #include <gtsam/nonlinear/Values.h>
+#include <gtsam/base/ScratchBuffer.h>
+
+#include <boost/make_shared.hpp>
 
 #include <typeinfo>       // operator typeid
 #include <ostream>
@@ -111,6 +116,9 @@ public:
   /// Construct an execution trace for reverse AD
   virtual T traceExecution(const Values& values, ExecutionTrace<T>& trace,
       ExecutionTraceStorage* traceStorage) const = 0;
+
+  /// Append the instructions computing this expression to a tape, returns the last one
+  virtual size_t compile(ExpressionTape& tape) const = 0;
 };
 
 //-----------------------------------------------------------------------------
@@ -149,6 +157,24 @@ public:
       ExecutionTraceStorage* traceStorage) const {
     return constant_;
   }
+
+  /// Copy the constant into the tape buffer
+  static void Forward(const TapeInstruction& instruction, const Values& values, char* buffer,
+      bool withJacobians) {
+    const ConstantExpression* node = static_cast<const ConstantExpression*>(instruction.node);
+    new (buffer + instruction.value) T(node->constant_);
+  }
+
+  /// Compile into a tape
+  virtual size_t compile(ExpressionTape& tape) const {
+    size_t index;
+    if (tape.lookup(this, index))
+      return index;
+    TapeInstruction instruction(&Forward, &TapeReverseNothing, &TapeDestroy<T>, this);
+    instruction.value = tape.allocate(sizeof(T));
+    instruction.adjoint = tape.allocateAdjoint(traits<T>::dimension);
+    return tape.push_back(instruction);
+  }
 };
 
 //-----------------------------------------------------------------------------
@@ -202,6 +228,33 @@ public:
     return values.at<T>(key_);
   }
 
+  /// Copy the value of the key into the tape buffer
+  static void Forward(const TapeInstruction& instruction, const Values& values, char* buffer,
+      bool withJacobians) {
+    new (buffer + instruction.value) T(values.at<T>(instruction.key));
+  }
+
+  /// Reverse AD ends here, by adding dF/dT to the Jacobian block of the key
+  static void Reverse(const TapeInstruction& instruction, DenseIndex rows, const char* buffer,
+      double* adjoints, VerticalBlockMatrix& Ab) {
+    Ab(instruction.block) += Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic,
+        traits<T>::dimension> >(adjoints + instruction.adjoint * rows, rows,
+        traits<T>::dimension);
+  }
+
+  /// Compile into a tape
+  virtual size_t compile(ExpressionTape& tape) const {
+    size_t index;
+    if (tape.lookup(this, index))
+      return index;
+    TapeInstruction instruction(&Forward, &Reverse, &TapeDestroy<T>, this);
+    instruction.leaf = true;
+    instruction.key = key_;
+    instruction.value = tape.allocate(sizeof(T));
+    instruction.adjoint = tape.allocateAdjoint(traits<T>::dimension);
+    return tape.push_back(instruction);
+  }
+
 };
 
 //-----------------------------------------------------------------------------
@@ -324,6 +377,39 @@ public:
     // Finally, the function call fills in the Jacobian dTdA1
     return function_(record->value1, record->dTdA1);
   }
+
+  /// Call the function on the argument in the tape buffer
+  static void Forward(const TapeInstruction& instruction, const Values& values, char* buffer,
+      bool withJacobians) {
+    const UnaryExpression* node = static_cast<const UnaryExpression*>(instruction.node);
+    const A1& a1 = TapeValue<A1>(buffer, instruction.arguments[0]);
+    if (withJacobians)
+      new (buffer + instruction.value) T(node->function_(a1,
+          TapeJacobian<T, A1>(buffer, instruction.jacobians[0])));
+    else
+      new (buffer + instruction.value) T(node->function_(a1, boost::none));
+  }
+
+  /// Multiply in dT/dA1 and pass on to the argument
+  static void Reverse(const TapeInstruction& instruction, DenseIndex rows, const char* buffer,
+      double* adjoints, VerticalBlockMatrix& Ab) {
+    TapeReverseArgument<T, A1>(instruction, 0, rows, buffer, adjoints);
+  }
+
+  /// Compile the argument and then this function into a tape
+  virtual size_t compile(ExpressionTape& tape) const {
+    size_t index;
+    if (tape.lookup(this, index))
+      return index;
+    TapeInstruction instruction(&Forward, &Reverse, &TapeDestroy<T>, this);
+    const size_t i1 = expression1_->compile(tape);
+    instruction.arguments[0] = tape[i1].value;
+    instruction.argumentAdjoints[0] = tape[i1].adjoint;
+    instruction.value = tape.allocate(sizeof(T));
+    instruction.jacobians[0] = tape.allocate(sizeof(typename Jacobian<T, A1>::type));
+    instruction.adjoint = tape.allocateAdjoint(traits<T>::dimension);
+    return tape.push_back(instruction);
+  }
 };
 
 //-----------------------------------------------------------------------------
@@ -427,6 +513,46 @@ public:
     trace.setFunction(record);
     return function_(record->value1, record->value2, record->dTdA1, record->dTdA2);
   }
+
+  /// Call the function on the arguments in the tape buffer
+  static void Forward(const TapeInstruction& instruction, const Values& values, char* buffer,
+      bool withJacobians) {
+    const BinaryExpression* node = static_cast<const BinaryExpression*>(instruction.node);
+    const A1& a1 = TapeValue<A1>(buffer, instruction.arguments[0]);
+    const A2& a2 = TapeValue<A2>(buffer, instruction.arguments[1]);
+    if (withJacobians)
+      new (buffer + instruction.value) T(node->function_(a1, a2,
+          TapeJacobian<T, A1>(buffer, instruction.jacobians[0]),
+          TapeJacobian<T, A2>(buffer, instruction.jacobians[1])));
+    else
+      new (buffer + instruction.value) T(node->function_(a1, a2, boost::none, boost::none));
+  }
+
+  /// Multiply in dT/dA1 and dT/dA2 and pass on to the arguments
+  static void Reverse(const TapeInstruction& instruction, DenseIndex rows, const char* buffer,
+      double* adjoints, VerticalBlockMatrix& Ab) {
+    TapeReverseArgument<T, A1>(instruction, 0, rows, buffer, adjoints);
+    TapeReverseArgument<T, A2>(instruction, 1, rows, buffer, adjoints);
+  }
+
+  /// Compile the arguments and then this function into a tape
+  virtual size_t compile(ExpressionTape& tape) const {
+    size_t index;
+    if (tape.lookup(this, index))
+      return index;
+    TapeInstruction instruction(&Forward, &Reverse, &TapeDestroy<T>, this);
+    const size_t i1 = expression1_->compile(tape);
+    instruction.arguments[0] = tape[i1].value;
+    instruction.argumentAdjoints[0] = tape[i1].adjoint;
+    const size_t i2 = expression2_->compile(tape);
+    instruction.arguments[1] = tape[i2].value;
+    instruction.argumentAdjoints[1] = tape[i2].adjoint;
+    instruction.value = tape.allocate(sizeof(T));
+    instruction.jacobians[0] = tape.allocate(sizeof(typename Jacobian<T, A1>::type));
+    instruction.jacobians[1] = tape.allocate(sizeof(typename Jacobian<T, A2>::type));
+    instruction.adjoint = tape.allocateAdjoint(traits<T>::dimension);
+    return tape.push_back(instruction);
+  }
 };
 
 //-----------------------------------------------------------------------------
@@ -545,6 +671,246 @@ public:
     return function_(record->value1, record->value2, record->value3,
         record->dTdA1, record->dTdA2, record->dTdA3);
   }
+
+  /// Call the function on the arguments in the tape buffer
+  static void Forward(const TapeInstruction& instruction, const Values& values, char* buffer,
+      bool withJacobians) {
+    const TernaryExpression* node = static_cast<const TernaryExpression*>(instruction.node);
+    const A1& a1 = TapeValue<A1>(buffer, instruction.arguments[0]);
+    const A2& a2 = TapeValue<A2>(buffer, instruction.arguments[1]);
+    const A3& a3 = TapeValue<A3>(buffer, instruction.arguments[2]);
+    if (withJacobians)
+      new (buffer + instruction.value) T(node->function_(a1, a2, a3,
+          TapeJacobian<T, A1>(buffer, instruction.jacobians[0]),
+          TapeJacobian<T, A2>(buffer, instruction.jacobians[1]),
+          TapeJacobian<T, A3>(buffer, instruction.jacobians[2])));
+    else
+      new (buffer + instruction.value) T(node->function_(a1, a2, a3, boost::none, boost::none,
+          boost::none));
+  }
+
+  /// Multiply in dT/dA1, dT/dA2 and dT/dA3 and pass on to the arguments
+  static void Reverse(const TapeInstruction& instruction, DenseIndex rows, const char* buffer,
+      double* adjoints, VerticalBlockMatrix& Ab) {
+    TapeReverseArgument<T, A1>(instruction, 0, rows, buffer, adjoints);
+    TapeReverseArgument<T, A2>(instruction, 1, rows, buffer, adjoints);
+    TapeReverseArgument<T, A3>(instruction, 2, rows, buffer, adjoints);
+  }
+
+  /// Compile the arguments and then this function into a tape
+  virtual size_t compile(ExpressionTape& tape) const {
+    size_t index;
+    if (tape.lookup(this, index))
+      return index;
+    TapeInstruction instruction(&Forward, &Reverse, &TapeDestroy<T>, this);
+    const size_t i1 = expression1_->compile(tape);
+    instruction.arguments[0] = tape[i1].value;
+    instruction.argumentAdjoints[0] = tape[i1].adjoint;
+    const size_t i2 = expression2_->compile(tape);
+    instruction.arguments[1] = tape[i2].value;
+    instruction.argumentAdjoints[1] = tape[i2].adjoint;
+    const size_t i3 = expression3_->compile(tape);
+    instruction.arguments[2] = tape[i3].value;
+    instruction.argumentAdjoints[2] = tape[i3].adjoint;
+    instruction.value = tape.allocate(sizeof(T));
+    instruction.jacobians[0] = tape.allocate(sizeof(typename Jacobian<T, A1>::type));
+    instruction.jacobians[1] = tape.allocate(sizeof(typename Jacobian<T, A2>::type));
+    instruction.jacobians[2] = tape.allocate(sizeof(typename Jacobian<T, A3>::type));
+    instruction.adjoint = tape.allocateAdjoint(traits<T>::dimension);
+    return tape.push_back(instruction);
+  }
+};
+
+//-----------------------------------------------------------------------------
+/**
+ * Shareable Expression, see Expression::shareable.  Inside a LinearizationPass, the value of the
+ * wrapped expression and its Jacobians with respect to its keys are computed once per thread and
+ * cached, and reverse AD multiplies dF/dT into the cached Jacobians instead of tracing the wrapped
+ * expression again.  Outside a pass it evaluates the wrapped expression every time.
+ */
+template<class T>
+class SharedExpression: public ExpressionNode<T> {
+
+  static const int Dim = traits<T>::dimension;
+
+  boost::shared_ptr<ExpressionNode<T> > expression_;
+  KeyVector keys_; ///< Keys of the wrapped expression, in increasing order
+  FastVector<int> dims_; ///< Dimensions of the keys
+
+  /// Value of the wrapped expression, and its Jacobians if they were asked for
+  struct Entry: public SharedExpressionEntry {
+    T value;
+    std::vector<Matrix> jacobians;
+  };
+  typedef boost::shared_ptr<const Entry> EntryPointer;
+
+  /// Constructor, wrapping an expression
+  explicit SharedExpression(const boost::shared_ptr<ExpressionNode<T> >& expression) :
+      expression_(expression) {
+    std::map<Key, int> map;
+    expression_->dims(map);
+    for (std::map<Key, int>::const_iterator it = map.begin(); it != map.end(); ++it) {
+      keys_.push_back(it->first);
+      dims_.push_back(it->second);
+    }
+    ExpressionNode<T>::traceSize_ = upAligned(sizeof(Record)) + expression_->traceSize();
+  }
+
+  friend class Expression<T>;
+
+  /// Evaluate the wrapped expression, and optionally its Jacobians
+  boost::shared_ptr<Entry> compute(const Values& values, bool withJacobians) const {
+    boost::shared_ptr<Entry> entry = boost::allocate_shared<Entry>(
+        Eigen::aligned_allocator<Entry>());
+    if (!withJacobians) {
+      entry->value = expression_->value(values);
+      return entry;
+    }
+    VerticalBlockMatrix Ab(dims_, Dim);
+    Ab.matrix().setZero();
+    JacobianMap jacobians(keys_, Ab);
+    ScratchBuffer::Lease scratch(expression_->traceSize() * sizeof(ExecutionTraceStorage));
+    ExecutionTrace<T> trace;
+    entry->value = expression_->traceExecution(values, trace,
+        reinterpret_cast<ExecutionTraceStorage*>(scratch.data()));
+    trace.startReverseAD1(jacobians);
+    entry->jacobians.reserve(keys_.size());
+    for (size_t i = 0; i < keys_.size(); ++i)
+      entry->jacobians.push_back(Ab(i));
+    return entry;
+  }
+
+  /// The entry at values, from the cache inside a LinearizationPass
+  EntryPointer entry(const Values& values, bool withJacobians) const {
+    boost::shared_ptr<SharedExpressionEntry>* cached = sharedExpressionEntry(this, values);
+    if (!cached)
+      return compute(values, withJacobians);
+    if (!*cached)
+      *cached = compute(values, true);
+    return boost::static_pointer_cast<const Entry>(*cached);
+  }
+
+public:
+
+  /// Destructor
+  virtual ~SharedExpression() {
+  }
+
+  /// Print
+  virtual void print(const std::string& indent = "") const {
+    std::cout << indent << "SharedExpression" << std::endl;
+    expression_->print(indent + "  ");
+  }
+
+  /// Return value
+  virtual T value(const Values& values) const {
+    return expression_->value(values);
+  }
+
+  /// Return keys that play in this expression
+  virtual std::set<Key> keys() const {
+    return std::set<Key>(keys_.begin(), keys_.end());
+  }
+
+  /// Return dimensions for each argument
+  virtual void dims(std::map<Key, int>& map) const {
+    for (size_t i = 0; i < keys_.size(); ++i)
+      map[keys_[i]] = dims_[i];
+  }
+
+  // Inner Record Class, pointing to a cached entry
+  struct Record: public CallRecordImplementor<Record, Dim> {
+
+    const SharedExpression* node;
+    const Entry* entry;
+
+    /// Print to std::cout
+    void print(const std::string& indent) const {
+      std::cout << indent << "SharedExpression::Record" << std::endl;
+    }
+
+    /// Start the reverse AD process
+    void startReverseAD4(JacobianMap& jacobians) const {
+      for (size_t i = 0; i < node->keys_.size(); ++i)
+        jacobians(node->keys_[i]) += entry->jacobians[i];
+    }
+
+    /// Given df/dT, multiply in the cached dT/dkey for every key
+    template<typename SomeMatrix>
+    void reverseAD4(const SomeMatrix & dFdT, JacobianMap& jacobians) const {
+      for (size_t i = 0; i < node->keys_.size(); ++i)
+        jacobians(node->keys_[i]) += dFdT * entry->jacobians[i];
+    }
+  };
+
+  /// Construct an execution trace for reverse AD, ending at the cached Jacobians in a pass
+  virtual T traceExecution(const Values& values, ExecutionTrace<T>& trace,
+      ExecutionTraceStorage* ptr) const {
+    boost::shared_ptr<SharedExpressionEntry>* cached = sharedExpressionEntry(this, values);
+    if (!cached)
+      return expression_->traceExecution(values, trace, ptr);
+    if (!*cached)
+      *cached = compute(values, true);
+
+    // The cache owns the entry until the next pass, so the record need not
+    Record* record = new (ptr) Record();
+    record->node = this;
+    record->entry = static_cast<const Entry*>(cached->get());
+    trace.setFunction(record);
+    return record->entry->value;
+  }
+
+  /// Look up or compute the entry, and keep it alive in the tape buffer
+  static void Forward(const TapeInstruction& instruction, const Values& values, char* buffer,
+      bool withJacobians) {
+    const SharedExpression* node = static_cast<const SharedExpression*>(instruction.node);
+    const EntryPointer entry = node->entry(values, withJacobians);
+    new (buffer + instruction.value) T(entry->value);
+    new (buffer + instruction.jacobians[0]) EntryPointer(entry);
+  }
+
+  /// Multiply in the cached dT/dkey and pass on to the leaf of every key
+  static void Reverse(const TapeInstruction& instruction, DenseIndex rows, const char* buffer,
+      double* adjoints, VerticalBlockMatrix& Ab) {
+    const SharedExpression* node = static_cast<const SharedExpression*>(instruction.node);
+    const Entry& entry = **reinterpret_cast<const EntryPointer*>(buffer + instruction.jacobians[0]);
+    Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Dim> > dFdT(
+        adjoints + instruction.adjoint * rows, rows, Dim);
+    size_t adjoint = instruction.argumentAdjoints[0];
+    for (size_t i = 0; i < node->keys_.size(); ++i) {
+      Eigen::Map<Matrix>(adjoints + adjoint * rows, rows, node->dims_[i]).noalias() +=
+          dFdT * entry.jacobians[i];
+      adjoint += node->dims_[i];
+    }
+  }
+
+  /// Destroy the value and release the entry
+  static void Destroy(const TapeInstruction& instruction, char* buffer) {
+    reinterpret_cast<EntryPointer*>(buffer + instruction.jacobians[0])->~EntryPointer();
+    TapeDestroy<T>(instruction, buffer);
+  }
+
+  /// Compile into a tape: a leaf for every key, with consecutive adjoints, then this node
+  virtual size_t compile(ExpressionTape& tape) const {
+    size_t index;
+    if (tape.lookup(this, index))
+      return index;
+    TapeInstruction instruction(&Forward, &Reverse, &Destroy, this);
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      TapeInstruction leaf(&TapeForwardNothing, &TapeReverseKey, &TapeDestroyNothing, this);
+      leaf.leaf = true;
+      leaf.key = keys_[i];
+      leaf.dimension = dims_[i];
+      leaf.adjoint = tape.allocateAdjoint(dims_[i]);
+      if (i == 0)
+        instruction.argumentAdjoints[0] = leaf.adjoint;
+      tape.push_back(leaf);
+    }
+    instruction.value = tape.allocate(sizeof(T));
+    instruction.jacobians[0] = tape.allocate(sizeof(EntryPointer));
+    instruction.adjoint = tape.allocateAdjoint(Dim);
+    return tape.push_back(instruction);
+  }
 };
 
 } // namespace internal
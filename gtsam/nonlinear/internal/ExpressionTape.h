@@ -0,0 +1,369 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ExpressionTape.h
+ * @date Oct 15, 2026
+ * @brief An expression tree flattened into a linear tape of instructions
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/internal/ExecutionTrace.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/base/VerticalBlockMatrix.h>
+#include <gtsam/base/ScratchBuffer.h>
+
+#include <boost/foreach.hpp>
+
+#include <map>
+#include <new>
+#include <vector>
+
+namespace gtsam {
+namespace internal {
+
+template<class T> class ExpressionNode;
+
+/**
+ * One instruction of an ExpressionTape: it computes the value of one expression node from the
+ * values of its arguments, and in reverse AD passes the derivative of the root with respect to
+ * the node on to its arguments.
+ *
+ * Values and local Jacobians live in a byte buffer, and derivatives with respect to the nodes
+ * ("adjoints") in a buffer of doubles, all at offsets fixed when the tape is built.  The
+ * functions are plain function pointers instantiated by the node types, so executing a tape
+ * involves no virtual calls.
+ */
+struct TapeInstruction {
+
+  typedef void (*Forward)(const TapeInstruction& instruction, const Values& values,
+      char* buffer, bool withJacobians);
+  typedef void (*Reverse)(const TapeInstruction& instruction, DenseIndex rows,
+      const char* buffer, double* adjoints, VerticalBlockMatrix& Ab);
+  typedef void (*Destroy)(const TapeInstruction& instruction, char* buffer);
+
+  Forward forward; ///< Compute the value, and optionally the local Jacobians
+  Reverse reverse; ///< Multiply the adjoint into the adjoints of the arguments
+  Destroy destroy; ///< Destroy the value
+  const void* node; ///< The ExpressionNode this instruction was compiled from
+
+  bool leaf; ///< Whether this is a leaf, i.e., an unknown
+  Key key; ///< Key of a leaf
+  DenseIndex block; ///< Block of a leaf in the Jacobian
+  int dimension; ///< Dimension of a leaf compiled by a shareable expression, see TapeReverseKey
+
+  size_t value; ///< Byte offset of the value
+  size_t adjoint; ///< Offset, in columns, of the adjoint
+  size_t arguments[3]; ///< Byte offsets of the values of the arguments
+  size_t argumentAdjoints[3]; ///< Offsets, in columns, of the adjoints of the arguments
+  size_t jacobians[3]; ///< Byte offsets of the Jacobians with respect to the arguments
+
+  /// Construct an instruction for the given node
+  TapeInstruction(Forward f, Reverse r, Destroy d, const void* n) :
+      forward(f), reverse(r), destroy(d), node(n), leaf(false), key(0), block(0), dimension(0),
+      value(0), adjoint(0) {
+    for (size_t i = 0; i < 3; ++i)
+      arguments[i] = argumentAdjoints[i] = jacobians[i] = 0;
+  }
+};
+
+/// Value of type T at a byte offset in the buffer
+template<class T>
+const T& TapeValue(const char* buffer, size_t offset) {
+  return *reinterpret_cast<const T*>(buffer + offset);
+}
+
+/// Fixed-size Jacobian of T with respect to A at a byte offset in the buffer
+template<class T, class A>
+Eigen::Matrix<double, traits<T>::dimension, traits<A>::dimension>& TapeJacobian(char* buffer,
+    size_t offset) {
+  return *reinterpret_cast<Eigen::Matrix<double, traits<T>::dimension, traits<A>::dimension>*>(
+      buffer + offset);
+}
+
+/// Destroy the value of type T of an instruction
+template<class T>
+void TapeDestroy(const TapeInstruction& instruction, char* buffer) {
+  reinterpret_cast<T*>(buffer + instruction.value)->~T();
+}
+
+/// Reverse AD for an instruction without arguments
+inline void TapeReverseNothing(const TapeInstruction&, DenseIndex, const char*, double*,
+    VerticalBlockMatrix&) {
+}
+
+/// Forward pass for an instruction without a value
+inline void TapeForwardNothing(const TapeInstruction&, const Values&, char*, bool) {
+}
+
+/// Destroy nothing, for an instruction without a value
+inline void TapeDestroyNothing(const TapeInstruction&, char*) {
+}
+
+/// Reverse AD ends at a leaf whose dimension is only known at run time, by adding dF/dT to the
+/// Jacobian block of the key
+inline void TapeReverseKey(const TapeInstruction& instruction, DenseIndex rows,
+    const char*, double* adjoints, VerticalBlockMatrix& Ab) {
+  Ab(instruction.block) += Eigen::Map<const Matrix>(adjoints + instruction.adjoint * rows, rows,
+      instruction.dimension);
+}
+
+/// Given dF/dT of an instruction, add dF/dT * dT/dA to the adjoint of its i-th argument
+template<class T, class A>
+void TapeReverseArgument(const TapeInstruction& instruction, size_t i, DenseIndex rows,
+    const char* buffer, double* adjoints) {
+  static const int DimT = traits<T>::dimension, DimA = traits<A>::dimension;
+  Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, DimT> > dFdT(
+      adjoints + instruction.adjoint * rows, rows, DimT);
+  Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, DimA> > dFdA(
+      adjoints + instruction.argumentAdjoints[i] * rows, rows, DimA);
+  dFdA.noalias() += dFdT
+      * *reinterpret_cast<const Eigen::Matrix<double, DimT, DimA>*>(
+          buffer + instruction.jacobians[i]);
+}
+
+/**
+ * An ExpressionTape is an expression tree compiled into a topologically ordered list of
+ * instructions, see TapeInstruction.  A subexpression that occurs several times in the tree is
+ * compiled, and evaluated, only once.  Evaluation runs the instructions forward, and reverse AD
+ * runs them backward, writing the Jacobians straight into the blocks of a VerticalBlockMatrix
+ * ordered by key, as in ExpressionFactor.
+ *
+ * Expressions of dynamically sized types cannot be compiled, see valid().
+ */
+class ExpressionTape {
+
+  std::vector<TapeInstruction> instructions_;
+  std::map<const void*, size_t> compiled_; ///< Instruction of each node, while compiling
+  size_t valueSize_; ///< Size of the value buffer, in bytes
+  size_t adjointSize_; ///< Number of columns of the adjoints
+  DenseIndex rows_; ///< Dimension of the root
+  bool valid_;
+
+public:
+
+  /// Compile the expression rooted at root
+  template<typename T>
+  explicit ExpressionTape(const ExpressionNode<T>& root) :
+      valueSize_(0), adjointSize_(0), rows_(traits<T>::dimension), valid_(
+          traits<T>::dimension != Eigen::Dynamic) {
+    root.compile(*this);
+    compiled_.clear();
+
+    // Number the leaves in key order, as their blocks in the Jacobian
+    std::map<Key, DenseIndex> blocks;
+    BOOST_FOREACH(const TapeInstruction& instruction, instructions_) {
+      if (instruction.leaf)
+        blocks[instruction.key] = 0;
+    }
+    DenseIndex block = 0;
+    for (std::map<Key, DenseIndex>::iterator it = blocks.begin(); it != blocks.end(); ++it)
+      it->second = block++;
+    BOOST_FOREACH(TapeInstruction& instruction, instructions_) {
+      if (instruction.leaf)
+        instruction.block = blocks[instruction.key];
+    }
+  }
+
+  /// Whether the expression could be compiled
+  bool valid() const {
+    return valid_;
+  }
+
+  /// Number of instructions
+  size_t size() const {
+    return instructions_.size();
+  }
+
+  /**
+   * Evaluate the expression, and if Ab is given add the Jacobians with respect to the keys, in
+   * key order, to its first blocks.  T has to be the type of the root.
+   */
+  template<typename T>
+  T evaluate(const Values& values, VerticalBlockMatrix* Ab = 0) const {
+    const size_t adjointBytes = Ab ? adjointSize_ * rows_ * sizeof(double) : 0;
+
+    // Values, Jacobians and adjoints all live in the per-thread scratch buffer
+    ScratchBuffer::Lease scratch(valueSize_ + adjointBytes);
+    char* buffer = scratch.data();
+
+    // Forward pass, destroying what was computed if a function throws
+    size_t n = 0;
+    try {
+      for (; n < instructions_.size(); ++n)
+        instructions_[n].forward(instructions_[n], values, buffer, Ab != 0);
+    } catch (...) {
+      destroy(buffer, n);
+      throw;
+    }
+    const T result = TapeValue<T>(buffer, instructions_.back().value);
+
+    // Reverse pass, starting with dT/dT = I at the root
+    if (Ab) {
+      double* adjoints = reinterpret_cast<double*>(buffer + valueSize_);
+      std::fill(adjoints, adjoints + adjointSize_ * rows_, 0.0);
+      Eigen::Map<Matrix>(adjoints + instructions_.back().adjoint * rows_, rows_, rows_).setIdentity();
+      for (size_t i = instructions_.size(); i-- > 0;)
+        instructions_[i].reverse(instructions_[i], rows_, buffer, adjoints, *Ab);
+    }
+
+    destroy(buffer, n);
+    return result;
+  }
+
+  /// Size of the buffer one tape needs in EvaluateBatch, in bytes, keeping the next one aligned
+  size_t batchBufferSize() const {
+    const size_t bytes = valueSize_ + adjointSize_ * rows_ * sizeof(double);
+    return (bytes + TraceAlignment - 1) / TraceAlignment * TraceAlignment;
+  }
+
+  /// Byte offset of the value of the root in the buffer
+  size_t rootValue() const {
+    return instructions_.back().value;
+  }
+
+  /**
+   * Whether both tapes execute the same functions on the same buffer layout, e.g. because they
+   * were compiled from the same expression template with different keys and constants.
+   */
+  bool sameStructure(const ExpressionTape& other) const {
+    if (rows_ != other.rows_ || valueSize_ != other.valueSize_
+        || adjointSize_ != other.adjointSize_ || instructions_.size() != other.instructions_.size())
+      return false;
+    for (size_t i = 0; i < instructions_.size(); ++i) {
+      const TapeInstruction& a = instructions_[i];
+      const TapeInstruction& b = other.instructions_[i];
+      if (a.forward != b.forward || a.reverse != b.reverse || a.leaf != b.leaf
+          || a.block != b.block || a.dimension != b.dimension || a.value != b.value
+          || a.adjoint != b.adjoint)
+        return false;
+      for (size_t j = 0; j < 3; ++j) {
+        if (a.arguments[j] != b.arguments[j] || a.argumentAdjoints[j] != b.argumentAdjoints[j]
+            || a.jacobians[j] != b.jacobians[j])
+          return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Evaluate a batch of tapes of the same structure, see sameStructure.  Each instruction is run
+   * for all tapes before moving on to the next one, so the same function is called back to back
+   * on buffers laid out alike.  Tape k works in buffer + k * batchBufferSize(), where the value
+   * of its root is left at rootValue() until DestroyBatch is called.  If Abs is not empty, the
+   * Jacobians of tape k are added to *Abs[k] as in evaluate.
+   */
+  static void EvaluateBatch(const std::vector<const ExpressionTape*>& tapes, const Values& values,
+      char* buffer, const std::vector<VerticalBlockMatrix*>& Abs) {
+    if (tapes.empty())
+      return;
+    const ExpressionTape& first = *tapes.front();
+    const size_t n = tapes.size(), stride = first.batchBufferSize();
+    const bool withJacobians = !Abs.empty();
+
+    // Forward pass, destroying what was computed if a function throws
+    size_t i = 0, k = 0;
+    try {
+      for (; i < first.instructions_.size(); ++i) {
+        for (k = 0; k < n; ++k)
+          tapes[k]->instructions_[i].forward(tapes[k]->instructions_[i], values,
+              buffer + k * stride, withJacobians);
+      }
+    } catch (...) {
+      for (size_t m = 0; m < n; ++m)
+        tapes[m]->destroy(buffer + m * stride, m < k ? i + 1 : i);
+      throw;
+    }
+
+    // Reverse pass, starting with dT/dT = I at each root
+    if (withJacobians) {
+      const DenseIndex rows = first.rows_;
+      for (k = 0; k < n; ++k) {
+        double* adjoints = reinterpret_cast<double*>(buffer + k * stride + first.valueSize_);
+        std::fill(adjoints, adjoints + first.adjointSize_ * rows, 0.0);
+        Eigen::Map<Matrix>(adjoints + first.instructions_.back().adjoint * rows, rows, rows)
+            .setIdentity();
+      }
+      for (i = first.instructions_.size(); i-- > 0;) {
+        for (k = 0; k < n; ++k) {
+          char* own = buffer + k * stride;
+          tapes[k]->instructions_[i].reverse(tapes[k]->instructions_[i], rows, own,
+              reinterpret_cast<double*>(own + first.valueSize_), *Abs[k]);
+        }
+      }
+    }
+  }
+
+  /// Destroy the values left by EvaluateBatch
+  static void DestroyBatch(const std::vector<const ExpressionTape*>& tapes, char* buffer) {
+    if (tapes.empty())
+      return;
+    const size_t stride = tapes.front()->batchBufferSize();
+    for (size_t k = 0; k < tapes.size(); ++k)
+      tapes[k]->destroy(buffer + k * stride, tapes[k]->instructions_.size());
+  }
+
+  /// @name Used by ExpressionNode::compile
+  /// @{
+
+  /// Look up the instruction a node was already compiled into
+  bool lookup(const void* node, size_t& index) const {
+    std::map<const void*, size_t>::const_iterator it = compiled_.find(node);
+    if (it == compiled_.end())
+      return false;
+    index = it->second;
+    return true;
+  }
+
+  /// Access an instruction
+  const TapeInstruction& operator[](size_t index) const {
+    return instructions_[index];
+  }
+
+  /// Reserve space for an object in the value buffer, returns its byte offset
+  size_t allocate(size_t bytes) {
+    const size_t offset = valueSize_;
+    valueSize_ += (bytes + TraceAlignment - 1) / TraceAlignment * TraceAlignment;
+    return offset;
+  }
+
+  /// Reserve the adjoint of a node of the given dimension, returns its offset in columns
+  size_t allocateAdjoint(int dim) {
+    if (dim == Eigen::Dynamic) {
+      valid_ = false;
+      return 0;
+    }
+    const size_t offset = adjointSize_;
+    adjointSize_ += dim;
+    return offset;
+  }
+
+  /// Append an instruction, returns its index
+  size_t push_back(const TapeInstruction& instruction) {
+    instructions_.push_back(instruction);
+    compiled_[instruction.node] = instructions_.size() - 1;
+    return instructions_.size() - 1;
+  }
+
+  /// @}
+
+private:
+
+  /// Destroy the values of the first n instructions
+  void destroy(char* buffer, size_t n) const {
+    for (size_t i = n; i-- > 0;)
+      instructions_[i].destroy(instructions_[i], buffer);
+  }
+};
+
+} // namespace internal
+} // namespace gtsam
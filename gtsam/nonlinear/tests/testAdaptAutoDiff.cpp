@@ -228,6 +228,40 @@ TEST(AdaptAutoDiff, AdaptAutoDiff) {
   EXPECT(assert_equal(E2, H2, 1e-8));
 }
 
+/* ************************************************************************* */
+// A function whose derivative lanes do not fill whole SIMD packets
+struct Odd {
+  template <typename T>
+  bool operator()(const T* const x, const T* const y, T* z) const {
+    z[0] = x[0] * y[0] + sin(x[1]);
+    z[1] = x[2] / y[1];
+    z[2] = x[0] * x[1] * y[1];
+    return true;
+  }
+};
+
+Vector3 odd(const Vector3& x, const Vector2& y) {
+  Vector3 z;
+  Odd()(x.data(), y.data(), z.data());
+  return z;
+}
+
+TEST(AdaptAutoDiff, OddDimensions) {
+  AdaptAutoDiff<Odd, 3, 3, 2> adaptor;
+  const Vector3 x(0.1, 0.2, 0.3);
+  const Vector2 y(2.0, 4.0);
+  Matrix33 H1;
+  Matrix32 H2;
+  EXPECT(assert_equal(odd(x, y), adaptor(x, y, H1, H2), 1e-9));
+  EXPECT(assert_equal(numericalDerivative21(odd, x, y), Matrix(H1), 1e-7));
+  EXPECT(assert_equal(numericalDerivative22(odd, x, y), Matrix(H2), 1e-7));
+
+  // Only one of the Jacobians
+  Matrix32 H2only;
+  adaptor(x, y, boost::none, H2only);
+  EXPECT(assert_equal(H2, H2only, 1e-9));
+}
+
 /* ************************************************************************* */
 // Test AutoDiff wrapper in an expression
 TEST(AdaptAutoDiff, SnavelyExpression) {
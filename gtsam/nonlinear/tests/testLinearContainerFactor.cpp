@@ -322,6 +322,66 @@ TEST( testLinearContainerFactor, hessian_relinearize )
   CHECK(gtsam::assert_equal(*expected_factor, *actual_factor));
 }
 
+/* ************************************************************************* */
+TEST( testLinearContainerFactor, linearizeInto )
+{
+  gtsam::Key key1(1);
+  gtsam::Key key2(2);
+  gtsam::Values linpoint1;
+  linpoint1.insert(key1, gtsam::Point3(-22.4,  +8.5,  +2.4));
+  linpoint1.insert(key2, gtsam::Point3(-21.0,  +5.0, +21.0));
+  gtsam::BetweenFactor<gtsam::Point3> betweenFactor(key1, key2, gtsam::Point3(1.0, -2.5, 17.8),
+      gtsam::noiseModel::Isotropic::Sigma(3, 0.1));
+  gtsam::JacobianFactor jacobian(*betweenFactor.linearize(linpoint1));
+  gtsam::LinearContainerFactor jacobianContainer(jacobian, linpoint1);
+  gtsam::LinearContainerFactor hessianContainer(gtsam::HessianFactor(jacobian), linpoint1);
+
+  gtsam::Values linpoint2;
+  linpoint2.insert(key1, gtsam::Point3(+18.0, -0.25, +1.11));
+  linpoint2.insert(key2, gtsam::Point3(-10.0, +11.2, +0.05));
+
+  // Relinearizing into an existing factor of the same shape reuses its storage
+  gtsam::JacobianFactor actualJacobian = jacobian;
+  const double* storage = actualJacobian.matrixObject().matrix().data();
+  EXPECT(jacobianContainer.linearizeInto(linpoint2, actualJacobian));
+  EXPECT(gtsam::assert_equal(*betweenFactor.linearize(linpoint2),
+      static_cast<const gtsam::GaussianFactor&>(actualJacobian)));
+  EXPECT(storage == actualJacobian.matrixObject().matrix().data());
+
+  // The cached relinearization is used again, and replaced when the values change
+  EXPECT(gtsam::assert_equal(*betweenFactor.linearize(linpoint2), *jacobianContainer.linearize(linpoint2)));
+  EXPECT(jacobianContainer.linearizeInto(linpoint1, actualJacobian));
+  EXPECT(gtsam::assert_equal(jacobian, actualJacobian));
+
+  gtsam::HessianFactor actualHessian;
+  EXPECT(hessianContainer.linearizeInto(linpoint2, actualHessian));
+  EXPECT(gtsam::assert_equal(gtsam::HessianFactor(*betweenFactor.linearize(linpoint2)), actualHessian));
+
+  // Factors of another type are left alone
+  EXPECT(!hessianContainer.linearizeInto(linpoint2, actualJacobian));
+  EXPECT(gtsam::assert_equal(jacobian, actualJacobian));
+}
+
+/* ************************************************************************* */
+TEST( testLinearContainerFactor, Share )
+{
+  gtsam::Values linpoint;
+  linpoint.insert(x1, gtsam::Pose2(1.0, 2.0, 0.3));
+  linpoint.insert(x2, gtsam::Pose2(2.0, 1.0, 0.1));
+  linpoint.insert(l1, gtsam::Point3(1.0, 2.0, 3.0));
+  GaussianFactor::shared_ptr jacobian(new JacobianFactor(x1, Matrix::Identity(3, 3),
+      x2, -Matrix::Identity(3, 3), Vector3(0.1, 0.2, 0.3)));
+
+  // The factor is shared rather than cloned, and only the values of its keys are kept
+  boost::shared_ptr<LinearContainerFactor> shared = LinearContainerFactor::Share(jacobian, linpoint);
+  EXPECT(shared->factor() == jacobian);
+  LONGS_EQUAL(2, shared->linearizationPoint()->size());
+  EXPECT(assert_equal(LinearContainerFactor(jacobian, linpoint), *shared));
+  EXPECT(assert_equal(*jacobian, *shared->linearize(linpoint)));
+
+  EXPECT(!LinearContainerFactor::Share(jacobian)->hasLinearizationPoint());
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
@@ -0,0 +1,109 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testNumericalDerivativeFactor.cpp
+ * @date Oct 15, 2026
+ */
+
+#include <gtsam/nonlinear/NumericalDerivativeFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/linear/JacobianFactor.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace gtsam;
+using namespace std;
+
+namespace {
+
+// The between factor, with numerical derivatives
+class NumericalBetween: public NumericalDerivativeFactor2<Pose2, Pose2, 3> {
+  Pose2 measured_;
+public:
+  NumericalBetween(Key j1, Key j2, const Pose2& measured, const SharedNoiseModel& model) :
+      NumericalDerivativeFactor2<Pose2, Pose2, 3>(model, j1, j2), measured_(measured) {
+  }
+  virtual Vector3 evaluateErrorOnly(const Pose2& x1, const Pose2& x2) const {
+    return measured_.localCoordinates(x1.between(x2));
+  }
+};
+
+// The prior factor, with numerical derivatives
+class NumericalPrior: public NumericalDerivativeFactor1<Pose2, 3> {
+  Pose2 prior_;
+public:
+  NumericalPrior(Key j, const Pose2& prior, const SharedNoiseModel& model) :
+      NumericalDerivativeFactor1<Pose2, 3>(model, j), prior_(prior) {
+  }
+  virtual Vector3 evaluateErrorOnly(const Pose2& x) const {
+    return prior_.localCoordinates(x);
+  }
+};
+
+SharedNoiseModel model = noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.2, 0.05));
+}
+
+/* ************************************************************************* */
+TEST( NumericalDerivativeFactor, binary )
+{
+  Pose2 x1(1.0, 2.0, 0.3), x2(2.5, 1.5, -0.4);
+  Values values;
+  values.insert(1, x1);
+  values.insert(2, x2);
+
+  // at zero error the analytic Jacobians of BetweenFactor are exact
+  NumericalBetween factor(1, 2, x1.between(x2), model);
+  BetweenFactor<Pose2> expected(1, 2, x1.between(x2), model);
+  GaussianFactor::shared_ptr actualLinear = factor.linearize(values);
+  GaussianFactor::shared_ptr expectedLinear = expected.linearize(values);
+  EXPECT(assert_equal(expectedLinear->jacobian().first, actualLinear->jacobian().first, 1e-6));
+  EXPECT(assert_equal(expectedLinear->jacobian().second, actualLinear->jacobian().second, 1e-9));
+
+  // otherwise compare with the reference numerical derivatives
+  NumericalBetween factor2(1, 2, Pose2(1.4, -0.6, -0.6), model);
+  Matrix H1, H2;
+  Vector error = factor2.evaluateError(x1, x2, H1, H2);
+  EXPECT(assert_equal(Vector(factor2.evaluateErrorOnly(x1, x2)), error));
+  EXPECT(assert_equal(numericalDerivative21<Vector3, Pose2, Pose2>(
+      boost::bind(&NumericalBetween::evaluateErrorOnly, &factor2, _1, _2), x1, x2), H1, 1e-9));
+  EXPECT(assert_equal(numericalDerivative22<Vector3, Pose2, Pose2>(
+      boost::bind(&NumericalBetween::evaluateErrorOnly, &factor2, _1, _2), x1, x2), H2, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST( NumericalDerivativeFactor, unary )
+{
+  Pose2 x(1.0, 2.0, 0.3);
+  Values values;
+  values.insert(1, x);
+
+  // at zero error the identity Jacobian of PriorFactor is exact
+  NumericalPrior factor(1, x, model);
+  PriorFactor<Pose2> expected(1, x, model);
+  GaussianFactor::shared_ptr actualLinear = factor.linearize(values);
+  GaussianFactor::shared_ptr expectedLinear = expected.linearize(values);
+  EXPECT(assert_equal(expectedLinear->jacobian().first, actualLinear->jacobian().first, 1e-6));
+  EXPECT(assert_equal(expectedLinear->jacobian().second, actualLinear->jacobian().second, 1e-9));
+
+  // otherwise compare with the reference numerical derivative
+  NumericalPrior factor2(1, Pose2(1.1, 1.9, 0.25), model);
+  Matrix H;
+  factor2.evaluateError(x, H);
+  EXPECT(assert_equal(numericalDerivative11<Vector3, Pose2>(
+      boost::bind(&NumericalPrior::evaluateErrorOnly, &factor2, _1), x), H, 1e-9));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -283,6 +283,60 @@ TEST(Values, expmap_d)
   CHECK(config0.equals(config0));
 }
 
+/* ************************************************************************* */
+TEST(Values, retractInPlace)
+{
+  Values values;
+  values.insert(key1, Vector3(1.0, 2.0, 3.0));
+  values.insert(key2, Pose2(1.0, 2.0, 0.3));
+  values.insert(key3, Pose2(0.3, 0.4, 0.5));
+
+  VectorValues increment = pair_list_of<Key, Vector>
+    (key1, Vector3(1.0, 1.1, 1.2))
+    (key2, Vector3(0.1, 0.2, 0.3));
+
+  const Values expected = values.retract(increment);
+
+  // Values are updated where they live, so references stay valid
+  const Pose2& pose = values.at<Pose2>(key2);
+  values.retractInPlace(increment);
+  CHECK(assert_equal(expected, values));
+  CHECK(assert_equal(expected.at<Pose2>(key2), pose));
+}
+
+/* ************************************************************************* */
+TEST(Values, retractBatch)
+{
+  // A run of Pose3 values, interrupted by a value without a delta and a value of another type
+  Values values;
+  for (size_t j = 0; j < 6; ++j)
+    values.insert(j, Pose3(Rot3::RzRyRx(0.1 * j, -0.2, 0.3), Point3(1.0 * j, 2.0, 3.0)));
+  values.insert(6, Pose2(1.0, 2.0, 0.3));
+  values.insert(7, Pose3());
+
+  VectorValues increment;
+  for (size_t j = 0; j < 8; ++j) {
+    if (j == 3)
+      continue;
+    if (j == 6)
+      increment.insert(j, Vector3(0.1, 0.2, 0.3));
+    else
+      increment.insert(j, (Vector(6) << 0.1 * j, 0.2, -0.3, 1.0, 2.0 * j, 3.0).finished());
+  }
+
+  const Values actual = values.retract(increment);
+  EXPECT_LONGS_EQUAL(8, actual.size());
+  for (size_t j = 0; j < 8; ++j) {
+    if (j == 6) {
+      EXPECT(assert_equal(values.at<Pose2>(j).retract(increment.at(j)), actual.at<Pose2>(j)));
+    } else if (j == 3) {
+      EXPECT(assert_equal(values.at<Pose3>(j), actual.at<Pose3>(j)));
+    } else {
+      EXPECT(assert_equal(values.at<Pose3>(j).retract(increment.at(j)), actual.at<Pose3>(j)));
+    }
+  }
+}
+
 /* ************************************************************************* */
 TEST(Values, localCoordinates)
 {
@@ -485,6 +539,46 @@ TEST(Values, FixedSize) {
   CHECK(assert_equal((Vector)expected, values.at<Vector3>(key1)));
   CHECK_EXCEPTION(values.insertFixed(key1, v, 12),runtime_error);
 }
+/* ************************************************************************* */
+TEST(Values, memoryUsage) {
+  Values small, large;
+  small.insert(key1, Vector(Vector::Zero(2)));
+  large.insert(key1, Vector(Vector::Zero(12)));
+  EXPECT_LONGS_EQUAL(10 * sizeof(double), (long)(large.memoryUsage() - small.memoryUsage()));
+
+  // Fixed-size values have no heap storage
+  Values fixed;
+  fixed.insert(key1, Point2(1.0, 2.0));
+  EXPECT_LONGS_EQUAL((long)(Values().memoryUsage() + fixed.at(key1).memoryUsage()
+      + mapNodeBytes(1, sizeof(std::pair<const Key, void*>))), (long)fixed.memoryUsage());
+  EXPECT_LONGS_EQUAL(sizeof(GenericValue<Point2>), (long)fixed.at(key1).memoryUsage());
+}
+
+/* ************************************************************************* */
+TEST(Values, atKeys) {
+  Values values;
+  for (Key j = 1; j <= 6; ++j)
+    values.insert(j, Point2(j, 0.0));
+  values.insert(10, Pose2(1.0, 2.0, 0.3));
+
+  // Adjacent, distant and decreasing keys all resolve to their values
+  KeyVector keys = list_of<Key>(2)(3)(6)(10)(1);
+  const Value* actual[5];
+  values.at(keys, actual);
+  for (size_t i = 0; i < keys.size(); ++i)
+    EXPECT(actual[i] == &values.at(keys[i]));
+
+  // Values are tagged with their type, and cast without RTTI
+  EXPECT(actual[0]->typeTag() == &internal::TypeTag<GenericValue<Point2> >::id);
+  EXPECT(assert_equal(Point2(3.0, 0.0), Values::Cast<Point2>(3, *actual[1])));
+  EXPECT(assert_equal(Pose2(1.0, 2.0, 0.3), Values::Cast<Pose2>(10, *actual[3])));
+  CHECK_EXCEPTION(Values::Cast<Pose2>(1, *actual[4]), ValuesIncorrectType);
+
+  keys.push_back(7);
+  const Value* missing[6];
+  CHECK_EXCEPTION(values.at(keys, missing), ValuesKeyDoesNotExist);
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
@@ -21,6 +21,8 @@
 
 #include <gtsam/nonlinear/ExpressionFactor.h>
 #include <gtsam/geometry/BearingRange.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
 #include <boost/concept/assert.hpp>
 
 namespace gtsam {
@@ -66,6 +68,11 @@ class BearingRangeFactor
                          Expression<A2>(key2));
   }
 
+  /// Linearize, specialized with fixed-size Jacobians for Pose2/Point2 and Pose3/Point3
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+    return Base::linearize(x);
+  }
+
   /// print
   virtual void print(const std::string& s = "",
                      const KeyFormatter& kf = DefaultKeyFormatter) const {
@@ -75,6 +82,16 @@ class BearingRangeFactor
 
 };  // BearingRangeFactor
 
+/// Linearize a BearingRangeFactor<Pose2, Point2> without the expression tree
+template <>
+GTSAM_EXPORT boost::shared_ptr<GaussianFactor>
+BearingRangeFactor<Pose2, Point2>::linearize(const Values& x) const;
+
+/// Linearize a BearingRangeFactor<Pose3, Point3> without the expression tree
+template <>
+GTSAM_EXPORT boost::shared_ptr<GaussianFactor>
+BearingRangeFactor<Pose3, Point3>::linearize(const Values& x) const;
+
 /// traits
 template <typename A1, typename A2, typename B, typename R>
 struct traits<BearingRangeFactor<A1, A2, B, R> >
@@ -0,0 +1,184 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  RangeFactor.cpp
+ *  @brief Specialized linearization of RangeFactor and BearingRangeFactor
+ *  @date  Oct 15, 2026
+ **/
+
+#include <gtsam/sam/RangeFactor.h>
+#include <gtsam/sam/BearingRangeFactor.h>
+#include <gtsam/linear/BinaryJacobianFactor.h>
+
+namespace gtsam {
+
+namespace {
+
+// Whiten a fixed-size system with the square root information, without dynamic matrices
+template<int M, int N1, int N2>
+void whiten(const noiseModel::Gaussian& gaussian, Eigen::Matrix<double, M, N1>& H1,
+    Eigen::Matrix<double, M, N2>& H2, Eigen::Matrix<double, M, 1>& b) {
+  if (gaussian.isUnit())
+    return;
+  const noiseModel::Diagonal* diagonal = dynamic_cast<const noiseModel::Diagonal*>(&gaussian);
+  if (diagonal) {
+    const Eigen::Matrix<double, M, 1> invsigmas = diagonal->invsigmas();
+    H1 = invsigmas.asDiagonal() * H1;
+    H2 = invsigmas.asDiagonal() * H2;
+    b.array() *= invsigmas.array();
+  } else {
+    const Eigen::Matrix<double, M, M> R = gaussian.R();
+    H1 = R * H1;
+    H2 = R * H2;
+    b = R * b;
+  }
+}
+
+// The Jacobian factor on a pose and a point, with the blocks in the order of keys, which
+// ExpressionFactor sorts
+template<int M, int NPOSE, int NPOINT>
+boost::shared_ptr<GaussianFactor> binaryFactor(const KeyVector& keys, bool poseFirst,
+    const Eigen::Matrix<double, M, NPOSE>& Hpose, const Eigen::Matrix<double, M, NPOINT>& Hpoint,
+    const Eigen::Matrix<double, M, 1>& b) {
+  if (poseFirst)
+    return boost::make_shared<BinaryJacobianFactor<M, NPOSE, NPOINT> >(keys[0], Hpose, keys[1],
+        Hpoint, b);
+  else
+    return boost::make_shared<BinaryJacobianFactor<M, NPOINT, NPOSE> >(keys[0], Hpoint, keys[1],
+        Hpose, b);
+}
+
+}
+
+/* ************************************************************************* */
+template<>
+boost::shared_ptr<GaussianFactor> RangeFactor<Pose2, Point2>::linearize(
+    const Values& x) const {
+  // Only Gaussian noise models are whitened here, constrained and robust ones are not
+  const noiseModel::Gaussian* gaussian =
+      dynamic_cast<const noiseModel::Gaussian*>(this->noiseModel_.get());
+  if (!gaussian || gaussian->isConstrained())
+    return Base::linearize(x);
+
+  // Only linearize if the factor is active
+  if (!this->active(x))
+    return boost::shared_ptr<JacobianFactor>();
+
+  const bool poseFirst = this->dims_[0] == Pose2::dimension;
+  const Pose2& pose = x.at<Pose2>(this->keys_[poseFirst ? 0 : 1]);
+  const Point2& point = x.at<Point2>(this->keys_[poseFirst ? 1 : 0]);
+  Matrix13 Hpose;
+  Matrix12 Hpoint;
+  Vector1 b;
+  b << this->measured_ - pose.range(point, Hpose, Hpoint);
+  whiten(*gaussian, Hpose, Hpoint, b);
+  return binaryFactor(this->keys_, poseFirst, Hpose, Hpoint, b);
+}
+
+/* ************************************************************************* */
+template<>
+boost::shared_ptr<GaussianFactor> RangeFactor<Pose3, Point3>::linearize(
+    const Values& x) const {
+  const noiseModel::Gaussian* gaussian =
+      dynamic_cast<const noiseModel::Gaussian*>(this->noiseModel_.get());
+  if (!gaussian || gaussian->isConstrained())
+    return Base::linearize(x);
+  if (!this->active(x))
+    return boost::shared_ptr<JacobianFactor>();
+
+  const bool poseFirst = this->dims_[0] == Pose3::dimension;
+  const Pose3& pose = x.at<Pose3>(this->keys_[poseFirst ? 0 : 1]);
+  const Point3& point = x.at<Point3>(this->keys_[poseFirst ? 1 : 0]);
+
+  // The range is invariant to the rotation, see Pose3::rangeBatch
+  const Vector3 d = point.vector() - pose.translation().vector();
+  const double r = d.norm();
+  Matrix16 Hpose;
+  Matrix13 Hpoint;
+  if (r > 1e-10) {
+    Hpoint = d.transpose() / r;
+    Hpose << 0.0, 0.0, 0.0, -Hpoint * pose.rotation().matrix();
+  } else {
+    pose.range(point, Hpose, Hpoint);
+  }
+  Vector1 b;
+  b << this->measured_ - r;
+  whiten(*gaussian, Hpose, Hpoint, b);
+  return binaryFactor(this->keys_, poseFirst, Hpose, Hpoint, b);
+}
+
+/* ************************************************************************* */
+template<>
+boost::shared_ptr<GaussianFactor> BearingRangeFactor<Pose2, Point2>::linearize(
+    const Values& x) const {
+  const noiseModel::Gaussian* gaussian =
+      dynamic_cast<const noiseModel::Gaussian*>(this->noiseModel_.get());
+  if (!gaussian || gaussian->isConstrained())
+    return Base::linearize(x);
+  if (!this->active(x))
+    return boost::shared_ptr<JacobianFactor>();
+
+  const bool poseFirst = this->dims_[0] == Pose2::dimension;
+  const Pose2& pose = x.at<Pose2>(this->keys_[poseFirst ? 0 : 1]);
+  const Point2& point = x.at<Point2>(this->keys_[poseFirst ? 1 : 0]);
+
+  // Bearing and range from the point in pose coordinates, see Pose2::bearing and Pose2::range
+  Matrix23 Dd_pose;
+  Matrix2 Dd_point;
+  const Point2 d = pose.transform_to(point, Dd_pose, Dd_point);
+  Matrix2 Dbr_d;
+  Matrix12 Db_d, Dr_d;
+  const Rot2 bearing = Rot2::relativeBearing(d, Db_d);
+  const double range = d.norm(Dr_d);
+  Dbr_d << Db_d, Dr_d;
+  Matrix23 Hpose = Dbr_d * Dd_pose;
+  Matrix2 Hpoint = Dbr_d * Dd_point;
+  Vector2 b;
+  b << traits<Rot2>::Local(bearing, this->measured_.first), this->measured_.second - range;
+  whiten(*gaussian, Hpose, Hpoint, b);
+  return binaryFactor(this->keys_, poseFirst, Hpose, Hpoint, b);
+}
+
+/* ************************************************************************* */
+template<>
+boost::shared_ptr<GaussianFactor> BearingRangeFactor<Pose3, Point3>::linearize(
+    const Values& x) const {
+  const noiseModel::Gaussian* gaussian =
+      dynamic_cast<const noiseModel::Gaussian*>(this->noiseModel_.get());
+  if (!gaussian || gaussian->isConstrained())
+    return Base::linearize(x);
+  if (!this->active(x))
+    return boost::shared_ptr<JacobianFactor>();
+
+  const bool poseFirst = this->dims_[0] == Pose3::dimension;
+  const Pose3& pose = x.at<Pose3>(this->keys_[poseFirst ? 0 : 1]);
+  const Point3& point = x.at<Point3>(this->keys_[poseFirst ? 1 : 0]);
+
+  // Bearing and range from the point in pose coordinates, see Pose3::bearing and Pose3::range
+  Matrix36 Dq_pose;
+  Matrix3 Dq_point;
+  const Point3 q = pose.transform_to(point, Dq_pose, Dq_point);
+  Matrix3 Dbr_q;
+  Matrix23 Db_q;
+  Matrix13 Dr_q;
+  const Unit3 bearing = Unit3::FromPoint3(q, Db_q);
+  const double range = q.norm(Dr_q);
+  Dbr_q << Db_q, Dr_q;
+  Matrix36 Hpose = Dbr_q * Dq_pose;
+  Matrix3 Hpoint = Dbr_q * Dq_point;
+  Vector3 b;
+  b << traits<Unit3>::Local(bearing, this->measured_.first), this->measured_.second - range;
+  whiten(*gaussian, Hpose, Hpoint, b);
+  return binaryFactor(this->keys_, poseFirst, Hpose, Hpoint, b);
+}
+
+}
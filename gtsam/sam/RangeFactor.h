@@ -19,6 +19,8 @@
 #pragma once
 
 #include <gtsam/nonlinear/ExpressionFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
 
 namespace gtsam {
 
@@ -60,6 +62,11 @@ class RangeFactor : public ExpressionFactor2<T, A1, A2> {
     return Expression<T>(Range<A1, A2>(), a1_, a2_);
   }
 
+  /// Linearize, specialized with fixed-size Jacobians for Pose2/Point2 and Pose3/Point3
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+    return Base::linearize(x);
+  }
+
   /// print
   void print(const std::string& s = "",
              const KeyFormatter& kf = DefaultKeyFormatter) const {
@@ -68,6 +75,16 @@ class RangeFactor : public ExpressionFactor2<T, A1, A2> {
   }
 };  // \ RangeFactor
 
+/// Linearize a RangeFactor<Pose2, Point2> without the expression tree
+template <>
+GTSAM_EXPORT boost::shared_ptr<GaussianFactor> RangeFactor<Pose2, Point2>::linearize(
+    const Values& x) const;
+
+/// Linearize a RangeFactor<Pose3, Point3> without the expression tree
+template <>
+GTSAM_EXPORT boost::shared_ptr<GaussianFactor> RangeFactor<Pose3, Point3>::linearize(
+    const Values& x) const;
+
 /// traits
 template <typename A1, typename A2, typename T>
 struct traits<RangeFactor<A1, A2, T> >
@@ -100,6 +100,41 @@ TEST(BearingRangeFactor, Serialization3D) {
 //  EXPECT_CORRECT_FACTOR_JACOBIANS(factor, values, 1e-7, 1e-5);
 //}
 
+/* ************************************************************************* */
+// The specialized linearization matches the expression one, in both key orders
+TEST(BearingRangeFactor, Linearize) {
+  typedef ExpressionFactor<BearingRange<Pose2, Point2> > Expression2D;
+  typedef ExpressionFactor<BearingRange<Pose3, Point3> > Expression3D;
+  Matrix3 information;
+  information << 4.0, 0.5, 0.1, 0.5, 2.0, 0.2, 0.1, 0.2, 1.0;
+  Values values;
+  values.insert(poseKey, Pose2(1.0, 2.0, 0.57));
+  values.insert(pointKey, Point2(-4.0, 11.0));
+  values.insert(Key(3), Pose3(Rot3::RzRyRx(0.2, -0.3, 1.75), Point3(1.0, 2.0, -3.0)));
+  values.insert(Key(4), Point3(-2.0, 11.0, 1.0));
+  values.insert(Key(0), Point2(3.0, -1.0));
+  values.insert(Key(5), Point3(3.0, -1.0, 2.0));
+  values.insert(Key(6), Pose3(Rot3::RzRyRx(-1.2, 0.4, 0.3), Point3(-1.0, 0.5, 2.0)));
+
+  BearingRangeFactor2D factors2D[] = { factor2D,
+      BearingRangeFactor2D(poseKey, Key(0), 0.3, 2, noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.5))) };
+  for (size_t i = 0; i < 2; ++i) {
+    const BearingRangeFactor2D& factor = factors2D[i];
+    EXPECT(assert_equal(factor.Expression2D::linearize(values)->augmentedJacobian(),
+        factor.linearize(values)->augmentedJacobian(), 1e-9));
+  }
+
+  const Unit3 bearing = Pose3().bearing(Point3(1, 2, 3));
+  BearingRangeFactor3D factors3D[] = {
+      BearingRangeFactor3D(Key(3), Key(4), bearing, 10, model3D),
+      BearingRangeFactor3D(Key(6), Key(5), bearing, 10, noiseModel::Gaussian::Information(information)) };
+  for (size_t i = 0; i < 2; ++i) {
+    const BearingRangeFactor3D& factor = factors3D[i];
+    EXPECT(assert_equal(factor.Expression3D::linearize(values)->augmentedJacobian(),
+        factor.linearize(values)->augmentedJacobian(), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
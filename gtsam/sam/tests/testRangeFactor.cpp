@@ -389,6 +389,37 @@ TEST(RangeFactor, NonGTSAM) {
   CHECK(assert_equal(expectedError, factor.evaluateError(pose, point), 1e-9));
 }
 
+/* ************************************************************************* */
+// The specialized linearization matches the expression one, in both key orders
+TEST( RangeFactor, Linearize ) {
+  SharedNoiseModel diagonal = noiseModel::Diagonal::Sigmas(Vector1::Constant(0.2));
+  Values values;
+  values.insert(poseKey, Pose2(1.0, 2.0, 0.57));
+  values.insert(pointKey, Point2(-4.0, 11.0));
+  values.insert(Key(3), Pose3(Rot3::RzRyRx(0.2, -0.3, 1.75), Point3(1.0, 2.0, -3.0)));
+  values.insert(Key(4), Point3(-2.0, 11.0, 1.0));
+  values.insert(Key(0), Point3(3.0, -1.0, 2.0));
+  values.insert(Key(5), Pose2(-2.0, 1.0, -2.1));
+
+  RangeFactor2D factors2D[] = { RangeFactor2D(poseKey, pointKey, measurement, model),
+      RangeFactor2D(poseKey, pointKey, measurement, diagonal),
+      RangeFactor2D(Key(5), pointKey, measurement, diagonal) };
+  for (size_t i = 0; i < 3; ++i) {
+    const RangeFactor2D& factor = factors2D[i];
+    EXPECT(assert_equal(factor.ExpressionFactor<double>::linearize(values)->augmentedJacobian(),
+        factor.linearize(values)->augmentedJacobian(), 1e-9));
+  }
+
+  RangeFactor3D factors3D[] = { RangeFactor3D(Key(3), Key(4), measurement, model),
+      RangeFactor3D(Key(3), Key(4), measurement, diagonal),
+      RangeFactor3D(Key(3), Key(0), measurement, diagonal) };
+  for (size_t i = 0; i < 3; ++i) {
+    const RangeFactor3D& factor = factors3D[i];
+    EXPECT(assert_equal(factor.ExpressionFactor<double>::linearize(values)->augmentedJacobian(),
+        factor.linearize(values)->augmentedJacobian(), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -0,0 +1,132 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  BetweenFactor.cpp
+ *  @brief Specialized linearization of BetweenFactor
+ *  @date  Oct 15, 2026
+ **/
+
+#include <gtsam/slam/BetweenFactor.h>
+
+#include <cmath>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+template<>
+boost::shared_ptr<GaussianFactor> BetweenFactor<Pose2>::linearize(
+    const Values& x) const {
+#if defined(SLOW_BUT_CORRECT_BETWEENFACTOR) || defined(SLOW_BUT_CORRECT_EXPMAP)
+  return Base::linearize(x);
+#else
+  // Only linearize if the factor is active
+  if (!this->active(x))
+    return boost::shared_ptr<JacobianFactor>();
+
+  const Key key1 = this->key1(), key2 = this->key2();
+  const Pose2& p1 = x.at<Pose2>(key1);
+  const Pose2& p2 = x.at<Pose2>(key2);
+
+  // The rotations already store their cosines and sines, so the angle differences
+  // follow from the angle subtraction identities.  hx = between(p1,p2):
+  const double c1 = p1.r().c(), s1 = p1.r().s(), c2 = p2.r().c(), s2 = p2.r().s();
+  const double c = c1 * c2 + s1 * s2, s = c1 * s2 - s1 * c2;
+  const double dx = p2.x() - p1.x(), dy = p2.y() - p1.y();
+  const double tx = c1 * dx + s1 * dy, ty = -s1 * dx + c1 * dy;
+
+  // Local coordinates of hx around the measurement, i.e. of between(measured_,hx)
+  const double cm = measured_.r().c(), sm = measured_.r().s();
+  const double ex = tx - measured_.x(), ey = ty - measured_.y();
+  Vector3 b;
+  b << -(cm * ex + sm * ey), -(-sm * ex + cm * ey),
+      -std::atan2(cm * s - sm * c, cm * c + sm * s);
+
+  // Jacobians of between, see Pose2::between: -AdjointMap(between(p2,p1)) and identity
+  Matrix3 H1, H2;
+  H1 << -c, -s, -s2 * dx + c2 * dy,
+         s, -c, -c2 * dx - s2 * dy,
+       0.0, 0.0, -1.0;
+  H2.setIdentity();
+
+  // Whiten the system if needed, a diagonal model without going through dynamic matrices
+  const SharedNoiseModel& noiseModel = this->get_noiseModel();
+  const noiseModel::Diagonal* diagonal =
+      dynamic_cast<const noiseModel::Diagonal*>(noiseModel.get());
+  if (diagonal && !noiseModel->isConstrained()) {
+    const Vector3 invsigmas = diagonal->invsigmas();
+    H1 = invsigmas.asDiagonal() * H1;
+    H2 = invsigmas.asDiagonal();
+    b.array() *= invsigmas.array();
+  } else if (noiseModel && !noiseModel->isUnit()) {
+    H1 = noiseModel->Whiten(H1);
+    H2 = noiseModel->Whiten(H2);
+    b = noiseModel->whiten(b);
+  }
+
+  // Create new (unit) noiseModel, preserving constraints if applicable
+  SharedDiagonal model;
+  if (noiseModel && noiseModel->isConstrained())
+    model = boost::static_pointer_cast<noiseModel::Constrained>(noiseModel)->unit();
+
+  return boost::make_shared<BinaryJacobianFactor<3, 3, 3> >(key1, H1, key2, H2, b, model);
+#endif
+}
+
+/* ************************************************************************* */
+template<>
+boost::shared_ptr<GaussianFactor> BetweenFactor<Pose3>::linearize(
+    const Values& x) const {
+#ifdef SLOW_BUT_CORRECT_BETWEENFACTOR
+  return Base::linearize(x);
+#else
+  // Only Gaussian noise models are whitened here, constrained and robust ones are not
+  const SharedNoiseModel& noiseModel = this->get_noiseModel();
+  const noiseModel::Gaussian* gaussian =
+      dynamic_cast<const noiseModel::Gaussian*>(noiseModel.get());
+  if (noiseModel && (!gaussian || noiseModel->isConstrained()))
+    return Base::linearize(x);
+
+  // Only linearize if the factor is active
+  if (!this->active(x))
+    return boost::shared_ptr<JacobianFactor>();
+
+  const Key key1 = this->key1(), key2 = this->key2();
+  const Pose3& p1 = x.at<Pose3>(key1);
+  const Pose3& p2 = x.at<Pose3>(key2);
+
+  // Same error as evaluateError, with fixed-size Jacobians
+  Matrix6 H1, H2;
+  const Pose3 hx = p1.between(p2, H1, H2);
+  Vector6 b = -traits<Pose3>::Local(measured_, hx);
+
+  // Whiten the system with the square root information, without dynamic matrices
+  if (gaussian && !gaussian->isUnit()) {
+    const noiseModel::Diagonal* diagonal =
+        dynamic_cast<const noiseModel::Diagonal*>(gaussian);
+    if (diagonal) {
+      const Vector6 invsigmas = diagonal->invsigmas();
+      H1 = invsigmas.asDiagonal() * H1;
+      H2 = invsigmas.asDiagonal() * H2;
+      b.array() *= invsigmas.array();
+    } else {
+      const Matrix6 R = gaussian->R();
+      H1 = R * H1;
+      H2 = R * H2;
+      b = R * b;
+    }
+  }
+
+  return boost::make_shared<BinaryJacobianFactor<6, 6, 6> >(key1, H1, key2, H2, b);
+#endif
+}
+
+}
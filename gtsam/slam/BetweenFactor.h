@@ -19,6 +19,8 @@
 
 #include <gtsam/base/Testable.h>
 #include <gtsam/base/Lie.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 
 namespace gtsam {
@@ -102,6 +104,14 @@ namespace gtsam {
 #endif
     }
 
+    /**
+     * Linearize to a JacobianFactor.  Specialized with fixed-size Jacobians for
+     * some types, see BetweenFactor.cpp.
+     */
+    virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+      return Base::linearize(x);
+    }
+
     /** return the measured */
     const VALUE& measured() const {
       return measured_;
@@ -124,6 +134,16 @@ namespace gtsam {
     }
   }; // \class BetweenFactor
 
+  /// Linearize a BetweenFactor<Pose2> without trigonometry beyond one atan2
+  template<>
+  GTSAM_EXPORT boost::shared_ptr<GaussianFactor> BetweenFactor<Pose2>::linearize(
+      const Values& x) const;
+
+  /// Linearize a BetweenFactor<Pose3> with fixed-size Jacobians and whitening
+  template<>
+  GTSAM_EXPORT boost::shared_ptr<GaussianFactor> BetweenFactor<Pose3>::linearize(
+      const Values& x) const;
+
   /// traits
   template<class VALUE>
   struct traits<BetweenFactor<VALUE> > : public Testable<BetweenFactor<VALUE> > {};
@@ -0,0 +1,102 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  GeneralSFMFactor.cpp
+ *  @brief Specialized linearization of GeneralSFMFactor
+ *  @date  Oct 15, 2026
+ **/
+
+#include <gtsam/slam/GeneralSFMFactor.h>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+template<>
+boost::shared_ptr<GaussianFactor>
+GeneralSFMFactor<PinholeCamera<Cal3Bundler>, Point3>::linearize(const Values& values) const {
+  // Only Gaussian noise models are whitened here, constrained and robust ones are not
+  const SharedNoiseModel& noiseModel = this->get_noiseModel();
+  const noiseModel::Gaussian* gaussian =
+      dynamic_cast<const noiseModel::Gaussian*>(noiseModel.get());
+  if (noiseModel && (!gaussian || noiseModel->isConstrained()))
+    return Base::linearize(values);
+
+  // Only linearize if the factor is active
+  if (!this->active(values))
+    return boost::shared_ptr<JacobianFactor>();
+
+  const Key key1 = this->key1(), key2 = this->key2();
+  const PinholeCamera<Cal3Bundler>& camera = values.at<PinholeCamera<Cal3Bundler> >(key1);
+  const Point3& point = values.at<Point3>(key2);
+  const Pose3& pose = camera.pose();
+  const Cal3Bundler& K = camera.calibration();
+
+  JacobianC H1;
+  JacobianL H2;
+  Vector2 b;
+
+  // The point in camera coordinates, see Pose3::transform_to
+  const Matrix3 Rt = pose.rotation().transpose();
+  const Vector3 q = Rt * (point.vector() - pose.translation().vector());
+#ifdef GTSAM_THROW_CHEIRALITY_EXCEPTION
+  if (q.z() <= 0) {
+    H1.setZero();
+    H2.setZero();
+    b.setZero();
+    return boost::make_shared<BinaryJacobianFactor<2, DimC, DimL> >(key1, H1, key2, H2, b);
+  }
+#endif
+
+  // Normalized coordinates and radial distortion, see Cal3Bundler::uncalibrate
+  const double d = 1.0 / q.z(), u = q.x() * d, v = q.y() * d;
+  const double f = K.fx(), k1 = K.k1(), k2 = K.k2();
+  const double r = u * u + v * v, g = 1.0 + (k1 + k2 * r) * r;
+  b << measured_.x() - (K.u0() + f * g * u), measured_.y() - (K.v0() + f * g * v);
+
+  // Jacobians of the image point with respect to the normalized point and the calibration
+  const double a = 2.0 * (k1 + 2.0 * k2 * r);
+  Matrix2 Dpi_pn;
+  Dpi_pn << f * (g + a * u * u), f * a * u * v, f * a * u * v, f * (g + a * v * v);
+  Matrix23 Dcal;
+  Dcal << g * u, f * r * u, f * r * r * u, g * v, f * r * v, f * r * r * v;
+
+  // Whiten the 2-row blocks before the chain rule, so the pose and point blocks come out whitened
+  if (gaussian && !gaussian->isUnit()) {
+    const noiseModel::Diagonal* diagonal =
+        dynamic_cast<const noiseModel::Diagonal*>(gaussian);
+    if (diagonal) {
+      const Vector2 invsigmas = diagonal->invsigmas();
+      Dpi_pn = invsigmas.asDiagonal() * Dpi_pn;
+      Dcal = invsigmas.asDiagonal() * Dcal;
+      b.array() *= invsigmas.array();
+    } else {
+      const Matrix2 R = gaussian->R();
+      Dpi_pn = R * Dpi_pn;
+      Dcal = R * Dcal;
+      b = R * b;
+    }
+  }
+
+  // Jacobians of the normalized point, see PinholeBase::Dpose and PinholeBase::Dpoint
+  Matrix26 Dpn_pose;
+  Dpn_pose << u * v, -1.0 - u * u, v, -d, 0.0, d * u,
+      1.0 + v * v, -u * v, -u, 0.0, -d, d * v;
+  Matrix23 Dpn_point;
+  Dpn_point << Rt.row(0) - u * Rt.row(2), Rt.row(1) - v * Rt.row(2);
+  Dpn_point *= d;
+
+  H1 << Dpi_pn * Dpn_pose, Dcal;
+  H2.noalias() = Dpi_pn * Dpn_point;
+  return boost::make_shared<BinaryJacobianFactor<2, DimC, DimL> >(key1, H1, key2, H2, b);
+}
+
+}
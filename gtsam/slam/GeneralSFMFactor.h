@@ -21,6 +21,7 @@
 #pragma once
 
 #include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/Cal3Bundler.h>
 #include <gtsam/geometry/Point2.h>
 #include <gtsam/geometry/Point3.h>
 #include <gtsam/geometry/Pose3.h>
@@ -189,6 +190,11 @@ private:
   }
 };
 
+/// Linearize the bundler factor with projection, distortion and whitening fused in one kernel
+template<>
+GTSAM_EXPORT boost::shared_ptr<GaussianFactor>
+GeneralSFMFactor<PinholeCamera<Cal3Bundler>, Point3>::linearize(const Values& values) const;
+
 template<class CAMERA, class LANDMARK>
 struct traits<GeneralSFMFactor<CAMERA, LANDMARK> > : Testable<
     GeneralSFMFactor<CAMERA, LANDMARK> > {
@@ -22,10 +22,21 @@
 #include <gtsam/nonlinear/GaussNewtonOptimizer.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/geometry/Pose3.h>
+#include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/Preconditioner.h>
 #include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <boost/make_shared.hpp>
 #include <boost/math/special_functions.hpp>
 
+#include <algorithm>
+
 using namespace std;
 
 namespace gtsam {
@@ -39,34 +50,104 @@ static const Matrix zero33= Matrix::Zero(3,3);
 static const Key keyAnchor = symbol('Z', 9999999);
 
 /* ************************************************************************* */
-GaussianFactorGraph buildLinearOrientationGraph(const NonlinearFactorGraph& g) {
+namespace {
+
+// The linear orientation factor of factor k of a graph of BetweenFactor<Pose3>: the rows of
+// the rotation of key2 are the rows of the rotation of key1 rotated by Rij
+void buildOrientationFactor(const NonlinearFactorGraph& g, size_t k,
+    const noiseModel::Unit::shared_ptr& model,
+    vector<GaussianFactor::shared_ptr>& factors) {
+  Matrix3 Rij;
+
+  boost::shared_ptr<BetweenFactor<Pose3> > pose3Between =
+      boost::dynamic_pointer_cast<BetweenFactor<Pose3> >(g[k]);
+  if (pose3Between)
+    Rij = pose3Between->measured().rotation().matrix();
+  else
+    std::cout << "Error in buildLinearOrientationGraph" << std::endl;
+
+  const FastVector<Key>& keys = g[k]->keys();
+  Key key1 = keys[0], key2 = keys[1];
+  Matrix M9 = Matrix::Zero(9,9);
+  M9.block(0,0,3,3) = Rij;
+  M9.block(3,3,3,3) = Rij;
+  M9.block(6,6,3,3) = Rij;
+  factors[k] = boost::make_shared<JacobianFactor>(key1, -I9, key2, M9, zero9, model);
+}
 
-  GaussianFactorGraph linearGraph;
-  noiseModel::Unit::shared_ptr model = noiseModel::Unit::Create(9);
+// Project the relaxed rotation of slot k onto SO(3)
+void normalizeRotation(const vector<const Vector*>& relaxed, size_t k,
+    vector<Rot3>& rotations) {
+  const Vector& rotVector = *relaxed[k];
+  Matrix3 rotMat;
+  rotMat(0,0) = rotVector(0); rotMat(0,1) = rotVector(1); rotMat(0,2) = rotVector(2);
+  rotMat(1,0) = rotVector(3); rotMat(1,1) = rotVector(4); rotMat(1,2) = rotVector(5);
+  rotMat(2,0) = rotVector(6); rotMat(2,1) = rotVector(7); rotMat(2,2) = rotVector(8);
+
+  Matrix U, V; Vector s;
+  svd(rotMat, U, s, V);
+  Matrix3 normalizedRotMat = U * V.transpose();
+
+  if(normalizedRotMat.determinant() < 0) {
+    Matrix ppm = Matrix::Zero(3,3); // plus plus minus
+    ppm(0,0) = 1; ppm(1,1) = 1; ppm(2,2) = -1;
+    normalizedRotMat = U * ppm * V.transpose();
+  }
 
-  BOOST_FOREACH(const boost::shared_ptr<NonlinearFactor>& factor, g) {
-    Matrix3 Rij;
+  rotations[k] = Rot3(normalizedRotMat);
+}
 
-    boost::shared_ptr<BetweenFactor<Pose3> > pose3Between =
-        boost::dynamic_pointer_cast<BetweenFactor<Pose3> >(factor);
-    if (pose3Between)
-      Rij = pose3Between->measured().rotation().matrix();
-    else
-      std::cout << "Error in buildLinearOrientationGraph" << std::endl;
-
-    // std::cout << "Rij \n" << Rij << std::endl;
-
-    const FastVector<Key>& keys = factor->keys();
-    Key key1 = keys[0], key2 = keys[1];
-    Matrix M9 = Matrix::Zero(9,9);
-    M9.block(0,0,3,3) = Rij;
-    M9.block(3,3,3,3) = Rij;
-    M9.block(6,6,3,3) = Rij;
-    linearGraph.add(key1, -I9, key2, M9, zero9, model);
+#ifdef GTSAM_USE_TBB
+class BuildOrientationFactors {
+  const NonlinearFactorGraph& g_;
+  const noiseModel::Unit::shared_ptr& model_;
+  vector<GaussianFactor::shared_ptr>& factors_;
+public:
+  BuildOrientationFactors(const NonlinearFactorGraph& g,
+      const noiseModel::Unit::shared_ptr& model,
+      vector<GaussianFactor::shared_ptr>& factors) :
+      g_(g), model_(model), factors_(factors) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& r) const {
+    for (size_t k = r.begin(); k != r.end(); ++k)
+      buildOrientationFactor(g_, k, model_, factors_);
   }
+};
+
+class NormalizeRotations {
+  const vector<const Vector*>& relaxed_;
+  vector<Rot3>& rotations_;
+public:
+  NormalizeRotations(const vector<const Vector*>& relaxed, vector<Rot3>& rotations) :
+      relaxed_(relaxed), rotations_(rotations) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& r) const {
+    for (size_t k = r.begin(); k != r.end(); ++k)
+      normalizeRotation(relaxed_, k, rotations_);
+  }
+};
+#endif
+
+} // namespace
+
+/* ************************************************************************* */
+GaussianFactorGraph buildLinearOrientationGraph(const NonlinearFactorGraph& g) {
+
+  noiseModel::Unit::shared_ptr model = noiseModel::Unit::Create(9);
+
+  // The factors are independent, so they can be built in parallel
+  vector<GaussianFactor::shared_ptr> factors(g.size() + 1);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, g.size()),
+      BuildOrientationFactors(g, model, factors));
+#else
+  for (size_t k = 0; k < g.size(); ++k)
+    buildOrientationFactor(g, k, model, factors);
+#endif
   // prior on the anchor orientation
-  linearGraph.add(keyAnchor, I9, (Vector(9) << 1.0, 0.0, 0.0,/*  */ 0.0, 1.0, 0.0, /*  */ 0.0, 0.0, 1.0).finished(), model);
-  return linearGraph;
+  factors[g.size()] = boost::make_shared<JacobianFactor>(keyAnchor, I9,
+      (Vector(9) << 1.0, 0.0, 0.0,/*  */ 0.0, 1.0, 0.0, /*  */ 0.0, 0.0, 1.0).finished(), model);
+  return GaussianFactorGraph(factors.begin(), factors.end());
 }
 
 /* ************************************************************************* */
@@ -74,34 +155,30 @@ GaussianFactorGraph buildLinearOrientationGraph(const NonlinearFactorGraph& g) {
 Values normalizeRelaxedRotations(const VectorValues& relaxedRot3) {
   gttic(InitializePose3_computeOrientationsChordal);
 
-  Matrix ppm = Matrix::Zero(3,3); // plus plus minus
-  ppm(0,0) = 1; ppm(1,1) = 1; ppm(2,2) = -1;
-
-  Values validRot3;
+  KeyVector keys;
+  vector<const Vector*> relaxed;
+  keys.reserve(relaxedRot3.size());
+  relaxed.reserve(relaxedRot3.size());
   BOOST_FOREACH(const VectorValues::value_type& it, relaxedRot3) {
-    Key key = it.first;
-    if (key != keyAnchor) {
-      const Vector& rotVector = it.second;
-      Matrix3 rotMat;
-      rotMat(0,0) = rotVector(0); rotMat(0,1) = rotVector(1); rotMat(0,2) = rotVector(2);
-      rotMat(1,0) = rotVector(3); rotMat(1,1) = rotVector(4); rotMat(1,2) = rotVector(5);
-      rotMat(2,0) = rotVector(6); rotMat(2,1) = rotVector(7); rotMat(2,2) = rotVector(8);
-
-      Matrix U, V; Vector s;
-      svd(rotMat, U, s, V);
-      Matrix3 normalizedRotMat = U * V.transpose();
-
-      //      std::cout << "rotMat \n" << rotMat << std::endl;
-      //      std::cout << "U V' \n" << U * V.transpose() << std::endl;
-      //      std::cout << "V \n" << V << std::endl;
-
-      if(normalizedRotMat.determinant() < 0)
-        normalizedRotMat = U * ppm * V.transpose();
-
-      Rot3 initRot = Rot3(normalizedRotMat);
-      validRot3.insert(key, initRot);
+    if (it.first != keyAnchor) {
+      keys.push_back(it.first);
+      relaxed.push_back(&it.second);
     }
   }
+
+  // One SVD per rotation, in parallel
+  vector<Rot3> rotations(keys.size());
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, keys.size()),
+      NormalizeRotations(relaxed, rotations));
+#else
+  for (size_t k = 0; k < keys.size(); ++k)
+    normalizeRotation(relaxed, k, rotations);
+#endif
+
+  Values validRot3;
+  for (size_t k = 0; k < keys.size(); ++k)
+    validRot3.insert(keys[k], rotations[k]);
   return validRot3;
 }
 
@@ -145,33 +222,176 @@ Values computeOrientationsChordal(const NonlinearFactorGraph& pose3Graph) {
   return normalizeRelaxedRotations(relaxedRot3);
 }
 
+/* ************************************************************************* */
+PCGSolverParameters chordalPCGParameters() {
+  PCGSolverParameters parameters;
+  parameters.preconditioner_ = boost::make_shared<BlockJacobiPreconditionerParameters>();
+  parameters.blas_kernel_ = ConjugateGradientParameters::BSR;
+  parameters.setMaxIterations(1000);
+  parameters.setReset(1001);
+  parameters.setEpsilon_rel(1e-8);
+  parameters.setEpsilon_abs(1e-12);
+  return parameters;
+}
+
 /* ************************************************************************* */
 // Return the orientations of a graph including only BetweenFactors<Pose3>
-Values computeOrientationsGradient(const NonlinearFactorGraph& pose3Graph, const Values& givenGuess, const size_t maxIter, const bool setRefFrame) {
-  gttic(InitializePose3_computeOrientationsGradient);
+Values computeOrientationsChordal(const NonlinearFactorGraph& pose3Graph,
+    const PCGSolverParameters& pcgParams) {
+  gttic(InitializePose3_computeOrientationsChordal);
 
-  // this works on the inverse rotations, according to Tron&Vidal,2011
-  Values inverseRot;
-  inverseRot.insert(keyAnchor, Rot3());
-  BOOST_FOREACH(const Values::ConstKeyValuePair& key_value, givenGuess) {
-    Key key = key_value.key;
-    const Pose3& pose = givenGuess.at<Pose3>(key);
-    inverseRot.insert(key, pose.rotation().inverse());
+  // regularize measurements and plug everything in a factor graph
+  GaussianFactorGraph relaxedGraph = buildLinearOrientationGraph(pose3Graph);
+
+  // Solve the LFG with PCG, starting from zero
+  VectorValues relaxedRot3 = PCGSolver(pcgParams).optimize(relaxedGraph);
+
+  // normalize and compute Rot3
+  return normalizeRelaxedRotations(relaxedRot3);
+}
+
+/* ************************************************************************* */
+namespace {
+
+// A relative rotation measurement of the gradient method, with the keys of its
+// BetweenFactor<Pose3> replaced by their indices in the sorted keys of the estimate
+struct GradientEdge {
+  size_t i1, i2;
+  Rot3 Rij;
+};
+
+// Gradient of edges [begin,end) with respect to both of their nodes
+void edgeGradients(size_t begin, size_t end, const vector<GradientEdge>& edges,
+    const vector<Rot3>& inverseRot, double a, double b,
+    vector<Vector3>& grad1, vector<Vector3>& grad2) {
+  for (size_t e = begin; e < end; ++e) {
+    const GradientEdge& edge = edges[e];
+    const Rot3& R1 = inverseRot[edge.i1];
+    const Rot3& R2 = inverseRot[edge.i2];
+    grad1[e] = gradientTron(R1, edge.Rij * R2, a, b);
+    grad2[e] = gradientTron(R2, edge.Rij.between(R1), a, b);
+  }
+}
+
+// Sum the gradients of the edges incident on nodes [begin,end), in the order of the factors,
+// and take a gradient step. An incident edge is stored as 2*e for its first key, 2*e+1 else.
+void nodeSteps(size_t begin, size_t end, const vector<size_t>& adjStarts,
+    const vector<size_t>& adjEdges, const vector<Vector3>& grad1,
+    const vector<Vector3>& grad2, double stepsize, vector<Rot3>& inverseRot,
+    vector<double>& normGrad) {
+  for (size_t i = begin; i < end; ++i) {
+    Vector3 gradKey = Vector3::Zero();
+    for (size_t k = adjStarts[i]; k < adjStarts[i + 1]; ++k) {
+      const size_t e = adjEdges[k] / 2;
+      gradKey = gradKey + ((adjEdges[k] % 2 == 0) ? grad1[e] : grad2[e]);
+    }
+    normGrad[i] = gradKey.norm();
+    inverseRot[i] = inverseRot[i].retract(stepsize * gradKey);
+  }
+}
+
+#ifdef GTSAM_USE_TBB
+class EdgeGradients {
+  const vector<GradientEdge>& edges_;
+  const vector<Rot3>& inverseRot_;
+  const double a_, b_;
+  vector<Vector3>& grad1_;
+  vector<Vector3>& grad2_;
+public:
+  EdgeGradients(const vector<GradientEdge>& edges, const vector<Rot3>& inverseRot,
+      double a, double b, vector<Vector3>& grad1, vector<Vector3>& grad2) :
+      edges_(edges), inverseRot_(inverseRot), a_(a), b_(b), grad1_(grad1), grad2_(grad2) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& r) const {
+    edgeGradients(r.begin(), r.end(), edges_, inverseRot_, a_, b_, grad1_, grad2_);
+  }
+};
+
+class NodeSteps {
+  const vector<size_t>& adjStarts_;
+  const vector<size_t>& adjEdges_;
+  const vector<Vector3>& grad1_;
+  const vector<Vector3>& grad2_;
+  const double stepsize_;
+  vector<Rot3>& inverseRot_;
+  vector<double>& normGrad_;
+public:
+  NodeSteps(const vector<size_t>& adjStarts, const vector<size_t>& adjEdges,
+      const vector<Vector3>& grad1, const vector<Vector3>& grad2, double stepsize,
+      vector<Rot3>& inverseRot, vector<double>& normGrad) :
+      adjStarts_(adjStarts), adjEdges_(adjEdges), grad1_(grad1), grad2_(grad2),
+      stepsize_(stepsize), inverseRot_(inverseRot), normGrad_(normGrad) {
   }
+  void operator()(const tbb::blocked_range<size_t>& r) const {
+    nodeSteps(r.begin(), r.end(), adjStarts_, adjEdges_, grad1_, grad2_, stepsize_,
+        inverseRot_, normGrad_);
+  }
+};
+#endif
+
+// Index of a key in sorted keys, throws if it is not there
+size_t keyIndex(const KeyVector& keys, Key key) {
+  KeyVector::const_iterator it = lower_bound(keys.begin(), keys.end(), key);
+  if (it == keys.end() || *it != key)
+    throw ValuesKeyDoesNotExist("computeOrientationsGradient", key);
+  return it - keys.begin();
+}
 
-  // Create the map of edges incident on each node
-  KeyVectorMap adjEdgesMap;
-  KeyRotMap factorId2RotMap;
+} // namespace
 
-  createSymbolicGraph(adjEdgesMap, factorId2RotMap, pose3Graph);
+/* ************************************************************************* */
+// Return the orientations of a graph including only BetweenFactors<Pose3>
+Values computeOrientationsGradient(const NonlinearFactorGraph& pose3Graph, const Values& givenGuess, const size_t maxIter, const bool setRefFrame) {
+  gttic(InitializePose3_computeOrientationsGradient);
+
+  // this works on the inverse rotations, according to Tron&Vidal,2011, indexed by sorted key
+  KeyVector keys;
+  keys.reserve(givenGuess.size() + 1);
+  BOOST_FOREACH(const Values::ConstKeyValuePair& key_value, givenGuess)
+    keys.push_back(key_value.key);
+  keys.insert(upper_bound(keys.begin(), keys.end(), keyAnchor), keyAnchor);
+  if (adjacent_find(keys.begin(), keys.end()) != keys.end())
+    throw ValuesKeyAlreadyExists(keyAnchor);
+  vector<Rot3> inverseRot(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i)
+    if (keys[i] != keyAnchor)
+      inverseRot[i] = givenGuess.at<Pose3>(keys[i]).rotation().inverse();
+
+  // The edges, and the edges incident on each node in the order of the factors
+  vector<GradientEdge> edges;
+  edges.reserve(pose3Graph.size());
+  vector<size_t> adjStarts(keys.size() + 1, 0);
+  BOOST_FOREACH(const boost::shared_ptr<NonlinearFactor>& factor, pose3Graph) {
+    boost::shared_ptr<BetweenFactor<Pose3> > pose3Between =
+        boost::dynamic_pointer_cast<BetweenFactor<Pose3> >(factor);
+    if (pose3Between){
+      GradientEdge edge;
+      edge.i1 = keyIndex(keys, pose3Between->key1());
+      edge.i2 = keyIndex(keys, pose3Between->key2());
+      edge.Rij = pose3Between->measured().rotation();
+      edges.push_back(edge);
+      ++adjStarts[edge.i1 + 1];
+      ++adjStarts[edge.i2 + 1];
+    }else{
+      std::cout << "Error in computeOrientationsGradient" << std::endl;
+    }
+  }
+  for (size_t i = 0; i < keys.size(); ++i)
+    adjStarts[i + 1] += adjStarts[i];
+  vector<size_t> adjEdges(adjStarts.back());
+  vector<size_t> adjNext(adjStarts.begin(), adjStarts.end() - 1);
+  for (size_t e = 0; e < edges.size(); ++e) {
+    adjEdges[adjNext[edges[e].i1]++] = 2 * e;
+    // a self loop uses the gradient of its first key twice
+    adjEdges[adjNext[edges[e].i2]++] = 2 * e + (edges[e].i1 == edges[e].i2 ? 0 : 1);
+  }
 
-  // calculate max node degree & allocate gradient
+  // calculate max node degree
   size_t maxNodeDeg = 0;
-  VectorValues grad;
-  BOOST_FOREACH(const Values::ConstKeyValuePair& key_value, inverseRot) {
-    Key key = key_value.key;
-    grad.insert(key,Vector3::Zero());
-    size_t currNodeDeg = (adjEdgesMap.at(key)).size();
+  for (size_t i = 0; i < keys.size(); ++i) {
+    size_t currNodeDeg = adjStarts[i + 1] - adjStarts[i];
+    if (currNodeDeg == 0)
+      throw std::out_of_range("computeOrientationsGradient: node without edges");
     if(currNodeDeg > maxNodeDeg)
       maxNodeDeg = currNodeDeg;
   }
@@ -186,47 +406,25 @@ Values computeOrientationsGradient(const NonlinearFactorGraph& pose3Graph, const
 
   std::cout <<" b " << b <<" f0 " << f0 <<" a " << a <<" rho " << rho <<" stepsize " << stepsize << " maxNodeDeg "<< maxNodeDeg << std::endl;
   double maxGrad;
+  vector<Vector3> grad1(edges.size()), grad2(edges.size());
+  vector<double> normGrad(keys.size());
   // gradient iterations
   size_t it;
   for(it=0; it < maxIter; it++){
     //////////////////////////////////////////////////////////////////////////
-    // compute the gradient at each node
-    //std::cout << "it  " << it <<" b " << b <<" f0 " << f0 <<" a " << a
-    //   <<" rho " << rho <<" stepsize " << stepsize << " maxNodeDeg "<< maxNodeDeg << std::endl;
-    maxGrad = 0;
-    BOOST_FOREACH(const Values::ConstKeyValuePair& key_value, inverseRot) {
-      Key key = key_value.key;
-      //std::cout << "---------------------------key  " << DefaultKeyFormatter(key) << std::endl;
-      Vector gradKey = Vector3::Zero();
-      // collect the gradient for each edge incident on key
-      BOOST_FOREACH(const size_t& factorId, adjEdgesMap.at(key)){
-        Rot3 Rij = factorId2RotMap.at(factorId);
-        Rot3 Ri = inverseRot.at<Rot3>(key);
-        if( key == (pose3Graph.at(factorId))->keys()[0] ){
-          Key key1 = (pose3Graph.at(factorId))->keys()[1];
-          Rot3 Rj = inverseRot.at<Rot3>(key1);
-          gradKey = gradKey + gradientTron(Ri, Rij  * Rj, a, b);
-          //std::cout << "key1 " << DefaultKeyFormatter(key1) << " gradientTron(Ri, Rij  * Rj, a, b) \n " << gradientTron(Ri, Rij  * Rj, a, b) << std::endl;
-        }else if( key == (pose3Graph.at(factorId))->keys()[1] ){
-          Key key0 = (pose3Graph.at(factorId))->keys()[0];
-          Rot3 Rj = inverseRot.at<Rot3>(key0);
-          gradKey = gradKey + gradientTron(Ri, Rij.between(Rj), a, b);
-          //std::cout << "key0 " << DefaultKeyFormatter(key0) << " gradientTron(Ri, Rij.inverse()  * Rj, a, b) \n " << gradientTron(Ri, Rij.between(Rj), a, b) << std::endl;
-        }else{
-          std::cout << "Error in gradient computation" << std::endl;
-        }
-      } // end of i-th gradient computation
-      grad.at(key) = stepsize *  gradKey;
-
-      double normGradKey = (gradKey).norm();
-      //std::cout << "key  " << DefaultKeyFormatter(key) <<" \n grad \n" << grad.at(key) << std::endl;
-      if(normGradKey>maxGrad)
-        maxGrad = normGradKey;
-    } // end of loop over nodes
-
-    //////////////////////////////////////////////////////////////////////////
-    // update estimates
-    inverseRot = inverseRot.retract(grad);
+    // compute the gradient of each edge, then sum them at each node and update its estimate:
+    // both only read the estimates of the previous iteration, so they run in parallel
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, edges.size()),
+        EdgeGradients(edges, inverseRot, a, b, grad1, grad2));
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, keys.size()),
+        NodeSteps(adjStarts, adjEdges, grad1, grad2, stepsize, inverseRot, normGrad));
+#else
+    edgeGradients(0, edges.size(), edges, inverseRot, a, b, grad1, grad2);
+    nodeSteps(0, keys.size(), adjStarts, adjEdges, grad1, grad2, stepsize, inverseRot,
+        normGrad);
+#endif
+    maxGrad = *max_element(normGrad.begin(), normGrad.end());
 
     //////////////////////////////////////////////////////////////////////////
     // check stopping condition
@@ -237,16 +435,15 @@ Values computeOrientationsGradient(const NonlinearFactorGraph& pose3Graph, const
   std::cout << "nr of gradient iterations " << it << "maxGrad " << maxGrad <<  std::endl;
 
   // Return correct rotations
-  const Rot3& Rref = inverseRot.at<Rot3>(keyAnchor); // This will be set to the identity as so far we included no prior
+  const Rot3& Rref = inverseRot[keyIndex(keys, keyAnchor)]; // This will be set to the identity as so far we included no prior
   Values estimateRot;
-  BOOST_FOREACH(const Values::ConstKeyValuePair& key_value, inverseRot) {
-    Key key = key_value.key;
-    if (key != keyAnchor) {
-      const Rot3& R = inverseRot.at<Rot3>(key);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (keys[i] != keyAnchor) {
+      const Rot3& R = inverseRot[i];
       if(setRefFrame)
-        estimateRot.insert(key, Rref.compose(R.inverse()));
+        estimateRot.insert(keys[i], Rref.compose(R.inverse()));
       else
-        estimateRot.insert(key, R.inverse());
+        estimateRot.insert(keys[i], R.inverse());
     }
   }
   return estimateRot;
@@ -374,6 +571,21 @@ Values initialize(const NonlinearFactorGraph& graph) {
   return computePoses(pose3Graph, valueRot3);
 }
 
+/* ************************************************************************* */
+Values initialize(const NonlinearFactorGraph& graph, const PCGSolverParameters& pcgParams) {
+  gttic(InitializePose3_initialize);
+
+  // We "extract" the Pose3 subgraph of the original graph: this
+  // is done to properly model priors and avoiding operating on a larger graph
+  NonlinearFactorGraph pose3Graph = buildPose3graph(graph);
+
+  // Get orientations from relative orientation measurements, iteratively
+  Values valueRot3 = computeOrientationsChordal(pose3Graph, pcgParams);
+
+  // Compute the full poses (1 GN iteration on full poses)
+  return computePoses(pose3Graph, valueRot3);
+}
+
 /* ************************************************************************* */
 Values initialize(const NonlinearFactorGraph& graph, const Values& givenGuess, bool useGradient) {
   Values initialValues;
@@ -23,6 +23,7 @@
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/linear/PCGSolver.h>
 #include <gtsam/inference/graph.h>
 #include <gtsam/geometry/Rot3.h>
 
@@ -39,6 +40,17 @@ GTSAM_EXPORT Values normalizeRelaxedRotations(const VectorValues& relaxedRot3);
 
 GTSAM_EXPORT Values computeOrientationsChordal(const NonlinearFactorGraph& pose3Graph);
 
+/// PCG with the BSR kernel and a block-Jacobi preconditioner, tight enough for the chordal relaxation
+GTSAM_EXPORT PCGSolverParameters chordalPCGParameters();
+
+/**
+ * Solve the chordal relaxation with PCG instead of by elimination, e.g. with
+ * chordalPCGParameters(). The relaxation has a 9-dimensional variable per pose, which makes
+ * elimination expensive on large graphs.
+ */
+GTSAM_EXPORT Values computeOrientationsChordal(const NonlinearFactorGraph& pose3Graph,
+    const PCGSolverParameters& pcgParams);
+
 GTSAM_EXPORT Values computeOrientationsGradient(const NonlinearFactorGraph& pose3Graph,
     const Values& givenGuess, size_t maxIter = 10000, const bool setRefFrame = true);
 
@@ -53,6 +65,9 @@ GTSAM_EXPORT Values computePoses(NonlinearFactorGraph& pose3graph,  Values& init
 
 GTSAM_EXPORT Values initialize(const NonlinearFactorGraph& graph);
 
+/// Initialize with the chordal relaxation solved by PCG, see computeOrientationsChordal
+GTSAM_EXPORT Values initialize(const NonlinearFactorGraph& graph, const PCGSolverParameters& pcgParams);
+
 GTSAM_EXPORT Values initialize(const NonlinearFactorGraph& graph, const Values& givenGuess, bool useGradient = false);
 
 } // end of namespace lago
@@ -53,22 +53,22 @@ public:
   JacobianFactorQ(const FastVector<Key>& keys,
       const std::vector<MatrixZD>& FBlocks, const Matrix& E, const Matrix3& P,
       const Vector& b, const SharedDiagonal& model = SharedDiagonal()) :
-      Base() {
-    size_t j = 0, m2 = E.rows(), m = m2 / ZDim;
-    // Calculate projector Q
-    Matrix Q = eye(m2) - E * P * E.transpose();
-    // Calculate pre-computed Jacobian matrices
-    // TODO: can we do better ?
-    std::vector<KeyMatrix> QF;
-    QF.reserve(m);
-    // Below, we compute each mZDim*D block A_j = Q_j * F_j = (mZDim*ZDim) * (Zdim*D)
-    for (size_t k = 0; k < FBlocks.size(); ++k) {
-      Key key = keys[k];
-      QF.push_back(
-          KeyMatrix(key, - Q.block(0, ZDim * j++, m2, ZDim) * FBlocks[k]));
-    }
-    // Which is then passed to the normal JacobianFactor constructor
-    JacobianFactor::fillTerms(QF, - Q * b, model);
+      Base(keys, E.rows(), model) {
+    size_t m2 = E.rows(), m = m2 / ZDim;
+    if (model && (size_t) model->dim() != m2)
+      throw InvalidNoiseModel(m2, model->dim());
+    // With Q = I - E*P*E', each mZDim*D block A_j = Q_j * F_j = F_j - E * (P * E_j' * F_j),
+    // where F_j is padded with zeros. With all P * E_j' * F_j computed first, the correction
+    // is a single matrix product, and the dense mZDim*mZDim projector Q is never formed.
+    Matrix PEtF(3, m * D);
+    for (size_t k = 0; k < m; ++k)
+      PEtF.block<3, D>(0, D * k) = P * E.block<ZDim, 3>(ZDim * k, 0).transpose()
+          * FBlocks[k];
+    // The blocks -A_j and the RHS -Q*b are written directly into the augmented matrix
+    this->Ab_.range(0, m).noalias() = E * PEtF;
+    for (size_t k = 0; k < m; ++k)
+      this->Ab_(k).template block<ZDim, D>(ZDim * k, 0) -= FBlocks[k];
+    this->Ab_(m).col(0) = E * (P * (E.transpose() * b)) - b;
   }
 };
 // end class JacobianFactorQ
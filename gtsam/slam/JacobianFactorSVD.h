@@ -6,6 +6,7 @@
 
 #pragma once
 #include <gtsam/linear/RegularJacobianFactor.h>
+#include <Eigen/QR>
 
 namespace gtsam {
 /**
@@ -67,6 +68,66 @@ public:
     }
     JacobianFactor::fillTerms(QF, Enull.transpose() * b, model);
   }
+
+private:
+
+  /// Uninitialized factor with the given number of rows, see FromPointJacobian
+  JacobianFactorSVD(const FastVector<Key>& keys, DenseIndex rows,
+      const SharedDiagonal& model) :
+      Base(keys, rows, model) {
+    if (model && (DenseIndex) model->dim() != rows)
+      throw InvalidNoiseModel(rows, model->dim());
+  }
+
+public:
+
+  /**
+   * @brief Create from the point Jacobian E itself, without forming a null-space basis
+   * Projects [F b] onto the null space of E's transpose with the Householder reflections of
+   * a QR factorization of E, in compact form I - V*T*V', and keeps the last ZDim*m - N rows.
+   * Because F is block-diagonal, V'*F costs O(m), and the projection is a single matrix product
+   * instead of the (ZDim*m)^2 basis of an SVD.  The result spans the same row space as the
+   * factor created from the SVD basis of E, so it has the same Hessian and error.
+   */
+  static boost::shared_ptr<JacobianFactorSVD> FromPointJacobian(
+      const FastVector<Key>& keys, const std::vector<MatrixZD>& Fblocks,
+      const Matrix& E, const Vector& b, //
+      const SharedDiagonal& model = SharedDiagonal()) {
+    const size_t M = E.rows(), N = E.cols(), m = Fblocks.size();
+
+    // Householder vectors V (unit lower trapezoidal) and coefficients of E = Q*R
+    Eigen::HouseholderQR<Matrix> qr(E);
+    Matrix V = qr.matrixQR().template triangularView<Eigen::StrictlyLower>();
+    V.diagonal().setOnes();
+    const Vector& tau = qr.hCoeffs();
+
+    // Upper triangular T with Q = H_0 * ... * H_{N-1} = I - V*T*V'
+    Matrix T = Matrix::Zero(N, N);
+    for (size_t i = 0; i < N; ++i) {
+      T(i, i) = tau(i);
+      if (i > 0)
+        T.col(i).head(i) = -tau(i) * (T.topLeftCorner(i, i).template triangularView<Eigen::Upper>()
+            * (V.leftCols(i).transpose() * V.col(i)));
+    }
+
+    // W = T'*V'*[F b], using that F is block-diagonal
+    Matrix W(N, m * D + 1);
+    for (size_t k = 0; k < m; ++k)
+      W.block(0, D * k, N, D) = V.block(k * ZDim, 0, ZDim, N).transpose() * Fblocks[k];
+    W.col(m * D) = V.transpose() * b;
+    W = T.transpose() * W;
+
+    // Q'*[F b] = [F b] - V*W, of which the first N rows belong to the point and the others are
+    // written directly into the augmented matrix of the factor
+    boost::shared_ptr<JacobianFactorSVD> factor(new JacobianFactorSVD(keys, M - N, model));
+    factor->Ab_.full().noalias() = -V.bottomRows(M - N) * W;
+    for (size_t k = 0; k < m; ++k)
+      for (size_t r = 0; r < ZDim; ++r)
+        if (ZDim * k + r >= N)
+          factor->Ab_(k).row(ZDim * k + r - N) += Fblocks[k].row(r);
+    factor->Ab_(m).col(0) += b.tail(M - N);
+    return factor;
+  }
 };
 
 }
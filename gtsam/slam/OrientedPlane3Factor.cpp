@@ -19,6 +19,79 @@ void OrientedPlane3Factor::print(const string& s,
   this->noiseModel_->print("  noise model: ");
 }
 
+//***************************************************************************
+namespace {
+// The error of a plane measured from a pose, given as the transpose of its rotation and its
+// translation, with fixed-size Jacobians.  It is the error of OrientedPlane3::transform followed by
+// OrientedPlane3::error, computing the basis of the predicted normal once.
+Vector3 planeError(const Matrix3& Rt, const Vector3& t, const OrientedPlane3& plane,
+    const OrientedPlane3& measured, OptionalJacobian<3, 6> H1,
+    OptionalJacobian<3, 3> H2) {
+  const Unit3& n = plane.normal();
+  const Vector3 nv = n.unitVector();
+  const Unit3 predicted(Vector3(Rt * nv));
+  const double predicted_d = nv.dot(t) + plane.distance();
+  if (H1) {
+    H1->setZero();
+    H1->block<2, 3>(0, 0) = predicted.basis().transpose() * predicted.skew();
+    H1->block<1, 3>(2, 3) = predicted.unitVector().transpose();
+  }
+  if (H2) {
+    const Matrix32& B = n.basis();
+    H2->setZero();
+    H2->block<2, 2>(0, 0) = predicted.basis().transpose() * Rt * B;
+    H2->block<1, 2>(2, 0) = t.transpose() * B;
+    (*H2)(2, 2) = 1;
+  }
+  const Vector2 n_error = -predicted.localCoordinates(measured.normal());
+  return Vector3(n_error(0), n_error(1), predicted_d - measured.distance());
+}
+}
+
+//***************************************************************************
+Vector OrientedPlane3Factor::evaluateError(const Pose3& pose,
+    const OrientedPlane3& plane, boost::optional<Matrix&> H1,
+    boost::optional<Matrix&> H2) const {
+  Matrix36 D_pose;
+  Matrix33 D_plane;
+  const Vector3 e = planeError(pose.rotation().transpose(),
+      pose.translation().vector(), plane, measured_p_, H1 ? &D_pose : 0,
+      H2 ? &D_plane : 0);
+  if (H1)
+    *H1 = D_pose;
+  if (H2)
+    *H2 = D_plane;
+  return e;
+}
+
+//***************************************************************************
+Matrix OrientedPlane3Factor::EvaluateBatch(const Pose3& pose,
+    const vector<OrientedPlane3>& planes, const vector<OrientedPlane3>& measured,
+    boost::optional<Matrix&> H1, boost::optional<Matrix&> H2) {
+  if (planes.size() != measured.size())
+    throw invalid_argument(
+        "OrientedPlane3Factor::EvaluateBatch: one measurement per plane is needed");
+  const size_t n = planes.size();
+  const Matrix3 Rt = pose.rotation().transpose();
+  const Vector3 t = pose.translation().vector();
+  Matrix errors(3, n);
+  if (H1)
+    H1->resize(3 * n, 6);
+  if (H2)
+    H2->resize(3 * n, 3);
+  Matrix36 D_pose;
+  Matrix33 D_plane;
+  for (size_t i = 0; i < n; i++) {
+    errors.col(i) = planeError(Rt, t, planes[i], measured[i], H1 ? &D_pose : 0,
+        H2 ? &D_plane : 0);
+    if (H1)
+      H1->block<3, 6>(3 * i, 0) = D_pose;
+    if (H2)
+      H2->block<3, 3>(3 * i, 0) = D_plane;
+  }
+  return errors;
+}
+
 //***************************************************************************
 void OrientedPlane3DirectionPrior::print(const string& s,
     const KeyFormatter& keyFormatter) const {
@@ -39,23 +112,13 @@ bool OrientedPlane3DirectionPrior::equals(const NonlinearFactor& expected,
 
 Vector OrientedPlane3DirectionPrior::evaluateError(const OrientedPlane3& plane,
     boost::optional<Matrix&> H) const {
-
+  // The normals are used by reference, so the basis of the measured one is computed only once
+  Matrix22 H_p;
+  const Vector2 e = measured_p_.normal().error(plane.normal(), H ? &H_p : 0);
   if (H) {
-    Matrix H_p;
-    Unit3 n_hat_p = measured_p_.normal();
-    Unit3 n_hat_q = plane.normal();
-    Vector e = n_hat_p.error(n_hat_q, H_p);
-    H->resize(2, 3);
-    H->block<2, 2>(0, 0) << H_p;
-    H->block<2, 1>(0, 2) << Matrix::Zero(2, 1);
-    return e;
-  } else {
-    Unit3 n_hat_p = measured_p_.normal();
-    Unit3 n_hat_q = plane.normal();
-    Vector e = n_hat_p.error(n_hat_q);
-    return e;
+    *H = Matrix23::Zero();
+    H->block<2, 2>(0, 0) = H_p;
   }
-
+  return e;
 }
 }
-
@@ -10,6 +10,8 @@
 #include <gtsam/geometry/OrientedPlane3.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 
+#include <vector>
+
 namespace gtsam {
 
 /**
@@ -43,17 +45,32 @@ public:
   virtual void print(const std::string& s = "OrientedPlane3Factor",
       const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
 
+  /// The measured plane
+  const OrientedPlane3& measured() const {
+    return measured_p_;
+  }
+
   /// evaluateError
   virtual Vector evaluateError(const Pose3& pose, const OrientedPlane3& plane,
       boost::optional<Matrix&> H1 = boost::none, boost::optional<Matrix&> H2 =
-          boost::none) const {
-    OrientedPlane3 predicted_plane = OrientedPlane3::Transform(plane, pose, H1,
-        H2);
-    Vector err(3);
-    err << predicted_plane.error(measured_p_);
-    return (err);
-  }
-  ;
+          boost::none) const;
+
+  /**
+   * Errors of many planes measured from one pose, with the rotation and translation of the pose
+   * taken out of the loop over the planes.  The error and Jacobians of each plane are those of
+   * evaluateError.
+   * @param pose the pose all planes are measured from
+   * @param planes the plane landmarks
+   * @param measured the measured planes, one per landmark
+   * @param H1 optional 3n*6 Jacobians wrpt the pose, stacked in the order of the planes
+   * @param H2 optional 3n*3 Jacobians wrpt each plane, stacked in the order of the planes
+   * @return 3*n matrix with the error of each plane in a column
+   */
+  static Matrix EvaluateBatch(const Pose3& pose,
+      const std::vector<OrientedPlane3>& planes,
+      const std::vector<OrientedPlane3>& measured,
+      boost::optional<Matrix&> H1 = boost::none,
+      boost::optional<Matrix&> H2 = boost::none);
 };
 
 // TODO: Convert this factor to dimension two, three dimensions is redundant for direction prior
@@ -0,0 +1,58 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  PriorFactor.cpp
+ *  @brief Specialized linearization of PriorFactor
+ *  @date  Oct 15, 2026
+ **/
+
+#include <gtsam/slam/PriorFactor.h>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+template<>
+boost::shared_ptr<GaussianFactor> PriorFactor<Pose3>::linearize(
+    const Values& x) const {
+  // Only Gaussian noise models are whitened here, constrained and robust ones are not
+  const SharedNoiseModel& noiseModel = this->get_noiseModel();
+  const noiseModel::Gaussian* gaussian =
+      dynamic_cast<const noiseModel::Gaussian*>(noiseModel.get());
+  if (noiseModel && (!gaussian || noiseModel->isConstrained()))
+    return Base::linearize(x);
+
+  // Only linearize if the factor is active
+  if (!this->active(x))
+    return boost::shared_ptr<JacobianFactor>();
+
+  // Same error as evaluateError, whose Jacobian is the identity, so that the whitened
+  // Jacobian is the square root information itself
+  const Key key = this->key();
+  Vector6 b = traits<Pose3>::Local(x.at<Pose3>(key), prior_);
+  Matrix6 A = Matrix6::Identity();
+  if (gaussian && !gaussian->isUnit()) {
+    const noiseModel::Diagonal* diagonal =
+        dynamic_cast<const noiseModel::Diagonal*>(gaussian);
+    if (diagonal) {
+      const Vector6 invsigmas = diagonal->invsigmas();
+      A = invsigmas.asDiagonal();
+      b.array() *= invsigmas.array();
+    } else {
+      A = gaussian->R();
+      b = A * b;
+    }
+  }
+
+  return boost::make_shared<UnaryJacobianFactor<6, 6> >(key, A, b);
+}
+
+}
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/geometry/Pose3.h>
 #include <gtsam/base/Testable.h>
 
 namespace gtsam {
@@ -92,6 +93,14 @@ namespace gtsam {
       return -traits<T>::Local(x, prior_);
     }
 
+    /**
+     * Linearize to a JacobianFactor.  Specialized with fixed-size Jacobians for
+     * some types, see PriorFactor.cpp.
+     */
+    virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+      return Base::linearize(x);
+    }
+
     const VALUE & prior() const { return prior_; }
 
   private:
@@ -106,4 +115,9 @@ namespace gtsam {
     }
   };
 
+  /// Linearize a PriorFactor<Pose3> with a fixed-size Jacobian and whitening
+  template<>
+  GTSAM_EXPORT boost::shared_ptr<GaussianFactor> PriorFactor<Pose3>::linearize(
+      const Values& x) const;
+
 } /// namespace gtsam
@@ -10,6 +10,7 @@
 #include <gtsam/geometry/CameraSet.h>
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/ScratchBuffer.h>
 #include <boost/foreach.hpp>
 #include <iosfwd>
 
@@ -211,7 +212,7 @@ public:
       //      blocks[j] = Fj.transpose() * Fj
       //          - FtE * PointCovariance_ * FtE.transpose();
 
-      const Matrix23& Ej = E_.block<ZDim, 3>(ZDim * pos, 0);
+      const Eigen::Matrix<double, ZDim, 3> Ej = E_.block<ZDim, 3>(ZDim * pos, 0);
       blocks[j] = Fj.transpose()
           * (Fj - Ej * PointCovariance_ * Ej.transpose() * Fj);
 
@@ -253,26 +254,89 @@ public:
     y += F.transpose() * e3;
   }
 
-  typedef std::vector<Vector2> Error2s;
+  typedef Eigen::Matrix<double, ZDim, 1> ZVector;
+  typedef std::vector<ZVector> Error2s;
+
+protected:
+
+  typedef Eigen::Matrix<double, D, 1> DVector;
+
+  /// Access to the camera blocks of x and y in raw memory, see multiplyHessianAdd
+  struct RawAccess {
+    double* data;
+    explicit RawAccess(const double* data) : data(const_cast<double*>(data)) {}
+    Eigen::Map<DVector> operator()(Key key) const {
+      return Eigen::Map<DVector>(data + D * key);
+    }
+  };
+
+  /// Access to the camera blocks of x in a VectorValues
+  struct ConstVectorValuesAccess {
+    const VectorValues& x;
+    explicit ConstVectorValuesAccess(const VectorValues& x) : x(x) {}
+    const Vector& operator()(Key key) const { return x.at(key); }
+  };
+
+  /// Access to the camera blocks of y in a VectorValues, inserting zero blocks where needed
+  struct VectorValuesAccess {
+    VectorValues& y;
+    explicit VectorValuesAccess(VectorValues& y) : y(y) {}
+    Vector& operator()(Key key) const {
+      static const Vector empty;
+      std::pair<VectorValues::iterator, bool> it = y.tryInsert(key, empty);
+      if (it.second)
+        it.first->second = Vector::Zero(D);
+      return it.first->second;
+    }
+  };
 
   /**
-   * @brief Calculate corrected error Q*(e-ZDim*b) = (I - E*P*E')*(e-ZDim*b)
+   * y += F'*alpha*(I - E*P*E')*F*x, in two fused passes over the fixed-size blocks.  F*x is
+   * kept in per-thread scratch memory, so no memory is allocated and different factors can be
+   * multiplied concurrently.
+   */
+  template<class XACCESS, class YACCESS>
+  void fusedMultiplyHessianAdd(double alpha, const XACCESS& x, const YACCESS& y) const {
+    ScratchBuffer::Lease lease(size() * sizeof(ZVector));
+    ZVector* Fx = reinterpret_cast<ZVector*>(lease.data());
+
+    // d1 = E'*F*x = (3*2m)*(2m*dm)*dm
+    Vector3 d1 = Vector3::Zero();
+    for (size_t k = 0; k < size(); ++k) {
+      Fx[k].noalias() = FBlocks_[k] * x(keys_[k]);
+      d1.noalias() += E_.block<ZDim, 3>(ZDim * k, 0).transpose() * Fx[k];
+    }
+
+    // d2 = P*d1 = (3*3)*3
+    const Vector3 d2 = Eigen::Map<const Matrix3>(PointCovariance_.data()) * d1;
+
+    // y += F'*alpha*(F*x - E*d2) = (dm*2m)*2m
+    for (size_t k = 0; k < size(); ++k) {
+      const ZVector e = alpha * (Fx[k] - E_.block<ZDim, 3>(ZDim * k, 0) * d2);
+      y(keys_[k]).noalias() += FBlocks_[k].transpose() * e;
+    }
+  }
+
+public:
+
+  /**
+   * @brief Calculate corrected error Q*(e-2*b) = (I - E*P*E')*(e-2*b)
    */
   void projectError2(const Error2s& e1, Error2s& e2) const {
 
-    // d1 = E.transpose() * (e1-ZDim*b) = (3*2m)*2m
+    // d1 = E.transpose() * (e1-2*b) = (3*2m)*2m
     Vector3 d1;
     d1.setZero();
     for (size_t k = 0; k < size(); k++)
       d1 += E_.block<ZDim, 3>(ZDim * k, 0).transpose()
-          * (e1[k] - ZDim * b_.segment<ZDim>(k * ZDim));
+          * (e1[k] - 2.0 * b_.segment<ZDim>(k * ZDim));
 
     // d2 = E.transpose() * e1 = (3*2m)*2m
     Vector3 d2 = PointCovariance_ * d1;
 
     // e3 = alpha*(e1 - E*d2) = 1*[2m-(2m*3)*3]
     for (size_t k = 0; k < size(); k++)
-      e2[k] = e1[k] - ZDim * b_.segment<ZDim>(k * ZDim)
+      e2[k] = e1[k] - 2.0 * b_.segment<ZDim>(k * ZDim)
           - E_.block<ZDim, 3>(ZDim * k, 0) * d2;
   }
 
@@ -344,7 +408,7 @@ public:
       e2[k] = e1[k] - E_.block<ZDim, 3>(ZDim * k, 0) * d2;
   }
 
-  /// Scratch space for multiplyHessianAdd
+  /// Scratch space for error and gradient computations
   mutable Error2s e1, e2;
 
   /**
@@ -352,29 +416,7 @@ public:
    * RAW memory access! Assumes keys start at 0 and go to M-1, and x and and y are laid out that way
    */
   void multiplyHessianAdd(double alpha, const double* x, double* y) const {
-
-    // Use eigen magic to access raw memory
-    typedef Eigen::Matrix<double, D, 1> DVector;
-    typedef Eigen::Map<DVector> DMap;
-    typedef Eigen::Map<const DVector> ConstDMap;
-
-    // resize does not do malloc if correct size
-    e1.resize(size());
-    e2.resize(size());
-
-    // e1 = F * x = (2m*dm)*dm
-    for (size_t k = 0; k < size(); ++k) {
-      Key key = keys_[k];
-      e1[k] = FBlocks_[k] * ConstDMap(x + D * key);
-    }
-
-    projectError(e1, e2);
-
-    // y += F.transpose()*e2 = (2d*2m)*2m
-    for (size_t k = 0; k < size(); ++k) {
-      Key key = keys_[k];
-      DMap(y + D * key) += FBlocks_[k].transpose() * alpha * e2[k];
-    }
+    fusedMultiplyHessianAdd(alpha, RawAccess(x), RawAccess(y));
   }
 
   void multiplyHessianAdd(double alpha, const double* x, double* y,
@@ -387,28 +429,7 @@ public:
    */
   void multiplyHessianAdd(double alpha, const VectorValues& x,
       VectorValues& y) const {
-
-    // resize does not do malloc if correct size
-    e1.resize(size());
-    e2.resize(size());
-
-    // e1 = F * x = (2m*dm)*dm
-    for (size_t k = 0; k < size(); ++k)
-      e1[k] = FBlocks_[k] * x.at(keys_[k]);
-
-    projectError(e1, e2);
-
-    // y += F.transpose()*e2 = (2d*2m)*2m
-    for (size_t k = 0; k < size(); ++k) {
-      Key key = keys_[k];
-      static const Vector empty;
-      std::pair<VectorValues::iterator, bool> it = y.tryInsert(key, empty);
-      Vector& yi = it.first->second;
-      // Create the value as a zero vector if it does not exist.
-      if (it.second)
-        yi = Vector::Zero(FBlocks_[k].cols());
-      yi += FBlocks_[k].transpose() * alpha * e2[k];
-    }
+    fusedMultiplyHessianAdd(alpha, ConstVectorValuesAccess(x), VectorValuesAccess(y));
   }
 
   /**
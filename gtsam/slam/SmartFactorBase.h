@@ -30,6 +30,8 @@
 
 #include <boost/optional.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/thread/tss.hpp>
+#include <map>
 #include <vector>
 
 namespace gtsam {
@@ -160,6 +162,7 @@ public:
   /// Collect all cameras: important that in key order
   virtual Cameras cameras(const Values& values) const {
     Cameras cameras;
+    cameras.reserve(this->keys_.size());
     BOOST_FOREACH(const Key& k, this->keys_)
       cameras.push_back(values.at<CAMERA>(k));
     return cameras;
@@ -275,22 +278,42 @@ public:
     Enull = svd.matrixU().block(0, N, ZDim * m, ZDim * m - N); // last ZDim*m-N columns
   }
 
+  /**
+   * Storage for the Jacobians F, E and the right-hand side b of one track, see Workspace.
+   */
+  struct JacobianWorkspace {
+    std::vector<MatrixZD> Fblocks;
+    Matrix E;
+    Vector b;
+  };
+
+  /**
+   * The workspace of the calling thread for tracks of length m.  Because every track length
+   * has its own workspace, and the workspaces are kept between calls, computing the Jacobians
+   * of a track into it does not allocate once a track of the same length has been seen.  The
+   * workspace is only valid until the next call on the same thread with the same m, and must
+   * not be used across threads.
+   */
+  static JacobianWorkspace& Workspace(size_t m) {
+    static boost::thread_specific_ptr<std::map<size_t, JacobianWorkspace> > workspaces;
+    if (!workspaces.get())
+      workspaces.reset(new std::map<size_t, JacobianWorkspace>());
+    return (*workspaces)[m];
+  }
+
   /// Linearize to a Hessianfactor
   boost::shared_ptr<RegularHessianFactor<Dim> > createHessianFactor(
       const Cameras& cameras, const Point3& point, const double lambda = 0.0,
       bool diagonalDamping = false) const {
 
-    std::vector<MatrixZD> Fblocks;
-    Matrix E;
-    Vector b;
-    computeJacobians(Fblocks, E, b, cameras, point);
-
-    // build augmented hessian
-    SymmetricBlockMatrix augmentedHessian = Cameras::SchurComplement(Fblocks, E,
-        b);
+    JacobianWorkspace& w = Workspace(keys_.size());
+    computeJacobians(w.Fblocks, w.E, w.b, cameras, point);
 
-    return boost::make_shared<RegularHessianFactor<Dim> >(keys_,
-        augmentedHessian);
+    // build augmented hessian directly in the storage of the factor
+    boost::shared_ptr<RegularHessianFactor<Dim> > factor =
+        RegularHessianFactor<Dim>::Uninitialized(keys_);
+    Cameras::SchurComplement(w.Fblocks, w.E, w.b, factor->matrixObject());
+    return factor;
   }
 
   /**
@@ -302,20 +325,20 @@ public:
       const double lambda, bool diagonalDamping,
       SymmetricBlockMatrix& augmentedHessian,
       const FastVector<Key> allKeys) const {
-    Matrix E;
-    Vector b;
-    std::vector<MatrixZD> Fblocks;
-    computeJacobians(Fblocks, E, b, cameras, point);
-    Cameras::UpdateSchurComplement(Fblocks, E, b, allKeys, keys_,
+    JacobianWorkspace& w = Workspace(keys_.size());
+    computeJacobians(w.Fblocks, w.E, w.b, cameras, point);
+    Cameras::UpdateSchurComplement(w.Fblocks, w.E, w.b, allKeys, keys_,
         augmentedHessian);
   }
 
   /// Whiten the Jacobians computed by computeJacobians using noiseModel_
   void whitenJacobians(std::vector<MatrixZD>& F, Matrix& E, Vector& b) const {
-    noiseModel_->WhitenSystem(E, b);
-    // TODO make WhitenInPlace work with any dense matrix type
+    // The noise model is isotropic, so whitening is a scaling that needs no temporaries
+    const double invsigma = noiseModel_->invsigma(0);
+    E *= invsigma;
+    b *= invsigma;
     for (size_t i = 0; i < F.size(); i++)
-      F[i] = noiseModel_->Whiten(F[i]);
+      F[i] *= invsigma;
   }
 
   /// Return Jacobians as RegularImplicitSchurFactor with raw access
@@ -355,14 +378,12 @@ public:
   boost::shared_ptr<JacobianFactor> createJacobianSVDFactor(
       const Cameras& cameras, const Point3& point, double lambda = 0.0) const {
     size_t m = this->keys_.size();
-    std::vector<MatrixZD> F;
-    Vector b;
+    JacobianWorkspace& w = Workspace(m);
+    computeJacobians(w.Fblocks, w.E, w.b, cameras, point);
     const size_t M = ZDim * m;
-    Matrix E0(M, M - 3);
-    computeJacobiansSVD(F, E0, b, cameras, point);
     SharedIsotropic n = noiseModel::Isotropic::Sigma(M - 3,
         noiseModel_->sigma());
-    return boost::make_shared<JacobianFactorSVD<Dim, ZDim> >(keys_, F, E0, b, n);
+    return JacobianFactorSVD<Dim, ZDim>::FromPointJacobian(keys_, w.Fblocks, w.E, w.b, n);
   }
 
   /// Create BIG block-diagonal matrix F from Fblocks
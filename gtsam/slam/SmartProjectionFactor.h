@@ -20,6 +20,7 @@
 #pragma once
 
 #include <gtsam/slam/SmartFactorBase.h>
+#include <gtsam/slam/TriangulationCache.h>
 
 #include <gtsam/geometry/triangulation.h>
 #include <gtsam/inference/Symbol.h>
@@ -144,6 +145,8 @@ protected:
   /// @{
   mutable TriangulationResult result_; ///< result from triangulateSafe
   mutable std::vector<Pose3> cameraPosesTriangulation_; ///< current triangulation poses
+  TriangulationCache::shared_ptr triangulationCache_; ///< optional cache shared with other factors
+  size_t track_; ///< ID of the track of this factor in triangulationCache_
   /// @}
 
 public:
@@ -163,7 +166,7 @@ public:
       const boost::optional<Pose3> body_P_sensor = boost::none,
       const SmartProjectionParams& params = SmartProjectionParams()) :
       Base(sharedNoiseModel, body_P_sensor), params_(params), //
-      result_(TriangulationResult::Degenerate()) {
+      result_(TriangulationResult::Degenerate()), track_(0) {
   }
 
   /** Virtual destructor */
@@ -193,6 +196,16 @@ public:
         && Base::equals(p, tol);
   }
 
+  /**
+   * Share triangulation results with other factors through a graph-level cache.  Factors with
+   * the same track ID must observe the same landmark with the same measurements, e.g. copies of
+   * a factor in different graphs, and then triangulate only once between them.
+   */
+  void setTriangulationCache(const TriangulationCache::shared_ptr& cache, size_t track) {
+    triangulationCache_ = cache;
+    track_ = track;
+  }
+
   /// Check if the new linearization point is the same as the one used for previous triangulation
   bool decideIfTriangulate(const Cameras& cameras) const {
     // several calls to linearize will be done from the same linearization point, hence it is not needed to re-triangulate
@@ -236,6 +249,17 @@ public:
     if (m < 2) // if we have a single pose the corresponding factor is uninformative
       return TriangulationResult::Degenerate();
 
+    if (triangulationCache_) {
+      // The shared cache replaces the cache in this factor
+      if (!triangulationCache_->lookup(track_, cameras,
+          params_.retriangulationThreshold, result_)) {
+        result_ = gtsam::triangulateSafe(cameras, this->measured_,
+            params_.triangulation);
+        triangulationCache_->store(track_, cameras, result_);
+      }
+      return result_;
+    }
+
     bool retriangulate = decideIfTriangulate(cameras);
     if (retriangulate)
       result_ = gtsam::triangulateSafe(cameras, this->measured_,
@@ -280,20 +304,19 @@ public:
     }
 
     // Jacobian could be 3D Point3 OR 2D Unit3, difference is E.cols().
-    std::vector<typename Base::MatrixZD> Fblocks;
-    Matrix E;
-    Vector b;
-    computeJacobiansWithTriangulatedPoint(Fblocks, E, b, cameras);
+    // They are computed into the workspace of this thread to avoid allocations.
+    typename Base::JacobianWorkspace& w = Base::Workspace(numKeys);
+    computeJacobiansWithTriangulatedPoint(w.Fblocks, w.E, w.b, cameras);
 
     // Whiten using noise model
-    Base::whitenJacobians(Fblocks, E, b);
-
-    // build augmented hessian
-    SymmetricBlockMatrix augmentedHessian = //
-        Cameras::SchurComplement(Fblocks, E, b, lambda, diagonalDamping);
-
-    return boost::make_shared<RegularHessianFactor<Base::Dim> >(this->keys_,
-        augmentedHessian);
+    Base::whitenJacobians(w.Fblocks, w.E, w.b);
+
+    // build augmented hessian directly in the storage of the factor
+    boost::shared_ptr<RegularHessianFactor<Base::Dim> > factor =
+        RegularHessianFactor<Base::Dim>::Uninitialized(this->keys_);
+    Cameras::SchurComplement(w.Fblocks, w.E, w.b, factor->matrixObject(), lambda,
+        diagonalDamping);
+    return factor;
   }
 
   // create factor
@@ -111,20 +111,21 @@ public:
   }
 
   /**
-   * Collect all cameras involved in this factor
+   * Collect all cameras involved in this factor.  All cameras reference the one
+   * calibration K_ of this factor, rather than each holding a copy.
    * @param values Values structure which must contain camera poses corresponding
    * to keys involved in this factor
    * @return vector of Values
    */
   typename Base::Cameras cameras(const Values& values) const {
     typename Base::Cameras cameras;
+    cameras.reserve(this->keys_.size());
     BOOST_FOREACH(const Key& k, this->keys_) {
-      Pose3 pose = values.at<Pose3>(k);
+      const Pose3& pose = values.at<Pose3>(k);
       if (Base::body_P_sensor_)
-        pose = pose.compose(*(Base::body_P_sensor_));
-
-      Camera camera(pose, K_);
-      cameras.push_back(camera);
+        cameras.push_back(Camera(pose.compose(*(Base::body_P_sensor_)), K_));
+      else
+        cameras.push_back(Camera(pose, K_));
     }
     return cameras;
   }
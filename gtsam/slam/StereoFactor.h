@@ -140,15 +140,62 @@ public:
     } catch(StereoCheiralityException& e) {
       if (H1) *H1 = zeros(3,6);
       if (H2) *H2 = zeros(3,3);
-      if (verboseCheirality_)
-      std::cout << e.what() << ": Landmark "<< DefaultKeyFormatter(this->key2()) <<
-          " moved behind camera " << DefaultKeyFormatter(this->key1()) << std::endl;
-      if (throwCheirality_)
-        throw e;
+      handleCheirality(e);
     }
     return ones(3) * 2.0 * K_->fx();
   }
 
+  /**
+   * Linearize using fixed-size Jacobians and StereoCamera::Project, avoiding the dynamic
+   * matrices of NoiseModelFactor2::linearize.  Gives the same JacobianFactor.
+   */
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& values) const {
+    // Only linearize if the factor is active
+    if (!this->active(values)) return boost::shared_ptr<JacobianFactor>();
+
+    const Key key1 = this->key1(), key2 = this->key2();
+    Matrix36 H1;
+    Matrix3 H2;
+    Vector3 b;
+    try {
+      const POSE& pose = values.at<POSE>(key1);
+      const LANDMARK& point = values.at<LANDMARK>(key2);
+      if (body_P_sensor_) {
+        Matrix6 H0;
+        Matrix36 Hsensor;
+        const StereoPoint2 reprojectionError(StereoCamera::Project(
+            pose.compose(*body_P_sensor_, H0), *K_, point, Hsensor, H2) - measured_);
+        H1 = Hsensor * H0;
+        b = -reprojectionError.vector();
+      } else {
+        const StereoPoint2 reprojectionError(
+            StereoCamera::Project(pose, *K_, point, H1, H2) - measured_);
+        b = -reprojectionError.vector();
+      }
+    } catch (StereoCheiralityException& e) {
+      H1.setZero();
+      H2.setZero();
+      b.setConstant(-2.0 * K_->fx());
+      handleCheirality(e);
+    }
+
+    // Whiten the system if needed
+    const SharedNoiseModel& noiseModel = this->get_noiseModel();
+    if (noiseModel && !noiseModel->isUnit()) {
+      H1 = noiseModel->Whiten(H1);
+      H2 = noiseModel->Whiten(H2);
+      b = noiseModel->whiten(b);
+    }
+
+    // Create new (unit) noiseModel, preserving constraints if applicable
+    SharedDiagonal model;
+    if (noiseModel && noiseModel->isConstrained()) {
+      model = boost::static_pointer_cast<noiseModel::Constrained>(noiseModel)->unit();
+    }
+
+    return boost::make_shared<BinaryJacobianFactor<3, 6, 3> >(key1, H1, key2, H2, b, model);
+  }
+
   /** return the measured */
   const StereoPoint2& measured() const {
     return measured_;
@@ -166,6 +213,15 @@ public:
   inline bool throwCheirality() const { return throwCheirality_; }
 
 private:
+  /// Report a cheirality exception as asked for by the verbosity flags
+  void handleCheirality(const StereoCheiralityException& e) const {
+    if (verboseCheirality_)
+      std::cout << e.what() << ": Landmark "<< DefaultKeyFormatter(this->key2()) <<
+          " moved behind camera " << DefaultKeyFormatter(this->key1()) << std::endl;
+    if (throwCheirality_)
+      throw e;
+  }
+
   /** Serialization function */
   friend class boost::serialization::access;
   template<class Archive>
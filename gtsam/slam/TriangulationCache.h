@@ -0,0 +1,114 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   TriangulationCache.h
+ * @brief  Triangulation results shared between the smart factors of a graph
+ * @date   Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/geometry/triangulation.h>
+#include <gtsam/geometry/CameraSet.h>
+#include <gtsam/base/FastMap.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Triangulated points of a graph, keyed by track ID, together with the camera poses they were
+ * triangulated from.  Smart factors that share a cache (see
+ * SmartProjectionFactor::setTriangulationCache) look their point up here first, and only
+ * triangulate when no factor on the same track has done so from poses that are equal to the
+ * current ones up to the retriangulation threshold.  The cache may be used from several
+ * threads at once.
+ */
+class TriangulationCache {
+public:
+
+  typedef boost::shared_ptr<TriangulationCache> shared_ptr;
+
+  TriangulationCache() : hits_(0), misses_(0) {}
+
+  /**
+   * Look up the point of a track.
+   * @return true, and the cached point in result, if the track was triangulated from poses
+   * that are equal to those of the given cameras up to tol.
+   */
+  template<class CAMERA>
+  bool lookup(size_t track, const CameraSet<CAMERA>& cameras, double tol,
+      TriangulationResult& result) const {
+    boost::mutex::scoped_lock lock(mutex_);
+    typename FastMap<size_t, Entry>::const_iterator it = entries_.find(track);
+    bool found = it != entries_.end() && it->second.poses.size() == cameras.size();
+    for (size_t i = 0; found && i < cameras.size(); ++i)
+      found = cameras[i].pose().equals(it->second.poses[i], tol);
+    if (found) {
+      result = it->second.result;
+      ++hits_;
+    } else {
+      ++misses_;
+    }
+    return found;
+  }
+
+  /// Store the point of a track triangulated from the given cameras
+  template<class CAMERA>
+  void store(size_t track, const CameraSet<CAMERA>& cameras,
+      const TriangulationResult& result) {
+    boost::mutex::scoped_lock lock(mutex_);
+    Entry& entry = entries_[track];
+    entry.poses.resize(cameras.size());
+    for (size_t i = 0; i < cameras.size(); ++i)
+      entry.poses[i] = cameras[i].pose();
+    entry.result = result;
+  }
+
+  /// Forget the point of a track, e.g. after its measurements changed
+  void invalidate(size_t track) {
+    boost::mutex::scoped_lock lock(mutex_);
+    entries_.erase(track);
+  }
+
+  /// Forget all points
+  void clear() {
+    boost::mutex::scoped_lock lock(mutex_);
+    entries_.clear();
+  }
+
+  /// Number of cached tracks
+  size_t size() const {
+    boost::mutex::scoped_lock lock(mutex_);
+    return entries_.size();
+  }
+
+  /// Number of lookups that found a point, and that did not
+  size_t hits() const { return hits_; }
+  size_t misses() const { return misses_; }
+
+private:
+
+  struct Entry {
+    std::vector<Pose3> poses; ///< poses the point was triangulated from
+    TriangulationResult result;
+    Entry() : result(TriangulationResult::Degenerate()) {}
+  };
+
+  mutable boost::mutex mutex_;
+  FastMap<size_t, Entry> entries_;
+  mutable size_t hits_, misses_;
+};
+
+}
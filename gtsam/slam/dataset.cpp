@@ -23,6 +23,7 @@
 #include <gtsam/geometry/Rot3.h>
 #include <gtsam/inference/FactorGraph.h>
 #include <gtsam/inference/Symbol.h>
+#include <gtsam/nonlinear/ISAM2.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/nonlinear/Values-inl.h>
@@ -33,15 +34,29 @@
 #include <gtsam/base/types.h>
 #include <gtsam/base/Value.h>
 #include <gtsam/base/Vector.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
 
 #include <boost/assign/list_inserter.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/foreach.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/make_shared.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <numeric>
 #include <stdexcept>
 
 using namespace std;
@@ -110,12 +125,263 @@ GraphAndValues load2D(pair<string, SharedNoiseModel> dataset, int maxID,
       noiseFormat, kernelFunctionType);
 }
 
+/* ************************************************************************* */
+namespace {
+
+// Exact powers of ten, for the fast path of parseDouble
+const double kPowersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8,
+    1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+    1e21, 1e22 };
+
+inline bool isBlank(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Skip blanks, and return whether a token follows on the same line
+inline bool nextToken(const char*& p, const char* end) {
+  while (p != end && isBlank(*p))
+    ++p;
+  return p != end && *p != '\n';
+}
+
+inline const char* tokenEnd(const char* p, const char* end) {
+  while (p != end && !isBlank(*p) && *p != '\n')
+    ++p;
+  return p;
+}
+
+// Parse an unsigned integer token
+bool parseKey(const char*& p, const char* end, Key& key) {
+  if (!nextToken(p, end))
+    return false;
+  const char* q = tokenEnd(p, end);
+  key = 0;
+  for (; p != q; ++p) {
+    if (*p < '0' || *p > '9')
+      return false;
+    key = 10 * key + (*p - '0');
+  }
+  return true;
+}
+
+// Parse a floating point token.  Decimals with at most 15 significant digits and a small
+// exponent are converted exactly with a single multiplication or division (Clinger's fast
+// path), which covers nearly all numbers in dataset files; anything else goes to strtod.
+bool parseDouble(const char*& p, const char* end, double& x) {
+  if (!nextToken(p, end))
+    return false;
+  const char* q = tokenEnd(p, end);
+  const char* c = p;
+  const bool negative = (*c == '-');
+  if (*c == '-' || *c == '+')
+    ++c;
+  boost::uint64_t mantissa = 0;
+  int digits = 0, exponent = 0;
+  bool anyDigit = false;
+  for (; c != q && *c >= '0' && *c <= '9'; ++c, anyDigit = true) {
+    if (mantissa == 0 && *c == '0')
+      continue;
+    mantissa = 10 * mantissa + (*c - '0');
+    ++digits;
+    if (digits > 15)
+      break;
+  }
+  if (c != q && *c == '.' && digits <= 15) {
+    for (++c; c != q && *c >= '0' && *c <= '9'; ++c, anyDigit = true) {
+      if (mantissa == 0 && *c == '0') {
+        --exponent;
+        continue;
+      }
+      mantissa = 10 * mantissa + (*c - '0');
+      --exponent;
+      if (++digits > 15)
+        break;
+    }
+  }
+  if (anyDigit && digits <= 15 && c != q && (*c == 'e' || *c == 'E')) {
+    ++c;
+    const bool negativeExponent = (c != q && *c == '-');
+    if (c != q && (*c == '-' || *c == '+'))
+      ++c;
+    int e = 0;
+    const char* firstExponentDigit = c;
+    for (; c != q && *c >= '0' && *c <= '9' && e < 10000; ++c)
+      e = 10 * e + (*c - '0');
+    if (c == firstExponentDigit)
+      anyDigit = false;
+    exponent += negativeExponent ? -e : e;
+  }
+  if (anyDigit && digits <= 15 && c == q && exponent >= -22 && exponent <= 22) {
+    x = double(mantissa);
+    x = exponent < 0 ? x / kPowersOfTen[-exponent] : x * kPowersOfTen[exponent];
+    if (negative)
+      x = -x;
+  } else {
+    // Slow path, strtod needs a terminated copy
+    char buffer[64];
+    const size_t n = q - p;
+    if (n >= sizeof(buffer))
+      return false;
+    copy(p, q, buffer);
+    buffer[n] = '\0';
+    char* parsed;
+    x = strtod(buffer, &parsed);
+    if (parsed != buffer + n)
+      return false;
+  }
+  p = q;
+  return true;
+}
+
+bool parseDoubles(const char*& p, const char* end, double* x, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    if (!parseDouble(p, end, x[i]))
+      return false;
+  return true;
+}
+
+// Parse the lines in [begin, end), which starts at the beginning of a line, into records
+void parseLines(const char* begin, const char* end,
+    vector<Dataset2DRecord>& records) {
+  Dataset2DRecord record;
+  for (const char* p = begin; p != end;) {
+    if (nextToken(p, end)) {
+      const char* tagEnd = tokenEnd(p, end);
+      const string tag(p, tagEnd);
+      const char* line = p;
+      p = tagEnd;
+      bool known = true, ok = true;
+      if (tag == "VERTEX2" || tag == "VERTEX_SE2" || tag == "VERTEX") {
+        record.type = Dataset2DRecord::POSE;
+        record.id2 = 0;
+        ok = parseKey(p, end, record.id1) && parseDoubles(p, end, record.values, 3);
+      } else if (tag == "EDGE2" || tag == "EDGE" || tag == "EDGE_SE2"
+          || tag == "ODOMETRY") {
+        record.type = Dataset2DRecord::ODOMETRY;
+        ok = parseKey(p, end, record.id1) && parseKey(p, end, record.id2)
+            && parseDoubles(p, end, record.values, 9);
+      } else if (tag == "BR") {
+        record.type = Dataset2DRecord::BEARING_RANGE;
+        ok = parseKey(p, end, record.id1) && parseKey(p, end, record.id2)
+            && parseDoubles(p, end, record.values, 4);
+      } else if (tag == "LANDMARK") {
+        record.type = Dataset2DRecord::LANDMARK;
+        ok = parseKey(p, end, record.id1) && parseKey(p, end, record.id2)
+            && parseDoubles(p, end, record.values, 5);
+      } else {
+        known = false;
+      }
+      if (!ok)
+        throw invalid_argument("parse2D: could not parse line \""
+            + string(line, find(line, end, '\n')) + "\"");
+      if (known)
+        records.push_back(record);
+    }
+    p = find(p, end, '\n');
+    if (p != end)
+      ++p;
+  }
+}
+
+// Bytes per chunk, and number of chunks parsed before their records are handed out
+const size_t kChunkSize = 1 << 20;
+const size_t kChunksPerBatch = 16;
+
+// A read-only memory map of a whole file
+struct MappedFile {
+  boost::interprocess::file_mapping mapping;
+  boost::interprocess::mapped_region region;
+  MappedFile(const string& filename) :
+      mapping(filename.c_str(), boost::interprocess::read_only),
+      region(mapping, boost::interprocess::read_only) {
+  }
+  const char* begin() const {
+    return static_cast<const char*>(region.get_address());
+  }
+  const char* end() const {
+    return begin() + region.get_size();
+  }
+};
+
+// Split [begin, end) into chunks of about kChunkSize that end at a line break
+vector<const char*> splitIntoChunks(const char* begin, const char* end) {
+  vector<const char*> bounds(1, begin);
+  while (bounds.back() != end) {
+    const char* next = bounds.back() + min<size_t>(kChunkSize, end - bounds.back());
+    next = find(next, end, '\n');
+    bounds.push_back(next == end ? end : next + 1);
+  }
+  return bounds;
+}
+
+#ifdef GTSAM_USE_TBB
+// Parses a range of chunks, each into its own vector of records
+struct ParseChunks {
+  const vector<const char*>& bounds;
+  vector<vector<Dataset2DRecord> >& records;
+  ParseChunks(const vector<const char*>& bounds,
+      vector<vector<Dataset2DRecord> >& records) :
+      bounds(bounds), records(records) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& r) const {
+    for (size_t i = r.begin(); i != r.end(); ++i)
+      parseLines(bounds[i], bounds[i + 1], records[i]);
+  }
+};
+#endif
+
+} // namespace
+
+/* ************************************************************************* */
+size_t parse2D(const string& filename, const Dataset2DCallback& callback) {
+  if (!fs::is_regular_file(filename))
+    throw invalid_argument("parse2D: can not find file " + filename);
+  if (fs::file_size(filename) == 0)
+    return 0;
+
+  boost::shared_ptr<MappedFile> file;
+  try {
+    file = boost::make_shared<MappedFile>(filename);
+  } catch (const boost::interprocess::interprocess_exception&) {
+    throw invalid_argument("parse2D: can not map file " + filename);
+  }
+
+  // Split the file into chunks that end at a line break
+  const vector<const char*> bounds = splitIntoChunks(file->begin(), file->end());
+  const size_t nrChunks = bounds.size() - 1;
+
+  // Parse a batch of chunks at a time, and hand out their records in order
+  size_t count = 0;
+  vector<vector<Dataset2DRecord> > records(min(nrChunks, kChunksPerBatch));
+  for (size_t first = 0; first < nrChunks; first += kChunksPerBatch) {
+    const size_t n = min(kChunksPerBatch, nrChunks - first);
+    for (size_t i = 0; i < n; ++i) {
+      records[i].clear();
+      records[i].reserve((bounds[first + i + 1] - bounds[first + i]) / 64);
+    }
+    const vector<const char*> batchBounds(bounds.begin() + first,
+        bounds.begin() + first + n + 1);
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+        ParseChunks(batchBounds, records));
+#else
+    for (size_t i = 0; i < n; ++i)
+      parseLines(batchBounds[i], batchBounds[i + 1], records[i]);
+#endif
+    for (size_t i = 0; i < n; ++i) {
+      BOOST_FOREACH(const Dataset2DRecord& record, records[i])
+        callback(record);
+      count += records[i].size();
+    }
+  }
+  return count;
+}
+
 /* ************************************************************************* */
 // Read noise parameters and interpret them according to flags
-static SharedNoiseModel readNoiseModel(ifstream& is, bool smart,
+static SharedNoiseModel readNoiseModel(const double* v, bool smart,
     NoiseFormat noiseFormat, KernelFunctionType kernelFunctionType) {
-  double v1, v2, v3, v4, v5, v6;
-  is >> v1 >> v2 >> v3 >> v4 >> v5 >> v6;
+  const double v1 = v[0], v2 = v[1], v3 = v[2], v4 = v[3], v5 = v[4], v6 = v[5];
 
    if (noiseFormat == NoiseFormatAUTO)
    {
@@ -196,40 +462,39 @@ static SharedNoiseModel readNoiseModel(ifstream& is, bool smart,
   }
 }
 
+/* ************************************************************************* */
+namespace {
+// Inserts the poses read by parse2D, and keeps the measurements for later
+struct CollectRecords2D {
+  Values& initial;
+  Key maxID;
+  vector<Dataset2DRecord>& measurements;
+  CollectRecords2D(Values& initial, Key maxID,
+      vector<Dataset2DRecord>& measurements) :
+      initial(initial), maxID(maxID), measurements(measurements) {
+  }
+  void operator()(const Dataset2DRecord& record) const {
+    if (record.type != Dataset2DRecord::POSE)
+      measurements.push_back(record);
+    else if (!maxID || record.id1 < maxID) // optional filter
+      initial.insert(record.id1,
+          Pose2(record.values[0], record.values[1], record.values[2]));
+  }
+};
+}
+
 /* ************************************************************************* */
 GraphAndValues load2D(const string& filename, SharedNoiseModel model, Key maxID,
     bool addNoise, bool smart, NoiseFormat noiseFormat,
     KernelFunctionType kernelFunctionType) {
 
-  ifstream is(filename.c_str());
-  if (!is)
-    throw invalid_argument("load2D: can not find file " + filename);
-
   Values::shared_ptr initial(new Values);
   NonlinearFactorGraph::shared_ptr graph(new NonlinearFactorGraph);
 
-  string tag;
-
-  // load the poses
-  while (!is.eof()) {
-    if (!(is >> tag))
-      break;
-
-    if ((tag == "VERTEX2") || (tag == "VERTEX_SE2") || (tag == "VERTEX")) {
-      Key id;
-      double x, y, yaw;
-      is >> id >> x >> y >> yaw;
-
-      // optional filter
-      if (maxID && id >= maxID)
-        continue;
-
-      initial->insert(id, Pose2(x, y, yaw));
-    }
-    is.ignore(LINESIZE, '\n');
-  }
-  is.clear(); /* clears the end-of-file and error flags */
-  is.seekg(0, ios::beg);
+  // Read the file, inserting the poses right away, as measurements may precede them
+  vector<Dataset2DRecord> measurements;
+  parse2D(filename, CollectRecords2D(*initial, maxID, measurements));
+  graph->reserve(measurements.size());
 
   // If asked, create a sampler with random number generator
   Sampler sampler;
@@ -245,24 +510,24 @@ GraphAndValues load2D(const string& filename, SharedNoiseModel model, Key maxID,
   }
 
   // Parse the pose constraints
-  Key id1, id2;
   bool haveLandmark = false;
   const bool useModelInFile = !model;
-  while (!is.eof()) {
-    if (!(is >> tag))
-      break;
-
-    if ((tag == "EDGE2") || (tag == "EDGE") || (tag == "EDGE_SE2")
-        || (tag == "ODOMETRY")) {
+  // Edges mostly repeat the noise of the previous edge, so its model is reused
+  SharedNoiseModel modelInFile;
+  double noiseInFile[6];
+  BOOST_FOREACH(const Dataset2DRecord& record, measurements) {
+    const Key id1 = record.id1, id2 = record.id2;
+    const double* v = record.values;
 
-      // Read transform
-      double x, y, yaw;
-      is >> id1 >> id2 >> x >> y >> yaw;
-      Pose2 l1Xl2(x, y, yaw);
+    if (record.type == Dataset2DRecord::ODOMETRY) {
+      Pose2 l1Xl2(v[0], v[1], v[2]);
 
       // read noise model
-      SharedNoiseModel modelInFile = readNoiseModel(is, smart, noiseFormat,
-          kernelFunctionType);
+      if (!modelInFile || !std::equal(v + 3, v + 9, noiseInFile)) {
+        modelInFile = readNoiseModel(v + 3, smart, noiseFormat,
+            kernelFunctionType);
+        copy(v + 3, v + 9, noiseInFile);
+      }
 
       // optional filter
       if (maxID && (id1 >= maxID || id2 >= maxID))
@@ -283,21 +548,24 @@ GraphAndValues load2D(const string& filename, SharedNoiseModel model, Key maxID,
       NonlinearFactor::shared_ptr factor(
           new BetweenFactor<Pose2>(id1, id2, l1Xl2, model));
       graph->push_back(factor);
+      continue;
     }
+
     // Parse measurements
     double bearing, range, bearing_std, range_std;
 
     // A bearing-range measurement
-    if (tag == "BR") {
-      is >> id1 >> id2 >> bearing >> range >> bearing_std >> range_std;
+    if (record.type == Dataset2DRecord::BEARING_RANGE) {
+      bearing = v[0];
+      range = v[1];
+      bearing_std = v[2];
+      range_std = v[3];
     }
 
     // A landmark measurement, TODO Frank says: don't know why is converted to bearing-range
-    if (tag == "LANDMARK") {
-      double lmx, lmy;
-      double v1, v2, v3;
-
-      is >> id1 >> id2 >> lmx >> lmy >> v1 >> v2 >> v3;
+    if (record.type == Dataset2DRecord::LANDMARK) {
+      const double lmx = v[0], lmy = v[1];
+      const double v1 = v[2], v3 = v[4];
 
       // Convert x,y to bearing,range
       bearing = atan2(lmy, lmx);
@@ -322,31 +590,28 @@ GraphAndValues load2D(const string& filename, SharedNoiseModel model, Key maxID,
     }
 
     // Do some common stuff for bearing-range measurements
-    if (tag == "LANDMARK" || tag == "BR") {
-
-      // optional filter
-      if (maxID && id1 >= maxID)
-        continue;
 
-      // Create noise model
-      noiseModel::Diagonal::shared_ptr measurementNoise =
-          noiseModel::Diagonal::Sigmas((Vector(2) << bearing_std, range_std).finished());
-
-      // Add to graph
-      *graph += BearingRangeFactor<Pose2, Point2>(id1, L(id2), bearing, range,
-          measurementNoise);
+    // optional filter
+    if (maxID && id1 >= maxID)
+      continue;
 
-      // Insert poses or points if they do not exist yet
-      if (!initial->exists(id1))
-        initial->insert(id1, Pose2());
-      if (!initial->exists(L(id2))) {
-        Pose2 pose = initial->at<Pose2>(id1);
-        Point2 local(cos(bearing) * range, sin(bearing) * range);
-        Point2 global = pose.transform_from(local);
-        initial->insert(L(id2), global);
-      }
+    // Create noise model
+    noiseModel::Diagonal::shared_ptr measurementNoise =
+        noiseModel::Diagonal::Sigmas((Vector(2) << bearing_std, range_std).finished());
+
+    // Add to graph
+    *graph += BearingRangeFactor<Pose2, Point2>(id1, L(id2), bearing, range,
+        measurementNoise);
+
+    // Insert poses or points if they do not exist yet
+    if (!initial->exists(id1))
+      initial->insert(id1, Pose2());
+    if (!initial->exists(L(id2))) {
+      Pose2 pose = initial->at<Pose2>(id1);
+      Point2 local(cos(bearing) * range, sin(bearing) * range);
+      Point2 global = pose.transform_from(local);
+      initial->insert(L(id2), global);
     }
-    is.ignore(LINESIZE, '\n');
   }
 
   return make_pair(graph, initial);
@@ -358,6 +623,239 @@ GraphAndValues load2D_robust(const string& filename,
   return load2D(filename, model, maxID);
 }
 
+namespace {
+
+// Number of vertices or factors formatted into one buffer when writing
+const size_t kLinesPerChunk = 4096;
+
+// Append to a line, without the locale and state handling of ostream: keys as decimal
+// integers, and doubles as " %g", which is what operator<< writes with the default precision
+inline void appendKey(string& line, Key key) {
+  char buffer[24];
+  char* p = buffer + sizeof(buffer);
+  do {
+    *--p = char('0' + key % 10);
+    key /= 10;
+  } while (key);
+  line.append(p, buffer + sizeof(buffer));
+}
+
+inline void appendDouble(string& line, double x) {
+  char buffer[32];
+  const int n = snprintf(buffer, sizeof(buffer), " %g", x);
+  line.append(buffer, n);
+}
+
+// Formats the lines of the items in a range of chunks, one buffer per chunk. A format returns
+// false for an item it cannot write, of which the first of each chunk is recorded.
+template<class FORMAT>
+struct FormatChunks {
+  const FORMAT& format;
+  size_t first, n; // index of the first item of the batch, and number of items
+  vector<string>& buffers;
+  vector<size_t>& failed;
+  FormatChunks(const FORMAT& format, size_t first, size_t n, vector<string>& buffers,
+      vector<size_t>& failed) :
+      format(format), first(first), n(n), buffers(buffers), failed(failed) {
+  }
+  void formatChunk(size_t c) const {
+    string& buffer = buffers[c];
+    buffer.clear();
+    failed[c] = n;
+    const size_t end = min(n, first + (c + 1) * kLinesPerChunk);
+    for (size_t i = first + c * kLinesPerChunk; i < end; ++i) {
+      if (!format(i, buffer) && failed[c] == n)
+        failed[c] = i;
+    }
+  }
+#ifdef GTSAM_USE_TBB
+  void operator()(const tbb::blocked_range<size_t>& r) const {
+    for (size_t c = r.begin(); c != r.end(); ++c)
+      formatChunk(c);
+  }
+#endif
+};
+
+// Format the n items of a sequence in parallel chunks, and write them to the stream in order, a
+// batch of chunks at a time. Returns the first item that could not be formatted, or n.
+template<class FORMAT>
+size_t writeInChunks(ostream& stream, size_t n, const FORMAT& format) {
+  const size_t nrChunks = (n + kLinesPerChunk - 1) / kLinesPerChunk;
+  vector<string> buffers(min(nrChunks, kChunksPerBatch));
+  vector<size_t> failed(buffers.size());
+  for (size_t firstChunk = 0; firstChunk < nrChunks; firstChunk += kChunksPerBatch) {
+    const size_t m = min(kChunksPerBatch, nrChunks - firstChunk);
+    const FormatChunks<FORMAT> body(format, firstChunk * kLinesPerChunk, n, buffers, failed);
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m), body);
+#else
+    for (size_t c = 0; c < m; ++c)
+      body.formatChunk(c);
+#endif
+    for (size_t c = 0; c < m; ++c) {
+      if (failed[c] != n)
+        return failed[c];
+      stream.write(buffers[c].data(), buffers[c].size());
+    }
+  }
+  return n;
+}
+
+// The vertices of one pose type, collected from a Values
+template<class POSE>
+struct Vertices : vector<pair<Key, const POSE*> > {
+  explicit Vertices(const Values& values) {
+    BOOST_FOREACH(const typename Values::ConstFiltered<POSE>::KeyValuePair& key_value,
+        values.filter<POSE>())
+      this->push_back(make_pair(key_value.key, &key_value.value));
+  }
+};
+
+// Formats VERTEX_SE2 and VERTEX_SE3:QUAT lines of writeG2o
+struct G2oPose2Vertex {
+  const Vertices<Pose2>& vertices;
+  G2oPose2Vertex(const Vertices<Pose2>& vertices) : vertices(vertices) {}
+  bool operator()(size_t i, string& line) const {
+    const Pose2& pose = *vertices[i].second;
+    line += "VERTEX_SE2 ";
+    appendKey(line, vertices[i].first);
+    appendDouble(line, pose.x());
+    appendDouble(line, pose.y());
+    appendDouble(line, pose.theta());
+    line += '\n';
+    return true;
+  }
+};
+
+struct G2oPose3Vertex {
+  const Vertices<Pose3>& vertices;
+  G2oPose3Vertex(const Vertices<Pose3>& vertices) : vertices(vertices) {}
+  bool operator()(size_t i, string& line) const {
+    const Pose3& pose = *vertices[i].second;
+    const Point3& p = pose.translation();
+    const Quaternion q = pose.rotation().toQuaternion();
+    line += "VERTEX_SE3:QUAT ";
+    appendKey(line, vertices[i].first);
+    appendDouble(line, p.x());
+    appendDouble(line, p.y());
+    appendDouble(line, p.z());
+    appendDouble(line, q.x());
+    appendDouble(line, q.y());
+    appendDouble(line, q.z());
+    appendDouble(line, q.w());
+    line += '\n';
+    return true;
+  }
+};
+
+// Formats EDGE_SE2 and EDGE_SE3:QUAT lines of writeG2o, failing on non-Gaussian noise models
+struct G2oEdge {
+  const NonlinearFactorGraph& graph;
+  G2oEdge(const NonlinearFactorGraph& graph) : graph(graph) {}
+  bool operator()(size_t i, string& line) const {
+    const NonlinearFactor* factor = graph[i].get();
+    if (const BetweenFactor<Pose2>* factor2D = dynamic_cast<const BetweenFactor<Pose2>*>(factor)) {
+      const noiseModel::Gaussian* gaussian =
+          dynamic_cast<const noiseModel::Gaussian*>(factor2D->get_noiseModel().get());
+      if (!gaussian)
+        return false;
+      const Matrix R = gaussian->R();
+      const Matrix Info = R.transpose() * R;
+      const Pose2& pose = factor2D->measured();
+      line += "EDGE_SE2 ";
+      appendKey(line, factor2D->key1());
+      line += ' ';
+      appendKey(line, factor2D->key2());
+      appendDouble(line, pose.x());
+      appendDouble(line, pose.y());
+      appendDouble(line, pose.theta());
+      for (int r = 0; r < 3; r++)
+        for (int c = r; c < 3; c++)
+          appendDouble(line, Info(r, c));
+      line += '\n';
+    } else if (const BetweenFactor<Pose3>* factor3D =
+        dynamic_cast<const BetweenFactor<Pose3>*>(factor)) {
+      const noiseModel::Gaussian* gaussian =
+          dynamic_cast<const noiseModel::Gaussian*>(factor3D->get_noiseModel().get());
+      if (!gaussian)
+        return false;
+      const Matrix R = gaussian->R();
+      const Matrix Info = R.transpose() * R;
+      const Pose3& pose = factor3D->measured();
+      const Point3& p = pose.translation();
+      const Quaternion q = pose.rotation().toQuaternion();
+      line += "EDGE_SE3:QUAT ";
+      appendKey(line, factor3D->key1());
+      line += ' ';
+      appendKey(line, factor3D->key2());
+      appendDouble(line, p.x());
+      appendDouble(line, p.y());
+      appendDouble(line, p.z());
+      appendDouble(line, q.x());
+      appendDouble(line, q.y());
+      appendDouble(line, q.z());
+      appendDouble(line, q.w());
+
+      // g2o orders translation before rotation
+      Matrix6 InfoG2o;
+      InfoG2o.block<3, 3>(0, 0) = Info.block<3, 3>(3, 3); // cov translation
+      InfoG2o.block<3, 3>(3, 3) = Info.block<3, 3>(0, 0); // cov rotation
+      InfoG2o.block<3, 3>(0, 3) = Info.block<3, 3>(0, 3); // off diagonal
+      InfoG2o.block<3, 3>(3, 0) = Info.block<3, 3>(3, 0); // off diagonal
+      for (int r = 0; r < 6; r++)
+        for (int c = r; c < 6; c++)
+          appendDouble(line, InfoG2o(r, c));
+      line += '\n';
+    }
+    return true;
+  }
+};
+
+// Formats VERTEX2 and EDGE2 lines of save2D, with one information matrix for all edges
+struct Save2DVertex {
+  const vector<pair<Key, const Pose2*> >& vertices;
+  Save2DVertex(const vector<pair<Key, const Pose2*> >& vertices) : vertices(vertices) {}
+  bool operator()(size_t i, string& line) const {
+    const Pose2& pose = *vertices[i].second;
+    line += "VERTEX2 ";
+    appendKey(line, vertices[i].first);
+    appendDouble(line, pose.x());
+    appendDouble(line, pose.y());
+    appendDouble(line, pose.theta());
+    line += '\n';
+    return true;
+  }
+};
+
+struct Save2DEdge {
+  const NonlinearFactorGraph& graph;
+  const Matrix& RR;
+  Save2DEdge(const NonlinearFactorGraph& graph, const Matrix& RR) : graph(graph), RR(RR) {}
+  bool operator()(size_t i, string& line) const {
+    const BetweenFactor<Pose2>* factor = dynamic_cast<const BetweenFactor<Pose2>*>(graph[i].get());
+    if (!factor)
+      return true;
+    const Pose2 pose = factor->measured().inverse();
+    line += "EDGE2 ";
+    appendKey(line, factor->key2());
+    line += ' ';
+    appendKey(line, factor->key1());
+    appendDouble(line, pose.x());
+    appendDouble(line, pose.y());
+    appendDouble(line, pose.theta());
+    appendDouble(line, RR(0, 0));
+    appendDouble(line, RR(0, 1));
+    appendDouble(line, RR(1, 1));
+    appendDouble(line, RR(2, 2));
+    appendDouble(line, RR(0, 2));
+    appendDouble(line, RR(1, 2));
+    line += '\n';
+    return true;
+  }
+};
+
+} // namespace
+
 /* ************************************************************************* */
 void save2D(const NonlinearFactorGraph& graph, const Values& config,
     const noiseModel::Diagonal::shared_ptr model, const string& filename) {
@@ -365,28 +863,16 @@ void save2D(const NonlinearFactorGraph& graph, const Values& config,
   fstream stream(filename.c_str(), fstream::out);
 
   // save poses
-
-  BOOST_FOREACH(const Values::ConstKeyValuePair& key_value, config) {
-    const Pose2& pose = key_value.value.cast<Pose2>();
-    stream << "VERTEX2 " << key_value.key << " " << pose.x() << " " << pose.y()
-        << " " << pose.theta() << endl;
-  }
+  vector<pair<Key, const Pose2*> > vertices;
+  vertices.reserve(config.size());
+  BOOST_FOREACH(const Values::ConstKeyValuePair& key_value, config)
+    vertices.push_back(make_pair(key_value.key, &key_value.value.cast<Pose2>()));
+  writeInChunks(stream, vertices.size(), Save2DVertex(vertices));
 
   // save edges
   Matrix R = model->R();
   Matrix RR = trans(R) * R; //prod(trans(R),R);
-  BOOST_FOREACH(boost::shared_ptr<NonlinearFactor> factor_, graph) {
-    boost::shared_ptr<BetweenFactor<Pose2> > factor =
-        boost::dynamic_pointer_cast<BetweenFactor<Pose2> >(factor_);
-    if (!factor)
-      continue;
-
-    Pose2 pose = factor->measured().inverse();
-    stream << "EDGE2 " << factor->key2() << " " << factor->key1() << " "
-        << pose.x() << " " << pose.y() << " " << pose.theta() << " " << RR(0, 0)
-        << " " << RR(0, 1) << " " << RR(1, 1) << " " << RR(2, 2) << " "
-        << RR(0, 2) << " " << RR(1, 2) << endl;
-  }
+  writeInChunks(stream, graph.size(), Save2DEdge(graph, RR));
 
   stream.close();
 }
@@ -408,84 +894,33 @@ GraphAndValues readG2o(const string& g2oFile, const bool is3D,
 
 /* ************************************************************************* */
 void writeG2o(const NonlinearFactorGraph& graph, const Values& estimate,
-    const string& filename) {
-  fstream stream(filename.c_str(), fstream::out);
-
+    ostream& stream) {
   // save 2D & 3D poses
-  Values::ConstFiltered<Pose2> viewPose2 = estimate.filter<Pose2>();
-  BOOST_FOREACH(const Values::ConstFiltered<Pose2>::KeyValuePair& key_value, viewPose2) {
-    stream << "VERTEX_SE2 " << key_value.key << " " << key_value.value.x() << " "
-        << key_value.value.y() << " " << key_value.value.theta() << endl;
-  }
-
-  Values::ConstFiltered<Pose3> viewPose3 = estimate.filter<Pose3>();
-  BOOST_FOREACH(const Values::ConstFiltered<Pose3>::KeyValuePair& key_value, viewPose3) {
-      Point3 p = key_value.value.translation();
-      Rot3 R = key_value.value.rotation();
-      stream << "VERTEX_SE3:QUAT " << key_value.key << " " << p.x() << " "  << p.y() << " " << p.z()
-        << " " << R.toQuaternion().x() << " " << R.toQuaternion().y() << " " << R.toQuaternion().z()
-        << " " << R.toQuaternion().w() << endl;
-  }
+  const Vertices<Pose2> poses2D(estimate);
+  writeInChunks(stream, poses2D.size(), G2oPose2Vertex(poses2D));
+  const Vertices<Pose3> poses3D(estimate);
+  writeInChunks(stream, poses3D.size(), G2oPose3Vertex(poses3D));
 
   // save edges (2D or 3D)
-  BOOST_FOREACH(boost::shared_ptr<NonlinearFactor> factor_, graph) {
-    boost::shared_ptr<BetweenFactor<Pose2> > factor =
-        boost::dynamic_pointer_cast<BetweenFactor<Pose2> >(factor_);
-    if (factor){
-      SharedNoiseModel model = factor->get_noiseModel();
-      boost::shared_ptr<noiseModel::Gaussian> gaussianModel =
-          boost::dynamic_pointer_cast<noiseModel::Gaussian>(model);
-      if (!gaussianModel){
-        model->print("model\n");
-        throw invalid_argument("writeG2o: invalid noise model!");
-      }
-      Matrix Info = gaussianModel->R().transpose() * gaussianModel->R();
-      Pose2 pose = factor->measured(); //.inverse();
-      stream << "EDGE_SE2 " << factor->key1() << " " << factor->key2() << " "
-          << pose.x() << " " << pose.y() << " " << pose.theta();
-      for (int i = 0; i < 3; i++){
-        for (int j = i; j < 3; j++){
-          stream << " " << Info(i, j);
-        }
-      }
-      stream << endl;
-    }
-
-    boost::shared_ptr< BetweenFactor<Pose3> > factor3D =
-        boost::dynamic_pointer_cast< BetweenFactor<Pose3> >(factor_);
-
-    if (factor3D){
-      SharedNoiseModel model = factor3D->get_noiseModel();
-
-      boost::shared_ptr<noiseModel::Gaussian> gaussianModel =
-          boost::dynamic_pointer_cast<noiseModel::Gaussian>(model);
-      if (!gaussianModel){
-        model->print("model\n");
-        throw invalid_argument("writeG2o: invalid noise model!");
-      }
-      Matrix Info = gaussianModel->R().transpose() * gaussianModel->R();
-      Pose3 pose3D = factor3D->measured();
-      Point3 p = pose3D.translation();
-      Rot3 R = pose3D.rotation();
-
-      stream << "EDGE_SE3:QUAT " << factor3D->key1() << " " << factor3D->key2() << " "
-          << p.x() << " "  << p.y() << " " << p.z()  << " " << R.toQuaternion().x()
-          << " " << R.toQuaternion().y() << " " << R.toQuaternion().z()  << " " << R.toQuaternion().w();
+  const size_t invalid = writeInChunks(stream, graph.size(), G2oEdge(graph));
+  if (invalid != graph.size()) {
+    graph[invalid]->print("factor\n");
+    throw invalid_argument("writeG2o: invalid noise model!");
+  }
+}
 
-      Matrix InfoG2o = eye(6);
-      InfoG2o.block(0,0,3,3) = Info.block(3,3,3,3); // cov translation
-      InfoG2o.block(3,3,3,3) = Info.block(0,0,3,3); // cov rotation
-      InfoG2o.block(0,3,3,3) = Info.block(0,3,3,3); // off diagonal
-      InfoG2o.block(3,0,3,3) = Info.block(3,0,3,3); // off diagonal
+/* ************************************************************************* */
+void writeG2o(const NonlinearFactorGraph& graph, const Values& estimate,
+    const string& filename) {
+  fstream stream(filename.c_str(), fstream::out);
+  writeG2o(graph, estimate, stream);
+  stream.close();
+}
 
-      for (int i = 0; i < 6; i++){
-        for (int j = i; j < 6; j++){
-          stream << " " << InfoG2o(i, j);
-        }
-      }
-      stream << endl;
-    }
-  }
+/* ************************************************************************* */
+void writeG2o(const ISAM2& isam, const string& filename) {
+  fstream stream(filename.c_str(), fstream::out);
+  writeG2o(isam.getFactorsUnsafe(), isam.calculateEstimate(), stream);
   stream.close();
 }
 
@@ -697,62 +1132,233 @@ bool readBundler(const string& filename, SfM_data &data) {
 }
 
 /* ************************************************************************* */
-bool readBAL(const string& filename, SfM_data &data) {
-  // Load the data file
-  ifstream is(filename.c_str(), ifstream::in);
-  if (!is) {
+namespace {
+
+// Skip white space, including line breaks
+inline const char* skipSpace(const char* p, const char* end) {
+  while (p != end && (isBlank(*p) || *p == '\n'))
+    ++p;
+  return p;
+}
+
+// The numbers of a BAL file that follow its header, in file order
+struct BALNumbers {
+  size_t nrObservations, nrPoses, nrPoints;
+  vector<size_t> cameraIndices, pointIndices; // of each observation
+  vector<double> uv; // 2 per observation
+  vector<double> cameras; // 9 per camera
+  vector<double> points; // 3 per point
+
+  BALNumbers(size_t nrObservations, size_t nrPoses, size_t nrPoints) :
+      nrObservations(nrObservations), nrPoses(nrPoses), nrPoints(nrPoints), //
+      cameraIndices(nrObservations), pointIndices(nrObservations), //
+      uv(2 * nrObservations), cameras(9 * nrPoses), points(3 * nrPoints) {
+  }
+
+  size_t size() const {
+    return 4 * nrObservations + 9 * nrPoses + 3 * nrPoints;
+  }
+
+  // Store number n, returns false if it is not a valid index where one is expected
+  bool store(size_t n, double x) {
+    if (n < 4 * nrObservations) {
+      const size_t k = n / 4;
+      switch (n % 4) {
+      case 0:
+      case 1:
+        if (!(x >= 0) || x != floor(x))
+          return false;
+        (n % 4 == 0 ? cameraIndices : pointIndices)[k] = size_t(x);
+        return true;
+      default:
+        // BAL values have always been read in single precision
+        uv[2 * k + n % 4 - 2] = float(x);
+        return true;
+      }
+    }
+    n -= 4 * nrObservations;
+    if (n < 9 * nrPoses)
+      cameras[n] = float(x);
+    else
+      points[n - 9 * nrPoses] = float(x);
+    return true;
+  }
+};
+
+// Number of white space separated tokens in [begin, end)
+size_t countTokens(const char* begin, const char* end) {
+  size_t count = 0;
+  for (const char* p = skipSpace(begin, end); p != end; p = skipSpace(p, end)) {
+    p = tokenEnd(p, end);
+    ++count;
+  }
+  return count;
+}
+
+// Parse the numbers in [begin, end), the first of which is number first after the header
+bool parseBALNumbers(const char* begin, const char* end, size_t first,
+    BALNumbers& numbers) {
+  double x;
+  for (const char* p = skipSpace(begin, end); p != end; p = skipSpace(p, end))
+    if (!parseDouble(p, end, x) || !numbers.store(first++, x))
+      return false;
+  return true;
+}
+
+#ifdef GTSAM_USE_TBB
+// Counts the numbers in a range of chunks
+struct CountBALNumbers {
+  const vector<const char*>& bounds;
+  vector<size_t>& counts;
+  CountBALNumbers(const vector<const char*>& bounds, vector<size_t>& counts) :
+      bounds(bounds), counts(counts) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& r) const {
+    for (size_t i = r.begin(); i != r.end(); ++i)
+      counts[i] = countTokens(bounds[i], bounds[i + 1]);
+  }
+};
+
+// Parses a range of chunks, knowing where the numbers of each chunk go
+struct ParseBALChunks {
+  const vector<const char*>& bounds;
+  const vector<size_t>& firsts;
+  BALNumbers& numbers;
+  vector<char>& ok;
+  ParseBALChunks(const vector<const char*>& bounds,
+      const vector<size_t>& firsts, BALNumbers& numbers, vector<char>& ok) :
+      bounds(bounds), firsts(firsts), numbers(numbers), ok(ok) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& r) const {
+    for (size_t i = r.begin(); i != r.end(); ++i)
+      ok[i] = parseBALNumbers(bounds[i], bounds[i + 1], firsts[i], numbers);
+  }
+};
+#endif
+
+} // namespace
+
+/* ************************************************************************* */
+bool readBAL(const string& filename, SfM_data &data, bool compact) {
+  // Map the data file
+  if (!fs::is_regular_file(filename) || fs::file_size(filename) == 0) {
+    cout << "Error in readBAL: can not find the file!!" << endl;
+    return false;
+  }
+  boost::shared_ptr<MappedFile> file;
+  try {
+    file = boost::make_shared<MappedFile>(filename);
+  } catch (const boost::interprocess::interprocess_exception&) {
     cout << "Error in readBAL: can not find the file!!" << endl;
     return false;
   }
+  const char* end = file->end();
 
   // Get the number of camera poses and 3D points
-  size_t nrPoses, nrPoints, nrObservations;
-  is >> nrPoses >> nrPoints >> nrObservations;
+  double header[3];
+  const char* p = file->begin();
+  for (size_t k = 0; k < 3; k++) {
+    p = skipSpace(p, end);
+    if (!parseDouble(p, end, header[k]) || !(header[k] >= 0)) {
+      cout << "Error in readBAL: invalid header!!" << endl;
+      return false;
+    }
+  }
+  const size_t nrPoses = size_t(header[0]), nrPoints = size_t(header[1]),
+      nrObservations = size_t(header[2]);
+
+  // Split the rest into chunks that end at a line break, and count the numbers in each
+  const vector<const char*> bounds = splitIntoChunks(p, end);
+  const size_t nrChunks = bounds.size() - 1;
+  vector<size_t> counts(nrChunks);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, nrChunks),
+      CountBALNumbers(bounds, counts));
+#else
+  for (size_t i = 0; i < nrChunks; ++i)
+    counts[i] = countTokens(bounds[i], bounds[i + 1]);
+#endif
 
-  data.tracks.resize(nrPoints);
+  // Knowing where each chunk starts, parse them straight into place
+  BALNumbers numbers(nrObservations, nrPoses, nrPoints);
+  vector<size_t> firsts(nrChunks + 1, 0);
+  partial_sum(counts.begin(), counts.end(), firsts.begin() + 1);
+  if (firsts.back() != numbers.size()) {
+    cout << "Error in readBAL: expected " << numbers.size()
+        << " numbers after the header, found " << firsts.back() << endl;
+    return false;
+  }
+  vector<char> ok(nrChunks);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, nrChunks),
+      ParseBALChunks(bounds, firsts, numbers, ok));
+#else
+  for (size_t i = 0; i < nrChunks; ++i)
+    ok[i] = parseBALNumbers(bounds[i], bounds[i + 1], firsts[i], numbers);
+#endif
+  if (find(ok.begin(), ok.end(), 0) != ok.end()) {
+    cout << "Error in readBAL: invalid number in file" << endl;
+    return false;
+  }
 
-  // Get the information for the observations
+  // Sort the observations by point into a measurement table
+  SfM_MeasurementTable table;
+  table.offsets.assign(nrPoints + 1, 0);
   for (size_t k = 0; k < nrObservations; k++) {
-    size_t i = 0, j = 0;
-    float u, v;
-    is >> i >> j >> u >> v;
-    data.tracks[j].measurements.push_back(make_pair(i, Point2(u, -v)));
+    if (numbers.cameraIndices[k] >= nrPoses
+        || numbers.pointIndices[k] >= nrPoints) {
+      cout << "Error in readBAL: observation " << k << " is out of range" << endl;
+      return false;
+    }
+    ++table.offsets[numbers.pointIndices[k] + 1];
+  }
+  partial_sum(table.offsets.begin(), table.offsets.end(), table.offsets.begin());
+  {
+    vector<size_t> next(table.offsets.begin(), table.offsets.end() - 1);
+    table.cameraIndices.resize(nrObservations);
+    table.uv.resize(nrObservations);
+    for (size_t k = 0; k < nrObservations; k++) {
+      const size_t n = next[numbers.pointIndices[k]]++;
+      table.cameraIndices[n] = numbers.cameraIndices[k];
+      table.uv[n] = Point2(numbers.uv[2 * k], -numbers.uv[2 * k + 1]);
+    }
+    vector<size_t>().swap(numbers.cameraIndices);
+    vector<size_t>().swap(numbers.pointIndices);
+    vector<double>().swap(numbers.uv);
   }
 
   // Get the information for the camera poses
+  data.cameras.reserve(data.cameras.size() + nrPoses);
   for (size_t i = 0; i < nrPoses; i++) {
-    // Get the Rodrigues vector
-    float wx, wy, wz;
-    is >> wx >> wy >> wz;
-    Rot3 R = Rot3::Rodrigues(wx, wy, wz); // BAL-OpenGL rotation matrix
-
-    // Get the translation vector
-    float tx, ty, tz;
-    is >> tx >> ty >> tz;
-
-    Pose3 pose = openGL2gtsam(R, tx, ty, tz);
-
-    // Get the focal length and the radial distortion parameters
-    float f, k1, k2;
-    is >> f >> k1 >> k2;
-    Cal3Bundler K(f, k1, k2);
-
+    const double* c = &numbers.cameras[9 * i];
+    // Rodrigues vector, translation vector, focal length and radial distortion parameters
+    Rot3 R = Rot3::Rodrigues(c[0], c[1], c[2]); // BAL-OpenGL rotation matrix
+    Pose3 pose = openGL2gtsam(R, c[3], c[4], c[5]);
+    Cal3Bundler K(c[6], c[7], c[8]);
     data.cameras.push_back(SfM_Camera(pose, K));
   }
 
-  // Get the information for the 3D points
+  // Get the information for the 3D points, and their measurements unless compact
+  data.tracks.resize(nrPoints);
   for (size_t j = 0; j < nrPoints; j++) {
-    // Get the 3D position
-    float x, y, z;
-    is >> x >> y >> z;
+    const double* x = &numbers.points[3 * j];
     SfM_Track& track = data.tracks[j];
-    track.p = Point3(x, y, z);
+    track.p = Point3(x[0], x[1], x[2]);
     track.r = 0.4f;
     track.g = 0.4f;
     track.b = 0.4f;
+    if (!compact) {
+      track.measurements.reserve(track.measurements.size()
+          + table.offsets[j + 1] - table.offsets[j]);
+      for (size_t n = table.offsets[j]; n < table.offsets[j + 1]; n++)
+        track.measurements.push_back(make_pair(table.cameraIndices[n], table.uv[n]));
+    }
   }
+  if (compact)
+    std::swap(data.measurementTable, table);
+  else
+    data.measurementTable = SfM_MeasurementTable();
 
-  is.close();
   return true;
 }
 
@@ -770,19 +1376,18 @@ bool writeBAL(const string& filename, SfM_data &data) {
   // Write the number of camera poses and 3D points
   size_t nrObservations = 0;
   for (size_t j = 0; j < data.number_tracks(); j++) {
-    nrObservations += data.tracks[j].number_measurements();
+    nrObservations += data.number_measurements(j);
   }
 
   // Write observations
   os << data.number_cameras() << " " << data.number_tracks() << " "
-      << nrObservations << endl;
-  os << endl;
+      << nrObservations << "\n";
+  os << "\n";
 
   for (size_t j = 0; j < data.number_tracks(); j++) { // for each 3D point j
-    SfM_Track track = data.tracks[j];
-
-    for (size_t k = 0; k < track.number_measurements(); k++) { // for each observation of the 3D point j
-      size_t i = track.measurements[k].first; // camera id
+    for (size_t k = 0; k < data.number_measurements(j); k++) { // for each observation of the 3D point j
+      const SfM_Measurement measurement = data.measurement(j, k);
+      size_t i = measurement.first; // camera id
       double u0 = data.cameras[i].calibration().u0();
       double v0 = data.cameras[i].calibration().v0();
 
@@ -792,36 +1397,36 @@ bool writeBAL(const string& filename, SfM_data &data) {
             << endl;
       }
 
-      double pixelBALx = track.measurements[k].second.x() - u0; // center of image is the origin
-      double pixelBALy = -(track.measurements[k].second.y() - v0); // center of image is the origin
+      double pixelBALx = measurement.second.x() - u0; // center of image is the origin
+      double pixelBALy = -(measurement.second.y() - v0); // center of image is the origin
       Point2 pixelMeasurement(pixelBALx, pixelBALy);
       os << i /*camera id*/<< " " << j /*point id*/<< " "
           << pixelMeasurement.x() /*u of the pixel*/<< " "
-          << pixelMeasurement.y() /*v of the pixel*/<< endl;
+          << pixelMeasurement.y() /*v of the pixel*/<< "\n";
     }
   }
-  os << endl;
+  os << "\n";
 
   // Write cameras
   for (size_t i = 0; i < data.number_cameras(); i++) { // for each camera
     Pose3 poseGTSAM = data.cameras[i].pose();
     Cal3Bundler cameraCalibration = data.cameras[i].calibration();
     Pose3 poseOpenGL = gtsam2openGL(poseGTSAM);
-    os << Rot3::Logmap(poseOpenGL.rotation()) << endl;
-    os << poseOpenGL.translation().vector() << endl;
-    os << cameraCalibration.fx() << endl;
-    os << cameraCalibration.k1() << endl;
-    os << cameraCalibration.k2() << endl;
-    os << endl;
+    os << Rot3::Logmap(poseOpenGL.rotation()) << "\n";
+    os << poseOpenGL.translation().vector() << "\n";
+    os << cameraCalibration.fx() << "\n";
+    os << cameraCalibration.k1() << "\n";
+    os << cameraCalibration.k2() << "\n";
+    os << "\n";
   }
 
   // Write the points
   for (size_t j = 0; j < data.number_tracks(); j++) { // for each 3D point j
     Point3 point = data.tracks[j].p;
-    os << point.x() << endl;
-    os << point.y() << endl;
-    os << point.z() << endl;
-    os << endl;
+    os << point.x() << "\n";
+    os << point.y() << "\n";
+    os << point.z() << "\n";
+    os << "\n";
   }
 
   os.close();
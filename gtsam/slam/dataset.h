@@ -29,13 +29,17 @@
 #include <gtsam/linear/NoiseModel.h>
 #include <gtsam/base/types.h>
 
+#include <boost/function.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
+#include <iosfwd>
 #include <string>
 #include <utility> // for pair
 #include <vector>
 
 namespace gtsam {
 
+class ISAM2;
+
 #ifndef MATLAB_MEX_FILE
 /**
  * Find the full path to an example dataset distributed with gtsam.  The name
@@ -104,6 +108,34 @@ GTSAM_EXPORT GraphAndValues load2D(const std::string& filename,
         false, bool smart = true, NoiseFormat noiseFormat = NoiseFormatAUTO, //
     KernelFunctionType kernelFunctionType = KernelFunctionTypeNONE);
 
+/// One line of a TORO/G2O style 2D graph file, as read by parse2D
+struct Dataset2DRecord {
+  enum Type {
+    POSE, ///< VERTEX2, VERTEX_SE2 or VERTEX: values are x, y, yaw
+    ODOMETRY, ///< EDGE2, EDGE, EDGE_SE2 or ODOMETRY: x, y, yaw, then the 6 noise entries
+    BEARING_RANGE, ///< BR: bearing, range, bearing sigma, range sigma
+    LANDMARK ///< LANDMARK: landmark x, y in the pose frame, then 3 covariance entries
+  };
+  Type type;
+  Key id1; ///< the pose, or the first pose of an edge
+  Key id2; ///< the second pose of an edge, or the landmark (unused for POSE)
+  double values[9]; ///< the numbers that follow the ids on the line, see Type
+};
+
+/// Called by parse2D for every record, in file order
+typedef boost::function<void(const Dataset2DRecord&)> Dataset2DCallback;
+
+/**
+ * Stream the records of a TORO/G2O style 2D graph file to a callback, without building a
+ * graph.  The file is memory-mapped and parsed in chunks, in parallel if GTSAM is built with
+ * TBB, but the callback is always called from the calling thread and in file order, so it can
+ * e.g. filter or count edges cheaply.  Lines with other tags are skipped.
+ * @return the number of records read
+ * @throw std::invalid_argument if the file cannot be read or a line cannot be parsed
+ */
+GTSAM_EXPORT size_t parse2D(const std::string& filename,
+    const Dataset2DCallback& callback);
+
 /// @deprecated load2D now allows for arbitrary models and wrapping a robust kernel
 GTSAM_EXPORT GraphAndValues load2D_robust(const std::string& filename,
     noiseModel::Base::shared_ptr& model, int maxID = 0);
@@ -134,6 +166,20 @@ GTSAM_EXPORT GraphAndValues readG2o(const std::string& g2oFile, const bool is3D
 GTSAM_EXPORT void writeG2o(const NonlinearFactorGraph& graph,
     const Values& estimate, const std::string& filename);
 
+/**
+ * @brief Write a g2o file to a stream, as writeG2o above. The lines are formatted in parallel
+ * chunks, which are written in order as soon as a batch of them is complete.
+ */
+GTSAM_EXPORT void writeG2o(const NonlinearFactorGraph& graph,
+    const Values& estimate, std::ostream& stream);
+
+/**
+ * @brief Write the factors and current estimate of an ISAM2 to a g2o file, without copying its
+ * factor graph. Factors and variables evicted to disk, see ISAM2Params::maxResidentVariables,
+ * are not written.
+ */
+GTSAM_EXPORT void writeG2o(const ISAM2& isam, const std::string& filename);
+
 /**
  * Load TORO 3D Graph
  */
@@ -159,16 +205,47 @@ struct SfM_Track {
 /// Define the structure for the camera poses
 typedef PinholeCamera<Cal3Bundler> SfM_Camera;
 
+/**
+ * The measurements of all tracks in compressed sparse row form: those of track j are
+ * (cameraIndices[k], uv[k]) for offsets[j] <= k < offsets[j+1].  Three flat arrays instead of
+ * a vector per track, which matters for BAL problems with millions of points.
+ */
+struct SfM_MeasurementTable {
+  std::vector<size_t> offsets; ///< number of tracks + 1 entries
+  std::vector<size_t> cameraIndices; ///< camera of each measurement
+  std::vector<Point2> uv; ///< 2D image projection of each measurement
+  size_t size() const {
+    return cameraIndices.size();
+  } ///< The total number of measurements
+  bool empty() const {
+    return offsets.empty();
+  }
+};
+
 /// Define the structure for SfM data
 struct SfM_data {
   std::vector<SfM_Camera> cameras; ///< Set of cameras
   std::vector<SfM_Track> tracks; ///< Sparse set of points
+  /// If not empty, holds the measurements of all tracks, whose own measurements are then empty
+  SfM_MeasurementTable measurementTable;
   size_t number_cameras() const {
     return cameras.size();
   } ///< The number of camera poses
   size_t number_tracks() const {
     return tracks.size();
   } ///< The number of reconstructed 3D points
+  /// The number of measurements of track j, in either layout
+  size_t number_measurements(size_t j) const {
+    return measurementTable.empty() ? tracks[j].number_measurements() :
+        measurementTable.offsets[j + 1] - measurementTable.offsets[j];
+  }
+  /// Measurement k of track j, in either layout
+  SfM_Measurement measurement(size_t j, size_t k) const {
+    if (measurementTable.empty())
+      return tracks[j].measurements[k];
+    const size_t n = measurementTable.offsets[j] + k;
+    return SfM_Measurement(measurementTable.cameraIndices[n], measurementTable.uv[n]);
+  }
 };
 
 /**
@@ -182,12 +259,16 @@ GTSAM_EXPORT bool readBundler(const std::string& filename, SfM_data &data);
 
 /**
  * @brief This function parses a "Bundle Adjustment in the Large" (BAL) file and stores the data into a
- * SfM_data structure
+ * SfM_data structure.  The file is memory-mapped and parsed in chunks, in parallel if GTSAM is
+ * built with TBB.
  * @param filename The name of the BAL file
  * @param data SfM structure where the data is stored
+ * @param compact if true, the measurements are stored in data.measurementTable rather than in
+ * the tracks, see SfM_data::measurement
  * @return true if the parsing was successful, false otherwise
  */
-GTSAM_EXPORT bool readBAL(const std::string& filename, SfM_data &data);
+GTSAM_EXPORT bool readBAL(const std::string& filename, SfM_data &data,
+    bool compact = false);
 
 /**
  * @brief This function writes a "Bundle Adjustment in the Large" (BAL) file from a
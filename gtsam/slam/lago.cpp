@@ -22,9 +22,19 @@
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <boost/make_shared.hpp>
 #include <boost/math/special_functions.hpp>
 
+#include <algorithm>
+#include <limits>
+
 using namespace std;
 
 namespace gtsam {
@@ -219,58 +229,297 @@ static NonlinearFactorGraph buildPose2graph(const NonlinearFactorGraph& graph) {
 }
 
 /* ************************************************************************* */
-static PredecessorMap<Key> findOdometricPath(
-    const NonlinearFactorGraph& pose2Graph) {
+namespace {
 
-  PredecessorMap<Key> tree;
-  Key minKey = keyAnchor; // this initialization does not matter
-  bool minUnassigned = true;
+const size_t kNoParent = std::numeric_limits<size_t>::max();
+
+// A relative orientation measurement, with the keys of its BetweenFactor<Pose2> replaced by
+// their indices in the sorted keys of the graph
+struct OrientationEdge {
+  size_t i1, i2;
+  double deltaTheta;
+  double sigma; // std on the angular measurement
+};
+
+// Index of a key in sorted keys
+inline size_t keyIndex(const KeyVector& keys, Key key) {
+  return lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+}
+
+// Retrieve the edge of factor k of a graph of BetweenFactor<Pose2>
+void extractEdge(const NonlinearFactorGraph& pose2Graph, const KeyVector& keys,
+    size_t k, vector<OrientationEdge>& edges) {
+  boost::shared_ptr<BetweenFactor<Pose2> > pose2Between =
+      boost::dynamic_pointer_cast<BetweenFactor<Pose2> >(pose2Graph[k]);
+  if (!pose2Between)
+    throw invalid_argument(
+        "buildLinearOrientationGraph: invalid between factor!");
+  boost::shared_ptr<noiseModel::Diagonal> diagonalModel =
+      boost::dynamic_pointer_cast<noiseModel::Diagonal>(
+          pose2Between->get_noiseModel());
+  if (!diagonalModel)
+    throw invalid_argument("buildLinearOrientationGraph: invalid noise model "
+        "(current version assumes diagonal noise model)!");
+  OrientationEdge& edge = edges[k];
+  edge.i1 = keyIndex(keys, pose2Between->keys()[0]);
+  edge.i2 = keyIndex(keys, pose2Between->keys()[1]);
+  edge.deltaTheta = pose2Between->measured().theta();
+  edge.sigma = diagonalModel->sigma(2);
+}
+
+// The linear orientation factor of slot r: the first nrTree slots hold the spanning tree
+// edges, the others the chords, whose measurement is regularized by the orientations to root
+void buildOrientationFactor(const vector<OrientationEdge>& edges,
+    const KeyVector& keys, const vector<size_t>& spanningTreeIds,
+    const vector<size_t>& chordsIds, const vector<double>& thetasToRoot,
+    size_t r, vector<GaussianFactor::shared_ptr>& factors) {
+  const size_t nrTree = spanningTreeIds.size();
+  const bool isChord = r >= nrTree;
+  const OrientationEdge& edge = edges[isChord ? chordsIds[r - nrTree] : spanningTreeIds[r]];
+  double deltaTheta = edge.deltaTheta;
+  if (isChord) {
+    // this coincides to summing up measurements along the cycle induced by the chord
+    double k2pi_noise = deltaTheta + thetasToRoot[edge.i1] - thetasToRoot[edge.i2];
+    double k = boost::math::round(k2pi_noise / (2 * M_PI));
+    deltaTheta -= 2 * k * M_PI;
+  }
+  factors[r] = boost::make_shared<JacobianFactor>(keys[edge.i1], -I,
+      keys[edge.i2], I, (Vector(1) << deltaTheta).finished(),
+      noiseModel::Diagonal::Sigmas((Vector(1) << edge.sigma).finished()));
+}
+
+// The linearized between factor k of a graph of BetweenFactor<Pose2>
+void buildPoseFactor(const NonlinearFactorGraph& pose2graph,
+    const VectorValues& orientationsLago, size_t k,
+    vector<GaussianFactor::shared_ptr>& factors) {
+  boost::shared_ptr<BetweenFactor<Pose2> > pose2Between =
+      boost::dynamic_pointer_cast<BetweenFactor<Pose2> >(pose2graph[k]);
+  if (!pose2Between)
+    throw invalid_argument(
+        "computeLagoPoses: cannot manage non between factor here!");
+
+  Key key1 = pose2Between->keys()[0];
+  double theta1 = orientationsLago.at(key1)(0);
+  double s1 = sin(theta1);
+  double c1 = cos(theta1);
+
+  Key key2 = pose2Between->keys()[1];
+  double theta2 = orientationsLago.at(key2)(0);
+
+  double linearDeltaRot = theta2 - theta1 - pose2Between->measured().theta();
+  linearDeltaRot = Rot2(linearDeltaRot).theta(); // to normalize
+
+  double dx = pose2Between->measured().x();
+  double dy = pose2Between->measured().y();
+
+  Vector globalDeltaCart = //
+      (Vector(2) << c1 * dx - s1 * dy, s1 * dx + c1 * dy).finished();
+  Vector b = (Vector(3) << globalDeltaCart, linearDeltaRot).finished(); // rhs
+  Matrix J1 = -I3;
+  J1(0, 2) = s1 * dx + c1 * dy;
+  J1(1, 2) = -c1 * dx + s1 * dy;
+  // Retrieve the noise model for the relative rotation
+  boost::shared_ptr<noiseModel::Diagonal> diagonalModel =
+      boost::dynamic_pointer_cast<noiseModel::Diagonal>(
+          pose2Between->get_noiseModel());
 
-  BOOST_FOREACH(const boost::shared_ptr<NonlinearFactor>& factor, pose2Graph) {
+  factors[k] = boost::make_shared<JacobianFactor>(key1, J1, key2, I3, b,
+      diagonalModel);
+}
+
+#ifdef GTSAM_USE_TBB
+class ExtractEdges {
+  const NonlinearFactorGraph& pose2Graph_;
+  const KeyVector& keys_;
+  vector<OrientationEdge>& edges_;
+public:
+  ExtractEdges(const NonlinearFactorGraph& pose2Graph, const KeyVector& keys,
+      vector<OrientationEdge>& edges) :
+      pose2Graph_(pose2Graph), keys_(keys), edges_(edges) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& r) const {
+    for (size_t k = r.begin(); k != r.end(); ++k)
+      extractEdge(pose2Graph_, keys_, k, edges_);
+  }
+};
+
+class BuildOrientationFactors {
+  const vector<OrientationEdge>& edges_;
+  const KeyVector& keys_;
+  const vector<size_t>& spanningTreeIds_;
+  const vector<size_t>& chordsIds_;
+  const vector<double>& thetasToRoot_;
+  vector<GaussianFactor::shared_ptr>& factors_;
+public:
+  BuildOrientationFactors(const vector<OrientationEdge>& edges,
+      const KeyVector& keys, const vector<size_t>& spanningTreeIds,
+      const vector<size_t>& chordsIds, const vector<double>& thetasToRoot,
+      vector<GaussianFactor::shared_ptr>& factors) :
+      edges_(edges), keys_(keys), spanningTreeIds_(spanningTreeIds), //
+      chordsIds_(chordsIds), thetasToRoot_(thetasToRoot), factors_(factors) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& r) const {
+    for (size_t k = r.begin(); k != r.end(); ++k)
+      buildOrientationFactor(edges_, keys_, spanningTreeIds_, chordsIds_,
+          thetasToRoot_, k, factors_);
+  }
+};
+
+class BuildPoseFactors {
+  const NonlinearFactorGraph& pose2graph_;
+  const VectorValues& orientationsLago_;
+  vector<GaussianFactor::shared_ptr>& factors_;
+public:
+  BuildPoseFactors(const NonlinearFactorGraph& pose2graph,
+      const VectorValues& orientationsLago,
+      vector<GaussianFactor::shared_ptr>& factors) :
+      pose2graph_(pose2graph), orientationsLago_(orientationsLago), factors_(factors) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& r) const {
+    for (size_t k = r.begin(); k != r.end(); ++k)
+      buildPoseFactor(pose2graph_, orientationsLago_, k, factors_);
+  }
+};
+#endif
 
-    Key key1 = std::min(factor->keys()[0], factor->keys()[1]);
-    Key key2 = std::max(factor->keys()[0], factor->keys()[1]);
+/* ************************************************************************* */
+// Spanning tree along consecutive keys, as parent indices (see findOdometricPath)
+vector<size_t> findOdometricPath(const KeyVector& keys,
+    const vector<OrientationEdge>& edges) {
+
+  vector<size_t> parent(keys.size(), kNoParent);
+  size_t minIndex = 0; // this initialization does not matter
+  bool minUnassigned = true;
+
+  BOOST_FOREACH(const OrientationEdge& edge, edges) {
+    size_t i1 = std::min(edge.i1, edge.i2);
+    size_t i2 = std::max(edge.i1, edge.i2);
     if (minUnassigned) {
-      minKey = key1;
+      minIndex = i1;
       minUnassigned = false;
     }
-    if (key2 - key1 == 1) { // consecutive keys
-      tree.insert(key2, key1);
-      if (key1 < minKey)
-        minKey = key1;
+    if (keys[i2] - keys[i1] == 1) { // consecutive keys
+      if (parent[i2] == kNoParent)
+        parent[i2] = i1;
+      if (i1 < minIndex)
+        minIndex = i1;
     }
   }
-  tree.insert(minKey, keyAnchor);
-  tree.insert(keyAnchor, keyAnchor); // root
-  return tree;
+  const size_t anchor = keyIndex(keys, keyAnchor);
+  if (parent[minIndex] == kNoParent)
+    parent[minIndex] = anchor;
+  if (parent[anchor] == kNoParent)
+    parent[anchor] = anchor; // root
+  return parent;
 }
 
+} // namespace
+
 /* ************************************************************************* */
-// Return the orientations of a graph including only BetweenFactors<Pose2>
+// Return the orientations of a graph including only BetweenFactors<Pose2>.  Same as
+// getSymbolicGraph, computeThetasToRoot and buildLinearOrientationGraph, but with vectors
+// indexed by key instead of maps, and the per-edge work done in parallel.
 static VectorValues computeOrientations(const NonlinearFactorGraph& pose2Graph,
     bool useOdometricPath) {
   gttic(lago_computeOrientations);
 
+  // Sorted keys, and the relative orientation measurements in terms of their indices
+  KeyVector keys;
+  keys.reserve(2 * pose2Graph.size() + 1);
+  BOOST_FOREACH(const boost::shared_ptr<NonlinearFactor>& factor, pose2Graph)
+    keys.insert(keys.end(), factor->keys().begin(), factor->keys().end());
+  keys.push_back(keyAnchor);
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  const size_t n = keys.size();
+
+  vector<OrientationEdge> edges(pose2Graph.size());
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, edges.size()),
+      ExtractEdges(pose2Graph, keys, edges));
+#else
+  for (size_t k = 0; k < edges.size(); ++k)
+    extractEdge(pose2Graph, keys, k, edges);
+#endif
+
   // Find a minimum spanning tree
-  PredecessorMap<Key> tree;
+  vector<size_t> parent;
   if (useOdometricPath)
-    tree = findOdometricPath(pose2Graph);
-  else
-    tree = findMinimumSpanningTree<NonlinearFactorGraph, Key,
-        BetweenFactor<Pose2> >(pose2Graph);
+    parent = findOdometricPath(keys, edges);
+  else {
+    PredecessorMap<Key> tree = findMinimumSpanningTree<NonlinearFactorGraph,
+        Key, BetweenFactor<Pose2> >(pose2Graph);
+    parent.assign(n, kNoParent);
+    BOOST_FOREACH(const PredecessorMap<Key>::value_type& it, tree)
+      parent[keyIndex(keys, it.first)] = keyIndex(keys, it.second);
+  }
 
-  // Create a linear factor graph (LFG) of scalars
-  key2doubleMap deltaThetaMap;
-  vector<size_t> spanningTreeIds; // ids of between factors forming the spanning tree T
-  vector<size_t> chordsIds; // ids of between factors corresponding to chordsIds wrt T
-  getSymbolicGraph(spanningTreeIds, chordsIds, deltaThetaMap, tree, pose2Graph);
+  // Split the edges into spanning tree edges, and chords wrt the tree. For a tree
+  // edge parent -> child, deltaTheta[child] is theta[child] - theta[parent].
+  vector<size_t> spanningTreeIds, chordsIds;
+  vector<double> deltaTheta(n);
+  vector<char> hasDeltaTheta(n, false);
+  for (size_t k = 0; k < edges.size(); ++k) {
+    const OrientationEdge& edge = edges[k];
+    if (parent[edge.i1] == kNoParent || parent[edge.i2] == kNoParent)
+      throw std::out_of_range("lago: node is not in the spanning tree");
+    if (parent[edge.i1] == edge.i2) { // key2 -> key1
+      if (!hasDeltaTheta[edge.i1]) {
+        deltaTheta[edge.i1] = -edge.deltaTheta;
+        hasDeltaTheta[edge.i1] = true;
+      }
+      spanningTreeIds.push_back(k);
+    } else if (parent[edge.i2] == edge.i1) { // key1 -> key2
+      if (!hasDeltaTheta[edge.i2]) {
+        deltaTheta[edge.i2] = edge.deltaTheta;
+        hasDeltaTheta[edge.i2] = true;
+      }
+      spanningTreeIds.push_back(k);
+    } else
+      chordsIds.push_back(k); // it's a chord!
+  }
 
-  // temporary structure to correct wraparounds along loops
-  key2doubleMap orientationsToRoot = computeThetasToRoot(deltaThetaMap, tree);
+  // Cumulative orientations wrt the root, each tree edge being traversed once
+  vector<double> thetasToRoot(n, 0.0);
+  vector<char> known(n, false);
+  known[keyIndex(keys, keyAnchor)] = true;
+  vector<size_t> path;
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = i; !known[j]; j = parent[j]) {
+      if (parent[j] == j) { // another root
+        known[j] = true;
+        break;
+      }
+      if (!hasDeltaTheta[j]) {
+        if (j == i)
+          break; // not in the tree, e.g. no edge to its parent
+        throw std::out_of_range("lago: spanning tree edge without measurement");
+      }
+      path.push_back(j);
+    }
+    for (; !path.empty(); path.pop_back()) {
+      const size_t j = path.back();
+      thetasToRoot[j] = thetasToRoot[parent[j]] + deltaTheta[j];
+      known[j] = true;
+    }
+  }
 
   // regularize measurements and plug everything in a factor graph
-  GaussianFactorGraph lagoGraph = buildLinearOrientationGraph(spanningTreeIds,
-      chordsIds, pose2Graph, orientationsToRoot, tree);
+  const size_t nrFactors = spanningTreeIds.size() + chordsIds.size();
+  vector<GaussianFactor::shared_ptr> factors(nrFactors + 1);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, nrFactors),
+      BuildOrientationFactors(edges, keys, spanningTreeIds, chordsIds,
+          thetasToRoot, factors));
+#else
+  for (size_t r = 0; r < nrFactors; ++r)
+    buildOrientationFactor(edges, keys, spanningTreeIds, chordsIds,
+        thetasToRoot, r, factors);
+#endif
+  // prior on the anchor orientation
+  factors[nrFactors] = boost::make_shared<JacobianFactor>(keyAnchor, I,
+      (Vector(1) << 0.0).finished(), priorOrientationNoise);
+  GaussianFactorGraph lagoGraph(factors.begin(), factors.end());
 
   // Solve the LFG
   VectorValues orientationsLago = lagoGraph.optimize();
@@ -295,51 +544,19 @@ Values computePoses(const NonlinearFactorGraph& pose2graph,
     VectorValues& orientationsLago) {
   gttic(lago_computePoses);
 
-  // Linearized graph on full poses
-  GaussianFactorGraph linearPose2graph;
-
-  // We include the linear version of each between factor
-  BOOST_FOREACH(const boost::shared_ptr<NonlinearFactor>& factor, pose2graph) {
-
-    boost::shared_ptr<BetweenFactor<Pose2> > pose2Between =
-        boost::dynamic_pointer_cast<BetweenFactor<Pose2> >(factor);
-
-    if (pose2Between) {
-      Key key1 = pose2Between->keys()[0];
-      double theta1 = orientationsLago.at(key1)(0);
-      double s1 = sin(theta1);
-      double c1 = cos(theta1);
-
-      Key key2 = pose2Between->keys()[1];
-      double theta2 = orientationsLago.at(key2)(0);
-
-      double linearDeltaRot = theta2 - theta1
-          - pose2Between->measured().theta();
-      linearDeltaRot = Rot2(linearDeltaRot).theta(); // to normalize
-
-      double dx = pose2Between->measured().x();
-      double dy = pose2Between->measured().y();
-
-      Vector globalDeltaCart = //
-          (Vector(2) << c1 * dx - s1 * dy, s1 * dx + c1 * dy).finished();
-      Vector b = (Vector(3) << globalDeltaCart, linearDeltaRot).finished(); // rhs
-      Matrix J1 = -I3;
-      J1(0, 2) = s1 * dx + c1 * dy;
-      J1(1, 2) = -c1 * dx + s1 * dy;
-      // Retrieve the noise model for the relative rotation
-      boost::shared_ptr<noiseModel::Diagonal> diagonalModel =
-          boost::dynamic_pointer_cast<noiseModel::Diagonal>(
-              pose2Between->get_noiseModel());
-
-      linearPose2graph.add(key1, J1, key2, I3, b, diagonalModel);
-    } else {
-      throw invalid_argument(
-          "computeLagoPoses: cannot manage non between factor here!");
-    }
-  }
+  // Linearized graph on full poses, with the linear version of each between factor
+  vector<GaussianFactor::shared_ptr> factors(pose2graph.size() + 1);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, pose2graph.size()),
+      BuildPoseFactors(pose2graph, orientationsLago, factors));
+#else
+  for (size_t k = 0; k < pose2graph.size(); ++k)
+    buildPoseFactor(pose2graph, orientationsLago, k, factors);
+#endif
   // add prior
-  linearPose2graph.add(keyAnchor, I3, Vector3(0.0, 0.0, 0.0),
-      priorPose2Noise);
+  factors[pose2graph.size()] = boost::make_shared<JacobianFactor>(keyAnchor,
+      I3, Vector3(0.0, 0.0, 0.0), priorPose2Noise);
+  GaussianFactorGraph linearPose2graph(factors.begin(), factors.end());
 
   // optimize
   VectorValues posesLago = linearPose2graph.optimize();
@@ -0,0 +1,479 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file snapshot.cpp
+ * @date Oct 14, 2026
+ * @brief A binary, memory-mappable snapshot format for Values and factor graphs
+ */
+
+#include <gtsam/slam/snapshot.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/ProjectionFactor.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Point2.h>
+#include <gtsam/geometry/Point3.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Rot2.h>
+#include <gtsam/geometry/Rot3.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/base/GenericValue.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/foreach.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+/* ************************************************************************* */
+// File layout: a Header, followed by nrValues ValueRecords, followed by nrFactors FactorRecords.
+// All records have a fixed size, so the i^th value or factor is found without parsing.
+
+const char magic[8] = { 'G', 'T', 'S', 'A', 'M', 'S', 'N', 'P' };
+const boost::uint32_t byteOrderMark = 0x01020304;
+
+struct Header {
+  char magic[8];
+  boost::uint32_t version;
+  boost::uint32_t byteOrder; ///< byteOrderMark, to detect snapshots written on other platforms
+  boost::uint64_t nrValues;
+  boost::uint64_t nrFactors;
+  boost::uint64_t valuesOffset; ///< Offset of the first value record from the start of the file
+  boost::uint64_t factorsOffset; ///< Offset of the first factor record from the start of the file
+};
+
+struct ValueRecord {
+  boost::uint64_t key;
+  boost::uint32_t type;
+  boost::uint32_t reserved;
+  double data[12];
+};
+
+struct FactorRecord {
+  boost::uint32_t type;
+  boost::uint32_t noiseType;
+  boost::uint32_t noiseDim;
+  boost::uint32_t flags;
+  boost::uint64_t keys[2];
+  double measured[12];
+  double noise[36]; ///< sigma, sigmas, or row-major square root information matrix
+  double calibration[5];
+  double bodyPsensor[12];
+};
+
+// Value type tags.  New types must be given new tags, to keep old snapshots readable.
+enum ValueType {
+  DOUBLE = 1, POINT2 = 2, POINT3 = 3, ROT2 = 4, ROT3 = 5, POSE2 = 6, POSE3 = 7, CAL3_S2 = 8
+};
+
+// Factor type tags
+enum FactorType {
+  BETWEEN_POSE2 = 1, BETWEEN_POSE3 = 2, BETWEEN_POINT3 = 3,
+  PRIOR_POSE2 = 11, PRIOR_POSE3 = 12, PRIOR_POINT3 = 13,
+  PROJECTION_POSE3_POINT3_CAL3_S2 = 21
+};
+
+// Noise model tags
+enum NoiseType {
+  UNIT = 1, ISOTROPIC = 2, DIAGONAL = 3, GAUSSIAN = 4
+};
+
+// Projection factor flags
+enum ProjectionFlags {
+  HAS_BODY_P_SENSOR = 1, THROW_CHEIRALITY = 2, VERBOSE_CHEIRALITY = 4
+};
+
+/* ************************************************************************* */
+// Conversion of each supported value type to and from doubles
+template<class T> struct Record;
+
+template<> struct Record<double> {
+  static const ValueType type = DOUBLE;
+  static void write(double x, double* d) { d[0] = x; }
+  static double read(const double* d) { return d[0]; }
+};
+
+template<> struct Record<Point2> {
+  static const ValueType type = POINT2;
+  static void write(const Point2& p, double* d) { d[0] = p.x(); d[1] = p.y(); }
+  static Point2 read(const double* d) { return Point2(d[0], d[1]); }
+};
+
+template<> struct Record<Point3> {
+  static const ValueType type = POINT3;
+  static void write(const Point3& p, double* d) { d[0] = p.x(); d[1] = p.y(); d[2] = p.z(); }
+  static Point3 read(const double* d) { return Point3(d[0], d[1], d[2]); }
+};
+
+template<> struct Record<Rot2> {
+  static const ValueType type = ROT2;
+  static void write(const Rot2& R, double* d) { d[0] = R.theta(); }
+  static Rot2 read(const double* d) { return Rot2::fromAngle(d[0]); }
+};
+
+template<> struct Record<Rot3> {
+  static const ValueType type = ROT3;
+  static void write(const Rot3& R, double* d) {
+    const Matrix3 M = R.matrix();
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 3; ++j)
+        d[3 * i + j] = M(i, j);
+  }
+  static Rot3 read(const double* d) {
+    Matrix3 M;
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 3; ++j)
+        M(i, j) = d[3 * i + j];
+    return Rot3(M);
+  }
+};
+
+template<> struct Record<Pose2> {
+  static const ValueType type = POSE2;
+  static void write(const Pose2& p, double* d) { d[0] = p.x(); d[1] = p.y(); d[2] = p.theta(); }
+  static Pose2 read(const double* d) { return Pose2(d[0], d[1], d[2]); }
+};
+
+template<> struct Record<Pose3> {
+  static const ValueType type = POSE3;
+  static void write(const Pose3& p, double* d) {
+    Record<Rot3>::write(p.rotation(), d);
+    Record<Point3>::write(p.translation(), d + 9);
+  }
+  static Pose3 read(const double* d) {
+    return Pose3(Record<Rot3>::read(d), Record<Point3>::read(d + 9));
+  }
+};
+
+template<> struct Record<Cal3_S2> {
+  static const ValueType type = CAL3_S2;
+  static void write(const Cal3_S2& K, double* d) {
+    d[0] = K.fx(); d[1] = K.fy(); d[2] = K.skew(); d[3] = K.px(); d[4] = K.py();
+  }
+  static Cal3_S2 read(const double* d) { return Cal3_S2(d[0], d[1], d[2], d[3], d[4]); }
+};
+
+/* ************************************************************************* */
+template<class T>
+bool writeValue(const Value& value, ValueRecord& record) {
+  const GenericValue<T>* asT = dynamic_cast<const GenericValue<T>*>(&value);
+  if (!asT)
+    return false;
+  record.type = Record<T>::type;
+  Record<T>::write(asT->value(), record.data);
+  return true;
+}
+
+/* ************************************************************************* */
+template<class T>
+void readValue(const ValueRecord& record, Values& values) {
+  values.insert(Key(record.key), Record<T>::read(record.data));
+}
+
+/* ************************************************************************* */
+void writeNoise(const SharedNoiseModel& model, FactorRecord& record) {
+  if (model->dim() > 6)
+    throw std::invalid_argument("writeSnapshot: noise models of dimension above 6 are not supported");
+  record.noiseDim = boost::uint32_t(model->dim());
+  if (boost::dynamic_pointer_cast<noiseModel::Unit>(model)) {
+    record.noiseType = UNIT;
+  } else if (noiseModel::Isotropic::shared_ptr isotropic =
+      boost::dynamic_pointer_cast<noiseModel::Isotropic>(model)) {
+    record.noiseType = ISOTROPIC;
+    record.noise[0] = isotropic->sigma();
+  } else if (boost::dynamic_pointer_cast<noiseModel::Constrained>(model)) {
+    throw std::invalid_argument("writeSnapshot: constrained noise models are not supported");
+  } else if (noiseModel::Diagonal::shared_ptr diagonal =
+      boost::dynamic_pointer_cast<noiseModel::Diagonal>(model)) {
+    record.noiseType = DIAGONAL;
+    const Vector sigmas = diagonal->sigmas();
+    for (DenseIndex i = 0; i < sigmas.size(); ++i)
+      record.noise[i] = sigmas(i);
+  } else if (noiseModel::Gaussian::shared_ptr gaussian =
+      boost::dynamic_pointer_cast<noiseModel::Gaussian>(model)) {
+    record.noiseType = GAUSSIAN;
+    const Matrix R = gaussian->R();
+    for (DenseIndex i = 0; i < R.rows(); ++i)
+      for (DenseIndex j = 0; j < R.cols(); ++j)
+        record.noise[R.cols() * i + j] = R(i, j);
+  } else {
+    throw std::invalid_argument(
+        "writeSnapshot: only Unit, Isotropic, Diagonal and Gaussian noise models are supported");
+  }
+}
+
+/* ************************************************************************* */
+SharedNoiseModel readNoise(const FactorRecord& record) {
+  const size_t dim = record.noiseDim;
+  switch (record.noiseType) {
+  case UNIT:
+    return noiseModel::Unit::Create(dim);
+  case ISOTROPIC:
+    return noiseModel::Isotropic::Sigma(dim, record.noise[0], false);
+  case DIAGONAL: {
+    Vector sigmas(dim);
+    for (size_t i = 0; i < dim; ++i)
+      sigmas(i) = record.noise[i];
+    return noiseModel::Diagonal::Sigmas(sigmas, false);
+  }
+  case GAUSSIAN: {
+    Matrix R(dim, dim);
+    for (size_t i = 0; i < dim; ++i)
+      for (size_t j = 0; j < dim; ++j)
+        R(i, j) = record.noise[dim * i + j];
+    return noiseModel::Gaussian::SqrtInformation(R, false);
+  }
+  default:
+    throw std::runtime_error("SnapshotReader: unknown noise model type");
+  }
+}
+
+/* ************************************************************************* */
+template<class T>
+bool writeBetween(const NonlinearFactor& factor, boost::uint32_t type, FactorRecord& record) {
+  const BetweenFactor<T>* between = dynamic_cast<const BetweenFactor<T>*>(&factor);
+  if (!between)
+    return false;
+  record.type = type;
+  record.keys[0] = between->key1();
+  record.keys[1] = between->key2();
+  Record<T>::write(between->measured(), record.measured);
+  writeNoise(between->get_noiseModel(), record);
+  return true;
+}
+
+/* ************************************************************************* */
+template<class T>
+bool writePrior(const NonlinearFactor& factor, boost::uint32_t type, FactorRecord& record) {
+  const PriorFactor<T>* prior = dynamic_cast<const PriorFactor<T>*>(&factor);
+  if (!prior)
+    return false;
+  record.type = type;
+  record.keys[0] = prior->key();
+  Record<T>::write(prior->prior(), record.measured);
+  writeNoise(prior->get_noiseModel(), record);
+  return true;
+}
+
+/* ************************************************************************* */
+typedef GenericProjectionFactor<Pose3, Point3, Cal3_S2> ProjectionFactor;
+
+bool writeProjection(const NonlinearFactor& factor, FactorRecord& record) {
+  const ProjectionFactor* projection = dynamic_cast<const ProjectionFactor*>(&factor);
+  if (!projection)
+    return false;
+  record.type = PROJECTION_POSE3_POINT3_CAL3_S2;
+  record.keys[0] = projection->key1();
+  record.keys[1] = projection->key2();
+  Record<Point2>::write(projection->measured(), record.measured);
+  writeNoise(projection->get_noiseModel(), record);
+  Record<Cal3_S2>::write(*projection->calibration(), record.calibration);
+  if (projection->body_P_sensor()) {
+    record.flags |= HAS_BODY_P_SENSOR;
+    Record<Pose3>::write(*projection->body_P_sensor(), record.bodyPsensor);
+  }
+  if (projection->throwCheirality())
+    record.flags |= THROW_CHEIRALITY;
+  if (projection->verboseCheirality())
+    record.flags |= VERBOSE_CHEIRALITY;
+  return true;
+}
+
+/* ************************************************************************* */
+NonlinearFactor::shared_ptr readProjection(const FactorRecord& record) {
+  boost::optional<Pose3> body_P_sensor;
+  if (record.flags & HAS_BODY_P_SENSOR)
+    body_P_sensor = Record<Pose3>::read(record.bodyPsensor);
+  return boost::make_shared<ProjectionFactor>(Record<Point2>::read(record.measured),
+      readNoise(record), Key(record.keys[0]), Key(record.keys[1]),
+      boost::make_shared<Cal3_S2>(Record<Cal3_S2>::read(record.calibration)),
+      (record.flags & THROW_CHEIRALITY) != 0, (record.flags & VERBOSE_CHEIRALITY) != 0,
+      body_P_sensor);
+}
+
+/* ************************************************************************* */
+template<class T>
+NonlinearFactor::shared_ptr readBetween(const FactorRecord& record) {
+  return boost::make_shared<BetweenFactor<T> >(Key(record.keys[0]), Key(record.keys[1]),
+      Record<T>::read(record.measured), readNoise(record));
+}
+
+/* ************************************************************************* */
+template<class T>
+NonlinearFactor::shared_ptr readPrior(const FactorRecord& record) {
+  return boost::make_shared<PriorFactor<T> >(Key(record.keys[0]),
+      Record<T>::read(record.measured), readNoise(record));
+}
+
+} // namespace
+
+/* ************************************************************************* */
+void writeSnapshot(const string& filename, const NonlinearFactorGraph& graph,
+    const Values& values) {
+  gttic(writeSnapshot);
+
+  Header header;
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.version = SnapshotReader::Version;
+  header.byteOrder = byteOrderMark;
+  header.nrValues = values.size();
+  header.nrFactors = graph.size();
+  header.valuesOffset = sizeof(Header);
+  header.factorsOffset = header.valuesOffset + header.nrValues * sizeof(ValueRecord);
+
+  ofstream os(filename.c_str(), ios::out | ios::binary | ios::trunc);
+  if (!os)
+    throw std::invalid_argument("writeSnapshot: cannot open file " + filename);
+  os.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+  BOOST_FOREACH(const Values::ConstKeyValuePair& key_value, values) {
+    ValueRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.key = key_value.key;
+    if (!(writeValue<double>(key_value.value, record)
+        || writeValue<Point2>(key_value.value, record)
+        || writeValue<Point3>(key_value.value, record)
+        || writeValue<Rot2>(key_value.value, record)
+        || writeValue<Rot3>(key_value.value, record)
+        || writeValue<Pose2>(key_value.value, record)
+        || writeValue<Pose3>(key_value.value, record)
+        || writeValue<Cal3_S2>(key_value.value, record)))
+      throw std::invalid_argument("writeSnapshot: unsupported value type");
+    os.write(reinterpret_cast<const char*>(&record), sizeof(record));
+  }
+
+  BOOST_FOREACH(const NonlinearFactor::shared_ptr& factor, graph) {
+    if (!factor)
+      throw std::invalid_argument("writeSnapshot: null factors are not supported");
+    FactorRecord record;
+    std::memset(&record, 0, sizeof(record));
+    if (!(writeBetween<Pose2>(*factor, BETWEEN_POSE2, record)
+        || writeBetween<Pose3>(*factor, BETWEEN_POSE3, record)
+        || writeBetween<Point3>(*factor, BETWEEN_POINT3, record)
+        || writePrior<Pose2>(*factor, PRIOR_POSE2, record)
+        || writePrior<Pose3>(*factor, PRIOR_POSE3, record)
+        || writePrior<Point3>(*factor, PRIOR_POINT3, record)
+        || writeProjection(*factor, record)))
+      throw std::invalid_argument("writeSnapshot: unsupported factor type");
+    os.write(reinterpret_cast<const char*>(&record), sizeof(record));
+  }
+
+  if (!os)
+    throw std::runtime_error("writeSnapshot: error writing file " + filename);
+}
+
+/* ************************************************************************* */
+struct SnapshotReader::MappedFile {
+  boost::interprocess::file_mapping mapping;
+  boost::interprocess::mapped_region region;
+  MappedFile(const string& filename) :
+      mapping(filename.c_str(), boost::interprocess::read_only),
+      region(mapping, boost::interprocess::read_only) {
+  }
+};
+
+/* ************************************************************************* */
+SnapshotReader::SnapshotReader(const string& filename) {
+  try {
+    file_ = boost::make_shared<MappedFile>(filename);
+  } catch (const boost::interprocess::interprocess_exception&) {
+    throw std::invalid_argument("SnapshotReader: cannot open file " + filename);
+  }
+
+  const char* data = static_cast<const char*>(file_->region.get_address());
+  const size_t size = file_->region.get_size();
+  if (size < sizeof(Header))
+    throw std::runtime_error("SnapshotReader: " + filename + " is not a snapshot");
+  const Header& header = *reinterpret_cast<const Header*>(data);
+  if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+    throw std::runtime_error("SnapshotReader: " + filename + " is not a snapshot");
+  if (header.byteOrder != byteOrderMark)
+    throw std::runtime_error("SnapshotReader: " + filename + " was written with another byte order");
+  if (header.version != Version)
+    throw std::runtime_error("SnapshotReader: " + filename + " has an unsupported version");
+  if (header.valuesOffset + header.nrValues * sizeof(ValueRecord) > header.factorsOffset
+      || header.factorsOffset + header.nrFactors * sizeof(FactorRecord) > size)
+    throw std::runtime_error("SnapshotReader: " + filename + " is truncated");
+
+  values_ = data + header.valuesOffset;
+  factors_ = data + header.factorsOffset;
+  nrValues_ = header.nrValues;
+  nrFactors_ = header.nrFactors;
+}
+
+/* ************************************************************************* */
+Key SnapshotReader::key(size_t i) const {
+  return reinterpret_cast<const ValueRecord*>(values_)[i].key;
+}
+
+/* ************************************************************************* */
+void SnapshotReader::insertValue(size_t i, Values& values) const {
+  const ValueRecord& record = reinterpret_cast<const ValueRecord*>(values_)[i];
+  switch (record.type) {
+  case DOUBLE: readValue<double>(record, values); break;
+  case POINT2: readValue<Point2>(record, values); break;
+  case POINT3: readValue<Point3>(record, values); break;
+  case ROT2: readValue<Rot2>(record, values); break;
+  case ROT3: readValue<Rot3>(record, values); break;
+  case POSE2: readValue<Pose2>(record, values); break;
+  case POSE3: readValue<Pose3>(record, values); break;
+  case CAL3_S2: readValue<Cal3_S2>(record, values); break;
+  default: throw std::runtime_error("SnapshotReader: unknown value type");
+  }
+}
+
+/* ************************************************************************* */
+Values SnapshotReader::values() const {
+  gttic(SnapshotReader_values);
+  Values values;
+  for (size_t i = 0; i < nrValues_; ++i)
+    insertValue(i, values);
+  return values;
+}
+
+/* ************************************************************************* */
+NonlinearFactor::shared_ptr SnapshotReader::factor(size_t i) const {
+  const FactorRecord& record = reinterpret_cast<const FactorRecord*>(factors_)[i];
+  switch (record.type) {
+  case BETWEEN_POSE2: return readBetween<Pose2>(record);
+  case BETWEEN_POSE3: return readBetween<Pose3>(record);
+  case BETWEEN_POINT3: return readBetween<Point3>(record);
+  case PRIOR_POSE2: return readPrior<Pose2>(record);
+  case PRIOR_POSE3: return readPrior<Pose3>(record);
+  case PRIOR_POINT3: return readPrior<Point3>(record);
+  case PROJECTION_POSE3_POINT3_CAL3_S2: return readProjection(record);
+  default: throw std::runtime_error("SnapshotReader: unknown factor type");
+  }
+}
+
+/* ************************************************************************* */
+NonlinearFactorGraph SnapshotReader::graph() const {
+  gttic(SnapshotReader_graph);
+  NonlinearFactorGraph graph;
+  graph.reserve(nrFactors_);
+  for (size_t i = 0; i < nrFactors_; ++i)
+    graph.push_back(factor(i));
+  return graph;
+}
+
+} // namespace gtsam
@@ -0,0 +1,93 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file snapshot.h
+ * @date Oct 14, 2026
+ * @brief A binary, memory-mappable snapshot format for Values and factor graphs
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/base/types.h>
+
+#include <boost/shared_ptr.hpp>
+#include <string>
+
+namespace gtsam {
+
+/**
+ * Write a graph and values to a binary snapshot file, which can be loaded quickly with
+ * SnapshotReader.  Unlike the boost archives in serialization.h, the snapshot is a versioned,
+ * contiguous array of fixed-size, type-tagged records in native byte order, that is read by
+ * memory-mapping the file and materializing records on demand.
+ *
+ * Supported value types are double, Point2, Point3, Rot2, Rot3, Pose2, Pose3 and Cal3_S2.
+ * Supported factors are BetweenFactor and PriorFactor on Pose2, Pose3 and Point3, and
+ * GenericProjectionFactor<Pose3, Point3, Cal3_S2>, with Unit, Isotropic, Diagonal or Gaussian
+ * noise models.
+ * @throw std::invalid_argument if a value, factor or noise model is not supported
+ */
+GTSAM_EXPORT void writeSnapshot(const std::string& filename, const NonlinearFactorGraph& graph,
+    const Values& values);
+
+/**
+ * Reads a snapshot written by writeSnapshot.  The file is memory-mapped on construction and
+ * only its header is checked, values and factors are created when requested, so that a large
+ * snapshot is opened almost instantly and only the parts in use are paged in.
+ */
+class GTSAM_EXPORT SnapshotReader {
+public:
+
+  /**
+   * Memory-map a snapshot file
+   * @throw std::invalid_argument if the file cannot be opened, std::runtime_error if it is not a
+   * valid snapshot of a supported version
+   */
+  explicit SnapshotReader(const std::string& filename);
+
+  /// Number of values in the snapshot
+  size_t nrValues() const { return nrValues_; }
+
+  /// Number of factors in the snapshot
+  size_t nrFactors() const { return nrFactors_; }
+
+  /// Key of the i^th value
+  Key key(size_t i) const;
+
+  /// Create all values
+  Values values() const;
+
+  /// Insert the i^th value into \c values
+  void insertValue(size_t i, Values& values) const;
+
+  /// Create the i^th factor
+  NonlinearFactor::shared_ptr factor(size_t i) const;
+
+  /// Create all factors
+  NonlinearFactorGraph graph() const;
+
+  /// The version of the snapshot format written by writeSnapshot
+  static const unsigned int Version = 1;
+
+private:
+
+  struct MappedFile;
+  boost::shared_ptr<MappedFile> file_; ///< The memory-mapped file
+  const char* values_; ///< Start of the value records
+  const char* factors_; ///< Start of the factor records
+  size_t nrValues_;
+  size_t nrFactors_;
+};
+
+} // namespace gtsam
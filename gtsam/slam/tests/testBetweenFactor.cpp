@@ -6,8 +6,11 @@
  */
 
 #include <gtsam/base/numericalDerivative.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Rot3.h>
 #include <gtsam/inference/Symbol.h>
+#include <gtsam/nonlinear/Values.h>
 #include <gtsam/slam/BetweenFactor.h>
 #include <CppUnitLite/TestHarness.h>
 
@@ -44,6 +47,63 @@ TEST(BetweenFactor, Rot3) {
   EXPECT(assert_equal(numericalH2,actualH2, 1E-5));
 }
 
+/* ************************************************************************* */
+TEST(BetweenFactor, Pose2Linearize) {
+  Pose2 p1(1.0, 2.0, 0.3), p2(2.5, 1.5, -2.9);
+  Pose2 measured = p1.between(p2) * Pose2(0.05, -0.02, 0.04);
+  Values values;
+  values.insert(X(1), p1);
+  values.insert(X(2), p2);
+
+  // The fixed-size specialization agrees with NoiseModelFactor2::linearize
+  BetweenFactor<Pose2> factor(X(1), X(2), measured, Diagonal::Sigmas(Vector3(0.1, 0.2, 0.05)));
+  EXPECT(assert_equal(*factor.NoiseModelFactor2<Pose2, Pose2>::linearize(values),
+      *factor.linearize(values), 1e-9));
+
+  // Also with a constrained noise model, and across the angle wrap-around
+  BetweenFactor<Pose2> constraint(X(1), X(2), Pose2(1.0, 0.5, 3.1),
+      Constrained::MixedSigmas(Vector3(0.0, 0.1, 0.1)));
+  EXPECT(assert_equal(*constraint.NoiseModelFactor2<Pose2, Pose2>::linearize(values),
+      *constraint.linearize(values), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(BetweenFactor, Pose3Linearize) {
+  Pose3 p1(Rot3::Rodrigues(0.1, -0.2, 0.3), Point3(1.0, 2.0, 0.5));
+  Pose3 p2(Rot3::Rodrigues(-0.4, 0.5, 2.6), Point3(2.5, 1.5, -0.3));
+  Pose3 measured = p1.between(p2) * Pose3(Rot3::Rodrigues(0.02, -0.01, 0.04),
+      Point3(0.05, -0.02, 0.01));
+  Values values;
+  values.insert(X(1), p1);
+  values.insert(X(2), p2);
+
+  // The fixed-size specialization agrees with NoiseModelFactor2::linearize, for unit,
+  // diagonal and full Gaussian noise models
+  Matrix6 sqrtInformation = 10.0 * Matrix6::Identity();
+  sqrtInformation(0, 4) = 2.0;
+  sqrtInformation(3, 5) = -1.5;
+  std::vector<SharedNoiseModel> models;
+  models.push_back(Unit::Create(6));
+  models.push_back(Diagonal::Sigmas((Vector(6) << 0.1, 0.2, 0.05, 0.3, 0.3, 0.4).finished()));
+  models.push_back(Gaussian::SqrtInformation(sqrtInformation));
+  for (size_t i = 0; i < models.size(); ++i) {
+    BetweenFactor<Pose3> factor(X(1), X(2), measured, models[i]);
+    GaussianFactor::shared_ptr actual = factor.linearize(values);
+    EXPECT((boost::dynamic_pointer_cast<BinaryJacobianFactor<6, 6, 6> >(actual)));
+    EXPECT(assert_equal(*factor.NoiseModelFactor2<Pose3, Pose3>::linearize(values),
+        *actual, 1e-9));
+  }
+
+  // Robust and constrained noise models are left to NoiseModelFactor2
+  BetweenFactor<Pose3> robust(X(1), X(2), measured, Robust::Create(
+      mEstimator::Huber::Create(1.0), Isotropic::Sigma(6, 0.1)));
+  EXPECT(assert_equal(*robust.NoiseModelFactor2<Pose3, Pose3>::linearize(values),
+      *robust.linearize(values), 1e-9));
+  BetweenConstraint<Pose3> constraint(measured, X(1), X(2));
+  EXPECT(assert_equal(*constraint.NoiseModelFactor2<Pose3, Pose3>::linearize(values),
+      *constraint.linearize(values), 1e-9));
+}
+
 /* ************************************************************************* */
 /*
 // Constructor scalar
@@ -17,13 +17,18 @@
 
 
 #include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
 #include <gtsam/slam/dataset.h>
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/inference/Symbol.h>
+#include <gtsam/nonlinear/ISAM2.h>
 #include <gtsam/base/TestableAssertions.h>
 
 #include <boost/algorithm/string.hpp>
 
+#include <fstream>
+#include <sstream>
+
 #include <CppUnitLite/TestHarness.h>
 
 using namespace gtsam::symbol_shorthand;
@@ -56,6 +61,98 @@ TEST( dataSet, load2D)
   EXPECT(assert_equal(expected, *actual));
 }
 
+/* ************************************************************************* */
+namespace {
+// Counts the records of each type, and keeps the edges out of pose 0
+struct CountRecords {
+  size_t& poses;
+  size_t& edges;
+  vector<Dataset2DRecord>& fromZero;
+  CountRecords(size_t& poses, size_t& edges, vector<Dataset2DRecord>& fromZero) :
+      poses(poses), edges(edges), fromZero(fromZero) {
+  }
+  void operator()(const Dataset2DRecord& record) const {
+    if (record.type == Dataset2DRecord::POSE)
+      ++poses;
+    else if (record.type == Dataset2DRecord::ODOMETRY) {
+      ++edges;
+      if (record.id1 == 0 || record.id2 == 0)
+        fromZero.push_back(record);
+    }
+  }
+};
+
+// Keeps all records
+struct KeepRecords {
+  vector<Dataset2DRecord>& records;
+  KeepRecords(vector<Dataset2DRecord>& records) : records(records) {}
+  void operator()(const Dataset2DRecord& record) const {
+    records.push_back(record);
+  }
+};
+}
+
+TEST( dataSet, parse2D)
+{
+  const string filename = findExampleDataFile("w100.graph");
+  size_t poses = 0, edges = 0;
+  vector<Dataset2DRecord> fromZero;
+  EXPECT_LONGS_EQUAL(400, parse2D(filename, CountRecords(poses, edges, fromZero)));
+  EXPECT_LONGS_EQUAL(100, poses);
+  EXPECT_LONGS_EQUAL(300, edges);
+
+  // The first edge in the file, EDGE2 1 0 -0.99879 0.0417574 -0.00818381 1 0 1 1 0 0
+  LONGS_EQUAL(11, fromZero.size());
+  EXPECT_LONGS_EQUAL(99, fromZero[10].id1);
+  EXPECT_LONGS_EQUAL(1, fromZero[0].id1);
+  EXPECT_LONGS_EQUAL(0, fromZero[0].id2);
+  EXPECT_DOUBLES_EQUAL(-0.99879, fromZero[0].values[0], 1e-15);
+  EXPECT_DOUBLES_EQUAL(0.0417574, fromZero[0].values[1], 1e-15);
+  EXPECT_DOUBLES_EQUAL(-0.00818381, fromZero[0].values[2], 1e-15);
+  EXPECT_DOUBLES_EQUAL(1.0, fromZero[0].values[3], 0);
+  EXPECT_DOUBLES_EQUAL(0.0, fromZero[0].values[8], 0);
+}
+
+/* ************************************************************************* */
+TEST( dataSet, parse2DFormats)
+{
+  // Numbers in all forms, comments, unknown tags, blank lines and no final newline
+  const string filename = createRewrittenFileName(findExampleDataFile("w100.graph"));
+  {
+    ofstream os(filename.c_str());
+    os << "# a comment\n"
+       << "VERTEX_SE2 0 1.5e-3 -2E2 +.25\r\n"
+       << "\n"
+       << "   FIX 0\n"
+       << "EDGE_SE2 0 12345678901 0.1234567890123456789 -0 1e-320 1 0 0 1 0 1\n"
+       << "LANDMARK 0 3 1 2 0.5 0 0.5\n"
+       << "BR 0 4 0.3 10 0.1 nan";
+  }
+  vector<Dataset2DRecord> records;
+  EXPECT_LONGS_EQUAL(4, parse2D(filename,
+      KeepRecords(records)));
+  LONGS_EQUAL(4, records.size());
+  EXPECT(records[0].type == Dataset2DRecord::POSE);
+  EXPECT_DOUBLES_EQUAL(1.5e-3, records[0].values[0], 0);
+  EXPECT_DOUBLES_EQUAL(-2e2, records[0].values[1], 0);
+  EXPECT_DOUBLES_EQUAL(0.25, records[0].values[2], 0);
+  EXPECT(records[1].type == Dataset2DRecord::ODOMETRY);
+  EXPECT_LONGS_EQUAL(12345678901ULL, records[1].id2);
+  EXPECT_DOUBLES_EQUAL(0.1234567890123456789, records[1].values[0], 0);
+  EXPECT_DOUBLES_EQUAL(1e-320, records[1].values[2], 0);
+  EXPECT(records[2].type == Dataset2DRecord::LANDMARK);
+  EXPECT_DOUBLES_EQUAL(0.5, records[2].values[4], 0);
+  EXPECT(records[3].type == Dataset2DRecord::BEARING_RANGE);
+  EXPECT(records[3].values[3] != records[3].values[3]); // nan
+
+  // A truncated line is an error
+  {
+    ofstream os(filename.c_str());
+    os << "VERTEX2 0 1 2\n";
+  }
+  CHECK_EXCEPTION(parse2D(filename, KeepRecords(records)), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 TEST( dataSet, load2DVictoriaPark)
 {
@@ -341,6 +438,76 @@ TEST( dataSet, writeG2o3DNonDiagonalNoise)
   EXPECT(assert_equal(*expectedGraph,*actualGraph,1e-4));
 }
 
+/* ************************************************************************* */
+TEST( dataSet, writeG2oStream)
+{
+  // More edges than fit in one chunk, written exactly as with operator<<
+  noiseModel::Diagonal::shared_ptr model = noiseModel::Diagonal::Sigmas((Vector(3) << 0.1, 0.2, 0.05).finished());
+  NonlinearFactorGraph graph;
+  Values values;
+  ostringstream expected;
+  for (size_t i = 0; i < 10000; ++i) {
+    const Pose2 pose(0.001 * i, -1.5e-7 * i, 0.37 * i);
+    values.insert(i, pose);
+    expected << "VERTEX_SE2 " << i << " " << pose.x() << " " << pose.y() << " " << pose.theta() << "\n";
+  }
+  const Matrix Info = model->R().transpose() * model->R();
+  for (size_t i = 1; i < 10000; ++i) {
+    const Pose2 odometry(1.0 / i, 0.25, -0.01 * i);
+    graph.add(BetweenFactor<Pose2>(i - 1, i, odometry, model));
+  }
+  for (size_t i = 1; i < 10000; ++i) {
+    const Pose2 odometry(1.0 / i, 0.25, -0.01 * i);
+    expected << "EDGE_SE2 " << i - 1 << " " << i << " " << odometry.x() << " " << odometry.y()
+        << " " << odometry.theta();
+    for (int r = 0; r < 3; r++)
+      for (int c = r; c < 3; c++)
+        expected << " " << Info(r, c);
+    expected << "\n";
+  }
+
+  ostringstream actual;
+  writeG2o(graph, values, actual);
+  EXPECT(expected.str() == actual.str());
+}
+
+/* ************************************************************************* */
+TEST( dataSet, writeG2oISAM2)
+{
+  // A loop of 3D poses, with a full information matrix on the loop closure
+  NonlinearFactorGraph graph;
+  Values initial;
+  SharedNoiseModel model = noiseModel::Diagonal::Sigmas(
+      (Vector(6) << 0.05, 0.05, 0.05, 0.1, 0.1, 0.1).finished());
+  Matrix6 information = 100 * I_6x6;
+  information(0, 4) = information(4, 0) = 10;
+  const Pose3 odometry(Rot3::RzRyRx(0.1, -0.05, 0.3), Point3(1.0, 0.2, -0.1));
+  Pose3 pose;
+  for (size_t i = 0; i < 20; ++i) {
+    initial.insert(i, pose.retract((Vector(6) << 0.01, 0, 0, 0.05, 0, 0).finished()));
+    if (i > 0)
+      graph.add(BetweenFactor<Pose3>(i - 1, i, odometry, model));
+    pose = pose * odometry;
+  }
+  graph.add(BetweenFactor<Pose3>(0, 19, initial.at<Pose3>(0).between(pose) * odometry.inverse(),
+      noiseModel::Gaussian::Information(information)));
+  graph.add(PriorFactor<Pose3>(0, Pose3(), noiseModel::Isotropic::Sigma(6, 0.01)));
+
+  ISAM2 isam;
+  isam.update(graph, initial);
+
+  const string filenameToWrite = createRewrittenFileName(findExampleDataFile("w100"));
+  writeG2o(isam, filenameToWrite);
+
+  // The prior is not written
+  NonlinearFactorGraph::shared_ptr actualGraph;
+  Values::shared_ptr actualValues;
+  boost::tie(actualGraph, actualValues) = readG2o(filenameToWrite, true);
+  graph.resize(graph.size() - 1);
+  EXPECT(assert_equal(isam.calculateEstimate(), *actualValues, 1e-4));
+  EXPECT(assert_equal(graph, *actualGraph, 1e-4));
+}
+
 /* ************************************************************************* */
 TEST( dataSet, readBAL_Dubrovnik)
 {
@@ -362,6 +529,69 @@ TEST( dataSet, readBAL_Dubrovnik)
   EXPECT(assert_equal(expected,actual,12));
 }
 
+/* ************************************************************************* */
+TEST( dataSet, readBALCompact)
+{
+  // Write a small problem, with the measurements of each track in any camera order
+  SfM_data data;
+  data.cameras.push_back(SfM_Camera(Pose3(Rot3::ypr(0.1, 0.2, 0.3), Point3(1, 2, 3)),
+      Cal3Bundler(500, 1e-3, 1e-5)));
+  data.cameras.push_back(SfM_Camera(Pose3(Rot3::ypr(-0.3, 0.1, 0.2), Point3(-1, 0.5, 2)),
+      Cal3Bundler(400, -2e-3, 0)));
+  for (size_t j = 0; j < 3; j++) {
+    SfM_Track track;
+    track.p = Point3(0.5 * j, -0.25 * j, 10);
+    track.r = track.g = track.b = 0.4f;
+    for (size_t i = 0; i < 2; i++)
+      if (i + j != 2)
+        track.measurements.push_back(make_pair((i + j) % 2, Point2(10.5 * j - i, 3.25 * i)));
+    data.tracks.push_back(track);
+  }
+  const string filename = createRewrittenFileName(findExampleDataFile("w100.graph"));
+  CHECK(writeBAL(filename, data));
+
+  // Read it back in both layouts
+  SfM_data expanded, compact;
+  CHECK(readBAL(filename, expanded));
+  CHECK(readBAL(filename, compact, true));
+  EXPECT(expanded.measurementTable.empty());
+  EXPECT_LONGS_EQUAL(4, compact.measurementTable.size());
+  LONGS_EQUAL(3, compact.number_tracks());
+  LONGS_EQUAL(2, compact.number_cameras());
+  for (size_t i = 0; i < 2; i++) {
+    EXPECT(assert_equal(data.cameras[i], expanded.cameras[i], 1e-4));
+    EXPECT(assert_equal(expanded.cameras[i], compact.cameras[i]));
+  }
+  for (size_t j = 0; j < 3; j++) {
+    EXPECT(assert_equal(data.tracks[j].p, compact.tracks[j].p));
+    EXPECT(compact.tracks[j].measurements.empty());
+    EXPECT_LONGS_EQUAL(data.tracks[j].number_measurements(), expanded.number_measurements(j));
+    LONGS_EQUAL(data.number_measurements(j), compact.number_measurements(j));
+    for (size_t k = 0; k < data.number_measurements(j); k++) {
+      EXPECT_LONGS_EQUAL(data.measurement(j, k).first, compact.measurement(j, k).first);
+      EXPECT(assert_equal(data.measurement(j, k).second, compact.measurement(j, k).second));
+      EXPECT(assert_equal(data.measurement(j, k).second,
+          expanded.tracks[j].measurements[k].second));
+    }
+  }
+
+  // A compact problem writes the same file
+  const string filename2 = createRewrittenFileName(findExampleDataFile("example.graph"));
+  CHECK(writeBAL(filename2, compact));
+  SfM_data rewritten;
+  CHECK(readBAL(filename2, rewritten));
+  EXPECT(assert_equal(expanded.tracks[2].measurements[0].second,
+      rewritten.tracks[2].measurements[0].second));
+
+  // A file that is cut short is rejected
+  {
+    ofstream os(filename.c_str());
+    os << "1 1 1\n0 0 1.0 2.0\n";
+  }
+  SfM_data truncated;
+  EXPECT(!readBAL(filename, truncated));
+}
+
 /* ************************************************************************* */
 TEST( dataSet, openGL2gtsam)
 {
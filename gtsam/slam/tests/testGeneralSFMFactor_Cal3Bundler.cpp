@@ -28,6 +28,7 @@
 #include <gtsam/geometry/PinholeCamera.h>
 #include <gtsam/base/Testable.h>
 
+#include <boost/foreach.hpp>
 #include <boost/shared_ptr.hpp>
 #include <CppUnitLite/TestHarness.h>
 
@@ -381,6 +382,27 @@ TEST( GeneralSFMFactor_Cal3Bundler, optimize_varK_BA ) {
   EXPECT(optimizer.error() < 0.5 * reproj_error * nMeasurements);
 }
 
+/* ************************************************************************* */
+TEST( GeneralSFMFactor_Cal3Bundler, linearize ) {
+  Values values;
+  values.insert(X(1), GeneralCamera(Pose3(Rot3::ypr(0.1, -0.2, 0.3), Point3(0.5, -0.4, -6.0)),
+      Cal3Bundler(500, 1e-3, -2e-4, 10, -20)));
+  values.insert(L(1), Point3(0.3, 0.6, 1.0));
+  Point2 z(320., 240.);
+
+  // The fused kernel agrees with the generic linearization of NoiseModelFactor2
+  Matrix22 cov;
+  cov << 4.0, 1.0, 1.0, 2.0;
+  SharedNoiseModel models[] = { noiseModel::Unit::Create(2),
+      noiseModel::Diagonal::Sigmas(Vector2(0.5, 2.0)), noiseModel::Gaussian::Covariance(cov) };
+  BOOST_FOREACH(const SharedNoiseModel& model, models) {
+    Projection factor(z, model, X(1), L(1));
+    GaussianFactor::shared_ptr actual = factor.linearize(values);
+    GaussianFactor::shared_ptr expected = factor.Projection::Base::linearize(values);
+    EXPECT(assert_equal(expected->augmentedJacobian(), actual->augmentedJacobian(), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
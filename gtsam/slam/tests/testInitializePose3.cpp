@@ -91,6 +91,37 @@ TEST( InitializePose3, orientations ) {
   EXPECT(assert_equal(simple::R3, initial.at<Rot3>(x3), 1e-6));
 }
 
+/* *************************************************************************** */
+TEST( InitializePose3, orientationsPCG ) {
+  // A loop of poses with loop closures, and noisy relative rotations
+  NonlinearFactorGraph graph;
+  const size_t n = 30;
+  vector<Pose3> poses;
+  for (size_t i = 0; i < n; ++i)
+    poses.push_back(Pose3(Rot3::ypr(0.2 * i, 0.1 * sin(i), -0.05 * i), Point3(i, sin(i), 0)));
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t step = 1; step <= 5; step += 4) {
+      const size_t j = (i + step) % n;
+      const Rot3 noise = Rot3::Expmap(Vector3(0.01 * sin(3.0 * i), 0.02 * cos(i), 0.01));
+      const Pose3 measured = poses[i].between(poses[j]);
+      graph.add(BetweenFactor<Pose3>(i, j,
+          Pose3(measured.rotation() * noise, measured.translation()), model));
+    }
+  }
+  graph.add(PriorFactor<Pose3>(0, poses[0], model));
+  NonlinearFactorGraph pose3Graph = InitializePose3::buildPose3graph(graph);
+
+  // The iterative solution of the relaxation matches the direct one
+  Values expected = InitializePose3::computeOrientationsChordal(pose3Graph);
+  Values actual = InitializePose3::computeOrientationsChordal(pose3Graph,
+      InitializePose3::chordalPCGParameters());
+  EXPECT_LONGS_EQUAL(n, actual.size());
+  EXPECT(assert_equal(expected, actual, 1e-6));
+
+  EXPECT(assert_equal(InitializePose3::initialize(graph),
+      InitializePose3::initialize(graph, InitializePose3::chordalPCGParameters()), 1e-6));
+}
+
 /* *************************************************************************** */
 TEST( InitializePose3, orientationsGradientSymbolicGraph ) {
   NonlinearFactorGraph pose3Graph = InitializePose3::buildPose3graph(simple::graph());
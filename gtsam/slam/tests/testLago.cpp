@@ -256,6 +256,34 @@ TEST( Lago, smallGraph2 ) {
   EXPECT(assert_equal(expected, actual, 1e-6));
 }
 
+/* *************************************************************************** */
+TEST( Lago, orientationsMatchMapBasedSteps ) {
+  NonlinearFactorGraph::shared_ptr g;
+  Values::shared_ptr initial;
+  boost::tie(g, initial) = load2D(findExampleDataFile("w100.graph"));
+  noiseModel::Diagonal::shared_ptr priorModel = noiseModel::Diagonal::Variances(Vector3(1e-2, 1e-2, 1e-4));
+  NonlinearFactorGraph graphWithPrior = *g;
+  graphWithPrior.add(PriorFactor<Pose2>(0, Pose2(), priorModel));
+
+  // The same steps with the public map-based functions, the prior becoming a between factor
+  // from the anchor
+  Key keyAnc = symbol('Z',9999999);
+  NonlinearFactorGraph pose2Graph = *g;
+  pose2Graph.add(BetweenFactor<Pose2>(keyAnc, 0, Pose2(), priorModel));
+  PredecessorMap<Key> tree = findMinimumSpanningTree<NonlinearFactorGraph, Key,
+      BetweenFactor<Pose2> >(pose2Graph);
+  lago::key2doubleMap deltaThetaMap;
+  vector<size_t> spanningTreeIds, chordsIds;
+  lago::getSymbolicGraph(spanningTreeIds, chordsIds, deltaThetaMap, tree, pose2Graph);
+  lago::key2doubleMap orientationsToRoot = lago::computeThetasToRoot(deltaThetaMap, tree);
+  VectorValues expected = lago::buildLinearOrientationGraph(spanningTreeIds, chordsIds,
+      pose2Graph, orientationsToRoot, tree).optimize();
+
+  VectorValues actual = lago::initializeOrientations(graphWithPrior, false);
+  EXPECT_LONGS_EQUAL(101, actual.size());
+  EXPECT(assert_equal(expected, actual, 1e-9));
+}
+
 /* *************************************************************************** */
 TEST( Lago, largeGraphNoisy_orientations ) {
 
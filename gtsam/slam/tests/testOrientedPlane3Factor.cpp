@@ -174,6 +174,41 @@ TEST( OrientedPlane3DirectionPrior, Constructor ) {
   EXPECT(assert_equal(expectedH3, actualH3, 1e-8));
 }
 
+/* ************************************************************************* */
+// The errors of several planes from one pose, one factor at a time and in a batch, against the
+// plane transform followed by the plane error
+TEST (OrientedPlane3Factor, EvaluateBatch) {
+  const Pose3 pose(Rot3::ypr(0.3, -0.2, 0.1), Point3(1.0, -2.0, 0.5));
+  vector<OrientedPlane3> planes, measured;
+  planes += OrientedPlane3(-1.0, 0.1, 0.2, 3.0), OrientedPlane3(0.2, 1.0, -0.3, 2.0),
+      OrientedPlane3(0.1, -0.2, 1.0, 5.0);
+  measured += OrientedPlane3(-0.9, 0.0, 0.3, 2.5), OrientedPlane3(0.4, 0.9, -0.2, 1.0),
+      OrientedPlane3(0.0, -0.1, 1.0, 4.0);
+
+  Matrix H1, H2;
+  const Matrix errors = OrientedPlane3Factor::EvaluateBatch(pose, planes, measured, H1, H2);
+  LONGS_EQUAL(3, errors.cols());
+  for (size_t i = 0; i < planes.size(); i++) {
+    Matrix36 expectedH1;
+    Matrix33 expectedH2;
+    const Vector3 expected = planes[i].transform(pose, expectedH2, expectedH1).error(
+        measured[i]);
+
+    const OrientedPlane3Factor factor(measured[i].planeCoefficients(),
+        noiseModel::Unit::Create(3), 0, 1);
+    Matrix actualH1, actualH2;
+    EXPECT(assert_equal(expected, factor.evaluateError(pose, planes[i], actualH1, actualH2), 1e-9));
+    EXPECT(assert_equal(expectedH1, actualH1, 1e-9));
+    EXPECT(assert_equal(expectedH2, actualH2, 1e-9));
+
+    EXPECT(assert_equal(expected, Vector(errors.col(i)), 1e-9));
+    EXPECT(assert_equal(expectedH1, Matrix(H1.block<3, 6>(3 * i, 0)), 1e-9));
+    EXPECT(assert_equal(expectedH2, Matrix(H2.block<3, 3>(3 * i, 0)), 1e-9));
+  }
+  CHECK_EXCEPTION(OrientedPlane3Factor::EvaluateBatch(pose, planes,
+      vector<OrientedPlane3>(1)), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 int main() {
   srand(time(NULL));
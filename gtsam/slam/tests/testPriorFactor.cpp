@@ -7,6 +7,7 @@
 
 #include <gtsam/base/Vector.h>
 #include <gtsam/slam/PriorFactor.h>
+#include <gtsam/geometry/Pose3.h>
 #include <CppUnitLite/TestHarness.h>
 
 using namespace std;
@@ -33,6 +34,29 @@ TEST(PriorFactor, ConstructorDynamicSizeVector) {
   PriorFactor<Vector> factor(1, v, model);
 }
 
+// Linearization with the fixed-size specialization for Pose3
+TEST(PriorFactor, Pose3Linearize) {
+  Pose3 prior(Rot3::Rodrigues(0.1, -0.2, 0.3), Point3(1.0, 2.0, 0.5));
+  Values values;
+  values.insert(1, Pose3(Rot3::Rodrigues(-0.4, 0.5, 2.6), Point3(2.5, 1.5, -0.3)));
+
+  Matrix6 sqrtInformation = 10.0 * Matrix6::Identity();
+  sqrtInformation(0, 4) = 2.0;
+  sqrtInformation(3, 5) = -1.5;
+  std::vector<SharedNoiseModel> models;
+  models.push_back(noiseModel::Unit::Create(6));
+  models.push_back(noiseModel::Diagonal::Sigmas(
+      (Vector(6) << 0.1, 0.2, 0.05, 0.3, 0.3, 0.4).finished()));
+  models.push_back(noiseModel::Gaussian::SqrtInformation(sqrtInformation));
+  models.push_back(noiseModel::Robust::Create(noiseModel::mEstimator::Huber::Create(1.0),
+      noiseModel::Isotropic::Sigma(6, 0.1)));
+  for (size_t i = 0; i < models.size(); ++i) {
+    PriorFactor<Pose3> factor(1, prior, models[i]);
+    EXPECT(assert_equal(*factor.NoiseModelFactor1<Pose3>::linearize(values),
+        *factor.linearize(values), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -18,6 +18,7 @@
 
 #include <gtsam/slam/JacobianFactorQ.h>
 #include <gtsam/slam/JacobianFactorQR.h>
+#include <gtsam/slam/JacobianFactorSVD.h>
 #include <gtsam/slam/RegularImplicitSchurFactor.h>
 #include <gtsam/geometry/CalibratedCamera.h>
 #include <gtsam/geometry/Point2.h>
@@ -279,6 +280,38 @@ TEST(regularImplicitSchurFactor, hessianDiagonal)
   EXPECT(assert_equal(actualBD[3],actualInfo2.block<6,6>(12,12)));
 }
 
+/* ************************************************************************* */
+TEST(regularImplicitSchurFactor, nullSpaceProjection) {
+
+  Matrix E = zeros(6, 3);
+  E.block<2,2>(0, 0) = eye(2);
+  E.block<2,3>(2, 0) = 2 * ones(2, 3);
+  E.block<2,2>(4, 1) = eye(2);
+  Matrix3 P = (E.transpose() * E).inverse();
+  const SharedDiagonal model;
+
+  // JacobianFactorQ, compared with an explicit projector Q
+  Matrix Q = eye(6) - E * P * E.transpose();
+  vector<pair<Key, Matrix> > terms;
+  for (size_t k = 0; k < 3; ++k)
+    terms.push_back(make_pair(keys[k], Matrix(-Q.middleCols<2>(2 * k) * FBlocks[k])));
+  JacobianFactor expectedQ(terms, -Q * b, model);
+  JacobianFactorQ<6, 2> jfQ(keys, FBlocks, E, P, b, model);
+  EXPECT(assert_equal(expectedQ, (const JacobianFactor&)jfQ, 1e-9));
+
+  // JacobianFactorSVD with a Householder projection, compared with the SVD basis of E
+  Eigen::JacobiSVD<Matrix> svd(E, Eigen::ComputeFullU);
+  Matrix Enull = svd.matrixU().rightCols(3);
+  JacobianFactorSVD<6, 2> expectedSVD(keys, FBlocks, Enull, b, model);
+  boost::shared_ptr<JacobianFactorSVD<6, 2> > actualSVD =
+      JacobianFactorSVD<6, 2>::FromPointJacobian(keys, FBlocks, E, b, model);
+  EXPECT_LONGS_EQUAL(3, actualSVD->rows());
+  EXPECT(assert_equal(expectedSVD.information(), actualSVD->information(), 1e-9));
+  EXPECT(assert_equal(expectedSVD.gradientAtZero(), actualSVD->gradientAtZero(), 1e-9));
+  VectorValues x = map_list_of(0, gtsam::repeat(6, 2))(1, gtsam::repeat(6, 4))(3, gtsam::repeat(6, 8));
+  EXPECT_DOUBLES_EQUAL(expectedSVD.error(x), actualSVD->error(x), 1e-9);
+}
+
 /* ************************************************************************* */
 int main(void) {
   TestResult tr;
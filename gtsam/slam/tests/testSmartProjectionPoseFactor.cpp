@@ -186,6 +186,52 @@ TEST( SmartProjectionPoseFactor, noisy ) {
   DOUBLES_EQUAL(actualError1, actualError2, 1e-7);
 }
 
+/* *************************************************************************/
+TEST( SmartProjectionPoseFactor, triangulationCache ) {
+
+  using namespace vanillaPose;
+
+  Point2 level_uv = level_camera.project(landmark1) + Point2(0.2, 0.2);
+  Point2 level_uv_right = level_camera_right.project(landmark1);
+
+  Values values;
+  values.insert(x1, cam1.pose());
+  values.insert(x2, pose_right.compose(
+      Pose3(Rot3::ypr(-M_PI / 10, 0., -M_PI / 10), Point3(0.5, 0.1, 0.3))));
+
+  // Two factors on the same track, sharing a cache
+  TriangulationCache::shared_ptr cache(new TriangulationCache());
+  SmartFactor factor1(model, sharedK), factor2(model, sharedK), expected(model, sharedK);
+  SmartFactor* factors[] = { &factor1, &factor2, &expected };
+  for (size_t i = 0; i < 3; ++i) {
+    factors[i]->add(level_uv, x1);
+    factors[i]->add(level_uv_right, x2);
+  }
+  factor1.setTriangulationCache(cache, 7);
+  factor2.setTriangulationCache(cache, 7);
+
+  // Only the first evaluation triangulates
+  const double expectedError = expected.error(values);
+  EXPECT_DOUBLES_EQUAL(expectedError, factor1.error(values), 1e-9);
+  EXPECT_DOUBLES_EQUAL(expectedError, factor2.error(values), 1e-9);
+  factor1.linearize(values);
+  EXPECT_LONGS_EQUAL(1, cache->size());
+  EXPECT_LONGS_EQUAL(1, cache->misses());
+  EXPECT_LONGS_EQUAL(2, cache->hits());
+  EXPECT(assert_equal(*expected.point(), *factor2.point(), 1e-9));
+
+  // Moving a camera triangulates again
+  values.update(x1, cam1.pose().retract((Vector(6) << 0, 0, 0, 0.1, 0, 0).finished()));
+  EXPECT_DOUBLES_EQUAL(expected.error(values), factor2.error(values), 1e-9);
+  EXPECT_LONGS_EQUAL(2, cache->misses());
+  EXPECT(assert_equal(*expected.point(), *factor2.point(), 1e-9));
+
+  // As does invalidating the track
+  cache->invalidate(7);
+  factor1.error(values);
+  EXPECT_LONGS_EQUAL(3, cache->misses());
+}
+
 /* *************************************************************************/
 TEST( SmartProjectionPoseFactor, smartFactorWithSensorBodyTransform ){
   // make a realistic calibration matrix
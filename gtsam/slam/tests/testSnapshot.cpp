@@ -0,0 +1,110 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testSnapshot.cpp
+ * @date Oct 14, 2026
+ * @brief Unit tests for the binary snapshot format
+ */
+
+#include <gtsam/slam/snapshot.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/ProjectionFactor.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Rot2.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <cstdio>
+#include <fstream>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+using symbol_shorthand::L;
+
+/* ************************************************************************* */
+TEST( Snapshot, roundTrip )
+{
+  Values values;
+  values.insert(0, 1.5);
+  values.insert(1, Point2(1, 2));
+  values.insert(2, Rot2::fromAngle(0.3));
+  values.insert(3, Pose2(1, 2, 0.4));
+  values.insert(4, Rot3::RzRyRx(0.1, 0.2, 0.3));
+  values.insert(5, Cal3_S2(500, 500, 0.1, 320, 240));
+  values.insert(X(1), Pose3(Rot3::RzRyRx(0.1, -0.2, 0.3), Point3(1, 2, 3)));
+  values.insert(X(2), Pose3(Rot3::RzRyRx(0.2, -0.1, 0.4), Point3(2, 2, 3)));
+  values.insert(L(1), Point3(5, 1, 10));
+
+  Matrix R = Matrix::Identity(6, 6);
+  R(0, 5) = 0.5;
+  boost::shared_ptr<Cal3_S2> K(new Cal3_S2(500, 500, 0, 320, 240));
+  NonlinearFactorGraph graph;
+  graph.push_back(PriorFactor<Pose3>(X(1), values.at<Pose3>(X(1)),
+      noiseModel::Isotropic::Sigma(6, 0.1)));
+  graph.push_back(BetweenFactor<Pose3>(X(1), X(2), Pose3(Rot3(), Point3(1, 0, 0)),
+      noiseModel::Gaussian::SqrtInformation(R)));
+  graph.push_back(BetweenFactor<Pose2>(3, 3, Pose2(), noiseModel::Unit::Create(3)));
+  graph.push_back(PriorFactor<Point3>(L(1), Point3(5, 1, 10),
+      noiseModel::Diagonal::Sigmas(Vector3(1, 2, 3))));
+  graph.push_back(GenericProjectionFactor<Pose3, Point3, Cal3_S2>(Point2(300, 200),
+      noiseModel::Isotropic::Sigma(2, 1.0), X(1), L(1), K));
+  graph.push_back(GenericProjectionFactor<Pose3, Point3, Cal3_S2>(Point2(310, 210),
+      noiseModel::Isotropic::Sigma(2, 2.0), X(2), L(1), K, true, false,
+      Pose3(Rot3(), Point3(0.1, 0, 0))));
+
+  const string filename = "testSnapshot.snapshot";
+  writeSnapshot(filename, graph, values);
+  {
+    SnapshotReader reader(filename);
+    LONGS_EQUAL(values.size(), reader.nrValues());
+    LONGS_EQUAL(graph.size(), reader.nrFactors());
+    EXPECT(assert_equal(values, reader.values()));
+    EXPECT(assert_equal(graph, reader.graph()));
+
+    // Random access to individual records
+    EXPECT(reader.factor(4)->equals(*graph[4]));
+    Values some;
+    reader.insertValue(reader.nrValues() - 1, some);
+    LONGS_EQUAL(1, some.size());
+    EXPECT(some.exists(reader.key(reader.nrValues() - 1)));
+  }
+  std::remove(filename.c_str());
+}
+
+/* ************************************************************************* */
+TEST( Snapshot, errors )
+{
+  // Unsupported values
+  Values values;
+  values.insert(0, Vector3(1, 2, 3));
+  CHECK_EXCEPTION(writeSnapshot("testSnapshotErrors.snapshot", NonlinearFactorGraph(), values),
+      std::invalid_argument);
+
+  // Missing file and invalid contents
+  CHECK_EXCEPTION(SnapshotReader("missing.snapshot"), std::invalid_argument);
+  const string filename = "testSnapshotErrors.snapshot";
+  {
+    ofstream os(filename.c_str());
+    os << "this is not a snapshot, but a text file long enough to hold a snapshot header";
+  }
+  CHECK_EXCEPTION(SnapshotReader reader(filename), std::runtime_error);
+  std::remove(filename.c_str());
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
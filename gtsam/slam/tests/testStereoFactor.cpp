@@ -184,6 +184,34 @@ TEST( StereoFactor, JacobianWithTransform ) {
   CHECK(assert_equal(H2Expected, H2Actual, 1e-3));
 }
 
+/* ************************************************************************* */
+TEST( StereoFactor, linearize ) {
+  StereoPoint2 measurement(323, 318-50, 241);
+  Pose3 body_P_sensor(Rot3::RzRyRx(-M_PI_2, 0.0, -M_PI_2), Point3(0.25, -0.10, 1.0));
+  SharedNoiseModel sigmas = noiseModel::Diagonal::Sigmas(Vector3(1.0, 2.0, 0.5));
+  TestStereoFactor factor(measurement, sigmas, X(1), L(1), K);
+  TestStereoFactor factorWithTransform(measurement, sigmas, X(1), L(1), K, body_P_sensor);
+
+  Values values;
+  values.insert(X(1), Pose3(Rot3::RzRyRx(0.05, -0.02, 0.1), Point3(-6.50, 0.10, -1.0)));
+  values.insert(L(1), Point3(0.2, -0.1, 0.3));
+
+  // The fixed-size path has to agree with NoiseModelFactor2::linearize
+  EXPECT(assert_equal(*factorWithTransform.Base::linearize(values),
+      *factorWithTransform.linearize(values), 1e-9));
+
+  Values values2;
+  values2.insert(X(1), camera1);
+  values2.insert(L(1), Point3(0.1, -0.2, 5.0));
+  EXPECT(assert_equal(*factor.Base::linearize(values2), *factor.linearize(values2), 1e-9));
+
+  // Behind the camera: zero Jacobians and a large error
+  Values behind;
+  behind.insert(X(1), camera1);
+  behind.insert(L(1), Point3(0, 0, 7));
+  EXPECT(assert_equal(*factor.Base::linearize(behind), *factor.linearize(behind), 1e-9));
+}
+
 /* ************************************************************************* */
 TEST( StereoFactor, singlePoint)
 {
@@ -28,7 +28,8 @@ namespace gtsam {
 
   /* ************************************************************************* */
   SymbolicJunctionTree::SymbolicJunctionTree(
-    const SymbolicEliminationTree& eliminationTree) :
-  Base(eliminationTree) {}
+    const SymbolicEliminationTree& eliminationTree,
+    const RelaxedAmalgamation& amalgamation) :
+  Base(eliminationTree, amalgamation) {}
 
 }
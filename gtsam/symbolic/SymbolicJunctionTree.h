@@ -58,9 +58,12 @@ namespace gtsam {
     * @param structure The set of factors involving each variable.  If this is not
     * precomputed, you can call the Create(const FactorGraph<DERIVEDFACTOR>&)
     * named constructor instead.
+    * @param amalgamation Parameters for merging cliques, the default merges only when there is
+    * no fill
     * @return The elimination tree
     */
-    SymbolicJunctionTree(const SymbolicEliminationTree& eliminationTree);
+    SymbolicJunctionTree(const SymbolicEliminationTree& eliminationTree,
+      const RelaxedAmalgamation& amalgamation = RelaxedAmalgamation());
   };
 
 }
@@ -147,6 +147,37 @@ TEST(EliminationTree, Create2)
   SymbolicEliminationTree actual(graph, order);
   
   EXPECT(assert_equal(expected, actual));
+  LONGS_EQUAL(1, (long)actual.roots().size());
+  LONGS_EQUAL(8, actual.roots().front()->problemSize());
+}
+
+/* ************************************************************************* */
+TEST(EliminationTree, LongChain)
+{
+  // A chain with a loop closure from every pose to the first one, eliminated
+  // from the far end, is a path whose root is found through every earlier node
+  const size_t n = 2000;
+  SymbolicFactorGraph graph;
+  Ordering order;
+  for (size_t j = 0; j < n; ++j) {
+    if (j > 0) {
+      graph += SymbolicFactor(j - 1, j);
+      graph += SymbolicFactor(0, j);
+    }
+    order += n - 1 - j;
+  }
+
+  SymbolicEliminationTree actual(graph, order);
+  LONGS_EQUAL(1, (long)actual.roots().size());
+  SymbolicEliminationTree::sharedNode node = actual.roots().front();
+  for (size_t j = 0; j < n; ++j) {
+    LONGS_EQUAL((long)(j), (long)node->key);
+    LONGS_EQUAL((long)(n - j), node->problemSize());
+    if (j + 1 < n) {
+      LONGS_EQUAL(1, (long)node->children.size());
+      node = node->children.front();
+    }
+  }
 }
 
 /* ************************************************************************* */
@@ -57,6 +57,30 @@ TEST( JunctionTree, constructor )
   EXPECT(assert_equal(*simpleChain[1],   *actual.roots().front()->children.front()->factors[1]));
 }
 
+/* ************************************************************************* */
+TEST( JunctionTree, relaxedAmalgamation )
+{
+  Ordering order; order += 0, 1, 2, 3;
+  SymbolicEliminationTree etree(simpleChain, order);
+
+  // Merging 0 1 : 2 into 2 3 would make a quarter of the child's rows zero fill
+  SymbolicJunctionTree exact(etree, RelaxedAmalgamation(0.2));
+  LONGS_EQUAL(1, (long)exact.roots().front()->children.size());
+
+  SymbolicJunctionTree::Node::Keys merged = list_of(0)(1)(2)(3);
+  SymbolicJunctionTree relaxed(etree, RelaxedAmalgamation(0.25));
+  EXPECT(assert_container_equality(merged, relaxed.roots().front()->orderedFrontalKeys));
+  LONGS_EQUAL(0, (long)relaxed.roots().front()->children.size());
+  LONGS_EQUAL(3, (long)relaxed.roots().front()->factors.size());
+
+  // The child clique has 2 frontal variables
+  SymbolicJunctionTree small(etree, RelaxedAmalgamation(0.0, 2));
+  LONGS_EQUAL(1, (long)small.roots().front()->children.size());
+  SymbolicJunctionTree large(etree, RelaxedAmalgamation(0.0, 3));
+  EXPECT(assert_container_equality(merged, large.roots().front()->orderedFrontalKeys));
+  LONGS_EQUAL(0, (long)large.roots().front()->children.size());
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
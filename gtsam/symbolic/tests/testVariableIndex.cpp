@@ -115,6 +115,33 @@ TEST(VariableIndex, remove) {
   CHECK(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(VariableIndex, removeInconsistent) {
+
+  SymbolicFactorGraph fg;
+  fg.push_factor(0, 1);
+  fg.push_factor(1, 2);
+  fg.push_factor(1, 3);
+  VariableIndex actual(fg);
+
+  // Removing factors 0 and 2 leaves only factor 1 on variable 1
+  SymbolicFactorGraph removed;
+  removed.push_back(fg[0]);
+  removed.push_back(fg[2]);
+  vector<size_t> indices;
+  indices.push_back(0); indices.push_back(2);
+  actual.remove(indices.begin(), indices.end(), removed);
+  EXPECT_LONGS_EQUAL(2, actual.nEntries());
+  EXPECT(actual[1] == VariableIndex::Factors(size_t(1), size_t(1)));
+  EXPECT(actual[0].empty());
+
+  // Removing factor 0 again is inconsistent with the index
+  vector<size_t> again(1, 0);
+  SymbolicFactorGraph removedAgain;
+  removedAgain.push_back(fg[0]);
+  CHECK_EXCEPTION(actual.remove(again.begin(), again.end(), removedAgain), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 TEST(VariableIndex, deep_copy) {
 
@@ -0,0 +1,603 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file PersistentBTree.h
+ * @brief purely functional B-tree with wide nodes, allocated from a shared pool
+ * @date Oct 15, 2026
+ */
+
+#pragma once
+
+#include <boost/atomic.hpp>
+#include <boost/function.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gtsam {
+
+  /**
+   * @brief Purely functional B-tree, a drop-in for BTree with fewer, wider nodes
+   *
+   * Like BTree, every add or remove returns a new tree and leaves the old one untouched, so a
+   * tree can be handed to concurrent readers as a snapshot.  Only the nodes on the path from the
+   * root to the modified entry are copied, all other nodes are shared between the versions.
+   *
+   * Each node holds up to ORDER-1 sorted keys next to each other, so a lookup touches about
+   * log_ORDER(n) nodes instead of the log_2(n) nodes and shared_ptr dereferences of BTree.
+   * Nodes are reference counted with an atomic counter and allocated from a pool shared by a
+   * tree and all trees derived from it.  Freed nodes are kept in the pool and reused by later
+   * versions instead of going back to the heap.
+   *
+   * KEY and VALUE have to be default constructible and assignable, KEY needs operator<.
+   * Iterators stay valid as long as the tree they were obtained from.
+   * @addtogroup base
+   */
+  template<class KEY, class VALUE, size_t ORDER = 16>
+  class PersistentBTree {
+
+  public:
+
+    typedef std::pair<KEY, VALUE> value_type;
+
+  private:
+
+    // Nodes hold at most ORDER-1 entries, and at least MIN_ENTRIES unless they are the root
+    static const size_t MIN_ENTRIES = (ORDER - 1) / 2;
+
+    /**
+     * Node in a tree.  There is room for one extra entry and child, so an insertion can
+     * overflow a node before it is split.
+     */
+    struct Node {
+      boost::atomic<size_t> refs_;
+      size_t n_;
+      bool leaf_;
+      KEY keys_[ORDER];
+      VALUE values_[ORDER];
+      Node* children_[ORDER + 1];
+
+      Node() : refs_(0), n_(0), leaf_(true) {}
+
+      /** index of the first key not less than k */
+      size_t lowerBound(const KEY& k) const {
+        return std::lower_bound(keys_, keys_ + n_, k) - keys_;
+      }
+    }; // Node
+
+    /**
+     * Allocates nodes in chunks, and keeps freed nodes on a free list for reuse
+     */
+    class Pool : boost::noncopyable {
+      static const size_t NODES_PER_CHUNK = 64;
+
+      union Slot {
+        Slot* next;
+        char node[sizeof(Node)];
+        long double align1;
+        void* align2;
+      };
+
+      boost::mutex mutex_;
+      std::vector<Slot*> chunks_;
+      Slot* free_;
+
+    public:
+
+      Pool() : free_(NULL) {}
+
+      ~Pool() {
+        for (size_t i = 0; i < chunks_.size(); i++)
+          delete[] chunks_[i];
+      }
+
+      Node* allocate() {
+        Slot* slot;
+        {
+          boost::mutex::scoped_lock lock(mutex_);
+          if (!free_) {
+            Slot* chunk = new Slot[NODES_PER_CHUNK];
+            chunks_.push_back(chunk);
+            for (size_t i = 0; i < NODES_PER_CHUNK; i++) {
+              chunk[i].next = free_;
+              free_ = &chunk[i];
+            }
+          }
+          slot = free_;
+          free_ = slot->next;
+        }
+        return new (slot->node) Node();
+      }
+
+      void deallocate(Node* node) {
+        node->~Node();
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        boost::mutex::scoped_lock lock(mutex_);
+        slot->next = free_;
+        free_ = slot;
+      }
+    }; // Pool
+
+    // The pool is declared before the root, so that the nodes are released before the pool
+    boost::shared_ptr<Pool> pool_;
+    Node* root_;
+    size_t size_;
+    size_t height_;
+
+    static void acquire(Node* node) {
+      node->refs_.fetch_add(1, boost::memory_order_relaxed);
+    }
+
+    /** release a reference, and free the node and its subtree if it was the last one */
+    void release(Node* node) const {
+      if (node->refs_.fetch_sub(1, boost::memory_order_acq_rel) != 1) return;
+      if (!node->leaf_)
+        for (size_t i = 0; i <= node->n_; i++)
+          release(node->children_[i]);
+      pool_->deallocate(node);
+    }
+
+    /** copy a node, sharing its children */
+    Node* clone(const Node* node) const {
+      Node* copy = pool_->allocate();
+      copy->n_ = node->n_;
+      copy->leaf_ = node->leaf_;
+      std::copy(node->keys_, node->keys_ + node->n_, copy->keys_);
+      std::copy(node->values_, node->values_ + node->n_, copy->values_);
+      if (!node->leaf_) {
+        std::copy(node->children_, node->children_ + node->n_ + 1, copy->children_);
+        for (size_t i = 0; i <= node->n_; i++)
+          acquire(copy->children_[i]);
+      }
+      return copy;
+    }
+
+    /** replace child i of a node owned by this operation */
+    void setChild(Node* node, size_t i, Node* child) const {
+      acquire(child);
+      release(node->children_[i]);
+      node->children_[i] = child;
+    }
+
+    /** insert an entry at position i of a node, leaving the children alone */
+    static void insertEntry(Node* node, size_t i, const KEY& k, const VALUE& v) {
+      std::copy_backward(node->keys_ + i, node->keys_ + node->n_, node->keys_ + node->n_ + 1);
+      std::copy_backward(node->values_ + i, node->values_ + node->n_, node->values_ + node->n_ + 1);
+      node->keys_[i] = k;
+      node->values_[i] = v;
+      node->n_++;
+    }
+
+    /** remove entry i of a node, leaving the children alone */
+    static void eraseEntry(Node* node, size_t i) {
+      std::copy(node->keys_ + i + 1, node->keys_ + node->n_, node->keys_ + i);
+      std::copy(node->values_ + i + 1, node->values_ + node->n_, node->values_ + i);
+      node->n_--;
+    }
+
+    /** insert an entry and the child to its right at position i of an internal node */
+    static void insertAt(Node* node, size_t i, const KEY& k, const VALUE& v, Node* right) {
+      std::copy_backward(node->children_ + i + 1, node->children_ + node->n_ + 1,
+          node->children_ + node->n_ + 2);
+      node->children_[i + 1] = right;
+      insertEntry(node, i, k, v);
+    }
+
+    /** remove entry i and the child to its right from an internal node, without releasing it */
+    static void eraseAt(Node* node, size_t i) {
+      std::copy(node->children_ + i + 2, node->children_ + node->n_ + 1, node->children_ + i + 1);
+      eraseEntry(node, i);
+    }
+
+    /** Result of an insertion that split a node: the middle entry and the new right node */
+    struct Split {
+      Node* right;
+      KEY key;
+      VALUE value;
+      Split() : right(NULL) {}
+    };
+
+    /** path-copying insertion into the subtree at node, returns the copy of node */
+    Node* insert(const Node* node, const KEY& k, const VALUE& v, Split& split, bool& replaced) const {
+      size_t i = node->lowerBound(k);
+      Node* copy = clone(node);
+      if (i < node->n_ && !(k < node->keys_[i])) {
+        copy->values_[i] = v;
+        replaced = true;
+        return copy;
+      }
+      if (node->leaf_)
+        insertEntry(copy, i, k, v);
+      else {
+        Split childSplit;
+        setChild(copy, i, insert(node->children_[i], k, v, childSplit, replaced));
+        if (childSplit.right) {
+          insertAt(copy, i, childSplit.key, childSplit.value, childSplit.right);
+          acquire(childSplit.right);
+        }
+      }
+
+      // split an overflowing node around its middle entry
+      if (copy->n_ == ORDER) {
+        const size_t mid = ORDER / 2;
+        Node* right = pool_->allocate();
+        right->leaf_ = copy->leaf_;
+        right->n_ = ORDER - mid - 1;
+        std::copy(copy->keys_ + mid + 1, copy->keys_ + ORDER, right->keys_);
+        std::copy(copy->values_ + mid + 1, copy->values_ + ORDER, right->values_);
+        if (!copy->leaf_)
+          std::copy(copy->children_ + mid + 1, copy->children_ + ORDER + 1, right->children_);
+        split.key = copy->keys_[mid];
+        split.value = copy->values_[mid];
+        split.right = right;
+        copy->n_ = mid;
+      }
+      return copy;
+    }
+
+    /**
+     * Restore the minimum number of entries of child i, a node owned by this operation, by
+     * borrowing from or merging with a sibling.  Siblings are copied before they are changed.
+     */
+    void rebalance(Node* node, size_t i) const {
+      Node* child = node->children_[i];
+      if (child->n_ >= MIN_ENTRIES) return;
+
+      if (i > 0 && node->children_[i - 1]->n_ > MIN_ENTRIES) {
+        // rotate the last entry of the left sibling through the parent
+        Node* left = clone(node->children_[i - 1]);
+        insertEntry(child, 0, node->keys_[i - 1], node->values_[i - 1]);
+        if (!child->leaf_) {
+          std::copy_backward(child->children_, child->children_ + child->n_,
+              child->children_ + child->n_ + 1);
+          child->children_[0] = left->children_[left->n_];
+        }
+        node->keys_[i - 1] = left->keys_[left->n_ - 1];
+        node->values_[i - 1] = left->values_[left->n_ - 1];
+        left->n_--;
+        setChild(node, i - 1, left);
+      } else if (i < node->n_ && node->children_[i + 1]->n_ > MIN_ENTRIES) {
+        // rotate the first entry of the right sibling through the parent
+        Node* right = clone(node->children_[i + 1]);
+        insertEntry(child, child->n_, node->keys_[i], node->values_[i]);
+        node->keys_[i] = right->keys_[0];
+        node->values_[i] = right->values_[0];
+        if (!right->leaf_) {
+          child->children_[child->n_] = right->children_[0];
+          std::copy(right->children_ + 1, right->children_ + right->n_ + 1, right->children_);
+        }
+        eraseEntry(right, 0);
+        setChild(node, i + 1, right);
+      } else {
+        // merge with a sibling and the entry in between
+        if (i == node->n_) i--;
+        Node* left = node->children_[i];
+        Node* right = node->children_[i + 1];
+        Node* merged = (left == child) ? left : clone(left);
+        merged->keys_[merged->n_] = node->keys_[i];
+        merged->values_[merged->n_] = node->values_[i];
+        std::copy(right->keys_, right->keys_ + right->n_, merged->keys_ + merged->n_ + 1);
+        std::copy(right->values_, right->values_ + right->n_, merged->values_ + merged->n_ + 1);
+        if (!right->leaf_) {
+          std::copy(right->children_, right->children_ + right->n_ + 1,
+              merged->children_ + merged->n_ + 1);
+          for (size_t j = 0; j <= right->n_; j++)
+            acquire(right->children_[j]);
+        }
+        merged->n_ += right->n_ + 1;
+        if (merged != left) setChild(node, i, merged);
+        release(node->children_[i + 1]);
+        eraseAt(node, i);
+      }
+    }
+
+    /** path-copying removal of the maximum entry of the subtree at node */
+    Node* eraseMax(const Node* node, KEY& k, VALUE& v) const {
+      Node* copy = clone(node);
+      if (node->leaf_) {
+        k = copy->keys_[copy->n_ - 1];
+        v = copy->values_[copy->n_ - 1];
+        copy->n_--;
+      } else {
+        setChild(copy, copy->n_, eraseMax(node->children_[node->n_], k, v));
+        rebalance(copy, copy->n_);
+      }
+      return copy;
+    }
+
+    /** path-copying removal of a key that is in the subtree at node */
+    Node* erase(const Node* node, const KEY& k) const {
+      size_t i = node->lowerBound(k);
+      bool found = i < node->n_ && !(k < node->keys_[i]);
+      Node* copy = clone(node);
+      if (node->leaf_)
+        eraseEntry(copy, i);
+      else if (found) {
+        // replace the entry by its predecessor
+        setChild(copy, i, eraseMax(node->children_[i], copy->keys_[i], copy->values_[i]));
+        rebalance(copy, i);
+      } else {
+        setChild(copy, i, erase(node->children_[i], k));
+        rebalance(copy, i);
+      }
+      return copy;
+    }
+
+    /** tree with a new root, which is not yet referenced */
+    PersistentBTree(const boost::shared_ptr<Pool>& pool, Node* root, size_t size, size_t height) :
+      pool_(pool), root_(root), size_(size), height_(height) {
+      if (root_) acquire(root_);
+    }
+
+  public:
+
+    /** default constructor creates an empty tree */
+    PersistentBTree() : root_(NULL), size_(0), height_(0) {
+    }
+
+    /** copy constructor, shares all nodes */
+    PersistentBTree(const PersistentBTree& other) :
+      pool_(other.pool_), root_(other.root_), size_(other.size_), height_(other.height_) {
+      if (root_) acquire(root_);
+    }
+
+    /** destructor */
+    ~PersistentBTree() {
+      if (root_) release(root_);
+    }
+
+    /** assignment operator */
+    PersistentBTree& operator=(const PersistentBTree& other) {
+      if (other.root_) acquire(other.root_);
+      if (root_) release(root_);
+      pool_ = other.pool_;
+      root_ = other.root_;
+      size_ = other.size_;
+      height_ = other.height_;
+      return *this;
+    }
+
+    /** Check whether tree is empty */
+    bool empty() const {
+      return !root_;
+    }
+
+    /** return size of the tree */
+    size_t size() const {
+      return size_;
+    }
+
+    /** Return height of the tree, 0 if empty */
+    size_t height() const {
+      return height_;
+    }
+
+    /** add a key-value pair, replacing the value if the key exists */
+    PersistentBTree add(const value_type& xd) const {
+      boost::shared_ptr<Pool> pool = pool_ ? pool_ : boost::make_shared<Pool>();
+      if (!root_) {
+        Node* leaf = pool->allocate();
+        leaf->keys_[0] = xd.first;
+        leaf->values_[0] = xd.second;
+        leaf->n_ = 1;
+        return PersistentBTree(pool, leaf, 1, 1);
+      }
+      Split split;
+      bool replaced = false;
+      Node* root = insert(root_, xd.first, xd.second, split, replaced);
+      size_t height = height_;
+      if (split.right) {
+        Node* left = root;
+        root = pool_->allocate();
+        root->leaf_ = false;
+        root->n_ = 1;
+        root->keys_[0] = split.key;
+        root->values_[0] = split.value;
+        root->children_[0] = left;
+        root->children_[1] = split.right;
+        acquire(left);
+        acquire(split.right);
+        height++;
+      }
+      return PersistentBTree(pool_, root, replaced ? size_ : size_ + 1, height);
+    }
+
+    /** add a key-value pair */
+    PersistentBTree add(const KEY& x, const VALUE& d) const {
+      return add(std::make_pair(x, d));
+    }
+
+    /** remove a key-value pair, returns the same tree if the key is not there */
+    PersistentBTree remove(const KEY& x) const {
+      if (!mem(x)) return *this;
+      Node* root = erase(root_, x);
+      if (root->n_ > 0)
+        return PersistentBTree(pool_, root, size_ - 1, height_);
+
+      // the root lost its last entry: the tree shrinks by one level
+      Node* child = root->leaf_ ? NULL : root->children_[0];
+      if (child) acquire(child);
+      acquire(root);
+      release(root);
+      PersistentBTree result(pool_, child, size_ - 1, height_ - 1);
+      if (child) release(child);
+      return result;
+    }
+
+    /** member predicate */
+    bool mem(const KEY& x) const {
+      return findValue(x) != NULL;
+    }
+
+    /** find a value given a key, throws exception when not found */
+    const VALUE& find(const KEY& x) const {
+      const VALUE* value = findValue(x);
+      if (!value) throw std::invalid_argument("PersistentBTree::find: key not found");
+      return *value;
+    }
+
+    /** Check whether trees are *exactly* the same (share the same root) */
+    inline bool same(const PersistentBTree& other) const {
+      return other.root_ == root_;
+    }
+
+    /** Check whether trees contain the same key-value pairs */
+    bool operator==(const PersistentBTree& other) const {
+      if (other.root_ == root_) return true;
+      if (other.size_ != size_) return false;
+      for (const_iterator it1 = begin(), it2 = other.begin(); it1 != end(); ++it1, ++it2)
+        if (!(it1.key() == it2.key()) || !(it1.value() == it2.value())) return false;
+      return true;
+    }
+
+    inline bool operator!=(const PersistentBTree& other) const {
+      return !operator==(other);
+    }
+
+    /** iterate over tree */
+    void iter(boost::function<void(const KEY&, const VALUE&)> f) const {
+      for (const_iterator it = begin(); it != end(); ++it)
+        f(it.key(), it.value());
+    }
+
+    /**
+     *  @brief Const iterator, in increasing order of the keys
+     *  Keeps a stack with the path from the root, and the current entry in each node
+     */
+    class const_iterator {
+
+    private:
+
+      typedef const_iterator Self;
+      typedef std::pair<const Node*, size_t> Position;
+
+      std::vector<Position> path_;
+
+      void descend(const Node* node) {
+        while (true) {
+          path_.push_back(Position(node, 0));
+          if (node->leaf_) break;
+          node = node->children_[0];
+        }
+      }
+
+      void increment() {
+        if (path_.empty()) return;
+        Position& top = path_.back();
+        top.second++;
+        if (!top.first->leaf_)
+          descend(top.first->children_[top.second]);
+        else
+          while (!path_.empty() && path_.back().second == path_.back().first->n_)
+            path_.pop_back();
+      }
+
+      const Position& current() const {
+        if (path_.empty()) throw std::invalid_argument(
+            "PersistentBTree::const_iterator: tried to dereference end");
+        return path_.back();
+      }
+
+    public:
+
+      // traits for playing nice with STL
+      typedef ptrdiff_t difference_type;
+      typedef std::forward_iterator_tag iterator_category;
+      typedef std::pair<KEY, VALUE> value_type;
+      typedef const value_type* pointer;
+      typedef value_type reference; // keys and values are stored apart
+
+      /** initialize end */
+      const_iterator() {
+      }
+
+      /** initialize from root */
+      explicit const_iterator(const Node* root) {
+        if (root) descend(root);
+      }
+
+      /** equality */
+      bool operator==(const Self& other) const {
+        return path_ == other.path_;
+      }
+
+      /** inequality */
+      bool operator!=(const Self& other) const {
+        return path_ != other.path_;
+      }
+
+      /** key of the current entry */
+      const KEY& key() const {
+        return current().first->keys_[current().second];
+      }
+
+      /** value of the current entry */
+      const VALUE& value() const {
+        return current().first->values_[current().second];
+      }
+
+      /** dereference, returns a copy of the key-value pair */
+      reference operator*() const {
+        return value_type(key(), value());
+      }
+
+      /** pre-increment */
+      Self& operator++() {
+        increment();
+        return *this;
+      }
+
+      /** post-increment */
+      Self operator++(int) {
+        Self tmp = *this;
+        increment();
+        return tmp;
+      }
+
+    }; // const_iterator
+
+    // to make PersistentBTree work with BOOST_FOREACH
+    typedef const_iterator iterator;
+
+    /** return iterator */
+    const_iterator begin() const {
+      return const_iterator(root_);
+    }
+
+    /** return iterator */
+    const_iterator end() const {
+      return const_iterator();
+    }
+
+  private:
+
+    const VALUE* findValue(const KEY& k) const {
+      const Node* node = root_;
+      while (node) {
+        size_t i = node->lowerBound(k);
+        if (i < node->n_ && !(k < node->keys_[i])) return &node->values_[i];
+        node = node->leaf_ ? NULL : node->children_[i];
+      }
+      return NULL;
+    }
+
+  }; // PersistentBTree
+
+} // namespace gtsam
@@ -0,0 +1,155 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testPersistentBTree.cpp
+ * @date Oct 15, 2026
+ */
+
+#include <boost/foreach.hpp>
+#include <boost/assign/std/list.hpp> // for +=
+using namespace boost::assign;
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam_unstable/base/PersistentBTree.h>
+
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <sstream>
+
+using namespace std;
+using namespace gtsam;
+
+typedef PersistentBTree<string, int> IntTree;
+typedef PersistentBTree<int, int, 4> SmallTree; // narrow nodes to exercise splits and merges
+
+static string x1("x1"), x2("x2"), x3("x3"), x4("x4"), x5("x5");
+typedef pair<string, int> KeyInt;
+KeyInt p1(x1, 1), p2(x2, 2), p3(x3, 3), p4(x4, 4), p5(x5, 5);
+
+/* ************************************************************************* */
+TEST( PersistentBTree, add )
+{
+  IntTree tree;
+  CHECK(tree.empty())
+  LONGS_EQUAL(0,tree.height())
+
+  IntTree tree1 = tree.add(p1);
+  LONGS_EQUAL(1,tree1.height())
+  LONGS_EQUAL(1,tree1.size())
+  LONGS_EQUAL(1,tree1.find(x1))
+
+  IntTree tree5 = tree1.add(p5).add(p3).add(p2).add(p4);
+  LONGS_EQUAL(5,tree5.size())
+  LONGS_EQUAL(4,tree5.find(x4))
+  CHECK(tree.empty())
+  LONGS_EQUAL(1,tree1.size())
+
+  // Test functional nature: tree5 and tree6 have different values for x4
+  IntTree tree6 = tree5.add(x4, 6);
+  LONGS_EQUAL(5,tree6.size())
+  LONGS_EQUAL(4,tree5.find(x4))
+  LONGS_EQUAL(6,tree6.find(x4))
+  CHECK(tree5 != tree6)
+  CHECK(tree5 == tree1.add(p2).add(p3).add(p4).add(p5))
+
+  CHECK_EXCEPTION(tree5.find("x6"), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST( PersistentBTree, iterating )
+{
+  IntTree tree = IntTree().add(p3).add(p1).add(p5).add(p2).add(p4);
+
+  IntTree::const_iterator it = tree.begin(), it2 = tree.begin();
+  CHECK(it==it2)
+  CHECK(*it == p1)
+  CHECK(it.key() == x1)
+  LONGS_EQUAL(1, it.value())
+  CHECK(*(++it) == p2)
+  CHECK(it!=it2)
+  CHECK(it==(++it2))
+  CHECK(*(++it) == p3)
+  CHECK(*(it++) == p3)
+  CHECK(*it == p4)
+  CHECK(*(++it) == p5)
+  CHECK((++it)==tree.end())
+
+  int sum = 0;
+  BOOST_FOREACH(const KeyInt& p, tree)
+    sum += p.second;
+  LONGS_EQUAL(15,sum)
+
+  list<KeyInt> expected, actual;
+  expected += p1,p2,p3,p4,p5;
+  copy(tree.begin(), tree.end(), back_inserter(actual));
+  CHECK(actual==expected)
+}
+
+/* ************************************************************************* */
+TEST( PersistentBTree, remove )
+{
+  IntTree tree5 = IntTree().add(p1).add(p2).add(p3).add(p4).add(p5);
+  IntTree tree4 = tree5.remove(x3);
+  LONGS_EQUAL(4,tree4.size())
+  CHECK(!tree4.mem(x3))
+  CHECK(tree5.mem(x3))
+  CHECK(tree4.same(tree4.remove(x3)))
+  CHECK(IntTree().add(p1).remove(x1).empty())
+}
+
+/* ************************************************************************* */
+TEST( PersistentBTree, stress )
+{
+  // random adds and removes, compared to std::map, keeping all versions as snapshots
+  srand(42);
+  vector<SmallTree> trees(1);
+  vector<map<int, int> > maps(1);
+  for (int step = 0; step < 2000; step++) {
+    int key = rand() % 300;
+    SmallTree tree = trees.back();
+    map<int, int> m = maps.back();
+    if (rand() % 3 == 0) {
+      tree = tree.remove(key);
+      m.erase(key);
+    } else {
+      tree = tree.add(key, step);
+      m[key] = step;
+    }
+    trees.push_back(tree);
+    maps.push_back(m);
+  }
+
+  // a tree with 4 children per node and about 200 keys is at most 7 levels deep
+  CHECK(trees.back().height() <= 7)
+  for (size_t t = 0; t < trees.size(); t += 97) {
+    LONGS_EQUAL(maps[t].size(), trees[t].size())
+    vector<SmallTree::value_type> expected(maps[t].begin(), maps[t].end());
+    vector<SmallTree::value_type> actual(trees[t].begin(), trees[t].end());
+    CHECK(actual == expected)
+    for (int key = 0; key < 300; key++)
+      CHECK(trees[t].mem(key) == (maps[t].count(key) == 1))
+  }
+
+  // remove everything
+  SmallTree tree = trees.back();
+  typedef pair<const int, int> MapEntry;
+  BOOST_FOREACH(const MapEntry& p, maps.back())
+    tree = tree.remove(p.first);
+  CHECK(tree.empty())
+  LONGS_EQUAL(0,tree.height())
+  LONGS_EQUAL(maps.back().size(), trees.back().size())
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -8,6 +8,13 @@
 #include <gtsam_unstable/discrete/Domain.h>
 #include <gtsam_unstable/discrete/CSP.h>
 #include <gtsam/base/Testable.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
+
 #include <boost/foreach.hpp>
 
 using namespace std;
@@ -21,7 +28,44 @@ namespace gtsam {
     return mpe;
   }
 
-  void CSP::runArcConsistency(size_t cardinality, size_t nrIterations, bool print) const {
+  /* ************************************************************************* */
+  namespace {
+    typedef std::vector<std::vector<Constraint::shared_ptr> > VariableConstraints;
+
+    // Revise the domain of variable v with all its constraints, true if it changed
+    bool revise(Key v, const VariableConstraints& constraints, std::vector<Domain>& domains) {
+      bool changed = false;
+      BOOST_FOREACH(const Constraint::shared_ptr& constraint, constraints[v])
+        // if not already a singleton
+        if (!domains[v].isSingleton())
+          changed = constraint->ensureArcConsistency(v, domains) || changed;
+      return changed;
+    }
+
+#ifdef GTSAM_USE_TBB
+    // Revise a batch of variables that share no constraint, so that no revision reads a
+    // domain that another one writes
+    class ReviseBatch {
+      const std::vector<Key>& batch_;
+      const VariableConstraints& constraints_;
+      std::vector<Domain>& domains_;
+      std::vector<char>& changed_;
+    public:
+      ReviseBatch(const std::vector<Key>& batch, const VariableConstraints& constraints,
+          std::vector<Domain>& domains, std::vector<char>& changed) :
+          batch_(batch), constraints_(constraints), domains_(domains), changed_(changed) {
+      }
+      void operator()(const tbb::blocked_range<size_t>& r) const {
+        for (size_t i = r.begin(); i != r.end(); ++i)
+          changed_[batch_[i]] = revise(batch_[i], constraints_, domains_);
+      }
+    };
+#endif
+  }
+
+  /* ************************************************************************* */
+  std::vector<Domain> CSP::runArcConsistency(size_t cardinality, size_t nrIterations,
+      bool print) const {
     // Create VariableIndex
     VariableIndex index(*this);
     // index.print();
@@ -33,29 +77,65 @@ namespace gtsam {
     for (size_t j = 0; j < n; j++)
       domains.push_back(Domain(DiscreteKey(j,cardinality)));
 
-    // Create array of flags indicating a domain changed or not
-    std::vector<bool> changed(n);
+    // Get the constraints on each variable once
+    VariableConstraints constraints(n);
+    for (size_t v = 0; v < n; v++) {
+      BOOST_FOREACH(size_t f, index[v]) {
+        Constraint::shared_ptr constraint = boost::dynamic_pointer_cast<Constraint>((*this)[f]);
+        if (!constraint) throw runtime_error("CSP:runArcConsistency: non-constraint factor");
+        constraints[v].push_back(constraint);
+      }
+    }
+
+    // Greedily color the variables so that variables sharing a constraint get different
+    // colors.  Variables of one color are revised together, in parallel with TBB.
+    std::vector<std::vector<Key> > batches;
+    std::vector<size_t> color(n), stamp; // stamp[c] == v if a neighbor of v has color c
+    for (size_t v = 0; v < n; v++) {
+      BOOST_FOREACH(const Constraint::shared_ptr& constraint, constraints[v])
+        BOOST_FOREACH(Key k, constraint->keys())
+          if (k < v) stamp[color[k]] = v;
+      size_t c = 0;
+      while (c < batches.size() && stamp[c] == v) ++c;
+      if (c == batches.size()) {
+        batches.push_back(std::vector<Key>());
+        stamp.push_back(n);
+      }
+      color[v] = c;
+      batches[c].push_back(v);
+    }
 
-    // iterate nrIterations over entire grid
+    // Worklist of variables to revise, initially all.  A variable whose domain changed
+    // puts all variables that share a constraint with it back on the worklist.
+    std::vector<char> queued(n, true), changed(n);
+
+    // iterate at most nrIterations over the batches
     for (size_t it = 0; it < nrIterations; it++) {
       bool anyChange = false;
-      // iterate over all cells
-      for (size_t v = 0; v < n; v++) {
-        // keep track of which domains changed
-        changed[v] = false;
-        // loop over all factors/constraints for variable v
-        const VariableIndex::Factors& factors = index[v];
-        BOOST_FOREACH(size_t f,factors) {
-          // if not already a singleton
-          if (!domains[v].isSingleton()) {
-            // get the constraint and call its ensureArcConsistency method
-            Constraint::shared_ptr constraint = boost::dynamic_pointer_cast<Constraint>((*this)[f]);
-            if (!constraint) throw runtime_error("CSP:runArcConsistency: non-constraint factor");
-            changed[v] = constraint->ensureArcConsistency(v,domains) || changed[v];
+      std::fill(changed.begin(), changed.end(), false);
+      BOOST_FOREACH(const std::vector<Key>& batch, batches) {
+        std::vector<Key> work;
+        BOOST_FOREACH(Key v, batch)
+          if (queued[v]) {
+            work.push_back(v);
+            queued[v] = false;
           }
-        } // f
-        if (changed[v]) anyChange = true;
-      } // v
+        if (work.empty()) continue;
+#ifdef GTSAM_USE_TBB
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, work.size()),
+            ReviseBatch(work, constraints, domains, changed));
+#else
+        BOOST_FOREACH(Key v, work)
+          changed[v] = revise(v, constraints, domains);
+#endif
+        BOOST_FOREACH(Key v, work) {
+          if (!changed[v]) continue;
+          anyChange = true;
+          BOOST_FOREACH(const Constraint::shared_ptr& constraint, constraints[v])
+            BOOST_FOREACH(Key k, constraint->keys())
+              queued[k] = true;
+        }
+      } // batches
       if (!anyChange) break;
       // TODO: Sudoku specific hack
       if (print) {
@@ -92,6 +172,7 @@ namespace gtsam {
       if (print) reduced->print();
     }
 #endif
+    return domains;
   }
 } // gtsam
 
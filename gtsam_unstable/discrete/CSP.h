@@ -77,9 +77,12 @@ namespace gtsam {
      * Apply arc-consistency ~ Approximate loopy belief propagation
      * We need to give the domains to a constraint, and it returns
      * a domain whose values don't conflict in the arc-consistency way.
+     * Only variables next to a changed domain are revised again, and variables
+     * that share no constraint are revised in parallel with TBB.
+     * Returns the domains of all variables.
      * TODO: should get cardinality from Indices
      */
-    void runArcConsistency(size_t cardinality, size_t nrIterations = 10,
+    std::vector<Domain> runArcConsistency(size_t cardinality, size_t nrIterations = 10,
         bool print = false) const;
   }; // CSP
 
@@ -21,7 +21,8 @@ namespace gtsam {
 //    formatter(keys_[0]) << ") with values";
 //    BOOST_FOREACH (size_t v,values_) cout << " " << v;
 //    cout << endl;
-    BOOST_FOREACH (size_t v,values_) cout << v;
+    for (size_t v = values_.find_first(); v != values_.npos; v = values_.find_next(v))
+      cout << v;
   }
 
   /* ************************************************************************* */
@@ -50,7 +51,8 @@ namespace gtsam {
   bool Domain::ensureArcConsistency(size_t j, vector<Domain>& domains) const {
     if (j != keys_[0]) throw invalid_argument("Domain check on wrong domain");
     Domain& D = domains[j];
-    BOOST_FOREACH(size_t value, values_)
+    for (size_t value = values_.find_first(); value != values_.npos;
+        value = values_.find_next(value))
       if (!D.contains(value)) throw runtime_error("Unsatisfiable");
     D = *this;
     return true;
@@ -60,14 +62,15 @@ namespace gtsam {
   bool Domain::checkAllDiff(const vector<Key> keys, vector<Domain>& domains) {
     Key j = keys_[0];
     // for all values in this domain
-    BOOST_FOREACH(size_t value, values_) {
+    for (size_t value = values_.find_first(); value != values_.npos;
+        value = values_.find_next(value)) {
       // for all connected domains
       BOOST_FOREACH(Key k, keys)
         // if any domain contains the value we cannot make this domain singleton
         if (k!=j && domains[k].contains(value))
           goto found;
-      values_.clear();
-      values_.insert(value);
+      values_.reset();
+      values_.set(value);
       return true; // we changed it
       found:;
     }
@@ -87,7 +90,7 @@ namespace gtsam {
   Constraint::shared_ptr Domain::partiallyApply(
       const vector<Domain>& domains) const {
     const Domain& Dk = domains[keys_[0]];
-    if (Dk.isSingleton() && !contains(*Dk.begin())) throw runtime_error(
+    if (Dk.isSingleton() && !contains(Dk.firstValue())) throw runtime_error(
         "Domain::partiallyApply: unsatisfiable");
     return boost::make_shared < Domain > (Dk);
   }
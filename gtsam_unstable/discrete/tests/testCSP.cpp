@@ -220,7 +220,14 @@ TEST_UNSAFE( CSP, AllDiff)
   EXPECT(assert_equal(f4,reduced4->toDecisionTreeFactor()));
 
   // full arc-consistency test
-  csp.runArcConsistency(nrColors);
+  vector<Domain> consistent = csp.runArcConsistency(nrColors);
+  LONGS_EQUAL(3, consistent.size());
+  EXPECT(consistent[AZ.first].isSingleton());
+  LONGS_EQUAL(2, consistent[AZ.first].firstValue());
+  LONGS_EQUAL(2, consistent[ID.first].nrValues());
+  EXPECT(!consistent[ID.first].contains(2));
+  LONGS_EQUAL(2, consistent[UT.first].nrValues());
+  EXPECT(!consistent[UT.first].contains(2));
 }
 
 /* ************************************************************************* */
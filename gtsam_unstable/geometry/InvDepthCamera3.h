@@ -14,6 +14,7 @@
 #include <cmath>
 #include <boost/optional.hpp>
 #include <boost/serialization/nvp.hpp>
+#include <vector>
 #include <gtsam/base/Vector.h>
 #include <gtsam/base/Matrix.h>
 #include <gtsam/geometry/Point2.h>
@@ -67,13 +68,22 @@ public:
    * Convert an inverse depth landmark to cartesian Point3
    * @param pw first five parameters (x,y,z,theta,phi) of inv depth landmark
    * @param inv inverse depth
+   * @param H1 optional 3*5 Jacobian w.r.t. pw
+   * @param H2 optional 3*1 Jacobian w.r.t. rho
    * @return Point3
    */
-  static gtsam::Point3 invDepthTo3D(const Vector5& pw, double rho) {
-    gtsam::Point3 ray_base(pw.segment(0,3));
-    double theta = pw(3), phi = pw(4);
-    gtsam::Point3 m(cos(theta)*cos(phi),sin(theta)*cos(phi),sin(phi));
-    return ray_base + m/rho;
+  static gtsam::Point3 invDepthTo3D(const Vector5& pw, double rho,
+      OptionalJacobian<3, 5> H1 = boost::none, OptionalJacobian<3, 1> H2 = boost::none) {
+    const double cos_theta = cos(pw(3)), sin_theta = sin(pw(3));
+    const double cos_phi = cos(pw(4)), sin_phi = sin(pw(4));
+    const Vector3 m(cos_theta*cos_phi, sin_theta*cos_phi, sin_phi);
+    if (H1) {
+      H1->leftCols<3>().setIdentity();
+      H1->col(3) << -sin_theta*cos_phi/rho, cos_theta*cos_phi/rho, 0.0;
+      H1->col(4) << -cos_theta*sin_phi/rho, -sin_theta*sin_phi/rho, cos_phi/rho;
+    }
+    if (H2) *H2 = -m/(rho*rho);
+    return gtsam::Point3(pw.head<3>() + m/rho);
   }
 
   /** project a point from world InvDepth parameterization to the image
@@ -87,65 +97,57 @@ public:
       boost::optional<gtsam::Matrix&> H2 = boost::none,
       boost::optional<gtsam::Matrix&> H3 = boost::none) const {
 
-    gtsam::Point3 ray_base(pw.segment(0,3));
-    double theta = pw(3), phi = pw(4);
-    gtsam::Point3 m(cos(theta)*cos(phi),sin(theta)*cos(phi),sin(phi));
-    const gtsam::Point3 landmark = ray_base + m/rho;
-
     gtsam::PinholeCamera<CALIBRATION> camera(pose_, *k_);
+    if (!H1 && !H2 && !H3)
+      return camera.project(invDepthTo3D(pw, rho));
+
+    Matrix35 Dlandmark_pw;
+    Matrix31 Dlandmark_rho;
+    Matrix26 Dpose;
+    Matrix23 Dlandmark;
+    const gtsam::Point3 landmark = invDepthTo3D(pw, rho, Dlandmark_pw, Dlandmark_rho);
+    gtsam::Point2 uv = camera.project(landmark, Dpose, Dlandmark);
+    if (H1) *H1 = Dpose;
+    if (H2) *H2 = Dlandmark * Dlandmark_pw;
+    if (H3) *H3 = Dlandmark * Dlandmark_rho;
+    return uv;
+  }
 
-    if (!H1 && !H2 && !H3) {
-      gtsam::Point2 uv= camera.project(landmark);
-      return uv;
-    }
-    else {
-      gtsam::Matrix J2;
-      gtsam::Point2 uv= camera.project(landmark,H1, J2, boost::none);
-      if (H1) {
-        *H1 = (*H1) * gtsam::eye(6);
-      }
-
-      double cos_theta = cos(theta);
-      double sin_theta = sin(theta);
-      double cos_phi = cos(phi);
-      double sin_phi = sin(phi);
-      double rho2 = rho * rho;
-
-      if (H2) {
-        double H11 = 1;
-        double H12 = 0;
-        double H13 = 0;
-        double H14 = -cos_phi*sin_theta/rho;
-        double H15 = -cos_theta*sin_phi/rho;
-
-        double H21 = 0;
-        double H22 = 1;
-        double H23 = 0;
-        double H24 = cos_phi*cos_theta/rho;
-        double H25 = -sin_phi*sin_theta/rho;
-
-        double H31 = 0;
-        double H32 = 0;
-        double H33 = 1;
-        double H34 = 0;
-        double H35 = cos_phi/rho;
-
-        *H2 = J2 * (Matrix(3, 5) <<
-            H11, H12, H13, H14, H15,
-            H21, H22, H23, H24, H25,
-            H31, H32, H33, H34, H35).finished();
-      }
-      if(H3) {
-        double H16 = -cos_phi*cos_theta/rho2;
-        double H26 = -cos_phi*sin_theta/rho2;
-        double H36 = -sin_phi/rho2;
-        *H3 = J2 * (Matrix(3, 1) <<
-            H16,
-            H26,
-            H36).finished();
-      }
-      return uv;
+  /**
+   * Project one inverse depth landmark into several images, e.g., all observations of a
+   * landmark, converting the landmark and computing its Jacobian only once.
+   * @param poses the camera poses
+   * @param K the calibration shared by all cameras
+   * @param pw first five parameters (x,y,z,theta,phi) of inv depth landmark
+   * @param rho inverse depth
+   * @param H1 optional 2n*6 Jacobian w.r.t. the poses, 2 rows per pose
+   * @param H2 optional 2n*5 Jacobian w.r.t. pw, 2 rows per pose
+   * @param H3 optional 2n*1 Jacobian w.r.t. rho, 2 rows per pose
+   * @return the image points, one per pose
+   */
+  static std::vector<gtsam::Point2> projectBatch(const std::vector<Pose3>& poses,
+      const CALIBRATION& K, const Vector5& pw, double rho,
+      Matrix* H1 = 0, Matrix* H2 = 0, Matrix* H3 = 0) {
+    Matrix35 Dlandmark_pw;
+    Matrix31 Dlandmark_rho;
+    const gtsam::Point3 landmark = invDepthTo3D(pw, rho, Dlandmark_pw, Dlandmark_rho);
+
+    const size_t n = poses.size();
+    if (H1) H1->resize(2 * n, 6);
+    if (H2) H2->resize(2 * n, 5);
+    if (H3) H3->resize(2 * n, 1);
+    std::vector<gtsam::Point2> uv;
+    uv.reserve(n);
+    Matrix26 Dpose;
+    Matrix23 Dlandmark;
+    for (size_t i = 0; i < n; i++) {
+      gtsam::PinholeCamera<CALIBRATION> camera(poses[i], K);
+      uv.push_back(camera.project(landmark, H1 ? &Dpose : 0, H2 || H3 ? &Dlandmark : 0));
+      if (H1) H1->block<2, 6>(2 * i, 0) = Dpose;
+      if (H2) H2->block<2, 5>(2 * i, 0) = Dlandmark * Dlandmark_pw;
+      if (H3) H3->block<2, 1>(2 * i, 0) = Dlandmark * Dlandmark_rho;
     }
+    return uv;
   }
 
   /**
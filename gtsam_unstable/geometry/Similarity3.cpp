@@ -22,9 +22,70 @@
 #include <gtsam/geometry/Pose3.h>
 
 #include <gtsam/base/Manifold.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/config.h>
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <boost/static_assert.hpp>
+
+#include <limits>
+#include <stdexcept>
 
 namespace gtsam {
 
+namespace {
+
+// Points are mapped as the columns of a 3*n matrix
+BOOST_STATIC_ASSERT(sizeof(Point3) == 3 * sizeof(double));
+typedef Eigen::Matrix<double, 3, Eigen::Dynamic> Matrix3X;
+typedef Eigen::Map<const Matrix3X> ConstPointsMap;
+typedef Eigen::Map<Matrix3X> PointsMap;
+
+// Transform points [first,last) with the matrix sR and translation t
+void transformPoints(const Matrix3& sR, const Vector3& t, const std::vector<Point3>& points,
+    std::vector<Point3>& result, size_t first, size_t last) {
+  ConstPointsMap p(reinterpret_cast<const double*>(&points[first]), 3, last - first);
+  PointsMap q(reinterpret_cast<double*>(&result[first]), 3, last - first);
+  q.noalias() = sR * p;
+  q.colwise() += t;
+}
+
+// Transform poses [first,last) with the rotation R, matrix sR and translation t
+void transformPoses(const Rot3& R, const Matrix3& sR, const Vector3& t,
+    const std::vector<Pose3>& poses, std::vector<Pose3>& result, size_t first, size_t last) {
+  for (size_t i = first; i < last; ++i)
+    result[i] = Pose3(R * poses[i].rotation(), Point3(sR * poses[i].translation().vector() + t));
+}
+
+#ifdef GTSAM_USE_TBB
+struct _TransformPoints {
+  const Matrix3& sR; const Vector3& t;
+  const std::vector<Point3>& points; std::vector<Point3>& result;
+  _TransformPoints(const Matrix3& sR, const Vector3& t, const std::vector<Point3>& points,
+      std::vector<Point3>& result) : sR(sR), t(t), points(points), result(result) {}
+  void operator()(const tbb::blocked_range<size_t>& range) const {
+    transformPoints(sR, t, points, result, range.begin(), range.end());
+  }
+};
+
+struct _TransformPoses {
+  const Rot3& R; const Matrix3& sR; const Vector3& t;
+  const std::vector<Pose3>& poses; std::vector<Pose3>& result;
+  _TransformPoses(const Rot3& R, const Matrix3& sR, const Vector3& t,
+      const std::vector<Pose3>& poses, std::vector<Pose3>& result) :
+      R(R), sR(sR), t(t), poses(poses), result(result) {}
+  void operator()(const tbb::blocked_range<size_t>& range) const {
+    transformPoses(R, sR, t, poses, result, range.begin(), range.end());
+  }
+};
+#endif
+
+}
+
 Similarity3::Similarity3(const Matrix3& R, const Vector3& t, double s) :
       R_(R), t_(t), s_(s) {
 }
@@ -69,6 +130,99 @@ Similarity3::Translation Similarity3::transform_from(const Translation& p) const
   return R_ * (s_ * p) + t_;
 }
 
+void Similarity3::transform_from(const std::vector<Point3>& points,
+    std::vector<Point3>& result) const {
+  result.resize(points.size());
+  if (points.empty())
+    return;
+  const Matrix3 sR = s_ * R_.matrix();
+  const Vector3 t = t_.vector();
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, points.size(), 4096),
+      _TransformPoints(sR, t, points, result));
+#else
+  transformPoints(sR, t, points, result, 0, points.size());
+#endif
+}
+
+void Similarity3::transform_from(const std::vector<Pose3>& poses,
+    std::vector<Pose3>& result) const {
+  result.resize(poses.size());
+  const Matrix3 sR = s_ * R_.matrix();
+  const Vector3 t = t_.vector();
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, poses.size(), 1024),
+      _TransformPoses(R_, sR, t, poses, result));
+#else
+  transformPoses(R_, sR, t, poses, result, 0, poses.size());
+#endif
+}
+
+boost::optional<Similarity3> Similarity3::Align(const std::vector<Point3Pair>& pairs,
+    const std::vector<double>& weights) {
+  const size_t n = pairs.size();
+  if (n < 3)
+    return boost::none;
+  if (!weights.empty() && weights.size() != n)
+    throw std::invalid_argument("Similarity3::Align: one weight per pair is required");
+
+  // the pairs as the columns of two matrices, p the first and q the second points
+  Matrix3X p(3, n), q(3, n);
+  for (size_t i = 0; i < n; ++i) {
+    p.col(i) = pairs[i].first.vector();
+    q.col(i) = pairs[i].second.vector();
+  }
+  const Vector w = weights.empty() ? Vector(Vector::Ones(n)) :
+      Vector(Eigen::Map<const Vector>(&weights[0], n));
+  const double W = w.sum();
+  if (W <= 0.0)
+    return boost::none;
+
+  // weighted centroids, covariance of q and p, and variance of p
+  const Vector3 cp = p * w / W, cq = q * w / W;
+  p.colwise() -= cp;
+  q.colwise() -= cq;
+  const Matrix3X wp = p * w.asDiagonal();
+  const Matrix3 Sigma = q * wp.transpose() / W;
+  const double sigma2 = (wp.cwiseProduct(p)).sum() / W;
+  if (sigma2 <= std::numeric_limits<double>::epsilon())
+    return boost::none;
+
+  // rotation with the reflection correction, scale and translation
+  Eigen::JacobiSVD<Matrix3> svd(Sigma, Eigen::ComputeFullU | Eigen::ComputeFullV);
+  Vector3 d = Vector3::Ones();
+  if (svd.matrixU().determinant() * svd.matrixV().determinant() < 0)
+    d(2) = -1.0;
+  const Matrix3 R = svd.matrixU() * d.asDiagonal() * svd.matrixV().transpose();
+  const double s = svd.singularValues().dot(d) / sigma2;
+  return Similarity3(R, cq - s * R * cp, s);
+}
+
+boost::optional<Similarity3> Similarity3::Align(const std::vector<Point3Pair>& pairs,
+    const noiseModel::mEstimator::Base& robust, size_t maxIterations) {
+  boost::optional<Similarity3> S = Align(pairs);
+  if (!S)
+    return S;
+  const size_t n = pairs.size();
+  Vector distances(n);
+  std::vector<double> weights(n);
+  for (size_t iteration = 0; iteration < maxIterations; ++iteration) {
+    const Matrix3 sR = S->s_ * S->R_.matrix();
+    const Vector3 t = S->t_.vector();
+    for (size_t i = 0; i < n; ++i)
+      distances(i) = (pairs[i].second.vector() - sR * pairs[i].first.vector() - t).norm();
+    Eigen::Map<Vector>(&weights[0], n) = robust.weights(distances);
+    const boost::optional<Similarity3> next = Align(pairs, weights);
+    if (!next)
+      break;
+    const bool converged = next->equals(*S, 1e-9);
+    S = next;
+    if (converged)
+      break;
+  }
+  return S;
+}
+
 Matrix7 Similarity3::AdjointMap() const{
   const Matrix3 R = R_.matrix();
   const Vector3 t = t_.vector();
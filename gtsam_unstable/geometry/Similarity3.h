@@ -22,10 +22,14 @@
 #include <gtsam/base/Lie.h>
 #include <gtsam/base/Manifold.h>
 
+#include <boost/optional.hpp>
+#include <vector>
+
 namespace gtsam {
 
 // Forward declarations
 class Pose3;
+namespace noiseModel { namespace mEstimator { class Base; } }
 
 /**
  * 3D similarity transform
@@ -89,6 +93,31 @@ public:
 
   Similarity3 operator*(const Similarity3& T) const;
 
+  /// Transform an array of points, in parallel with TBB
+  void transform_from(const std::vector<Point3>& points, std::vector<Point3>& result) const;
+
+  /// Transform an array of poses, rotating their orientations and transforming their positions
+  void transform_from(const std::vector<Pose3>& poses, std::vector<Pose3>& result) const;
+
+  /// @}
+  /// @name Alignment
+  /// @{
+
+  /**
+   * Closed-form least-squares similarity S with pair.second = S * pair.first (Umeyama 1991),
+   * each pair weighted by the corresponding entry of \c weights, or uniformly if it is empty.
+   * Returns none for fewer than three pairs or if the weighted first points coincide.
+   */
+  static boost::optional<Similarity3> Align(const std::vector<Point3Pair>& pairs,
+      const std::vector<double>& weights = std::vector<double>());
+
+  /**
+   * Iteratively reweighted Align, the weights being those of the \c robust kernel for the
+   * distances between pair.second and S * pair.first, starting from uniform weights.
+   */
+  static boost::optional<Similarity3> Align(const std::vector<Point3Pair>& pairs,
+      const noiseModel::mEstimator::Base& robust, size_t maxIterations = 10);
+
   /// @}
   /// @name Standard interface
   /// @{
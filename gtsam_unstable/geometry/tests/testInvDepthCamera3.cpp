@@ -121,6 +121,30 @@ TEST( InvDepthFactor, Dproject_inv_depth)
   EXPECT(assert_equal(expected,actual,1e-7));
 }
 
+/* ************************************************************************* */
+TEST( InvDepthFactor, projectBatch)
+{
+  Vector5 landmark((Vector(5) << 0.1,0.2,0.3, 0.1,0.2).finished());
+  double inv_depth(1./4);
+  vector<Pose3> poses;
+  poses.push_back(level_pose);
+  poses.push_back(level_pose.retract((Vector(6) << 0.01,-0.02,0.03, 0.1,-0.2,0.3).finished()));
+  poses.push_back(level_pose.retract((Vector(6) << -0.02,0.01,0.02, 0.2,0.1,-0.5).finished()));
+
+  Matrix actualH1, actualH2, actualH3;
+  vector<Point2> actual = InvDepthCamera3<Cal3_S2>::projectBatch(poses, *K, landmark,
+      inv_depth, &actualH1, &actualH2, &actualH3);
+  LONGS_EQUAL(3, actual.size());
+  for (size_t i = 0; i < poses.size(); i++) {
+    InvDepthCamera3<Cal3_S2> inv_camera(poses[i], K);
+    Matrix H1, H2, H3;
+    EXPECT(assert_equal(inv_camera.project(landmark, inv_depth, H1, H2, H3), actual[i]));
+    EXPECT(assert_equal(H1, Matrix(actualH1.middleRows(2 * i, 2)), 1e-9));
+    EXPECT(assert_equal(H2, Matrix(actualH2.middleRows(2 * i, 2)), 1e-9));
+    EXPECT(assert_equal(H3, Matrix(actualH3.middleRows(2 * i, 2)), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 TEST(InvDepthFactor, backproject)
 {
@@ -7,6 +7,7 @@
 
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/inference/FactorGraph-inst.h>
+#include <gtsam/linear/linearExceptions.h>
 #include <gtsam_unstable/linear/QPSolver.h>
 
 #include <boost/range/adaptor/map.hpp>
@@ -24,16 +25,40 @@ QPSolver::QPSolver(const QP& qp) : qp_(qp) {
   inequalityVariableIndex_ = VariableIndex(qp_.inequalities);
   constrainedKeys_ = qp_.equalities.keys();
   constrainedKeys_.merge(qp_.inequalities.keys());
+
+  // Eliminate the keys that no inequality involves, in COLAMD order
+  KeySet inequalityKeys = qp_.inequalities.keys();
+  KeySet baseKeys = baseGraph_.keys();
+  vector<Key> constrainLast;
+  BOOST_FOREACH(Key key, baseKeys) {
+    if (inequalityKeys.exists(key))
+      constrainLast.push_back(key);
+  }
+  if (!constrainLast.empty() && constrainLast.size() < baseKeys.size()) {
+    Ordering ordering = Ordering::ColamdConstrainedLast(baseGraph_, constrainLast);
+    Ordering freeKeys;
+    freeKeys.assign(ordering.begin(), ordering.end() - constrainLast.size());
+    try {
+      boost::tie(freeBayesNet_, reducedGraph_) =
+          baseGraph_.eliminatePartialSequential(freeKeys);
+    } catch (const IndeterminantLinearSystemException&) {
+      // Only determined together with the inequality keys, solve the whole system every time
+      freeBayesNet_.reset();
+      reducedGraph_.reset();
+    }
+  }
 }
 
 //******************************************************************************
 VectorValues QPSolver::solveWithCurrentWorkingSet(
     const LinearInequalityFactorGraph& workingSet) const {
-  GaussianFactorGraph workingGraph = baseGraph_;
+  GaussianFactorGraph workingGraph = freeBayesNet_ ? *reducedGraph_ : baseGraph_;
   BOOST_FOREACH(const LinearInequality::shared_ptr& factor, workingSet) {
     if (factor->active())
       workingGraph.push_back(factor);
   }
+  if (freeBayesNet_)
+    return freeBayesNet_->optimize(workingGraph.optimize());
   return workingGraph.optimize();
 }
 
@@ -232,13 +257,32 @@ LinearInequalityFactorGraph QPSolver::identifyActiveConstraints(
   return workingSet;
 }
 
+//******************************************************************************
+LinearInequalityFactorGraph QPSolver::identifyActiveConstraints(
+    const LinearInequalityFactorGraph& inequalities,
+    const VectorValues& initialValues, const KeySet& warmActiveSet) const {
+  LinearInequalityFactorGraph workingSet =
+      identifyActiveConstraints(inequalities, initialValues);
+  BOOST_FOREACH(const LinearInequality::shared_ptr& factor, workingSet) {
+    if (warmActiveSet.exists(factor->dualKey()))
+      factor->activate();
+  }
+  return workingSet;
+}
+
 //******************************************************************************
 pair<VectorValues, VectorValues> QPSolver::optimize(
     const VectorValues& initialValues) const {
+  return optimize(initialValues, KeySet());
+}
+
+//******************************************************************************
+pair<VectorValues, VectorValues> QPSolver::optimize(
+    const VectorValues& initialValues, const KeySet& warmActiveSet) const {
 
   // Initialize workingSet from the feasible initialValues
   LinearInequalityFactorGraph workingSet =
-      identifyActiveConstraints(qp_.inequalities, initialValues);
+      identifyActiveConstraints(qp_.inequalities, initialValues, warmActiveSet);
   QPState state(initialValues, VectorValues(), workingSet, false);
 
   /// main loop of the solver
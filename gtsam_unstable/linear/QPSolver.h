@@ -8,6 +8,7 @@
 #pragma once
 
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam_unstable/linear/QP.h>
 
 #include <vector>
@@ -49,12 +50,19 @@ class QPSolver {
   VariableIndex costVariableIndex_, equalityVariableIndex_,
       inequalityVariableIndex_;
   KeySet constrainedKeys_; //!< all constrained keys, will become factors in the dual graph
+  GaussianBayesNet::shared_ptr freeBayesNet_; //!< elimination of the keys no inequality involves, null if there are none
+  GaussianFactorGraph::shared_ptr reducedGraph_; //!< the factor on the inequality keys left by freeBayesNet_
 
 public:
   /// Constructor
   QPSolver(const QP& qp);
 
-  /// Find solution with the current working set
+  /**
+   * Find solution with the current working set.
+   * The working set only changes the system on the keys involved in inequalities, so the
+   * other keys are eliminated once in the constructor, and every active-set iteration only
+   * eliminates the reduced system left on the inequality keys before back-substituting.
+   */
   VectorValues solveWithCurrentWorkingSet(
       const LinearInequalityFactorGraph& workingSet) const;
 
@@ -175,6 +183,16 @@ public:
       const LinearInequalityFactorGraph& inequalities,
       const VectorValues& initialValues) const;
 
+  /**
+   * Identify active constraints based on initial values, and also activate the inequalities
+   * whose dual keys are in warmActiveSet, e.g., the active set of the previous solve of a QP
+   * with the same structure.  Those need not be tight at the initial values, but together with
+   * the equalities they have to be linearly independent.
+   */
+  LinearInequalityFactorGraph identifyActiveConstraints(
+      const LinearInequalityFactorGraph& inequalities,
+      const VectorValues& initialValues, const KeySet& warmActiveSet) const;
+
   /** Optimize with a provided initial values
    * For this version, it is the responsibility of the caller to provide
    * a feasible initial value.
@@ -183,6 +201,15 @@ public:
   std::pair<VectorValues, VectorValues> optimize(
       const VectorValues& initialValues) const;
 
+  /** Optimize with a provided feasible initial values, warm started from the inequalities
+   * whose dual keys are in warmActiveSet, e.g., the keys of the duals returned by the previous
+   * solve.  When the active set does not change much between solves, as in model predictive
+   * control, this saves most of the active-set iterations.
+   * @return a pair of <primal, dual> solutions
+   */
+  std::pair<VectorValues, VectorValues> optimize(
+      const VectorValues& initialValues, const KeySet& warmActiveSet) const;
+
 };
 
 } /* namespace gtsam */
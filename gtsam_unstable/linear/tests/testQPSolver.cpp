@@ -302,6 +302,62 @@ TEST(QPSolver, failedSubproblem) {
   CHECK(assert_equal(expected, solution, 1e-7));
 }
 
+/* ************************************************************************* */
+// A tiny MPC problem: x0 = 5, x_{k+1} = x_k + u_k, cost sum x_k^2 + u_k^2, and u_k >= -1.
+// The states only appear in the cost and the dynamics, so they are eliminated once.
+QP createTestMPC() {
+  QP qp;
+  qp.equalities.push_back(LinearEquality(X(0), One, 5.0 * ones(1), 0));
+  for (size_t k = 0; k < 2; ++k) {
+    qp.cost.push_back(JacobianFactor(X(k + 1), One, zero(1)));
+    qp.cost.push_back(JacobianFactor(U(k), One, zero(1)));
+    qp.equalities.push_back(LinearEquality(X(k + 1), One, X(k), -One, U(k), -One, zero(1), k + 1));
+    qp.inequalities.push_back(LinearInequality(U(k), -One, 1.0, k + 10)); // -u_k <= 1
+  }
+  return qp;
+}
+
+TEST(QPSolver, warmStart) {
+  QP qp = createTestMPC();
+  QPSolver solver(qp);
+  VectorValues initialValues;
+  for (size_t k = 0; k < 3; ++k)
+    initialValues.insert(X(k), 5.0 * ones(1));
+  for (size_t k = 0; k < 2; ++k)
+    initialValues.insert(U(k), zero(1));
+
+  VectorValues solution, duals;
+  boost::tie(solution, duals) = solver.optimize(initialValues);
+  VectorValues expectedSolution;
+  expectedSolution.insert(X(0), 5.0 * ones(1));
+  expectedSolution.insert(X(1), 4.0 * ones(1));
+  expectedSolution.insert(X(2), 3.0 * ones(1));
+  expectedSolution.insert(U(0), -ones(1));
+  expectedSolution.insert(U(1), -ones(1));
+  CHECK(assert_equal(expectedSolution, solution, 1e-7));
+
+  // Warm start from the active set of the previous solve
+  KeySet activeSet;
+  BOOST_FOREACH(const VectorValues::KeyValuePair& dual, duals)
+    activeSet.insert(dual.first);
+  EXPECT(activeSet.exists(10) && activeSet.exists(11));
+  VectorValues warmSolution;
+  boost::tie(warmSolution, boost::tuples::ignore) = solver.optimize(initialValues, activeSet);
+  CHECK(assert_equal(expectedSolution, warmSolution, 1e-7));
+
+  // which takes fewer iterations
+  size_t coldIterations = 0, warmIterations = 0;
+  QPState state(initialValues, VectorValues(),
+      solver.identifyActiveConstraints(qp.inequalities, initialValues), false);
+  for (; !state.converged; ++coldIterations)
+    state = solver.iterate(state);
+  state = QPState(initialValues, VectorValues(),
+      solver.identifyActiveConstraints(qp.inequalities, initialValues, activeSet), false);
+  for (; !state.converged; ++warmIterations)
+    state = solver.iterate(state);
+  EXPECT(warmIterations < coldIterations);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -20,11 +20,16 @@
 #include <gtsam_unstable/nonlinear/BatchFixedLagSmoother.h>
 #include <gtsam/nonlinear/LinearContainerFactor.h>
 #include <gtsam/linear/GaussianJunctionTree.h>
+#include <gtsam/linear/GaussianEliminationTree.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/inference/inferenceExceptions.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/GaussianFactor.h>
 //#include <gtsam/inference/inference.h>
 #include <gtsam/base/debug.h>
 
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
 namespace gtsam {
 
 /* ************************************************************************* */
@@ -67,6 +72,7 @@ FixedLagSmoother::Result BatchFixedLagSmoother::update(
   BOOST_FOREACH(const Values::ConstKeyValuePair& key_value, newTheta) {
     ordering_.push_back(key_value.key);
   }
+  newKeysSinceReorder_ += newTheta.size();
   // Augment Delta
   delta_.insert(newTheta.zeroVectors());
 
@@ -109,7 +115,11 @@ FixedLagSmoother::Result BatchFixedLagSmoother::update(
   // Marginalize out old variables.
   gttic(marginalize);
   if (marginalizableKeys.size() > 0) {
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
     marginalize(marginalizableKeys);
+    result.marginalizedVariables = marginalizableKeys.size();
+    result.marginalizationTime = 1e-6 * (boost::posix_time::microsec_clock::universal_time()
+        - start).total_microseconds();
   }
   gttoc(marginalize);
 
@@ -181,8 +191,14 @@ void BatchFixedLagSmoother::eraseKeys(const std::set<Key>& keys) {
   eraseKeyTimestampMap(keys);
 
   // Remove marginalized keys from the ordering and delta
+  Ordering remaining;
+  remaining.reserve(ordering_.size());
+  BOOST_FOREACH(Key key, ordering_) {
+    if (keys.find(key) == keys.end())
+      remaining.push_back(key);
+  }
+  ordering_ = remaining;
   BOOST_FOREACH(Key key, keys) {
-    ordering_.erase(std::find(ordering_.begin(), ordering_.end(), key));
     delta_.erase(key);
   }
 }
@@ -204,9 +220,26 @@ void BatchFixedLagSmoother::reorder(const std::set<Key>& marginalizeKeys) {
     std::cout << std::endl;
   }
 
-  // COLAMD groups will be used to place marginalize keys in Group 0, and everything else in Group 1
-  ordering_ = Ordering::ColamdConstrainedFirst(factors_,
-      std::vector<Key>(marginalizeKeys.begin(), marginalizeKeys.end()));
+  if (2 * newKeysSinceReorder_ >= ordering_.size()) {
+    // COLAMD groups will be used to place marginalize keys in Group 0, and everything else in Group 1
+    ordering_ = Ordering::ColamdConstrainedFirst(factors_,
+        std::vector<Key>(marginalizeKeys.begin(), marginalizeKeys.end()));
+    newKeysSinceReorder_ = 0;
+  } else if (!marginalizeKeys.empty()) {
+    // As the window slides the previous ordering stays good, with the new keys at the end.
+    // Only move the marginalize keys, which usually are in front already, to the front.
+    Ordering reordered;
+    reordered.reserve(ordering_.size());
+    BOOST_FOREACH(Key key, ordering_) {
+      if (marginalizeKeys.find(key) != marginalizeKeys.end())
+        reordered.push_back(key);
+    }
+    BOOST_FOREACH(Key key, ordering_) {
+      if (marginalizeKeys.find(key) == marginalizeKeys.end())
+        reordered.push_back(key);
+    }
+    ordering_ = reordered;
+  }
 
   if (debug) {
     ordering_.print("New Ordering: ");
@@ -273,6 +306,28 @@ FixedLagSmoother::Result BatchFixedLagSmoother::optimize() {
       // Linearize graph around the linearization point
       GaussianFactorGraph linearFactorGraph = *factors_.linearize(theta_);
 
+      // Add prior factors at the current solution, for each of the variables. Their weight
+      // is set for each lambda below, so the symbolic structure of the damped system, and its
+      // junction tree, is the same for all lambdas and is only computed once.
+      gttic(damp);
+      GaussianFactorGraph dampedFactorGraph(linearFactorGraph);
+      dampedFactorGraph.reserve(linearFactorGraph.size() + delta_.size());
+      std::vector<JacobianFactor::shared_ptr> priors;
+      priors.reserve(delta_.size());
+      BOOST_FOREACH(const VectorValues::KeyValuePair& key_value, delta_) {
+        size_t dim = key_value.second.size();
+        priors.push_back(boost::make_shared<JacobianFactor>(key_value.first,
+            Matrix::Identity(dim, dim), key_value.second, noiseModel::Unit::Create(dim)));
+        dampedFactorGraph.push_back(priors.back());
+      }
+      gttoc(damp);
+
+      gttic(symbolic);
+      GaussianEliminationTree eliminationTree(dampedFactorGraph,
+          VariableIndex(dampedFactorGraph), ordering_);
+      GaussianJunctionTree junctionTree(eliminationTree);
+      gttoc(symbolic);
+
       // Keep increasing lambda until we make make progress
       while (true) {
 
@@ -281,21 +336,16 @@ FixedLagSmoother::Result BatchFixedLagSmoother::optimize() {
               << lambda << std::endl;
         }
 
-        // Add prior factors at the current solution
+        // Weight the priors at the current solution with sigma = 1/sqrt(lambda)
         gttic(damp);
-        GaussianFactorGraph dampedFactorGraph(linearFactorGraph);
-        dampedFactorGraph.reserve(linearFactorGraph.size() + delta_.size());
         {
-          // for each of the variables, add a prior at the current solution
-          double sigma = 1.0 / std::sqrt(lambda);
+          const double sqrtLambda = std::sqrt(lambda);
+          size_t i = 0;
           BOOST_FOREACH(const VectorValues::KeyValuePair& key_value, delta_) {
+            JacobianFactor& prior = *priors[i++];
             size_t dim = key_value.second.size();
-            Matrix A = Matrix::Identity(dim, dim);
-            Vector b = key_value.second;
-            SharedDiagonal model = noiseModel::Isotropic::Sigma(dim, sigma);
-            GaussianFactor::shared_ptr prior(
-                new JacobianFactor(key_value.first, A, b, model));
-            dampedFactorGraph.push_back(prior);
+            prior.getA(prior.begin()) = sqrtLambda * Matrix::Identity(dim, dim);
+            prior.getb() = sqrtLambda * key_value.second;
           }
         }
         gttoc(damp);
@@ -303,8 +353,11 @@ FixedLagSmoother::Result BatchFixedLagSmoother::optimize() {
 
         gttic(solve);
         // Solve Damped Gaussian Factor Graph
-        newDelta = dampedFactorGraph.optimize(ordering_,
-            parameters_.getEliminationFunction());
+        std::pair<GaussianBayesTree::shared_ptr, GaussianFactorGraph::shared_ptr> eliminated =
+            junctionTree.eliminate(parameters_.getEliminationFunction());
+        if (!eliminated.second->empty())
+          throw InconsistentEliminationRequested();
+        newDelta = eliminated.first->optimize();
         // update the evalpoint with the new delta
         evalpoint = theta_.retract(newDelta);
         gttoc(solve);
@@ -405,10 +458,10 @@ void BatchFixedLagSmoother::marginalize(const std::set<Key>& marginalizeKeys) {
 
   // Identify all of the factors involving any marginalized variable. These must be removed.
   std::set<size_t> removedFactorSlots;
-  VariableIndex variableIndex(factors_);
   BOOST_FOREACH(Key key, marginalizeKeys) {
-    const FastVector<size_t>& slots = variableIndex[key];
-    removedFactorSlots.insert(slots.begin(), slots.end());
+    FactorIndex::const_iterator slots = factorIndex_.find(key);
+    if (slots != factorIndex_.end())
+      removedFactorSlots.insert(slots->second.begin(), slots->second.end());
   }
 
   if (debug) {
@@ -35,7 +35,7 @@ public:
 
   /** default constructor */
   BatchFixedLagSmoother(double smootherLag = 0.0, const LevenbergMarquardtParams& parameters = LevenbergMarquardtParams(), bool enforceConsistency = true) :
-    FixedLagSmoother(smootherLag), parameters_(parameters), enforceConsistency_(enforceConsistency) { };
+    FixedLagSmoother(smootherLag), parameters_(parameters), enforceConsistency_(enforceConsistency), newKeysSinceReorder_(0) { };
 
   /** destructor */
   virtual ~BatchFixedLagSmoother() { };
@@ -140,6 +140,9 @@ protected:
   /** A cross-reference structure to allow efficient factor lookups by key **/
   FactorIndex factorIndex_;
 
+  /** Number of variables added since the ordering was last computed with COLAMD **/
+  size_t newKeysSinceReorder_;
+
   /** Augment the list of factors with a set of new factors */
   void insertFactors(const NonlinearFactorGraph& newFactors);
 
@@ -149,7 +152,8 @@ protected:
   /** Erase any keys associated with timestamps before the provided time */
   void eraseKeys(const std::set<Key>& keys);
 
-  /** Use colamd to update into an efficient ordering */
+  /** Move the marginalizable keys to the front of the ordering, and recompute it with colamd
+   * once half of the variables in the window were added since it was last computed */
   void reorder(const std::set<Key>& marginalizeKeys = std::set<Key>());
 
   /** Optimize the current graph using a modified version of L-M */
@@ -19,6 +19,8 @@
 #include <gtsam_unstable/nonlinear/ConcurrentBatchSmoother.h>
 #include <gtsam/nonlinear/LinearContainerFactor.h>
 #include <gtsam/linear/GaussianJunctionTree.h>
+#include <gtsam/linear/GaussianEliminationTree.h>
+#include <gtsam/linear/GaussianEliminationPlan.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/base/debug.h>
 
@@ -94,7 +96,7 @@ ConcurrentBatchSmoother::Result ConcurrentBatchSmoother::update(const NonlinearF
   // Calculate the marginal on the separator from the smoother factors
   if(separatorValues_.size() > 0) {
     gttic(presync);
-    updateSmootherSummarization();
+    result.reusedCliques = updateSmootherSummarization();
     gttoc(presync);
   }
 
@@ -199,6 +201,10 @@ std::vector<size_t> ConcurrentBatchSmoother::insertFactors(const NonlinearFactor
       factors_.push_back(factor);
     }
     slots.push_back(slot);
+
+    // A reused slot has to be linearized again
+    if(slot < linearFactors_.size())
+      linearFactors_[slot].reset();
   }
 
   gttoc(insert_factors);
@@ -264,7 +270,7 @@ ConcurrentBatchSmoother::Result ConcurrentBatchSmoother::optimize() {
     gttic(optimizer_iteration);
     {
       // Linearize graph around the linearization point
-      GaussianFactorGraph linearFactorGraph = *factors_.linearize(theta_);
+      GaussianFactorGraph linearFactorGraph = *linearize();
 
       // Keep increasing lambda until we make make progress
       while(true) {
@@ -292,8 +298,17 @@ ConcurrentBatchSmoother::Result ConcurrentBatchSmoother::optimize() {
         result.lambdas++;
 
         gttic(solve);
-        // Solve Damped Gaussian Factor Graph
-        newDelta = dampedFactorGraph.optimize(ordering_, parameters_.getEliminationFunction());
+        // Solve Damped Gaussian Factor Graph.  The damped system has the same structure for every
+        // lambda and iteration, and for updates that add no factors, so the symbolic elimination
+        // is only redone when the ordering or the structure changes.
+        if(!eliminationPlan_ || eliminationPlan_->ordering() != ordering_
+            || !eliminationPlan_->compatible(dampedFactorGraph))
+          eliminationPlan_ = boost::make_shared<GaussianEliminationPlan>(dampedFactorGraph, ordering_);
+        if(parameters_.linearSolverType == NonlinearOptimizerParams::MULTIFRONTAL_CHOLESKY)
+          newDelta = eliminationPlan_->optimize(dampedFactorGraph);
+        else
+          newDelta = eliminationPlan_->eliminateMultifrontal(dampedFactorGraph,
+              parameters_.getEliminationFunction())->optimize();
         // update the evalpoint with the new delta
         evalpoint = theta_.retract(newDelta);
         gttoc(solve);
@@ -357,7 +372,15 @@ ConcurrentBatchSmoother::Result ConcurrentBatchSmoother::optimize() {
 }
 
 /* ************************************************************************* */
-void ConcurrentBatchSmoother::updateSmootherSummarization() {
+GaussianFactorGraph::shared_ptr ConcurrentBatchSmoother::linearize() {
+  if(!parameters_.cacheLinearization)
+    return factors_.linearize(theta_);
+  return linearizeWithCache(factors_, theta_, parameters_.relinearizeThreshold,
+      linearizationPoint_, linearFactors_, skippedLinearizations_);
+}
+
+/* ************************************************************************* */
+size_t ConcurrentBatchSmoother::updateSmootherSummarization() {
 
   // The smoother summarization factors are the resulting marginal factors on the separator
   // variables that result from marginalizing out all of the other variables
@@ -377,7 +400,85 @@ void ConcurrentBatchSmoother::updateSmootherSummarization() {
   }
 
   // Calculate the marginal factors on the separator
-  smootherSummarization_ = internal::calculateMarginalFactors(graph, theta_, separatorKeys, parameters_.getEliminationFunction());
+  if(!cacheSummarization_) {
+    smootherSummarization_ = internal::calculateMarginalFactors(graph, theta_, separatorKeys, parameters_.getEliminationFunction());
+    return 0;
+  }
+
+  // Eliminate the cached linear factors in the smoother ordering, which has the separator last
+  gttic(summarize_cached);
+  linearizeWithCache(factors_, theta_, parameters_.relinearizeThreshold,
+      linearizationPoint_, linearFactors_, skippedLinearizations_);
+  GaussianFactorGraph linearGraph(linearFactors_);
+  BOOST_FOREACH(size_t slot, filterSummarizationSlots_) {
+    linearGraph.remove(slot);
+  }
+  VariableIndex variableIndex(linearGraph);
+  Ordering ordering;
+  BOOST_FOREACH(Key key, ordering_) {
+    if(!separatorKeys.exists(key) && variableIndex.find(key) != variableIndex.end())
+      ordering.push_back(key);
+  }
+  if(ordering.empty()) {
+    // There are no keys to marginalize
+    smootherSummarization_ = graph;
+    summarizedCliques_.clear();
+    return 0;
+  }
+  GaussianJunctionTree junctionTree(GaussianEliminationTree(linearGraph, variableIndex, ordering));
+
+  FastMap<Key, SummarizedClique> summarized;
+  size_t reused = 0;
+  GaussianFactorGraph marginals;
+  BOOST_FOREACH(const GaussianJunctionTree::sharedNode& root, junctionTree.roots()) {
+    marginals.push_back(summarizeClique(root, summarized, reused));
+  }
+  marginals.push_back(junctionTree.remainingFactors().begin(), junctionTree.remainingFactors().end());
+  summarizedCliques_.swap(summarized);
+
+  // Wrap in nonlinear container factors, at the linearization point of the cache
+  smootherSummarization_ = NonlinearFactorGraph();
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& marginal, marginals) {
+    if(marginal && !marginal->empty())
+      smootherSummarization_.push_back(boost::make_shared<LinearContainerFactor>(marginal, linearizationPoint_));
+  }
+  gttoc(summarize_cached);
+
+  return reused;
+}
+
+/* ************************************************************************* */
+GaussianFactor::shared_ptr ConcurrentBatchSmoother::summarizeClique(const GaussianJunctionTree::sharedNode& cluster,
+    FastMap<Key, SummarizedClique>& summarized, size_t& reused) const {
+
+  // Gather the factors of the clique and the marginals of its children
+  SummarizedClique clique;
+  clique.frontals = cluster->orderedFrontalKeys;
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, cluster->factors) {
+    if(factor)
+      clique.factors.push_back(factor);
+  }
+  BOOST_FOREACH(const GaussianJunctionTree::sharedNode& child, cluster->children) {
+    GaussianFactor::shared_ptr marginal = summarizeClique(child, summarized, reused);
+    if(marginal)
+      clique.factors.push_back(marginal);
+  }
+
+  // Reuse the previous marginal if nothing changed, otherwise eliminate
+  FastMap<Key, SummarizedClique>::const_iterator previous = summarizedCliques_.find(clique.frontals.front());
+  if(previous != summarizedCliques_.end() && previous->second.frontals == clique.frontals
+      && previous->second.factors == clique.factors) {
+    clique.marginal = previous->second.marginal;
+    ++reused;
+  } else {
+    GaussianFactorGraph factors;
+    factors.push_back(clique.factors.begin(), clique.factors.end());
+    clique.marginal = parameters_.getEliminationFunction()(factors, clique.frontals).second;
+  }
+
+  GaussianFactor::shared_ptr marginal = clique.marginal;
+  summarized[clique.frontals.front()] = clique;
+  return marginal;
 }
 
 /* ************************************************************************* */
@@ -21,10 +21,13 @@
 
 #include <gtsam_unstable/nonlinear/ConcurrentFilteringAndSmoothing.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/linear/GaussianJunctionTree.h>
 #include <queue>
 
 namespace gtsam {
 
+class GaussianEliminationPlan;
+
 /**
  * A Levenberg-Marquardt Batch Smoother that implements the Concurrent Filtering and Smoother interface.
  */
@@ -41,9 +44,10 @@ public:
     size_t nonlinearVariables; ///< The number of variables that can be relinearized
     size_t linearVariables; ///< The number of variables that must keep a constant linearization point
     double error; ///< The final factor graph error
+    size_t reusedCliques; ///< The number of cliques whose separator summarization was reused, see cacheSummarization
 
     /// Constructor
-    Result() : iterations(0), lambdas(0), nonlinearVariables(0), linearVariables(0), error(0) {};
+    Result() : iterations(0), lambdas(0), nonlinearVariables(0), linearVariables(0), error(0), reusedCliques(0) {};
 
     /// Getter methods
     size_t getIterations() const { return iterations; }
@@ -51,10 +55,22 @@ public:
     size_t getNonlinearVariables() const { return nonlinearVariables; }
     size_t getLinearVariables() const { return linearVariables; }
     double getError() const { return error; }
+    size_t getReusedCliques() const { return reusedCliques; }
   };
 
-  /** Default constructor */
-  ConcurrentBatchSmoother(const LevenbergMarquardtParams& parameters = LevenbergMarquardtParams()) : parameters_(parameters) {};
+  /**
+   * Default constructor.  The smoother linearizes through a cache of linear factors when
+   * LevenbergMarquardtParams::cacheLinearization is set, see NonlinearOptimizerParams.
+   * @param parameters The LM parameters
+   * @param cacheSummarization Keep the factorization of the smoother variables that computes the
+   * summarization on the separator between updates, and only redo the cliques whose factors
+   * changed.  The summarization is then computed from the cached linear factors, linearized at
+   * their own linearization points within LevenbergMarquardtParams::relinearizeThreshold of the
+   * current estimate, instead of relinearizing the whole smoother graph.
+   */
+  ConcurrentBatchSmoother(const LevenbergMarquardtParams& parameters = LevenbergMarquardtParams(),
+      bool cacheSummarization = false) :
+      parameters_(parameters), cacheSummarization_(cacheSummarization), skippedLinearizations_(0) {};
 
   /** Default destructor */
   virtual ~ConcurrentBatchSmoother() {};
@@ -169,6 +185,20 @@ protected:
 
 private:
 
+  /** A clique of the separator summarization, with the factors it eliminated and its marginal */
+  struct SummarizedClique {
+    Ordering frontals;
+    FastVector<GaussianFactor::shared_ptr> factors; ///< Its own factors, then the marginals of its children
+    GaussianFactor::shared_ptr marginal;
+  };
+
+  bool cacheSummarization_; ///< Whether to keep the summarization cliques between updates
+  Values linearizationPoint_; ///< The point at which each variable of the linear factor cache was linearized
+  GaussianFactorGraph linearFactors_; ///< The factors linearized at linearizationPoint_, by slot
+  size_t skippedLinearizations_; ///< Number of factor linearizations reused from the cache
+  boost::shared_ptr<GaussianEliminationPlan> eliminationPlan_; ///< Symbolic elimination of the damped system
+  FastMap<Key, SummarizedClique> summarizedCliques_; ///< The cliques of the last summarization, by first frontal key
+
   /** Augment the graph with new factors
    *
    * @param factors The factors to add to the graph
@@ -188,8 +218,17 @@ private:
   /** Use a modified version of L-M to update the linearization point and delta */
   Result optimize();
 
-  /** Calculate the smoother marginal factors on the separator variables */
-  void updateSmootherSummarization();
+  /** Linearize the smoother factors at theta_, through the linear factor cache if enabled */
+  GaussianFactorGraph::shared_ptr linearize();
+
+  /** Calculate the smoother marginal factors on the separator variables
+   * @return the number of cliques whose marginal was reused */
+  size_t updateSmootherSummarization();
+
+  /** Eliminate the frontal variables of a summarization clique and its subtree, reusing the
+   * previous marginals of cliques whose factors did not change */
+  GaussianFactor::shared_ptr summarizeClique(const GaussianJunctionTree::sharedNode& cluster,
+      FastMap<Key, SummarizedClique>& summarized, size_t& reused) const;
 
   /** Print just the nonlinear keys in a nonlinear factor */
   static void PrintNonlinearFactor(const NonlinearFactor::shared_ptr& factor,
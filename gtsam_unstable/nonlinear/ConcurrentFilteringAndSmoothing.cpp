@@ -53,11 +53,22 @@ namespace internal {
 /* ************************************************************************* */
 NonlinearFactorGraph calculateMarginalFactors(const NonlinearFactorGraph& graph, const Values& theta,
     const KeySet& remainingKeys, const GaussianFactorGraph::Eliminate& eliminateFunction) {
+  return calculateMarginalFactors(graph, GaussianFactorGraph(), theta, remainingKeys, eliminateFunction);
+}
+
+/* ************************************************************************* */
+NonlinearFactorGraph calculateMarginalFactors(const NonlinearFactorGraph& graph,
+    const GaussianFactorGraph& linearGraph, const Values& theta, const KeySet& remainingKeys,
+    const GaussianFactorGraph::Eliminate& eliminateFunction) {
 
 
   // Calculate the set of RootKeys = AllKeys \Intersect RemainingKeys
   KeySet rootKeys;
   KeySet allKeys(graph.keys());
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, linearGraph) {
+    if(factor)
+      allKeys.insert(factor->begin(), factor->end());
+  }
   std::set_intersection(allKeys.begin(), allKeys.end(), remainingKeys.begin(), remainingKeys.end(), std::inserter(rootKeys, rootKeys.end()));
 
   // Calculate the set of MarginalizeKeys = AllKeys - RemainingKeys
@@ -65,20 +76,26 @@ NonlinearFactorGraph calculateMarginalFactors(const NonlinearFactorGraph& graph,
   std::set_difference(allKeys.begin(), allKeys.end(), remainingKeys.begin(), remainingKeys.end(), std::inserter(marginalizeKeys, marginalizeKeys.end()));
 
   if(marginalizeKeys.size() == 0) {
-    // There are no keys to marginalize. Simply return the input factors
-    return graph;
+    // There are no keys to marginalize. Simply return the input factors, sharing the linear ones
+    NonlinearFactorGraph marginalFactors = graph;
+    BOOST_FOREACH(const GaussianFactor::shared_ptr& gaussianFactor, linearGraph) {
+      if(gaussianFactor)
+        marginalFactors += LinearContainerFactor::Share(gaussianFactor, theta);
+    }
+    return marginalFactors;
   } else {
     // Create the linear factor graph
     GaussianFactorGraph linearFactorGraph = *graph.linearize(theta);
+    linearFactorGraph.push_back(linearGraph);
     // .first is the eliminated Bayes tree, while .second is the remaining factor graph
     GaussianFactorGraph marginalLinearFactors = *linearFactorGraph.eliminatePartialMultifrontal(
         std::vector<Key>(marginalizeKeys.begin(), marginalizeKeys.end()), eliminateFunction).second;
 
-    // Wrap in nonlinear container factors
+    // Wrap in nonlinear container factors, which can own the new marginal factors without a copy
     NonlinearFactorGraph marginalFactors;
     marginalFactors.reserve(marginalLinearFactors.size());
     BOOST_FOREACH(const GaussianFactor::shared_ptr& gaussianFactor, marginalLinearFactors) {
-      marginalFactors += boost::make_shared<LinearContainerFactor>(gaussianFactor, theta);
+      marginalFactors += LinearContainerFactor::Share(gaussianFactor, theta);
     }
 
     return marginalFactors;
@@ -154,6 +154,13 @@ namespace internal {
   NonlinearFactorGraph calculateMarginalFactors(const NonlinearFactorGraph& graph, const Values& theta,
       const KeySet& remainingKeys, const GaussianFactorGraph::Eliminate& eliminateFunction);
 
+  /** Version of calculateMarginalFactors for a graph augmented with factors that are already linear
+   * at theta, such as cached Bayes tree factors.  These are used as they are, without copying them
+   * into LinearContainerFactors and linearizing those again.  */
+  NonlinearFactorGraph calculateMarginalFactors(const NonlinearFactorGraph& graph,
+      const GaussianFactorGraph& linearGraph, const Values& theta, const KeySet& remainingKeys,
+      const GaussianFactorGraph::Eliminate& eliminateFunction);
+
 }
 
 }/// namespace gtsam
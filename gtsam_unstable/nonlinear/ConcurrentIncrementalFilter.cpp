@@ -112,6 +112,7 @@ ConcurrentIncrementalFilter::Result ConcurrentIncrementalFilter::update(const No
   gttic(isam2);
   gtsam::ISAM2Result isam2Result = isam2_.update(newFactors, newTheta, removedFactors, orderingConstraints, noRelinKeys, additionalKeys);
   gttoc(isam2);
+  filterSummarizationValid_ = false;
 
   if(keysToMove && keysToMove->size() > 0) {
 
@@ -213,6 +214,7 @@ void ConcurrentIncrementalFilter::synchronize(const NonlinearFactorGraph& smooth
   FastVector<size_t> removeFactors(currentSmootherSummarizationSlots_.begin(), currentSmootherSummarizationSlots_.end());
   ISAM2Result result = isam2_.update(currentSmootherSummarization, Values(), removeFactors, boost::none, noRelinKeys, boost::none, false);
   currentSmootherSummarizationSlots_ = result.newFactorsIndices;
+  filterSummarizationValid_ = false;
 
   // Set the previous smoother summarization to the current smoother summarization and clear the smoother shortcut
   previousSmootherSummarization_ = currentSmootherSummarization;
@@ -228,8 +230,13 @@ void ConcurrentIncrementalFilter::getSummarizedFactors(NonlinearFactorGraph& fil
 
   gttic(get_summarized_factors);
 
-  // Calculate the current filter summarization
-  filterSummarization = calculateFilterSummarization();
+  // Calculate the current filter summarization, unless iSAM2 did not change since the last one.
+  // The summarization factors are shared, they are never modified once created.
+  if(!filterSummarizationValid_) {
+    filterSummarization_ = calculateFilterSummarization();
+    filterSummarizationValid_ = true;
+  }
+  filterSummarization = filterSummarization_;
 
   // Copy the current separator values into the output
   BOOST_FOREACH(Key key, isam2_.getFixedVariables()) {
@@ -397,15 +404,17 @@ NonlinearFactorGraph ConcurrentIncrementalFilter::calculateFilterSummarization()
     childCliques.erase(clique);
   }
 
-  // Augment the factor graph with cached factors from the children
+  // Collect the cached factors from the children, the marginals of their subtrees. These are
+  // already linear at the linearization point and never modified, so they are used directly
+  // instead of being copied into LinearContainerFactors and linearized again.
+  GaussianFactorGraph childFactors;
   BOOST_FOREACH(const ISAM2Clique::shared_ptr& clique, childCliques) {
-    LinearContainerFactor::shared_ptr factor(new LinearContainerFactor(clique->cachedFactor(), isam2_.getLinearizationPoint()));
-    graph.push_back( factor );
+    childFactors.push_back(clique->cachedFactor());
   }
 
   // Calculate the marginal factors on the separator
-  NonlinearFactorGraph filterSummarization = internal::calculateMarginalFactors(graph, isam2_.getLinearizationPoint(), separatorKeys,
-      isam2_.params().getEliminationFunction());
+  NonlinearFactorGraph filterSummarization = internal::calculateMarginalFactors(graph, childFactors,
+      isam2_.getLinearizationPoint(), separatorKeys, isam2_.params().getEliminationFunction());
 
   return filterSummarization;
 }
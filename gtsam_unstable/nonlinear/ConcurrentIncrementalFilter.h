@@ -61,7 +61,7 @@ public:
   };
 
   /** Default constructor */
-  ConcurrentIncrementalFilter(const ISAM2Params& parameters = ISAM2Params()) : isam2_(parameters) {};
+  ConcurrentIncrementalFilter(const ISAM2Params& parameters = ISAM2Params()) : isam2_(parameters), filterSummarizationValid_(false) {};
 
   /** Default destructor */
   virtual ~ConcurrentIncrementalFilter() {};
@@ -177,6 +177,10 @@ protected:
   NonlinearFactorGraph smootherFactors_;  ///< A temporary holding place for the set of full nonlinear factors being sent to the smoother
   Values smootherValues_; ///< A temporary holding place for the linearization points of all keys being sent to the smoother
 
+  // The filter summarization, kept until iSAM2 changes so that repeated requests share the same factors
+  NonlinearFactorGraph filterSummarization_; ///< The last calculated filter summarization on the current separator
+  bool filterSummarizationValid_; ///< Whether filterSummarization_ is up to date with iSAM2
+
 private:
 
   /** Traverse the iSAM2 Bayes Tree, inserting all descendants of the provided index/key into 'additionalKeys' */
@@ -0,0 +1,153 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ConcurrentSmootherThread.h
+ * @brief   Runs the smoother of the Concurrent Filtering and Smoothing architecture on its
+ *          own thread, synchronized with the filter without blocking it
+ * @date    Oct 15, 2026
+ */
+
+// \callgraph
+#pragma once
+
+#include <gtsam_unstable/nonlinear/ConcurrentFilteringAndSmoothing.h>
+
+#include <boost/exception_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace gtsam {
+
+/**
+ * Owns a worker thread that calls SMOOTHER::update() after every synchronization, so that the
+ * thread running the filter only has to call synchronize() after its own updates.
+ *
+ * synchronize() never waits for the smoother: while the smoother is updating it returns false
+ * immediately, and the filter keeps accumulating the factors it sends to the smoother, as well
+ * as using the last smoother summarization it received, until the next successful call.  When
+ * the smoother is idle the data exchange of gtsam::synchronize is done right away, which only
+ * copies summarized factors, and the worker is woken up to update the smoother.
+ *
+ * The filter must only be used from the thread calling synchronize.  The smoother must not be
+ * used directly while the worker may be updating it, i.e., call waitUntilIdle first.
+ * SMOOTHER is a ConcurrentSmoother with an update() method taking default arguments, such as
+ * ConcurrentBatchSmoother and ConcurrentIncrementalSmoother.
+ */
+template<class SMOOTHER>
+class ConcurrentSmootherThread : boost::noncopyable {
+public:
+
+  /** Start the worker thread for the given filter and smoother, which must outlive this */
+  ConcurrentSmootherThread(ConcurrentFilter& filter, SMOOTHER& smoother) :
+      filter_(filter), smoother_(smoother), pending_(false), busy_(false), stop_(false),
+      nrUpdates_(0) {
+    thread_ = boost::thread(&ConcurrentSmootherThread::run, this);
+  }
+
+  /** Stop the worker thread, after it finishes a smoother update it is doing or was asked to do */
+  ~ConcurrentSmootherThread() {
+    {
+      boost::lock_guard<boost::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+  }
+
+  /**
+   * Synchronize filter and smoother if the smoother is idle, and start a smoother update.
+   * Never blocks on the smoother.  Rethrows an exception thrown by the last smoother update.
+   * @return true if synchronized, false if the smoother is still busy
+   */
+  bool synchronize() {
+    boost::unique_lock<boost::mutex> lock(mutex_, boost::try_to_lock);
+    if (!lock.owns_lock() || busy_ || pending_) return false;
+    rethrow();
+    gtsam::synchronize(filter_, smoother_);
+    pending_ = true;
+    wake_.notify_all();
+    return true;
+  }
+
+  /** Block until the smoother has finished all requested updates */
+  void waitUntilIdle() {
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    while (busy_ || pending_)
+      idle_.wait(lock);
+    rethrow();
+  }
+
+  /** Whether the smoother is neither updating nor about to */
+  bool isIdle() const {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    return !busy_ && !pending_;
+  }
+
+  /** Number of smoother updates finished so far */
+  size_t nrUpdates() const {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    return nrUpdates_;
+  }
+
+private:
+
+  ConcurrentFilter& filter_;
+  SMOOTHER& smoother_;
+
+  mutable boost::mutex mutex_; ///< Guards the flags below, and the smoother while not busy_
+  boost::condition_variable wake_; ///< Signals the worker that pending_ or stop_ was set
+  boost::condition_variable idle_; ///< Signals waitUntilIdle that busy_ was cleared
+  bool pending_; ///< A synchronization happened and the smoother has to be updated
+  bool busy_; ///< The worker is updating the smoother, without holding the mutex
+  bool stop_; ///< The worker should exit once there is nothing pending
+  size_t nrUpdates_;
+  boost::exception_ptr error_; ///< Exception thrown by the last smoother update
+  boost::thread thread_;
+
+  /** Worker thread: update the smoother whenever synchronize asks for it */
+  void run() {
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    while (true) {
+      while (!pending_ && !stop_)
+        wake_.wait(lock);
+      if (!pending_) break;
+      pending_ = false;
+      busy_ = true;
+      lock.unlock();
+      try {
+        smoother_.update();
+      } catch (...) {
+        lock.lock();
+        error_ = boost::current_exception();
+        lock.unlock();
+      }
+      lock.lock();
+      busy_ = false;
+      ++nrUpdates_;
+      idle_.notify_all();
+    }
+  }
+
+  /** Rethrow an exception from the worker, with the mutex held */
+  void rethrow() {
+    if (error_) {
+      boost::exception_ptr error = error_;
+      error_ = boost::exception_ptr();
+      boost::rethrow_exception(error);
+    }
+  }
+};
+
+} /// namespace gtsam
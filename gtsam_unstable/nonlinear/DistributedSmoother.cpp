@@ -0,0 +1,295 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DistributedSmoother.cpp
+ * @brief   Gauss-Newton over a partitioned graph, with each partition eliminated by its own
+ *          worker into a factor on the separator, e.g., one worker per robot of a team
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam_unstable/nonlinear/DistributedSmoother.h>
+#include <gtsam/nonlinear/NonlinearOptimizer.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/serialization.h>
+
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+string DistributedMessage::serialize() const {
+  return serializeBinary(*this);
+}
+
+/* ************************************************************************* */
+DistributedMessage DistributedMessage::Deserialize(const string& serialized) {
+  DistributedMessage message;
+  deserializeBinary(serialized, message);
+  return message;
+}
+
+/* ************************************************************************* */
+namespace {
+  // Solve the frontal variables of a clique and its subtree, given the solution of its separator
+  void backSubstitute(const GaussianBayesTree::sharedClique& clique, VectorValues& solution) {
+    solution.insert(clique->conditional()->solve(solution));
+    BOOST_FOREACH(const GaussianBayesTree::sharedClique& child, clique->children)
+      backSubstitute(child, solution);
+  }
+}
+
+/* ************************************************************************* */
+string DistributedSmootherWorker::handle(const string& request) {
+  return handle(DistributedMessage::Deserialize(request)).serialize();
+}
+
+/* ************************************************************************* */
+DistributedMessage DistributedSmootherWorker::handle(const DistributedMessage& request) {
+  DistributedMessage reply;
+  switch(request.type) {
+
+  case DistributedMessage::SETUP:
+    factors_ = request.factors;
+    values_ = request.values;
+    interior_ = request.keys;
+    bayesTree_.reset();
+    break;
+
+  case DistributedMessage::LINEARIZE: {
+    GaussianFactorGraph::shared_ptr separatorGraph = factors_.linearize(values_);
+    reply.error = factors_.error(values_);
+    if(!interior_.empty())
+      boost::tie(bayesTree_, separatorGraph) = separatorGraph->eliminatePartialMultifrontal(interior_);
+    if(!separatorGraph->empty())
+      reply.separatorFactors.push_back(HessianFactor(*separatorGraph));
+    break;
+  }
+
+  case DistributedMessage::UPDATE: {
+    VectorValues delta = request.delta;
+    if(bayesTree_) {
+      BOOST_FOREACH(const GaussianBayesTree::sharedClique& root, bayesTree_->roots())
+        backSubstitute(root, delta);
+      bayesTree_.reset();
+    }
+    values_.retractInPlace(delta);
+    break;
+  }
+
+  case DistributedMessage::ESTIMATE:
+    BOOST_FOREACH(Key key, interior_)
+      reply.values.insert(key, values_.at(key));
+    break;
+
+  default:
+    throw invalid_argument("DistributedSmootherWorker: unknown request");
+  }
+  return reply;
+}
+
+/* ************************************************************************* */
+ThreadedDistributedTransport::ThreadedDistributedTransport(size_t nrWorkers) :
+    workers_(nrWorkers), replies_(nrWorkers), errors_(nrWorkers), threads_(nrWorkers) {
+}
+
+/* ************************************************************************* */
+ThreadedDistributedTransport::~ThreadedDistributedTransport() {
+  BOOST_FOREACH(const boost::shared_ptr<boost::thread>& thread, threads_)
+    if(thread) thread->join();
+}
+
+/* ************************************************************************* */
+void ThreadedDistributedTransport::send(size_t worker, const string& request) {
+  if(threads_[worker])
+    throw runtime_error("ThreadedDistributedTransport: the previous reply was not received");
+  threads_[worker] = boost::make_shared<boost::thread>(
+      boost::bind(&ThreadedDistributedTransport::run, this, worker, request));
+}
+
+/* ************************************************************************* */
+string ThreadedDistributedTransport::receive(size_t worker) {
+  if(!threads_[worker])
+    throw runtime_error("ThreadedDistributedTransport: no request was sent");
+  threads_[worker]->join();
+  threads_[worker].reset();
+  if(errors_[worker]) {
+    boost::exception_ptr error = errors_[worker];
+    errors_[worker] = boost::exception_ptr();
+    boost::rethrow_exception(error);
+  }
+  string reply;
+  reply.swap(replies_[worker]);
+  return reply;
+}
+
+/* ************************************************************************* */
+void ThreadedDistributedTransport::run(size_t worker, const string& request) {
+  try {
+    replies_[worker] = workers_[worker].handle(request);
+  } catch(...) {
+    errors_[worker] = boost::current_exception();
+  }
+}
+
+/* ************************************************************************* */
+DistributedSmoother::DistributedSmoother(const NonlinearFactorGraph& graph, const Values& initial,
+    const vector<KeySet>& partitions, const DistributedTransport::shared_ptr& transport,
+    const GaussNewtonParams& params) :
+    transport_(transport), params_(params), values_(initial) {
+
+  if(transport_->size() != partitions.size())
+    throw invalid_argument("DistributedSmoother: the transport needs one worker per partition");
+
+  FastMap<Key, size_t> partitionOf;
+  for(size_t p = 0; p < partitions.size(); ++p) {
+    BOOST_FOREACH(Key key, partitions[p]) {
+      if(!partitionOf.insert(make_pair(key, p)).second)
+        throw invalid_argument("DistributedSmoother: a key is in more than one partition");
+    }
+  }
+
+  // A factor goes to a worker if all its keys are in that partition
+  vector<NonlinearFactorGraph> workerFactors(partitions.size());
+  BOOST_FOREACH(const NonlinearFactor::shared_ptr& factor, graph) {
+    if(!factor)
+      continue;
+    bool local = !factor->keys().empty();
+    size_t partition = 0;
+    BOOST_FOREACH(Key key, factor->keys()) {
+      FastMap<Key, size_t>::const_iterator it = partitionOf.find(key);
+      if(it == partitionOf.end() || (key != factor->front() && it->second != partition)) {
+        local = false;
+        break;
+      }
+      partition = it->second;
+    }
+    if(local)
+      workerFactors[partition].push_back(factor);
+    else
+      separatorFactors_.push_back(factor);
+  }
+  separatorKeys_ = separatorFactors_.keys();
+
+  // Each worker eliminates its keys that are not on the separator, in COLAMD order
+  workerSeparatorKeys_.resize(partitions.size());
+  for(size_t p = 0; p < partitions.size(); ++p) {
+    DistributedMessage setup(DistributedMessage::SETUP);
+    setup.factors = workerFactors[p];
+    KeySet keys = workerFactors[p].keys();
+    vector<Key> separator;
+    BOOST_FOREACH(Key key, keys) {
+      setup.values.insert(key, initial.at(key));
+      if(separatorKeys_.exists(key))
+        separator.push_back(key);
+    }
+    if(separator.size() < keys.size()) {
+      Ordering ordering = Ordering::ColamdConstrainedLast(workerFactors[p], separator);
+      setup.keys.assign(ordering.begin(), ordering.begin() + (keys.size() - separator.size()));
+    }
+    workerSeparatorKeys_[p].insert(separator.begin(), separator.end());
+    transport_->send(p, setup.serialize());
+  }
+  for(size_t p = 0; p < partitions.size(); ++p)
+    transport_->receive(p);
+}
+
+/* ************************************************************************* */
+GaussianFactorGraph DistributedSmoother::linearize(double& error) const {
+  for(size_t p = 0; p < transport_->size(); ++p)
+    transport_->send(p, DistributedMessage(DistributedMessage::LINEARIZE).serialize());
+
+  // Linearize the factors between partitions while the workers eliminate
+  GaussianFactorGraph separatorGraph = *separatorFactors_.linearize(values_);
+  error = separatorFactors_.error(values_);
+
+  for(size_t p = 0; p < transport_->size(); ++p) {
+    DistributedMessage reply = DistributedMessage::Deserialize(transport_->receive(p));
+    error += reply.error;
+    BOOST_FOREACH(const HessianFactor& factor, reply.separatorFactors)
+      separatorGraph.push_back(boost::make_shared<HessianFactor>(factor));
+  }
+  return separatorGraph;
+}
+
+/* ************************************************************************* */
+DistributedSmoother::Result DistributedSmoother::optimize() {
+  Result result;
+  result.separatorVariables = separatorKeys_.size();
+
+  double error;
+  GaussianFactorGraph separatorGraph = linearize(error);
+  if(params_.verbosity >= NonlinearOptimizerParams::ERROR)
+    cout << "Initial error: " << error << endl;
+
+  while(result.iterations < params_.maxIterations) {
+
+    // Solve the separator, and let the workers back-substitute into their interior
+    VectorValues delta;
+    if(!separatorGraph.empty())
+      delta = separatorGraph.optimize(boost::none, params_.getEliminationFunction());
+    for(size_t p = 0; p < transport_->size(); ++p) {
+      DistributedMessage update(DistributedMessage::UPDATE);
+      BOOST_FOREACH(Key key, workerSeparatorKeys_[p])
+        update.delta.insert(key, delta.at(key));
+      transport_->send(p, update.serialize());
+    }
+    values_.retractInPlace(delta);
+    for(size_t p = 0; p < transport_->size(); ++p)
+      transport_->receive(p);
+    ++result.iterations;
+
+    double newError;
+    separatorGraph = linearize(newError);
+    if(params_.verbosity >= NonlinearOptimizerParams::ERROR)
+      cout << "newError: " << newError << endl;
+
+    bool converged = checkConvergence(params_.relativeErrorTol, params_.absoluteErrorTol,
+        params_.errorTol, error, newError, params_.verbosity);
+    error = newError;
+    if(converged)
+      break;
+  }
+
+  result.error = error;
+  return result;
+}
+
+/* ************************************************************************* */
+Values DistributedSmoother::calculateEstimate() const {
+  for(size_t p = 0; p < transport_->size(); ++p)
+    transport_->send(p, DistributedMessage(DistributedMessage::ESTIMATE).serialize());
+  Values estimate = values_;
+  for(size_t p = 0; p < transport_->size(); ++p)
+    estimate.update(DistributedMessage::Deserialize(transport_->receive(p)).values);
+  return estimate;
+}
+
+/* ************************************************************************* */
+vector<KeySet> DistributedSmoother::PartitionBySymbol(const Values& values) {
+  FastMap<unsigned char, KeySet> byChr;
+  BOOST_FOREACH(Key key, values.keys())
+    byChr[Symbol(key).chr()].insert(key);
+  vector<KeySet> partitions;
+  typedef pair<const unsigned char, KeySet> ChrKeys;
+  BOOST_FOREACH(const ChrKeys& chr_keys, byChr)
+    partitions.push_back(chr_keys.second);
+  return partitions;
+}
+
+} /// namespace gtsam
@@ -0,0 +1,222 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DistributedSmoother.h
+ * @brief   Gauss-Newton over a partitioned graph, with each partition eliminated by its own
+ *          worker into a factor on the separator, e.g., one worker per robot of a team
+ * @date    Oct 15, 2026
+ */
+
+// \callgraph
+#pragma once
+
+#include <gtsam_unstable/base/dllexport.h>
+#include <gtsam/nonlinear/GaussNewtonOptimizer.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Ordering.h>
+
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <string>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * A request from the DistributedSmoother to one of its workers, or the reply to it.  Messages
+ * travel as strings made with serializeBinary, so that any transport can carry them.  As with
+ * gtsam_unstable/slam/serialization.cpp, the factor and value types in the graph have to be
+ * registered with BOOST_CLASS_EXPORT_GUID and GTSAM_VALUE_EXPORT, on both ends.
+ */
+struct GTSAM_UNSTABLE_EXPORT DistributedMessage {
+
+  enum Type {
+    SETUP,     ///< Coordinator sends the factors, their initial values and the interior keys
+    LINEARIZE, ///< Worker linearizes and eliminates its interior, and replies with the separator factor
+    UPDATE,    ///< Coordinator sends the separator delta, worker back-substitutes and retracts
+    ESTIMATE,  ///< Worker replies with the values of its interior keys
+    REPLY      ///< A reply from the worker
+  };
+
+  int type;
+  NonlinearFactorGraph factors;  ///< SETUP: the factors of the partition
+  Values values;                 ///< SETUP: initial values, ESTIMATE reply: current interior values
+  Ordering keys;                 ///< SETUP: the keys to eliminate locally
+  std::vector<HessianFactor> separatorFactors; ///< LINEARIZE reply: the marginal on the separator, if any
+  VectorValues delta;            ///< UPDATE: the separator delta
+  double error;                  ///< LINEARIZE reply: the error of the partition factors
+
+  DistributedMessage(int type = REPLY) : type(type), error(0.0) {}
+
+  /** Serialize with serializeBinary */
+  std::string serialize() const;
+
+  /** Deserialize a string made by serialize */
+  static DistributedMessage Deserialize(const std::string& serialized);
+
+private:
+  friend class boost::serialization::access;
+  template<class ARCHIVE>
+  void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+    ar & BOOST_SERIALIZATION_NVP(type);
+    ar & BOOST_SERIALIZATION_NVP(factors);
+    ar & BOOST_SERIALIZATION_NVP(values);
+    ar & BOOST_SERIALIZATION_NVP(keys);
+    ar & BOOST_SERIALIZATION_NVP(separatorFactors);
+    ar & BOOST_SERIALIZATION_NVP(delta);
+    ar & BOOST_SERIALIZATION_NVP(error);
+  }
+};
+
+/**
+ * The state of one partition of a DistributedSmoother, living wherever the transport delivers
+ * its messages: a thread, a process, or another robot.  Between LINEARIZE and UPDATE it keeps the
+ * Bayes tree of its interior keys, so that only the separator factor and the separator delta
+ * cross the transport.
+ */
+class GTSAM_UNSTABLE_EXPORT DistributedSmootherWorker {
+public:
+
+  typedef boost::shared_ptr<DistributedSmootherWorker> shared_ptr;
+
+  /** Handle a serialized request and return the serialized reply */
+  std::string handle(const std::string& request);
+
+  /** Handle a request */
+  DistributedMessage handle(const DistributedMessage& request);
+
+private:
+  NonlinearFactorGraph factors_;
+  Values values_;
+  Ordering interior_;
+  GaussianBayesTree::shared_ptr bayesTree_; ///< The elimination of the interior at values_
+};
+
+/**
+ * Carries the messages between a DistributedSmoother and its workers.  send() has to return
+ * without waiting for the worker, so that all workers run at the same time, and receive() blocks
+ * until the reply to the last request to that worker has arrived.
+ */
+class GTSAM_UNSTABLE_EXPORT DistributedTransport {
+public:
+
+  typedef boost::shared_ptr<DistributedTransport> shared_ptr;
+
+  virtual ~DistributedTransport() {}
+
+  /** The number of workers */
+  virtual size_t size() const = 0;
+
+  /** Start a request on a worker */
+  virtual void send(size_t worker, const std::string& request) = 0;
+
+  /** Wait for the reply to the last request sent to a worker */
+  virtual std::string receive(size_t worker) = 0;
+};
+
+/**
+ * A transport to workers owned by the transport itself, each request running on its own thread.
+ * Messages are still serialized, so this also exercises what a networked transport would do.
+ */
+class GTSAM_UNSTABLE_EXPORT ThreadedDistributedTransport : public DistributedTransport {
+public:
+
+  /** Create nrWorkers workers */
+  explicit ThreadedDistributedTransport(size_t nrWorkers);
+
+  /** Wait for requests still running */
+  virtual ~ThreadedDistributedTransport();
+
+  virtual size_t size() const { return workers_.size(); }
+  virtual void send(size_t worker, const std::string& request);
+  virtual std::string receive(size_t worker);
+
+private:
+  std::vector<DistributedSmootherWorker> workers_;
+  std::vector<std::string> replies_;
+  std::vector<boost::exception_ptr> errors_;
+  std::vector<boost::shared_ptr<boost::thread> > threads_;
+
+  void run(size_t worker, const std::string& request);
+};
+
+/**
+ * Gauss-Newton on a graph split into partitions, for instance the poses of each robot of a team.
+ * A factor whose keys are all in one partition is sent to the worker of that partition, and all
+ * other factors stay with the coordinator.  The keys of the coordinator factors form the
+ * separator.  Every iteration, each worker linearizes its factors and eliminates its interior
+ * keys into one factor on its separator keys, the coordinator solves the separator system, and
+ * the workers back-substitute the separator delta into their interior.  This is the same solution
+ * as eliminating with the separator last, so it converges like GaussNewtonOptimizer.
+ *
+ * The partitions can come from anything that splits the keys, e.g. PartitionBySymbol for robots
+ * that label their keys with a Symbol character, or gtsam_unstable/partition when built with METIS.
+ */
+class GTSAM_UNSTABLE_EXPORT DistributedSmoother {
+public:
+
+  struct Result {
+    size_t iterations; ///< The number of Gauss-Newton iterations performed
+    size_t separatorVariables; ///< The number of variables solved by the coordinator
+    double error; ///< The final factor graph error
+
+    Result() : iterations(0), separatorVariables(0), error(0) {}
+
+    size_t getIterations() const { return iterations; }
+    size_t getSeparatorVariables() const { return separatorVariables; }
+    double getError() const { return error; }
+  };
+
+  /**
+   * Split the graph and send every worker its partition
+   * @param graph The factors to optimize
+   * @param initial Initial values for all keys of the graph
+   * @param partitions Disjoint sets of keys, one per worker of the transport
+   * @param transport The connection to the workers
+   * @param params Convergence criteria and linear solver for the separator system
+   */
+  DistributedSmoother(const NonlinearFactorGraph& graph, const Values& initial,
+      const std::vector<KeySet>& partitions, const DistributedTransport::shared_ptr& transport,
+      const GaussNewtonParams& params = GaussNewtonParams());
+
+  /** Iterate until convergence, or params.maxIterations */
+  Result optimize();
+
+  /** Collect the current estimate from the workers */
+  Values calculateEstimate() const;
+
+  /** The factors solved by the coordinator */
+  const NonlinearFactorGraph& separatorFactors() const { return separatorFactors_; }
+
+  /** Group keys into partitions by their Symbol character, in increasing order of the character */
+  static std::vector<KeySet> PartitionBySymbol(const Values& values);
+
+private:
+  DistributedTransport::shared_ptr transport_;
+  GaussNewtonParams params_;
+  NonlinearFactorGraph separatorFactors_; ///< The factors that span partitions
+  Values values_; ///< The initial values, with the separator keys kept up to date
+  KeySet separatorKeys_;
+  std::vector<KeySet> workerSeparatorKeys_; ///< The separator keys each worker shares
+
+  /** Linearize and eliminate on all workers, return the separator system and the total error */
+  GaussianFactorGraph linearize(double& error) const;
+};
+
+} /// namespace gtsam
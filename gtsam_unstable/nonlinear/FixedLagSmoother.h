@@ -21,6 +21,7 @@
 #pragma once
 
 #include <gtsam_unstable/base/dllexport.h>
+#include <gtsam_unstable/nonlinear/KeyTimestampIndex.h>
 #include <gtsam/inference/Key.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/Values.h>
@@ -49,7 +50,10 @@ public:
     size_t nonlinearVariables; ///< The number of variables that can be relinearized
     size_t linearVariables; ///< The number of variables that must keep a constant linearization point
     double error; ///< The final factor graph error
-    Result() : iterations(0), intermediateSteps(0), nonlinearVariables(0), linearVariables(0), error(0) {};
+    size_t marginalizedVariables; ///< The number of variables marginalized out by this update
+    double marginalizationTime; ///< The wall time in seconds spent marginalizing them
+    Result() : iterations(0), intermediateSteps(0), nonlinearVariables(0), linearVariables(0), error(0),
+        marginalizedVariables(0), marginalizationTime(0.0) {};
 
     /// Getter methods
     size_t getIterations() const { return iterations; }
@@ -57,6 +61,8 @@ public:
     size_t getNonlinearVariables() const { return nonlinearVariables; }
     size_t getLinearVariables() const { return linearVariables; }
     double getError() const { return error; }
+    size_t getMarginalizedVariables() const { return marginalizedVariables; }
+    double getMarginalizationTime() const { return marginalizationTime; }
   };
 
 
@@ -82,9 +88,14 @@ public:
     return smootherLag_;
   }
 
-  /** Access the current set of timestamps associated with each variable */
-  const KeyTimestampMap& timestamps() const {
-    return keyTimestampMap_;
+  /** The current set of timestamps associated with each variable */
+  KeyTimestampMap timestamps() const {
+    return timestampIndex_.timestamps();
+  }
+
+  /** Access the index of the variables by timestamp */
+  const KeyTimestampIndex& timestampIndex() const {
+    return timestampIndex_;
   }
 
   /** Add new factors, updating the solution and relinearizing as needed. */
@@ -103,9 +114,8 @@ protected:
   /** The length of the smoother lag. Any variable older than this amount will be marginalized out. */
   double smootherLag_;
 
-  /** The current timestamp associated with each tracked key */
-  TimestampKeyMap timestampKeyMap_;
-  KeyTimestampMap keyTimestampMap_;
+  /** The current timestamp associated with each tracked key, in a ring buffer ordered by time */
+  KeyTimestampIndex timestampIndex_;
 
   /** Update the Timestamps associated with the keys */
   void updateKeyTimestampMap(const KeyTimestampMap& newTimestamps);
@@ -22,6 +22,8 @@
 #include <gtsam_unstable/nonlinear/IncrementalFixedLagSmoother.h>
 #include <gtsam/base/debug.h>
 
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
 namespace gtsam {
 
 /* ************************************************************************* */
@@ -46,6 +48,34 @@ void recursiveMarkAffectedKeys(const Key& key,
   // If the key was not found in the separator/parents, then none of its children can have it either
 }
 
+/* ************************************************************************* */
+bool onlyMarginalizableKeysBelow(const ISAM2Clique::shared_ptr& clique,
+    const std::set<Key>& marginalizableKeys,
+    std::map<ISAM2Clique*, bool>& visited) {
+
+  std::map<ISAM2Clique*, bool>::const_iterator known = visited.find(clique.get());
+  if (known != visited.end())
+    return known->second;
+
+  bool result = true;
+  BOOST_FOREACH(Key i, clique->conditional()->frontals()) {
+    if (marginalizableKeys.find(i) == marginalizableKeys.end()) {
+      result = false;
+      break;
+    }
+  }
+  if (result) {
+    BOOST_FOREACH(const ISAM2Clique::shared_ptr& child, clique->children) {
+      if (!onlyMarginalizableKeysBelow(child, marginalizableKeys, visited)) {
+        result = false;
+        break;
+      }
+    }
+  }
+  visited[clique.get()] = result;
+  return result;
+}
+
 /* ************************************************************************* */
 void IncrementalFixedLagSmoother::print(const std::string& s,
     const KeyFormatter& keyFormatter) const {
@@ -114,10 +144,16 @@ FixedLagSmoother::Result IncrementalFixedLagSmoother::update(
     std::cout << std::endl;
   }
 
-  // Mark additional keys between the marginalized keys and the leaves
+  // Mark additional keys between the marginalized keys and the leaves. A key whose clique and
+  // subtree only contain marginalizable keys is a leaf already, as it is for the oldest keys of a
+  // trajectory, and its whole subtree is marginalized as is.  Marking it would re-eliminate the
+  // path from it to the root.
   std::set<gtsam::Key> additionalKeys;
+  std::map<ISAM2Clique*, bool> leafSubtrees;
   BOOST_FOREACH(gtsam::Key key, marginalizableKeys) {
     gtsam::ISAM2Clique::shared_ptr clique = isam_[key];
+    if (onlyMarginalizableKeysBelow(clique, marginalizableKeys, leafSubtrees))
+      continue;
     BOOST_FOREACH(const gtsam::ISAM2Clique::shared_ptr& child, clique->children) {
       recursiveMarkAffectedKeys(key, child, additionalKeys);
     }
@@ -125,7 +161,7 @@ FixedLagSmoother::Result IncrementalFixedLagSmoother::update(
   KeyList additionalMarkedKeys(additionalKeys.begin(), additionalKeys.end());
 
   // Update iSAM2
-  ISAM2Result isamResult = isam_.update(newFactors, newTheta,
+  isamResult_ = isam_.update(newFactors, newTheta,
       FastVector<size_t>(), constrainedKeys, boost::none, additionalMarkedKeys);
 
   if (debug) {
@@ -135,10 +171,15 @@ FixedLagSmoother::Result IncrementalFixedLagSmoother::update(
   }
 
   // Marginalize out any needed variables
+  Result result;
   if (marginalizableKeys.size() > 0) {
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
     FastList<Key> leafKeys(marginalizableKeys.begin(),
         marginalizableKeys.end());
     isam_.marginalizeLeaves(leafKeys);
+    result.marginalizedVariables = marginalizableKeys.size();
+    result.marginalizationTime = 1e-6 * (boost::posix_time::microsec_clock::universal_time()
+        - start).total_microseconds();
   }
 
   // Remove marginalized keys from the KeyTimestampMap
@@ -150,7 +191,6 @@ FixedLagSmoother::Result IncrementalFixedLagSmoother::update(
   }
 
   // TODO: Fill in result structure
-  Result result;
   result.iterations = 1;
   result.linearVariables = 0;
   result.nonlinearVariables = 0;
@@ -164,12 +204,7 @@ FixedLagSmoother::Result IncrementalFixedLagSmoother::update(
 
 /* ************************************************************************* */
 void IncrementalFixedLagSmoother::eraseKeysBefore(double timestamp) {
-  TimestampKeyMap::iterator end = timestampKeyMap_.lower_bound(timestamp);
-  TimestampKeyMap::iterator iter = timestampKeyMap_.begin();
-  while (iter != end) {
-    keyTimestampMap_.erase(iter->second);
-    timestampKeyMap_.erase(iter++);
-  }
+  timestampIndex_.eraseBefore(timestamp);
 }
 
 /* ************************************************************************* */
@@ -180,8 +215,8 @@ void IncrementalFixedLagSmoother::createOrderingConstraints(
     constrainedKeys = FastMap<Key, int>();
     // Generate ordering constraints so that the marginalizable variables will be eliminated first
     // Set all variables to Group1
-    BOOST_FOREACH(const TimestampKeyMap::value_type& timestamp_key, timestampKeyMap_) {
-      constrainedKeys->operator[](timestamp_key.second) = 1;
+    BOOST_FOREACH(Key key, timestampIndex_.keys()) {
+      constrainedKeys->operator[](key) = 1;
     }
     // Set marginalizable variables to Group0
     BOOST_FOREACH(Key key, marginalizableKeys) {
@@ -108,11 +108,19 @@ public:
     return isam_.marginalCovariance(key);
   }
 
+  /// Get results of the latest iSAM2 update, including its metrics
+  const ISAM2Result& getISAM2Result() const {
+    return isamResult_;
+  }
+
 protected:
   /** An iSAM2 object used to perform inference. The smoother lag is controlled
    * by what factors are removed each iteration */
   ISAM2 isam_;
 
+  /** Store results of the latest iSAM2 update */
+  ISAM2Result isamResult_;
+
   /** Erase any keys associated with timestamps before the provided time */
   void eraseKeysBefore(double timestamp);
 
@@ -0,0 +1,230 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    KeyTimestampIndex.cpp
+ * @brief   Ring-buffer index of the keys of a fixed-lag smoother, ordered by timestamp
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam_unstable/nonlinear/KeyTimestampIndex.h>
+
+#include <boost/foreach.hpp>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+KeyTimestampIndex::KeyTimestampIndex() :
+    head_(0), count_(0), stale_(0), nextSequence_(0) {
+}
+
+/* ************************************************************************* */
+void KeyTimestampIndex::print(const std::string& s, const KeyFormatter& keyFormatter) const {
+  std::cout << s;
+  for (size_t i = 0; i < count_; ++i) {
+    const Entry& e = entry(i);
+    if (live(e))
+      std::cout << "  " << keyFormatter(e.key) << ": " << e.timestamp << std::endl;
+  }
+}
+
+/* ************************************************************************* */
+bool KeyTimestampIndex::equals(const KeyTimestampIndex& other, double tol) const {
+  if (size() != other.size())
+    return false;
+  typedef boost::unordered_map<Key, Slot>::value_type KeySlot;
+  BOOST_FOREACH(const KeySlot& key_slot, slots_) {
+    boost::unordered_map<Key, Slot>::const_iterator it = other.slots_.find(key_slot.first);
+    if (it == other.slots_.end()
+        || std::fabs(it->second.timestamp - key_slot.second.timestamp) > tol)
+      return false;
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+double KeyTimestampIndex::at(Key key) const {
+  boost::unordered_map<Key, Slot>::const_iterator it = slots_.find(key);
+  if (it == slots_.end())
+    throw std::out_of_range("KeyTimestampIndex::at: key has no timestamp");
+  return it->second.timestamp;
+}
+
+/* ************************************************************************* */
+bool KeyTimestampIndex::live(const Entry& entry) const {
+  boost::unordered_map<Key, Slot>::const_iterator it = slots_.find(entry.key);
+  return it != slots_.end() && it->second.sequence == entry.sequence;
+}
+
+/* ************************************************************************* */
+void KeyTimestampIndex::update(Key key, double timestamp) {
+  boost::unordered_map<Key, Slot>::iterator it = slots_.find(key);
+  const bool moved = (it != slots_.end());
+  if (moved) {
+    if (it->second.timestamp == timestamp)
+      return;
+    ++stale_;
+  } else {
+    it = slots_.insert(std::make_pair(key, Slot())).first;
+  }
+  it->second.timestamp = timestamp;
+  it->second.sequence = nextSequence_;
+  const Entry e = { timestamp, key, nextSequence_++ };
+  insert(e);
+  if (moved)
+    retire();
+}
+
+/* ************************************************************************* */
+void KeyTimestampIndex::update(const KeyTimestampMap& timestamps) {
+  BOOST_FOREACH(const KeyTimestampMap::value_type& key_timestamp, timestamps)
+    update(key_timestamp.first, key_timestamp.second);
+}
+
+/* ************************************************************************* */
+void KeyTimestampIndex::erase(Key key) {
+  if (slots_.erase(key) > 0) {
+    ++stale_;
+    retire();
+  }
+}
+
+/* ************************************************************************* */
+void KeyTimestampIndex::erase(const std::set<Key>& keys) {
+  BOOST_FOREACH(Key key, keys)
+    erase(key);
+}
+
+/* ************************************************************************* */
+std::set<Key> KeyTimestampIndex::eraseBefore(double timestamp) {
+  std::set<Key> keys;
+  while (count_ > 0 && entry(0).timestamp < timestamp) {
+    const Entry& e = entry(0);
+    if (live(e)) {
+      keys.insert(e.key);
+      slots_.erase(e.key);
+    } else {
+      --stale_;
+    }
+    head_ = (head_ + 1) & (ring_.size() - 1);
+    --count_;
+  }
+  retire();
+  return keys;
+}
+
+/* ************************************************************************* */
+double KeyTimestampIndex::latest() const {
+  for (size_t i = count_; i > 0; --i) {
+    const Entry& e = entry(i - 1);
+    if (live(e))
+      return e.timestamp;
+  }
+  return -std::numeric_limits<double>::max();
+}
+
+/* ************************************************************************* */
+std::set<Key> KeyTimestampIndex::findBefore(double timestamp) const {
+  std::set<Key> keys;
+  for (size_t i = 0; i < count_ && entry(i).timestamp < timestamp; ++i) {
+    if (live(entry(i)))
+      keys.insert(entry(i).key);
+  }
+  return keys;
+}
+
+/* ************************************************************************* */
+std::set<Key> KeyTimestampIndex::findAfter(double timestamp) const {
+  std::set<Key> keys;
+  for (size_t i = count_; i > 0 && entry(i - 1).timestamp > timestamp; --i) {
+    if (live(entry(i - 1)))
+      keys.insert(entry(i - 1).key);
+  }
+  return keys;
+}
+
+/* ************************************************************************* */
+KeyVector KeyTimestampIndex::keys() const {
+  KeyVector keys;
+  keys.reserve(size());
+  for (size_t i = 0; i < count_; ++i) {
+    if (live(entry(i)))
+      keys.push_back(entry(i).key);
+  }
+  return keys;
+}
+
+/* ************************************************************************* */
+KeyTimestampIndex::KeyTimestampMap KeyTimestampIndex::timestamps() const {
+  KeyTimestampMap timestamps;
+  typedef boost::unordered_map<Key, Slot>::value_type KeySlot;
+  BOOST_FOREACH(const KeySlot& key_slot, slots_)
+    timestamps.insert(std::make_pair(key_slot.first, key_slot.second.timestamp));
+  return timestamps;
+}
+
+/* ************************************************************************* */
+void KeyTimestampIndex::insert(const Entry& e) {
+  if (count_ == ring_.size())
+    reallocate(ring_.empty() ? 16 : 2 * ring_.size());
+
+  // Find the position after all entries that are not newer, searching from the back since
+  // timestamps mostly arrive in order
+  size_t position = count_;
+  if (position > 0 && entry(position - 1).timestamp > e.timestamp) {
+    size_t first = 0, last = count_;
+    while (first < last) {
+      const size_t middle = first + (last - first) / 2;
+      if (entry(middle).timestamp > e.timestamp)
+        last = middle;
+      else
+        first = middle + 1;
+    }
+    position = first;
+  }
+
+  for (size_t i = count_; i > position; --i)
+    entry(i) = entry(i - 1);
+  entry(position) = e;
+  ++count_;
+}
+
+/* ************************************************************************* */
+void KeyTimestampIndex::retire() {
+  while (count_ > 0 && !live(entry(0))) {
+    head_ = (head_ + 1) & (ring_.size() - 1);
+    --count_;
+    --stale_;
+  }
+  if (stale_ >= 16 && 2 * stale_ > count_)
+    reallocate(ring_.size());
+}
+
+/* ************************************************************************* */
+void KeyTimestampIndex::reallocate(size_t capacity) {
+  std::vector<Entry> ring(capacity);
+  size_t n = 0;
+  for (size_t i = 0; i < count_; ++i) {
+    if (live(entry(i)))
+      ring[n++] = entry(i);
+  }
+  ring_.swap(ring);
+  head_ = 0;
+  count_ = n;
+  stale_ = 0;
+}
+
+/* ************************************************************************* */
+} /// namespace gtsam
@@ -0,0 +1,139 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    KeyTimestampIndex.h
+ * @brief   Ring-buffer index of the keys of a fixed-lag smoother, ordered by timestamp
+ * @date    Oct 15, 2026
+ */
+
+// \callgraph
+#pragma once
+
+#include <gtsam_unstable/base/dllexport.h>
+#include <gtsam/inference/Key.h>
+
+#include <boost/unordered_map.hpp>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Tracks the timestamp of each key of a fixed-lag smoother.  The entries are kept in a ring
+ * buffer in timestamp order, next to a hash map from each key to its timestamp.  When
+ * timestamps arrive in increasing order, as they do in a running smoother, adding a key is
+ * an append, and the expired keys are a prefix of the buffer that is found and removed in
+ * time linear in their number.  Changing the timestamp of a key appends a new entry and
+ * leaves the old one stale; stale entries are skipped, dropped when they reach the front of
+ * the buffer, and compacted away once they make up half of the buffer.  A timestamp older
+ * than the newest one is inserted in order by shifting the newer entries.
+ */
+class GTSAM_UNSTABLE_EXPORT KeyTimestampIndex {
+
+public:
+
+  /// A map from keys to timestamps, ordered by key
+  typedef std::map<Key, double> KeyTimestampMap;
+
+  /** Create an empty index */
+  KeyTimestampIndex();
+
+  /** Print the keys in timestamp order */
+  void print(const std::string& s = "", const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+  /** Check whether both indices have the same keys, with timestamps within tol */
+  bool equals(const KeyTimestampIndex& other, double tol = 1e-9) const;
+
+  /** The number of keys */
+  size_t size() const { return slots_.size(); }
+
+  /** Whether there are no keys */
+  bool empty() const { return slots_.empty(); }
+
+  /** Whether the key has a timestamp */
+  bool exists(Key key) const { return slots_.find(key) != slots_.end(); }
+
+  /** The timestamp of a key, throws std::out_of_range if it has none */
+  double at(Key key) const;
+
+  /** Set the timestamp of a key, adding the key if it is new */
+  void update(Key key, double timestamp);
+
+  /** Set the timestamps of several keys */
+  void update(const KeyTimestampMap& timestamps);
+
+  /** Remove a key, if it exists */
+  void erase(Key key);
+
+  /** Remove several keys */
+  void erase(const std::set<Key>& keys);
+
+  /** Remove all keys with a timestamp before the given time, and return them */
+  std::set<Key> eraseBefore(double timestamp);
+
+  /** The newest timestamp, or the lowest double if there are no keys */
+  double latest() const;
+
+  /** The keys with a timestamp before the given time */
+  std::set<Key> findBefore(double timestamp) const;
+
+  /** The keys with a timestamp after the given time */
+  std::set<Key> findAfter(double timestamp) const;
+
+  /** All keys, in timestamp order */
+  KeyVector keys() const;
+
+  /** All keys with their timestamps, ordered by key */
+  KeyTimestampMap timestamps() const;
+
+private:
+
+  /** An entry of the ring buffer, stale if the key has moved to a newer entry or was removed */
+  struct Entry {
+    double timestamp;
+    Key key;
+    size_t sequence;
+  };
+
+  /** The timestamp of a key, and the sequence number of its live entry */
+  struct Slot {
+    double timestamp;
+    size_t sequence;
+  };
+
+  std::vector<Entry> ring_;  ///< the ring buffer, with a power of two capacity
+  size_t head_;              ///< position of the oldest entry in ring_
+  size_t count_;             ///< number of entries, including stale ones
+  size_t stale_;             ///< number of stale entries
+  size_t nextSequence_;      ///< sequence number of the next entry
+  boost::unordered_map<Key, Slot> slots_;
+
+  /** The i-th oldest entry */
+  Entry& entry(size_t i) { return ring_[(head_ + i) & (ring_.size() - 1)]; }
+  const Entry& entry(size_t i) const { return ring_[(head_ + i) & (ring_.size() - 1)]; }
+
+  /** Whether an entry is the current one of its key */
+  bool live(const Entry& entry) const;
+
+  /** Add an entry in timestamp order, after the entries with the same timestamp */
+  void insert(const Entry& entry);
+
+  /** Drop the stale entries at the front, and compact the buffer once half of it is stale */
+  void retire();
+
+  /** Rewrite the buffer with only the live entries, with the given capacity */
+  void reallocate(size_t capacity);
+};
+
+} /// namespace gtsam
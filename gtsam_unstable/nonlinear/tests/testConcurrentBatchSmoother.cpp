@@ -790,6 +790,75 @@ TEST( ConcurrentBatchSmoother, removeFactors_values )
 }
 
 
+/* ************************************************************************* */
+TEST( ConcurrentBatchSmoother, cacheSummarization )
+{
+  LevenbergMarquardtParams parameters;
+  parameters.cacheLinearization = true;
+  parameters.relinearizeThreshold = 1e-3;
+
+  ConcurrentBatchSmoother smoother(parameters);
+  ConcurrentBatchSmoother cachedSmoother(parameters, true);
+
+  // An odometry chain on 0..9 with a loop closure, and a separator on 10 and 11
+  NonlinearFactorGraph smootherFactors, filterSumarization;
+  Values smootherValues, filterSeparatorValues;
+  smootherFactors.push_back(PriorFactor<Pose3>(0, poseInitial, noisePrior));
+  smootherValues.insert(0, poseInitial.compose(poseError));
+  for(Key j = 1; j <= 10; ++j) {
+    smootherFactors.push_back(BetweenFactor<Pose3>(j-1, j, poseOdometry, noiseOdometery));
+    Pose3 pose = (j == 1 ? smootherValues.at<Pose3>(0) : smootherValues.at<Pose3>(j-1)).compose(poseOdometry).compose(poseError);
+    if(j < 10) smootherValues.insert(j, pose);
+    else filterSeparatorValues.insert(j, pose);
+  }
+  smootherFactors.push_back(BetweenFactor<Pose3>(2, 7, poseOdometry.compose(poseOdometry).compose(poseOdometry).compose(poseOdometry).compose(poseOdometry), noiseLoop));
+  filterSeparatorValues.insert(11, filterSeparatorValues.at<Pose3>(10).compose(poseOdometry));
+  filterSumarization.push_back(LinearContainerFactor(BetweenFactor<Pose3>(10, 11, poseOdometry, noiseOdometery).linearize(filterSeparatorValues), filterSeparatorValues));
+
+  for(size_t i = 0; i < 2; ++i) {
+    NonlinearFactorGraph summarization, cachedSummarization;
+    Values separatorValues, cachedSeparatorValues;
+    smoother.presync();
+    cachedSmoother.presync();
+    smoother.getSummarizedFactors(summarization, separatorValues);
+    cachedSmoother.getSummarizedFactors(cachedSummarization, cachedSeparatorValues);
+    smoother.synchronize(smootherFactors, smootherValues, filterSumarization, filterSeparatorValues);
+    cachedSmoother.synchronize(smootherFactors, smootherValues, filterSumarization, filterSeparatorValues);
+    smoother.postsync();
+    cachedSmoother.postsync();
+    smootherFactors = NonlinearFactorGraph();
+    smootherValues = Values();
+
+    ConcurrentBatchSmoother::Result result = smoother.update();
+    ConcurrentBatchSmoother::Result cachedResult = cachedSmoother.update();
+    EXPECT_LONGS_EQUAL(0, result.getReusedCliques());
+    if(i == 0) {
+      EXPECT_LONGS_EQUAL(0, cachedResult.getReusedCliques());
+    } else {
+      CHECK(cachedResult.getReusedCliques() > 0);
+    }
+
+    // Same estimate, and the summarizations agree on the separator
+    CHECK(assert_equal(smoother.calculateEstimate(), cachedSmoother.calculateEstimate(), 1e-6));
+    summarization = NonlinearFactorGraph();
+    cachedSummarization = NonlinearFactorGraph();
+    separatorValues.clear();
+    cachedSeparatorValues.clear();
+    smoother.presync();
+    cachedSmoother.presync();
+    smoother.getSummarizedFactors(summarization, separatorValues);
+    cachedSmoother.getSummarizedFactors(cachedSummarization, cachedSeparatorValues);
+    smoother.postsync();
+    cachedSmoother.postsync();
+    CHECK(assert_equal(separatorValues, cachedSeparatorValues, 1e-9));
+    // up to the linearization points of the cached factors
+    GaussianFactorGraph linear = *summarization.linearize(separatorValues);
+    GaussianFactorGraph cachedLinear = *cachedSummarization.linearize(separatorValues);
+    EXPECT(assert_equal(linear.hessian().first, cachedLinear.hessian().first, 1e-3));
+    EXPECT(assert_equal(linear.hessian().second, cachedLinear.hessian().second, 1e-2));
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -1439,6 +1439,53 @@ TEST( ConcurrentIncrementalFilter, removeFactors_values )
 
 
 
+/* ************************************************************************* */
+TEST( ConcurrentIncrementalFilter, summarization_shared )
+{
+  ISAM2Params parameters;
+  parameters.relinearizeThreshold = 0;
+  parameters.relinearizeSkip = 1;
+  ConcurrentIncrementalFilter filter(parameters);
+
+  NonlinearFactorGraph newFactors;
+  newFactors.push_back(PriorFactor<Pose3>(1, poseInitial, noisePrior));
+  newFactors.push_back(BetweenFactor<Pose3>(1, 2, poseOdometry, noiseOdometery));
+  newFactors.push_back(BetweenFactor<Pose3>(2, 3, poseOdometry, noiseOdometery));
+  newFactors.push_back(BetweenFactor<Pose3>(3, 4, poseOdometry, noiseOdometery));
+  Values newValues;
+  newValues.insert(1, poseInitial);
+  newValues.insert(2, poseInitial.compose(poseOdometry));
+  newValues.insert(3, newValues.at<Pose3>(2).compose(poseOdometry));
+  newValues.insert(4, newValues.at<Pose3>(3).compose(poseOdometry));
+  FastList<Key> keysToMove;
+  keysToMove.push_back(1);
+  filter.update(newFactors, newValues, keysToMove);
+  filter.presync();
+  filter.synchronize(NonlinearFactorGraph(), Values());
+
+  // Repeated requests share the same summarization factors
+  NonlinearFactorGraph summarization1, summarization2;
+  Values separatorValues1, separatorValues2;
+  filter.getSummarizedFactors(summarization1, separatorValues1);
+  filter.getSummarizedFactors(summarization2, separatorValues2);
+  CHECK(summarization1.size() > 0);
+  LONGS_EQUAL(summarization1.size(), summarization2.size());
+  for(size_t i = 0; i < summarization1.size(); ++i)
+    CHECK(summarization1[i] == summarization2[i]);
+  CHECK(assert_equal(separatorValues1, separatorValues2));
+
+  // Once the filter changes, the summarization is calculated again
+  keysToMove.clear();
+  keysToMove.push_back(2);
+  filter.update(NonlinearFactorGraph(), Values(), keysToMove);
+  NonlinearFactorGraph summarization3;
+  Values separatorValues3;
+  filter.getSummarizedFactors(summarization3, separatorValues3);
+  CHECK(summarization3.size() > 0);
+  CHECK(summarization3[0] != summarization1[0]);
+  CHECK(separatorValues3.exists(3));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -0,0 +1,100 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testConcurrentSmootherThread.cpp
+ * @brief   Unit tests for running the concurrent smoother on its own thread
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam_unstable/nonlinear/ConcurrentSmootherThread.h>
+#include <gtsam_unstable/nonlinear/ConcurrentBatchFilter.h>
+#include <gtsam_unstable/nonlinear/ConcurrentBatchSmoother.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+
+// Set up initial pose, odometry difference, loop closure difference, and initialization errors
+const Pose3 poseInitial;
+const Pose3 poseOdometry( Rot3::RzRyRx(Vector3(0.05, 0.10, -0.75)), Point3(1.0, -0.25, 0.10) );
+const Pose3 poseError( Rot3::RzRyRx(Vector3(0.01, 0.02, -0.1)), Point3(0.05, -0.05, 0.02) );
+
+// Set up noise models for the factors
+const SharedDiagonal noisePrior = noiseModel::Isotropic::Sigma(6, 0.10);
+const SharedDiagonal noiseOdometery = noiseModel::Diagonal::Sigmas((Vector(6) << 0.1, 0.1, 0.1, 0.5, 0.5, 0.5).finished());
+
+} // end namespace
+
+/* ************************************************************************* */
+TEST( ConcurrentSmootherThread, chain )
+{
+  LevenbergMarquardtParams parameters;
+  ConcurrentBatchFilter filter(parameters);
+  ConcurrentBatchSmoother smoother(parameters);
+
+  NonlinearFactorGraph allFactors;
+  Values allValues;
+  size_t nrSynchronized = 0;
+  {
+    ConcurrentSmootherThread<ConcurrentBatchSmoother> smootherThread(filter, smoother);
+
+    // Run the filter on an odometry chain, moving all but the last two poses to the smoother
+    Pose3 pose = poseInitial.compose(poseError);
+    for (Key j = 0; j < 30; ++j) {
+      NonlinearFactorGraph newFactors;
+      if (j == 0)
+        newFactors.push_back(PriorFactor<Pose3>(0, poseInitial, noisePrior));
+      else {
+        newFactors.push_back(BetweenFactor<Pose3>(j - 1, j, poseOdometry, noiseOdometery));
+        pose = pose.compose(poseOdometry).compose(poseError);
+      }
+      Values newValues;
+      newValues.insert(j, pose);
+      allFactors.push_back(newFactors);
+      allValues.insert(j, pose);
+
+      FastList<Key> keysToMove;
+      if (j >= 2) keysToMove.push_back(j - 2);
+      filter.update(newFactors, newValues, keysToMove);
+
+      // Never blocks, skips if the smoother is busy
+      if (smootherThread.synchronize()) ++nrSynchronized;
+    }
+
+    // Hand the remaining factors over, and wait for the smoother to finish
+    smootherThread.waitUntilIdle();
+    EXPECT(smootherThread.synchronize());
+    smootherThread.waitUntilIdle();
+    EXPECT(smootherThread.isIdle());
+    EXPECT_LONGS_EQUAL(nrSynchronized + 1, smootherThread.nrUpdates());
+  }
+
+  // Filter and smoother estimates together are the batch solution
+  Values expected = LevenbergMarquardtOptimizer(allFactors, allValues, parameters).optimize();
+  Values actual = smoother.calculateEstimate();
+  Values filterEstimate = filter.calculateEstimate();
+  BOOST_FOREACH(const Values::ConstKeyValuePair& key_value, filterEstimate)
+    if (!actual.exists(key_value.key)) actual.insert(key_value.key, key_value.value);
+  EXPECT_LONGS_EQUAL(30, actual.size());
+  EXPECT(assert_equal(expected, actual, 1e-4));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
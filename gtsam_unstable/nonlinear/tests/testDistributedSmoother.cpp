@@ -0,0 +1,125 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testDistributedSmoother.cpp
+ * @brief   Unit tests for the DistributedSmoother
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam_unstable/nonlinear/DistributedSmoother.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/nonlinear/GaussNewtonOptimizer.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/base/serialization.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Export the types sent to the workers
+BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Diagonal, "gtsam_noiseModel_Diagonal");
+BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Isotropic, "gtsam_noiseModel_Isotropic");
+BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Unit, "gtsam_noiseModel_Unit");
+GTSAM_VALUE_EXPORT(gtsam::Pose2);
+BOOST_CLASS_EXPORT_GUID(gtsam::PriorFactor<gtsam::Pose2>, "gtsam::PriorFactorPose2");
+BOOST_CLASS_EXPORT_GUID(gtsam::BetweenFactor<gtsam::Pose2>, "gtsam::BetweenFactorPose2");
+
+namespace {
+
+const SharedDiagonal noisePrior = noiseModel::Isotropic::Sigma(3, 0.1);
+const SharedDiagonal noiseOdometry = noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.1, 0.05));
+const SharedDiagonal noiseRendezvous = noiseModel::Diagonal::Sigmas(Vector3(0.2, 0.2, 0.1));
+
+// Three robots 'a', 'b' and 'c' driving in circles, observing each other now and then
+void createTeam(NonlinearFactorGraph& graph, Values& initial) {
+  const Pose2 odometry(1.0, 0.0, M_PI / 8.0);
+  const Pose2 error(0.05, -0.03, 0.02);
+  const unsigned char robots[] = {'a', 'b', 'c'};
+  for (size_t r = 0; r < 3; ++r) {
+    Pose2 pose(0.0, 3.0 * r, 0.0);
+    graph.push_back(PriorFactor<Pose2>(Symbol(robots[r], 0), pose, noisePrior));
+    initial.insert(Symbol(robots[r], 0), pose);
+    for (size_t i = 1; i < 20; ++i) {
+      graph.push_back(BetweenFactor<Pose2>(Symbol(robots[r], i - 1), Symbol(robots[r], i),
+          odometry, noiseOdometry));
+      pose = pose.compose(odometry).compose(error);
+      initial.insert(Symbol(robots[r], i), pose);
+    }
+  }
+  for (size_t i = 4; i < 20; i += 5) {
+    graph.push_back(BetweenFactor<Pose2>(Symbol('a', i), Symbol('b', i), Pose2(0.0, 3.0, 0.0), noiseRendezvous));
+    graph.push_back(BetweenFactor<Pose2>(Symbol('b', i), Symbol('c', i), Pose2(0.0, 3.0, 0.0), noiseRendezvous));
+  }
+}
+
+} // end namespace
+
+/* ************************************************************************* */
+TEST( DistributedSmoother, message )
+{
+  DistributedMessage message(DistributedMessage::SETUP);
+  message.factors.push_back(PriorFactor<Pose2>(Symbol('a', 0), Pose2(), noisePrior));
+  message.values.insert(Symbol('a', 0), Pose2(1.0, 2.0, 0.3));
+  message.keys.push_back(Symbol('a', 0));
+  message.delta.insert(Symbol('a', 1), Vector3(0.1, 0.2, 0.3));
+  message.separatorFactors.push_back(HessianFactor(Symbol('a', 1), 2.0 * eye(3), Vector3(1.0, 2.0, 3.0), 4.0));
+
+  DistributedMessage actual = DistributedMessage::Deserialize(message.serialize());
+  EXPECT_LONGS_EQUAL(DistributedMessage::SETUP, actual.type);
+  EXPECT(assert_equal(message.factors, actual.factors));
+  EXPECT(assert_equal(message.values, actual.values));
+  EXPECT(assert_equal(message.keys, actual.keys));
+  EXPECT(assert_equal(message.delta, actual.delta));
+  LONGS_EQUAL(1, actual.separatorFactors.size());
+  EXPECT(assert_equal(message.separatorFactors[0], actual.separatorFactors[0]));
+}
+
+/* ************************************************************************* */
+TEST( DistributedSmoother, team )
+{
+  NonlinearFactorGraph graph;
+  Values initial;
+  createTeam(graph, initial);
+
+  GaussNewtonParams params;
+  params.relativeErrorTol = 1e-10;
+  params.absoluteErrorTol = 1e-10;
+  Values expected = GaussNewtonOptimizer(graph, initial, params).optimize();
+
+  // One worker per robot, the rendezvous factors are solved by the coordinator
+  vector<KeySet> partitions = DistributedSmoother::PartitionBySymbol(initial);
+  LONGS_EQUAL(3, partitions.size());
+  DistributedTransport::shared_ptr transport(new ThreadedDistributedTransport(partitions.size()));
+  DistributedSmoother smoother(graph, initial, partitions, transport, params);
+  EXPECT_LONGS_EQUAL(8, smoother.separatorFactors().size());
+
+  DistributedSmoother::Result result = smoother.optimize();
+  EXPECT_LONGS_EQUAL(12, result.getSeparatorVariables());
+  EXPECT(result.getIterations() > 1);
+  EXPECT_DOUBLES_EQUAL(graph.error(expected), result.getError(), 1e-6);
+
+  Values actual = smoother.calculateEstimate();
+  EXPECT_LONGS_EQUAL(60, actual.size());
+  EXPECT(assert_equal(expected, actual, 1e-6));
+
+  // A partition without any worker
+  partitions.pop_back();
+  CHECK_EXCEPTION(DistributedSmoother(graph, initial, partitions, transport, params), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -169,11 +169,15 @@ TEST( IncrementalFixedLagSmoother, Example )
     fullinit.insert(newValues);
 
     // Update the smoother
-    smoother.update(newFactors, newValues, newTimestamps);
+    FixedLagSmoother::Result result = smoother.update(newFactors, newValues, newTimestamps);
 
     // Check
     CHECK(check_smoother(fullgraph, fullinit, smoother, key2));
 
+    // The variable that fell out of the lag was marginalized
+    LONGS_EQUAL(i >= 8 ? 1 : 0, result.getMarginalizedVariables());
+    if (i >= 8) CHECK(!smoother.getLinearizationPoint().exists(MakeKey(i-8)));
+
     ++i;
   }
 
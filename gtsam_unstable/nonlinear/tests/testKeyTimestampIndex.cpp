@@ -0,0 +1,113 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testKeyTimestampIndex.cpp
+ * @brief   Unit tests for the ring-buffer index of keys by timestamp
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam_unstable/nonlinear/KeyTimestampIndex.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/assign/list_of.hpp>
+#include <map>
+
+using namespace std;
+using namespace gtsam;
+using boost::assign::list_of;
+
+/* ************************************************************************* */
+TEST( KeyTimestampIndex, InOrder )
+{
+  KeyTimestampIndex index;
+  EXPECT(index.empty());
+  EXPECT_DOUBLES_EQUAL(-std::numeric_limits<double>::max(), index.latest(), 0.0);
+
+  for (size_t i = 0; i < 100; ++i)
+    index.update(i, 0.5 * i);
+  EXPECT_LONGS_EQUAL(100, index.size());
+  EXPECT_DOUBLES_EQUAL(49.5, index.latest(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(10.0, index.at(20), 1e-9);
+
+  set<Key> expected = list_of(0)(1)(2);
+  EXPECT(expected == index.findBefore(1.5));
+  expected = list_of(98)(99);
+  EXPECT(expected == index.findAfter(48.5));
+
+  // Expire the oldest keys in one batch
+  expected = list_of(0)(1)(2)(3);
+  EXPECT(expected == index.eraseBefore(2.0));
+  EXPECT_LONGS_EQUAL(96, index.size());
+  EXPECT(!index.exists(3));
+  EXPECT(index.exists(4));
+  CHECK_EXCEPTION(index.at(3), std::out_of_range);
+}
+
+/* ************************************************************************* */
+TEST( KeyTimestampIndex, Moves )
+{
+  // Compare against the std::map/std::multimap pair it replaces, with timestamps that
+  // move back and forth, keys that are erased, and the window sliding forward
+  KeyTimestampIndex index;
+  map<Key, double> expected;
+  for (size_t i = 0; i < 500; ++i) {
+    const double t = 0.1 * i;
+    index.update(i, t);
+    expected[i] = t;
+
+    // Move an older key to now, and another one back in time
+    if (i > 10 && i % 3 == 0) {
+      index.update(i - 5, t);
+      expected[i - 5] = t;
+      index.update(i - 7, t - 3.0);
+      expected[i - 7] = t - 3.0;
+    }
+
+    // Erase a key explicitly
+    if (i > 20 && i % 7 == 0) {
+      index.erase(i - 20);
+      expected.erase(i - 20);
+    }
+
+    // Slide the window
+    if (i % 10 == 0) {
+      set<Key> expectedBefore;
+      for (map<Key, double>::iterator it = expected.begin(); it != expected.end(); ) {
+        if (it->second < t - 4.0) {
+          expectedBefore.insert(it->first);
+          expected.erase(it++);
+        } else {
+          ++it;
+        }
+      }
+      EXPECT(expectedBefore == index.eraseBefore(t - 4.0));
+    }
+    EXPECT(expected == index.timestamps());
+  }
+
+  // The keys come out in timestamp order
+  const KeyVector keys = index.keys();
+  LONGS_EQUAL(expected.size(), keys.size());
+  for (size_t k = 1; k < keys.size(); ++k)
+    EXPECT(index.at(keys[k - 1]) <= index.at(keys[k]));
+
+  KeyTimestampIndex other;
+  other.update(index.timestamps());
+  EXPECT(index.equals(other));
+  other.erase(keys.front());
+  EXPECT(!index.equals(other));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
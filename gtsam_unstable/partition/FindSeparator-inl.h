@@ -12,10 +12,17 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <numeric>
 #include <boost/tuple/tuple.hpp>
 #include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/shared_array.hpp>
-#include <boost/timer.hpp>
+#include <boost/thread/mutex.hpp>
+#include <gtsam/config.h>
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/task_group.h>
+#endif
 
 #include "FindSeparator.h"
 
@@ -30,6 +37,14 @@ namespace gtsam { namespace partition {
 
   typedef boost::shared_array<idx_t> sharedInts;
 
+  /* ************************************************************************* */
+  // Metis draws its random numbers from the process-wide rand() state, so calls from parallel
+  // tasks are serialized to keep the partitions deterministic
+  inline boost::mutex& metisMutex() {
+    static boost::mutex mutex;
+    return mutex;
+  }
+
   /* ************************************************************************* */
   /**
    * Return the size of the separator and the partiion indices {part}
@@ -40,16 +55,12 @@ namespace gtsam { namespace partition {
   std::pair<int, sharedInts> separatorMetis(idx_t n, const sharedInts& xadj,
     const sharedInts& adjncy, const sharedInts& adjwgt, bool verbose) {
 
-    // control parameters
-    idx_t vwgt[n];                  // the weights of the vertices
+    // control parameters, with uniform weights on the vertices
     idx_t options[METIS_NOPTIONS];
     METIS_SetDefaultOptions(options);  // use defaults
     idx_t sepsize;                      // the size of the separator, output
     sharedInts part_(new idx_t[n]);      // the partition of each vertex, output
 
-    // set uniform weights on the vertices
-    std::fill(vwgt, vwgt+n, 1);
-
     // TODO: Fix at later time
     //boost::timer::cpu_timer TOTALTmr;
     if (verbose) {
@@ -61,8 +72,11 @@ namespace gtsam { namespace partition {
     }
 
     // call metis parition routine
-    METIS_ComputeVertexSeparator(&n, xadj.get(), adjncy.get(), 
-           vwgt, options, &sepsize, part_.get());
+    {
+      boost::mutex::scoped_lock lock(metisMutex());
+      METIS_ComputeVertexSeparator(&n, xadj.get(), adjncy.get(),
+             NULL, options, &sepsize, part_.get());
+    }
 
     if (verbose) {
       //boost::cpu_times const elapsed_times(timer.elapsed());
@@ -128,15 +142,12 @@ namespace gtsam { namespace partition {
     const sharedInts& adjwgt, bool verbose) {
 
     // control parameters
-    idx_t vwgt[n];                  // the weights of the vertices
+    std::vector<idx_t> vwgt(n, 1);      // uniform weights on the vertices
     idx_t options[METIS_NOPTIONS];
     METIS_SetDefaultOptions(options);  // use defaults
     idx_t edgecut;                      // the number of edge cuts, output
     sharedInts part_(new idx_t[n]);      // the partition of each vertex, output
 
-    // set uniform weights on the vertices
-    std::fill(vwgt, vwgt+n, 1);
-
     //TODO: Fix later
     //boost::timer TOTALTmr;
     if (verbose) {
@@ -151,8 +162,11 @@ namespace gtsam { namespace partition {
     //int wgtflag = 1; // only edge weights
     //int numflag = 0; // c style numbering starting from 0
     //int nparts = 2; // partition the graph to 2 submaps
-    modefied_EdgeComputeSeparator(&n, xadj.get(), adjncy.get(), vwgt, adjwgt.get(),
-        options, &edgecut, part_.get());
+    {
+      boost::mutex::scoped_lock lock(metisMutex());
+      modefied_EdgeComputeSeparator(&n, xadj.get(), adjncy.get(), &vwgt[0], adjwgt.get(),
+          options, &edgecut, part_.get());
+    }
 
     
     if (verbose) {
@@ -176,62 +190,42 @@ namespace gtsam { namespace partition {
   void prepareMetisGraph(const GenericGraph& graph, const std::vector<size_t>& keys, WorkSpace& workspace,
       sharedInts* ptr_xadj, sharedInts* ptr_adjncy, sharedInts* ptr_adjwgt) {
 
-    typedef int Weight;
-    typedef std::vector<int> Weights;
-    typedef std::vector<int> Neighbors;
-    typedef std::pair<Neighbors, Weights> NeighborsInfo;
-
     // set up dictionary
-    std::vector<int>& dictionary = workspace.dictionary;
+    const std::vector<int>& dictionary = workspace.dictionary;
     workspace.prepareDictionary(keys);
 
-    // prepare for {adjacencyMap}, a pair of neighbor indices and the correponding edge weights
-    int numNodes = keys.size();
-    int numEdges = 0;
-    std::vector<NeighborsInfo> adjacencyMap;
-    adjacencyMap.resize(numNodes);
-    std::cout << "Number of nodes: " << adjacencyMap.size() << std::endl;
-    int index1, index2;
-
-    BOOST_FOREACH(const typename GenericGraph::value_type& factor, graph){
-      index1 = dictionary[factor->key1.index];
-      index2 = dictionary[factor->key2.index];
-      std::cout << "index1: " << index1 << std::endl;
-      std::cout << "index2: " << index2 << std::endl;
-      // if both nodes are in the current graph, i.e. not a joint factor between frontal and separator
-      if (index1 >= 0 && index2 >= 0) {       
-        std::pair<Neighbors, Weights>& adjacencyMap1 = adjacencyMap[index1];
-        std::pair<Neighbors, Weights>& adjacencyMap2 = adjacencyMap[index2];
-        try{
-         adjacencyMap1.first.push_back(index2);
-         adjacencyMap1.second.push_back(factor->weight);
-         adjacencyMap2.first.push_back(index1);
-         adjacencyMap2.second.push_back(factor->weight);
-        }catch(std::exception& e){
-          std::cout << e.what() << std::endl;
-        }
-        numEdges++;
+    // count the neighbors of each node, only for factors with both nodes in the current graph,
+    // i.e. not a joint factor between frontal and separator
+    const int numNodes = keys.size();
+    *ptr_xadj = sharedInts(new idx_t[numNodes+1]);
+    idx_t* xadj = ptr_xadj->get();
+    std::fill(xadj, xadj + numNodes + 1, 0);
+    BOOST_FOREACH(const typename GenericGraph::value_type& factor, graph) {
+      int index1 = dictionary[factor->key1.index];
+      int index2 = dictionary[factor->key2.index];
+      if (index1 >= 0 && index2 >= 0) {
+        ++xadj[index1 + 1];
+        ++xadj[index2 + 1];
       }
     }
-
-    // prepare for {xadj}, {adjncy}, and {adjwgt}
-    *ptr_xadj   = sharedInts(new idx_t[numNodes+1]);
-    *ptr_adjncy = sharedInts(new idx_t[numEdges*2]);
-    *ptr_adjwgt = sharedInts(new idx_t[numEdges*2]);
-    sharedInts& xadj = *ptr_xadj;
-    sharedInts& adjncy = *ptr_adjncy;
-    sharedInts& adjwgt = *ptr_adjwgt;
-    int ind_xadj = 0, ind_adjncy = 0;
-    BOOST_FOREACH(const NeighborsInfo& info, adjacencyMap) {
-      *(xadj.get() + ind_xadj) = ind_adjncy;
-      std::copy(info.first .begin(), info.first .end(), adjncy.get() + ind_adjncy);
-      std::copy(info.second.begin(), info.second.end(), adjwgt.get() + ind_adjncy);
-      assert(info.first.size() == info.second.size());
-      ind_adjncy += info.first.size();
-      ind_xadj ++;
+    std::partial_sum(xadj, xadj + numNodes + 1, xadj);
+
+    // fill {adjncy} and {adjwgt} in place, the neighbors of each node in the order of the factors
+    *ptr_adjncy = sharedInts(new idx_t[xadj[numNodes]]);
+    *ptr_adjwgt = sharedInts(new idx_t[xadj[numNodes]]);
+    idx_t* adjncy = ptr_adjncy->get();
+    idx_t* adjwgt = ptr_adjwgt->get();
+    std::vector<idx_t> next(xadj, xadj + numNodes);
+    BOOST_FOREACH(const typename GenericGraph::value_type& factor, graph) {
+      int index1 = dictionary[factor->key1.index];
+      int index2 = dictionary[factor->key2.index];
+      if (index1 >= 0 && index2 >= 0) {
+        adjncy[next[index1]] = index2;
+        adjwgt[next[index1]++] = factor->weight;
+        adjncy[next[index2]] = index1;
+        adjwgt[next[index2]++] = factor->weight;
+      }
     }
-    if (ind_xadj != numNodes) throw std::runtime_error("prepareMetisGraph_: ind_xadj != numNodes");
-    *(xadj.get() + ind_xadj) = ind_adjncy;
   }
 
   /* ************************************************************************* */
@@ -285,7 +279,7 @@ namespace gtsam { namespace partition {
       throw std::runtime_error("separatorPartitionByMetis: invalid sepsize from Metis ND!");
     }
 
-    return boost::make_optional<MetisResult >(result);
+    return result;
   }
 
   /* *************************************************************************/ 
@@ -360,7 +354,7 @@ namespace gtsam { namespace partition {
       std::cout << "edgeCut: " << edgeCut << std::endl;
     }
 
-    return boost::make_optional<MetisResult >(result);
+    return result;
   }
 
   /* ************************************************************************* */
@@ -475,7 +469,7 @@ namespace gtsam { namespace partition {
 
     if (!result.is_initialized()) {
       std::cout << "metis failed!" << std::endl;
-      return 0;
+      return boost::none;
     }
 
     if (reduceGraph) {
@@ -563,4 +557,109 @@ namespace gtsam { namespace partition {
     return islands.size();
   }
 
+  /* ************************************************************************* */
+  // a subgraph in Metis format, with the key of each node
+  struct MetisSubgraph {
+    std::vector<idx_t> xadj, adjncy;
+    std::vector<size_t> keys;
+  };
+
+  void recursiveSeparator(const MetisSubgraph& graph, const size_t minNodesPerMap, SeparatorTree& tree);
+
+  // task dissecting one half of a bisected graph
+  class RecursiveSeparatorTask {
+    boost::shared_ptr<MetisSubgraph> graph_;
+    size_t minNodesPerMap_;
+    SeparatorTree* tree_;
+  public:
+    RecursiveSeparatorTask(const boost::shared_ptr<MetisSubgraph>& graph, const size_t minNodesPerMap,
+        SeparatorTree* tree) : graph_(graph), minNodesPerMap_(minNodesPerMap), tree_(tree) {}
+    void operator()() const { recursiveSeparator(*graph_, minNodesPerMap_, *tree_); }
+  };
+
+  /* ************************************************************************* */
+  inline void recursiveSeparator(const MetisSubgraph& graph, const size_t minNodesPerMap, SeparatorTree& tree) {
+    idx_t n = graph.keys.size();
+
+    // bisect with a vertex separator, part[i] is 0 or 1 for the two halves and 2 for the separator
+    std::vector<idx_t> part(n, 0);
+    size_t partSize[3] = { 0, 0, 0 };
+    if ((size_t) n > minNodesPerMap && !graph.adjncy.empty()) {
+      idx_t options[METIS_NOPTIONS];
+      METIS_SetDefaultOptions(options);
+      idx_t sepsize;
+      int outputError;
+      {
+        boost::mutex::scoped_lock lock(metisMutex());
+        outputError = METIS_ComputeVertexSeparator(&n, const_cast<idx_t*>(&graph.xadj[0]),
+            const_cast<idx_t*>(&graph.adjncy[0]), NULL, options, &sepsize, &part[0]);
+      }
+      if (outputError == METIS_OK)
+        for (idx_t i = 0; i < n; ++i)
+          ++partSize[part[i]];
+    }
+
+    // a small or inseparable subgraph is a leaf
+    if (partSize[0] == 0 || partSize[1] == 0) {
+      tree.keys = graph.keys;
+      return;
+    }
+
+    // build the two halves from the adjacency of this graph, the separator stays in this node
+    boost::shared_ptr<MetisSubgraph> halves[2] = { boost::make_shared<MetisSubgraph>(),
+        boost::make_shared<MetisSubgraph>() };
+    std::vector<idx_t> localIndex(n);
+    size_t nextIndex[3] = { 0, 0, 0 };
+    tree.keys.reserve(partSize[2]);
+    for (idx_t i = 0; i < n; ++i) {
+      localIndex[i] = nextIndex[part[i]]++;
+      if (part[i] == 2)
+        tree.keys.push_back(graph.keys[i]);
+      else
+        halves[part[i]]->keys.push_back(graph.keys[i]);
+    }
+    for (size_t h = 0; h < 2; ++h) {
+      halves[h]->xadj.reserve(partSize[h] + 1);
+      halves[h]->xadj.push_back(0);
+    }
+    for (idx_t i = 0; i < n; ++i) {
+      if (part[i] == 2)
+        continue;
+      MetisSubgraph& half = *halves[part[i]];
+      for (idx_t k = graph.xadj[i]; k < graph.xadj[i + 1]; ++k)
+        if (part[graph.adjncy[k]] == part[i])
+          half.adjncy.push_back(localIndex[graph.adjncy[k]]);
+      half.xadj.push_back(half.adjncy.size());
+    }
+
+    tree.children.push_back(boost::make_shared<SeparatorTree>());
+    tree.children.push_back(boost::make_shared<SeparatorTree>());
+#ifdef GTSAM_USE_TBB
+    tbb::task_group tasks;
+    tasks.run(RecursiveSeparatorTask(halves[0], minNodesPerMap, tree.children[0].get()));
+    recursiveSeparator(*halves[1], minNodesPerMap, *tree.children[1]);
+    tasks.wait();
+#else
+    recursiveSeparator(*halves[0], minNodesPerMap, *tree.children[0]);
+    recursiveSeparator(*halves[1], minNodesPerMap, *tree.children[1]);
+#endif
+  }
+
+  /* ************************************************************************* */
+  template<class GenericGraph>
+  boost::shared_ptr<SeparatorTree> recursiveSeparator(const GenericGraph& graph,
+      const std::vector<size_t>& keys, const size_t minNodesPerMap, WorkSpace& workspace) {
+    sharedInts xadj, adjncy, adjwgt;
+    prepareMetisGraph<GenericGraph>(graph, keys, workspace, &xadj, &adjncy, &adjwgt);
+
+    MetisSubgraph metisGraph;
+    metisGraph.xadj.assign(xadj.get(), xadj.get() + keys.size() + 1);
+    metisGraph.adjncy.assign(adjncy.get(), adjncy.get() + xadj[keys.size()]);
+    metisGraph.keys = keys;
+
+    boost::shared_ptr<SeparatorTree> tree = boost::make_shared<SeparatorTree>();
+    recursiveSeparator(metisGraph, minNodesPerMap, *tree);
+    return tree;
+  }
+
 }} //namespace
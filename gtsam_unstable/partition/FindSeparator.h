@@ -9,6 +9,7 @@
 #include <map>
 #include <vector>
 #include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
 #include <gtsam/inference/Key.h>
 #include <gtsam/inference/Symbol.h>
 
@@ -24,6 +25,12 @@ namespace gtsam { namespace partition {
     std::vector<size_t> C;     // separator
   };
 
+  /** the nested dissection tree found by recursiveSeparator */
+  struct SeparatorTree {
+    std::vector<size_t> keys;  // the separator of an inner node, or all the keys of a leaf
+    std::vector<boost::shared_ptr<SeparatorTree> > children;  // the two halves, empty for a leaf
+  };
+
   /**
    * use Metis library to partition, return the size of separator and the optional partition table
    * the size of dictionary mush be equal to the number of variables in the original graph (the largest one)
@@ -41,4 +48,14 @@ namespace gtsam { namespace partition {
       const int minNodesPerMap, WorkSpace& workspace, bool verbose, const boost::optional<std::vector<Symbol> >& int2symbol,
       const bool reduceGraph, const int minNrConstraintsPerCamera, const int minNrConstraintsPerLandmark);
 
+  /**
+   * recursively bisect the graph with Metis vertex separators, until the subgraphs have at most
+   * minNodesPerMap nodes or cannot be split. The Metis graph is built from the generic graph once,
+   * and every level builds its halves directly from the adjacency of its parent. With TBB the two
+   * halves are dissected as parallel tasks.
+   */
+  template<class GenericGraph>
+  boost::shared_ptr<SeparatorTree> recursiveSeparator(const GenericGraph& graph,
+      const std::vector<size_t>& keys, const size_t minNodesPerMap, WorkSpace& workspace);
+
 }} //namespace
@@ -0,0 +1,243 @@
+/*
+ * MultilevelOptimizer-inl.h
+ *
+ *   Created on: Oct 15, 2026
+ *  Description: coarse-to-fine Levenberg-Marquardt for large pose graphs
+ */
+
+#pragma once
+
+#include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+#include <gtsam/base/timing.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/config.h>
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include "FindSeparator-inl.h"
+#include "GenericGraph.h"
+#include "MultilevelOptimizer.h"
+
+namespace gtsam { namespace partition {
+
+  namespace internal {
+
+    // add the keys of the leaves of a separator tree to the clusters, one cluster per leaf
+    inline void collectLeaves(const SeparatorTree& tree, std::vector<size_t>& cluster, size_t& nrClusters) {
+      if (tree.children.empty()) {
+        BOOST_FOREACH(size_t i, tree.keys)
+          cluster[i] = nrClusters;
+        ++nrClusters;
+      } else {
+        BOOST_FOREACH(const boost::shared_ptr<SeparatorTree>& child, tree.children)
+          collectLeaves(*child, cluster, nrClusters);
+      }
+    }
+
+    // solves clusters on their own, storing the poses relative to their representatives
+    template<class POSE>
+    struct ClusterSolver {
+      typedef std::vector<POSE, Eigen::aligned_allocator<POSE> > Poses;
+      const NonlinearFactorGraph& graph;
+      const Values& values;
+      const std::vector<Key>& keys;
+      const std::vector<std::vector<size_t> >& clusterPoses;   // the pose indices, representative first
+      const std::vector<std::vector<size_t> >& clusterFactors; // the factors within each cluster
+      const LevenbergMarquardtParams& params;
+      Poses& offsets;
+
+      ClusterSolver(const NonlinearFactorGraph& graph, const Values& values, const std::vector<Key>& keys,
+          const std::vector<std::vector<size_t> >& clusterPoses,
+          const std::vector<std::vector<size_t> >& clusterFactors,
+          const LevenbergMarquardtParams& params, Poses& offsets) :
+        graph(graph), values(values), keys(keys), clusterPoses(clusterPoses),
+        clusterFactors(clusterFactors), params(params), offsets(offsets) {}
+
+      void solve(size_t c) const {
+        const std::vector<size_t>& poses = clusterPoses[c];
+        const Key representative = keys[poses.front()];
+        Values local;
+        BOOST_FOREACH(size_t i, poses)
+          local.insert(keys[i], values.at(keys[i]));
+        if (!clusterFactors[c].empty()) {
+          // the prior only fixes the gauge, the factors are invariant to moving the cluster rigidly
+          NonlinearFactorGraph localGraph;
+          localGraph.reserve(clusterFactors[c].size() + 1);
+          BOOST_FOREACH(size_t f, clusterFactors[c])
+            localGraph.push_back(graph[f]);
+          localGraph.push_back(boost::make_shared<PriorFactor<POSE> >(representative,
+              local.at<POSE>(representative), noiseModel::Unit::Create(traits<POSE>::dimension)));
+          local = LevenbergMarquardtOptimizer(localGraph, local, params).optimize();
+        }
+        const POSE& origin = local.at<POSE>(representative);
+        BOOST_FOREACH(size_t i, poses)
+          offsets[i] = traits<POSE>::Between(origin, local.at<POSE>(keys[i]));
+      }
+
+#ifdef GTSAM_USE_TBB
+      void operator()(const tbb::blocked_range<size_t>& range) const {
+        for (size_t c = range.begin(); c != range.end(); ++c)
+          solve(c);
+      }
+#endif
+    };
+
+  }
+
+  /* ************************************************************************* */
+  template<class POSE>
+  Values MultilevelOptimizer<POSE>::Initialize(const NonlinearFactorGraph& graph,
+      const Values& initialValues, const MultilevelParams& params) {
+    gttic(MultilevelOptimizer_initialize);
+    return SolveLevel(graph, initialValues, params, 0);
+  }
+
+  /* ************************************************************************* */
+  template<class POSE>
+  size_t MultilevelOptimizer<POSE>::FindClusters(const NonlinearFactorGraph& graph,
+      const std::vector<Key>& keys, const FastMap<Key, size_t>& index, size_t clusterSize,
+      std::vector<size_t>& cluster) {
+    // the pose graph edges, between poses numbered as in keys
+    GenericGraph3D edges;
+    for (size_t f = 0; f < graph.size(); ++f) {
+      if (!graph[f] || graph[f]->size() != 2)
+        continue;
+      FastMap<Key, size_t>::const_iterator i = index.find(graph[f]->keys()[0]);
+      FastMap<Key, size_t>::const_iterator j = index.find(graph[f]->keys()[1]);
+      if (i != index.end() && j != index.end() && i->second != j->second)
+        edges.push_back(boost::make_shared<GenericFactor3D>(i->second, j->second, f,
+            NODE_POSE_3D, NODE_POSE_3D));
+    }
+
+    // the leaves of the nested dissection are the clusters
+    std::vector<size_t> indices(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+      indices[i] = i;
+    WorkSpace workspace(keys.size());
+    boost::shared_ptr<SeparatorTree> tree = recursiveSeparator(edges, indices, clusterSize, workspace);
+    const size_t none = keys.size();
+    cluster.assign(keys.size(), none);
+    size_t nrClusters = 0;
+    internal::collectLeaves(*tree, cluster, nrClusters);
+
+    // separator poses join the cluster of a neighbor, unconnected ones are clusters of their own
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      BOOST_FOREACH(const sharedGenericFactor3D& edge, edges) {
+        size_t& c1 = cluster[edge->key1.index];
+        size_t& c2 = cluster[edge->key2.index];
+        if (c1 == none && c2 != none) {
+          c1 = c2;
+          changed = true;
+        } else if (c2 == none && c1 != none) {
+          c2 = c1;
+          changed = true;
+        }
+      }
+    }
+    BOOST_FOREACH(size_t& c, cluster)
+      if (c == none)
+        c = nrClusters++;
+    return nrClusters;
+  }
+
+  /* ************************************************************************* */
+  template<class POSE>
+  Values MultilevelOptimizer<POSE>::SolveLevel(const NonlinearFactorGraph& graph,
+      const Values& values, const MultilevelParams& params, size_t level) {
+    // the poses of this level
+    std::vector<Key> keys;
+    FastMap<Key, size_t> index;
+    BOOST_FOREACH(const typename Values::ConstFiltered<POSE>::KeyValuePair& key_value, values.filter<POSE>()) {
+      index.insert(std::make_pair(key_value.key, keys.size()));
+      keys.push_back(key_value.key);
+    }
+
+    Values result = values;
+    std::vector<size_t> cluster;
+    const size_t nrClusters = (level < params.maxLevels && keys.size() > params.clusterSize) ?
+        FindClusters(graph, keys, index, params.clusterSize, cluster) : keys.size();
+    if (nrClusters < keys.size()) {
+      gttic(coarsen);
+      // the poses of each cluster with the representative first, and the factors within it
+      std::vector<std::vector<size_t> > clusterPoses(nrClusters), clusterFactors(nrClusters);
+      for (size_t i = 0; i < keys.size(); ++i)
+        clusterPoses[cluster[i]].push_back(i);
+      for (size_t f = 0; f < graph.size(); ++f) {
+        if (!graph[f] || graph[f]->size() < 2)
+          continue;
+        size_t c = nrClusters;
+        BOOST_FOREACH(Key key, graph[f]->keys()) {
+          FastMap<Key, size_t>::const_iterator i = index.find(key);
+          if (i == index.end() || (c != nrClusters && cluster[i->second] != c)) {
+            c = nrClusters;
+            break;
+          }
+          c = cluster[i->second];
+        }
+        if (c != nrClusters)
+          clusterFactors[c].push_back(f);
+      }
+
+      // solve the clusters
+      typename internal::ClusterSolver<POSE>::Poses offsets(keys.size());
+      internal::ClusterSolver<POSE> solver(graph, values, keys, clusterPoses, clusterFactors,
+          params.coarseParams, offsets);
+#ifdef GTSAM_USE_TBB
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, nrClusters), solver);
+#else
+      for (size_t c = 0; c < nrClusters; ++c)
+        solver.solve(c);
+#endif
+
+      // collapse the pose factors into factors on the representatives
+      NonlinearFactorGraph coarse;
+      BOOST_FOREACH(const NonlinearFactor::shared_ptr& factor, graph) {
+        if (const BetweenFactor<POSE>* between = dynamic_cast<const BetweenFactor<POSE>*>(factor.get())) {
+          const size_t i = index.at(between->key1()), j = index.at(between->key2());
+          if (cluster[i] != cluster[j])
+            coarse.push_back(boost::make_shared<BetweenFactor<POSE> >(
+                keys[clusterPoses[cluster[i]].front()], keys[clusterPoses[cluster[j]].front()],
+                traits<POSE>::Compose(traits<POSE>::Compose(offsets[i], between->measured()),
+                    traits<POSE>::Inverse(offsets[j])), between->get_noiseModel()));
+        } else if (const PriorFactor<POSE>* prior = dynamic_cast<const PriorFactor<POSE>*>(factor.get())) {
+          const size_t i = index.at(prior->key());
+          coarse.push_back(boost::make_shared<PriorFactor<POSE> >(keys[clusterPoses[cluster[i]].front()],
+              traits<POSE>::Compose(prior->prior(), traits<POSE>::Inverse(offsets[i])),
+              prior->get_noiseModel()));
+        }
+      }
+      Values coarseValues;
+      BOOST_FOREACH(Key key, coarse.keys())
+        coarseValues.insert(key, values.at(key));
+      gttoc(coarsen);
+
+      // solve the coarser levels, and move every cluster with its representative
+      const Values coarseResult = coarse.empty() ? coarseValues :
+          SolveLevel(coarse, coarseValues, params, level + 1);
+      gttic(propagate);
+      for (size_t c = 0; c < nrClusters; ++c) {
+        const Key representative = keys[clusterPoses[c].front()];
+        const POSE& origin = coarseResult.exists(representative) ?
+            coarseResult.at<POSE>(representative) : values.at<POSE>(representative);
+        BOOST_FOREACH(size_t i, clusterPoses[c])
+          result.update(keys[i], traits<POSE>::Compose(origin, offsets[i]));
+      }
+    }
+
+    // the fine level is left to the Levenberg-Marquardt iterations of the optimizer
+    if (level > 0) {
+      gttic(solve_coarse_level);
+      result = LevenbergMarquardtOptimizer(graph, result, params.coarseParams).optimize();
+    }
+    return result;
+  }
+
+}} // namespace
@@ -0,0 +1,76 @@
+/*
+ * MultilevelOptimizer.h
+ *
+ *   Created on: Oct 15, 2026
+ *  Description: coarse-to-fine Levenberg-Marquardt for large pose graphs
+ */
+
+#pragma once
+
+#include <vector>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+
+namespace gtsam { namespace partition {
+
+  /** Parameters of MultilevelOptimizer, the inherited LevenbergMarquardtParams control the fine iterations */
+  class MultilevelParams : public LevenbergMarquardtParams {
+  public:
+    size_t clusterSize;  ///< The largest nested dissection leaf collapsed into one pose of the next coarser level (default: 64)
+    size_t maxLevels;    ///< The largest number of coarse levels (default: 8)
+    LevenbergMarquardtParams coarseParams; ///< The parameters of the cluster and coarse level solves (default: at most 10 iterations)
+
+    MultilevelParams() : clusterSize(64), maxLevels(8) {
+      coarseParams.maxIterations = 10;
+    }
+    virtual ~MultilevelParams() {}
+  };
+
+  /**
+   * Levenberg-Marquardt on a pose graph, initialized by solving a hierarchy of coarser pose graphs.
+   *
+   * At every level, the poses are clustered by recursiveSeparator: the leaves of the separator tree
+   * are the clusters, and the separator poses join an adjacent cluster.  Every cluster is solved on
+   * its own, its factors fixing the poses relative to its first pose, the representative.  The next
+   * coarser level has one pose per cluster, the representative, and every BetweenFactor<POSE> and
+   * PriorFactor<POSE> of the level is collapsed into a factor on the representatives, using the
+   * relative poses of the cluster solution; BetweenFactors within a cluster and all other factors
+   * are dropped.  Starting from the coarsest level, each level is solved with
+   * MultilevelParams::coarseParams and its solution is propagated down, moving every cluster
+   * rigidly with its representative.  The constructor computes this initialization, and the
+   * iterations of the optimizer are ordinary Levenberg-Marquardt iterations on the full graph.
+   *
+   * Values that are not poses keep their initial value.
+   */
+  template<class POSE>
+  class MultilevelOptimizer : public LevenbergMarquardtOptimizer {
+  protected:
+    MultilevelParams multilevelParams_;
+
+  public:
+    typedef boost::shared_ptr<MultilevelOptimizer> shared_ptr;
+
+    /** Initialize with the coarse levels, see Initialize, and set up the fine iterations */
+    MultilevelOptimizer(const NonlinearFactorGraph& graph, const Values& initialValues,
+        const MultilevelParams& params = MultilevelParams()) :
+      LevenbergMarquardtOptimizer(graph, Initialize(graph, initialValues, params), params),
+      multilevelParams_(params) {}
+
+    virtual ~MultilevelOptimizer() {}
+
+    const MultilevelParams& multilevelParams() const { return multilevelParams_; }
+
+    /** The initialization propagated down from the coarse levels, without fine iterations */
+    static Values Initialize(const NonlinearFactorGraph& graph, const Values& initialValues,
+        const MultilevelParams& params);
+
+  private:
+    /** Initialize \c values with the coarser levels, and solve them if this is a coarse level */
+    static Values SolveLevel(const NonlinearFactorGraph& graph, const Values& values,
+        const MultilevelParams& params, size_t level);
+
+    /** Assign the poses to clusters, returning the number of clusters */
+    static size_t FindClusters(const NonlinearFactorGraph& graph, const std::vector<Key>& keys,
+        const FastMap<Key, size_t>& index, size_t clusterSize, std::vector<size_t>& cluster);
+  };
+
+}} // namespace
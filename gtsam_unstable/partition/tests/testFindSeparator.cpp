@@ -226,6 +226,56 @@ TEST ( Partition, findSeparator3_with_reduced_camera )
   LONGS_EQUAL(2, partitionTable[28]);
 }
 
+/* ************************************************************************* */
+namespace {
+  // collect the keys of a separator tree, and return the size of the largest leaf
+  size_t collectKeys(const SeparatorTree& tree, vector<size_t>& keys) {
+    size_t largestLeaf = tree.children.empty() ? tree.keys.size() : 0;
+    keys.insert(keys.end(), tree.keys.begin(), tree.keys.end());
+    BOOST_FOREACH(const boost::shared_ptr<SeparatorTree>& child, tree.children)
+      largestLeaf = max(largestLeaf, collectKeys(*child, keys));
+    return largestLeaf;
+  }
+}
+
+// 10x10 grid of poses
+TEST ( Partition, recursiveSeparator )
+{
+  const size_t N = 10;
+  GenericGraph2D graph;
+  for (size_t i = 0; i < N; i++)
+    for (size_t j = 0; j < N; j++) {
+      if (i + 1 < N) graph.push_back(boost::make_shared<GenericFactor2D>(i*N+j, NODE_POSE_2D, (i+1)*N+j, NODE_POSE_2D));
+      if (j + 1 < N) graph.push_back(boost::make_shared<GenericFactor2D>(i*N+j, NODE_POSE_2D, i*N+j+1, NODE_POSE_2D));
+    }
+  std::vector<size_t> keys;
+  for (size_t i = 0; i < N*N; i++)
+    keys.push_back(i);
+
+  WorkSpace workspace(N*N);
+  boost::shared_ptr<SeparatorTree> tree = recursiveSeparator<GenericGraph2D>(graph, keys, 8, workspace);
+  LONGS_EQUAL(2, tree->children.size());
+  CHECK(!tree->keys.empty());
+
+  // every key is in exactly one node, and the leaves are small
+  vector<size_t> actual;
+  CHECK(collectKeys(*tree, actual) <= 8);
+  sort(actual.begin(), actual.end());
+  CHECK(keys == actual);
+
+  // the root separator disconnects the two subtrees
+  vector<int> side(N*N, -1);
+  for (size_t c = 0; c < 2; c++) {
+    vector<size_t> childKeys;
+    collectKeys(*tree->children[c], childKeys);
+    BOOST_FOREACH(size_t key, childKeys)
+      side[key] = c;
+  }
+  BOOST_FOREACH(const sharedGenericFactor2D& factor, graph)
+    CHECK(side[factor->key1.index] < 0 || side[factor->key2.index] < 0 ||
+        side[factor->key1.index] == side[factor->key2.index]);
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -0,0 +1,84 @@
+/*
+ * testMultilevelOptimizer.cpp
+ *
+ *   Created on: Oct 15, 2026
+ *  Description: unit tests for MultilevelOptimizer
+ */
+
+#include <gtsam_unstable/partition/MultilevelOptimizer-inl.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+#include <cmath>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam::partition;
+
+/* ************************************************************************* */
+// N x N grid of poses with exact relative measurements between neighbors, and a poor initialization
+namespace {
+  const size_t N = 12;
+
+  Pose2 truePose(size_t i, size_t j) {
+    return Pose2(i + 0.1 * j, j, 0.15 * i - 0.1 * j);
+  }
+
+  void createGrid(NonlinearFactorGraph& graph, Values& truth, Values& initial) {
+    noiseModel::Diagonal::shared_ptr model = noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.1, 0.05));
+    for (size_t i = 0; i < N; i++)
+      for (size_t j = 0; j < N; j++) {
+        const Key key = symbol('x', i * N + j);
+        const double k = i * N + j;
+        truth.insert(key, truePose(i, j));
+        initial.insert(key, truePose(i, j) * Pose2(0.3 * sin(k), 0.3 * cos(k), 0.5 * sin(1.7 * k)));
+        if (i + 1 < N)
+          graph.push_back(BetweenFactor<Pose2>(key, symbol('x', (i + 1) * N + j),
+              truePose(i, j).between(truePose(i + 1, j)), model));
+        if (j + 1 < N)
+          graph.push_back(BetweenFactor<Pose2>(key, symbol('x', i * N + j + 1),
+              truePose(i, j).between(truePose(i, j + 1)), model));
+      }
+    graph.push_back(PriorFactor<Pose2>(symbol('x', 0), truePose(0, 0), model));
+  }
+}
+
+/* ************************************************************************* */
+TEST ( MultilevelOptimizer, initialize )
+{
+  NonlinearFactorGraph graph;
+  Values truth, initial;
+  createGrid(graph, truth, initial);
+
+  MultilevelParams params;
+  params.clusterSize = 8;
+  Values actual = MultilevelOptimizer<Pose2>::Initialize(graph, initial, params);
+  LONGS_EQUAL(initial.size(), actual.size());
+  CHECK(graph.error(actual) < 1e-3 * graph.error(initial));
+
+  // a graph no larger than a cluster is not coarsened
+  params.clusterSize = N * N;
+  CHECK(assert_equal(initial, MultilevelOptimizer<Pose2>::Initialize(graph, initial, params)));
+}
+
+/* ************************************************************************* */
+TEST ( MultilevelOptimizer, optimize )
+{
+  NonlinearFactorGraph graph;
+  Values truth, initial;
+  createGrid(graph, truth, initial);
+
+  MultilevelParams params;
+  params.clusterSize = 8;
+  params.maxIterations = 5;
+  MultilevelOptimizer<Pose2> optimizer(graph, initial, params);
+  Values actual = optimizer.optimize();
+  CHECK(assert_equal(truth, actual, 1e-5));
+  CHECK(optimizer.iterations() <= 3);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
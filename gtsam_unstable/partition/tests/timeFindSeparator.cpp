@@ -0,0 +1,58 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeFindSeparator.cpp
+ * @brief   Time a single METIS bisection and the recursive separator tree on a 2D grid
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam_unstable/partition/FindSeparator-inl.h>
+#include <gtsam_unstable/partition/GenericGraph.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/make_shared.hpp>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam::partition;
+
+int main(int argc, char *argv[]) {
+  // an N x N grid of poses, with N from the command line
+  const size_t N = argc > 1 ? atoi(argv[1]) : 300;
+  GenericGraph2D graph;
+  for (size_t i = 0; i < N; i++)
+    for (size_t j = 0; j < N; j++) {
+      if (i + 1 < N) graph.push_back(boost::make_shared<GenericFactor2D>(i*N+j, NODE_POSE_2D, (i+1)*N+j, NODE_POSE_2D));
+      if (j + 1 < N) graph.push_back(boost::make_shared<GenericFactor2D>(i*N+j, NODE_POSE_2D, i*N+j+1, NODE_POSE_2D));
+    }
+  vector<size_t> keys;
+  for (size_t i = 0; i < N*N; i++)
+    keys.push_back(i);
+  cout << "Grid of " << N << " x " << N << " poses" << endl;
+
+  WorkSpace workspace(N*N);
+  for (size_t trial = 0; trial < 5; trial++) {
+    gttic_(separatorPartitionByMetis);
+    separatorPartitionByMetis<GenericGraph2D>(graph, keys, workspace, false);
+    gttoc_(separatorPartitionByMetis);
+
+    gttic_(recursiveSeparator);
+    recursiveSeparator<GenericGraph2D>(graph, keys, 100, workspace);
+    gttoc_(recursiveSeparator);
+    tictoc_finishedIteration_();
+  }
+
+  tictoc_print_();
+  return 0;
+}
@@ -22,6 +22,7 @@
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/linear/GaussianFactor.h>
 #include <gtsam/nonlinear/Marginals.h>
+#include <gtsam_unstable/slam/IndicatorProbabilities.h>
 
 namespace gtsam {
 
@@ -55,6 +56,10 @@ private:
 
   bool flag_bump_up_near_zero_probs_;
 
+  // sqrt(det(R'R)) of the inlier and outlier models, cached as they only change with the models
+  double normalizer_inlier_;
+  double normalizer_outlier_;
+
   /** concept check by type */
   GTSAM_CONCEPT_LIE_TYPE(T)GTSAM_CONCEPT_TESTABLE_TYPE(T)
 
@@ -64,7 +69,8 @@ public:
   typedef typename boost::shared_ptr<BetweenFactorEM> shared_ptr;
 
   /** default constructor - only use for serialization */
-  BetweenFactorEM() {
+  BetweenFactorEM() :
+      normalizer_inlier_(0.0), normalizer_outlier_(0.0) {
   }
 
   /** Constructor */
@@ -76,6 +82,7 @@ public:
           measured), model_inlier_(model_inlier), model_outlier_(model_outlier), prior_inlier_(
           prior_inlier), prior_outlier_(prior_outlier), flag_bump_up_near_zero_probs_(
           flag_bump_up_near_zero_probs) {
+    cacheNormalizers();
   }
 
   virtual ~BetweenFactorEM() {
@@ -154,44 +161,31 @@ public:
 
     Matrix H1, H2;
 
-    T hx = p1.between(p2, H1, H2); // h(x)
+    // only ask for the Jacobians of between when they are needed
+    T hx = H ? p1.between(p2, H1, H2) : p1.between(p2); // h(x)
     // manifold equivalent of h(x)-z -> log(z,h(x))
 
     Vector err = measured_.localCoordinates(hx);
 
-    // Calculate indicator probabilities (inlier and outlier)
-    Vector p_inlier_outlier = calcIndicatorProb(x);
-    double p_inlier = p_inlier_outlier[0];
-    double p_outlier = p_inlier_outlier[1];
-
-    Vector err_wh_inlier = model_inlier_->whiten(err);
-    Vector err_wh_outlier = model_outlier_->whiten(err);
-
-    Matrix invCov_inlier = model_inlier_->R().transpose() * model_inlier_->R();
-    Matrix invCov_outlier = model_outlier_->R().transpose()
-        * model_outlier_->R();
+    // Calculate indicator probabilities (inlier and outlier) from the same error
+    Vector p_inlier_outlier = calcIndicatorProb(err);
+    double sqrt_p_inlier = std::sqrt(p_inlier_outlier[0]);
+    double sqrt_p_outlier = std::sqrt(p_inlier_outlier[1]);
 
-    Vector err_wh_eq;
-    err_wh_eq.resize(err_wh_inlier.rows() * 2);
-    err_wh_eq << sqrt(p_inlier) * err_wh_inlier.array(), sqrt(p_outlier)
-        * err_wh_outlier.array();
+    const size_t d = err.size();
+    Vector err_wh_eq(2 * d);
+    err_wh_eq << sqrt_p_inlier * model_inlier_->whiten(err), sqrt_p_outlier
+        * model_outlier_->whiten(err);
 
     if (H) {
       // stack Jacobians for the two indicators for each of the key
+      (*H)[0].resize(2 * d, H1.cols());
+      (*H)[0] << sqrt_p_inlier * model_inlier_->Whiten(H1), sqrt_p_outlier
+          * model_outlier_->Whiten(H1);
 
-      Matrix H1_inlier = sqrt(p_inlier) * model_inlier_->Whiten(H1);
-      Matrix H1_outlier = sqrt(p_outlier) * model_outlier_->Whiten(H1);
-      Matrix H1_aug = gtsam::stack(2, &H1_inlier, &H1_outlier);
-
-      Matrix H2_inlier = sqrt(p_inlier) * model_inlier_->Whiten(H2);
-      Matrix H2_outlier = sqrt(p_outlier) * model_outlier_->Whiten(H2);
-      Matrix H2_aug = gtsam::stack(2, &H2_inlier, &H2_outlier);
-
-      (*H)[0].resize(H1_aug.rows(), H1_aug.cols());
-      (*H)[1].resize(H2_aug.rows(), H2_aug.cols());
-
-      (*H)[0] = H1_aug;
-      (*H)[1] = H2_aug;
+      (*H)[1].resize(2 * d, H2.cols());
+      (*H)[1] << sqrt_p_inlier * model_inlier_->Whiten(H2), sqrt_p_outlier
+          * model_outlier_->Whiten(H2);
     }
 
     if (debug) {
@@ -230,22 +224,22 @@ public:
 
   /* ************************************************************************* */
   gtsam::Vector calcIndicatorProb(const gtsam::Values& x) const {
+    return calcIndicatorProb(unwhitenedError(x));
+  }
 
-    bool debug = false;
+  /* ************************************************************************* */
+  /** indicator probabilities (inlier and outlier) given the unwhitened error */
+  gtsam::Vector calcIndicatorProb(const gtsam::Vector& err) const {
 
-    Vector err = unwhitenedError(x);
+    bool debug = false;
 
     // Calculate indicator probabilities (inlier and outlier)
     Vector err_wh_inlier = model_inlier_->whiten(err);
     Vector err_wh_outlier = model_outlier_->whiten(err);
 
-    Matrix invCov_inlier = model_inlier_->R().transpose() * model_inlier_->R();
-    Matrix invCov_outlier = model_outlier_->R().transpose()
-        * model_outlier_->R();
-
-    double p_inlier = prior_inlier_ * std::sqrt(invCov_inlier.determinant())
+    double p_inlier = prior_inlier_ * normalizer_inlier_
         * exp(-0.5 * err_wh_inlier.dot(err_wh_inlier));
-    double p_outlier = prior_outlier_ * std::sqrt(invCov_outlier.determinant())
+    double p_outlier = prior_outlier_ * normalizer_outlier_
         * exp(-0.5 * err_wh_outlier.dot(err_wh_outlier));
 
     if (debug) {
@@ -284,15 +278,25 @@ public:
     return (Vector(2) << p_inlier, p_outlier).finished();
   }
 
+  /* ************************************************************************* */
+  /**
+   * Indicator probabilities of all the BetweenFactorEM<VALUE> factors in a graph, computed in
+   * parallel when TBB is enabled.
+   * @return 2*n matrix with the inlier and outlier probabilities of each factor in a column
+   * @param indices optional, filled with the index in the graph of each column
+   */
+  static Matrix CalcIndicatorProbs(const gtsam::NonlinearFactorGraph& graph,
+      const gtsam::Values& x, std::vector<size_t>* indices = 0) {
+    return internal::CalcIndicatorProbs<This>(graph, x, indices);
+  }
+
   /* ************************************************************************* */
   gtsam::Vector unwhitenedError(const gtsam::Values& x) const {
 
     const T& p1 = x.at<T>(key1_);
     const T& p2 = x.at<T>(key2_);
 
-    Matrix H1, H2;
-
-    T hx = p1.between(p2, H1, H2); // h(x)
+    T hx = p1.between(p2); // h(x)
 
     return measured_.localCoordinates(hx);
   }
@@ -393,6 +397,8 @@ public:
     model_outlier_ = gtsam::noiseModel::Gaussian::Covariance(
         covRoutlier + cov_state);
 
+    cacheNormalizers();
+
     //       model_inlier_->print("after:");
     //       std::cout<<"covRinlier + cov_state: "<<covRinlier + cov_state<<std::endl;
   }
@@ -414,6 +420,14 @@ public:
 
 private:
 
+  /** compute the normalizers of the indicator probabilities, call whenever the models change */
+  void cacheNormalizers() {
+    normalizer_inlier_ = std::sqrt(
+        (model_inlier_->R().transpose() * model_inlier_->R()).determinant());
+    normalizer_outlier_ = std::sqrt(
+        (model_outlier_->R().transpose() * model_outlier_->R()).determinant());
+  }
+
   /** Serialization function */
   friend class boost::serialization::access;
   template<class ARCHIVE>
@@ -0,0 +1,83 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  IndicatorProbabilities.h
+ *  @brief Inlier and outlier probabilities of all the EM factors of a graph at once
+ *  @date  Oct 15, 2026
+ **/
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <vector>
+
+namespace gtsam {
+namespace internal {
+
+#ifdef GTSAM_USE_TBB
+/// Compute the indicator probabilities of a range of factors, the body of tbb::parallel_for
+template<class FACTOR>
+class CalcIndicatorProbsRange {
+  const std::vector<const FACTOR*>& factors_;
+  const Values& x_;
+  Matrix& probs_;
+public:
+  CalcIndicatorProbsRange(const std::vector<const FACTOR*>& factors, const Values& x,
+      Matrix& probs) :
+      factors_(factors), x_(x), probs_(probs) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& range) const {
+    for (size_t i = range.begin(); i != range.end(); ++i)
+      probs_.col(i) = factors_[i]->calcIndicatorProb(x_);
+  }
+};
+#endif
+
+/**
+ * The inlier and outlier probabilities of all the factors of type FACTOR in a graph, computed in
+ * parallel when TBB is enabled.
+ * @return 2*n matrix with the probabilities of each factor in a column, in the order of the graph
+ * @param indices optional, filled with the index in the graph of each column
+ */
+template<class FACTOR>
+Matrix CalcIndicatorProbs(const NonlinearFactorGraph& graph, const Values& x,
+    std::vector<size_t>* indices) {
+  std::vector<const FACTOR*> factors;
+  if (indices)
+    indices->clear();
+  for (size_t i = 0; i < graph.size(); ++i) {
+    if (const FACTOR* factor = dynamic_cast<const FACTOR*>(graph[i].get())) {
+      factors.push_back(factor);
+      if (indices)
+        indices->push_back(i);
+    }
+  }
+
+  Matrix probs(2, factors.size());
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, factors.size(), 64),
+      CalcIndicatorProbsRange<FACTOR>(factors, x, probs));
+#else
+  for (size_t i = 0; i < factors.size(); ++i)
+    probs.col(i) = factors[i]->calcIndicatorProb(x);
+#endif
+  return probs;
+}
+
+} // namespace internal
+} // namespace gtsam
@@ -15,7 +15,7 @@
 #include <gtsam/geometry/Cal3_S2.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Point2.h>
-#include <gtsam/base/numericalDerivative.h>
+#include <gtsam_unstable/geometry/InvDepthCamera3.h>
 
 namespace gtsam {
 
@@ -78,17 +78,26 @@ public:
         && this->K_->equals(*e->K_, tol);
   }
 
-  Vector inverseDepthError(const Pose3& pose, const Vector6& landmark) const {
+  /// Reprojection error, with optional fixed-size Jacobians
+  Vector inverseDepthError(const Pose3& pose, const Vector6& landmark,
+      OptionalJacobian<2, 6> H1 = boost::none, OptionalJacobian<2, 6> H2 = boost::none) const {
     try {
       // Calculate the 3D coordinates of the landmark in the world frame
-      double x = landmark(0), y = landmark(1), z = landmark(2);
-      double theta = landmark(3), phi = landmark(4), rho = landmark(5);
-      Point3 world_P_landmark = Point3(x, y, z) + Point3(cos(theta)*cos(phi)/rho, sin(theta)*cos(phi)/rho, sin(phi)/rho);
+      Matrix35 Dpoint_pw;
+      Matrix31 Dpoint_rho;
+      Point3 world_P_landmark = InvDepthCamera3<Cal3_S2>::invDepthTo3D(landmark.head<5>(),
+          landmark(5), H2 ? &Dpoint_pw : 0, H2 ? &Dpoint_rho : 0);
       // Project landmark into Pose2
       PinholeCamera<Cal3_S2> camera(pose, *K_);
-      gtsam::Point2 reprojectionError(camera.project(world_P_landmark) - measured_);
+      Matrix23 Dproject_point;
+      gtsam::Point2 reprojectionError(camera.project(world_P_landmark, H1,
+          H2 ? &Dproject_point : 0) - measured_);
+      if (H2)
+        *H2 << Dproject_point * Dpoint_pw, Dproject_point * Dpoint_rho;
       return reprojectionError.vector();
     } catch( CheiralityException& e) {
+      if (H1) H1->setZero();
+      if (H2) H2->setZero();
       std::cout << e.what()
           << ": Inverse Depth Landmark [" << DefaultKeyFormatter(this->key2()) << "]"
           << " moved behind camera [" << DefaultKeyFormatter(this->key1()) <<"]"
@@ -102,19 +111,11 @@ public:
   Vector evaluateError(const Pose3& pose, const Vector6& landmark,
       boost::optional<gtsam::Matrix&> H1=boost::none,
       boost::optional<gtsam::Matrix&> H2=boost::none) const {
-
-    if (H1) {
-      (*H1) = numericalDerivative11<Vector, Pose3>(
-          boost::bind(&InvDepthFactorVariant1::inverseDepthError, this, _1,
-              landmark), pose);
-    }
-    if (H2) {
-      (*H2) = numericalDerivative11<Vector, Vector6>(
-          boost::bind(&InvDepthFactorVariant1::inverseDepthError, this, pose,
-              _1), landmark);
-    }
-
-    return inverseDepthError(pose, landmark);
+    Matrix26 Dpose, Dlandmark;
+    Vector error = inverseDepthError(pose, landmark, H1 ? &Dpose : 0, H2 ? &Dlandmark : 0);
+    if (H1) *H1 = Dpose;
+    if (H2) *H2 = Dlandmark;
+    return error;
   }
 
   /** return the measurement */
@@ -16,7 +16,7 @@
 #include <gtsam/geometry/Cal3_S2.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Point2.h>
-#include <gtsam/base/numericalDerivative.h>
+#include <gtsam_unstable/geometry/InvDepthCamera3.h>
 
 namespace gtsam {
 
@@ -82,16 +82,28 @@ public:
         && this->referencePoint_.equals(e->referencePoint_, tol);
   }
 
-  Vector inverseDepthError(const Pose3& pose, const Vector3& landmark) const {
+  /// Reprojection error, with optional fixed-size Jacobians
+  Vector inverseDepthError(const Pose3& pose, const Vector3& landmark,
+      OptionalJacobian<2, 6> H1 = boost::none, OptionalJacobian<2, 3> H2 = boost::none) const {
     try {
       // Calculate the 3D coordinates of the landmark in the world frame
-      double theta = landmark(0), phi = landmark(1), rho = landmark(2);
-      Point3 world_P_landmark = referencePoint_ + Point3(cos(theta)*cos(phi)/rho, sin(theta)*cos(phi)/rho, sin(phi)/rho);
+      Vector5 pw;
+      pw << referencePoint_.vector(), landmark(0), landmark(1);
+      Matrix35 Dpoint_pw;
+      Matrix31 Dpoint_rho;
+      Point3 world_P_landmark = InvDepthCamera3<Cal3_S2>::invDepthTo3D(pw, landmark(2),
+          H2 ? &Dpoint_pw : 0, H2 ? &Dpoint_rho : 0);
       // Project landmark into Pose2
       PinholeCamera<Cal3_S2> camera(pose, *K_);
-      gtsam::Point2 reprojectionError(camera.project(world_P_landmark) - measured_);
+      Matrix23 Dproject_point;
+      gtsam::Point2 reprojectionError(camera.project(world_P_landmark, H1,
+          H2 ? &Dproject_point : 0) - measured_);
+      if (H2)
+        *H2 << Dproject_point * Dpoint_pw.rightCols<2>(), Dproject_point * Dpoint_rho;
       return reprojectionError.vector();
     } catch( CheiralityException& e) {
+      if (H1) H1->setZero();
+      if (H2) H2->setZero();
       std::cout << e.what()
           << ": Inverse Depth Landmark [" << DefaultKeyFormatter(this->key2()) << "]"
           << " moved behind camera [" << DefaultKeyFormatter(this->key1()) <<"]"
@@ -105,19 +117,12 @@ public:
   Vector evaluateError(const Pose3& pose, const Vector3& landmark,
       boost::optional<gtsam::Matrix&> H1=boost::none,
       boost::optional<gtsam::Matrix&> H2=boost::none) const {
-
-    if (H1) {
-      (*H1) = numericalDerivative11<Vector, Pose3>(
-          boost::bind(&InvDepthFactorVariant2::inverseDepthError, this, _1,
-              landmark), pose);
-    }
-    if (H2) {
-      (*H2) = numericalDerivative11<Vector, Vector3>(
-          boost::bind(&InvDepthFactorVariant2::inverseDepthError, this, pose,
-              _1), landmark);
-    }
-
-    return inverseDepthError(pose, landmark);
+    Matrix26 Dpose;
+    Matrix23 Dlandmark;
+    Vector error = inverseDepthError(pose, landmark, H1 ? &Dpose : 0, H2 ? &Dlandmark : 0);
+    if (H1) *H1 = Dpose;
+    if (H2) *H2 = Dlandmark;
+    return error;
   }
 
   /** return the measurement */
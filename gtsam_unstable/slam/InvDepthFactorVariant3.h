@@ -15,10 +15,28 @@
 #include <gtsam/geometry/Cal3_S2.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Point2.h>
-#include <gtsam/base/numericalDerivative.h>
 
 namespace gtsam {
 
+/**
+ * Convert a (theta,phi,rho) landmark to a Point3 in the frame of its reference pose,
+ * with the camera looking along z: p = (cos(phi)*sin(theta), sin(phi), cos(phi)*cos(theta))/rho
+ * @param landmark the inverse depth landmark (theta,phi,rho)
+ * @param H optional 3*3 Jacobian w.r.t. the landmark
+ */
+inline Point3 InvDepthToPoint3(const Vector3& landmark, OptionalJacobian<3, 3> H = boost::none) {
+  const double cos_theta = cos(landmark(0)), sin_theta = sin(landmark(0));
+  const double cos_phi = cos(landmark(1)), sin_phi = sin(landmark(1));
+  const double rho = landmark(2);
+  const Vector3 m(cos_phi*sin_theta, sin_phi, cos_phi*cos_theta);
+  if (H) {
+    H->col(0) << cos_phi*cos_theta/rho, 0.0, -cos_phi*sin_theta/rho;
+    H->col(1) << -sin_phi*sin_theta/rho, cos_phi/rho, -sin_phi*cos_theta/rho;
+    H->col(2) = -m/(rho*rho);
+  }
+  return Point3(m/rho);
+}
+
 /**
  * Binary factor representing the first visual measurement using an inverse-depth parameterization
  */
@@ -80,18 +98,30 @@ public:
         && this->K_->equals(*e->K_, tol);
   }
 
-  Vector inverseDepthError(const Pose3& pose, const Vector3& landmark) const {
+  /// Reprojection error, with optional fixed-size Jacobians
+  Vector inverseDepthError(const Pose3& pose, const Vector3& landmark,
+      OptionalJacobian<2, 6> H1 = boost::none, OptionalJacobian<2, 3> H2 = boost::none) const {
     try {
       // Calculate the 3D coordinates of the landmark in the Pose frame
-      double theta = landmark(0), phi = landmark(1), rho = landmark(2);
-      Point3 pose_P_landmark(cos(phi)*sin(theta)/rho, sin(phi)/rho, cos(phi)*cos(theta)/rho);
+      Matrix3 Dpoint_landmark;
+      Point3 pose_P_landmark = InvDepthToPoint3(landmark, H2 ? &Dpoint_landmark : 0);
       // Convert the landmark to world coordinates
-      Point3 world_P_landmark = pose.transform_from(pose_P_landmark);
+      Matrix36 Dworld_pose;
+      Matrix3 Dworld_point;
+      Point3 world_P_landmark = pose.transform_from(pose_P_landmark,
+          H1 ? &Dworld_pose : 0, H2 ? &Dworld_point : 0);
       // Project landmark into Pose2
       PinholeCamera<Cal3_S2> camera(pose, *K_);
-      gtsam::Point2 reprojectionError(camera.project(world_P_landmark) - measured_);
+      Matrix26 Dproject_pose;
+      Matrix23 Dproject_world;
+      gtsam::Point2 reprojectionError(camera.project(world_P_landmark,
+          H1 ? &Dproject_pose : 0, H1 || H2 ? &Dproject_world : 0) - measured_);
+      if (H1) *H1 = Dproject_pose + Dproject_world * Dworld_pose;
+      if (H2) *H2 = Dproject_world * Dworld_point * Dpoint_landmark;
       return reprojectionError.vector();
     } catch( CheiralityException& e) {
+      if (H1) H1->setZero();
+      if (H2) H2->setZero();
       std::cout << e.what()
           << ": Inverse Depth Landmark [" << DefaultKeyFormatter(this->key1()) << "," << DefaultKeyFormatter(this->key2()) << "]"
           << " moved behind camera [" << DefaultKeyFormatter(this->key1()) << "]"
@@ -105,15 +135,12 @@ public:
   Vector evaluateError(const Pose3& pose, const Vector3& landmark,
       boost::optional<gtsam::Matrix&> H1=boost::none,
       boost::optional<gtsam::Matrix&> H2=boost::none) const {
-
-    if(H1) {
-      (*H1) = numericalDerivative11<Vector,Pose3>(boost::bind(&InvDepthFactorVariant3a::inverseDepthError, this, _1, landmark), pose);
-    }
-    if(H2) {
-      (*H2) = numericalDerivative11<Vector,Vector3>(boost::bind(&InvDepthFactorVariant3a::inverseDepthError, this, pose, _1), landmark);
-    }
-
-    return inverseDepthError(pose, landmark);
+    Matrix26 Dpose;
+    Matrix23 Dlandmark;
+    Vector error = inverseDepthError(pose, landmark, H1 ? &Dpose : 0, H2 ? &Dlandmark : 0);
+    if (H1) *H1 = Dpose;
+    if (H2) *H2 = Dlandmark;
+    return error;
   }
 
   /** return the measurement */
@@ -199,18 +226,31 @@ public:
         && this->K_->equals(*e->K_, tol);
   }
 
-  Vector inverseDepthError(const Pose3& pose1, const Pose3& pose2, const Vector3& landmark) const {
+  /// Reprojection error, with optional fixed-size Jacobians
+  Vector inverseDepthError(const Pose3& pose1, const Pose3& pose2, const Vector3& landmark,
+      OptionalJacobian<2, 6> H1 = boost::none, OptionalJacobian<2, 6> H2 = boost::none,
+      OptionalJacobian<2, 3> H3 = boost::none) const {
     try {
       // Calculate the 3D coordinates of the landmark in the Pose1 frame
-      double theta = landmark(0), phi = landmark(1), rho = landmark(2);
-      Point3 pose1_P_landmark(cos(phi)*sin(theta)/rho, sin(phi)/rho, cos(phi)*cos(theta)/rho);
+      Matrix3 Dpoint_landmark;
+      Point3 pose1_P_landmark = InvDepthToPoint3(landmark, H3 ? &Dpoint_landmark : 0);
       // Convert the landmark to world coordinates
-      Point3 world_P_landmark = pose1.transform_from(pose1_P_landmark);
+      Matrix36 Dworld_pose1;
+      Matrix3 Dworld_point;
+      Point3 world_P_landmark = pose1.transform_from(pose1_P_landmark,
+          H1 ? &Dworld_pose1 : 0, H3 ? &Dworld_point : 0);
       // Project landmark into Pose2
       PinholeCamera<Cal3_S2> camera(pose2, *K_);
-      gtsam::Point2 reprojectionError(camera.project(world_P_landmark) - measured_);
+      Matrix23 Dproject_world;
+      gtsam::Point2 reprojectionError(camera.project(world_P_landmark, H2,
+          H1 || H3 ? &Dproject_world : 0) - measured_);
+      if (H1) *H1 = Dproject_world * Dworld_pose1;
+      if (H3) *H3 = Dproject_world * Dworld_point * Dpoint_landmark;
       return reprojectionError.vector();
     } catch( CheiralityException& e) {
+      if (H1) H1->setZero();
+      if (H2) H2->setZero();
+      if (H3) H3->setZero();
       std::cout << e.what()
           << ": Inverse Depth Landmark [" << DefaultKeyFormatter(this->key1()) << "," << DefaultKeyFormatter(this->key3()) << "]"
           << " moved behind camera " << DefaultKeyFormatter(this->key2())
@@ -225,17 +265,14 @@ public:
       boost::optional<gtsam::Matrix&> H1=boost::none,
       boost::optional<gtsam::Matrix&> H2=boost::none,
       boost::optional<gtsam::Matrix&> H3=boost::none) const {
-
-    if(H1)
-      (*H1) = numericalDerivative11<Vector,Pose3>(boost::bind(&InvDepthFactorVariant3b::inverseDepthError, this, _1, pose2, landmark), pose1);
-
-    if(H2)
-      (*H2) = numericalDerivative11<Vector,Pose3>(boost::bind(&InvDepthFactorVariant3b::inverseDepthError, this, pose1, _1, landmark), pose2);
-
-    if(H3)
-      (*H3) = numericalDerivative11<Vector,Vector3>(boost::bind(&InvDepthFactorVariant3b::inverseDepthError, this, pose1, pose2, _1), landmark);
-
-    return inverseDepthError(pose1, pose2, landmark);
+    Matrix26 Dpose1, Dpose2;
+    Matrix23 Dlandmark;
+    Vector error = inverseDepthError(pose1, pose2, landmark, H1 ? &Dpose1 : 0,
+        H2 ? &Dpose2 : 0, H3 ? &Dlandmark : 0);
+    if (H1) *H1 = Dpose1;
+    if (H2) *H2 = Dpose2;
+    if (H3) *H3 = Dlandmark;
+    return error;
   }
 
   /** return the measurement */
@@ -0,0 +1,297 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   RigProjectionFactor.h
+ * @brief  Projection factor for all the observations of a landmark by a multi-camera rig
+ * @date   Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/geometry/CalibratedCamera.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose3.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/serialization/vector.hpp>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Cameras rigidly attached to a body, each with its pose in the body frame and its calibration
+ * @addtogroup SLAM
+ */
+template<class CALIBRATION = Cal3_S2>
+class CameraRig {
+public:
+
+  typedef boost::shared_ptr<CameraRig> shared_ptr;
+
+  CameraRig() {}
+
+  /// Add a camera with the given pose in the body frame, and return its index in the rig
+  size_t add(const Pose3& body_P_sensor, const boost::shared_ptr<CALIBRATION>& K) {
+    body_P_sensors_.push_back(body_P_sensor);
+    K_.push_back(K);
+    return K_.size() - 1;
+  }
+
+  /// Number of cameras
+  size_t size() const { return K_.size(); }
+
+  /// Pose of camera i in the body frame
+  const Pose3& body_P_sensor(size_t i) const { return body_P_sensors_[i]; }
+
+  /// Calibration of camera i
+  const boost::shared_ptr<CALIBRATION>& calibration(size_t i) const { return K_[i]; }
+
+  void print(const std::string& s = "") const {
+    std::cout << s << "CameraRig with " << size() << " cameras\n";
+    for (size_t i = 0; i < size(); ++i) {
+      body_P_sensors_[i].print("  sensor pose in body frame: ");
+      K_[i]->print("  calibration: ");
+    }
+  }
+
+  bool equals(const CameraRig& other, double tol = 1e-9) const {
+    if (size() != other.size())
+      return false;
+    for (size_t i = 0; i < size(); ++i)
+      if (!body_P_sensors_[i].equals(other.body_P_sensors_[i], tol)
+          || !K_[i]->equals(*other.K_[i], tol))
+        return false;
+    return true;
+  }
+
+private:
+
+  std::vector<Pose3> body_P_sensors_;
+  std::vector<boost::shared_ptr<CALIBRATION> > K_;
+
+  /// Serialization function
+  friend class boost::serialization::access;
+  template<class ARCHIVE>
+  void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+    ar & BOOST_SERIALIZATION_NVP(body_P_sensors_);
+    ar & BOOST_SERIALIZATION_NVP(K_);
+  }
+};
+
+/**
+ * Reprojection errors of one landmark in several cameras of a rig, at one body pose: the same
+ * as one GenericProjectionFactor with body_P_sensor per observation, but the landmark is
+ * transformed into the body frame only once, and from there into each camera with the constant
+ * extrinsics, so no camera pose is composed. Linearizes to a single BinaryJacobianFactor with
+ * two rows per observation.
+ * @addtogroup SLAM
+ */
+template<class CALIBRATION = Cal3_S2>
+class RigProjectionFactor: public NoiseModelFactor2<Pose3, Point3> {
+public:
+
+  typedef NoiseModelFactor2<Pose3, Point3> Base;
+  typedef RigProjectionFactor<CALIBRATION> This;
+  typedef boost::shared_ptr<This> shared_ptr;
+  typedef CameraRig<CALIBRATION> Rig;
+
+protected:
+
+  boost::shared_ptr<Rig> rig_;  ///< The cameras and their extrinsics
+  std::vector<size_t> cameras_; ///< Index in the rig of the camera of each measurement
+  std::vector<Point2> measured_; ///< Image measurements
+
+  // verbosity handling for Cheirality Exceptions
+  bool throwCheirality_; ///< If true, rethrows Cheirality exceptions (default: false)
+  bool verboseCheirality_; ///< If true, prints text for Cheirality exceptions (default: false)
+
+public:
+
+  /// Default constructor
+  RigProjectionFactor() : throwCheirality_(false), verboseCheirality_(false) {}
+
+  /**
+   * Constructor
+   * @param rig the cameras of the rig
+   * @param poseKey is the index of the body pose
+   * @param pointKey is the index of the landmark
+   * @param cameras is the index in the rig of the camera of each measurement
+   * @param measured is the image location of the landmark in each of these cameras
+   * @param model is the 2-dimensional noise model of one measurement
+   * @param throwCheirality determines whether Cheirality exceptions are rethrown
+   * @param verboseCheirality determines whether exceptions are printed for Cheirality
+   */
+  RigProjectionFactor(const boost::shared_ptr<Rig>& rig, Key poseKey, Key pointKey,
+      const std::vector<size_t>& cameras, const std::vector<Point2>& measured,
+      const SharedDiagonal& model, bool throwCheirality = false,
+      bool verboseCheirality = false) :
+      Base(Stacked(model, measured.size()), poseKey, pointKey), rig_(rig),
+      cameras_(cameras), measured_(measured), throwCheirality_(throwCheirality),
+      verboseCheirality_(verboseCheirality) {
+    if (cameras.size() != measured.size())
+      throw std::invalid_argument(
+          "RigProjectionFactor: need one camera index per measurement");
+    for (size_t k = 0; k < cameras.size(); ++k)
+      if (cameras[k] >= rig->size())
+        throw std::invalid_argument("RigProjectionFactor: camera index out of range");
+  }
+
+  virtual ~RigProjectionFactor() {}
+
+  /// @return a deep copy of this factor
+  virtual gtsam::NonlinearFactor::shared_ptr clone() const {
+    return boost::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this))); }
+
+  /**
+   * print
+   * @param s optional string naming the factor
+   * @param keyFormatter optional formatter useful for printing Symbols
+   */
+  void print(const std::string& s = "", const KeyFormatter& keyFormatter = DefaultKeyFormatter) const {
+    std::cout << s << "RigProjectionFactor, z = ";
+    for (size_t k = 0; k < measured_.size(); ++k)
+      std::cout << "(" << cameras_[k] << ": " << measured_[k].x() << ", "
+          << measured_[k].y() << ") ";
+    std::cout << "\n";
+    Base::print("", keyFormatter);
+  }
+
+  /// equals
+  virtual bool equals(const NonlinearFactor& p, double tol = 1e-9) const {
+    const This *e = dynamic_cast<const This*>(&p);
+    if (!e || !Base::equals(p, tol) || cameras_ != e->cameras_ || !rig_->equals(*e->rig_, tol))
+      return false;
+    for (size_t k = 0; k < measured_.size(); ++k)
+      if (!measured_[k].equals(e->measured_[k], tol))
+        return false;
+    return true;
+  }
+
+  /// Evaluate the stacked reprojection errors h(x)-z and optionally their derivatives
+  Vector evaluateError(const Pose3& pose, const Point3& point,
+      boost::optional<Matrix&> H1 = boost::none, boost::optional<Matrix&> H2 = boost::none) const {
+    const size_t m = measured_.size();
+    Vector error(2 * m);
+    if (H1) H1->resize(2 * m, 6);
+    if (H2) H2->resize(2 * m, 3);
+
+    // The landmark in the body frame, shared by all cameras
+    Matrix36 Dpose;
+    Matrix3 Dpoint;
+    const Point3 pb = pose.transform_to(point, H1 ? &Dpose : 0, H2 ? &Dpoint : 0);
+
+    for (size_t k = 0; k < m; ++k) {
+      const size_t c = cameras_[k];
+      const Pose3& body_P_sensor = rig_->body_P_sensor(c);
+      const CALIBRATION& K = *rig_->calibration(c);
+
+      // The landmark in the camera frame, whose Jacobian wrpt pb is the constant R'
+      Matrix3 Rt;
+      const Point3 pc = body_P_sensor.transform_to(pb, boost::none, Rt);
+      if (pc.z() <= 0) {
+        if (H1) H1->block<2, 6>(2 * k, 0).setZero();
+        if (H2) H2->block<2, 3>(2 * k, 0).setZero();
+        error.segment<2>(2 * k).setConstant(2.0 * K.fx());
+        if (verboseCheirality_)
+          std::cout << "Cheirality Exception: Landmark " << DefaultKeyFormatter(this->key2())
+              << " moved behind camera " << c << " of " << DefaultKeyFormatter(this->key1())
+              << std::endl;
+        if (throwCheirality_)
+          throw CheiralityException();
+        continue;
+      }
+
+      Matrix23 Dpc;
+      Matrix2 Dpn;
+      const Point2 pn = PinholeBase::Project(pc, (H1 || H2) ? &Dpc : 0);
+      const Point2 pi = K.uncalibrate(pn, boost::none, (H1 || H2) ? &Dpn : 0);
+      error.segment<2>(2 * k) = (pi - measured_[k]).vector();
+      if (H1 || H2) {
+        const Matrix23 Dpb = Dpn * Dpc * Rt;
+        if (H1) H1->block<2, 6>(2 * k, 0) = Dpb * Dpose;
+        if (H2) H2->block<2, 3>(2 * k, 0) = Dpb * Dpoint;
+      }
+    }
+    return error;
+  }
+
+  /// Linearize to a single BinaryJacobianFactor, whitened row by row
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+    const noiseModel::Diagonal* diagonal =
+        dynamic_cast<const noiseModel::Diagonal*>(this->noiseModel_.get());
+    if (!diagonal || diagonal->isConstrained())
+      return Base::linearize(x);
+
+    // Only linearize if the factor is active
+    if (!this->active(x))
+      return boost::shared_ptr<JacobianFactor>();
+
+    Matrix H1, H2;
+    Vector b = -evaluateError(x.at<Pose3>(this->key1()), x.at<Point3>(this->key2()), H1, H2);
+    const Vector& invsigmas = diagonal->invsigmas();
+    H1 = invsigmas.asDiagonal() * H1;
+    H2 = invsigmas.asDiagonal() * H2;
+    b.array() *= invsigmas.array();
+    return boost::make_shared<BinaryJacobianFactor<Eigen::Dynamic, 6, 3> >(this->key1(), H1,
+        this->key2(), H2, b);
+  }
+
+  /// The cameras of the rig
+  const boost::shared_ptr<Rig>& rig() const { return rig_; }
+
+  /// Index in the rig of the camera of each measurement
+  const std::vector<size_t>& cameras() const { return cameras_; }
+
+  /// The measurements
+  const std::vector<Point2>& measured() const { return measured_; }
+
+  /** return verbosity */
+  inline bool verboseCheirality() const { return verboseCheirality_; }
+
+  /** return flag for throwing cheirality exceptions */
+  inline bool throwCheirality() const { return throwCheirality_; }
+
+private:
+
+  /// The noise model of one measurement, repeated for n measurements
+  static SharedNoiseModel Stacked(const SharedDiagonal& model, size_t n) {
+    if (!model || model->dim() != 2)
+      throw std::invalid_argument(
+          "RigProjectionFactor: need a 2-dimensional noise model");
+    Vector sigmas(2 * n);
+    for (size_t k = 0; k < n; ++k)
+      sigmas.segment<2>(2 * k) = model->sigmas();
+    return noiseModel::Diagonal::Sigmas(sigmas, true);
+  }
+
+  /// Serialization function
+  friend class boost::serialization::access;
+  template<class ARCHIVE>
+  void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+    ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Base);
+    ar & BOOST_SERIALIZATION_NVP(rig_);
+    ar & BOOST_SERIALIZATION_NVP(cameras_);
+    ar & BOOST_SERIALIZATION_NVP(measured_);
+    ar & BOOST_SERIALIZATION_NVP(throwCheirality_);
+    ar & BOOST_SERIALIZATION_NVP(verboseCheirality_);
+  }
+};
+
+/// traits
+template<class CALIBRATION>
+struct traits<RigProjectionFactor<CALIBRATION> > : public Testable<
+    RigProjectionFactor<CALIBRATION> > {
+};
+
+} // \ namespace gtsam
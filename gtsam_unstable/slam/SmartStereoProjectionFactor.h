@@ -21,6 +21,7 @@
 #pragma once
 
 #include <gtsam/slam/SmartFactorBase.h>
+#include <gtsam/slam/TriangulationCache.h>
 
 #include <gtsam/geometry/triangulation.h>
 #include <gtsam/geometry/Pose3.h>
@@ -145,6 +146,8 @@ protected:
   /// @{
   mutable TriangulationResult result_; ///< result from triangulateSafe
   mutable std::vector<Pose3> cameraPosesTriangulation_; ///< current triangulation poses
+  TriangulationCache::shared_ptr triangulationCache_; ///< optional cache shared with other factors
+  size_t track_; ///< ID of the track of this factor in triangulationCache_
   /// @}
 
 public:
@@ -164,7 +167,7 @@ public:
       SmartStereoProjectionParams()) :
       Base(sharedNoiseModel), //
       params_(params), //
-      result_(TriangulationResult::Degenerate()) {
+      result_(TriangulationResult::Degenerate()), track_(0) {
   }
 
   /** Virtual destructor */
@@ -193,6 +196,15 @@ public:
         && Base::equals(p, tol);
   }
 
+  /**
+   * Share triangulation results with other factors through a graph-level cache, as in
+   * SmartProjectionFactor::setTriangulationCache.
+   */
+  void setTriangulationCache(const TriangulationCache::shared_ptr& cache, size_t track) {
+    triangulationCache_ = cache;
+    track_ = track;
+  }
+
   /// Check if the new linearization point_ is the same as the one used for previous triangulation
   bool decideIfTriangulate(const Cameras& cameras) const {
     // several calls to linearize will be done from the same linearization point_, hence it is not needed to re-triangulate
@@ -229,86 +241,81 @@ public:
     return retriangulate; // if we arrive to this point_ all poses are the same and we don't need re-triangulation
   }
 
-//  /// triangulateSafe
-//  size_t triangulateSafe(const Values& values) const {
-//    return triangulateSafe(this->cameras(values));
-//  }
-
   /// triangulateSafe
   TriangulationResult triangulateSafe(const Cameras& cameras) const {
 
-    size_t m = cameras.size();
-    bool retriangulate = decideIfTriangulate(cameras);
-
-//    if(!retriangulate)
-//      std::cout << "retriangulate = false" << std::endl;
-//
-//    bool retriangulate = true;
-
-    if (retriangulate) {
-//      std::cout << "Retriangulate " << std::endl;
-      std::vector<Point3> reprojections;
-      reprojections.reserve(m);
-      for(size_t i = 0; i < m; i++) {
-        reprojections.push_back(cameras[i].backproject(measured_[i]));
+    if (triangulationCache_) {
+      // The shared cache replaces the cache in this factor
+      if (!triangulationCache_->lookup(track_, cameras,
+          params_.retriangulationThreshold, result_)) {
+        triangulate(cameras);
+        triangulationCache_->store(track_, cameras, result_);
       }
+      return result_;
+    }
 
-      Point3 pw_sum;
-      BOOST_FOREACH(const Point3& pw, reprojections) {
-        pw_sum = pw_sum + pw;
-      }
-      // average reprojected landmark
-      Point3 pw_avg = pw_sum / double(m);
-
-      double totalReprojError = 0;
-
-      // check if it lies in front of all cameras
-      for(size_t i = 0; i < m; i++) {
-        const Pose3& pose = cameras[i].pose();
-        const Point3& pl = pose.transform_to(pw_avg);
-        if (pl.z() <= 0) {
-          result_ = TriangulationResult::BehindCamera();
-          return result_;
-        }
+    if (decideIfTriangulate(cameras))
+      triangulate(cameras);
+    return result_;
+  }
 
-        // check landmark distance
-        if (params_.triangulation.landmarkDistanceThreshold > 0 &&
-            pl.norm() > params_.triangulation.landmarkDistanceThreshold) {
-          result_ = TriangulationResult::Degenerate();
-          return result_;
-        }
+  /// Triangulate from the average of the back-projected measurements, sets result_
+  TriangulationResult triangulate(const Cameras& cameras) const {
 
-        if (params_.triangulation.dynamicOutlierRejectionThreshold > 0) {
-          const StereoPoint2& zi = measured_[i];
-          StereoPoint2 reprojectionError(cameras[i].project(pw_avg) - zi);
-          totalReprojError += reprojectionError.vector().norm();
-        }
-      } // for
+    size_t m = cameras.size();
+    Point3 pw_sum;
+    for(size_t i = 0; i < m; i++)
+      pw_sum = pw_sum + cameras[i].backproject(measured_[i]);
+    // average reprojected landmark
+    Point3 pw_avg = pw_sum / double(m);
+
+    double totalReprojError = 0;
+
+    // check if it lies in front of all cameras
+    for(size_t i = 0; i < m; i++) {
+      const Pose3& pose = cameras[i].pose();
+      const Point3& pl = pose.transform_to(pw_avg);
+      if (pl.z() <= 0) {
+        result_ = TriangulationResult::BehindCamera();
+        return result_;
+      }
 
-      if (params_.triangulation.dynamicOutlierRejectionThreshold > 0
-          && totalReprojError / m > params_.triangulation.dynamicOutlierRejectionThreshold) {
+      // check landmark distance
+      if (params_.triangulation.landmarkDistanceThreshold > 0 &&
+          pl.norm() > params_.triangulation.landmarkDistanceThreshold) {
         result_ = TriangulationResult::Degenerate();
         return result_;
       }
 
-      if(params_.triangulation.enableEPI) {
-        try {
-         pw_avg = triangulateNonlinear(cameras, measured_, pw_avg);
-        } catch(StereoCheiralityException& e) {
-          if(params_.verboseCheirality)
-            std::cout << "Cheirality Exception in SmartStereoProjectionFactor" << std::endl;
-          if(params_.throwCheirality)
-            throw;
-          result_ = TriangulationResult::BehindCamera();
-          return TriangulationResult::BehindCamera();
-        }
+      if (params_.triangulation.dynamicOutlierRejectionThreshold > 0) {
+        const StereoPoint2& zi = measured_[i];
+        StereoPoint2 reprojectionError(cameras[i].project(pw_avg) - zi);
+        totalReprojError += reprojectionError.vector().norm();
       }
+    } // for
 
-      result_ = TriangulationResult(pw_avg);
+    if (params_.triangulation.dynamicOutlierRejectionThreshold > 0
+        && totalReprojError / m > params_.triangulation.dynamicOutlierRejectionThreshold) {
+      result_ = TriangulationResult::Degenerate();
+      return result_;
+    }
 
-    } // if retriangulate
-    return result_;
+    if(params_.triangulation.enableEPI) {
+      try {
+       pw_avg = triangulateNonlinear(cameras, measured_, pw_avg);
+      } catch(StereoCheiralityException& e) {
+        if(params_.verboseCheirality)
+          std::cout << "Cheirality Exception in SmartStereoProjectionFactor" << std::endl;
+        if(params_.throwCheirality)
+          throw;
+        result_ = TriangulationResult::BehindCamera();
+        return TriangulationResult::BehindCamera();
+      }
+    }
+
+    result_ = TriangulationResult(pw_avg);
 
+    return result_;
   }
 
   /// triangulate
@@ -348,47 +355,46 @@ public:
     }
 
     // Jacobian could be 3D Point3 OR 2D Unit3, difference is E.cols().
-    std::vector<Base::MatrixZD> Fblocks;
-    Matrix F, E;
-    Vector b;
-    computeJacobiansWithTriangulatedPoint(Fblocks, E, b, cameras);
+    // They are computed into the workspace of this thread to avoid allocations.
+    Base::JacobianWorkspace& w = Base::Workspace(numKeys);
+    computeJacobiansWithTriangulatedPoint(w.Fblocks, w.E, w.b, cameras);
 
     // Whiten using noise model
-    Base::whitenJacobians(Fblocks, E, b);
+    Base::whitenJacobians(w.Fblocks, w.E, w.b);
+
+    // build augmented hessian directly in the storage of the factor
+    boost::shared_ptr<RegularHessianFactor<Base::Dim> > factor =
+        RegularHessianFactor<Base::Dim>::Uninitialized(this->keys_);
+    Cameras::SchurComplement(w.Fblocks, w.E, w.b, factor->matrixObject(), lambda,
+        diagonalDamping);
+    return factor;
+  }
 
-    // build augmented hessian
-    SymmetricBlockMatrix augmentedHessian = //
-        Cameras::SchurComplement(Fblocks, E, b, lambda, diagonalDamping);
+  // create factor
+  boost::shared_ptr<RegularImplicitSchurFactor<StereoCamera> > createRegularImplicitSchurFactor(
+      const Cameras& cameras, double lambda) const {
+    if (triangulateForLinearize(cameras))
+      return Base::createRegularImplicitSchurFactor(cameras, *result_, lambda);
+    else
+      // failed: return empty
+      return boost::shared_ptr<RegularImplicitSchurFactor<StereoCamera> >();
+  }
 
-    return boost::make_shared<RegularHessianFactor<Base::Dim> >(this->keys_,
-        augmentedHessian);
+  /// create factor
+  boost::shared_ptr<JacobianFactorQ<Base::Dim, Base::ZDim> > createJacobianQFactor(
+      const Cameras& cameras, double lambda) const {
+    if (triangulateForLinearize(cameras))
+      return Base::createJacobianQFactor(cameras, *result_, lambda);
+    else
+      // failed: return empty
+      return boost::make_shared<JacobianFactorQ<Base::Dim, Base::ZDim> >(this->keys_);
   }
 
-  // create factor
-//  boost::shared_ptr<RegularImplicitSchurFactor<StereoCamera> > createRegularImplicitSchurFactor(
-//      const Cameras& cameras, double lambda) const {
-//    if (triangulateForLinearize(cameras))
-//      return Base::createRegularImplicitSchurFactor(cameras, *result_, lambda);
-//    else
-//      // failed: return empty
-//      return boost::shared_ptr<RegularImplicitSchurFactor<StereoCamera> >();
-//  }
-//
-//  /// create factor
-//  boost::shared_ptr<JacobianFactorQ<Base::Dim, Base::ZDim> > createJacobianQFactor(
-//      const Cameras& cameras, double lambda) const {
-//    if (triangulateForLinearize(cameras))
-//      return Base::createJacobianQFactor(cameras, *result_, lambda);
-//    else
-//      // failed: return empty
-//      return boost::make_shared<JacobianFactorQ<Base::Dim, Base::ZDim> >(this->keys_);
-//  }
-//
-//  /// Create a factor, takes values
-//  boost::shared_ptr<JacobianFactorQ<Base::Dim, Base::ZDim> > createJacobianQFactor(
-//      const Values& values, double lambda) const {
-//    return createJacobianQFactor(this->cameras(values), lambda);
-//  }
+  /// Create a factor, takes values
+  boost::shared_ptr<JacobianFactorQ<Base::Dim, Base::ZDim> > createJacobianQFactor(
+      const Values& values, double lambda) const {
+    return createJacobianQFactor(this->cameras(values), lambda);
+  }
 
   /// different (faster) way to compute Jacobian factor
   boost::shared_ptr<JacobianFactor> createJacobianSVDFactor(
@@ -399,23 +405,23 @@ public:
       return boost::make_shared<JacobianFactorSVD<Base::Dim, ZDim> >(this->keys_);
   }
 
-//  /// linearize to a Hessianfactor
-//  virtual boost::shared_ptr<RegularHessianFactor<Base::Dim> > linearizeToHessian(
-//      const Values& values, double lambda = 0.0) const {
-//    return createHessianFactor(this->cameras(values), lambda);
-//  }
-
-//  /// linearize to an Implicit Schur factor
-//  virtual boost::shared_ptr<RegularImplicitSchurFactor<StereoCamera> > linearizeToImplicit(
-//      const Values& values, double lambda = 0.0) const {
-//    return createRegularImplicitSchurFactor(this->cameras(values), lambda);
-//  }
-//
-//  /// linearize to a JacobianfactorQ
-//  virtual boost::shared_ptr<JacobianFactorQ<Base::Dim, Base::ZDim> > linearizeToJacobian(
-//      const Values& values, double lambda = 0.0) const {
-//    return createJacobianQFactor(this->cameras(values), lambda);
-//  }
+  /// linearize to a Hessianfactor
+  virtual boost::shared_ptr<RegularHessianFactor<Base::Dim> > linearizeToHessian(
+      const Values& values, double lambda = 0.0) const {
+    return createHessianFactor(this->cameras(values), lambda);
+  }
+
+  /// linearize to an Implicit Schur factor
+  virtual boost::shared_ptr<RegularImplicitSchurFactor<StereoCamera> > linearizeToImplicit(
+      const Values& values, double lambda = 0.0) const {
+    return createRegularImplicitSchurFactor(this->cameras(values), lambda);
+  }
+
+  /// linearize to a JacobianfactorQ
+  virtual boost::shared_ptr<JacobianFactorQ<Base::Dim, Base::ZDim> > linearizeToJacobian(
+      const Values& values, double lambda = 0.0) const {
+    return createJacobianQFactor(this->cameras(values), lambda);
+  }
 
   /**
    * Linearize to Gaussian Factor
@@ -428,12 +434,12 @@ public:
     switch (params_.linearizationMode) {
     case HESSIAN:
       return createHessianFactor(cameras, lambda);
-//    case IMPLICIT_SCHUR:
-//      return createRegularImplicitSchurFactor(cameras, lambda);
+    case IMPLICIT_SCHUR:
+      return createRegularImplicitSchurFactor(cameras, lambda);
     case JACOBIAN_SVD:
       return createJacobianSVDFactor(cameras, lambda);
-//    case JACOBIAN_Q:
-//      return createJacobianQFactor(cameras, lambda);
+    case JACOBIAN_Q:
+      return createJacobianQFactor(cameras, lambda);
     default:
       throw std::runtime_error("SmartStereoFactorlinearize: unknown mode");
     }
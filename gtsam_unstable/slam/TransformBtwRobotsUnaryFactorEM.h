@@ -23,6 +23,7 @@
 #include <gtsam/linear/GaussianFactor.h>
 #include <gtsam/base/Testable.h>
 #include <gtsam/base/Lie.h>
+#include <gtsam_unstable/slam/IndicatorProbabilities.h>
 
 #include <ostream>
 
@@ -65,6 +66,10 @@ namespace gtsam {
     bool flag_bump_up_near_zero_probs_;
     mutable bool start_with_M_step_;
 
+    // sqrt(|R'R|) of the inlier and outlier models, cached as they only change with the models
+    double normalizer_inlier_;
+    double normalizer_outlier_;
+
     /** concept check by type */
     GTSAM_CONCEPT_LIE_TYPE(T)
     GTSAM_CONCEPT_TESTABLE_TYPE(T)
@@ -75,7 +80,8 @@ namespace gtsam {
     typedef typename boost::shared_ptr<TransformBtwRobotsUnaryFactorEM> shared_ptr;
 
     /** default constructor - only use for serialization */
-    TransformBtwRobotsUnaryFactorEM() {}
+    TransformBtwRobotsUnaryFactorEM() :
+      normalizer_inlier_(0.0), normalizer_outlier_(0.0) {}
 
     /** Constructor */
     TransformBtwRobotsUnaryFactorEM(Key key, const VALUE& measured, Key keyA, Key keyB,
@@ -90,6 +96,7 @@ namespace gtsam {
           start_with_M_step_(false){
 
       setValAValB(valA, valB);
+      cacheNormalizers();
 
     }
 
@@ -186,18 +193,19 @@ namespace gtsam {
 
       Matrix H_compose, H_between1, H_dummy;
 
-      T orgA_T_currA = valA_.at<T>(keyA_);
-      T orgB_T_currB = valB_.at<T>(keyB_);
-
-      T orgA_T_orgB = x.at<T>(key_);
+      const T& orgA_T_currA = valA_.at<T>(keyA_);
+      const T& orgB_T_currB = valB_.at<T>(keyB_);
 
-      T orgA_T_currB = orgA_T_orgB.compose(orgB_T_currB, H_compose, H_dummy);
+      const T& orgA_T_orgB = x.at<T>(key_);
 
-      T currA_T_currB_pred = orgA_T_currA.between(orgA_T_currB, H_dummy, H_between1);
+      // only ask for the Jacobians when they are needed
+      T orgA_T_currB = H ? orgA_T_orgB.compose(orgB_T_currB, H_compose, H_dummy)
+          : orgA_T_orgB.compose(orgB_T_currB);
 
-      T currA_T_currB_msr  = measured_;
+      T currA_T_currB_pred = H ? orgA_T_currA.between(orgA_T_currB, H_dummy, H_between1)
+          : orgA_T_currA.between(orgA_T_currB);
 
-      Vector err = currA_T_currB_msr.localCoordinates(currA_T_currB_pred);
+      Vector err = measured_.localCoordinates(currA_T_currB_pred);
 
       // Calculate indicator probabilities (inlier and outlier)
       Vector p_inlier_outlier = calcIndicatorProb(x, err);
@@ -211,34 +219,25 @@ namespace gtsam {
         p_outlier = 0.5;
       }
 
-      Vector err_wh_inlier  = model_inlier_->whiten(err);
-      Vector err_wh_outlier = model_outlier_->whiten(err);
-
-      Matrix invCov_inlier  = model_inlier_->R().transpose() * model_inlier_->R();
-      Matrix invCov_outlier = model_outlier_->R().transpose() * model_outlier_->R();
+      double sqrt_p_inlier  = sqrt(p_inlier);
+      double sqrt_p_outlier = sqrt(p_outlier);
 
-      Vector err_wh_eq;
-      err_wh_eq.resize(err_wh_inlier.rows()*2);
-      err_wh_eq << sqrt(p_inlier) * err_wh_inlier.array() , sqrt(p_outlier) * err_wh_outlier.array();
-
-      Matrix H_unwh = H_compose * H_between1;
+      const size_t d = err.size();
+      Vector err_wh_eq(2*d);
+      err_wh_eq << sqrt_p_inlier * model_inlier_->whiten(err), sqrt_p_outlier * model_outlier_->whiten(err);
 
       if (H){
+        Matrix H_unwh = H_compose * H_between1;
 
-        Matrix H_inlier  = sqrt(p_inlier)*model_inlier_->Whiten(H_unwh);
-        Matrix H_outlier = sqrt(p_outlier)*model_outlier_->Whiten(H_unwh);
-        Matrix H_aug = gtsam::stack(2, &H_inlier, &H_outlier);
-
-        (*H)[0].resize(H_aug.rows(),H_aug.cols());
-        (*H)[0] = H_aug;
-      }
-
-      if (debug){
-        //        std::cout<<"H_compose - rows, cols, : "<<H_compose.rows()<<", "<< H_compose.cols()<<std::endl;
-        //        std::cout<<"H_between1 - rows, cols, : "<<H_between1.rows()<<", "<< H_between1.cols()<<std::endl;
-        //        std::cout<<"H_unwh - rows, cols, : "<<H_unwh.rows()<<", "<< H_unwh.cols()<<std::endl;
-        //        std::cout<<"H_unwh: "<<std:endl<<H_unwh[0]
+        (*H)[0].resize(2*d, H_unwh.cols());
+        (*H)[0] << sqrt_p_inlier*model_inlier_->Whiten(H_unwh), sqrt_p_outlier*model_outlier_->Whiten(H_unwh);
 
+        if (debug){
+          //        std::cout<<"H_compose - rows, cols, : "<<H_compose.rows()<<", "<< H_compose.cols()<<std::endl;
+          //        std::cout<<"H_between1 - rows, cols, : "<<H_between1.rows()<<", "<< H_between1.cols()<<std::endl;
+          //        std::cout<<"H_unwh - rows, cols, : "<<H_unwh.rows()<<", "<< H_unwh.cols()<<std::endl;
+          //        std::cout<<"H_unwh: "<<std:endl<<H_unwh[0]
+        }
       }
 
 
@@ -260,11 +259,8 @@ namespace gtsam {
       Vector err_wh_inlier  = model_inlier_->whiten(err);
       Vector err_wh_outlier = model_outlier_->whiten(err);
 
-      Matrix invCov_inlier  = model_inlier_->R().transpose() * model_inlier_->R();
-      Matrix invCov_outlier = model_outlier_->R().transpose() * model_outlier_->R();
-
-      double p_inlier  = prior_inlier_ * sqrt(invCov_inlier.norm()) * exp( -0.5 * err_wh_inlier.dot(err_wh_inlier) );
-      double p_outlier = prior_outlier_ * sqrt(invCov_outlier.norm()) * exp( -0.5 * err_wh_outlier.dot(err_wh_outlier) );
+      double p_inlier  = prior_inlier_ * normalizer_inlier_ * exp( -0.5 * err_wh_inlier.dot(err_wh_inlier) );
+      double p_outlier = prior_outlier_ * normalizer_outlier_ * exp( -0.5 * err_wh_outlier.dot(err_wh_outlier) );
 
       double sumP = p_inlier + p_outlier;
       p_inlier  /= sumP;
@@ -287,21 +283,31 @@ namespace gtsam {
       return (Vector(2) << p_inlier, p_outlier).finished();
     }
 
+    /* ************************************************************************* */
+    /**
+     * Indicator probabilities of all the TransformBtwRobotsUnaryFactorEM<VALUE> factors in a graph,
+     * computed in parallel when TBB is enabled.
+     * @return 2*n matrix with the inlier and outlier probabilities of each factor in a column
+     * @param indices optional, filled with the index in the graph of each column
+     */
+    static Matrix CalcIndicatorProbs(const gtsam::NonlinearFactorGraph& graph,
+        const gtsam::Values& x, std::vector<size_t>* indices = 0) {
+      return internal::CalcIndicatorProbs<This>(graph, x, indices);
+    }
+
     /* ************************************************************************* */
     gtsam::Vector unwhitenedError(const gtsam::Values& x) const {
 
-      T orgA_T_currA = valA_.at<T>(keyA_);
-      T orgB_T_currB = valB_.at<T>(keyB_);
+      const T& orgA_T_currA = valA_.at<T>(keyA_);
+      const T& orgB_T_currB = valB_.at<T>(keyB_);
 
-      T orgA_T_orgB = x.at<T>(key_);
+      const T& orgA_T_orgB = x.at<T>(key_);
 
       T orgA_T_currB = orgA_T_orgB.compose(orgB_T_currB);
 
       T currA_T_currB_pred = orgA_T_currA.between(orgA_T_currB);
 
-      T currA_T_currB_msr  = measured_;
-
-      return currA_T_currB_msr.localCoordinates(currA_T_currB_pred);
+      return measured_.localCoordinates(currA_T_currB_pred);
     }
 
     /* ************************************************************************* */
@@ -394,6 +400,8 @@ namespace gtsam {
       Matrix covRoutlier = (model_outlier_->R().transpose()*model_outlier_->R()).inverse();
       model_outlier_ = gtsam::noiseModel::Gaussian::Covariance(covRoutlier + cov_state);
 
+      cacheNormalizers();
+
       //       model_inlier_->print("after:");
       //       std::cout<<"covRinlier + cov_state: "<<covRinlier + cov_state<<std::endl;
     }
@@ -412,6 +420,12 @@ namespace gtsam {
 
   private:
 
+    /** compute the normalizers of the indicator probabilities, call whenever the models change */
+    void cacheNormalizers() {
+      normalizer_inlier_  = sqrt((model_inlier_->R().transpose()*model_inlier_->R()).norm());
+      normalizer_outlier_ = sqrt((model_outlier_->R().transpose()*model_outlier_->R()).norm());
+    }
+
     /** Serialization function */
     friend class boost::serialization::access;
     template<class ARCHIVE>
@@ -297,6 +297,59 @@ TEST (BetweenFactorEM, updateNoiseModel ) {
 
 #endif
 
+/* ************************************************************************* */
+TEST (BetweenFactorEM, CalcIndicatorProbs ) {
+  SharedGaussian model_inlier(noiseModel::Diagonal::Sigmas(Vector3(0.5, 0.5, 0.05)));
+  SharedGaussian model_outlier(noiseModel::Diagonal::Sigmas(Vector3(50.0, 50.0, 10.0)));
+
+  gtsam::Values values;
+  values.insert(1, Pose2(10.0, 15.0, 0.1));
+  values.insert(2, Pose2(15.0, 15.0, 0.3));
+  values.insert(3, Pose2(20.0, 12.0, -0.2));
+
+  // an inlier, an outlier and a factor with another value type in between
+  NonlinearFactorGraph graph;
+  graph.push_back(PriorFactor<Pose2>(1, Pose2(10.0, 15.0, 0.1),
+      noiseModel::Isotropic::Sigma(3, 1.0)));
+  graph.push_back(BetweenFactorEM<Pose2>(1, 2, Pose2(5.0, 0.1, 0.2), model_inlier,
+      model_outlier, 0.5, 0.5));
+  graph.push_back(BetweenFactor<Pose2>(2, 3, Pose2(5.0, -3.0, -0.5),
+      noiseModel::Isotropic::Sigma(3, 1.0)));
+  graph.push_back(BetweenFactorEM<Pose2>(2, 3, Pose2(-8.0, 20.0, 1.5), model_inlier,
+      model_outlier, 0.5, 0.5, true));
+
+  std::vector<size_t> indices;
+  Matrix actual = BetweenFactorEM<Pose2>::CalcIndicatorProbs(graph, values, &indices);
+
+  LONGS_EQUAL(2, indices.size());
+  LONGS_EQUAL(1, indices[0]);
+  LONGS_EQUAL(3, indices[1]);
+  LONGS_EQUAL(2, actual.rows());
+  LONGS_EQUAL(2, actual.cols());
+  for (size_t j = 0; j < indices.size(); ++j) {
+    const BetweenFactorEM<Pose2>& factor =
+        dynamic_cast<const BetweenFactorEM<Pose2>&>(*graph[indices[j]]);
+    EXPECT(assert_equal(factor.calcIndicatorProb(values), Vector(actual.col(j)), 1e-12));
+  }
+  EXPECT(actual(0, 0) > actual(1, 0));
+  EXPECT(actual(0, 1) < actual(1, 1));
+
+  // whitened error is the error whitened by both models, weighted by the probabilities
+  const BetweenFactorEM<Pose2>& inlier =
+      dynamic_cast<const BetweenFactorEM<Pose2>&>(*graph[1]);
+  Vector err = inlier.unwhitenedError(values);
+  Vector expected(6);
+  expected << std::sqrt(actual(0, 0)) * model_inlier->whiten(err),
+      std::sqrt(actual(1, 0)) * model_outlier->whiten(err);
+  std::vector<Matrix> H(2);
+  EXPECT(assert_equal(expected,
+      inlier.whitenedError(values, H), 1e-9));
+  EXPECT(assert_equal(expected,
+      inlier.whitenedError(values), 1e-9));
+  LONGS_EQUAL(6, H[0].rows());
+  LONGS_EQUAL(3, H[1].cols());
+}
+
 /* ************************************************************************* */
   int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
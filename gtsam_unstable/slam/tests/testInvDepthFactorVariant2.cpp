@@ -7,6 +7,7 @@
 
 #include <CppUnitLite/TestHarness.h>
 #include <gtsam_unstable/slam/InvDepthFactorVariant2.h>
+#include <gtsam/nonlinear/factorTesting.h>
 #include <gtsam/nonlinear/NonlinearEquality.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
@@ -110,6 +111,19 @@ TEST( InvDepthFactorVariant2, optimize) {
 }
 
 
+/* ************************************************************************* */
+TEST( InvDepthFactorVariant2, Jacobians) {
+  Pose3 pose(Rot3::ypr(-M_PI/2 + 0.1, 0.05, -M_PI/2), Point3(0.1, -0.2, 1.0));
+  Cal3_S2::shared_ptr K(new Cal3_S2(1500, 1200, 0, 640, 480));
+  InvDepthFactorVariant2 factor(1, 100, Point2(600, 500), K, Point3(0.1, 0.2, 1.1),
+      noiseModel::Unit::Create(2));
+
+  Values values;
+  values.insert(Key(1), pose);
+  values.insert(Key(100), Vector3(0.1, 0.2, 0.25));
+  EXPECT_CORRECT_FACTOR_JACOBIANS(factor, values, 1e-7, 1e-4);
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
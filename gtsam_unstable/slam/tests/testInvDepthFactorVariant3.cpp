@@ -7,6 +7,7 @@
 
 #include <CppUnitLite/TestHarness.h>
 #include <gtsam_unstable/slam/InvDepthFactorVariant3.h>
+#include <gtsam/nonlinear/factorTesting.h>
 #include <gtsam/nonlinear/NonlinearEquality.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
@@ -80,6 +81,23 @@ TEST( InvDepthFactorVariant3, optimize) {
 }
 
 
+/* ************************************************************************* */
+TEST( InvDepthFactorVariant3, Jacobians) {
+  Pose3 pose1(Rot3::ypr(-M_PI/2 + 0.1, 0.05, -M_PI/2), Point3(0.1, -0.2, 1.0));
+  Pose3 pose2(Rot3::ypr(-M_PI/2, -0.05, -M_PI/2 + 0.1), Point3(0.3, 0.1, 1.5));
+  Cal3_S2::shared_ptr K(new Cal3_S2(1500, 1200, 0, 640, 480));
+  SharedNoiseModel sigma(noiseModel::Unit::Create(2));
+  InvDepthFactorVariant3a factor1(1, 100, Point2(600, 500), K, sigma);
+  InvDepthFactorVariant3b factor2(1, 2, 100, Point2(620, 450), K, sigma);
+
+  Values values;
+  values.insert(Key(1), pose1);
+  values.insert(Key(2), pose2);
+  values.insert(Key(100), Vector3(0.1, 0.2, 0.25));
+  EXPECT_CORRECT_FACTOR_JACOBIANS(factor1, values, 1e-7, 1e-4);
+  EXPECT_CORRECT_FACTOR_JACOBIANS(factor2, values, 1e-7, 1e-4);
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -0,0 +1,131 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testRigProjectionFactor.cpp
+ * @brief   Unit tests for RigProjectionFactor
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam_unstable/slam/RigProjectionFactor.h>
+#include <gtsam/slam/ProjectionFactor.h>
+#include <gtsam/geometry/Cal3DS2.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/numericalDerivative.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+using symbol_shorthand::X;
+using symbol_shorthand::L;
+
+namespace {
+  // A rig of four cameras looking forward, left, right and up, with different calibrations
+  CameraRig<Cal3DS2>::shared_ptr createRig() {
+    CameraRig<Cal3DS2>::shared_ptr rig = boost::make_shared<CameraRig<Cal3DS2> >();
+    const Rot3 forward(Point3(0, -1, 0), Point3(0, 0, -1), Point3(1, 0, 0));
+    for (size_t c = 0; c < 4; ++c) {
+      const Rot3 R = Rot3::Rz(0.4 * c - 0.6) * forward;
+      rig->add(Pose3(R, Point3(0.1 * c, -0.05 * c, 0.3)), boost::make_shared<Cal3DS2>(
+          500.0 + 10 * c, 510.0, 0.0, 320.0, 240.0 - c, -0.1, 0.01 * c, 0.001, -0.002));
+    }
+    return rig;
+  }
+
+  const Pose3 body(Rot3::ypr(0.3, -0.1, 0.05), Point3(1.0, -2.0, 0.5));
+  const Point3 landmark(9.0, 0.5, 1.0);
+  const SharedDiagonal pixel = noiseModel::Diagonal::Sigmas(Vector2(1.0, 2.0));
+}
+
+/* ************************************************************************* */
+TEST(RigProjectionFactor, error) {
+  CameraRig<Cal3DS2>::shared_ptr rig = createRig();
+  vector<size_t> cameras;
+  vector<Point2> measured;
+  for (size_t c = 0; c < 3; ++c) {
+    cameras.push_back(c);
+    measured.push_back(Point2(300.0 + c, 200.0 - 2.0 * c));
+  }
+  RigProjectionFactor<Cal3DS2> factor(rig, X(1), L(1), cameras, measured, pixel);
+  EXPECT_LONGS_EQUAL(6, factor.dim());
+
+  // Same errors and linearization as one GenericProjectionFactor per measurement
+  Values values;
+  values.insert(X(1), body);
+  values.insert(L(1), landmark);
+  Vector expectedError(6);
+  Matrix expectedA1(6, 6), expectedA2(6, 3);
+  Vector expectedb(6);
+  for (size_t k = 0; k < 3; ++k) {
+    GenericProjectionFactor<Pose3, Point3, Cal3DS2> single(measured[k], pixel, X(1), L(1),
+        rig->calibration(k), rig->body_P_sensor(k));
+    expectedError.segment<2>(2 * k) = single.evaluateError(body, landmark);
+    JacobianFactor::shared_ptr linear = boost::dynamic_pointer_cast<JacobianFactor>(
+        single.linearize(values));
+    expectedA1.block<2, 6>(2 * k, 0) = linear->getA(linear->begin());
+    expectedA2.block<2, 3>(2 * k, 0) = linear->getA(linear->begin() + 1);
+    expectedb.segment<2>(2 * k) = linear->getb();
+  }
+  EXPECT(assert_equal(expectedError, factor.evaluateError(body, landmark), 1e-9));
+
+  GaussianFactor::shared_ptr actual = factor.linearize(values);
+  EXPECT((boost::dynamic_pointer_cast<BinaryJacobianFactor<Eigen::Dynamic, 6, 3> >(actual)));
+  const GaussianFactor& expected = JacobianFactor(X(1), expectedA1, L(1), expectedA2, expectedb);
+  EXPECT(assert_equal(expected, *actual, 1e-7));
+}
+
+/* ************************************************************************* */
+TEST(RigProjectionFactor, jacobians) {
+  CameraRig<Cal3DS2>::shared_ptr rig = createRig();
+  vector<size_t> cameras;
+  vector<Point2> measured;
+  cameras.push_back(2);
+  measured.push_back(Point2(310.0, 250.0));
+  cameras.push_back(0);
+  measured.push_back(Point2(330.0, 230.0));
+  RigProjectionFactor<Cal3DS2> factor(rig, X(1), L(1), cameras, measured, pixel);
+
+  Matrix H1, H2;
+  factor.evaluateError(body, landmark, H1, H2);
+  boost::function<Vector(const Pose3&, const Point3&)> f = boost::bind(
+      &RigProjectionFactor<Cal3DS2>::evaluateError, factor, _1, _2, boost::none, boost::none);
+  EXPECT(assert_equal(numericalDerivative21(f, body, landmark), H1, 1e-5));
+  EXPECT(assert_equal(numericalDerivative22(f, body, landmark), H2, 1e-5));
+}
+
+/* ************************************************************************* */
+TEST(RigProjectionFactor, cheirality) {
+  CameraRig<Cal3DS2>::shared_ptr rig = createRig();
+  vector<size_t> cameras;
+  vector<Point2> measured;
+  cameras.push_back(1);
+  measured.push_back(Point2(320.0, 240.0));
+  RigProjectionFactor<Cal3DS2> factor(rig, X(1), L(1), cameras, measured, pixel);
+
+  // A landmark behind all cameras gives a constant error and zero Jacobians
+  const Point3 behind = body.transform_from(Point3(-20.0, 0.0, 0.0));
+  Matrix H1, H2;
+  EXPECT(assert_equal(Vector2(2.0 * 510.0, 2.0 * 510.0),
+      factor.evaluateError(body, behind, H1, H2)));
+  EXPECT(assert_equal(Matrix(Matrix::Zero(2, 6)), H1));
+
+  RigProjectionFactor<Cal3DS2> throwing(rig, X(1), L(1), cameras, measured, pixel, true);
+  CHECK_EXCEPTION(throwing.evaluateError(body, behind), CheiralityException);
+  CHECK_EXCEPTION(RigProjectionFactor<Cal3DS2>(rig, X(1), L(1), vector<size_t>(1, 4),
+      measured, pixel), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -969,6 +969,85 @@ TEST( SmartStereoProjectionPoseFactor, CheckHessian) {
 //}
 //
 
+/* *************************************************************************/
+TEST( SmartStereoProjectionPoseFactor, linearizationModes ) {
+
+  vector<Key> views;
+  views.push_back(x1);
+  views.push_back(x2);
+  views.push_back(x3);
+
+  Pose3 pose1 = Pose3(Rot3::ypr(-M_PI / 2, 0., -M_PI / 2), Point3(0, 0, 1));
+  Pose3 pose2 = pose1 * Pose3(Rot3::RzRyRx(-0.05, 0.0, -0.05), Point3(0, 0, 0));
+  Pose3 pose3 = pose2 * Pose3(Rot3::RzRyRx(-0.05, 0.0, -0.05), Point3(0, 0, 0));
+  vector<StereoPoint2> measurements = stereo_projectToMultipleCameras(
+      StereoCamera(pose1, K), StereoCamera(pose2, K), StereoCamera(pose3, K),
+      Point3(5, 0.5, 1.2));
+
+  Values values;
+  values.insert(x1, pose1);
+  values.insert(x2, pose2);
+  values.insert(x3, pose3 * Pose3(Rot3::ypr(-M_PI / 100, 0., -M_PI / 100),
+      Point3(0.1, 0.1, 0.1)));
+
+  SmartStereoProjectionPoseFactor hessianFactor(model,
+      SmartStereoProjectionParams(HESSIAN));
+  hessianFactor.add(measurements, views, K);
+  Matrix expected = hessianFactor.linearize(values)->information();
+
+  // The implicit Schur complement and the Q Jacobian represent the same Hessian
+  SmartStereoProjectionPoseFactor implicitFactor(model,
+      SmartStereoProjectionParams(IMPLICIT_SCHUR));
+  implicitFactor.add(measurements, views, K);
+  GaussianFactor::shared_ptr implicit = implicitFactor.linearize(values);
+  CHECK(boost::dynamic_pointer_cast<RegularImplicitSchurFactor<StereoCamera> >(implicit));
+  EXPECT(assert_equal(expected, implicit->information(), 1e-7));
+
+  SmartStereoProjectionPoseFactor jacobianFactor(model,
+      SmartStereoProjectionParams(JACOBIAN_Q));
+  jacobianFactor.add(measurements, views, K);
+  GaussianFactor::shared_ptr jacobianQ = jacobianFactor.linearize(values);
+  CHECK((boost::dynamic_pointer_cast<JacobianFactorQ<6, 3> >(jacobianQ)));
+  EXPECT(assert_equal(expected, jacobianQ->information(), 1e-7));
+}
+
+/* *************************************************************************/
+TEST( SmartStereoProjectionPoseFactor, triangulationCache ) {
+
+  vector<Key> views;
+  views.push_back(x1);
+  views.push_back(x2);
+  views.push_back(x3);
+
+  Pose3 pose1 = Pose3(Rot3::ypr(-M_PI / 2, 0., -M_PI / 2), Point3(0, 0, 1));
+  Pose3 pose2 = pose1 * Pose3(Rot3::RzRyRx(-0.05, 0.0, -0.05), Point3(0, 0, 0));
+  Pose3 pose3 = pose2 * Pose3(Rot3::RzRyRx(-0.05, 0.0, -0.05), Point3(0, 0, 0));
+  vector<StereoPoint2> measurements = stereo_projectToMultipleCameras(
+      StereoCamera(pose1, K), StereoCamera(pose2, K), StereoCamera(pose3, K),
+      Point3(5, 0.5, 1.2));
+
+  Values values;
+  values.insert(x1, pose1);
+  values.insert(x2, pose2);
+  values.insert(x3, pose3);
+
+  // Two copies of the same factor share the triangulation of their track
+  TriangulationCache::shared_ptr cache(new TriangulationCache);
+  SmartStereoProjectionPoseFactor factor1(model), factor2(model);
+  factor1.add(measurements, views, K);
+  factor2.add(measurements, views, K);
+  factor1.setTriangulationCache(cache, 7);
+  factor2.setTriangulationCache(cache, 7);
+
+  double expected = factor1.error(values);
+  EXPECT_DOUBLES_EQUAL(expected, factor2.error(values), 1e-9);
+  EXPECT(factor2.isValid());
+  EXPECT(assert_equal(*factor1.point(), *factor2.point(), 1e-9));
+  LONGS_EQUAL(1, cache->size());
+  LONGS_EQUAL(1, cache->hits());
+  LONGS_EQUAL(1, cache->misses());
+}
+
 /* *************************************************************************/
 TEST( SmartStereoProjectionPoseFactor, HessianWithRotation ) {
   vector<Key> views;
@@ -263,6 +263,58 @@ TEST( TransformBtwRobotsUnaryFactorEM, Jacobian)
   Matrix H1_expected = gtsam::numericalDerivative11<Vector, Pose2>(boost::bind(&predictionError, _1,  key, g), orgA_T_orgB, stepsize);
 //  CHECK( assert_equal(H1_expected, H1_actual, 1e-5));
 }
+
+/* ************************************************************************* */
+TEST( TransformBtwRobotsUnaryFactorEM, CalcIndicatorProbs)
+{
+  gtsam::Key key(0);
+  gtsam::Key keyA(1);
+  gtsam::Key keyB(2);
+
+  gtsam::Pose2 orgA_T_1(10.0, 15.0, 0.1);
+  gtsam::Pose2 orgB_T_2(15.0, 15.0, 0.3);
+  gtsam::Pose2 orgA_T_orgB(100.0, 45.0, 1.8);
+
+  gtsam::Pose2 rel_pose_ideal = orgA_T_1.between(orgA_T_orgB.compose(orgB_T_2));
+
+  SharedGaussian model_inlier(noiseModel::Diagonal::Sigmas(Vector3(0.5, 0.5, 0.05)));
+  SharedGaussian model_outlier(noiseModel::Diagonal::Sigmas(Vector3(5, 5, 1.0)));
+
+  gtsam::Values valA, valB;
+  valA.insert(keyA, orgA_T_1);
+  valB.insert(keyB, orgB_T_2);
+
+  // an inlier and an outlier measurement
+  NonlinearFactorGraph graph;
+  graph.push_back(TransformBtwRobotsUnaryFactorEM<gtsam::Pose2>(key,
+      rel_pose_ideal.compose(gtsam::Pose2(0.5, 0.4, 0.01)), keyA, keyB, valA, valB,
+      model_inlier, model_outlier, 0.5, 0.5));
+  graph.push_back(BetweenFactor<gtsam::Pose2>(key, keyA, orgA_T_1,
+      noiseModel::Isotropic::Sigma(3, 1.0)));
+  graph.push_back(TransformBtwRobotsUnaryFactorEM<gtsam::Pose2>(key,
+      rel_pose_ideal.compose(gtsam::Pose2(10.0, -8.0, 1.2)), keyA, keyB, valA, valB,
+      model_inlier, model_outlier, 0.5, 0.5));
+
+  gtsam::Values values;
+  values.insert(key, orgA_T_orgB);
+
+  std::vector<size_t> indices;
+  Matrix actual = TransformBtwRobotsUnaryFactorEM<gtsam::Pose2>::CalcIndicatorProbs(graph,
+      values, &indices);
+
+  LONGS_EQUAL(2, indices.size());
+  LONGS_EQUAL(0, indices[0]);
+  LONGS_EQUAL(2, indices[1]);
+  LONGS_EQUAL(2, actual.cols());
+  for (size_t j = 0; j < indices.size(); ++j) {
+    const TransformBtwRobotsUnaryFactorEM<gtsam::Pose2>& factor =
+        dynamic_cast<const TransformBtwRobotsUnaryFactorEM<gtsam::Pose2>&>(*graph[indices[j]]);
+    EXPECT(assert_equal(factor.calcIndicatorProb(values), Vector(actual.col(j)), 1e-12));
+  }
+  EXPECT(actual(0, 0) > actual(1, 0));
+  EXPECT(actual(0, 1) < actual(1, 1));
+}
+
 /////* ************************************************************************** */
 //TEST (TransformBtwRobotsUnaryFactorEM, jacobian ) {
 //
@@ -0,0 +1,83 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeArcConsistency.cpp
+ * @brief   Time CSP::runArcConsistency on a CSP the size of a large scheduling instance
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam_unstable/discrete/CSP.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/assign/std/vector.hpp>
+
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+using namespace boost::assign;
+
+// The 9*9 Sudoku AJC_3star_Feb8_2012 from testSudoku, 0 is unknown
+static const size_t puzzle[81] = {
+    9,5,0, 0,0,6, 0,0,0,
+    0,8,4, 0,7,0, 0,0,0,
+    6,2,0, 5,0,0, 4,0,0,
+
+    0,0,0, 2,9,0, 6,0,0,
+    0,9,0, 0,0,0, 0,2,0,
+    0,0,2, 0,6,3, 0,0,0,
+
+    0,0,9, 0,0,7, 0,6,8,
+    0,0,0, 0,3,0, 2,9,0,
+    0,0,0, 1,0,0, 0,3,7};
+
+/* ************************************************************************* */
+// Add a copy of the puzzle on keys offset..offset+80
+void addSudoku(CSP& csp, Key offset) {
+  for (size_t k = 0; k < 81; k++)
+    if (puzzle[k]) csp.addSingleValue(DiscreteKey(offset + k, 9), puzzle[k] - 1);
+  for (size_t i = 0; i < 9; i++) {
+    DiscreteKeys row, col, box;
+    for (size_t j = 0; j < 9; j++) {
+      row += DiscreteKey(offset + 9 * i + j, 9);
+      col += DiscreteKey(offset + 9 * j + i, 9);
+      box += DiscreteKey(offset + 9 * (3 * (i / 3) + j / 3) + 3 * (i % 3) + j % 3, 9);
+    }
+    csp.addAllDiff(row);
+    csp.addAllDiff(col);
+    csp.addAllDiff(box);
+  }
+}
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  // 600 puzzles have 48600 variables
+  const size_t nrPuzzles = argc > 1 ? atoi(argv[1]) : 600;
+  CSP csp;
+  for (size_t p = 0; p < nrPuzzles; p++)
+    addSudoku(csp, 81 * p);
+  cout << "Arc consistency on " << 81 * nrPuzzles << " variables and " << csp.size()
+      << " constraints" << endl;
+
+  vector<Domain> domains;
+  gttic_(runArcConsistency);
+  domains = csp.runArcConsistency(9, 100);
+  gttoc_(runArcConsistency);
+
+  size_t nrSolved = 0;
+  for (size_t j = 0; j < domains.size(); j++)
+    if (domains[j].isSingleton()) ++nrSolved;
+  cout << nrSolved << " variables have a single value left" << endl;
+
+  tictoc_print_();
+  return 0;
+}
@@ -0,0 +1,95 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeBTreeVariants.cpp
+ * @brief   Time the binary BTree against the wide-node PersistentBTree
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam_unstable/base/BTree.h>
+#include <gtsam_unstable/base/PersistentBTree.h>
+
+#include <boost/random.hpp>
+#include <boost/timer.hpp>
+#include <boost/format.hpp>
+#include <boost/foreach.hpp>
+#include <boost/assign/std/vector.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+using namespace boost::assign;
+using boost::timer;
+using boost::format;
+
+// Insert all keys one version at a time, look every key up, iterate, and remove half of them
+template<class TREE>
+void timeTree(const string& name, const vector<size_t>& keys, ostream& os) {
+  TREE tree;
+  timer tim;
+  BOOST_FOREACH(size_t key, keys)
+    tree = tree.add(key, key);
+  double add = tim.elapsed();
+
+  tim.restart();
+  size_t sum = 0;
+  for (size_t r = 0; r < 10; r++)
+    BOOST_FOREACH(size_t key, keys)
+      sum += tree.find(key);
+  double find = tim.elapsed();
+
+  tim.restart();
+  for (typename TREE::const_iterator it = tree.begin(); it != tree.end(); ++it)
+    sum += (*it).second;
+  double iterate = tim.elapsed();
+
+  // keep the old version alive, as a concurrent reader would
+  TREE snapshot = tree;
+  tim.restart();
+  for (size_t k = 0; k < keys.size(); k += 2)
+    tree = tree.remove(keys[k]);
+  double remove = tim.elapsed();
+
+  os << add << "," << find << "," << iterate << "," << remove << ",";
+  cout << format("%1%: add %2% s, 10x find %3% s, iterate %4% s, remove %5% s (%6%, %7%)")
+      % name % add % find % iterate % remove % tree.size() % (sum % 10) << endl;
+}
+
+int main(int argc, char* argv[]) {
+
+  // Create CSV file for results
+  ofstream os("btree-timing.csv");
+  os << "keys,BTree add,find,iterate,remove,PersistentBTree add,find,iterate,remove" << endl;
+
+  vector<size_t> ns;
+  ns += 1000, 10000, 100000, 1000000;
+  BOOST_FOREACH(size_t n, ns) {
+    cout << format("\nTesting with %1% keys\n") % (int)n;
+    boost::variate_generator<boost::mt19937, boost::uniform_int<size_t> > rn(
+        boost::mt19937(), boost::uniform_int<size_t>(0, 100 * n));
+    vector<size_t> keys;
+    keys.reserve(n);
+    for (size_t k = 0; k < n; k++)
+      keys.push_back(rn());
+
+    os << n << ",";
+    timeTree<BTree<size_t, size_t> >("BTree", keys, os);
+    timeTree<PersistentBTree<size_t, size_t> >("PersistentBTree", keys, os);
+    os << endl;
+  }
+
+  return 0;
+
+}
@@ -0,0 +1,290 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeIncrementalReplay.cpp
+ * @brief   Replay a pose graph step by step through ISAM2 and the fixed-lag smoothers,
+ *          reporting per-step latency percentiles, loop closures and memory growth
+ * @date    Oct 15, 2026
+ *
+ * Usage: timeIncrementalReplay [--dataset file] [--lag steps] [--steps N] [--csv file]
+ *
+ * Pose i arrives at step i with timestamp i, together with all factors whose highest key is
+ * i. A factor connecting non-consecutive poses is counted as a loop closure. The fixed-lag
+ * smoothers cannot use factors on poses that left their window, so those loop closures are
+ * dropped from their stream and counted in the report.
+ */
+
+#include <gtsam_unstable/nonlinear/BatchFixedLagSmoother.h>
+#include <gtsam_unstable/nonlinear/IncrementalFixedLagSmoother.h>
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/slam/dataset.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/geometry/Pose2.h>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/foreach.hpp>
+#include <boost/format.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace gtsam;
+using boost::format;
+
+/* ************************************************************************* */
+// Resident set size of the process in bytes, or 0 where not available
+static size_t residentBytes() {
+#ifdef __linux__
+  ifstream statm("/proc/self/statm");
+  size_t pages = 0, resident = 0;
+  if (statm >> pages >> resident)
+    return resident * sysconf(_SC_PAGESIZE);
+#endif
+  return 0;
+}
+
+static double secondsSince(const boost::posix_time::ptime& start) {
+  return 1e-6 * (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds();
+}
+
+/* ************************************************************************* */
+// What we record about every step
+struct StepRecord {
+  double seconds;
+  bool loopClosure;
+  size_t factors;         // factors currently held by the solver
+  size_t residentBytes;   // process memory after the step
+  size_t reeliminated;    // ISAM2Result::variablesReeliminated, for the iSAM2-based solvers
+  size_t cliques;         // ISAM2Result::cliques
+  size_t bytesAllocated;  // ISAM2Result::Metrics::bytesAllocated
+  StepRecord() : seconds(0), loopClosure(false), factors(0), residentBytes(0),
+      reeliminated(0), cliques(0), bytesAllocated(0) {}
+};
+
+// Common interface of the solvers being compared
+class Solver {
+public:
+  virtual ~Solver() {}
+  virtual string name() const = 0;
+  /// Lag in steps, or 0 if the solver keeps the whole history
+  virtual size_t lag() const { return 0; }
+  /// Add the step's factors and new pose, filling in everything but the time
+  virtual void update(const NonlinearFactorGraph& factors, const Values& values,
+      double timestamp, StepRecord& record) = 0;
+};
+
+class ISAM2Solver : public Solver {
+  ISAM2 isam2_;
+public:
+  string name() const { return "ISAM2"; }
+  void update(const NonlinearFactorGraph& factors, const Values& values,
+      double timestamp, StepRecord& record) {
+    const ISAM2Result result = isam2_.update(factors, values);
+    record.factors = isam2_.getFactorsUnsafe().nrFactors();
+    record.reeliminated = result.variablesReeliminated;
+    record.cliques = result.cliques;
+    record.bytesAllocated = result.metrics.bytesAllocated;
+  }
+};
+
+class IncrementalFixedLagSolver : public Solver {
+  size_t lag_;
+  IncrementalFixedLagSmoother smoother_;
+public:
+  explicit IncrementalFixedLagSolver(size_t lag) : lag_(lag), smoother_(double(lag)) {}
+  string name() const { return "IncrementalFixedLagSmoother"; }
+  size_t lag() const { return lag_; }
+  void update(const NonlinearFactorGraph& factors, const Values& values,
+      double timestamp, StepRecord& record) {
+    FixedLagSmoother::KeyTimestampMap timestamps;
+    BOOST_FOREACH(Key key, values.keys()) timestamps[key] = timestamp;
+    smoother_.update(factors, values, timestamps);
+    const ISAM2Result& result = smoother_.getISAM2Result();
+    record.factors = smoother_.getFactors().nrFactors();
+    record.reeliminated = result.variablesReeliminated;
+    record.cliques = result.cliques;
+    record.bytesAllocated = result.metrics.bytesAllocated;
+  }
+};
+
+class BatchFixedLagSolver : public Solver {
+  size_t lag_;
+  BatchFixedLagSmoother smoother_;
+public:
+  explicit BatchFixedLagSolver(size_t lag) : lag_(lag), smoother_(double(lag)) {}
+  string name() const { return "BatchFixedLagSmoother"; }
+  size_t lag() const { return lag_; }
+  void update(const NonlinearFactorGraph& factors, const Values& values,
+      double timestamp, StepRecord& record) {
+    FixedLagSmoother::KeyTimestampMap timestamps;
+    BOOST_FOREACH(Key key, values.keys()) timestamps[key] = timestamp;
+    smoother_.update(factors, values, timestamps);
+    record.factors = smoother_.getFactors().nrFactors();
+  }
+};
+
+/* ************************************************************************* */
+// Nearest-rank percentile of sorted samples
+static double percentile(const vector<double>& sorted, double p) {
+  if (sorted.empty()) return 0;
+  size_t rank = size_t(ceil(p / 100.0 * sorted.size()));
+  return sorted[min(sorted.size(), max<size_t>(rank, 1)) - 1];
+}
+
+// Print percentiles, the worst loop closure, memory growth and a log2 latency histogram
+static void report(const Solver& solver, const vector<StepRecord>& records,
+    size_t droppedLoopClosures, size_t startBytes) {
+  vector<double> times;
+  double total = 0, worstLoopClosure = 0;
+  size_t worstLoopClosureStep = 0, loopClosures = 0;
+  for (size_t step = 0; step < records.size(); step++) {
+    const StepRecord& r = records[step];
+    times.push_back(r.seconds);
+    total += r.seconds;
+    if (r.loopClosure) {
+      ++loopClosures;
+      if (r.seconds > worstLoopClosure) {
+        worstLoopClosure = r.seconds;
+        worstLoopClosureStep = step;
+      }
+    }
+  }
+  sort(times.begin(), times.end());
+
+  cout << "\n" << solver.name();
+  if (solver.lag()) cout << " (lag " << solver.lag() << " steps)";
+  cout << "\n  steps " << records.size() << ", total " << total << " s, loop closures "
+      << loopClosures << " (" << droppedLoopClosures << " dropped outside the window)\n";
+  cout << format("  latency ms: p50 %.3f  p90 %.3f  p99 %.3f  p99.9 %.3f  max %.3f\n")
+      % (1e3 * percentile(times, 50)) % (1e3 * percentile(times, 90))
+      % (1e3 * percentile(times, 99)) % (1e3 * percentile(times, 99.9))
+      % (1e3 * percentile(times, 100));
+  if (loopClosures)
+    cout << format("  worst loop closure: step %d, %.3f ms\n") % worstLoopClosureStep
+        % (1e3 * worstLoopClosure);
+  if (!records.empty()) {
+    const StepRecord& last = records.back();
+    cout << "  factors at end " << last.factors;
+    if (last.residentBytes)
+      cout << ", resident memory growth "
+          << (double(last.residentBytes) - double(startBytes)) / (1 << 20) << " MB";
+    cout << "\n";
+  }
+
+  // Histogram with power-of-two buckets starting at 1 microsecond
+  vector<size_t> buckets;
+  BOOST_FOREACH(double t, times) {
+    size_t b = t > 1e-6 ? size_t(log(t / 1e-6) / log(2.0)) : 0;
+    if (b >= buckets.size()) buckets.resize(b + 1, 0);
+    ++buckets[b];
+  }
+  const size_t width = 50;
+  size_t largest = buckets.empty() ? 1 : *max_element(buckets.begin(), buckets.end());
+  for (size_t b = 0; b < buckets.size(); b++) {
+    if (!buckets[b]) continue;
+    cout << format("  < %10.3f ms %8d ") % (1e-3 * double(2ul << b)) % buckets[b]
+        << string((buckets[b] * width + largest - 1) / largest, '#') << "\n";
+  }
+}
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  string datasetName = "w10000";
+  size_t lag = 100, maxSteps = 0;
+  string csvFile;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (!strcmp(argv[i], "--dataset")) datasetName = argv[i + 1];
+    else if (!strcmp(argv[i], "--lag")) lag = strtoul(argv[i + 1], 0, 10);
+    else if (!strcmp(argv[i], "--steps")) maxSteps = strtoul(argv[i + 1], 0, 10);
+    else if (!strcmp(argv[i], "--csv")) csvFile = argv[i + 1];
+    else
+      throw runtime_error("Usage: timeIncrementalReplay [--dataset file] [--lag steps] "
+          "[--steps N] [--csv file]");
+  }
+
+  // Load the dataset and split it into steps, by the highest key of each factor
+  const string datasetFile = ifstream(datasetName.c_str()) ? datasetName :
+      findExampleDataFile(datasetName);
+  GraphAndValues data = load2D(datasetFile);
+  const Values& initial = *data.second;
+  size_t steps = initial.size();
+  if (maxSteps) steps = min(steps, maxSteps);
+  vector<NonlinearFactorGraph> stepFactors(steps);
+  stepFactors[0].push_back(PriorFactor<Pose2>(0, initial.at<Pose2>(0),
+      noiseModel::Unit::Create(3)));
+  BOOST_FOREACH(const NonlinearFactor::shared_ptr& factor, *data.first) {
+    const Key last = *max_element(factor->begin(), factor->end());
+    if (last < steps) stepFactors[last].push_back(factor);
+  }
+  cout << "Replaying " << steps << " steps of " << datasetFile << endl;
+
+  vector<boost::shared_ptr<Solver> > solvers;
+  solvers.push_back(boost::shared_ptr<Solver>(new ISAM2Solver()));
+  solvers.push_back(boost::shared_ptr<Solver>(new IncrementalFixedLagSolver(lag)));
+  solvers.push_back(boost::shared_ptr<Solver>(new BatchFixedLagSolver(lag)));
+
+  ofstream csv;
+  if (!csvFile.empty()) {
+    csv.open(csvFile.c_str());
+    csv << "solver,step,seconds,loopClosure,factors,residentBytes,reeliminated,cliques,"
+        "bytesAllocated\n";
+  }
+
+  BOOST_FOREACH(const boost::shared_ptr<Solver>& solver, solvers) {
+    const size_t startBytes = residentBytes();
+    vector<StepRecord> records(steps);
+    size_t dropped = 0;
+    for (size_t step = 0; step < steps; step++) {
+      // Keep only the factors on poses still inside the solver's window
+      NonlinearFactorGraph factors;
+      BOOST_FOREACH(const NonlinearFactor::shared_ptr& factor, stepFactors[step]) {
+        const Key first = *min_element(factor->begin(), factor->end());
+        const bool loopClosure = first + 1 < step;
+        records[step].loopClosure |= loopClosure;
+        if (solver->lag() && first + solver->lag() < step) {
+          ++dropped;
+          continue;
+        }
+        factors.push_back(factor);
+      }
+      Values values;
+      values.insert(step, initial.at(step));
+
+      const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+      solver->update(factors, values, double(step), records[step]);
+      records[step].seconds = secondsSince(start);
+      records[step].residentBytes = residentBytes();
+
+      if (csv.is_open()) {
+        const StepRecord& r = records[step];
+        csv << solver->name() << "," << step << "," << r.seconds << "," << r.loopClosure << ","
+            << r.factors << "," << r.residentBytes << "," << r.reeliminated << "," << r.cliques
+            << "," << r.bytesAllocated << "\n";
+      }
+    }
+    report(*solver, records, dropped, startBytes);
+  }
+
+  return 0;
+}
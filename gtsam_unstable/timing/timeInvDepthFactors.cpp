@@ -0,0 +1,119 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeInvDepthFactors.cpp
+ * @brief   time InvDepthCamera3 and InvDepthFactorVariant derivatives
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam_unstable/slam/InvDepthFactor3.h>
+#include <gtsam_unstable/slam/InvDepthFactorVariant1.h>
+#include <gtsam_unstable/slam/InvDepthFactorVariant2.h>
+#include <gtsam_unstable/slam/InvDepthFactorVariant3.h>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+
+static void report(const string& name, long timeLog, long timeLog2, int n) {
+  double seconds = (double)(timeLog2-timeLog)/CLOCKS_PER_SEC;
+  cout << name << ": " << ((double)n/seconds) << " calls/second, "
+      << ((double)seconds*1000000/n) << " musecs/call" << endl;
+}
+
+int main()
+{
+  int n = 100000;
+
+  Cal3_S2::shared_ptr K(new Cal3_S2(1500, 1200, 0, 640, 480));
+  const Pose3 pose1(Rot3::ypr(-M_PI/2, 0., -M_PI/2), Point3(0,0,1));
+  const Pose3 pose2(Rot3::ypr(-M_PI/2, 0.1, -M_PI/2), Point3(0,0.2,1.5));
+  const Vector5 pw((Vector(5) << 0.1,0.2,0.3, 0.1,0.2).finished());
+  const double rho = 1./4;
+  const Point2 z(600, 500);
+  SharedNoiseModel model = noiseModel::Unit::Create(2);
+
+  {
+    InvDepthCamera3<Cal3_S2> camera(pose1, K);
+    Matrix H1, H2, H3;
+    long timeLog = clock();
+    for(int i = 0; i < n; i++)
+      camera.project(pw, rho, H1, H2, H3);
+    report("InvDepthCamera3::project", timeLog, clock(), n);
+  }
+
+  {
+    // a landmark observed in 10 images, projected one camera at a time and batched
+    vector<Pose3> poses(10, pose1);
+    for (size_t j = 0; j < poses.size(); j++)
+      poses[j] = pose1.retract((Vector(6) << 0.01*j,0,0, 0,0.05*j,0).finished());
+    Matrix H1, H2, H3;
+    long timeLog = clock();
+    for(int i = 0; i < n/10; i++)
+      for (size_t j = 0; j < poses.size(); j++)
+        InvDepthCamera3<Cal3_S2>(poses[j], K).project(pw, rho, H1, H2, H3);
+    report("InvDepthCamera3::project x10", timeLog, clock(), n/10);
+    timeLog = clock();
+    for(int i = 0; i < n/10; i++)
+      InvDepthCamera3<Cal3_S2>::projectBatch(poses, *K, pw, rho, &H1, &H2, &H3);
+    report("InvDepthCamera3::projectBatch x10", timeLog, clock(), n/10);
+  }
+
+  {
+    InvDepthFactor3<Pose3, Vector5, double> factor(z, model, 1, 2, 3, K);
+    Matrix H1, H2, H3;
+    long timeLog = clock();
+    for(int i = 0; i < n; i++)
+      factor.evaluateError(pose1, pw, rho, H1, H2, H3);
+    report("InvDepthFactor3", timeLog, clock(), n);
+  }
+
+  {
+    InvDepthFactorVariant1 factor(1, 2, z, K, model);
+    const Vector6 landmark((Vector(6) << pw, rho).finished());
+    Matrix H1, H2;
+    long timeLog = clock();
+    for(int i = 0; i < n; i++)
+      factor.evaluateError(pose1, landmark, H1, H2);
+    report("InvDepthFactorVariant1", timeLog, clock(), n);
+  }
+
+  {
+    InvDepthFactorVariant2 factor(1, 2, z, K, Point3(0.1,0.2,0.3), model);
+    const Vector3 landmark(0.1, 0.2, rho);
+    Matrix H1, H2;
+    long timeLog = clock();
+    for(int i = 0; i < n; i++)
+      factor.evaluateError(pose1, landmark, H1, H2);
+    report("InvDepthFactorVariant2", timeLog, clock(), n);
+  }
+
+  {
+    InvDepthFactorVariant3a factor1(1, 3, z, K, model);
+    InvDepthFactorVariant3b factor2(1, 2, 3, z, K, model);
+    const Vector3 landmark(0.1, 0.2, rho);
+    Matrix H1, H2, H3;
+    long timeLog = clock();
+    for(int i = 0; i < n; i++)
+      factor1.evaluateError(pose1, landmark, H1, H2);
+    report("InvDepthFactorVariant3a", timeLog, clock(), n);
+    timeLog = clock();
+    for(int i = 0; i < n; i++)
+      factor2.evaluateError(pose1, pose2, landmark, H1, H2, H3);
+    report("InvDepthFactorVariant3b", timeLog, clock(), n);
+  }
+
+  return 0;
+}
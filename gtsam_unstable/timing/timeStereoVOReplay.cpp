@@ -0,0 +1,426 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeStereoVOReplay.cpp
+ * @brief   Replay a stereo visual odometry sequence frame by frame through ISAM2, with
+ *          GenericStereoFactor landmarks and with SmartStereoProjectionPoseFactor, reporting
+ *          sustained throughput, latency percentiles and a per-phase breakdown
+ * @date    Oct 15, 2026
+ *
+ * Usage: timeStereoVOReplay [--generated frames] [--frames N] [--window frames]
+ *                           [--target-fps F] [--target-p99 ms] [--csv file]
+ *
+ * By default the bundled VO_*_large.txt sequence is replayed. With --generated a longer
+ * sequence is synthesized instead: the camera drives down a corridor whose walls are lined
+ * with landmarks. Frame i brings pose i and all stereo measurements taken from it.
+ *
+ * The GenericStereoFactor pipeline adds a landmark variable on first sight and one factor per
+ * measurement. The smart factor pipeline keeps one factor per landmark, starting when it has
+ * been seen twice, and replaces it (through removeFactorIndices) whenever its track grows.
+ *
+ * Sustained throughput is that of the slowest window of consecutive frames. If targets are
+ * given, the process exits with status 1 when a pipeline misses them.
+ */
+
+#include <gtsam_unstable/slam/SmartStereoProjectionPoseFactor.h>
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/slam/StereoFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/dataset.h>
+#include <gtsam/geometry/StereoCamera.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/foreach.hpp>
+#include <boost/format.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace gtsam;
+using boost::format;
+using symbol_shorthand::L;
+using symbol_shorthand::X;
+
+/* ************************************************************************* */
+// Resident set size of the process in bytes, or 0 where not available
+static size_t residentBytes() {
+#ifdef __linux__
+  ifstream statm("/proc/self/statm");
+  size_t pages = 0, resident = 0;
+  if (statm >> pages >> resident)
+    return resident * sysconf(_SC_PAGESIZE);
+#endif
+  return 0;
+}
+
+static boost::posix_time::ptime now() {
+  return boost::posix_time::microsec_clock::universal_time();
+}
+
+static double secondsSince(const boost::posix_time::ptime& start) {
+  return 1e-6 * (now() - start).total_microseconds();
+}
+
+/* ************************************************************************* */
+// A stereo measurement of a landmark, with the landmark position used to initialize it
+struct Observation {
+  size_t landmark;
+  StereoPoint2 measured;
+  Point3 initial;  // in world coordinates
+  Observation(size_t l, const StereoPoint2& z, const Point3& p) :
+      landmark(l), measured(z), initial(p) {}
+};
+
+// The sequence to replay: initial poses and the measurements taken from each of them
+struct Sequence {
+  string name;
+  Cal3_S2Stereo::shared_ptr K;
+  vector<Pose3> poses;
+  vector<vector<Observation> > observations;
+};
+
+// Read the bundled VO_calibration.txt, VO_camera_poses_large.txt and VO_stereo_factors_large.txt
+static Sequence loadBundled() {
+  Sequence sequence;
+  sequence.name = "VO_stereo_factors_large.txt";
+
+  double fx, fy, s, u0, v0, b;
+  ifstream calibration(findExampleDataFile("VO_calibration.txt").c_str());
+  if (!(calibration >> fx >> fy >> s >> u0 >> v0 >> b))
+    throw runtime_error("timeStereoVOReplay: could not read VO_calibration.txt");
+  sequence.K.reset(new Cal3_S2Stereo(fx, fy, s, u0, v0, b));
+
+  // Pose ids need not start at 0, so map them to frame numbers in the order of the file
+  map<size_t, size_t> frameOf;
+  ifstream poses(findExampleDataFile("VO_camera_poses_large.txt").c_str());
+  size_t id;
+  MatrixRowMajor m(4, 4);
+  while (poses >> id) {
+    for (int i = 0; i < 16; i++)
+      poses >> m.data()[i];
+    frameOf[id] = sequence.poses.size();
+    sequence.poses.push_back(Pose3(m));
+  }
+  sequence.observations.resize(sequence.poses.size());
+
+  // The landmark positions in the file are in the frame of the observing camera
+  ifstream factors(findExampleDataFile("VO_stereo_factors_large.txt").c_str());
+  size_t x, l;
+  double uL, uR, v, X, Y, Z;
+  while (factors >> x >> l >> uL >> uR >> v >> X >> Y >> Z) {
+    map<size_t, size_t>::const_iterator frame = frameOf.find(x);
+    if (frame == frameOf.end()) continue;
+    sequence.observations[frame->second].push_back(Observation(l, StereoPoint2(uL, uR, v),
+        sequence.poses[frame->second].transform_from(Point3(X, Y, Z))));
+  }
+  return sequence;
+}
+
+// Drive down a corridor along the world x axis, 0.5m per frame, with landmarks every meter on
+// both walls at two heights. Initial poses and landmarks are perturbed deterministically.
+static Sequence generate(size_t frames) {
+  Sequence sequence;
+  sequence.name = (format("generated corridor, %d frames") % frames).str();
+  sequence.K.reset(new Cal3_S2Stereo(500, 500, 0, 320, 240, 0.5));
+  const double step = 0.5, minDepth = 2, maxDepth = 20;
+
+  // camera z looks down the corridor, x to the right and y down
+  const Rot3 R(Point3(0, -1, 0), Point3(0, 0, -1), Point3(1, 0, 0));
+  vector<Pose3> truth;
+  for (size_t i = 0; i < frames; i++) {
+    const double t = step * i;
+    truth.push_back(Pose3(R, Point3(t, 0.3 * sin(0.05 * t), 0)));
+    sequence.poses.push_back(truth.back().compose(Pose3(Rot3::RzRyRx(0.002 * sin(0.7 * i),
+        0.002 * cos(0.3 * i), 0.001), Point3(0.01 * cos(1.3 * i), 0.01, 0.01 * sin(0.9 * i)))));
+  }
+
+  const size_t columns = size_t(step * frames + maxDepth) + 1;
+  sequence.observations.resize(frames);
+  for (size_t i = 0; i < frames; i++) {
+    const StereoCamera camera(truth[i], sequence.K);
+    for (size_t l = 0; l < 4 * columns; l++) {
+      const Point3 point(double(l / 4), (l % 2) ? 5.0 : -5.0, (l % 4) < 2 ? -1.0 : 1.5);
+      const Point3 q = truth[i].transform_to(point);
+      if (q.z() < minDepth || q.z() > maxDepth) continue;
+      const StereoPoint2 z = camera.project(point);
+      if (z.uL() < 0 || z.uL() > 640 || z.uR() < 0 || z.v() < 0 || z.v() > 480) continue;
+      sequence.observations[i].push_back(Observation(l, z,
+          point + Point3(0.05 * sin(double(l)), 0.05 * cos(double(l)), 0.05)));
+    }
+  }
+  return sequence;
+}
+
+/* ************************************************************************* */
+// What we record about every frame; the phases add up to the frame latency
+struct FrameRecord {
+  double build;     // creating the new factors and values
+  double update;    // ISAM2::update
+  double estimate;  // ISAM2::calculateEstimate
+  size_t measurements;
+  size_t factors;         // factors currently held by ISAM2
+  size_t residentBytes;   // process memory after the frame
+  size_t relinearized;    // ISAM2Result::variablesRelinearized
+  size_t reeliminated;    // ISAM2Result::variablesReeliminated
+  FrameRecord() : build(0), update(0), estimate(0), measurements(0), factors(0),
+      residentBytes(0), relinearized(0), reeliminated(0) {}
+  double seconds() const { return build + update + estimate; }
+};
+
+// Common interface of the two factor formulations being compared
+class Pipeline {
+protected:
+  const Sequence& sequence_;
+  const SharedNoiseModel model_;
+  ISAM2 isam2_;
+  Values estimate_;
+public:
+  Pipeline(const Sequence& sequence, const ISAM2Params& params) :
+      sequence_(sequence), model_(noiseModel::Isotropic::Sigma(3, 1)), isam2_(params) {}
+  virtual ~Pipeline() {}
+  virtual string name() const = 0;
+  /// Create the factors and values brought by a frame
+  virtual void build(size_t frame, NonlinearFactorGraph& factors, Values& values,
+      vector<size_t>& removeIndices) = 0;
+  /// Called with the result of the update that added the frame
+  virtual void updated(const ISAM2Result& /*result*/) {}
+
+  /// Replay one frame, timing each phase
+  void replay(size_t frame, FrameRecord& record) {
+    boost::posix_time::ptime start = now();
+    NonlinearFactorGraph factors;
+    Values values;
+    vector<size_t> removeIndices;
+    values.insert(X(frame), sequence_.poses[frame]);
+    if (frame == 0)
+      factors.push_back(PriorFactor<Pose3>(X(0), sequence_.poses[0],
+          noiseModel::Isotropic::Sigma(6, 1e-3)));
+    build(frame, factors, values, removeIndices);
+    record.build = secondsSince(start);
+
+    start = now();
+    const ISAM2Result result = isam2_.update(factors, values, removeIndices);
+    updated(result);
+    record.update = secondsSince(start);
+
+    start = now();
+    estimate_ = isam2_.calculateEstimate();
+    record.estimate = secondsSince(start);
+
+    record.measurements = sequence_.observations[frame].size();
+    record.factors = isam2_.getFactorsUnsafe().nrFactors();
+    record.relinearized = result.variablesRelinearized;
+    record.reeliminated = result.variablesReeliminated;
+  }
+};
+
+// One landmark variable per landmark and one GenericStereoFactor per measurement
+class GenericStereoPipeline : public Pipeline {
+  KeySet landmarks_;
+public:
+  GenericStereoPipeline(const Sequence& sequence, const ISAM2Params& params) :
+      Pipeline(sequence, params) {}
+  string name() const { return "GenericStereoFactor"; }
+  void build(size_t frame, NonlinearFactorGraph& factors, Values& values,
+      vector<size_t>& /*removeIndices*/) {
+    BOOST_FOREACH(const Observation& o, sequence_.observations[frame]) {
+      factors.push_back(GenericStereoFactor<Pose3, Point3>(o.measured, model_, X(frame),
+          L(o.landmark), sequence_.K));
+      if (landmarks_.insert(L(o.landmark)).second)
+        values.insert(L(o.landmark), o.initial);
+    }
+  }
+};
+
+// One SmartStereoProjectionPoseFactor per landmark seen at least twice, replaced as it grows
+class SmartStereoPipeline : public Pipeline {
+  typedef SmartStereoProjectionPoseFactor SmartFactor;
+  struct Track {
+    vector<StereoPoint2> measured;
+    vector<Key> poses;
+    size_t index;  // of the current smart factor in ISAM2, if any
+    bool added;
+    Track() : index(0), added(false) {}
+  };
+  map<size_t, Track> tracks_;
+  vector<size_t> pending_;  // landmarks whose new factor is in the current update
+public:
+  SmartStereoPipeline(const Sequence& sequence, const ISAM2Params& params) :
+      Pipeline(sequence, params) {}
+  string name() const { return "SmartStereoProjectionPoseFactor"; }
+  void build(size_t frame, NonlinearFactorGraph& factors, Values& /*values*/,
+      vector<size_t>& removeIndices) {
+    pending_.clear();
+    BOOST_FOREACH(const Observation& o, sequence_.observations[frame]) {
+      Track& track = tracks_[o.landmark];
+      track.measured.push_back(o.measured);
+      track.poses.push_back(X(frame));
+      if (track.poses.size() < 2) continue;
+      if (track.added) removeIndices.push_back(track.index);
+      boost::shared_ptr<SmartFactor> factor(new SmartFactor(model_));
+      factor->add(track.measured, track.poses, sequence_.K);
+      factors.push_back(factor);
+      pending_.push_back(o.landmark);
+    }
+  }
+  void updated(const ISAM2Result& result) {
+    for (size_t i = 0; i < pending_.size(); i++) {
+      Track& track = tracks_[pending_[i]];
+      track.index = result.newFactorsIndices[i + (result.newFactorsIndices.size() -
+          pending_.size())];
+      track.added = true;
+    }
+  }
+};
+
+/* ************************************************************************* */
+// Nearest-rank percentile of sorted samples
+static double percentile(const vector<double>& sorted, double p) {
+  if (sorted.empty()) return 0;
+  size_t rank = size_t(ceil(p / 100.0 * sorted.size()));
+  return sorted[min(sorted.size(), max<size_t>(rank, 1)) - 1];
+}
+
+// Print throughput, latency percentiles, the per-phase breakdown and memory growth, and
+// return whether the targets (if positive) are met
+static bool report(const Pipeline& pipeline, const vector<FrameRecord>& records,
+    size_t window, size_t startBytes, double targetFps, double targetP99) {
+  vector<double> times;
+  double total = 0, build = 0, update = 0, estimate = 0;
+  size_t measurements = 0;
+  BOOST_FOREACH(const FrameRecord& r, records) {
+    times.push_back(r.seconds());
+    total += r.seconds();
+    build += r.build;
+    update += r.update;
+    estimate += r.estimate;
+    measurements += r.measurements;
+  }
+
+  // Slowest window of consecutive frames
+  window = max<size_t>(1, min(window, records.size()));
+  double windowTime = 0, slowestWindow = 0;
+  for (size_t i = 0; i < records.size(); i++) {
+    windowTime += records[i].seconds();
+    if (i >= window) windowTime -= records[i - window].seconds();
+    if (i + 1 >= window) slowestWindow = max(slowestWindow, windowTime);
+  }
+  sort(times.begin(), times.end());
+
+  const double fps = total > 0 ? records.size() / total : 0;
+  const double sustainedFps = slowestWindow > 0 ? window / slowestWindow : 0;
+  const double p99 = 1e3 * percentile(times, 99);
+  cout << "\n" << pipeline.name() << "\n";
+  cout << format("  frames %d, total %.3f s, %.1f frames/s, %.0f measurements/s\n")
+      % records.size() % total % fps % (total > 0 ? measurements / total : 0);
+  cout << format("  sustained %.1f frames/s (slowest window of %d frames)\n")
+      % sustainedFps % window;
+  cout << format("  latency ms: p50 %.3f  p90 %.3f  p99 %.3f  max %.3f\n")
+      % (1e3 * percentile(times, 50)) % (1e3 * percentile(times, 90)) % p99
+      % (1e3 * percentile(times, 100));
+  if (total > 0)
+    cout << format("  phases: build %.3f s (%.1f%%), update %.3f s (%.1f%%), "
+        "estimate %.3f s (%.1f%%)\n") % build % (100 * build / total) % update
+        % (100 * update / total) % estimate % (100 * estimate / total);
+  if (!records.empty()) {
+    const FrameRecord& last = records.back();
+    cout << "  factors at end " << last.factors;
+    if (last.residentBytes)
+      cout << ", resident memory growth "
+          << (double(last.residentBytes) - double(startBytes)) / (1 << 20) << " MB";
+    cout << "\n";
+  }
+
+  bool met = true;
+  if (targetFps > 0 && sustainedFps < targetFps) met = false;
+  if (targetP99 > 0 && p99 > targetP99) met = false;
+  if (targetFps > 0 || targetP99 > 0)
+    cout << "  targets " << (met ? "met" : "MISSED") << "\n";
+  return met;
+}
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  size_t generated = 0, maxFrames = 0, window = 50;
+  double targetFps = 0, targetP99 = 0;
+  string csvFile;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (!strcmp(argv[i], "--generated")) generated = strtoul(argv[i + 1], 0, 10);
+    else if (!strcmp(argv[i], "--frames")) maxFrames = strtoul(argv[i + 1], 0, 10);
+    else if (!strcmp(argv[i], "--window")) window = strtoul(argv[i + 1], 0, 10);
+    else if (!strcmp(argv[i], "--target-fps")) targetFps = atof(argv[i + 1]);
+    else if (!strcmp(argv[i], "--target-p99")) targetP99 = atof(argv[i + 1]);
+    else if (!strcmp(argv[i], "--csv")) csvFile = argv[i + 1];
+    else
+      throw runtime_error("Usage: timeStereoVOReplay [--generated frames] [--frames N] "
+          "[--window frames] [--target-fps F] [--target-p99 ms] [--csv file]");
+  }
+
+  const Sequence sequence = generated ? generate(generated) : loadBundled();
+  size_t frames = sequence.poses.size();
+  if (maxFrames) frames = min(frames, maxFrames);
+  size_t measurements = 0;
+  for (size_t i = 0; i < frames; i++)
+    measurements += sequence.observations[i].size();
+  cout << "Replaying " << frames << " frames with " << measurements << " measurements of "
+      << sequence.name << endl;
+
+  // Smart factors re-triangulate on every linearization, so they cannot be cached
+  ISAM2Params params;
+  params.relinearizeSkip = 1;
+  ISAM2Params smartParams = params;
+  smartParams.cacheLinearizedFactors = false;
+
+  vector<boost::shared_ptr<Pipeline> > pipelines;
+  pipelines.push_back(boost::shared_ptr<Pipeline>(new GenericStereoPipeline(sequence, params)));
+  pipelines.push_back(boost::shared_ptr<Pipeline>(new SmartStereoPipeline(sequence,
+      smartParams)));
+
+  ofstream csv;
+  if (!csvFile.empty()) {
+    csv.open(csvFile.c_str());
+    csv << "pipeline,frame,seconds,build,update,estimate,measurements,factors,residentBytes,"
+        "relinearized,reeliminated\n";
+  }
+
+  bool met = true;
+  BOOST_FOREACH(const boost::shared_ptr<Pipeline>& pipeline, pipelines) {
+    const size_t startBytes = residentBytes();
+    vector<FrameRecord> records(frames);
+    for (size_t frame = 0; frame < frames; frame++) {
+      FrameRecord& r = records[frame];
+      pipeline->replay(frame, r);
+      r.residentBytes = residentBytes();
+      if (csv.is_open())
+        csv << pipeline->name() << "," << frame << "," << r.seconds() << "," << r.build << ","
+            << r.update << "," << r.estimate << "," << r.measurements << "," << r.factors << ","
+            << r.residentBytes << "," << r.relinearized << "," << r.reeliminated << "\n";
+    }
+    met &= report(*pipeline, records, window, startBytes, targetFps, targetP99);
+  }
+
+  return met ? 0 : 1;
+}
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <gtsam/slam/ProjectionFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/nonlinear/Values.h>
@@ -29,6 +30,7 @@
 #include <gtsam/geometry/SimpleCamera.h>
 
 #include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
 
 #include <exception>
 
@@ -137,6 +139,111 @@ Matrix extractPose3(const Values& values) {
   return result;
 }
 
+/// Check that a matrix has one row of the given width per key
+static void checkRows(const char* function, const Vector& J, const Matrix& M,
+    int width) {
+  if (M.cols() != width || M.rows() != J.size())
+    throw std::invalid_argument(std::string(function) + ": expected a "
+        + boost::lexical_cast<std::string>(J.size()) + "*"
+        + boost::lexical_cast<std::string>(width) + " matrix");
+}
+
+/// Pose3 from a row [r11 r12 r13 r21 r22 r23 r31 r32 r33 x y z], as in extractPose3
+static Pose3 pose3FromRow(const Matrix& M, int j) {
+  Matrix3 R;
+  R << M.row(j).segment(0, 3), M.row(j).segment(3, 3), M.row(j).segment(6, 3);
+  return Pose3(Rot3(R), Point3(M(j, 9), M(j, 10), M(j, 11)));
+}
+
+/// Insert Point2 values with keys J from a matrix [x y], one row per key
+void insertPoint2(Values& values, const Vector& J, const Matrix& points) {
+  checkRows("insertPoint2", J, points, 2);
+  for (int j = 0; j < J.size(); j++)
+    values.insert(Key(J(j)), Point2(points(j, 0), points(j, 1)));
+}
+
+/// Insert Point3 values with keys J from a matrix [x y z], one row per key
+void insertPoint3(Values& values, const Vector& J, const Matrix& points) {
+  checkRows("insertPoint3", J, points, 3);
+  for (int j = 0; j < J.size(); j++)
+    values.insert(Key(J(j)), Point3(points(j, 0), points(j, 1), points(j, 2)));
+}
+
+/// Insert Pose2 values with keys J from a matrix [x y theta], one row per key
+void insertPose2(Values& values, const Vector& J, const Matrix& poses) {
+  checkRows("insertPose2", J, poses, 3);
+  for (int j = 0; j < J.size(); j++)
+    values.insert(Key(J(j)), Pose2(poses(j, 0), poses(j, 1), poses(j, 2)));
+}
+
+/// Insert Pose3 values with keys J from a matrix in the extractPose3 layout
+void insertPose3(Values& values, const Vector& J, const Matrix& poses) {
+  checkRows("insertPose3", J, poses, 12);
+  for (int j = 0; j < J.size(); j++)
+    values.insert(Key(J(j)), pose3FromRow(poses, j));
+}
+
+/// Extract the Point2 values with keys J into a matrix [x y], in the order of J
+Matrix extractPoint2(const Values& values, const Vector& J) {
+  Matrix result(J.size(), 2);
+  for (int j = 0; j < J.size(); j++)
+    result.row(j) = values.at<Point2>(Key(J(j))).vector();
+  return result;
+}
+
+/// Extract the Point3 values with keys J into a matrix [x y z], in the order of J
+Matrix extractPoint3(const Values& values, const Vector& J) {
+  Matrix result(J.size(), 3);
+  for (int j = 0; j < J.size(); j++)
+    result.row(j) = values.at<Point3>(Key(J(j))).vector();
+  return result;
+}
+
+/// Extract the Pose2 values with keys J into a matrix [x y theta], in the order of J
+Matrix extractPose2(const Values& values, const Vector& J) {
+  Matrix result(J.size(), 3);
+  for (int j = 0; j < J.size(); j++) {
+    const Pose2& pose = values.at<Pose2>(Key(J(j)));
+    result.row(j) << pose.x(), pose.y(), pose.theta();
+  }
+  return result;
+}
+
+/// Extract the Pose3 values with keys J into a matrix in the extractPose3 layout
+Matrix extractPose3(const Values& values, const Vector& J) {
+  Matrix result(J.size(), 12);
+  for (int j = 0; j < J.size(); j++) {
+    const Pose3& pose = values.at<Pose3>(Key(J(j)));
+    const Matrix3 R = pose.rotation().matrix();
+    result.row(j) << R.row(0), R.row(1), R.row(2), pose.translation().vector().transpose();
+  }
+  return result;
+}
+
+/// Insert BetweenFactor<Pose2> edges I(k)->J(k) with measurements [x y theta], one row per edge
+void insertBetweenFactorsPose2(NonlinearFactorGraph& graph, const Vector& I,
+    const Vector& J, const Matrix& Z, const SharedNoiseModel& model) {
+  if (I.size() != J.size())
+    throw std::invalid_argument("insertBetweenFactorsPose2: I and J must have same size");
+  checkRows("insertBetweenFactorsPose2", J, Z, 3);
+  graph.reserve(graph.size() + J.size());
+  for (int k = 0; k < J.size(); k++)
+    graph.push_back(boost::make_shared<BetweenFactor<Pose2> >(Key(I(k)), Key(J(k)),
+        Pose2(Z(k, 0), Z(k, 1), Z(k, 2)), model));
+}
+
+/// Insert BetweenFactor<Pose3> edges I(k)->J(k) with measurements in the extractPose3 layout
+void insertBetweenFactorsPose3(NonlinearFactorGraph& graph, const Vector& I,
+    const Vector& J, const Matrix& Z, const SharedNoiseModel& model) {
+  if (I.size() != J.size())
+    throw std::invalid_argument("insertBetweenFactorsPose3: I and J must have same size");
+  checkRows("insertBetweenFactorsPose3", J, Z, 12);
+  graph.reserve(graph.size() + J.size());
+  for (int k = 0; k < J.size(); k++)
+    graph.push_back(boost::make_shared<BetweenFactor<Pose3> >(Key(I(k)), Key(J(k)),
+        pose3FromRow(Z, k), model));
+}
+
 /// Perturb all Point2 values using normally distributed noise
 void perturbPoint2(Values& values, double sigma, int32_t seed = 42u) {
   noiseModel::Isotropic::shared_ptr model = noiseModel::Isotropic::Sigma(2,
@@ -45,3 +45,24 @@ CHECK('KeySet', isa(actual,'gtsam.KeySet'));
 CHECK('size==3', actual.size==3);
 CHECK('actual.count(x1)', actual.count(x1));
 
+
+%% Bulk insertion and extraction
+poses = [0 0 0; 1 0 pi/2; 1 1 pi];
+values = Values;
+utilities.insertPose2(values, [x1;x2;x3], poses);
+CHECK('size==3', values.size==3);
+CHECK('extractPose2', norm(utilities.extractPose2(values, [x3;x2;x1]) - poses(3:-1:1,:)) < 1e-9);
+
+points = [1 2 3; 4 5 6];
+utilities.insertPoint3(values, [1;2], points);
+CHECK('extractPoint3', norm(utilities.extractPoint3(values, [1;2]) - points) < 1e-9);
+
+pose3s = [reshape(eye(3),1,9) 1 2 3; reshape(eye(3),1,9) 4 5 6];
+values3 = Values;
+utilities.insertPose3(values3, [1;2], pose3s);
+CHECK('extractPose3', norm(utilities.extractPose3(values3, [1;2]) - pose3s) < 1e-9);
+
+graph = NonlinearFactorGraph;
+model = noiseModel.Unit.Create(3);
+utilities.insertBetweenFactorsPose2(graph, [x1;x2], [x2;x3], [1 0 pi/2; 0 1 pi/2], model);
+CHECK('graph.size==2', graph.size==2);
@@ -116,6 +116,13 @@ TEST(DoglegOptimizer, ComputeDoglegPoint) {
   VectorValues expected3 = gbn.optimize();
   VectorValues actual3 = DoglegOptimizerImpl::ComputeDoglegPoint(Delta3, gbn.optimizeGradientSearch(), gbn.optimize());
   EXPECT(assert_equal(expected3, actual3));
+
+  // One path gives the same points for all radii
+  const VectorValues dx_u = gbn.optimizeGradientSearch(), dx_n = gbn.optimize();
+  const DoglegOptimizerImpl::DoglegPath path(dx_u, dx_n);
+  EXPECT(assert_equal(actual1, path.point(Delta1)));
+  EXPECT(assert_equal(actual2, path.point(Delta2)));
+  EXPECT(assert_equal(actual3, path.point(Delta3)));
 }
 
 /* ************************************************************************* */
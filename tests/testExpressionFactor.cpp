@@ -23,8 +23,11 @@
 #include <gtsam/slam/PriorFactor.h>
 #include <gtsam/nonlinear/expressionTesting.h>
 #include <gtsam/nonlinear/ExpressionFactor.h>
+#include <gtsam/nonlinear/ExpressionFactorGraph.h>
+#include <gtsam/nonlinear/LinearizationPass.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/expressionTesting.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/base/Testable.h>
 
 #include <CppUnitLite/TestHarness.h>
@@ -344,6 +347,110 @@ TEST(ExpressionFactor, tree) {
   EXPECT( assert_equal(*expected, *gf3, 1e-9));
 }
 
+/* ************************************************************************* */
+// Relinearize into the factor of a previous linearization
+TEST(ExpressionFactor, linearizeInto) {
+  Values values;
+  values.insert(1, Pose3());
+  values.insert(2, Point3(0, 0, 1));
+  values.insert(3, Cal3_S2());
+  Pose3_ x(1);
+  Point3_ p(2);
+  Cal3_S2_ K(3);
+  ExpressionFactor<Point2> f(model, measured, project3(x, p, K));
+
+  JacobianFactor::shared_ptr factor =
+      boost::dynamic_pointer_cast<JacobianFactor>(f.linearize(values));
+  CHECK(factor);
+  const double* storage = factor->matrixObject().matrix().data();
+
+  Values values2 = values;
+  values2.update(2, Point3(0.1, -0.2, 2));
+  EXPECT(f.linearizeInto(values2, *factor));
+  EXPECT(assert_equal(*f.linearize(values2), *boost::static_pointer_cast<GaussianFactor>(factor), 1e-9));
+  EXPECT(storage == factor->matrixObject().matrix().data());
+
+  // A factor of another shape is reshaped
+  JacobianFactor other;
+  EXPECT(f.linearizeInto(values2, other));
+  EXPECT(assert_equal(*f.linearize(values2), static_cast<GaussianFactor&>(other), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(ExpressionFactorGraph, linearizeBatched) {
+  Values values;
+  values.insert(1, Pose3());
+  values.insert(2, Pose3(Rot3::yaw(0.1), Point3(0.2, 0, 0)));
+  values.insert(3, Cal3_S2());
+  ExpressionFactorGraph graph;
+  Cal3_S2_ K(3);
+  for (Key j = 10; j < 15; ++j) {
+    values.insert(j, Point3(0.1 * j - 1.2, 0.3, 5));
+    graph.addExpressionFactor(project3(Pose3_(1), Point3_(j), K), measured, model);
+    graph.addExpressionFactor(project3(Pose3_(2), Point3_(j), K), measured, model);
+  }
+
+  // A factor of another structure, one that cannot be batched, and an empty slot
+  graph.addExpressionFactor(Point3_(10), Point3(0, 0, 1), noiseModel::Unit::Create(3));
+  graph.push_back(PriorFactor<Pose3>(1, Pose3(), noiseModel::Unit::Create(6)));
+  graph.push_back(NonlinearFactor::shared_ptr());
+
+  const GaussianFactorGraph expected = *graph.linearize(values);
+  EXPECT(assert_equal(expected, *graph.linearizeBatched(values, 3), 1e-9));
+  EXPECT(assert_equal(expected, *graph.linearizeBatched(values), 1e-9));
+}
+
+/* ************************************************************************* */
+// Counts the inverses computed with derivatives
+static size_t nrInverses = 0;
+static Pose3 countedInverse(const Pose3& x, OptionalJacobian<6, 6> H) {
+  if (H)
+    ++nrInverses;
+  return x.inverse(H);
+}
+
+// Factors sharing the inverse of a pose linearize as if it were computed in every factor
+TEST(ExpressionFactorGraph, shareable) {
+  Values values;
+  values.insert(1, Pose3(Rot3::yaw(0.1), Point3(0.2, 0, 0)));
+  const SharedNoiseModel model3 = noiseModel::Unit::Create(3);
+  const Pose3_ inverse = Pose3_(countedInverse, Pose3_(1)).shareable();
+  EXPECT(inverse.keys() == list_of(1));
+  ExpressionFactorGraph graph, expected;
+  for (Key j = 10; j < 15; ++j) {
+    values.insert(j, Point3(0.1 * j - 1.2, 0.3, 5));
+    graph.addExpressionFactor(transform_from(inverse, Point3_(j)), Point3(0, 0, 5), model3);
+    expected.addExpressionFactor(transform_to(Pose3_(1), Point3_(j)), Point3(0, 0, 5), model3);
+  }
+  EXPECT_DOUBLES_EQUAL(expected.error(values), graph.error(values), 1e-9);
+
+  // The inverse is computed once per pass, by each thread that needs it
+  nrInverses = 0;
+  EXPECT(assert_equal(*expected.linearize(values), *graph.linearize(values), 1e-9));
+#ifndef GTSAM_USE_TBB
+  EXPECT_LONGS_EQUAL(1, nrInverses);
+#endif
+  EXPECT(assert_equal(*expected.linearize(values), *graph.linearizeBatched(values, 2), 1e-9));
+
+  // Outside a pass, every factor computes it
+  nrInverses = 0;
+  EXPECT(assert_equal(*expected.at(0)->linearize(values), *graph.at(0)->linearize(values), 1e-9));
+  EXPECT(assert_equal(*expected.at(1)->linearize(values), *graph.at(1)->linearize(values), 1e-9));
+  EXPECT_LONGS_EQUAL(2, nrInverses);
+
+  // Reverse AD through an execution trace uses the cache as well
+  nrInverses = 0;
+  const LinearizationPass pass(values);
+  for (Key j = 10; j < 12; ++j) {
+    vector<Matrix> expectedH(2), actualH(2);
+    const Point3 point = transform_to(Pose3_(1), Point3_(j)).value(values, expectedH);
+    EXPECT(assert_equal(point, transform_from(inverse, Point3_(j)).value(values, actualH), 1e-9));
+    EXPECT(assert_equal(expectedH[0], actualH[0], 1e-9));
+    EXPECT(assert_equal(expectedH[1], actualH[1], 1e-9));
+  }
+  EXPECT_LONGS_EQUAL(1, nrInverses);
+}
+
 /* ************************************************************************* */
 
 TEST(ExpressionFactor, Compose1) {
@@ -559,6 +666,34 @@ TEST(Expression, testMultipleCompositions) {
   EXPECT_CORRECT_EXPRESSION_JACOBIANS(sum3_, values, fd_step, tolerance);
 }
 
+/* ************************************************************************* */
+// A compiled expression gives the same value and Jacobians as the tree
+TEST(Expression, compiled) {
+  Values values;
+  values.insert(1, 10.0);
+  values.insert(2, 20.0);
+
+  Expression<double> v1_(Key(1));
+  Expression<double> v2_(Key(2));
+  Expression<double> sum1_(Combine(1, 2), v1_, v2_);
+  Expression<double> sum2_(Combine(3, 4), sum1_, v1_);
+  Expression<double> sum3_(Combine(5, 6), sum1_, sum2_);
+
+  // sum1_ and the leaves occur several times in the tree, but are compiled once
+  internal::ExpressionTape tape(*sum3_.root());
+  EXPECT(tape.valid());
+  EXPECT_LONGS_EQUAL(5, tape.size());
+
+  vector<Matrix> expectedH(2);
+  const double expected = sum3_.value(values, expectedH);
+  VerticalBlockMatrix Ab(FastVector<int>(2, 1), 1);
+  Ab.matrix().setZero();
+  EXPECT_DOUBLES_EQUAL(expected, tape.evaluate<double>(values, &Ab), 1e-9);
+  EXPECT(assert_equal(expectedH[0], Matrix(Ab(0)), 1e-9));
+  EXPECT(assert_equal(expectedH[1], Matrix(Ab(1)), 1e-9));
+  EXPECT_DOUBLES_EQUAL(expected, tape.evaluate<double>(values), 1e-9);
+}
+
 /* ************************************************************************* */
 // Another test, with Ternary Expressions
 static double combine3(const double& x, const double& y, const double& z,
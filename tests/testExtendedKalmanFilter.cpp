@@ -17,9 +17,11 @@
 #include <gtsam/slam/PriorFactor.h>
 #include <gtsam/slam/BetweenFactor.h>
 #include <gtsam/nonlinear/ExtendedKalmanFilter-inl.h>
+#include <gtsam/nonlinear/FixedExtendedKalmanFilter.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/geometry/Point2.h>
+#include <gtsam/geometry/Pose2.h>
 
 #include <CppUnitLite/TestHarness.h>
 
@@ -418,6 +420,47 @@ TEST( ExtendedKalmanFilter, nonlinear ) {
 }
 
 
+/* ************************************************************************* */
+TEST( FixedExtendedKalmanFilter, linear ) {
+
+  // Same example as ExtendedKalmanFilter linear, with the closed-form covariances
+  FixedExtendedKalmanFilter<Point2> ekf(Point2(0.0, 0.0),
+      noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.1)));
+  SharedDiagonal Q = noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.1), true);
+  SharedDiagonal R = noiseModel::Diagonal::Sigmas(Vector2(0.25, 0.25), true);
+
+  BetweenFactor<Point2> motion(X(0), X(1), Point2(1.0, 0.0), Q);
+  EXPECT(assert_equal(Point2(1.0, 0.0), ekf.predict(motion)));
+  EXPECT(assert_equal(Matrix(0.02 * I_2x2), Matrix(ekf.covariance()), 1e-9));
+
+  PriorFactor<Point2> measurement(X(1), Point2(1.0, 0.0), R);
+  EXPECT(assert_equal(Point2(1.0, 0.0), ekf.update(measurement)));
+  const double P = 1.0 / (1.0 / 0.02 + 1.0 / 0.0625);
+  EXPECT(assert_equal(Matrix(P * I_2x2), Matrix(ekf.covariance()), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST( FixedExtendedKalmanFilter, nonlinear ) {
+
+  // A Pose2 filter, where rotation makes the motion model nonlinear
+  Pose2 x_initial(0.1, -0.2, 0.3);
+  noiseModel::Diagonal::shared_ptr P_initial =
+      noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.1, 0.05));
+  ExtendedKalmanFilter<Pose2> expected(X(0), x_initial, P_initial);
+  FixedExtendedKalmanFilter<Pose2> actual(x_initial, P_initial);
+
+  SharedDiagonal Q = noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.05, 0.02));
+  SharedDiagonal R = noiseModel::Diagonal::Sigmas(Vector3(0.2, 0.2, 0.1));
+  for (size_t i = 0; i < 10; ++i) {
+    BetweenFactor<Pose2> motion(X(i), X(i+1), Pose2(1.0, 0.1, 0.2), Q);
+    EXPECT(assert_equal(expected.predict(motion), actual.predict(motion), 1e-9));
+
+    const double t = double(i + 1);
+    PriorFactor<Pose2> measurement(X(i+1), Pose2(t, 0.3 * t, 0.2 * t + 0.3), R);
+    EXPECT(assert_equal(expected.update(measurement), actual.update(measurement), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
@@ -15,6 +15,7 @@
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/ISAM2-impl.h>
 #include <gtsam/nonlinear/Marginals.h>
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/GaussianBayesTree.h>
@@ -453,6 +454,48 @@ TEST(ISAM2, removeVariables)
   CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, compactFactors)
+{
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph);
+
+  // Remove the measurements on landmark 0 (Key 100), leaving two null slots
+  FastVector<size_t> toRemove;
+  toRemove.push_back(7);
+  toRemove.push_back(14);
+  isam.update(NonlinearFactorGraph(), Values(), toRemove);
+  fullgraph.remove(7);
+  fullgraph.remove(14);
+  fullinit.erase(100);
+
+  // The remaining factors keep their order
+  const FastVector<size_t> newIndices = isam.compactFactors();
+  NonlinearFactorGraph compacted;
+  BOOST_FOREACH(const NonlinearFactor::shared_ptr& factor, fullgraph)
+    if(factor)
+      compacted.push_back(factor);
+  LONGS_EQUAL(fullgraph.size(), newIndices.size());
+  EXPECT_LONGS_EQUAL(6, newIndices[6]);
+  EXPECT_LONGS_EQUAL(compacted.size(), newIndices[7]);
+  EXPECT_LONGS_EQUAL(7, newIndices[8]);
+  EXPECT_LONGS_EQUAL(compacted.size(), newIndices[14]);
+  EXPECT_LONGS_EQUAL(13, newIndices[15]);
+  EXPECT(assert_equal(compacted, isam.getFactorsUnsafe()));
+  EXPECT(assert_equal(VariableIndex(compacted), isam.getVariableIndex()));
+  CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
+
+  // Later removals use the new indices: replacing the last factor with itself keeps the solution
+  NonlinearFactorGraph replaced;
+  replaced.push_back(fullgraph.back());
+  toRemove.assign(1, newIndices[fullgraph.size() - 1]);
+  isam.update(replaced, Values(), toRemove);
+  EXPECT_LONGS_EQUAL(compacted.size() + 1, isam.getFactorsUnsafe().size());
+  EXPECT(!isam.getFactorsUnsafe()[compacted.size() - 1]);
+  CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, swapFactors)
 {
@@ -507,6 +550,71 @@ TEST(ISAM2, swapFactors)
   EXPECT(assert_equal(expectedGradient, actualGradient));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, reeliminateIndependentBranches)
+{
+  ISAM2 isam(ISAM2Params(ISAM2GaussNewtonParams(0.0), 0.0, 0, false));
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+
+  // A trunk of odometry 0..19, long enough for the updates below to be incremental
+  {
+    NonlinearFactorGraph newfactors;
+    newfactors += PriorFactor<Pose2>(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+    Values init;
+    init.insert(0, Pose2(0.01, 0.01, 0.01));
+    fullgraph.push_back(newfactors);
+    fullinit.insert(init);
+    isam.update(newfactors, init);
+  }
+  for(size_t i = 0; i < 19; ++i) {
+    NonlinearFactorGraph newfactors;
+    newfactors += BetweenFactor<Pose2>(i, i+1, Pose2(1.0, 0.0, 0.0), odoNoise);
+    Values init;
+    init.insert(i+1, Pose2(double(i+1)+0.1, -0.1, 0.01));
+    fullgraph.push_back(newfactors);
+    fullinit.insert(init);
+    isam.update(newfactors, init);
+  }
+
+  // Two branches of odometry, 101..105 and 201..205, starting at the end of the trunk
+  for(size_t i = 0; i < 5; ++i) {
+    NonlinearFactorGraph newfactors;
+    newfactors += BetweenFactor<Pose2>(i == 0 ? 19 : i+100, i+101, Pose2(1.0, 0.0, 0.0), odoNoise);
+    newfactors += BetweenFactor<Pose2>(i == 0 ? 19 : i+200, i+201, Pose2(0.0, 1.0, 0.0), odoNoise);
+    Values init;
+    init.insert(i+101, Pose2(double(i+20)+0.1, -0.1, 0.01));
+    init.insert(i+201, Pose2(19.1, double(i+1)-0.1, 0.01));
+    fullgraph.push_back(newfactors);
+    fullinit.insert(init);
+    isam.update(newfactors, init);
+  }
+  CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
+
+  // Observing the junction and both ends constrains them to be eliminated last, which separates
+  // the re-eliminated parts of the two branches into independent sub-problems
+  {
+    NonlinearFactorGraph newfactors;
+    newfactors += PriorFactor<Pose2>(19, Pose2(19.0, 0.0, 0.0), odoNoise);
+    newfactors += PriorFactor<Pose2>(105, Pose2(24.0, 0.0, 0.0), odoNoise);
+    newfactors += PriorFactor<Pose2>(205, Pose2(19.0, 5.0, 0.0), odoNoise);
+    fullgraph.push_back(newfactors);
+    isam.update(newfactors, Values());
+  }
+  CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
+  EXPECT_LONGS_EQUAL(1, isam.roots().size());
+
+  // The re-attached subtrees are updated correctly later on
+  {
+    NonlinearFactorGraph newfactors;
+    newfactors += BetweenFactor<Pose2>(102, 203, Pose2(-2.0, 3.0, 0.0), odoNoise);
+    newfactors += BetweenFactor<Pose2>(10, 19, Pose2(9.0, 0.0, 0.0), odoNoise);
+    fullgraph.push_back(newfactors);
+    isam.update(newfactors, Values());
+  }
+  CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, constrained_ordering)
 {
@@ -646,6 +754,140 @@ TEST(ISAM2, slamlike_solution_partial_relinearization_check)
   CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, optimizeWildfireParallel)
+{
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph);
+
+  // Only the root clique is replaced, so the wildfire stops where the change is small
+  const KeySet replaced(isam.roots().front()->conditional()->beginFrontals(),
+      isam.roots().front()->conditional()->endFrontals());
+  const VectorValues zero = VectorValues::Zero(isam.getDelta());
+  BOOST_FOREACH(double threshold, list_of(1e-6)(1e-3)(0.1)) {
+    VectorValues expected = zero, actual = zero;
+    size_t expectedCount = 0;
+    BOOST_FOREACH(const ISAM2::sharedClique& root, isam.roots())
+      expectedCount += optimizeWildfireNonRecursive(root, threshold, replaced, expected);
+    const size_t actualCount = optimizeWildfireParallel(isam.roots(), threshold, replaced, actual);
+    EXPECT_LONGS_EQUAL(expectedCount, actualCount);
+    EXPECT(assert_equal(expected, actual));
+  }
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, relinearizeBudget)
+{
+  // Relinearize at every update, but at most two variables per update
+  const ISAM2Params unlimited(ISAM2GaussNewtonParams(0.0), 0.01, 1);
+  ISAM2Params params = unlimited;
+  params.relinearizeBudget = 2;
+  ISAM2 isam(params), expected(unlimited);
+
+  // An odometry chain with a poor initialization and a loop closure, and another update in which
+  // most variables are above the relinearization threshold
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  for(size_t i = 0; i < 13; ++i) {
+    NonlinearFactorGraph newfactors;
+    Values init;
+    if(i == 0)
+      newfactors += PriorFactor<Pose2>(0, Pose2(), odoNoise);
+    else if(i < 12)
+      newfactors += BetweenFactor<Pose2>(i-1, i, Pose2(1.0, 0.0, M_PI/6.0), odoNoise);
+    if(i == 11)
+      newfactors += BetweenFactor<Pose2>(11, 0, Pose2(1.0, 0.0, M_PI/6.0), odoNoise);
+    if(i < 12)
+      init.insert(i, Pose2(double(i), 0.5 * double(i), 0.0));
+    fullgraph.push_back(newfactors);
+    fullinit.insert(init);
+
+    const Values before = isam.getLinearizationPoint();
+    const ISAM2Result result = isam.update(newfactors, init);
+    expected.update(newfactors, init);
+
+    // No more than the budget of existing variables is moved to a new linearization point
+    size_t relinearized = 0;
+    BOOST_FOREACH(Key key, before.keys())
+      if(!before.at<Pose2>(key).equals(isam.getLinearizationPoint().at<Pose2>(key), 1e-12))
+        ++relinearized;
+    EXPECT(relinearized <= 2);
+    EXPECT_LONGS_EQUAL(isam.getDeferredRelinKeys().size(), result.relinearizeQueueDepth);
+  }
+  EXPECT(isam.getDeferredRelinKeys().size() > 0);
+
+  // The deferred variables are relinearized over the next updates, which converge to the same
+  // solution as without a budget
+  for(size_t k = 0; k < 50; ++k) {
+    isam.update();
+    expected.update();
+  }
+  EXPECT_LONGS_EQUAL(0, isam.getDeferredRelinKeys().size());
+  EXPECT(assert_equal(expected.calculateEstimate(), isam.calculateEstimate(), 1e-4));
+  EXPECT_LONGS_EQUAL(0, expected.update().relinearizeQueueDepth);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, checkRelinearizationFull)
+{
+  // Enough variables of two types for the check to be split into several ranges
+  VectorValues delta;
+  KeySet expectedUniform, expectedPerType;
+  for(size_t j = 0; j < 5000; ++j) {
+    const double small = (j % 7 == 0) ? 0.3 : 0.05;
+    delta.insert(Symbol('x', j), (Vector(3) << 0.0, small, 0.0).finished());
+    delta.insert(Symbol('l', j), (Vector(2) << small, 0.0).finished());
+    if(j % 7 == 0) {
+      expectedUniform.insert(Symbol('x', j));
+      expectedUniform.insert(Symbol('l', j));
+      expectedPerType.insert(Symbol('x', j));
+    }
+  }
+
+  EXPECT(expectedUniform == ISAM2::Impl::CheckRelinearizationFull(delta, 0.1));
+
+  FastMap<char,Vector> thresholds;
+  thresholds['x'] = (Vector(3) << 0.1, 0.1, 0.1).finished();
+  thresholds['l'] = (Vector(2) << 0.5, 0.5).finished();
+  EXPECT(expectedPerType == ISAM2::Impl::CheckRelinearizationFull(delta, thresholds));
+
+  // A threshold vector of the wrong dimension, or a missing one, is an error
+  thresholds['l'] = (Vector(3) << 0.5, 0.5, 0.5).finished();
+  CHECK_EXCEPTION(ISAM2::Impl::CheckRelinearizationFull(delta, thresholds), std::invalid_argument);
+  thresholds.erase('l');
+  CHECK_EXCEPTION(ISAM2::Impl::CheckRelinearizationFull(delta, thresholds), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, metrics)
+{
+  ISAM2 isam;
+  for(size_t i = 0; i < 10; ++i) {
+    NonlinearFactorGraph newfactors;
+    Values init;
+    if(i == 0)
+      newfactors += PriorFactor<Pose2>(0, Pose2(), odoNoise);
+    else
+      newfactors += BetweenFactor<Pose2>(i-1, i, Pose2(1.0, 0.0, M_PI/6.0), odoNoise);
+    init.insert(i, Pose2(double(i), 0.0, 0.0));
+    const ISAM2Result result = isam.update(newfactors, init);
+
+    // Each update re-eliminates at least the new pose, in a clique with its predecessor
+    EXPECT(result.metrics.newCliques >= 1);
+    EXPECT(result.metrics.bytesAllocated > 0);
+    EXPECT_LONGS_EQUAL(i == 0 ? 3 : 6, result.metrics.maxCliqueDimension);
+    EXPECT(result.metrics.totalTime >= result.metrics.eliminationTime);
+    EXPECT(result.metrics.totalTime >= result.metrics.linearizeTime);
+  }
+
+  // An update with nothing to do does no work
+  const ISAM2Result result = isam.update();
+  EXPECT_LONGS_EQUAL(0, result.metrics.newCliques);
+  EXPECT_LONGS_EQUAL(0, result.metrics.affectedCliques);
+  EXPECT_LONGS_EQUAL(0, result.metrics.bytesAllocated);
+}
+
 namespace {
   bool checkMarginalizeLeaves(ISAM2& isam, const FastList<Key>& leafKeys) {
     Matrix expectedAugmentedHessian, expected3AugmentedHessian;
@@ -790,6 +1032,41 @@ TEST(ISAM2, marginalizeLeaves3)
   EXPECT(checkMarginalizeLeaves(isam, leafKeys));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, forkMarginalizeLeaves)
+{
+  NonlinearFactorGraph factors;
+  factors += PriorFactor<LieScalar>(0, Zero, model);
+  factors += BetweenFactor<LieScalar>(0, 1, Zero, model);
+  factors += BetweenFactor<LieScalar>(1, 2, Zero, model);
+  factors += BetweenFactor<LieScalar>(0, 2, Zero, model);
+  factors += BetweenFactor<LieScalar>(2, 3, Zero, model);
+
+  Values values;
+  FastMap<Key,int> constrainedKeys;
+  for (Key j = 0; j < 4; ++j) {
+    values.insert(j, Zero);
+    constrainedKeys.insert(make_pair(j, int(j)));
+  }
+
+  ISAM2 isam, expected;
+  isam.update(factors, values, FastVector<size_t>(), constrainedKeys);
+  expected.update(factors, values, FastVector<size_t>(), constrainedKeys);
+
+  // The fork shares the conditionals of the original
+  ISAM2 fork(isam);
+  EXPECT(fork[0]->conditional() == isam[0]->conditional());
+  EXPECT(fork[3]->conditional() == isam[3]->conditional());
+
+  // Splitting the clique of 0 in the fork must not change the original
+  FastList<Key> leafKeys = list_of(0);
+  fork.marginalizeLeaves(leafKeys);
+  EXPECT(!fork.valueExists(0));
+  EXPECT(fork[1]->conditional() != isam[1]->conditional());
+  EXPECT(assert_equal(expected, isam));
+  EXPECT(checkMarginalizeLeaves(isam, leafKeys));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, marginalizeLeaves4)
 {
@@ -839,6 +1116,103 @@ TEST(ISAM2, marginalCovariance)
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, maxThreads)
+{
+  // Confining the work to a task arena of its own does not change the result
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false, true);
+  params.maxThreads = 2;
+  EXPECT(assert_equal(createSlamlikeISAM2(), createSlamlikeISAM2(boost::none, boost::none, params)));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, snapshot)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false, true);
+  EXPECT(!createSlamlikeISAM2(boost::none, boost::none, params).snapshot());
+  params.publishSnapshots = true;
+  ISAM2 isam = createSlamlikeISAM2(boost::none, boost::none, params);
+
+  // The snapshot of the last update answers like the ISAM2
+  const ISAM2Snapshot::shared_ptr snapshot = isam.snapshot();
+  CHECK(snapshot);
+  const Values expected = isam.calculateEstimate();
+  EXPECT(assert_equal(expected, snapshot->calculateEstimate()));
+  EXPECT(assert_equal(isam.calculateEstimate<Pose2>(5), snapshot->calculateEstimate<Pose2>(5)));
+  EXPECT(assert_equal(isam.calculateBestEstimate(), snapshot->calculateBestEstimate(), 1e-9));
+  EXPECT(assert_equal(isam.marginalCovariance(5), snapshot->marginalCovariance(5), 1e-9));
+
+  // A reader keeps its snapshot while the ISAM2 moves on
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(0, 5, Pose2(2.0, 1.0, M_PI/2), odoNoise);
+  isam.update(newfactors);
+  const ISAM2Snapshot::shared_ptr next = isam.snapshot();
+  LONGS_EQUAL(snapshot->epoch() + 1, next->epoch());
+  EXPECT(assert_equal(expected, snapshot->calculateEstimate()));
+  EXPECT(assert_equal(isam.calculateEstimate(), next->calculateEstimate()));
+  EXPECT(!expected.equals(next->calculateEstimate(), 1e-6));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, marginalCovariances)
+{
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph);
+
+  // A second, disconnected tree
+  {
+    NonlinearFactorGraph newfactors;
+    newfactors += PriorFactor<Pose2>(1000, Pose2(1.0, 2.0, 0.3), odoNoise);
+    Values init;
+    init.insert(1000, Pose2(1.0, 2.0, 0.3));
+    isam.update(newfactors, init);
+  }
+
+  FastVector<Key> keys;
+  BOOST_FOREACH(Key key, isam.getLinearizationPoint().keys())
+    keys.push_back(key);
+  keys.push_back(keys.front()); // Repeated keys are allowed
+
+  for(size_t k = 0; k < 3; ++k) {
+    // Batch and single queries, both before and after the cache is filled
+    const Marginals marginals(isam.getFactorsUnsafe(), isam.getLinearizationPoint());
+    const FastVector<Matrix> actual = isam.marginalCovariances(keys);
+    LONGS_EQUAL(keys.size(), actual.size());
+    for(size_t i = 0; i < keys.size(); ++i) {
+      EXPECT(assert_equal(marginals.marginalCovariance(keys[i]), actual[i], 1e-9));
+      EXPECT(assert_equal(actual[i], isam.marginalCovariance(keys[i])));
+    }
+
+    // Updates change the marginals, except in the other tree after the first update
+    NonlinearFactorGraph newfactors;
+    if(k == 0)
+      newfactors += BetweenFactor<Pose2>(0, 5, Pose2(2.0, 1.0, M_PI/2), odoNoise);
+    else
+      newfactors += PriorFactor<Pose2>(1000, Pose2(1.1, 2.0, 0.3), odoNoise);
+    isam.update(newfactors);
+  }
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, memoryUsage)
+{
+  ISAM2 isam = createSlamlikeISAM2();
+  const MemoryUsage usage = isam.memoryUsage();
+  const MemoryUsage factors = isam.getFactorsUnsafe().memoryUsage();
+  EXPECT_LONGS_EQUAL((long)factors["factors"], (long)usage["factors"]);
+  EXPECT_LONGS_EQUAL((long)factors["noise models"], (long)usage["noise models"]);
+  EXPECT_LONGS_EQUAL((long)isam.getVariableIndex().memoryUsage(), (long)usage["variable index"]);
+  EXPECT_LONGS_EQUAL((long)isam.getLinearizationPoint().memoryUsage(), (long)usage["values"]);
+  EXPECT(usage["conditionals"] > 0);
+  EXPECT(usage["cached linear factors"] > 0);
+  EXPECT_LONGS_EQUAL(0, (long)usage["marginal covariances"]);
+
+  // Cached marginal covariances are accounted for
+  isam.marginalCovariances(list_of<Key>(0)(5));
+  EXPECT(isam.memoryUsage()["marginal covariances"] >= 2 * 9 * sizeof(double));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, calculate_nnz)
 {
@@ -35,6 +35,7 @@
 #include <gtsam/symbolic/SymbolicEliminationTree.h>
 #include <gtsam/inference/BayesTree.h>
 #include <gtsam/inference/ClusterTree.h>
+#include <gtsam/inference/eliminationCost.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/base/Matrix.h>
@@ -129,6 +130,70 @@ TEST( GaussianJunctionTreeB, constructor2 ) {
   EXPECT(assert_equal(o1, x1->orderedFrontalKeys));
   EXPECT_LONGS_EQUAL(2, x1->factors.size());
   EXPECT_LONGS_EQUAL(4, x1->problemSize_);
+
+  // Estimated elimination costs, from the dimensions of the Point2 variables
+  EXPECT_DOUBLES_EQUAL(eliminationFlops(6, 0), x324->estimatedCost(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(eliminationFlops(4, 2), x56->estimatedCost(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(eliminationFlops(2, 2), x7->estimatedCost(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(eliminationFlops(2, 2), x1->estimatedCost(), 1e-9);
+
+  // The cliques of the Bayes tree have the same dimensions
+  GaussianBayesTree::shared_ptr bt = actual.eliminate(EliminateCholesky).first;
+  EXPECT_DOUBLES_EQUAL(eliminationFlops(6, 0), (*bt)[X(4)]->estimatedCost(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(eliminationFlops(4, 2), (*bt)[X(5)]->estimatedCost(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(eliminationFlops(2, 2), (*bt)[X(1)]->estimatedCost(), 1e-9);
+}
+
+/* ************************************************************************* */
+TEST( GaussianJunctionTreeB, estimateEliminationCost ) {
+  NonlinearFactorGraph nlfg;
+  Values values;
+  boost::tie(nlfg, values) = createNonlinearSmoother(7);
+  GaussianFactorGraph::shared_ptr fg = nlfg.linearize(values);
+  Ordering ordering;
+  ordering += X(1), X(3), X(5), X(7), X(2), X(6), X(4);
+
+  // Same cliques as above, with frontal and separator dimensions 6+0, 4+2, 2+2 and 2+2
+  const EliminationCostEstimate actual = fg->estimateEliminationCost(ordering);
+  EXPECT_DOUBLES_EQUAL(eliminationFlops(6, 0) + eliminationFlops(4, 2)
+      + 2 * eliminationFlops(2, 2), actual.flops, 1e-9);
+  EXPECT_LONGS_EQUAL(21 + (10 + 8) + 2 * (3 + 4), actual.rNonzeros);
+  EXPECT_LONGS_EQUAL(6, actual.largestClique);
+  EXPECT_LONGS_EQUAL(4, actual.nrCliques);
+  EXPECT_LONGS_EQUAL(sizeof(double) * (6 * 7 + 4 * 7 + 2 * (2 * 5)), actual.bayesTreeBytes);
+  // At the peak, the whole Bayes tree is built and the root clique is eliminated, with the
+  // remaining factors of its two children on x2 and x4
+  EXPECT_LONGS_EQUAL(actual.bayesTreeBytes + denseFactorBytes(6) + 2 * denseFactorBytes(2),
+      actual.peakBytes);
+
+  // The Bayes tree has the predicted number of cliques
+  GaussianBayesTree::shared_ptr bt = fg->eliminateMultifrontal(ordering);
+  EXPECT_LONGS_EQUAL(actual.nrCliques, bt->size());
+
+  // The estimate for an ordering type uses an ordering of that type
+  const EliminationCostEstimate colamd = fg->estimateEliminationCost(Ordering::COLAMD);
+  EXPECT_DOUBLES_EQUAL(fg->estimateEliminationCost(Ordering::Colamd(*fg)).flops, colamd.flops, 1e-9);
+}
+
+/* ************************************************************************* */
+TEST( GaussianJunctionTreeB, eliminatePeakBytes ) {
+  NonlinearFactorGraph nlfg;
+  Values values;
+  boost::tie(nlfg, values) = createNonlinearSmoother(7);
+  GaussianFactorGraph::shared_ptr fg = nlfg.linearize(values);
+  Ordering ordering;
+  ordering += X(1), X(3), X(5), X(7), X(2), X(6), X(4);
+  GaussianJunctionTree tree((GaussianEliminationTree(*fg, ordering)));
+
+  // Same cliques as above: at the peak, the root clique on 3 Point2 variables is eliminated,
+  // with the remaining factors of its two children on x2 and x4
+  size_t peakBytes = 0;
+  GaussianBayesTree::shared_ptr actual = tree.eliminate(EliminateCholesky, &peakBytes).first;
+  EXPECT_LONGS_EQUAL(denseFactorBytes(6) + 2 * denseFactorBytes(2), peakBytes);
+
+  // Reporting the memory does not change the result
+  GaussianBayesTree::shared_ptr expected = tree.eliminate(EliminateCholesky).first;
+  EXPECT(assert_equal(*expected, *actual));
 }
 
 ///* ************************************************************************* */
@@ -0,0 +1,98 @@
+/**
+ * @file    testISAM2Checkpoint.cpp
+ * @brief   Unit tests for saving and restoring ISAM2 checkpoints
+ * @date    Oct 15, 2026
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/base/serialization.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <sstream>
+
+using namespace std;
+using namespace gtsam;
+
+// Checkpoints hold these types
+BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Diagonal, "gtsam_noiseModel_Diagonal");
+BOOST_CLASS_EXPORT_GUID(gtsam::PriorFactor<gtsam::Pose2>, "gtsam::PriorFactorPose2");
+BOOST_CLASS_EXPORT_GUID(gtsam::BetweenFactor<gtsam::Pose2>, "gtsam::BetweenFactorPose2");
+GTSAM_VALUE_EXPORT(gtsam::Pose2);
+
+static const SharedNoiseModel odoNoise = noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.1, M_PI/100.0));
+static const Pose2 odometry(1.0, 0.0, 0.1);
+
+/* ************************************************************************* */
+// Add odometry poses first to last - 1, writing each update to \c journal if given
+static void addChain(ISAM2& isam, Key first, Key last, ostream* journal = 0) {
+  for (Key i = first; i < last; ++i) {
+    NonlinearFactorGraph newFactors;
+    Values newValues;
+    if (i == 0)
+      newFactors += PriorFactor<Pose2>(0, Pose2(), odoNoise);
+    else
+      newFactors += BetweenFactor<Pose2>(i - 1, i, odometry, odoNoise);
+    if (i % 7 == 6)
+      newFactors += BetweenFactor<Pose2>(i - 5, i, Pose2(5.2, 0.1, 0.4), odoNoise);
+    newValues.insert(i, Pose2(0.9 * i, 0.1 * i, 0.12 * i));
+    isam.update(newFactors, newValues);
+    if (journal)
+      ISAM2::saveUpdate(*journal, newFactors, newValues);
+  }
+}
+
+/* ************************************************************************* */
+// Restore a checkpoint in the middle of a chain, replay the rest, and compare with the original
+static bool checkRestore(const ISAM2Params& params)
+{
+  ISAM2 expected(params);
+  addChain(expected, 0, 30);
+
+  stringstream checkpoint;
+  expected.saveCheckpoint(checkpoint);
+  ISAM2 actual(params);
+  actual.loadCheckpoint(checkpoint);
+  bool ok = assert_equal(expected, actual) && assert_equal(expected.getDelta(), actual.getDelta());
+
+  // Following the journal of the later updates gives the same state
+  stringstream journal;
+  addChain(expected, 30, 50, &journal);
+  size_t replayed = 0;
+  while (actual.replayUpdate(journal))
+    ++replayed;
+  return ok && replayed == 20 && assert_equal(expected, actual)
+      && assert_equal(expected.calculateEstimate(), actual.calculateEstimate());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Checkpoint, gaussNewton)
+{
+  EXPECT(checkRestore(ISAM2Params()));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Checkpoint, doglegQR)
+{
+  ISAM2Params params(ISAM2DoglegParams(1.0));
+  params.factorization = ISAM2Params::QR;
+  EXPECT(checkRestore(params));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Checkpoint, notACheckpoint)
+{
+  stringstream stream("not a checkpoint");
+  ISAM2 isam;
+  CHECK_EXCEPTION(isam.loadCheckpoint(stream), std::runtime_error);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
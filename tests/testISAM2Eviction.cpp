@@ -0,0 +1,144 @@
+/**
+ * @file    testISAM2Eviction.cpp
+ * @brief   Unit tests for evicting ISAM2 subtrees to disk
+ * @date    Oct 15, 2026
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/linear/GaussianConditional.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/base/serialization.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <boost/foreach.hpp>
+
+using namespace std;
+using namespace gtsam;
+
+// Evicted subtrees hold these types
+BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Diagonal, "gtsam_noiseModel_Diagonal");
+BOOST_CLASS_EXPORT_GUID(gtsam::JacobianFactor, "gtsam::JacobianFactor");
+BOOST_CLASS_EXPORT_GUID(gtsam::HessianFactor, "gtsam::HessianFactor");
+BOOST_CLASS_EXPORT_GUID(gtsam::GaussianConditional, "gtsam::GaussianConditional");
+BOOST_CLASS_EXPORT_GUID(gtsam::PriorFactor<gtsam::Pose2>, "gtsam::PriorFactorPose2");
+BOOST_CLASS_EXPORT_GUID(gtsam::BetweenFactor<gtsam::Pose2>, "gtsam::BetweenFactorPose2");
+GTSAM_VALUE_EXPORT(gtsam::Pose2);
+
+static const SharedNoiseModel odoNoise = noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.1, M_PI/100.0));
+static const Pose2 odometry(1.0, 0.0, 0.1);
+
+/* ************************************************************************* */
+// Add a long odometry chain one pose at a time
+static void addChain(ISAM2& isam, Key n) {
+  Pose2 pose;
+  for (Key i = 0; i < n; ++i) {
+    NonlinearFactorGraph newFactors;
+    Values newValues;
+    if (i == 0)
+      newFactors += PriorFactor<Pose2>(0, Pose2(), odoNoise);
+    else
+      newFactors += BetweenFactor<Pose2>(i - 1, i, odometry, odoNoise);
+    newValues.insert(i, pose.compose(Pose2(0.01, -0.01, 0.01)));
+    pose = pose.compose(odometry);
+    isam.update(newFactors, newValues);
+  }
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Eviction, loopClosure)
+{
+  // Without relinearization the evicting ISAM2 solves the same linear system
+  ISAM2Params params;
+  params.enableRelinearization = false;
+  ISAM2 expected(params);
+  params.maxResidentVariables = 20;
+  ISAM2 actual(params);
+
+  addChain(expected, 60);
+  addChain(actual, 60);
+
+  // The old poses are on disk
+  EXPECT(actual.getLinearizationPoint().size() <= 20);
+  EXPECT(actual.isEvicted(0));
+  EXPECT(actual.valueExists(0));
+  EXPECT(!actual.isEvicted(59));
+  EXPECT_LONGS_EQUAL(60, actual.getLinearizationPoint().size() + actual.getEvictedKeys().size());
+  const Values resident = actual.calculateBestEstimate();
+  const Values all = expected.calculateBestEstimate();
+  BOOST_FOREACH(Key key, resident.keys())
+    EXPECT(assert_equal(all.at<Pose2>(key), resident.at<Pose2>(key), 1e-6));
+
+  // A loop closure loads the poses it involves
+  NonlinearFactorGraph loop;
+  loop += BetweenFactor<Pose2>(59, 1, Pose2(-1.0, 0.5, 0.2), odoNoise);
+  expected.update(loop);
+  actual.update(loop);
+  EXPECT(!actual.isEvicted(1));
+
+  // Once everything is loaded again, the solutions agree
+  actual.pageIn(actual.getEvictedKeys());
+  EXPECT(actual.getEvictedKeys().empty());
+  EXPECT(assert_equal(expected.calculateBestEstimate(), actual.calculateBestEstimate(), 1e-6));
+  EXPECT_LONGS_EQUAL(expected.getFactorsUnsafe().nrFactors(), actual.getFactorsUnsafe().nrFactors());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Eviction, removeEvictedFactor)
+{
+  ISAM2Params params;
+  params.maxResidentVariables = 20;
+  ISAM2 isam(params);
+  addChain(isam, 60);
+  EXPECT(isam.isEvicted(0));
+
+  // Replacing the prior, which was evicted, loads its subtree
+  NonlinearFactorGraph prior;
+  prior += PriorFactor<Pose2>(0, Pose2(0.1, 0.0, 0.0), odoNoise);
+  isam.update(prior, Values(), vector<size_t>(1, 0));
+  EXPECT(!isam.getFactorsUnsafe()[0]);
+  EXPECT(!isam.isEvicted(0));
+  isam.pageIn(isam.getEvictedKeys());
+  EXPECT(assert_equal(Pose2(0.1, 0.0, 0.0), isam.calculateBestEstimate().at<Pose2>(0), 1e-3));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Eviction, compactFactors)
+{
+  ISAM2Params params;
+  params.enableRelinearization = false;
+  ISAM2 expected(params);
+  params.maxResidentVariables = 20;
+  ISAM2 actual(params);
+  addChain(expected, 60);
+  addChain(actual, 60);
+
+  // Replace the prior, leaving its slot empty while the old poses are on disk again
+  NonlinearFactorGraph prior;
+  prior += PriorFactor<Pose2>(0, Pose2(0.1, 0.0, 0.0), odoNoise);
+  expected.update(prior, Values(), vector<size_t>(1, 0));
+  actual.update(prior, Values(), vector<size_t>(1, 0));
+  EXPECT(!actual.getEvictedKeys().empty());
+
+  // The evicted factors move down with the resident ones
+  const FastVector<size_t> newIndices = actual.compactFactors();
+  EXPECT_LONGS_EQUAL(60, newIndices[0]);
+  EXPECT_LONGS_EQUAL(0, newIndices[1]);
+  EXPECT_LONGS_EQUAL(59, newIndices[60]);
+  expected.compactFactors();
+  actual.pageIn(actual.getEvictedKeys());
+  EXPECT(actual.getEvictedKeys().empty());
+  EXPECT(assert_equal(expected.getFactorsUnsafe(), actual.getFactorsUnsafe()));
+  EXPECT(assert_equal(expected.getVariableIndex(), actual.getVariableIndex()));
+  EXPECT(assert_equal(expected.calculateBestEstimate(), actual.calculateBestEstimate(), 1e-6));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
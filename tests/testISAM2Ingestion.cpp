@@ -0,0 +1,128 @@
+/**
+ * @file    testISAM2Ingestion.cpp
+ * @brief   Unit tests for multi-producer ingestion of measurements into ISAM2
+ * @date    Oct 15, 2026
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Point2.h>
+#include <gtsam/nonlinear/ISAM2Ingestion.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+using namespace std;
+using namespace gtsam;
+
+static const SharedNoiseModel noise = noiseModel::Isotropic::Sigma(2, 0.1);
+
+/* ************************************************************************* */
+// A producer pushing a chain of points one measurement at a time.  The factors are linear, so
+// ISAM2 reaches the exact solution however the measurements are coalesced.
+static void pushChain(ISAM2Ingestion* ingestion, Key first, size_t length) {
+  for (Key j = first; j < first + length; ++j) {
+    NonlinearFactorGraph newFactors;
+    Values newValues;
+    if (j == first)
+      newFactors += PriorFactor<Point2>(j, Point2(double(first), 0.0), noise);
+    else
+      newFactors += BetweenFactor<Point2>(j - 1, j, Point2(1.0, 0.5), noise);
+    newValues.insert(j, Point2(0.0, 0.0));
+    ingestion->push(newFactors, newValues);
+  }
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Ingestion, producers)
+{
+  ISAM2Ingestion ingestion;
+
+  // Four producers with their own chains, pushing concurrently
+  const size_t nrProducers = 4, length = 25;
+  boost::thread_group producers;
+  for (size_t p = 0; p < nrProducers; ++p)
+    producers.create_thread(boost::bind(&pushChain, &ingestion, Key(100 * p), length));
+  producers.join_all();
+  ingestion.flush();
+
+  const ISAM2Ingestion::Statistics statistics = ingestion.statistics();
+  EXPECT_LONGS_EQUAL(nrProducers * length, statistics.pushed);
+  EXPECT_LONGS_EQUAL(nrProducers * length, statistics.applied);
+  EXPECT_LONGS_EQUAL(0, statistics.rejected);
+  EXPECT_LONGS_EQUAL(0, statistics.pendingFactors);
+  EXPECT(statistics.updates >= 1 && statistics.updates <= statistics.applied);
+  EXPECT(statistics.maxBatch >= 1);
+  EXPECT(statistics.meanLatency <= statistics.maxLatency);
+
+  const Values actual = ingestion.isam().calculateBestEstimate();
+  EXPECT_LONGS_EQUAL(nrProducers * length, actual.size());
+  for (size_t p = 0; p < nrProducers; ++p)
+    for (size_t i = 0; i < length; ++i)
+      EXPECT(assert_equal(Point2(100.0 * p + i, 0.5 * i), actual.at<Point2>(100 * p + i), 1e-6));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Ingestion, backpressure)
+{
+  // The worker waits for a batch that cannot fill up, so measurements stay pending
+  ISAM2Ingestion::Params params;
+  params.minBatchFactors = 100;
+  params.maxWait = 0.5;
+  params.maxPendingFactors = 5;
+  ISAM2Ingestion ingestion(ISAM2Params(), params);
+
+  size_t accepted = 0;
+  for (Key j = 0; j < 10; ++j) {
+    NonlinearFactorGraph newFactors;
+    newFactors += PriorFactor<Point2>(j, Point2(1.0, 2.0), noise);
+    Values newValues;
+    newValues.insert(j, Point2(0.0, 0.0));
+    if (ingestion.push(newFactors, newValues))
+      ++accepted;
+  }
+  EXPECT_LONGS_EQUAL(5, accepted);
+  ingestion.flush();
+
+  const ISAM2Ingestion::Statistics statistics = ingestion.statistics();
+  EXPECT_LONGS_EQUAL(5, statistics.pushed);
+  EXPECT_LONGS_EQUAL(5, statistics.rejected);
+  EXPECT_LONGS_EQUAL(5, statistics.maxPendingFactors);
+  EXPECT_LONGS_EQUAL(1, statistics.updates);
+  EXPECT_LONGS_EQUAL(5, statistics.maxBatch);
+  EXPECT_DOUBLES_EQUAL(5.0, statistics.meanBatch(), 1e-9);
+  EXPECT_LONGS_EQUAL(5, ingestion.isam().calculateEstimate().size());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Ingestion, error)
+{
+  // Two producers initializing the same variable in one batch make the update throw, in flush()
+  ISAM2Ingestion::Params params;
+  params.minBatchFactors = 2;
+  params.maxWait = 10.0;
+  ISAM2Ingestion ingestion(ISAM2Params(), params);
+  NonlinearFactorGraph newFactors;
+  newFactors += PriorFactor<Point2>(0, Point2(1.0, 2.0), noise);
+  Values newValues;
+  newValues.insert(0, Point2(0.0, 0.0));
+  ingestion.push(newFactors, newValues);
+  ingestion.push(newFactors, newValues);
+  CHECK_EXCEPTION(ingestion.flush(), std::exception);
+
+  // The error is only reported once, and the ISAM2 is left untouched
+  ingestion.push(newFactors, newValues);
+  ingestion.push(newFactors);
+  ingestion.flush();
+  EXPECT_LONGS_EQUAL(2, ingestion.statistics().updates);
+  EXPECT(assert_equal(Point2(1.0, 2.0), ingestion.isam().calculateEstimate<Point2>(0), 1e-6));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -0,0 +1,140 @@
+/**
+ * @file    testISAM2Pipeline.cpp
+ * @brief   Unit tests for asynchronous ISAM2 updates
+ * @date    Oct 14, 2026
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/nonlinear/ISAM2Pipeline.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <boost/foreach.hpp>
+
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+
+static const SharedNoiseModel odoNoise = noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.1, M_PI/100.0));
+
+/* ************************************************************************* */
+// A square loop of poses with a noisy odometry chain and loop closures, one update per pose
+static void createUpdates(vector<NonlinearFactorGraph>& factors, vector<Values>& values) {
+  const Pose2 odometry(1.0, 0.0, M_PI/2.0), noise(0.05, -0.03, 0.02);
+  Pose2 pose;
+  for (Key i = 0; i < 12; ++i) {
+    NonlinearFactorGraph newFactors;
+    Values newValues;
+    if (i == 0) {
+      newFactors += PriorFactor<Pose2>(0, Pose2(), odoNoise);
+    } else {
+      newFactors += BetweenFactor<Pose2>(i - 1, i, odometry, odoNoise);
+      if (i >= 4)
+        newFactors += BetweenFactor<Pose2>(i - 4, i, Pose2(), odoNoise);
+      pose = pose.compose(odometry).compose(noise);
+    }
+    newValues.insert(i, pose);
+    factors.push_back(newFactors);
+    values.push_back(newValues);
+  }
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Pipeline, sameAsISAM2)
+{
+  vector<NonlinearFactorGraph> factors;
+  vector<Values> values;
+  createUpdates(factors, values);
+
+  // Relinearize often, so that some pre-linearized factors are stale
+  ISAM2Params params;
+  params.relinearizeThreshold = 0.001;
+  params.relinearizeSkip = 1;
+
+  ISAM2 isam(params);
+  vector<Values> expected;
+  vector<ISAM2Result> expectedResults;
+  for (size_t k = 0; k < factors.size(); ++k) {
+    expectedResults.push_back(isam.update(factors[k], values[k]));
+    expected.push_back(isam.calculateEstimate());
+  }
+
+  // Queue all updates at once
+  ISAM2Pipeline pipeline(params);
+  vector<boost::shared_future<ISAM2Result> > results;
+  for (size_t k = 0; k < factors.size(); ++k)
+    results.push_back(pipeline.updateAsync(factors[k], values[k]));
+
+  for (size_t k = 0; k < factors.size(); ++k) {
+    const ISAM2Result result = results[k].get();
+    EXPECT(expectedResults[k].newFactorsIndices == result.newFactorsIndices);
+    EXPECT_LONGS_EQUAL(expectedResults[k].variablesRelinearized, result.variablesRelinearized);
+  }
+  pipeline.wait();
+  EXPECT_LONGS_EQUAL(0, pipeline.pendingUpdates());
+  EXPECT_LONGS_EQUAL(factors.size(), pipeline.completedUpdates());
+  EXPECT(assert_equal(expected.back(), pipeline.calculateEstimate(), 1e-9));
+  EXPECT(assert_equal(isam.getLinearizationPoint(), pipeline.isam().getLinearizationPoint(), 1e-9));
+
+  // Waiting for each update in turn gives the estimate after that update
+  ISAM2Pipeline stepped(params);
+  for (size_t k = 0; k < factors.size(); ++k) {
+    stepped.update(factors[k], values[k]);
+    EXPECT(assert_equal(expected[k], stepped.calculateEstimate(), 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Pipeline, updateLinearized)
+{
+  vector<NonlinearFactorGraph> factors;
+  vector<Values> values;
+  createUpdates(factors, values);
+
+  ISAM2 expected, actual;
+  for (size_t k = 0; k < factors.size(); ++k) {
+    expected.update(factors[k], values[k]);
+
+    // Linearize at a wrong point for the existing variables, which must be detected
+    Values point = values[k];
+    BOOST_FOREACH(Key key, factors[k].keys())
+      if (!point.exists(key))
+        point.insert(key, Pose2(5.0, 5.0, 1.0));
+    actual.updateLinearized(factors[k], values[k], vector<size_t>(),
+        *factors[k].linearize(point), point);
+  }
+  EXPECT(assert_equal(expected.calculateEstimate(), actual.calculateEstimate(), 1e-9));
+
+  // There must be one linearized factor per new factor
+  CHECK_EXCEPTION(actual.updateLinearized(factors[1], Values(), vector<size_t>(),
+      GaussianFactorGraph(), Values()), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Pipeline, exception)
+{
+  ISAM2Pipeline pipeline;
+  NonlinearFactorGraph newFactors;
+  newFactors += PriorFactor<Pose2>(0, Pose2(), odoNoise);
+  Values newValues;
+  newValues.insert(0, Pose2());
+  pipeline.update(newFactors, newValues);
+
+  // Variable 2 has no initial value, so the update throws when it is applied
+  NonlinearFactorGraph bad;
+  bad += BetweenFactor<Pose2>(0, 2, Pose2(), odoNoise);
+  boost::shared_future<ISAM2Result> result = pipeline.updateAsync(bad, Values());
+  CHECK_EXCEPTION(result.get(), std::exception);
+  EXPECT_LONGS_EQUAL(2, pipeline.completedUpdates());
+  EXPECT(assert_equal(newValues, pipeline.calculateEstimate(), 1e-9));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
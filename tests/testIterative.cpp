@@ -25,9 +25,12 @@
 
 #include <CppUnitLite/TestHarness.h>
 
+#include <boost/assign/list_of.hpp>
+
 using namespace std;
 using namespace gtsam;
 using namespace example;
+using boost::assign::list_of;
 using symbol_shorthand::X; // to create pose keys
 using symbol_shorthand::L; // to create landmark keys
 
@@ -81,6 +84,50 @@ TEST( Iterative, conjugateGradientDescent )
   CHECK(assert_equal(expected,actual,1e-2));
 }
 
+/* ************************************************************************* */
+TEST( Iterative, DenseIndexedSystem )
+{
+  // A graph with a noise model and a Hessian factor, and a null factor that is skipped
+  GaussianFactorGraph fg = createGaussianFactorGraph();
+  fg += JacobianFactor(X(2), 2 * eye(2), Vector2(1.0, 2.0), noiseModel::Isotropic::Sigma(2, 0.5));
+  fg += HessianFactor(JacobianFactor(X(1), eye(2), L(1), -eye(2), Vector2(0.5, 0.0)));
+  GaussianFactorGraph withNull = fg;
+  withNull.push_back(GaussianFactor::shared_ptr());
+  DenseIndexedSystem Ab(withNull);
+
+  // The keys are numbered in the order they first appear
+  const FastVector<Key> expectedKeys = list_of<Key>(X(1))(X(2))(L(1));
+  EXPECT(expectedKeys == Ab.keys());
+  EXPECT_LONGS_EQUAL(6, Ab.cols());
+
+  VectorValues x;
+  x.insert(X(1), Vector2(0.1, 0.2));
+  x.insert(X(2), Vector2(-0.3, 0.4));
+  x.insert(L(1), Vector2(0.5, -0.6));
+  const Vector v = Ab.vector(x);
+  EXPECT(assert_equal(x, Ab.vectorValues(v)));
+
+  // Same products as the graph
+  Matrix A;
+  Vector b;
+  boost::tie(A, b) = fg.jacobian(Ordering(expectedKeys));
+  EXPECT_LONGS_EQUAL(A.rows(), Ab.rows());
+  EXPECT(assert_equal(Vector(A * v), Ab * v, 1e-9));
+  EXPECT(assert_equal(Vector(A.transpose() * (A * v - b)), Ab.gradient(v), 1e-9));
+  EXPECT(assert_equal(Ab.vector(fg.gradient(x)), Ab.gradient(v), 1e-9));
+  const Vector e = Ab * v;
+  Vector actual = v;
+  Ab.transposeMultiplyAdd(2.0, e, actual);
+  EXPECT(assert_equal(Vector(v + 2.0 * A.transpose() * A * v), actual, 1e-9));
+
+  // Conjugate gradients give the solution of the graph
+  ConjugateGradientParameters parameters;
+  parameters.setEpsilon_abs(1e-12);
+  parameters.setEpsilon_rel(1e-12);
+  EXPECT(assert_equal(fg.optimize(), conjugateGradientDescent(fg, VectorValues::Zero(x),
+      parameters), 1e-6));
+}
+
 /* ************************************************************************* */
 TEST( Iterative, conjugateGradientDescent_hard_constraint )
 {
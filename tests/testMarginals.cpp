@@ -238,6 +238,47 @@ TEST(Marginals, order) {
   LONGS_EQUAL(2, (long)joint(101,101).rows());
 }
 
+/* ************************************************************************* */
+TEST(Marginals, marginalCovariances) {
+  NonlinearFactorGraph fg;
+  Values vals;
+  fg += PriorFactor<Pose2>(0, Pose2(), noiseModel::Diagonal::Sigmas(Vector3(0.3, 0.3, 0.1)));
+  vals.insert(0, Pose2());
+  for (Key i = 1; i < 20; ++i) {
+    fg += BetweenFactor<Pose2>(i - 1, i, Pose2(1, 0, 0.1),
+        noiseModel::Diagonal::Sigmas(Vector3(0.2, 0.2, 0.1)));
+    vals.insert(i, Pose2(i, 0.1 * i, 0.1 * i));
+  }
+  for (Key j = 100; j < 105; ++j) {
+    const Point2 landmark(2.0 * (j - 100), 2);
+    vals.insert(j, landmark);
+    for (Key i = 4 * (j - 100); i < 4 * (j - 100) + 3; ++i)
+      fg += BearingRangeFactor<Pose2, Point2>(i, j, vals.at<Pose2>(i).bearing(landmark),
+          vals.at<Pose2>(i).range(landmark), noiseModel::Unit::Create(2));
+  }
+
+  Marginals marginals(fg, vals);
+  const FastMap<Key, Matrix> covariances = marginals.marginalCovariances();
+  LONGS_EQUAL(25, (long)covariances.size());
+  BOOST_FOREACH(Key key, fg.keys())
+    EXPECT(assert_equal(marginals.marginalCovariance(key), covariances.at(key), 1e-8));
+
+  // The sparse inverse contains the joint covariance of every factor
+  const FastMap<std::pair<Key, Key>, Matrix> sparse = marginals.sparseInverse();
+  BOOST_FOREACH(const NonlinearFactor::shared_ptr& factor, fg) {
+    const Key i = std::min(factor->front(), factor->back());
+    const Key j = std::max(factor->front(), factor->back());
+    JointMarginal joint = marginals.jointMarginalCovariance(factor->keys());
+    EXPECT(assert_equal(Matrix(joint(i, j)), sparse.at(std::make_pair(i, j)), 1e-8));
+    EXPECT(assert_equal(Matrix(joint(i, i)), sparse.at(std::make_pair(i, i)), 1e-8));
+  }
+
+  Marginals qr(fg, vals, Marginals::QR);
+  const FastMap<Key, Matrix> qrCovariances = qr.marginalCovariances();
+  BOOST_FOREACH(Key key, fg.keys())
+    EXPECT(assert_equal(marginals.marginalCovariance(key), qrCovariances.at(key), 1e-8));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -18,6 +18,8 @@
  **/
 
 /*STL/C++*/
+#include <boost/foreach.hpp>
+
 #include <iostream>
 
 #include <CppUnitLite/TestHarness.h>
@@ -30,6 +32,9 @@
 #include <tests/smallExample.h>
 #include <tests/simulated2D.h>
 #include <gtsam/linear/GaussianFactor.h>
+#include <gtsam/linear/BinaryJacobianFactor.h>
+#include <gtsam/linear/UnaryJacobianFactor.h>
+#include <gtsam/linear/HessianFactor.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/inference/Symbol.h>
 
@@ -175,6 +180,69 @@ TEST( NonlinearFactor, linearize_f4 )
   CHECK(assert_equal(*expected,*actual));
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactor, linearize_fixedSize )
+{
+  Values c = createNoisyValues();
+  NonlinearFactorGraph nfg = createNonlinearFactorGraph();
+
+  // Factors on fixed-dimension values linearize to fixed-size Jacobian factors
+  typedef UnaryJacobianFactor<Eigen::Dynamic, 2> Unary;
+  typedef BinaryJacobianFactor<Eigen::Dynamic, 2, 2> Binary;
+  GaussianFactorGraph actual = *nfg.linearize(c);
+  EXPECT(boost::dynamic_pointer_cast<Unary>(actual[0]));
+  EXPECT(boost::dynamic_pointer_cast<Binary>(actual[1]));
+
+  // Compare with plain JacobianFactors
+  GaussianFactorGraph expected;
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, actual)
+    expected.push_back(boost::make_shared<JacobianFactor>(
+        *boost::dynamic_pointer_cast<JacobianFactor>(factor)));
+  EXPECT(assert_equal(expected, actual));
+
+  // Fixed-size updateHessian
+  EXPECT(assert_equal(expected.hessian().first, actual.hessian().first, 1e-9));
+  EXPECT(assert_equal(expected.hessian().second, actual.hessian().second, 1e-9));
+
+  VectorValues x = createCorrectDelta();
+
+  VectorValues expectedY = x, actualY = x;
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, expected)
+    factor->multiplyHessianAdd(0.5, x, expectedY);
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, actual)
+    factor->multiplyHessianAdd(0.5, x, actualY);
+  EXPECT(assert_equal(expectedY, actualY, 1e-9));
+
+  Errors e = expected * x;
+  VectorValues expectedG, actualG;
+  expected.transposeMultiplyAdd(2.0, e, expectedG);
+  actual.transposeMultiplyAdd(2.0, e, actualG);
+  EXPECT(assert_equal(expectedG, actualG, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactor, linearizeInto )
+{
+  NonlinearFactorGraph nfg = createNonlinearFactorGraph();
+  Values c1 = createNoisyValues(), c2 = createValues();
+
+  // Linearizing at c2 overwrites the linearization at c1 in its own storage
+  GaussianFactor::shared_ptr actual = nfg[1]->linearize(c1);
+  const double* data =
+      boost::dynamic_pointer_cast<JacobianFactor>(actual)->matrixObject().matrix().data();
+  EXPECT(nfg[1]->linearizeInto(c2, *actual));
+  EXPECT(assert_equal(*nfg[1]->linearize(c2), *actual, 1e-9));
+  EXPECT(data ==
+      boost::dynamic_pointer_cast<JacobianFactor>(actual)->matrixObject().matrix().data());
+
+  // Factors of another shape or type are left unchanged
+  JacobianFactor other(X(1), eye(2), zero(2));
+  EXPECT(!nfg[1]->linearizeInto(c2, other));
+  EXPECT(assert_equal(JacobianFactor(X(1), eye(2), zero(2)), other));
+  HessianFactor hessian(*actual);
+  EXPECT(!nfg[1]->linearizeInto(c2, hessian));
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactor, size )
 {
@@ -23,12 +23,15 @@ using namespace std;
 
 #include <boost/assign/std/list.hpp>
 #include <boost/assign/std/set.hpp>
+#include <boost/core/demangle.hpp>
+#include <boost/foreach.hpp>
 using namespace boost::assign;
 
 #include <CppUnitLite/TestHarness.h>
 
 #include <gtsam/base/Testable.h>
 #include <gtsam/base/Matrix.h>
+#include <gtsam/base/timing.h>
 #include <tests/smallExample.h>
 #include <gtsam/inference/FactorGraph.h>
 #include <gtsam/inference/Symbol.h>
@@ -62,6 +65,17 @@ TEST( NonlinearFactorGraph, error )
   DOUBLES_EQUAL( 5.625, actual2, 1e-9 );
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, errorChunked )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  fg.push_back(NonlinearFactor::shared_ptr()); // null factors are skipped
+  Values c2 = createNoisyValues();
+  double expected = fg.error(c2);
+  for (size_t grainSize = 1; grainSize <= fg.size() + 1; ++grainSize)
+    DOUBLES_EQUAL(expected, fg.error(c2, grainSize), 1e-9);
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactorGraph, keys )
 {
@@ -112,6 +126,112 @@ TEST( NonlinearFactorGraph, linearize )
   CHECK(assert_equal(expected,linearized)); // Needs correct linearizations
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, relinearize )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  fg.push_back(NonlinearFactor::shared_ptr());
+  Values initial = createNoisyValues();
+  GaussianFactorGraph expected = *fg.linearize(initial);
+
+  // Relinearize the linearization at other values, keeping a reference to its first factor
+  GaussianFactorGraph actual = *fg.linearize(createValues());
+  vector<const GaussianFactor*> factors;
+  BOOST_FOREACH(const GaussianFactor::shared_ptr& factor, actual)
+    factors.push_back(factor.get());
+  GaussianFactor::shared_ptr shared = actual[0];
+  GaussianFactor::shared_ptr sharedCopy = shared->clone();
+  fg.relinearize(initial, actual);
+  EXPECT(assert_equal(expected, actual));
+
+  // The shared factor was replaced, the others were overwritten in place
+  EXPECT(actual[0] != shared);
+  EXPECT(assert_equal(*sharedCopy, *shared));
+  for (size_t i = 1; i < fg.size() - 1; ++i)
+    EXPECT(actual[i].get() == factors[i]);
+
+  // An empty graph is resized
+  GaussianFactorGraph empty;
+  fg.relinearize(initial, empty);
+  EXPECT(assert_equal(expected, empty));
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, factorProfile )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  Values initial = createNoisyValues();
+  GaussianFactorGraph linear;
+
+  internal::startFactorProfile();
+  fg.error(initial);
+  fg.error(initial);
+  fg.linearize(initial);
+  fg.relinearize(initial, linear);
+  internal::stopFactorProfile();
+  fg.linearize(initial); // not profiled
+
+  // A prior, an odometry and two measurements, with 2-dimensional variables and errors
+  const vector<internal::FactorTypeProfile> profiles = internal::factorProfile();
+  LONGS_EQUAL(3, (long)profiles.size());
+  map<string, internal::FactorTypeProfile> byType;
+  BOOST_FOREACH(const internal::FactorTypeProfile& profile, profiles)
+    byType[profile.type] = profile;
+  const internal::FactorTypeProfile& prior =
+      byType[boost::core::demangle(typeid(simulated2D::Prior).name())];
+  EXPECT_LONGS_EQUAL(2, (long)prior.errorCalls);
+  EXPECT_LONGS_EQUAL(2, (long)prior.linearizeCalls);
+  EXPECT_LONGS_EQUAL(2 * 2 * 3, (long)prior.linearizedEntries);
+  const internal::FactorTypeProfile& measurement =
+      byType[boost::core::demangle(typeid(simulated2D::Measurement).name())];
+  EXPECT_LONGS_EQUAL(4, (long)measurement.errorCalls);
+  EXPECT_LONGS_EQUAL(4, (long)measurement.linearizeCalls);
+  EXPECT_LONGS_EQUAL(4 * 2 * 5, (long)measurement.linearizedEntries);
+  EXPECT(measurement.secs() > 0.0);
+
+  // Starting again clears the statistics
+  internal::startFactorProfile();
+  internal::stopFactorProfile();
+  EXPECT(internal::factorProfile().empty());
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, memoryUsage )
+{
+  // Three factors sharing a noise model, and one with a noise model of its own
+  SharedDiagonal shared = noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.2));
+  SharedDiagonal own = noiseModel::Diagonal::Sigmas(Vector2(0.3, 0.4));
+  NonlinearFactorGraph fg;
+  fg += simulated2D::Prior(Point2(0.0, 0.0), shared, X(1));
+  fg += simulated2D::Odometry(Point2(1.0, 0.0), shared, X(1), X(2));
+  fg += simulated2D::Odometry(Point2(1.0, 0.0), shared, X(2), X(3));
+  fg += simulated2D::Measurement(Point2(0.0, 1.0), own, X(3), L(1));
+  fg.push_back(NonlinearFactor::shared_ptr());
+
+  const MemoryUsage usage = fg.memoryUsage();
+  EXPECT_LONGS_EQUAL((long)(shared->memoryUsage() + own->memoryUsage()),
+      (long)usage["noise models"]);
+  EXPECT_LONGS_EQUAL(sizeof(noiseModel::Diagonal) + 3 * 2 * sizeof(double),
+      (long)shared->memoryUsage());
+  size_t factors = sizeof(NonlinearFactorGraph) + fg.size() * sizeof(NonlinearFactorGraph::sharedFactor);
+  for (size_t i = 0; i < 4; ++i)
+    factors += fg[i]->memoryUsage();
+  EXPECT(usage["factors"] >= factors); // the vector of factors may have unused capacity
+  EXPECT_LONGS_EQUAL((long)(usage["factors"] + usage["noise models"]), (long)usage.total());
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, gradient )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  fg.push_back(NonlinearFactor::shared_ptr()); // null factors are skipped
+  Values initial = createNoisyValues();
+  VectorValues expected = fg.linearize(initial)->gradientAtZero();
+  EXPECT(assert_equal(expected, fg.gradient(initial), 1e-9));
+  for (size_t grainSize = 1; grainSize <= fg.size() + 1; ++grainSize)
+    EXPECT(assert_equal(expected, fg.gradient(initial, grainSize), 1e-9));
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactorGraph, clone )
 {
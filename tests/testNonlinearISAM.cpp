@@ -228,6 +228,63 @@ TEST(testNonlinearISAM, markov_chain_with_reconnect ) {
   EXPECT(assert_equal(expected.at<Point2>(lm3), actualQR.at<Point2>(lm3), tol));
 }
 
+/* ************************************************************************* */
+TEST(testNonlinearISAM, markov_chain_background_reorder ) {
+  int reorder_interval = 2;
+  NonlinearISAM isamBatch(reorder_interval, EliminatePreferCholesky); // create an ISAM object
+  NonlinearISAM isamBackground(reorder_interval, EliminatePreferCholesky, true);
+
+  SharedDiagonal model = noiseModel::Diagonal::Sigmas(Vector3(3.0, 3.0, 0.5));
+  Sampler sampler(model, 42u);
+
+  // create initial graph
+  Pose2 cur_pose; // start at origin
+  NonlinearFactorGraph start_factors;
+  start_factors += NonlinearEquality<Pose2>(0, cur_pose);
+
+  Values init;
+  Values expected;
+  init.insert(0, cur_pose);
+  expected.insert(0, cur_pose);
+  isamBatch.update(start_factors, init);
+  isamBackground.update(start_factors, init);
+
+  size_t nrPoses = 21;
+  Pose2 z(1.0, 2.0, 0.1);
+  for (size_t i=1; i<=nrPoses; ++i) {
+    NonlinearFactorGraph new_factors;
+    new_factors += BetweenFactor<Pose2>(i-1, i, z, model);
+    Values new_init;
+
+    cur_pose = cur_pose.compose(z);
+    new_init.insert(i, cur_pose.retract(sampler.sample()));
+    expected.insert(i, cur_pose);
+    isamBatch.update(new_factors, new_init);
+    isamBackground.update(new_factors, new_init);
+
+    // Let every other reordering finish before the next update swaps it in
+    if (i % 4 == 0)
+      isamBackground.waitForReorder();
+  }
+  isamBackground.waitForReorder();
+  EXPECT(!isamBackground.reorderInProgress());
+
+  // verify values - all but the last one should be very close
+  Values actualBatch = isamBatch.estimate();
+  Values actualBackground = isamBackground.estimate();
+  for (size_t i=0; i<nrPoses; ++i) {
+    EXPECT(assert_equal(expected.at<Pose2>(i), actualBackground.at<Pose2>(i), tol));
+    EXPECT(assert_equal(actualBatch.at<Pose2>(i), actualBackground.at<Pose2>(i), tol));
+  }
+
+  // A batch reordering supersedes a running background one
+  isamBackground.reorder_relinearize();
+  EXPECT(!isamBackground.reorderInProgress());
+  Values actualRelinearized = isamBackground.estimate();
+  for (size_t i=0; i<nrPoses; ++i)
+    EXPECT(assert_equal(expected.at<Pose2>(i), actualRelinearized.at<Pose2>(i), tol));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
@@ -170,6 +170,30 @@ TEST( NonlinearOptimizer, optimization_method )
 
   Values actualMFChol = LevenbergMarquardtOptimizer(fg, c0, paramsChol).optimize();
   DOUBLES_EQUAL(0,fg.error(actualMFChol),tol);
+
+  LevenbergMarquardtParams paramsMixed;
+  paramsMixed.setLinearSolverType("MULTIFRONTAL_CHOLESKY_MIXED");
+  EXPECT(paramsMixed.isMixedPrecision());
+  Values actualMixed = LevenbergMarquardtOptimizer(fg, c0, paramsMixed).optimize();
+  DOUBLES_EQUAL(0,fg.error(actualMixed),tol);
+  EXPECT(assert_equal(actualMFChol, actualMixed, 1e-9));
+
+  // Schur complement, eliminating the landmark first
+  NonlinearFactorGraph slam = example::createNonlinearFactorGraph();
+  Values noisy = example::createNoisyValues();
+  Values expectedSlam = LevenbergMarquardtOptimizer(slam, noisy, paramsChol).optimize();
+  LevenbergMarquardtParams paramsSchur;
+  paramsSchur.setLinearSolverType("SCHUR_COMPLEMENT");
+  EXPECT(paramsSchur.isSchurComplement());
+  EXPECT(assert_equal(expectedSlam, LevenbergMarquardtOptimizer(slam, noisy, paramsSchur).optimize(), 1e-6));
+  paramsSchur.schurKeys.insert(L(1));
+  EXPECT(assert_equal(expectedSlam, LevenbergMarquardtOptimizer(slam, noisy, paramsSchur).optimize(), 1e-6));
+
+  // Sparse Cholesky of the assembled Hessian
+  LevenbergMarquardtParams paramsCholmod;
+  paramsCholmod.setLinearSolverType("CHOLMOD");
+  EXPECT(paramsCholmod.isCholmod());
+  EXPECT(assert_equal(expectedSlam, LevenbergMarquardtOptimizer(slam, noisy, paramsCholmod).optimize(), 1e-6));
 }
 
 /* ************************************************************************* */
@@ -302,6 +326,11 @@ TEST_UNSAFE(NonlinearOptimizer, MoreOptimization) {
     expectedDiagonal = d + params.lambdaInitial * d;
     EXPECT(assert_equal(expectedDiagonal, damped.hessianDiagonal()));
 
+    // The damped system shares the undamped factors rather than copying them
+    LONGS_EQUAL(linear->size() + initBetter.size(), damped.size());
+    for (size_t i = 0; i < linear->size(); i++)
+      EXPECT(damped[i] == (*linear)[i]);
+
     // test convergence (does not!)
     Values actual = optimizer.optimize();
     EXPECT(assert_equal(expected, actual));
@@ -389,6 +418,78 @@ TEST(NonlinearOptimizer, disconnected_graph) {
   EXPECT(assert_equal(expected, LevenbergMarquardtOptimizer(graph, init).optimize()));
 }
 
+/* ************************************************************************* */
+TEST(NonlinearOptimizer, linearizationCache) {
+  // X1 and X2 start at their solution, so their factors never need relinearizing
+  Values init;
+  init.insert(X(1), Pose2(0.,0.,0.));
+  init.insert(X(2), Pose2(1.5,0.,0.));
+  init.insert(X(3), Pose2(2.5,0.5,0.3));
+  init.insert(X(4), Pose2(2.0,2.0,-0.5));
+
+  NonlinearFactorGraph graph;
+  graph += PriorFactor<Pose2>(X(1), Pose2(0.,0.,0.), noiseModel::Isotropic::Sigma(3,1));
+  graph += BetweenFactor<Pose2>(X(1),X(2), Pose2(1.5,0.,0.), noiseModel::Isotropic::Sigma(3,1));
+  graph += PriorFactor<Pose2>(X(3), Pose2(3.,0.,0.), noiseModel::Isotropic::Sigma(3,1));
+  graph += BetweenFactor<Pose2>(X(3),X(4), Pose2(1.0,0.5,1.2), noiseModel::Isotropic::Sigma(3,1));
+  const Values exact = LevenbergMarquardtOptimizer(graph, init).optimize();
+
+  LevenbergMarquardtParams lmParams;
+  lmParams.cacheLinearization = true;
+  lmParams.relinearizeThreshold = 1e-3;
+  LevenbergMarquardtOptimizer lm(graph, init, lmParams);
+  EXPECT(assert_equal(exact, lm.optimize(), 1e-4));
+  EXPECT(lm.skippedLinearizations() > 0);
+
+  GaussNewtonParams gnParams;
+  gnParams.cacheLinearization = true;
+  gnParams.relinearizeThreshold = 1e-3;
+  GaussNewtonOptimizer gn(graph, init, gnParams);
+  EXPECT(assert_equal(exact, gn.optimize(), 1e-4));
+  EXPECT(gn.skippedLinearizations() > 0);
+
+  // Without the cache nothing is skipped
+  LevenbergMarquardtOptimizer uncached(graph, init);
+  uncached.optimize();
+  EXPECT_LONGS_EQUAL(0, uncached.skippedLinearizations());
+}
+
+/* ************************************************************************* */
+TEST(NonlinearOptimizer, parallelLambdaTrials) {
+  // A poor initial estimate, so that LM rejects steps and increases lambda
+  NonlinearFactorGraph fg;
+  fg += PriorFactor<Pose2>(0, Pose2(0, 0, 0), noiseModel::Isotropic::Sigma(3, 1));
+  fg += BetweenFactor<Pose2>(0, 1, Pose2(1, 0, M_PI / 2), noiseModel::Isotropic::Sigma(3, 1));
+  fg += BetweenFactor<Pose2>(1, 2, Pose2(1, 0, M_PI / 2), noiseModel::Isotropic::Sigma(3, 1));
+
+  Values init;
+  init.insert(0, Pose2(3, 4, -M_PI));
+  init.insert(1, Pose2(10, 2, -M_PI));
+  init.insert(2, Pose2(11, 7, -M_PI));
+
+  Values expected;
+  expected.insert(0, Pose2(0, 0, 0));
+  expected.insert(1, Pose2(1, 0, M_PI / 2));
+  expected.insert(2, Pose2(1, 1, M_PI));
+
+  LevenbergMarquardtParams params = LevenbergMarquardtParams::LegacyDefaults();
+  params.lambdaUpperBound = 1e9;
+  LevenbergMarquardtOptimizer sequential(fg, init, params);
+  EXPECT(assert_equal(expected, sequential.optimize(), 1e-4));
+
+  params.setParallelLambdaTrials(4);
+  const NonlinearOptimizerParams::LinearSolverType solvers[] = {
+      NonlinearOptimizerParams::MULTIFRONTAL_CHOLESKY, NonlinearOptimizerParams::MULTIFRONTAL_QR,
+      NonlinearOptimizerParams::SEQUENTIAL_CHOLESKY, NonlinearOptimizerParams::CHOLMOD };
+  for (size_t i = 0; i < 4; ++i) {
+    params.linearSolverType = solvers[i];
+    LevenbergMarquardtOptimizer parallel(fg, init, params);
+    EXPECT(assert_equal(expected, parallel.optimize(), 1e-4));
+    // Rejected steps try several lambdas at once
+    EXPECT(parallel.getInnerIterations() >= sequential.getInnerIterations());
+  }
+}
+
 /* ************************************************************************* */
 #include <gtsam/linear/iterative.h>
 
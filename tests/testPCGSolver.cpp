@@ -19,6 +19,7 @@
 #include <tests/smallExample.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
 #include <gtsam/linear/PCGSolver.h>
 #include <gtsam/linear/SubgraphPreconditioner.h>
 #include <gtsam/inference/Symbol.h>
@@ -26,7 +27,9 @@
 
 #include <CppUnitLite/TestHarness.h>
 
+#include <boost/foreach.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/assign/list_of.hpp>
 #include <boost/assign/std/list.hpp> // for operator +=
 using namespace boost::assign;
 
@@ -124,6 +127,174 @@ TEST( GaussianFactorGraphSystem, multiply_getb)
   EXPECT(assert_equal(expectedb, actualb, 1e-3));
 }
 
+/* ************************************************************************* */
+// Test the BSR kernel of GaussianFactorGraphSystem::multiply against the factor graph version
+TEST( GaussianFactorGraphSystem, multiply_bsr)
+{
+  // Chain of 3D variables, which uses the fixed-size kernel, and a mix of dimensions
+  GaussianFactorGraph chain, mixed;
+  SharedDiagonal model3 = noiseModel::Diagonal::Sigmas(Vector3(0.5, 0.3, 0.1));
+  Matrix A = (Matrix(3,3) << 1, 2, 0, 0, 3, 1, 1, 0, 4).finished();
+  chain += JacobianFactor(0, A, Vector3(1, 2, 3), model3);
+  for (Key j = 0; j < 4; ++j)
+    chain += JacobianFactor(j, -A, j + 1, A.transpose(), Vector3(0, 1, j), model3);
+  mixed = chain;
+  mixed += JacobianFactor(2, (Matrix(2,3) << 1, 0, 1, 0, 1, 0).finished(), 7,
+      (Matrix(2,2) << 2, 1, 0, 2).finished(), Vector2(1, 1), noiseModel::Unit::Create(2));
+  mixed += HessianFactor(JacobianFactor(7, (Matrix(2,2) << 1, 1, 0, 1).finished(),
+      Vector2(0, 1)));
+  // A 6D, a 1D and a 4D variable, the last of which uses the dynamic kernel
+  Matrix A63 = Matrix::Zero(3, 6), A41 = Matrix::Ones(4, 1);
+  A63.leftCols<3>() = A;
+  A63.rightCols<3>() = A.transpose();
+  mixed += JacobianFactor(2, A, 8, A63, Vector3(1, 0, 2), model3);
+  mixed += JacobianFactor(8, Matrix::Identity(6, 6), Vector::LinSpaced(6, 0, 1));
+  mixed += JacobianFactor(8, Matrix::Ones(1, 6), 9, Matrix::Constant(1, 1, 2.0),
+      Vector::Ones(1));
+  mixed += JacobianFactor(9, A41, 10, Matrix::Identity(4, 4) * 2, Vector4(1, 2, 3, 4));
+
+  const std::vector<GaussianFactorGraph> graphs = list_of(chain)(mixed);
+  BOOST_FOREACH(const GaussianFactorGraph& gfg, graphs) {
+    DummyPreconditioner dummyPreconditioner;
+    KeyInfo keyInfo(gfg);
+    std::map<Key,Vector> lambda;
+    dummyPreconditioner.build(gfg, keyInfo, lambda);
+
+    BlockSparseHessian hessian(gfg, keyInfo);
+    EXPECT(assert_equal(gfg.hessian(keyInfo.ordering()).first, hessian.matrix(), 1e-9));
+
+    GaussianFactorGraphSystem factors(gfg, dummyPreconditioner, keyInfo, lambda);
+    GaussianFactorGraphSystem bsr(gfg, dummyPreconditioner, keyInfo, lambda,
+        ConjugateGradientParameters::BSR);
+    Vector x = Vector::LinSpaced(keyInfo.numCols(), -1.0, 2.0);
+    Vector expected = Vector::Zero(x.size()), actual = Vector::Zero(x.size());
+    factors.multiply(x, expected);
+    bsr.multiply(x, actual);
+    EXPECT(assert_equal(expected, actual, 1e-9));
+  }
+  LONGS_EQUAL(3, BlockSparseHessian(chain, KeyInfo(chain)).blockDim());
+  LONGS_EQUAL(13, BlockSparseHessian(chain, KeyInfo(chain)).nrBlocks());
+  LONGS_EQUAL(0, BlockSparseHessian(mixed, KeyInfo(mixed)).blockDim());
+}
+
+/* ************************************************************************* */
+// Test PCG with the BSR kernel
+TEST( PCGSolver, bsr )
+{
+  LevenbergMarquardtParams paramsPCG;
+  paramsPCG.linearSolverType = LevenbergMarquardtParams::Iterative;
+  PCGSolverParameters::shared_ptr pcg = boost::make_shared<PCGSolverParameters>();
+  pcg->preconditioner_ = boost::make_shared<BlockJacobiPreconditionerParameters>();
+  pcg->blas_kernel_ = ConjugateGradientParameters::BSR;
+  paramsPCG.iterativeParams = pcg;
+
+  NonlinearFactorGraph fg = example::createReallyNonlinearFactorGraph();
+
+  Point2 x0(10,10);
+  Values c0;
+  c0.insert(X(1), x0);
+
+  Values actualPCG = LevenbergMarquardtOptimizer(fg, c0, paramsPCG).optimize();
+
+  DOUBLES_EQUAL(0,fg.error(actualPCG),tol);
+}
+
+/* ************************************************************************* */
+// Test pipelined PCG against standard PCG
+TEST( PCGSolver, pipelined )
+{
+  GaussianFactorGraph gfg = example::createGaussianFactorGraph();
+  KeyInfo keyInfo(gfg);
+  std::map<Key,Vector> lambda;
+  const VectorValues expected = gfg.optimize();
+
+  PCGSolverParameters pcg;
+  pcg.preconditioner_ = boost::make_shared<BlockJacobiPreconditionerParameters>();
+  pcg.setEpsilon_rel(1e-10);
+  pcg.setEpsilon_abs(1e-20);
+  pcg.setVariant(ConjugateGradientParameters::PIPELINED);
+  // Restarting the recurrences halfway must not change the solution
+  pcg.setReset(3);
+  const VectorValues actual = PCGSolver(pcg).optimize(gfg, keyInfo, lambda,
+      VectorValues::Zero(expected));
+  EXPECT(assert_equal(expected, actual, 1e-6));
+
+  LevenbergMarquardtParams paramsPCG;
+  paramsPCG.linearSolverType = LevenbergMarquardtParams::Iterative;
+  PCGSolverParameters::shared_ptr lmPCG = boost::make_shared<PCGSolverParameters>(pcg);
+  lmPCG->setReset(501);
+  paramsPCG.iterativeParams = lmPCG;
+
+  NonlinearFactorGraph fg = example::createReallyNonlinearFactorGraph();
+  Values c0;
+  c0.insert(X(1), Point2(10,10));
+  Values actualPCG = LevenbergMarquardtOptimizer(fg, c0, paramsPCG).optimize();
+  DOUBLES_EQUAL(0,fg.error(actualPCG),tol);
+}
+
+/* ************************************************************************* */
+// Test warm started PCG, and inexact Newton steps in LM
+TEST( PCGSolver, warmStarted )
+{
+  GaussianFactorGraph gfg = example::createGaussianFactorGraph();
+  KeyInfo keyInfo(gfg);
+  std::map<Key,Vector> lambda;
+  const VectorValues expected = gfg.optimize();
+
+  PCGSolverParameters pcg;
+  pcg.preconditioner_ = boost::make_shared<BlockJacobiPreconditionerParameters>();
+  pcg.setEpsilon_rel(1e-10);
+  pcg.setEpsilon_abs(1e-20);
+  VectorValues near = expected;
+  near.begin()->second += Vector::Constant(near.begin()->second.size(), 1e-3);
+  EXPECT(assert_equal(expected, PCGSolver(pcg).optimizeWarmStarted(gfg, keyInfo, lambda, near), 1e-6));
+  EXPECT(assert_equal(expected, PCGSolver(pcg).optimizeWarmStarted(gfg, keyInfo, lambda, expected), 1e-6));
+  // A warm start worse than zero is not used
+  VectorValues far = expected;
+  far.begin()->second += Vector::Constant(far.begin()->second.size(), 1e3);
+  EXPECT(assert_equal(expected, PCGSolver(pcg).optimizeWarmStarted(gfg, keyInfo, lambda, far), 1e-6));
+
+  NonlinearFactorGraph fg = example::createNonlinearFactorGraph();
+  const Values c0 = example::createNoisyValues();
+  const Values exact = LevenbergMarquardtOptimizer(fg, c0).optimize();
+
+  LevenbergMarquardtParams paramsPCG;
+  paramsPCG.linearSolverType = LevenbergMarquardtParams::Iterative;
+  paramsPCG.iterativeParams = boost::make_shared<PCGSolverParameters>(pcg);
+  paramsPCG.setInexactNewton(true);
+  paramsPCG.setWarmStartIterative(true);
+  LevenbergMarquardtOptimizer inexact(fg, c0, paramsPCG);
+  EXPECT(assert_equal(exact, inexact.optimize(), 1e-4));
+
+  // The parallel lambda trials are solved one after another, as the steps depend on each other
+  paramsPCG.setParallelLambdaTrials(3);
+  EXPECT(assert_equal(exact, LevenbergMarquardtOptimizer(fg, c0, paramsPCG).optimize(), 1e-4));
+}
+
+/* ************************************************************************* */
+// Test block PCG with several right-hand sides
+TEST( PCGSolver, block )
+{
+  GaussianFactorGraph gfg = example::createGaussianFactorGraph();
+  KeyInfo keyInfo(gfg);
+  std::map<Key,Vector> lambda;
+  const Matrix H = gfg.hessian(keyInfo.ordering()).first;
+  Matrix B(H.rows(), 3);
+  B << Matrix::Identity(H.rows(), 2), Vector::LinSpaced(H.rows(), -1.0, 2.0);
+  const Matrix expected = H.llt().solve(B);
+
+  PCGSolverParameters pcg;
+  pcg.preconditioner_ = boost::make_shared<BlockJacobiPreconditionerParameters>();
+  pcg.setEpsilon_rel(1e-10);
+  pcg.setEpsilon_abs(1e-20);
+  EXPECT(assert_equal(expected, PCGSolver(pcg).solve(gfg, keyInfo, lambda, B), 1e-6));
+
+  pcg.setVariant(ConjugateGradientParameters::BLOCK);
+  EXPECT(assert_equal(expected, PCGSolver(pcg).solve(gfg, keyInfo, lambda, B), 1e-6));
+  EXPECT(ConjugateGradientParameters::BLOCK ==
+      ConjugateGradientParameters::variantTranslator("block"));
+}
+
 /* ************************************************************************* */
 // Test Dummy Preconditioner
 TEST( PCGSolver, dummy )
@@ -0,0 +1,103 @@
+/**
+ * @file    testPooledFactorGraph.cpp
+ * @brief   Unit tests for the factor graph storing its factors in pools by type
+ * @date    Oct 15, 2026
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/nonlinear/PooledFactorGraph.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/base/TestableAssertions.h>
+
+using namespace std;
+using namespace gtsam;
+
+static const SharedNoiseModel noise = noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.1, 0.05));
+
+/* ************************************************************************* */
+// A pose graph with interleaved factor types, in a PooledFactorGraph and a NonlinearFactorGraph
+static void createGraphs(PooledFactorGraph& pooled, NonlinearFactorGraph& graph, Values& values) {
+  const Pose2 odometry(1.0, 0.2, 0.1);
+  Pose2 pose;
+  for (Key j = 0; j < 20; ++j) {
+    if (j % 5 == 0) {
+      PriorFactor<Pose2> prior(j, pose, noise);
+      pooled.add(prior);
+      graph.push_back(prior);
+    }
+    if (j > 0) {
+      BetweenFactor<Pose2> between(j - 1, j, odometry, noise);
+      pooled.add(between);
+      graph.push_back(between);
+    }
+    values.insert(j, pose.retract(Vector3(0.01 * j, -0.02, 0.003 * j)));
+    pose = pose.compose(odometry);
+  }
+}
+
+/* ************************************************************************* */
+TEST(PooledFactorGraph, sameAsNonlinearFactorGraph)
+{
+  PooledFactorGraph pooled;
+  NonlinearFactorGraph graph;
+  Values values;
+  createGraphs(pooled, graph, values);
+  EXPECT_LONGS_EQUAL(2, pooled.nrPools());
+  EXPECT_LONGS_EQUAL(graph.size(), pooled.size());
+  EXPECT_LONGS_EQUAL(graph.size(), pooled.nrFactors());
+
+  EXPECT_DOUBLES_EQUAL(graph.error(values), pooled.error(values), 1e-9);
+  EXPECT(assert_equal(*graph.linearize(values), *pooled.linearize(values)));
+  EXPECT(assert_equal(graph, pooled.asNonlinearFactorGraph()));
+  EXPECT(assert_equal(*graph[3], pooled.at(3)));
+
+  // Indices are given out in the order the factors were added
+  EXPECT_LONGS_EQUAL(graph.size(), pooled.add(BetweenFactor<Pose2>(0, 19, Pose2(), noise)));
+}
+
+/* ************************************************************************* */
+TEST(PooledFactorGraph, remove)
+{
+  PooledFactorGraph pooled;
+  NonlinearFactorGraph graph;
+  Values values;
+  createGraphs(pooled, graph, values);
+
+  // Removed factors leave null slots, and the other factors keep their index
+  pooled.remove(0);
+  pooled.remove(7);
+  graph.remove(0);
+  graph.remove(7);
+  EXPECT(!pooled.exists(7));
+  EXPECT(pooled.exists(8));
+  EXPECT_LONGS_EQUAL(graph.size() - 2, pooled.nrFactors());
+  CHECK_EXCEPTION(pooled.at(7), std::out_of_range);
+
+  EXPECT_DOUBLES_EQUAL(graph.error(values), pooled.error(values), 1e-9);
+  const GaussianFactorGraph::shared_ptr linear = pooled.linearize(values);
+  EXPECT(!(*linear)[0] && !(*linear)[7]);
+  EXPECT(assert_equal(*graph.linearize(values), *linear));
+  EXPECT(assert_equal(graph, pooled.asNonlinearFactorGraph()));
+}
+
+/* ************************************************************************* */
+TEST(PooledFactorGraph, concreteType)
+{
+  // Adding through a base class reference would slice the factor
+  struct DerivedFactor : public BetweenFactor<Pose2> {
+    DerivedFactor() : BetweenFactor<Pose2>(0, 1, Pose2(), noise) {}
+  };
+  PooledFactorGraph pooled;
+  const DerivedFactor derived;
+  const BetweenFactor<Pose2>& base = derived;
+  CHECK_EXCEPTION(pooled.add(base), std::invalid_argument);
+  EXPECT_LONGS_EQUAL(0, pooled.size());
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -24,6 +24,9 @@
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/PCGSolver.h>
 #include <gtsam/geometry/Point2.h>
+#include <tests/smallExample.h>
+
+#include <boost/tuple/tuple.hpp>
 
 using namespace std;
 using namespace gtsam;
@@ -122,6 +125,124 @@ TEST(PCGSolver, simpleLinearSystem) {
   EXPECT(assert_equal(expectedSolution, deltaPCGJacobi, 1e-5));
   //deltaPCGJacobi.print("PCG Jacobi");
 
+  // With block incomplete Cholesky preconditioner
+  pcg->preconditioner_ = boost::make_shared<gtsam::BlockIncompleteCholeskyPreconditionerParameters>();
+  VectorValues deltaPCGIC = PCGSolver(*pcg).optimize(simpleGFG);
+  EXPECT(assert_equal(expectedSolution, deltaPCGIC, 1e-5));
+
+  // With algebraic multigrid preconditioner
+  pcg->preconditioner_ = boost::make_shared<gtsam::AlgebraicMultigridPreconditionerParameters>();
+  VectorValues deltaPCGAMG = PCGSolver(*pcg).optimize(simpleGFG);
+  EXPECT(assert_equal(expectedSolution, deltaPCGAMG, 1e-5));
+}
+
+/* ************************************************************************* */
+TEST(Preconditioner, blockJacobi) {
+  // Variables of the fixed-size dimensions and of other ones
+  const size_t dims[] = { 3, 6, 2, 15, 9 };
+  GaussianFactorGraph graph;
+  for (Key j = 0; j < 5; ++j) {
+    const size_t d = dims[j];
+    graph += JacobianFactor(j, Matrix(Matrix::Identity(d, d) + Matrix::Constant(d, d, 0.1 * (j + 1))),
+        Vector::Zero(d), noiseModel::Unit::Create(d));
+  }
+  graph += JacobianFactor(0, Matrix::Constant(3, 3, 0.2), 1, Matrix::Constant(3, 6, 0.3),
+      Vector::Zero(3), noiseModel::Unit::Create(3));
+  KeyInfo keyInfo(graph);
+  std::map<Key,Vector> lambda;
+
+  // The preconditioner inverts the block diagonal of the Hessian
+  const Matrix H = graph.hessian(keyInfo.ordering()).first;
+  Matrix D = Matrix::Zero(H.rows(), H.cols());
+  for (size_t j = 0, offset = 0; j < 5; offset += dims[j++])
+    D.block(offset, offset, dims[j], dims[j]) = H.block(offset, offset, dims[j], dims[j]);
+  const Vector b = Vector::LinSpaced(H.rows(), 1.0, 2.0);
+  BlockJacobiPreconditioner preconditioner;
+  preconditioner.build(graph, keyInfo, lambda);
+  Vector actual(b.size());
+  preconditioner.fullSolve(b, actual);
+  EXPECT(assert_equal(Vector(D.llt().solve(b)), actual, 1e-9));
+
+  // The split form uses the lower triangular factors of the blocks
+  Vector y(b.size());
+  preconditioner.solve(b, y);
+  EXPECT(assert_equal(Vector(D.llt().matrixL().solve(b)), y, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(Preconditioner, incompleteCholesky) {
+  GaussianFactorGraph planar;
+  VectorValues xtrue;
+  boost::tie(planar, xtrue) = example::planarGraph(4);
+  KeyInfo keyInfo(planar);
+  std::map<Key,Vector> lambda;
+  const Matrix H = planar.hessian(keyInfo.ordering()).first;
+  const Vector b = Vector::LinSpaced(H.rows(), 1.0, 2.0);
+
+  // On a chain, IC0 is the exact factorization
+  GaussianFactorGraph chain = example::createSmoother(5);
+  KeyInfo chainInfo(chain);
+  const Matrix chainH = chain.hessian(chainInfo.ordering()).first;
+  const Vector chainb = Vector::LinSpaced(chainH.rows(), 1.0, 2.0);
+  BlockIncompleteCholeskyPreconditioner ic0;
+  ic0.build(chain, chainInfo, lambda);
+  Vector actual(chainb.size());
+  ic0.fullSolve(chainb, actual);
+  EXPECT(assert_equal(Vector(chainH.llt().solve(chainb)), actual, 1e-6));
+
+  // On a grid, IC0 drops the fill-in, while enough fill gives the exact factorization again
+  ic0.build(planar, keyInfo, lambda);
+  LONGS_EQUAL(24, ic0.nrOffDiagonalBlocks());
+  BlockIncompleteCholeskyPreconditioner ic1(BlockIncompleteCholeskyPreconditionerParameters(1));
+  ic1.build(planar, keyInfo, lambda);
+  CHECK(ic1.nrOffDiagonalBlocks() > ic0.nrOffDiagonalBlocks());
+  BlockIncompleteCholeskyPreconditioner full(BlockIncompleteCholeskyPreconditionerParameters(16));
+  full.build(planar, keyInfo, lambda);
+  actual.resize(b.size());
+  full.fullSolve(b, actual);
+  EXPECT(assert_equal(Vector(H.llt().solve(b)), actual, 1e-6));
+
+  // The split form is consistent with the full solve
+  Vector y(b.size()), expected(b.size());
+  ic1.solve(b, y);
+  ic1.transposeSolve(y, expected);
+  ic1.fullSolve(b, actual);
+  EXPECT(assert_equal(expected, actual, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(Preconditioner, multigrid) {
+  GaussianFactorGraph planar;
+  VectorValues xtrue;
+  boost::tie(planar, xtrue) = example::planarGraph(10);
+  KeyInfo keyInfo(planar);
+  std::map<Key,Vector> lambda;
+
+  AlgebraicMultigridPreconditionerParameters parameters;
+  parameters.coarsestDim_ = 20;
+  AlgebraicMultigridPreconditioner amg(parameters);
+  amg.build(planar, keyInfo, lambda);
+  CHECK(amg.nrLevels() > 2);
+  LONGS_EQUAL(200, amg.dim(0));
+  CHECK(amg.dim(amg.nrLevels() - 1) <= 20);
+  Vector x(200);
+  CHECK_EXCEPTION(amg.solve(Vector::Zero(200), x), std::logic_error);
+
+  // The V-cycle is symmetric
+  const Vector u = Vector::LinSpaced(200, 1.0, 2.0), v = Vector::LinSpaced(200, -1.0, 3.0);
+  Vector Mu(200), Mv(200);
+  amg.fullSolve(u, Mu);
+  amg.fullSolve(v, Mv);
+  DOUBLES_EQUAL(v.dot(Mu), u.dot(Mv), 1e-6 * std::abs(v.dot(Mu)));
+
+  // PCG with the multigrid preconditioner solves the system
+  PCGSolverParameters::shared_ptr pcg = boost::make_shared<PCGSolverParameters>();
+  pcg->setMaxIterations(100);
+  pcg->setEpsilon_abs(0.0);
+  pcg->setEpsilon_rel(1e-10);
+  pcg->preconditioner_ = boost::make_shared<AlgebraicMultigridPreconditionerParameters>(parameters);
+  VectorValues deltaPCG = PCGSolver(*pcg).optimize(planar);
+  EXPECT(assert_equal(planar.optimize(), deltaPCG, 1e-5));
 }
 
 /* ************************************************************************* */
@@ -220,6 +220,75 @@ TEST( SubgraphPreconditioner, conjugateGradients )
 
 #endif
 
+#include <tests/smallExample.h>
+#include <gtsam/linear/SubgraphPreconditioner.h>
+#include <gtsam/linear/SubgraphSolver.h>
+#include <gtsam/linear/PCGSolver.h>
+
+#include <boost/tuple/tuple.hpp>
+
+/* ************************************************************************* */
+TEST( SubgraphPreconditioner, boruvkaSpanningForest )
+{
+  using namespace gtsam;
+  const size_t N = 4, nrHorizontal = N * (N - 1);
+  GaussianFactorGraph Ab;
+  VectorValues xtrue;
+  boost::tie(Ab, xtrue) = example::planarGraph(N);
+
+  // With equal weights, the forest is the greedy one: all horizontal edges and the first column
+  std::vector<size_t> expected;
+  for (size_t i = 1; i < N * N; ++i)
+    expected.push_back(i);
+  std::vector<size_t> actual = boruvkaSpanningForest(Ab, std::vector<double>(Ab.size(), 1.0));
+  EXPECT(expected == actual);
+
+  // Heavier vertical edges: all vertical edges, and the bottom row to connect the columns
+  std::vector<double> weights(Ab.size(), 1.0);
+  for (size_t i = 1 + nrHorizontal; i < Ab.size(); ++i)
+    weights[i] = 2.0;
+  expected.clear();
+  for (size_t x = 1; x < N; ++x)
+    expected.push_back(1 + (x - 1) * N);
+  for (size_t i = 1 + nrHorizontal; i < Ab.size(); ++i)
+    expected.push_back(i);
+  actual = boruvkaSpanningForest(Ab, weights);
+  EXPECT(expected == actual);
+
+  // Eliminating the subgraph, which is a tree plus the prior, gives the same solution
+  GaussianFactorGraph tree;
+  tree.push_back(Ab[0]);
+  BOOST_FOREACH(const size_t i, actual)
+    tree.push_back(Ab[i]);
+  EXPECT(assert_equal(tree.eliminateSequential()->optimize(),
+      eliminateFactorSubgraph(tree)->optimize(), 1e-9));
+  EXPECT(assert_equal(tree.eliminateSequential(example::planarOrdering(N), EliminateQR)->optimize(),
+      eliminateFactorSubgraph(tree, example::planarOrdering(N), EliminateQR)->optimize(), 1e-9));
+
+  // Subgraph preconditioned CG with a Boruvka spanning tree
+  SubgraphPreconditionerParameters::shared_ptr preconditioner =
+      boost::make_shared<SubgraphPreconditionerParameters>();
+  preconditioner->builderParams_.skeleton_ = SubgraphBuilderParameters::BORUVKA;
+  preconditioner->builderParams_.skeletonWeight_ = SubgraphBuilderParameters::LHS_FNORM;
+  preconditioner->builderParams_.complexity_ = 0.0;
+  PCGSolverParameters parameters;
+  parameters.preconditioner_ = preconditioner;
+  parameters.epsilon_rel_ = parameters.epsilon_abs_ = 1e-12;
+  EXPECT(assert_equal(xtrue, PCGSolver(parameters).optimize(Ab), 1e-5));
+}
+
+/* ************************************************************************* */
+TEST( SubgraphSolver, setupTime )
+{
+  using namespace gtsam;
+  GaussianFactorGraph Ab;
+  VectorValues xtrue;
+  boost::tie(Ab, xtrue) = example::planarGraph(3);
+  SubgraphSolver solver(Ab, SubgraphSolverParameters(), example::planarOrdering(3));
+  EXPECT(solver.setupTime() >= 0.0);
+  EXPECT(assert_equal(xtrue, solver.optimize(), 1e-5));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
@@ -0,0 +1,263 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    Benchmark.h
+ * @brief   Small benchmark harness: warmup, repetitions, statistics and JSON output
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/timing.h>
+
+#include <boost/foreach.hpp>
+#include <boost/function.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace gtsam {
+namespace benchmark {
+
+/// Wall-clock stopwatch, using the same boost timers as gttic/gttoc when available
+class Stopwatch {
+#ifdef GTSAM_USING_NEW_BOOST_TIMERS
+  boost::timer::cpu_timer timer_;
+public:
+  void start() { timer_.start(); }
+  double seconds() const { return 1e-9 * double(timer_.elapsed().wall); }
+#else
+  std::clock_t start_;
+public:
+  Stopwatch() : start_(std::clock()) {}
+  void start() { start_ = std::clock(); }
+  double seconds() const { return double(std::clock() - start_) / CLOCKS_PER_SEC; }
+#endif
+};
+
+/// Summary statistics of a set of timings, in seconds
+struct Stats {
+  double min, max, mean, median, stddev;
+
+  static Stats Compute(std::vector<double> samples) {
+    Stats s = { 0, 0, 0, 0, 0 };
+    const size_t n = samples.size();
+    if (n == 0) return s;
+    std::sort(samples.begin(), samples.end());
+    s.min = samples.front();
+    s.max = samples.back();
+    BOOST_FOREACH(double t, samples) s.mean += t;
+    s.mean /= n;
+    s.median = (n % 2) ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+    if (n > 1) {
+      BOOST_FOREACH(double t, samples) s.stddev += (t - s.mean) * (t - s.mean);
+      s.stddev = std::sqrt(s.stddev / (n - 1));
+    }
+    return s;
+  }
+};
+
+/// Options shared by all benchmarks in a suite, see Suite::parse
+struct Options {
+  size_t warmup;         ///< untimed runs before measuring
+  size_t repetitions;    ///< timed runs
+  std::string filter;    ///< only run benchmarks whose name contains this string
+  std::string jsonFile;  ///< if not empty, write results to this file
+  std::vector<std::pair<std::string, std::string> > datasets; ///< --name file overrides
+
+  Options() : warmup(1), repetitions(5) {}
+
+  /// Dataset override given on the command line, or defaultName otherwise
+  std::string dataset(const std::string& name, const std::string& defaultName) const {
+    for (size_t i = 0; i < datasets.size(); i++)
+      if (datasets[i].first == name) return datasets[i].second;
+    return defaultName;
+  }
+};
+
+/**
+ * A benchmark is a setup function, run once and not timed, and a function that is
+ * timed for every repetition. The setup typically loads a dataset and builds graphs.
+ */
+struct Benchmark {
+  typedef boost::function<void()> Function;
+  std::string name, dataset;
+  Function setup, run;
+};
+
+/// Result of running one benchmark
+struct Result {
+  std::string name, dataset;
+  std::vector<double> times;
+  Stats stats;
+  std::string error; ///< non-empty if the benchmark threw
+};
+
+/**
+ * A suite of benchmarks sharing command-line options. Usage:
+ *   Suite suite("timeBenchmarks");
+ *   suite.parse(argc, argv);
+ *   suite.add("manhattan/linearize", file, setupFunction, runFunction);
+ *   return suite.run();
+ */
+class Suite {
+  std::string program_;
+  Options options_;
+  std::vector<Benchmark> benchmarks_;
+  std::vector<Result> results_;
+
+public:
+  explicit Suite(const std::string& program) : program_(program) {}
+
+  const Options& options() const { return options_; }
+
+  /// Parse --warmup N, --repetitions N, --filter S, --json FILE and --<dataset> FILE
+  void parse(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+      std::string arg = argv[i];
+      if (arg == "--help" || arg == "-h") usage(0);
+      if (arg.compare(0, 2, "--") != 0 || i + 1 >= argc) usage(1);
+      const std::string value = argv[++i];
+      if (arg == "--warmup")
+        options_.warmup = std::strtoul(value.c_str(), 0, 10);
+      else if (arg == "--repetitions")
+        options_.repetitions = std::max<size_t>(1, std::strtoul(value.c_str(), 0, 10));
+      else if (arg == "--filter")
+        options_.filter = value;
+      else if (arg == "--json")
+        options_.jsonFile = value;
+      else
+        options_.datasets.push_back(std::make_pair(arg.substr(2), value));
+    }
+  }
+
+  /// Register a benchmark; it is skipped if it does not match --filter
+  void add(const std::string& name, const std::string& dataset,
+      const Benchmark::Function& setup, const Benchmark::Function& run) {
+    if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos)
+      return;
+    Benchmark b;
+    b.name = name;
+    b.dataset = dataset;
+    b.setup = setup;
+    b.run = run;
+    benchmarks_.push_back(b);
+  }
+
+  /// Run all benchmarks, print a table, and write JSON if requested. Returns exit code.
+  int run() {
+    std::cout << std::left << std::setw(32) << "benchmark" << std::right
+        << std::setw(12) << "min" << std::setw(12) << "median" << std::setw(12)
+        << "mean" << std::setw(12) << "stddev" << "  (seconds, " << options_.repetitions
+        << " repetitions)" << std::endl;
+    int status = 0;
+    BOOST_FOREACH(const Benchmark& b, benchmarks_) {
+      Result r = runOne(b);
+      if (r.error.empty())
+        std::cout << std::left << std::setw(32) << r.name << std::right
+            << std::setw(12) << r.stats.min << std::setw(12) << r.stats.median
+            << std::setw(12) << r.stats.mean << std::setw(12) << r.stats.stddev
+            << std::endl;
+      else {
+        std::cout << std::left << std::setw(32) << r.name << "  FAILED: " << r.error
+            << std::endl;
+        status = 1;
+      }
+      results_.push_back(r);
+    }
+    if (!options_.jsonFile.empty()) {
+      std::ofstream os(options_.jsonFile.c_str());
+      if (!os) {
+        std::cerr << "Could not write " << options_.jsonFile << std::endl;
+        return 1;
+      }
+      writeJSON(os);
+    }
+    return status;
+  }
+
+  /// Write results as JSON, one object per benchmark
+  void writeJSON(std::ostream& os) const {
+    os << "{\n  \"program\": \"" << escape(program_) << "\",\n"
+        << "  \"warmup\": " << options_.warmup << ",\n"
+        << "  \"repetitions\": " << options_.repetitions << ",\n"
+        << "  \"benchmarks\": [";
+    os << std::setprecision(9);
+    for (size_t k = 0; k < results_.size(); k++) {
+      const Result& r = results_[k];
+      os << (k ? "," : "") << "\n    {\"name\": \"" << escape(r.name)
+          << "\", \"dataset\": \"" << escape(r.dataset) << "\"";
+      if (!r.error.empty()) {
+        os << ", \"error\": \"" << escape(r.error) << "\"}";
+        continue;
+      }
+      os << ", \"min\": " << r.stats.min << ", \"max\": " << r.stats.max
+          << ", \"mean\": " << r.stats.mean << ", \"median\": " << r.stats.median
+          << ", \"stddev\": " << r.stats.stddev << ", \"times\": [";
+      for (size_t i = 0; i < r.times.size(); i++)
+        os << (i ? ", " : "") << r.times[i];
+      os << "]}";
+    }
+    os << "\n  ]\n}\n";
+  }
+
+private:
+  Result runOne(const Benchmark& b) const {
+    Result r;
+    r.name = b.name;
+    r.dataset = b.dataset;
+    try {
+      if (b.setup) b.setup();
+      for (size_t i = 0; i < options_.warmup; i++)
+        b.run();
+      Stopwatch watch;
+      for (size_t i = 0; i < options_.repetitions; i++) {
+        watch.start();
+        b.run();
+        r.times.push_back(watch.seconds());
+      }
+      r.stats = Stats::Compute(r.times);
+    } catch (std::exception& e) {
+      r.error = e.what();
+    }
+    return r;
+  }
+
+  static std::string escape(const std::string& s) {
+    std::string out;
+    BOOST_FOREACH(char c, s) {
+      if (c == '"' || c == '\\') out += '\\';
+      if (c == '\n') out += "\\n";
+      else out += c;
+    }
+    return out;
+  }
+
+  void usage(int status) const {
+    std::cout << "Usage: " << program_ << " [--warmup N] [--repetitions N]"
+        " [--filter substring] [--json file] [--<dataset> file]..." << std::endl;
+    std::exit(status);
+  }
+};
+
+} // namespace benchmark
+} // namespace gtsam
@@ -0,0 +1,60 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeAHRSIntegration.cpp
+ * @brief   time gyroscope preintegration, sample by sample and batched, in samples per second
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/navigation/AHRSFactor.h>
+
+#include <time.h>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+int main() {
+  const size_t n = 1000, repeats = 2000;
+  const double dt = 0.001;
+
+  boost::shared_ptr<PreintegratedAhrsMeasurements::Params> p =
+      boost::make_shared<PreintegratedAhrsMeasurements::Params>();
+  p->gyroscopeCovariance = 1e-4 * I_3x3;
+  p->body_P_sensor = Pose3(Rot3::ypr(0.0, 0.0, M_PI), Point3());
+  const Vector3 biasHat(0.01, -0.02, 0.005);
+
+  Matrix omegas(n, 3);
+  for (size_t k = 0; k < n; ++k)
+    omegas.row(k) << 0.5 * sin(0.01 * k), 0.2, -0.3 * cos(0.02 * k);
+
+  PreintegratedAhrsMeasurements pim(p, biasHat);
+  clock_t start = clock();
+  for (size_t r = 0; r < repeats; ++r) {
+    pim.resetIntegration();
+    for (size_t k = 0; k < n; ++k)
+      pim.integrateMeasurement(omegas.row(k).transpose(), dt);
+  }
+  double seconds = double(clock() - start) / CLOCKS_PER_SEC;
+  cout << "integrateMeasurement:  " << n * repeats / seconds << " samples/s" << endl;
+
+  start = clock();
+  for (size_t r = 0; r < repeats; ++r) {
+    pim.resetIntegration();
+    pim.integrateMeasurements(omegas, dt);
+  }
+  seconds = double(clock() - start) / CLOCKS_PER_SEC;
+  cout << "integrateMeasurements: " << n * repeats / seconds << " samples/s" << endl;
+
+  return 0;
+}
@@ -0,0 +1,218 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeBenchmarks.cpp
+ * @brief   Benchmark suite over the example datasets, with statistics and JSON output
+ * @date    Oct 15, 2026
+ *
+ * Usage: timeBenchmarks [--warmup N] [--repetitions N] [--filter substring]
+ *                       [--json file] [--manhattan file] [--sphere file] [--bal file]
+ *
+ * Datasets are looked up as given, and otherwise with findExampleDataFile. The BAL
+ * benchmarks are skipped when no BAL file is available. The `benchmark` target runs
+ * this suite and writes gtsam_benchmarks.json in the build directory.
+ */
+
+#include "Benchmark.h"
+
+#include <gtsam/slam/dataset.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/GeneralSFMFactor.h>
+#include <gtsam/geometry/Cal3Bundler.h>
+#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/nonlinear/DoglegOptimizer.h>
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam::benchmark;
+
+// Use the file as given if it exists, otherwise search the example data directories
+static string resolve(const string& name) {
+  if (ifstream(name.c_str())) return name;
+  return findExampleDataFile(name);
+}
+
+/* ************************************************************************* */
+// Pose graph benchmarks, for both the 2D Manhattan and 3D sphere datasets
+template <class POSE>
+struct PoseGraphBenchmark {
+  string file;
+  bool is3D;
+  NonlinearFactorGraph graph;
+  Values initial;
+  vector<NonlinearFactorGraph> stepFactors; // factors grouped by their highest key
+  double result; // keeps the compiler from discarding the timed work
+
+  PoseGraphBenchmark(const string& file, bool is3D) :
+      file(file), is3D(is3D), result(0) {}
+
+  void load() {
+    GraphAndValues data = is3D ? load3D(file) : load2D(file);
+    graph = *data.first;
+    initial = *data.second;
+    const Key first = initial.keys().front();
+    graph.push_back(PriorFactor<POSE>(first, initial.at<POSE>(first),
+        noiseModel::Unit::Create(traits<POSE>::dimension)));
+
+    // Group factors by the last pose they involve, for incremental playback
+    stepFactors.clear();
+    stepFactors.resize(initial.size());
+    BOOST_FOREACH(const NonlinearFactor::shared_ptr& factor, graph) {
+      if (!factor) continue;
+      const Key last = *max_element(factor->begin(), factor->end());
+      if (last < stepFactors.size()) stepFactors[last].push_back(factor);
+    }
+  }
+
+  void linearize() {
+    result = graph.linearize(initial)->size();
+  }
+
+  void batch() {
+    LevenbergMarquardtOptimizer optimizer(graph, initial);
+    result = graph.error(optimizer.optimize());
+  }
+
+  void batchDogleg() {
+    DoglegOptimizer optimizer(graph, initial);
+    result = graph.error(optimizer.optimize());
+  }
+
+  void incremental() {
+    ISAM2 isam2;
+    for (size_t step = 0; step < stepFactors.size(); step++) {
+      Values newValues;
+      if (initial.exists(step))
+        newValues.insert(step, initial.at(step));
+      isam2.update(stepFactors[step], newValues);
+    }
+    result = graph.error(isam2.calculateEstimate());
+  }
+};
+
+/* ************************************************************************* */
+// Bundle adjustment benchmarks on a BAL file, as in timeSFMBAL
+struct BALBenchmark {
+  typedef PinholeCamera<Cal3Bundler> Camera;
+  typedef GeneralSFMFactor<Camera, Point3> SfmFactor;
+
+  string file;
+  NonlinearFactorGraph graph;
+  Values initial;
+  Ordering ordering;
+  double result; // keeps the compiler from discarding the timed work
+
+  explicit BALBenchmark(const string& file) : file(file), result(0) {}
+
+  void load() {
+    using symbol_shorthand::C;
+    using symbol_shorthand::P;
+    SfM_data db;
+    if (!readBAL(file, db, true))
+      throw runtime_error("Could not read BAL file " + file);
+
+    SharedNoiseModel model = noiseModel::Unit::Create(2);
+    graph = NonlinearFactorGraph();
+    initial.clear();
+    ordering = Ordering();
+    for (size_t j = 0; j < db.number_tracks(); j++) {
+      for (size_t k = 0; k < db.number_measurements(j); k++) {
+        const SfM_Measurement m = db.measurement(j, k);
+        graph.push_back(SfmFactor(m.second, model, C(m.first), P(j)));
+      }
+      initial.insert(P(j), db.tracks[j].p);
+      ordering.push_back(P(j));
+    }
+    for (size_t i = 0; i < db.number_cameras(); i++) {
+      initial.insert(C(i), db.cameras[i]);
+      ordering.push_back(C(i));
+    }
+  }
+
+  void linearize() {
+    result = graph.linearize(initial)->size();
+  }
+
+  void batch() {
+    LevenbergMarquardtParams params;
+    LevenbergMarquardtParams::SetCeresDefaults(&params);
+    params.setOrdering(ordering);
+    LevenbergMarquardtOptimizer optimizer(graph, initial, params);
+    result = graph.error(optimizer.optimize());
+  }
+
+  void batchDogleg() {
+    DoglegParams params;
+    params.setOrdering(ordering);
+    DoglegOptimizer optimizer(graph, initial, params);
+    result = graph.error(optimizer.optimize());
+  }
+};
+
+/* ************************************************************************* */
+template <class BENCHMARK>
+static void addBatch(Suite& suite, const string& prefix,
+    const boost::shared_ptr<BENCHMARK>& b) {
+  const Benchmark::Function load = boost::bind(&BENCHMARK::load, b);
+  // "load" times parsing; the others load once, untimed, in their setup
+  suite.add(prefix + "/load", b->file, Benchmark::Function(), load);
+  suite.add(prefix + "/linearize", b->file, load, boost::bind(&BENCHMARK::linearize, b));
+  suite.add(prefix + "/batchLM", b->file, load, boost::bind(&BENCHMARK::batch, b));
+  // Same problem with Dogleg, to compare the two trust region strategies
+  suite.add(prefix + "/batchDogleg", b->file, load, boost::bind(&BENCHMARK::batchDogleg, b));
+}
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  Suite suite("timeBenchmarks");
+  suite.parse(argc, argv);
+  const Options& options = suite.options();
+
+  try {
+    typedef PoseGraphBenchmark<Pose2> Manhattan;
+    boost::shared_ptr<Manhattan> manhattan(new Manhattan(
+        resolve(options.dataset("manhattan", "w10000")), false));
+    addBatch(suite, "manhattan", manhattan);
+    suite.add("manhattan/iSAM2", manhattan->file,
+        boost::bind(&Manhattan::load, manhattan),
+        boost::bind(&Manhattan::incremental, manhattan));
+
+    typedef PoseGraphBenchmark<Pose3> Sphere;
+    boost::shared_ptr<Sphere> sphere(new Sphere(
+        resolve(options.dataset("sphere", "sphere_smallnoise")), true));
+    addBatch(suite, "sphere", sphere);
+  } catch (std::exception& e) {
+    cerr << e.what() << endl;
+    return 1;
+  }
+
+  try {
+    boost::shared_ptr<BALBenchmark> bal(new BALBenchmark(
+        resolve(options.dataset("bal", "dubrovnik-16-22106-pre"))));
+    addBatch(suite, "bal", bal);
+  } catch (std::invalid_argument& e) {
+    cout << "Skipping BAL benchmarks: no BAL file found, use --bal file" << endl;
+  }
+
+  return suite.run();
+}
@@ -0,0 +1,90 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeImuFactor.cpp
+ * @brief   time linearizing a window of IMU factors, as relinearized by a VIO ISAM2 update
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/navigation/ImuFactor.h>
+#include <gtsam/navigation/CombinedImuFactor.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/timing.h>
+
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+using symbol_shorthand::V;
+using symbol_shorthand::B;
+
+/* ************************************************************************* */
+#define TEST(TITLE,STATEMENT) \
+  gttic_(TITLE); \
+  for(int i = 0; i < n; i++) \
+  STATEMENT; \
+  gttoc_(TITLE);
+
+int main()
+{
+  const int n = 10000, window = 30;
+  cout << "NOTE:  Times are reported for " << n << " linearizations of " << window
+      << " factors" << endl;
+
+  // A window of IMU factors, each summarizing 100 measurements at 200Hz
+  boost::shared_ptr<PreintegratedCombinedMeasurements::Params> p =
+      PreintegratedCombinedMeasurements::Params::MakeSharedU();
+  p->accelerometerCovariance = 1e-3 * I_3x3;
+  p->gyroscopeCovariance = 1e-4 * I_3x3;
+  p->integrationCovariance = 1e-8 * I_3x3;
+  p->biasAccOmegaInit = 1e-5 * I_6x6;
+  const imuBias::ConstantBias bias(Vector3(0.01, -0.02, 0.03), Vector3(1e-3, 2e-3, -1e-3));
+
+  vector<ImuFactor::shared_ptr> imuFactors;
+  vector<CombinedImuFactor::shared_ptr> combinedFactors;
+  Values values;
+  for (int k = 0; k < window; ++k) {
+    PreintegratedImuMeasurements pim(p, bias);
+    PreintegratedCombinedMeasurements combined(p, bias);
+    for (int i = 0; i < 100; ++i) {
+      const Vector3 acc(0.1 * sin(0.01 * i), 0.2, 9.81), omega(0.01, 0.02 * cos(0.01 * i), 0.1);
+      pim.integrateMeasurement(acc, omega, 0.005);
+      combined.integrateMeasurement(acc, omega, 0.005);
+    }
+    imuFactors.push_back(boost::make_shared<ImuFactor>(X(k), V(k), X(k + 1), V(k + 1), B(k),
+        pim));
+    combinedFactors.push_back(boost::make_shared<CombinedImuFactor>(X(k), V(k), X(k + 1),
+        V(k + 1), B(k), B(k + 1), combined));
+  }
+  for (int k = 0; k <= window; ++k) {
+    values.insert(X(k), Pose3(Rot3::Rz(0.05 * k), Point3(0.5 * k, 0.1 * k, 0.0)));
+    values.insert(V(k), Vector3(1.0, 0.2, 0.0));
+    values.insert(B(k), bias);
+  }
+
+  // Generic path through evaluateError and dynamic matrices, and the fixed-size one
+  TEST(ImuFactor_generic, for (int k = 0; k < window; ++k)
+      imuFactors[k]->NoiseModelFactor::linearize(values))
+  TEST(ImuFactor_fixed, for (int k = 0; k < window; ++k)
+      imuFactors[k]->linearize(values))
+  TEST(CombinedImuFactor_generic, for (int k = 0; k < window; ++k)
+      combinedFactors[k]->NoiseModelFactor::linearize(values))
+  TEST(CombinedImuFactor_fixed, for (int k = 0; k < window; ++k)
+      combinedFactors[k]->linearize(values))
+
+  // Print timings
+  tictoc_print_();
+
+  return 0;
+}
@@ -36,7 +36,7 @@ int main(int argc, char *argv[]) {
   // read graph
   Values::shared_ptr solution;
   NonlinearFactorGraph::shared_ptr g;
-  string inputFile = findExampleDataFile("w10000");
+  string inputFile = argc > 1 ? argv[1] : findExampleDataFile("w10000");
   SharedDiagonal model = noiseModel::Diagonal::Sigmas((Vector(3) << 0.05, 0.05, 5.0 * M_PI / 180.0).finished());
   boost::tie(g, solution) = load2D(inputFile, model);
 
@@ -58,10 +58,18 @@ int main(int argc, char *argv[]) {
     {
       gttic_(lago);
 
+      gttic_(orientations);
+      VectorValues orientations = lago::initializeOrientations(*g);
+      gttoc_(orientations);
+
       gttic_(init);
       Values lagoInitial = lago::initialize(*g);
       gttoc_(init);
 
+      gttic_(init_spanningTree);
+      Values lagoInitialTree = lago::initialize(*g, false);
+      gttoc_(init_spanningTree);
+
       gttic_(refine);
       GaussNewtonOptimizer optimizer(*g, lagoInitial);
       Values result = optimizer.optimize();
@@ -19,6 +19,7 @@
 
 #include <gtsam/base/timing.h>
 #include <gtsam/geometry/Pose2.h>
+#include <gtsam/slam/BetweenFactor.h>
 
 using namespace std;
 using namespace gtsam;
@@ -152,6 +153,15 @@ int main()
   TEST(Pose2BetweenFactorEvaluateErrorOptimizedBetween, Pose2BetweenFactorEvaluateErrorOptimizedBetween(X3, X, X2, H1, H2));
   TEST(Pose2BetweenFactorEvaluateErrorOptimizedBetweenFixed, Pose2BetweenFactorEvaluateErrorOptimizedBetweenFixed(X3, X, X2, H1f, H2f));
 
+  // Linearize through NoiseModelFactor2 and through the fixed-size specialization
+  typedef NoiseModelFactor2<Pose2, Pose2> NoiseModelFactor22;
+  BetweenFactor<Pose2> factor(0, 1, X3, noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.1, 0.05)));
+  Values values;
+  values.insert(0, X);
+  values.insert(1, X2);
+  TEST(Pose2BetweenFactorLinearizeDefault, factor.NoiseModelFactor22::linearize(values));
+  TEST(Pose2BetweenFactorLinearizeFixed, factor.linearize(values));
+
   // Print timings
   tictoc_print_();
 
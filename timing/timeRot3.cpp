@@ -51,5 +51,42 @@ int main()
   TEST("Slow rotation matrix",Rot3::Rz(z)*Rot3::Ry(y)*Rot3::Rx(x))
   TEST("Fast Rotation matrix", Rot3::RzRyRx(x,y,z))
 
+  // Operations that differ between the matrix and quaternion representations
+#ifdef GTSAM_USE_QUATERNIONS
+  cout << endl << "Rot3 is stored as a quaternion (GTSAM_USE_QUATERNIONS)" << endl;
+#else
+  cout << endl << "Rot3 is stored as a rotation matrix" << endl;
+#endif
+  Point3 p(1.0, -2.0, 3.0);
+  Matrix3 H1, H2;
+  TEST("rotate", R.rotate(p))
+  TEST("rotate with derivatives", R.rotate(p, H1, H2))
+  TEST("unrotate", R.unrotate(p))
+  TEST("unrotate with derivatives", R.unrotate(p, H1, H2))
+  TEST("compose", R.compose(R2))
+  TEST("compose with derivatives", R.compose(R2, H1, H2))
+  TEST("between", R.between(R2))
+  TEST("between with derivatives", R.between(R2, H1, H2))
+  TEST("inverse", R.inverse())
+  TEST("matrix", R.matrix())
+  TEST("Logmap with derivative", Rot3::Logmap(R2, H1))
+
+  // The same kernels in both representations, regardless of the one Rot3 uses.
+  // Each result feeds the next iteration, so the loops are not optimized away.
+  const Matrix3 M = R.matrix();
+  const Quaternion q = R.toQuaternion();
+  Vector3 wr = p.vector();
+  Matrix3 Mr = R2.matrix();
+  Quaternion qr = R2.toQuaternion();
+  TEST("Matrix3 * Vector3", wr = M * wr)
+  TEST("Quaternion * Vector3", wr = q * wr)
+  TEST("Matrix3 * Matrix3", Mr = M * Mr)
+  TEST("Quaternion * Quaternion", qr = q * qr)
+  TEST("Matrix3 transpose * Matrix3", Mr = M.transpose() * Mr)
+  TEST("Quaternion conjugate * Quaternion", qr = q.conjugate() * qr)
+  TEST("SO3::Logmap", SO3::Logmap(M))
+  TEST("Quaternion Logmap", traits<Quaternion>::Logmap(q))
+  cout << endl << "(checksum " << wr.sum() + Mr.sum() + qr.w() << ")" << endl;
+
   return 0;
 }
@@ -47,10 +47,11 @@ SfM_data preamble(int argc, char* argv[]) {
       throw runtime_error("Usage: timeSFMBALxxx [--colamd] [BALfile]");
   }
 
-  // Load BAL file
+  // Load BAL file, keeping the measurements in one flat table
   SfM_data db;
   string defaultFilename = findExampleDataFile("dubrovnik-16-22106-pre");
-  bool success = readBAL(argc > 1 ? argv[argc - 1] : defaultFilename, db);
+  const bool compact = true;
+  bool success = readBAL(argc > 1 ? argv[argc - 1] : defaultFilename, db, compact);
   if (!success) throw runtime_error("Could not access file!");
   return db;
 }
@@ -35,7 +35,8 @@ int main(int argc, char* argv[]) {
   // Build graph using conventional GeneralSFMFactor
   NonlinearFactorGraph graph;
   for (size_t j = 0; j < db.number_tracks(); j++) {
-    BOOST_FOREACH (const SfM_Measurement& m, db.tracks[j].measurements) {
+    for (size_t k = 0; k < db.number_measurements(j); k++) {
+      const SfM_Measurement m = db.measurement(j, k);
       size_t i = m.first;
       Point2 z = m.second;
       Pose3_ navTcam_(C(i));
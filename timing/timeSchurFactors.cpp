@@ -13,6 +13,8 @@
 #include <gtsam/slam/RegularImplicitSchurFactor.h>
 #include <gtsam/geometry/Cal3Bundler.h>
 #include <gtsam/geometry/PinholePose.h>
+#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
 
 #include <boost/assign/list_of.hpp>
 #include <boost/assign/std/vector.hpp>
@@ -120,6 +122,55 @@ void timeAll(size_t m, size_t N) {
 
 } // timeAll
 
+/*************************************************************************************/
+// Rate of the Hessian-vector products that dominate a PCG iteration, for a graph with one
+// implicit Schur factor per point, each seen by m of the nrCameras cameras
+template<typename CAMERA>
+void timePCG(size_t nrCameras, size_t nrPoints, size_t m, size_t N) {
+
+  static const int D = CAMERA::dimension;
+  typedef Eigen::Matrix<double, 2, D> Matrix2D;
+  GaussianFactorGraph graph;
+  for (size_t j = 0; j < nrPoints; j++) {
+    FastVector<Key> keys;
+    vector<Matrix2D> Fblocks;
+    Matrix E(2 * m, 3);
+    for (size_t i = 0; i < m; i++) {
+      keys.push_back((j + 7 * i) % nrCameras);
+      Fblocks.push_back((i + 1) * Matrix::Ones(2, D));
+      E.block<2, 3>(2 * i, 0) << 1, 0, i, 0, 1, j % 5;
+    }
+    Matrix P = (E.transpose() * E).inverse();
+    graph.push_back(boost::make_shared<RegularImplicitSchurFactor<CAMERA> >(keys, Fblocks, E, P,
+        gtsam::repeat(2 * m, 1)));
+  }
+
+  VectorValues x;
+  for (size_t i = 0; i < nrCameras; i++)
+    x.insert(i, gtsam::repeat(D, 0.1 * i));
+  Vector xdata = x.vector(), ydata = zero(nrCameras * D);
+
+  gttic_(PCGVectorValues);
+  for (size_t t = 0; t < N; t++) {
+    VectorValues y;
+    graph.multiplyHessianAdd(1.0, x, y);
+  }
+  gttoc_(PCGVectorValues);
+  gttic_(PCGRaw);
+  for (size_t t = 0; t < N; t++) {
+    BOOST_FOREACH(const GaussianFactor::shared_ptr& f, graph)
+      boost::static_pointer_cast<RegularImplicitSchurFactor<CAMERA> >(f)->multiplyHessianAdd(
+          1.0, xdata.data(), ydata.data());
+  }
+  gttoc_(PCGRaw);
+
+  tictoc_getNode(vv, PCGVectorValues)
+  tictoc_getNode(raw, PCGRaw)
+  cout << nrPoints << " points, " << nrCameras << " cameras, track length " << m << ": "
+      << N / vv->secs() << " iterations/s with VectorValues, " << N / raw->secs()
+      << " iterations/s raw (checksum " << ydata.sum() << ")" << endl;
+}
+
 /*************************************************************************************/
 int main(void) {
 #ifdef SLOW
@@ -152,6 +203,10 @@ int main(void) {
   // loop over number of images
   BOOST_FOREACH(size_t m,ms)
     timeAll<PinholePose<Cal3Bundler> >(m, NUM_ITERATIONS);
+
+  // PCG iteration rate, for 6-dof and 9-dof cameras
+  timePCG<PinholePose<Cal3Bundler> >(100, 10000, 5, 100);
+  timePCG<PinholeCamera<Cal3Bundler> >(100, 10000, 5, 100);
 }
 
 //*************************************************************************************
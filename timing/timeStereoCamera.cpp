@@ -19,6 +19,8 @@
 #include <iostream>
 
 #include <gtsam/geometry/StereoCamera.h>
+#include <gtsam/slam/StereoFactor.h>
+#include <gtsam/nonlinear/Values.h>
 
 using namespace std;
 using namespace gtsam;
@@ -44,6 +46,44 @@ int main()
     camera.project(point1, computed1, computed2);
   long timeLog2 = clock();
   double seconds = (double)(timeLog2-timeLog)/CLOCKS_PER_SEC;
+  cout << "project, dynamic Jacobians:" << endl;
+  cout << ((double)n/seconds) << " calls/second" << endl;
+  cout << ((double)seconds*1000000/n) << " musecs/call" << endl;
+
+  Matrix36 H1;
+  Matrix3 H2;
+  timeLog = clock();
+  for(int i = 0; i < n; i++)
+    StereoCamera::Project(pose1, *K, point1, H1, H2);
+  timeLog2 = clock();
+  seconds = (double)(timeLog2-timeLog)/CLOCKS_PER_SEC;
+  cout << "Project, fixed-size Jacobians:" << endl;
+  cout << ((double)n/seconds) << " calls/second" << endl;
+  cout << ((double)seconds*1000000/n) << " musecs/call" << endl;
+
+  // Linearize a stereo factor through NoiseModelFactor2 and through the fixed-size path
+  typedef GenericStereoFactor<Pose3, Point3> StereoFactor;
+  const StereoFactor factor(camera.project(point1), noiseModel::Isotropic::Sigma(3, 1.0),
+      0, 1, K);
+  Values values;
+  values.insert(0, pose1);
+  values.insert(1, Point3(-0.08, -0.08, -0.5));
+
+  timeLog = clock();
+  for(int i = 0; i < n; i++)
+    factor.Base::linearize(values);
+  timeLog2 = clock();
+  seconds = (double)(timeLog2-timeLog)/CLOCKS_PER_SEC;
+  cout << "NoiseModelFactor2::linearize:" << endl;
+  cout << ((double)n/seconds) << " calls/second" << endl;
+  cout << ((double)seconds*1000000/n) << " musecs/call" << endl;
+
+  timeLog = clock();
+  for(int i = 0; i < n; i++)
+    factor.linearize(values);
+  timeLog2 = clock();
+  seconds = (double)(timeLog2-timeLog)/CLOCKS_PER_SEC;
+  cout << "GenericStereoFactor::linearize:" << endl;
   cout << ((double)n/seconds) << " calls/second" << endl;
   cout << ((double)seconds*1000000/n) << " musecs/call" << endl;
 
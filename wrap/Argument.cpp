@@ -106,6 +106,21 @@ void Argument::proxy_check(FileWriter& proxyFile, const string& s) const {
     proxyFile.oss << " && size(" << s << ",2)==1";
 }
 
+/* ************************************************************************* */
+string Argument::python_type() const {
+  string cppType = type.qualifiedName("::");
+  // Matrix and Vector are converted from Python buffers, see wrap/python.h
+  if (type.category == Qualified::EIGEN)
+    return "const " + cppType + "&";
+  if (is_ptr)
+    return "boost::shared_ptr<" + cppType + ">";
+  if (is_ref && !is_const)
+    return cppType + "&";
+  if (type.category == Qualified::BASIS && !is_ref)
+    return cppType;
+  return "const " + cppType + "&";
+}
+
 /* ************************************************************************* */
 string ArgumentList::types() const {
   string str;
@@ -153,6 +168,19 @@ string ArgumentList::names() const {
   return str;
 }
 
+/* ************************************************************************* */
+string ArgumentList::python_parameters() const {
+  string str;
+  bool first = true;
+  BOOST_FOREACH(Argument arg, *this) {
+    if (!first)
+      str += ", ";
+    str += arg.python_type() + " " + arg.name;
+    first = false;
+  }
+  return str;
+}
+
 /* ************************************************************************* */
 bool ArgumentList::allScalar() const {
   BOOST_FOREACH(Argument arg, *this)
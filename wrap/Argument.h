@@ -62,6 +62,9 @@ struct Argument {
    */
   void proxy_check(FileWriter& proxyFile, const std::string& s) const;
 
+  /// C++ parameter type in a Python wrapper, e.g., boost::shared_ptr<Test>
+  std::string python_type() const;
+
   friend std::ostream& operator<<(std::ostream& os, const Argument& arg) {
     os << (arg.is_const ? "const " : "") << arg.type << (arg.is_ptr ? "*" : "")
         << (arg.is_ref ? "&" : "");
@@ -109,6 +112,9 @@ struct ArgumentList: public std::vector<Argument> {
    */
   void proxy_check(FileWriter& proxyFile) const;
 
+  /// Parameter list of a Python wrapper function, e.g., "const Vector& v, int i"
+  std::string python_parameters() const;
+
   /// Output stream operator
   friend std::ostream& operator<<(std::ostream& os,
       const ArgumentList& argList) {
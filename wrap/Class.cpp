@@ -629,15 +629,40 @@ string Class::getSerializationExport() const {
       + qualifiedName() + "\");";
 }
 
+/* ************************************************************************* */
+void Class::python_functions(FileWriter& wrapperFile,
+    const TypeAttributesTable& typeAttributes) const {
+  const string cppName = qualifiedName("::"), uniqueName = qualifiedName();
+  constructor.python_functions(wrapperFile, cppName, uniqueName);
+  BOOST_FOREACH(const StaticMethod& m, static_methods | boost::adaptors::map_values)
+    m.python_functions(wrapperFile, cppName, uniqueName, typeAttributes);
+  BOOST_FOREACH(const Method& m, methods_ | boost::adaptors::map_values)
+    m.python_functions(wrapperFile, cppName, uniqueName, typeAttributes);
+  wrapperFile.oss << "\n";
+}
+
 /* ************************************************************************* */
 void Class::python_wrapper(FileWriter& wrapperFile) const {
-  wrapperFile.oss << "class_<" << name() << ">(\"" << name() << "\")\n";
-  constructor.python_wrapper(wrapperFile, name());
+  // Objects are held by shared pointers, as in the MATLAB wrapper
+  const string cppName = qualifiedName("::"), uniqueName = qualifiedName();
+  wrapperFile.oss << "  class_<" << cppName << ", boost::shared_ptr<" << cppName
+      << ">";
+  if (parentClass)
+    wrapperFile.oss << ", bases<" << *qualifiedParent() << ">";
+  // A virtual class is returned by clone(), and may be abstract
+  if (isVirtual)
+    wrapperFile.oss << ", boost::noncopyable";
+  // The outer namespace is the module, e.g., gtsam::noiseModel::Base is noiseModelBase
+  string pythonName = name();
+  for (size_t i = namespaces().size(); i > 1; --i)
+    pythonName = namespaces()[i - 1] + pythonName;
+  wrapperFile.oss << " >(\"" << pythonName << "\", no_init)\n";
+  constructor.python_wrapper(wrapperFile, uniqueName);
   BOOST_FOREACH(const StaticMethod& m, static_methods | boost::adaptors::map_values)
-    m.python_wrapper(wrapperFile, name());
+    m.python_wrapper(wrapperFile, uniqueName);
   BOOST_FOREACH(const Method& m, methods_ | boost::adaptors::map_values)
-    m.python_wrapper(wrapperFile, name());
-  wrapperFile.oss << ";\n\n";
+    m.python_wrapper(wrapperFile, uniqueName);
+  wrapperFile.oss << "    ;\n\n";
 }
 
 /* ************************************************************************* */
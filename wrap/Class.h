@@ -135,7 +135,11 @@ public:
   void deserialization_fragments(FileWriter& proxyFile, FileWriter& wrapperFile,
       Str wrapperName, std::vector<std::string>& functionNames) const;
 
-  // emit python wrapper
+  // emit python wrapper functions for constructors and methods
+  void python_functions(FileWriter& wrapperFile,
+      const TypeAttributesTable& typeAttributes) const;
+
+  // emit python wrapper, the class_ definition
   void python_wrapper(FileWriter& wrapperFile) const;
 
   friend std::ostream& operator<<(std::ostream& os, const Class& cls) {
@@ -116,9 +116,25 @@ string Constructor::wrapper_fragment(FileWriter& file, Str cppClassName,
 }
 
 /* ************************************************************************* */
-void Constructor::python_wrapper(FileWriter& wrapperFile, Str className) const {
-  wrapperFile.oss << "  .def(\"" << name_ << "\", &" << className << "::" << name_
-      << ");\n";
+void Constructor::python_functions(FileWriter& wrapperFile,
+    Str cppClassName, Str uniqueName) const {
+  // example: return boost::shared_ptr<gtsam::Point2>(new gtsam::Point2(x,y));
+  const string shared = "boost::shared_ptr<" + cppClassName + ">";
+  for (size_t i = 0; i < nrOverloads(); i++) {
+    wrapperFile.oss << "static " << shared << " " << uniqueName
+        << "_constructor_" << i << "(" << argumentList(i).python_parameters()
+        << ") {\n";
+    wrapperFile.oss << "  return " << shared << "(new " << cppClassName << "("
+        << argumentList(i).names() << "));\n";
+    wrapperFile.oss << "}\n";
+  }
+}
+
+/* ************************************************************************* */
+void Constructor::python_wrapper(FileWriter& wrapperFile, Str uniqueName) const {
+  for (size_t i = 0; i < nrOverloads(); i++)
+    wrapperFile.oss << "    .def(\"__init__\", make_constructor(&" << uniqueName
+        << "_constructor_" << i << "))\n";
 }
 
 /* ************************************************************************* */
@@ -75,8 +75,12 @@ struct Constructor: public OverloadedFunction {
   void generate_construct(FileWriter& file, Str cppClassName,
       std::vector<ArgumentList>& args_list) const;
 
-  // emit python wrapper
-  void python_wrapper(FileWriter& wrapperFile, Str className) const;
+  // emit python wrapper functions, one for each overload
+  void python_functions(FileWriter& wrapperFile, Str cppClassName,
+      Str uniqueName) const;
+
+  // emit python wrapper, the __init__ definitions in the class_
+  void python_wrapper(FileWriter& wrapperFile, Str uniqueName) const;
 
   friend std::ostream& operator<<(std::ostream& os, const Constructor& m) {
     for (size_t i = 0; i < m.nrOverloads(); i++)
@@ -77,3 +77,18 @@ void Function::emit_conditional_call(FileWriter& proxyFile,
 }
 
 /* ************************************************************************* */
+void Function::python_function(FileWriter& wrapperFile,
+    const string& functionName, const string& self,
+    const ReturnValue& returnVal, const ArgumentList& args, const string& call,
+    const TypeAttributesTable& typeAttributes) const {
+  string parameters = args.python_parameters();
+  if (!self.empty())
+    parameters = parameters.empty() ? self : self + ", " + parameters;
+  wrapperFile.oss << "static " << returnVal.python_returnType(typeAttributes)
+      << " " << functionName << "(" << parameters << ") {\n";
+  returnVal.python_return(wrapperFile, call + "(" + args.names() + ")",
+      typeAttributes);
+  wrapperFile.oss << "}\n";
+}
+
+/* ************************************************************************* */
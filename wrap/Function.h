@@ -67,6 +67,17 @@ public:
       const ReturnValue& returnVal, const ArgumentList& args,
       const std::string& wrapperName, int id) const;
 
+  /**
+   * Emit a Boost.Python wrapper function, e.g.,
+   * static double gtsamPoint2_x_0(gtsam::Point2& self) { return self.x(); }
+   * @param self the parameter for the object, if any
+   * @param call the function to call with the arguments
+   */
+  void python_function(FileWriter& wrapperFile, const std::string& functionName,
+      const std::string& self, const ReturnValue& returnVal,
+      const ArgumentList& args, const std::string& call,
+      const TypeAttributesTable& typeAttributes) const;
+
 };
 
 } // \namespace wrap
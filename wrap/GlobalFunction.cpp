@@ -127,9 +127,21 @@ void GlobalFunction::generateSingleFunction(const string& toolboxPath,
   mfunctionFile.emit(true);
 }
 
+/* ************************************************************************* */
+void GlobalFunction::python_functions(FileWriter& wrapperFile,
+    const TypeAttributesTable& typeAttributes) const {
+  for (size_t i = 0; i < nrOverloads(); i++)
+    python_function(wrapperFile,
+        overloads[i].qualifiedName() + "_" + boost::lexical_cast<string>(i), "",
+        returnValue(i), argumentList(i), overloads[i].qualifiedName("::"),
+        typeAttributes);
+}
+
 /* ************************************************************************* */
 void GlobalFunction::python_wrapper(FileWriter& wrapperFile) const {
-  wrapperFile.oss << "def(\"" << name_ << "\", " << name_ << ");\n";
+  for (size_t i = 0; i < nrOverloads(); i++)
+    wrapperFile.oss << "  def(\"" << name_ << "\", &"
+        << overloads[i].qualifiedName() << "_" << i << ");\n";
 }
 
 /* ************************************************************************* */
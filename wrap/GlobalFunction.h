@@ -47,7 +47,11 @@ struct GlobalFunction: public FullyOverloadedFunction {
       const std::string& wrapperName, const TypeAttributesTable& typeAttributes,
       FileWriter& file, std::vector<std::string>& functionNames) const;
 
-  // emit python wrapper
+  // emit python wrapper functions, one for each overload
+  void python_functions(FileWriter& wrapperFile,
+      const TypeAttributesTable& typeAttributes) const;
+
+  // emit python wrapper, the def statements
   void python_wrapper(FileWriter& wrapperFile) const;
 
 private:
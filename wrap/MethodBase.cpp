@@ -133,9 +133,39 @@ string MethodBase::wrapper_fragment(FileWriter& wrapperFile, Str cppClassName,
 }
 
 /* ************************************************************************* */
-void MethodBase::python_wrapper(FileWriter& wrapperFile, Str className) const {
-  wrapperFile.oss << "  .def(\"" << name_ << "\", &" << className << "::"
-      << name_ << ");\n";
+void MethodBase::python_functions(FileWriter& wrapperFile, Str cppClassName,
+    Str uniqueName, const TypeAttributesTable& typeAttributes) const {
+  string call = (isStatic() ? cppClassName + "::" : "self.") + name_;
+  if (templateArgValue_)
+    call += ("<" + templateArgValue_->qualifiedName("::") + ">");
+  string self = isStatic() ? "" : cppClassName + "& self";
+  for (size_t i = 0; i < nrOverloads(); i++)
+    python_function(wrapperFile, python_name(uniqueName, i), self,
+        returnValue(i), argumentList(i), call, typeAttributes);
+}
+
+/* ************************************************************************* */
+void MethodBase::python_wrapper(FileWriter& wrapperFile, Str uniqueName) const {
+  for (size_t i = 0; i < nrOverloads(); i++)
+    wrapperFile.oss << "    .def(\"" << pythonName() << "\", &"
+        << python_name(uniqueName, i) << ")\n";
+  if (isStatic())
+    wrapperFile.oss << "    .staticmethod(\"" << pythonName() << "\")\n";
+}
+
+/* ************************************************************************* */
+string MethodBase::pythonName() const {
+  // As in MATLAB, static methods are uppercase, e.g., Rot3.Ypr and rot.ypr
+  string name = matlabName();
+  if (isStatic())
+    name[0] = toupper(name[0], locale());
+  return name;
+}
+
+/* ************************************************************************* */
+string MethodBase::python_name(Str uniqueName, size_t overload) const {
+  return uniqueName + "_" + pythonName() + "_"
+      + boost::lexical_cast<string>(overload);
 }
 
 /* ************************************************************************* */
@@ -48,8 +48,12 @@ struct MethodBase: public FullyOverloadedFunction {
       Str wrapperName, const TypeAttributesTable& typeAttributes,
       std::vector<std::string>& functionNames) const;
 
-  // emit python wrapper
-  void python_wrapper(FileWriter& wrapperFile, Str className) const;
+  // emit python wrapper functions, one for each overload
+  void python_functions(FileWriter& wrapperFile, Str cppClassName,
+      Str uniqueName, const TypeAttributesTable& typeAttributes) const;
+
+  // emit python wrapper, the definitions in the class_
+  void python_wrapper(FileWriter& wrapperFile, Str uniqueName) const;
 
 protected:
 
@@ -59,6 +63,12 @@ protected:
       Str matlabUniqueName, int overload, int id,
       const TypeAttributesTable& typeAttributes) const; ///< cpp wrapper
 
+  /// name in python, uppercase for static methods
+  std::string pythonName() const;
+
+  /// name of the python wrapper function for an overload
+  std::string python_name(Str uniqueName, size_t overload) const;
+
   virtual std::string wrapper_call(FileWriter& wrapperFile, Str cppClassName,
       Str matlabUniqueName, const ArgumentList& args) const = 0;
 };
@@ -446,14 +446,33 @@ void Module::python_wrapper(const string& toolboxPath) const {
 
   fs::create_directories(toolboxPath);
 
-  // create the unified .cpp switch file
+  // create the unified .cpp file with the Boost.Python module
   const string wrapperName = name + "_python";
   string wrapperFileName = toolboxPath + "/" + wrapperName + ".cpp";
   FileWriter wrapperFile(wrapperFileName, verbose, "//");
-  wrapperFile.oss << "#include <boost/python.hpp>\n\n";
-  wrapperFile.oss << "using namespace boost::python;\n";
+  wrapperFile.oss << "#include <wrap/python.h>\n\n";
+
+  // Generate includes while avoiding redundant includes
+  generateIncludes(wrapperFile);
+
+  // create typedef classes, used by the wrapper functions
+  BOOST_FOREACH(const Class& cls, expandedClasses)
+    if(!cls.typedefName.empty())
+      wrapperFile.oss << cls.getTypedef() << "\n";
+  wrapperFile.oss << "\n";
+
+  wrapperFile.oss << "using namespace boost::python;\n\n";
+
+  // write out wrapper functions, which adapt arguments and results
+  BOOST_FOREACH(const Class& cls, expandedClasses)
+    cls.python_functions(wrapperFile, typeAttributes);
+  BOOST_FOREACH(const GlobalFunctions::value_type& p, global_functions)
+    p.second.python_functions(wrapperFile, typeAttributes);
+  wrapperFile.oss << "\n";
+
   wrapperFile.oss << "BOOST_PYTHON_MODULE(" + name + ")\n";
   wrapperFile.oss << "{\n";
+  wrapperFile.oss << "  wrap::python::registerEigenConverters();\n\n";
 
   // write out classes
   BOOST_FOREACH(const Class& cls, expandedClasses)
@@ -67,4 +67,24 @@ void ReturnType::wrapTypeUnwrap(FileWriter& wrapperFile) const {
 }
 
 /* ************************************************************************* */
+string ReturnType::python_cppType() const {
+  string cppType = qualifiedName("::");
+  return isPtr ? "boost::shared_ptr<" + cppType + ">" : cppType;
+}
 
+/* ************************************************************************* */
+string ReturnType::python_result(const string& result,
+    const TypeAttributesTable& typeAttributes) const {
+  if (category == EIGEN)
+    // Hand over the result without a copy, unless it is shared
+    return isPtr ? "wrap::python::copyEigen(*" + result + ")" :
+        "wrap::python::wrapEigen(" + result + ")";
+  else if (category == CLASS && !isPtr
+      && typeAttributes.attributes(qualifiedName("::")).isVirtual)
+    // A virtual class is cloned, so the derived-most type is returned
+    return "boost::python::object(" + result + ".clone())";
+  else
+    return result;
+}
+
+/* ************************************************************************* */
@@ -60,6 +60,13 @@ private:
   /// Creates typedef
   void wrapTypeUnwrap(FileWriter& wrapperFile) const;
 
+  /// C++ type in which a Python wrapper stores the result
+  std::string python_cppType() const;
+
+  /// Expression converting a stored result to Python, see wrap/python.h
+  std::string python_result(const std::string& result,
+      const TypeAttributesTable& typeAttributes) const;
+
 };
 
 //******************************************************************************
@@ -69,4 +69,39 @@ void ReturnValue::emit_matlab(FileWriter& proxyFile) const {
 }
 
 /* ************************************************************************* */
+string ReturnValue::python_returnType(
+    const TypeAttributesTable& typeAttributes) const {
+  if (isPair)
+    return "boost::python::object";
+  else if (type1.category == ReturnType::VOID)
+    return "void";
+  else if (type1.python_result("result", typeAttributes) != "result")
+    return "boost::python::object";
+  else
+    return type1.python_cppType();
+}
 
+/* ************************************************************************* */
+void ReturnValue::python_return(FileWriter& wrapperFile, const string& call,
+    const TypeAttributesTable& typeAttributes) const {
+  if (isPair) {
+    wrapperFile.oss << "  std::pair<" << type1.python_cppType() << ", "
+        << type2.python_cppType() << " > result = " << call << ";\n";
+    wrapperFile.oss << "  return boost::python::make_tuple("
+        << type1.python_result("result.first", typeAttributes) << ", "
+        << type2.python_result("result.second", typeAttributes) << ");\n";
+  } else if (type1.category == ReturnType::VOID) {
+    wrapperFile.oss << "  " << call << ";\n";
+  } else if (type1.category == ReturnType::EIGEN) {
+    // Store the result, so that it can be swapped into the Python object
+    wrapperFile.oss << "  " << type1.python_cppType() << " result = " << call
+        << ";\n";
+    wrapperFile.oss << "  return "
+        << type1.python_result("result", typeAttributes) << ";\n";
+  } else {
+    wrapperFile.oss << "  return " << type1.python_result(call, typeAttributes)
+        << ";\n";
+  }
+}
+
+/* ************************************************************************* */
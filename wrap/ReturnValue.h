@@ -67,6 +67,13 @@ struct ReturnValue {
 
   void emit_matlab(FileWriter& proxyFile) const;
 
+  /// Return type of a Python wrapper function
+  std::string python_returnType(const TypeAttributesTable& typeAttributes) const;
+
+  /// Emit the body of a Python wrapper function, returning the result of call
+  void python_return(FileWriter& wrapperFile, const std::string& call,
+      const TypeAttributesTable& typeAttributes) const;
+
   friend std::ostream& operator<<(std::ostream& os, const ReturnValue& r) {
     if (!r.isPair && r.type1.category == ReturnType::VOID)
       os << "void";
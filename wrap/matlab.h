@@ -181,12 +181,17 @@ mxArray* wrap<double>(const double& value) {
   return mxCreateDoubleScalar(value);
 }
 
+// Views of MATLAB double arrays as Eigen matrices. MATLAB and Eigen both store
+// matrices in column-major order, so an array is copied in bulk, or not at all.
+typedef Eigen::Map<gtsam::Matrix> MatrixMap;
+typedef Eigen::Map<const gtsam::Matrix> ConstMatrixMap;
+typedef Eigen::Map<const gtsam::Vector> ConstVectorMap;
+
 // wrap a const Eigen vector into a double vector
 mxArray* wrap_Vector(const gtsam::Vector& v) {
   int m = v.size();
   mxArray *result = mxCreateDoubleMatrix(m, 1, mxREAL);
-  double *data = mxGetPr(result);
-  for (int i=0;i<m;i++) data[i]=v(i);
+  MatrixMap(mxGetPr(result), m, 1) = v;
   return result;
 }
 
@@ -204,9 +209,7 @@ mxArray* wrap_Matrix(const gtsam::Matrix& A) {
   gtsam::print(A);
 #endif
   mxArray *result = mxCreateDoubleMatrix(m, n, mxREAL);
-  double *data = mxGetPr(result);
-  // converts from column-major to row-major
-  for (int j=0;j<n;j++) for (int i=0;i<m;i++,data++) *data = A(i,j);
+  MatrixMap(mxGetPr(result), m, n) = A;
   return result;
 }
 
@@ -304,9 +307,7 @@ gtsam::Vector unwrap< gtsam::Vector >(const mxArray* array) {
 #ifdef DEBUG_WRAP
   mexPrintf("unwrap< gtsam::Vector > called with %dx%d argument\n", m,n);
 #endif
-  double* data = (double*)mxGetData(array);
-  gtsam::Vector v(m);
-  for (int i=0;i<m;i++,data++) v(i) = *data;
+  gtsam::Vector v = ConstVectorMap((const double*)mxGetData(array), m);
 #ifdef DEBUG_WRAP
   gtsam::print(v);
 #endif
@@ -321,16 +322,20 @@ gtsam::Matrix unwrap< gtsam::Matrix >(const mxArray* array) {
 #ifdef DEBUG_WRAP
   mexPrintf("unwrap< gtsam::Matrix > called with %dx%d argument\n", m,n);
 #endif
-  double* data = (double*)mxGetData(array);
-  gtsam::Matrix A(m,n);
-  // converts from row-major to column-major
-  for (int j=0;j<n;j++) for (int i=0;i<m;i++,data++) A(i,j) = *data;
+  gtsam::Matrix A = ConstMatrixMap((const double*)mxGetData(array), m, n);
 #ifdef DEBUG_WRAP
   gtsam::print(A);
 #endif
   return A;
 }
 
+// View a MATLAB double matrix as an Eigen matrix without copying it, for C++ code that
+// accepts Eigen::Map or Eigen::Ref arguments. The view is only valid while the array lives.
+ConstMatrixMap unwrap_map(const mxArray* array) {
+  if (mxIsDouble(array)==false || mxIsComplex(array)) error("unwrap_map: not a real matrix");
+  return ConstMatrixMap((const double*)mxGetData(array), mxGetM(array), mxGetN(array));
+}
+
 /*
  [create_object] creates a MATLAB proxy class object with a mexhandle
  in the self property. Matlab does not allow the creation of matlab
@@ -0,0 +1,261 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file python.h
+ * @brief header file to be included in Boost.Python wrappers
+ * @date Oct 15, 2026
+ *
+ * Matrix and Vector results are handed to Python without a copy: the result
+ * is swapped into a small Python object that owns it and exports it with the
+ * buffer protocol (PEP 3118), and NumPy arrays are views of that buffer.
+ * Matrix and Vector arguments are read from any object with a buffer of
+ * doubles, a NumPy array, memoryview or array.array, with any strides.
+ */
+
+#pragma once
+
+#include <gtsam/base/Vector.h>
+#include <gtsam/base/Matrix.h>
+
+using gtsam::Vector;
+using gtsam::Matrix;
+
+#include <boost/python.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <string>
+#include <cstring>
+
+using namespace std;
+
+#if PY_MAJOR_VERSION < 3
+#define WRAP_TPFLAGS_BUFFER (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_NEWBUFFER)
+#else
+#define WRAP_TPFLAGS_BUFFER Py_TPFLAGS_DEFAULT
+#endif
+
+namespace wrap {
+namespace python {
+
+//*****************************************************************************
+// Owner of a Matrix or Vector result, exporting it with the buffer protocol
+//*****************************************************************************
+
+struct EigenBuffer {
+  PyObject_HEAD
+  Matrix* matrix; ///< owned matrix, or null
+  Vector* vector; ///< owned vector, or null
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+};
+
+static void EigenBuffer_dealloc(PyObject* self) {
+  EigenBuffer* buffer = reinterpret_cast<EigenBuffer*>(self);
+  delete buffer->matrix;
+  delete buffer->vector;
+  PyObject_Del(self);
+}
+
+static int EigenBuffer_getbuffer(PyObject* self, Py_buffer* view, int flags) {
+  EigenBuffer* buffer = reinterpret_cast<EigenBuffer*>(self);
+  const int ndim = buffer->vector ? 1 : 2;
+  // Without strides the consumer assumes C order, which a matrix is not
+  if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES && ndim == 2
+      && buffer->shape[0] > 1 && buffer->shape[1] > 1) {
+    PyErr_SetString(PyExc_BufferError, "column-major matrix needs strides");
+    view->obj = NULL;
+    return -1;
+  }
+  view->buf = buffer->matrix ?
+      static_cast<void*>(buffer->matrix->data()) :
+      static_cast<void*>(buffer->vector->data());
+  view->obj = self;
+  Py_INCREF(self);
+  view->len = buffer->shape[0] * (ndim == 2 ? buffer->shape[1] : 1)
+      * Py_ssize_t(sizeof(double));
+  view->readonly = 0;
+  view->itemsize = sizeof(double);
+  view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>("d") : NULL;
+  view->ndim = ndim;
+  view->shape = (flags & PyBUF_ND) ? buffer->shape : NULL;
+  view->strides = (flags & PyBUF_STRIDES) ? buffer->strides : NULL;
+  view->suboffsets = NULL;
+  view->internal = NULL;
+  return 0;
+}
+
+#if PY_MAJOR_VERSION < 3
+static PyBufferProcs EigenBuffer_procs = { 0, 0, 0, 0,
+    EigenBuffer_getbuffer, 0 };
+#else
+static PyBufferProcs EigenBuffer_procs = { EigenBuffer_getbuffer, 0 };
+#endif
+
+static PyTypeObject EigenBuffer_type = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "wrap.EigenBuffer",           /* tp_name */
+  sizeof(EigenBuffer),          /* tp_basicsize */
+  0,                            /* tp_itemsize */
+  EigenBuffer_dealloc,          /* tp_dealloc */
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  &EigenBuffer_procs,           /* tp_as_buffer */
+  WRAP_TPFLAGS_BUFFER,          /* tp_flags */
+  "Matrix or Vector owned by a wrapped result" /* tp_doc */
+};
+
+/// numpy.asarray, or None if NumPy is not installed
+inline boost::python::object& asarray() {
+  static boost::python::object function;
+  return function;
+}
+
+/// Wrap an EigenBuffer in a NumPy array, or in a memoryview without NumPy
+inline boost::python::object view(EigenBuffer* buffer) {
+  boost::python::object owner(boost::python::handle<>(
+      reinterpret_cast<PyObject*>(buffer)));
+  if (!asarray().is_none())
+    return asarray()(owner);
+  return boost::python::object(boost::python::handle<>(
+      PyMemoryView_FromObject(owner.ptr())));
+}
+
+inline EigenBuffer* newBuffer() {
+  EigenBuffer* buffer = PyObject_New(EigenBuffer, &EigenBuffer_type);
+  if (!buffer)
+    boost::python::throw_error_already_set();
+  buffer->matrix = 0;
+  buffer->vector = 0;
+  return buffer;
+}
+
+/// Hand a matrix to Python without copying, m is left empty
+inline boost::python::object wrapEigen(Matrix& m) {
+  EigenBuffer* buffer = newBuffer();
+  buffer->matrix = new Matrix();
+  buffer->matrix->swap(m);
+  buffer->shape[0] = buffer->matrix->rows();
+  buffer->shape[1] = buffer->matrix->cols();
+  buffer->strides[0] = sizeof(double);
+  buffer->strides[1] = buffer->matrix->rows() * sizeof(double);
+  return view(buffer);
+}
+
+/// Hand a vector to Python without copying, v is left empty
+inline boost::python::object wrapEigen(Vector& v) {
+  EigenBuffer* buffer = newBuffer();
+  buffer->vector = new Vector();
+  buffer->vector->swap(v);
+  buffer->shape[0] = buffer->vector->size();
+  buffer->shape[1] = 1;
+  buffer->strides[0] = sizeof(double);
+  buffer->strides[1] = 0;
+  return view(buffer);
+}
+
+/// Hand a copy of a matrix or vector to Python, for results that are shared
+template<class EIGEN>
+boost::python::object copyEigen(const EIGEN& m) {
+  EIGEN copy(m);
+  return wrapEigen(copy);
+}
+
+//*****************************************************************************
+// Conversions between Python and Matrix or Vector
+//*****************************************************************************
+
+/// Whether a buffer format is a native double
+inline bool isDouble(const char* format) {
+  if (!format)
+    return false;
+  const unsigned short one = 1;
+  const char native = *reinterpret_cast<const char*>(&one) ? '<' : '>';
+  if (format[0] == '@' || format[0] == '=' || format[0] == native)
+    ++format;
+  return std::strcmp(format, "d") == 0;
+}
+
+/// Converts any Python object with a buffer of doubles, copying it once
+template<class EIGEN>
+struct EigenFromPython {
+
+  EigenFromPython() {
+    boost::python::converter::registry::push_back(&convertible, &construct,
+        boost::python::type_id<EIGEN>());
+  }
+
+  static bool isVector() {
+    return EIGEN::ColsAtCompileTime == 1;
+  }
+
+  static void* convertible(PyObject* obj) {
+    if (!PyObject_CheckBuffer(obj))
+      return 0;
+    Py_buffer buffer;
+    if (PyObject_GetBuffer(obj, &buffer, PyBUF_STRIDES | PyBUF_FORMAT) != 0) {
+      PyErr_Clear();
+      return 0;
+    }
+    const bool ok = isDouble(buffer.format) && buffer.ndim <= 2
+        && !(isVector() && buffer.ndim == 2 && buffer.shape[1] != 1);
+    PyBuffer_Release(&buffer);
+    return ok ? obj : 0;
+  }
+
+  static void construct(PyObject* obj,
+      boost::python::converter::rvalue_from_python_stage1_data* data) {
+    Py_buffer buffer;
+    if (PyObject_GetBuffer(obj, &buffer, PyBUF_STRIDES | PyBUF_FORMAT) != 0)
+      boost::python::throw_error_already_set();
+    const Py_ssize_t rows = buffer.ndim > 0 ? buffer.shape[0] : 1;
+    const Py_ssize_t cols = buffer.ndim > 1 ? buffer.shape[1] : 1;
+    const Py_ssize_t rowStride = buffer.ndim > 0 ? buffer.strides[0] : 0;
+    const Py_ssize_t colStride = buffer.ndim > 1 ? buffer.strides[1] : 0;
+    void* storage = reinterpret_cast<
+        boost::python::converter::rvalue_from_python_storage<EIGEN>*>(data)->storage.bytes;
+    EIGEN* m = new (storage) EIGEN();
+    m->resize(rows, cols);
+    const char* p = static_cast<const char*>(buffer.buf);
+    for (Py_ssize_t j = 0; j < cols; j++)
+      for (Py_ssize_t i = 0; i < rows; i++)
+        m->coeffRef(i, j) = *reinterpret_cast<const double*>(p + i * rowStride
+            + j * colStride);
+    PyBuffer_Release(&buffer);
+    data->convertible = storage;
+  }
+};
+
+/// Matrix or Vector results that are not wrapped by wrapEigen are copied
+template<class EIGEN>
+struct EigenToPython {
+  static PyObject* convert(const EIGEN& m) {
+    return boost::python::incref(copyEigen(m).ptr());
+  }
+};
+
+/// Register the conversions, called when the module is imported
+inline void registerEigenConverters() {
+  if (PyType_Ready(&EigenBuffer_type) < 0)
+    boost::python::throw_error_already_set();
+  try {
+    asarray() = boost::python::import("numpy").attr("asarray");
+  } catch (const boost::python::error_already_set&) {
+    PyErr_Clear();
+  }
+  EigenFromPython<Matrix>();
+  EigenFromPython<Vector>();
+  boost::python::to_python_converter<Matrix, EigenToPython<Matrix> >();
+  boost::python::to_python_converter<Vector, EigenToPython<Vector> >();
+}
+
+} // \namespace python
+} // \namespace wrap
@@ -1,88 +1,321 @@
-#include <boost/python.hpp>
+#include <wrap/python.h>
+
+#include <folder/path/to/Test.h>
+
+typedef MyTemplate<gtsam::Point2> MyTemplatePoint2;
+typedef MyTemplate<Matrix> MyTemplateMatrix;
+typedef MyFactor<gtsam::Pose2, Matrix> MyFactorPosePoint2;
 
 using namespace boost::python;
+
+static boost::shared_ptr<gtsam::Point2> gtsamPoint2_constructor_0() {
+  return boost::shared_ptr<gtsam::Point2>(new gtsam::Point2());
+}
+static boost::shared_ptr<gtsam::Point2> gtsamPoint2_constructor_1(double x, double y) {
+  return boost::shared_ptr<gtsam::Point2>(new gtsam::Point2(x,y));
+}
+static void gtsamPoint2_argChar_0(gtsam::Point2& self, char a) {
+  self.argChar(a);
+}
+static void gtsamPoint2_argUChar_0(gtsam::Point2& self, unsigned char a) {
+  self.argUChar(a);
+}
+static int gtsamPoint2_dim_0(gtsam::Point2& self) {
+  return self.dim();
+}
+static void gtsamPoint2_eigenArguments_0(gtsam::Point2& self, const Vector& v, const Matrix& m) {
+  self.eigenArguments(v,m);
+}
+static char gtsamPoint2_returnChar_0(gtsam::Point2& self) {
+  return self.returnChar();
+}
+static VectorNotEigen gtsamPoint2_vectorConfusion_0(gtsam::Point2& self) {
+  return self.vectorConfusion();
+}
+static double gtsamPoint2_x_0(gtsam::Point2& self) {
+  return self.x();
+}
+static double gtsamPoint2_y_0(gtsam::Point2& self) {
+  return self.y();
+}
+
+static boost::shared_ptr<gtsam::Point3> gtsamPoint3_constructor_0(double x, double y, double z) {
+  return boost::shared_ptr<gtsam::Point3>(new gtsam::Point3(x,y,z));
+}
+static gtsam::Point3 gtsamPoint3_StaticFunctionRet_0(double z) {
+  return gtsam::Point3::StaticFunctionRet(z);
+}
+static double gtsamPoint3_StaticFunction_0() {
+  return gtsam::Point3::staticFunction();
+}
+static double gtsamPoint3_norm_0(gtsam::Point3& self) {
+  return self.norm();
+}
+
+static boost::shared_ptr<Test> Test_constructor_0() {
+  return boost::shared_ptr<Test>(new Test());
+}
+static boost::shared_ptr<Test> Test_constructor_1(double a, const Matrix& b) {
+  return boost::shared_ptr<Test>(new Test(a,b));
+}
+static void Test_arg_EigenConstRef_0(Test& self, const Matrix& value) {
+  self.arg_EigenConstRef(value);
+}
+static boost::python::object Test_create_MixedPtrs_0(Test& self) {
+  std::pair<Test, boost::shared_ptr<Test> > result = self.create_MixedPtrs();
+  return boost::python::make_tuple(result.first, result.second);
+}
+static boost::python::object Test_create_ptrs_0(Test& self) {
+  std::pair<boost::shared_ptr<Test>, boost::shared_ptr<Test> > result = self.create_ptrs();
+  return boost::python::make_tuple(result.first, result.second);
+}
+static void Test_print_0(Test& self) {
+  self.print();
+}
+static boost::shared_ptr<gtsam::Point2> Test_return_Point2Ptr_0(Test& self, bool value) {
+  return self.return_Point2Ptr(value);
+}
+static Test Test_return_Test_0(Test& self, boost::shared_ptr<Test> value) {
+  return self.return_Test(value);
+}
+static boost::shared_ptr<Test> Test_return_TestPtr_0(Test& self, boost::shared_ptr<Test> value) {
+  return self.return_TestPtr(value);
+}
+static bool Test_return_bool_0(Test& self, bool value) {
+  return self.return_bool(value);
+}
+static double Test_return_double_0(Test& self, double value) {
+  return self.return_double(value);
+}
+static bool Test_return_field_0(Test& self, const Test& t) {
+  return self.return_field(t);
+}
+static int Test_return_int_0(Test& self, int value) {
+  return self.return_int(value);
+}
+static boost::python::object Test_return_matrix1_0(Test& self, const Matrix& value) {
+  Matrix result = self.return_matrix1(value);
+  return wrap::python::wrapEigen(result);
+}
+static boost::python::object Test_return_matrix2_0(Test& self, const Matrix& value) {
+  Matrix result = self.return_matrix2(value);
+  return wrap::python::wrapEigen(result);
+}
+static boost::python::object Test_return_pair_0(Test& self, const Vector& v, const Matrix& A) {
+  std::pair<Vector, Matrix > result = self.return_pair(v,A);
+  return boost::python::make_tuple(wrap::python::wrapEigen(result.first), wrap::python::wrapEigen(result.second));
+}
+static boost::python::object Test_return_ptrs_0(Test& self, boost::shared_ptr<Test> p1, boost::shared_ptr<Test> p2) {
+  std::pair<boost::shared_ptr<Test>, boost::shared_ptr<Test> > result = self.return_ptrs(p1,p2);
+  return boost::python::make_tuple(result.first, result.second);
+}
+static size_t Test_return_size_t_0(Test& self, size_t value) {
+  return self.return_size_t(value);
+}
+static string Test_return_string_0(Test& self, string value) {
+  return self.return_string(value);
+}
+static boost::python::object Test_return_vector1_0(Test& self, const Vector& value) {
+  Vector result = self.return_vector1(value);
+  return wrap::python::wrapEigen(result);
+}
+static boost::python::object Test_return_vector2_0(Test& self, const Vector& value) {
+  Vector result = self.return_vector2(value);
+  return wrap::python::wrapEigen(result);
+}
+
+
+static boost::shared_ptr<MyTemplatePoint2> MyTemplatePoint2_constructor_0() {
+  return boost::shared_ptr<MyTemplatePoint2>(new MyTemplatePoint2());
+}
+static void MyTemplatePoint2_accept_T_0(MyTemplatePoint2& self, const gtsam::Point2& value) {
+  self.accept_T(value);
+}
+static void MyTemplatePoint2_accept_Tptr_0(MyTemplatePoint2& self, boost::shared_ptr<gtsam::Point2> value) {
+  self.accept_Tptr(value);
+}
+static boost::python::object MyTemplatePoint2_create_MixedPtrs_0(MyTemplatePoint2& self) {
+  std::pair<gtsam::Point2, boost::shared_ptr<gtsam::Point2> > result = self.create_MixedPtrs();
+  return boost::python::make_tuple(result.first, result.second);
+}
+static boost::python::object MyTemplatePoint2_create_ptrs_0(MyTemplatePoint2& self) {
+  std::pair<boost::shared_ptr<gtsam::Point2>, boost::shared_ptr<gtsam::Point2> > result = self.create_ptrs();
+  return boost::python::make_tuple(result.first, result.second);
+}
+static gtsam::Point2 MyTemplatePoint2_return_T_0(MyTemplatePoint2& self, boost::shared_ptr<gtsam::Point2> value) {
+  return self.return_T(value);
+}
+static boost::shared_ptr<gtsam::Point2> MyTemplatePoint2_return_Tptr_0(MyTemplatePoint2& self, boost::shared_ptr<gtsam::Point2> value) {
+  return self.return_Tptr(value);
+}
+static boost::python::object MyTemplatePoint2_return_ptrs_0(MyTemplatePoint2& self, boost::shared_ptr<gtsam::Point2> p1, boost::shared_ptr<gtsam::Point2> p2) {
+  std::pair<boost::shared_ptr<gtsam::Point2>, boost::shared_ptr<gtsam::Point2> > result = self.return_ptrs(p1,p2);
+  return boost::python::make_tuple(result.first, result.second);
+}
+static boost::python::object MyTemplatePoint2_templatedMethodMatrix_0(MyTemplatePoint2& self, const Matrix& t) {
+  Matrix result = self.templatedMethod<Matrix>(t);
+  return wrap::python::wrapEigen(result);
+}
+static gtsam::Point2 MyTemplatePoint2_templatedMethodPoint2_0(MyTemplatePoint2& self, const gtsam::Point2& t) {
+  return self.templatedMethod<gtsam::Point2>(t);
+}
+static gtsam::Point3 MyTemplatePoint2_templatedMethodPoint3_0(MyTemplatePoint2& self, const gtsam::Point3& t) {
+  return self.templatedMethod<gtsam::Point3>(t);
+}
+static boost::python::object MyTemplatePoint2_templatedMethodVector_0(MyTemplatePoint2& self, const Vector& t) {
+  Vector result = self.templatedMethod<Vector>(t);
+  return wrap::python::wrapEigen(result);
+}
+
+static boost::shared_ptr<MyTemplateMatrix> MyTemplateMatrix_constructor_0() {
+  return boost::shared_ptr<MyTemplateMatrix>(new MyTemplateMatrix());
+}
+static void MyTemplateMatrix_accept_T_0(MyTemplateMatrix& self, const Matrix& value) {
+  self.accept_T(value);
+}
+static void MyTemplateMatrix_accept_Tptr_0(MyTemplateMatrix& self, const Matrix& value) {
+  self.accept_Tptr(value);
+}
+static boost::python::object MyTemplateMatrix_create_MixedPtrs_0(MyTemplateMatrix& self) {
+  std::pair<Matrix, boost::shared_ptr<Matrix> > result = self.create_MixedPtrs();
+  return boost::python::make_tuple(wrap::python::wrapEigen(result.first), wrap::python::copyEigen(*result.second));
+}
+static boost::python::object MyTemplateMatrix_create_ptrs_0(MyTemplateMatrix& self) {
+  std::pair<boost::shared_ptr<Matrix>, boost::shared_ptr<Matrix> > result = self.create_ptrs();
+  return boost::python::make_tuple(wrap::python::copyEigen(*result.first), wrap::python::copyEigen(*result.second));
+}
+static boost::python::object MyTemplateMatrix_return_T_0(MyTemplateMatrix& self, const Matrix& value) {
+  Matrix result = self.return_T(value);
+  return wrap::python::wrapEigen(result);
+}
+static boost::python::object MyTemplateMatrix_return_Tptr_0(MyTemplateMatrix& self, const Matrix& value) {
+  boost::shared_ptr<Matrix> result = self.return_Tptr(value);
+  return wrap::python::copyEigen(*result);
+}
+static boost::python::object MyTemplateMatrix_return_ptrs_0(MyTemplateMatrix& self, const Matrix& p1, const Matrix& p2) {
+  std::pair<boost::shared_ptr<Matrix>, boost::shared_ptr<Matrix> > result = self.return_ptrs(p1,p2);
+  return boost::python::make_tuple(wrap::python::copyEigen(*result.first), wrap::python::copyEigen(*result.second));
+}
+static boost::python::object MyTemplateMatrix_templatedMethodMatrix_0(MyTemplateMatrix& self, const Matrix& t) {
+  Matrix result = self.templatedMethod<Matrix>(t);
+  return wrap::python::wrapEigen(result);
+}
+static gtsam::Point2 MyTemplateMatrix_templatedMethodPoint2_0(MyTemplateMatrix& self, const gtsam::Point2& t) {
+  return self.templatedMethod<gtsam::Point2>(t);
+}
+static gtsam::Point3 MyTemplateMatrix_templatedMethodPoint3_0(MyTemplateMatrix& self, const gtsam::Point3& t) {
+  return self.templatedMethod<gtsam::Point3>(t);
+}
+static boost::python::object MyTemplateMatrix_templatedMethodVector_0(MyTemplateMatrix& self, const Vector& t) {
+  Vector result = self.templatedMethod<Vector>(t);
+  return wrap::python::wrapEigen(result);
+}
+
+static boost::shared_ptr<MyFactorPosePoint2> MyFactorPosePoint2_constructor_0(size_t key1, size_t key2, double measured, boost::shared_ptr<gtsam::noiseModel::Base> noiseModel) {
+  return boost::shared_ptr<MyFactorPosePoint2>(new MyFactorPosePoint2(key1,key2,measured,noiseModel));
+}
+
+static boost::python::object aGlobalFunction_0() {
+  Vector result = aGlobalFunction();
+  return wrap::python::wrapEigen(result);
+}
+static boost::python::object overloadedGlobalFunction_0(int a) {
+  Vector result = overloadedGlobalFunction(a);
+  return wrap::python::wrapEigen(result);
+}
+static boost::python::object overloadedGlobalFunction_1(int a, double b) {
+  Vector result = overloadedGlobalFunction(a,b);
+  return wrap::python::wrapEigen(result);
+}
+
 BOOST_PYTHON_MODULE(geometry)
 {
-class_<Point2>("Point2")
-  .def("Point2", &Point2::Point2);
-  .def("argChar", &Point2::argChar);
-  .def("argUChar", &Point2::argUChar);
-  .def("dim", &Point2::dim);
-  .def("eigenArguments", &Point2::eigenArguments);
-  .def("returnChar", &Point2::returnChar);
-  .def("vectorConfusion", &Point2::vectorConfusion);
-  .def("x", &Point2::x);
-  .def("y", &Point2::y);
-;
-
-class_<Point3>("Point3")
-  .def("Point3", &Point3::Point3);
-  .def("StaticFunctionRet", &Point3::StaticFunctionRet);
-  .def("staticFunction", &Point3::staticFunction);
-  .def("norm", &Point3::norm);
-;
-
-class_<Test>("Test")
-  .def("Test", &Test::Test);
-  .def("arg_EigenConstRef", &Test::arg_EigenConstRef);
-  .def("create_MixedPtrs", &Test::create_MixedPtrs);
-  .def("create_ptrs", &Test::create_ptrs);
-  .def("print", &Test::print);
-  .def("return_Point2Ptr", &Test::return_Point2Ptr);
-  .def("return_Test", &Test::return_Test);
-  .def("return_TestPtr", &Test::return_TestPtr);
-  .def("return_bool", &Test::return_bool);
-  .def("return_double", &Test::return_double);
-  .def("return_field", &Test::return_field);
-  .def("return_int", &Test::return_int);
-  .def("return_matrix1", &Test::return_matrix1);
-  .def("return_matrix2", &Test::return_matrix2);
-  .def("return_pair", &Test::return_pair);
-  .def("return_ptrs", &Test::return_ptrs);
-  .def("return_size_t", &Test::return_size_t);
-  .def("return_string", &Test::return_string);
-  .def("return_vector1", &Test::return_vector1);
-  .def("return_vector2", &Test::return_vector2);
-;
-
-class_<MyBase>("MyBase")
-  .def("MyBase", &MyBase::MyBase);
-;
-
-class_<MyTemplatePoint2>("MyTemplatePoint2")
-  .def("MyTemplatePoint2", &MyTemplatePoint2::MyTemplatePoint2);
-  .def("accept_T", &MyTemplatePoint2::accept_T);
-  .def("accept_Tptr", &MyTemplatePoint2::accept_Tptr);
-  .def("create_MixedPtrs", &MyTemplatePoint2::create_MixedPtrs);
-  .def("create_ptrs", &MyTemplatePoint2::create_ptrs);
-  .def("return_T", &MyTemplatePoint2::return_T);
-  .def("return_Tptr", &MyTemplatePoint2::return_Tptr);
-  .def("return_ptrs", &MyTemplatePoint2::return_ptrs);
-  .def("templatedMethod", &MyTemplatePoint2::templatedMethod);
-  .def("templatedMethod", &MyTemplatePoint2::templatedMethod);
-  .def("templatedMethod", &MyTemplatePoint2::templatedMethod);
-  .def("templatedMethod", &MyTemplatePoint2::templatedMethod);
-;
-
-class_<MyTemplateMatrix>("MyTemplateMatrix")
-  .def("MyTemplateMatrix", &MyTemplateMatrix::MyTemplateMatrix);
-  .def("accept_T", &MyTemplateMatrix::accept_T);
-  .def("accept_Tptr", &MyTemplateMatrix::accept_Tptr);
-  .def("create_MixedPtrs", &MyTemplateMatrix::create_MixedPtrs);
-  .def("create_ptrs", &MyTemplateMatrix::create_ptrs);
-  .def("return_T", &MyTemplateMatrix::return_T);
-  .def("return_Tptr", &MyTemplateMatrix::return_Tptr);
-  .def("return_ptrs", &MyTemplateMatrix::return_ptrs);
-  .def("templatedMethod", &MyTemplateMatrix::templatedMethod);
-  .def("templatedMethod", &MyTemplateMatrix::templatedMethod);
-  .def("templatedMethod", &MyTemplateMatrix::templatedMethod);
-  .def("templatedMethod", &MyTemplateMatrix::templatedMethod);
-;
-
-class_<MyFactorPosePoint2>("MyFactorPosePoint2")
-  .def("MyFactorPosePoint2", &MyFactorPosePoint2::MyFactorPosePoint2);
-;
-
-def("aGlobalFunction", aGlobalFunction);
-def("overloadedGlobalFunction", overloadedGlobalFunction);
+  wrap::python::registerEigenConverters();
+
+  class_<gtsam::Point2, boost::shared_ptr<gtsam::Point2> >("Point2", no_init)
+    .def("__init__", make_constructor(&gtsamPoint2_constructor_0))
+    .def("__init__", make_constructor(&gtsamPoint2_constructor_1))
+    .def("argChar", &gtsamPoint2_argChar_0)
+    .def("argUChar", &gtsamPoint2_argUChar_0)
+    .def("dim", &gtsamPoint2_dim_0)
+    .def("eigenArguments", &gtsamPoint2_eigenArguments_0)
+    .def("returnChar", &gtsamPoint2_returnChar_0)
+    .def("vectorConfusion", &gtsamPoint2_vectorConfusion_0)
+    .def("x", &gtsamPoint2_x_0)
+    .def("y", &gtsamPoint2_y_0)
+    ;
+
+  class_<gtsam::Point3, boost::shared_ptr<gtsam::Point3> >("Point3", no_init)
+    .def("__init__", make_constructor(&gtsamPoint3_constructor_0))
+    .def("StaticFunctionRet", &gtsamPoint3_StaticFunctionRet_0)
+    .staticmethod("StaticFunctionRet")
+    .def("StaticFunction", &gtsamPoint3_StaticFunction_0)
+    .staticmethod("StaticFunction")
+    .def("norm", &gtsamPoint3_norm_0)
+    ;
+
+  class_<Test, boost::shared_ptr<Test> >("Test", no_init)
+    .def("__init__", make_constructor(&Test_constructor_0))
+    .def("__init__", make_constructor(&Test_constructor_1))
+    .def("arg_EigenConstRef", &Test_arg_EigenConstRef_0)
+    .def("create_MixedPtrs", &Test_create_MixedPtrs_0)
+    .def("create_ptrs", &Test_create_ptrs_0)
+    .def("print", &Test_print_0)
+    .def("return_Point2Ptr", &Test_return_Point2Ptr_0)
+    .def("return_Test", &Test_return_Test_0)
+    .def("return_TestPtr", &Test_return_TestPtr_0)
+    .def("return_bool", &Test_return_bool_0)
+    .def("return_double", &Test_return_double_0)
+    .def("return_field", &Test_return_field_0)
+    .def("return_int", &Test_return_int_0)
+    .def("return_matrix1", &Test_return_matrix1_0)
+    .def("return_matrix2", &Test_return_matrix2_0)
+    .def("return_pair", &Test_return_pair_0)
+    .def("return_ptrs", &Test_return_ptrs_0)
+    .def("return_size_t", &Test_return_size_t_0)
+    .def("return_string", &Test_return_string_0)
+    .def("return_vector1", &Test_return_vector1_0)
+    .def("return_vector2", &Test_return_vector2_0)
+    ;
+
+  class_<MyBase, boost::shared_ptr<MyBase>, boost::noncopyable >("MyBase", no_init)
+    ;
+
+  class_<MyTemplatePoint2, boost::shared_ptr<MyTemplatePoint2>, bases<MyBase>, boost::noncopyable >("MyTemplatePoint2", no_init)
+    .def("__init__", make_constructor(&MyTemplatePoint2_constructor_0))
+    .def("accept_T", &MyTemplatePoint2_accept_T_0)
+    .def("accept_Tptr", &MyTemplatePoint2_accept_Tptr_0)
+    .def("create_MixedPtrs", &MyTemplatePoint2_create_MixedPtrs_0)
+    .def("create_ptrs", &MyTemplatePoint2_create_ptrs_0)
+    .def("return_T", &MyTemplatePoint2_return_T_0)
+    .def("return_Tptr", &MyTemplatePoint2_return_Tptr_0)
+    .def("return_ptrs", &MyTemplatePoint2_return_ptrs_0)
+    .def("templatedMethodMatrix", &MyTemplatePoint2_templatedMethodMatrix_0)
+    .def("templatedMethodPoint2", &MyTemplatePoint2_templatedMethodPoint2_0)
+    .def("templatedMethodPoint3", &MyTemplatePoint2_templatedMethodPoint3_0)
+    .def("templatedMethodVector", &MyTemplatePoint2_templatedMethodVector_0)
+    ;
+
+  class_<MyTemplateMatrix, boost::shared_ptr<MyTemplateMatrix>, bases<MyBase>, boost::noncopyable >("MyTemplateMatrix", no_init)
+    .def("__init__", make_constructor(&MyTemplateMatrix_constructor_0))
+    .def("accept_T", &MyTemplateMatrix_accept_T_0)
+    .def("accept_Tptr", &MyTemplateMatrix_accept_Tptr_0)
+    .def("create_MixedPtrs", &MyTemplateMatrix_create_MixedPtrs_0)
+    .def("create_ptrs", &MyTemplateMatrix_create_ptrs_0)
+    .def("return_T", &MyTemplateMatrix_return_T_0)
+    .def("return_Tptr", &MyTemplateMatrix_return_Tptr_0)
+    .def("return_ptrs", &MyTemplateMatrix_return_ptrs_0)
+    .def("templatedMethodMatrix", &MyTemplateMatrix_templatedMethodMatrix_0)
+    .def("templatedMethodPoint2", &MyTemplateMatrix_templatedMethodPoint2_0)
+    .def("templatedMethodPoint3", &MyTemplateMatrix_templatedMethodPoint3_0)
+    .def("templatedMethodVector", &MyTemplateMatrix_templatedMethodVector_0)
+    ;
+
+  class_<MyFactorPosePoint2, boost::shared_ptr<MyFactorPosePoint2> >("MyFactorPosePoint2", no_init)
+    .def("__init__", make_constructor(&MyFactorPosePoint2_constructor_0))
+    ;
+
+  def("aGlobalFunction", &aGlobalFunction_0);
+  def("overloadedGlobalFunction", &overloadedGlobalFunction_0);
+  def("overloadedGlobalFunction", &overloadedGlobalFunction_1);
 }
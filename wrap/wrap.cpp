@@ -43,6 +43,21 @@ void generate_matlab_toolbox(
   module.matlab_code(toolboxPath);
 }
 
+/**
+ * Top-level function to generate a Boost.Python module
+ * @param interfacePath path to where interface file lives, e.g., borg/gtsam
+ * @param moduleName name of the module to be generated e.g. gtsam
+ * @param outputPath path where moduleName_python.cpp should be generated
+ */
+void generate_python_module(
+           const string& interfacePath,
+           const string& moduleName,
+           const string& outputPath)
+{
+  wrap::Module module(interfacePath, moduleName, false);
+  module.python_wrapper(outputPath);
+}
+
 /** Displays usage information */
 void usage() {
   cerr << "wrap parses an interface file and produces a MATLAB toolbox" << endl;
@@ -51,14 +66,24 @@ void usage() {
   cerr << "  moduleName    : the name of the module, interface file must be called moduleName.h" << endl;
   cerr << "  toolboxPath   : the directory in which to generate the wrappers" << endl;
   cerr << "  headerPath    : path to matlab.h" << endl;
+  cerr << "or produces a Boost.Python module source, which includes wrap/python.h" << endl;
+  cerr << "usage: wrap --python interfacePath moduleName outputPath" << endl;
 }
 
 /**
- * main parses arguments and calls generate_matlab_toolbox above
+ * main parses arguments and calls generate_matlab_toolbox or generate_python_module above
  * Typically called from "make all" using appropriate arguments
  */
 int main(int argc, const char* argv[]) {
-  if (argc != 5) {
+  if (argc == 5 && string(argv[1]) == "--python") {
+    try {
+      generate_python_module(argv[2],argv[3],argv[4]);
+    } catch(std::exception& e) {
+      cerr << e.what() << endl;
+      return 1;
+    }
+  }
+  else if (argc != 5) {
     cerr << "Invalid arguments:\n";
     for (int i=0; i<argc; ++i)
       cerr << argv[i] << endl;